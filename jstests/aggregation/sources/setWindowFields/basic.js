@@ -0,0 +1,69 @@
+// Tests the $setWindowFields stage, which computes window functions over sorted partitions.
+(function() {
+"use strict";
+
+const coll = db.set_window_fields_basic;
+coll.drop();
+
+for (let i = 0; i < 10; i++) {
+    assert.commandWorked(coll.insert({_id: i, part: i % 2, x: i}));
+}
+
+// A running total within each partition.
+let results = coll.aggregate([
+                      {
+                          $setWindowFields: {
+                              partitionBy: "$part",
+                              sortBy: {x: 1},
+                              output: {
+                                  total: {$sum: "$x", window: {documents: ["unbounded", "current"]}}
+                              }
+                          }
+                      },
+                      {$sort: {_id: 1}}
+                  ])
+                  .toArray();
+assert.eq(results.map(doc => doc.total), [0, 1, 2, 4, 6, 9, 12, 16, 20, 25], results);
+
+// A sliding window over the whole collection.
+results = coll.aggregate([
+                  {
+                      $setWindowFields: {
+                          sortBy: {_id: 1},
+                          output: {
+                              avg: {$avg: "$x", window: {documents: [-1, 1]}},
+                              min: {$min: "$x", window: {documents: [-2, 0]}},
+                              max: {$max: "$x", window: {documents: [0, 2]}}
+                          }
+                      }
+                  },
+                  {$sort: {_id: 1}}
+              ])
+              .toArray();
+assert.eq(results.map(doc => doc.avg), [0.5, 1, 2, 3, 4, 5, 6, 7, 8, 8.5], results);
+assert.eq(results.map(doc => doc.min), [0, 0, 0, 1, 2, 3, 4, 5, 6, 7], results);
+assert.eq(results.map(doc => doc.max), [2, 3, 4, 5, 6, 7, 8, 9, 9, 9], results);
+
+// The whole partition is the default window.
+results = coll.aggregate([
+                  {$setWindowFields: {partitionBy: "$part", output: {count: {$sum: 1}}}},
+                  {$group: {_id: "$count", n: {$sum: 1}}}
+              ])
+              .toArray();
+assert.eq(results, [{_id: 5, n: 10}], results);
+
+// Invalid specifications are rejected.
+assert.commandFailedWithCode(
+    db.runCommand(
+        {aggregate: coll.getName(), pipeline: [{$setWindowFields: {sortBy: {x: 1}}}], cursor: {}}),
+    4031715);
+assert.commandFailedWithCode(db.runCommand({
+    aggregate: coll.getName(),
+    pipeline: [{
+        $setWindowFields:
+            {output: {total: {$sum: "$x", window: {documents: [1, 0]}}}}
+    }],
+    cursor: {}
+}),
+                             4031719);
+}());
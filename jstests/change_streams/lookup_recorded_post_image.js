@@ -0,0 +1,72 @@
+// Tests that change streams using 'fullDocument: updateLookup' return the post-image recorded in
+// the oplog for collections created with the 'recordPostImages' option, rather than looking up
+// the current version of the document.
+//
+// Updates made inside a multi-document transaction do not record post-images.
+// @tags: [
+//   change_stream_does_not_expect_txns,
+//   do_not_wrap_aggregations_in_facets,
+//   uses_multiple_connections,
+// ]
+(function() {
+"use strict";
+
+load("jstests/libs/change_stream_util.js");
+load("jstests/libs/collection_drop_recreate.js");  // For assertDropAndRecreateCollection.
+
+const coll =
+    assertDropAndRecreateCollection(db, "lookup_recorded_post_image", {recordPostImages: true});
+assert(coll.exists().options.recordPostImages, coll.exists());
+
+const cst = new ChangeStreamTest(db);
+const cursor = cst.startWatchingChanges(
+    {pipeline: [{$changeStream: {fullDocument: "updateLookup"}}], collection: coll});
+
+assert.commandWorked(coll.insert({_id: 1, a: 1}));
+assert.commandWorked(coll.update({_id: 1}, {$set: {a: 2}}));
+assert.commandWorked(coll.update({_id: 1}, {$inc: {a: 1}, $set: {b: 1}}));
+
+// Remove the document before reading the updates, so that a lookup would find nothing.
+assert.commandWorked(coll.remove({_id: 1}));
+
+cst.assertNextChangesEqual({
+    cursor: cursor,
+    expectedChanges: [
+        {
+            documentKey: {_id: 1},
+            fullDocument: {_id: 1, a: 1},
+            ns: {db: db.getName(), coll: coll.getName()},
+            operationType: "insert",
+        },
+        {
+            documentKey: {_id: 1},
+            fullDocument: {_id: 1, a: 2},
+            ns: {db: db.getName(), coll: coll.getName()},
+            operationType: "update",
+            updateDescription: {updatedFields: {a: 2}, removedFields: []},
+        },
+        {
+            documentKey: {_id: 1},
+            fullDocument: {_id: 1, a: 3, b: 1},
+            ns: {db: db.getName(), coll: coll.getName()},
+            operationType: "update",
+            updateDescription: {updatedFields: {a: 3, b: 1}, removedFields: []},
+        },
+        {
+            documentKey: {_id: 1},
+            ns: {db: db.getName(), coll: coll.getName()},
+            operationType: "delete",
+        },
+    ]
+});
+
+// Streams that don't ask for the full document are unaffected.
+const defaultCursor = cst.startWatchingChanges({pipeline: [{$changeStream: {}}], collection: coll});
+assert.commandWorked(coll.insert({_id: 2, a: 1}));
+assert.commandWorked(coll.update({_id: 2}, {$set: {a: 2}}));
+const changes = cst.assertNextChangesEqual({cursor: defaultCursor, expectedNumChanges: 2});
+assert.eq("update", changes[1].operationType, changes);
+assert(!changes[1].hasOwnProperty("fullDocument"), changes);
+
+cst.cleanUp();
+}());
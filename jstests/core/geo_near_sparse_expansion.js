@@ -0,0 +1,37 @@
+// Tests that $near and $nearSphere return the nearest documents in order when a dense cluster
+// around the query point is followed by a wide empty region and a distant cluster, which the search
+// must cross by growing its annuli quickly.
+(function() {
+"use strict";
+
+const coll = db.geo_near_sparse_expansion;
+
+function runTest(indexSpec, makeLoc, nearQuery) {
+    coll.drop();
+    assert.commandWorked(coll.createIndex(indexSpec));
+
+    const docs = [];
+    for (let i = 0; i < 20; i++) {
+        docs.push({_id: i, loc: makeLoc(0.0001 * i, 0)});
+    }
+    for (let i = 0; i < 20; i++) {
+        docs.push({_id: 100 + i, loc: makeLoc(40 + 0.01 * i, 0)});
+    }
+    assert.commandWorked(coll.insert(docs));
+
+    const expectedIds = docs.map(doc => doc._id);
+    for (let limit of [5, 25, 40]) {
+        const ids = coll.find({loc: nearQuery}).limit(limit).toArray().map(doc => doc._id);
+        assert.eq(expectedIds.slice(0, limit), ids, tojson(indexSpec));
+    }
+
+    const explain = coll.find({loc: nearQuery}).limit(25).explain("executionStats");
+    const nearStage = explain.executionStats.executionStages.inputStage;
+    assert.eq(nearStage.inputStages.length, nearStage.searchIntervals.length, explain);
+}
+
+runTest({loc: "2dsphere"},
+        (x, y) => ({type: "Point", coordinates: [x, y]}),
+        {$nearSphere: {$geometry: {type: "Point", coordinates: [0, 0]}}});
+runTest({loc: "2d"}, (x, y) => [x, y], {$near: [0, 0]});
+})();
@@ -0,0 +1,48 @@
+// Tests that indexes stay correct when an update changes the fields of some indexes on a
+// collection but leaves those of others, including partial filter fields, as they were.
+// @tags: [requires_non_retryable_writes]
+(function() {
+"use strict";
+
+const coll = db.update_unaffected_indexes;
+coll.drop();
+
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({"b.c": 1}));
+assert.commandWorked(coll.createIndex({d: 1}, {partialFilterExpression: {e: {$gt: 0}}}));
+
+const docs = [];
+for (let i = 0; i < 20; ++i) {
+    docs.push({_id: i, a: i, b: {c: i % 2}, d: i, e: i % 4});
+}
+assert.commandWorked(coll.insert(docs));
+
+function assertIndexCount(expected, query, hint) {
+    assert.eq(expected, coll.find(query).hint(hint).itcount(), {query: query, hint: hint});
+}
+
+// Changing 'a' only must still update the {a: 1} index, and leave the others intact.
+assert.commandWorked(coll.update({}, {$inc: {a: 100}}, {multi: true}));
+assertIndexCount(20, {a: {$gte: 100}}, {a: 1});
+assertIndexCount(0, {a: {$lt: 100}}, {a: 1});
+assertIndexCount(10, {"b.c": 1}, {"b.c": 1});
+assertIndexCount(15, {d: {$gte: 0}, e: {$gt: 0}}, {d: 1});
+
+// Changing a field inside 'b' alongside one that no index covers.
+assert.commandWorked(coll.update({"b.c": 1}, {$set: {"b.c": 2, f: 1}}, {multi: true}));
+assertIndexCount(0, {"b.c": 1}, {"b.c": 1});
+assertIndexCount(10, {"b.c": 2}, {"b.c": 1});
+assertIndexCount(20, {a: {$gte: 100}}, {a: 1});
+
+// Changing only the partial filter field moves documents in and out of the partial index.
+assert.commandWorked(coll.update({e: 0}, {$set: {e: 1}}, {multi: true}));
+assertIndexCount(20, {d: {$gte: 0}, e: {$gt: 0}}, {d: 1});
+assert.commandWorked(coll.update({}, {$set: {e: 0}}, {multi: true}));
+assertIndexCount(0, {d: {$gte: 0}, e: {$gt: 0}}, {d: 1});
+
+// Replacement updates which keep the indexed fields behave the same way.
+assert.commandWorked(coll.update({_id: 0}, {a: 100, b: {c: 0}, d: 0, e: 0, g: "replaced"}));
+assertIndexCount(1, {a: 100}, {a: 1});
+assertIndexCount(10, {"b.c": 0}, {"b.c": 1});
+assert.eq("replaced", coll.findOne({a: 100}).g);
+}());
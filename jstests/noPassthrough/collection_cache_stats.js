@@ -0,0 +1,83 @@
+/**
+ * Tests that $collStats and $indexStats report how much of a collection and of its indexes is
+ * resident in the WiredTiger cache, and that the 'cachePriority' collection option is validated and
+ * reported.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+
+const kCacheStatsFields = [
+    "bytesInCache",
+    "dirtyBytesInCache",
+    "bytesReadIntoCache",
+    "pagesReadIntoCache",
+    "unmodifiedPagesEvicted",
+    "modifiedPagesEvicted"
+];
+
+function assertCacheStats(stats) {
+    for (let field of kCacheStatsFields) {
+        assert(stats.hasOwnProperty(field), tojson(stats));
+    }
+}
+
+function getCacheStats(coll) {
+    return coll.aggregate([{$collStats: {cacheStats: {}}}]).next().cacheStats;
+}
+
+assert.commandWorked(db.createCollection(
+    "hot", {storageEngine: {wiredTiger: {cachePriority: "high"}}}));
+assert.commandWorked(db.createCollection(
+    "archive", {storageEngine: {wiredTiger: {cachePriority: "low"}}}));
+assert.commandWorked(db.createCollection("plain"));
+
+for (let collName of ["hot", "archive", "plain"]) {
+    const coll = db[collName];
+    assert.commandWorked(coll.createIndex({a: 1}));
+    assert.commandWorked(coll.insert([{_id: 1, a: 1}, {_id: 2, a: 2}]));
+    assert.eq(2, coll.find().itcount());
+
+    const cacheStats = getCacheStats(coll);
+    assertCacheStats(cacheStats);
+    assert.gt(cacheStats.bytesInCache, 0, tojson(cacheStats));
+    assertCacheStats(cacheStats.indexes._id_);
+    assertCacheStats(cacheStats.indexes.a_1);
+
+    const indexStats = coll.aggregate([{$indexStats: {}}]).toArray();
+    assert.eq(2, indexStats.length, tojson(indexStats));
+    for (let index of indexStats) {
+        assertCacheStats(index.cache);
+    }
+}
+
+assert.eq("high", getCacheStats(db.hot).cachePriority);
+assert.eq("low", getCacheStats(db.archive).cachePriority);
+assert.eq("normal", getCacheStats(db.plain).cachePriority);
+assert(db.hot.stats().wiredTiger.creationString.includes("cache_resident=true"));
+
+assert.commandFailedWithCode(
+    db.createCollection("bad", {storageEngine: {wiredTiger: {cachePriority: "urgent"}}}),
+    ErrorCodes.InvalidOptions);
+assert.commandFailedWithCode(
+    db.createCollection("bad", {storageEngine: {wiredTiger: {cachePriority: 1}}}),
+    ErrorCodes.TypeMismatch);
+
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: "plain", pipeline: [{$collStats: {cacheStats: {a: 1}}}], cursor: {}}),
+    4031729);
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: "missing", pipeline: [{$collStats: {cacheStats: {}}}], cursor: {}}),
+    4031730);
+
+// The priority of a collection survives a restart.
+MongoRunner.stopMongod(conn);
+const restarted = MongoRunner.runMongod({dbpath: conn.dbpath, noCleanData: true});
+assert.eq("low", getCacheStats(restarted.getDB("test").archive).cachePriority);
+assert.eq(2, restarted.getDB("test").archive.find().itcount());
+MongoRunner.stopMongod(restarted);
+})();
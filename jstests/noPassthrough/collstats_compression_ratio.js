@@ -0,0 +1,29 @@
+/**
+ * Tests that collStats reports how well a WiredTiger collection's data compresses on disk.
+ *
+ * @tags: [requires_persistence,requires_wiredtiger]
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod({wiredTigerCollectionBlockCompressor: 'zstd'});
+assert.neq(null, conn, "mongod failed to start up");
+
+const testDb = conn.getDB('test');
+const coll = testDb.collstats_compression_ratio;
+coll.drop();
+
+// Small documents with a repeating schema compress well.
+const docs = [];
+for (let i = 0; i < 10000; ++i) {
+    docs.push({_id: i, status: "active", category: "widgets", quantity: i % 10});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(testDb.adminCommand({fsync: 1}));
+
+const stats = coll.stats();
+assert(stats.wiredTiger.hasOwnProperty('compressionRatio'), stats);
+assert.gt(stats.wiredTiger.compressionRatio, 1, stats);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,56 @@
+/**
+ * Tests that the dbHash command reports the same hashes however many threads hash the documents it
+ * scans, and that it supports the murmur3 hash algorithm.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+
+// Make collections large enough to be hashed in several batches.
+const bigString = "x".repeat(64 * 1024);
+for (let c = 0; c < 3; ++c) {
+    const bulk = db["coll" + c].initializeUnorderedBulkOp();
+    for (let i = 0; i < 200; ++i) {
+        bulk.insert({_id: i, c: c, s: bigString});
+    }
+    assert.commandWorked(bulk.execute());
+}
+assert.commandWorked(db.createCollection("empty"));
+
+function dbHash(numThreads, hashAlgorithm) {
+    assert.commandWorked(db.adminCommand({setParameter: 1, maxDbHashThreads: numThreads}));
+    const cmd = {dbHash: 1};
+    if (hashAlgorithm) {
+        cmd.hashAlgorithm = hashAlgorithm;
+    }
+    return assert.commandWorked(db.runCommand(cmd));
+}
+
+const md5Serial = dbHash(0);
+assert.eq(md5Serial.collections, dbHash(1).collections);
+assert.eq(md5Serial.collections, dbHash(8).collections);
+assert.eq(md5Serial.md5, dbHash(8, "md5").md5);
+
+const murmurSerial = dbHash(0, "murmur3");
+const murmurParallel = dbHash(8, "murmur3");
+assert.eq(murmurSerial.collections, murmurParallel.collections);
+assert.eq(murmurSerial.murmur3, murmurParallel.murmur3);
+assert(!murmurSerial.hasOwnProperty("md5"), tojson(murmurSerial));
+assert.neq(md5Serial.collections.coll0, murmurSerial.collections.coll0);
+
+// Changing a document changes the hash of its collection only.
+assert.commandWorked(db.coll1.update({_id: 150}, {$set: {c: -1}}));
+const murmurUpdated = dbHash(8, "murmur3");
+assert.eq(murmurSerial.collections.coll0, murmurUpdated.collections.coll0);
+assert.neq(murmurSerial.collections.coll1, murmurUpdated.collections.coll1);
+assert.neq(murmurSerial.murmur3, murmurUpdated.murmur3);
+
+assert.commandFailedWithCode(db.runCommand({dbHash: 1, hashAlgorithm: "sha1"}),
+                             ErrorCodes.BadValue);
+assert.commandFailedWithCode(db.runCommand({dbHash: 1, hashAlgorithm: 1}),
+                             ErrorCodes.TypeMismatch);
+
+MongoRunner.stopMongod(conn);
+})();
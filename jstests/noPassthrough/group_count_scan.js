@@ -0,0 +1,88 @@
+/**
+ * Tests that a $group on an indexed field whose accumulators only count documents is answered by a
+ * GROUP_COUNT_SCAN over the index, and that it returns the same groups as a regular $group.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod failed to start up");
+
+const testDb = conn.getDB("test");
+const coll = testDb.group_count_scan;
+coll.drop();
+
+assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+assert.commandWorked(coll.createIndex({a: -1}));
+assert.commandWorked(coll.createIndex({c: 1}, {sparse: true}));
+assert.commandWorked(coll.insert([
+    {_id: 0, a: 1, b: 1, c: 1},
+    {_id: 1, a: 1.0, b: 2},
+    {_id: 2, a: NumberLong(1), b: 3},
+    {_id: 3, a: "x", b: 1},
+    {_id: 4, a: null, b: 1},
+    {_id: 5, b: 1},
+    {_id: 6, a: {y: 1}, b: 1},
+    {_id: 7, a: 2, b: 1, c: 2},
+]));
+
+function groupsWithParameter(pipeline, enabled) {
+    assert.commandWorked(
+        testDb.adminCommand({setParameter: 1, internalDocumentSourceGroupAllowCountScan: enabled}));
+    return coll.aggregate(pipeline).toArray();
+}
+
+function getGroupCountScan(pipeline) {
+    const explain = coll.explain().aggregate(pipeline);
+    return getAggPlanStage(explain, "GROUP_COUNT_SCAN");
+}
+
+// Every eligible pipeline returns the same groups with and without the optimization.
+[[{$group: {_id: "$a", n: {$sum: 1}}}],
+ [{$group: {_id: "$a", n: {$sum: 1}, m: {$sum: NumberInt(-3)}}}, {$sort: {n: -1}}],
+ [{$group: {_id: "$a"}}, {$project: {_id: 1}}],
+].forEach(function(pipeline) {
+    const expected = groupsWithParameter(pipeline, false);
+    const actual = groupsWithParameter(pipeline, true);
+    assert(arrayEq(expected, actual), {expected: expected, actual: actual});
+});
+
+// The scan uses the index with the fewest fields and reads one key per document.
+let groupCountScan = getGroupCountScan([{$group: {_id: "$a", n: {$sum: 1}}}]);
+assert.neq(null, groupCountScan);
+assert.eq("a_-1", groupCountScan.indexName, groupCountScan);
+
+let explain = coll.explain("executionStats").aggregate([{$group: {_id: "$a", n: {$sum: 1}}}]);
+groupCountScan = getAggPlanStage(explain, "GROUP_COUNT_SCAN");
+assert.eq(8, groupCountScan.keysExamined, explain);
+assert.eq(5, groupCountScan.groupsReturned, explain);
+const executionStats = explain.hasOwnProperty("stages") ? explain.stages[0].$cursor.executionStats
+                                                       : explain.executionStats;
+assert.eq(0, executionStats.totalDocsExamined, explain);
+
+// Documents missing the field are counted in the null group, as $group would.
+assert.eq([{_id: null, n: 2}],
+          coll.aggregate([{$group: {_id: "$a", n: {$sum: 1}}}, {$match: {_id: null}}]).toArray());
+
+// Pipelines which filter, sort, use a non-simple collation, a sparse or multikey index, or any
+// accumulator besides a $sum of an integer constant do not use the scan.
+[[{$match: {b: 1}}, {$group: {_id: "$a", n: {$sum: 1}}}],
+ [{$sort: {a: 1}}, {$group: {_id: "$a", n: {$sum: 1}}}],
+ [{$group: {_id: "$a", n: {$sum: "$b"}}}],
+ [{$group: {_id: "$a", n: {$sum: 1.5}}}],
+ [{$group: {_id: "$a", n: {$sum: 1}, b: {$max: "$b"}}}],
+ [{$group: {_id: "$c", n: {$sum: 1}}}],
+].forEach(function(pipeline) {
+    assert.eq(null, getGroupCountScan(pipeline), pipeline);
+});
+explain =
+    coll.explain().aggregate([{$group: {_id: "$a", n: {$sum: 1}}}], {collation: {locale: "fr"}});
+assert.eq(null, getAggPlanStage(explain, "GROUP_COUNT_SCAN"), explain);
+
+assert.commandWorked(coll.insert({_id: 8, a: [1, 2], b: 1}));
+assert.eq(null, getGroupCountScan([{$group: {_id: "$a", n: {$sum: 1}}}]));
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,71 @@
+/**
+ * Tests that equality lookups on unique, single-field indexes use the idhack fast path when
+ * 'internalQueryAllowIdHackOnUniqueIndexes' is enabled.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryAllowIdHackOnUniqueIndexes: true}});
+assert.neq(null, conn, "mongod failed to start up");
+
+const testDb = conn.getDB("test");
+const coll = testDb.idhack_unique_index;
+coll.drop();
+
+assert.commandWorked(coll.createIndex({email: 1}, {unique: true}));
+assert.commandWorked(coll.createIndex({name: 1}));
+assert.commandWorked(
+    coll.createIndex({code: 1}, {unique: true, partialFilterExpression: {code: {$gt: 0}}}));
+assert.commandWorked(coll.insert([
+    {_id: 1, email: "a@example.com", name: "a", code: 1},
+    {_id: 2, email: "b@example.com", name: "b", code: 2},
+    {_id: 3, name: "c"},
+]));
+
+// A point lookup on the unique index reports the index it used.
+let explain = coll.find({email: "b@example.com"}).explain("executionStats");
+assert(isIdhack(testDb, explain.queryPlanner.winningPlan), explain);
+assert.eq("email_1", explain.queryPlanner.winningPlan.indexName, explain);
+assert.eq(1, explain.executionStats.nReturned, explain);
+assert.eq(1, explain.executionStats.totalKeysExamined, explain);
+assert.eq({_id: 2, email: "b@example.com", name: "b", code: 2},
+          coll.findOne({email: "b@example.com"}));
+assert.eq(null, coll.findOne({email: "z@example.com"}));
+
+// The plan summary in the slow query log and profiler names the index.
+assert.commandWorked(testDb.setProfilingLevel(2));
+assert.eq(1, coll.find({email: "a@example.com"}).comment("unique_idhack").itcount());
+const profileEntry = testDb.system.profile.findOne({"command.comment": "unique_idhack"});
+assert.eq("IDHACK { email: 1 }", profileEntry.planSummary, profileEntry);
+assert.commandWorked(testDb.setProfilingLevel(0));
+
+// Updates and deletes by key take the same path.
+explain = coll.explain().update({email: "a@example.com"}, {$set: {name: "aa"}});
+assert(planHasStage(testDb, explain.queryPlanner.winningPlan, "IDHACK"), explain);
+assert.commandWorked(coll.update({email: "a@example.com"}, {$set: {name: "aa"}}));
+assert.eq("aa", coll.findOne({_id: 1}).name);
+
+explain = coll.explain().remove({email: "a@example.com"});
+assert(planHasStage(testDb, explain.queryPlanner.winningPlan, "IDHACK"), explain);
+assert.commandWorked(coll.remove({email: "a@example.com"}));
+assert.eq(null, coll.findOne({_id: 1}));
+
+// Non-unique and partial indexes, null equality, non-equality predicates and non-simple collations
+// all go through regular planning.
+[{name: "b"}, {code: 2}, {email: null}, {email: {$gte: "b"}}].forEach(function(query) {
+    explain = coll.find(query).explain();
+    assert(!isIdhack(testDb, explain.queryPlanner.winningPlan), explain);
+});
+explain = coll.find({email: "b@example.com"}).collation({locale: "fr"}).explain();
+assert(!isIdhack(testDb, explain.queryPlanner.winningPlan), explain);
+
+// Disabling the parameter restores regular planning for the unique index.
+assert.commandWorked(
+    testDb.adminCommand({setParameter: 1, internalQueryAllowIdHackOnUniqueIndexes: false}));
+explain = coll.find({email: "b@example.com"}).explain();
+assert(isIxscan(testDb, explain.queryPlanner.winningPlan), explain);
+
+MongoRunner.stopMongod(conn);
+}());
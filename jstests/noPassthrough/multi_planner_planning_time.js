@@ -0,0 +1,47 @@
+/**
+ * Tests that the time spent by the multi-planner picking a winning plan is reported in explain,
+ * the profiler and the slow query log.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod failed to start up");
+
+const testDb = conn.getDB("test");
+const coll = testDb.multi_planner_planning_time;
+coll.drop();
+
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+const docs = [];
+for (let i = 0; i < 200; ++i) {
+    docs.push({a: i % 10, b: i % 20});
+}
+assert.commandWorked(coll.insert(docs));
+
+// A query with two candidate plans reports its planning time in the execution stats.
+let explain = coll.find({a: 1, b: 1}).explain("executionStats");
+assert.gte(explain.executionStats.planningTimeMicros, 0, explain);
+
+// A query with a single candidate plan does not go through the multi-planner.
+explain = coll.find({a: 1}).explain("executionStats");
+assert(!explain.executionStats.hasOwnProperty("planningTimeMicros"), explain);
+
+// The profiler records the planning time alongside 'fromMultiPlanner'.
+assert.commandWorked(testDb.setProfilingLevel(2));
+assert.eq(10, coll.find({a: 1, b: 1}).comment("multi_planned").itcount());
+assert.eq(20, coll.find({a: 1}).comment("single_planned").itcount());
+let profileEntry = testDb.system.profile.findOne({"command.comment": "multi_planned"});
+assert(profileEntry.fromMultiPlanner, profileEntry);
+assert.gte(profileEntry.planningTimeMicros, 0, profileEntry);
+profileEntry = testDb.system.profile.findOne({"command.comment": "single_planned"});
+assert(!profileEntry.hasOwnProperty("planningTimeMicros"), profileEntry);
+assert.commandWorked(testDb.setProfilingLevel(0, {slowms: -1}));
+
+// The slow query log line carries the same value.
+assert.eq(10, coll.find({a: 1, b: 1}).comment("multi_planned_log").itcount());
+assert.soon(() => checkLog.checkContainsOnce(conn, /multi_planned_log.*planningTimeMicros:\d+/));
+
+MongoRunner.stopMongod(conn);
+}());
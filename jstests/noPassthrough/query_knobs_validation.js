@@ -33,6 +33,7 @@ const expectedParamDefaults = {
     internalQueryExecYieldPeriodMS: 10,
     internalQueryFacetBufferSizeBytes: 100 * 1024 * 1024,
     internalDocumentSourceCursorBatchSizeBytes: 4 * 1024 * 1024,
+    internalDocumentSourceCursorInitialBatchSizeBytes: 256 * 1024,
     internalDocumentSourceLookupCacheSizeBytes: 100 * 1024 * 1024,
     internalLookupStageIntermediateDocumentMaxSizeBytes: 100 * 1024 * 1024,
     internalDocumentSourceGroupMaxMemoryBytes: 100 * 1024 * 1024,
@@ -162,6 +163,10 @@ assertSetParameterSucceeds("internalDocumentSourceCursorBatchSizeBytes", 11);
 assertSetParameterSucceeds("internalDocumentSourceCursorBatchSizeBytes", 0);
 assertSetParameterFails("internalDocumentSourceCursorBatchSizeBytes", -1);
 
+assertSetParameterSucceeds("internalDocumentSourceCursorInitialBatchSizeBytes", 11);
+assertSetParameterSucceeds("internalDocumentSourceCursorInitialBatchSizeBytes", 0);
+assertSetParameterFails("internalDocumentSourceCursorInitialBatchSizeBytes", -1);
+
 assertSetParameterSucceeds("internalDocumentSourceLookupCacheSizeBytes", 11);
 assertSetParameterSucceeds("internalDocumentSourceLookupCacheSizeBytes", 0);
 assertSetParameterFails("internalDocumentSourceLookupCacheSizeBytes", -1);
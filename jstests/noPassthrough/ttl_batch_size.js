@@ -0,0 +1,49 @@
+/**
+ * Tests that 'ttlIndexDeleteBatchSize' spreads the deletion of a TTL index's expired documents over
+ * several visits of the TTL monitor, and that the index is reported in 'ttl.indexesWithBacklog'
+ * until it is caught up.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        ttlMonitorSleepSecs: 1,
+        ttlMonitorEnabled: false,
+        ttlIndexDeleteBatchSize: 100,
+        ttlMonitorBacklogSleepMillis: 500,
+    }
+});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDB = conn.getDB("test");
+const coll = testDB.ttl_batch_size;
+const numDocs = 1000;
+
+const expired = new Date(Date.now() - 60 * 60 * 1000);
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; i++) {
+    bulk.insert({_id: i, date: expired});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({date: 1}, {expireAfterSeconds: 60}));
+
+const ttlMetrics = () => testDB.serverStatus().metrics.ttl;
+const deletedBefore = ttlMetrics().deletedDocuments;
+assert.eq(0, ttlMetrics().indexesWithBacklog);
+
+assert.commandWorked(testDB.adminCommand({setParameter: 1, ttlMonitorEnabled: true}));
+
+// The first visit only deletes one batch, which leaves the index with a backlog.
+assert.soon(() => ttlMetrics().indexesWithBacklog == 1, () => tojson(ttlMetrics()));
+const remaining = coll.find().itcount();
+assert.gt(remaining, 0);
+assert.lt(remaining, numDocs);
+
+// The following visits delete the remaining documents and clear the backlog.
+assert.soon(() => coll.find().itcount() === 0);
+assert.soon(() => ttlMetrics().indexesWithBacklog == 0, () => tojson(ttlMetrics()));
+assert.eq(numDocs, ttlMetrics().deletedDocuments - deletedBefore);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,49 @@
+/**
+ * Tests the checkpoint statistics reported in serverStatus, and that checkpoints can be started
+ * early when dirty data in the cache exceeds 'wiredTigerCheckpointDirtyTriggerPercent'.
+ *
+ * @tags: [requires_persistence,requires_wiredtiger]
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod({syncdelay: 1});
+assert.neq(null, conn, "mongod failed to start up");
+
+const testDb = conn.getDB('test');
+const coll = testDb.wt_checkpoint_thread_stats;
+assert.commandWorked(coll.insert({_id: 0, payload: 'x'.repeat(1024)}));
+
+const getStats = () => testDb.serverStatus().wiredTiger.checkpointThread;
+assert.soon(() => getStats().checkpoints > 0, () => tojson(getStats()));
+let stats = getStats();
+assert.gte(stats.totalDurationMillis, stats.lastDurationMillis, stats);
+assert.gte(stats.totalBytesWritten, stats.lastBytesWritten, stats);
+assert.gte(stats.totalWriteStallMicros, stats.lastWriteStallMicros, stats);
+assert.eq(0, stats.checkpointsTriggeredByDirtyCache, stats);
+
+assert.commandFailed(
+    testDb.adminCommand({setParameter: 1, wiredTigerCheckpointDirtyTriggerPercent: 101}));
+MongoRunner.stopMongod(conn);
+
+// With a long checkpoint interval and a trigger of 1% of the cache, dirtying the cache starts a
+// checkpoint well before the interval elapses.
+const pacedConn = MongoRunner.runMongod({
+    syncdelay: 3600,
+    wiredTigerCacheSizeGB: 0.25,
+    setParameter: {wiredTigerCheckpointDirtyTriggerPercent: 1}
+});
+assert.neq(null, pacedConn, "mongod failed to start up");
+
+const pacedColl = pacedConn.getDB('test').wt_checkpoint_thread_stats;
+const docs = [];
+for (let i = 0; i < 5000; ++i) {
+    docs.push({_id: i, payload: 'x'.repeat(1024)});
+}
+assert.commandWorked(pacedColl.insert(docs));
+
+const getPacedStats = () => pacedConn.getDB('admin').serverStatus().wiredTiger.checkpointThread;
+assert.soon(() => getPacedStats().checkpointsTriggeredByDirtyCache > 0,
+            () => tojson(getPacedStats()));
+MongoRunner.stopMongod(pacedConn);
+}());
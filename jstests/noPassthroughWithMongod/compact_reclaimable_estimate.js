@@ -0,0 +1,29 @@
+// Tests that compact reports an estimate, made before compacting, of the bytes it can reclaim.
+(function() {
+"use strict";
+
+if (db.serverStatus().storageEngine.name !== "wiredTiger") {
+    jsTestLog("Skipping test because compact estimates are only reported by WiredTiger");
+    return;
+}
+
+const coll = db.compact_reclaimable_estimate;
+coll.drop();
+assert.commandWorked(coll.createIndex({a: 1}));
+
+const padding = "x".repeat(1024);
+const docs = [];
+for (let i = 0; i < 10000; ++i) {
+    docs.push({_id: i, a: i, padding: padding});
+}
+assert.commandWorked(coll.insert(docs));
+
+// Checkpoint so that the space of the deleted documents shows up as free for reuse.
+assert.commandWorked(coll.remove({_id: {$gte: 1000}}));
+assert.commandWorked(db.adminCommand({fsync: 1}));
+
+const res = assert.commandWorked(db.runCommand({compact: coll.getName()}));
+assert(res.hasOwnProperty("estimatedBytesReclaimable"), tojson(res));
+assert.gte(res.estimatedBytesReclaimable, 0, tojson(res));
+assert.eq(1000, coll.find().hint({a: 1}).itcount());
+}());
@@ -0,0 +1,49 @@
+/**
+ * Tests that a $text query sorted on the text score with a limit only fetches the documents it
+ * returns, and that it returns the same documents as an unlimited query.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const coll = db.fts_score_sort_limit;
+coll.drop();
+assert.commandWorked(coll.createIndex({content: "text"}, {default_language: "none"}));
+
+const docs = [];
+for (let i = 0; i < 50; i++) {
+    docs.push({_id: i, n: i, content: "apple ".repeat(1 + i % 7) + "banana ".repeat(1 + i % 3)});
+}
+assert.commandWorked(coll.insert(docs));
+
+const projection = {score: {$meta: "textScore"}};
+const sort = {score: {$meta: "textScore"}};
+
+function textOrStage(query, limit) {
+    const explain = coll.find(query, projection).sort(sort).limit(limit).explain("executionStats");
+    const stages = getPlanStages(explain.executionStats.executionStages, "TEXT_OR");
+    assert.eq(1, stages.length, explain);
+    return stages[0];
+}
+
+function assertSameResults(query, limit, skip) {
+    const all = coll.find(query, projection).sort(sort).toArray();
+    const expected = all.slice(skip, skip + limit).map(d => d.score);
+    const actual =
+        coll.find(query, projection).sort(sort).skip(skip).limit(limit).toArray().map(d => d.score);
+    assert.eq(expected, actual);
+}
+
+// Only the documents returned are fetched.
+assert.eq(5, textOrStage({$text: {$search: "apple banana"}}, 5).fetches);
+assertSameResults({$text: {$search: "apple banana"}}, 5, 0);
+assertSameResults({$text: {$search: "apple"}}, 10, 3);
+
+// Negated terms, phrases and residual predicates may reject documents after scoring, so every
+// candidate is still fetched.
+assert.eq(50, textOrStage({$text: {$search: "apple -cherry"}}, 5).fetches);
+assert.eq(50, textOrStage({$text: {$search: "\"apple\""}}, 5).fetches);
+assert.eq(50, textOrStage({$text: {$search: "apple"}, n: {$gte: 10}}, 5).fetches);
+assertSameResults({$text: {$search: "apple -cherry"}}, 5, 0);
+})();
@@ -0,0 +1,44 @@
+// Tests that $indexStats reports the updates which skipped maintaining an index, either because
+// they left its fields unchanged or because the document stayed outside its partial filter.
+(function() {
+"use strict";
+
+const coll = db.index_stats_skipped_updates;
+coll.drop();
+
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({d: 1}, {partialFilterExpression: {e: {$gt: 0}}}));
+
+const docs = [];
+for (let i = 0; i < 10; ++i) {
+    docs.push({_id: i, a: i, d: i, e: i < 4 ? 1 : 0});
+}
+assert.commandWorked(coll.insert(docs));
+
+function getSkippedUpdates(indexName) {
+    const stats = coll.aggregate([{$indexStats: {}}, {$match: {name: indexName}}]).toArray();
+    assert.eq(1, stats.length, stats);
+    return stats[0].maintenance.skippedUpdates;
+}
+
+assert.eq(0, getSkippedUpdates("a_1"));
+assert.eq(0, getSkippedUpdates("d_1"));
+
+// Changing 'd' leaves the {a: 1} index alone for every document. The partial index is skipped for
+// the six documents which stay outside its filter, and maintained for the other four.
+assert.commandWorked(coll.update({}, {$inc: {d: 100}}, {multi: true}));
+assert.eq(10, getSkippedUpdates("a_1"));
+assert.eq(6, getSkippedUpdates("d_1"));
+assert.eq(4, coll.find({d: {$gte: 100}, e: {$gt: 0}}).hint({d: 1}).itcount());
+
+// Changing 'a' leaves the fields of the partial index unchanged for every document.
+assert.commandWorked(coll.update({}, {$inc: {a: 100}}, {multi: true}));
+assert.eq(10, getSkippedUpdates("a_1"));
+assert.eq(16, getSkippedUpdates("d_1"));
+assert.eq(10, coll.find({a: {$gte: 100}}).hint({a: 1}).itcount());
+
+// Moving documents into the partial filter must maintain the index.
+assert.commandWorked(coll.update({e: 0}, {$set: {e: 1}}, {multi: true}));
+assert.eq(16, getSkippedUpdates("d_1"));
+assert.eq(10, coll.find({d: {$gte: 100}, e: {$gt: 0}}).hint({d: 1}).itcount());
+}());
@@ -0,0 +1,39 @@
+// Tests that validate reports the same results whether or not it generates the index keys of the
+// documents it scans on several threads.
+(function() {
+"use strict";
+
+const coll = db.validate_parallel_key_generation;
+coll.drop();
+
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1, c: -1}));
+assert.commandWorked(coll.createIndex({"d.e": 1}));
+assert.commandWorked(coll.createIndex({c: 1}, {partialFilterExpression: {a: {$gt: 500}}}));
+assert.commandWorked(coll.createIndex({s: "text"}));
+assert.commandWorked(coll.createIndex({"$**": 1}, {name: "wildcard"}));
+
+const docs = [];
+for (let i = 0; i < 3000; ++i) {
+    docs.push({_id: i, a: i, b: i % 7, c: "c" + i, d: [{e: i}, {e: i + 1}], s: "word" + (i % 10)});
+}
+assert.commandWorked(coll.insert(docs));
+
+function validate(numThreads) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, maxValidateKeyGenerationThreads: numThreads}));
+    const res = assert.commandWorked(coll.validate({full: true}));
+    assert(res.valid, tojson(res));
+    return res;
+}
+
+try {
+    const serial = validate(1);
+    const parallel = validate(4);
+    assert.eq(serial.nrecords, parallel.nrecords);
+    assert.eq(serial.keysPerIndex, parallel.keysPerIndex);
+    assert.eq([], parallel.errors);
+} finally {
+    assert.commandWorked(db.adminCommand({setParameter: 1, maxValidateKeyGenerationThreads: 1}));
+}
+}());
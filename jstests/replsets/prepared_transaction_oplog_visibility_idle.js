@@ -0,0 +1,70 @@
+/**
+ * Tests that the prepare, commit and abort oplog entries of prepared transactions become visible,
+ * and majority committed, on an otherwise idle replica set. Their oplog slots are reserved in a
+ * separate unit of work which always aborts, so oplog visibility must be refreshed even then.
+ *
+ * @tags: [uses_transactions, uses_prepare_transaction]
+ */
+(function() {
+"use strict";
+
+load("jstests/core/txns/libs/prepare_helpers.js");
+
+const rst = new ReplSetTest({
+    nodes: [{}, {rsConfig: {priority: 0}}],
+    // Periodic no-op writes would advance oplog visibility on their own.
+    nodeOptions: {setParameter: {writePeriodicNoops: false}},
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+rst.getSecondary().setSlaveOk();
+const dbName = "test";
+const collName = jsTestName();
+const testDB = primary.getDB(dbName);
+assert.commandWorked(testDB.runCommand({create: collName, writeConcern: {w: "majority"}}));
+
+const session = primary.startSession({causalConsistency: false});
+const sessionColl = session.getDatabase(dbName).getCollection(collName);
+
+function runPreparedTransaction(doc, commit) {
+    session.startTransaction();
+    assert.commandWorked(sessionColl.insert(doc));
+    const prepareTimestamp = PrepareHelpers.prepareTransaction(session);
+
+    if (commit) {
+        // The commit must be majority committed without any other write advancing visibility.
+        assert.commandWorked(session.getDatabase("admin").adminCommand({
+            commitTransaction: 1,
+            commitTimestamp: prepareTimestamp,
+            writeConcern: {w: "majority", wtimeout: ReplSetTest.kDefaultTimeoutMS}
+        }));
+        assert.commandWorked(session.commitTransaction_forTesting());
+    } else {
+        assert.commandWorked(session.getDatabase("admin").adminCommand({
+            abortTransaction: 1,
+            writeConcern: {w: "majority", wtimeout: ReplSetTest.kDefaultTimeoutMS}
+        }));
+        assert.commandWorkedOrFailedWithCode(session.abortTransaction_forTesting(),
+                                             ErrorCodes.NoSuchTransaction);
+    }
+}
+
+function assertLatestOplogEntryIsVisible(node, op) {
+    const entry = node.getDB("local").oplog.rs.find().sort({$natural: -1}).limit(1).next();
+    assert(entry.o.hasOwnProperty(op), tojson(entry));
+}
+
+runPreparedTransaction({_id: 1}, true);
+assertLatestOplogEntryIsVisible(primary, "commitTransaction");
+assertLatestOplogEntryIsVisible(rst.getSecondary(), "commitTransaction");
+assert.eq({_id: 1}, rst.getSecondary().getDB(dbName)[collName].findOne());
+
+runPreparedTransaction({_id: 2}, false);
+assertLatestOplogEntryIsVisible(primary, "abortTransaction");
+assertLatestOplogEntryIsVisible(rst.getSecondary(), "abortTransaction");
+
+session.endSession();
+rst.stopSet();
+})();
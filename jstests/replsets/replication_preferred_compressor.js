@@ -0,0 +1,53 @@
+/**
+ * Tests that replicationNetworkPreferredCompressor applies to the connections a secondary fetches
+ * the oplog over, and not just to the rest of its replication traffic.
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({
+    nodes: [
+        {},
+        {
+            rsConfig: {priority: 0},
+            setParameter: {replicationNetworkPreferredCompressor: "zstd"},
+        },
+    ],
+    // Snappy is offered first, so it is what connections negotiate unless the hook reorders it.
+    nodeOptions: {networkMessageCompressors: "snappy,zstd"},
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const secondary = rst.getSecondary();
+
+function getDecompressedBytes(node) {
+    const serverStatus = assert.commandWorked(node.adminCommand({serverStatus: 1}));
+    const compression = serverStatus.network.compression;
+    return {
+        snappy: compression.snappy.decompressor.bytesOut,
+        zstd: compression.zstd.decompressor.bytesOut,
+    };
+}
+
+const before = getDecompressedBytes(secondary);
+
+const kNumDocs = 20;
+const kDocSize = 100 * 1024;
+const coll = primary.getDB("test")[jsTestName()];
+for (let i = 0; i < kNumDocs; ++i) {
+    assert.commandWorked(coll.insert({_id: i, pad: "x".repeat(kDocSize)}));
+}
+rst.awaitReplication();
+
+// The oplog batches reach the secondary as replies to its fetcher's getMores, so they are
+// decompressed with the compressor that its fetcher connection negotiated.
+const after = getDecompressedBytes(secondary);
+const zstdBytes = after.zstd - before.zstd;
+const snappyBytes = after.snappy - before.snappy;
+assert.gte(zstdBytes, kNumDocs * kDocSize, tojson({before: before, after: after}));
+assert.lt(snappyBytes, kDocSize, tojson({before: before, after: after}));
+
+rst.stopSet();
+})();
@@ -448,6 +448,7 @@ let testCases = {
     getLastError: {skip: "does not forward command to primary shard"},
     getLog: {skip: "executes locally on mongos (not sent to any remote node)"},
     getMore: {skip: "requires a previously established cursor"},
+    getOperationTraces: {skip: "executes locally on mongos (not sent to any remote node)"},
     getParameter: {skip: "executes locally on mongos (not sent to any remote node)"},
     getShardMap: {skip: "executes locally on mongos (not sent to any remote node)"},
     getShardVersion: {skip: "executes locally on mongos (not sent to any remote node)"},
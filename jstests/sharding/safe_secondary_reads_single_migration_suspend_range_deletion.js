@@ -209,6 +209,7 @@ let testCases = {
     getLastError: {skip: "primary only"},
     getLog: {skip: "does not return user data"},
     getMore: {skip: "shard version already established"},
+    getOperationTraces: {skip: "does not return user data"},
     getParameter: {skip: "does not return user data"},
     getShardMap: {skip: "does not return user data"},
     getShardVersion: {skip: "primary only"},
@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * Speeds up repeated lookups of top-level fields in a single BSONObj, such as when a filter with
+ * many predicates is evaluated against one document. The first lookup walks the object like
+ * BSONObj::getField(). On the second lookup, objects with at least 'kMinFieldsToIndex' fields are
+ * indexed by field name once, and later lookups are answered from the index.
+ *
+ * Like BSONObj::getField(), the first occurrence of a repeated field name is returned.
+ */
+class BSONFieldIndex {
+    BSONFieldIndex(const BSONFieldIndex&) = delete;
+    BSONFieldIndex& operator=(const BSONFieldIndex&) = delete;
+
+public:
+    static constexpr int kMinFieldsToIndex = 16;
+
+    explicit BSONFieldIndex(BSONObj obj) : _obj(std::move(obj)) {}
+
+    BSONElement getField(StringData name) {
+        switch (_state) {
+            case State::kNotLookedUp:
+                _state = State::kLookedUpOnce;
+                return _obj.getField(name);
+            case State::kLookedUpOnce:
+                _state = _buildIndex() ? State::kIndexed : State::kUnindexed;
+                return getField(name);
+            case State::kIndexed: {
+                auto it = _index.find(name);
+                return it == _index.end() ? BSONElement() : it->second;
+            }
+            case State::kUnindexed:
+                return _obj.getField(name);
+        }
+        MONGO_UNREACHABLE;
+    }
+
+    bool isIndexed() const {
+        return _state == State::kIndexed;
+    }
+
+private:
+    enum class State { kNotLookedUp, kLookedUpOnce, kIndexed, kUnindexed };
+
+    bool _buildIndex() {
+        const int nFields = _obj.nFields();
+        if (nFields < kMinFieldsToIndex) {
+            return false;
+        }
+
+        _index.reserve(nFields);
+        for (auto&& elem : _obj) {
+            // emplace() keeps the first element for a repeated field name.
+            _index.emplace(elem.fieldNameStringData(), elem);
+        }
+        return true;
+    }
+
+    BSONObj _obj;
+    State _state = State::kNotLookedUp;
+    StringDataMap<BSONElement> _index;
+};
+
+}  // namespace mongo
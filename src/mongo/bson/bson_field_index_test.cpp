@@ -0,0 +1,88 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bson_field_index.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj makeObj(int nFields) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < nFields; ++i) {
+        builder.append("f" + std::to_string(i), i);
+    }
+    return builder.obj();
+}
+
+TEST(BSONFieldIndexTest, SmallObjectIsNotIndexed) {
+    BSONObj obj = makeObj(BSONFieldIndex::kMinFieldsToIndex - 1);
+    BSONFieldIndex index(obj);
+    ASSERT_EQ(0, index.getField("f0").numberInt());
+    ASSERT_EQ(1, index.getField("f1").numberInt());
+    ASSERT_TRUE(index.getField("missing").eoo());
+    ASSERT_FALSE(index.isIndexed());
+}
+
+TEST(BSONFieldIndexTest, LargeObjectIsIndexedOnSecondLookup) {
+    BSONObj obj = makeObj(BSONFieldIndex::kMinFieldsToIndex * 2);
+    BSONFieldIndex index(obj);
+    ASSERT_EQ(3, index.getField("f3").numberInt());
+    ASSERT_FALSE(index.isIndexed());
+
+    ASSERT_EQ(20, index.getField("f20").numberInt());
+    ASSERT_TRUE(index.isIndexed());
+    for (int i = 0; i < BSONFieldIndex::kMinFieldsToIndex * 2; ++i) {
+        ASSERT_BSONELT_EQ(obj.getField("f" + std::to_string(i)),
+                          index.getField("f" + std::to_string(i)));
+    }
+    ASSERT_TRUE(index.getField("missing").eoo());
+    ASSERT_TRUE(index.getField("").eoo());
+}
+
+TEST(BSONFieldIndexTest, RepeatedFieldNameReturnsFirstOccurrence) {
+    BSONObjBuilder builder;
+    builder.append("dup", 1);
+    builder.appendElements(makeObj(BSONFieldIndex::kMinFieldsToIndex));
+    builder.append("dup", 2);
+    BSONObj obj = builder.obj();
+
+    BSONFieldIndex index(obj);
+    ASSERT_EQ(1, index.getField("dup").numberInt());
+    ASSERT_EQ(1, index.getField("dup").numberInt());
+    ASSERT_TRUE(index.isIndexed());
+}
+
+}  // namespace
+}  // namespace mongo
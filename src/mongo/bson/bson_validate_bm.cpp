@@ -0,0 +1,126 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bson_validate.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/oid.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * A document shaped like a typical application record: an ObjectId, a handful of scalars and
+ * short strings, a small subdocument and a short array.
+ */
+BSONObj makeRecord(int i) {
+    BSONObjBuilder builder;
+    builder.append("_id", OID::gen());
+    builder.append("name", "user" + std::to_string(i));
+    builder.append("email", "user" + std::to_string(i) + "@example.com");
+    builder.append("age", i % 100);
+    builder.append("score", i * 1.5);
+    builder.append("active", i % 2 == 0);
+    builder.appendDate("createdAt", Date_t::fromMillisSinceEpoch(i));
+    {
+        BSONObjBuilder address(builder.subobjStart("address"));
+        address.append("street", "123 Main St");
+        address.append("city", "New York");
+        address.append("zip", "10001");
+    }
+    {
+        BSONArrayBuilder tags(builder.subarrayStart("tags"));
+        tags.append("a");
+        tags.append("b");
+        tags.append("c");
+    }
+    return builder.obj();
+}
+
+BSONObj makeFlat(int nFields) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < nFields; ++i) {
+        builder.append("field" + std::to_string(i), i);
+    }
+    return builder.obj();
+}
+
+BSONObj makeNested(int depth) {
+    BSONObj obj = BSON("x" << 1);
+    for (int i = 0; i < depth; ++i) {
+        obj = BSON("a" << obj << "b" << i);
+    }
+    return obj;
+}
+
+BSONObj makeLongStrings(int nFields, int length) {
+    const std::string value(length, 'x');
+    BSONObjBuilder builder;
+    for (int i = 0; i < nFields; ++i) {
+        builder.append("field" + std::to_string(i), value);
+    }
+    return builder.obj();
+}
+
+void runValidate(benchmark::State& state, const BSONObj& obj) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest).isOK());
+    }
+    state.SetBytesProcessed(state.iterations() * obj.objsize());
+}
+
+void BM_validateRecord(benchmark::State& state) {
+    runValidate(state, makeRecord(state.range(0)));
+}
+
+void BM_validateFlat(benchmark::State& state) {
+    runValidate(state, makeFlat(state.range(0)));
+}
+
+void BM_validateNested(benchmark::State& state) {
+    runValidate(state, makeNested(state.range(0)));
+}
+
+void BM_validateLongStrings(benchmark::State& state) {
+    runValidate(state, makeLongStrings(10, state.range(0)));
+}
+
+}  // namespace
+
+BENCHMARK(BM_validateRecord)->Arg(1);
+BENCHMARK(BM_validateFlat)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(BM_validateNested)->Arg(5)->Arg(50)->Arg(99);
+BENCHMARK(BM_validateLongStrings)->Arg(16)->Arg(1024)->Arg(64 * 1024);
+
+}  // namespace mongo
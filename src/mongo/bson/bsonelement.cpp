@@ -78,7 +78,7 @@ void BSONElement::jsonStringStream(JsonStringFormat format,
     switch (type()) {
         case mongo::String:
         case Symbol:
-            s << '"' << str::escape(string(valuestr(), valuestrsize() - 1)) << '"';
+            s << '"' << str::escape(StringData(valuestr(), valuestrsize() - 1)) << '"';
             break;
         case NumberLong:
             if (format == TenGen) {
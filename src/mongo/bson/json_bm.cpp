@@ -0,0 +1,83 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
+#include "mongo/bson/oid.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * A document shaped like a logged command: a handful of scalars, a filter subdocument and a
+ * string with characters that need escaping.
+ */
+BSONObj makeCommand(int nStrings) {
+    BSONObjBuilder builder;
+    builder.append("find", "collection");
+    builder.append("filter", BSON("_id" << OID::gen() << "status" << "active"));
+    builder.append("batchSize", 101);
+    builder.append("comment", "look up \"active\" users\n");
+    for (int i = 0; i < nStrings; ++i) {
+        builder.append("s" + std::to_string(i),
+                       "a string value of moderate length, field " + std::to_string(i));
+    }
+    return builder.obj();
+}
+
+void BM_jsonString(benchmark::State& state) {
+    const BSONObj obj = makeCommand(state.range(0));
+    size_t totalBytes = 0;
+    for (auto _ : state) {
+        auto json = obj.jsonString();
+        totalBytes += json.size();
+        benchmark::DoNotOptimize(json);
+    }
+    state.SetBytesProcessed(totalBytes);
+}
+
+void BM_fromjson(benchmark::State& state) {
+    const std::string json = makeCommand(state.range(0)).jsonString();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fromjson(json));
+    }
+    state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+}  // namespace
+
+BENCHMARK(BM_jsonString)->Arg(0)->Arg(10)->Arg(100);
+BENCHMARK(BM_fromjson)->Arg(0)->Arg(10)->Arg(100);
+
+}  // namespace mongo
@@ -75,6 +75,11 @@ const int BufferMaxSize = 64 * 1024 * 1024;
 template <typename Allocator>
 class StringBuilderImpl;
 
+/**
+ * Tag for constructing a BufBuilder whose buffers come from the SharedBufferPool.
+ */
+struct UseSharedBufferPool {};
+
 class SharedBufferAllocator {
     SharedBufferAllocator(const SharedBufferAllocator&) = delete;
     SharedBufferAllocator& operator=(const SharedBufferAllocator&) = delete;
@@ -85,15 +90,28 @@ public:
         invariant(!_buf.isShared());
     }
 
+    /**
+     * Takes the buffer, and all the buffers it grows into, from the SharedBufferPool.
+     */
+    explicit SharedBufferAllocator(UseSharedBufferPool) : _pooled(true) {}
+
     // Allow moving but not copying. It would be an error for two SharedBufferAllocators to use the
     // same underlying buffer.
     SharedBufferAllocator(SharedBufferAllocator&&) = default;
     SharedBufferAllocator& operator=(SharedBufferAllocator&&) = default;
 
     void malloc(size_t sz) {
-        _buf = SharedBuffer::allocate(sz);
+        _buf = _pooled ? SharedBuffer::allocateFromPool(sz) : SharedBuffer::allocate(sz);
     }
     void realloc(size_t sz) {
+        if (_pooled) {
+            // Grow into a block of a larger size class, so that the old block goes back to the
+            // pool.
+            auto newBuf = SharedBuffer::allocateFromPool(sz);
+            memcpy(newBuf.get(), _buf.get(), std::min(sz, _buf.capacity()));
+            _buf = std::move(newBuf);
+            return;
+        }
         _buf.realloc(sz);
     }
     void free() {
@@ -109,6 +127,7 @@ public:
 
 private:
     SharedBuffer _buf;
+    bool _pooled = false;
 };
 
 class StackAllocator {
@@ -165,6 +184,19 @@ public:
         reservedBytes = 0;
     }
 
+    /**
+     * Takes the buffer of this builder, and any buffer it grows into, from the SharedBufferPool,
+     * for builders of network messages. Only available to BufBuilder.
+     */
+    explicit BasicBufBuilder(UseSharedBufferPool tag, int initsize = 512)
+        : _buf(tag), size(initsize) {
+        if (size > 0) {
+            _buf.malloc(size);
+        }
+        l = 0;
+        reservedBytes = 0;
+    }
+
     void kill() {
         _buf.free();
     }
@@ -137,7 +137,12 @@ Message DBClientCursor::_assembleInit() {
                 // QueryRequest doesn't handle $readPreference.
                 cmd = BSONObjBuilder(std::move(cmd)).append(readPref).obj();
             }
-            return assembleCommandRequest(_client, ns.db(), opts, std::move(cmd));
+            auto msg = assembleCommandRequest(_client, ns.db(), opts, std::move(cmd));
+            // Let the server start the exhaust stream with the first batch.
+            if (opts & QueryOption_Exhaust && msg.operation() == dbMsg) {
+                OpMsg::setFlag(&msg, OpMsg::kExhaustSupported);
+            }
+            return msg;
         }
         // else use legacy OP_QUERY request.
         // Legacy OP_QUERY request does not support UUIDs.
@@ -117,13 +117,7 @@ public:
         auto targetHost = HostAndPort::parse(
             _saslClientSession->getParameter(SaslClientSession::parameterServiceHostAndPort));
         if (targetHost.isOK()) {
-            _credentials = _clientCache->getCachedSecrets(targetHost.getValue(), presecrets);
-            if (!_credentials) {
-                _credentials = scram::Secrets<HashBlock>(presecrets);
-
-                _clientCache->setCachedSecrets(
-                    std::move(targetHost.getValue()), std::move(presecrets), _credentials);
-            }
+            _credentials = _clientCache->getOrComputeSecrets(targetHost.getValue(), presecrets);
         } else {
             _credentials = scram::Secrets<HashBlock>(presecrets);
         }
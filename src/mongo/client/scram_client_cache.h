@@ -28,13 +28,17 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <string>
+#include <vector>
 
 #include "mongo/crypto/mechanism_scram.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/net/hostandport.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -60,6 +64,12 @@ namespace mongo {
  * server is going to advertise the same salt value upon
  * reauthentication.  This might be useful for mobile clients where
  * CPU usage is a concern."
+ *
+ * Secrets depend only on their presecrets, so getOrComputeSecrets() also reuses secrets cached
+ * for another host when the presecrets match, as they do for the members of a replica set which
+ * share a user document. It also makes concurrent authentications with the same presecrets wait
+ * for a single computation, so that a storm of new connections to a host costs one computation
+ * rather than one per connection.
  */
 template <typename HashBlock>
 class SCRAMClientCache {
@@ -116,9 +126,59 @@ public:
         }
     }
 
+    /**
+     * Returns the SCRAMSecrets for the presecrets, computing them only if no host has them cached
+     * and no other thread is already computing them. Records the result for the specified host.
+     */
+    scram::Secrets<HashBlock> getOrComputeSecrets(const HostAndPort& target,
+                                                  const scram::Presecrets<HashBlock>& presecrets) {
+        stdx::unique_lock<Latch> lock(_hostToSecretsMutex);
+        while (true) {
+            auto foundSecret = _hostToSecrets.find(target);
+            if (foundSecret != _hostToSecrets.end() && foundSecret->second.first == presecrets) {
+                return foundSecret->second.second;
+            }
+
+            // Another host may share the presecrets, in which case it has the same secrets.
+            for (const auto& entry : _hostToSecrets) {
+                if (entry.second.first == presecrets) {
+                    auto cacheRecord = entry.second;
+                    _hostToSecrets.insert_or_assign(target, cacheRecord);
+                    return cacheRecord.second;
+                }
+            }
+
+            if (std::find(_inProgress.begin(), _inProgress.end(), presecrets) ==
+                _inProgress.end()) {
+                break;
+            }
+            _computationDone.wait(lock);
+        }
+
+        _inProgress.push_back(presecrets);
+        auto guard = makeGuard([&] {
+            if (!lock.owns_lock()) {
+                lock.lock();
+            }
+            _inProgress.erase(std::find(_inProgress.begin(), _inProgress.end(), presecrets));
+            _computationDone.notify_all();
+        });
+
+        lock.unlock();
+        scram::Secrets<HashBlock> secrets(presecrets);
+        lock.lock();
+
+        _hostToSecrets.insert_or_assign(target, std::make_pair(presecrets, secrets));
+        return secrets;
+    }
+
 private:
     mutable Mutex _hostToSecretsMutex = MONGO_MAKE_LATCH("SCRAMClientCache::_hostToSecretsMutex");
     HostToSecretsMap _hostToSecrets;
+
+    // Presecrets whose secrets a thread is computing, and a condition signalled when one is done.
+    std::vector<scram::Presecrets<HashBlock>> _inProgress;
+    stdx::condition_variable _computationDone;
 };
 
 }  // namespace mongo
@@ -86,7 +86,8 @@ void AuthOpObserver::onDelete(OperationContext* opCtx,
                               OptionalCollectionUUID uuid,
                               StmtId stmtId,
                               bool fromMigrate,
-                              const boost::optional<BSONObj>& deletedDoc) {
+                              const boost::optional<BSONObj>& deletedDoc,
+                              const repl::OplogSlot& oplogSlot) {
     auto& documentKey = documentKeyDecoration(opCtx);
     invariant(!documentKey.isEmpty());
     AuthorizationManager::get(opCtx->getServiceContext())
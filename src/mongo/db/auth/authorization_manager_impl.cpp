@@ -33,6 +33,8 @@
 
 #include "mongo/db/auth/authorization_manager_impl.h"
 
+#include <absl/hash/hash.h>
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -352,8 +354,15 @@ AuthorizationManagerImpl::AuthorizationManagerImpl(
       _privilegeDocsExist(false),
       _externalState(std::move(externalState)),
       _version(schemaVersionInvalid),
-      _userCache(authorizationManagerCacheSize, UserCacheInvalidator()),
-      _fetchGeneration(OID::gen()) {}
+      _fetchGeneration(OID::gen()) {
+    const size_t partitionSize =
+        std::max<size_t>(1,
+                         (authorizationManagerCacheSize + kUserCachePartitions - 1) /
+                             kUserCachePartitions);
+    for (size_t i = 0; i < kUserCachePartitions; ++i) {
+        _userCaches.push_back(std::make_unique<UserCache>(partitionSize, UserCacheInvalidator()));
+    }
+}
 
 AuthorizationManagerImpl::~AuthorizationManagerImpl() {}
 
@@ -499,13 +508,26 @@ void AuthorizationManagerImpl::UserCacheInvalidator::operator()(User* user) {
     user->_invalidate();
 }
 
+AuthorizationManagerImpl::UserCache& AuthorizationManagerImpl::_getUserCache(
+    const UserName& userName) {
+    return *_userCaches[absl::Hash<UserName>{}(userName) % kUserCachePartitions];
+}
+
+template <typename Pred>
+void AuthorizationManagerImpl::_invalidateUsersIf(Pred predicate) {
+    for (auto& userCache : _userCaches) {
+        userCache->invalidateIf(predicate);
+    }
+}
+
 StatusWith<UserHandle> AuthorizationManagerImpl::acquireUser(OperationContext* opCtx,
                                                              const UserName& userName) {
     if (userName == internalSecurity.user->getName()) {
         return internalSecurity.user;
     }
 
-    boost::optional<UserHandle> cachedUser = _userCache.get(userName);
+    auto& userCache = _getUserCache(userName);
+    boost::optional<UserHandle> cachedUser = userCache.get(userName);
     auto returnUser = [&](boost::optional<UserHandle> cachedUser) {
         auto ret = *cachedUser;
         fassert(16914, ret.get());
@@ -524,7 +546,7 @@ StatusWith<UserHandle> AuthorizationManagerImpl::acquireUser(OperationContext* o
     // thread is fetching into the cache
     CacheGuard guard(opCtx, this);
 
-    while ((boost::none == (cachedUser = _userCache.get(userName))) &&
+    while ((boost::none == (cachedUser = userCache.get(userName))) &&
            guard.otherUpdateInFetchPhase()) {
         guard.wait();
     }
@@ -590,7 +612,7 @@ StatusWith<UserHandle> AuthorizationManagerImpl::acquireUser(OperationContext* o
     if (guard.isSameCacheGeneration()) {
         if (_version == schemaVersionInvalid)
             _version = authzVersion;
-        ret = _userCache.insertOrAssignAndGet(userName, std::move(user));
+        ret = userCache.insertOrAssignAndGet(userName, std::move(user));
         _updateCacheGeneration_inlock(guard);
     } else {
         // If the cache generation changed while this thread was in fetch mode, the data
@@ -735,15 +757,14 @@ void AuthorizationManagerImpl::invalidateUserByName(OperationContext* opCtx,
     CacheGuard guard(opCtx, this);
     _updateCacheGeneration_inlock(guard);
     LOG(2) << "Invalidating user " << userName;
-    _userCache.invalidate(userName);
+    _getUserCache(userName).invalidate(userName);
 }
 
 void AuthorizationManagerImpl::invalidateUsersFromDB(OperationContext* opCtx, StringData dbname) {
     CacheGuard guard(opCtx, this);
     _updateCacheGeneration_inlock(guard);
     LOG(2) << "Invalidating all users from database " << dbname;
-    _userCache.invalidateIf(
-        [&](const UserName& user, const User*) { return user.getDB() == dbname; });
+    _invalidateUsersIf([&](const UserName& user, const User*) { return user.getDB() == dbname; });
 }
 
 void AuthorizationManagerImpl::invalidateUserCache(OperationContext* opCtx) {
@@ -754,7 +775,7 @@ void AuthorizationManagerImpl::invalidateUserCache(OperationContext* opCtx) {
 
 void AuthorizationManagerImpl::_invalidateUserCache_inlock(const CacheGuard& guard) {
     _updateCacheGeneration_inlock(guard);
-    _userCache.invalidateIf([](const UserName& a, const User*) { return true; });
+    _invalidateUsersIf([](const UserName& a, const User*) { return true; });
 
     // Reread the schema version before acquiring the next user.
     _version = schemaVersionInvalid;
@@ -846,13 +867,14 @@ void AuthorizationManagerImpl::logOp(OperationContext* opCtx,
 
 std::vector<AuthorizationManager::CachedUserInfo> AuthorizationManagerImpl::getUserCacheInfo()
     const {
-    auto cacheData = _userCache.getCacheInfo();
     std::vector<AuthorizationManager::CachedUserInfo> ret;
-    ret.reserve(cacheData.size());
-    std::transform(
-        cacheData.begin(), cacheData.end(), std::back_inserter(ret), [](const auto& info) {
-            return AuthorizationManager::CachedUserInfo{info.key, info.active};
-        });
+    for (const auto& userCache : _userCaches) {
+        auto cacheData = userCache->getCacheInfo();
+        std::transform(
+            cacheData.begin(), cacheData.end(), std::back_inserter(ret), [](const auto& info) {
+                return AuthorizationManager::CachedUserInfo{info.key, info.active};
+            });
+    }
 
     return ret;
 }
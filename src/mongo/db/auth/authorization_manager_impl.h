@@ -225,12 +225,25 @@ private:
      * go to disk to read user privilege documents whenever possible.  Every User object
      * has a reference count - the AuthorizationManager must not delete a User object in the
      * cache unless its reference count is zero.
+     *
+     * The cache is split into kUserCachePartitions partitions by the hash of the user name, each
+     * with its own mutex, so that concurrent lookups of different users rarely contend. Each
+     * partition holds its share of authorizationManagerCacheSize users.
      */
     struct UserCacheInvalidator {
         void operator()(User* user);
     };
 
-    InvalidatingLRUCache<UserName, User, UserCacheInvalidator> _userCache;
+    using UserCache = InvalidatingLRUCache<UserName, User, UserCacheInvalidator>;
+
+    static constexpr size_t kUserCachePartitions = 8;
+
+    UserCache& _getUserCache(const UserName& userName);
+
+    template <typename Pred>
+    void _invalidateUsersIf(Pred predicate);
+
+    std::vector<std::unique_ptr<UserCache>> _userCaches;
 
     Mutex _pinnedUsersMutex = MONGO_MAKE_LATCH("AuthorizationManagerImpl::_pinnedUsersMutex");
     stdx::condition_variable _pinnedUsersCond;
@@ -250,7 +263,7 @@ private:
     OID _fetchGeneration;
 
     /**
-     * True if there is an update to the _userCache in progress, and that update is currently in
+     * True if there is an update to the user cache in progress, and that update is currently in
      * the "fetch phase", during which it does not hold the _cacheMutex.
      *
      * Manipulated via CacheGuard.
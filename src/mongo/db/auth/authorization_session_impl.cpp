@@ -874,38 +874,60 @@ bool AuthorizationSessionImpl::isAuthorizedForAnyActionOnResource(const Resource
 bool AuthorizationSessionImpl::_isAuthorizedForPrivilege(const Privilege& privilege) {
     const ResourcePattern& target(privilege.getResourcePattern());
 
-    ResourcePattern resourceSearchList[resourceSearchListCapacity];
-    const int resourceSearchListLength = buildResourceSearchList(target, resourceSearchList);
-
     ActionSet unmetRequirements = privilege.getActions();
 
     PrivilegeVector defaultPrivileges = getDefaultPrivileges();
-    for (PrivilegeVector::iterator it = defaultPrivileges.begin(); it != defaultPrivileges.end();
-         ++it) {
-        for (int i = 0; i < resourceSearchListLength; ++i) {
-            if (!(it->getResourcePattern() == resourceSearchList[i]))
-                continue;
+    if (!defaultPrivileges.empty()) {
+        ResourcePattern resourceSearchList[resourceSearchListCapacity];
+        const int resourceSearchListLength = buildResourceSearchList(target, resourceSearchList);
 
-            ActionSet userActions = it->getActions();
-            unmetRequirements.removeAllActionsFromSet(userActions);
+        for (const auto& defaultPrivilege : defaultPrivileges) {
+            for (int i = 0; i < resourceSearchListLength; ++i) {
+                if (!(defaultPrivilege.getResourcePattern() == resourceSearchList[i]))
+                    continue;
 
-            if (unmetRequirements.empty())
-                return true;
+                ActionSet userActions = defaultPrivilege.getActions();
+                unmetRequirements.removeAllActionsFromSet(userActions);
+
+                if (unmetRequirements.empty())
+                    return true;
+            }
         }
     }
 
+    return _getGrantedActions(target).isSupersetOf(unmetRequirements);
+}
+
+const ActionSet& AuthorizationSessionImpl::_getGrantedActions(const ResourcePattern& target) {
+    // Enough for the namespaces a typical connection works with, while bounding the memory of
+    // connections which touch many, such as listDatabases over many databases.
+    static constexpr size_t kMaxCachedResources = 256;
+
+    if (_grantedActionsGeneration != _authenticatedUsers.getGeneration()) {
+        _grantedActionsCache.clear();
+        _grantedActionsGeneration = _authenticatedUsers.getGeneration();
+    }
+
+    auto it = _grantedActionsCache.find(target);
+    if (it != _grantedActionsCache.end()) {
+        return it->second;
+    }
+
+    if (_grantedActionsCache.size() >= kMaxCachedResources) {
+        _grantedActionsCache.clear();
+    }
+
+    ResourcePattern resourceSearchList[resourceSearchListCapacity];
+    const int resourceSearchListLength = buildResourceSearchList(target, resourceSearchList);
+
+    ActionSet grantedActions;
     for (const auto& user : _authenticatedUsers) {
         for (int i = 0; i < resourceSearchListLength; ++i) {
-            ActionSet userActions = user->getActionsForResource(resourceSearchList[i]);
-            unmetRequirements.removeAllActionsFromSet(userActions);
-
-            if (unmetRequirements.empty()) {
-                return true;
-            }
+            grantedActions.addAllActionsFromSet(user->getActionsForResource(resourceSearchList[i]));
         }
     }
 
-    return false;
+    return _grantedActionsCache.emplace(target, std::move(grantedActions)).first->second;
 }
 
 void AuthorizationSessionImpl::setImpersonatedUserData(std::vector<UserName> usernames,
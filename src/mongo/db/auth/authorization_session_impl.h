@@ -41,7 +41,9 @@
 #include "mongo/db/auth/privilege.h"
 #include "mongo/db/auth/user_name.h"
 #include "mongo/db/auth/user_set.h"
+#include "mongo/db/auth/resource_pattern.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 
@@ -218,6 +220,10 @@ private:
     // lock on the admin database (to update out-of-date user privilege information).
     bool _isAuthorizedForPrivilege(const Privilege& privilege);
 
+    // Returns the actions the authenticated users are granted on "target", through any of the
+    // resource patterns matching it, from _grantedActionsCache if possible.
+    const ActionSet& _getGrantedActions(const ResourcePattern& target);
+
     std::tuple<std::vector<UserName>*, std::vector<RoleName>*> _getImpersonations() override {
         return std::make_tuple(&_impersonatedUserNames, &_impersonatedRoleNames);
     }
@@ -229,5 +235,11 @@ private:
     std::vector<UserName> _impersonatedUserNames;
     std::vector<RoleName> _impersonatedRoleNames;
     bool _impersonationFlag;
+
+    // The actions granted on recently checked resources, as computed by _getGrantedActions().
+    // Cleared whenever the generation of _authenticatedUsers moves past
+    // _grantedActionsGeneration, and when it grows too large.
+    stdx::unordered_map<ResourcePattern, ActionSet> _grantedActionsCache;
+    uint64_t _grantedActionsGeneration = 0;
 };
 }  // namespace mongo
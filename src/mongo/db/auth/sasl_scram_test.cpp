@@ -648,5 +648,38 @@ TEST(SCRAMCache, testSetAndReset) {
     testSetAndReset<SHA256Block>();
 }
 
+template <typename HashBlock>
+void testGetOrComputeSharesSecretsAcrossHosts() {
+    SCRAMClientCache<HashBlock> cache;
+    const auto salt = scram::Presecrets<HashBlock>::generateSecureRandomSalt();
+    HostAndPort hostA("localhost:27017");
+    HostAndPort hostB("localhost:27018");
+
+    const auto presecrets = scram::Presecrets<HashBlock>("aaa", salt, 10000);
+    const auto secrets = cache.getOrComputeSecrets(hostA, presecrets);
+    ASSERT_TRUE(secrets);
+    ASSERT_TRUE(secrets.clientKey() == scram::Secrets<HashBlock>(presecrets).clientKey());
+
+    // The secrets were cached for hostA, and are reused for hostB, which shares the presecrets.
+    ASSERT_TRUE(cache.getCachedSecrets(hostA, presecrets));
+    ASSERT_FALSE(cache.getCachedSecrets(hostB, presecrets));
+    const auto secretsB = cache.getOrComputeSecrets(hostB, presecrets);
+    ASSERT_TRUE(secrets.clientKey() == secretsB.clientKey());
+    ASSERT_TRUE(cache.getCachedSecrets(hostB, presecrets));
+
+    // Different presecrets are computed afresh.
+    const auto otherSalt = scram::Presecrets<HashBlock>::generateSecureRandomSalt();
+    const auto otherPresecrets = scram::Presecrets<HashBlock>("aaa", otherSalt, 10000);
+    const auto otherSecrets = cache.getOrComputeSecrets(hostB, otherPresecrets);
+    ASSERT_FALSE(secrets.clientKey() == otherSecrets.clientKey());
+    ASSERT_FALSE(cache.getCachedSecrets(hostB, presecrets));
+    ASSERT_TRUE(cache.getCachedSecrets(hostA, presecrets));
+}
+
+TEST(SCRAMCache, testGetOrComputeSharesSecretsAcrossHosts) {
+    testGetOrComputeSharesSecretsAcrossHosts<SHA1Block>();
+    testGetOrComputeSharesSecretsAcrossHosts<SHA256Block>();
+}
+
 }  // namespace
 }  // namespace mongo
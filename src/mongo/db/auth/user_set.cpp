@@ -77,6 +77,7 @@ void UserSet::add(UserHandle user) {
     } else {
         *it = std::move(user);
     }
+    ++_generation;
 }
 
 void UserSet::removeByDBName(StringData dbname) {
@@ -85,15 +86,18 @@ void UserSet::removeByDBName(StringData dbname) {
     });
     if (it != _users.end()) {
         _users.erase(it);
+        ++_generation;
     }
 }
 
 void UserSet::replaceAt(iterator it, UserHandle replacement) {
     *it = std::move(replacement);
+    ++_generation;
 }
 
 void UserSet::removeAt(iterator it) {
     _users.erase(it);
+    ++_generation;
 }
 
 UserHandle UserSet::lookup(const UserName& name) const {
@@ -109,10 +109,20 @@ public:
         return _users.end();
     }
 
+    /**
+     * Returns a number which changes whenever a user is added, replaced or removed, so callers can
+     * tell whether information derived from the set is still current.
+     */
+    uint64_t getGeneration() const {
+        return _generation;
+    }
+
 private:
     // The UserSet maintains ownership of the Users in it, and is responsible for
     // returning them to the AuthorizationManager when done with them.
     std::list<UserHandle> _users;
+
+    uint64_t _generation = 0;
 };
 
 }  // namespace mongo
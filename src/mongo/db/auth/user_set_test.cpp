@@ -108,5 +108,25 @@ TEST(UserSetTest, IterateNames) {
     ASSERT(!iter.more());
 }
 
+TEST(UserSetTest, GenerationAdvancesOnMutation) {
+    UserSet set;
+    auto generation = set.getGeneration();
+
+    set.add(std::make_shared<User>(UserName("Bob", "test")));
+    ASSERT_GT(set.getGeneration(), generation);
+    generation = set.getGeneration();
+
+    // Lookups do not change the set.
+    set.lookup(UserName("Bob", "test"));
+    ASSERT_EQUALS(set.getGeneration(), generation);
+
+    // Removing a database with no authenticated user does not change the set.
+    set.removeByDBName("test2"_sd);
+    ASSERT_EQUALS(set.getGeneration(), generation);
+
+    set.removeByDBName("test"_sd);
+    ASSERT_GT(set.getGeneration(), generation);
+}
+
 }  // namespace
 }  // namespace mongo
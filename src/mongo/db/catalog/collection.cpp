@@ -33,8 +33,12 @@
 
 #include "mongo/db/catalog/collection.h"
 
+#include <algorithm>
 #include <sstream>
 
+#include "mongo/db/catalog/capped_insert_notifier_gen.h"
+#include "mongo/util/scopeguard.h"
+
 namespace mongo {
 
 //
@@ -44,22 +48,76 @@ namespace mongo {
 void CappedInsertNotifier::notifyAll() {
     stdx::lock_guard<Latch> lk(_mutex);
     ++_version;
-    _notifier.notify_all();
+
+    const auto now = Clock::now();
+    const stdx::chrono::microseconds coalesceInterval(gCappedInsertNotifierCoalesceMicros.load());
+    if (!_hasTimekeeper || now >= _lastWakeup + coalesceInterval) {
+        _wakeAll(lk, now);
+        return;
+    }
+
+    // The waiting threads were woken recently. Leave it to the timekeeper to wake them once the
+    // interval has passed, which also covers every other insert made until then.
+    if (!_wakeupDeferred) {
+        _wakeupDeferred = true;
+        _deferredWakeupNotifier.notify_one();
+    }
 }
 
 void CappedInsertNotifier::waitUntil(uint64_t prevVersion, Date_t deadline) const {
     stdx::unique_lock<Latch> lk(_mutex);
-    while (!_dead && prevVersion == _version) {
+    while (!_dead && prevVersion == _version && _hasTimekeeper) {
         if (stdx::cv_status::timeout == _notifier.wait_until(lk, deadline.toSystemTimePoint())) {
             return;
         }
     }
+    if (_dead || prevVersion != _version) {
+        return;
+    }
+
+    // Become the timekeeper, which must not leave while it has a deferred wakeup to deliver.
+    _hasTimekeeper = true;
+    ON_BLOCK_EXIT([&] {
+        _hasTimekeeper = false;
+        // Hand the role over to another waiting thread, if there is one.
+        _notifier.notify_one();
+    });
+
+    while (!_dead) {
+        if (_wakeupDeferred) {
+            const auto now = Clock::now();
+            const auto wakeupAt = _lastWakeup +
+                stdx::chrono::microseconds(gCappedInsertNotifierCoalesceMicros.load());
+            const auto untilDeadline =
+                deadline.toSystemTimePoint() - stdx::chrono::system_clock::now();
+            if (now >= wakeupAt || untilDeadline <= untilDeadline.zero()) {
+                _wakeAll(lk, now);
+                return;
+            }
+            _deferredWakeupNotifier.wait_for(
+                lk,
+                std::min(wakeupAt - now,
+                         stdx::chrono::duration_cast<Clock::duration>(untilDeadline)));
+        } else if (prevVersion != _version ||
+                   stdx::cv_status::timeout ==
+                       _deferredWakeupNotifier.wait_until(lk, deadline.toSystemTimePoint())) {
+            return;
+        }
+    }
 }
 
 void CappedInsertNotifier::kill() {
     stdx::lock_guard<Latch> lk(_mutex);
     _dead = true;
     _notifier.notify_all();
+    _deferredWakeupNotifier.notify_all();
+}
+
+void CappedInsertNotifier::_wakeAll(WithLock, Clock::time_point now) const {
+    _lastWakeup = now;
+    _wakeupDeferred = false;
+    _notifier.notify_all();
+    _deferredWakeupNotifier.notify_all();
 }
 
 bool CappedInsertNotifier::isDead() {
@@ -53,6 +53,8 @@
 #include "mongo/db/storage/snapshot.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/chrono.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/decorable.h"
 
 namespace mongo {
@@ -93,6 +95,10 @@ struct CollectionUpdateArgs {
     bool fromMigrate = false;
 
     StoreDocOption storeDocOption = StoreDocOption::None;
+
+    // Set when the collection records post-images for change streams, in which case the oplog
+    // gets 'updatedDoc' even when the write is not retryable.
+    bool recordPostImage = false;
 };
 
 /**
@@ -102,7 +108,9 @@ struct CollectionUpdateArgs {
 class CappedInsertNotifier {
 public:
     /**
-     * Wakes up all threads waiting.
+     * Wakes up all threads waiting. If 'cappedInsertNotifierCoalesceMicros' is set and the
+     * waiting threads were woken less than that long ago, the wakeup is instead deferred to the
+     * end of the interval, together with any other notifications made until then.
      */
     void notifyAll();
 
@@ -132,9 +140,16 @@ public:
     bool isDead();
 
 private:
+    using Clock = stdx::chrono::steady_clock;
+
+    void _wakeAll(WithLock, Clock::time_point now) const;
+
     // Signalled when a successful insert is made into a capped collection.
     mutable stdx::condition_variable _notifier;
 
+    // Signalled when a wakeup is deferred, for the waiting thread which delivers it.
+    mutable stdx::condition_variable _deferredWakeupNotifier;
+
     // Mutex used with '_notifier'. Protects access to '_version'.
     mutable Mutex _mutex = MONGO_MAKE_LATCH("CappedInsertNotifier::_mutex");
 
@@ -146,6 +161,13 @@ private:
 
     // True once the notifier is dead.
     bool _dead = false;
+
+    // The time of the last wakeup, and whether a notification is waiting for the next one. One of
+    // the waiting threads at a time, the timekeeper, delivers deferred wakeups; all other threads
+    // wait on '_notifier' alone. Access is synchronized with '_mutex'.
+    mutable Clock::time_point _lastWakeup;
+    mutable bool _wakeupDeferred = false;
+    mutable bool _hasTimekeeper = false;
 };
 
 class Collection : public Decorable<Collection> {
@@ -236,6 +258,8 @@ public:
      * 'opDebug' Optional argument. When not null, will be used to record operation statistics.
      * 'noWarn' if unindexing the record causes an error, if noWarn is true the error
      * will not be logged.
+     * 'oplogSlot' if not null, the optime reserved for the oplog entry of the delete. The storage
+     * write is timestamped with it, so that several deletes can share one WriteUnitOfWork.
      */
     virtual void deleteDocument(OperationContext* const opCtx,
                                 StmtId stmtId,
@@ -243,7 +267,8 @@ public:
                                 OpDebug* const opDebug,
                                 const bool fromMigrate = false,
                                 const bool noWarn = false,
-                                StoreDeletedDoc storeDeletedDoc = StoreDeletedDoc::Off) = 0;
+                                StoreDeletedDoc storeDeletedDoc = StoreDeletedDoc::Off,
+                                const repl::OplogSlot& oplogSlot = repl::OplogSlot()) = 0;
 
     /*
      * Inserts all documents inside one WUOW.
@@ -280,13 +305,15 @@ public:
     /**
      * Inserts a document into the record store for a bulk loader that manages the index building
      * outside this Collection. The bulk loader is notified with the RecordId of the document
-     * inserted into the RecordStore.
+     * inserted into the RecordStore. If 'bulkInserter' is not null, the document is written
+     * through it instead of RecordStore::insertRecords().
      *
      * NOTE: It is up to caller to commit the indexes.
      */
     virtual Status insertDocumentForBulkLoader(OperationContext* const opCtx,
                                                const BSONObj& doc,
-                                               const OnRecordInsertedFn& onRecordInserted) = 0;
+                                               const OnRecordInsertedFn& onRecordInserted,
+                                               BulkRecordInserter* bulkInserter) = 0;
 
     /**
      * Updates the document @ oldLocation with newDoc.
@@ -388,6 +415,12 @@ public:
      */
     virtual bool isTemporary(OperationContext* opCtx) const = 0;
 
+    /**
+     * Returns true if updates to this collection write the post-image of each updated document to
+     * the oplog, as requested by the 'recordPostImages' collection option.
+     */
+    virtual bool getRecordPostImages() const = 0;
+
     //
     // Stats
     //
@@ -32,6 +32,9 @@
 
 #include "collection_catalog.h"
 
+#include <array>
+#include <limits>
+
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/concurrency/lock_manager_defs.h"
 #include "mongo/db/storage/recovery_unit.h"
@@ -44,6 +47,10 @@ namespace {
 const ServiceContext::Decoration<CollectionCatalog> getCatalog =
     ServiceContext::declareDecoration<CollectionCatalog>();
 
+// Source of CollectionCatalog::_catalogId. Zero is never handed out, so that it can mean "nothing
+// cached" in the per-thread snapshot cache.
+AtomicWord<uint64_t> nextCatalogId{1};
+
 class FinishDropCollectionChange : public RecoveryUnit::Change {
 public:
     FinishDropCollectionChange(CollectionCatalog* catalog,
@@ -67,6 +74,169 @@ private:
 
 }  // namespace
 
+/**
+ * The snapshot maps are split into shards by key hash, so that publishing a DDL change only copies
+ * the shards holding the entries it touches, plus the array of shard pointers. A published
+ * snapshot is never modified; shards are shared between successive snapshots.
+ */
+struct CollectionCatalog::Snapshot {
+    static constexpr int kShardBits = 8;
+    static constexpr size_t kNumShards = size_t{1} << kShardBits;
+
+    struct UUIDEntry {
+        Collection* collection;
+        NamespaceString nss;
+    };
+
+    struct NamespaceEntry {
+        Collection* collection;
+        CollectionUUID uuid;
+    };
+
+    using UUIDShard = stdx::unordered_map<CollectionUUID, UUIDEntry, CollectionUUID::Hash>;
+    using NamespaceShard = stdx::unordered_map<NamespaceString, NamespaceEntry>;
+    using ShadowCatalogMap =
+        stdx::unordered_map<CollectionUUID, NamespaceString, CollectionUUID::Hash>;
+
+    // Picks the shard from the top bits of the hash, which the shard's own hash table does not use
+    // to place entries, so that each shard still sees well distributed hashes.
+    static size_t shardIndex(const CollectionUUID& uuid) {
+        return _topBits(absl::Hash<std::size_t>{}(CollectionUUID::Hash{}(uuid)));
+    }
+
+    static size_t shardIndex(const NamespaceString& nss) {
+        return _topBits(absl::Hash<NamespaceString>{}(nss));
+    }
+
+    const UUIDEntry* find(const CollectionUUID& uuid) const {
+        return _find(uuidShards[shardIndex(uuid)], uuid);
+    }
+
+    const NamespaceEntry* find(const NamespaceString& nss) const {
+        return _find(namespaceShards[shardIndex(nss)], nss);
+    }
+
+    std::array<std::shared_ptr<const UUIDShard>, kNumShards> uuidShards;
+    std::array<std::shared_ptr<const NamespaceShard>, kNumShards> namespaceShards;
+
+    // When set, the catalog is in closed state and this maps UUIDs to their pre-close namespace.
+    // See onCloseCatalog.
+    std::shared_ptr<const ShadowCatalogMap> shadowCatalog;
+
+private:
+    static size_t _topBits(std::size_t hash) {
+        return hash >> (std::numeric_limits<std::size_t>::digits - kShardBits);
+    }
+
+    template <typename Shard, typename Key>
+    static const typename Shard::mapped_type* _find(const std::shared_ptr<const Shard>& shard,
+                                                    const Key& key) {
+        if (!shard) {
+            return nullptr;
+        }
+        auto it = shard->find(key);
+        return it == shard->end() ? nullptr : &it->second;
+    }
+};
+
+/**
+ * Builds the next snapshot from the current one. Each shard that gets modified is copied the first
+ * time it is touched; all others stay shared with the current snapshot.
+ */
+class CollectionCatalog::SnapshotBuilder {
+public:
+    explicit SnapshotBuilder(const Snapshot& current)
+        : _snapshot(std::make_shared<Snapshot>(current)) {}
+
+    void insert(CollectionUUID uuid, Collection* coll, const NamespaceString& nss) {
+        _mutableShard(_snapshot->uuidShards, _uuidShards, uuid)
+            .insert_or_assign(uuid, Snapshot::UUIDEntry{coll, nss});
+        _mutableShard(_snapshot->namespaceShards, _namespaceShards, nss)
+            .insert_or_assign(nss, Snapshot::NamespaceEntry{coll, uuid});
+    }
+
+    void erase(CollectionUUID uuid, const NamespaceString& nss) {
+        _mutableShard(_snapshot->uuidShards, _uuidShards, uuid).erase(uuid);
+        _mutableShard(_snapshot->namespaceShards, _namespaceShards, nss).erase(nss);
+    }
+
+    void rename(const NamespaceString& from, const NamespaceString& to) {
+        auto& fromShard = _mutableShard(_snapshot->namespaceShards, _namespaceShards, from);
+        auto it = fromShard.find(from);
+        invariant(it != fromShard.end());
+        auto entry = it->second;
+        fromShard.erase(it);
+
+        _mutableShard(_snapshot->namespaceShards, _namespaceShards, to).insert_or_assign(to, entry);
+
+        auto& uuidShard = _mutableShard(_snapshot->uuidShards, _uuidShards, entry.uuid);
+        auto uuidIt = uuidShard.find(entry.uuid);
+        invariant(uuidIt != uuidShard.end());
+        uuidIt->second.nss = to;
+    }
+
+    void setShadowCatalog(std::shared_ptr<const Snapshot::ShadowCatalogMap> shadowCatalog) {
+        _snapshot->shadowCatalog = std::move(shadowCatalog);
+    }
+
+    std::shared_ptr<const Snapshot> finish() {
+        return std::move(_snapshot);
+    }
+
+private:
+    template <typename T>
+    using ShardArray = std::array<std::shared_ptr<T>, Snapshot::kNumShards>;
+
+    template <typename Shard, typename Key>
+    static Shard& _mutableShard(ShardArray<const Shard>& shards,
+                                ShardArray<Shard>& copies,
+                                const Key& key) {
+        auto index = Snapshot::shardIndex(key);
+        auto& copy = copies[index];
+        if (!copy) {
+            copy = shards[index] ? std::make_shared<Shard>(*shards[index])
+                                 : std::make_shared<Shard>();
+            shards[index] = copy;
+        }
+        return *copy;
+    }
+
+    std::shared_ptr<Snapshot> _snapshot;
+
+    // The shards of '_snapshot' copied so far, which are not yet visible to any reader.
+    ShardArray<Snapshot::UUIDShard> _uuidShards;
+    ShardArray<Snapshot::NamespaceShard> _namespaceShards;
+};
+
+CollectionCatalog::CollectionCatalog()
+    : _catalogId(nextCatalogId.fetchAndAdd(1)), _snapshot(std::make_shared<Snapshot>()) {}
+
+const CollectionCatalog::Snapshot* CollectionCatalog::_getSnapshot() const {
+    // The snapshot this thread read last. Keeping a reference to it here, rather than copying the
+    // shared_ptr on every lookup, avoids having all readers write to the same reference count.
+    struct CachedSnapshot {
+        uint64_t catalogId = 0;
+        uint64_t version = 0;
+        std::shared_ptr<const Snapshot> snapshot;
+    };
+    static thread_local CachedSnapshot cached;
+
+    if (cached.catalogId == _catalogId && cached.version == _snapshotVersion.load()) {
+        return cached.snapshot.get();
+    }
+
+    stdx::lock_guard<Latch> lock(_catalogLock);
+    cached.catalogId = _catalogId;
+    cached.version = _snapshotVersion.load();
+    cached.snapshot = _snapshot;
+    return cached.snapshot.get();
+}
+
+void CollectionCatalog::_publishSnapshot(WithLock, std::shared_ptr<const Snapshot> snapshot) {
+    _snapshot = std::move(snapshot);
+    _snapshotVersion.fetchAndAdd(1);
+}
+
 CollectionCatalog::iterator::iterator(StringData dbName,
                                       uint64_t genNum,
                                       const CollectionCatalog& catalog)
@@ -174,14 +344,11 @@ void CollectionCatalog::setCollectionNamespace(OperationContext* opCtx,
                                                Collection* coll,
                                                const NamespaceString& fromCollection,
                                                const NamespaceString& toCollection) {
-    // Rather than maintain, in addition to the UUID -> Collection* mapping, an auxiliary
-    // data structure with the UUID -> namespace mapping, the CollectionCatalog relies on
-    // Collection::ns() to provide UUID to namespace lookup. In addition, the CollectionCatalog
-    // does not require callers to hold locks.
-    //
-    // This means that Collection::ns() may be called while only '_catalogLock' (and no lock
-    // manager locks) are held. The purpose of this function is ensure that we write to the
-    // Collection's namespace string under '_catalogLock'.
+    // The CollectionCatalog does not require callers to hold locks. Lookups from UUID to
+    // namespace are answered from the snapshot, which keeps its own copy of the namespace, while
+    // Collection::ns() may still be called with only '_catalogLock' (and no lock manager locks)
+    // held. The purpose of this function is to ensure that we write to the Collection's namespace
+    // string under '_catalogLock', and that the snapshot is updated along with it.
     invariant(coll);
     stdx::lock_guard<Latch> lock(_catalogLock);
 
@@ -190,6 +357,10 @@ void CollectionCatalog::setCollectionNamespace(OperationContext* opCtx,
     _collections[toCollection] = _collections[fromCollection];
     _collections.erase(fromCollection);
 
+    SnapshotBuilder builder(*_snapshot);
+    builder.rename(fromCollection, toCollection);
+    _publishSnapshot(lock, builder.finish());
+
     ResourceId oldRid = ResourceId(RESOURCE_COLLECTION, fromCollection.ns());
     ResourceId newRid = ResourceId(RESOURCE_COLLECTION, toCollection.ns());
 
@@ -203,6 +374,10 @@ void CollectionCatalog::setCollectionNamespace(OperationContext* opCtx,
         _collections[fromCollection] = _collections[toCollection];
         _collections.erase(toCollection);
 
+        SnapshotBuilder builder(*_snapshot);
+        builder.rename(toCollection, fromCollection);
+        _publishSnapshot(lock, builder.finish());
+
         ResourceId oldRid = ResourceId(RESOURCE_COLLECTION, fromCollection.ns());
         ResourceId newRid = ResourceId(RESOURCE_COLLECTION, toCollection.ns());
 
@@ -220,22 +395,29 @@ void CollectionCatalog::onCloseDatabase(OperationContext* opCtx, std::string dbN
 void CollectionCatalog::onCloseCatalog(OperationContext* opCtx) {
     invariant(opCtx->lockState()->isW());
     stdx::lock_guard<Latch> lock(_catalogLock);
-    invariant(!_shadowCatalog);
-    _shadowCatalog.emplace();
+    invariant(!_snapshot->shadowCatalog);
+    auto shadowCatalog = std::make_shared<Snapshot::ShadowCatalogMap>();
     for (auto& entry : _catalog)
-        _shadowCatalog->insert({entry.first, entry.second->ns()});
+        shadowCatalog->insert({entry.first, entry.second->ns()});
+
+    SnapshotBuilder builder(*_snapshot);
+    builder.setShadowCatalog(std::move(shadowCatalog));
+    _publishSnapshot(lock, builder.finish());
 }
 
 void CollectionCatalog::onOpenCatalog(OperationContext* opCtx) {
     invariant(opCtx->lockState()->isW());
     stdx::lock_guard<Latch> lock(_catalogLock);
-    invariant(_shadowCatalog);
-    _shadowCatalog.reset();
+    invariant(_snapshot->shadowCatalog);
+
+    SnapshotBuilder builder(*_snapshot);
+    builder.setShadowCatalog(nullptr);
+    _publishSnapshot(lock, builder.finish());
 }
 
 Collection* CollectionCatalog::lookupCollectionByUUID(CollectionUUID uuid) const {
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    return _lookupCollectionByUUID(lock, uuid);
+    auto entry = _getSnapshot()->find(uuid);
+    return entry ? entry->collection : nullptr;
 }
 
 Collection* CollectionCatalog::_lookupCollectionByUUID(WithLock, CollectionUUID uuid) const {
@@ -244,26 +426,23 @@ Collection* CollectionCatalog::_lookupCollectionByUUID(WithLock, CollectionUUID
 }
 
 Collection* CollectionCatalog::lookupCollectionByNamespace(const NamespaceString& nss) const {
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto it = _collections.find(nss);
-    return it == _collections.end() ? nullptr : it->second;
+    auto entry = _getSnapshot()->find(nss);
+    return entry ? entry->collection : nullptr;
 }
 
 boost::optional<NamespaceString> CollectionCatalog::lookupNSSByUUID(CollectionUUID uuid) const {
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto foundIt = _catalog.find(uuid);
-    if (foundIt != _catalog.end()) {
-        NamespaceString ns = foundIt->second->ns();
-        invariant(!ns.isEmpty());
-        return ns;
+    auto snapshot = _getSnapshot();
+    if (auto entry = snapshot->find(uuid)) {
+        invariant(!entry->nss.isEmpty());
+        return entry->nss;
     }
 
     // Only in the case that the catalog is closed and a UUID is currently unknown, resolve it
     // using the pre-close state. This ensures that any tasks reloading the catalog can see their
     // own updates.
-    if (_shadowCatalog) {
-        auto shadowIt = _shadowCatalog->find(uuid);
-        if (shadowIt != _shadowCatalog->end())
+    if (auto& shadowCatalog = snapshot->shadowCatalog) {
+        auto shadowIt = shadowCatalog->find(uuid);
+        if (shadowIt != shadowCatalog->end())
             return shadowIt->second;
     }
     return boost::none;
@@ -271,19 +450,11 @@ boost::optional<NamespaceString> CollectionCatalog::lookupNSSByUUID(CollectionUU
 
 boost::optional<CollectionUUID> CollectionCatalog::lookupUUIDByNSS(
     const NamespaceString& nss) const {
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
-    auto it = _orderedCollections.lower_bound(std::make_pair(nss.db().toString(), minUuid));
-
-    // The entry _mapIter points to is valid if it's not at the end of _orderedCollections and
-    // the entry's database is the same as dbName.
-    while (it != _orderedCollections.end() && it->first.first == nss.db()) {
-        if (it->second->ns() == nss) {
-            return it->first.second;
-        }
-        ++it;
+    auto entry = _getSnapshot()->find(nss);
+    if (!entry) {
+        return boost::none;
     }
-    return boost::none;
+    return entry->uuid;
 }
 
 NamespaceString CollectionCatalog::resolveNamespaceStringOrUUID(NamespaceStringOrUUID nsOrUUID) {
@@ -383,6 +554,10 @@ void CollectionCatalog::registerCollection(CollectionUUID uuid, std::unique_ptr<
     _collections[ns] = _catalog[uuid].get();
     _orderedCollections[dbIdPair] = _catalog[uuid].get();
 
+    SnapshotBuilder builder(*_snapshot);
+    builder.insert(uuid, _catalog[uuid].get(), ns);
+    _publishSnapshot(lock, builder.finish());
+
     auto dbRid = ResourceId(RESOURCE_DATABASE, dbName);
     addResource(dbRid, dbName);
 
@@ -410,6 +585,10 @@ std::unique_ptr<Collection> CollectionCatalog::deregisterCollection(CollectionUU
     _collections.erase(ns);
     _catalog.erase(uuid);
 
+    SnapshotBuilder builder(*_snapshot);
+    builder.erase(uuid, ns);
+    _publishSnapshot(lock, builder.finish());
+
     auto collRid = ResourceId(RESOURCE_COLLECTION, ns.ns());
     removeResource(collRid, ns.ns());
 
@@ -444,6 +623,11 @@ void CollectionCatalog::deregisterAllCollections() {
     _orderedCollections.clear();
     _catalog.clear();
 
+    // Start over from an empty snapshot rather than erasing every entry, keeping the closed state.
+    auto emptySnapshot = std::make_shared<Snapshot>();
+    emptySnapshot->shadowCatalog = _snapshot->shadowCatalog;
+    _publishSnapshot(lock, std::move(emptySnapshot));
+
     stdx::lock_guard<Latch> resourceLock(_resourceLock);
     _resourceInformation.clear();
 
@@ -31,10 +31,12 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/uuid.h"
 
@@ -97,7 +99,7 @@ public:
 
     static CollectionCatalog& get(ServiceContext* svcCtx);
     static CollectionCatalog& get(OperationContext* opCtx);
-    CollectionCatalog() = default;
+    CollectionCatalog();
 
     /**
      * This function is responsible for safely setting the namespace string inside 'coll' to the
@@ -160,8 +162,7 @@ public:
     boost::optional<NamespaceString> lookupNSSByUUID(CollectionUUID uuid) const;
 
     /**
-     * Returns the UUID if `nss` exists in CollectionCatalog. The time complexity of
-     * this function is linear to the number of collections in `nss.db()`.
+     * Returns the UUID if `nss` exists in CollectionCatalog.
      */
     boost::optional<CollectionUUID> lookupUUIDByNSS(const NamespaceString& nss) const;
 
@@ -247,19 +248,39 @@ public:
 private:
     friend class CollectionCatalog::iterator;
 
+    /**
+     * Immutable copy of the UUID and namespace lookup maps, read by the lookup functions without
+     * taking '_catalogLock'. Defined in the .cpp file.
+     */
+    struct Snapshot;
+    class SnapshotBuilder;
+
     Collection* _lookupCollectionByUUID(WithLock, CollectionUUID uuid) const;
 
+    /**
+     * Returns the current snapshot. In the common case, where the catalog has not changed since
+     * this thread last read it, this is a single atomic load. The returned pointer stays valid
+     * until the calling thread calls this function again.
+     */
+    const Snapshot* _getSnapshot() const;
+
+    /**
+     * Makes 'snapshot' the current snapshot. Must be called with '_catalogLock' held.
+     */
+    void _publishSnapshot(WithLock, std::shared_ptr<const Snapshot> snapshot);
+
     const std::vector<CollectionUUID>& _getOrdering_inlock(const StringData& db,
                                                            const stdx::lock_guard<Latch>&);
     mutable mongo::Mutex _catalogLock;
 
-    /**
-     * When present, indicates that the catalog is in closed state, and contains a map from UUID
-     * to pre-close NSS. See also onCloseCatalog.
-     */
-    boost::optional<
-        mongo::stdx::unordered_map<CollectionUUID, NamespaceString, CollectionUUID::Hash>>
-        _shadowCatalog;
+    // Identifies this catalog in the per-thread snapshot cache.
+    const uint64_t _catalogId;
+
+    // The latest published snapshot, protected by '_catalogLock'. Readers that have a copy of it
+    // cached compare against '_snapshotVersion', which is bumped under '_catalogLock' whenever a
+    // new snapshot is published, instead of taking the lock.
+    std::shared_ptr<const Snapshot> _snapshot;
+    AtomicWord<uint64_t> _snapshotVersion{0};
 
     using CollectionCatalogMap = mongo::stdx::
         unordered_map<CollectionUUID, std::unique_ptr<Collection>, CollectionUUID::Hash>;
@@ -523,6 +523,47 @@ TEST_F(CollectionCatalogTest, RenameCollection) {
     ASSERT_EQUALS(catalog.lookupCollectionByUUID(uuid), collection);
 }
 
+TEST_F(CollectionCatalogTest, LookupsByNamespaceFollowRename) {
+    auto uuid = CollectionUUID::gen();
+    NamespaceString oldNss(nss.db(), "oldcol");
+    auto collUnique = std::make_unique<CollectionMock>(oldNss);
+    auto collection = collUnique.get();
+    catalog.registerCollection(uuid, std::move(collUnique));
+    ASSERT_EQUALS(catalog.lookupCollectionByNamespace(oldNss), collection);
+    ASSERT_EQUALS(*catalog.lookupUUIDByNSS(oldNss), uuid);
+
+    NamespaceString newNss(nss.db(), "newcol");
+    catalog.setCollectionNamespace(&opCtx, collection, oldNss, newNss);
+    ASSERT(catalog.lookupCollectionByNamespace(oldNss) == nullptr);
+    ASSERT_EQUALS(catalog.lookupUUIDByNSS(oldNss), boost::none);
+    ASSERT_EQUALS(catalog.lookupCollectionByNamespace(newNss), collection);
+    ASSERT_EQUALS(*catalog.lookupUUIDByNSS(newNss), uuid);
+    ASSERT_EQUALS(*catalog.lookupNSSByUUID(uuid), newNss);
+
+    // The collection registered by the fixture is unaffected.
+    ASSERT_EQUALS(catalog.lookupCollectionByNamespace(nss), col);
+    ASSERT_EQUALS(*catalog.lookupUUIDByNSS(nss), colUUID);
+}
+
+TEST_F(CollectionCatalogTest, LookupsDoNotMixUpCatalogs) {
+    // Interleave lookups against two catalogs on the same thread, so that each lookup has to
+    // notice that the snapshot it read last belongs to the other catalog.
+    CollectionCatalog otherCatalog;
+    ASSERT_EQUALS(catalog.lookupCollectionByUUID(colUUID), col);
+    ASSERT(otherCatalog.lookupCollectionByUUID(colUUID) == nullptr);
+    ASSERT_EQUALS(catalog.lookupCollectionByNamespace(nss), col);
+    ASSERT(otherCatalog.lookupCollectionByNamespace(nss) == nullptr);
+
+    auto otherUnique = std::make_unique<CollectionMock>(nss);
+    auto other = otherUnique.get();
+    otherCatalog.registerCollection(colUUID, std::move(otherUnique));
+    ASSERT_EQUALS(otherCatalog.lookupCollectionByUUID(colUUID), other);
+    ASSERT_EQUALS(catalog.lookupCollectionByUUID(colUUID), col);
+    otherCatalog.deregisterAllCollections();
+    ASSERT(otherCatalog.lookupCollectionByUUID(colUUID) == nullptr);
+    ASSERT_EQUALS(catalog.lookupCollectionByUUID(colUUID), col);
+}
+
 TEST_F(CollectionCatalogTest, LookupNSSByUUIDForClosedCatalogReturnsOldNSSIfDropped) {
     catalog.onCloseCatalog(&opCtx);
     catalog.deregisterCollection(colUUID);
@@ -35,11 +35,14 @@
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/catalog/index_key_validate.h"
 #include "mongo/db/catalog/multi_index_block.h"
+#include "mongo/db/client.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index_builds_coordinator.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/storage/sorted_data_interface.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
@@ -68,10 +71,16 @@ Collection* getCollectionForCompact(OperationContext* opCtx,
     return collection;
 }
 
+void setCompactMessage(OperationContext* opCtx, StringData message) {
+    stdx::lock_guard<Client> lk(*opCtx->getClient());
+    CurOp::get(opCtx)->setMessage_inlock(message);
+}
+
 }  // namespace
 
 StatusWith<int64_t> compactCollection(OperationContext* opCtx,
-                                      const NamespaceString& collectionNss) {
+                                      const NamespaceString& collectionNss,
+                                      int64_t* estimatedReclaimableBytes) {
     AutoGetDb autoDb(opCtx, collectionNss.db(), MODE_IX);
     Database* database = autoDb.getDb();
     uassert(ErrorCodes::NamespaceNotFound, "database does not exist", database);
@@ -108,11 +117,28 @@ StatusWith<int64_t> compactCollection(OperationContext* opCtx,
     auto oldTotalSize = recordStore->storageSize(opCtx) + collection->getIndexSize(opCtx);
     auto indexCatalog = collection->getIndexCatalog();
 
+    // Space the storage engine has allocated but not reused is all that compaction can give back.
+    int64_t reclaimableBytes = recordStore->freeStorageSize(opCtx);
+    const bool includeUnfinishedIndexes = false;
+    auto ii = indexCatalog->getIndexIterator(opCtx, includeUnfinishedIndexes);
+    while (ii->more()) {
+        reclaimableBytes +=
+            ii->next()->accessMethod()->getSortedDataInterface()->getFreeStorageBytes(opCtx);
+    }
+    if (estimatedReclaimableBytes) {
+        *estimatedReclaimableBytes = reclaimableBytes;
+    }
+    log() << "compact " << collectionNss << " estimated reclaimable bytes: " << reclaimableBytes;
+
+    setCompactMessage(opCtx,
+                      str::stream() << "compact: compacting collection, estimated reclaimable"
+                                    << " bytes: " << reclaimableBytes);
     Status status = recordStore->compact(opCtx);
     if (!status.isOK())
         return status;
 
     // Compact all indexes (not including unfinished indexes)
+    setCompactMessage(opCtx, "compact: compacting indexes");
     status = indexCatalog->compactIndexes(opCtx);
     if (!status.isOK())
         return status;
@@ -39,8 +39,13 @@ namespace mongo {
  *
  * Returns the number of bytes of stable storage and index size that were freed. If the total
  * size decreased, the return value is positive. Otherwise, the return value is negative.
+ *
+ * If 'estimatedReclaimableBytes' is not null, it is set before compacting to the number of bytes
+ * the storage engine has allocated to the collection and its indexes without using them, which
+ * is the most that compaction can free.
  */
 StatusWith<int64_t> compactCollection(OperationContext* opCtx,
-                                      const NamespaceString& collectionNss);
+                                      const NamespaceString& collectionNss,
+                                      int64_t* estimatedReclaimableBytes = nullptr);
 
 }  // namespace mongo
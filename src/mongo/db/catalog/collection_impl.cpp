@@ -232,6 +232,7 @@ void CollectionImpl::init(OperationContext* opCtx) {
         parseValidator(opCtx, _validatorDoc, MatchExpressionParser::kAllowAllSpecialFeatures));
     _validationAction = uassertStatusOK(_parseValidationAction(collectionOptions.validationAction));
     _validationLevel = uassertStatusOK(_parseValidationLevel(collectionOptions.validationLevel));
+    _recordPostImages = collectionOptions.recordPostImages;
 
     getIndexCatalog()->init(opCtx).transitional_ignore();
     _initialized = true;
@@ -439,7 +440,8 @@ Status CollectionImpl::insertDocument(OperationContext* opCtx,
 
 Status CollectionImpl::insertDocumentForBulkLoader(OperationContext* opCtx,
                                                    const BSONObj& doc,
-                                                   const OnRecordInsertedFn& onRecordInserted) {
+                                                   const OnRecordInsertedFn& onRecordInserted,
+                                                   BulkRecordInserter* bulkInserter) {
 
     auto status = checkFailCollectionInsertsFailPoint(_ns, doc);
     if (!status.isOK()) {
@@ -455,8 +457,9 @@ Status CollectionImpl::insertDocumentForBulkLoader(OperationContext* opCtx,
 
     // Using timestamp 0 for these inserts, which are non-oplog so we don't have an appropriate
     // timestamp to use.
-    StatusWith<RecordId> loc =
-        _recordStore->insertRecord(opCtx, doc.objdata(), doc.objsize(), Timestamp());
+    StatusWith<RecordId> loc = bulkInserter
+        ? bulkInserter->insertRecord(opCtx, doc.objdata(), doc.objsize())
+        : _recordStore->insertRecord(opCtx, doc.objdata(), doc.objsize(), Timestamp());
 
     if (!loc.isOK())
         return loc.getStatus();
@@ -482,6 +485,7 @@ Status CollectionImpl::insertDocumentForBulkLoader(OperationContext* opCtx,
     getGlobalServiceContext()->getOpObserver()->onInserts(
         opCtx, ns(), uuid(), inserts.begin(), inserts.end(), false);
 
+    CollectionQueryInfo::get(this).advanceWriteGenerationOnCommit(opCtx);
     opCtx->recoveryUnit()->onCommit(
         [this](boost::optional<Timestamp>) { notifyCappedWaitersIfNeeded(); });
 
@@ -542,6 +546,8 @@ Status CollectionImpl::_insertDocuments(OperationContext* opCtx,
     if (opDebug) {
         opDebug->additiveMetrics.incrementKeysInserted(keysInserted);
     }
+    CollectionQueryInfo::get(this).notifyOfWritesOnCommit(opCtx, count);
+    CollectionQueryInfo::get(this).advanceWriteGenerationOnCommit(opCtx);
 
     return status;
 }
@@ -587,13 +593,18 @@ void CollectionImpl::deleteDocument(OperationContext* opCtx,
                                     OpDebug* opDebug,
                                     bool fromMigrate,
                                     bool noWarn,
-                                    Collection::StoreDeletedDoc storeDeletedDoc) {
+                                    Collection::StoreDeletedDoc storeDeletedDoc,
+                                    const repl::OplogSlot& oplogSlot) {
     if (isCapped()) {
         log() << "failing remove on a capped ns " << _ns;
         uasserted(10089, "cannot remove from a capped collection");
         return;
     }
 
+    if (!oplogSlot.isNull()) {
+        uassertStatusOK(opCtx->recoveryUnit()->setTimestamp(oplogSlot.getTimestamp()));
+    }
+
     Snapshotted<BSONObj> doc = docFor(opCtx, loc);
     getGlobalServiceContext()->getOpObserver()->aboutToDelete(opCtx, ns(), doc.value());
 
@@ -605,9 +616,11 @@ void CollectionImpl::deleteDocument(OperationContext* opCtx,
     int64_t keysDeleted;
     _indexCatalog->unindexRecord(opCtx, doc.value(), loc, noWarn, &keysDeleted);
     _recordStore->deleteRecord(opCtx, loc);
+    CollectionQueryInfo::get(this).notifyOfWritesOnCommit(opCtx, 1);
+    CollectionQueryInfo::get(this).advanceWriteGenerationOnCommit(opCtx);
 
     getGlobalServiceContext()->getOpObserver()->onDelete(
-        opCtx, ns(), uuid(), stmtId, fromMigrate, deletedDoc);
+        opCtx, ns(), uuid(), stmtId, fromMigrate, deletedDoc, oplogSlot);
 
     if (opDebug) {
         opDebug->additiveMetrics.incrementKeysDeleted(keysDeleted);
@@ -675,6 +688,7 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
 
     uassertStatusOK(
         _recordStore->updateRecord(opCtx, oldLocation, newDoc.objdata(), newDoc.objsize()));
+    CollectionQueryInfo::get(this).advanceWriteGenerationOnCommit(opCtx);
 
     if (indexesAffected) {
         int64_t keysInserted, keysDeleted;
@@ -686,10 +700,12 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
             opDebug->additiveMetrics.incrementKeysInserted(keysInserted);
             opDebug->additiveMetrics.incrementKeysDeleted(keysDeleted);
         }
+        CollectionQueryInfo::get(this).notifyOfWritesOnCommit(opCtx, 1);
     }
 
     invariant(sid == opCtx->recoveryUnit()->getSnapshotId());
     args->updatedDoc = newDoc;
+    args->recordPostImage = _recordPostImages;
 
     OplogUpdateEntryArgs entryArgs(*args, ns(), _uuid);
     getGlobalServiceContext()->getOpObserver()->onUpdate(opCtx, entryArgs);
@@ -719,7 +735,9 @@ StatusWith<RecordData> CollectionImpl::updateDocumentWithDamages(
         _recordStore->updateWithDamages(opCtx, loc, oldRec.value(), damageSource, damages);
 
     if (newRecStatus.isOK()) {
+        CollectionQueryInfo::get(this).advanceWriteGenerationOnCommit(opCtx);
         args->updatedDoc = newRecStatus.getValue().toBson();
+        args->recordPostImage = _recordPostImages;
 
         OplogUpdateEntryArgs entryArgs(*args, ns(), _uuid);
         getGlobalServiceContext()->getOpObserver()->onUpdate(opCtx, entryArgs);
@@ -731,6 +749,10 @@ bool CollectionImpl::isTemporary(OperationContext* opCtx) const {
     return DurableCatalog::get(opCtx)->getCollectionOptions(opCtx, _ns).temp;
 }
 
+bool CollectionImpl::getRecordPostImages() const {
+    return _recordPostImages;
+}
+
 bool CollectionImpl::isCapped() const {
     return _cappedNotifier.get();
 }
@@ -806,6 +828,7 @@ Status CollectionImpl::truncate(OperationContext* opCtx) {
     auto status = _recordStore->truncate(opCtx);
     if (!status.isOK())
         return status;
+    CollectionQueryInfo::get(this).advanceWriteGenerationOnCommit(opCtx);
 
     // 4) re-create indexes
     for (size_t i = 0; i < indexSpecs.size(); i++) {
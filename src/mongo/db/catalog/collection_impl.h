@@ -125,7 +125,8 @@ public:
         OpDebug* opDebug,
         bool fromMigrate = false,
         bool noWarn = false,
-        Collection::StoreDeletedDoc storeDeletedDoc = Collection::StoreDeletedDoc::Off) final;
+        Collection::StoreDeletedDoc storeDeletedDoc = Collection::StoreDeletedDoc::Off,
+        const repl::OplogSlot& oplogSlot = repl::OplogSlot()) final;
 
     /*
      * Inserts all documents inside one WUOW.
@@ -162,13 +163,15 @@ public:
     /**
      * Inserts a document into the record store for a bulk loader that manages the index building
      * outside this Collection. The bulk loader is notified with the RecordId of the document
-     * inserted into the RecordStore.
+     * inserted into the RecordStore. If 'bulkInserter' is not null, the document is written
+     * through it instead of RecordStore::insertRecords().
      *
      * NOTE: It is up to caller to commit the indexes.
      */
     Status insertDocumentForBulkLoader(OperationContext* opCtx,
                                        const BSONObj& doc,
-                                       const OnRecordInsertedFn& onRecordInserted) final;
+                                       const OnRecordInsertedFn& onRecordInserted,
+                                       BulkRecordInserter* bulkInserter) final;
 
     /**
      * Updates the document @ oldLocation with newDoc.
@@ -262,6 +265,8 @@ public:
 
     bool isTemporary(OperationContext* opCtx) const final;
 
+    bool getRecordPostImages() const final;
+
     //
     // Stats
     //
@@ -380,6 +385,8 @@ private:
     ValidationAction _validationAction;
     ValidationLevel _validationLevel;
 
+    bool _recordPostImages = false;
+
     // Notifier object for awaitData. Threads polling a capped collection for new data can wait
     // on this object until notified of the arrival of new data.
     //
@@ -96,7 +96,8 @@ public:
                         OpDebug* opDebug,
                         bool fromMigrate,
                         bool noWarn,
-                        Collection::StoreDeletedDoc storeDeletedDoc) {
+                        Collection::StoreDeletedDoc storeDeletedDoc,
+                        const repl::OplogSlot& oplogSlot) {
         std::abort();
     }
 
@@ -123,7 +124,8 @@ public:
 
     Status insertDocumentForBulkLoader(OperationContext* opCtx,
                                        const BSONObj& doc,
-                                       const OnRecordInsertedFn& onRecordInserted) {
+                                       const OnRecordInsertedFn& onRecordInserted,
+                                       BulkRecordInserter* bulkInserter) {
         std::abort();
     }
 
@@ -196,6 +198,10 @@ public:
         std::abort();
     }
 
+    bool getRecordPostImages() const {
+        std::abort();
+    }
+
     bool isCapped() const {
         std::abort();
     }
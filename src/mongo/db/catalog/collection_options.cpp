@@ -168,6 +168,8 @@ StatusWith<CollectionOptions> CollectionOptions::parse(const BSONObj& options, P
             continue;
         } else if (fieldName == "temp") {
             collectionOptions.temp = e.trueValue();
+        } else if (fieldName == "recordPostImages") {
+            collectionOptions.recordPostImages = e.trueValue();
         } else if (fieldName == "storageEngine") {
             Status status = checkStorageEngineOptions(e);
             if (!status.isOK()) {
@@ -286,6 +288,9 @@ void CollectionOptions::appendBSON(BSONObjBuilder* builder) const {
     if (temp)
         builder->appendBool("temp", true);
 
+    if (recordPostImages)
+        builder->appendBool("recordPostImages", true);
+
     if (!storageEngine.isEmpty()) {
         builder->append("storageEngine", storageEngine);
     }
@@ -345,6 +350,10 @@ bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
         return false;
     }
 
+    if (recordPostImages != other.recordPostImages) {
+        return false;
+    }
+
     if (storageEngine.woCompare(other.storageEngine) != 0) {
         return false;
     }
@@ -120,6 +120,10 @@ struct CollectionOptions {
 
     bool temp = false;
 
+    // Whether every update writes the post-image of the document to the oplog, so that change
+    // streams using 'fullDocument: updateLookup' can return it without querying the collection.
+    bool recordPostImages = false;
+
     // Storage engine collection options. Always owned or empty.
     BSONObj storageEngine;
 
@@ -231,6 +231,16 @@ TEST(CollectionOptions, CollationFieldNotDumpedToBSONWhenOmitted) {
     ASSERT_FALSE(asBSON["collation"]);
 }
 
+TEST(CollectionOptions, RecordPostImagesParsesCorrectly) {
+    auto options = assertGet(CollectionOptions::parse(fromjson("{recordPostImages: true}")));
+    ASSERT_TRUE(options.recordPostImages);
+    checkRoundTrip(options);
+
+    options = assertGet(CollectionOptions::parse(fromjson("{validator: {a: 1}}")));
+    ASSERT_FALSE(options.recordPostImages);
+    ASSERT_FALSE(options.toBSON()["recordPostImages"]);
+}
+
 TEST(CollectionOptions, ViewParsesCorrectly) {
     auto options =
         assertGet(CollectionOptions::parse(fromjson("{viewOn: 'c', pipeline: [{$match: {}}]}")));
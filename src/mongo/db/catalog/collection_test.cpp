@@ -32,6 +32,7 @@
 #include <memory>
 
 #include "mongo/bson/oid.h"
+#include "mongo/db/catalog/capped_insert_notifier_gen.h"
 #include "mongo/db/catalog/capped_utils.h"
 #include "mongo/db/catalog/catalog_test_fixture.h"
 #include "mongo/db/catalog/collection.h"
@@ -40,6 +41,7 @@
 #include "mongo/db/repl/storage_interface_impl.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace {
 
@@ -153,6 +155,38 @@ TEST_F(CollectionTest, CappedNotifierWaitUntilAsynchronousKill) {
     ASSERT_EQ(notifier->getVersion(), prevVersion);
 }
 
+TEST_F(CollectionTest, CappedNotifierCoalescesNotificationsWithinInterval) {
+    NamespaceString nss("test.t");
+    makeCapped(nss);
+
+    const auto originalCoalesceMicros = gCappedInsertNotifierCoalesceMicros.load();
+    ON_BLOCK_EXIT([&] { gCappedInsertNotifierCoalesceMicros.store(originalCoalesceMicros); });
+    gCappedInsertNotifierCoalesceMicros.store(500 * 1000);
+
+    AutoGetCollectionForRead acfr(operationContext(), nss);
+    Collection* col = acfr.getCollection();
+    auto notifier = col->getCappedInsertNotifier();
+
+    // Nobody is waiting, so this wakes immediately and starts the coalescing interval.
+    auto before = Date_t::now();
+    notifier->notifyAll();
+    auto prevVersion = notifier->getVersion();
+
+    // This notification arrives while the main thread waits, within the interval, so the wakeup
+    // is deferred to the end of the interval.
+    stdx::thread thread([&notifier] {
+        sleepmillis(50);
+        notifier->notifyAll();
+    });
+    notifier->waitUntil(prevVersion, before + Seconds(25));
+    auto after = Date_t::now();
+    thread.join();
+
+    ASSERT_GTE(after - before, Milliseconds(450));
+    ASSERT_LT(after - before, Seconds(25));
+    ASSERT_EQ(notifier->getVersion(), prevVersion + 1);
+}
+
 TEST_F(CollectionTest, HaveCappedWaiters) {
     NamespaceString nss("test.t");
     makeCapped(nss);
@@ -42,6 +42,7 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/debug_util.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 class CollatorInterface;
@@ -88,6 +89,21 @@ public:
 
     virtual const CollatorInterface* getCollator() const = 0;
 
+    /**
+     * Returns the names of the top-level fields of a document which its keys in this index are
+     * generated from, including those referenced by the partial filter expression, so that an
+     * update leaving all of them unchanged cannot change the keys. Returns nullptr if the keys may
+     * depend on any field, as they do for text and wildcard indexes.
+     */
+    virtual const StringSet* getKeyedTopLevelFields() const = 0;
+
+    /**
+     * Returns the names of the top-level fields referenced by the partial filter expression, or
+     * nullptr if the index has none. An update leaving all of them unchanged cannot move a document
+     * into or out of the index.
+     */
+    virtual const StringSet* getFilterTopLevelFields() const = 0;
+
     /// ---------------------
 
     virtual void setIsReady(const bool newIsReady) = 0;
@@ -42,6 +42,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index_names.h"
 #include "mongo/db/logical_clock.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_parser.h"
@@ -59,6 +60,26 @@ namespace mongo {
 
 using std::string;
 
+namespace {
+
+StringData topLevelField(StringData path) {
+    return path.substr(0, path.find('.'));
+}
+
+/**
+ * Adds the top-level fields of the paths referenced by 'expr' to 'fields'.
+ */
+void addTopLevelFields(const MatchExpression* expr, StringSet* fields) {
+    if (!expr->path().empty()) {
+        fields->insert(topLevelField(expr->path()).toString());
+    }
+    for (size_t i = 0; i < expr->numChildren(); ++i) {
+        addTopLevelFields(expr->getChild(i), fields);
+    }
+}
+
+}  // namespace
+
 IndexCatalogEntryImpl::IndexCatalogEntryImpl(OperationContext* const opCtx,
                                              const std::string& ident,
                                              std::unique_ptr<IndexDescriptor> descriptor,
@@ -110,6 +131,23 @@ IndexCatalogEntryImpl::IndexCatalogEntryImpl(OperationContext* const opCtx,
         LOG(2) << "have filter expression for " << ns() << " " << _descriptor->indexName() << " "
                << redact(filter);
     }
+
+    if (_filterExpression) {
+        _filterTopLevelFields.emplace();
+        addTopLevelFields(_filterExpression.get(), &*_filterTopLevelFields);
+    }
+
+    const auto& accessMethodName = _descriptor->getAccessMethodName();
+    if (accessMethodName != IndexNames::TEXT && accessMethodName != IndexNames::WILDCARD) {
+        _keyedTopLevelFields.emplace();
+        for (auto&& keyElem : _descriptor->keyPattern()) {
+            _keyedTopLevelFields->insert(topLevelField(keyElem.fieldNameStringData()).toString());
+        }
+        if (_filterTopLevelFields) {
+            _keyedTopLevelFields->insert(_filterTopLevelFields->begin(),
+                                         _filterTopLevelFields->end());
+        }
+    }
 }
 
 IndexCatalogEntryImpl::~IndexCatalogEntryImpl() {
@@ -114,6 +114,14 @@ public:
         return _collator.get();
     }
 
+    const StringSet* getKeyedTopLevelFields() const final {
+        return _keyedTopLevelFields.get_ptr();
+    }
+
+    const StringSet* getFilterTopLevelFields() const final {
+        return _filterTopLevelFields.get_ptr();
+    }
+
     /// ---------------------
 
     void setIsReady(bool newIsReady) final;
@@ -212,6 +220,12 @@ private:
     std::unique_ptr<CollatorInterface> _collator;
     std::unique_ptr<MatchExpression> _filterExpression;
 
+    // Unset if the keys of the index may depend on any field of a document.
+    boost::optional<StringSet> _keyedTopLevelFields;
+
+    // Unset if the index has no partial filter expression.
+    boost::optional<StringSet> _filterTopLevelFields;
+
     // cached stuff
 
     Ordering _ordering;           // TODO: this might be b-tree specific
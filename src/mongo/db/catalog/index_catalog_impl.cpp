@@ -33,6 +33,7 @@
 
 #include "mongo/db/catalog/index_catalog_impl.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/base/init.h"
@@ -43,6 +44,7 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_build_block.h"
 #include "mongo/db/catalog/index_catalog_entry_impl.h"
+#include "mongo/db/catalog/index_catalog_impl_gen.h"
 #include "mongo/db/catalog/index_key_validate.h"
 #include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
@@ -71,6 +73,8 @@
 #include "mongo/db/storage/storage_engine_init.h"
 #include "mongo/db/ttl_collection_cache.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/future.h"
 #include "mongo/util/log.h"
 #include "mongo/util/represent_as.h"
 #include "mongo/util/str.h"
@@ -86,6 +90,13 @@ using IndexVersion = IndexDescriptor::IndexVersion;
 
 const BSONObj IndexCatalogImpl::_idObj = BSON("_id" << 1);
 
+namespace {
+
+// Smaller batches are not worth handing to other threads.
+constexpr size_t kMinRecordsToGenerateKeysInParallel = 16;
+
+}  // namespace
+
 // -------------
 
 IndexCatalogImpl::IndexCatalogImpl(Collection* collection) : _collection(collection) {}
@@ -1309,6 +1320,33 @@ Status IndexCatalogImpl::_updateRecord(OperationContext* const opCtx,
                                        const RecordId& recordId,
                                        int64_t* const keysInsertedOut,
                                        int64_t* const keysDeletedOut) {
+    const auto fieldsUnchanged = [&](const StringSet& fields) {
+        return std::all_of(fields.begin(), fields.end(), [&](const std::string& field) {
+            return oldDoc[field].binaryEqual(newDoc[field]);
+        });
+    };
+
+    // Generating the keys of both documents is only needed if a field they are generated from has
+    // changed. This avoids most of the cost of maintaining the indexes an update does not affect,
+    // when it affects others.
+    const auto* keyedFields = index->getKeyedTopLevelFields();
+    if (keyedFields && fieldsUnchanged(*keyedFields)) {
+        CollectionQueryInfo::get(_collection)
+            .notifyOfSkippedIndexUpdate(index->descriptor()->indexName());
+        return Status::OK();
+    }
+
+    // If none of the fields the partial filter expression depends on have changed, either both
+    // documents belong in the index or neither does. In the latter case there are no keys to diff,
+    // so a single evaluation of the filter is enough to skip the index.
+    const auto* filterFields = index->getFilterTopLevelFields();
+    if (filterFields && fieldsUnchanged(*filterFields) &&
+        !index->getFilterExpression()->matchesBSON(oldDoc)) {
+        CollectionQueryInfo::get(_collection)
+            .notifyOfSkippedIndexUpdate(index->descriptor()->indexName());
+        return Status::OK();
+    }
+
     IndexAccessMethod* iam = index->accessMethod();
 
     InsertDeleteOptions options;
@@ -1424,6 +1462,127 @@ void IndexCatalogImpl::_unindexRecord(OperationContext* opCtx,
     _unindexKeys(opCtx, entry, {keys.begin(), keys.end()}, obj, loc, logIfError, keysDeletedOut);
 }
 
+Status IndexCatalogImpl::_indexRecordsInParallel(OperationContext* opCtx,
+                                                 const std::vector<IndexCatalogEntry*>& indexes,
+                                                 const std::vector<BsonRecord>& bsonRecords,
+                                                 size_t numThreads,
+                                                 int64_t* keysInsertedOut) {
+    struct RecordKeys {
+        KeyStringSet keys;
+        KeyStringSet multikeyMetadataKeys;
+        MultikeyPaths multikeyPaths;
+    };
+
+    // The options depend on 'opCtx', so they are prepared before any work is handed out.
+    std::vector<InsertDeleteOptions> options(indexes.size());
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        prepareInsertDeleteOptions(opCtx, indexes[i]->descriptor(), &options[i]);
+    }
+
+    // Generating keys only reads the records and the index's own access method and filter, so the
+    // keys of different indexes can be generated concurrently without 'opCtx'. Records filtered out
+    // of a partial index have no keys.
+    std::vector<std::vector<boost::optional<RecordKeys>>> keysByIndex(indexes.size());
+    auto generateKeys = [&](size_t thread) {
+        try {
+            for (size_t i = thread; i < indexes.size(); i += numThreads) {
+                const MatchExpression* filter = indexes[i]->getFilterExpression();
+                auto& indexKeys = keysByIndex[i];
+                indexKeys.resize(bsonRecords.size());
+                for (size_t j = 0; j < bsonRecords.size(); ++j) {
+                    const auto& bsonRecord = bsonRecords[j];
+                    if (filter && !filter->matchesBSON(*bsonRecord.docPtr)) {
+                        continue;
+                    }
+                    indexKeys[j].emplace();
+                    auto& recordKeys = *indexKeys[j];
+                    indexes[i]->accessMethod()->getKeys(*bsonRecord.docPtr,
+                                                        options[i].getKeysMode,
+                                                        &recordKeys.keys,
+                                                        &recordKeys.multikeyMetadataKeys,
+                                                        &recordKeys.multikeyPaths,
+                                                        bsonRecord.id);
+                }
+            }
+        } catch (...) {
+            return exceptionToStatus();
+        }
+        return Status::OK();
+    };
+
+    // The pool is shared by all inserts and lives for the rest of the process. Its idle threads
+    // are reaped, and it never needs more than the most threads any one insert may use.
+    static ThreadPool* const keyGenerationPool = [] {
+        ThreadPool::Options poolOptions;
+        poolOptions.poolName = "InsertKeyGeneration";
+        poolOptions.minThreads = 0;
+        poolOptions.maxThreads = 64;
+        auto pool = new ThreadPool(poolOptions);
+        pool->startup();
+        return pool;
+    }();
+
+    // The tasks refer to the locals above, which is safe because all of them are waited for.
+    std::vector<Future<void>> keyGenerations;
+    for (size_t thread = 1; thread < numThreads; ++thread) {
+        auto pf = makePromiseFuture<void>();
+        keyGenerationPool->schedule(
+            [&generateKeys, thread, promise = std::move(pf.promise)](Status status) mutable {
+                if (status.isOK()) {
+                    status = generateKeys(thread);
+                }
+                if (status.isOK()) {
+                    promise.emplaceValue();
+                } else {
+                    promise.setError(status);
+                }
+            });
+        keyGenerations.push_back(std::move(pf.future));
+    }
+
+    Status status = generateKeys(0);
+    for (auto& keyGeneration : keyGenerations) {
+        Status keyGenerationStatus = keyGeneration.getNoThrow();
+        if (status.isOK()) {
+            status = keyGenerationStatus;
+        }
+    }
+    // Key generation errors are thrown, as they are when the keys are generated serially.
+    uassertStatusOK(status);
+
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        for (size_t j = 0; j < bsonRecords.size(); ++j) {
+            const auto& recordKeys = keysByIndex[i][j];
+            if (!recordKeys) {
+                continue;
+            }
+
+            const auto& bsonRecord = bsonRecords[j];
+            invariant(bsonRecord.id != RecordId());
+            if (!bsonRecord.ts.isNull()) {
+                Status status = opCtx->recoveryUnit()->setTimestamp(bsonRecord.ts);
+                if (!status.isOK())
+                    return status;
+            }
+
+            Status status = _indexKeys(opCtx,
+                                       indexes[i],
+                                       {recordKeys->keys.begin(), recordKeys->keys.end()},
+                                       recordKeys->multikeyMetadataKeys,
+                                       recordKeys->multikeyPaths,
+                                       *bsonRecord.docPtr,
+                                       bsonRecord.id,
+                                       options[i],
+                                       keysInsertedOut);
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+    }
+
+    return Status::OK();
+}
+
 Status IndexCatalogImpl::indexRecords(OperationContext* opCtx,
                                       const std::vector<BsonRecord>& bsonRecords,
                                       int64_t* keysInsertedOut) {
@@ -1431,6 +1590,22 @@ Status IndexCatalogImpl::indexRecords(OperationContext* opCtx,
         *keysInsertedOut = 0;
     }
 
+    // Large batches on collections with several indexes generate the keys of the indexes
+    // concurrently, if enabled.
+    const size_t numIndexes = _readyIndexes.size() + _buildingIndexes.size();
+    const size_t numThreads =
+        std::min(numIndexes, static_cast<size_t>(maxInsertKeyGenerationThreads.load()));
+    if (numThreads > 1 && bsonRecords.size() >= kMinRecordsToGenerateKeysInParallel) {
+        std::vector<IndexCatalogEntry*> indexes;
+        for (auto&& it : _readyIndexes) {
+            indexes.push_back(it.get());
+        }
+        for (auto&& it : _buildingIndexes) {
+            indexes.push_back(it.get());
+        }
+        return _indexRecordsInParallel(opCtx, indexes, bsonRecords, numThreads, keysInsertedOut);
+    }
+
     for (auto&& it : _readyIndexes) {
         Status s = _indexRecords(opCtx, it.get(), bsonRecords, keysInsertedOut);
         if (!s.isOK())
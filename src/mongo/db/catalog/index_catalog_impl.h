@@ -326,6 +326,17 @@ private:
                          const std::vector<BsonRecord>& bsonRecords,
                          int64_t* keysInsertedOut);
 
+    /**
+     * Indexes 'bsonRecords' in 'indexes' like _indexRecords(), but first generates the keys of
+     * the records for all of the indexes using 'numThreads' threads, each of which handles a
+     * share of the indexes. The keys are then inserted by the calling thread.
+     */
+    Status _indexRecordsInParallel(OperationContext* opCtx,
+                                   const std::vector<IndexCatalogEntry*>& indexes,
+                                   const std::vector<BsonRecord>& bsonRecords,
+                                   size_t numThreads,
+                                   int64_t* keysInsertedOut);
+
     Status _updateRecord(OperationContext* const opCtx,
                          IndexCatalogEntry* index,
                          const BSONObj& oldDoc,
@@ -40,6 +40,7 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_timestamp_helper.h"
 #include "mongo/db/catalog/multi_index_block_gen.h"
+#include "mongo/db/catalog/throttle_cursor.h"
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/index/multikey_paths.h"
@@ -54,7 +55,9 @@
 #include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/logger/redaction.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/future.h"
 #include "mongo/util/log.h"
 #include "mongo/util/progress_meter.h"
 #include "mongo/util/quick_exit.h"
@@ -71,6 +74,15 @@ MONGO_FAIL_POINT_DEFINE(hangAfterIndexBuildOf);
 MONGO_FAIL_POINT_DEFINE(hangAndThenFailIndexBuild);
 MONGO_FAIL_POINT_DEFINE(leaveIndexBuildUnfinishedForShutdown);
 
+namespace {
+
+// Bounds on the documents the collection scan accumulates before handing them to the key
+// generation threads.
+constexpr size_t kKeyGenerationBatchMaxDocs = 1000;
+constexpr size_t kKeyGenerationBatchMaxBytes = 16 * 1024 * 1024;
+
+}  // namespace
+
 MultiIndexBlock::~MultiIndexBlock() {
     invariant(_buildIsCleanedUp);
 }
@@ -463,6 +475,34 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(OperationContext* opCtx,
         _method != IndexBuildMethod::kBackground && useReadOnceCursorsForIndexBuilds.load();
     opCtx->recoveryUnit()->setReadOnce(readOnce);
 
+    // When several indexes are built with bulk builders, the scan hands batches of documents to
+    // a pool of threads so that the keys of different indexes are generated concurrently.
+    std::unique_ptr<ThreadPool> keyGenerationPool;
+    if (const auto numKeyGenerationThreads = _getNumKeyGenerationThreads();
+        numKeyGenerationThreads > 1) {
+        ThreadPool::Options options;
+        options.poolName = "IndexBuildKeyGeneration";
+        options.minThreads = numKeyGenerationThreads - 1;
+        options.maxThreads = numKeyGenerationThreads - 1;
+        keyGenerationPool = std::make_unique<ThreadPool>(options);
+        keyGenerationPool->startup();
+    }
+    ON_BLOCK_EXIT([&] {
+        if (keyGenerationPool) {
+            keyGenerationPool->shutdown();
+            keyGenerationPool->join();
+        }
+    });
+    std::vector<std::pair<BSONObj, RecordId>> batch;
+    size_t batchBytes = 0;
+
+    // Limits the rate at which the scan reads documents. Foreground builds hold an exclusive lock
+    // on the collection, so slowing them down would only stall every other operation on it.
+    DataThrottle dataThrottle(opCtx, &maxIndexBuildScanMBperSec);
+    if (!isBackgroundBuilding()) {
+        dataThrottle.turnThrottlingOff();
+    }
+
     Snapshotted<BSONObj> objToIndex;
     RecordId loc;
     PlanExecutor::ExecState state;
@@ -490,8 +530,35 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(OperationContext* opCtx,
             // Done before insert so we can retry document if it WCEs.
             progress->setTotalWhileRunning(collection->numRecords(opCtx));
 
+            if (!retries) {
+                dataThrottle.awaitIfNeeded(opCtx, objToIndex.value().objsize());
+            }
+
             failPointHangDuringBuild(&hangBeforeIndexBuildOf, "before", objToIndex.value());
 
+            if (keyGenerationPool) {
+                // The document must outlive yields of the collection scan.
+                batch.emplace_back(objToIndex.value().getOwned(), loc);
+                batchBytes += batch.back().first.objsize();
+                if (batch.size() >= kKeyGenerationBatchMaxDocs ||
+                    batchBytes >= kKeyGenerationBatchMaxBytes) {
+                    Status ret = _insertBatchInParallel(opCtx, batch, keyGenerationPool.get());
+                    if (!ret.isOK()) {
+                        // Fail the index build hard.
+                        return ret;
+                    }
+                    batch.clear();
+                    batchBytes = 0;
+                }
+
+                failPointHangDuringBuild(&hangAfterIndexBuildOf, "after", objToIndex.value());
+
+                progress->hit();
+                n++;
+                retries = 0;
+                continue;
+            }
+
             WriteUnitOfWork wunit(opCtx);
             Status ret = insert(opCtx, objToIndex.value(), loc);
             if (_method == IndexBuildMethod::kBackground)
@@ -540,6 +607,13 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(OperationContext* opCtx,
         return exec->getMemberObjectStatus(objToIndex.value());
     }
 
+    if (!batch.empty()) {
+        Status ret = _insertBatchInParallel(opCtx, batch, keyGenerationPool.get());
+        if (!ret.isOK()) {
+            return ret;
+        }
+    }
+
     if (MONGO_unlikely(leaveIndexBuildUnfinishedForShutdown.shouldFail())) {
         log() << "Index build interrupted due to 'leaveIndexBuildUnfinishedForShutdown' failpoint. "
                  "Mimicing shutdown error code.";
@@ -610,6 +684,82 @@ Status MultiIndexBlock::insert(OperationContext* opCtx, const BSONObj& doc, cons
     return Status::OK();
 }
 
+size_t MultiIndexBlock::_getNumKeyGenerationThreads() const {
+    // Background builds insert into the indexes directly, inside the scan's write unit of work.
+    if (_indexes.size() < 2 || _method == IndexBuildMethod::kBackground) {
+        return 1;
+    }
+    for (const auto& index : _indexes) {
+        if (!index.bulk) {
+            return 1;
+        }
+    }
+    return std::min(_indexes.size(), size_t(maxIndexBuildKeyGenerationThreads.load()));
+}
+
+Status MultiIndexBlock::_insertBatchInParallel(
+    OperationContext* opCtx,
+    const std::vector<std::pair<BSONObj, RecordId>>& batch,
+    ThreadPool* pool) {
+    if (State::kAborted == _getState()) {
+        return {ErrorCodes::IndexBuildAborted,
+                str::stream() << "Index build aborted: " << _abortReason};
+    }
+
+    // Each index's bulk builder is only touched by the task that generates its keys and this
+    // function waits for every task, so the tasks may refer to 'batch' and '_indexes'.
+    std::vector<Future<void>> indexInserts;
+    for (size_t i = 1; i < _indexes.size(); i++) {
+        auto pf = makePromiseFuture<void>();
+        pool->schedule([this, opCtx, i, &batch, promise = std::move(pf.promise)](
+                           Status status) mutable {
+            if (status.isOK()) {
+                status = _insertBatchIntoIndex(opCtx, i, batch);
+            }
+            if (status.isOK()) {
+                promise.emplaceValue();
+            } else {
+                promise.setError(status);
+            }
+        });
+        indexInserts.push_back(std::move(pf.future));
+    }
+
+    Status status = _insertBatchIntoIndex(opCtx, 0, batch);
+    for (auto& indexInsert : indexInserts) {
+        Status indexStatus = indexInsert.getNoThrow();
+        if (status.isOK()) {
+            status = indexStatus;
+        }
+    }
+    return status;
+}
+
+Status MultiIndexBlock::_insertBatchIntoIndex(
+    OperationContext* opCtx,
+    size_t indexNumber,
+    const std::vector<std::pair<BSONObj, RecordId>>& batch) {
+    auto& index = _indexes[indexNumber];
+    for (const auto& [doc, loc] : batch) {
+        if (index.filterExpression && !index.filterExpression->matchesBSON(doc)) {
+            continue;
+        }
+
+        // BulkBuilder::insert() only generates keys and adds them to its Sorter, so it does not
+        // use 'opCtx' and may run off the thread that owns it. The Sorter performs file I/O that
+        // may result in an exception.
+        try {
+            Status status = index.bulk->insert(opCtx, doc, loc, index.options);
+            if (!status.isOK()) {
+                return status;
+            }
+        } catch (...) {
+            return exceptionToStatus();
+        }
+    }
+    return Status::OK();
+}
+
 Status MultiIndexBlock::dumpInsertsFromBulk(OperationContext* opCtx) {
     return dumpInsertsFromBulk(opCtx, nullptr);
 }
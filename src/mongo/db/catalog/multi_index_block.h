@@ -34,6 +34,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "mongo/base/status.h"
@@ -58,6 +59,7 @@ class Collection;
 class MatchExpression;
 class NamespaceString;
 class OperationContext;
+class ThreadPool;
 
 /**
  * Builds one or more indexes.
@@ -318,6 +320,29 @@ private:
     Status _dumpInsertsFromBulk(std::set<RecordId>* dupRecords,
                                 std::vector<BSONObj>* dupKeysInserted);
 
+    /**
+     * Returns the number of threads, including the one scanning the collection, that should
+     * generate keys during insertAllDocumentsInCollection(). Returns 1 when keys should be
+     * generated by the scanning thread as each document is read.
+     */
+    size_t _getNumKeyGenerationThreads() const;
+
+    /**
+     * Adds the keys of every document in 'batch' to the bulk builder of each index. The keys of
+     * different indexes are generated concurrently on this thread and the threads of 'pool'.
+     */
+    Status _insertBatchInParallel(OperationContext* opCtx,
+                                  const std::vector<std::pair<BSONObj, RecordId>>& batch,
+                                  ThreadPool* pool);
+
+    /**
+     * Adds the keys of every document in 'batch' to the bulk builder of the index at 'indexNumber'
+     * in '_indexes'.
+     */
+    Status _insertBatchIntoIndex(OperationContext* opCtx,
+                                 size_t indexNumber,
+                                 const std::vector<std::pair<BSONObj, RecordId>>& batch);
+
     /**
      * Returns the current state.
      */
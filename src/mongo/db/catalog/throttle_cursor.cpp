@@ -120,6 +120,8 @@ boost::optional<KeyStringEntry> SortedDataInterfaceThrottleCursor::nextKeyString
     return entry;
 }
 
+DataThrottle::DataThrottle(OperationContext* opCtx) : DataThrottle(opCtx, &gMaxValidateMBperSec) {}
+
 void DataThrottle::awaitIfNeeded(OperationContext* opCtx, const int64_t dataSize) {
     int64_t currentMillis =
         opCtx->getServiceContext()->getFastClockSource()->now().toMillisSinceEpoch();
@@ -150,13 +152,13 @@ void DataThrottle::awaitIfNeeded(OperationContext* opCtx, const int64_t dataSize
         return;
     }
 
-    // No throttling should take place if 'gMaxValidateMBperSec' is zero.
-    uint64_t maxValidateBytesPerSec = gMaxValidateMBperSec.load() * 1024 * 1024;
-    if (maxValidateBytesPerSec == 0) {
+    // No throttling should take place if the limit is zero.
+    uint64_t maxBytesPerSec = static_cast<uint64_t>(_maxMBperSec->load()) * 1024 * 1024;
+    if (maxBytesPerSec == 0) {
         return;
     }
 
-    if (_bytesProcessed < maxValidateBytesPerSec) {
+    if (_bytesProcessed < maxBytesPerSec) {
         return;
     }
 
@@ -34,6 +34,7 @@
 
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/sorted_data_interface.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/fail_point.h"
 
 namespace mongo {
@@ -102,26 +103,33 @@ private:
 
 /**
  * Throttles the amount of data processed within a unit of time. Puts the thread to sleep via an
- * opCtx -- so it is interruptible -- whenever the data limit set by the 'maxValidateMBperSec'
- * server parameter is exceeded before the time unit is done.
+ * opCtx -- so it is interruptible -- whenever the data limit set by a server parameter, by default
+ * 'maxValidateMBperSec', is exceeded before the time unit is done.
  */
 class DataThrottle {
 public:
-    DataThrottle(OperationContext* opCtx)
+    explicit DataThrottle(OperationContext* opCtx);
+
+    /**
+     * Constructs a DataThrottle whose limit in MB per second is read from 'maxMBperSec' on every
+     * call to awaitIfNeeded(), so that it follows runtime changes of the server parameter.
+     */
+    DataThrottle(OperationContext* opCtx, const AtomicWord<int>* maxMBperSec)
         : _startMillis(
               opCtx->getServiceContext()->getFastClockSource()->now().toMillisSinceEpoch()),
           _bytesProcessed(0),
           _totalElapsedTimeSec(0),
           _totalMBProcessed(0),
-          _shouldNotThrottle(false) {}
+          _shouldNotThrottle(false),
+          _maxMBperSec(maxMBperSec) {}
 
     /**
-     * If throttling is not enabled by calling turnThrottlingOff(), or if
-     * 'maxValidateMBperSec' == 0, then this is a no-op.
+     * If throttling is not enabled by calling turnThrottlingOff(), or if the limit is 0, then this
+     * is a no-op.
      *
-     * When the accumulated number of bytes processed in each second reaches or exceeds the limit
-     * set by the 'maxValidateMBperSec' server parameter, the throttle mechanism gets engaged to
-     * wait for the remainder of that second by putting the thread to sleep.
+     * When the accumulated number of bytes processed in each second reaches or exceeds the limit,
+     * the throttle mechanism gets engaged to wait for the remainder of that second by putting the
+     * thread to sleep.
      *
      * In addition to throttling, while the thread is waiting, its operation context remains
      * interruptible.
@@ -145,6 +153,9 @@ private:
 
     // Whether the throttle should be active.
     bool _shouldNotThrottle;
+
+    // The server parameter holding the limit in MB per second.
+    const AtomicWord<int>* _maxMBperSec;
 };
 
 }  // namespace mongo
@@ -379,6 +379,35 @@ TEST_F(ThrottleCursorTest, TestMixedCursorsWithSharedThrottleOn) {
     }
 }
 
+TEST_F(ThrottleCursorTest, TestThrottleFollowsItsOwnServerParameter) {
+    auto opCtx = operationContext();
+    AutoGetCollection autoColl(opCtx, kNss, MODE_X);
+    Collection* coll = autoColl.getCollection();
+
+    // Use a fixed record data size to simplify the timing calculations.
+    FailPointEnableBlock failPoint("fixedCursorDataSizeOf512KBForDataThrottle");
+
+    AtomicWord<int> maxMbPerSec{1};
+    DataThrottle dataThrottle(opCtx, &maxMbPerSec);
+    SeekableRecordThrottleCursor cursor =
+        SeekableRecordThrottleCursor(opCtx, coll->getRecordStore(), &dataThrottle);
+
+    // The 'maxValidateMBperSec' server parameter does not affect this throttle. With a limit of 1MB
+    // per second, the 10 records of 0.5MB take at least 5 seconds to read.
+    setMaxMbPerSec(0);
+    Date_t start = getTime();
+
+    int numRecords = 0;
+    while (cursor.next(opCtx)) {
+        numRecords++;
+    }
+
+    Date_t end = getTime();
+
+    ASSERT_EQ(numRecords, 10);
+    ASSERT_TRUE(getDifferenceInMillis(start, end) >= 5000);
+}
+
 }  // namespace
 
 }  // namespace mongo
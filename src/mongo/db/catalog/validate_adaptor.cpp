@@ -37,6 +37,7 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/index_consistency.h"
+#include "mongo/db/catalog/max_validate_mb_per_sec_gen.h"
 #include "mongo/db/catalog/throttle_cursor.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/index/index_access_method.h"
@@ -47,6 +48,8 @@
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/rpc/object_check.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/future.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
@@ -56,6 +59,25 @@ namespace {
 const long long kInterruptIntervalNumRecords = 4096;
 const long long kInterruptIntervalNumBytes = 50 * 1024 * 1024;  // 50MB.
 
+// Bounds on the batches of documents whose keys are generated concurrently for several indexes.
+const size_t kKeyGenerationBatchMaxDocs = 1000;
+const size_t kKeyGenerationBatchMaxBytes = 16 * 1024 * 1024;  // 16MB.
+
+// The pool is shared by all validations and lives for the rest of the process. Its idle threads are
+// reaped, and it never needs more than the most threads any one validation may use.
+ThreadPool* getKeyGenerationPool() {
+    static ThreadPool* const keyGenerationPool = [] {
+        ThreadPool::Options poolOptions;
+        poolOptions.poolName = "ValidateKeyGeneration";
+        poolOptions.minThreads = 0;
+        poolOptions.maxThreads = 64;
+        auto pool = new ThreadPool(poolOptions);
+        pool->startup();
+        return pool;
+    }();
+    return keyGenerationPool;
+}
+
 }  // namespace
 
 Status ValidateAdaptor::validateRecord(OperationContext* opCtx,
@@ -63,78 +85,177 @@ Status ValidateAdaptor::validateRecord(OperationContext* opCtx,
                                        const RecordData& record,
                                        size_t* dataSize) {
     BSONObj recordBson;
+    const Status status = _validateRecordBson(record, &recordBson, dataSize);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    const IndexCatalog* indexCatalog = _validateState->getCollection()->getIndexCatalog();
+    if (!indexCatalog->haveAnyIndexes()) {
+        return status;
+    }
+
+    for (const auto& index : _validateState->getIndexes()) {
+        boost::optional<DocumentKeys> documentKeys;
+        _generateDocumentKeys(index.get(), recordBson, recordId, &documentKeys);
+        if (!documentKeys) {
+            continue;
+        }
+
+        Status addStatus = _addDocumentKeys(opCtx, index.get(), recordId, *documentKeys);
+        if (!addStatus.isOK()) {
+            return addStatus;
+        }
+    }
+    return status;
+}
+
+Status ValidateAdaptor::_validateRecordBson(const RecordData& record,
+                                            BSONObj* recordBson,
+                                            size_t* dataSize) {
     try {
-        recordBson = record.toBson();
+        *recordBson = record.toBson();
     } catch (...) {
         return exceptionToStatus();
     }
 
     const Status status = validateBSON(
-        recordBson.objdata(), recordBson.objsize(), Validator<BSONObj>::enabledBSONVersion());
+        recordBson->objdata(), recordBson->objsize(), Validator<BSONObj>::enabledBSONVersion());
     if (status.isOK()) {
-        *dataSize = recordBson.objsize();
-    } else {
-        return status;
+        *dataSize = recordBson->objsize();
     }
+    return status;
+}
 
-    const IndexCatalog* indexCatalog = _validateState->getCollection()->getIndexCatalog();
-    if (!indexCatalog->haveAnyIndexes()) {
-        return status;
+void ValidateAdaptor::_generateDocumentKeys(const IndexCatalogEntry* index,
+                                            const BSONObj& recordBson,
+                                            const RecordId& recordId,
+                                            boost::optional<DocumentKeys>* documentKeys) const {
+    const IndexDescriptor* descriptor = index->descriptor();
+    if (descriptor->isPartial() && !index->getFilterExpression()->matchesBSON(recordBson)) {
+        return;
     }
 
-    for (const auto& index : _validateState->getIndexes()) {
-        const IndexDescriptor* descriptor = index->descriptor();
-        const IndexAccessMethod* iam = index->accessMethod();
+    documentKeys->emplace();
+    index->accessMethod()->getKeys(recordBson,
+                                   IndexAccessMethod::GetKeysMode::kEnforceConstraints,
+                                   &(*documentKeys)->keys,
+                                   &(*documentKeys)->multikeyMetadataKeys,
+                                   &(*documentKeys)->multikeyPaths,
+                                   recordId);
+}
 
-        if (descriptor->isPartial()) {
-            const IndexCatalogEntry* ice = indexCatalog->getEntry(descriptor);
-            if (!ice->getFilterExpression()->matchesBSON(recordBson)) {
-                continue;
-            }
+Status ValidateAdaptor::_addDocumentKeys(OperationContext* opCtx,
+                                         const IndexCatalogEntry* index,
+                                         const RecordId& recordId,
+                                         const DocumentKeys& documentKeys) {
+    const IndexDescriptor* descriptor = index->descriptor();
+    const IndexAccessMethod* iam = index->accessMethod();
+
+    if (!descriptor->isMultikey() &&
+        iam->shouldMarkIndexAsMultikey(
+            documentKeys.keys.size(),
+            {documentKeys.multikeyMetadataKeys.begin(), documentKeys.multikeyMetadataKeys.end()},
+            documentKeys.multikeyPaths)) {
+        std::string msg = str::stream()
+            << "Index " << descriptor->indexName() << " is not multi-key but has more than one"
+            << " key in document " << recordId;
+        ValidateResults& curRecordResults = (*_indexNsResultsMap)[descriptor->indexName()];
+        curRecordResults.errors.push_back(msg);
+        curRecordResults.valid = false;
+    }
+
+    IndexInfo& indexInfo = _indexConsistency->getIndexInfo(descriptor->indexName());
+    for (const auto& keyString : documentKeys.multikeyMetadataKeys) {
+        try {
+            _indexConsistency->addMultikeyMetadataPath(keyString, &indexInfo);
+        } catch (...) {
+            return exceptionToStatus();
         }
+    }
 
-        KeyStringSet documentKeySet;
-        KeyStringSet multikeyMetadataKeys;
-        MultikeyPaths multikeyPaths;
-        iam->getKeys(recordBson,
-                     IndexAccessMethod::GetKeysMode::kEnforceConstraints,
-                     &documentKeySet,
-                     &multikeyMetadataKeys,
-                     &multikeyPaths,
-                     recordId);
-
-        if (!descriptor->isMultikey() &&
-            iam->shouldMarkIndexAsMultikey(
-                documentKeySet.size(),
-                {multikeyMetadataKeys.begin(), multikeyMetadataKeys.end()},
-                multikeyPaths)) {
-            std::string msg = str::stream()
-                << "Index " << descriptor->indexName() << " is not multi-key but has more than one"
-                << " key in document " << recordId;
-            ValidateResults& curRecordResults = (*_indexNsResultsMap)[descriptor->indexName()];
-            curRecordResults.errors.push_back(msg);
-            curRecordResults.valid = false;
+    for (const auto& keyString : documentKeys.keys) {
+        try {
+            _totalIndexKeys++;
+            _indexConsistency->addDocKey(opCtx, keyString, &indexInfo, recordId);
+        } catch (...) {
+            return exceptionToStatus();
         }
+    }
+    return Status::OK();
+}
 
-        IndexInfo& indexInfo = _indexConsistency->getIndexInfo(descriptor->indexName());
-        for (const auto& keyString : multikeyMetadataKeys) {
-            try {
-                _indexConsistency->addMultikeyMetadataPath(keyString, &indexInfo);
-            } catch (...) {
-                return exceptionToStatus();
+std::vector<Status> ValidateAdaptor::_addBatchDocumentKeys(
+    OperationContext* opCtx,
+    const std::vector<std::pair<RecordId, BSONObj>>& batch,
+    size_t numThreads,
+    ThreadPool* pool) {
+    const auto& indexes = _validateState->getIndexes();
+
+    // Generating keys only reads the documents and the index's own access method and filter, so
+    // the keys of different indexes can be generated concurrently without 'opCtx'.
+    std::vector<std::vector<boost::optional<DocumentKeys>>> keysByIndex(indexes.size());
+    auto generateKeys = [&](size_t thread) {
+        try {
+            for (size_t i = thread; i < indexes.size(); i += numThreads) {
+                auto& indexKeys = keysByIndex[i];
+                indexKeys.resize(batch.size());
+                for (size_t j = 0; j < batch.size(); ++j) {
+                    _generateDocumentKeys(
+                        indexes[i].get(), batch[j].second, batch[j].first, &indexKeys[j]);
+                }
             }
+        } catch (...) {
+            return exceptionToStatus();
+        }
+        return Status::OK();
+    };
+
+    // The tasks refer to the locals above, which is safe because all of them are waited for.
+    std::vector<Future<void>> keyGenerations;
+    for (size_t thread = 1; thread < numThreads; ++thread) {
+        auto pf = makePromiseFuture<void>();
+        pool->schedule(
+            [&generateKeys, thread, promise = std::move(pf.promise)](Status status) mutable {
+                if (status.isOK()) {
+                    status = generateKeys(thread);
+                }
+                if (status.isOK()) {
+                    promise.emplaceValue();
+                } else {
+                    promise.setError(status);
+                }
+            });
+        keyGenerations.push_back(std::move(pf.future));
+    }
+
+    Status status = generateKeys(0);
+    for (auto& keyGeneration : keyGenerations) {
+        Status keyGenerationStatus = keyGeneration.getNoThrow();
+        if (status.isOK()) {
+            status = keyGenerationStatus;
         }
+    }
+    // Key generation errors are thrown, as they are when the keys are generated serially.
+    uassertStatusOK(status);
+
+    // The keys are added in the order in which they would have been added serially.
+    std::vector<Status> recordStatuses(batch.size(), Status::OK());
+    for (size_t j = 0; j < batch.size(); ++j) {
+        for (size_t i = 0; i < indexes.size(); ++i) {
+            const auto& documentKeys = keysByIndex[i][j];
+            if (!documentKeys) {
+                continue;
+            }
 
-        for (const auto& keyString : documentKeySet) {
-            try {
-                _totalIndexKeys++;
-                _indexConsistency->addDocKey(opCtx, keyString, &indexInfo, recordId);
-            } catch (...) {
-                return exceptionToStatus();
+            recordStatuses[j] =
+                _addDocumentKeys(opCtx, indexes[i].get(), batch[j].first, *documentKeys);
+            if (!recordStatuses[j].isOK()) {
+                break;
             }
         }
     }
-    return status;
+    return recordStatuses;
 }
 
 void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
@@ -243,6 +364,53 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
         _progress.set(CurOp::get(opCtx)->setProgress_inlock(curopMessage, totalRecords));
     }
 
+    auto reportInvalidRecord = [&](const RecordId& recordId,
+                                   const Status& status,
+                                   size_t validatedSize,
+                                   long long dataSize) {
+        str::stream ss;
+        ss << "Document with RecordId " << recordId << " is corrupted. ";
+        if (!status.isOK() && validatedSize != static_cast<size_t>(dataSize)) {
+            ss << "Reasons: (1) " << status << "; (2) Validated size of " << validatedSize
+               << " bytes does not equal the record size of " << dataSize << " bytes";
+        } else if (!status.isOK()) {
+            ss << "Reason: " << status;
+        } else {
+            ss << "Reason: Validated size of " << validatedSize
+               << " bytes does not equal the record size of " << dataSize << " bytes";
+        }
+        log() << std::string(ss);
+
+        // Only log once
+        if (results->valid) {
+            results->errors.push_back("Detected one or more invalid documents. See logs.");
+            results->valid = false;
+        }
+        nInvalid++;
+    };
+
+    // When enabled, the keys of batches of documents are generated for several indexes at once.
+    const size_t numKeyGenerationThreads = std::min(
+        _validateState->getIndexes().size(), size_t(maxValidateKeyGenerationThreads.load()));
+    std::vector<std::pair<RecordId, BSONObj>> batch;
+    size_t batchBytes = 0;
+    auto addBatchDocumentKeys = [&] {
+        if (batch.empty()) {
+            return;
+        }
+
+        auto statuses =
+            _addBatchDocumentKeys(opCtx, batch, numKeyGenerationThreads, getKeyGenerationPool());
+        for (size_t j = 0; j < batch.size(); ++j) {
+            if (!statuses[j].isOK()) {
+                const auto size = batch[j].second.objsize();
+                reportInvalidRecord(batch[j].first, statuses[j], size, size);
+            }
+        }
+        batch.clear();
+        batchBytes = 0;
+    };
+
     const std::unique_ptr<SeekableRecordThrottleCursor>& traverseRecordStoreCursor =
         _validateState->getTraverseRecordStoreCursor();
     for (auto record =
@@ -255,7 +423,19 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
         interruptIntervalNumBytes += dataSize;
         dataSizeTotal += dataSize;
         size_t validatedSize;
-        Status status = validateRecord(opCtx, record->id, record->data, &validatedSize);
+        Status status = Status::OK();
+        if (numKeyGenerationThreads > 1) {
+            // The keys are generated and checked once the batch is full.
+            BSONObj recordBson;
+            status = _validateRecordBson(record->data, &recordBson, &validatedSize);
+            if (status.isOK()) {
+                // The document must outlive yields of the record store cursor.
+                batch.emplace_back(record->id, recordBson.getOwned());
+                batchBytes += recordBson.objsize();
+            }
+        } else {
+            status = validateRecord(opCtx, record->id, record->data, &validatedSize);
+        }
 
         // Checks to ensure isInRecordIdOrder() is being used properly.
         if (prevRecordId.isValid()) {
@@ -265,32 +445,20 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
         // validatedSize = dataSize is not a general requirement as some storage engines may use
         // padding, but we still require that they return the unpadded record data.
         if (!status.isOK() || validatedSize != static_cast<size_t>(dataSize)) {
-            str::stream ss;
-            ss << "Document with RecordId " << record->id << " is corrupted. ";
-            if (!status.isOK() && validatedSize != static_cast<size_t>(dataSize)) {
-                ss << "Reasons: (1) " << status << "; (2) Validated size of " << validatedSize
-                   << " bytes does not equal the record size of " << dataSize << " bytes";
-            } else if (!status.isOK()) {
-                ss << "Reason: " << status;
-            } else {
-                ss << "Reason: Validated size of " << validatedSize
-                   << " bytes does not equal the record size of " << dataSize << " bytes";
-            }
-            log() << std::string(ss);
-
-            // Only log once
-            if (results->valid) {
-                results->errors.push_back("Detected one or more invalid documents. See logs.");
-                results->valid = false;
-            }
-            nInvalid++;
+            reportInvalidRecord(record->id, status, validatedSize, dataSize);
         }
 
         prevRecordId = record->id;
 
+        if (batch.size() >= kKeyGenerationBatchMaxDocs ||
+            batchBytes >= kKeyGenerationBatchMaxBytes) {
+            addBatchDocumentKeys();
+        }
+
         if (_numRecords % kInterruptIntervalNumRecords == 0 ||
             interruptIntervalNumBytes >= kInterruptIntervalNumBytes) {
             // Periodically checks for interrupts and yields.
+            addBatchDocumentKeys();
             opCtx->checkForInterrupt();
             _validateState->yield(opCtx);
 
@@ -300,6 +468,8 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
         }
     }
 
+    addBatchDocumentKeys();
+
     // Do not update the record store stats if we're in the background as we've validated a
     // checkpoint and it may not have the most up-to-date changes.
     if (results->valid && !_validateState->isBackground()) {
@@ -30,6 +30,8 @@
 #pragma once
 
 #include "mongo/db/catalog/validate_state.h"
+#include "mongo/db/index/multikey_paths.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/util/progress_meter.h"
 
 namespace mongo {
@@ -37,6 +39,7 @@ namespace mongo {
 class IndexConsistency;
 class IndexDescriptor;
 class OperationContext;
+class ThreadPool;
 
 /**
  * The validate adaptor is used to keep track of collection and index consistency during a running
@@ -87,6 +90,48 @@ public:
     void validateIndexKeyCount(const IndexDescriptor* idx, ValidateResults& results);
 
 private:
+    // The keys of one document in one index.
+    struct DocumentKeys {
+        KeyStringSet keys;
+        KeyStringSet multikeyMetadataKeys;
+        MultikeyPaths multikeyPaths;
+    };
+
+    /**
+     * Checks that 'record' is valid BSON, returning it in 'recordBson' and its size in 'dataSize'.
+     */
+    Status _validateRecordBson(const RecordData& record, BSONObj* recordBson, size_t* dataSize);
+
+    /**
+     * Generates the keys of 'recordBson' in 'index', leaving 'documentKeys' unset if the document
+     * is outside the partial filter expression of the index. Does not use an OperationContext, so
+     * that it can run on any thread.
+     */
+    void _generateDocumentKeys(const IndexCatalogEntry* index,
+                               const BSONObj& recordBson,
+                               const RecordId& recordId,
+                               boost::optional<DocumentKeys>* documentKeys) const;
+
+    /**
+     * Checks the multikey state of 'index' against 'documentKeys' and adds them to the index
+     * consistency tracking.
+     */
+    Status _addDocumentKeys(OperationContext* opCtx,
+                            const IndexCatalogEntry* index,
+                            const RecordId& recordId,
+                            const DocumentKeys& documentKeys);
+
+    /**
+     * Generates the keys of the documents in 'batch', whose BSON has already been validated, for
+     * all indexes by spreading the indexes over 'numThreads' threads of 'pool' and the calling
+     * thread. Then adds the keys in record order and returns the status of each record.
+     */
+    std::vector<Status> _addBatchDocumentKeys(
+        OperationContext* opCtx,
+        const std::vector<std::pair<RecordId, BSONObj>>& batch,
+        size_t numThreads,
+        ThreadPool* pool);
+
     IndexConsistency* _indexConsistency;
     CollectionValidation::ValidateState* _validateState;
     ValidateResultsMap* _indexNsResultsMap;
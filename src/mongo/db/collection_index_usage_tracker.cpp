@@ -61,6 +61,13 @@ void CollectionIndexUsageTracker::recordIndexAccess(StringData indexName) {
     _indexUsageMap[indexName].accesses.fetchAndAdd(1);
 }
 
+void CollectionIndexUsageTracker::recordSkippedIndexUpdate(StringData indexName) {
+    auto it = _indexUsageMap.find(indexName);
+    if (it != _indexUsageMap.end()) {
+        it->second.skippedUpdates.fetchAndAdd(1);
+    }
+}
+
 void CollectionIndexUsageTracker::recordCollectionScans(unsigned long long collectionScans) {
     _collectionScans.fetchAndAdd(collectionScans);
     collectionScansCounter.increment(collectionScans);
@@ -66,11 +66,13 @@ public:
 
         IndexUsageStats(const IndexUsageStats& other)
             : accesses(other.accesses.load()),
+              skippedUpdates(other.skippedUpdates.load()),
               trackerStartTime(other.trackerStartTime),
               indexKey(other.indexKey) {}
 
         IndexUsageStats& operator=(const IndexUsageStats& other) {
             accesses.store(other.accesses.load());
+            skippedUpdates.store(other.skippedUpdates.load());
             trackerStartTime = other.trackerStartTime;
             indexKey = other.indexKey;
             return *this;
@@ -79,6 +81,10 @@ public:
         // Number of operations that have used this index.
         AtomicWord<long long> accesses;
 
+        // Number of document updates which left this index's keys unchanged and were able to skip
+        // generating them.
+        AtomicWord<long long> skippedUpdates;
+
         // Date/Time that we started tracking index usage.
         Date_t trackerStartTime;
 
@@ -100,6 +106,13 @@ public:
      */
     void recordIndexAccess(StringData indexName);
 
+    /**
+     * Record that an update skipped maintaining index 'indexName'. Safe to be called by multiple
+     * threads concurrently. Indexes which are not registered, such as those still being built, are
+     * ignored.
+     */
+    void recordSkippedIndexUpdate(StringData indexName);
+
     /**
      * Add map entry for 'indexName' stats collection. Must be called under exclusive collection
      * lock.
@@ -0,0 +1,228 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kCommand
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/auth/action_set.h"
+#include "mongo/db/auth/action_type.h"
+#include "mongo/db/auth/privilege.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbhelpers.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/index_statistics.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+namespace {
+
+const long long kDefaultSampleSize = 10000;
+const long long kDefaultNumBuckets = 64;
+
+long long parsePositiveLong(const BSONObj& cmdObj, StringData fieldName, long long defaultValue) {
+    auto elem = cmdObj[fieldName];
+    if (elem.eoo()) {
+        return defaultValue;
+    }
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << "'" << fieldName << "' must be a number",
+            elem.isNumber());
+    const long long value = elem.safeNumberLong();
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "'" << fieldName << "' must be positive",
+            value > 0);
+    return value;
+}
+
+/**
+ * Samples a collection with a random cursor and builds histogram and distinct value statistics
+ * over the leading field of each of its indexes. The statistics are installed in the collection's
+ * CollectionQueryInfo for use by the query planner and, when this node can accept writes, stored
+ * in the database's system.statistics collection.
+ */
+class CmdAnalyze : public BasicCommand {
+public:
+    CmdAnalyze() : BasicCommand("analyze") {}
+
+    std::string help() const override {
+        return "gather index statistics for the query planner by sampling a collection\n"
+               "{ analyze : <collection_name>, [sampleSize: <n>], [numBuckets: <n>] }\n"
+               "  sampleSize - number of documents to sample (defaults to 10000)\n"
+               "  numBuckets - maximum number of histogram buckets per index (defaults to 64)\n";
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kAlways;
+    }
+
+    void addRequiredPrivileges(const std::string& dbname,
+                               const BSONObj& cmdObj,
+                               std::vector<Privilege>* out) const override {
+        const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbname, cmdObj));
+        out->push_back(Privilege(ResourcePattern::forExactNamespace(nss), ActionType::find));
+
+        ActionSet statsActions;
+        statsActions.addAction(ActionType::insert);
+        statsActions.addAction(ActionType::update);
+        out->push_back(Privilege(ResourcePattern::forExactNamespace(NamespaceString(
+                                     dbname, NamespaceString::kSystemDotStatisticsCollectionName)),
+                                 statsActions));
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbname, cmdObj));
+        const long long sampleSize = parsePositiveLong(cmdObj, "sampleSize", kDefaultSampleSize);
+        const long long numBuckets = parsePositiveLong(cmdObj, "numBuckets", kDefaultNumBuckets);
+
+        std::vector<BSONObj> statsDocs;
+        {
+            AutoGetCollectionForReadCommand autoColl(opCtx, nss);
+            uassert(ErrorCodes::CommandNotSupportedOnView,
+                    "cannot analyze a view",
+                    !autoColl.getView());
+            Collection* collection = autoColl.getCollection();
+            uassert(ErrorCodes::NamespaceNotFound,
+                    str::stream() << "collection " << nss << " does not exist",
+                    collection);
+
+            const long long numRecords = static_cast<long long>(collection->numRecords(opCtx));
+            auto cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+            uassert(ErrorCodes::IllegalOperation,
+                    "the storage engine does not support random sampling",
+                    cursor);
+
+            std::vector<BSONObj> sampledDocs;
+            const long long targetSize = std::min(sampleSize, numRecords);
+            while (static_cast<long long>(sampledDocs.size()) < targetSize) {
+                opCtx->checkForInterrupt();
+                auto record = cursor->next();
+                if (!record) {
+                    break;
+                }
+                sampledDocs.push_back(record->data.toBson().getOwned());
+            }
+
+            IndexStatisticsMap indexStats;
+            auto it = collection->getIndexCatalog()->getIndexIterator(opCtx, false);
+            while (it->more()) {
+                const IndexCatalogEntry* entry = it->next();
+                const IndexDescriptor* desc = entry->descriptor();
+
+                // Partial indexes only hold a subset of the sampled documents, and non-simple
+                // collations index comparison keys rather than the values themselves.
+                if (desc->getIndexType() != INDEX_BTREE || desc->isPartial() ||
+                    entry->getCollator()) {
+                    continue;
+                }
+
+                auto stats = IndexStatistics::build(desc->indexName(),
+                                                    desc->keyPattern(),
+                                                    sampledDocs,
+                                                    numRecords,
+                                                    static_cast<size_t>(numBuckets));
+
+                BSONObjBuilder docBuilder;
+                {
+                    BSONObjBuilder idBuilder(docBuilder.subobjStart("_id"));
+                    collection->uuid().appendToBuilder(&idBuilder, "collectionUUID");
+                    idBuilder.append("index", desc->indexName());
+                }
+                docBuilder.append("ns", nss.ns());
+                docBuilder.appendDate("analyzedAt", Date_t::now());
+                docBuilder.appendElements(stats.toBSON());
+                statsDocs.push_back(docBuilder.obj());
+
+                indexStats.emplace(desc->indexName(), std::move(stats));
+            }
+
+            CollectionQueryInfo::get(collection)
+                .setIndexStatistics(std::move(indexStats), numRecords);
+            result.append("numRecords", numRecords);
+            result.append("numSampledDocs", static_cast<long long>(sampledDocs.size()));
+            result.append("numIndexesAnalyzed", static_cast<int>(statsDocs.size()));
+        }
+
+        const NamespaceString statsNss(nss.db(),
+                                       NamespaceString::kSystemDotStatisticsCollectionName);
+        bool persisted = false;
+        writeConflictRetry(opCtx, "analyze", statsNss.ns(), [&] {
+            if (statsDocs.empty()) {
+                return;
+            }
+
+            // Intent locks suffice to write to an existing statistics collection. Only the first
+            // run on a database, which creates it, takes the database lock in exclusive mode.
+            boost::optional<AutoGetCollection> autoStats;
+            boost::optional<Lock::DBLock> dbLock;
+            autoStats.emplace(opCtx, statsNss, MODE_IX);
+            if (!autoStats->getCollection()) {
+                autoStats.reset();
+                dbLock.emplace(opCtx, nss.db(), MODE_X);
+            }
+            if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, statsNss)) {
+                return;
+            }
+
+            WriteUnitOfWork wuow(opCtx);
+            for (auto&& doc : statsDocs) {
+                Helpers::upsert(opCtx, statsNss.ns(), doc);
+            }
+            wuow.commit();
+            persisted = true;
+        });
+        result.append("persisted", persisted);
+
+        LOG(1) << "Analyzed " << nss << ", gathered statistics for " << statsDocs.size()
+               << " indexes";
+        return true;
+    }
+} cmdAnalyze;
+
+}  // namespace
+}  // namespace mongo
@@ -105,9 +105,12 @@ public:
             return false;
         }
 
-        StatusWith<int64_t> status = compactCollection(opCtx, nss);
+        int64_t estimatedReclaimableBytes = 0;
+        StatusWith<int64_t> status = compactCollection(opCtx, nss, &estimatedReclaimableBytes);
         uassertStatusOK(status.getStatus());
         result.appendNumber("bytesFreed", static_cast<long long>(status.getValue()));
+        result.appendNumber("estimatedBytesReclaimable",
+                            static_cast<long long>(estimatedReclaimableBytes));
 
         return true;
     }
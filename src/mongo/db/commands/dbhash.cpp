@@ -31,17 +31,26 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <array>
 #include <boost/optional.hpp>
+#include <deque>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
+
+#include <third_party/murmurhash3/MurmurHash3.h>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog_helper.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/dbhash_gen.h"
 #include "mongo/db/commands/test_commands_enabled.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/logical_clock.h"
@@ -51,15 +60,216 @@
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/log.h"
 #include "mongo/util/md5.hpp"
 #include "mongo/util/net/socket_utils.h"
+#include "mongo/util/progress_meter.h"
 #include "mongo/util/timer.h"
 
 namespace mongo {
 
 namespace {
 
+enum class HashAlgorithm { kMD5, kMurmur3 };
+
+// The documents of a collection are hashed in batches of about this many bytes. With murmur3 the
+// batch boundaries are part of the collection's hash, so this must be the same on every node.
+const size_t kHashBatchBytes = 4 * 1024 * 1024;  // 4MB.
+
+// The pool is shared by all dbHash commands and lives for the rest of the process. Its idle threads
+// are reaped, and it never needs more than the most threads any one command may use.
+ThreadPool* getHashingPool() {
+    static ThreadPool* const hashingPool = [] {
+        ThreadPool::Options poolOptions;
+        poolOptions.poolName = "DbHash";
+        poolOptions.minThreads = 0;
+        poolOptions.maxThreads = 64;
+        auto pool = new ThreadPool(poolOptions);
+        pool->startup();
+        return pool;
+    }();
+    return hashingPool;
+}
+
+std::string hashBytes(HashAlgorithm algorithm, StringData bytes) {
+    md5digest d;
+    if (algorithm == HashAlgorithm::kMD5) {
+        md5(bytes.rawData(), bytes.size(), d);
+    } else {
+        MurmurHash3_x64_128(bytes.rawData(), bytes.size(), 0, d);
+    }
+    return digestToString(d);
+}
+
+/**
+ * Bounds the number of batches that one dbHash command has waiting to be hashed or being hashed,
+ * and so the memory they hold.
+ */
+class HashingBudget {
+public:
+    explicit HashingBudget(int maxBatches) : _available(maxBatches) {}
+
+    void acquire(OperationContext* opCtx) {
+        stdx::unique_lock<Latch> lk(_mutex);
+        opCtx->waitForConditionOrInterrupt(_batchReleased, lk, [&] { return _available > 0; });
+        --_available;
+    }
+
+    void release() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        ++_available;
+        _batchReleased.notify_one();
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("HashingBudget::_mutex");
+    stdx::condition_variable _batchReleased;
+    int _available;
+};
+
+/**
+ * Hashes the documents of one collection, in the order in which they are appended, on the hashing
+ * pool while the scan moves on. With md5 the batches are hashed one after another into a single
+ * digest, which is the md5 of all the documents in order. With murmur3 each batch is hashed on its
+ * own and the collection's hash is the hash of the batch hashes in order, so the batches of a large
+ * collection are hashed in parallel. Without a pool, each batch is hashed as soon as it fills.
+ */
+class CollectionHasher : public std::enable_shared_from_this<CollectionHasher> {
+public:
+    CollectionHasher(HashAlgorithm algorithm,
+                     ThreadPool* pool,
+                     std::shared_ptr<HashingBudget> budget)
+        : _algorithm(algorithm), _pool(pool), _budget(std::move(budget)) {
+        md5_init(&_md5State);
+    }
+
+    void append(OperationContext* opCtx, const BSONObj& doc) {
+        _batch.append(doc.objdata(), doc.objsize());
+        if (_batch.size() >= kHashBatchBytes) {
+            _submitBatch(opCtx);
+        }
+    }
+
+    /**
+     * Waits for every batch to be hashed and returns the collection's hash.
+     */
+    std::string finish(OperationContext* opCtx) {
+        if (!_batch.empty()) {
+            _submitBatch(opCtx);
+        }
+
+        stdx::unique_lock<Latch> lk(_mutex);
+        opCtx->waitForConditionOrInterrupt(_batchHashed, lk, [&] { return _numPending == 0; });
+
+        if (_algorithm == HashAlgorithm::kMD5) {
+            md5digest d;
+            md5_finish(&_md5State, d);
+            return digestToString(d);
+        }
+        return hashBytes(_algorithm,
+                         StringData(reinterpret_cast<const char*>(_batchHashes.data()),
+                                    _batchHashes.size() * sizeof(BatchHash)));
+    }
+
+private:
+    using BatchHash = std::array<unsigned char, 16>;
+
+    void _submitBatch(OperationContext* opCtx) {
+        std::string batch;
+        batch.swap(_batch);
+
+        if (!_pool) {
+            _hashBatch(_numBatches++, batch);
+            return;
+        }
+
+        _budget->acquire(opCtx);
+        const size_t index = _numBatches++;
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            ++_numPending;
+            if (_algorithm == HashAlgorithm::kMD5) {
+                // The md5 batches are queued and hashed in order by one task at a time.
+                _md5Queue.push_back(std::move(batch));
+                if (_md5Draining) {
+                    return;
+                }
+                _md5Draining = true;
+            }
+        }
+
+        // The pool only fails to schedule a task when it is shutting down, and then runs the task
+        // on this thread, so the batch is hashed either way.
+        if (_algorithm == HashAlgorithm::kMD5) {
+            _pool->schedule([self = shared_from_this()](Status) { self->_drainMD5Queue(); });
+            return;
+        }
+        _pool->schedule([self = shared_from_this(), index, batch = std::move(batch)](Status) {
+            self->_hashBatch(index, batch);
+            self->_onBatchHashed();
+        });
+    }
+
+    void _hashBatch(size_t index, const std::string& batch) {
+        if (_algorithm == HashAlgorithm::kMD5) {
+            md5_append(
+                &_md5State, reinterpret_cast<const md5_byte_t*>(batch.data()), batch.size());
+            return;
+        }
+
+        BatchHash hash;
+        MurmurHash3_x64_128(batch.data(), batch.size(), 0, hash.data());
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_batchHashes.size() <= index) {
+            _batchHashes.resize(index + 1);
+        }
+        _batchHashes[index] = hash;
+    }
+
+    void _drainMD5Queue() {
+        stdx::unique_lock<Latch> lk(_mutex);
+        while (!_md5Queue.empty()) {
+            auto batch = std::move(_md5Queue.front());
+            _md5Queue.pop_front();
+            lk.unlock();
+            _hashBatch(0, batch);
+            _onBatchHashed();
+            lk.lock();
+        }
+        _md5Draining = false;
+    }
+
+    void _onBatchHashed() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            --_numPending;
+            _batchHashed.notify_all();
+        }
+        _budget->release();
+    }
+
+    const HashAlgorithm _algorithm;
+    ThreadPool* const _pool;
+    const std::shared_ptr<HashingBudget> _budget;
+
+    // Only used by the scanning thread.
+    std::string _batch;
+    size_t _numBatches = 0;
+
+    // Only used by one thread at a time: the scanning thread without a pool, otherwise the task
+    // draining '_md5Queue', and the scanning thread once every batch is hashed.
+    md5_state_t _md5State;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("CollectionHasher::_mutex");
+    stdx::condition_variable _batchHashed;
+    size_t _numPending = 0;
+    std::deque<std::string> _md5Queue;
+    bool _md5Draining = false;
+    std::vector<BatchHash> _batchHashes;
+};
+
 class DBHashCmd : public ErrmsgCommandDeprecated {
 public:
     DBHashCmd() : ErrmsgCommandDeprecated("dbHash", "dbhash") {}
@@ -112,6 +322,22 @@ public:
             }
         }
 
+        auto algorithm = HashAlgorithm::kMD5;
+        if (auto elem = cmdObj["hashAlgorithm"]) {
+            uassert(ErrorCodes::TypeMismatch,
+                    "The 'hashAlgorithm' option must be a string",
+                    elem.type() == BSONType::String);
+            if (elem.valueStringData() == "murmur3") {
+                algorithm = HashAlgorithm::kMurmur3;
+            } else {
+                uassert(ErrorCodes::BadValue,
+                        str::stream() << "Unknown 'hashAlgorithm' " << elem.valueStringData()
+                                      << "; expected 'md5' or 'murmur3'",
+                        elem.valueStringData() == "md5");
+            }
+        }
+        const StringData algorithmName = algorithm == HashAlgorithm::kMD5 ? "md5"_sd : "murmur3"_sd;
+
         const std::string ns = parseNs(dbname, cmdObj);
         uassert(ErrorCodes::InvalidNamespace,
                 str::stream() << "Invalid db name: " << ns,
@@ -209,10 +435,14 @@ public:
 
         result.append("host", prettyHostName());
 
-        md5_state_t globalState;
-        md5_init(&globalState);
+        // The documents are hashed on up to 'maxDbHashThreads' threads, each with one batch at a
+        // time, while this thread scans.
+        const int numHashingThreads = gMaxDbHashThreads.load();
+        ThreadPool* const pool = numHashingThreads > 0 ? getHashingPool() : nullptr;
+        auto budget = std::make_shared<HashingBudget>(std::max(numHashingThreads, 1));
 
         std::map<std::string, std::string> collectionToHashMap;
+        std::map<std::string, std::shared_ptr<CollectionHasher>> collectionToHasherMap;
         std::map<std::string, OptionalCollectionUUID> collectionToUUIDMap;
         std::set<std::string> cappedCollectionSet;
 
@@ -276,16 +506,24 @@ public:
                 collectionToUUIDMap[collNss.coll().toString()] = uuid;
             }
 
-            // Compute the hash for this collection.
-            std::string hash = _hashCollection(opCtx, db, collNss);
-
-            collectionToHashMap[collNss.coll().toString()] = hash;
+            // Scan this collection. Its hash is collected once every collection has been scanned,
+            // so that hashing it overlaps with scanning the collections after it.
+            auto hasher = std::make_shared<CollectionHasher>(algorithm, pool, budget);
+            if (_hashCollection(opCtx, db, collNss, hasher.get())) {
+                collectionToHasherMap[collNss.coll().toString()] = std::move(hasher);
+            } else {
+                collectionToHashMap[collNss.coll().toString()] = "no _id _index";
+            }
 
             return true;
         });
         if (!noError)
             return false;
 
+        for (auto&& entry : collectionToHasherMap) {
+            collectionToHashMap[entry.first] = entry.second->finish(opCtx);
+        }
+
         BSONObjBuilder bb(result.subobjStart("collections"));
         BSONArrayBuilder cappedCollections;
         BSONObjBuilder collectionsByUUID;
@@ -300,11 +538,12 @@ public:
             uuid->appendToBuilder(&collectionsByUUID, collName);
         }
 
+        std::string allHashes;
         for (auto entry : collectionToHashMap) {
             auto collName = entry.first;
             auto hash = entry.second;
             bb.append(collName, hash);
-            md5_append(&globalState, (const md5_byte_t*)hash.c_str(), hash.size());
+            allHashes += hash;
         }
 
         bb.done();
@@ -312,18 +551,21 @@ public:
         result.append("capped", BSONArray(cappedCollections.done()));
         result.append("uuids", collectionsByUUID.done());
 
-        md5digest d;
-        md5_finish(&globalState, d);
-        std::string hash = digestToString(d);
-
-        result.append("md5", hash);
+        result.append(algorithmName, hashBytes(algorithm, allHashes));
         result.appendNumber("timeMillis", timer.millis());
 
         return 1;
     }
 
 private:
-    std::string _hashCollection(OperationContext* opCtx, Database* db, const NamespaceString& nss) {
+    /**
+     * Scans the collection in _id order and appends its documents to 'hasher'. Returns false if the
+     * collection has no _id index to scan.
+     */
+    bool _hashCollection(OperationContext* opCtx,
+                         Database* db,
+                         const NamespaceString& nss,
+                         CollectionHasher* hasher) {
 
         Collection* collection = CollectionCatalog::get(opCtx).lookupCollectionByNamespace(nss);
         invariant(collection);
@@ -370,19 +612,23 @@ private:
                 opCtx, nss.ns(), collection, PlanExecutor::NO_YIELD);
         } else {
             log() << "can't find _id index for: " << nss;
-            return "no _id _index";
+            return false;
         }
 
-        md5_state_t st;
-        md5_init(&st);
+        ProgressMeterHolder progress;
+        {
+            const std::string curopMessage = "dbHash: hashing " + nss.ns();
+            stdx::unique_lock<Client> lk(*opCtx->getClient());
+            progress.set(CurOp::get(opCtx)->setProgress_inlock(curopMessage,
+                                                               collection->numRecords(opCtx)));
+        }
 
-        long long n = 0;
         PlanExecutor::ExecState state;
         BSONObj c;
         verify(nullptr != exec.get());
         while (PlanExecutor::ADVANCED == (state = exec->getNext(&c, nullptr))) {
-            md5_append(&st, (const md5_byte_t*)c.objdata(), c.objsize());
-            n++;
+            hasher->append(opCtx, c);
+            progress.hit();
         }
         if (PlanExecutor::IS_EOF != state) {
             warning() << "error while hashing, db dropped? ns=" << nss;
@@ -390,11 +636,7 @@ private:
                       "Plan executor error while running dbHash command: " +
                           WorkingSetCommon::toStatusString(c));
         }
-        md5digest d;
-        md5_finish(&st, d);
-        std::string hash = digestToString(d);
-
-        return hash;
+        return true;
     }
 
 } dbhashCmd;
@@ -494,6 +494,7 @@ public:
             Document doc;
             PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
             std::uint64_t numResults = 0;
+            bool reservedForLargeBatch = false;
             while (!FindCommon::enoughForFirstBatch(originalQR, numResults) &&
                    PlanExecutor::ADVANCED == (state = exec->getNext(&doc, nullptr))) {
                 // If we can't fit this result inside the current batch, then we stash it for later.
@@ -506,6 +507,16 @@ public:
                 // Add result to output buffer.
                 firstBatch.append(obj);
                 numResults++;
+
+                // Only kInitReplyBufferSize is reserved up front, so a large first batch would
+                // otherwise grow the reply buffer by doubling it repeatedly.
+                const size_t bytesUsed = firstBatch.bytesUsed();
+                if (!reservedForLargeBatch &&
+                    bytesUsed > static_cast<size_t>(FindCommon::kInitReplyBufferSize)) {
+                    reservedForLargeBatch = true;
+                    firstBatch.reserveBytes(FindCommon::estimateRemainingFirstBatchBytes(
+                        originalQR, numResults, bytesUsed));
+                }
             }
 
             // Throw an assertion if query execution fails for any reason.
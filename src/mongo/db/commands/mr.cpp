@@ -97,6 +97,11 @@ namespace {
 
 Rarely mapParamsDeprecationSampler;  // Used to occasionally log deprecation messages.
 
+// Limits on the number and total size of input documents passed to a single Mapper::mapBatch()
+// call.
+const size_t kMapBatchSize = 100;
+const int kMapBatchMaxBytes = 1024 * 1024;
+
 /**
  * Runs a count against the namespace specified by 'ns'. If the caller holds the global write lock,
  * then this function does not acquire any additional locks.
@@ -252,6 +257,21 @@ void JSFunction::init(State* state) {
 void JSMapper::init(State* state) {
     _func.init(state);
     _params = state->config().mapParams;
+
+    BSONArrayBuilder paramsArray;
+    for (auto&& param : _params) {
+        paramsArray.append(param);
+    }
+    _paramsArray = paramsArray.arr();
+
+    // _map is installed in the scope by JSFunction::init().
+    _mapBatchFunc = _func.scope()->createFunction(
+        "function(docs, params) {"
+        "    for (var i = 0; i < docs.length; i++) {"
+        "        _map.apply(docs[i], params);"
+        "    }"
+        "}");
+    uassert(ErrorCodes::InternalError, "couldn't compile code for: _mapBatch", _mapBatchFunc);
 }
 
 /**
@@ -264,6 +284,29 @@ void JSMapper::map(const BSONObj& o) {
         uasserted(9014, str::stream() << "map invoke failed: " << s->getError());
 }
 
+void JSMapper::mapBatch(const std::vector<BSONObj>& docs) {
+    if (docs.size() == 1) {
+        map(docs.front());
+        return;
+    }
+
+    Scope* s = _func.scope();
+    verify(s);
+
+    BSONObjBuilder args;
+    {
+        BSONArrayBuilder docsArray(args.subarrayStart("docs"));
+        for (auto&& doc : docs) {
+            docsArray.append(doc);
+        }
+    }
+    args.append("params", _paramsArray);
+
+    const auto argsObj = args.done();
+    if (s->invoke(_mapBatchFunc, &argsObj, nullptr, 0, true))
+        uasserted(9014, str::stream() << "map invoke failed: " << s->getError());
+}
+
 /**
  * Applies the finalize function to a tuple obj (key, val)
  * Returns tuple obj {_id: key, value: newval}
@@ -1532,6 +1575,27 @@ bool runMapReduce(OperationContext* opCtx,
 
             Timer mt;
 
+            // Documents are handed to the mapper in batches, to amortize the cost of calling into
+            // the JS engine.
+            std::vector<BSONObj> mapBatch;
+            int mapBatchBytes = 0;
+            const auto mapPendingBatch = [&] {
+                if (mapBatch.empty()) {
+                    return;
+                }
+
+                if (config.verbose)
+                    mt.reset();
+
+                config.mapper->mapBatch(mapBatch);
+
+                if (config.verbose)
+                    mapTime += mt.micros();
+
+                mapBatch.clear();
+                mapBatchBytes = 0;
+            };
+
             BSONObj o;
             PlanExecutor::ExecState execState;
             while (PlanExecutor::ADVANCED == (execState = exec->getNext(&o, nullptr))) {
@@ -1546,18 +1610,20 @@ bool runMapReduce(OperationContext* opCtx,
                     }
                 }
 
-                if (config.verbose)
-                    mt.reset();
-
-                config.mapper->map(o);
-
-                if (config.verbose)
-                    mapTime += mt.micros();
+                mapBatchBytes += o.objsize();
+                mapBatch.push_back(std::move(o));
+                if (mapBatch.size() >= kMapBatchSize || mapBatchBytes >= kMapBatchMaxBytes) {
+                    mapPendingBatch();
+                }
 
                 // Check if the state accumulated so far needs to be written to a collection.
                 // This may yield the DB lock temporarily and then acquire it again.
                 numInputs++;
                 if (numInputs % 100 == 0) {
+                    // Run the map function over any buffered documents so that their emits are
+                    // accounted for before deciding whether to spill.
+                    mapPendingBatch();
+
                     Timer t;
 
                     // TODO: As an optimization, we might want to do the save/restore state and
@@ -1583,6 +1649,8 @@ bool runMapReduce(OperationContext* opCtx,
                     break;
             }
 
+            mapPendingBatch();
+
             if (PlanExecutor::FAILURE == execState) {
                 uasserted(ErrorCodes::OperationFailed,
                           str::stream() << "Executor error during mapReduce command: "
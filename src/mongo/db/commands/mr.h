@@ -63,6 +63,16 @@ public:
 
     virtual void map(const BSONObj& o) = 0;
 
+    /**
+     * Maps each of 'docs' in order. Mappers which have a fixed cost per call can override this to
+     * map all of them at once.
+     */
+    virtual void mapBatch(const std::vector<BSONObj>& docs) {
+        for (auto&& doc : docs) {
+            map(doc);
+        }
+    }
+
 protected:
     Mapper() = default;
 };
@@ -139,11 +149,20 @@ class JSMapper : public Mapper {
 public:
     JSMapper(const BSONElement& code) : _func("_map", code) {}
     virtual void map(const BSONObj& o);
+    virtual void mapBatch(const std::vector<BSONObj>& docs);
     virtual void init(State* state);
 
 private:
     JSFunction _func;
     BSONObj _params;
+
+    // Calls the map function for each document of an array, so that a batch of documents crosses
+    // into the JS engine in one invocation.
+    ScriptingFunction _mapBatchFunc;
+
+    // The values of '_params', as the array of arguments passed to the map function by
+    // '_mapBatchFunc'.
+    BSONObj _paramsArray;
 };
 
 class JSReducer : public Reducer {
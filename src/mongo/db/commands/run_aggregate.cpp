@@ -47,6 +47,7 @@
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/aggregation_result_cache.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_geo_near.h"
@@ -62,10 +63,12 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/speculative_majority_read_info.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/service_context.h"
@@ -121,12 +124,15 @@ bool canOptimizeAwayPipeline(const Pipeline* pipeline,
  * requests). Otherwise, returns false. The passed 'nsForCursor' is only used to determine the
  * namespace used in the returned cursor, which will be registered with the global cursor manager,
  * and thus will be different from that in 'request'.
+ *
+ * If 'batchOut' is non-null, every document added to the first batch is also appended to it.
  */
 bool handleCursorCommand(OperationContext* opCtx,
                          const NamespaceString& nsForCursor,
                          std::vector<ClientCursor*> cursors,
                          const AggregationRequest& request,
-                         rpc::ReplyBuilderInterface* result) {
+                         rpc::ReplyBuilderInterface* result,
+                         std::vector<BSONObj>* batchOut = nullptr) {
     invariant(!cursors.empty());
     long long batchSize = request.getBatchSize();
 
@@ -226,6 +232,9 @@ bool handleCursorCommand(OperationContext* opCtx,
         // If this executor produces a postBatchResumeToken, add it to the cursor response.
         responseBuilder.setPostBatchResumeToken(exec->getPostBatchResumeToken());
         responseBuilder.append(next);
+        if (batchOut) {
+            batchOut->push_back(next);
+        }
     }
 
     if (cursor) {
@@ -256,6 +265,79 @@ bool handleCursorCommand(OperationContext* opCtx,
     return static_cast<bool>(cursor);
 }
 
+/**
+ * Returns the key under which the results of this aggregation may be cached, or boost::none if the
+ * request did not opt in to the aggregation result cache or the aggregation is not eligible for
+ * it. Only read-only aggregations over a single collection are eligible, and only if they read the
+ * latest data, so that their results can only change when the collection's write generation does.
+ */
+boost::optional<std::string> makeResultCacheKey(OperationContext* opCtx,
+                                                const AggregationRequest& request,
+                                                const LiteParsedPipeline& liteParsedPipeline,
+                                                const Collection* collection,
+                                                const Pipeline& pipeline) {
+    if (!request.getResultCacheMaxStaleness() ||
+        internalQueryAggregationResultCacheMaxBytes.load() == 0) {
+        return boost::none;
+    }
+
+    if (request.getExplain() || request.isFromMongos() || request.needsMerge() ||
+        request.getExchangeSpec() || opCtx->inMultiDocumentTransaction() ||
+        liteParsedPipeline.hasChangeStream() ||
+        !liteParsedPipeline.getInvolvedNamespaces().empty() || !collection ||
+        collection->isCapped()) {
+        return boost::none;
+    }
+
+    // Reads on a secondary, or at a point in time other than the latest, may not observe writes
+    // which have already advanced the write generation.
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    const auto readConcernLevel = readConcernArgs.getLevel();
+    if ((readConcernLevel != repl::ReadConcernLevel::kLocalReadConcern &&
+         readConcernLevel != repl::ReadConcernLevel::kAvailableReadConcern) ||
+        readConcernArgs.getArgsOpTime() || readConcernArgs.getArgsAfterClusterTime() ||
+        readConcernArgs.getArgsAtClusterTime() ||
+        !repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, collection->ns())) {
+        return boost::none;
+    }
+
+    BSONArrayBuilder serializedPipeline;
+    for (auto&& stage : pipeline.getSources()) {
+        if (stage->constraints().writesPersistentData()) {
+            return boost::none;
+        }
+    }
+    for (auto&& stage : pipeline.serialize()) {
+        stage.addToBsonArray(&serializedPipeline);
+    }
+
+    return AggregationResultCache::makeKey(collection->ns(),
+                                           collection->uuid(),
+                                           serializedPipeline.arr(),
+                                           request.getCollation(),
+                                           request.getHint());
+}
+
+/**
+ * Replies to the aggregate command with 'results' as a single, exhausted batch.
+ */
+void appendCachedResults(OperationContext* opCtx,
+                         const NamespaceString& nsForCursor,
+                         const std::vector<BSONObj>& results,
+                         rpc::ReplyBuilderInterface* result) {
+    CursorResponseBuilder::Options options;
+    options.isInitialResponse = true;
+    CursorResponseBuilder responseBuilder(result, options);
+    for (auto&& obj : results) {
+        responseBuilder.append(obj);
+    }
+    responseBuilder.done(0LL, nsForCursor.ns());
+
+    auto curOp = CurOp::get(opCtx);
+    curOp->debug().nreturned = results.size();
+    curOp->debug().cursorExhausted = true;
+}
+
 StatusWith<StringMap<ExpressionContext::ResolvedNamespace>> resolveInvolvedNamespaces(
     OperationContext* opCtx, const AggregationRequest& request) {
     const LiteParsedPipeline liteParsedPipeline(request);
@@ -503,6 +585,11 @@ Status runAggregate(OperationContext* opCtx,
     std::vector<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> execs;
     boost::intrusive_ptr<ExpressionContext> expCtx;
     auto curOp = CurOp::get(opCtx);
+
+    // Set if the results of this aggregation may be stored in the aggregation result cache. The
+    // write generation of the collection is read before the aggregation starts to execute.
+    boost::optional<std::string> resultCacheKey;
+    long long resultCacheWriteGeneration = 0;
     {
         const LiteParsedPipeline liteParsedPipeline(request);
 
@@ -626,6 +713,25 @@ Status runAggregate(OperationContext* opCtx,
             }
         }
 
+        resultCacheKey =
+            makeResultCacheKey(opCtx, request, liteParsedPipeline, collection, *pipeline);
+        if (resultCacheKey) {
+            resultCacheWriteGeneration =
+                CollectionQueryInfo::get(collection).getWriteGeneration();
+            auto cachedResults = AggregationResultCache::get(opCtx)->lookup(
+                *resultCacheKey,
+                resultCacheWriteGeneration,
+                *request.getResultCacheMaxStaleness(),
+                opCtx->getServiceContext()->getFastClockSource()->now());
+            // The cached results are returned in a single batch, so they can only be served to
+            // requests whose batch size is large enough.
+            if (cachedResults &&
+                cachedResults->size() <= static_cast<size_t>(request.getBatchSize())) {
+                appendCachedResults(opCtx, origNss, *cachedResults, result);
+                return Status::OK();
+            }
+        }
+
         pipeline->optimizePipeline();
 
         // Check if the pipeline has a $geoNear stage, as it will be ripped away during the build
@@ -759,10 +865,23 @@ Status runAggregate(OperationContext* opCtx,
         }
     } else {
         // Cursor must be specified, if explain is not.
+        std::vector<BSONObj> batchForResultCache;
         const bool keepCursor =
-            handleCursorCommand(opCtx, origNss, std::move(cursors), request, result);
+            handleCursorCommand(opCtx,
+                                origNss,
+                                std::move(cursors),
+                                request,
+                                result,
+                                resultCacheKey ? &batchForResultCache : nullptr);
         if (keepCursor) {
             cursorFreer.dismiss();
+        } else if (resultCacheKey) {
+            // The first batch holds the complete results, so they can be cached.
+            AggregationResultCache::get(opCtx)->insert(
+                *resultCacheKey,
+                std::move(batchForResultCache),
+                resultCacheWriteGeneration,
+                opCtx->getServiceContext()->getFastClockSource()->now());
         }
 
         PlanSummaryStats stats;
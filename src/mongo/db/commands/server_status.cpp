@@ -161,6 +161,18 @@ public:
         return true;
     }
 
+    void appendSections(OperationContext* opCtx,
+                        const BSONObj& spec,
+                        BSONObjBuilder* result) const {
+        for (auto&& elem : spec) {
+            auto it = _sections.find(elem.fieldName());
+            if (it == _sections.end() || !elem.trueValue()) {
+                continue;
+            }
+            it->second->appendSection(opCtx, elem, result);
+        }
+    }
+
     void addSection(ServerStatusSection* section) {
         // Disallow adding a section named "timing" as it is reserved for the server status command.
         dassert(section->getSectionName() != kTimingSection);
@@ -198,6 +210,12 @@ ServerStatusSection::ServerStatusSection(const string& sectionName) : _sectionNa
     CmdServerStatusInstantiator::getInstance().addSection(this);
 }
 
+void appendServerStatusSections(OperationContext* opCtx,
+                                const BSONObj& spec,
+                                BSONObjBuilder* result) {
+    CmdServerStatusInstantiator::getInstance().appendSections(opCtx, spec, result);
+}
+
 OpCounterServerStatusSection::OpCounterServerStatusSection(const string& sectionName,
                                                            OpCounters* counters)
     : ServerStatusSection(sectionName), _counters(counters) {}
@@ -107,6 +107,18 @@ private:
     const std::string _sectionName;
 };
 
+/**
+ * Appends the sections named in 'spec' as the serverStatus command would, using each element of
+ * 'spec' as the configuration of the section of the same name. Unlike the command, sections which
+ * are not named are left out whether or not they are included by default, and the basic fields
+ * and metrics are not appended. Sections which do not exist are skipped.
+ *
+ * Meant for internal callers, such as diagnostic data capture, which sample a few sections often.
+ */
+void appendServerStatusSections(OperationContext* opCtx,
+                                const BSONObj& spec,
+                                BSONObjBuilder* result);
+
 class OpCounterServerStatusSection : public ServerStatusSection {
 public:
     OpCounterServerStatusSection(const std::string& sectionName, OpCounters* counters);
@@ -32,6 +32,7 @@
 #include <string>
 
 #include "mongo/db/jsobj.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -88,4 +89,13 @@ public:
 private:
     const T* _t;
 };
+
+/**
+ * For gauges, which are set to the current level of something rather than counted up.
+ */
+template <>
+inline void ServerStatusMetricField<AtomicWord<long long>>::appendAtLeaf(
+    BSONObjBuilder& b) const {
+    b.append(_leafName, _t->load());
+}
 }  // namespace mongo
@@ -33,11 +33,15 @@
 
 #include "mongo/config.h"
 #include "mongo/db/commands/server_status.h"
+#include "mongo/db/wait_events.h"
+#include "mongo/logv2/log_domain_global.h"
+#include "mongo/logv2/log_manager.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/service_entry_point.h"
 #include "mongo/util/net/hostname_canonicalization.h"
 #include "mongo/util/net/socket_utils.h"
 #include "mongo/util/net/ssl_manager.h"
+#include "mongo/util/shared_buffer_pool.h"
 
 namespace mongo {
 
@@ -84,6 +88,10 @@ public:
         BSONObjBuilder b;
         networkCounter.append(b);
         appendMessageCompressionStats(&b);
+        {
+            BSONObjBuilder section(b.subobjStart("messageBufferPool"));
+            SharedBufferPool::appendStats(&section);
+        }
         auto executor = opCtx->getServiceContext()->getServiceExecutor();
         if (executor) {
             BSONObjBuilder section(b.subobjStart("serviceExecutorTaskStats"));
@@ -95,6 +103,57 @@ public:
 
 } network;
 
+/**
+ * The number of waits and the time spent in them since startup, for each class of wait an
+ * operation can block on.
+ */
+class WaitEventsStatus : public ServerStatusSection {
+public:
+    WaitEventsStatus() : ServerStatusSection("waitEvents") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder b;
+        WaitEvents::appendGlobalStats(&b);
+        return b.obj();
+    }
+} waitEventsStatus;
+
+/**
+ * Statistics of the background thread writing the log file, when it is enabled, including how
+ * often logging threads had to wait for it to catch up.
+ */
+class AsyncLogWrites : public ServerStatusSection {
+public:
+    AsyncLogWrites() : ServerStatusSection("asyncLogWrites") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        auto stats = logv2::LogManager::global().getGlobalDomainInternal().asyncFileStats();
+        if (!stats) {
+            return BSONObj();
+        }
+
+        BSONObjBuilder b;
+        b.append("queued", stats->queued);
+        b.append("written", stats->written);
+        b.append("bytesWritten", stats->bytesWritten);
+        b.append("writeErrors", stats->writeErrors);
+        b.append("producerWaits", stats->producerWaits);
+        b.append("producerWaitMicros", stats->producerWaitMicros);
+        b.append("capacity", stats->capacity);
+        return b.obj();
+    }
+} asyncLogWrites;
+
 #ifdef MONGO_CONFIG_SSL
 class Security : public ServerStatusSection {
 public:
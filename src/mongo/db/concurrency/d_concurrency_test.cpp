@@ -1406,6 +1406,56 @@ TEST_F(DConcurrencyTestFixture, StressPartitioned) {
     { Lock::GlobalRead r(newClients[1].second.get()); }
 }
 
+TEST_F(DConcurrencyTestFixture, StressGlobalIntentFastPath) {
+    const int kNumIterations = 5000;
+
+    std::vector<std::pair<ServiceContext::UniqueClient, ServiceContext::UniqueOperationContext>>
+        clients = makeKClientsWithLockers(kMaxStressThreads);
+
+    // Intent locks on the global resource are granted without the lock manager's mutexes, so
+    // check that they are still never held together with a conflicting global lock.
+    AtomicWord<int> sharedHolders{0};
+    AtomicWord<int> exclusiveIntentHolders{0};
+    AtomicWord<int> ready{0};
+    std::vector<stdx::thread> threads;
+
+    for (int threadId = 0; threadId < kMaxStressThreads; threadId++) {
+        threads.emplace_back([&, threadId]() {
+            // Busy-wait until everybody is ready
+            ready.fetchAndAdd(1);
+            while (ready.load() < kMaxStressThreads)
+                ;
+
+            auto opCtx = clients[threadId].second.get();
+            for (int i = 0; i < kNumIterations; i++) {
+                if (threadId == 0 && i % 50 == 0) {
+                    Lock::GlobalWrite w(opCtx);
+                    ASSERT_EQ(0, sharedHolders.load());
+                    ASSERT_EQ(0, exclusiveIntentHolders.load());
+                } else if (threadId == 0 && i % 50 == 1) {
+                    Lock::GlobalRead r(opCtx);
+                    ASSERT_EQ(0, exclusiveIntentHolders.load());
+                } else if (i % 2 == 0) {
+                    Lock::GlobalLock is(opCtx, MODE_IS);
+                    sharedHolders.fetchAndAdd(1);
+                    sharedHolders.fetchAndSubtract(1);
+                } else {
+                    Lock::GlobalLock ix(opCtx, MODE_IX);
+                    exclusiveIntentHolders.fetchAndAdd(1);
+                    exclusiveIntentHolders.fetchAndSubtract(1);
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    auto newClients = makeKClientsWithLockers(2);
+    { Lock::GlobalWrite w(newClients[0].second.get()); }
+    { Lock::GlobalRead r(newClients[1].second.get()); }
+}
+
 TEST_F(DConcurrencyTestFixture, ResourceMutexLabels) {
     Lock::ResourceMutex mutex("label");
     ASSERT(mutex.getName() == "label");
@@ -33,7 +33,10 @@
 
 #include "mongo/db/concurrency/flow_control_ticketholder.h"
 
+#include <boost/optional.hpp>
+
 #include "mongo/db/operation_context.h"
+#include "mongo/db/wait_events.h"
 #include "mongo/util/log.h"
 #include "mongo/util/time_support.h"
 
@@ -94,8 +97,11 @@ void FlowControlTicketholder::getTicket(OperationContext* opCtx,
     }
 
     LOG(4) << "Taking ticket. Available: " << _tickets;
+    // Only an acquisition which has to wait for a ticket is reported as a wait event.
+    boost::optional<ScopedWaitEvent> waitEvent;
     if (_tickets == 0) {
         ++stats->acquireWaitCount;
+        waitEvent.emplace(opCtx, WaitEvent::kFlowControl);
     }
 
     auto currentWaitTime = curTimeMicros64();
@@ -142,6 +142,7 @@ struct LockHead {
 
         conversionsCount = 0;
         compatibleFirstCount = 0;
+        fastPathGrantedCount = 0;
     }
 
     /**
@@ -222,6 +223,12 @@ struct LockHead {
      */
     void migratePartitionedLockHeads();
 
+    /**
+     * Blocks 'fastPathLock', the fast path for this lock's resource, and takes over the requests
+     * it granted. Must not be blocked already.
+     */
+    void blockFastPath(FastPathLockHead* fastPathLock);
+
     // Methods to maintain the granted queue
     void incGrantedModeCount(LockMode mode) {
         invariant(grantedCounts[mode] >= 0);
@@ -314,6 +321,11 @@ struct LockHead {
     // be switched to compatible-first. As long as this value is > 0, the policy will stay
     // compatible-first.
     uint32_t compatibleFirstCount;
+
+    // Counts the requests granted by the FastPathLockHead for this resource, which are counted in
+    // grantedCounts since the fast path was blocked, but are not on the granted queue. The fast
+    // path is only opened again once they have all been released.
+    uint32_t fastPathGrantedCount;
 };
 
 /**
@@ -356,6 +368,121 @@ struct PartitionedLockHead {
     LockRequestList grantedList;
 };
 
+/**
+ * The FastPathLockHead grants requests with the intent modes MODE_IS and MODE_IX on one of the
+ * global resources, which every operation locks, without taking any mutex. Even partitioned lock
+ * heads would have all operations of a partition contend on its mutex for them.
+ *
+ * As long as no request with another mode needs the resource, its granted requests are only counted
+ * in a single atomic word. They are neither on a granted queue nor counted by its LockHead.
+ *
+ * Before a request with another mode is put on the LockHead, the LockHead blocks the fast path and
+ * takes over the counts of its granted requests. Requests which find the fast path blocked use the
+ * LockHead, including releases of requests it took over. The fast path is only opened again once
+ * the LockHead has no requests it took over, no conflicts and only intent modes granted.
+ *
+ * Granting and releasing requests is thread-safe. Blocking and opening the fast path must be done
+ * under the bucket lock of the LockHead.
+ */
+struct FastPathLockHead {
+    // Set while the fast path is blocked. The counts of granted requests are then zero.
+    static constexpr uint64_t kBlocked = 1ULL << 63;
+
+    // The count of requests granted in MODE_IS is in the low bits and the count of those granted in
+    // MODE_IX is in the bits from 'kIXCountShift'.
+    static constexpr int kIXCountShift = 32;
+    static constexpr uint64_t kCountMask = (1ULL << 31) - 1;
+
+    static uint64_t countOf(LockMode mode) {
+        invariant(mode == MODE_IS || mode == MODE_IX);
+        return mode == MODE_IX ? 1ULL << kIXCountShift : 1;
+    }
+
+    /**
+     * Grants a request in 'mode', unless the fast path is blocked.
+     */
+    bool tryGrant(LockMode mode) {
+        return _tryUpdate([count = countOf(mode)](uint64_t granted) { return granted + count; });
+    }
+
+    /**
+     * Converts a granted request from 'mode' to 'newMode', unless the fast path is blocked, in
+     * which case its LockHead took the request over.
+     */
+    bool tryConvert(LockMode mode, LockMode newMode) {
+        return _tryUpdate([count = countOf(mode), newCount = countOf(newMode)](uint64_t granted) {
+            invariant(((granted / count) & kCountMask) > 0);
+            return granted - count + newCount;
+        });
+    }
+
+    /**
+     * Releases a granted request in 'mode', unless the fast path is blocked, in which case its
+     * LockHead took the request over.
+     */
+    bool tryRelease(LockMode mode) {
+        return _tryUpdate([count = countOf(mode)](uint64_t granted) {
+            invariant(((granted / count) & kCountMask) > 0);
+            return granted - count;
+        });
+    }
+
+    /**
+     * Blocks the fast path and returns the number of requests it had granted in MODE_IS and in
+     * MODE_IX.
+     */
+    std::pair<uint32_t, uint32_t> block() {
+        uint64_t granted = state.load();
+        while (!state.compareAndSwap(&granted, kBlocked)) {
+        }
+        invariant(!(granted & kBlocked));
+        return {granted & kCountMask, (granted >> kIXCountShift) & kCountMask};
+    }
+
+    void unblock() {
+        uint64_t blocked = kBlocked;
+        invariant(state.compareAndSwap(&blocked, 0));
+    }
+
+    bool isBlocked() const {
+        return state.load() & kBlocked;
+    }
+
+    // Id of the resource which the fast path is for. Initialized at construction time and does
+    // not change.
+    ResourceId resourceId;
+
+    AtomicWord<uint64_t> state{0};
+
+private:
+    template <typename Update>
+    bool _tryUpdate(Update update) {
+        uint64_t granted = state.load();
+        while (!(granted & kBlocked)) {
+            if (state.compareAndSwap(&granted, update(granted))) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+void LockHead::blockFastPath(FastPathLockHead* fastPathLock) {
+    const auto granted = fastPathLock->block();
+    for (const auto& [mode, count] : {std::make_pair(MODE_IS, granted.first),
+                                      std::make_pair(MODE_IX, granted.second)}) {
+        if (count == 0) {
+            continue;
+        }
+        if (grantedCounts[mode] == 0) {
+            invariant((grantedModes & modeMask(mode)) == 0);
+            grantedModes |= modeMask(mode);
+        }
+        grantedCounts[mode] += count;
+        fastPathGrantedCount += count;
+    }
+}
+
 void LockHead::migratePartitionedLockHeads() {
     invariant(partitioned());
 
@@ -400,6 +527,11 @@ const unsigned LockManager::_numLockBuckets(128);
 // The exact value doesn't appear very important, but should be power of two
 const unsigned LockManager::_numPartitions = 32;
 
+// The resources with a FastPathLockHead. These are resourceIdParallelBatchWriterMode,
+// resourceIdReplicationStateTransitionLock and resourceIdGlobal, which may not have been
+// constructed yet when the global lock manager is.
+const unsigned LockManager::_numFastPathLocks = 3;
+
 // static
 std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serviceContext) {
     std::map<LockerId, BSONObj> lockToClientMap;
@@ -429,6 +561,11 @@ std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serv
 LockManager::LockManager() {
     _lockBuckets = new LockBucket[_numLockBuckets];
     _partitions = new Partition[_numPartitions];
+
+    _fastPathLocks = new FastPathLockHead[_numFastPathLocks];
+    _fastPathLocks[0].resourceId = ResourceId(RESOURCE_PBWM, 1ULL);
+    _fastPathLocks[1].resourceId = ResourceId(RESOURCE_RSTL, 1ULL);
+    _fastPathLocks[2].resourceId = ResourceId(RESOURCE_GLOBAL, 1ULL);
 }
 
 LockManager::~LockManager() {
@@ -439,8 +576,13 @@ LockManager::~LockManager() {
         invariant(_lockBuckets[i].data.empty());
     }
 
+    for (unsigned i = 0; i < _numFastPathLocks; i++) {
+        invariant(_fastPathLocks[i].isBlocked() || _fastPathLocks[i].state.load() == 0);
+    }
+
     delete[] _lockBuckets;
     delete[] _partitions;
+    delete[] _fastPathLocks;
 }
 
 LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mode) {
@@ -448,10 +590,20 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
     invariant(request->status == LockRequest::STATUS_NEW);
     invariant(request->recursiveCount == 1);
 
-    request->partitioned = (mode == MODE_IX || mode == MODE_IS);
+    const bool isIntentMode = (mode == MODE_IX || mode == MODE_IS);
+    FastPathLockHead* const fastPathLock = _getFastPathLock(resId);
+
+    request->partitioned = isIntentMode && !fastPathLock;
     request->mode = mode;
 
-    // For intent modes, try the PartitionedLockHead
+    // For intent modes on the global resources, try the FastPathLockHead
+    if (isIntentMode && fastPathLock && fastPathLock->tryGrant(mode)) {
+        request->fastPathLock = fastPathLock;
+        request->status = LockRequest::STATUS_GRANTED;
+        return LOCK_OK;
+    }
+
+    // For other intent modes, try the PartitionedLockHead
     if (request->partitioned) {
         Partition* partition = _getPartition(request);
         stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
@@ -474,8 +626,30 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
 
     LockHead* lock = bucket->findOrInsert(resId);
 
-    // Start a partitioned lock if possible
-    if (request->partitioned && !(lock->grantedModes & (~intentModes)) && !lock->conflictModes) {
+    if (fastPathLock) {
+        if (!isIntentMode) {
+            // Requests granted by the fast path must be accounted for before this one, so block it
+            if (!fastPathLock->isBlocked()) {
+                lock->blockFastPath(fastPathLock);
+            }
+        } else {
+            // Open the fast path again if nothing would conflict with the requests it grants
+            if (fastPathLock->isBlocked() && !(lock->grantedModes & (~intentModes)) &&
+                !lock->conflictModes && !lock->fastPathGrantedCount) {
+                fastPathLock->unblock();
+            }
+
+            // Nobody else can block the fast path while the bucket is locked
+            if (!fastPathLock->isBlocked()) {
+                invariant(fastPathLock->tryGrant(mode));
+                request->fastPathLock = fastPathLock;
+                request->status = LockRequest::STATUS_GRANTED;
+                return LOCK_OK;
+            }
+        }
+    } else if (request->partitioned && !(lock->grantedModes & (~intentModes)) &&
+               !lock->conflictModes) {
+        // Start a partitioned lock if possible
         Partition* partition = _getPartition(request);
         stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
         PartitionedLockHead* partitionedLock = partition->findOrInsert(resId);
@@ -517,13 +691,24 @@ LockResult LockManager::convert(ResourceId resId, LockRequest* request, LockMode
     invariant((LockConflictsTable[request->mode] | LockConflictsTable[newMode]) ==
               LockConflictsTable[newMode]);
 
+    // Conversions between intent modes can stay on the fast path
+    if (request->fastPathLock && (newMode == MODE_IS || newMode == MODE_IX) &&
+        request->fastPathLock->tryConvert(request->mode, newMode)) {
+        request->mode = newMode;
+        return LOCK_OK;
+    }
+
     LockBucket* bucket = _getBucket(resId);
     stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
 
-    LockBucket::Map::iterator it = bucket->data.find(resId);
-    invariant(it != bucket->data.end());
-
-    LockHead* const lock = it->second;
+    LockHead* lock;
+    if (request->fastPathLock) {
+        lock = _leaveFastPath(bucket, request);
+    } else {
+        LockBucket::Map::iterator it = bucket->data.find(resId);
+        invariant(it != bucket->data.end());
+        lock = it->second;
+    }
 
     if (lock->partitioned()) {
         lock->migratePartitionedLockHeads();
@@ -579,6 +764,28 @@ bool LockManager::unlock(LockRequest* request) {
         return false;
     }
 
+    if (request->fastPathLock) {
+        invariant(request->status == LockRequest::STATUS_GRANTED);
+        if (request->fastPathLock->tryRelease(request->mode)) {
+            return true;
+        }
+
+        // The fast path was blocked since the request was granted, so the LockHead took it over.
+        LockBucket* bucket = _getBucket(request->fastPathLock->resourceId);
+        stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
+
+        LockBucket::Map::iterator it = bucket->data.find(request->fastPathLock->resourceId);
+        invariant(it != bucket->data.end());
+        LockHead* const lock = it->second;
+
+        invariant(lock->fastPathGrantedCount > 0);
+        lock->fastPathGrantedCount--;
+        lock->decGrantedModeCount(request->mode);
+
+        _onLockModeChanged(lock, lock->grantedCounts[request->mode] == 0);
+        return true;
+    }
+
     if (request->partitioned) {
         // Unlocking a lock that was acquired as partitioned. The lock request may since have
         // moved to the lock head, but there is no safe way to find out without synchronizing
@@ -649,7 +856,7 @@ bool LockManager::unlock(LockRequest* request) {
 }
 
 void LockManager::downgrade(LockRequest* request, LockMode newMode) {
-    invariant(request->lock);
+    invariant(request->lock || request->fastPathLock);
     invariant(request->status == LockRequest::STATUS_GRANTED);
     invariant(request->recursiveCount > 0);
 
@@ -658,11 +865,18 @@ void LockManager::downgrade(LockRequest* request, LockMode newMode) {
     invariant((LockConflictsTable[request->mode] | LockConflictsTable[newMode]) ==
               LockConflictsTable[request->mode]);
 
-    LockHead* lock = request->lock;
+    // Only an IX request can be downgraded on the fast path, and only to IS
+    if (request->fastPathLock && request->fastPathLock->tryConvert(request->mode, newMode)) {
+        request->mode = newMode;
+        return;
+    }
 
-    LockBucket* bucket = _getBucket(lock->resourceId);
+    LockBucket* bucket = _getBucket(request->fastPathLock ? request->fastPathLock->resourceId
+                                                          : request->lock->resourceId);
     stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
 
+    LockHead* lock = request->fastPathLock ? _leaveFastPath(bucket, request) : request->lock;
+
     lock->incGrantedModeCount(newMode);
     lock->decGrantedModeCount(request->mode);
     request->mode = newMode;
@@ -690,6 +904,7 @@ void LockManager::_cleanupUnusedLocksInBucket(LockBucket* bucket) {
 
         if (lock->grantedModes == 0) {
             invariant(lock->grantedModes == 0);
+            invariant(lock->fastPathGrantedCount == 0);
             invariant(lock->grantedList._front == nullptr);
             invariant(lock->grantedList._back == nullptr);
             invariant(lock->conflictModes == 0);
@@ -812,8 +1027,9 @@ void LockManager::_onLockModeChanged(LockHead* lock, bool checkConflictQueue) {
     }
 
     // This is a convenient place to check that the state of the two request queues is in sync
-    // with the bitmask on the modes.
-    invariant((lock->grantedModes == 0) ^ (lock->grantedList._front != nullptr));
+    // with the bitmask on the modes. Requests taken over from the fast path are only counted.
+    invariant((lock->grantedModes == 0) ^
+              (lock->grantedList._front != nullptr || lock->fastPathGrantedCount > 0));
     invariant((lock->conflictModes == 0) ^ (lock->conflictList._front != nullptr));
 }
 
@@ -825,6 +1041,31 @@ LockManager::Partition* LockManager::_getPartition(LockRequest* request) const {
     return &_partitions[request->locker->getId() % _numPartitions];
 }
 
+FastPathLockHead* LockManager::_getFastPathLock(ResourceId resId) const {
+    for (unsigned i = 0; i < _numFastPathLocks; i++) {
+        if (_fastPathLocks[i].resourceId == resId) {
+            return &_fastPathLocks[i];
+        }
+    }
+    return nullptr;
+}
+
+LockHead* LockManager::_leaveFastPath(LockBucket* bucket, LockRequest* request) {
+    FastPathLockHead* const fastPathLock = request->fastPathLock;
+    LockHead* const lock = bucket->findOrInsert(fastPathLock->resourceId);
+    if (!fastPathLock->isBlocked()) {
+        lock->blockFastPath(fastPathLock);
+    }
+
+    // The request is already counted as granted, it only needs to go on the granted queue
+    invariant(lock->fastPathGrantedCount > 0);
+    lock->fastPathGrantedCount--;
+    request->fastPathLock = nullptr;
+    request->lock = lock;
+    lock->grantedList.push_back(request);
+    return lock;
+}
+
 void LockManager::dump() const {
     log() << "Dumping LockManager @ " << static_cast<const void*>(this) << '\n';
 
@@ -1038,6 +1279,7 @@ void LockRequest::initNew(Locker* locker, LockGrantNotification* notify) {
 
     lock = nullptr;
     partitionedLock = nullptr;
+    fastPathLock = nullptr;
     prev = nullptr;
     next = nullptr;
     status = STATUS_NEW;
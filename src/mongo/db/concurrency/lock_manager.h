@@ -177,6 +177,18 @@ private:
      */
     Partition* _getPartition(LockRequest* request) const;
 
+    /**
+     * Retrieves the FastPathLockHead for a resource, or nullptr if intent locks on it do not have a
+     * fast path.
+     */
+    FastPathLockHead* _getFastPathLock(ResourceId resId) const;
+
+    /**
+     * Moves a request granted by a FastPathLockHead to the granted queue of the LockHead, blocking
+     * the fast path if it is not already. Must be called under the bucket's mutex.
+     */
+    LockHead* _leaveFastPath(LockBucket* bucket, LockRequest* request);
+
     /**
      * Prints the contents of a bucket to the log.
      */
@@ -224,5 +236,8 @@ private:
 
     static const unsigned _numPartitions;
     Partition* _partitions;
+
+    static const unsigned _numFastPathLocks;
+    FastPathLockHead* _fastPathLocks;
 };
 }  // namespace mongo
@@ -48,6 +48,7 @@ class Locker;
 
 struct LockHead;
 struct PartitionedLockHead;
+struct FastPathLockHead;
 
 /**
  * LockMode compatibility matrix.
@@ -426,6 +427,15 @@ struct LockRequest {
     // Protected by LockHead bucket's mutex
     PartitionedLockHead* partitionedLock;
 
+    // Pointer to the fast path lock which granted this request, or null if it was not granted by
+    // a fast path lock or has since moved to the granted queue of 'lock'. A request which is
+    // granted by a fast path lock is on neither 'lock' nor 'partitionedLock'.
+    //
+    // Written by LockManager on Locker thread
+    // Read by LockManager on Locker thread
+    // No synchronization
+    FastPathLockHead* fastPathLock;
+
     // The linked list chain on which this request hangs off the owning lock head. The reason
     // intrusive linked list is used instead of the std::list class is to allow for entries to be
     // removed from the middle of the list in O(1) time, if they are known instead of having to
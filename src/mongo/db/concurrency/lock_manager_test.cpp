@@ -952,4 +952,120 @@ TEST(LockManager, Fairness) {
     ASSERT(lockMgr.unlock(&requestIX1));
 }
 
+
+TEST(LockManager, FastPathFairness) {
+    LockManager lockMgr;
+
+    // Intent locks on the global resource are granted on the fast path
+    LockerImpl lockerIS;
+    LockRequestCombo requestIS(&lockerIS);
+    ASSERT(LOCK_OK == lockMgr.lock(resourceIdGlobal, &requestIS, MODE_IS));
+    ASSERT(requestIS.fastPathLock);
+
+    LockerImpl lockerIX;
+    LockRequestCombo requestIX(&lockerIX);
+    ASSERT(LOCK_OK == lockMgr.lock(resourceIdGlobal, &requestIX, MODE_IX));
+    ASSERT(requestIX.fastPathLock);
+
+    // A conflicting lock has to wait for them
+    LockerImpl lockerX;
+    LockRequestCombo requestX(&lockerX);
+    ASSERT(LOCK_WAITING == lockMgr.lock(resourceIdGlobal, &requestX, MODE_X));
+
+    // Whoever comes next is blocked, instead of being granted on the fast path
+    LockerImpl lockerIX1;
+    LockRequestCombo requestIX1(&lockerIX1);
+    ASSERT(LOCK_WAITING == lockMgr.lock(resourceIdGlobal, &requestIX1, MODE_IX));
+    ASSERT(!requestIX1.fastPathLock);
+
+    // Freeing the first two locks should grant the X lock
+    ASSERT(lockMgr.unlock(&requestIS));
+    ASSERT_EQ(0, requestX.numNotifies);
+    ASSERT(lockMgr.unlock(&requestIX));
+    ASSERT_EQ(LOCK_OK, requestX.lastResult);
+    ASSERT_EQ(1, requestX.numNotifies);
+    ASSERT_EQ(0, requestIX1.numNotifies);
+
+    ASSERT(lockMgr.unlock(&requestX));
+    ASSERT_EQ(LOCK_OK, requestIX1.lastResult);
+    ASSERT_EQ(1, requestIX1.numNotifies);
+
+    // With only intent locks left, the fast path opens again
+    LockerImpl lockerIS1;
+    LockRequestCombo requestIS1(&lockerIS1);
+    ASSERT(LOCK_OK == lockMgr.lock(resourceIdGlobal, &requestIS1, MODE_IS));
+    ASSERT(requestIS1.fastPathLock);
+
+    ASSERT(lockMgr.unlock(&requestIX1));
+    ASSERT(lockMgr.unlock(&requestIS1));
+}
+
+TEST(LockManager, FastPathConversion) {
+    LockManager lockMgr;
+
+    LockerImpl locker1;
+    LockRequestCombo request1(&locker1);
+    ASSERT(LOCK_OK == lockMgr.lock(resourceIdGlobal, &request1, MODE_IS));
+
+    // Converting between intent modes stays on the fast path
+    ASSERT(LOCK_OK == lockMgr.convert(resourceIdGlobal, &request1, MODE_IX));
+    ASSERT(request1.mode == MODE_IX);
+    ASSERT(request1.fastPathLock);
+
+    LockerImpl locker2;
+    LockRequestCombo request2(&locker2);
+    ASSERT(LOCK_OK == lockMgr.lock(resourceIdGlobal, &request2, MODE_IS));
+
+    // Converting to a conflicting mode waits for the other fast path grants
+    ASSERT(LOCK_WAITING == lockMgr.convert(resourceIdGlobal, &request2, MODE_S));
+    ASSERT(!request2.fastPathLock);
+    ASSERT_EQ(0, request2.numNotifies);
+
+    ASSERT(!lockMgr.unlock(&request1));
+    ASSERT_EQ(0, request2.numNotifies);
+    ASSERT(lockMgr.unlock(&request1));
+    ASSERT_EQ(1, request2.numNotifies);
+    ASSERT(request2.mode == MODE_S);
+
+    ASSERT(!lockMgr.unlock(&request2));
+    ASSERT(lockMgr.unlock(&request2));
+}
+
+TEST(LockManager, FastPathDowngrade) {
+    LockManager lockMgr;
+
+    LockerImpl locker1;
+    LockRequestCombo request1(&locker1);
+    ASSERT(LOCK_OK == lockMgr.lock(resourceIdGlobal, &request1, MODE_IX));
+
+    LockerImpl locker2;
+    LockRequestCombo request2(&locker2);
+    ASSERT(LOCK_WAITING == lockMgr.lock(resourceIdGlobal, &request2, MODE_S));
+
+    // The IX request was taken over when the fast path was blocked, so it is downgraded on the
+    // LockHead, which grants the S request
+    lockMgr.downgrade(&request1, MODE_IS);
+    ASSERT(request1.mode == MODE_IS);
+    ASSERT(!request1.fastPathLock);
+    ASSERT_EQ(1, request2.numNotifies);
+    ASSERT_EQ(LOCK_OK, request2.lastResult);
+
+    ASSERT(lockMgr.unlock(&request1));
+    ASSERT(lockMgr.unlock(&request2));
+
+    // Unused locks can be cleaned up while requests are granted on the fast path
+    LockerImpl locker3;
+    LockRequestCombo request3(&locker3);
+    ASSERT(LOCK_OK == lockMgr.lock(resourceIdGlobal, &request3, MODE_IX));
+    ASSERT(request3.fastPathLock);
+    lockMgr.cleanupUnusedLocks();
+
+    LockerImpl locker4;
+    LockRequestCombo request4(&locker4);
+    ASSERT(LOCK_WAITING == lockMgr.lock(resourceIdGlobal, &request4, MODE_X));
+    ASSERT(lockMgr.unlock(&request3));
+    ASSERT_EQ(1, request4.numNotifies);
+    ASSERT(lockMgr.unlock(&request4));
+}
+
 }  // namespace mongo
@@ -39,9 +39,11 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/flow_control.h"
+#include "mongo/db/wait_events.h"
 #include "mongo/platform/compiler.h"
 #include "mongo/stdx/new.h"
 #include "mongo/util/background.h"
+#include "mongo/util/concurrency/admission_context.h"
 #include "mongo/util/concurrency/ticketholder.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/fail_point.h"
@@ -338,10 +340,15 @@ bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t d
         auto restoreStateOnErrorGuard = makeGuard([&] { _clientState.store(kInactive); });
 
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
-        if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
-            return false;
+        AdmissionContext* admCtx = opCtx ? &AdmissionContext::get(opCtx) : nullptr;
+        // Only an acquisition which had to wait for a ticket is reported as a wait event.
+        if (!holder->tryAdmit(admCtx)) {
+            ScopedWaitEvent waitEvent(opCtx, WaitEvent::kTicket);
+            if (deadline == Date_t::max()) {
+                holder->waitForTicket(interruptible, admCtx);
+            } else if (!holder->waitForTicketUntil(interruptible, admCtx, deadline)) {
+                return false;
+            }
         }
         restoreStateOnErrorGuard.dismiss();
     }
@@ -921,6 +928,7 @@ void LockerImpl::_lockComplete(OperationContext* opCtx,
     Milliseconds waitTime = std::min(timeout, MaxWaitTime);
     const uint64_t startOfTotalWaitTime = curTimeMicros64();
     uint64_t startOfCurrentWaitTime = startOfTotalWaitTime;
+    ScopedWaitEvent waitEvent(opCtx, WaitEvent::kLock);
 
     while (true) {
         // It is OK if this call wakes up spuriously, because we re-evaluate the remaining
@@ -0,0 +1,247 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/service_context_d_test_fixture.h"
+#include "mongo/platform/random.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+/*
+ * End-to-end benchmarks of the read and write paths of mongod. Each benchmark starts the
+ * WiredTiger storage engine in a temporary dbpath and runs its workload as commands through
+ * DBDirectClient, so that the timings include command parsing, query planning, the PlanExecutor or
+ * Pipeline and the storage engine, but not the network.
+ *
+ * Data is generated deterministically and random choices use a fixed seed, so that the results of
+ * different builds can be compared against each other.
+ */
+
+const NamespaceString kNss("crud_bm.coll");
+const NamespaceString kForeignNss("crud_bm.foreign");
+
+constexpr int64_t kSeed = 1;
+constexpr int kNumGroups = 100;
+constexpr int kInsertBatchSize = 100;
+
+// Fields which carry secondary indexes, in the order they are added by BM_InsertBatch.
+const std::vector<std::string> kIndexedFields{"a", "b", "c", "s"};
+
+BSONObj makeDocument(int i) {
+    return BSON("_id" << i << "a" << i << "b" << i % kNumGroups << "c" << 0 << "s"
+                      << std::string(64, 'a' + i % 26));
+}
+
+/**
+ * Owns a ServiceContext running the WiredTiger storage engine in a temporary dbpath, along with an
+ * operation and a DBDirectClient to run commands on it.
+ */
+class CrudBenchmarkHarness : public ServiceContextMongoDTest {
+public:
+    CrudBenchmarkHarness() : ServiceContextMongoDTest("wiredTiger") {
+        auto service = getServiceContext();
+        auto replCoord = std::make_unique<repl::ReplicationCoordinatorMock>(service);
+        invariant(replCoord->setFollowerMode(repl::MemberState::RS_PRIMARY));
+        repl::ReplicationCoordinator::set(service, std::move(replCoord));
+
+        _opCtx = makeOperationContext();
+        _client = std::make_unique<DBDirectClient>(_opCtx.get());
+    }
+
+    ~CrudBenchmarkHarness() {
+        _client.reset();
+        _opCtx.reset();
+    }
+
+    /**
+     * Runs 'cmd' against the benchmark database, throwing if the command or any of its writes
+     * fails.
+     */
+    BSONObj runCommand(const BSONObj& cmd) {
+        BSONObj result;
+        _client->runCommand(kNss.db().toString(), cmd, result);
+        uassertStatusOK(getStatusFromWriteCommandReply(result));
+        return result;
+    }
+
+    void createIndex(const NamespaceString& nss, StringData field) {
+        runCommand(BSON("createIndexes" << nss.coll() << "indexes"
+                                        << BSON_ARRAY(BSON("key" << BSON(field << 1) << "name"
+                                                                 << field.toString() + "_1"))));
+    }
+
+    /**
+     * Inserts the documents makeDocument(begin) to makeDocument(end - 1) into 'nss'.
+     */
+    void insertDocuments(const NamespaceString& nss, int begin, int end) {
+        while (begin < end) {
+            BSONArrayBuilder documents;
+            for (int batchEnd = std::min(begin + 1000, end); begin < batchEnd; ++begin) {
+                documents.append(makeDocument(begin));
+            }
+            runCommand(BSON("insert" << nss.coll() << "documents" << documents.arr()));
+        }
+    }
+
+private:
+    void _doTest() override {}
+
+    ServiceContext::UniqueOperationContext _opCtx;
+    std::unique_ptr<DBDirectClient> _client;
+};
+
+void BM_PointFind(benchmark::State& state) {
+    const int numDocs = state.range(0);
+    CrudBenchmarkHarness harness;
+    harness.insertDocuments(kNss, 0, numDocs);
+
+    PseudoRandom random(kSeed);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(harness.runCommand(
+            BSON("find" << kNss.coll() << "filter" << BSON("_id" << random.nextInt32(numDocs))
+                        << "limit" << 1 << "singleBatch" << true)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_RangeScanWithSort(benchmark::State& state) {
+    const int numDocs = 10000;
+    const int rangeSize = state.range(0);
+    CrudBenchmarkHarness harness;
+    harness.insertDocuments(kNss, 0, numDocs);
+    harness.createIndex(kNss, "a");
+
+    PseudoRandom random(kSeed);
+    for (auto _ : state) {
+        const int begin = random.nextInt32(numDocs - rangeSize);
+        benchmark::DoNotOptimize(harness.runCommand(BSON(
+            "find" << kNss.coll() << "filter"
+                   << BSON("a" << BSON("$gte" << begin << "$lt" << begin + rangeSize)) << "sort"
+                   << BSON("b" << 1) << "batchSize" << rangeSize << "singleBatch" << true)));
+    }
+    state.SetItemsProcessed(state.iterations() * rangeSize);
+}
+
+void BM_Group(benchmark::State& state) {
+    const int numDocs = state.range(0);
+    CrudBenchmarkHarness harness;
+    harness.insertDocuments(kNss, 0, numDocs);
+
+    const auto cmd = BSON(
+        "aggregate" << kNss.coll() << "pipeline"
+                    << BSON_ARRAY(BSON("$group" << BSON("_id"
+                                                        << "$b"
+                                                        << "total" << BSON("$sum" << "$a"))))
+                    << "cursor" << BSON("batchSize" << kNumGroups));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(harness.runCommand(cmd));
+    }
+    state.SetItemsProcessed(state.iterations() * numDocs);
+}
+
+void BM_Lookup(benchmark::State& state) {
+    const int numDocs = state.range(0);
+    CrudBenchmarkHarness harness;
+    harness.insertDocuments(kNss, 0, numDocs);
+    harness.insertDocuments(kForeignNss, 0, kNumGroups);
+
+    // Each local document joins with the single foreign document whose _id is its group. The
+    // joined documents are counted rather than returned, so that the cursor does not dominate.
+    const auto cmd = BSON(
+        "aggregate" << kNss.coll() << "pipeline"
+                    << BSON_ARRAY(BSON("$lookup" << BSON("from" << kForeignNss.coll()
+                                                                << "localField"
+                                                                << "b"
+                                                                << "foreignField"
+                                                                << "_id"
+                                                                << "as"
+                                                                << "joined"))
+                                  << BSON("$group" << BSON("_id" << BSONNULL << "joined"
+                                                                 << BSON("$sum" << BSON(
+                                                                             "$size"
+                                                                             << "$joined")))))
+                    << "cursor" << BSONObj());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(harness.runCommand(cmd));
+    }
+    state.SetItemsProcessed(state.iterations() * numDocs);
+}
+
+void BM_InsertBatch(benchmark::State& state) {
+    const int numIndexes = state.range(0);
+    CrudBenchmarkHarness harness;
+    for (int i = 0; i < numIndexes; ++i) {
+        harness.createIndex(kNss, kIndexedFields[i]);
+    }
+
+    int nextId = 0;
+    for (auto _ : state) {
+        harness.insertDocuments(kNss, nextId, nextId + kInsertBatchSize);
+        nextId += kInsertBatchSize;
+    }
+    state.SetItemsProcessed(state.iterations() * kInsertBatchSize);
+}
+
+void BM_UpdateMany(benchmark::State& state) {
+    const int numDocs = state.range(0);
+    CrudBenchmarkHarness harness;
+    harness.insertDocuments(kNss, 0, numDocs);
+    harness.createIndex(kNss, "b");
+
+    // Each update matches one group, through the index on "b", and modifies an unindexed field.
+    int group = 0;
+    for (auto _ : state) {
+        harness.runCommand(BSON(
+            "update" << kNss.coll() << "updates"
+                     << BSON_ARRAY(BSON("q" << BSON("b" << group) << "u"
+                                            << BSON("$inc" << BSON("c" << 1)) << "multi" << true))));
+        group = (group + 1) % kNumGroups;
+    }
+    state.SetItemsProcessed(state.iterations() * (numDocs / kNumGroups));
+}
+
+BENCHMARK(BM_PointFind)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RangeScanWithSort)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Group)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Lookup)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_InsertBatch)->DenseRange(0, 4)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_UpdateMany)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace mongo
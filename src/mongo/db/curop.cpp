@@ -406,6 +406,29 @@ void CurOp::raiseDbProfileLevel(int dbProfileLevel) {
     _dbprofile = std::max(dbProfileLevel, _dbprofile);
 }
 
+namespace {
+
+/**
+ * The storage engine does not expose the time application threads spend evicting from its cache as
+ * it happens, so it is taken from the storage statistics of the operation once they are gathered.
+ */
+void recordCacheEvictionWait(OperationContext* opCtx, OpDebug& debug) {
+    if (!debug.storageStats) {
+        return;
+    }
+
+    auto cacheWait = debug.storageStats->toBSON().getFieldDotted("timeWaitingMicros.cache");
+    if (!cacheWait.isNumber() || cacheWait.safeNumberLong() <= 0) {
+        return;
+    }
+
+    const Microseconds elapsed(cacheWait.safeNumberLong());
+    WaitEvents::record(opCtx, WaitEvent::kCacheEviction, elapsed);
+    debug.waitEvents.record(WaitEvent::kCacheEviction, elapsed);
+}
+
+}  // namespace
+
 bool CurOp::completeAndLogOperation(OperationContext* opCtx,
                                     logger::LogComponent component,
                                     boost::optional<size_t> responseLength,
@@ -425,6 +448,7 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
     // Obtain the total execution time of this operation.
     _end = curTimeMicros64();
     _debug.executionTimeMicros = durationCount<Microseconds>(elapsedTimeExcludingPauses());
+    _debug.waitEvents = WaitEventStats::get(opCtx);
 
     const bool shouldSample =
         client->getPrng().nextCanonicalDouble() < serverGlobalParams.sampleRate;
@@ -457,6 +481,8 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
             }
         }
 
+        recordCacheEvictionWait(opCtx, _debug);
+
         // Gets the time spent blocked on prepare conflicts.
         auto prepareConflictDurationMicros =
             PrepareConflictTracker::get(opCtx).getPrepareConflictDuration();
@@ -720,6 +746,7 @@ string OpDebug::report(OperationContext* opCtx, const SingleThreadedLockStats* l
     OPDEBUG_TOSTRING_HELP_BOOL(hasSortStage);
     OPDEBUG_TOSTRING_HELP_BOOL(usedDisk);
     OPDEBUG_TOSTRING_HELP_BOOL(fromMultiPlanner);
+    OPDEBUG_TOSTRING_HELP_OPTIONAL("planningTimeMicros", planningTimeMicros);
     OPDEBUG_TOSTRING_HELP_BOOL(replanned);
     OPDEBUG_TOSTRING_HELP_OPTIONAL("nMatched", additiveMetrics.nMatched);
     OPDEBUG_TOSTRING_HELP_OPTIONAL("nModified", additiveMetrics.nModified);
@@ -770,6 +797,12 @@ string OpDebug::report(OperationContext* opCtx, const SingleThreadedLockStats* l
         s << " storage:" << storageStats->toBSON().toString();
     }
 
+    if (!waitEvents.empty()) {
+        BSONObjBuilder waitEventsBuilder;
+        waitEvents.append(&waitEventsBuilder);
+        s << " waitEvents:" << waitEventsBuilder.obj().toString();
+    }
+
     if (iscommand) {
         s << " protocol:" << getProtoString(networkOp);
     }
@@ -824,6 +857,7 @@ void OpDebug::append(OperationContext* opCtx,
     OPDEBUG_APPEND_BOOL(hasSortStage);
     OPDEBUG_APPEND_BOOL(usedDisk);
     OPDEBUG_APPEND_BOOL(fromMultiPlanner);
+    OPDEBUG_APPEND_OPTIONAL("planningTimeMicros", planningTimeMicros);
     OPDEBUG_APPEND_BOOL(replanned);
     OPDEBUG_APPEND_OPTIONAL("nMatched", additiveMetrics.nMatched);
     OPDEBUG_APPEND_OPTIONAL("nModified", additiveMetrics.nModified);
@@ -864,6 +898,11 @@ void OpDebug::append(OperationContext* opCtx,
         b.append("storage", storageStats->toBSON());
     }
 
+    if (!waitEvents.empty()) {
+        BSONObjBuilder waitEventsBuilder(b.subobjStart("waitEvents"));
+        waitEvents.append(&waitEventsBuilder);
+    }
+
     if (!errInfo.isOK()) {
         b.appendNumber("ok", 0.0);
         if (!errInfo.reason().empty()) {
@@ -894,6 +933,9 @@ void OpDebug::setPlanSummaryMetrics(const PlanSummaryStats& planSummaryStats) {
     hasSortStage = planSummaryStats.hasSortStage;
     usedDisk = planSummaryStats.usedDisk;
     fromMultiPlanner = planSummaryStats.fromMultiPlanner;
+    if (planSummaryStats.fromMultiPlanner) {
+        planningTimeMicros = planSummaryStats.planningTimeMicros;
+    }
     replanned = planSummaryStats.replanned;
 }
 
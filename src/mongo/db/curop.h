@@ -35,6 +35,7 @@
 #include "mongo/db/cursor_id.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/wait_events.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/diagnostic_info.h"
 #include "mongo/util/progress_meter.h"
@@ -200,6 +201,9 @@ public:
     // single solution).
     bool fromMultiPlanner{false};
 
+    // The time the multi-planner spent picking the winning plan, if the plan came from it.
+    boost::optional<long long> planningTimeMicros;
+
     // True if a replan was triggered during the execution of this operation.
     bool replanned{false};
 
@@ -239,6 +243,9 @@ public:
     // Stores storage statistics.
     std::shared_ptr<StorageStats> storageStats;
 
+    // Stores the time spent blocked, by wait class.
+    WaitEventStats waitEvents;
+
     bool waitingForFlowControl{false};
 };
 
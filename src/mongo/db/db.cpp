@@ -111,6 +111,7 @@
 #include "mongo/db/repl/replication_coordinator_external_state_impl.h"
 #include "mongo/db/repl/replication_coordinator_impl.h"
 #include "mongo/db/repl/replication_coordinator_impl_gen.h"
+#include "mongo/db/repl/replication_network_connection_hook.h"
 #include "mongo/db/repl/replication_process.h"
 #include "mongo/db/repl/replication_recovery.h"
 #include "mongo/db/repl/storage_interface_impl.h"
@@ -181,6 +182,7 @@
 #include "mongo/util/stacktrace.h"
 #include "mongo/util/text.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 #include "mongo/util/version.h"
 #include "mongo/watchdog/watchdog_mongod.h"
 
@@ -334,7 +336,9 @@ ExitCode _initAndListen(int listenPort) {
                      std::make_unique<FlowControl>(
                          serviceContext, repl::ReplicationCoordinator::get(serviceContext)));
 
+    Timer storageEngineTimer;
     initializeStorageEngine(serviceContext, StorageEngineInitFlags::kNone);
+    log() << "Initialized the storage engine in " << storageEngineTimer.millis() << "ms";
 
 #ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
     if (EncryptionHooks::get(serviceContext)->restartRequired()) {
@@ -416,7 +420,10 @@ ExitCode _initAndListen(int listenPort) {
 
     bool nonLocalDatabases;
     try {
+        Timer repairTimer;
         nonLocalDatabases = repairDatabasesAndCheckVersion(startupOpCtx.get());
+        log() << "Opened databases and checked data file versions in " << repairTimer.millis()
+              << "ms";
     } catch (const ExceptionFor<ErrorCodes::MustDowngrade>& error) {
         severe(LogComponent::kControl) << "** IMPORTANT: " << error.toStatus().reason();
         exitCleanly(EXIT_NEED_DOWNGRADE);
@@ -815,7 +822,9 @@ auto makeReplicationExecutor(ServiceContext* serviceContext) {
     hookList->addHook(std::make_unique<rpc::LogicalTimeMetadataHook>(serviceContext));
     return std::make_unique<executor::ThreadPoolTaskExecutor>(
         std::make_unique<ThreadPool>(tpOptions),
-        executor::makeNetworkInterface("Replication", nullptr, std::move(hookList)));
+        executor::makeNetworkInterface("Replication",
+                                       std::make_unique<repl::ReplicationNetworkConnectionHook>(),
+                                       std::move(hookList)));
 }
 
 void setUpReplication(ServiceContext* serviceContext) {
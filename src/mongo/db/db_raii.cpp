@@ -33,13 +33,18 @@
 
 #include "mongo/db/db_raii.h"
 
+#include "mongo/base/counter.h"
 #include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii_gen.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -52,6 +57,57 @@ const boost::optional<int> kDoNotChangeProfilingLevel = boost::none;
 const auto allowSecondaryReadsDuringBatchApplication_DONT_USE =
     OperationContext::declareDecoration<boost::optional<bool>>();
 
+// Secondary reads which read at the last applied timestamp, which waited for batch application to
+// move it past pending catalog changes, and which took the PBWM lock after all.
+Counter64 readsAtLastAppliedCounter;
+Counter64 readsWaitedForBatchApplicationCounter;
+Counter64 readsWaitedForBatchApplicationMicrosCounter;
+Counter64 readsConflictedWithBatchApplicationCounter;
+
+ServerStatusMetricField<Counter64> displayReadsAtLastApplied(
+    "repl.secondaryReads.atLastApplied", &readsAtLastAppliedCounter);
+ServerStatusMetricField<Counter64> displayReadsWaitedForBatchApplication(
+    "repl.secondaryReads.waitedForBatchApplication", &readsWaitedForBatchApplicationCounter);
+ServerStatusMetricField<Counter64> displayReadsWaitedForBatchApplicationMicros(
+    "repl.secondaryReads.waitedForBatchApplicationMicros",
+    &readsWaitedForBatchApplicationMicrosCounter);
+ServerStatusMetricField<Counter64> displayReadsConflictedWithBatchApplication(
+    "repl.secondaryReads.conflictedWithBatchApplication",
+    &readsConflictedWithBatchApplicationCounter);
+
+/**
+ * Waits for at most 'secondaryReadsMaxBatchApplicationWaitMillis' for the last applied timestamp
+ * to reach 'ts', which happens at the end of the batch applying it. Returns true if it did.
+ */
+bool waitForLastAppliedTimestamp(OperationContext* opCtx, Timestamp ts) {
+    const Milliseconds maxWait(gSecondaryReadsMaxBatchApplicationWaitMillis.load());
+    if (maxWait <= Milliseconds(0)) {
+        return false;
+    }
+
+    readsWaitedForBatchApplicationCounter.increment();
+    Timer timer;
+    ON_BLOCK_EXIT([&] { readsWaitedForBatchApplicationMicrosCounter.increment(timer.micros()); });
+
+    auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+    const repl::ReadConcernArgs waitArgs(LogicalTime(ts),
+                                         repl::ReadConcernLevel::kLocalReadConcern);
+    auto deadline = std::min(Date_t::now() + maxWait, opCtx->getDeadline());
+    while (replCoord->getMyLastAppliedOpTime().getTimestamp() < ts) {
+        if (Date_t::now() >= deadline) {
+            return false;
+        }
+
+        // This returns early without an error when the last applied optime advances, but not far
+        // enough. A failure to wait leaves it to the PBWM lock, unless the operation was killed.
+        if (!replCoord->waitUntilOpTimeForReadUntil(opCtx, waitArgs, deadline).isOK()) {
+            opCtx->checkForInterrupt();
+            return false;
+        }
+    }
+    return true;
+}
+
 }  // namespace
 
 AutoStatsTracker::AutoStatsTracker(OperationContext* opCtx,
@@ -113,6 +169,10 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
     repl::ReplicationCoordinator* const replCoord = repl::ReplicationCoordinator::get(opCtx);
     const auto readConcernLevel = repl::ReadConcernArgs::get(opCtx).getLevel();
 
+    // Set once the read has waited for batch application to move the last applied timestamp past
+    // pending catalog changes.
+    bool waitedForBatchApplication = false;
+
     // If the collection doesn't exist or disappears after releasing locks and waiting, there is no
     // need to check for pending catalog changes.
     while (auto coll = _autoColl->getCollection()) {
@@ -164,6 +224,9 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
             : boost::none;
 
         if (!_conflictingCatalogChanges(opCtx, minSnapshot, lastAppliedTimestamp)) {
+            if (lastAppliedTimestamp) {
+                readsAtLastAppliedCounter.increment();
+            }
             return;
         }
 
@@ -177,14 +240,35 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
         // Yield locks in order to do the blocking call below.
         _autoColl = boost::none;
 
-        // If there are pending catalog changes, we should conflict with any in-progress batches (by
-        // taking the PBWM lock) and choose not to read from the last applied timestamp by unsetting
-        // _shouldNotConflictWithSecondaryBatchApplicationBlock. Index builds on secondaries can
-        // complete at timestamps later than the lastAppliedTimestamp during initial sync. After
-        // initial sync finishes, if we waited instead of retrying, readers would block indefinitely
-        // waiting for the lastAppliedTimestamp to move forward. Instead we force the reader take
-        // the PBWM lock and retry.
+        // The pending catalog changes are usually part of the batch being applied, so we first wait
+        // once for the batch to finish and retry at the new last applied timestamp, rather than
+        // block the read behind the batches which follow by taking the PBWM lock. Operations which
+        // still hold locks could stall batch application, so they do not wait. The wait is bounded
+        // by 'secondaryReadsMaxBatchApplicationWaitMillis': index builds on secondaries can
+        // complete at timestamps later than the lastAppliedTimestamp during initial sync, and after
+        // initial sync finishes the lastAppliedTimestamp may not move forward for an unbounded
+        // time. If the wait is disabled or times out, we instead conflict with any in-progress
+        // batches by taking the PBWM lock, choose not to read from the last applied timestamp by
+        // unsetting _shouldNotConflictWithSecondaryBatchApplicationBlock, and retry.
+        if (lastAppliedTimestamp && !waitedForBatchApplication &&
+            !opCtx->lockState()->isLocked()) {
+            waitedForBatchApplication = true;
+
+            // Abandon the snapshot so that the retry reads at the new last applied timestamp.
+            opCtx->recoveryUnit()->abandonSnapshot();
+            if (waitForLastAppliedTimestamp(opCtx, *minSnapshot)) {
+                {
+                    stdx::lock_guard<Client> lk(*opCtx->getClient());
+                    CurOp::get(opCtx)->yielded();
+                }
+
+                _autoColl.emplace(opCtx, nsOrUUID, collectionLockMode, viewMode, deadline);
+                continue;
+            }
+        }
+
         if (lastAppliedTimestamp) {
+            readsConflictedWithBatchApplicationCounter.increment();
             LOG(0) << "tried reading at last-applied time: " << *lastAppliedTimestamp
                    << " on ns: " << nss.ns() << ", but future catalog changes are pending at time "
                    << *minSnapshot << ". Trying again without reading at last-applied time.";
@@ -0,0 +1,134 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/db_raii.h"
+
+#include "mongo/db/catalog/catalog_test_fixture.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/concurrency/lock_state.h"
+#include "mongo/db/db_raii_gen.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Finishes applying the current batch, if one is set, when a read waits for the last applied
+ * optime to move forward.
+ */
+class BatchApplyingReplicationCoordinatorMock : public repl::ReplicationCoordinatorMock {
+public:
+    using repl::ReplicationCoordinatorMock::ReplicationCoordinatorMock;
+
+    Status waitUntilOpTimeForReadUntil(OperationContext* opCtx,
+                                       const repl::ReadConcernArgs& settings,
+                                       boost::optional<Date_t> deadline) override {
+        ++numWaits;
+        if (endOfBatch) {
+            setMyLastAppliedOpTimeAndWallTime({*endOfBatch, Date_t()});
+        }
+        return Status::OK();
+    }
+
+    boost::optional<repl::OpTime> endOfBatch;
+    int numWaits = 0;
+};
+
+class DBRAIITestFixture : public CatalogTestFixture {
+public:
+    DBRAIITestFixture() : CatalogTestFixture("wiredTiger") {}
+
+protected:
+    void setUp() override {
+        CatalogTestFixture::setUp();
+        ASSERT_OK(storageInterface()->createCollection(operationContext(), nss, {}));
+
+        // The collection has catalog changes pending at a timestamp later than the last applied
+        // timestamp of the secondary.
+        {
+            AutoGetCollection autoColl(operationContext(), nss, MODE_X);
+            autoColl.getCollection()->setMinimumVisibleSnapshot(kCatalogChangeTs);
+        }
+
+        auto replCoord =
+            std::make_unique<BatchApplyingReplicationCoordinatorMock>(getServiceContext());
+        ASSERT_OK(replCoord->setFollowerMode(repl::MemberState::RS_SECONDARY));
+        replCoord->setMyLastAppliedOpTimeAndWallTime(
+            {repl::OpTime(Timestamp(10, 1), 1), Date_t()});
+        _replCoord = replCoord.get();
+        repl::ReplicationCoordinator::set(getServiceContext(), std::move(replCoord));
+    }
+
+    BatchApplyingReplicationCoordinatorMock* replCoord() {
+        return _replCoord;
+    }
+
+    bool holdsPBWMLock() {
+        return operationContext()->lockState()->isLockHeldForMode(resourceIdParallelBatchWriterMode,
+                                                                   MODE_IS);
+    }
+
+    const NamespaceString nss = NamespaceString("test", "coll");
+    const Timestamp kCatalogChangeTs = Timestamp(20, 1);
+
+private:
+    BatchApplyingReplicationCoordinatorMock* _replCoord = nullptr;
+};
+
+TEST_F(DBRAIITestFixture, ReadWaitsForTheBatchBoundaryInsteadOfTakingThePBWMLock) {
+    replCoord()->endOfBatch = repl::OpTime(kCatalogChangeTs, 1);
+
+    AutoGetCollectionForRead autoColl(operationContext(), nss);
+    ASSERT(autoColl.getCollection());
+    ASSERT_GTE(replCoord()->numWaits, 1);
+    ASSERT_FALSE(holdsPBWMLock());
+    ASSERT_EQ(RecoveryUnit::ReadSource::kLastApplied,
+              operationContext()->recoveryUnit()->getTimestampReadSource());
+}
+
+TEST_F(DBRAIITestFixture, ReadTakesThePBWMLockWhenTheBatchBoundaryIsNotReachedInTime) {
+    const auto maxWaitMillis = gSecondaryReadsMaxBatchApplicationWaitMillis.load();
+    ON_BLOCK_EXIT([&] { gSecondaryReadsMaxBatchApplicationWaitMillis.store(maxWaitMillis); });
+    gSecondaryReadsMaxBatchApplicationWaitMillis.store(10);
+
+    AutoGetCollectionForRead autoColl(operationContext(), nss);
+    ASSERT(autoColl.getCollection());
+    ASSERT_GTE(replCoord()->numWaits, 1);
+    ASSERT(holdsPBWMLock());
+    ASSERT_EQ(RecoveryUnit::ReadSource::kUnset,
+              operationContext()->recoveryUnit()->getTimestampReadSource());
+}
+
+}  // namespace
+}  // namespace mongo
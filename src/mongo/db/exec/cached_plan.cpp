@@ -190,9 +190,13 @@ Status CachedPlanStage::replan(PlanYieldPolicy* yieldPolicy, bool shouldCache) {
 
     _specificStats.replanned = true;
 
+    PlanCache* cache = CollectionQueryInfo::get(collection()).getPlanCache();
+    cache->notifyOfReplan(*_canonicalQuery,
+                          shouldCache ? PlanCache::ReplanReason::kWorksExceeded
+                                      : PlanCache::ReplanReason::kPlanFailed);
+
     if (shouldCache) {
         // Deactivate the current cache entry.
-        PlanCache* cache = CollectionQueryInfo::get(collection()).getPlanCache();
         cache->deactivate(*_canonicalQuery);
     }
 
@@ -281,6 +285,22 @@ PlanStage::StageState CachedPlanStage::doWork(WorkingSetID* out) {
     return child()->work(out);
 }
 
+PlanStage::StageState CachedPlanStage::doWorkBatch(size_t maxWorks,
+                                                   std::vector<WorkingSetID>* out,
+                                                   WorkingSetID* stateOut) {
+    // Results buffered during the trial period are handed out one at a time, as by doWork().
+    if (isEOF() || !_results.empty()) {
+        return workBatchWith(1, out, stateOut, [this](WorkingSetID* id) {
+            return CachedPlanStage::doWork(id);
+        });
+    }
+
+    const size_t startSize = out->size();
+    const StageState status = child()->workBatch(maxWorks, out, stateOut);
+    recordWorkBatchResults(out->size() - startSize, status);
+    return status;
+}
+
 std::unique_ptr<PlanStageStats> CachedPlanStage::getStats() {
     _commonStats.isEOF = isEOF();
 
@@ -37,7 +37,6 @@
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/collection_scan_common.h"
-#include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
@@ -45,6 +44,7 @@
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
 
 #include "mongo/db/client.h"  // XXX-ERH
 
@@ -69,6 +69,8 @@ CollectionScan::CollectionScan(OperationContext* opCtx,
     _specificStats.direction = params.direction;
     _specificStats.minTs = params.minTs;
     _specificStats.maxTs = params.maxTs;
+    _specificStats.minRecord = params.minRecord;
+    _specificStats.maxRecord = params.maxRecord;
     _specificStats.tailable = params.tailable;
     if (params.minTs || params.maxTs) {
         // The 'minTs' and 'maxTs' parameters are used for a special optimization that
@@ -77,6 +79,10 @@ CollectionScan::CollectionScan(OperationContext* opCtx,
         invariant(collection->ns().isOplog());
     }
     invariant(!_params.shouldTrackLatestOplogTimestamp || collection->ns().isOplog());
+    if (params.minRecord || params.maxRecord) {
+        invariant(!params.tailable);
+        invariant(!params.minRecord || !params.maxRecord || *params.minRecord <= *params.maxRecord);
+    }
 
     // Set early stop condition.
     if (params.maxTs) {
@@ -84,6 +90,12 @@ CollectionScan::CollectionScan(OperationContext* opCtx,
         _endCondition = std::make_unique<GTEMatchExpression>(repl::OpTime::kTimestampFieldName,
                                                              _endConditionBSON.firstElement());
     }
+
+    // Batches can only be filtered as a whole when every document is simply kept or dropped.
+    if (_filter && !_endCondition && !_params.stopApplyingFilterAfterFirstMatch &&
+        !_params.shouldTrackLatestOplogTimestamp) {
+        _batchFilter = BatchLeafMatcher::make(_filter);
+    }
 }
 
 PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
@@ -95,9 +107,7 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
     const bool needToMakeCursor = !_cursor;
     try {
         if (needToMakeCursor) {
-            const bool forward = _params.direction == CollectionScanParams::FORWARD;
-
-            if (forward && _params.shouldWaitForOplogVisibility) {
+            if (forward() && _params.shouldWaitForOplogVisibility) {
                 // Forward, non-tailable scans from the oplog need to wait until all oplog entries
                 // before the read begins to be visible. This isn't needed for reverse scans because
                 // we only hide oplog entries from forward scans, and it isn't necessary for tailing
@@ -114,7 +124,7 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
                 collection()->getRecordStore()->waitForAllEarlierOplogWritesToBeVisible(getOpCtx());
             }
 
-            _cursor = collection()->getCursor(getOpCtx(), forward);
+            _cursor = collection()->getCursor(getOpCtx(), forward());
 
             if (!_lastSeenId.isNull()) {
                 invariant(_params.tailable);
@@ -150,6 +160,18 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             }
         }
 
+        const auto& rangeStart = forward() ? _params.minRecord : _params.maxRecord;
+        if (!record && _lastSeenId.isNull() && rangeStart) {
+            // Start the scan directly at the beginning of the range if that record exists.
+            // Otherwise the scan starts at the beginning of the collection, and the records that
+            // precede the range are skipped below. A failed seekExact() leaves the cursor at an
+            // unspecified position, so a fresh cursor is needed to scan from the beginning.
+            record = _cursor->seekExact(*rangeStart);
+            if (!record) {
+                _cursor = collection()->getCursor(getOpCtx(), forward());
+            }
+        }
+
         if (!record) {
             record = _cursor->next();
         }
@@ -175,6 +197,14 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
     }
 
     _lastSeenId = record->id;
+    if (isBeforeRange(record->id)) {
+        return PlanStage::NEED_TIME;
+    }
+    if (isAfterRange(record->id)) {
+        _commonStats.isEOF = true;
+        return PlanStage::IS_EOF;
+    }
+
     if (_params.shouldTrackLatestOplogTimestamp) {
         auto status = setLatestOplogEntryTimestamp(*record);
         if (!status.isOK()) {
@@ -183,14 +213,73 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         }
     }
 
-    WorkingSetID id = _workingSet->allocate();
-    WorkingSetMember* member = _workingSet->get(id);
-    member->recordId = record->id;
-    member->resetDocument(getOpCtx()->recoveryUnit()->getSnapshotId(),
-                          record->data.releaseToBson());
-    _workingSet->transitionToRecordIdAndObj(id);
+    return returnIfMatches(&*record, out);
+}
+
+PlanStage::StageState CollectionScan::doWorkBatch(size_t maxWorks,
+                                                  std::vector<WorkingSetID>* out,
+                                                  WorkingSetID* stateOut) {
+    // The latest oplog timestamp must not run ahead of the results actually consumed by the
+    // caller, so batch only a single unit of work when tracking it.
+    if (_params.shouldTrackLatestOplogTimestamp) {
+        maxWorks = 1;
+    }
+
+    if (!_batchFilter) {
+        return workBatchWith(maxWorks, out, stateOut, [this](WorkingSetID* id) {
+            return CollectionScan::doWork(id);
+        });
+    }
+
+    // Produce the batch without applying the filter to each document, then evaluate the filter
+    // over the entire batch in one pass.
+    const size_t startSize = out->size();
+    StageState state;
+    {
+        const MatchExpression* filter = _filter;
+        _filter = nullptr;
+        ON_BLOCK_EXIT([&] { _filter = filter; });
+        state = workBatchWith(maxWorks, out, stateOut, [this](WorkingSetID* id) {
+            return CollectionScan::doWork(id);
+        });
+    }
 
-    return returnIfMatches(member, id, out);
+    for (size_t i = startSize; i < out->size(); ++i) {
+        _batchDocs.push_back(_workingSet->get((*out)[i])->doc.value().toBson());
+    }
+    _batchFilter->matches(_batchDocs, &_batchSelection);
+
+    size_t numKept = startSize;
+    for (size_t i = 0; i < _batchDocs.size(); ++i) {
+        const WorkingSetID id = (*out)[startSize + i];
+        if (BatchLeafMatcher::isSelected(_batchSelection, i)) {
+            (*out)[numKept++] = id;
+        } else {
+            _workingSet->free(id);
+        }
+    }
+    _batchDocs.clear();
+
+    // Rejected documents were accounted for as advanced while the batch was produced.
+    const size_t numRejected = out->size() - numKept;
+    out->resize(numKept);
+    _commonStats.advanced -= numRejected;
+    _commonStats.needTime += numRejected;
+
+    if (PlanStage::ADVANCED == state && numKept == startSize) {
+        state = PlanStage::NEED_TIME;
+    }
+    return state;
+}
+
+bool CollectionScan::isBeforeRange(const RecordId& id) const {
+    return forward() ? _params.minRecord && id < *_params.minRecord
+                     : _params.maxRecord && id > *_params.maxRecord;
+}
+
+bool CollectionScan::isAfterRange(const RecordId& id) const {
+    return forward() ? _params.maxRecord && id > *_params.maxRecord
+                     : _params.minRecord && id < *_params.minRecord;
 }
 
 Status CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
@@ -206,24 +295,33 @@ Status CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
     return Status::OK();
 }
 
-PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
-                                                      WorkingSetID memberID,
-                                                      WorkingSetID* out) {
+PlanStage::StageState CollectionScan::returnIfMatches(Record* record, WorkingSetID* out) {
     ++_specificStats.docsTested;
-    if (Filter::passes(member, _filter)) {
-        if (_params.stopApplyingFilterAfterFirstMatch) {
-            _filter = nullptr;
+
+    // The record's data may point directly into the storage engine's buffer, so test it in place
+    // and only hand records which match over to the working set.
+    const BSONObj recordObj = record->data.toBson();
+    if (_filter && !_filter->matchesBSON(recordObj)) {
+        if (_endCondition && _endCondition->matchesBSON(recordObj)) {
+            _commonStats.isEOF = true;
+            return PlanStage::IS_EOF;
         }
-        *out = memberID;
-        return PlanStage::ADVANCED;
-    } else if (_endCondition && Filter::passes(member, _endCondition.get())) {
-        _workingSet->free(memberID);
-        _commonStats.isEOF = true;
-        return PlanStage::IS_EOF;
-    } else {
-        _workingSet->free(memberID);
         return PlanStage::NEED_TIME;
     }
+
+    if (_params.stopApplyingFilterAfterFirstMatch) {
+        _filter = nullptr;
+    }
+
+    WorkingSetID id = _workingSet->allocate();
+    WorkingSetMember* member = _workingSet->get(id);
+    member->recordId = record->id;
+    member->resetDocument(getOpCtx()->recoveryUnit()->getSnapshotId(),
+                          record->data.releaseToBson());
+    _workingSet->transitionToRecordIdAndObj(id);
+
+    *out = id;
+    return PlanStage::ADVANCED;
 }
 
 bool CollectionScan::isEOF() {
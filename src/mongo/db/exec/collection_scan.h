@@ -30,9 +30,11 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/matcher/batch_leaf_matcher.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
 
@@ -60,6 +62,9 @@ public:
                    const MatchExpression* filter);
 
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(size_t maxWorks,
+                           std::vector<WorkingSetID>* out,
+                           WorkingSetID* stateOut) final;
     bool isEOF() final;
 
     void doDetachFromOperationContext() final;
@@ -84,10 +89,11 @@ protected:
 
 private:
     /**
-     * If the member (with id memberID) passes our filter, set *out to memberID and return that
-     * ADVANCED.  Otherwise, free memberID and return NEED_TIME.
+     * If 'record' passes our filter, places it in a new working set member, sets *out to that
+     * member's id and returns ADVANCED. Otherwise returns NEED_TIME, or IS_EOF if the scan's end
+     * condition has been reached, without allocating a working set member.
      */
-    StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
+    StageState returnIfMatches(Record* record, WorkingSetID* out);
 
     /**
      * Extracts the timestamp from the 'ts' field of 'record', and sets '_latestOplogEntryTimestamp'
@@ -96,12 +102,31 @@ private:
      */
     Status setLatestOplogEntryTimestamp(const Record& record);
 
+    bool forward() const {
+        return _params.direction == CollectionScanParams::FORWARD;
+    }
+
+    /**
+     * Returns whether 'id' comes before or after, respectively, the range of RecordIds given by
+     * '_params.minRecord' and '_params.maxRecord', in the direction of the scan.
+     */
+    bool isBeforeRange(const RecordId& id) const;
+    bool isAfterRange(const RecordId& id) const;
+
     // WorkingSet is not owned by us.
     WorkingSet* _workingSet;
 
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // If non-null, an equivalent of '_filter' which doWorkBatch() uses to filter each batch of
+    // documents in a single pass.
+    std::unique_ptr<BatchLeafMatcher> _batchFilter;
+
+    // Scratch space for evaluating '_batchFilter', kept to avoid reallocating for every batch.
+    std::vector<BSONObj> _batchDocs;
+    SelectionBitmap _batchSelection;
+
     // If a document does not pass '_filter' but passes '_endCondition', stop scanning and return
     // IS_EOF.
     BSONObj _endConditionBSON;
@@ -51,6 +51,16 @@ struct CollectionScanParams {
     // oplog scans.
     boost::optional<Timestamp> maxTs;
 
+    // If present, the collection scan only returns records whose RecordId is at least 'minRecord'.
+    // When this is the first record in the direction of the scan, the scan seeks directly to it if
+    // the record exists. Cannot be combined with 'tailable'.
+    boost::optional<RecordId> minRecord;
+
+    // If present, the collection scan only returns records whose RecordId is at most 'maxRecord',
+    // and hits EOF at the first record past it in the direction of the scan. Cannot be combined with
+    // 'tailable'.
+    boost::optional<RecordId> maxRecord;
+
     Direction direction = FORWARD;
 
     // Do we want the scan to be 'tailable'?  Only meaningful if the collection is capped.
@@ -67,6 +67,10 @@ struct DeleteStageParams {
     // The stmtId for this particular delete.
     StmtId stmtId = kUninitializedStmtId;
 
+    // For a multi delete, the number of deleted documents after which the stage reports EOF even
+    // if its child has more documents to return. Unlimited if not set.
+    boost::optional<long long> limit;
+
     // The parsed query predicate for this delete. Not owned here.
     CanonicalQuery* canonicalQuery;
 
@@ -34,6 +34,7 @@
 #include <boost/functional/hash.hpp>
 
 #include "mongo/bson/bson_depth.h"
+#include "mongo/db/exec/document_value/document_storage_buffer_pool.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/resume_token.h"
@@ -160,13 +161,35 @@ Position DocumentStorage::findField(StringData requested, LookupPolicy policy) c
         return pos;
     }
 
+    if (_numUncachedLookups < kMaxUncachedLookups) {
+        // The first few lookups that miss the cache only convert the requested element, so reading
+        // a handful of fields from a wide document does not build Values for everything preceding
+        // them. The elements skipped here stay unconverted until the caching scan below or an
+        // iterator reaches them.
+        ++_numUncachedLookups;
+        for (BSONObjIterator it = _bsonIt; it.more();) {
+            BSONElement bsonElement(it.next());
+            if (requested == bsonElement.fieldNameStringData()) {
+                return const_cast<DocumentStorage*>(this)->constructInCache(bsonElement);
+            }
+        }
+        return Position();
+    }
+
     while (_bsonIt.more()) {
         BSONElement bsonElement(_bsonIt.next());
+        // Elements found by the lookups above are already in the cache.
+        Position pos;
+        if (_numUncachedLookups > 0) {
+            pos = findFieldInCache(bsonElement.fieldNameStringData());
+        }
         // In order to avoid repeatedly scanning the BSON we were constructed from, we'll bring in a
         // copy of every value we encounter while searching here. That way the next time we search
         // we won't have to reconsider elements we've already examined and can avoid an O(N^2) worst
         // case performance.
-        auto pos = const_cast<DocumentStorage*>(this)->constructInCache(bsonElement);
+        if (!pos.found()) {
+            pos = const_cast<DocumentStorage*>(this)->constructInCache(bsonElement);
+        }
         if (requested == bsonElement.fieldNameStringData()) {
             return pos;
         }
@@ -247,6 +270,7 @@ void DocumentStorage::alloc(unsigned newSize) {
     const bool firstAlloc = !_cache;
     const bool doingRehash = needRehash();
     const size_t oldCapacity = _cacheEnd - _cache;
+    const size_t oldAllocatedBytes = allocatedBytes();
 
     // make new bucket count big enough
     while (needRehash() || hashTabBuckets() < HASH_TAB_INIT_SIZE)
@@ -259,13 +283,13 @@ void DocumentStorage::alloc(unsigned newSize) {
 
     uassert(16490, "Tried to make oversized document", capacity <= size_t(BufferMaxSize));
 
-    std::unique_ptr<char[]> oldBuf(_cache);
-    _cache = new char[capacity];
+    char* oldBuf = _cache;
+    _cache = DocumentStorageBufferPool::allocate(capacity);
     _cacheEnd = _cache + capacity - hashTabBytes();
 
     if (!firstAlloc) {
         // This just copies the elements
-        memcpy(_cache, oldBuf.get(), _usedBytes);
+        memcpy(_cache, oldBuf, _usedBytes);
 
         if (_numFields >= HASH_TAB_MIN) {
             // if we were hashing, deal with the hash table
@@ -273,9 +297,11 @@ void DocumentStorage::alloc(unsigned newSize) {
                 rehash();
             } else {
                 // no rehash needed so just slide table down to new position
-                memcpy(_hashTab, oldBuf.get() + oldCapacity, hashTabBytes());
+                memcpy(_hashTab, oldBuf + oldCapacity, hashTabBytes());
             }
         }
+
+        DocumentStorageBufferPool::free(oldBuf, oldAllocatedBytes);
     }
 }
 
@@ -292,8 +318,13 @@ void DocumentStorage::reserveFields(size_t expectedFields) {
 
     uassert(16491, "Tried to make oversized document", newSize <= size_t(BufferMaxSize));
 
-    _cache = new char[newSize + hashTabBytes()];
-    _cacheEnd = _cache + newSize;
+    // Round up to a power of two like alloc() does, so that the buffer can be recycled.
+    size_t capacity = 128;
+    while (capacity < newSize + hashTabBytes())
+        capacity *= 2;
+
+    _cache = DocumentStorageBufferPool::allocate(capacity);
+    _cacheEnd = _cache + capacity - hashTabBytes();
 }
 
 intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
@@ -303,7 +334,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
         // Make a copy of the buffer with the fields.
         // It is very important that the positions of each field are the same after cloning.
         const size_t bufferBytes = allocatedBytes();
-        out->_cache = new char[bufferBytes];
+        out->_cache = DocumentStorageBufferPool::allocate(bufferBytes);
         out->_cacheEnd = out->_cache + (_cacheEnd - _cache);
         memcpy(out->_cache, _cache, bufferBytes);
 
@@ -335,11 +366,11 @@ size_t DocumentStorage::getMetadataApproximateSize() const {
 }
 
 DocumentStorage::~DocumentStorage() {
-    std::unique_ptr<char[]> deleteBufferAtScopeEnd(_cache);
-
     for (auto it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
     }
+
+    DocumentStorageBufferPool::free(_cache, allocatedBytes());
 }
 
 void DocumentStorage::reset(const BSONObj& bson, bool stripMetadata) {
@@ -347,13 +378,17 @@ void DocumentStorage::reset(const BSONObj& bson, bool stripMetadata) {
     _bsonIt = BSONObjIterator(_bson);
     _stripMetadata = stripMetadata;
     _modified = false;
+    _numUncachedLookups = 0;
 
     // Clean cache.
     for (auto it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
     }
 
-    _cacheEnd = _cache;
+    // Release the buffer, whose size can't be recovered once the hash table is reset.
+    DocumentStorageBufferPool::free(_cache, allocatedBytes());
+    _cache = nullptr;
+    _cacheEnd = nullptr;
     _usedBytes = 0;
     _numFields = 0;
     _hashTabMask = 0;
@@ -502,6 +502,10 @@ private:
 
     void loadLazyMetadata() const;
 
+    // Number of cache misses served by scanning ahead in '_bson' without caching the elements
+    // passed over. Later misses cache every element they pass to bound repeated scans of the BSON.
+    static constexpr unsigned char kMaxUncachedLookups = 4;
+
     enum {
         HASH_TAB_INIT_SIZE = 8,  // must be power of 2
         HASH_TAB_MIN = 4,        // don't hash fields for docs smaller than this
@@ -535,6 +539,9 @@ private:
     BSONObj _bson;
     mutable BSONObjIterator _bsonIt;
 
+    // Counts the lookups served without caching the preceding elements; see findField().
+    mutable unsigned char _numUncachedLookups = 0;
+
     // If '_stripMetadata' is true, tracks whether or not the metadata has been lazy-loaded from the
     // backing '_bson' object. If so, then no attempt will be made to load the metadata again, even
     // if the metadata has been released by a call to 'releaseMetadata()'.
@@ -0,0 +1,200 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/document_value/document_storage_buffer_pool.h"
+
+#include <array>
+#include <vector>
+
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
+
+namespace mongo {
+namespace {
+
+Counter64 cachedBytesCounter;
+Counter64 reusedCounter;
+Counter64 allocatedCounter;
+
+ServerStatusMetricField<Counter64> displayCachedBytes("query.documentBufferPool.cachedBytes",
+                                                      &cachedBytesCounter);
+ServerStatusMetricField<Counter64> displayReused("query.documentBufferPool.reused",
+                                                 &reusedCounter);
+ServerStatusMetricField<Counter64> displayAllocated("query.documentBufferPool.allocated",
+                                                    &allocatedCounter);
+
+// The number of events after which a thread publishes its counts.
+constexpr long long kStatsFlushInterval = 1024;
+
+constexpr size_t kNumSizeClasses = 6;
+static_assert(DocumentStorageBufferPool::kMinCachedBufferSize << (kNumSizeClasses - 1) ==
+                  DocumentStorageBufferPool::kMaxCachedBufferSize,
+              "one size class per power of two between the smallest and largest cached buffers");
+
+/**
+ * Returns the size class of buffers of 'size' bytes, or -1 if they aren't cached.
+ */
+int sizeClassFor(size_t size) {
+    if (size < DocumentStorageBufferPool::kMinCachedBufferSize ||
+        size > DocumentStorageBufferPool::kMaxCachedBufferSize || (size & (size - 1)) != 0) {
+        return -1;
+    }
+
+    int sizeClass = 0;
+    for (size_t classSize = DocumentStorageBufferPool::kMinCachedBufferSize; classSize < size;
+         classSize *= 2) {
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+class ThreadCache {
+public:
+    ~ThreadCache();
+
+    char* allocate(int sizeClass, size_t size) {
+        auto& buffers = _buffers[sizeClass];
+        if (buffers.empty()) {
+            ++_pendingAllocated;
+            maybeFlushStats();
+            return new char[size];
+        }
+
+        char* buffer = buffers.back();
+        buffers.pop_back();
+        _cachedBytes -= size;
+        _pendingCachedBytes -= size;
+        ++_pendingReused;
+        maybeFlushStats();
+        return buffer;
+    }
+
+    void free(char* buffer, int sizeClass, size_t size) {
+        if (_cachedBytes + size > DocumentStorageBufferPool::kMaxCachedBytesPerThread) {
+            delete[] buffer;
+            return;
+        }
+
+        _buffers[sizeClass].push_back(buffer);
+        _cachedBytes += size;
+        _pendingCachedBytes += size;
+        maybeFlushStats();
+    }
+
+    void flushStats() {
+        if (_pendingCachedBytes > 0) {
+            cachedBytesCounter.increment(_pendingCachedBytes);
+        } else if (_pendingCachedBytes < 0) {
+            cachedBytesCounter.decrement(-_pendingCachedBytes);
+        }
+        reusedCounter.increment(_pendingReused);
+        allocatedCounter.increment(_pendingAllocated);
+        _pendingCachedBytes = 0;
+        _pendingReused = 0;
+        _pendingAllocated = 0;
+        _pendingEvents = 0;
+    }
+
+private:
+    void maybeFlushStats() {
+        if (++_pendingEvents >= kStatsFlushInterval) {
+            flushStats();
+        }
+    }
+
+    std::array<std::vector<char*>, kNumSizeClasses> _buffers;
+    size_t _cachedBytes = 0;
+
+    // Counts not yet published to the serverStatus counters.
+    long long _pendingCachedBytes = 0;
+    long long _pendingReused = 0;
+    long long _pendingAllocated = 0;
+    long long _pendingEvents = 0;
+};
+
+thread_local ThreadCache threadCache;
+
+// Set once 'threadCache' has been destroyed, after which buffers freed by the destructors of other
+// thread-local objects go straight back to the allocator.
+thread_local bool threadCacheDestroyed = false;
+
+ThreadCache::~ThreadCache() {
+    size_t sizeClassBytes = DocumentStorageBufferPool::kMinCachedBufferSize;
+    for (auto&& buffers : _buffers) {
+        for (char* buffer : buffers) {
+            delete[] buffer;
+        }
+        _pendingCachedBytes -= sizeClassBytes * buffers.size();
+        sizeClassBytes *= 2;
+    }
+    flushStats();
+    threadCacheDestroyed = true;
+}
+
+}  // namespace
+
+char* DocumentStorageBufferPool::allocate(size_t size) {
+    const int sizeClass = sizeClassFor(size);
+    if (sizeClass < 0 || threadCacheDestroyed) {
+        return new char[size];
+    }
+    return threadCache.allocate(sizeClass, size);
+}
+
+void DocumentStorageBufferPool::free(char* buffer, size_t size) {
+    if (!buffer) {
+        return;
+    }
+
+    const int sizeClass = sizeClassFor(size);
+    if (sizeClass < 0 || threadCacheDestroyed) {
+        delete[] buffer;
+        return;
+    }
+    threadCache.free(buffer, sizeClass, size);
+}
+
+DocumentStorageBufferPool::Stats DocumentStorageBufferPool::getStats() {
+    Stats stats;
+    stats.cachedBytes = cachedBytesCounter.get();
+    stats.reused = reusedCounter.get();
+    stats.allocated = allocatedCounter.get();
+    return stats;
+}
+
+void DocumentStorageBufferPool::flushThreadStats() {
+    if (!threadCacheDestroyed) {
+        threadCache.flushStats();
+    }
+}
+
+}  // namespace mongo
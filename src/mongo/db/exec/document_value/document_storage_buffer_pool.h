@@ -0,0 +1,86 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+
+namespace mongo {
+
+/**
+ * Recycles the buffers which hold the fields of a DocumentStorage. Aggregation builds and destroys
+ * large numbers of short-lived documents whose buffers come in a handful of power-of-two sizes, so
+ * each thread keeps the buffers it frees, up to 'kMaxCachedBytesPerThread', and hands them out
+ * again before falling back to the allocator. Buffers of any other size, including those too large
+ * to be cached, are allocated and freed directly.
+ *
+ * A buffer may be freed on a different thread than the one it was allocated on.
+ */
+class DocumentStorageBufferPool {
+public:
+    static constexpr size_t kMinCachedBufferSize = 128;
+    static constexpr size_t kMaxCachedBufferSize = 4096;
+    static constexpr size_t kMaxCachedBytesPerThread = 64 * 1024;
+
+    struct Stats {
+        // The bytes currently held in the caches of all threads.
+        long long cachedBytes = 0;
+
+        // The number of buffers handed out from a cache rather than newly allocated.
+        long long reused = 0;
+
+        // The number of cacheable buffers which had to be newly allocated.
+        long long allocated = 0;
+    };
+
+    /**
+     * Returns a buffer of 'size' bytes.
+     */
+    static char* allocate(size_t size);
+
+    /**
+     * Releases 'buffer', which must have been returned by allocate() for the same 'size'. A null
+     * 'buffer' is ignored.
+     */
+    static void free(char* buffer, size_t size);
+
+    /**
+     * Returns the statistics reported in serverStatus. Each thread publishes its counts
+     * periodically, so they may lag behind the most recent allocations.
+     */
+    static Stats getStats();
+
+    /**
+     * Publishes the counts of the calling thread, such that getStats() reflects them.
+     */
+    static void flushThreadStats();
+};
+
+}  // namespace mongo
@@ -0,0 +1,114 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/document_storage_buffer_pool.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(DocumentStorageBufferPoolTest, FreedBufferIsReusedForSameSize) {
+    char* buffer = DocumentStorageBufferPool::allocate(256);
+    DocumentStorageBufferPool::free(buffer, 256);
+
+    // A different size class doesn't get the freed buffer.
+    char* otherSize = DocumentStorageBufferPool::allocate(512);
+    ASSERT_NE(otherSize, buffer);
+
+    char* reused = DocumentStorageBufferPool::allocate(256);
+    ASSERT_EQ(reused, buffer);
+
+    DocumentStorageBufferPool::free(otherSize, 512);
+    DocumentStorageBufferPool::free(reused, 256);
+}
+
+TEST(DocumentStorageBufferPoolTest, BuffersOfOtherSizesAreNotCached) {
+    DocumentStorageBufferPool::flushThreadStats();
+    const auto before = DocumentStorageBufferPool::getStats();
+
+    const size_t tooLarge = DocumentStorageBufferPool::kMaxCachedBufferSize * 2;
+    for (size_t size : {size_t(100), size_t(384), tooLarge}) {
+        char* buffer = DocumentStorageBufferPool::allocate(size);
+        buffer[size - 1] = 'x';
+        DocumentStorageBufferPool::free(buffer, size);
+    }
+
+    DocumentStorageBufferPool::flushThreadStats();
+    const auto after = DocumentStorageBufferPool::getStats();
+    ASSERT_EQ(after.cachedBytes, before.cachedBytes);
+    ASSERT_EQ(after.reused, before.reused);
+    ASSERT_EQ(after.allocated, before.allocated);
+}
+
+TEST(DocumentStorageBufferPoolTest, DocumentsReuseBuffersOfDestroyedDocuments) {
+    DocumentStorageBufferPool::flushThreadStats();
+    const auto before = DocumentStorageBufferPool::getStats();
+
+    for (int i = 0; i < 10; ++i) {
+        MutableDocument md;
+        md.addField("a", Value(i));
+        md.addField("b", Value("string"_sd));
+        auto doc = md.freeze();
+        auto copy = doc;
+        MutableDocument modified(copy);
+        modified.setField("a", Value(i + 1));
+        ASSERT_DOCUMENT_EQ(modified.freeze(), (Document{{"a", i + 1}, {"b", "string"_sd}}));
+        ASSERT_DOCUMENT_EQ(doc, (Document{{"a", i}, {"b", "string"_sd}}));
+    }
+
+    DocumentStorageBufferPool::flushThreadStats();
+    ASSERT_GT(DocumentStorageBufferPool::getStats().reused, before.reused);
+}
+
+TEST(DocumentStorageBufferPoolTest, ThreadCacheIsBounded) {
+    const size_t size = DocumentStorageBufferPool::kMaxCachedBufferSize;
+    const size_t numBuffers = 2 * DocumentStorageBufferPool::kMaxCachedBytesPerThread / size;
+
+    std::vector<char*> buffers;
+    for (size_t i = 0; i < numBuffers; ++i) {
+        buffers.push_back(DocumentStorageBufferPool::allocate(size));
+    }
+    for (char* buffer : buffers) {
+        DocumentStorageBufferPool::free(buffer, size);
+    }
+
+    DocumentStorageBufferPool::flushThreadStats();
+    ASSERT_LTE(DocumentStorageBufferPool::getStats().cachedBytes,
+               static_cast<long long>(DocumentStorageBufferPool::kMaxCachedBytesPerThread));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -133,6 +133,70 @@ TEST(DocumentConstruction, FromBsonReset) {
     ASSERT_BSONOBJ_EQ(bson, toBson(newDocument));
 }
 
+TEST(DocumentConstruction, FromBsonLooksUpFieldsOutOfOrder) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < 20; ++i) {
+        builder.append("f" + std::to_string(i), i);
+    }
+    auto bson = builder.obj();
+    Document document = fromBson(bson);
+
+    // Lookups that skip ahead in the BSON, followed by enough misses to fall back to caching every
+    // element scanned, must neither lose nor duplicate fields.
+    for (auto i : {15, 3, 18, 0, 7, 19, 1}) {
+        ASSERT_VALUE_EQ(Value(i), document["f" + std::to_string(i)]);
+    }
+    ASSERT(document["missing"].missing());
+    ASSERT_EQUALS(20U, document.size());
+    ASSERT_BSONOBJ_EQ(bson, toBson(document));
+    for (int i = 0; i < 20; ++i) {
+        auto field = getNthField(document, i);
+        ASSERT_EQUALS("f" + std::to_string(i), field.first.toString());
+        ASSERT_VALUE_EQ(Value(i), field.second);
+    }
+
+    MutableDocument md(document);
+    md.setField("f18", Value("x"_sd));
+    md.remove("f3");
+    md.setField("f20", Value(20));
+    auto modified = md.freeze();
+    ASSERT_EQUALS(20U, modified.size());
+    ASSERT_VALUE_EQ(Value("x"_sd), modified["f18"]);
+    ASSERT(modified["f3"].missing());
+    ASSERT_EQUALS("f20", getNthField(modified, 19).first.toString());
+}
+
+TEST(DocumentConstruction, FromBsonRepeatedLookupsDoNotDuplicateCachedFields) {
+    // The field names all have the same length, so the cache grows the same way whatever order the
+    // fields are brought into it.
+    BSONObjBuilder builder;
+    for (int i = 10; i < 30; ++i) {
+        builder.append("f" + std::to_string(i), i);
+    }
+    auto bson = builder.obj();
+
+    auto cacheAllFields = [](const Document& document) {
+        for (FieldIterator it(document); it.more();) {
+            it.next();
+        }
+    };
+
+    Document scanned = fromBson(bson);
+    cacheAllFields(scanned);
+
+    // Repeat lookups of fields found ahead of the cached part of the BSON, both before and after
+    // the lookups fall back to caching every element they pass.
+    Document lookedUp = fromBson(bson);
+    for (auto i : {25, 25, 13, 28, 25, 13, 10, 17, 29, 11, 28}) {
+        ASSERT_VALUE_EQ(Value(i), lookedUp["f" + std::to_string(i)]);
+    }
+    cacheAllFields(lookedUp);
+
+    ASSERT_EQUALS(20U, lookedUp.size());
+    ASSERT_EQUALS(scanned.getApproximateSize(), lookedUp.getApproximateSize());
+    ASSERT_BSONOBJ_EQ(bson, toBson(lookedUp));
+}
+
 /**
  * Appends to 'builder' an object nested 'depth' levels deep.
  */
@@ -31,7 +31,9 @@
 
 #include "mongo/db/exec/fetch.h"
 
+#include <algorithm>
 #include <memory>
+#include <tuple>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
@@ -69,6 +71,11 @@ bool FetchStage::isEOF() {
         return false;
     }
 
+    if (!_childBatch.empty() || _childBatchState) {
+        // We have buffered output from our child that we haven't handed on yet.
+        return false;
+    }
+
     return child()->isEOF();
 }
 
@@ -77,15 +84,23 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    // Either retry the last WSM we worked on or get a new one from our child.
+    // Either retry the last WSM we worked on, take the next one buffered by doWorkBatch(), or get
+    // a new one from our child.
     WorkingSetID id;
     StageState status;
-    if (_idRetrying == WorkingSet::INVALID_ID) {
-        status = child()->work(&id);
-    } else {
+    if (_idRetrying != WorkingSet::INVALID_ID) {
         status = ADVANCED;
         id = _idRetrying;
         _idRetrying = WorkingSet::INVALID_ID;
+    } else if (!_childBatch.empty()) {
+        status = ADVANCED;
+        id = _childBatch.front();
+        _childBatch.pop_front();
+    } else if (_childBatchState) {
+        std::tie(status, id) = *_childBatchState;
+        _childBatchState = boost::none;
+    } else {
+        status = child()->work(&id);
     }
 
     if (PlanStage::ADVANCED == status) {
@@ -131,10 +146,40 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState FetchStage::doWorkBatch(size_t maxWorks,
+                                              std::vector<WorkingSetID>* out,
+                                              WorkingSetID* stateOut) {
+    if (_idRetrying == WorkingSet::INVALID_ID && _childBatch.empty() && !_childBatchState) {
+        std::vector<WorkingSetID> childBatch;
+        WorkingSetID childStateId = WorkingSet::INVALID_ID;
+        const StageState childState = child()->workBatch(maxWorks, &childBatch, &childStateId);
+
+        _childBatch.insert(_childBatch.end(), childBatch.begin(), childBatch.end());
+        if (PlanStage::ADVANCED != childState && PlanStage::NEED_TIME != childState) {
+            _childBatchState = std::make_pair(childState, childStateId);
+        } else if (_childBatch.empty()) {
+            return recordWorkResult(PlanStage::NEED_TIME);
+        }
+    }
+
+    // Fetch everything we have buffered, but never more than we were asked for.
+    const size_t numBuffered = (_idRetrying != WorkingSet::INVALID_ID ? 1 : 0) +
+        _childBatch.size() + (_childBatchState ? 1 : 0);
+    return workBatchWith(std::min(maxWorks, numBuffered), out, stateOut, [this](WorkingSetID* id) {
+        return FetchStage::doWork(id);
+    });
+}
+
 void FetchStage::doSaveStateRequiresCollection() {
     if (_cursor) {
         _cursor->saveUnpositioned();
     }
+
+    // Buffered members which already have an object may be pointing into storage engine memory
+    // that is not guaranteed to survive the yield.
+    for (auto id : _childBatch) {
+        _ws->get(id)->makeObjOwnedIfNeeded();
+    }
 }
 
 void FetchStage::doRestoreStateRequiresCollection() {
@@ -29,7 +29,10 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+#include <deque>
 #include <memory>
+#include <utility>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/jsobj.h"
@@ -60,6 +63,9 @@ public:
 
     bool isEOF() final;
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(size_t maxWorks,
+                           std::vector<WorkingSetID>* out,
+                           WorkingSetID* stateOut) final;
 
     void doDetachFromOperationContext() final;
     void doReattachToOperationContext() final;
@@ -98,6 +104,14 @@ private:
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // Results obtained from our child by doWorkBatch() which have not been fetched yet. These are
+    // consumed, in order, before asking our child for anything else.
+    std::deque<WorkingSetID> _childBatch;
+
+    // The state which ended the most recent batch obtained from our child, if it was IS_EOF,
+    // NEED_YIELD or FAILURE. It is handed on once '_childBatch' has been consumed.
+    boost::optional<std::pair<StageState, WorkingSetID>> _childBatchState;
+
     // Stats
     FetchStats _specificStats;
 };
@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/geo_near.h"
 
+#include <cmath>
 #include <memory>
 #include <vector>
 
@@ -94,6 +95,55 @@ struct StoredGeometry {
     BSONElement element;
     GeometryContainer geometry;
 };
+
+// Each search annulus aims to return between these numbers of results: enough to amortize setting
+// up its index scan, but few enough that the nearest results are returned quickly.
+const long long kMinResultsPerInterval = 300;
+const long long kMaxResultsPerInterval = 600;
+
+// The most the width of consecutive search annuli may grow by, so that a dense region following a
+// sparse one is not buffered all at once.
+const double kMaxBoundsIncrementGrowth = 8;
+
+/**
+ * Returns the width of the next search annulus given the width 'increment' of the last one and the
+ * statistics of the intervals searched so far.
+ *
+ * When the last annulus returned too few results, the density of the results seen so far is
+ * extrapolated to pick a width which should return about kMinResultsPerInterval. This crosses
+ * sparse regions in a few wide annuli rather than by doubling the width one narrow annulus at a
+ * time.
+ */
+double nextBoundsIncrement(double increment, const std::vector<IntervalStats>& intervals) {
+    if (intervals.empty()) {
+        return increment;
+    }
+
+    const IntervalStats& last = intervals.back();
+    if (last.numResultsReturned > kMaxResultsPerInterval) {
+        return increment / 2;
+    }
+    if (last.numResultsReturned >= kMinResultsPerInterval) {
+        return increment;
+    }
+
+    long long numResults = 0;
+    for (auto&& interval : intervals) {
+        numResults += interval.numResultsReturned;
+    }
+
+    double growth = kMaxBoundsIncrementGrowth;
+    const double inner = std::max(0.0, intervals.front().minDistanceAllowed);
+    const double outer = last.maxDistanceAllowed;
+    if (numResults > 0 && outer > inner) {
+        // Treat the results as spread evenly over the area searched so far, which grows with the
+        // square of the distance.
+        const double density = numResults / (outer * outer - inner * inner);
+        const double targetOuter = std::sqrt(outer * outer + kMinResultsPerInterval / density);
+        growth = std::min(kMaxBoundsIncrementGrowth, (targetOuter - outer) / increment);
+    }
+    return increment * std::max(2.0, growth);
+}
 }  // namespace
 
 /**
@@ -579,15 +629,7 @@ GeoNear2DStage::nextInterval(OperationContext* opCtx,
     // Setup the next interval
     //
 
-    if (!_specificStats.intervalStats.empty()) {
-        const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
-    }
+    _boundsIncrement = nextBoundsIncrement(_boundsIncrement, _specificStats.intervalStats);
 
     _boundsIncrement =
         max(_boundsIncrement, min2DBoundsIncrement(*_nearParams.nearQuery, indexDescriptor()));
@@ -975,15 +1017,7 @@ GeoNear2DSphereStage::nextInterval(OperationContext* opCtx,
     // Setup the next interval
     //
 
-    if (!_specificStats.intervalStats.empty()) {
-        const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
-    }
+    _boundsIncrement = nextBoundsIncrement(_boundsIncrement, _specificStats.intervalStats);
 
     invariant(_boundsIncrement > 0.0);
 
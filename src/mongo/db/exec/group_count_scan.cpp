@@ -0,0 +1,201 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/group_count_scan.h"
+
+#include <limits>
+#include <memory>
+
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/platform/overflow_arithmetic.h"
+
+namespace mongo {
+
+// static
+const char* GroupCountScan::kStageType = "GROUP_COUNT_SCAN";
+
+GroupCountScan::GroupCountScan(OperationContext* opCtx,
+                               GroupCountScanParams params,
+                               WorkingSet* workingSet)
+    : RequiresIndexStage(kStageType, opCtx, params.indexDescriptor, workingSet),
+      _workingSet(workingSet),
+      _keyPattern(std::move(params.keyPattern)),
+      _groupFieldName(std::move(params.groupFieldName)),
+      _countFields(std::move(params.countFields)) {
+    _specificStats.indexName = params.name;
+    _specificStats.keyPattern = _keyPattern;
+    _specificStats.indexVersion = static_cast<int>(params.indexDescriptor->version());
+}
+
+PlanStage::StageState GroupCountScan::doWork(WorkingSetID* out) {
+    if (_commonStats.isEOF)
+        return PlanStage::IS_EOF;
+
+    boost::optional<IndexKeyEntry> entry;
+    const bool needInit = !_cursor;
+    try {
+        // We only look at the keys.
+        const auto kWantKey = SortedDataInterface::Cursor::kWantKey;
+
+        if (needInit) {
+            // First call to work(). Position the cursor on the first key of the index, whatever
+            // the direction of each of its fields.
+            _cursor = indexAccessMethod()->newCursor(getOpCtx());
+
+            BSONObjBuilder startKey;
+            for (auto&& elem : _keyPattern) {
+                if (elem.number() >= 0) {
+                    startKey.appendMinKey("");
+                } else {
+                    startKey.appendMaxKey("");
+                }
+            }
+            auto keyStringForSeek = IndexEntryComparison::makeKeyStringFromBSONKeyForSeek(
+                startKey.obj(),
+                indexAccessMethod()->getSortedDataInterface()->getKeyStringVersion(),
+                indexAccessMethod()->getSortedDataInterface()->getOrdering(),
+                true, /* forward */
+                true /* inclusive */);
+            entry = _cursor->seek(keyStringForSeek, kWantKey);
+        } else {
+            entry = _cursor->next(kWantKey);
+        }
+    } catch (const WriteConflictException&) {
+        if (needInit) {
+            // Release our cursor and try again next time.
+            _cursor.reset();
+        }
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
+
+    if (!entry) {
+        _commonStats.isEOF = true;
+        _cursor.reset();
+        if (_currentCount == 0) {
+            return PlanStage::IS_EOF;
+        }
+
+        // Return the last group.
+        *out = makeGroupResult(_currentKey.firstElement(), _currentCount);
+        _currentCount = 0;
+        return PlanStage::ADVANCED;
+    }
+
+    ++_specificStats.keysExamined;
+
+    // Equal leading values are adjacent in the index. Values of different numeric types which
+    // compare equal, such as 1 and 1.0, belong to the same group just like in $group.
+    const bool considerFieldName = false;
+    if (_currentCount > 0 &&
+        entry->key.firstElement().woCompare(_currentKey.firstElement(), considerFieldName) == 0) {
+        ++_currentCount;
+        return PlanStage::NEED_TIME;
+    }
+
+    // The entry starts a new group. Return the group it ends, if any.
+    auto previousKey = std::move(_currentKey);
+    auto previousCount = _currentCount;
+    _currentKey = entry->key.getOwned();
+    _currentCount = 1;
+
+    if (previousCount == 0) {
+        return PlanStage::NEED_TIME;
+    }
+
+    *out = makeGroupResult(previousKey.firstElement(), previousCount);
+    return PlanStage::ADVANCED;
+}
+
+WorkingSetID GroupCountScan::makeGroupResult(const BSONElement& groupKey, long long count) {
+    ++_specificStats.groupsReturned;
+
+    BSONObjBuilder bob;
+    bob.appendAs(groupKey, _groupFieldName);
+    for (auto&& [fieldName, factor] : _countFields) {
+        // Like $sum over integers, the total is an int when it fits, a long if it fits in one,
+        // and a double otherwise.
+        long long total;
+        if (overflow::mul(count, factor, &total)) {
+            bob.append(fieldName, static_cast<double>(count) * static_cast<double>(factor));
+        } else if (total >= std::numeric_limits<int>::min() &&
+                   total <= std::numeric_limits<int>::max()) {
+            bob.append(fieldName, static_cast<int>(total));
+        } else {
+            bob.append(fieldName, total);
+        }
+    }
+
+    WorkingSetID id = _workingSet->allocate();
+    WorkingSetMember* member = _workingSet->get(id);
+    member->doc = {SnapshotId(), Document(bob.obj())};
+    member->transitionToOwnedObj();
+    return id;
+}
+
+bool GroupCountScan::isEOF() {
+    return _commonStats.isEOF;
+}
+
+void GroupCountScan::doSaveStateRequiresIndex() {
+    if (_cursor)
+        _cursor->save();
+}
+
+void GroupCountScan::doRestoreStateRequiresIndex() {
+    if (_cursor)
+        _cursor->restore();
+}
+
+void GroupCountScan::doDetachFromOperationContext() {
+    if (_cursor)
+        _cursor->detachFromOperationContext();
+}
+
+void GroupCountScan::doReattachToOperationContext() {
+    if (_cursor)
+        _cursor->reattachToOperationContext(getOpCtx());
+}
+
+std::unique_ptr<PlanStageStats> GroupCountScan::getStats() {
+    auto ret = std::make_unique<PlanStageStats>(_commonStats, STAGE_GROUP_COUNT_SCAN);
+    ret->specific = std::make_unique<GroupCountScanStats>(_specificStats);
+    return ret;
+}
+
+const SpecificStats* GroupCountScan::getSpecificStats() const {
+    return &_specificStats;
+}
+
+}  // namespace mongo
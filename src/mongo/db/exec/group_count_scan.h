@@ -0,0 +1,129 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/db/exec/requires_index_stage.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+
+namespace mongo {
+
+class WorkingSet;
+
+struct GroupCountScanParams {
+    GroupCountScanParams(const IndexDescriptor* descriptor,
+                         std::string groupFieldName,
+                         std::vector<std::pair<std::string, long long>> countFields)
+        : indexDescriptor(descriptor),
+          name(descriptor->indexName()),
+          keyPattern(descriptor->keyPattern()),
+          groupFieldName(std::move(groupFieldName)),
+          countFields(std::move(countFields)) {}
+
+    const IndexDescriptor* indexDescriptor;
+    std::string name;
+
+    BSONObj keyPattern;
+
+    // The field of each output document which holds the value of the group's leading key field.
+    std::string groupFieldName;
+
+    // The fields of each output document which hold the number of keys in the group, each
+    // multiplied by the paired factor.
+    std::vector<std::pair<std::string, long long>> countFields;
+};
+
+/**
+ * Used by aggregation to answer a $group on a single field whose accumulators only count, such as
+ * {$group: {_id: "$a", n: {$sum: 1}}}, with an index whose leading field is the group field. Scans
+ * the whole index in order and counts the adjacent keys whose leading field compares equal,
+ * returning one owned object per group in the shape of the $group's output. Neither the documents
+ * nor a Document per key are ever built.
+ *
+ * The caller is responsible for only using an index whose keys map one to one to the documents of
+ * the collection and hold the values $group would see, that is a btree index which is neither
+ * multikey, sparse, partial nor built with a non-simple collation.
+ */
+class GroupCountScan final : public RequiresIndexStage {
+public:
+    GroupCountScan(OperationContext* opCtx, GroupCountScanParams params, WorkingSet* workingSet);
+
+    StageState doWork(WorkingSetID* out) final;
+    bool isEOF() final;
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
+    StageType stageType() const final {
+        return STAGE_GROUP_COUNT_SCAN;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() final;
+
+    const SpecificStats* getSpecificStats() const final;
+
+    static const char* kStageType;
+
+protected:
+    void doSaveStateRequiresIndex() final;
+
+    void doRestoreStateRequiresIndex() final;
+
+private:
+    /**
+     * Returns a working set member holding the output document for the group whose leading key
+     * value is 'groupKey' and which spans 'count' index keys.
+     */
+    WorkingSetID makeGroupResult(const BSONElement& groupKey, long long count);
+
+    // The WorkingSet we annotate with results. Not owned by us.
+    WorkingSet* _workingSet;
+
+    const BSONObj _keyPattern;
+
+    const std::string _groupFieldName;
+
+    const std::vector<std::pair<std::string, long long>> _countFields;
+
+    std::unique_ptr<SortedDataInterface::Cursor> _cursor;
+
+    // The key of the first index entry of the group being counted, and the number of entries
+    // read for it so far. The count is zero before the first key has been read.
+    BSONObj _currentKey;
+    long long _currentCount = 0;
+
+    GroupCountScanStats _specificStats;
+};
+
+}  // namespace mongo
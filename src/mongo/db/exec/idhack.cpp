@@ -55,8 +55,10 @@ IDHackStage::IDHackStage(OperationContext* opCtx,
                          const IndexDescriptor* descriptor)
     : RequiresIndexStage(kStageType, opCtx, descriptor, ws),
       _workingSet(ws),
-      _key(query->getQueryObj()["_id"].wrap()) {
+      _key(query->getQueryObj()[descriptor->keyPattern().firstElementFieldNameStringData()]
+               .wrap()) {
     _specificStats.indexName = descriptor->indexName();
+    _specificStats.keyPattern = descriptor->keyPattern();
     _addKeyMetadata = query->getQueryRequest().returnKey();
 }
 
@@ -66,6 +68,7 @@ IDHackStage::IDHackStage(OperationContext* opCtx,
                          const IndexDescriptor* descriptor)
     : RequiresIndexStage(kStageType, opCtx, descriptor, ws), _workingSet(ws), _key(key) {
     _specificStats.indexName = descriptor->indexName();
+    _specificStats.keyPattern = descriptor->keyPattern();
 }
 
 IDHackStage::~IDHackStage() {}
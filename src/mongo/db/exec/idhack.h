@@ -44,6 +44,9 @@ class RecordCursor;
  * A standalone stage implementing the fast path for key-value retrievals via the _id index. Since
  * the _id index always has the collection default collation, the IDHackStage can only be used when
  * the query's collation is equal to the collection default.
+ *
+ * The same fast path can serve an equality lookup on any other unique, single-field btree index
+ * whose collation matches the query's. The lookup key is the query's value for the index's field.
  */
 class IDHackStage final : public RequiresIndexStage {
 public:
@@ -245,6 +245,13 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
     return PlanStage::ADVANCED;
 }
 
+PlanStage::StageState IndexScan::doWorkBatch(size_t maxWorks,
+                                             std::vector<WorkingSetID>* out,
+                                             WorkingSetID* stateOut) {
+    return workBatchWith(
+        maxWorks, out, stateOut, [this](WorkingSetID* id) { return IndexScan::doWork(id); });
+}
+
 bool IndexScan::isEOF() {
     return _commonStats.isEOF;
 }
@@ -114,6 +114,9 @@ public:
               const MatchExpression* filter);
 
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(size_t maxWorks,
+                           std::vector<WorkingSetID>* out,
+                           WorkingSetID* stateOut) final;
     bool isEOF() final;
     void doDetachFromOperationContext() final;
     void doReattachToOperationContext() final;
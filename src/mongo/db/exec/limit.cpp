@@ -29,6 +29,7 @@
 
 #include "mongo/db/exec/limit.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/exec/scoped_timer.h"
@@ -82,6 +83,26 @@ PlanStage::StageState LimitStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState LimitStage::doWorkBatch(size_t maxWorks,
+                                              std::vector<WorkingSetID>* out,
+                                              WorkingSetID* stateOut) {
+    if (0 == _numToReturn) {
+        // We've returned as many results as we're limited to.
+        return recordWorkResult(PlanStage::IS_EOF);
+    }
+
+    // Never ask the child for more work than we have results left to return, so that the whole
+    // batch can be passed through untouched.
+    const size_t startSize = out->size();
+    const StageState status = child()->workBatch(
+        std::min(maxWorks, static_cast<size_t>(_numToReturn)), out, stateOut);
+
+    const size_t numAdvanced = out->size() - startSize;
+    _numToReturn -= numAdvanced;
+    recordWorkBatchResults(numAdvanced, status);
+    return status;
+}
+
 unique_ptr<PlanStageStats> LimitStage::getStats() {
     _commonStats.isEOF = isEOF();
     unique_ptr<PlanStageStats> ret = std::make_unique<PlanStageStats>(_commonStats, STAGE_LIMIT);
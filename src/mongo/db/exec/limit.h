@@ -53,6 +53,9 @@ public:
 
     bool isEOF() final;
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(size_t maxWorks,
+                           std::vector<WorkingSetID>* out,
+                           WorkingSetID* stateOut) final;
 
     StageType stageType() const final {
         return STAGE_LIMIT;
@@ -44,12 +44,15 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/operation_trace.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -145,6 +148,23 @@ PlanStage::StageState MultiPlanStage::doWork(WorkingSetID* out) {
     return state;
 }
 
+PlanStage::StageState MultiPlanStage::doWorkBatch(size_t maxWorks,
+                                                  std::vector<WorkingSetID>* out,
+                                                  WorkingSetID* stateOut) {
+    // Switching to the backup plan, handing out the results buffered while planning and
+    // reporting a planning failure are all left to the one-at-a-time path.
+    if (_failure || hasBackupPlan() || !_candidates[_bestPlanIdx].results.empty()) {
+        return workBatchWith(1, out, stateOut, [this](WorkingSetID* id) {
+            return MultiPlanStage::doWork(id);
+        });
+    }
+
+    const size_t startSize = out->size();
+    const StageState state = _candidates[_bestPlanIdx].root->workBatch(maxWorks, out, stateOut);
+    recordWorkBatchResults(out->size() - startSize, state);
+    return state;
+}
+
 Status MultiPlanStage::tryYield(PlanYieldPolicy* yieldPolicy) {
     // These are the conditions which can cause us to yield:
     //   1) The yield policy's timer elapsed, or
@@ -203,6 +223,11 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
     // make sense.
     ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
 
+    // Also record the planning time more precisely for the slow query log and explain.
+    Timer planningTimer;
+    ON_BLOCK_EXIT([&] { _specificStats.planningTimeMicros = planningTimer.micros(); });
+    OperationTrace::Span multiPlanSpan(getOpCtx(), "multiPlan");
+
     size_t numWorks = getTrialPeriodWorks(getOpCtx(), collection());
     size_t numResults = getTrialPeriodNumToReturn(*_query);
 
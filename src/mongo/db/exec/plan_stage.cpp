@@ -42,21 +42,47 @@ namespace mongo {
 PlanStage::StageState PlanStage::work(WorkingSetID* out) {
     invariant(_opCtx);
     ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
-    ++_commonStats.works;
+    return recordWorkResult(doWork(out));
+}
+
+PlanStage::StageState PlanStage::workBatch(size_t maxWorks,
+                                           std::vector<WorkingSetID>* out,
+                                           WorkingSetID* stateOut) {
+    invariant(_opCtx);
+    invariant(maxWorks > 0);
+    *stateOut = WorkingSet::INVALID_ID;
+    ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+    return doWorkBatch(maxWorks, out, stateOut);
+}
 
-    StageState workResult = doWork(out);
+PlanStage::StageState PlanStage::doWorkBatch(size_t maxWorks,
+                                             std::vector<WorkingSetID>* out,
+                                             WorkingSetID* stateOut) {
+    return workBatchWith(1, out, stateOut, [this](WorkingSetID* id) { return doWork(id); });
+}
+
+PlanStage::StageState PlanStage::recordWorkResult(StageState state) {
+    ++_commonStats.works;
 
-    if (StageState::ADVANCED == workResult) {
+    if (StageState::ADVANCED == state) {
         ++_commonStats.advanced;
-    } else if (StageState::NEED_TIME == workResult) {
+    } else if (StageState::NEED_TIME == state) {
         ++_commonStats.needTime;
-    } else if (StageState::NEED_YIELD == workResult) {
+    } else if (StageState::NEED_YIELD == state) {
         ++_commonStats.needYield;
-    } else if (StageState::FAILURE == workResult) {
+    } else if (StageState::FAILURE == state) {
         _commonStats.failed = true;
     }
 
-    return workResult;
+    return state;
+}
+
+void PlanStage::recordWorkBatchResults(size_t numAdvanced, StageState state) {
+    _commonStats.works += numAdvanced;
+    _commonStats.advanced += numAdvanced;
+    if (StageState::ADVANCED != state) {
+        recordWorkResult(state);
+    }
 }
 
 void PlanStage::saveState() {
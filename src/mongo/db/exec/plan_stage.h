@@ -193,6 +193,21 @@ public:
      */
     StageState work(WorkingSetID* out);
 
+    /**
+     * Batch-at-a-time variant of work(). Performs up to 'maxWorks' units of work, appending the
+     * WorkingSetID of every result produced to 'out'. The caller owns each appended member exactly
+     * as if it had been returned by an ADVANCED call to work().
+     *
+     * The batch ends early at the first IS_EOF, NEED_YIELD or FAILURE state, which is returned
+     * with '*stateOut' set as work() would have set its out parameter. Any results appended
+     * before that point precede the state and must be consumed first. Otherwise, returns ADVANCED
+     * if at least one result was appended and NEED_TIME if none were.
+     *
+     * Stages which do not override doWorkBatch() perform exactly one unit of work per batch, so
+     * for them this is equivalent to calling work().
+     */
+    StageState workBatch(size_t maxWorks, std::vector<WorkingSetID>* out, WorkingSetID* stateOut);
+
     /**
      * Returns true if no more work can be done on the query / out of results.
      */
@@ -341,6 +356,57 @@ protected:
      */
     virtual StageState doWork(WorkingSetID* out) = 0;
 
+    /**
+     * Performs up to 'maxWorks' units of work. See comment at workBatch() above.
+     *
+     * Implementations are responsible for accounting for the work they do in the common stats,
+     * typically through workBatchWith() or recordWorkBatchResults(). The default implementation
+     * performs a single unit of work via doWork().
+     */
+    virtual StageState doWorkBatch(size_t maxWorks,
+                                   std::vector<WorkingSetID>* out,
+                                   WorkingSetID* stateOut);
+
+    /**
+     * Helper for doWorkBatch() implementations. Calls 'workOne', which must have the signature of
+     * doWork(), until 'maxWorks' units of work have been performed or it returns a state which
+     * ends the batch, recording each unit of work in the common stats.
+     *
+     * Leaf stages typically pass a lambda invoking their own doWork() non-virtually, so that an
+     * entire batch is produced without going through work() for every result.
+     */
+    template <typename WorkOneFn>
+    StageState workBatchWith(size_t maxWorks,
+                             std::vector<WorkingSetID>* out,
+                             WorkingSetID* stateOut,
+                             WorkOneFn&& workOne) {
+        const size_t startSize = out->size();
+        for (size_t works = 0; works < maxWorks; ++works) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            const StageState state = recordWorkResult(workOne(&id));
+            if (StageState::ADVANCED == state) {
+                out->push_back(id);
+            } else if (StageState::NEED_TIME != state) {
+                *stateOut = id;
+                return state;
+            }
+        }
+        return out->size() > startSize ? StageState::ADVANCED : StageState::NEED_TIME;
+    }
+
+    /**
+     * Records a single unit of work which resulted in 'state' in the common stats, and returns
+     * 'state'.
+     */
+    StageState recordWorkResult(StageState state);
+
+    /**
+     * Records a batch of 'numAdvanced' results, followed by 'state' if the batch ended with
+     * anything other than ADVANCED, in the common stats. For use by doWorkBatch() implementations
+     * which pass batches through from their children rather than using workBatchWith().
+     */
+    void recordWorkBatchResults(size_t numAdvanced, StageState state);
+
     /**
      * Saves any stage-specific state required to resume where it was if the underlying data
      * changes.
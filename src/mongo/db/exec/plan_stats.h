@@ -37,6 +37,7 @@
 #include "mongo/db/index/multikey_paths.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/stage_types.h"
+#include "mongo/db/record_id.h"
 #include "mongo/util/container_size_helper.h"
 #include "mongo/util/time_support.h"
 
@@ -243,6 +244,10 @@ struct CollectionScanStats : public SpecificStats {
     // document that does not pass the filter and has a "ts" Timestamp field greater than 'maxTs'.
     // Must only be set on forward oplog scans.
     boost::optional<Timestamp> maxTs;
+
+    // The inclusive bounds of the range of RecordIds scanned, if the scan was restricted to one.
+    boost::optional<RecordId> minRecord;
+    boost::optional<RecordId> maxRecord;
 };
 
 struct CountStats : public SpecificStats {
@@ -424,6 +429,30 @@ struct FetchStats : public SpecificStats {
     size_t docsExamined = 0u;
 };
 
+struct GroupCountScanStats : public SpecificStats {
+    SpecificStats* clone() const final {
+        GroupCountScanStats* specific = new GroupCountScanStats(*this);
+        // BSON objects have to be explicitly copied.
+        specific->keyPattern = keyPattern.getOwned();
+        return specific;
+    }
+
+    uint64_t estimateObjectSizeInBytes() const {
+        return keyPattern.objsize() + indexName.capacity() + sizeof(*this);
+    }
+
+    std::string indexName;
+
+    BSONObj keyPattern;
+
+    int indexVersion = 0;
+
+    size_t keysExamined = 0;
+
+    // The number of groups, and therefore documents, returned by the stage.
+    size_t groupsReturned = 0;
+};
+
 struct IDHackStats : public SpecificStats {
     IDHackStats() : keysExamined(0), docsExamined(0) {}
 
@@ -433,11 +462,13 @@ struct IDHackStats : public SpecificStats {
     }
 
     uint64_t estimateObjectSizeInBytes() const {
-        return indexName.capacity() + sizeof(*this);
+        return indexName.capacity() + keyPattern.objsize() + sizeof(*this);
     }
 
     std::string indexName;
 
+    BSONObj keyPattern;
+
     // Number of entries retrieved from the index while executing the idhack.
     size_t keysExamined;
 
@@ -567,6 +598,9 @@ struct MultiPlanStats : public SpecificStats {
     uint64_t estimateObjectSizeInBytes() const {
         return sizeof(*this);
     }
+
+    // The time spent running the trial period of the candidate plans and ranking them.
+    long long planningTimeMicros = 0;
 };
 
 struct OrStats : public SpecificStats {
@@ -631,6 +665,10 @@ struct SortStats : public SpecificStats {
 
     // Whether we spilled data to disk during the execution of this query.
     bool wasDiskUsed = false;
+
+    // The number of leading sort pattern components by which the input was already sorted. If
+    // non-zero, each run of input with equal values for those components was sorted separately.
+    size_t sortPrefixLength = 0u;
 };
 
 struct MergeSortStats : public SpecificStats {
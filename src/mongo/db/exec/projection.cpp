@@ -179,6 +179,34 @@ PlanStage::StageState ProjectionStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState ProjectionStage::doWorkBatch(size_t maxWorks,
+                                                   std::vector<WorkingSetID>* out,
+                                                   WorkingSetID* stateOut) {
+    const size_t startSize = out->size();
+    const StageState status = child()->workBatch(maxWorks, out, stateOut);
+
+    for (size_t i = startSize; i < out->size(); ++i) {
+        Status projStatus = transform(_ws.get((*out)[i]));
+        if (!projStatus.isOK()) {
+            warning() << "Couldn't execute projection, status = " << redact(projStatus);
+
+            // Results before the one which failed have already been projected and are still
+            // returned. Everything from the failed result onwards is discarded.
+            for (size_t j = i; j < out->size(); ++j) {
+                _ws.free((*out)[j]);
+            }
+            out->resize(i);
+
+            recordWorkBatchResults(i - startSize, PlanStage::FAILURE);
+            *stateOut = WorkingSetCommon::allocateStatusMember(&_ws, projStatus);
+            return PlanStage::FAILURE;
+        }
+    }
+
+    recordWorkBatchResults(out->size() - startSize, status);
+    return status;
+}
+
 std::unique_ptr<PlanStageStats> ProjectionStage::getStats() {
     _commonStats.isEOF = isEOF();
     auto ret = std::make_unique<PlanStageStats>(_commonStats, stageType());
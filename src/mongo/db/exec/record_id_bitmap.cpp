@@ -0,0 +1,210 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+
+#include <algorithm>
+#include <bitset>
+#include <iterator>
+
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+
+bool RecordIdBitmap::Container::add(uint16_t low) {
+    if (isBitset()) {
+        uint64_t& word = _bitset[low / 64];
+        const uint64_t bit = uint64_t{1} << (low % 64);
+        if (word & bit) {
+            return false;
+        }
+        word |= bit;
+        ++_size;
+        return true;
+    }
+
+    auto it = std::lower_bound(_array.begin(), _array.end(), low);
+    if (it != _array.end() && *it == low) {
+        return false;
+    }
+    _array.insert(it, low);
+    ++_size;
+
+    if (_array.size() > kMaxArraySize) {
+        convertToBitset();
+    }
+    return true;
+}
+
+bool RecordIdBitmap::Container::contains(uint16_t low) const {
+    if (isBitset()) {
+        return _bitset[low / 64] & (uint64_t{1} << (low % 64));
+    }
+    return std::binary_search(_array.begin(), _array.end(), low);
+}
+
+void RecordIdBitmap::Container::convertToBitset() {
+    _bitset.assign(kBitsetWords, 0);
+    for (auto low : _array) {
+        _bitset[low / 64] |= uint64_t{1} << (low % 64);
+    }
+    std::vector<uint16_t>().swap(_array);
+}
+
+void RecordIdBitmap::Container::intersectWith(const Container& other) {
+    if (isBitset() && other.isBitset()) {
+        _size = 0;
+        for (size_t i = 0; i < kBitsetWords; ++i) {
+            _bitset[i] &= other._bitset[i];
+            _size += std::bitset<64>(_bitset[i]).count();
+        }
+
+        // A sparse result is smaller as an array.
+        if (_size <= kMaxArraySize) {
+            std::vector<uint16_t> array;
+            array.reserve(_size);
+            for (size_t i = 0; i < kBitsetWords; ++i) {
+                for (uint64_t word = _bitset[i]; word; word &= word - 1) {
+                    array.push_back(static_cast<uint16_t>(i * 64 + countTrailingZeros64(word)));
+                }
+            }
+            _array = std::move(array);
+            std::vector<uint64_t>().swap(_bitset);
+        }
+        return;
+    }
+
+    // At least one side is an array, so the result is no larger than that array.
+    const std::vector<uint16_t>& candidates = isBitset() ? other._array : _array;
+    const Container& filter = isBitset() ? *this : other;
+    std::vector<uint16_t> array;
+    array.reserve(std::min(candidates.size(), filter.size()));
+    std::copy_if(candidates.begin(),
+                 candidates.end(),
+                 std::back_inserter(array),
+                 [&](uint16_t low) { return filter.contains(low); });
+
+    _array = std::move(array);
+    std::vector<uint64_t>().swap(_bitset);
+    _size = _array.size();
+}
+
+void RecordIdBitmap::Container::unionWith(const Container& other) {
+    if (!isBitset() && !other.isBitset()) {
+        std::vector<uint16_t> array;
+        array.reserve(_array.size() + other._array.size());
+        std::set_union(_array.begin(),
+                       _array.end(),
+                       other._array.begin(),
+                       other._array.end(),
+                       std::back_inserter(array));
+        _array = std::move(array);
+        _size = _array.size();
+        if (_array.size() > kMaxArraySize) {
+            convertToBitset();
+        }
+        return;
+    }
+
+    if (!isBitset()) {
+        convertToBitset();
+    }
+
+    if (other.isBitset()) {
+        _size = 0;
+        for (size_t i = 0; i < kBitsetWords; ++i) {
+            _bitset[i] |= other._bitset[i];
+            _size += std::bitset<64>(_bitset[i]).count();
+        }
+    } else {
+        for (auto low : other._array) {
+            add(low);
+        }
+    }
+}
+
+bool RecordIdBitmap::add(const RecordId& id) {
+    if (!_containers[highBits(id)].add(lowBits(id))) {
+        return false;
+    }
+    ++_size;
+    return true;
+}
+
+bool RecordIdBitmap::contains(const RecordId& id) const {
+    auto it = _containers.find(highBits(id));
+    return it != _containers.end() && it->second.contains(lowBits(id));
+}
+
+void RecordIdBitmap::intersectWith(const RecordIdBitmap& other) {
+    _size = 0;
+    for (auto it = _containers.begin(); it != _containers.end();) {
+        auto otherIt = other._containers.find(it->first);
+        if (otherIt == other._containers.end()) {
+            _containers.erase(it++);
+            continue;
+        }
+
+        it->second.intersectWith(otherIt->second);
+        if (it->second.size() == 0) {
+            _containers.erase(it++);
+            continue;
+        }
+        _size += it->second.size();
+        ++it;
+    }
+}
+
+void RecordIdBitmap::unionWith(const RecordIdBitmap& other) {
+    _size = 0;
+    for (auto&& highAndContainer : other._containers) {
+        _containers[highAndContainer.first].unionWith(highAndContainer.second);
+    }
+    for (auto&& highAndContainer : _containers) {
+        _size += highAndContainer.second.size();
+    }
+}
+
+void RecordIdBitmap::clear() {
+    _containers.clear();
+    _size = 0;
+}
+
+size_t RecordIdBitmap::getMemUsage() const {
+    size_t memUsage = sizeof(*this);
+    for (auto&& highAndContainer : _containers) {
+        memUsage += sizeof(highAndContainer.first) + highAndContainer.second.getMemUsage();
+    }
+    return memUsage;
+}
+
+}  // namespace mongo
@@ -0,0 +1,141 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+/**
+ * A compressed set of RecordIds, in the style of a roaring bitmap. The 64-bit record id space is
+ * split into chunks of 2^16 consecutive ids. Each chunk holding at least one id has a container of
+ * the low 16 bits of its ids: a sorted array while the chunk is sparse, and a fixed-size bitset
+ * once the array would take more space than the bitset.
+ *
+ * Record ids handed out by storage engines for a collection are dense, so a set of ids produced by
+ * an index scan costs a few bits per id, rather than the node allocations of a hash set.
+ */
+class RecordIdBitmap {
+public:
+    /**
+     * Adds 'id' to the set. Returns false if the set already contained it.
+     */
+    bool add(const RecordId& id);
+
+    bool contains(const RecordId& id) const;
+
+    /**
+     * Removes every id which is not also in 'other'.
+     */
+    void intersectWith(const RecordIdBitmap& other);
+
+    /**
+     * Adds every id in 'other'.
+     */
+    void unionWith(const RecordIdBitmap& other);
+
+    /**
+     * Returns the number of ids in the set.
+     */
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    void clear();
+
+    /**
+     * Returns the approximate number of bytes used by the set.
+     */
+    size_t getMemUsage() const;
+
+private:
+    /**
+     * The low 16 bits of the ids of one chunk.
+     */
+    class Container {
+    public:
+        // Once an array container would hold more values than this, a bitset is smaller.
+        static constexpr size_t kMaxArraySize = 4096;
+        static constexpr size_t kBitsetWords = (1 << 16) / 64;
+
+        bool add(uint16_t low);
+        bool contains(uint16_t low) const;
+
+        void intersectWith(const Container& other);
+        void unionWith(const Container& other);
+
+        size_t size() const {
+            return _size;
+        }
+
+        size_t getMemUsage() const {
+            return _array.capacity() * sizeof(uint16_t) + _bitset.capacity() * sizeof(uint64_t) +
+                sizeof(*this);
+        }
+
+    private:
+        bool isBitset() const {
+            return !_bitset.empty();
+        }
+
+        void convertToBitset();
+
+        // Sorted, without duplicates. Only used while the container is not a bitset.
+        std::vector<uint16_t> _array;
+
+        // Either empty or 'kBitsetWords' words long.
+        std::vector<uint64_t> _bitset;
+
+        size_t _size = 0;
+    };
+
+    static uint64_t highBits(const RecordId& id) {
+        return static_cast<uint64_t>(id.repr()) >> 16;
+    }
+
+    static uint16_t lowBits(const RecordId& id) {
+        return static_cast<uint16_t>(static_cast<uint64_t>(id.repr()) & 0xFFFF);
+    }
+
+    stdx::unordered_map<uint64_t, Container> _containers;
+
+    size_t _size = 0;
+};
+
+}  // namespace mongo
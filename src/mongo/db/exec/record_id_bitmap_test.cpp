@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+
+#include <set>
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(RecordIdBitmapTest, AddAndContains) {
+    RecordIdBitmap bitmap;
+    ASSERT_TRUE(bitmap.empty());
+
+    ASSERT_TRUE(bitmap.add(RecordId(1)));
+    ASSERT_TRUE(bitmap.add(RecordId(70000)));
+    ASSERT_TRUE(bitmap.add(RecordId(65535)));
+    ASSERT_FALSE(bitmap.add(RecordId(1)));
+
+    ASSERT_EQ(bitmap.size(), 3U);
+    ASSERT_TRUE(bitmap.contains(RecordId(1)));
+    ASSERT_TRUE(bitmap.contains(RecordId(65535)));
+    ASSERT_TRUE(bitmap.contains(RecordId(70000)));
+    ASSERT_FALSE(bitmap.contains(RecordId(2)));
+    ASSERT_FALSE(bitmap.contains(RecordId(65536)));
+
+    bitmap.clear();
+    ASSERT_TRUE(bitmap.empty());
+    ASSERT_FALSE(bitmap.contains(RecordId(1)));
+}
+
+TEST(RecordIdBitmapTest, DenseChunkIsSmallerThanSparseIds) {
+    RecordIdBitmap dense;
+    RecordIdBitmap sparse;
+    for (int64_t i = 1; i <= 20000; ++i) {
+        dense.add(RecordId(i));
+        sparse.add(RecordId(i << 16));
+    }
+
+    ASSERT_EQ(dense.size(), 20000U);
+    ASSERT_EQ(sparse.size(), 20000U);
+    for (int64_t i = 1; i <= 20000; ++i) {
+        ASSERT_TRUE(dense.contains(RecordId(i)));
+        ASSERT_TRUE(sparse.contains(RecordId(i << 16)));
+    }
+    ASSERT_FALSE(dense.contains(RecordId(20001)));
+
+    // A chunk holding 20000 ids is a single 8KB bitset.
+    ASSERT_LT(dense.getMemUsage(), 10000U);
+    ASSERT_LT(dense.getMemUsage(), sparse.getMemUsage());
+}
+
+TEST(RecordIdBitmapTest, IntersectAndUnionMatchSetOperations) {
+    // Mix array and bitset containers across a few chunks.
+    RecordIdBitmap multiplesOfTwo;
+    RecordIdBitmap multiplesOfThree;
+    std::set<int64_t> expectedIntersection;
+    std::set<int64_t> expectedUnion;
+    for (int64_t i = 1; i < 200000; ++i) {
+        if (i % 2 == 0) {
+            multiplesOfTwo.add(RecordId(i));
+            expectedUnion.insert(i);
+        }
+        if (i % 3 == 0 && i < 150000) {
+            multiplesOfThree.add(RecordId(i));
+            expectedUnion.insert(i);
+        }
+        if (i % 6 == 0 && i < 150000) {
+            expectedIntersection.insert(i);
+        }
+    }
+    for (int64_t i = 1; i < 100; ++i) {
+        multiplesOfThree.add(RecordId(1000000 + i));
+        expectedUnion.insert(1000000 + i);
+    }
+
+    RecordIdBitmap intersection = multiplesOfTwo;
+    intersection.intersectWith(multiplesOfThree);
+    ASSERT_EQ(intersection.size(), expectedIntersection.size());
+    for (int64_t i = 1; i < 1000100; i += (i < 200000 ? 1 : 1000)) {
+        ASSERT_EQ(intersection.contains(RecordId(i)), expectedIntersection.count(i) > 0);
+    }
+
+    RecordIdBitmap unionBitmap = multiplesOfTwo;
+    unionBitmap.unionWith(multiplesOfThree);
+    ASSERT_EQ(unionBitmap.size(), expectedUnion.size());
+    for (int64_t i = 1; i < 200000; ++i) {
+        ASSERT_EQ(unionBitmap.contains(RecordId(i)), expectedUnion.count(i) > 0);
+    }
+    ASSERT_TRUE(unionBitmap.contains(RecordId(1000050)));
+
+    // Intersecting with a disjoint set empties the bitmap.
+    RecordIdBitmap other;
+    other.add(RecordId(5000000));
+    intersection.intersectWith(other);
+    ASSERT_TRUE(intersection.empty());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -29,6 +29,7 @@
 
 #include "mongo/db/exec/skip.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/exec/scoped_timer.h"
@@ -86,6 +87,31 @@ PlanStage::StageState SkipStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState SkipStage::doWorkBatch(size_t maxWorks,
+                                             std::vector<WorkingSetID>* out,
+                                             WorkingSetID* stateOut) {
+    const size_t startSize = out->size();
+    StageState status = child()->workBatch(maxWorks, out, stateOut);
+
+    // Drop the results we're still skipping from the front of the batch.
+    const size_t numToDrop =
+        std::min(out->size() - startSize, static_cast<size_t>(std::max(_toSkip, 0LL)));
+    const auto dropBegin = out->begin() + startSize;
+    const auto dropEnd = dropBegin + numToDrop;
+    for (auto it = dropBegin; it != dropEnd; ++it) {
+        _ws->free(*it);
+    }
+    out->erase(dropBegin, dropEnd);
+    _toSkip -= numToDrop;
+
+    if (PlanStage::ADVANCED == status && out->size() == startSize) {
+        status = PlanStage::NEED_TIME;
+    }
+
+    recordWorkBatchResults(out->size() - startSize, status);
+    return status;
+}
+
 unique_ptr<PlanStageStats> SkipStage::getStats() {
     _commonStats.isEOF = isEOF();
     _specificStats.skip = _toSkip;
@@ -30,6 +30,8 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/exec/sort.h"
+
+#include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/exec/working_set_common.h"
 
 namespace mongo {
@@ -39,14 +41,18 @@ SortStage::SortStage(boost::intrusive_ptr<ExpressionContext> expCtx,
                      SortPattern sortPattern,
                      uint64_t limit,
                      uint64_t maxMemoryUsageBytes,
-                     std::unique_ptr<PlanStage> child)
+                     std::unique_ptr<PlanStage> child,
+                     size_t sortPrefixLength)
     : PlanStage(kStageType.rawData(), expCtx->opCtx),
       _ws(ws),
       _sortExecutor(std::move(sortPattern),
                     limit,
                     maxMemoryUsageBytes,
                     expCtx->tempDir,
-                    expCtx->allowDiskUse) {
+                    expCtx->allowDiskUse),
+      _sortPrefixLength(sortPrefixLength),
+      _limit(limit) {
+    invariant(_sortPrefixLength < _sortExecutor.sortPattern().size());
     _children.emplace_back(std::move(child));
 }
 
@@ -55,6 +61,10 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_sortPrefixLength > 0) {
+        return doWorkPartialSort(out);
+    }
+
     if (!_populated) {
         WorkingSetID id = WorkingSet::INVALID_ID;
         const StageState code = child()->work(&id);
@@ -107,11 +117,117 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
     return PlanStage::ADVANCED;
 }
 
+PlanStage::StageState SortStage::doWorkPartialSort(WorkingSetID* out) {
+    if (_returningRun) {
+        if (auto nextWsm = _sortExecutor.getNextWsm()) {
+            ++_numReturned;
+            *out = _ws->emplace(std::move(*nextWsm));
+            return PlanStage::ADVANCED;
+        }
+
+        // The current run has been returned in full. We are done if either the child or the limit
+        // is exhausted; otherwise begin the next run with the member that ended the previous one.
+        _returningRun = false;
+        if (_populated || (_limit > 0 && _numReturned >= _limit)) {
+            _partialSortEOF = true;
+            return PlanStage::IS_EOF;
+        }
+
+        invariant(_nextRunFirstMember);
+        _sortExecutor.startNextBatch(_limit > 0 ? _limit - _numReturned : 0);
+        _currentRunSortKey = _nextRunFirstMember->first;
+        auto nextRunFirstMember = std::move(*_nextRunFirstMember);
+        _nextRunFirstMember = boost::none;
+
+        try {
+            _sortExecutor.add(std::move(nextRunFirstMember.first),
+                              std::move(nextRunFirstMember.second));
+        } catch (const AssertionException&) {
+            // Propagate runtime errors using the FAILED status code.
+            *out = WorkingSetCommon::allocateStatusMember(_ws, exceptionToStatus());
+            return PlanStage::FAILURE;
+        }
+
+        return PlanStage::NEED_TIME;
+    }
+
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    const StageState code = child()->work(&id);
+
+    if (code == PlanStage::ADVANCED) {
+        auto member = _ws->get(id);
+        invariant(member->metadata().hasSortKey());
+
+        auto&& extractedMember = _ws->extract(id);
+        auto sortKey = extractedMember.metadata().getSortKey();
+
+        try {
+            if (_currentRunSortKey && !isInCurrentRun(sortKey)) {
+                // This member starts a new run, so the current run is complete. Hold on to the
+                // member until the current run has been sorted and returned.
+                _nextRunFirstMember.emplace(std::move(sortKey), std::move(extractedMember));
+                _sortExecutor.loadingDone();
+                _returningRun = true;
+                return PlanStage::NEED_TIME;
+            }
+
+            if (!_currentRunSortKey) {
+                _currentRunSortKey = sortKey;
+            }
+            _sortExecutor.add(std::move(sortKey), std::move(extractedMember));
+        } catch (const AssertionException&) {
+            // Propagate runtime errors using the FAILED status code.
+            *out = WorkingSetCommon::allocateStatusMember(_ws, exceptionToStatus());
+            return PlanStage::FAILURE;
+        }
+
+        return PlanStage::NEED_TIME;
+    } else if (code == PlanStage::IS_EOF) {
+        // The child has returned all of its results, so the run currently being buffered is the
+        // last one.
+        _populated = true;
+
+        try {
+            _sortExecutor.loadingDone();
+        } catch (const AssertionException&) {
+            // Propagate runtime errors using the FAILED status code.
+            *out = WorkingSetCommon::allocateStatusMember(_ws, exceptionToStatus());
+            return PlanStage::FAILURE;
+        }
+
+        _returningRun = true;
+        return PlanStage::NEED_TIME;
+    } else {
+        *out = id;
+    }
+
+    return code;
+}
+
+bool SortStage::isInCurrentRun(const Value& sortKey) const {
+    // The sort pattern has more components than the sorted prefix, so every sort key is an array
+    // with one element per sort pattern component. The keys already reflect any collation, so
+    // the prefixes can be compared with the simple comparator.
+    invariant(sortKey.isArray());
+    invariant(_currentRunSortKey && _currentRunSortKey->isArray());
+
+    const auto& key = sortKey.getArray();
+    const auto& currentRunKey = _currentRunSortKey->getArray();
+    for (size_t i = 0; i < _sortPrefixLength; ++i) {
+        if (ValueComparator::kInstance.evaluate(key[i] != currentRunKey[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 std::unique_ptr<PlanStageStats> SortStage::getStats() {
     _commonStats.isEOF = isEOF();
     std::unique_ptr<PlanStageStats> ret =
         std::make_unique<PlanStageStats>(_commonStats, STAGE_SORT);
-    ret->specific = _sortExecutor.cloneStats();
+    auto sortStats = _sortExecutor.cloneStats();
+    sortStats->sortPrefixLength = _sortPrefixLength;
+    ret->specific = std::move(sortStats);
     ret->children.emplace_back(child()->getStats());
     return ret;
 }
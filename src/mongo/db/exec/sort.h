@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <set>
 #include <vector>
 
@@ -48,6 +49,11 @@ namespace mongo {
  *   -- For each field in 'pattern', all inputs in the child must handle a getFieldDotted for that
  *   field.
  *   -- All WSMs produced by the child stage must have the sort key available as WSM computed data.
+ *
+ * If 'sortPrefixLength' is non-zero, the child must already produce its results in the order of
+ * the first 'sortPrefixLength' components of the sort pattern. In that case this stage performs a
+ * partial sort: it buffers and sorts only one run of results with equal sort key prefixes at a
+ * time, streaming each run out before reading the next one.
  */
 class SortStage final : public PlanStage {
 public:
@@ -58,10 +64,11 @@ public:
               SortPattern sortPattern,
               uint64_t limit,
               uint64_t maxMemoryUsageBytes,
-              std::unique_ptr<PlanStage> child);
+              std::unique_ptr<PlanStage> child,
+              size_t sortPrefixLength = 0);
 
     bool isEOF() final {
-        return _sortExecutor.isEOF();
+        return _sortPrefixLength ? _partialSortEOF : _sortExecutor.isEOF();
     }
 
     StageState doWork(WorkingSetID* out) final;
@@ -77,6 +84,18 @@ public:
     }
 
 private:
+    /**
+     * Implements doWork() for a partial sort, where the child's output is already sorted by the
+     * first '_sortPrefixLength' components of the sort pattern.
+     */
+    StageState doWorkPartialSort(WorkingSetID* out);
+
+    /**
+     * Returns true if the first '_sortPrefixLength' components of 'sortKey' are equal to those of
+     * the run currently being buffered.
+     */
+    bool isInCurrentRun(const Value& sortKey) const;
+
     // Not owned by us.
     WorkingSet* _ws;
 
@@ -84,6 +103,25 @@ private:
 
     // Whether or not we have finished loading data into '_sortExecutor'.
     bool _populated = false;
+
+    // The number of leading sort pattern components by which the child's output is already
+    // sorted, or zero if this stage performs a full blocking sort.
+    const size_t _sortPrefixLength;
+
+    // The remaining state is used only for a partial sort.
+    const uint64_t _limit;
+    uint64_t _numReturned = 0;
+
+    // Whether the current run has been loaded into '_sortExecutor' and is being returned.
+    bool _returningRun = false;
+
+    bool _partialSortEOF = false;
+
+    // The sort key of the first member of the run currently being buffered.
+    boost::optional<Value> _currentRunSortKey;
+
+    // The first member of the next run, read from the child before the current run was returned.
+    boost::optional<std::pair<Value, WorkingSetMember>> _nextRunFirstMember;
 };
 
 }  // namespace mongo
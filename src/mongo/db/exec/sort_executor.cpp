@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/exec/sort_executor.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 namespace {
@@ -47,6 +48,24 @@ std::string nextFileName() {
     static AtomicWord<unsigned> sortExecutorFileCounter;
     return "extsort-sort-executor." + std::to_string(sortExecutorFileCounter.fetchAndAdd(1));
 }
+
+/**
+ * Returns the Ordering with which to encode sort keys as KeyStrings, or boost::none if sort keys
+ * should be compared as Values. Patterns with more components than an Ordering can describe always
+ * use Value comparison.
+ */
+boost::optional<Ordering> makeKeyStringOrdering(const SortPattern& sortPattern) {
+    if (!internalQuerySortUseKeyStringSortKeys.load() ||
+        sortPattern.size() > Ordering::kMaxCompoundIndexKeys) {
+        return boost::none;
+    }
+
+    BSONObjBuilder orderingBob;
+    for (auto&& part : sortPattern) {
+        orderingBob.append("", part.isAscending ? 1 : -1);
+    }
+    return Ordering::make(orderingBob.obj());
+}
 }  // namespace
 
 SortExecutor::SortExecutor(SortPattern sortPattern,
@@ -56,7 +75,8 @@ SortExecutor::SortExecutor(SortPattern sortPattern,
                            bool allowDiskUse)
     : _sortPattern(std::move(sortPattern)),
       _tempDir(std::move(tempDir)),
-      _diskUseAllowed(allowDiskUse) {
+      _diskUseAllowed(allowDiskUse),
+      _keyStringOrdering(makeKeyStringOrdering(_sortPattern)) {
     _stats.sortPattern =
         _sortPattern.serialize(SortPattern::SortKeySerialization::kForExplain).toBson();
     _stats.limit = limit;
@@ -86,6 +106,16 @@ boost::optional<WorkingSetMember> SortExecutor::getNextWsm() {
         return boost::none;
     }
 
+    if (_keyStringOrdering) {
+        if (!_keyStringOutput->more()) {
+            _keyStringOutput.reset();
+            _isEOF = true;
+            return boost::none;
+        }
+
+        return _keyStringOutput->next().second;
+    }
+
     if (!_output->more()) {
         _output.reset();
         _isEOF = true;
@@ -112,6 +142,16 @@ void SortExecutor::add(Value sortKey, WorkingSetMember data) {
     // Metadata should be attached directly to the WSM rather than inside the Document.
     invariant(!data.doc.value().metadata());
 
+    if (_keyStringOrdering) {
+        if (!_keyStringSorter) {
+            _keyStringSorter.reset(makeKeyStringSorter());
+        }
+        _keyStringSorter->add(encodeSortKey(sortKey), std::move(data));
+
+        _stats.totalDataSizeBytes += data.getMemUsage();
+        return;
+    }
+
     if (!_sorter) {
         _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
     }
@@ -121,6 +161,17 @@ void SortExecutor::add(Value sortKey, WorkingSetMember data) {
 }
 
 void SortExecutor::loadingDone() {
+    if (_keyStringOrdering) {
+        // This conditional should only pass if no documents were added to the sorter.
+        if (!_keyStringSorter) {
+            _keyStringSorter.reset(makeKeyStringSorter());
+        }
+        _keyStringOutput.reset(_keyStringSorter->done());
+        _stats.wasDiskUsed = _stats.wasDiskUsed || _keyStringSorter->usedDisk();
+        _keyStringSorter.reset();
+        return;
+    }
+
     // This conditional should only pass if no documents were added to the sorter.
     if (!_sorter) {
         _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
@@ -130,9 +181,18 @@ void SortExecutor::loadingDone() {
     _sorter.reset();
 }
 
+void SortExecutor::startNextBatch(uint64_t limit) {
+    invariant(_isEOF);
+    invariant(!_sorter && !_keyStringSorter);
+    _isEOF = false;
+    _batchLimit = limit;
+}
+
 SortOptions SortExecutor::makeSortOptions() const {
     SortOptions opts;
-    if (_stats.limit) {
+    if (_batchLimit) {
+        opts.limit = _batchLimit;
+    } else if (_stats.limit) {
         opts.limit = _stats.limit;
     }
 
@@ -145,6 +205,37 @@ SortOptions SortExecutor::makeSortOptions() const {
     return opts;
 }
 
+SortExecutor::KeyStringDocumentSorter* SortExecutor::makeKeyStringSorter() const {
+    return KeyStringDocumentSorter::make(
+        makeSortOptions(),
+        KeyStringComparator(),
+        {KeyString::Value::SorterDeserializeSettings(KeyString::Version::kLatestVersion), {}});
+}
+
+KeyString::Value SortExecutor::encodeSortKey(const Value& sortKey) const {
+    // Sort keys for patterns with multiple components are arrays with one element per component.
+    // A missing component sorts as null, and must still occupy its position in the KeyString.
+    BSONObjBuilder keyBob;
+    auto appendKeyPart = [&keyBob](const Value& keyPart) {
+        if (keyPart.missing()) {
+            keyBob.appendNull("");
+        } else {
+            keyPart.addToBsonObj(&keyBob, ""_sd);
+        }
+    };
+    if (_sortPattern.isSingleElementKey()) {
+        appendKeyPart(sortKey);
+    } else {
+        for (auto&& keyPart : sortKey.getArray()) {
+            appendKeyPart(keyPart);
+        }
+    }
+
+    KeyString::Builder builder(
+        KeyString::Version::kLatestVersion, keyBob.obj(), *_keyStringOrdering);
+    return builder.getValueCopy();
+}
+
 std::unique_ptr<SortStats> SortExecutor::cloneStats() const {
     return std::unique_ptr<SortStats>{static_cast<SortStats*>(_stats.clone())};
 }
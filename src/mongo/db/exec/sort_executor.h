@@ -36,6 +36,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
+#include "mongo/db/storage/key_string.h"
 
 namespace mongo {
 /**
@@ -43,6 +44,10 @@ namespace mongo {
  * caller should provide input documents by repeated calls to the add() function, and then
  * complete the loading process with a single call to loadingDone(). Finally, getNext() should be
  * called to return the documents one by one in sorted order.
+ *
+ * If 'internalQuerySortUseKeyStringSortKeys' is set when the executor is constructed, each sort
+ * key is encoded as a KeyString as it is added, so that the sort compares keys with memcmp rather
+ * than by comparing Values.
  */
 class SortExecutor {
 public:
@@ -89,6 +94,14 @@ public:
      */
     void loadingDone();
 
+    /**
+     * Re-arms an executor whose output has been exhausted so that it accepts another batch of
+     * input. Used by a partial sort, which sorts each run of documents sharing a sort key prefix
+     * separately. If 'limit' is non-zero, at most that many documents are returned from the next
+     * batch. Stats accumulate across batches.
+     */
+    void startNextBatch(uint64_t limit);
+
     /**
      * Add a Document with sort key specified by Value to the DocumentSorter.
      */
@@ -126,8 +139,25 @@ private:
         SortKeyComparator _sortKeyComparator;
     };
 
+    using KeyStringDocumentSorter = Sorter<KeyString::Value, WorkingSetMember>;
+    class KeyStringComparator {
+    public:
+        int operator()(const KeyStringDocumentSorter::Data& lhs,
+                       const KeyStringDocumentSorter::Data& rhs) const {
+            return lhs.first.compare(rhs.first);
+        }
+    };
+
     SortOptions makeSortOptions() const;
 
+    KeyStringDocumentSorter* makeKeyStringSorter() const;
+
+    /**
+     * Encodes 'sortKey' as a KeyString whose binary order is the order of the sort pattern. The
+     * sort key must already reflect any collation.
+     */
+    KeyString::Value encodeSortKey(const Value& sortKey) const;
+
     const SortPattern _sortPattern;
     const std::string _tempDir;
     const bool _diskUseAllowed;
@@ -135,8 +165,17 @@ private:
     std::unique_ptr<DocumentSorter> _sorter;
     std::unique_ptr<DocumentSorter::Iterator> _output;
 
+    // Set if sort keys are encoded as KeyStrings, in which case '_keyStringSorter' and
+    // '_keyStringOutput' are used in place of '_sorter' and '_output'.
+    const boost::optional<Ordering> _keyStringOrdering;
+    std::unique_ptr<KeyStringDocumentSorter> _keyStringSorter;
+    std::unique_ptr<KeyStringDocumentSorter::Iterator> _keyStringOutput;
+
     SortStats _stats;
 
+    // If non-zero, overrides the limit in '_stats' for the current batch of a partial sort.
+    uint64_t _batchLimit = 0;
+
     bool _isEOF = false;
 };
 }  // namespace mongo
@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/sort_executor.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/platform/random.h"
+
+namespace mongo {
+namespace {
+
+const uint64_t kMaxMemoryUsageBytes = 100 * 1024 * 1024;
+
+/**
+ * Builds documents with a string field 'a' and an integer field 'b' in a pseudo-random order,
+ * each paired with its sort key for the pattern {a: 1, b: -1}.
+ */
+std::vector<std::pair<Value, Document>> makeInput(int numDocuments) {
+    PseudoRandom random(1);
+    std::vector<std::pair<Value, Document>> input;
+    input.reserve(numDocuments);
+    for (int i = 0; i < numDocuments; ++i) {
+        Value a("customer-" + std::to_string(random.nextInt32(numDocuments / 10 + 1)));
+        Value b(random.nextInt32(1000));
+        input.emplace_back(Value(std::vector<Value>{a, b}), Document{{"a", a}, {"b", b}});
+    }
+    return input;
+}
+
+/**
+ * Sorts the input with a SortExecutor, optionally with a limit, comparing sort keys either as
+ * Values or as KeyStrings.
+ */
+void runSort(benchmark::State& state, bool useKeyStringSortKeys) {
+    const bool originalUseKeyStringSortKeys = internalQuerySortUseKeyStringSortKeys.load();
+    internalQuerySortUseKeyStringSortKeys.store(useKeyStringSortKeys);
+
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    const SortPattern sortPattern{BSON("a" << 1 << "b" << -1), expCtx};
+    const auto input = makeInput(state.range(0));
+    const uint64_t limit = state.range(1);
+
+    for (auto _ : state) {
+        SortExecutor executor(sortPattern, limit, kMaxMemoryUsageBytes, "", false);
+        for (auto&& [sortKey, doc] : input) {
+            executor.add(sortKey, doc);
+        }
+        executor.loadingDone();
+        while (auto doc = executor.getNextDoc()) {
+            benchmark::DoNotOptimize(doc);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+
+    internalQuerySortUseKeyStringSortKeys.store(originalUseKeyStringSortKeys);
+}
+
+void BM_sortWithValueSortKeys(benchmark::State& state) {
+    runSort(state, false);
+}
+
+void BM_sortWithKeyStringSortKeys(benchmark::State& state) {
+    runSort(state, true);
+}
+
+}  // namespace
+
+BENCHMARK(BM_sortWithValueSortKeys)->Args({1000, 0})->Args({100000, 0})->Args({100000, 100});
+BENCHMARK(BM_sortWithKeyStringSortKeys)->Args({1000, 0})->Args({100000, 0})->Args({100000, 100});
+
+}  // namespace mongo
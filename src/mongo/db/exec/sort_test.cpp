@@ -41,9 +41,11 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/collation/collator_factory_mock.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/scopeguard.h"
 
 using namespace mongo;
 
@@ -72,12 +74,16 @@ public:
      *
      * 'expectedStr; represents the expected sorted data set.
      *     {output: [docA, docB, docC, ...]}
+     *
+     * If 'sortPrefixLength' is non-zero, the input must already be sorted by that many leading
+     * components of the sort pattern, and the stage performs a partial sort.
      */
     void testWork(const char* patternStr,
                   CollatorInterface* collator,
                   int limit,
                   const char* inputStr,
-                  const char* expectedStr) {
+                  const char* expectedStr,
+                  size_t sortPrefixLength = 0) {
         // WorkingSet is not owned by stages
         // so it's fine to declare
         WorkingSet ws;
@@ -114,7 +120,8 @@ public:
                        SortPattern{sortPattern, expCtx},
                        limit,
                        kMaxMemoryUsageBytes,
-                       std::move(sortKeyGen));
+                       std::move(sortKeyGen),
+                       sortPrefixLength);
 
         WorkingSetID id = WorkingSet::INVALID_ID;
         PlanStage::StageState state = PlanStage::NEED_TIME;
@@ -124,18 +131,24 @@ public:
             state = sort.work(&id);
         }
 
-        // QueuedDataStage's state should be EOF when sort is ready to advance.
-        ASSERT_TRUE(sort.child()->child()->isEOF());
+        // QueuedDataStage's state should be EOF when a full sort is ready to advance. A partial
+        // sort advances as soon as its first run has been read.
+        if (sortPrefixLength == 0) {
+            ASSERT_TRUE(sort.child()->child()->isEOF());
+        }
 
-        // While there's data to be retrieved, state should be equal to ADVANCED.
+        // While there's data to be retrieved, state should be equal to ADVANCED, or NEED_TIME
+        // between the runs of a partial sort.
         // Insert documents into BSON document in this format:
         //     {output: [docA, docB, docC, ...]}
         BSONObjBuilder bob;
         BSONArrayBuilder arr(bob.subarrayStart("output"));
-        while (state == PlanStage::ADVANCED) {
-            WorkingSetMember* member = ws.get(id);
-            BSONObj obj = member->doc.value().toBson();
-            arr.append(obj);
+        while (state == PlanStage::ADVANCED || state == PlanStage::NEED_TIME) {
+            if (state == PlanStage::ADVANCED) {
+                WorkingSetMember* member = ws.get(id);
+                BSONObj obj = member->doc.value().toBson();
+                arr.append(obj);
+            }
             state = sort.work(&id);
         }
         arr.doneFast();
@@ -301,4 +314,117 @@ TEST_F(SortStageTest, SortDescendingWithCollation) {
              "{input: [{a: 'ba'}, {a: 'aa'}, {a: 'ab'}]}",
              "{output: [{a: 'ab'}, {a: 'ba'}, {a: 'aa'}]}");
 }
+
+//
+// Partial sort
+// The input is already sorted by a prefix of the sort pattern, so each run of documents with equal
+// prefix values is sorted separately.
+//
+
+TEST_F(SortStageTest, PartialSortSortsEachRunOfEqualPrefix) {
+    testWork("{a: 1, b: 1}",
+             nullptr,
+             0,
+             "{input: [{a: 1, b: 3}, {a: 1, b: 1}, {a: 1, b: 2}, {a: 2, b: 2}, {a: 2, b: 1}, "
+             "{a: 3, b: 1}]}",
+             "{output: [{a: 1, b: 1}, {a: 1, b: 2}, {a: 1, b: 3}, {a: 2, b: 1}, {a: 2, b: 2}, "
+             "{a: 3, b: 1}]}",
+             1);
+}
+
+TEST_F(SortStageTest, PartialSortWithDescendingPrefix) {
+    testWork("{a: -1, b: 1}",
+             nullptr,
+             0,
+             "{input: [{a: 2, b: 2}, {a: 2, b: 1}, {a: 1, b: 3}, {a: 1, b: 1}]}",
+             "{output: [{a: 2, b: 1}, {a: 2, b: 2}, {a: 1, b: 1}, {a: 1, b: 3}]}",
+             1);
+}
+
+TEST_F(SortStageTest, PartialSortWithLimitSpanningRuns) {
+    testWork("{a: 1, b: -1}",
+             nullptr,
+             3,
+             "{input: [{a: 1, b: 1}, {a: 1, b: 2}, {a: 2, b: 1}, {a: 2, b: 3}, {a: 2, b: 2}, "
+             "{a: 3, b: 1}]}",
+             "{output: [{a: 1, b: 2}, {a: 1, b: 1}, {a: 2, b: 3}]}",
+             1);
+}
+
+TEST_F(SortStageTest, PartialSortWithCollation) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    testWork("{a: 1, b: 1}",
+             &collator,
+             0,
+             "{input: [{a: 'xa', b: 'ab'}, {a: 'xa', b: 'ba'}, {a: 'ab', b: 'ab'}]}",
+             "{output: [{a: 'xa', b: 'ba'}, {a: 'xa', b: 'ab'}, {a: 'ab', b: 'ab'}]}",
+             1);
+}
+
+//
+// KeyString sort keys
+// With 'internalQuerySortUseKeyStringSortKeys' set, sort keys are encoded as KeyStrings and
+// compared with memcmp. The results must match those of comparing the keys as Values.
+//
+
+class SortStageKeyStringSortKeysTest : public SortStageTest {
+public:
+    SortStageKeyStringSortKeysTest() {
+        internalQuerySortUseKeyStringSortKeys.store(true);
+    }
+
+    ~SortStageKeyStringSortKeysTest() {
+        internalQuerySortUseKeyStringSortKeys.store(_originalUseKeyStringSortKeys);
+    }
+
+private:
+    const bool _originalUseKeyStringSortKeys = internalQuerySortUseKeyStringSortKeys.load();
+};
+
+TEST_F(SortStageKeyStringSortKeysTest, SortCompoundPatternWithMixedDirections) {
+    testWork("{a: 1, b: -1}",
+             nullptr,
+             0,
+             "{input: [{a: 2, b: 1}, {a: 1, b: 1}, {a: 2, b: 3}, {a: 1, b: 2}]}",
+             "{output: [{a: 1, b: 2}, {a: 1, b: 1}, {a: 2, b: 3}, {a: 2, b: 1}]}");
+}
+
+TEST_F(SortStageKeyStringSortKeysTest, SortMixedTypesAndMissingField) {
+    testWork("{a: 1}",
+             nullptr,
+             0,
+             "{input: [{a: 'str'}, {a: 2.5}, {b: 1}, {a: 2}, {a: {x: 1}}, {a: NumberLong(1)}]}",
+             "{output: [{b: 1}, {a: NumberLong(1)}, {a: 2}, {a: 2.5}, {a: 'str'}, {a: {x: 1}}]}");
+}
+
+TEST_F(SortStageKeyStringSortKeysTest, SortDescendingWithLimit) {
+    testWork(
+        "{a: -1}", nullptr, 2, "{input: [{a: 2}, {a: 1}, {a: 3}]}", "{output: [{a: 3}, {a: 2}]}");
+}
+
+TEST_F(SortStageKeyStringSortKeysTest, SortStringsWithCommonPrefixes) {
+    testWork("{a: 1}",
+             nullptr,
+             0,
+             "{input: [{a: 'ab'}, {a: 'b'}, {a: 'a'}, {a: ''}]}",
+             "{output: [{a: ''}, {a: 'a'}, {a: 'ab'}, {a: 'b'}]}");
+}
+
+TEST_F(SortStageKeyStringSortKeysTest, SortWithCollation) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    testWork("{a: 1}",
+             &collator,
+             0,
+             "{input: [{a: 'ba'}, {a: 'aa'}, {a: 'ab'}]}",
+             "{output: [{a: 'aa'}, {a: 'ba'}, {a: 'ab'}]}");
+}
+
+TEST_F(SortStageKeyStringSortKeysTest, PartialSortSortsEachRunOfEqualPrefix) {
+    testWork("{a: 1, b: 1}",
+             nullptr,
+             0,
+             "{input: [{a: 1, b: 3}, {a: 1, b: 1}, {a: 2, b: 2}, {a: 2, b: 1}]}",
+             "{output: [{a: 1, b: 1}, {a: 1, b: 3}, {a: 2, b: 1}, {a: 2, b: 2}]}",
+             1);
+}
 }  // namespace
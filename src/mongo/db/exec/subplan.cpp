@@ -471,6 +471,20 @@ PlanStage::StageState SubplanStage::doWork(WorkingSetID* out) {
     return child()->work(out);
 }
 
+PlanStage::StageState SubplanStage::doWorkBatch(size_t maxWorks,
+                                                std::vector<WorkingSetID>* out,
+                                                WorkingSetID* stateOut) {
+    if (isEOF()) {
+        return recordWorkResult(PlanStage::IS_EOF);
+    }
+
+    invariant(child());
+    const size_t startSize = out->size();
+    const StageState status = child()->workBatch(maxWorks, out, stateOut);
+    recordWorkBatchResults(out->size() - startSize, status);
+    return status;
+}
+
 unique_ptr<PlanStageStats> SubplanStage::getStats() {
     _commonStats.isEOF = isEOF();
     unique_ptr<PlanStageStats> ret = std::make_unique<PlanStageStats>(_commonStats, STAGE_SUBPLAN);
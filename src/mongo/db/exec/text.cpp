@@ -56,6 +56,21 @@ using fts::MAX_WEIGHT;
 
 const char* TextStage::kStageType = "TEXT";
 
+namespace {
+
+/**
+ * Returns true if the TEXT_MATCH stage may reject some of the documents containing the positive
+ * terms of 'query', in which case more than the highest scoring documents must be examined to
+ * produce a given number of results.
+ */
+bool textMatchMayRejectDocuments(const fts::FTSQueryImpl& query) {
+    return query.getCaseSensitive() || query.getDiacriticSensitive() ||
+        !query.getNegatedTerms().empty() || !query.getPositivePhr().empty() ||
+        !query.getNegatedPhr().empty();
+}
+
+}  // namespace
+
 TextStage::TextStage(OperationContext* opCtx,
                      const TextStageParams& params,
                      WorkingSet* ws,
@@ -120,9 +135,11 @@ unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* opCtx,
     std::unique_ptr<PlanStage> textMatchStage;
     if (wantTextScore) {
         // We use a TEXT_OR stage to get the union of the results from the index scans and then
-        // compute their text scores. This is a blocking operation.
+        // compute their text scores. This is a blocking operation. When only the highest scoring
+        // documents are wanted, it need only fetch those.
+        const size_t limit = textMatchMayRejectDocuments(_params.query) ? 0 : _params.limit;
         auto textScorer =
-            std::make_unique<TextOrStage>(opCtx, _params.spec, ws, filter, collection);
+            std::make_unique<TextOrStage>(opCtx, _params.spec, ws, filter, collection, limit);
 
         textScorer->addChildren(std::move(indexScanList));
 
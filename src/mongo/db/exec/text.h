@@ -64,6 +64,10 @@ struct TextStageParams {
     // True if we need the text score in the output, because the projection includes the 'textScore'
     // metadata field.
     bool wantTextScore = true;
+
+    // If non-zero, the results are sorted by text score alone and only the 'limit' highest scoring
+    // documents are needed.
+    size_t limit = 0;
 };
 
 /**
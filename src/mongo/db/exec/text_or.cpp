@@ -29,6 +29,7 @@
 
 #include "mongo/db/exec/text_or.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <vector>
@@ -56,11 +57,13 @@ TextOrStage::TextOrStage(OperationContext* opCtx,
                          const FTSSpec& ftsSpec,
                          WorkingSet* ws,
                          const MatchExpression* filter,
-                         const Collection* collection)
+                         const Collection* collection,
+                         size_t limit)
     : RequiresCollectionStage(kStageType, opCtx, collection),
       _ftsSpec(ftsSpec),
       _ws(ws),
       _scoreIterator(_scores.end()),
+      _limit(limit),
       _filter(filter),
       _idRetrying(WorkingSet::INVALID_ID) {}
 
@@ -193,6 +196,17 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
         }
 
         // If we're here we are done reading results.  Move to the next state.
+        if (_limit) {
+            // Order the candidates by score so that only the ones returned are fetched.
+            _topResults.reserve(_scores.size());
+            for (auto&& scoreEntry : _scores) {
+                if (scoreEntry.second.wsid != WorkingSet::INVALID_ID) {
+                    _topResults.emplace_back(scoreEntry.second.score, scoreEntry.second.wsid);
+                }
+            }
+            std::make_heap(_topResults.begin(), _topResults.end());
+            _scores.clear();
+        }
         _scoreIterator = _scores.begin();
         _internalState = State::kReturningResults;
 
@@ -218,6 +232,10 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
 }
 
 PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
+    if (_limit) {
+        return returnTopResults(out);
+    }
+
     if (_scoreIterator == _scores.end()) {
         _internalState = State::kDone;
         return PlanStage::IS_EOF;
@@ -241,6 +259,46 @@ PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
     return PlanStage::ADVANCED;
 }
 
+PlanStage::StageState TextOrStage::returnTopResults(WorkingSetID* out) {
+    if (_topResults.empty() || _numReturned == _limit) {
+        freeTopResults();
+        _internalState = State::kDone;
+        return PlanStage::IS_EOF;
+    }
+
+    const auto score = _topResults.front().first;
+    const auto wsid = _topResults.front().second;
+    try {
+        if (!WorkingSetCommon::fetch(getOpCtx(), _ws, wsid, _recordCursor)) {
+            // The document was deleted or no longer has the indexed term; try the next candidate.
+            std::pop_heap(_topResults.begin(), _topResults.end());
+            _topResults.pop_back();
+            _ws->free(wsid);
+            return NEED_TIME;
+        }
+        ++_specificStats.fetches;
+    } catch (const WriteConflictException&) {
+        // The candidate stays at the top of the heap, so we retry it after yielding.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    std::pop_heap(_topResults.begin(), _topResults.end());
+    _topResults.pop_back();
+    ++_numReturned;
+
+    _ws->get(wsid)->metadata().setTextScore(score);
+    *out = wsid;
+    return PlanStage::ADVANCED;
+}
+
+void TextOrStage::freeTopResults() {
+    for (auto&& candidate : _topResults) {
+        _ws->free(candidate.second);
+    }
+    _topResults.clear();
+}
+
 PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out) {
     WorkingSetMember* wsm = _ws->get(wsid);
     invariant(wsm->getState() == WorkingSetMember::RID_AND_IDX);
@@ -266,19 +324,22 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         }
 
         // Our parent expects RID_AND_OBJ members, so we fetch the document here if we haven't
-        // already.
-        try {
-            if (!WorkingSetCommon::fetch(getOpCtx(), _ws, wsid, _recordCursor)) {
-                _ws->free(wsid);
-                textRecordData->score = -1;
-                return NEED_TIME;
+        // already. With a limit, only the highest scoring documents are fetched once all the scores
+        // are known, and the key data is kept so that the fetch can check the key still holds.
+        if (!_limit) {
+            try {
+                if (!WorkingSetCommon::fetch(getOpCtx(), _ws, wsid, _recordCursor)) {
+                    _ws->free(wsid);
+                    textRecordData->score = -1;
+                    return NEED_TIME;
+                }
+                ++_specificStats.fetches;
+            } catch (const WriteConflictException&) {
+                wsm->makeObjOwnedIfNeeded();
+                _idRetrying = wsid;
+                *out = WorkingSet::INVALID_ID;
+                return NEED_YIELD;
             }
-            ++_specificStats.fetches;
-        } catch (const WriteConflictException&) {
-            wsm->makeObjOwnedIfNeeded();
-            _idRetrying = wsid;
-            *out = WorkingSet::INVALID_ID;
-            return NEED_YIELD;
         }
 
         textRecordData->wsid = wsid;
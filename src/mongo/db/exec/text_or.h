@@ -30,6 +30,8 @@
 #pragma once
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/fts/fts_spec.h"
@@ -47,6 +49,10 @@ class OperationContext;
  * the positive terms in the search query, as well as their scores.
  *
  * The WorkingSetMembers returned are fetched and in the LOC_AND_OBJ state.
+ *
+ * If constructed with a non-zero 'limit', only the 'limit' documents with the highest scores are
+ * returned, in descending score order. Scores are then computed from the index keys alone, and only
+ * the documents which are returned get fetched.
  */
 class TextOrStage final : public RequiresCollectionStage {
 public:
@@ -71,7 +77,8 @@ public:
                 const FTSSpec& ftsSpec,
                 WorkingSet* ws,
                 const MatchExpression* filter,
-                const Collection* collection);
+                const Collection* collection,
+                size_t limit);
 
     void addChild(std::unique_ptr<PlanStage> child);
 
@@ -123,6 +130,17 @@ private:
      */
     StageState returnResults(WorkingSetID* out);
 
+    /**
+     * Worker for kReturningResults when the stage has a limit. Fetches and returns the highest
+     * scoring remaining candidate.
+     */
+    StageState returnTopResults(WorkingSetID* out);
+
+    /**
+     * Frees the working set members of the candidates which will not be returned.
+     */
+    void freeTopResults();
+
     // The index spec used to determine where to find the score.
     FTSSpec _ftsSpec;
 
@@ -150,6 +168,14 @@ private:
     ScoreMap _scores;
     ScoreMap::const_iterator _scoreIterator;
 
+    // The number of highest scoring documents to return, or 0 to return all of them.
+    const size_t _limit;
+    size_t _numReturned = 0;
+
+    // When '_limit' is set, a max-heap of the (score, wsid) pairs of the candidates which have not
+    // been fetched yet. The working set members are in the RID_AND_IDX state.
+    std::vector<std::pair<double, WorkingSetID>> _topResults;
+
     TextOrStats _specificStats;
 
     // Members needed only for using the TextMatchableDocument.
@@ -203,14 +203,14 @@ UpdateStage::UpdateStage(OperationContext* opCtx,
     _specificStats.isModUpdate = params.driver->type() == UpdateDriver::UpdateType::kOperator;
 }
 
-BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, RecordId& recordId) {
-    const UpdateRequest* request = _params.request;
+bool UpdateStage::applyUpdateToDocument(const Snapshotted<BSONObj>& oldObj,
+                                        const FieldRefSet& immutablePaths,
+                                        BSONObj* logObj,
+                                        bool* docWasModified,
+                                        const char** source) {
     UpdateDriver* driver = _params.driver;
     CanonicalQuery* cq = _params.canonicalQuery;
 
-    // If asked to return new doc, default to the oldObj, in case nothing changes.
-    BSONObj newObj = oldObj.value();
-
     // Ask the driver to apply the mods. It may be that the driver can apply those "in
     // place", that is, some values of the old document just get adjusted without any
     // change to the binary layout on the bson layer. It may be that a whole new document
@@ -222,24 +222,9 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                     ? mutablebson::Document::kInPlaceEnabled
                     : mutablebson::Document::kInPlaceDisabled));
 
-    BSONObj logObj;
-
-    bool docWasModified = false;
-
-    auto* const css = CollectionShardingState::get(getOpCtx(), collection()->ns());
-    auto metadata = css->getCurrentMetadata();
     Status status = Status::OK();
     const bool validateForStorage = getOpCtx()->writesAreReplicated() && _enforceOkForStorage;
     const bool isInsert = false;
-    FieldRefSet immutablePaths;
-    if (getOpCtx()->writesAreReplicated() && !request->isFromMigration()) {
-        if (metadata->isSharded() && !OperationShardingState::isOperationVersioned(getOpCtx())) {
-            auto& immutablePathsVector = metadata->getKeyPatternFields();
-            immutablePaths.fillFrom(
-                transitional_tools_do_not_use::unspool_vector(immutablePathsVector));
-        }
-        immutablePaths.keepShortest(&idFieldRef);
-    }
     if (!driver->needMatchDetails()) {
         // If we don't need match details, avoid doing the rematch
         status = driver->update(StringData(),
@@ -247,8 +232,8 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                                 validateForStorage,
                                 immutablePaths,
                                 isInsert,
-                                &logObj,
-                                &docWasModified);
+                                logObj,
+                                docWasModified);
     } else {
         // If there was a matched field, obtain it.
         MatchDetails matchDetails;
@@ -266,8 +251,8 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                                 validateForStorage,
                                 immutablePaths,
                                 isInsert,
-                                &logObj,
-                                &docWasModified);
+                                logObj,
+                                docWasModified);
     }
 
     if (!status.isOK()) {
@@ -290,8 +275,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
     }
 
     // See if the changes were applied in place
-    const char* source = nullptr;
-    const bool inPlace = _doc.getInPlaceUpdates(&_damages, &source);
+    const bool inPlace = _doc.getInPlaceUpdates(&_damages, source);
 
     if (inPlace && _damages.empty()) {
         // An interesting edge case. A modifier didn't notice that it was really a no-op
@@ -300,7 +284,53 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         //
         // Currently, an example of this is '{ $push : { x : {$each: [], $sort: 1} } }' when the 'x'
         // array exists and is already sorted.
-        docWasModified = false;
+        *docWasModified = false;
+    }
+
+    return inPlace;
+}
+
+BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, RecordId& recordId) {
+    const UpdateRequest* request = _params.request;
+    UpdateDriver* driver = _params.driver;
+
+    // If asked to return new doc, default to the oldObj, in case nothing changes.
+    BSONObj newObj = oldObj.value();
+
+    BSONObj logObj;
+
+    bool docWasModified = false;
+
+    auto* const css = CollectionShardingState::get(getOpCtx(), collection()->ns());
+    auto metadata = css->getCurrentMetadata();
+    FieldRefSet immutablePaths;
+    if (getOpCtx()->writesAreReplicated() && !request->isFromMigration()) {
+        if (metadata->isSharded() && !OperationShardingState::isOperationVersioned(getOpCtx())) {
+            auto& immutablePathsVector = metadata->getKeyPatternFields();
+            immutablePaths.fillFrom(
+                transitional_tools_do_not_use::unspool_vector(immutablePathsVector));
+        }
+        immutablePaths.keepShortest(&idFieldRef);
+    }
+
+    const char* source = nullptr;
+    bool inPlace = false;
+
+    // Updates which only overwrite fixed-size values of top-level fields are applied directly to
+    // the bytes of the old document. The first field must already be _id, because otherwise the
+    // document would have to be rewritten to move it there.
+    if (collection()->updateWithDamagesSupported() && driver->canApplyInPlace() &&
+        !metadata->isSharded() && oldObj.value().firstElementFieldNameStringData() == "_id"_sd &&
+        driver->applyInPlace(oldObj.value(),
+                             immutablePaths,
+                             &_damages,
+                             &_damageSource,
+                             &logObj,
+                             &docWasModified)) {
+        source = _damageSource.objdata();
+        inPlace = true;
+    } else {
+        inPlace = applyUpdateToDocument(oldObj, immutablePaths, &logObj, &docWasModified, &source);
     }
 
     if (docWasModified) {
@@ -172,6 +172,17 @@ private:
      */
     BSONObj transformAndUpdate(const Snapshotted<BSONObj>& oldObj, RecordId& recordId);
 
+    /**
+     * Applies the mods to '_doc', reset to the document 'oldObj', filling 'logObj' and
+     * 'docWasModified'. Returns true if the changes were applied in place, in which case
+     * '_damages' and 'source' describe them.
+     */
+    bool applyUpdateToDocument(const Snapshotted<BSONObj>& oldObj,
+                               const FieldRefSet& immutablePaths,
+                               BSONObj* logObj,
+                               bool* docWasModified,
+                               const char** source);
+
     /**
      * Computes the document to insert and inserts it into the collection. Used if the
      * user requested an upsert and no matching documents were found.
@@ -248,6 +259,9 @@ private:
     // These get reused for each update.
     mutablebson::Document& _doc;
     mutablebson::DamageVector _damages;
+
+    // The buffer the '_damages' of an update applied without '_doc' are copied from.
+    BSONObj _damageSource;
 };
 
 }  // namespace mongo
@@ -46,36 +46,40 @@ WorkingSetID WorkingSet::allocate() {
         // The free list is empty so we need to make a single new WSM to return. This relies on
         // vector::resize being amortized O(1) for efficient allocation. Note that the free list
         // remains empty until something is returned by a call to free().
-        WorkingSetID id = _data.size();
-        _data.resize(_data.size() + 1);
-        _data.back().nextFreeOrSelf = id;
+        WorkingSetID id = _members.size();
+        _members.resize(_members.size() + 1);
+        _nextFreeOrSelf.push_back(id);
         return id;
     }
 
     // Pop the head off the free list and return it.
     WorkingSetID id = _freeList;
-    _freeList = _data[id].nextFreeOrSelf;
-    _data[id].nextFreeOrSelf = id;  // set to self to mark as in-use
+    _freeList = _nextFreeOrSelf[id];
+    _nextFreeOrSelf[id] = id;  // set to self to mark as in-use
     return id;
 }
 
 void WorkingSet::free(WorkingSetID i) {
-    MemberHolder& holder = _data[i];
-    verify(i < _data.size());            // ID has been allocated.
-    verify(holder.nextFreeOrSelf == i);  // ID currently in use.
+    verify(i < _members.size());      // ID has been allocated.
+    verify(_nextFreeOrSelf[i] == i);  // ID currently in use.
 
     // Free resources and push this WSM to the head of the freelist.
-    holder.member.clear();
-    holder.nextFreeOrSelf = _freeList;
+    _members[i].clear();
+    _nextFreeOrSelf[i] = _freeList;
     _freeList = i;
 }
 
 void WorkingSet::clear() {
-    _data.clear();
-
-    // Since working set is now empty, the free list pointer should
-    // point to nothing.
+    // Rebuild the free list from the highest id down so that allocation restarts at id 0. Members
+    // which are already free were cleared when they were freed.
     _freeList = INVALID_ID;
+    for (WorkingSetID id = _members.size(); id-- > 0;) {
+        if (_nextFreeOrSelf[id] == id) {
+            _members[id].clear();
+        }
+        _nextFreeOrSelf[id] = _freeList;
+        _freeList = id;
+    }
 }
 
 void WorkingSet::transitionToRecordIdAndIdx(WorkingSetID id) {
@@ -94,8 +98,8 @@ void WorkingSet::transitionToOwnedObj(WorkingSetID id) {
 }
 
 WorkingSetMember WorkingSet::extract(WorkingSetID wsid) {
-    invariant(wsid < _data.size());
-    WorkingSetMember ret = std::move(_data[wsid].member);
+    invariant(wsid < _members.size());
+    WorkingSetMember ret = std::move(_members[wsid]);
     free(wsid);
     return ret;
 }
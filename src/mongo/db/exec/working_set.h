@@ -271,34 +271,45 @@ public:
      * release it.
      */
     WorkingSetMember* get(WorkingSetID i) {
-        dassert(i < _data.size());              // ID has been allocated.
-        dassert(_data[i].nextFreeOrSelf == i);  // ID currently in use.
-        return &_data[i].member;
+        dassert(i < _members.size());      // ID has been allocated.
+        dassert(_nextFreeOrSelf[i] == i);  // ID currently in use.
+        return &_members[i];
     }
 
     const WorkingSetMember* get(WorkingSetID i) const {
-        dassert(i < _data.size());              // ID has been allocated.
-        dassert(_data[i].nextFreeOrSelf == i);  // ID currently in use.
-        return &_data[i].member;
+        dassert(i < _members.size());      // ID has been allocated.
+        dassert(_nextFreeOrSelf[i] == i);  // ID currently in use.
+        return &_members[i];
     }
 
     /**
      * Returns true if WorkingSetMember with id 'i' is free.
      */
     bool isFree(WorkingSetID i) const {
-        return _data[i].nextFreeOrSelf != i;
+        return _nextFreeOrSelf[i] != i;
     }
 
     /**
-     * Deallocate the i-th query result and release its resources.
+     * Deallocate the i-th query result and release its resources. The slot keeps the capacity of
+     * its key data and document storage so that the next allocate() which reuses it does not need
+     * to allocate again.
      */
     void free(WorkingSetID i);
 
     /**
-     * Removes and deallocates all members of this working set.
+     * Frees all members of this working set. Every slot is returned to the free list rather than
+     * destroyed, so a working set which is cleared and refilled (e.g. after plan ranking) reuses
+     * its existing buffers. Ids are handed out again in ascending order.
      */
     void clear();
 
+    /**
+     * Returns the number of slots, in use or free, owned by this working set.
+     */
+    size_t capacity() const {
+        return _members.size();
+    }
+
     //
     // WorkingSetMember state transitions
     //
@@ -340,20 +351,19 @@ public:
     WorkingSetID emplace(WorkingSetMember&&);
 
 private:
-    struct MemberHolder {
-        // Free list link if freed. Points to self if in use.
-        WorkingSetID nextFreeOrSelf;
-
-        WorkingSetMember member;
-    };
-
-    // All WorkingSetIDs are indexes into this, except for INVALID_ID.
-    // Elements are added to _freeList rather than removed when freed.
-    std::vector<MemberHolder> _data;
-
-    // Index into _data, forming a linked-list using MemberHolder::nextFreeOrSelf as the next
-    // link. INVALID_ID is the list terminator since 0 is a valid index.
-    // If _freeList == INVALID_ID, the free list is empty and all elements in _data are in use.
+    // The members and their free list links are kept in parallel arrays indexed by WorkingSetID
+    // (all WorkingSetIDs are indexes into these, except for INVALID_ID). Keeping the links apart
+    // from the much larger members means that allocate(), free() and isFree() walk a dense array
+    // of ids instead of striding across member storage. Elements are added to _freeList rather
+    // than removed when freed, and the members keep their buffers while on the free list.
+    std::vector<WorkingSetMember> _members;
+
+    // Free list link if freed. Points to self if in use.
+    std::vector<WorkingSetID> _nextFreeOrSelf;
+
+    // Index into _members, forming a linked-list using _nextFreeOrSelf as the next link.
+    // INVALID_ID is the list terminator since 0 is a valid index. If _freeList == INVALID_ID, the
+    // free list is empty and all elements in _members are in use.
     WorkingSetID _freeList;
 
     // Holds IndexAccessMethods that have been registered with 'registerIndexAccessMethod()`. The
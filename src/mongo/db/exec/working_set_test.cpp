@@ -311,4 +311,46 @@ TEST_F(WorkingSetFixture, WsmCanBeExtractedAndReinserted) {
     ASSERT_FALSE(emplacedWsm->metadata());
 }
 
+TEST_F(WorkingSetFixture, FreedMemberKeepsKeyDataCapacity) {
+    member->recordId = RecordId{43};
+    member->keyData.emplace_back(BSON("a" << 1), BSON("" << 3), 0u, SnapshotId{});
+    member->keyData.emplace_back(BSON("b" << 1), BSON("" << 4), 0u, SnapshotId{});
+    ws->transitionToRecordIdAndIdx(id);
+    const auto capacity = member->keyData.capacity();
+    ws->free(id);
+    ASSERT_TRUE(ws->isFree(id));
+
+    // The next allocation reuses the freed slot, which is empty but retains its key buffer.
+    auto reusedId = ws->allocate();
+    ASSERT_EQ(reusedId, id);
+    auto reused = ws->get(reusedId);
+    ASSERT_EQ(reused->getState(), WorkingSetMember::INVALID);
+    ASSERT_TRUE(reused->keyData.empty());
+    ASSERT_EQ(reused->keyData.capacity(), capacity);
+    ASSERT_EQ(ws->capacity(), 1u);
+}
+
+TEST_F(WorkingSetFixture, ClearRecyclesAllMembers) {
+    member->doc.setValue(Document{{"foo", Value{"bar"_sd}}});
+    ws->transitionToOwnedObj(id);
+    auto secondId = ws->allocate();
+    auto thirdId = ws->allocate();
+    ws->free(secondId);
+    ASSERT_EQ(ws->capacity(), 3u);
+
+    ws->clear();
+    ASSERT_TRUE(ws->isFree(id));
+    ASSERT_TRUE(ws->isFree(secondId));
+    ASSERT_TRUE(ws->isFree(thirdId));
+
+    // All slots are handed out again, lowest id first, before the working set grows.
+    ASSERT_EQ(ws->allocate(), id);
+    ASSERT_FALSE(ws->get(id)->hasObj());
+    ASSERT_EQ(ws->allocate(), secondId);
+    ASSERT_EQ(ws->allocate(), thirdId);
+    ASSERT_EQ(ws->capacity(), 3u);
+    ASSERT_EQ(ws->allocate(), 3u);
+    ASSERT_EQ(ws->capacity(), 4u);
+}
+
 }  // namespace mongo
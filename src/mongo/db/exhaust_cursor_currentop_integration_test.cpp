@@ -118,18 +118,14 @@ TEST(CurrentOpExhaustCursorTest, CanSeeEachExhaustCursorPseudoGetMoreInCurrentOp
     auto queryThread = stdx::async(stdx::launch::async, [&testNSS, &queryConnection, &queryCursor] {
         queryConnection = connect("curop_exhaust_cursor_test_bg");
         auto projSpec = BSON("_id" << 0 << "a" << 1);
-        // Issue the initial 'find' with a batchSize of 2 and the exhaust flag set. We then iterate
+        // Issue the initial 'find' with a batchSize of 1 and the exhaust flag set. We then iterate
         // through the first batch and confirm that the results are as expected.
-        queryCursor = queryConnection->query(testNSS, {}, 0, 0, &projSpec, QueryOption_Exhaust, 2);
-        for (int i = 0; i < 2; ++i) {
-            ASSERT_BSONOBJ_EQ(queryCursor->nextSafe(), BSON("a" << i));
-        }
-        // Having exhausted the two results returned by the initial find, we set the batchSize to 1
-        // and issue a single getMore via DBClientCursor::more(). Because the 'exhaust' flag is set,
-        // the server will generate a series of internal getMores and stream them back to the client
-        // until the cursor is exhausted, without the client sending any further getMore requests.
-        // We expect this request to hang at the 'waitWithPinnedCursorDuringGetMoreBatch' failpoint.
-        queryCursor->setBatchSize(1);
+        queryCursor = queryConnection->query(testNSS, {}, 0, 0, &projSpec, QueryOption_Exhaust, 1);
+        ASSERT_BSONOBJ_EQ(queryCursor->nextSafe(), BSON("a" << 0));
+        // Because the 'exhaust' flag is set, the server follows the initial find with a series of
+        // internal getMores and streams them back to the client until the cursor is exhausted,
+        // without the client sending any getMore requests. We expect the next batch to hang at the
+        // 'waitWithPinnedCursorDuringGetMoreBatch' failpoint.
         ASSERT(queryCursor->more());
     });
 
@@ -147,11 +143,11 @@ TEST(CurrentOpExhaustCursorTest, CanSeeEachExhaustCursorPseudoGetMoreInCurrentOp
     }
     ASSERT(queryCursor);
 
-    // We expect that the server, having received the first {batchSize: 1} getMore for the parallel
-    // thread's exhaust cursor, will produce a series of pseudo-getMores internally and stream the
-    // results back to the client until the cursor is exhausted. Here, we verify that each of these
+    // We expect that the server, having received the {batchSize: 1} find for the parallel thread's
+    // exhaust cursor, will produce a series of pseudo-getMores internally and stream the results
+    // back to the client until the cursor is exhausted. Here, we verify that each of these
     // pseudo-getMores appear in the $currentOp output.
-    for (int i = 2; i < 10; ++i) {
+    for (int i = 1; i < 10; ++i) {
         // Generate a currentOp filter based on the cursorId and the cumulative nDocsReturned.
         const auto curOpMatch = BSON("command.collection"
                                      << "exhaust_cursor_currentop"
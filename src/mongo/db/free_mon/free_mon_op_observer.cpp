@@ -135,7 +135,8 @@ void FreeMonOpObserver::onDelete(OperationContext* opCtx,
                                  OptionalCollectionUUID uuid,
                                  StmtId stmtId,
                                  bool fromMigrate,
-                                 const boost::optional<BSONObj>& deletedDoc) {
+                                 const boost::optional<BSONObj>& deletedDoc,
+                                 const repl::OplogSlot& oplogSlot) {
     if (nss != NamespaceString::kServerConfigurationNamespace) {
         return;
     }
@@ -31,6 +31,8 @@
 
 #include "mongo/db/ftdc/collector.h"
 
+#include <algorithm>
+
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobjbuilder.h"
@@ -48,6 +50,12 @@ void FTDCCollectorCollection::add(std::unique_ptr<FTDCCollectorInterface> collec
     _collectors.emplace_back(std::move(collector));
 }
 
+bool FTDCCollectorCollection::hasData() const {
+    return std::any_of(_collectors.begin(), _collectors.end(), [](const auto& collector) {
+        return collector->hasData();
+    });
+}
+
 std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
     // If there are no collectors, just return an empty BSONObj so that that are caller knows we did
     // not collect anything
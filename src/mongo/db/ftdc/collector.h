@@ -69,6 +69,14 @@ public:
      */
     virtual void collect(OperationContext* opCtx, BSONObjBuilder& builder) = 0;
 
+    /**
+     * Returns false if the collector has nothing to report. Only consulted for periodic metadata
+     * collectors, whose document is skipped when none of them has anything to report.
+     */
+    virtual bool hasData() const {
+        return true;
+    }
+
 protected:
     FTDCCollectorInterface() = default;
 };
@@ -91,6 +99,11 @@ public:
      */
     void add(std::unique_ptr<FTDCCollectorInterface> collector);
 
+    /**
+     * Returns true if any collector in the collection has data to report.
+     */
+    bool hasData() const;
+
     /**
      * Collect a sample from all collectors. Called after all adding is complete.
      * Returns a tuple of a sample, and the time at which collecting started.
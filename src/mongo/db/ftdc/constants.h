@@ -49,4 +49,7 @@ extern const char kFTDCCollectEndField[];
 
 constexpr StringData kFTDCDefaultDirectory = "diagnostic.data"_sd;
 
+// Subdirectory of the FTDC directory which holds the high-frequency stream.
+constexpr StringData kFTDCHighFrequencyDirectory = "highFrequency"_sd;
+
 }  // namespace mongo
@@ -94,6 +94,12 @@ void FTDCController::setMaxSamplesPerInterimMetricChunk(size_t size) {
     _condvar.notify_one();
 }
 
+void FTDCController::setMetadataPeriod(Milliseconds millis) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    _configTemp.metadataPeriod = millis;
+    _condvar.notify_one();
+}
+
 Status FTDCController::setDirectory(const boost::filesystem::path& path) {
     stdx::lock_guard<Latch> lock(_mutex);
 
@@ -129,6 +135,16 @@ void FTDCController::addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface
     }
 }
 
+void FTDCController::addPeriodicMetadataCollector(
+    std::unique_ptr<FTDCCollectorInterface> collector) {
+    {
+        stdx::lock_guard<Latch> lock(_mutex);
+        invariant(_state == State::kNotStarted);
+
+        _periodicMetadataCollectors.add(std::move(collector));
+    }
+}
+
 BSONObj FTDCController::getMostRecentPeriodicDocument() {
     {
         stdx::lock_guard<Latch> lock(_mutex);
@@ -193,7 +209,7 @@ void FTDCController::doLoop() {
             _config = _configTemp;
         }
 
-        Client::initThread("ftdc");
+        Client::initThread(_threadName);
         Client* client = &cc();
 
         while (true) {
@@ -255,6 +271,19 @@ void FTDCController::doLoop() {
                     stdx::lock_guard<Latch> lock(_mutex);
                     _mostRecentPeriodicDocument = std::get<0>(collectSample);
                 }
+
+                if (now - _lastMetadataCollection >= _config.metadataPeriod) {
+                    _lastMetadataCollection = now;
+
+                    if (_periodicMetadataCollectors.hasData()) {
+                        auto collectMetadata = _periodicMetadataCollectors.collect(client);
+
+                        uassertStatusOK(
+                            _mgr->writeMetadataAndRotateIfNeeded(client,
+                                                                 std::get<0>(collectMetadata),
+                                                                 std::get<1>(collectMetadata)));
+                    }
+                }
             }
         }
     } catch (...) {
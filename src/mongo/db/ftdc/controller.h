@@ -56,8 +56,13 @@ class FTDCController {
     FTDCController& operator=(const FTDCController&) = delete;
 
 public:
-    FTDCController(const boost::filesystem::path path, FTDCConfig config)
-        : _path(path), _config(std::move(config)), _configTemp(_config) {}
+    FTDCController(const boost::filesystem::path path,
+                   FTDCConfig config,
+                   StringData threadName = "ftdc"_sd)
+        : _path(path),
+          _config(std::move(config)),
+          _configTemp(_config),
+          _threadName(threadName.toString()) {}
 
     ~FTDCController() = default;
 
@@ -99,6 +104,11 @@ public:
      */
     void setMaxSamplesPerInterimMetricChunk(size_t size);
 
+    /**
+     * Set the period for writing the documents of the periodic metadata collectors.
+     */
+    void setMetadataPeriod(Milliseconds millis);
+
     /*
      * Set the path to store FTDC files if not already set.
      *
@@ -118,6 +128,15 @@ public:
      */
     void addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface> collector);
 
+    /**
+     * Add a collector to collect every metadata period, and write as a metadata document rather
+     * than as a sample. i.e. CPU profiles
+     *
+     * This is for data whose shape changes from one collection to the next, which would defeat the
+     * compression of metric chunks.
+     */
+    void addPeriodicMetadataCollector(std::unique_ptr<FTDCCollectorInterface> collector);
+
     /**
      * Start the controller.
      *
@@ -197,6 +216,9 @@ private:
     // Config settings that are manipulated by setters via setParameter.
     FTDCConfig _configTemp;
 
+    // Name of the background thread, which tells apart the controllers of different streams.
+    const std::string _threadName;
+
     // Set of periodic collectors
     FTDCCollectorCollection _periodicCollectors;
 
@@ -207,6 +229,12 @@ private:
     // Set of file rotation collectors
     FTDCCollectorCollection _rotateCollectors;
 
+    // Set of periodic metadata collectors
+    FTDCCollectorCollection _periodicMetadataCollectors;
+
+    // Time at which the periodic metadata collectors were last collected
+    Date_t _lastMetadataCollection;
+
     // File manager that manages file rotation, and logging
     std::unique_ptr<FTDCFileManager> _mgr;
 
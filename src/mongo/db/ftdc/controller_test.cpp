@@ -43,6 +43,7 @@
 #include "mongo/db/ftdc/config.h"
 #include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/controller.h"
+#include "mongo/db/ftdc/file_reader.h"
 #include "mongo/db/ftdc/ftdc_test.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
@@ -156,6 +157,51 @@ public:
     }
 };
 
+class FTDCMetadataCollectorMock : public FTDCCollectorInterface {
+public:
+    explicit FTDCMetadataCollectorMock(bool hasData) : _hasData(hasData) {}
+
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) final {
+        builder.append("collection", _collections.addAndFetch(1));
+    }
+
+    std::string name() const final {
+        return "profile";
+    }
+
+    bool hasData() const final {
+        return _hasData;
+    }
+
+    int getCollections() const {
+        return _collections.load();
+    }
+
+private:
+    const bool _hasData;
+    AtomicWord<int> _collections{0};
+};
+
+/**
+ * Returns the metadata documents in the FTDC file 'path'.
+ */
+std::vector<BSONObj> readMetadataDocuments(const boost::filesystem::path& path) {
+    FTDCFileReader reader;
+    ASSERT_OK(reader.open(path));
+
+    std::vector<BSONObj> docs;
+    auto sw = reader.hasNext();
+    while (sw.isOK() && sw.getValue()) {
+        auto next = reader.next();
+        if (std::get<0>(next) == FTDCBSONUtil::FTDCType::kMetadata) {
+            docs.emplace_back(std::get<1>(next).getOwned());
+        }
+        sw = reader.hasNext();
+    }
+    ASSERT_OK(sw);
+    return docs;
+}
+
 // Test a run of the controller and the data it logs to log file
 TEST_F(FTDCControllerTest, TestFull) {
     unittest::TempDir tempdir("metrics_testpath");
@@ -280,4 +326,57 @@ TEST_F(FTDCControllerTest, TestStartAsDisabled) {
     ValidateDocumentList(alog, allDocs, FTDCValidationMode::kStrict);
 }
 
+// Test that periodic metadata collectors are written as metadata documents, and only when they have
+// data to report
+TEST_F(FTDCControllerTest, TestPeriodicMetadata) {
+    for (bool hasData : {false, true}) {
+        unittest::TempDir tempdir("metrics_testpath");
+        boost::filesystem::path dir(tempdir.path());
+
+        createDirectoryClean(dir);
+
+        FTDCConfig config;
+        config.enabled = true;
+        config.period = Milliseconds(1);
+        config.metadataPeriod = Milliseconds(1);
+        config.maxFileSizeBytes = FTDCConfig::kMaxFileSizeBytesDefault;
+        config.maxDirectorySizeBytes = FTDCConfig::kMaxDirectorySizeBytesDefault;
+
+        FTDCController c(dir, config);
+
+        auto c1 = std::make_unique<FTDCMetricsCollectorMock2>();
+        auto c1Ptr = c1.get();
+        c1Ptr->setSignalOnCount(50);
+        c.addPeriodicCollector(std::move(c1));
+
+        auto c2 = std::make_unique<FTDCMetadataCollectorMock>(hasData);
+        auto c2Ptr = c2.get();
+        c.addPeriodicMetadataCollector(std::move(c2));
+
+        c.start();
+
+        // Wait for 50 samples to have occured
+        c1Ptr->wait();
+
+        c.stop();
+
+        auto files = scanDirectory(dir);
+        ASSERT_EQUALS(files.size(), 1UL);
+
+        auto metadataDocs = readMetadataDocuments(files[0]);
+        if (!hasData) {
+            ASSERT_EQUALS(c2Ptr->getCollections(), 0);
+            ASSERT_EQUALS(metadataDocs.size(), 0UL);
+            continue;
+        }
+
+        ASSERT_GREATER_THAN_OR_EQUALS(c2Ptr->getCollections(), 1);
+        ASSERT_EQUALS(metadataDocs.size(), static_cast<size_t>(c2Ptr->getCollections()));
+        for (size_t i = 0; i < metadataDocs.size(); ++i) {
+            ASSERT_EQUALS(metadataDocs[i]["profile"]["collection"].numberInt(),
+                          static_cast<int>(i + 1));
+        }
+    }
+}
+
 }  // namespace mongo
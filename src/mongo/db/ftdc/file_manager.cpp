@@ -336,6 +336,22 @@ Status FTDCFileManager::writeSampleAndRotateIfNeeded(Client* client,
     return Status::OK();
 }
 
+Status FTDCFileManager::writeMetadataAndRotateIfNeeded(Client* client,
+                                                       const BSONObj& metadata,
+                                                       Date_t date) {
+    Status s = _writer.writeMetadata(metadata, date);
+
+    if (!s.isOK()) {
+        return s;
+    }
+
+    if (_writer.getSize() > _config->maxFileSizeBytes) {
+        return rotate(client);
+    }
+
+    return Status::OK();
+}
+
 Status FTDCFileManager::close() {
     return _writer.close();
 }
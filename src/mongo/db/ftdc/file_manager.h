@@ -85,6 +85,13 @@ public:
      */
     Status writeSampleAndRotateIfNeeded(Client* client, const BSONObj& sample, Date_t date);
 
+    /**
+     * Writes a metadata document to disk via FTDCFileWriter.
+     *
+     * Rotates files as needed.
+     */
+    Status writeMetadataAndRotateIfNeeded(Client* client, const BSONObj& metadata, Date_t date);
+
     /**
      * Closes the current file manager down.
      */
@@ -0,0 +1,276 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kFTDC
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/ftdc/ftdc_cpu_profile.h"
+
+#include <algorithm>
+#include <memory>
+#include <set>
+
+#if !defined(_WIN32)
+#include <dlfcn.h>
+#endif
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/ftdc/block_compressor.h"
+#include "mongo/db/ftdc/collector.h"
+#include "mongo/db/ftdc/controller.h"
+#include "mongo/db/ftdc/ftdc_server.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/log.h"
+#include "mongo/util/sampling_profiler.h"
+#include "mongo/util/stacktrace_json.h"
+#include "mongo/util/stacktrace_somap.h"
+
+namespace mongo {
+
+namespace {
+
+// The number of distinct stacks kept in a profile. Rarer stacks are only counted, so that the
+// profile of a busy process stays well below the maximum BSON size.
+constexpr size_t kMaxStacks = 2000;
+
+constexpr auto kCollectorName = "cpuProfile"_sd;
+
+/**
+ * The samples gathered since the last profile was written.
+ */
+struct CpuProfile {
+    Date_t start;
+    std::uint64_t samples = 0;
+    SamplingProfiler::StackCounts stacks;
+
+    void drain() {
+        samples += SamplingProfiler::get().drainSamples(&stacks);
+    }
+};
+
+/**
+ * Appends the frame at 'address' in the format of a logged stack trace: the base of the enclosing
+ * shared object, the offset of the address from it, and the enclosing symbol if known. Adds the
+ * base to 'bases'.
+ */
+void appendFrame(std::uintptr_t address, BSONArrayBuilder* frames, std::set<uint64_t>* bases) {
+    std::uintptr_t base = 0;
+    const char* symbol = nullptr;
+#if !defined(_WIN32)
+    Dl_info dli;
+    if (dladdr(reinterpret_cast<void*>(address), &dli) != 0) {
+        base = reinterpret_cast<std::uintptr_t>(dli.dli_fbase);
+        if (dli.dli_saddr) {
+            symbol = dli.dli_sname;
+        }
+    }
+#endif
+    bases->insert(base);
+
+    BSONObjBuilder frame(frames->subobjStart());
+    frame.append("b", Hex(base).str());
+    frame.append("o", Hex(address - base).str());
+    if (symbol) {
+        frame.append("s", symbol);
+    }
+}
+
+/**
+ * Appends the process info of the shared object map, with the "somap" array trimmed to the shared
+ * objects in 'bases'.
+ */
+void appendProcessInfo(const std::set<uint64_t>& bases, BSONObjBuilder* builder) {
+    BSONObjBuilder processInfo(builder->subobjStart("processInfo"));
+    for (const auto& element : globalSharedObjectMapInfo().obj()) {
+        if (element.type() == BSONType::Array && element.fieldNameStringData() == "somap") {
+            BSONArrayBuilder somap(processInfo.subarrayStart("somap"));
+            for (const auto& so : element.Array()) {
+                if (bases.count(Hex::fromHex(so.Obj().getStringField("b")))) {
+                    somap.append(so);
+                }
+            }
+            continue;
+        }
+        processInfo.append(element);
+    }
+}
+
+/**
+ * Builds the uncompressed profile document:
+ *
+ * {
+ *     stacks: [{count: <samples>, frames: [<index into frames>, ...]}, ...],
+ *     frames: [{b: <base>, o: <offset>, s: <symbol>}, ...],
+ *     processInfo: {...}
+ * }
+ *
+ * Stacks are ordered by decreasing count, with frames innermost first. Returns the number of
+ * samples of the stacks which did not make the cut.
+ */
+std::uint64_t buildProfileDocument(const SamplingProfiler::StackCounts& stackCounts,
+                                   BSONObjBuilder* builder) {
+    std::vector<std::pair<const SamplingProfiler::Stack*, std::uint64_t>> byCount;
+    byCount.reserve(stackCounts.size());
+    for (const auto& [stack, count] : stackCounts) {
+        byCount.emplace_back(&stack, count);
+    }
+    std::sort(byCount.begin(), byCount.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second > rhs.second;
+    });
+
+    std::uint64_t truncatedSamples = 0;
+    for (size_t i = kMaxStacks; i < byCount.size(); ++i) {
+        truncatedSamples += byCount[i].second;
+    }
+    byCount.resize(std::min(byCount.size(), kMaxStacks));
+
+    // Each distinct address is described once, and stacks refer to it by index.
+    stdx::unordered_map<std::uintptr_t, int> frameIndexes;
+    std::set<uint64_t> bases;
+    BSONArrayBuilder frames;
+    {
+        BSONArrayBuilder stacks(builder->subarrayStart("stacks"));
+        for (const auto& [stack, count] : byCount) {
+            BSONObjBuilder stackBuilder(stacks.subobjStart());
+            stackBuilder.append("count", static_cast<long long>(count));
+            BSONArrayBuilder stackFrames(stackBuilder.subarrayStart("frames"));
+            for (auto address : *stack) {
+                auto [it, inserted] =
+                    frameIndexes.emplace(address, static_cast<int>(frameIndexes.size()));
+                if (inserted) {
+                    appendFrame(address, &frames, &bases);
+                }
+                stackFrames.append(it->second);
+            }
+        }
+    }
+    builder->append("frames", frames.arr());
+    appendProcessInfo(bases, builder);
+
+    return truncatedSamples;
+}
+
+/**
+ * Reports the profiler's counters each period, and moves its samples into the current profile.
+ */
+class CpuProfileSampleCollector final : public FTDCCollectorInterface {
+public:
+    explicit CpuProfileSampleCollector(std::shared_ptr<CpuProfile> profile)
+        : _profile(std::move(profile)) {}
+
+    std::string name() const override {
+        return kCollectorName.toString();
+    }
+
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) override {
+        _profile->drain();
+
+        auto& profiler = SamplingProfiler::get();
+        builder.append("sampleRate", profiler.getSampleRate());
+        builder.append("samples", static_cast<long long>(profiler.getSampleCount()));
+        builder.append("droppedSamples", static_cast<long long>(profiler.getDroppedSampleCount()));
+    }
+
+private:
+    std::shared_ptr<CpuProfile> _profile;
+};
+
+/**
+ * Writes the current profile each metadata period, and starts a new one.
+ */
+class CpuProfileCollector final : public FTDCCollectorInterface {
+public:
+    explicit CpuProfileCollector(std::shared_ptr<CpuProfile> profile)
+        : _profile(std::move(profile)) {}
+
+    std::string name() const override {
+        return kCollectorName.toString();
+    }
+
+    bool hasData() const override {
+        return _profile->samples > 0;
+    }
+
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) override {
+        _profile->drain();
+
+        const auto now = opCtx->getServiceContext()->getPreciseClockSource()->now();
+        builder.appendDate("profileStart", _profile->start);
+        builder.append("sampleRate", SamplingProfiler::get().getSampleRate());
+        builder.append("samples", static_cast<long long>(_profile->samples));
+
+        BSONObjBuilder profileBuilder;
+        auto truncatedSamples = buildProfileDocument(_profile->stacks, &profileBuilder);
+        BSONObj profile = profileBuilder.done();
+        builder.append("truncatedSamples", static_cast<long long>(truncatedSamples));
+
+        _profile->stacks.clear();
+        _profile->samples = 0;
+        _profile->start = now;
+
+        auto swCompressed =
+            _compressor.compress({profile.objdata(), static_cast<size_t>(profile.objsize())});
+        if (!swCompressed.isOK()) {
+            builder.append("error", swCompressed.getStatus().toString());
+            return;
+        }
+
+        builder.append("uncompressedSize", profile.objsize());
+        builder.appendBinData("data",
+                              swCompressed.getValue().length(),
+                              BinDataGeneral,
+                              swCompressed.getValue().data());
+    }
+
+private:
+    std::shared_ptr<CpuProfile> _profile;
+    BlockCompressor _compressor;
+};
+
+}  // namespace
+
+void installCpuProfileCollectors(FTDCController* controller) {
+    auto profile = std::make_shared<CpuProfile>();
+    profile->start = getGlobalServiceContext()->getPreciseClockSource()->now();
+
+    controller->addPeriodicCollector(std::make_unique<CpuProfileSampleCollector>(profile));
+    controller->addPeriodicMetadataCollector(std::make_unique<CpuProfileCollector>(profile));
+
+    auto status =
+        SamplingProfiler::get().setSampleRate(ftdcStartupParams.cpuProfileSampleHz.load());
+    if (!status.isOK()) {
+        warning() << "Failed to start the CPU sampling profiler: " << status;
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,53 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+namespace mongo {
+
+class FTDCController;
+
+/**
+ * Install the collectors which write the samples of the CPU sampling profiler into FTDC:
+ *
+ * - A periodic collector, "cpuProfile", which reports the sample rate and the number of samples
+ *   taken and dropped, and moves the profiler's samples into the current profile. Collecting every
+ *   period keeps the profiler's sample ring from filling up.
+ * - A periodic metadata collector, also "cpuProfile", which writes the current profile and starts
+ *   a new one. The profile is a list of distinct stacks with their sample counts, where each frame
+ *   is a base and offset into a shared object, as in a logged stack trace, along with the process
+ *   info needed to symbolize them. It is compressed with zlib, and is only written if any samples
+ *   were taken.
+ *
+ * The profiler is started at the rate of diagnosticDataCollectionCpuProfileSampleHz.
+ */
+void installCpuProfileCollectors(FTDCController* controller);
+
+}  // namespace mongo
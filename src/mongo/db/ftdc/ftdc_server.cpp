@@ -34,17 +34,22 @@
 #include <boost/filesystem.hpp>
 #include <fstream>
 #include <memory>
+#include <set>
 
 #include "mongo/base/status.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/config.h"
+#include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/controller.h"
+#include "mongo/db/ftdc/ftdc_cpu_profile.h"
 #include "mongo/db/ftdc/ftdc_server_gen.h"
 #include "mongo/db/ftdc/ftdc_system_stats.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/util/sampling_profiler.h"
 #include "mongo/util/synchronized_value.h"
 
 namespace mongo {
@@ -53,6 +58,19 @@ namespace {
 
 const auto getFTDCController = ServiceContext::declareDecoration<std::unique_ptr<FTDCController>>();
 
+// Controller of the high-frequency stream, which samples a few metrics many times a second into
+// its own files, so that short stalls are not averaged away in the regular stream.
+const auto getHighFrequencyFTDCController =
+    ServiceContext::declareDecoration<std::unique_ptr<FTDCController>>();
+
+// Number of samples per chunk of the high-frequency stream. The samples are smaller and far more
+// frequent than in the regular stream, so chunks hold more of them to keep the rate of writes low.
+constexpr std::uint32_t kHighFrequencySamplesPerArchiveMetricChunk = 1000;
+constexpr std::uint32_t kHighFrequencySamplesPerInterimMetricChunk = 100;
+
+// The high-frequency stream may use this fraction of the FTDC directory size.
+constexpr std::uint64_t kHighFrequencyDirectorySizeDivisor = 4;
+
 FTDCController* getGlobalFTDCController() {
     if (!hasGlobalServiceContext()) {
         return nullptr;
@@ -61,6 +79,41 @@ FTDCController* getGlobalFTDCController() {
     return getFTDCController(getGlobalServiceContext()).get();
 }
 
+FTDCController* getGlobalHighFrequencyFTDCController() {
+    if (!hasGlobalServiceContext()) {
+        return nullptr;
+    }
+
+    return getHighFrequencyFTDCController(getGlobalServiceContext()).get();
+}
+
+boost::filesystem::path getHighFrequencyPath(const boost::filesystem::path& path) {
+    if (path.empty()) {
+        return path;
+    }
+
+    return path / kFTDCHighFrequencyDirectory.toString();
+}
+
+std::vector<std::string> parseHighFrequencyMetrics(StringData metrics) {
+    std::vector<std::string> paths;
+    while (!metrics.empty()) {
+        auto comma = metrics.find(',');
+        auto path = metrics.substr(0, comma);
+        while (!path.empty() && path[0] == ' ') {
+            path = path.substr(1);
+        }
+        while (!path.empty() && path[path.size() - 1] == ' ') {
+            path = path.substr(0, path.size() - 1);
+        }
+        if (!path.empty()) {
+            paths.push_back(path.toString());
+        }
+        metrics = comma == std::string::npos ? StringData() : metrics.substr(comma + 1);
+    }
+    return paths;
+}
+
 /**
  * Expose diagnosticDataCollectionDirectoryPath set parameter to specify the MongoD and MongoS FTDC
  * path.
@@ -86,6 +139,10 @@ Status DiagnosticDataCollectionDirectoryPathServerParameter::setFromString(const
                 return s;
             }
         }
+
+        if (auto highFrequencyController = getGlobalHighFrequencyFTDCController()) {
+            highFrequencyController->setDirectory(getHighFrequencyPath(str)).ignore();
+        }
     }
 
     ftdcDirectoryPathParameter = str;
@@ -100,6 +157,11 @@ boost::filesystem::path getFTDCDirectoryPathParameter() {
 Status onUpdateFTDCEnabled(const bool value) {
     auto controller = getGlobalFTDCController();
     if (controller) {
+        auto highFrequencyController = getGlobalHighFrequencyFTDCController();
+        if (highFrequencyController && ftdcStartupParams.highFrequencyPeriodMillis.load() > 0) {
+            highFrequencyController->setEnabled(value).ignore();
+        }
+
         return controller->setEnabled(value);
     }
 
@@ -130,6 +192,11 @@ Status onUpdateFTDCDirectorySize(const std::int32_t potentialNewValue) {
         controller->setMaxDirectorySizeBytes(potentialNewValue * 1024 * 1024);
     }
 
+    if (auto highFrequencyController = getGlobalHighFrequencyFTDCController()) {
+        highFrequencyController->setMaxDirectorySizeBytes(potentialNewValue * 1024 * 1024 /
+                                                          kHighFrequencyDirectorySizeDivisor);
+    }
+
     return Status::OK();
 }
 
@@ -148,6 +215,10 @@ Status onUpdateFTDCFileSize(const std::int32_t potentialNewValue) {
         controller->setMaxFileSizeBytes(potentialNewValue * 1024 * 1024);
     }
 
+    if (auto highFrequencyController = getGlobalHighFrequencyFTDCController()) {
+        highFrequencyController->setMaxFileSizeBytes(potentialNewValue * 1024 * 1024);
+    }
+
     return Status::OK();
 }
 
@@ -169,6 +240,46 @@ Status onUpdateFTDCPerInterimUpdate(const std::int32_t potentialNewValue) {
     return Status::OK();
 }
 
+Status onUpdateFTDCMetadataPeriod(const std::int32_t potentialNewValue) {
+    auto controller = getGlobalFTDCController();
+    if (controller) {
+        controller->setMetadataPeriod(Milliseconds(potentialNewValue));
+    }
+
+    return Status::OK();
+}
+
+Status onUpdateFTDCCpuProfileSampleHz(const std::int32_t potentialNewValue) {
+    // The profiler is started along with FTDC, after the server has forked, since interval timers
+    // are not inherited by child processes.
+    auto controller = getGlobalFTDCController();
+    if (controller) {
+        return SamplingProfiler::get().setSampleRate(potentialNewValue);
+    }
+
+    return Status::OK();
+}
+
+Status onUpdateFTDCHighFrequencyPeriod(const std::int32_t potentialNewValue) {
+    if (potentialNewValue > 0 && potentialNewValue < 10) {
+        return Status(ErrorCodes::BadValue,
+                      "diagnosticDataCollectionHighFrequencyPeriodMillis must be 0, which disables "
+                      "high-frequency collection, or at least 10");
+    }
+
+    auto highFrequencyController = getGlobalHighFrequencyFTDCController();
+    if (highFrequencyController) {
+        if (potentialNewValue == 0) {
+            return highFrequencyController->setEnabled(false);
+        }
+
+        highFrequencyController->setPeriod(Milliseconds(potentialNewValue));
+        return highFrequencyController->setEnabled(ftdcStartupParams.enabled.load());
+    }
+
+    return Status::OK();
+}
+
 FTDCSimpleInternalCommandCollector::FTDCSimpleInternalCommandCollector(StringData command,
                                                                        StringData name,
                                                                        StringData ns,
@@ -187,6 +298,44 @@ std::string FTDCSimpleInternalCommandCollector::name() const {
     return _name;
 }
 
+FTDCServerStatusMetricsCollector::FTDCServerStatusMetricsCollector(std::vector<std::string> paths)
+    : _paths(std::move(paths)) {
+    BSONObjBuilder specBuilder;
+    std::set<std::string> sections;
+    for (auto&& path : _paths) {
+        auto section = path.substr(0, path.find('.'));
+        if (!sections.insert(section).second) {
+            continue;
+        }
+
+        // Latency histograms are only generated on request, and are much of the point of sampling
+        // at a high frequency.
+        if (section == "opLatencies") {
+            specBuilder.append(section, BSON("histograms" << true));
+        } else {
+            specBuilder.append(section, true);
+        }
+    }
+    _sectionsSpec = specBuilder.obj();
+}
+
+void FTDCServerStatusMetricsCollector::collect(OperationContext* opCtx, BSONObjBuilder& builder) {
+    BSONObjBuilder sectionsBuilder;
+    appendServerStatusSections(opCtx, _sectionsSpec, &sectionsBuilder);
+    auto sections = sectionsBuilder.done();
+
+    for (auto&& path : _paths) {
+        auto elem = sections.getFieldDotted(path);
+        if (!elem.eoo()) {
+            builder.appendAs(elem, path);
+        }
+    }
+}
+
+std::string FTDCServerStatusMetricsCollector::name() const {
+    return "serverStatus";
+}
+
 // Register the FTDC system
 // Note: This must be run before the server parameters are parsed during startup
 // so that the FTDCController is initialized.
@@ -207,6 +356,7 @@ void startFTDC(boost::filesystem::path& path,
         ftdcStartupParams.maxSamplesPerArchiveMetricChunk.load();
     config.maxSamplesPerInterimMetricChunk =
         ftdcStartupParams.maxSamplesPerInterimMetricChunk.load();
+    config.metadataPeriod = Milliseconds(ftdcStartupParams.metadataPeriodMillis.load());
 
     ftdcDirectoryPathParameter = path;
 
@@ -236,6 +386,10 @@ void startFTDC(boost::filesystem::path& path,
     // Install System Metric Collector as a periodic collector
     installSystemMetricsCollector(controller.get());
 
+    // Install the CPU profile collectors, as a periodic collector and a periodic metadata
+    // collector
+    installCpuProfileCollectors(controller.get());
+
     // Install file rotation collectors
     // These are collected on each file rotation.
 
@@ -257,6 +411,34 @@ void startFTDC(boost::filesystem::path& path,
     staticFTDC = std::move(controller);
 
     staticFTDC->start();
+
+    // The high-frequency stream is written to a directory of its own, with its own period, and
+    // is only enabled along with FTDC once it is given a period.
+    const auto highFrequencyPeriodMillis = ftdcStartupParams.highFrequencyPeriodMillis.load();
+    FTDCConfig highFrequencyConfig = config;
+    highFrequencyConfig.enabled = config.enabled && highFrequencyPeriodMillis > 0;
+    if (highFrequencyPeriodMillis > 0) {
+        highFrequencyConfig.period = Milliseconds(highFrequencyPeriodMillis);
+    }
+    highFrequencyConfig.maxDirectorySizeBytes =
+        config.maxDirectorySizeBytes / kHighFrequencyDirectorySizeDivisor;
+    highFrequencyConfig.maxSamplesPerArchiveMetricChunk =
+        kHighFrequencySamplesPerArchiveMetricChunk;
+    highFrequencyConfig.maxSamplesPerInterimMetricChunk =
+        kHighFrequencySamplesPerInterimMetricChunk;
+
+    auto highFrequencyController = std::make_unique<FTDCController>(
+        getHighFrequencyPath(path), highFrequencyConfig, "ftdcHighFrequency"_sd);
+
+    highFrequencyController->addPeriodicCollector(
+        std::make_unique<FTDCServerStatusMetricsCollector>(
+            parseHighFrequencyMetrics(gFTDCHighFrequencyMetrics)));
+
+    auto& staticHighFrequencyFTDC = getHighFrequencyFTDCController(getGlobalServiceContext());
+
+    staticHighFrequencyFTDC = std::move(highFrequencyController);
+
+    staticHighFrequencyFTDC->start();
 }
 
 void stopFTDC() {
@@ -265,6 +447,12 @@ void stopFTDC() {
     if (controller) {
         controller->stop();
     }
+
+    if (auto highFrequencyController = getGlobalHighFrequencyFTDCController()) {
+        highFrequencyController->stop();
+    }
+
+    SamplingProfiler::get().setSampleRate(0).ignore();
 }
 
 FTDCController* FTDCController::get(ServiceContext* serviceContext) {
@@ -31,6 +31,7 @@
 
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/commands.h"
@@ -98,6 +99,26 @@ private:
     const OpMsgRequest _request;
 };
 
+/**
+ * An FTDC Collector that samples a fixed list of serverStatus metrics, given as dotted paths such
+ * as "wiredTiger.cache". Only the sections the paths belong to are generated, without going
+ * through the serverStatus command, so it is cheap enough to run many times a second. Paths which
+ * are missing from the sections are left out.
+ */
+class FTDCServerStatusMetricsCollector : public FTDCCollectorInterface {
+public:
+    explicit FTDCServerStatusMetricsCollector(std::vector<std::string> paths);
+
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) override;
+    std::string name() const override;
+
+private:
+    const std::vector<std::string> _paths;
+
+    // The sections the paths belong to, as a serverStatus specification.
+    BSONObj _sectionsSpec;
+};
+
 /**
  * FTDC startup parameters.
  *
@@ -111,6 +132,9 @@ struct FTDCStartupParams {
     AtomicWord<int> maxFileSizeMB;
     AtomicWord<int> maxSamplesPerArchiveMetricChunk;
     AtomicWord<int> maxSamplesPerInterimMetricChunk;
+    AtomicWord<int> metadataPeriodMillis;
+    AtomicWord<int> cpuProfileSampleHz;
+    AtomicWord<int> highFrequencyPeriodMillis;
 
     FTDCStartupParams()
         : enabled(FTDCConfig::kEnabledDefault),
@@ -119,7 +143,10 @@ struct FTDCStartupParams {
           maxDirectorySizeMB(FTDCConfig::kMaxDirectorySizeBytesDefault / (1024 * 1024)),
           maxFileSizeMB(FTDCConfig::kMaxFileSizeBytesDefault / (1024 * 1024)),
           maxSamplesPerArchiveMetricChunk(FTDCConfig::kMaxSamplesPerArchiveMetricChunkDefault),
-          maxSamplesPerInterimMetricChunk(FTDCConfig::kMaxSamplesPerInterimMetricChunkDefault) {}
+          maxSamplesPerInterimMetricChunk(FTDCConfig::kMaxSamplesPerInterimMetricChunkDefault),
+          metadataPeriodMillis(FTDCConfig::kMetadataPeriodMillisDefault),
+          cpuProfileSampleHz(0),
+          highFrequencyPeriodMillis(0) {}
 };
 
 extern FTDCStartupParams ftdcStartupParams;
@@ -133,6 +160,9 @@ Status onUpdateFTDCDirectorySize(const std::int32_t value);
 Status onUpdateFTDCFileSize(const std::int32_t value);
 Status onUpdateFTDCSamplesPerChunk(const std::int32_t value);
 Status onUpdateFTDCPerInterimUpdate(const std::int32_t value);
+Status onUpdateFTDCMetadataPeriod(const std::int32_t value);
+Status onUpdateFTDCCpuProfileSampleHz(const std::int32_t value);
+Status onUpdateFTDCHighFrequencyPeriod(const std::int32_t value);
 
 /**
  * Server Parameter accessors
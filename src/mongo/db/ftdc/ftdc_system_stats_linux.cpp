@@ -40,6 +40,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/controller.h"
+#include "mongo/util/concurrency/numa_placement.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/procparser.h"
 
@@ -74,12 +75,27 @@ static const std::vector<StringData> kNetstatKeys{
     "IpExt:"_sd,
 };
 
+// local_node and other_node count the allocations made by threads running on the node itself and on
+// other nodes, which is where the remote memory traffic of a NUMA machine comes from.
+static const std::vector<StringData> kNumaKeys{
+    "numa_hit"_sd,
+    "numa_miss"_sd,
+    "numa_foreign"_sd,
+    "interleave_hit"_sd,
+    "local_node"_sd,
+    "other_node"_sd,
+};
+
+constexpr auto kSysNodePath = "/sys/devices/system/node"_sd;
+
 /**
  *  Collect metrics from the Linux /proc file system.
  */
 class LinuxSystemMetricsCollector final : public SystemMetricsCollector {
 public:
-    LinuxSystemMetricsCollector() : _disks(procparser::findPhysicalDisks("/sys/block"_sd)) {
+    LinuxSystemMetricsCollector()
+        : _disks(procparser::findPhysicalDisks("/sys/block"_sd)),
+          _numaNodes(procparser::findNumaNodes(kSysNodePath)) {
         for (const auto& disk : _disks) {
             _disksStringData.emplace_back(disk);
         }
@@ -127,6 +143,27 @@ public:
                                 &subObjBuilder);
             subObjBuilder.doneFast();
         }
+
+        // Skip the numa section on machines with a single node.
+        if (_numaNodes.size() > 1) {
+            BSONObjBuilder subObjBuilder(builder.subobjStart("numa"_sd));
+            {
+                BSONObjBuilder placementBuilder(subObjBuilder.subobjStart("placement"_sd));
+                NumaPlacement::get().appendStats(&placementBuilder);
+            }
+
+            for (const auto& node : _numaNodes) {
+                BSONObjBuilder nodeBuilder(subObjBuilder.subobjStart(node));
+                processStatusErrors(
+                    procparser::parseProcMemInfoFile(
+                        str::stream() << kSysNodePath << "/" << node << "/numastat",
+                        kNumaKeys,
+                        &nodeBuilder),
+                    &nodeBuilder);
+                nodeBuilder.doneFast();
+            }
+            subObjBuilder.doneFast();
+        }
     }
 
 private:
@@ -135,6 +172,9 @@ private:
 
     // List of physical disks to collect stats from as StringData to pass to parseProcDiskStatsFile.
     std::vector<StringData> _disksStringData;
+
+    // List of NUMA nodes, such as "node0", to collect allocation stats from.
+    std::vector<std::string> _numaNodes;
 };
 
 }  // namespace
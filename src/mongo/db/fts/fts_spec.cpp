@@ -31,12 +31,15 @@
 
 #include "mongo/db/fts/fts_spec.h"
 
+#include <memory>
+
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/fts/fts_element_iterator.h"
 #include "mongo/db/fts/fts_tokenizer.h"
 #include "mongo/db/fts/fts_util.h"
 #include "mongo/db/matcher/expression_parser.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -52,6 +55,20 @@ const double MAX_WEIGHT = 1000000000;
 const double MAX_WORD_WEIGHT = MAX_WEIGHT / 10000;
 
 namespace {
+/**
+ * Returns a tokenizer for 'language' which belongs to the calling thread. Creating a tokenizer
+ * builds a Snowball stemmer, which costs more than tokenizing a typical indexed string, so the
+ * indexing of text fields reuses one tokenizer per language and thread.
+ */
+FTSTokenizer* getThreadTokenizer(const FTSLanguage* language) {
+    thread_local stdx::unordered_map<const FTSLanguage*, std::unique_ptr<FTSTokenizer>> tokenizers;
+    auto& tokenizer = tokenizers[language];
+    if (!tokenizer) {
+        tokenizer = language->createTokenizer();
+    }
+    return tokenizer.get();
+}
+
 // Default language.  Used for new indexes.
 const std::string moduleDefaultLanguage("english");
 
@@ -179,8 +196,7 @@ void FTSSpec::scoreDocument(const BSONObj& obj, TermFrequencyMap* term_freqs) co
 
     while (it.more()) {
         FTSIteratorValue val = it.next();
-        std::unique_ptr<FTSTokenizer> tokenizer(val._language->createTokenizer());
-        _scoreStringV2(tokenizer.get(), val._text, term_freqs, val._weight);
+        _scoreStringV2(getThreadTokenizer(val._language), val._text, term_freqs, val._weight);
     }
 }
 
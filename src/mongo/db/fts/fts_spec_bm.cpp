@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <type_traits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/fts/fts_spec.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace fts {
+namespace {
+
+struct CorpusEntry {
+    const char* language;
+    const char* text;
+};
+
+const CorpusEntry kCorpus[] = {
+    {"english",
+     "The quick brown foxes were jumping over the lazy dogs while the farmers watched them "
+     "running through the fields and across the rivers towards the distant mountains."},
+    {"french",
+     "Les renards bruns rapides sautaient par-dessus les chiens paresseux pendant que les "
+     "fermiers les regardaient courir à travers les champs et les rivières."},
+    {"german",
+     "Die schnellen braunen Füchse sprangen über die faulen Hunde, während die Bauern ihnen "
+     "zusahen, wie sie durch die Felder und über die Flüsse liefen."},
+    {"spanish",
+     "Los zorros marrones rápidos saltaban sobre los perros perezosos mientras los granjeros "
+     "los miraban correr por los campos y a través de los ríos."},
+    {"russian",
+     "Быстрые бурые лисы прыгали через ленивых собак, пока фермеры смотрели, как они бегут "
+     "по полям и через реки к далёким горам."},
+    {"turkish",
+     "Hızlı kahverengi tilkiler tembel köpeklerin üzerinden atlarken çiftçiler onların "
+     "tarlalardan ve nehirlerden uzak dağlara doğru koştuklarını izliyordu."},
+};
+
+std::vector<BSONObj> makeDocuments(size_t numLanguages) {
+    invariant(numLanguages > 0 && numLanguages <= std::extent<decltype(kCorpus)>::value);
+
+    std::vector<BSONObj> docs;
+    for (size_t i = 0; i < numLanguages; ++i) {
+        docs.push_back(BSON("title" << kCorpus[i].text << "body" << kCorpus[i].text << "language"
+                                    << kCorpus[i].language));
+    }
+    return docs;
+}
+
+FTSSpec makeSpec(int textIndexVersion) {
+    BSONObj indexSpec = BSON("key" << BSON("title"
+                                           << "text"
+                                           << "body"
+                                           << "text")
+                                   << "textIndexVersion" << textIndexVersion);
+    return FTSSpec(uassertStatusOK(FTSSpec::fixSpec(indexSpec)));
+}
+
+// Scores documents the way a text index build does, cycling through 'range(1)' languages so that
+// the cost of switching tokenizers and stemmers between documents shows up.
+void BM_ScoreDocument(benchmark::State& state) {
+    const FTSSpec spec = makeSpec(state.range(0));
+    const auto docs = makeDocuments(state.range(1));
+
+    size_t i = 0;
+    for (auto keepRunning : state) {
+        TermFrequencyMap termFreqs;
+        spec.scoreDocument(docs[i++ % docs.size()], &termFreqs);
+        benchmark::DoNotOptimize(termFreqs);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ScoreDocument)
+    ->Args({TEXT_INDEX_VERSION_2, 1})
+    ->Args({TEXT_INDEX_VERSION_2, 6})
+    ->Args({TEXT_INDEX_VERSION_3, 1})
+    ->Args({TEXT_INDEX_VERSION_3, 6});
+
+}  // namespace
+}  // namespace fts
+}  // namespace mongo
@@ -592,5 +592,36 @@ TEST(FTSSpec, TextIndexLegacyLanguageRecognition) {
         ASSERT_EQUALS(tfm.size(), 0U);  // "the" recognized as stopword
     }
 }
+
+// Tokenizers are reused across documents, so scoring a document must not depend on the documents
+// scored before it.
+TEST(FTSSpec, ScoreDocumentIsIndependentOfPreviouslyScoredDocuments) {
+    BSONObj indexSpec = BSON("key" << BSON("a"
+                                           << "text"));
+    FTSSpec spec(assertGet(FTSSpec::fixSpec(indexSpec)));
+
+    BSONObj english = fromjson("{a: 'the walking dogs walked'}");
+    BSONObj lang = fromjson("{a: 'i cani camminano', language: 'italian'}");
+
+    TermFrequencyMap first;
+    spec.scoreDocument(english, &first);
+
+    TermFrequencyMap other;
+    spec.scoreDocument(lang, &other);
+    ASSERT_FALSE(other.empty());
+    ASSERT(other.find("walk") == other.end());
+
+    TermFrequencyMap second;
+    spec.scoreDocument(english, &second);
+    ASSERT_EQUALS(first.size(), 2U);
+    ASSERT(first.find("walk") != first.end());
+    ASSERT(first.find("dog") != first.end());
+    ASSERT_EQUALS(second.size(), first.size());
+    for (auto&& term : first) {
+        auto it = second.find(term.first);
+        ASSERT(it != second.end());
+        ASSERT_EQUALS(it->second, term.second);
+    }
+}
 }  // namespace fts
 }  // namespace mongo
@@ -0,0 +1,156 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/oid.h"
+#include "mongo/db/index/btree_key_generator.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+namespace {
+
+const int kBatchSize = 500;
+
+BSONObj makeRecord(int i) {
+    BSONObjBuilder builder;
+    builder.append("_id", OID::gen());
+    for (int field = 0; field < 16; ++field) {
+        builder.append("field" + std::to_string(field), "value" + std::to_string(i * field));
+    }
+    return builder.obj();
+}
+
+std::vector<BSONObj> makeBatch() {
+    std::vector<BSONObj> batch;
+    for (int i = 0; i < kBatchSize; ++i) {
+        batch.push_back(makeRecord(i));
+    }
+    return batch;
+}
+
+/**
+ * Builds one single-field ascending key generator per index, keyed on 'field0', 'field1', ...
+ */
+std::vector<std::unique_ptr<BtreeKeyGenerator>> makeGenerators(int numIndexes,
+                                                               std::vector<std::string>* names) {
+    names->clear();
+    for (int i = 0; i < numIndexes; ++i) {
+        names->push_back("field" + std::to_string(i));
+    }
+
+    std::vector<std::unique_ptr<BtreeKeyGenerator>> generators;
+    for (const auto& name : *names) {
+        generators.push_back(
+            std::make_unique<BtreeKeyGenerator>(std::vector<const char*>{name.c_str()},
+                                                std::vector<BSONElement>{BSONElement()},
+                                                false /* isSparse */,
+                                                nullptr /* collator */,
+                                                KeyString::Version::kLatestVersion,
+                                                Ordering::make(BSON(name << 1))));
+    }
+    return generators;
+}
+
+void generateKeys(const BtreeKeyGenerator& generator, const std::vector<BSONObj>& batch) {
+    for (size_t i = 0; i < batch.size(); ++i) {
+        KeyStringSet keys;
+        MultikeyPaths multikeyPaths;
+        generator.getKeys(batch[i], &keys, &multikeyPaths, RecordId(i + 1));
+        benchmark::DoNotOptimize(keys.size());
+    }
+}
+
+/**
+ * Generates the keys of every index for the whole batch on the calling thread, as a single
+ * insert does with 'maxInsertKeyGenerationThreads' set to 1.
+ */
+void BM_generateKeysSerial(benchmark::State& state) {
+    std::vector<std::string> names;
+    const auto generators = makeGenerators(state.range(0), &names);
+    const auto batch = makeBatch();
+
+    for (auto _ : state) {
+        for (const auto& generator : generators) {
+            generateKeys(*generator, batch);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batch.size());
+}
+
+/**
+ * Splits the indexes across a thread pool, with each thread generating the keys of its indexes
+ * for the whole batch, as the insert path does when 'maxInsertKeyGenerationThreads' is raised.
+ */
+void BM_generateKeysParallel(benchmark::State& state) {
+    std::vector<std::string> names;
+    const auto generators = makeGenerators(state.range(0), &names);
+    const auto batch = makeBatch();
+    const size_t numThreads = std::min<size_t>(state.range(1), generators.size());
+
+    ThreadPool::Options options;
+    options.poolName = "KeyGenerationBenchmark";
+    options.minThreads = numThreads;
+    options.maxThreads = numThreads;
+    ThreadPool pool(options);
+    pool.startup();
+
+    for (auto _ : state) {
+        for (size_t thread = 0; thread < numThreads; ++thread) {
+            pool.schedule([&, thread](Status status) {
+                invariant(status);
+                for (size_t i = thread; i < generators.size(); i += numThreads) {
+                    generateKeys(*generators[i], batch);
+                }
+            });
+        }
+        pool.waitForIdle();
+    }
+    state.SetItemsProcessed(state.iterations() * batch.size());
+
+    pool.shutdown();
+    pool.join();
+}
+
+}  // namespace
+
+BENCHMARK(BM_generateKeysSerial)->Arg(1)->Arg(4)->Arg(8)->Arg(16);
+BENCHMARK(BM_generateKeysParallel)
+    ->Args({4, 2})
+    ->Args({4, 4})
+    ->Args({8, 4})
+    ->Args({8, 8})
+    ->Args({16, 4})
+    ->Args({16, 8});
+
+}  // namespace mongo
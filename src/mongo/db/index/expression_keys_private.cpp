@@ -405,10 +405,15 @@ void ExpressionKeysPrivate::getHashKeys(const BSONObj& obj,
         if (fieldVal.eoo()) {
             fieldVal = nullObj.firstElement();
         } else {
-            BSONObjBuilder bob;
-            CollationIndexKey::collationAwareIndexKeyAppend(fieldVal, collator, &bob);
-            fieldValObj = bob.obj();
-            fieldVal = fieldValObj.firstElement();
+            // Neither the hash nor the KeyString encoding depends on the field name, so a value
+            // which the collation cannot affect is used in place rather than copied into a new
+            // BSONObj.
+            if (collator && CollationIndexKey::isCollatableType(fieldVal.type())) {
+                BSONObjBuilder bob;
+                CollationIndexKey::collationAwareIndexKeyAppend(fieldVal, collator, &bob);
+                fieldValObj = bob.obj();
+                fieldVal = fieldValObj.firstElement();
+            }
             hasFieldValue = true;
         }
 
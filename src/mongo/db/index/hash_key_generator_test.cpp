@@ -177,6 +177,31 @@ TEST(HashKeyGeneratorTest, CollationAppliedforAllIndexFields) {
     ASSERT(assertKeysetsEqual(expectedKeys, actualKeys));
 }
 
+TEST(HashKeyGeneratorTest, CollationDoesNotAffectNonStringFieldsInCompoundIndex) {
+    BSONObj obj = fromjson("{a: {b: 1.5, c: {$date: 0}}, d: null}");
+    KeyStringSet actualKeys;
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+
+    BSONObj indexSpec = fromjson("{'a.b': 1, 'a.c': 'hashed', d: -1}");
+    ExpressionKeysPrivate::getHashKeys(obj,
+                                       indexSpec,
+                                       kHashSeed,
+                                       kHashVersion,
+                                       false,
+                                       &collator,
+                                       &actualKeys,
+                                       KeyString::Version::kLatestVersion,
+                                       Ordering::make(BSONObj()));
+
+    KeyStringSet expectedKeys;
+    KeyString::HeapBuilder keyString(KeyString::Version::kLatestVersion, Ordering::make(BSONObj()));
+    keyString.appendBSONElement(obj["a"]["b"]);
+    keyString.appendNumberLong(BSONElementHasher::hash64(obj["a"]["c"], kHashSeed));
+    keyString.appendBSONElement(obj["d"]);
+    expectedKeys.insert(keyString.release());
+    ASSERT(assertKeysetsEqual(expectedKeys, actualKeys));
+}
+
 TEST(HashKeyGeneratorTest, NoCollation) {
     BSONObj obj = fromjson("{a: 'string'}");
     KeyStringSet actualKeys;
@@ -287,6 +287,12 @@ bool AbstractIndexAccessMethod::appendCustomStats(OperationContext* opCtx,
     return _newInterface->appendCustomStats(opCtx, output, scale);
 }
 
+bool AbstractIndexAccessMethod::appendCacheStats(OperationContext* opCtx,
+                                                 BSONObjBuilder* output,
+                                                 double scale) const {
+    return _newInterface->appendCacheStats(opCtx, output, scale);
+}
+
 long long AbstractIndexAccessMethod::getSpaceUsedBytes(OperationContext* opCtx) const {
     return _newInterface->getSpaceUsedBytes(opCtx);
 }
@@ -173,6 +173,18 @@ public:
                                    BSONObjBuilder* result,
                                    double scale) const = 0;
 
+    /**
+     * Add a summary of how much of this index is resident in the storage engine's cache to BSON
+     * object builder.
+     *
+     * 'scale' is a scaling factor to apply to all byte statistics.
+     *
+     * Returns true if stats were appended.
+     */
+    virtual bool appendCacheStats(OperationContext* opCtx,
+                                  BSONObjBuilder* result,
+                                  double scale) const = 0;
+
     /**
      * @return The number of bytes consumed by this index.
      *         Exactly what is counted is not defined based on padding, re-use, etc...
@@ -481,6 +493,10 @@ public:
                            BSONObjBuilder* result,
                            double scale) const final;
 
+    bool appendCacheStats(OperationContext* opCtx,
+                          BSONObjBuilder* result,
+                          double scale) const final;
+
     long long getSpaceUsedBytes(OperationContext* opCtx) const final;
 
     RecordId findSingle(OperationContext* opCtx, const BSONObj& key) const final;
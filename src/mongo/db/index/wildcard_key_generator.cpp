@@ -43,20 +43,28 @@ static const BSONObj kDefaultProjection = BSON("_id"_sd << 0);
 
 // If the enclosing object is an array, then the current element's fieldname is the array index, so
 // we omit this when computing the full path. Otherwise, the full path is the pathPrefix plus the
-// element's fieldname.
-void pushPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* pathPrefix) {
+// element's fieldname. Every component, including the first, is prefixed with a '.' so that empty
+// fieldnames still produce distinct path components; see fullPathOf(). Returns the length of the
+// prefix, so that the caller can restore it.
+size_t pushPathComponent(BSONElement elem, bool enclosingObjIsArray, std::string* pathPrefix) {
+    const auto prefixLength = pathPrefix->size();
     if (!enclosingObjIsArray) {
-        pathPrefix->appendPart(elem.fieldNameStringData());
+        pathPrefix->push_back('.');
+        const auto fieldName = elem.fieldNameStringData();
+        pathPrefix->append(fieldName.rawData(), fieldName.size());
     }
+    return prefixLength;
 }
 
-// If the enclosing object is not an array, then the final path component should be its field name.
-// Verify that this is the case and then pop it off the FieldRef.
-void popPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* pathToElem) {
-    if (!enclosingObjIsArray) {
-        invariant(pathToElem->getPart(pathToElem->numParts() - 1) == elem.fieldNameStringData());
-        pathToElem->removeLastPart();
-    }
+// Truncates the path back to the prefix it had before the matching call to pushPathComponent().
+void popPathComponent(size_t prefixLength, std::string* pathToElem) {
+    invariant(prefixLength <= pathToElem->size());
+    pathToElem->resize(prefixLength);
+}
+
+// Returns the dotted path to the current element, without the leading '.' of its first component.
+StringData fullPathOf(const std::string& path) {
+    return StringData(path).substr(1);
 }
 }  // namespace
 
@@ -107,14 +115,14 @@ void WildcardKeyGenerator::generateKeys(BSONObj inputDoc,
                                         KeyStringSet* keys,
                                         KeyStringSet* multikeyPaths,
                                         boost::optional<RecordId> id) const {
-    FieldRef rootPath;
+    std::string rootPath;
     _traverseWildcard(
         _projExec->applyProjection(inputDoc), false, &rootPath, keys, multikeyPaths, id);
 }
 
 void WildcardKeyGenerator::_traverseWildcard(BSONObj obj,
                                              bool objIsArray,
-                                             FieldRef* path,
+                                             std::string* path,
                                              KeyStringSet* keys,
                                              KeyStringSet* multikeyPaths,
                                              boost::optional<RecordId> id) const {
@@ -124,19 +132,20 @@ void WildcardKeyGenerator::_traverseWildcard(BSONObj obj,
             continue;
 
         // Append the element's fieldname to the path, if the enclosing object is not an array.
-        pushPathComponent(elem, objIsArray, path);
+        const auto prefixLength = pushPathComponent(elem, objIsArray, path);
+        const auto fullPath = fullPathOf(*path);
 
         switch (elem.type()) {
             case BSONType::Array:
                 // If this is a nested array, we don't descend it but instead index it as a value.
-                if (_addKeyForNestedArray(elem, *path, objIsArray, keys, id))
+                if (_addKeyForNestedArray(elem, fullPath, objIsArray, keys, id))
                     break;
 
                 // Add an entry for the multi-key path, and then fall through to BSONType::Object.
-                _addMultiKey(*path, multikeyPaths);
+                _addMultiKey(fullPath, multikeyPaths);
 
             case BSONType::Object:
-                if (_addKeyForEmptyLeaf(elem, *path, keys, id))
+                if (_addKeyForEmptyLeaf(elem, fullPath, keys, id))
                     break;
 
                 _traverseWildcard(
@@ -144,16 +153,16 @@ void WildcardKeyGenerator::_traverseWildcard(BSONObj obj,
                 break;
 
             default:
-                _addKey(elem, *path, keys, id);
+                _addKey(elem, fullPath, keys, id);
         }
 
         // Remove the element's fieldname from the path, if it was pushed onto it earlier.
-        popPathComponent(elem, objIsArray, path);
+        popPathComponent(prefixLength, path);
     }
 }
 
 bool WildcardKeyGenerator::_addKeyForNestedArray(BSONElement elem,
-                                                 const FieldRef& fullPath,
+                                                 StringData fullPath,
                                                  bool enclosingObjIsArray,
                                                  KeyStringSet* keys,
                                                  boost::optional<RecordId> id) const {
@@ -166,7 +175,7 @@ bool WildcardKeyGenerator::_addKeyForNestedArray(BSONElement elem,
 }
 
 bool WildcardKeyGenerator::_addKeyForEmptyLeaf(BSONElement elem,
-                                               const FieldRef& fullPath,
+                                               StringData fullPath,
                                                KeyStringSet* keys,
                                                boost::optional<RecordId> id) const {
     invariant(elem.isABSONObj());
@@ -180,12 +189,12 @@ bool WildcardKeyGenerator::_addKeyForEmptyLeaf(BSONElement elem,
 }
 
 void WildcardKeyGenerator::_addKey(BSONElement elem,
-                                   const FieldRef& fullPath,
+                                   StringData fullPath,
                                    KeyStringSet* keys,
                                    boost::optional<RecordId> id) const {
     // Wildcard keys are of the form { "": "path.to.field", "": <collation-aware value> }.
     KeyString::HeapBuilder keyString(_keyStringVersion, _ordering);
-    keyString.appendString(fullPath.dottedField());
+    keyString.appendString(fullPath);
     if (_collator && elem) {
         keyString.appendBSONElement(elem, [&](StringData stringData) {
             return _collator->getComparisonString(stringData);
@@ -202,13 +211,13 @@ void WildcardKeyGenerator::_addKey(BSONElement elem,
     keys->insert(keyString.release());
 }
 
-void WildcardKeyGenerator::_addMultiKey(const FieldRef& fullPath,
+void WildcardKeyGenerator::_addMultiKey(StringData fullPath,
                                         KeyStringSet* multikeyPaths) const {
     // Multikey paths are denoted by a key of the form { "": 1, "": "path.to.array" }. The argument
     // 'multikeyPaths' may be nullptr if the access method is being used in an operation which does
     // not require multikey path generation.
     if (multikeyPaths) {
-        auto key = BSON("" << 1 << "" << fullPath.dottedField());
+        auto key = BSON("" << 1 << "" << fullPath);
         KeyString::HeapBuilder keyString(
             _keyStringVersion,
             key,
@@ -81,29 +81,32 @@ public:
                       boost::optional<RecordId> id = boost::none) const;
 
 private:
-    // Traverses every path of the post-projection document, adding keys to the set as it goes.
+    // Traverses every path of the post-projection document, adding keys to the set as it goes. The
+    // dotted 'path' to the current object is extended and truncated in place as the traversal
+    // descends into and returns from each field, so that wide documents do not pay for a new path
+    // string per indexed leaf.
     void _traverseWildcard(BSONObj obj,
                            bool objIsArray,
-                           FieldRef* path,
+                           std::string* path,
                            KeyStringSet* keys,
                            KeyStringSet* multikeyPaths,
                            boost::optional<RecordId> id) const;
 
     // Helper functions to format the entry appropriately before adding it to the key/path tracker.
-    void _addMultiKey(const FieldRef& fullPath, KeyStringSet* multikeyPaths) const;
+    void _addMultiKey(StringData fullPath, KeyStringSet* multikeyPaths) const;
     void _addKey(BSONElement elem,
-                 const FieldRef& fullPath,
+                 StringData fullPath,
                  KeyStringSet* keys,
                  boost::optional<RecordId> id) const;
 
     // Helper to check whether the element is a nested array, and conditionally add it to 'keys'.
     bool _addKeyForNestedArray(BSONElement elem,
-                               const FieldRef& fullPath,
+                               StringData fullPath,
                                bool enclosingObjIsArray,
                                KeyStringSet* keys,
                                boost::optional<RecordId> id) const;
     bool _addKeyForEmptyLeaf(BSONElement elem,
-                             const FieldRef& fullPath,
+                             StringData fullPath,
                              KeyStringSet* keys,
                              boost::optional<RecordId> id) const;
 
@@ -327,6 +327,33 @@ TEST(WildcardKeyGeneratorFullDocumentTest, ExtractMixedPathTypesAndAllSubpaths)
     ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
 }
 
+TEST(WildcardKeyGeneratorFullDocumentTest, PathIsRestoredAfterEachSiblingField) {
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"),
+                                {},
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSONObj())};
+    auto inputDoc =
+        fromjson("{longFieldName: {b: {c: 1}, d: [{e: 2}]}, f: 3, g: {'': 4, h: {'': {i: 5}}}}");
+
+    auto expectedKeys = makeKeySet({fromjson("{'': 'longFieldName.b.c', '': 1}"),
+                                    fromjson("{'': 'longFieldName.d.e', '': 2}"),
+                                    fromjson("{'': 'f', '': 3}"),
+                                    fromjson("{'': 'g.', '': 4}"),
+                                    fromjson("{'': 'g.h..i', '': 5}")});
+
+    auto expectedMultikeyPaths =
+        makeKeySet({fromjson("{'': 1, '': 'longFieldName.d'}")},
+                   RecordId{RecordId::ReservedId::kWildcardMultikeyMetadataId});
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
 // Single-subtree implicit projection.
 
 TEST(WildcardKeyGeneratorSingleSubtreeTest, ExtractSubtreeWithSinglePathComponent) {
@@ -312,6 +312,7 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
             lv2Config._consoleEnabled = false;
             lv2Config._fileEnabled = true;
             lv2Config._filePath = absoluteLogpath;
+            lv2Config._fileAsync = serverGlobalParams.logAsyncWrites;
             lv2Config._fileRotationMode = serverGlobalParams.logRenameOnRotate
                 ? logv2::LogDomainGlobal::ConfigurationOptions::RotationMode::kRename
                 : logv2::LogDomainGlobal::ConfigurationOptions::RotationMode::kReopen;
@@ -66,9 +66,11 @@ LogicalSessionCacheImpl::LogicalSessionCacheImpl(std::unique_ptr<ServiceLiaison>
     _stats.setLastTransactionReaperJobTimestamp(_service->now());
 
     if (!disableLogicalSessionCacheRefresh) {
-        _service->scheduleJob({"LogicalSessionCacheRefresh",
-                               [this](Client* client) { _periodicRefresh(client); },
-                               Milliseconds(logicalSessionRefreshMillis)});
+        _service->scheduleJob(
+            {"LogicalSessionCacheRefresh",
+             [this](Client* client) { _periodicRefresh(client); },
+             Milliseconds(std::max(
+                 1, logicalSessionRefreshMillis / logicalSessionRefreshDeltasPerInterval))});
 
         _service->scheduleJob({"LogicalSessionCacheReap",
                                [this](Client* client) { _periodicReap(client); },
@@ -104,7 +106,7 @@ Status LogicalSessionCacheImpl::vivify(OperationContext* opCtx, const LogicalSes
 
 Status LogicalSessionCacheImpl::refreshNow(Client* client) {
     try {
-        _refresh(client);
+        _refresh(client, RefreshType::kFull);
     } catch (...) {
         return exceptionToStatus();
     }
@@ -121,8 +123,17 @@ size_t LogicalSessionCacheImpl::size() {
 }
 
 void LogicalSessionCacheImpl::_periodicRefresh(Client* client) {
+    // Spread the writes of each refresh interval over several delta refreshes, the last of which
+    // is a full refresh so that long-running sessions do not expire.
+    auto refreshType = RefreshType::kFull;
+    if (++_refreshesSinceFullRefresh < logicalSessionRefreshDeltasPerInterval) {
+        refreshType = RefreshType::kDelta;
+    } else {
+        _refreshesSinceFullRefresh = 0;
+    }
+
     try {
-        _refresh(client);
+        _refresh(client, refreshType);
     } catch (...) {
         log() << "Failed to refresh session cache: " << exceptionToStatus()
               << ", will try again at the next refresh interval";
@@ -206,7 +217,7 @@ Status LogicalSessionCacheImpl::_reap(Client* client) {
     return Status::OK();
 }
 
-void LogicalSessionCacheImpl::_refresh(Client* client) {
+void LogicalSessionCacheImpl::_refresh(Client* client, RefreshType refreshType) {
     // Stats for serverStatus:
     {
         stdx::lock_guard<Latch> lk(_mutex);
@@ -216,8 +227,10 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
         _stats.setLastSessionsCollectionJobEntriesRefreshed(0);
         _stats.setLastSessionsCollectionJobEntriesEnded(0);
         _stats.setLastSessionsCollectionJobCursorsClosed(0);
+        _stats.setLastSessionsCollectionJobEntriesCheckedForRemoval(0);
 
         // Start the new run.
+        _stats.setLastSessionsCollectionJobWasDelta(refreshType == RefreshType::kDelta);
         _stats.setLastSessionsCollectionJobTimestamp(_service->now());
         _stats.setSessionsCollectionJobCount(_stats.getSessionsCollectionJobCount() + 1);
     }
@@ -285,14 +298,16 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
     // Refresh all recently active sessions as well as for sessions attached to running ops
     LogicalSessionRecordSet activeSessionRecords;
 
-    auto runningOpSessions = _service->getActiveOpSessions();
+    if (refreshType == RefreshType::kFull) {
+        auto runningOpSessions = _service->getActiveOpSessions();
 
-    for (const auto& it : runningOpSessions) {
-        // if a running op is the cause of an upsert, we won't have a user name for the record
-        if (explicitlyEndingSessions.count(it) > 0) {
-            continue;
+        for (const auto& it : runningOpSessions) {
+            // if a running op is the cause of an upsert, we won't have a user name for the record
+            if (explicitlyEndingSessions.count(it) > 0) {
+                continue;
+            }
+            activeSessionRecords.insert(makeLogicalSessionRecord(it, _service->now()));
         }
-        activeSessionRecords.insert(makeLogicalSessionRecord(it, _service->now()));
     }
     for (const auto& it : activeSessions) {
         activeSessionRecords.insert(it.second);
@@ -304,6 +319,8 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
     {
         stdx::lock_guard<Latch> lk(_mutex);
         _stats.setLastSessionsCollectionJobEntriesRefreshed(activeSessionRecords.size());
+        _stats.setSessionsCollectionJobEntriesRefreshedTotal(
+            _stats.getSessionsCollectionJobEntriesRefreshedTotal() + activeSessionRecords.size());
     }
 
     // Remove the ending sessions from the sessions collection.
@@ -319,30 +336,35 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
 
     KillAllSessionsByPatternSet patterns;
 
-    auto openCursorSessions = _service->getOpenCursorSessions(opCtx);
-    // Exclude sessions added to _activeSessions from the openCursorSession to avoid race between
-    // killing cursors on the removed sessions and creating sessions.
-    {
-        stdx::lock_guard<Latch> lk(_mutex);
+    if (refreshType == RefreshType::kFull) {
+        auto openCursorSessions = _service->getOpenCursorSessions(opCtx);
+        // Exclude sessions added to _activeSessions from the openCursorSession to avoid race
+        // between killing cursors on the removed sessions and creating sessions.
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
 
-        for (const auto& it : _activeSessions) {
-            auto newSessionIt = openCursorSessions.find(it.first);
-            if (newSessionIt != openCursorSessions.end()) {
-                openCursorSessions.erase(newSessionIt);
+            for (const auto& it : _activeSessions) {
+                auto newSessionIt = openCursorSessions.find(it.first);
+                if (newSessionIt != openCursorSessions.end()) {
+                    openCursorSessions.erase(newSessionIt);
+                }
             }
+
+            _stats.setLastSessionsCollectionJobEntriesCheckedForRemoval(openCursorSessions.size());
         }
-    }
 
-    // think about pruning ending and active out of openCursorSessions
-    auto statusAndRemovedSessions = _sessionsColl->findRemovedSessions(opCtx, openCursorSessions);
+        // think about pruning ending and active out of openCursorSessions
+        auto statusAndRemovedSessions =
+            _sessionsColl->findRemovedSessions(opCtx, openCursorSessions);
 
-    if (statusAndRemovedSessions.isOK()) {
-        auto removedSessions = statusAndRemovedSessions.getValue();
-        for (const auto& lsid : removedSessions) {
-            patterns.emplace(makeKillAllSessionsByPattern(opCtx, lsid));
+        if (statusAndRemovedSessions.isOK()) {
+            auto removedSessions = statusAndRemovedSessions.getValue();
+            for (const auto& lsid : removedSessions) {
+                patterns.emplace(makeKillAllSessionsByPattern(opCtx, lsid));
+            }
+        } else {
+            // Ignore errors.
         }
-    } else {
-        // Ignore errors.
     }
 
     // Add all of the explicitly ended sessions to the list of sessions to kill cursors for.
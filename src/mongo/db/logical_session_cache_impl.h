@@ -50,6 +50,10 @@ namespace mongo {
  *    every 5 minutes (300,000). If the caller is setting the sessionTimeout by hand, it is
  *    suggested that they consider also setting the refresh interval accordingly.
  *      --setParameter logicalSessionRefreshMillis=X.
+ *
+ *  - The number of refreshes each refresh interval is spread over. Defaults to 1. Only the last
+ *    refresh of each interval refreshes the sessions of running operations and open cursors.
+ *      --setParameter logicalSessionRefreshDeltasPerInterval=X.
  */
 class LogicalSessionCacheImpl final : public LogicalSessionCache {
 public:
@@ -89,8 +93,15 @@ public:
     LogicalSessionCacheStats getStats() override;
 
 private:
+    /**
+     * A delta refresh writes the records of the sessions used since the previous refresh and
+     * removes the explicitly ended sessions. A full refresh additionally refreshes the sessions
+     * attached to running operations and checks the sessions of open cursors for removal.
+     */
+    enum class RefreshType { kDelta, kFull };
+
     void _periodicRefresh(Client* client);
-    void _refresh(Client* client);
+    void _refresh(Client* client, RefreshType refreshType);
 
     void _periodicReap(Client* client);
     Status _reap(Client* client);
@@ -117,6 +128,10 @@ private:
 
     Date_t _lastRefreshTime;
 
+    // The number of periodic refreshes since the last full one. Only accessed by the periodic
+    // refresh job.
+    int _refreshesSinceFullRefresh{0};
+
     LogicalSessionCacheStats _stats;
 };
 
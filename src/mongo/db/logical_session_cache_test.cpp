@@ -50,6 +50,7 @@
 #include "mongo/stdx/future.h"
 #include "mongo/unittest/ensure_fcv.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -224,6 +225,45 @@ TEST_F(LogicalSessionCacheTest, ManySignedLsidsInCacheRefresh) {
     ASSERT(cache()->refreshNow(getClient()).isOK());
 }
 
+// Test that periodic refreshes between full refreshes only write the sessions used since the
+// previous refresh
+TEST_F(LogicalSessionCacheTest, DeltaRefreshSkipsRunningOpAndCursorSessions) {
+    const auto originalDeltasPerInterval = logicalSessionRefreshDeltasPerInterval;
+    logicalSessionRefreshDeltasPerInterval = 2;
+    ON_BLOCK_EXIT([&] { logicalSessionRefreshDeltasPerInterval = originalDeltasPerInterval; });
+
+    auto runningOpLsid = makeLogicalSessionIdForTest();
+    service()->add(runningOpLsid);
+    auto cursorLsid = makeLogicalSessionIdForTest();
+    service()->addCursorSession(cursorLsid);
+    auto record = makeLogicalSessionRecordForTest();
+    ASSERT_OK(cache()->startSession(opCtx(), record));
+    clearOpCtx();
+
+    // The first refresh of the interval only writes the newly started session.
+    service()->runScheduledJob("LogicalSessionCacheRefresh", getClient());
+    ASSERT(sessions()->has(record.getId()));
+    ASSERT(!sessions()->has(runningOpLsid));
+    ASSERT(!service()->matchKilled(cursorLsid));
+
+    auto stats = cache()->getStats();
+    ASSERT(stats.getLastSessionsCollectionJobWasDelta());
+    ASSERT_EQ(1, stats.getLastSessionsCollectionJobEntriesRefreshed());
+    ASSERT_EQ(0, stats.getLastSessionsCollectionJobEntriesCheckedForRemoval());
+
+    // The last refresh of the interval also refreshes the running operation's session and kills
+    // the cursors of the session which is no longer in the sessions collection.
+    service()->runScheduledJob("LogicalSessionCacheRefresh", getClient());
+    ASSERT(sessions()->has(runningOpLsid));
+    ASSERT(service()->matchKilled(cursorLsid));
+
+    stats = cache()->getStats();
+    ASSERT(!stats.getLastSessionsCollectionJobWasDelta());
+    ASSERT_EQ(1, stats.getLastSessionsCollectionJobEntriesRefreshed());
+    ASSERT_EQ(1, stats.getLastSessionsCollectionJobEntriesCheckedForRemoval());
+    ASSERT_EQ(2, stats.getSessionsCollectionJobEntriesRefreshedTotal());
+}
+
 //
 TEST_F(LogicalSessionCacheTest, RefreshMatrixSessionState) {
     const std::vector<std::vector<std::string>> stateNames = {
@@ -0,0 +1,443 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/batch_leaf_matcher.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "mongo/base/data_view.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/expression_path.h"
+#include "mongo/db/matcher/expression_tree.h"
+
+// TODO replace this with #if BOOST_HW_SIMD_X86 >= BOOST_HW_SIMD_X86_SSE2_VERSION in boost 1.60
+#if defined(_M_AMD64) || defined(__amd64__)
+#include <emmintrin.h>
+#define MONGO_BATCH_LEAF_MATCHER_HAVE_SSE2
+#endif
+
+namespace mongo {
+
+namespace {
+
+// $in lists longer than this are better served by the binary search done by InMatchExpression than
+// by comparing every document against every operand.
+const size_t kMaxInOperands = 16;
+
+// The largest magnitude for which every integer is exactly representable as a double.
+const long long kMaxExactDoubleInteger = 1LL << 53;
+
+bool isExactDouble(long long value) {
+    return value >= -kMaxExactDoubleInteger && value <= kMaxExactDoubleInteger;
+}
+
+/**
+ * Returns true and sets 'out' if 'elem' is a number whose comparisons against other numbers can be
+ * evaluated exactly as double comparisons.
+ */
+bool getExactDouble(const BSONElement& elem, double* out) {
+    switch (elem.type()) {
+        case NumberDouble:
+            *out = elem._numberDouble();
+            return !std::isnan(*out);
+        case NumberInt:
+            *out = elem._numberInt();
+            return true;
+        case NumberLong:
+            *out = elem._numberLong();
+            return isExactDouble(elem._numberLong());
+        default:
+            return false;
+    }
+}
+
+// Each comparison is provided in a scalar form and, where available, in an SSE2 form which compares
+// two doubles at once. All of the SSE2 comparisons used are ordered, so just like the scalar
+// comparisons they are false whenever either side is NaN.
+struct CompareLT {
+    template <typename T>
+    static bool scalar(const T& lhs, const T& rhs) {
+        return lhs < rhs;
+    }
+#ifdef MONGO_BATCH_LEAF_MATCHER_HAVE_SSE2
+    static __m128d vector(__m128d lhs, __m128d rhs) {
+        return _mm_cmplt_pd(lhs, rhs);
+    }
+#endif
+};
+
+struct CompareLTE {
+    template <typename T>
+    static bool scalar(const T& lhs, const T& rhs) {
+        return lhs <= rhs;
+    }
+#ifdef MONGO_BATCH_LEAF_MATCHER_HAVE_SSE2
+    static __m128d vector(__m128d lhs, __m128d rhs) {
+        return _mm_cmple_pd(lhs, rhs);
+    }
+#endif
+};
+
+struct CompareEQ {
+    template <typename T>
+    static bool scalar(const T& lhs, const T& rhs) {
+        return lhs == rhs;
+    }
+#ifdef MONGO_BATCH_LEAF_MATCHER_HAVE_SSE2
+    static __m128d vector(__m128d lhs, __m128d rhs) {
+        return _mm_cmpeq_pd(lhs, rhs);
+    }
+#endif
+};
+
+struct CompareGT {
+    template <typename T>
+    static bool scalar(const T& lhs, const T& rhs) {
+        return lhs > rhs;
+    }
+#ifdef MONGO_BATCH_LEAF_MATCHER_HAVE_SSE2
+    static __m128d vector(__m128d lhs, __m128d rhs) {
+        return _mm_cmpgt_pd(lhs, rhs);
+    }
+#endif
+};
+
+struct CompareGTE {
+    template <typename T>
+    static bool scalar(const T& lhs, const T& rhs) {
+        return lhs >= rhs;
+    }
+#ifdef MONGO_BATCH_LEAF_MATCHER_HAVE_SSE2
+    static __m128d vector(__m128d lhs, __m128d rhs) {
+        return _mm_cmpge_pd(lhs, rhs);
+    }
+#endif
+};
+
+/**
+ * ORs into 'out' a bit for every element of 'column' which compares true against 'operand'.
+ */
+template <typename Compare, typename T>
+void orCompareColumn(const std::vector<T>& column, const T& operand, SelectionBitmap* out) {
+    const size_t n = column.size();
+    for (size_t base = 0; base < n; base += 64) {
+        const size_t end = std::min(n, base + 64);
+        uint64_t word = 0;
+        for (size_t i = base; i < end; ++i) {
+            word |= uint64_t{Compare::scalar(column[i], operand)} << (i - base);
+        }
+        (*out)[base / 64] |= word;
+    }
+}
+
+#ifdef MONGO_BATCH_LEAF_MATCHER_HAVE_SSE2
+template <typename Compare>
+void orCompareColumn(const std::vector<double>& column,
+                     const double& operand,
+                     SelectionBitmap* out) {
+    const size_t n = column.size();
+    const __m128d rhs = _mm_set1_pd(operand);
+    size_t base = 0;
+
+    // Whole words are produced two lanes at a time.
+    for (; base + 64 <= n; base += 64) {
+        uint64_t word = 0;
+        for (size_t i = 0; i < 64; i += 2) {
+            const __m128d lhs = _mm_loadu_pd(&column[base + i]);
+            word |= uint64_t(_mm_movemask_pd(Compare::vector(lhs, rhs))) << i;
+        }
+        (*out)[base / 64] |= word;
+    }
+
+    // The last partial word, if any, is produced one element at a time.
+    uint64_t word = 0;
+    for (size_t i = base; i < n; ++i) {
+        word |= uint64_t{Compare::scalar(column[i], operand)} << (i - base);
+    }
+    if (base < n) {
+        (*out)[base / 64] |= word;
+    }
+}
+#endif
+
+template <typename T>
+void orCompareColumn(MatchExpression::MatchType matchType,
+                     const std::vector<T>& column,
+                     const T& operand,
+                     SelectionBitmap* out) {
+    switch (matchType) {
+        case MatchExpression::LT:
+            return orCompareColumn<CompareLT>(column, operand, out);
+        case MatchExpression::LTE:
+            return orCompareColumn<CompareLTE>(column, operand, out);
+        case MatchExpression::EQ:
+        case MatchExpression::MATCH_IN:
+            return orCompareColumn<CompareEQ>(column, operand, out);
+        case MatchExpression::GT:
+            return orCompareColumn<CompareGT>(column, operand, out);
+        case MatchExpression::GTE:
+            return orCompareColumn<CompareGTE>(column, operand, out);
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+template <typename T>
+void orCompareColumn(MatchExpression::MatchType matchType,
+                     const std::vector<T>& column,
+                     const std::vector<T>& operands,
+                     SelectionBitmap* out) {
+    for (auto&& operand : operands) {
+        orCompareColumn(matchType, column, operand, out);
+    }
+}
+
+void setBit(SelectionBitmap* bitmap, size_t i) {
+    (*bitmap)[i / 64] |= uint64_t{1} << (i % 64);
+}
+
+}  // namespace
+
+std::unique_ptr<BatchLeafMatcher> BatchLeafMatcher::make(const MatchExpression* expr) {
+    std::vector<Predicate> predicates;
+    if (!_addPredicate(expr, &predicates)) {
+        return nullptr;
+    }
+    return std::unique_ptr<BatchLeafMatcher>(new BatchLeafMatcher(std::move(predicates)));
+}
+
+bool BatchLeafMatcher::_addPredicate(const MatchExpression* expr,
+                                     std::vector<Predicate>* predicates) {
+    if (MatchExpression::AND == expr->matchType()) {
+        if (expr->numChildren() == 0) {
+            return false;
+        }
+        for (size_t i = 0; i < expr->numChildren(); ++i) {
+            if (!_addPredicate(expr->getChild(i), predicates)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<BSONElement> operands;
+    switch (expr->matchType()) {
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            operands.push_back(static_cast<const ComparisonMatchExpressionBase*>(expr)->getData());
+            break;
+        case MatchExpression::MATCH_IN: {
+            auto inExpr = static_cast<const InMatchExpression*>(expr);
+            if (!inExpr->getRegexes().empty() || inExpr->getEqualities().empty() ||
+                inExpr->getEqualities().size() > kMaxInOperands) {
+                return false;
+            }
+            operands = inExpr->getEqualities();
+            break;
+        }
+        default:
+            return false;
+    }
+
+    const StringData path = static_cast<const PathMatchExpression*>(expr)->path();
+    if (path.empty() || path.find('.') != std::string::npos) {
+        return false;
+    }
+
+    Predicate pred;
+    pred.expr = expr;
+    pred.fieldName = path.toString();
+    pred.matchType = expr->matchType();
+
+    switch (operands.front().type()) {
+        case NumberDouble:
+        case NumberInt:
+        case NumberLong:
+            pred.columnType = ColumnType::kDouble;
+            break;
+        case Date:
+            pred.columnType = ColumnType::kDate;
+            break;
+        case jstOID:
+            pred.columnType = ColumnType::kObjectId;
+            break;
+        default:
+            return false;
+    }
+
+    for (auto&& operand : operands) {
+        switch (pred.columnType) {
+            case ColumnType::kDouble: {
+                double value;
+                if (!getExactDouble(operand, &value)) {
+                    return false;
+                }
+                pred.doubleOperands.push_back(value);
+                break;
+            }
+            case ColumnType::kDate:
+                if (operand.type() != Date) {
+                    return false;
+                }
+                pred.dateOperands.push_back(operand.date().toMillisSinceEpoch());
+                break;
+            case ColumnType::kObjectId: {
+                if (operand.type() != jstOID) {
+                    return false;
+                }
+                ConstDataView view(operand.value());
+                pred.oidOperands.push_back(
+                    {view.read<BigEndian<uint64_t>>(), view.read<BigEndian<uint32_t>>(8)});
+                break;
+            }
+        }
+    }
+
+    predicates->push_back(std::move(pred));
+    return true;
+}
+
+void BatchLeafMatcher::matches(const std::vector<BSONObj>& docs,
+                               SelectionBitmap* selection) const {
+    selection->assign(numWords(docs.size()), ~uint64_t{0});
+    if (docs.size() % 64) {
+        selection->back() = (uint64_t{1} << (docs.size() % 64)) - 1;
+    }
+
+    for (auto&& pred : _predicates) {
+        _evaluate(pred, docs, selection);
+    }
+}
+
+void BatchLeafMatcher::_evaluate(const Predicate& pred,
+                                 const std::vector<BSONObj>& docs,
+                                 SelectionBitmap* selection) {
+    const size_t n = docs.size();
+
+    // Documents which the column can't faithfully represent, and which are therefore matched with
+    // the MatchExpression instead.
+    std::vector<size_t> fallback;
+
+    // Documents whose field has the right type. Only used for the integer column types, since for
+    // doubles a value of NaN already never compares true.
+    SelectionBitmap valid(numWords(n), 0);
+
+    std::vector<double> doubles;
+    std::vector<int64_t> dates;
+    std::vector<OIDKey> oids;
+    switch (pred.columnType) {
+        case ColumnType::kDouble:
+            doubles.assign(n, std::numeric_limits<double>::quiet_NaN());
+            break;
+        case ColumnType::kDate:
+            dates.assign(n, 0);
+            break;
+        case ColumnType::kObjectId:
+            oids.assign(n, OIDKey{0, 0});
+            break;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!isSelected(*selection, i)) {
+            continue;
+        }
+
+        const BSONElement elem = docs[i].getField(pred.fieldName);
+        if (elem.type() == Array) {
+            fallback.push_back(i);
+            continue;
+        }
+
+        switch (pred.columnType) {
+            case ColumnType::kDouble:
+                if (elem.isNumber()) {
+                    // NaN can never match a non-NaN operand and is left as such in the column. Any
+                    // other number without an exact double representation is matched separately.
+                    double value;
+                    if (getExactDouble(elem, &value)) {
+                        doubles[i] = value;
+                    } else if (elem.type() != NumberDouble) {
+                        fallback.push_back(i);
+                    }
+                }
+                break;
+            case ColumnType::kDate:
+                if (elem.type() == Date) {
+                    dates[i] = elem.date().toMillisSinceEpoch();
+                    setBit(&valid, i);
+                }
+                break;
+            case ColumnType::kObjectId:
+                if (elem.type() == jstOID) {
+                    ConstDataView view(elem.value());
+                    oids[i] = {view.read<BigEndian<uint64_t>>(), view.read<BigEndian<uint32_t>>(8)};
+                    setBit(&valid, i);
+                }
+                break;
+        }
+    }
+
+    SelectionBitmap result(numWords(n), 0);
+    switch (pred.columnType) {
+        case ColumnType::kDouble:
+            orCompareColumn(pred.matchType, doubles, pred.doubleOperands, &result);
+            break;
+        case ColumnType::kDate:
+            orCompareColumn(pred.matchType, dates, pred.dateOperands, &result);
+            break;
+        case ColumnType::kObjectId:
+            orCompareColumn(pred.matchType, oids, pred.oidOperands, &result);
+            break;
+    }
+    if (pred.columnType != ColumnType::kDouble) {
+        for (size_t w = 0; w < result.size(); ++w) {
+            result[w] &= valid[w];
+        }
+    }
+
+    for (auto i : fallback) {
+        if (pred.expr->matchesBSON(docs[i])) {
+            setBit(&result, i);
+        }
+    }
+
+    for (size_t w = 0; w < result.size(); ++w) {
+        (*selection)[w] &= result[w];
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,154 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo {
+
+/**
+ * The result of evaluating a predicate over a batch of documents: bit (i % 64) of word (i / 64) is
+ * set if and only if the i-th document of the batch matched.
+ */
+using SelectionBitmap = std::vector<uint64_t>;
+
+/**
+ * Evaluates a simple MatchExpression over a whole batch of documents at once.
+ *
+ * Only a restricted class of predicates is supported: $eq, $lt, $lte, $gt, $gte and $in on a
+ * top-level (non-dotted) field, against numeric, Date or ObjectId operands, as well as $and of any
+ * number of such predicates. For these, the field of interest is extracted from every document in
+ * the batch into a typed column, which is then compared against the operands by tight,
+ * vectorizable kernels. Documents for which the column extraction cannot be trusted to produce the
+ * same answer as the MatchExpression (arrays, which the matcher traverses, or numbers which cannot
+ * be represented exactly as a double) are evaluated with the MatchExpression itself.
+ *
+ * The MatchExpression used to construct a BatchLeafMatcher must outlive it.
+ */
+class BatchLeafMatcher {
+public:
+    /**
+     * Returns a matcher for 'expr', or nullptr if 'expr' is not of a supported shape.
+     */
+    static std::unique_ptr<BatchLeafMatcher> make(const MatchExpression* expr);
+
+    /**
+     * Evaluates the predicate over 'docs', replacing the contents of 'selection' with the result.
+     */
+    void matches(const std::vector<BSONObj>& docs, SelectionBitmap* selection) const;
+
+    /**
+     * Returns the number of words needed in a SelectionBitmap for 'numDocs' documents.
+     */
+    static size_t numWords(size_t numDocs) {
+        return (numDocs + 63) / 64;
+    }
+
+    /**
+     * Returns whether the i-th document is selected in 'selection'.
+     */
+    static bool isSelected(const SelectionBitmap& selection, size_t i) {
+        return selection[i / 64] & (uint64_t{1} << (i % 64));
+    }
+
+private:
+    /**
+     * The representation used for the field values and the operands of one predicate.
+     */
+    enum class ColumnType {
+        kDouble,
+        kDate,
+        kObjectId,
+    };
+
+    /**
+     * An ObjectId split into two integers which compare in the same order as the ObjectIds.
+     */
+    struct OIDKey {
+        bool operator<(const OIDKey& other) const {
+            return high < other.high || (high == other.high && low < other.low);
+        }
+        bool operator<=(const OIDKey& other) const {
+            return !(other < *this);
+        }
+        bool operator==(const OIDKey& other) const {
+            return high == other.high && low == other.low;
+        }
+        bool operator>(const OIDKey& other) const {
+            return other < *this;
+        }
+        bool operator>=(const OIDKey& other) const {
+            return !(*this < other);
+        }
+
+        uint64_t high;
+        uint32_t low;
+    };
+
+    /**
+     * A single supported leaf predicate.
+     */
+    struct Predicate {
+        const MatchExpression* expr;
+        std::string fieldName;
+        ColumnType columnType;
+
+        // One of EQ, LT, LTE, GT, GTE or MATCH_IN. For MATCH_IN, any of the operands may match;
+        // otherwise there is exactly one operand.
+        MatchExpression::MatchType matchType;
+        std::vector<double> doubleOperands;
+        std::vector<int64_t> dateOperands;
+        std::vector<OIDKey> oidOperands;
+    };
+
+    static bool _addPredicate(const MatchExpression* expr, std::vector<Predicate>* predicates);
+
+    /**
+     * ANDs the result of evaluating 'pred' over 'docs' into 'selection'. Documents which are not
+     * selected on entry are not examined.
+     */
+    static void _evaluate(const Predicate& pred,
+                          const std::vector<BSONObj>& docs,
+                          SelectionBitmap* selection);
+
+    explicit BatchLeafMatcher(std::vector<Predicate> predicates)
+        : _predicates(std::move(predicates)) {}
+
+    std::vector<Predicate> _predicates;
+};
+
+}  // namespace mongo
@@ -0,0 +1,170 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <limits>
+
+#include "mongo/bson/oid.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/batch_leaf_matcher.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/platform/decimal128.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<MatchExpression> parse(const BSONObj& query) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto result = MatchExpressionParser::parse(query, expCtx);
+    ASSERT_OK(result.getStatus());
+    return std::move(result.getValue());
+}
+
+/**
+ * A batch of documents whose 'x' field takes a variety of values, of which 'numDocs' are repeated
+ * as needed to exercise both whole and partial bitmap words.
+ */
+std::vector<BSONObj> makeDocs(size_t numDocs) {
+    const OID oid = OID("5d8b9a2a1c9d440000000001");
+    const std::vector<BSONObj> values = {
+        BSON("x" << 1),
+        BSON("x" << 2.5),
+        BSON("x" << -3LL),
+        BSON("x" << (1LL << 60)),
+        BSON("x" << (1LL << 60) + 1),
+        BSON("x" << std::numeric_limits<double>::quiet_NaN()),
+        BSON("x" << Decimal128("2")),
+        BSON("x"
+             << "2"),
+        BSON("x" << BSONNULL),
+        BSON("y" << 2),
+        BSON("x" << BSON_ARRAY(0 << 2 << 5)),
+        BSON("x" << BSON_ARRAY(oid)),
+        BSON("x" << BSON("y" << 2)),
+        BSON("x" << Date_t::fromMillisSinceEpoch(-1000)),
+        BSON("x" << Date_t::fromMillisSinceEpoch(5000)),
+        BSON("x" << Timestamp(5, 0)),
+        BSON("x" << oid),
+        BSON("x" << OID("5d8b9a2a1c9d440000000002")),
+        BSON("x" << OID("5d8b9a2b0000000000000000")),
+        BSON("y" << 1 << "x" << 2),
+    };
+
+    std::vector<BSONObj> docs;
+    for (size_t i = 0; i < numDocs; ++i) {
+        docs.push_back(values[i % values.size()]);
+    }
+    return docs;
+}
+
+/**
+ * Asserts that a BatchLeafMatcher can be built for 'query' and that it agrees with the
+ * MatchExpression on every document of batches of several sizes.
+ */
+void assertMatchesLikeExpression(const BSONObj& query) {
+    auto expr = parse(query);
+    auto matcher = BatchLeafMatcher::make(expr.get());
+    ASSERT(matcher) << query;
+
+    for (size_t numDocs : {1, 19, 64, 65, 200}) {
+        const auto docs = makeDocs(numDocs);
+        SelectionBitmap selection;
+        matcher->matches(docs, &selection);
+        ASSERT_EQ(BatchLeafMatcher::numWords(numDocs), selection.size());
+        for (size_t i = 0; i < numDocs; ++i) {
+            ASSERT_EQ(expr->matchesBSON(docs[i]), BatchLeafMatcher::isSelected(selection, i))
+                << query << " " << docs[i];
+        }
+    }
+}
+
+TEST(BatchLeafMatcherTest, NumericComparisons) {
+    for (auto&& op : {"$eq", "$lt", "$lte", "$gt", "$gte"}) {
+        assertMatchesLikeExpression(BSON("x" << BSON(op << 2)));
+        assertMatchesLikeExpression(BSON("x" << BSON(op << 2.5)));
+        assertMatchesLikeExpression(BSON("x" << BSON(op << -3LL)));
+        assertMatchesLikeExpression(BSON("x" << BSON(op << (1LL << 52))));
+    }
+}
+
+TEST(BatchLeafMatcherTest, DateComparisons) {
+    for (auto&& op : {"$eq", "$lt", "$lte", "$gt", "$gte"}) {
+        assertMatchesLikeExpression(BSON("x" << BSON(op << Date_t::fromMillisSinceEpoch(0))));
+        assertMatchesLikeExpression(BSON("x" << BSON(op << Date_t::fromMillisSinceEpoch(5000))));
+    }
+}
+
+TEST(BatchLeafMatcherTest, ObjectIdComparisons) {
+    for (auto&& op : {"$eq", "$lt", "$lte", "$gt", "$gte"}) {
+        assertMatchesLikeExpression(BSON("x" << BSON(op << OID("5d8b9a2a1c9d440000000002"))));
+        assertMatchesLikeExpression(BSON("x" << BSON(op << OID("5d8b9a2a00000000ffffffff"))));
+    }
+}
+
+TEST(BatchLeafMatcherTest, In) {
+    assertMatchesLikeExpression(fromjson("{x: {$in: [2, 2.5, 7]}}"));
+    assertMatchesLikeExpression(BSON(
+        "x" << BSON("$in" << BSON_ARRAY(Date_t::fromMillisSinceEpoch(-1000)
+                                        << Date_t::fromMillisSinceEpoch(5000)))));
+    assertMatchesLikeExpression(
+        BSON("x" << BSON("$in" << BSON_ARRAY(OID("5d8b9a2a1c9d440000000001")))));
+}
+
+TEST(BatchLeafMatcherTest, Conjunctions) {
+    assertMatchesLikeExpression(fromjson("{x: {$gt: 0, $lte: 2.5}}"));
+    assertMatchesLikeExpression(fromjson("{x: {$gte: 0}, y: {$lt: 2}}"));
+    assertMatchesLikeExpression(fromjson("{$and: [{x: {$in: [1, 2]}}, {y: 1}]}"));
+}
+
+TEST(BatchLeafMatcherTest, UnsupportedPredicates) {
+    for (auto&& query : {
+             fromjson("{'x.y': 2}"),
+             fromjson("{x: 'a'}"),
+             fromjson("{x: null}"),
+             fromjson("{x: {$exists: true}}"),
+             fromjson("{x: {$in: [1, 'a']}}"),
+             fromjson("{x: {$in: [1, /a/]}}"),
+             fromjson("{$or: [{x: 1}, {y: 1}]}"),
+             fromjson("{x: 1, z: 'a'}"),
+             BSON("x" << std::numeric_limits<double>::quiet_NaN()),
+             BSON("x" << (1LL << 60)),
+             BSON("x" << Decimal128("1")),
+         }) {
+        auto expr = parse(query);
+        ASSERT_FALSE(BatchLeafMatcher::make(expr.get())) << query;
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -29,6 +29,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/base/checked_cast.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_algo.h"
@@ -479,5 +481,101 @@ bool isPathPrefixOf(StringData first, StringData second) {
     return second.startsWith(first) && second[first.size()] == '.';
 }
 
+double estimateEvaluationCost(const MatchExpression* expr) {
+    double childrenCost = 0;
+    for (size_t i = 0; i < expr->numChildren(); ++i) {
+        childrenCost += estimateEvaluationCost(expr->getChild(i));
+    }
+
+    // Every path component requires another lookup, and possibly an implicit array traversal.
+    const double pathCost = std::count(expr->path().begin(), expr->path().end(), '.');
+
+    switch (expr->matchType()) {
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+        case MatchExpression::NOR:
+        case MatchExpression::NOT:
+            return childrenCost;
+
+        case MatchExpression::ALWAYS_FALSE:
+        case MatchExpression::ALWAYS_TRUE:
+            return 0;
+
+        case MatchExpression::EQ:
+        case MatchExpression::LTE:
+        case MatchExpression::LT:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+        case MatchExpression::EXISTS:
+        case MatchExpression::TYPE_OPERATOR:
+        case MatchExpression::MOD:
+        case MatchExpression::BITS_ALL_SET:
+        case MatchExpression::BITS_ALL_CLEAR:
+        case MatchExpression::BITS_ANY_SET:
+        case MatchExpression::BITS_ANY_CLEAR:
+        case MatchExpression::INTERNAL_EXPR_EQ:
+            return 1 + pathCost;
+
+        case MatchExpression::MATCH_IN: {
+            auto in = static_cast<const InMatchExpression*>(expr);
+            return 2 + pathCost + 4 * in->getRegexes().size();
+        }
+
+        case MatchExpression::REGEX:
+            return 5 + pathCost;
+
+        case MatchExpression::SIZE:
+            return 2 + pathCost;
+
+        case MatchExpression::ELEM_MATCH_OBJECT:
+        case MatchExpression::ELEM_MATCH_VALUE:
+            // The children are evaluated once per array element.
+            return 4 + pathCost + 4 * childrenCost;
+
+        case MatchExpression::GEO:
+        case MatchExpression::INTERNAL_2D_POINT_IN_ANNULUS:
+            return 16 + pathCost;
+
+        case MatchExpression::EXPRESSION:
+            return 32;
+
+        case MatchExpression::WHERE:
+            return 1024;
+
+        default:
+            return 8 + pathCost + childrenCost;
+    }
+}
+
+void orderForEvaluation(MatchExpression* expr) {
+    for (size_t i = 0; i < expr->numChildren(); ++i) {
+        orderForEvaluation(expr->getChild(i));
+    }
+
+    switch (expr->matchType()) {
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+        case MatchExpression::NOR:
+            break;
+        default:
+            return;
+    }
+
+    auto list = checked_cast<ListOfMatchExpression*>(expr);
+    std::vector<double> costs(list->numChildren());
+    std::vector<size_t> order(list->numChildren());
+    for (size_t i = 0; i < list->numChildren(); ++i) {
+        costs[i] = estimateEvaluationCost(list->getChild(i));
+        order[i] = i;
+    }
+    std::stable_sort(
+        order.begin(), order.end(), [&](size_t lhs, size_t rhs) { return costs[lhs] < costs[rhs]; });
+
+    if (std::is_sorted(order.begin(), order.end())) {
+        order.clear();
+    }
+    list->setEvaluationOrder(std::move(order));
+}
+
 }  // namespace expression
 }  // namespace mongo
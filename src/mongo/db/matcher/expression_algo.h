@@ -134,5 +134,21 @@ splitMatchExpressionBy(std::unique_ptr<MatchExpression> expr,
                        const std::set<std::string>& fields,
                        const StringMap<std::string>& renames);
 
+/**
+ * Returns a static, relative estimate of the cost of evaluating 'expr' against a single document.
+ * The estimate is only meaningful for comparing the costs of sibling expressions: a predicate on a
+ * top-level field is cheap, deeper paths, regexes and array predicates are more expensive, and
+ * $expr and $where are the most expensive of all.
+ */
+double estimateEvaluationCost(const MatchExpression* expr);
+
+/**
+ * Sets the evaluation order of every $and, $or and $nor in the tree rooted at 'expr' so that cheaper
+ * children are evaluated before more expensive ones, allowing the evaluation to short-circuit
+ * before reaching them. Children of equal estimated cost are kept in their original order. Does not
+ * change the shape of the tree or the set of documents matched by 'expr'.
+ */
+void orderForEvaluation(MatchExpression* expr);
+
 }  // namespace expression
 }  // namespace mongo
@@ -36,6 +36,7 @@
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/expression_tree.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/platform/decimal128.h"
@@ -1343,4 +1344,83 @@ TEST(HasExistencePredicateOnPath, ReturnsFalseWhenExistsOnSubpath) {
         expression::hasExistencePredicateOnPath(*swMatchExpression.getValue().get(), "a"_sd));
 }
 
+TEST(EstimateEvaluationCost, DeeperPathsAreMoreExpensive) {
+    ParsedMatchExpression shallow("{a: 1}");
+    ParsedMatchExpression deep("{'a.b.c': 1}");
+    ASSERT_LT(expression::estimateEvaluationCost(shallow.get()),
+              expression::estimateEvaluationCost(deep.get()));
+}
+
+TEST(EstimateEvaluationCost, ExprIsMoreExpensiveThanRegex) {
+    ParsedMatchExpression comparison("{a: {$gt: 1}}");
+    ParsedMatchExpression regex("{a: /abc/}");
+    ParsedMatchExpression expr("{$expr: {$eq: ['$a', '$b']}}");
+    ASSERT_LT(expression::estimateEvaluationCost(comparison.get()),
+              expression::estimateEvaluationCost(regex.get()));
+    ASSERT_LT(expression::estimateEvaluationCost(regex.get()),
+              expression::estimateEvaluationCost(expr.get()));
+}
+
+TEST(OrderForEvaluation, OrdersCheaperChildrenFirst) {
+    ParsedMatchExpression parsed("{$and: [{$expr: {$eq: ['$a', '$b']}}, {c: /abc/}, {d: 1}]}");
+    auto expr = const_cast<MatchExpression*>(parsed.get());
+    expression::orderForEvaluation(expr);
+
+    auto andExpr = checked_cast<AndMatchExpression*>(expr);
+    std::vector<size_t> expected{2, 1, 0};
+    ASSERT(andExpr->getEvaluationOrder() == expected);
+
+    // The order of evaluation must not affect the result.
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{a: 1, b: 1, c: 'xabcx', d: 1}")));
+    ASSERT_FALSE(expr->matchesBSON(fromjson("{a: 1, b: 2, c: 'xabcx', d: 1}")));
+    ASSERT_FALSE(expr->matchesBSON(fromjson("{a: 1, b: 1, c: 'xabcx', d: 2}")));
+}
+
+TEST(OrderForEvaluation, KeepsNaturalOrderForEqualCosts) {
+    ParsedMatchExpression parsed("{$or: [{a: 1}, {b: 1}, {c: 1}]}");
+    auto expr = const_cast<MatchExpression*>(parsed.get());
+    expression::orderForEvaluation(expr);
+    ASSERT_TRUE(checked_cast<OrMatchExpression*>(expr)->getEvaluationOrder().empty());
+}
+
+TEST(OrderForEvaluation, OrdersNestedChildren) {
+    ParsedMatchExpression parsed("{$or: [{$and: [{'x.y.z': 1}, {w: 1}]}, {v: 1}]}");
+    auto expr = const_cast<MatchExpression*>(parsed.get());
+    expression::orderForEvaluation(expr);
+
+    auto orExpr = checked_cast<OrMatchExpression*>(expr);
+    ASSERT(orExpr->getEvaluationOrder() == std::vector<size_t>({1, 0}));
+    auto andExpr = checked_cast<AndMatchExpression*>(orExpr->getChild(0));
+    ASSERT(andExpr->getEvaluationOrder() == std::vector<size_t>({1, 0}));
+
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{x: {y: {z: 1}}, w: 1}")));
+    ASSERT_FALSE(expr->matchesBSON(fromjson("{x: {y: {z: 1}}, w: 2}")));
+}
+
+TEST(OrderForEvaluation, ShallowCloneKeepsEvaluationOrder) {
+    ParsedMatchExpression parsed("{$and: [{'a.b': 1}, {c: 1}]}");
+    auto expr = const_cast<MatchExpression*>(parsed.get());
+    expression::orderForEvaluation(expr);
+
+    auto clone = expr->shallowClone();
+    ASSERT(checked_cast<AndMatchExpression*>(clone.get())->getEvaluationOrder() ==
+           std::vector<size_t>({1, 0}));
+}
+
+TEST(OrderForEvaluation, ElemMatchKeyIsRecordedInNaturalOrder) {
+    ParsedMatchExpression parsed("{$and: [{'a.b.c': 1}, {'d.e': 1}]}");
+    auto expr = const_cast<MatchExpression*>(parsed.get());
+    expression::orderForEvaluation(expr);
+    ASSERT(checked_cast<AndMatchExpression*>(expr)->getEvaluationOrder() ==
+           std::vector<size_t>({1, 0}));
+
+    // Both children record an elemMatchKey, and the one evaluated last wins.
+    MatchDetails details;
+    details.requestElemMatchKey();
+    ASSERT_TRUE(
+        expr->matchesBSON(fromjson("{a: [{b: {c: 0}}, {b: {c: 1}}], d: [{e: 1}]}"), &details));
+    ASSERT_TRUE(details.hasElemMatchKey());
+    ASSERT_EQ("0", details.elemMatchKey());
+}
+
 }  // namespace mongo
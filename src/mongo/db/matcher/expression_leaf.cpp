@@ -43,8 +43,8 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/path.h"
+#include "mongo/db/matcher/regex_cache.h"
 #include "mongo/db/query/collation/collator_interface.h"
-#include "mongo/util/regex_util.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -203,7 +203,7 @@ RegexMatchExpression::RegexMatchExpression(StringData path, const BSONElement& e
     : LeafMatchExpression(REGEX, path),
       _regex(e.regex()),
       _flags(e.regexFlags()),
-      _re(new pcrecpp::RE(_regex.c_str(), regex_util::flagsToPcreOptions(_flags, true))) {
+      _re(regex_cache::getCompiledRegex(_regex, _flags)) {
     uassert(ErrorCodes::BadValue, "regex not a regex", e.type() == RegEx);
     _init();
 }
@@ -212,7 +212,7 @@ RegexMatchExpression::RegexMatchExpression(StringData path, StringData regex, St
     : LeafMatchExpression(REGEX, path),
       _regex(regex.toString()),
       _flags(options.toString()),
-      _re(new pcrecpp::RE(_regex.c_str(), regex_util::flagsToPcreOptions(_flags, true))) {
+      _re(regex_cache::getCompiledRegex(_regex, _flags)) {
     _init();
 }
 
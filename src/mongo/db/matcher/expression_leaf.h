@@ -335,7 +335,8 @@ private:
 
     std::string _regex;
     std::string _flags;
-    std::unique_ptr<pcrecpp::RE> _re;
+    // Shared with other queries using the same pattern through the regex cache.
+    std::shared_ptr<const pcrecpp::RE> _re;
 };
 
 class ModMatchExpression : public LeafMatchExpression {
@@ -50,6 +50,13 @@ void ListOfMatchExpression::add(MatchExpression* e) {
     _expressions.push_back(e);
 }
 
+void ListOfMatchExpression::_cloneChildrenInto(ListOfMatchExpression* clone) const {
+    invariant(clone->numChildren() == 0);
+    for (auto&& child : _expressions) {
+        clone->add(child->shallowClone().release());
+    }
+    clone->_evaluationOrder = _evaluationOrder;
+}
 
 void ListOfMatchExpression::_debugList(StringBuilder& debug, int indentationLevel) const {
     for (unsigned i = 0; i < _expressions.size(); i++)
@@ -195,8 +202,12 @@ bool ListOfMatchExpression::equivalent(const MatchExpression* other) const {
 // -----
 
 bool AndMatchExpression::matches(const MatchableDocument* doc, MatchDetails* details) const {
+    // Which child gets to record the elemMatchKey depends on the order of evaluation, so when one
+    // is requested the children are evaluated in their natural order.
+    const bool naturalOrder = details && details->needRecord();
     for (size_t i = 0; i < numChildren(); i++) {
-        if (!getChild(i)->matches(doc, details)) {
+        auto child = naturalOrder ? getChild(i) : getChildInEvaluationOrder(i);
+        if (!child->matches(doc, details)) {
             if (details)
                 details->resetOutput();
             return false;
@@ -206,8 +217,10 @@ bool AndMatchExpression::matches(const MatchableDocument* doc, MatchDetails* det
 }
 
 bool AndMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetails* details) const {
+    const bool naturalOrder = details && details->needRecord();
     for (size_t i = 0; i < numChildren(); i++) {
-        if (!getChild(i)->matchesSingleElement(e, details)) {
+        auto child = naturalOrder ? getChild(i) : getChildInEvaluationOrder(i);
+        if (!child->matchesSingleElement(e, details)) {
             return false;
         }
     }
@@ -247,7 +260,7 @@ bool AndMatchExpression::isTriviallyTrue() const {
 
 bool OrMatchExpression::matches(const MatchableDocument* doc, MatchDetails* details) const {
     for (size_t i = 0; i < numChildren(); i++) {
-        if (getChild(i)->matches(doc, nullptr)) {
+        if (getChildInEvaluationOrder(i)->matches(doc, nullptr)) {
             return true;
         }
     }
@@ -255,8 +268,10 @@ bool OrMatchExpression::matches(const MatchableDocument* doc, MatchDetails* deta
 }
 
 bool OrMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetails* details) const {
+    const bool naturalOrder = details && details->needRecord();
     for (size_t i = 0; i < numChildren(); i++) {
-        if (getChild(i)->matchesSingleElement(e, details)) {
+        auto child = naturalOrder ? getChild(i) : getChildInEvaluationOrder(i);
+        if (child->matchesSingleElement(e, details)) {
             return true;
         }
     }
@@ -296,7 +311,7 @@ bool OrMatchExpression::isTriviallyFalse() const {
 
 bool NorMatchExpression::matches(const MatchableDocument* doc, MatchDetails* details) const {
     for (size_t i = 0; i < numChildren(); i++) {
-        if (getChild(i)->matches(doc, nullptr)) {
+        if (getChildInEvaluationOrder(i)->matches(doc, nullptr)) {
             return false;
         }
     }
@@ -304,8 +319,10 @@ bool NorMatchExpression::matches(const MatchableDocument* doc, MatchDetails* det
 }
 
 bool NorMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetails* details) const {
+    const bool naturalOrder = details && details->needRecord();
     for (size_t i = 0; i < numChildren(); i++) {
-        if (getChild(i)->matchesSingleElement(e, details)) {
+        auto child = naturalOrder ? getChild(i) : getChildInEvaluationOrder(i);
+        if (child->matchesSingleElement(e, details)) {
             return false;
         }
     }
@@ -92,15 +92,45 @@ public:
         return MatchCategory::kLogical;
     }
 
+    /**
+     * Sets the order in which matches() evaluates the children, as a permutation of the child
+     * indices. The order only affects how quickly a result is reached, never the result, and is
+     * ignored whenever it doesn't cover exactly the current children.
+     */
+    void setEvaluationOrder(std::vector<size_t> order) {
+        _evaluationOrder = std::move(order);
+    }
+
+    const std::vector<size_t>& getEvaluationOrder() const {
+        return _evaluationOrder;
+    }
+
 protected:
     void _debugList(StringBuilder& debug, int indentationLevel) const;
 
     void _listToBSON(BSONArrayBuilder* out) const;
 
+    /**
+     * Returns the i-th child in evaluation order. See setEvaluationOrder().
+     */
+    MatchExpression* getChildInEvaluationOrder(size_t i) const {
+        return _evaluationOrder.size() == _expressions.size() ? _expressions[_evaluationOrder[i]]
+                                                              : _expressions[i];
+    }
+
+    /**
+     * Copies the children and the evaluation order of this node into 'clone', which must have no
+     * children.
+     */
+    void _cloneChildrenInto(ListOfMatchExpression* clone) const;
+
 private:
     ExpressionOptimizerFunc getOptimizer() const final;
 
     std::vector<MatchExpression*> _expressions;
+
+    // See setEvaluationOrder(). Empty unless set explicitly.
+    std::vector<size_t> _evaluationOrder;
 };
 
 class AndMatchExpression : public ListOfMatchExpression {
@@ -116,9 +146,7 @@ public:
 
     virtual std::unique_ptr<MatchExpression> shallowClone() const {
         std::unique_ptr<AndMatchExpression> self = std::make_unique<AndMatchExpression>();
-        for (size_t i = 0; i < numChildren(); ++i) {
-            self->add(getChild(i)->shallowClone().release());
-        }
+        _cloneChildrenInto(self.get());
         if (getTag()) {
             self->setTag(getTag()->clone());
         }
@@ -145,9 +173,7 @@ public:
 
     virtual std::unique_ptr<MatchExpression> shallowClone() const {
         std::unique_ptr<OrMatchExpression> self = std::make_unique<OrMatchExpression>();
-        for (size_t i = 0; i < numChildren(); ++i) {
-            self->add(getChild(i)->shallowClone().release());
-        }
+        _cloneChildrenInto(self.get());
         if (getTag()) {
             self->setTag(getTag()->clone());
         }
@@ -174,9 +200,7 @@ public:
 
     virtual std::unique_ptr<MatchExpression> shallowClone() const {
         std::unique_ptr<NorMatchExpression> self = std::make_unique<NorMatchExpression>();
-        for (size_t i = 0; i < numChildren(); ++i) {
-            self->add(getChild(i)->shallowClone().release());
-        }
+        _cloneChildrenInto(self.get());
         if (getTag()) {
             self->setTag(getTag()->clone());
         }
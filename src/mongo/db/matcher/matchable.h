@@ -85,9 +85,9 @@ public:
 
     virtual ElementIterator* allocateIterator(const ElementPath* path) const {
         if (_iteratorUsed)
-            return new BSONElementIterator(path, _obj);
+            return new BSONElementIterator(path, _obj, &_fieldIndex);
         _iteratorUsed = true;
-        _iterator.reset(path, _obj);
+        _iterator.reset(path, _obj, &_fieldIndex);
         return &_iterator;
     }
 
@@ -101,6 +101,8 @@ public:
 
 private:
     BSONObj _obj;
+    // Shared by the iterators of every predicate evaluated against '_obj'.
+    mutable BSONFieldIndex _fieldIndex;
     mutable BSONElementIterator _iterator;
     mutable bool _iteratorUsed;
 };
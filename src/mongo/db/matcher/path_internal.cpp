@@ -42,7 +42,8 @@ bool isAllDigits(StringData str) {
 BSONElement getFieldDottedOrArray(const BSONObj& doc,
                                   const FieldRef& path,
                                   size_t* idxPath,
-                                  size_t startIndex) {
+                                  size_t startIndex,
+                                  BSONFieldIndex* topLevelFields) {
     if (path.numParts() == startIndex)
         return doc.getField("");
 
@@ -52,7 +53,9 @@ BSONElement getFieldDottedOrArray(const BSONObj& doc,
     bool stop = false;
     size_t partNum = startIndex;
     while (partNum < path.numParts() && !stop) {
-        res = curr.getField(path.getPart(partNum));
+        res = (topLevelFields && partNum == startIndex)
+            ? topLevelFields->getField(path.getPart(partNum))
+            : curr.getField(path.getPart(partNum));
 
         switch (res.type()) {
             case EOO:
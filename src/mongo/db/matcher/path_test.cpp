@@ -51,6 +51,43 @@ TEST(Path, Root1) {
     ASSERT(!cursor.more());
 }
 
+TEST(Path, TopLevelFieldIndexIsSharedAcrossPaths) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < BSONFieldIndex::kMinFieldsToIndex; ++i) {
+        builder.append("f" + std::to_string(i), i);
+    }
+    builder.append("a", BSON("b" << BSON_ARRAY(1 << 2)));
+    BSONObj doc = builder.obj();
+    BSONFieldIndex fieldIndex(doc);
+
+    ElementPath first;
+    first.init("f3");
+    BSONElementIterator firstCursor(&first, doc, &fieldIndex);
+    ASSERT(firstCursor.more());
+    ASSERT_EQUALS(3, firstCursor.next().element().numberInt());
+    ASSERT(!firstCursor.more());
+
+    // The second lookup indexes the document, and dotted paths still traverse below the top level.
+    ElementPath second;
+    second.init("a.b");
+    BSONElementIterator secondCursor(&second, doc, &fieldIndex);
+    ASSERT(fieldIndex.isIndexed());
+    ASSERT(secondCursor.more());
+    ASSERT_EQUALS(1, secondCursor.next().element().numberInt());
+    ASSERT(secondCursor.more());
+    ASSERT_EQUALS(2, secondCursor.next().element().numberInt());
+    ASSERT(secondCursor.more());
+    ASSERT_EQUALS(Array, secondCursor.next().element().type());
+    ASSERT(!secondCursor.more());
+
+    ElementPath missing;
+    missing.init("missing.x");
+    BSONElementIterator missingCursor(&missing, doc, &fieldIndex);
+    ASSERT(missingCursor.more());
+    ASSERT(missingCursor.next().element().eoo());
+    ASSERT(!missingCursor.more());
+}
+
 TEST(Path, RootArray1) {
     ElementPath p;
     p.init("a");
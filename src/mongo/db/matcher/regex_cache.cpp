@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/regex_cache.h"
+
+#include <limits>
+
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/regex_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace regex_cache {
+namespace {
+
+Counter64 regexCacheHits;
+Counter64 regexCacheMisses;
+ServerStatusMetricField<Counter64> regexCacheHitsMetric("query.regexCache.hits", &regexCacheHits);
+ServerStatusMetricField<Counter64> regexCacheMissesMetric("query.regexCache.misses",
+                                                          &regexCacheMisses);
+
+using CompiledRegex = std::shared_ptr<const pcrecpp::RE>;
+
+Mutex cacheMutex = MONGO_MAKE_LATCH("regex_cache::cacheMutex");
+
+// The size limit is a runtime setting, so the cache is created unbounded and trimmed on insert.
+LRUCache<std::string, CompiledRegex> cache(std::numeric_limits<std::size_t>::max());
+
+/**
+ * Builds the cache key. The flags are length-prefixed so that no two (pattern, flags) pairs
+ * produce the same key.
+ */
+std::string makeKey(StringData pattern, StringData flags) {
+    return str::stream() << flags.size() << ':' << flags << pattern;
+}
+
+}  // namespace
+
+CompiledRegex getCompiledRegex(StringData pattern, StringData flags) {
+    const std::size_t maxSize = internalQueryRegexCacheSize.load();
+    auto compile = [&] {
+        return std::make_shared<const pcrecpp::RE>(
+            pattern.toString(), regex_util::flagsToPcreOptions(flags, true));
+    };
+    if (maxSize == 0) {
+        return compile();
+    }
+
+    const std::string key = makeKey(pattern, flags);
+    {
+        stdx::lock_guard<Latch> lk(cacheMutex);
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            regexCacheHits.increment();
+            return it->second;
+        }
+    }
+
+    // Compile outside of the mutex. Concurrent misses on the same key may each compile the
+    // pattern, in which case the last one inserted is kept.
+    regexCacheMisses.increment();
+    CompiledRegex compiled = compile();
+
+    stdx::lock_guard<Latch> lk(cacheMutex);
+    cache.add(key, compiled);
+    while (cache.size() > maxSize) {
+        cache.erase(std::prev(cache.end()));
+    }
+    return compiled;
+}
+
+void clearForTest() {
+    stdx::lock_guard<Latch> lk(cacheMutex);
+    cache.clear();
+}
+
+}  // namespace regex_cache
+}  // namespace mongo
@@ -0,0 +1,58 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <pcrecpp.h>
+
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+namespace regex_cache {
+
+/**
+ * Returns the compiled form of the regular expression 'pattern' with the options 'flags', as
+ * interpreted by regex_util::flagsToPcreOptions() with invalid options ignored.
+ *
+ * Compiled regular expressions are kept in a process-wide cache of up to
+ * 'internalQueryRegexCacheSize' entries, evicted in least recently used order, so that queries
+ * using the same pattern share one compilation. The returned object is immutable and may be used
+ * concurrently. Callers must check RE::error() for patterns that failed to compile.
+ */
+std::shared_ptr<const pcrecpp::RE> getCompiledRegex(StringData pattern, StringData flags);
+
+/**
+ * Empties the cache. For testing.
+ */
+void clearForTest();
+
+}  // namespace regex_cache
+}  // namespace mongo
@@ -0,0 +1,74 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/regex_cache.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(RegexCacheTest, SamePatternAndFlagsShareCompilation) {
+    regex_cache::clearForTest();
+    auto first = regex_cache::getCompiledRegex("^ab+c", "i");
+    auto second = regex_cache::getCompiledRegex("^ab+c", "i");
+    ASSERT_EQ(first.get(), second.get());
+    ASSERT_TRUE(first->error().empty());
+    ASSERT_TRUE(first->PartialMatch("ABBC"));
+}
+
+TEST(RegexCacheTest, DifferentFlagsCompileSeparately) {
+    regex_cache::clearForTest();
+    auto caseSensitive = regex_cache::getCompiledRegex("abc", "");
+    auto caseInsensitive = regex_cache::getCompiledRegex("abc", "i");
+    ASSERT_NE(caseSensitive.get(), caseInsensitive.get());
+    ASSERT_FALSE(caseSensitive->PartialMatch("ABC"));
+    ASSERT_TRUE(caseInsensitive->PartialMatch("ABC"));
+}
+
+TEST(RegexCacheTest, FlagsAndPatternDoNotCollide) {
+    regex_cache::clearForTest();
+    auto a = regex_cache::getCompiledRegex("ia", "");
+    auto b = regex_cache::getCompiledRegex("a", "i");
+    ASSERT_NE(a.get(), b.get());
+    ASSERT_TRUE(a->PartialMatch("ia"));
+    ASSERT_FALSE(a->PartialMatch("A"));
+    ASSERT_TRUE(b->PartialMatch("A"));
+}
+
+TEST(RegexCacheTest, InvalidPatternReportsError) {
+    regex_cache::clearForTest();
+    auto re = regex_cache::getCompiledRegex("(", "");
+    ASSERT_FALSE(re->error().empty());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -133,13 +133,17 @@ public:
      * "fromMigrate" indicates whether the delete was induced by a chunk migration, and
      * so should be ignored by the user as an internal maintenance operation and not a
      * real delete.
+     * "oplogSlot", if not null, is the optime reserved for the oplog entry of the delete, which
+     * the caller has already used to timestamp the storage write. Otherwise an optime is assigned
+     * when the entry is written.
      */
     virtual void onDelete(OperationContext* opCtx,
                           const NamespaceString& nss,
                           OptionalCollectionUUID uuid,
                           StmtId stmtId,
                           bool fromMigrate,
-                          const boost::optional<BSONObj>& deletedDoc) = 0;
+                          const boost::optional<BSONObj>& deletedDoc,
+                          const repl::OplogSlot& oplogSlot) = 0;
     /**
      * Logs a no-op with "msgObj" in the o field into oplog.
      *
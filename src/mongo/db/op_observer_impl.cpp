@@ -146,11 +146,20 @@ struct OpTimeBundle {
  * Write oplog entry(ies) for the update operation.
  */
 OpTimeBundle replLogUpdate(OperationContext* opCtx, const OplogUpdateEntryArgs& args) {
+    // Images requested by findAndModify are only stored for retryable writes. Collections that
+    // record post-images store one for every update that doesn't already store an image.
+    auto storeDocOption = opCtx->getTxnNumber() ? args.updateArgs.storeDocOption
+                                                : CollectionUpdateArgs::StoreDocOption::None;
+    if (storeDocOption == CollectionUpdateArgs::StoreDocOption::None &&
+        args.updateArgs.recordPostImage) {
+        storeDocOption = CollectionUpdateArgs::StoreDocOption::PostImage;
+    }
+
     BSONObj storeObj;
-    if (args.updateArgs.storeDocOption == CollectionUpdateArgs::StoreDocOption::PreImage) {
+    if (storeDocOption == CollectionUpdateArgs::StoreDocOption::PreImage) {
         invariant(args.updateArgs.preImageDoc);
         storeObj = *args.updateArgs.preImageDoc;
-    } else if (args.updateArgs.storeDocOption == CollectionUpdateArgs::StoreDocOption::PostImage) {
+    } else if (storeDocOption == CollectionUpdateArgs::StoreDocOption::PostImage) {
         storeObj = args.updateArgs.updatedDoc;
     }
 
@@ -163,18 +172,23 @@ OpTimeBundle replLogUpdate(OperationContext* opCtx, const OplogUpdateEntryArgs&
 
     OpTimeBundle opTimes;
 
-    if (!storeObj.isEmpty() && opCtx->getTxnNumber()) {
+    if (!storeObj.isEmpty()) {
         MutableOplogEntry noopEntry = oplogEntry;
         noopEntry.setOpType(repl::OpTypeEnum::kNoop);
         noopEntry.setObject(std::move(storeObj));
+        if (storeDocOption == CollectionUpdateArgs::StoreDocOption::PostImage &&
+            args.updateArgs.recordPostImage) {
+            // Lets change streams pick the image out of the oplog as they scan past it.
+            noopEntry.setObject2(BSON("type"
+                                      << "changeStreamPostImage"));
+        }
         auto noteUpdateOpTime = logOperation(opCtx, &noopEntry);
 
         opTimes.prePostImageOpTime = noteUpdateOpTime;
 
-        if (args.updateArgs.storeDocOption == CollectionUpdateArgs::StoreDocOption::PreImage) {
+        if (storeDocOption == CollectionUpdateArgs::StoreDocOption::PreImage) {
             oplogLink.preImageOpTime = noteUpdateOpTime;
-        } else if (args.updateArgs.storeDocOption ==
-                   CollectionUpdateArgs::StoreDocOption::PostImage) {
+        } else if (storeDocOption == CollectionUpdateArgs::StoreDocOption::PostImage) {
             oplogLink.postImageOpTime = noteUpdateOpTime;
         }
     }
@@ -185,6 +199,10 @@ OpTimeBundle replLogUpdate(OperationContext* opCtx, const OplogUpdateEntryArgs&
     oplogEntry.setFromMigrateIfTrue(args.updateArgs.fromMigrate);
     // oplogLink could have been changed to include pre/postImageOpTime by the previous no-op write.
     repl::appendRetryableWriteInfo(opCtx, &oplogEntry, &oplogLink, args.updateArgs.stmtId);
+    if (!oplogLink.postImageOpTime.isNull()) {
+        // Also link recorded post-images on writes that are not retryable.
+        oplogEntry.setPostImageOpTime(oplogLink.postImageOpTime);
+    }
     opTimes.writeOpTime = logOperation(opCtx, &oplogEntry);
     opTimes.wallClockTime = oplogEntry.getWallClockTime();
     return opTimes;
@@ -198,7 +216,8 @@ OpTimeBundle replLogDelete(OperationContext* opCtx,
                            OptionalCollectionUUID uuid,
                            StmtId stmtId,
                            bool fromMigrate,
-                           const boost::optional<BSONObj>& deletedDoc) {
+                           const boost::optional<BSONObj>& deletedDoc,
+                           const repl::OplogSlot& oplogSlot) {
     MutableOplogEntry oplogEntry;
     oplogEntry.setNss(nss);
     oplogEntry.setUuid(uuid);
@@ -209,6 +228,9 @@ OpTimeBundle replLogDelete(OperationContext* opCtx,
     OpTimeBundle opTimes;
 
     if (deletedDoc && opCtx->getTxnNumber()) {
+        // The pre-image entry must come before the delete entry, so it cannot be logged after the
+        // delete has been given a reserved optime.
+        invariant(oplogSlot.isNull());
         MutableOplogEntry noopEntry = oplogEntry;
         noopEntry.setOpType(repl::OpTypeEnum::kNoop);
         noopEntry.setObject(deletedDoc.get());
@@ -222,6 +244,7 @@ OpTimeBundle replLogDelete(OperationContext* opCtx,
     oplogEntry.setFromMigrateIfTrue(fromMigrate);
     // oplogLink could have been changed to include preImageOpTime by the previous no-op write.
     repl::appendRetryableWriteInfo(opCtx, &oplogEntry, &oplogLink, stmtId);
+    oplogEntry.setOpTime(oplogSlot);
     opTimes.writeOpTime = logOperation(opCtx, &oplogEntry);
     opTimes.wallClockTime = oplogEntry.getWallClockTime();
     return opTimes;
@@ -496,7 +519,8 @@ void OpObserverImpl::onDelete(OperationContext* opCtx,
                               OptionalCollectionUUID uuid,
                               StmtId stmtId,
                               bool fromMigrate,
-                              const boost::optional<BSONObj>& deletedDoc) {
+                              const boost::optional<BSONObj>& deletedDoc,
+                              const repl::OplogSlot& oplogSlot) {
     auto& documentKey = documentKeyDecoration(opCtx);
     invariant(!documentKey.isEmpty());
 
@@ -510,7 +534,7 @@ void OpObserverImpl::onDelete(OperationContext* opCtx,
             nss, uuid, deletedDoc ? deletedDoc.get() : documentKey);
         txnParticipant.addTransactionOperation(opCtx, operation);
     } else {
-        opTime = replLogDelete(opCtx, nss, uuid, stmtId, fromMigrate, deletedDoc);
+        opTime = replLogDelete(opCtx, nss, uuid, stmtId, fromMigrate, deletedDoc, oplogSlot);
         SessionTxnRecord sessionTxnRecord;
         sessionTxnRecord.setLastWriteOpTime(opTime.writeOpTime);
         sessionTxnRecord.setLastWriteDate(opTime.wallClockTime);
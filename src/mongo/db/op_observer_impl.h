@@ -84,7 +84,8 @@ public:
                   OptionalCollectionUUID uuid,
                   StmtId stmtId,
                   bool fromMigrate,
-                  const boost::optional<BSONObj>& deletedDoc) final;
+                  const boost::optional<BSONObj>& deletedDoc,
+                  const repl::OplogSlot& oplogSlot) final;
     void onInternalOpMessage(OperationContext* opCtx,
                              const NamespaceString& nss,
                              const boost::optional<UUID> uuid,
@@ -0,0 +1,310 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/operation_trace.h"
+
+#include <cstdio>
+#include <deque>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/client.h"
+#include "mongo/db/operation_trace_gen.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/transport/session.h"
+#include "mongo/util/net/socket_utils.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getOperationTrace = OperationContext::declareDecoration<OperationTrace>();
+
+Mutex bufferMutex = MONGO_MAKE_LATCH("OperationTrace::bufferMutex");
+std::deque<BSONObj> spanBuffer;
+AtomicWord<long long> droppedSpanCount{0};
+
+std::string toHex(uint64_t value) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(value));
+    return buf;
+}
+
+/**
+ * Parses exactly 16 lowercase or uppercase hex digits from 'hex', which must be 16 characters.
+ */
+boost::optional<uint64_t> parseHex(StringData hex) {
+    if (hex.size() != 16) {
+        return boost::none;
+    }
+    uint64_t value = 0;
+    for (char c : hex) {
+        value <<= 4;
+        if (c >= '0' && c <= '9') {
+            value |= c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            value |= c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            value |= c - 'A' + 10;
+        } else {
+            return boost::none;
+        }
+    }
+    return value;
+}
+
+/**
+ * Returns whether 'client' is another node of the cluster: a connection which identified itself
+ * as internal, and which is authorized for internal actions on the cluster.
+ */
+bool isClusterMember(Client* client) {
+    const auto& session = client->session();
+    if (!session || !(session->getTags() & transport::Session::kInternalClient)) {
+        return false;
+    }
+    return AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
+        ResourcePattern::forClusterResource(), ActionType::internal);
+}
+
+}  // namespace
+
+OperationTrace& OperationTrace::get(OperationContext* opCtx) {
+    return getOperationTrace(opCtx);
+}
+
+void OperationTrace::start(OperationContext* opCtx,
+                           StringData name,
+                           const BSONElement& traceContext) {
+    if (isActive()) {
+        return;
+    }
+
+    // Only another member of the cluster may force a trace through its $traceContext. The context
+    // of any other client is only adopted when the operation is sampled anyway, so that clients
+    // cannot turn on tracing, and fill the span buffer, while sampling is disabled.
+    const double sampleRate = gOperationTraceSampleRate.load();
+    const bool fromClusterMember = isClusterMember(opCtx->getClient());
+    if (sampleRate == 0.0 && !fromClusterMember) {
+        return;
+    }
+
+    uint64_t traceIdHigh = 0;
+    uint64_t traceIdLow = 0;
+    uint64_t remoteParentSpanId = 0;
+    bool hasTraceContext = false;
+
+    // A trace context is {traceId: <32 hex digits>, spanId: <16 hex digits>}, the W3C
+    // traceparent identifiers of the upstream span.
+    if (traceContext.type() == BSONType::Object) {
+        auto traceId = traceContext.Obj()["traceId"];
+        auto spanId = traceContext.Obj()["spanId"];
+        if (traceId.type() == BSONType::String && traceId.valueStringData().size() == 32 &&
+            spanId.type() == BSONType::String) {
+            auto high = parseHex(traceId.valueStringData().substr(0, 16));
+            auto low = parseHex(traceId.valueStringData().substr(16));
+            auto parent = parseHex(spanId.valueStringData());
+            if (high && low && parent) {
+                traceIdHigh = *high;
+                traceIdLow = *low;
+                remoteParentSpanId = *parent;
+                hasTraceContext = true;
+            }
+        }
+    }
+
+    auto& prng = opCtx->getClient()->getPrng();
+    if (!(hasTraceContext && fromClusterMember)) {
+        if (sampleRate == 0.0 || prng.nextCanonicalDouble() >= sampleRate) {
+            return;
+        }
+        if (!hasTraceContext) {
+            traceIdHigh = prng.nextInt64();
+            traceIdLow = prng.nextInt64();
+        }
+    }
+
+    stdx::lock_guard<SpinLock> lk(_lock);
+    _traceIdHigh = traceIdHigh;
+    _traceIdLow = traceIdLow;
+    _remoteParentSpanId = remoteParentSpanId;
+    _nextSpanId = prng.nextInt64();
+    _openSpan(name);
+    _active.store(true);
+}
+
+void OperationTrace::finish(const BSONObj& attributes) {
+    if (!isActive()) {
+        return;
+    }
+
+    std::vector<BSONObj> spans;
+    {
+        stdx::lock_guard<SpinLock> lk(_lock);
+        while (!_openSpans.empty()) {
+            _closeSpan(_openSpans.back());
+        }
+        _spans.front().attributes = attributes.getOwned();
+
+        spans.reserve(_spans.size());
+        for (const auto& span : _spans) {
+            spans.push_back(_toOpenTelemetry(span));
+        }
+        _spans.clear();
+        _active.store(false);
+    }
+
+    {
+        const size_t maxSize = gOperationTraceBufferSize.load();
+        stdx::lock_guard<Latch> lk(bufferMutex);
+        for (auto&& span : spans) {
+            spanBuffer.push_back(std::move(span));
+        }
+        while (spanBuffer.size() > maxSize) {
+            spanBuffer.pop_front();
+            droppedSpanCount.fetchAndAdd(1);
+        }
+    }
+}
+
+uint64_t OperationTrace::addCompletedSpan(StringData name,
+                                          long long startMicros,
+                                          long long endMicros,
+                                          BSONObj attributes,
+                                          boost::optional<uint64_t> parentSpanId) {
+    invariant(isActive());
+    stdx::lock_guard<SpinLock> lk(_lock);
+    const auto spanId = _nextSpanId++;
+    _spans.push_back({name.toString(),
+                      spanId,
+                      parentSpanId.value_or(_currentSpanId()),
+                      startMicros,
+                      endMicros,
+                      std::move(attributes)});
+    return spanId;
+}
+
+void OperationTrace::appendTraceContext(BSONObjBuilder* builder) const {
+    invariant(isActive());
+    stdx::lock_guard<SpinLock> lk(_lock);
+    BSONObjBuilder contextBuilder(builder->subobjStart(kMetadataFieldName));
+    contextBuilder.append("traceId", toHex(_traceIdHigh) + toHex(_traceIdLow));
+    contextBuilder.append("spanId", toHex(_currentSpanId()));
+}
+
+size_t OperationTrace::_openSpan(StringData name) {
+    const auto parentSpanId = _currentSpanId();
+    const auto spanId = _nextSpanId++;
+    _spans.push_back(
+        {name.toString(), spanId, parentSpanId, static_cast<long long>(curTimeMicros64()), 0, {}});
+    _openSpans.push_back(_spans.size() - 1);
+    return _spans.size() - 1;
+}
+
+void OperationTrace::_closeSpan(size_t index) {
+    // Spans are scoped, so they close innermost first.
+    invariant(!_openSpans.empty() && _openSpans.back() == index);
+    _spans[index].endMicros = curTimeMicros64();
+    _openSpans.pop_back();
+}
+
+uint64_t OperationTrace::_currentSpanId() const {
+    return _openSpans.empty() ? _remoteParentSpanId : _spans[_openSpans.back()].spanId;
+}
+
+BSONObj OperationTrace::_toOpenTelemetry(const SpanData& span) const {
+    BSONObjBuilder builder;
+    builder.append("traceId", toHex(_traceIdHigh) + toHex(_traceIdLow));
+    builder.append("spanId", toHex(span.spanId));
+    if (span.parentSpanId) {
+        builder.append("parentSpanId", toHex(span.parentSpanId));
+    }
+    builder.append("name", span.name);
+    builder.append("startTimeUnixNano", span.startMicros * 1000);
+    builder.append("endTimeUnixNano", span.endMicros * 1000);
+    builder.append("attributes", span.attributes);
+    builder.append("resource", BSON("host.name" << getHostNameCachedAndPort()));
+    return builder.obj();
+}
+
+OperationTrace::Span::Span(OperationContext* opCtx, StringData name) {
+    auto& trace = OperationTrace::get(opCtx);
+    if (trace.isActive()) {
+        stdx::lock_guard<SpinLock> lk(trace._lock);
+        _trace = &trace;
+        _index = trace._openSpan(name);
+    }
+}
+
+OperationTrace::Span::~Span() {
+    if (_trace && _trace->isActive()) {
+        stdx::lock_guard<SpinLock> lk(_trace->_lock);
+        _trace->_closeSpan(_index);
+    }
+}
+
+std::vector<BSONObj> OperationTrace::getBufferedSpans(bool clear, size_t maxBytes) {
+    stdx::lock_guard<Latch> lk(bufferMutex);
+    std::vector<BSONObj> spans;
+    size_t totalBytes = 0;
+    for (const auto& span : spanBuffer) {
+        totalBytes += span.objsize();
+        if (totalBytes > maxBytes) {
+            break;
+        }
+        spans.push_back(span);
+    }
+    if (clear) {
+        spanBuffer.erase(spanBuffer.begin(), spanBuffer.begin() + spans.size());
+    }
+    return spans;
+}
+
+long long OperationTrace::getDroppedSpanCount() {
+    return droppedSpanCount.load();
+}
+
+Status OperationTraceMetadataHook::writeRequestMetadata(OperationContext* opCtx,
+                                                        BSONObjBuilder* metadataBob) {
+    if (opCtx && OperationTrace::get(opCtx).isActive()) {
+        OperationTrace::get(opCtx).appendTraceContext(metadataBob);
+    }
+    return Status::OK();
+}
+
+Status OperationTraceMetadataHook::readReplyMetadata(OperationContext* opCtx,
+                                                     StringData replySource,
+                                                     const BSONObj& metadataObj) {
+    return Status::OK();
+}
+
+}  // namespace mongo
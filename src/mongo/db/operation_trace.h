@@ -0,0 +1,193 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/rpc/metadata/metadata_hook.h"
+#include "mongo/util/concurrency/spin_lock.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * Opt-in, sampled tracing of individual operations. A traced operation records a tree of timed
+ * spans: the operation itself, command parsing, query planning, each PlanStage and DocumentSource
+ * it ran, and so on. When the operation completes its spans are moved into a process-wide buffer
+ * of up to 'operationTraceBufferSize' spans, which getOperationTraces returns in the OpenTelemetry
+ * span layout.
+ *
+ * An operation is traced with probability 'operationTraceSampleRate', or when its request carries
+ * a $traceContext from an upstream node, in which case it continues that node's trace. Requests
+ * sent on behalf of a traced operation carry a $traceContext through OperationTraceMetadataHook,
+ * so that a trace started on mongos follows the operation onto the shards.
+ *
+ * For an operation which is not traced, each instrumentation point costs a decoration lookup and
+ * a branch.
+ */
+class OperationTrace {
+    OperationTrace(const OperationTrace&) = delete;
+    OperationTrace& operator=(const OperationTrace&) = delete;
+
+public:
+    static constexpr StringData kMetadataFieldName = "$traceContext"_sd;
+
+    OperationTrace() = default;
+
+    static OperationTrace& get(OperationContext* opCtx);
+
+    /**
+     * Starts tracing the operation with a root span named 'name' if the operation is sampled, or
+     * if 'traceContext', the $traceContext element of the request, is a valid trace context sent
+     * by another node of the cluster. A sampled operation continues the trace of a valid context
+     * from any client. A malformed trace context is ignored. Does nothing if the operation is
+     * already being traced.
+     */
+    void start(OperationContext* opCtx, StringData name, const BSONElement& traceContext);
+
+    /**
+     * Closes the root span and any span still open, attaches 'attributes' to the root span and
+     * moves the operation's spans into the span buffer. Does nothing if the operation is not
+     * being traced.
+     */
+    void finish(const BSONObj& attributes);
+
+    bool isActive() const {
+        return _active.loadRelaxed();
+    }
+
+    /**
+     * Records a span which was timed elsewhere, for instance a PlanStage whose execution time is
+     * accumulated in its stats, and returns its span id. The span is a child of 'parentSpanId', or
+     * of the innermost open span if none is given. Only valid while the operation is traced.
+     */
+    uint64_t addCompletedSpan(StringData name,
+                              long long startMicros,
+                              long long endMicros,
+                              BSONObj attributes,
+                              boost::optional<uint64_t> parentSpanId = boost::none);
+
+    /**
+     * Appends the $traceContext to send with a request made on behalf of the operation, naming
+     * the innermost open span as the parent of the remote operation. Only valid while the
+     * operation is traced.
+     */
+    void appendTraceContext(BSONObjBuilder* builder) const;
+
+    /**
+     * Times the enclosing scope as a child of the innermost open span, if the operation is
+     * being traced.
+     */
+    class Span {
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+    public:
+        Span(OperationContext* opCtx, StringData name);
+        ~Span();
+
+    private:
+        OperationTrace* _trace = nullptr;
+        size_t _index = 0;
+    };
+
+    /**
+     * Returns the buffered spans of completed operations, oldest first, stopping before the total
+     * size of the returned spans would exceed 'maxBytes'. If 'clear' is true, the returned spans
+     * are removed from the buffer.
+     */
+    static std::vector<BSONObj> getBufferedSpans(
+        bool clear, size_t maxBytes = std::numeric_limits<size_t>::max());
+
+    /**
+     * Returns the number of spans dropped from the buffer because it was full.
+     */
+    static long long getDroppedSpanCount();
+
+private:
+    struct SpanData {
+        std::string name;
+        uint64_t spanId;
+        uint64_t parentSpanId;
+        long long startMicros;
+        long long endMicros;
+        BSONObj attributes;
+    };
+
+    // The following must be called with '_lock' held.
+    size_t _openSpan(StringData name);
+    void _closeSpan(size_t index);
+    uint64_t _currentSpanId() const;
+
+    BSONObj _toOpenTelemetry(const SpanData& span) const;
+
+    // Set while the operation is traced. The trace is recorded by the operation's own thread, but
+    // egress metadata hooks may read it from networking threads, so the spans are guarded by
+    // '_lock'.
+    AtomicWord<bool> _active{false};
+    mutable SpinLock _lock;
+
+    uint64_t _traceIdHigh = 0;
+    uint64_t _traceIdLow = 0;
+
+    // The span of the upstream node which sent the operation, or 0.
+    uint64_t _remoteParentSpanId = 0;
+
+    // Span ids are allocated sequentially from a random base, so that they are unique within the
+    // trace without drawing a random number per span.
+    uint64_t _nextSpanId = 0;
+
+    std::vector<SpanData> _spans;
+
+    // Indexes into '_spans' of the spans which have not ended yet, innermost last.
+    std::vector<size_t> _openSpans;
+};
+
+/**
+ * Attaches the $traceContext of a traced operation to the requests it sends to other nodes.
+ */
+class OperationTraceMetadataHook : public rpc::EgressMetadataHook {
+public:
+    Status writeRequestMetadata(OperationContext* opCtx, BSONObjBuilder* metadataBob) override;
+
+    Status readReplyMetadata(OperationContext* opCtx,
+                             StringData replySource,
+                             const BSONObj& metadataObj) override;
+};
+
+}  // namespace mongo
@@ -0,0 +1,225 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/operation_trace.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/operation_trace_gen.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+class OperationTraceTest : public ServiceContextTest {
+public:
+    void setUp() override {
+        ServiceContextTest::setUp();
+        OperationTrace::getBufferedSpans(true);
+    }
+
+    /**
+     * Returns the buffered spans with the given name.
+     */
+    std::vector<BSONObj> spansNamed(StringData name) {
+        std::vector<BSONObj> spans;
+        for (auto&& span : OperationTrace::getBufferedSpans(false)) {
+            if (span["name"].String() == name) {
+                spans.push_back(span);
+            }
+        }
+        return spans;
+    }
+};
+
+TEST_F(OperationTraceTest, NotTracedWhenSampleRateIsZero) {
+    auto opCtx = makeOperationContext();
+    auto& trace = OperationTrace::get(opCtx.get());
+    trace.start(opCtx.get(), "find", BSONElement());
+    ASSERT_FALSE(trace.isActive());
+
+    { OperationTrace::Span span(opCtx.get(), "parse"); }
+    trace.finish(BSONObj());
+    ASSERT_EQ(0U, OperationTrace::getBufferedSpans(false).size());
+}
+
+TEST_F(OperationTraceTest, SampledOperationRecordsNestedSpans) {
+    const auto originalRate = gOperationTraceSampleRate.load();
+    ON_BLOCK_EXIT([&] { gOperationTraceSampleRate.store(originalRate); });
+    gOperationTraceSampleRate.store(1.0);
+
+    auto opCtx = makeOperationContext();
+    auto& trace = OperationTrace::get(opCtx.get());
+    trace.start(opCtx.get(), "find", BSONElement());
+    ASSERT_TRUE(trace.isActive());
+    {
+        OperationTrace::Span planSpan(opCtx.get(), "plan");
+        OperationTrace::Span multiPlanSpan(opCtx.get(), "multiPlan");
+    }
+    trace.finish(BSON("nreturned" << 3));
+    ASSERT_FALSE(trace.isActive());
+
+    auto root = spansNamed("find");
+    auto plan = spansNamed("plan");
+    auto multiPlan = spansNamed("multiPlan");
+    ASSERT_EQ(1U, root.size());
+    ASSERT_EQ(1U, plan.size());
+    ASSERT_EQ(1U, multiPlan.size());
+
+    ASSERT_FALSE(root[0].hasField("parentSpanId"));
+    ASSERT_EQ(3, root[0]["attributes"]["nreturned"].numberInt());
+    ASSERT_EQ(root[0]["spanId"].String(), plan[0]["parentSpanId"].String());
+    ASSERT_EQ(plan[0]["spanId"].String(), multiPlan[0]["parentSpanId"].String());
+    ASSERT_EQ(root[0]["traceId"].String(), multiPlan[0]["traceId"].String());
+    ASSERT_EQ(32U, root[0]["traceId"].String().size());
+    ASSERT_LTE(root[0]["startTimeUnixNano"].numberLong(),
+               plan[0]["startTimeUnixNano"].numberLong());
+    ASSERT_GTE(root[0]["endTimeUnixNano"].numberLong(), plan[0]["endTimeUnixNano"].numberLong());
+}
+
+TEST_F(OperationTraceTest, SampledOperationContinuesTraceContext) {
+    const auto originalRate = gOperationTraceSampleRate.load();
+    ON_BLOCK_EXIT([&] { gOperationTraceSampleRate.store(originalRate); });
+    gOperationTraceSampleRate.store(1.0);
+
+    auto opCtx = makeOperationContext();
+    auto& trace = OperationTrace::get(opCtx.get());
+    const auto request = BSON("find"
+                              << "coll" << OperationTrace::kMetadataFieldName
+                              << BSON("traceId"
+                                      << "0123456789abcdef0123456789abcdef"
+                                      << "spanId"
+                                      << "00000000000000aa"));
+    trace.start(opCtx.get(), "find", request[OperationTrace::kMetadataFieldName]);
+    ASSERT_TRUE(trace.isActive());
+
+    BSONObjBuilder metadata;
+    trace.appendTraceContext(&metadata);
+    auto context = metadata.obj()[OperationTrace::kMetadataFieldName];
+    ASSERT_EQ("0123456789abcdef0123456789abcdef", context["traceId"].String());
+    trace.finish(BSONObj());
+
+    auto root = spansNamed("find");
+    ASSERT_EQ(1U, root.size());
+    ASSERT_EQ("0123456789abcdef0123456789abcdef", root[0]["traceId"].String());
+    ASSERT_EQ("00000000000000aa", root[0]["parentSpanId"].String());
+    ASSERT_EQ(root[0]["spanId"].String(), context["spanId"].String());
+}
+
+TEST_F(OperationTraceTest, TraceContextOfAnOrdinaryClientDoesNotForceTracing) {
+    auto opCtx = makeOperationContext();
+    auto& trace = OperationTrace::get(opCtx.get());
+    const auto request = BSON("find"
+                              << "coll" << OperationTrace::kMetadataFieldName
+                              << BSON("traceId"
+                                      << "0123456789abcdef0123456789abcdef"
+                                      << "spanId"
+                                      << "00000000000000aa"));
+    trace.start(opCtx.get(), "find", request[OperationTrace::kMetadataFieldName]);
+    ASSERT_FALSE(trace.isActive());
+    trace.finish(BSONObj());
+    ASSERT_EQ(0U, OperationTrace::getBufferedSpans(false).size());
+}
+
+TEST_F(OperationTraceTest, MalformedTraceContextIsIgnored) {
+    const auto originalRate = gOperationTraceSampleRate.load();
+    ON_BLOCK_EXIT([&] { gOperationTraceSampleRate.store(originalRate); });
+    gOperationTraceSampleRate.store(1.0);
+
+    auto opCtx = makeOperationContext();
+    auto& trace = OperationTrace::get(opCtx.get());
+    const auto request = BSON("find"
+                              << "coll" << OperationTrace::kMetadataFieldName
+                              << BSON("traceId"
+                                      << "not hex"
+                                      << "spanId"
+                                      << "00000000000000aa"));
+    trace.start(opCtx.get(), "find", request[OperationTrace::kMetadataFieldName]);
+    ASSERT_TRUE(trace.isActive());
+    trace.finish(BSONObj());
+
+    // The sampled operation starts a trace of its own.
+    auto root = spansNamed("find");
+    ASSERT_EQ(1U, root.size());
+    ASSERT_FALSE(root[0].hasField("parentSpanId"));
+}
+
+TEST_F(OperationTraceTest, BufferDropsOldestSpans) {
+    const auto originalRate = gOperationTraceSampleRate.load();
+    const auto originalSize = gOperationTraceBufferSize.load();
+    ON_BLOCK_EXIT([&] {
+        gOperationTraceSampleRate.store(originalRate);
+        gOperationTraceBufferSize.store(originalSize);
+    });
+    gOperationTraceSampleRate.store(1.0);
+    gOperationTraceBufferSize.store(2);
+
+    const auto droppedBefore = OperationTrace::getDroppedSpanCount();
+    for (auto name : {"first", "second", "third"}) {
+        auto opCtx = makeOperationContext();
+        OperationTrace::get(opCtx.get()).start(opCtx.get(), name, BSONElement());
+        OperationTrace::get(opCtx.get()).finish(BSONObj());
+    }
+
+    auto spans = OperationTrace::getBufferedSpans(true);
+    ASSERT_EQ(2U, spans.size());
+    ASSERT_EQ("second", spans[0]["name"].String());
+    ASSERT_EQ("third", spans[1]["name"].String());
+    ASSERT_EQ(droppedBefore + 1, OperationTrace::getDroppedSpanCount());
+    ASSERT_EQ(0U, OperationTrace::getBufferedSpans(false).size());
+}
+
+TEST_F(OperationTraceTest, GetBufferedSpansStopsAtSizeLimitAndKeepsTheRest) {
+    const auto originalRate = gOperationTraceSampleRate.load();
+    ON_BLOCK_EXIT([&] { gOperationTraceSampleRate.store(originalRate); });
+    gOperationTraceSampleRate.store(1.0);
+
+    for (auto name : {"first", "second"}) {
+        auto opCtx = makeOperationContext();
+        OperationTrace::get(opCtx.get()).start(opCtx.get(), name, BSONElement());
+        OperationTrace::get(opCtx.get()).finish(BSONObj());
+    }
+
+    const auto firstSize = OperationTrace::getBufferedSpans(false)[0].objsize();
+    auto spans = OperationTrace::getBufferedSpans(true, firstSize);
+    ASSERT_EQ(1U, spans.size());
+    ASSERT_EQ("first", spans[0]["name"].String());
+
+    spans = OperationTrace::getBufferedSpans(true);
+    ASSERT_EQ(1U, spans.size());
+    ASSERT_EQ("second", spans[0]["name"].String());
+}
+
+}  // namespace
+}  // namespace mongo
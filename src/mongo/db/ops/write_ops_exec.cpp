@@ -551,8 +551,10 @@ WriteResult performInserts(OperationContext* opCtx,
                 }
             }
 
+            // Unless the document had to be rewritten, it is still a view into the buffer of the
+            // message it arrived in, and is inserted from there without being copied.
             BSONObj toInsert = fixedDoc.getValue().isEmpty() ? doc : std::move(fixedDoc.getValue());
-            batch.emplace_back(stmtId, toInsert);
+            batch.emplace_back(stmtId, std::move(toInsert));
             bytesInBatch += batch.back().doc.objsize();
             if (!isLastDoc && batch.size() < maxBatchSize && bytesInBatch < maxBatchBytes)
                 continue;  // Add more to batch before inserting.
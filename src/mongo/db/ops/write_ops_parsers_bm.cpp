@@ -0,0 +1,104 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/ops/insert.h"
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/db/repl/oplog.h"
+#include "mongo/rpc/op_msg.h"
+
+namespace mongo {
+namespace {
+
+Message makeInsertMessage(int numDocs) {
+    OpMsgBuilder builder;
+    builder.setBody(BSON("insert"
+                         << "coll"
+                         << "$db"
+                         << "test"));
+    {
+        auto docSeq = builder.beginDocSequence("documents");
+        for (int i = 0; i < numDocs; ++i) {
+            docSeq.append(BSON("_id" << i << "x" << i << "s"
+                                     << "small document"));
+        }
+    }
+    return builder.finish();
+}
+
+/**
+ * Parses an insert with 'state.range(0)' documents in a single document sequence and turns it into
+ * the InsertStatements that write_ops_exec hands to the collection, which is the path a document
+ * takes from the message buffer to the RecordStore. Reports how many bytes per document were
+ * copied out of the message buffer on the way, which should be none.
+ */
+void BM_InsertFromDocumentSequence(benchmark::State& state) {
+    const auto message = makeInsertMessage(state.range(0));
+    const char* begin = message.buf();
+    const char* end = begin + message.size();
+
+    size_t bytesCopied = 0;
+    size_t docsInserted = 0;
+    for (auto _ : state) {
+        const auto op = InsertOp::parse(OpMsgRequest::parse(message));
+
+        std::vector<InsertStatement> batch;
+        batch.reserve(op.getDocuments().size());
+        for (auto&& doc : op.getDocuments()) {
+            // A document with _id first and no Timestamp(0, 0) to fill in is never rewritten, so
+            // the ServiceContext isn't needed.
+            auto fixedDoc = fixDocumentForInsert(nullptr, doc);
+            BSONObj toInsert = fixedDoc.getValue().isEmpty() ? doc : std::move(fixedDoc.getValue());
+            batch.emplace_back(batch.size(), std::move(toInsert));
+        }
+
+        for (auto&& stmt : batch) {
+            if (stmt.doc.objdata() < begin || stmt.doc.objdata() >= end) {
+                bytesCopied += stmt.doc.objsize();
+            }
+        }
+        docsInserted += batch.size();
+        benchmark::DoNotOptimize(batch.data());
+    }
+
+    state.SetItemsProcessed(docsInserted);
+    state.counters["bytesCopiedPerDoc"] =
+        docsInserted ? static_cast<double>(bytesCopied) / docsInserted : 0;
+}
+
+BENCHMARK(BM_InsertFromDocumentSequence)->Arg(1)->Arg(1000)->Arg(100000);
+
+}  // namespace
+}  // namespace mongo
@@ -249,6 +249,24 @@ TEST(CommandWriteOpsParsers, RealMultiInsert) {
     }
 }
 
+TEST(CommandWriteOpsParsers, DocumentSequenceInsertDocumentsAreViewsIntoTheMessage) {
+    const auto ns = NamespaceString("test", "foo");
+    auto cmd = BSON("insert" << ns.coll() << "documents"
+                             << BSON_ARRAY(BSON("_id" << 0) << BSON("_id" << 1)));
+    const auto message = toOpMsg(ns.db(), cmd, true).serialize();
+    const auto op = InsertOp::parse(OpMsgRequest::parse(message));
+
+    // The documents must keep the message buffer alive rather than hold copies of their own.
+    const char* begin = message.buf();
+    const char* end = begin + message.size();
+    ASSERT_EQ(op.getDocuments().size(), 2u);
+    for (auto&& doc : op.getDocuments()) {
+        ASSERT(doc.isOwned());
+        ASSERT_GTE(doc.objdata(), begin);
+        ASSERT_LTE(doc.objdata() + doc.objsize(), end);
+    }
+}
+
 TEST(CommandWriteOpsParsers, MultiInsertWithStmtId) {
     const auto ns = NamespaceString("test", "foo");
     const BSONObj obj0 = BSON("x" << 0);
@@ -80,6 +80,7 @@ void PeriodicThreadToDecreaseSnapshotHistoryCachePressure::_init(ServiceContext*
                 auto opCtx = client->makeOperationContext();
 
                 SnapshotWindowUtil::decreaseTargetSnapshotWindowSize(opCtx.get());
+                SnapshotWindowUtil::releaseIdleSnapshotHistory(opCtx.get());
             } catch (const DBException& ex) {
                 if (!ErrorCodes::isShutdownError(ex.toStatus().code())) {
                     warning() << "Periodic task to check for and decrease cache pressure caused by "
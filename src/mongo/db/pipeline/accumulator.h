@@ -76,6 +76,13 @@ public:
         processInternal(input, merging);
     }
 
+    /** Process a batch of inputs and update internal state, with the same result as calling
+     *  process() for each of them in order.
+     */
+    void processBatch(const std::vector<Value>& inputs, bool merging) {
+        processBatchInternal(inputs, merging);
+    }
+
     /** Marks the end of the evaluate() phase and return accumulated result.
      *  toBeMerged should be true when the outputs will be merged by process().
      */
@@ -109,6 +116,13 @@ protected:
     /// Update subclass's internal state based on input
     virtual void processInternal(const Value& input, bool merging) = 0;
 
+    /// Update subclass's internal state based on a batch of input, one input at a time by default
+    virtual void processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+        for (auto&& input : inputs) {
+            processInternal(input, merging);
+        }
+    }
+
     const boost::intrusive_ptr<ExpressionContext>& getExpressionContext() const {
         return _expCtx;
     }
@@ -120,6 +134,67 @@ private:
     boost::intrusive_ptr<ExpressionContext> _expCtx;
 };
 
+/**
+ * Collects the numeric values of a batch of inputs into contiguous arrays, so that the summing
+ * accumulators can add them with the batch kernels of DoubleDoubleSummation. Non-numeric values are
+ * skipped, since those accumulators ignore them.
+ */
+class NumericBatch {
+public:
+    /**
+     * Collects the numeric values in [first, last). Returns false if they can't all be added by a
+     * single kernel without changing the result: a Decimal128, or a mix of doubles and integers,
+     * has to be added one value at a time.
+     */
+    template <typename Iterator>
+    bool gather(Iterator first, Iterator last) {
+        doubles.clear();
+        integers.clear();
+        numLongs = 0;
+        for (; first != last; ++first) {
+            switch (first->getType()) {
+                case NumberDouble:
+                    doubles.push_back(first->getDouble());
+                    break;
+                case NumberLong:
+                    ++numLongs;
+                    integers.push_back(first->getLong());
+                    break;
+                case NumberInt:
+                    integers.push_back(first->getInt());
+                    break;
+                case NumberDecimal:
+                    return false;
+                default:
+                    break;
+            }
+        }
+        return doubles.empty() || integers.empty();
+    }
+
+    /**
+     * Returns the widest numeric type among the collected values, or EOO if there are none.
+     */
+    BSONType widestType() const {
+        if (!doubles.empty()) {
+            return NumberDouble;
+        }
+        if (numLongs > 0) {
+            return NumberLong;
+        }
+        return integers.empty() ? EOO : NumberInt;
+    }
+
+    size_t size() const {
+        return doubles.size() + integers.size();
+    }
+
+    std::vector<double> doubles;
+    // Both NumberInt and NumberLong values, 'numLongs' of which are NumberLong.
+    std::vector<long long> integers;
+    size_t numLongs = 0;
+};
+
 /**
  * A default parser for any accumulator that only takes a single expression as an argument. Returns
  * the expression to be evaluated by the accumulator and an Accumulator::Factory.
@@ -206,6 +281,7 @@ public:
     explicit AccumulatorSum(const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
     void processInternal(const Value& input, bool merging) final;
+    void processBatchInternal(const std::vector<Value>& inputs, bool merging) final;
     Value getValue(bool toBeMerged) final;
     const char* getOpName() const final;
     void reset() final;
@@ -238,6 +314,7 @@ public:
     AccumulatorMinMax(const boost::intrusive_ptr<ExpressionContext>& expCtx, Sense sense);
 
     void processInternal(const Value& input, bool merging) final;
+    void processBatchInternal(const std::vector<Value>& inputs, bool merging) final;
     Value getValue(bool toBeMerged) final;
     const char* getOpName() const final;
     void reset() final;
@@ -294,6 +371,7 @@ public:
     explicit AccumulatorAvg(const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
     void processInternal(const Value& input, bool merging) final;
+    void processBatchInternal(const std::vector<Value>& inputs, bool merging) final;
     Value getValue(bool toBeMerged) final;
     const char* getOpName() const final;
     void reset() final;
@@ -382,6 +460,17 @@ public:
     void reset() final;
 
 private:
+    /**
+     * Calls the reduce function on the buffered values and returns the result.
+     */
+    Value _reduce();
+
+    /**
+     * Re-reduces the buffered values down to a single value once there are enough of them, so
+     * that memory use for a key is bounded rather than growing with every emitted value.
+     */
+    void _reduceBufferedValuesIfNeeded();
+
     std::vector<Value> _values;
 
     std::string _funcSource;
@@ -93,6 +93,18 @@ void AccumulatorAvg::processInternal(const Value& input, bool merging) {
     _count++;
 }
 
+void AccumulatorAvg::processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+    NumericBatch batch;
+    if (merging || !batch.gather(inputs.begin(), inputs.end())) {
+        Accumulator::processBatchInternal(inputs, merging);
+        return;
+    }
+
+    _nonDecimalTotal.addDoubles(batch.doubles.data(), batch.doubles.size());
+    _nonDecimalTotal.addLongs(batch.integers.data(), batch.integers.size());
+    _count += batch.size();
+}
+
 intrusive_ptr<Accumulator> AccumulatorAvg::create(
     const boost::intrusive_ptr<ExpressionContext>& expCtx) {
     return new AccumulatorAvg(expCtx);
@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/javascript_execution.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 
@@ -82,37 +83,62 @@ void AccumulatorInternalJsReduce::processInternal(const Value& input, bool mergi
 
     _values.push_back(data["v"]);
     _memUsageBytes += data["v"].getApproximateSize();
+
+    _reduceBufferedValuesIfNeeded();
 }
 
-Value AccumulatorInternalJsReduce::getValue(bool toBeMerged) {
+Value AccumulatorInternalJsReduce::_reduce() {
     uassert(31241,
             "Cannot run server-side javascript without the javascript engine enabled",
             getGlobalScriptEngine());
 
-    auto val = [&]() {
-        if (_values.size() < 1) {
-            return Value{};
-        }
+    if (_values.size() < 1) {
+        return Value{};
+    }
+
+    BSONArrayBuilder bsonValues;
+    for (const auto& val : _values) {
+        bsonValues << val;
+    }
+
+    auto expCtx = getExpressionContext();
+    auto jsExec = expCtx->getJsExecWithScope();
+
+    ScriptingFunction func = jsExec->getScope()->createFunction(_funcSource.c_str());
+
+    uassert(31247, "The reduce function failed to parse in the javascript engine", func);
 
-        BSONArrayBuilder bsonValues;
-        for (const auto& val : _values) {
-            bsonValues << val;
-        }
+    // Function signature: reduce(key, values).
+    BSONObj params = BSON_ARRAY(_key << bsonValues.arr());
+    // For reduce, the key and values are both passed as 'params' so there's no need to set
+    // 'this'.
+    BSONObj thisObj;
+    return jsExec->callFunction(func, params, thisObj);
+}
 
-        auto expCtx = getExpressionContext();
-        auto jsExec = expCtx->getJsExecWithScope();
+void AccumulatorInternalJsReduce::_reduceBufferedValuesIfNeeded() {
+    if (_values.size() < 2) {
+        return;
+    }
 
-        ScriptingFunction func = jsExec->getScope()->createFunction(_funcSource.c_str());
+    // Like the legacy mapReduce implementation, rely on the reduce function being re-reducible:
+    // reduce(key, [reduce(key, values)]) must produce the same result as reduce(key, values).
+    // Also re-reduce before the buffered values get close to the maximum BSON size, since they
+    // are passed to the reduce function as a single array.
+    const auto threshold = internalQueryJsReduceBufferedValuesThreshold.load();
+    const bool tooManyValues = threshold > 0 && _values.size() >= static_cast<size_t>(threshold);
+    if (!tooManyValues && _memUsageBytes < BSONObjMaxUserSize / 2) {
+        return;
+    }
 
-        uassert(31247, "The reduce function failed to parse in the javascript engine", func);
+    auto reduced = _reduce();
+    _values.clear();
+    _values.push_back(reduced);
+    _memUsageBytes = sizeof(*this) + reduced.getApproximateSize();
+}
 
-        // Function signature: reduce(key, values).
-        BSONObj params = BSON_ARRAY(_key << bsonValues.arr());
-        // For reduce, the key and values are both passed as 'params' so there's no need to set
-        // 'this'.
-        BSONObj thisObj;
-        return jsExec->callFunction(func, params, thisObj);
-    }();
+Value AccumulatorInternalJsReduce::getValue(bool toBeMerged) {
+    auto val = _reduce();
 
     // If we're merging after this, wrap the value in the same format it was inserted in.
     if (toBeMerged) {
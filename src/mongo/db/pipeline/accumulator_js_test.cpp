@@ -37,9 +37,11 @@
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/process_interface_standalone.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/scripting/engine.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -170,6 +172,35 @@ TEST_F(MapReduceFixture, InternalJsReduceIdempotentOnlyWhenJSFunctionIsIdempoten
     ASSERT_EQUALS(expectedResult.getType(), result.getType());
 }
 
+TEST_F(MapReduceFixture, InternalJsReduceReReducesOnceBufferedValuesThresholdIsReached) {
+    const auto originalThreshold = internalQueryJsReduceBufferedValuesThreshold.load();
+    ON_BLOCK_EXIT([&] { internalQueryJsReduceBufferedValuesThreshold.store(originalThreshold); });
+
+    auto eval = std::string("function(key, values) { return Array.sum(values); };");
+    auto processValues = [&](int threshold) {
+        internalQueryJsReduceBufferedValuesThreshold.store(threshold);
+        auto accum = AccumulatorInternalJsReduce::create(getExpCtx());
+        for (int i = 1; i <= 100; ++i) {
+            accum->process(Value(DOC("eval" << eval << "data" << DOC("k" << 1 << "v" << i))),
+                           false);
+        }
+        return accum;
+    };
+
+    auto unbounded = processValues(0);
+    auto bounded = processValues(4);
+
+    // The bounded accumulator periodically reduces its buffered values, so it holds fewer of them
+    // but still produces the same result.
+    ASSERT_LT(bounded->getMemUsage(), unbounded->getMemUsage());
+
+    auto expectedResult = Value(5050.0);
+    ASSERT_VALUE_EQ(expectedResult, unbounded->getValue(false));
+    Value result = bounded->getValue(false);
+    ASSERT_VALUE_EQ(expectedResult, result);
+    ASSERT_EQUALS(expectedResult.getType(), result.getType());
+}
+
 TEST_F(MapReduceFixture, InternalJsReduceFailsWhenEvalContainsInvalidJavascript) {
     // Multiple source documents.
     {
@@ -31,6 +31,8 @@
 
 #include "mongo/db/pipeline/accumulator.h"
 
+#include <cmath>
+
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/expression.h"
@@ -62,6 +64,38 @@ void AccumulatorMinMax::processInternal(const Value& input, bool merging) {
     }
 }
 
+void AccumulatorMinMax::processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+    // When every non-nullish input is a double, the batch is reduced to its first best value with
+    // plain double comparisons, which order doubles like the ValueComparator does (NaN is lower
+    // than every number), and only that value is compared with the current one.
+    const Value* best = nullptr;
+    for (auto&& input : inputs) {
+        if (input.nullish()) {
+            continue;
+        }
+        if (input.getType() != NumberDouble) {
+            Accumulator::processBatchInternal(inputs, merging);
+            return;
+        }
+        if (!best) {
+            best = &input;
+            continue;
+        }
+
+        const double x = input.getDouble();
+        const double current = best->getDouble();
+        const bool better = _sense == MIN ? x < current || (std::isnan(x) && !std::isnan(current))
+                                          : x > current || (std::isnan(current) && !std::isnan(x));
+        if (better) {
+            best = &input;
+        }
+    }
+
+    if (best) {
+        processInternal(*best, merging);
+    }
+}
+
 Value AccumulatorMinMax::getValue(bool toBeMerged) {
     if (_val.missing()) {
         return Value(BSONNULL);
@@ -85,6 +85,20 @@ void AccumulatorSum::processInternal(const Value& input, bool merging) {
     }
 }
 
+void AccumulatorSum::processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+    NumericBatch batch;
+    if (merging || !batch.gather(inputs.begin(), inputs.end())) {
+        Accumulator::processBatchInternal(inputs, merging);
+        return;
+    }
+
+    if (batch.size() > 0) {
+        totalType = Value::getWidestNumeric(totalType, batch.widestType());
+        nonDecimalTotal.addDoubles(batch.doubles.data(), batch.doubles.size());
+        nonDecimalTotal.addLongs(batch.integers.data(), batch.integers.size());
+    }
+}
+
 intrusive_ptr<Accumulator> AccumulatorSum::create(
     const boost::intrusive_ptr<ExpressionContext>& expCtx) {
     return new AccumulatorSum(expCtx);
@@ -92,6 +92,15 @@ static void assertExpectedResults(
                 ASSERT_VALUE_EQ(op.second, result);
                 ASSERT_EQUALS(op.second.getType(), result.getType());
             }
+
+            // Asserts that result equals expected result when the input is processed as a batch.
+            {
+                auto accum = AccName::create(expCtx);
+                accum->processBatch(op.first, false);
+                Value result = accum->getValue(false);
+                ASSERT_VALUE_EQ(op.second, result);
+                ASSERT_EQUALS(op.second.getType(), result.getType());
+            }
         } catch (...) {
             log() << "failed with arguments: " << Value(op.first);
             throw;
@@ -331,6 +340,54 @@ TEST(Accumulators, Sum) {
          {{Value(9), Value()}, Value(9)}});
 }
 
+/**
+ * Asserts that processing 'inputs' as a batch gives the same result as processing them one at a
+ * time.
+ */
+template <typename AccName>
+static void assertBatchMatchesSequential(const intrusive_ptr<ExpressionContext>& expCtx,
+                                         const std::vector<Value>& inputs) {
+    auto sequential = AccName::create(expCtx);
+    for (auto&& input : inputs) {
+        sequential->process(input, false);
+    }
+    auto batched = AccName::create(expCtx);
+    batched->processBatch(inputs, false);
+
+    Value expected = sequential->getValue(false);
+    Value result = batched->getValue(false);
+    ASSERT_VALUE_EQ(expected, result);
+    ASSERT_EQUALS(expected.getType(), result.getType());
+}
+
+TEST(Accumulators, LongBatchesMatchSequentialProcessing) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+
+    std::vector<Value> doubles;
+    std::vector<Value> integers;
+    for (int i = 0; i < 41; ++i) {
+        doubles.push_back(Value(1.0 / (i + 1)));
+        integers.push_back(i % 3 ? Value(i * 1000003)
+                                 : Value(numeric_limits<long long>::max() - i));
+    }
+
+    std::vector<Value> doublesWithNaN = doubles;
+    doublesWithNaN[20] = Value(numeric_limits<double>::quiet_NaN());
+    doublesWithNaN[30] = Value(BSONNULL);
+
+    std::vector<Value> mixed = doubles;
+    mixed[10] = Value(7);
+    mixed[11] = Value(Decimal128("0.1"));
+    mixed[12] = Value("string"_sd);
+
+    for (auto&& inputs : {doubles, integers, doublesWithNaN, mixed}) {
+        assertBatchMatchesSequential<AccumulatorSum>(expCtx, inputs);
+        assertBatchMatchesSequential<AccumulatorAvg>(expCtx, inputs);
+        assertBatchMatchesSequential<AccumulatorMin>(expCtx, inputs);
+        assertBatchMatchesSequential<AccumulatorMax>(expCtx, inputs);
+    }
+}
+
 TEST(Accumulators, AddToSetRespectsCollation) {
     intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
     CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kAlwaysEqual);
@@ -57,6 +57,8 @@ constexpr StringData AggregationRequest::kPipelineName;
 constexpr StringData AggregationRequest::kCollationName;
 constexpr StringData AggregationRequest::kExplainName;
 constexpr StringData AggregationRequest::kAllowDiskUseName;
+constexpr StringData AggregationRequest::kResultCacheName;
+constexpr StringData AggregationRequest::kResultCacheMaxStalenessName;
 constexpr StringData AggregationRequest::kHintName;
 constexpr StringData AggregationRequest::kExchangeName;
 
@@ -210,6 +212,28 @@ StatusWith<AggregationRequest> AggregationRequest::parseFromBSON(
             } catch (const DBException& ex) {
                 return ex.toStatus();
             }
+        } else if (kResultCacheName == fieldName) {
+            if (elem.type() != BSONType::Object) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << kResultCacheName << " must be an object, not a "
+                                      << typeName(elem.type())};
+            }
+
+            Milliseconds maxStaleness{0};
+            for (auto&& optionElem : elem.embeddedObject()) {
+                if (kResultCacheMaxStalenessName != optionElem.fieldNameStringData()) {
+                    return {ErrorCodes::FailedToParse,
+                            str::stream() << "unrecognized field '" << optionElem.fieldName()
+                                          << "' in " << kResultCacheName};
+                }
+                if (!optionElem.isNumber() || optionElem.safeNumberLong() < 0) {
+                    return {ErrorCodes::BadValue,
+                            str::stream() << kResultCacheName << "." << kResultCacheMaxStalenessName
+                                          << " must be a non-negative number"};
+                }
+                maxStaleness = Milliseconds(optionElem.safeNumberLong());
+            }
+            request.setResultCacheMaxStaleness(maxStaleness);
         } else if (fieldName == "mergeByPBRT"_sd) {
             // TODO SERVER-41900: we must retain the ability to ingest the 'mergeByPBRT' field for
             // 4.4 upgrade purposes, since a 4.2 mongoS will always send {mergeByPBRT:true} to the
@@ -313,6 +337,12 @@ Document AggregationRequest::serializeToCommandObj() const {
          _writeConcern ? Value(_writeConcern->toBSON()) : Value()},
         // Only serialize runtime constants if any were specified.
         {kRuntimeConstants, _runtimeConstants ? Value(_runtimeConstants->toBSON()) : Value()},
+        // Only serialize the result cache options if the request opted in to the cache.
+        {kResultCacheName,
+         _resultCacheMaxStaleness
+             ? Value(Document{{kResultCacheMaxStalenessName,
+                               durationCount<Milliseconds>(*_resultCacheMaxStaleness)}})
+             : Value()},
     };
 }
 }  // namespace mongo
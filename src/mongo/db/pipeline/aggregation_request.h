@@ -39,6 +39,7 @@
 #include "mongo/db/pipeline/runtime_constants_gen.h"
 #include "mongo/db/query/explain_options.h"
 #include "mongo/db/write_concern_options.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
@@ -63,6 +64,8 @@ public:
     static constexpr StringData kHintName = "hint"_sd;
     static constexpr StringData kExchangeName = "exchange"_sd;
     static constexpr StringData kRuntimeConstants = "runtimeConstants"_sd;
+    static constexpr StringData kResultCacheName = "resultCache"_sd;
+    static constexpr StringData kResultCacheMaxStalenessName = "maxStalenessMS"_sd;
 
     static constexpr long long kDefaultBatchSize = 101;
 
@@ -216,6 +219,14 @@ public:
         return _runtimeConstants;
     }
 
+    /**
+     * Returns boost::none unless the request opted in to the aggregation result cache, in which
+     * case returns how stale a cached result it accepts.
+     */
+    boost::optional<Milliseconds> getResultCacheMaxStaleness() const {
+        return _resultCacheMaxStaleness;
+    }
+
     //
     // Setters for optional fields.
     //
@@ -280,6 +291,10 @@ public:
         _runtimeConstants = std::move(runtimeConstants);
     }
 
+    void setResultCacheMaxStaleness(boost::optional<Milliseconds> maxStaleness) {
+        _resultCacheMaxStaleness = maxStaleness;
+    }
+
 private:
     // Required fields.
     const NamespaceString _nss;
@@ -329,5 +344,9 @@ private:
     // A document containing runtime constants; i.e. values that do not change once computed (e.g.
     // $$NOW).
     boost::optional<RuntimeConstants> _runtimeConstants;
+
+    // If set, the request opted in to the aggregation result cache and accepts cached results up
+    // to this old even if the collection has been written to since.
+    boost::optional<Milliseconds> _resultCacheMaxStaleness;
 };
 }  // namespace mongo
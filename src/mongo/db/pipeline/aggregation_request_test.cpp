@@ -264,10 +264,55 @@ TEST(AggregationRequestTest, ShouldNotSerializeBatchSizeWhenExplainSet) {
     ASSERT_DOCUMENT_EQ(request.serializeToCommandObj(), expectedSerialization);
 }
 
+TEST(AggregationRequestTest, ShouldParseResultCacheOption) {
+    NamespaceString nss("a.collection");
+    auto request = AggregationRequest::parseFromBSON(
+        nss, fromjson("{pipeline: [], cursor: {}, resultCache: {maxStalenessMS: 500}}"));
+    ASSERT_OK(request.getStatus());
+    ASSERT_EQ(*request.getValue().getResultCacheMaxStaleness(), Milliseconds(500));
+
+    request = AggregationRequest::parseFromBSON(
+        nss, fromjson("{pipeline: [], cursor: {}, resultCache: {}}"));
+    ASSERT_OK(request.getStatus());
+    ASSERT_EQ(*request.getValue().getResultCacheMaxStaleness(), Milliseconds(0));
+
+    request = AggregationRequest::parseFromBSON(nss, fromjson("{pipeline: [], cursor: {}}"));
+    ASSERT_OK(request.getStatus());
+    ASSERT_FALSE(request.getValue().getResultCacheMaxStaleness());
+}
+
+TEST(AggregationRequestTest, ShouldSerializeResultCacheOptionIfSet) {
+    NamespaceString nss("a.collection");
+    AggregationRequest request(nss, {});
+    request.setResultCacheMaxStaleness(Milliseconds(250));
+
+    auto expectedSerialization = Document{
+        {AggregationRequest::kCommandName, nss.coll()},
+        {AggregationRequest::kPipelineName, Value(std::vector<Value>{})},
+        {AggregationRequest::kCursorName, Value(Document())},
+        {AggregationRequest::kResultCacheName,
+         Value(Document{{AggregationRequest::kResultCacheMaxStalenessName, 250LL}})}};
+    ASSERT_DOCUMENT_EQ(request.serializeToCommandObj(), expectedSerialization);
+}
+
 //
 // Error cases.
 //
 
+TEST(AggregationRequestTest, ShouldRejectInvalidResultCacheOption) {
+    NamespaceString nss("a.collection");
+    ASSERT_NOT_OK(AggregationRequest::parseFromBSON(
+                      nss, fromjson("{pipeline: [], cursor: {}, resultCache: true}"))
+                      .getStatus());
+    ASSERT_NOT_OK(
+        AggregationRequest::parseFromBSON(
+            nss, fromjson("{pipeline: [], cursor: {}, resultCache: {maxStalenessMS: -1}}"))
+            .getStatus());
+    ASSERT_NOT_OK(AggregationRequest::parseFromBSON(
+                      nss, fromjson("{pipeline: [], cursor: {}, resultCache: {unknown: 1}}"))
+                      .getStatus());
+}
+
 TEST(AggregationRequestTest, ShouldRejectNonArrayPipeline) {
     NamespaceString nss("a.collection");
     const BSONObj inputBson = fromjson("{pipeline: {}, cursor: {}}");
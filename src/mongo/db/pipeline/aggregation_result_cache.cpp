@@ -0,0 +1,172 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/aggregation_result_cache.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getAggregationResultCache = ServiceContext::declareDecoration<AggregationResultCache>();
+
+Counter64 hitsCounter;
+Counter64 missesCounter;
+Counter64 invalidationsCounter;
+Counter64 evictionsCounter;
+
+ServerStatusMetricField<Counter64> displayHits("query.aggregationResultCache.hits", &hitsCounter);
+ServerStatusMetricField<Counter64> displayMisses("query.aggregationResultCache.misses",
+                                                 &missesCounter);
+ServerStatusMetricField<Counter64> displayInvalidations(
+    "query.aggregationResultCache.invalidations", &invalidationsCounter);
+ServerStatusMetricField<Counter64> displayEvictions("query.aggregationResultCache.evictions",
+                                                    &evictionsCounter);
+
+// Approximate bookkeeping overhead of an entry, in addition to its key and results.
+constexpr size_t kEntryOverheadBytes = sizeof(std::string) + 64;
+
+}  // namespace
+
+AggregationResultCache* AggregationResultCache::get(ServiceContext* serviceContext) {
+    return &getAggregationResultCache(serviceContext);
+}
+
+AggregationResultCache* AggregationResultCache::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+std::string AggregationResultCache::makeKey(const NamespaceString& nss,
+                                            const UUID& uuid,
+                                            const BSONArray& serializedPipeline,
+                                            const BSONObj& collation,
+                                            const BSONObj& hint) {
+    BSONObjBuilder keyBob;
+    keyBob.append("ns", nss.ns());
+    uuid.appendToBuilder(&keyBob, "uuid");
+    keyBob.append("pipeline", serializedPipeline);
+    keyBob.append("collation", collation);
+    keyBob.append("hint", hint);
+    BSONObj key = keyBob.done();
+    return std::string(key.objdata(), key.objsize());
+}
+
+boost::optional<std::vector<BSONObj>> AggregationResultCache::lookup(const std::string& key,
+                                                                     long long writeGeneration,
+                                                                     Milliseconds maxStaleness,
+                                                                     Date_t now) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _entriesByKey.find(key);
+    if (it == _entriesByKey.end()) {
+        missesCounter.increment();
+        return boost::none;
+    }
+
+    auto entryIt = it->second;
+    if (entryIt->writeGeneration != writeGeneration && now - entryIt->cachedAt > maxStaleness) {
+        _erase(lk, entryIt);
+        invalidationsCounter.increment();
+        missesCounter.increment();
+        return boost::none;
+    }
+
+    // Move the entry to the front of the list to mark it as most recently used.
+    _entries.splice(_entries.begin(), _entries, entryIt);
+    hitsCounter.increment();
+    return entryIt->results;
+}
+
+void AggregationResultCache::insert(const std::string& key,
+                                    std::vector<BSONObj> results,
+                                    long long writeGeneration,
+                                    Date_t now) {
+    size_t sizeBytes = kEntryOverheadBytes + 2 * key.size();
+    for (auto&& result : results) {
+        sizeBytes += sizeof(BSONObj) + result.objsize();
+    }
+
+    const auto maxBytes = static_cast<size_t>(internalQueryAggregationResultCacheMaxBytes.load());
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _entriesByKey.find(key);
+    if (it != _entriesByKey.end()) {
+        _erase(lk, it->second);
+    }
+
+    if (sizeBytes > maxBytes) {
+        _evictToSize(lk, maxBytes);
+        return;
+    }
+
+    _entries.push_front({key, std::move(results), writeGeneration, now, sizeBytes});
+    _entriesByKey.emplace(key, _entries.begin());
+    _sizeBytes += sizeBytes;
+    _evictToSize(lk, maxBytes);
+}
+
+void AggregationResultCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries.clear();
+    _entriesByKey.clear();
+    _sizeBytes = 0;
+}
+
+size_t AggregationResultCache::numEntries() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+size_t AggregationResultCache::sizeBytes() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _sizeBytes;
+}
+
+void AggregationResultCache::_erase(WithLock, EntryList::iterator it) {
+    _sizeBytes -= it->sizeBytes;
+    _entriesByKey.erase(it->key);
+    _entries.erase(it);
+}
+
+void AggregationResultCache::_evictToSize(WithLock lk, size_t maxBytes) {
+    while (_sizeBytes > maxBytes) {
+        invariant(!_entries.empty());
+        _erase(lk, std::prev(_entries.end()));
+        evictionsCounter.increment();
+    }
+}
+
+}  // namespace mongo
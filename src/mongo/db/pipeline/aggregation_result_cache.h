@@ -0,0 +1,129 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * A cache of the complete results of read-only aggregations, for clients which run the same
+ * aggregation repeatedly and opt in with the 'resultCache' aggregate option.
+ *
+ * Each entry records the write generation of its collection (see CollectionQueryInfo) read before
+ * the aggregation started to execute. An entry may be served while the collection's write
+ * generation is unchanged, or, if the request tolerates staleness, while the entry is no older
+ * than the requested bound. Entries are evicted in least-recently-used order once the cache holds
+ * more than 'internalQueryAggregationResultCacheMaxBytes' of results.
+ */
+class AggregationResultCache {
+public:
+    static AggregationResultCache* get(ServiceContext* serviceContext);
+    static AggregationResultCache* get(OperationContext* opCtx);
+
+    /**
+     * Builds the key under which the results of 'serializedPipeline' run against the collection
+     * 'nss' with UUID 'uuid' are cached. The remaining arguments are the options of the request
+     * which may affect its results.
+     */
+    static std::string makeKey(const NamespaceString& nss,
+                               const UUID& uuid,
+                               const BSONArray& serializedPipeline,
+                               const BSONObj& collation,
+                               const BSONObj& hint);
+
+    /**
+     * Returns the cached results for 'key', or boost::none if there are none which may be served.
+     * An entry may be served if 'writeGeneration' is the generation at which it was cached, or if
+     * it was cached no more than 'maxStaleness' before 'now'. An entry which may not be served is
+     * removed from the cache.
+     */
+    boost::optional<std::vector<BSONObj>> lookup(const std::string& key,
+                                                 long long writeGeneration,
+                                                 Milliseconds maxStaleness,
+                                                 Date_t now);
+
+    /**
+     * Caches 'results' under 'key', replacing any existing entry, and evicts the least recently
+     * used entries until the cache is within its size limit. Results larger than the limit are not
+     * cached.
+     */
+    void insert(const std::string& key,
+                std::vector<BSONObj> results,
+                long long writeGeneration,
+                Date_t now);
+
+    /**
+     * Removes all entries.
+     */
+    void clear();
+
+    size_t numEntries() const;
+
+    size_t sizeBytes() const;
+
+private:
+    struct Entry {
+        std::string key;
+        std::vector<BSONObj> results;
+        long long writeGeneration;
+        Date_t cachedAt;
+        size_t sizeBytes;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    void _erase(WithLock, EntryList::iterator it);
+    void _evictToSize(WithLock, size_t maxBytes);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("AggregationResultCache::_mutex");
+
+    // Entries in most-recently-used first order.
+    EntryList _entries;
+    stdx::unordered_map<std::string, EntryList::iterator> _entriesByKey;
+    size_t _sizeBytes = 0;
+};
+
+}  // namespace mongo
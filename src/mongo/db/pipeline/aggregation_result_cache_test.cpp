@@ -0,0 +1,165 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/pipeline/aggregation_result_cache.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kTestNss("test.coll");
+const Date_t kNow = Date_t::fromMillisSinceEpoch(100000);
+
+std::string makeTestKey(const UUID& uuid, const BSONArray& pipeline) {
+    return AggregationResultCache::makeKey(kTestNss, uuid, pipeline, BSONObj(), BSONObj());
+}
+
+std::vector<BSONObj> makeResults(int numResults) {
+    std::vector<BSONObj> results;
+    for (int i = 0; i < numResults; ++i) {
+        results.push_back(BSON("_id" << i));
+    }
+    return results;
+}
+
+TEST(AggregationResultCacheTest, KeyDependsOnPipelineAndCollection) {
+    const auto uuid = UUID::gen();
+    const auto pipeline = BSON_ARRAY(BSON("$match" << BSON("a" << 1)));
+    ASSERT_EQ(makeTestKey(uuid, pipeline), makeTestKey(uuid, pipeline));
+    ASSERT_NE(makeTestKey(uuid, pipeline),
+              makeTestKey(uuid, BSON_ARRAY(BSON("$match" << BSON("a" << 2)))));
+    ASSERT_NE(makeTestKey(uuid, pipeline), makeTestKey(UUID::gen(), pipeline));
+    ASSERT_NE(makeTestKey(uuid, pipeline),
+              AggregationResultCache::makeKey(
+                  kTestNss, uuid, pipeline, BSON("locale"
+                                                 << "fr"),
+                  BSONObj()));
+}
+
+TEST(AggregationResultCacheTest, LookupReturnsResultsCachedAtSameWriteGeneration) {
+    AggregationResultCache cache;
+    const auto key = makeTestKey(UUID::gen(), BSONArray());
+    ASSERT_FALSE(cache.lookup(key, 0, Milliseconds(0), kNow));
+
+    cache.insert(key, makeResults(3), 0, kNow);
+    ASSERT_EQ(cache.numEntries(), 1U);
+
+    auto results = cache.lookup(key, 0, Milliseconds(0), kNow + Seconds(10));
+    ASSERT(results);
+    ASSERT_EQ(results->size(), 3U);
+    ASSERT_BSONOBJ_EQ((*results)[2], BSON("_id" << 2));
+}
+
+TEST(AggregationResultCacheTest, LookupInvalidatesEntryAfterWrite) {
+    AggregationResultCache cache;
+    const auto key = makeTestKey(UUID::gen(), BSONArray());
+    cache.insert(key, makeResults(3), 0, kNow);
+
+    ASSERT_FALSE(cache.lookup(key, 1, Milliseconds(0), kNow));
+    ASSERT_EQ(cache.numEntries(), 0U);
+    ASSERT_EQ(cache.sizeBytes(), 0U);
+    ASSERT_FALSE(cache.lookup(key, 0, Milliseconds(0), kNow));
+}
+
+TEST(AggregationResultCacheTest, LookupToleratesWritesWithinMaxStaleness) {
+    AggregationResultCache cache;
+    const auto key = makeTestKey(UUID::gen(), BSONArray());
+    cache.insert(key, makeResults(3), 0, kNow);
+
+    ASSERT(cache.lookup(key, 5, Milliseconds(1000), kNow + Milliseconds(1000)));
+    ASSERT_FALSE(cache.lookup(key, 5, Milliseconds(1000), kNow + Milliseconds(1001)));
+    ASSERT_EQ(cache.numEntries(), 0U);
+}
+
+TEST(AggregationResultCacheTest, InsertReplacesExistingEntry) {
+    AggregationResultCache cache;
+    const auto key = makeTestKey(UUID::gen(), BSONArray());
+    cache.insert(key, makeResults(3), 0, kNow);
+    cache.insert(key, makeResults(1), 1, kNow);
+    ASSERT_EQ(cache.numEntries(), 1U);
+
+    ASSERT_FALSE(cache.lookup(key, 0, Milliseconds(0), kNow));
+    cache.insert(key, makeResults(1), 1, kNow);
+    auto results = cache.lookup(key, 1, Milliseconds(0), kNow);
+    ASSERT(results);
+    ASSERT_EQ(results->size(), 1U);
+}
+
+TEST(AggregationResultCacheTest, EvictsLeastRecentlyUsedEntryWhenFull) {
+    const auto uuid = UUID::gen();
+    const auto keyA = makeTestKey(uuid, BSON_ARRAY(BSON("$skip" << 1)));
+    const auto keyB = makeTestKey(uuid, BSON_ARRAY(BSON("$skip" << 2)));
+    const auto keyC = makeTestKey(uuid, BSON_ARRAY(BSON("$skip" << 3)));
+
+    // Measure the size of a single entry, then size the cache to hold exactly two of them.
+    size_t entrySize;
+    {
+        AggregationResultCache cache;
+        cache.insert(keyA, makeResults(10), 0, kNow);
+        entrySize = cache.sizeBytes();
+    }
+    const auto originalMaxBytes = internalQueryAggregationResultCacheMaxBytes.load();
+    ON_BLOCK_EXIT([&] { internalQueryAggregationResultCacheMaxBytes.store(originalMaxBytes); });
+    internalQueryAggregationResultCacheMaxBytes.store(2 * entrySize);
+
+    AggregationResultCache cache;
+    cache.insert(keyA, makeResults(10), 0, kNow);
+    cache.insert(keyB, makeResults(10), 0, kNow);
+    ASSERT_EQ(cache.numEntries(), 2U);
+
+    // Using 'keyA' makes 'keyB' the least recently used entry.
+    ASSERT(cache.lookup(keyA, 0, Milliseconds(0), kNow));
+    cache.insert(keyC, makeResults(10), 0, kNow);
+    ASSERT_EQ(cache.numEntries(), 2U);
+    ASSERT_LTE(cache.sizeBytes(), 2 * entrySize);
+    ASSERT(cache.lookup(keyA, 0, Milliseconds(0), kNow));
+    ASSERT_FALSE(cache.lookup(keyB, 0, Milliseconds(0), kNow));
+    ASSERT(cache.lookup(keyC, 0, Milliseconds(0), kNow));
+}
+
+TEST(AggregationResultCacheTest, DoesNotCacheResultsLargerThanLimit) {
+    const auto originalMaxBytes = internalQueryAggregationResultCacheMaxBytes.load();
+    ON_BLOCK_EXIT([&] { internalQueryAggregationResultCacheMaxBytes.store(originalMaxBytes); });
+    internalQueryAggregationResultCacheMaxBytes.store(1024);
+
+    AggregationResultCache cache;
+    const auto key = makeTestKey(UUID::gen(), BSONArray());
+    cache.insert(key, makeResults(1000), 0, kNow);
+    ASSERT_EQ(cache.numEntries(), 0U);
+    ASSERT_EQ(cache.sizeBytes(), 0U);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -95,18 +95,29 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::doGetNext() {
         }
         invariant(populationResult.isEOF());
 
-        populateBuckets();
+        initializeBuckets();
 
         _populated = true;
-        _bucketsIterator = _buckets.begin();
     }
 
-    if (_bucketsIterator == _buckets.end()) {
+    if (!_currentBucket) {
         dispose();
         return GetNextResult::makeEOF();
     }
 
-    return makeDocument(*(_bucketsIterator++));
+    // A bucket's max boundary is only known once the bucket after it has been populated, so each
+    // bucket is returned after its successor is built. This keeps at most two buckets, and their
+    // accumulated values, in memory at a time.
+    auto nextBucket = populateNextBucket();
+    if (nextBucket) {
+        adjustBoundaries(*_currentBucket, *nextBucket);
+    } else if (_granularityRounder) {
+        _currentBucket->_max = _granularityRounder->roundUp(_currentBucket->_max);
+    }
+
+    auto out = makeDocument(*_currentBucket);
+    _currentBucket = std::move(nextBucket);
+    return out;
 }
 
 DepsTracker::State DocumentSourceBucketAuto::getDependencies(DepsTracker* deps) const {
@@ -193,114 +204,107 @@ void DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Document>&
     }
 }
 
-void DocumentSourceBucketAuto::populateBuckets() {
+void DocumentSourceBucketAuto::initializeBuckets() {
     invariant(_sorter);
     _sortedInput.reset(_sorter->done());
     _sorter.reset();
 
-    // If there are no buckets, then we don't need to populate anything.
-    if (_nBuckets == 0) {
-        return;
-    }
-
     // Calculate the approximate bucket size. We attempt to fill each bucket with this many
     // documents.
-    long long approxBucketSize = std::round(double(_nDocuments) / double(_nBuckets));
+    _approxBucketSize = std::round(double(_nDocuments) / double(_nBuckets));
 
-    if (approxBucketSize < 1) {
+    if (_approxBucketSize < 1) {
         // If the number of buckets is larger than the number of documents, then we try to make as
         // many buckets as possible by placing each document in its own bucket.
-        approxBucketSize = 1;
+        _approxBucketSize = 1;
     }
 
-    boost::optional<pair<Value, Document>> firstEntryInNextBucket;
+    _currentBucket = populateNextBucket();
+    if (_currentBucket && _granularityRounder) {
+        // If we we have a granularity, we round the first bucket's minimum down and the last
+        // bucket's maximum up. This way all of the bucket boundaries are rounded to numbers in the
+        // granularity specification.
+        _currentBucket->_min = _granularityRounder->roundDown(_currentBucket->_min);
+    }
+}
 
-    // Start creating and populating the buckets.
-    for (int i = 0; i < _nBuckets; i++) {
-        bool isLastBucket = (i == _nBuckets - 1);
+boost::optional<DocumentSourceBucketAuto::Bucket> DocumentSourceBucketAuto::populateNextBucket() {
+    if (_nBucketsPopulated >= _nBuckets) {
+        return boost::none;
+    }
+    bool isLastBucket = (_nBucketsPopulated == _nBuckets - 1);
+
+    // Get the first value to place in this bucket.
+    pair<Value, Document> currentValue;
+    if (_firstEntryInNextBucket) {
+        currentValue = std::move(*_firstEntryInNextBucket);
+        _firstEntryInNextBucket = boost::none;
+    } else if (_sortedInput->more()) {
+        currentValue = _sortedInput->next();
+    } else {
+        // No more values to process.
+        return boost::none;
+    }
+    ++_nBucketsPopulated;
+
+    // Initialize the current bucket.
+    Bucket currentBucket(pExpCtx, currentValue.first, currentValue.first, _accumulatedFields);
+
+    // Add the first value into the current bucket.
+    addDocumentToBucket(currentValue, currentBucket);
+
+    if (isLastBucket) {
+        // If this is the last bucket allowed, we need to put any remaining documents in the current
+        // bucket.
+        while (_sortedInput->more()) {
+            addDocumentToBucket(_sortedInput->next(), currentBucket);
+        }
+        return currentBucket;
+    }
 
-        // Get the first value to place in this bucket.
-        pair<Value, Document> currentValue;
-        if (firstEntryInNextBucket) {
-            currentValue = *firstEntryInNextBucket;
-            firstEntryInNextBucket = boost::none;
-        } else if (_sortedInput->more()) {
-            currentValue = _sortedInput->next();
+    // We go to _approxBucketSize - 1 because we already added the first value in order to keep
+    // track of the minimum value.
+    for (long long j = 0; j < _approxBucketSize - 1; j++) {
+        if (_sortedInput->more()) {
+            addDocumentToBucket(_sortedInput->next(), currentBucket);
         } else {
             // No more values to process.
             break;
         }
+    }
 
-        // Initialize the current bucket.
-        Bucket currentBucket(pExpCtx, currentValue.first, currentValue.first, _accumulatedFields);
-
-        // Add the first value into the current bucket.
-        addDocumentToBucket(currentValue, currentBucket);
-
-        if (isLastBucket) {
-            // If this is the last bucket allowed, we need to put any remaining documents in
-            // the current bucket.
-            while (_sortedInput->more()) {
-                addDocumentToBucket(_sortedInput->next(), currentBucket);
-            }
-        } else {
-            // We go to approxBucketSize - 1 because we already added the first value in order
-            // to keep track of the minimum value.
-            for (long long j = 0; j < approxBucketSize - 1; j++) {
-                if (_sortedInput->more()) {
-                    addDocumentToBucket(_sortedInput->next(), currentBucket);
-                } else {
-                    // No more values to process.
-                    break;
-                }
-            }
+    boost::optional<pair<Value, Document>> nextValue = _sortedInput->more()
+        ? boost::optional<pair<Value, Document>>(_sortedInput->next())
+        : boost::none;
 
-            boost::optional<pair<Value, Document>> nextValue = _sortedInput->more()
+    if (_granularityRounder) {
+        Value boundaryValue = _granularityRounder->roundUp(currentBucket._max);
+        // If there are any values that now fall into this bucket after we round the boundary,
+        // absorb them into this bucket too.
+        while (nextValue &&
+               pExpCtx->getValueComparator().evaluate(boundaryValue > nextValue->first)) {
+            addDocumentToBucket(*nextValue, currentBucket);
+            nextValue = _sortedInput->more()
+                ? boost::optional<pair<Value, Document>>(_sortedInput->next())
+                : boost::none;
+        }
+        if (nextValue) {
+            currentBucket._max = boundaryValue;
+        }
+    } else {
+        // If there are any more values that are equal to the boundary value, then absorb them into
+        // the current bucket too.
+        while (nextValue &&
+               pExpCtx->getValueComparator().evaluate(currentBucket._max == nextValue->first)) {
+            addDocumentToBucket(*nextValue, currentBucket);
+            nextValue = _sortedInput->more()
                 ? boost::optional<pair<Value, Document>>(_sortedInput->next())
                 : boost::none;
-
-            if (_granularityRounder) {
-                Value boundaryValue = _granularityRounder->roundUp(currentBucket._max);
-                // If there are any values that now fall into this bucket after we round the
-                // boundary, absorb them into this bucket too.
-                while (nextValue &&
-                       pExpCtx->getValueComparator().evaluate(boundaryValue > nextValue->first)) {
-                    addDocumentToBucket(*nextValue, currentBucket);
-                    nextValue = _sortedInput->more()
-                        ? boost::optional<pair<Value, Document>>(_sortedInput->next())
-                        : boost::none;
-                }
-                if (nextValue) {
-                    currentBucket._max = boundaryValue;
-                }
-            } else {
-                // If there are any more values that are equal to the boundary value, then absorb
-                // them into the current bucket too.
-                while (nextValue &&
-                       pExpCtx->getValueComparator().evaluate(currentBucket._max ==
-                                                              nextValue->first)) {
-                    addDocumentToBucket(*nextValue, currentBucket);
-                    nextValue = _sortedInput->more()
-                        ? boost::optional<pair<Value, Document>>(_sortedInput->next())
-                        : boost::none;
-                }
-            }
-            firstEntryInNextBucket = nextValue;
         }
-
-        // Add the current bucket to the vector of buckets.
-        addBucket(currentBucket);
     }
+    _firstEntryInNextBucket = std::move(nextValue);
 
-    if (!_buckets.empty() && _granularityRounder) {
-        // If we we have a granularity, we round the first bucket's minimum down and the last
-        // bucket's maximum up. This way all of the bucket boundaries are rounded to numbers in the
-        // granularity specification.
-        Bucket& firstBucket = _buckets.front();
-        Bucket& lastBucket = _buckets.back();
-        firstBucket._min = _granularityRounder->roundDown(firstBucket._min);
-        lastBucket._max = _granularityRounder->roundUp(lastBucket._max);
-    }
+    return currentBucket;
 }
 
 DocumentSourceBucketAuto::Bucket::Bucket(
@@ -315,35 +319,31 @@ DocumentSourceBucketAuto::Bucket::Bucket(
     }
 }
 
-void DocumentSourceBucketAuto::addBucket(Bucket& newBucket) {
-    if (!_buckets.empty()) {
-        Bucket& previous = _buckets.back();
-        if (_granularityRounder) {
-            // If we have a granularity specified and if there is a bucket that comes before the new
-            // bucket being added, then the new bucket's min boundary is updated to be the
-            // previous bucket's max boundary. This makes it so that bucket boundaries follow the
-            // granularity, have inclusive minimums, and have exclusive maximums.
-
-            double prevMax = previous._max.coerceToDouble();
-            if (prevMax == 0.0) {
-                // Handle the special case where the largest value in the first bucket is zero. In
-                // this case, we take the minimum boundary of the second bucket and round it down.
-                // We then set the maximum boundary of the first bucket to be the rounded down
-                // value. This maintains that the maximum boundary of the first bucket is exclusive
-                // and the minimum boundary of the second bucket is inclusive.
-                previous._max = _granularityRounder->roundDown(newBucket._min);
-            }
-
-            newBucket._min = previous._max;
-        } else {
-            // If there is a bucket that comes before the new bucket being added, then the previous
-            // bucket's max boundary is updated to the new bucket's min. This makes it so that
-            // buckets' min boundaries are inclusive and max boundaries are exclusive (except for
-            // the last bucket, which has an inclusive max).
-            previous._max = newBucket._min;
+void DocumentSourceBucketAuto::adjustBoundaries(Bucket& previous, Bucket& newBucket) {
+    if (_granularityRounder) {
+        // If we have a granularity specified and if there is a bucket that comes before the new
+        // bucket being added, then the new bucket's min boundary is updated to be the
+        // previous bucket's max boundary. This makes it so that bucket boundaries follow the
+        // granularity, have inclusive minimums, and have exclusive maximums.
+
+        double prevMax = previous._max.coerceToDouble();
+        if (prevMax == 0.0) {
+            // Handle the special case where the largest value in the first bucket is zero. In
+            // this case, we take the minimum boundary of the second bucket and round it down.
+            // We then set the maximum boundary of the first bucket to be the rounded down
+            // value. This maintains that the maximum boundary of the first bucket is exclusive
+            // and the minimum boundary of the second bucket is inclusive.
+            previous._max = _granularityRounder->roundDown(newBucket._min);
         }
+
+        newBucket._min = previous._max;
+    } else {
+        // If there is a bucket that comes before the new bucket being added, then the previous
+        // bucket's max boundary is updated to the new bucket's min. This makes it so that
+        // buckets' min boundaries are inclusive and max boundaries are exclusive (except for
+        // the last bucket, which has an inclusive max).
+        previous._max = newBucket._min;
     }
-    _buckets.push_back(newBucket);
 }
 
 Document DocumentSourceBucketAuto::makeDocument(const Bucket& bucket) {
@@ -366,7 +366,8 @@ Document DocumentSourceBucketAuto::makeDocument(const Bucket& bucket) {
 
 void DocumentSourceBucketAuto::doDispose() {
     _sortedInput.reset();
-    _bucketsIterator = _buckets.end();
+    _currentBucket = boost::none;
+    _firstEntryInNextBucket = boost::none;
 }
 
 Value DocumentSourceBucketAuto::serialize(
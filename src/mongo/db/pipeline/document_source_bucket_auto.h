@@ -130,9 +130,15 @@ private:
     Value extractKey(const Document& doc);
 
     /**
-     * Calculates the bucket boundaries for the input documents and places them into buckets.
+     * Prepares to read the sorted input back and populates the first bucket.
      */
-    void populateBuckets();
+    void initializeBuckets();
+
+    /**
+     * Calculates the boundaries of the next bucket and places the input documents that fall into
+     * it into the bucket. Returns boost::none once all input has been placed into buckets.
+     */
+    boost::optional<Bucket> populateNextBucket();
 
     /**
      * Adds the document in 'entry' to 'bucket' by updating the accumulators in 'bucket'.
@@ -140,9 +146,10 @@ private:
     void addDocumentToBucket(const std::pair<Value, Document>& entry, Bucket& bucket);
 
     /**
-     * Adds 'newBucket' to _buckets and updates any boundaries if necessary.
+     * Updates the boundaries of 'previous' and of 'newBucket', which immediately follows it, if
+     * necessary.
      */
-    void addBucket(Bucket& newBucket);
+    void adjustBoundaries(Bucket& previous, Bucket& newBucket);
 
     /**
      * Makes a document using the information from bucket. This is what is returned when getNext()
@@ -158,8 +165,11 @@ private:
     int _nBuckets;
     uint64_t _maxMemoryUsageBytes;
     bool _populated = false;
-    std::vector<Bucket> _buckets;
-    std::vector<Bucket>::iterator _bucketsIterator;
+    long long _approxBucketSize = 0;
+    int _nBucketsPopulated = 0;
+    // The bucket to return next, whose max boundary may still depend on the bucket after it.
+    boost::optional<Bucket> _currentBucket;
+    boost::optional<std::pair<Value, Document>> _firstEntryInNextBucket;
     boost::intrusive_ptr<Expression> _groupByExpression;
     boost::intrusive_ptr<GranularityRounder> _granularityRounder;
     long long _nDocuments = 0;
@@ -245,7 +245,8 @@ std::string DocumentSourceChangeStream::getNsRegexForChangeStream(const Namespac
 BSONObj DocumentSourceChangeStream::buildMatchFilter(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     Timestamp startFromInclusive,
-    bool showMigrationEvents) {
+    bool showMigrationEvents,
+    bool includePostImages) {
     auto nss = expCtx->ns;
 
     ChangeStreamType sourceType = getChangeStreamType(nss);
@@ -307,9 +308,16 @@ BSONObj DocumentSourceChangeStream::buildMatchFilter(
                                            << "o2.type"
                                            << "migrateChunkToNewShard");
 
-    // Supported operations that are either (2.1) or (2.2).
-    BSONObj normalOrChunkMigratedMatch =
-        BSON(opNsMatch["ns"] << OR(normalOpTypeMatch, chunkMigratedNewShardMatch));
+    // 2.3) A post-image recorded for an update, which the transformation attaches to the update.
+    auto postImageMatch = BSON("op"
+                               << "n"
+                               << "o2.type"
+                               << "changeStreamPostImage");
+
+    // Supported operations that are either (2.1), (2.2) or, if requested, (2.3).
+    BSONObj normalOrChunkMigratedMatch = includePostImages
+        ? BSON(opNsMatch["ns"] << OR(normalOpTypeMatch, chunkMigratedNewShardMatch, postImageMatch))
+        : BSON(opNsMatch["ns"] << OR(normalOpTypeMatch, chunkMigratedNewShardMatch));
 
     // Filter excluding entries resulting from chunk migration.
     BSONObj notFromMigrateFilter = BSON("fromMigrate" << NE << true);
@@ -336,6 +344,133 @@ BSONObj DocumentSourceChangeStream::buildMatchFilter(
 
 namespace {
 
+const std::set<std::string> kCrudOpTypes{"d", "i", "u"};
+
+/**
+ * Returns the op types of the CRUD oplog entries which produce events with the given
+ * 'operationType'.
+ */
+std::set<std::string> crudOpTypesForOperationType(StringData operationType) {
+    if (operationType == DocumentSourceChangeStream::kInsertOpType) {
+        return {"i"};
+    } else if (operationType == DocumentSourceChangeStream::kUpdateOpType ||
+               operationType == DocumentSourceChangeStream::kReplaceOpType) {
+        return {"u"};
+    } else if (operationType == DocumentSourceChangeStream::kDeleteOpType) {
+        return {"d"};
+    }
+    return {};
+}
+
+/**
+ * Returns the value 'condition' tests for equality, either directly or through $eq, or an EOO
+ * element if it is any other kind of condition.
+ */
+BSONElement getEqualityOperand(const BSONElement& condition) {
+    if (condition.type() != BSONType::Object) {
+        return condition;
+    }
+    BSONObj conditionObj = condition.embeddedObject();
+    if (conditionObj.nFields() == 1 && conditionObj.firstElementFieldNameStringData() == "$eq") {
+        return conditionObj.firstElement();
+    }
+    return BSONElement();
+}
+
+/**
+ * Translates an equality or $in condition on 'operationType' into a condition on the oplog 'op'
+ * field. Returns an empty object if 'condition' has another form or excludes no CRUD entries.
+ */
+BSONObj buildOpTypeFilter(const BSONElement& condition) {
+    std::set<std::string> allowed;
+    auto operand = getEqualityOperand(condition);
+    if (operand.type() == BSONType::String) {
+        allowed = crudOpTypesForOperationType(operand.valueStringData());
+    } else if (condition.type() == BSONType::Object &&
+               condition.embeddedObject().nFields() == 1 &&
+               condition.embeddedObject().firstElementFieldNameStringData() == "$in" &&
+               condition.embeddedObject().firstElement().type() == BSONType::Array) {
+        for (auto&& value : condition.embeddedObject().firstElement().embeddedObject()) {
+            if (value.type() != BSONType::String) {
+                return BSONObj();
+            }
+            auto opTypes = crudOpTypesForOperationType(value.valueStringData());
+            allowed.insert(opTypes.begin(), opTypes.end());
+        }
+    } else {
+        return BSONObj();
+    }
+
+    BSONArrayBuilder excluded;
+    for (auto&& opType : kCrudOpTypes) {
+        if (!allowed.count(opType)) {
+            excluded.append(opType);
+        }
+    }
+    auto excludedArr = excluded.arr();
+    return excludedArr.isEmpty() ? BSONObj() : BSON("op" << BSON("$nin" << excludedArr));
+}
+
+/**
+ * Translates an equality condition on 'documentKey._id' into a condition on the '_id' of the
+ * document in each kind of CRUD oplog entry. Returns an empty object if 'condition' has another
+ * form, or compares against a value whose equality semantics differ between the two, such as
+ * null, arrays and objects.
+ */
+BSONObj buildDocumentKeyIdFilter(const BSONElement& condition) {
+    auto operand = getEqualityOperand(condition);
+    switch (operand.type()) {
+        case BSONType::EOO:
+        case BSONType::Object:
+        case BSONType::Array:
+        case BSONType::RegEx:
+        case BSONType::jstNULL:
+        case BSONType::Undefined:
+            return BSONObj();
+        default:
+            break;
+    }
+
+    // Inserts and deletes carry the _id in 'o', updates in 'o2'.
+    BSONObjBuilder insertOrDelete;
+    insertOrDelete.append("op", BSON("$in" << BSON_ARRAY("i"
+                                                         << "d")));
+    insertOrDelete.appendAs(operand, "o._id");
+    BSONObjBuilder update;
+    update.append("op", "u");
+    update.appendAs(operand, "o2._id");
+
+    BSONArrayBuilder crudOpTypes;
+    for (auto&& opType : kCrudOpTypes) {
+        crudOpTypes.append(opType);
+    }
+    return BSON("$or" << BSON_ARRAY(BSON("op" << BSON("$nin" << crudOpTypes.arr()))
+                                    << insertOrDelete.obj() << update.obj()));
+}
+
+void appendOplogFiltersForEventFilter(const BSONObj& eventFilter, BSONArrayBuilder* filters) {
+    for (auto&& elem : eventFilter) {
+        BSONObj filter;
+        if (elem.fieldNameStringData() == DocumentSourceChangeStream::kOperationTypeField) {
+            filter = buildOpTypeFilter(elem);
+        } else if (elem.fieldNameStringData() == "documentKey._id"_sd) {
+            filter = buildDocumentKeyIdFilter(elem);
+        } else if (elem.fieldNameStringData() == "$and"_sd && elem.type() == BSONType::Array) {
+            // Every branch of a conjunction must hold, so each can be translated on its own.
+            for (auto&& branch : elem.embeddedObject()) {
+                if (branch.type() == BSONType::Object) {
+                    appendOplogFiltersForEventFilter(branch.embeddedObject(), filters);
+                }
+            }
+        }
+
+        // Conditions that cannot be translated are left out, which only widens the filter.
+        if (!filter.isEmpty()) {
+            filters->append(filter);
+        }
+    }
+}
+
 list<intrusive_ptr<DocumentSource>> buildPipeline(const intrusive_ptr<ExpressionContext>& expCtx,
                                                   const DocumentSourceChangeStreamSpec spec,
                                                   BSONElement elem) {
@@ -424,7 +559,8 @@ list<intrusive_ptr<DocumentSource>> buildPipeline(const intrusive_ptr<Expression
     // We must always build the DSOplogMatch stage even on mongoS, since our validation logic relies
     // upon the fact that it is always the first stage in the pipeline.
     stages.push_back(DocumentSourceOplogMatch::create(
-        DocumentSourceChangeStream::buildMatchFilter(expCtx, *startFrom, showMigrationEvents),
+        DocumentSourceChangeStream::buildMatchFilter(
+            expCtx, *startFrom, showMigrationEvents, spec.getFullDocument() == "updateLookup"_sd),
         expCtx));
 
     // If we haven't already populated the initial PBRT, then we are starting from a specific
@@ -451,6 +587,17 @@ list<intrusive_ptr<DocumentSource>> buildPipeline(const intrusive_ptr<Expression
 
 }  // namespace
 
+BSONObj DocumentSourceChangeStream::buildOplogFilterForEventFilter(const BSONObj& eventFilter) {
+    BSONArrayBuilder filters;
+    appendOplogFiltersForEventFilter(eventFilter, &filters);
+    auto filtersArr = filters.arr();
+    if (filtersArr.isEmpty()) {
+        return BSONObj();
+    }
+    return filtersArr.nFields() == 1 ? filtersArr.firstElement().Obj().getOwned()
+                                     : BSON("$and" << filtersArr);
+}
+
 list<intrusive_ptr<DocumentSource>> DocumentSourceChangeStream::createFromBson(
     BSONElement elem, const intrusive_ptr<ExpressionContext>& expCtx) {
     uassert(50808,
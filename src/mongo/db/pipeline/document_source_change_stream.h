@@ -162,11 +162,24 @@ public:
 
     /**
      * Produce the BSON object representing the filter for the $match stage to filter oplog entries
-     * to only those relevant for this $changeStream stage.
+     * to only those relevant for this $changeStream stage. When 'includePostImages' is true, the
+     * filter also matches the no-op entries holding post-images recorded by collections with the
+     * 'recordPostImages' option.
      */
     static BSONObj buildMatchFilter(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                     Timestamp startFrom,
-                                    bool showMigrationEvents);
+                                    bool showMigrationEvents,
+                                    bool includePostImages = false);
+
+    /**
+     * Given 'eventFilter', a $match predicate on the change events produced by this stage, returns
+     * a predicate on the raw oplog entries that holds for every entry which could produce a
+     * matching event, or an empty object if no such predicate can be derived. Only equality and
+     * $in conditions on 'operationType' and equality on 'documentKey._id' are translated; they
+     * only ever exclude CRUD entries, so that commands, transactions and no-ops still reach the
+     * transformation. The predicate uses the simple collation.
+     */
+    static BSONObj buildOplogFilterForEventFilter(const BSONObj& eventFilter);
 
     /**
      * Parses a $changeStream stage from 'elem' and produces the $match and transformation
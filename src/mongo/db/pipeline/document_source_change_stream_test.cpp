@@ -29,6 +29,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <boost/intrusive_ptr.hpp>
 #include <memory>
 #include <vector>
@@ -354,6 +355,103 @@ public:
     }
 };
 
+TEST_F(ChangeStreamStageTest, ShouldTranslateOperationTypePredicatesToOplogFilter) {
+    ASSERT_BSONOBJ_EQ(
+        DSChangeStream::buildOplogFilterForEventFilter(fromjson("{operationType: 'insert'}")),
+        fromjson("{op: {$nin: ['d', 'u']}}"));
+    ASSERT_BSONOBJ_EQ(DSChangeStream::buildOplogFilterForEventFilter(
+                          fromjson("{operationType: {$in: ['update', 'replace', 'drop']}}")),
+                      fromjson("{op: {$nin: ['d', 'i']}}"));
+    ASSERT_BSONOBJ_EQ(DSChangeStream::buildOplogFilterForEventFilter(
+                          fromjson("{$and: [{operationType: {$eq: 'drop'}}, {x: 1}]}")),
+                      fromjson("{op: {$nin: ['d', 'i', 'u']}}"));
+
+    // Predicates which exclude no CRUD entries, or have another form, are not translated.
+    for (auto&& eventFilter : {"{operationType: {$in: ['insert', 'update', 'delete']}}",
+                               "{operationType: {$ne: 'insert'}}",
+                               "{$or: [{operationType: 'insert'}, {x: 1}]}",
+                               "{'fullDocument.x': 1}"}) {
+        ASSERT_BSONOBJ_EQ(DSChangeStream::buildOplogFilterForEventFilter(fromjson(eventFilter)),
+                          BSONObj());
+    }
+}
+
+TEST_F(ChangeStreamStageTest, ShouldTranslateDocumentKeyIdPredicatesToOplogFilter) {
+    ASSERT_BSONOBJ_EQ(
+        DSChangeStream::buildOplogFilterForEventFilter(
+            fromjson("{'documentKey._id': 5, operationType: 'delete'}")),
+        fromjson("{$and: [{$or: [{op: {$nin: ['d', 'i', 'u']}}, {op: {$in: ['i', 'd']}, "
+                 "'o._id': 5}, {op: 'u', 'o2._id': 5}]}, {op: {$nin: ['i', 'u']}}]}"));
+
+    for (auto&& eventFilter : {"{'documentKey._id': null}",
+                               "{'documentKey._id': {a: 1}}",
+                               "{'documentKey._id': {$gt: 5}}",
+                               "{documentKey: {_id: 5}}"}) {
+        ASSERT_BSONOBJ_EQ(DSChangeStream::buildOplogFilterForEventFilter(fromjson(eventFilter)),
+                          BSONObj());
+    }
+}
+
+TEST_F(ChangeStreamStageTest, ShouldPushUserMatchIntoOplogFilter) {
+    auto stages = DSChangeStream::createFromBson(kDefaultSpec.firstElement(), getExpCtx());
+    auto userMatch =
+        DocumentSourceMatch::create(fromjson("{operationType: 'insert'}"), getExpCtx());
+    stages.push_back(userMatch);
+
+    auto oplogMatch = dynamic_cast<DocumentSourceOplogMatch*>(stages.front().get());
+    ASSERT(oplogMatch);
+    const auto originalFilter = oplogMatch->getQuery();
+
+    auto transform = std::next(stages.begin());
+    (*transform)->optimizeAt(transform, &stages);
+    ASSERT_BSONOBJ_EQ(
+        oplogMatch->getQuery(),
+        BSON("$and" << BSON_ARRAY(originalFilter << fromjson("{op: {$nin: ['d', 'u']}}"))));
+
+    // The user's $match stays in the pipeline, and the oplog filter is only narrowed once.
+    ASSERT(stages.back() == userMatch);
+    (*transform)->optimizeAt(transform, &stages);
+    ASSERT_BSONOBJ_EQ(
+        oplogMatch->getQuery(),
+        BSON("$and" << BSON_ARRAY(originalFilter << fromjson("{op: {$nin: ['d', 'u']}}"))));
+}
+
+TEST_F(ChangeStreamStageTest, ShouldNotPushUserMatchIntoOplogFilterWhenResuming) {
+    auto resumeToken = makeResumeToken(kDefaultTs, testUuid(), BSON("_id" << 1));
+    auto spec = BSON(DSChangeStream::kStageName << BSON("resumeAfter" << resumeToken));
+    auto stages = DSChangeStream::createFromBson(spec.firstElement(), getExpCtx());
+    stages.push_back(
+        DocumentSourceMatch::create(fromjson("{operationType: 'insert'}"), getExpCtx()));
+
+    auto oplogMatch = dynamic_cast<DocumentSourceOplogMatch*>(stages.front().get());
+    ASSERT(oplogMatch);
+    const auto originalFilter = oplogMatch->getQuery();
+
+    auto transform = std::next(stages.begin());
+    (*transform)->optimizeAt(transform, &stages);
+    ASSERT_BSONOBJ_EQ(oplogMatch->getQuery(), originalFilter);
+}
+
+TEST_F(ChangeStreamStageTest, ShouldPushUserMatchIntoOplogFilterWhenCheckingShardResumability) {
+    auto spec = BSON(DSChangeStream::kStageName << BSON("startAtOperationTime" << kDefaultTs));
+    auto stages = DSChangeStream::createFromBson(spec.firstElement(), getExpCtx());
+    ASSERT(std::any_of(stages.begin(), stages.end(), [](auto&& stage) {
+        return dynamic_cast<DocumentSourceShardCheckResumability*>(stage.get());
+    }));
+    stages.push_back(
+        DocumentSourceMatch::create(fromjson("{operationType: 'insert'}"), getExpCtx()));
+
+    auto oplogMatch = dynamic_cast<DocumentSourceOplogMatch*>(stages.front().get());
+    ASSERT(oplogMatch);
+    const auto originalFilter = oplogMatch->getQuery();
+
+    auto transform = std::next(stages.begin());
+    (*transform)->optimizeAt(transform, &stages);
+    ASSERT_BSONOBJ_EQ(
+        oplogMatch->getQuery(),
+        BSON("$and" << BSON_ARRAY(originalFilter << fromjson("{op: {$nin: ['d', 'u']}}"))));
+}
+
 TEST_F(ChangeStreamStageTest, ShouldRejectNonObjectArg) {
     auto expCtx = getExpCtx();
 
@@ -634,6 +732,43 @@ TEST_F(ChangeStreamStageTest, TransformUpdateFields) {
     checkTransformation(updateField, expectedUpdateField);
 }
 
+TEST_F(ChangeStreamStageTest, UpdateLookupUsesPostImageRecordedInOplog) {
+    const repl::OpTime imageOpTime(Timestamp(100, 1), 1);
+    const repl::OpTime updateOpTime(Timestamp(100, 2), 1);
+    BSONObj postImage = BSON("_id" << 1 << "x" << 2 << "y" << 1);
+    auto noop = makeOplogEntry(OpTypeEnum::kNoop,                           // op type
+                               nss,                                         // namespace
+                               postImage,                                   // o
+                               testUuid(),                                  // uuid
+                               boost::none,                                 // fromMigrate
+                               BSON("type" << "changeStreamPostImage"_sd),  // o2
+                               imageOpTime);                                // opTime
+    auto updateEntry = makeOplogEntry(OpTypeEnum::kUpdate,             // op type
+                                      nss,                             // namespace
+                                      BSON("$set" << BSON("y" << 1)),  // o
+                                      testUuid(),                      // uuid
+                                      boost::none,                     // fromMigrate
+                                      BSON("_id" << 1),                // o2
+                                      updateOpTime);                   // opTime
+    BSONObjBuilder updateBuilder(updateEntry.toBSON());
+    updateBuilder.append(OplogEntry::kPostImageOpTimeFieldName, imageOpTime.toBSON());
+    BSONObj update = updateBuilder.obj();
+
+    auto stages = makeStages(update, fromjson("{$changeStream: {fullDocument: 'updateLookup'}}"));
+
+    // Scan the no-op holding the post-image ahead of the update, as it appears in the oplog. The
+    // mock process interface would fail any lookup against the collection.
+    auto mock = DocumentSourceMock::createForTest({D(noop.toBSON()), D(update)});
+    stages[1]->setSource(mock.get());
+
+    auto next = stages.back()->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    auto doc = next.releaseDocument();
+    ASSERT_VALUE_EQ(doc[DSChangeStream::kOperationTypeField], V(DSChangeStream::kUpdateOpType));
+    ASSERT_VALUE_EQ(doc[DSChangeStream::kFullDocumentField], V(postImage));
+    ASSERT_TRUE(stages.back()->getNext().isEOF());
+}
+
 // Legacy documents might not have an _id field; then the document key is the full (post-update)
 // document.
 TEST_F(ChangeStreamStageTest, TransformUpdateFieldsLegacyNoId) {
@@ -137,6 +137,48 @@ StageConstraints DocumentSourceChangeStreamTransform::constraints(
     return constraints;
 }
 
+Pipeline::SourceContainer::iterator DocumentSourceChangeStreamTransform::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+    // The oplog filter compares with the simple collation, so the user's predicates can only be
+    // translated when they do too.
+    if (_pushedDownEventFilter || itr == container->begin() || pExpCtx->getCollator()) {
+        return std::next(itr);
+    }
+    auto oplogMatch = dynamic_cast<DocumentSourceOplogMatch*>(std::prev(itr)->get());
+    if (!oplogMatch) {
+        return std::next(itr);
+    }
+
+    // Skip over the other change stream stages, none of which change the fields we translate. A
+    // stream resumed through DocumentSourceEnsureResumeTokenPresent must see the event its resume
+    // token refers to, whether or not the user's predicates match it, so its oplog filter is left
+    // alone. DocumentSourceShardCheckResumability never requires that event: it only swallows the
+    // events up to the token, and checks the oplog history itself when it sees none of them.
+    auto nextStage = std::next(itr);
+    while (nextStage != container->end() &&
+           (*nextStage)->constraints(Pipeline::SplitState::kUnsplit).isChangeStreamStage()) {
+        if (dynamic_cast<DocumentSourceEnsureResumeTokenPresent*>(nextStage->get())) {
+            return std::next(itr);
+        }
+        ++nextStage;
+    }
+    auto userMatch = nextStage != container->end()
+        ? dynamic_cast<DocumentSourceMatch*>(nextStage->get())
+        : nullptr;
+    if (!userMatch) {
+        return std::next(itr);
+    }
+
+    auto oplogFilter =
+        DocumentSourceChangeStream::buildOplogFilterForEventFilter(userMatch->getQuery());
+    if (!oplogFilter.isEmpty()) {
+        oplogMatch->rebuild(BSON("$and" << BSON_ARRAY(oplogMatch->getQuery() << oplogFilter)));
+        _pushedDownEventFilter = true;
+    }
+    return std::next(itr);
+}
+
 ResumeTokenData DocumentSourceChangeStreamTransform::getResumeToken(Value ts,
                                                                     Value uuid,
                                                                     Value documentKey) {
@@ -212,6 +254,18 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
 
         documentKeyFields = _documentKeyCache.find(uuid.getUuid())->second.documentKeyFields;
     }
+
+    // Use the post-image recorded for this update if we have just scanned past it.
+    boost::optional<Value> postImage;
+    if (_postImage && !_txnIterator && opType == repl::OpTypeEnum::kUpdate) {
+        Value postImageTs = input[repl::OplogEntry::kPostImageOpTimeFieldName]["ts"];
+        if (postImageTs.getType() == BSONType::bsonTimestamp &&
+            postImageTs.getTimestamp() == _postImage->first) {
+            postImage = std::move(_postImage->second);
+        }
+        _postImage = boost::none;
+    }
+
     Value id = input.getNestedField("o._id");
     // Non-replace updates have the _id in field "o2".
     StringData operationType;
@@ -253,6 +307,9 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
                 updateDescription = Value(Document{
                     {"updatedFields", updatedFields.missing() ? Value(Document()) : updatedFields},
                     {"removedFields", removedFieldsVector}});
+                if (postImage) {
+                    fullDocument = std::move(*postImage);
+                }
             } else {
                 operationType = DocumentSourceChangeStream::kReplaceOpType;
                 fullDocument = input[repl::OplogEntry::kObjectFieldName];
@@ -380,6 +437,7 @@ DepsTracker::State DocumentSourceChangeStreamTransform::getDependencies(DepsTrac
     deps->fields.insert(repl::OplogEntry::kObjectFieldName.toString());
     deps->fields.insert(repl::OplogEntry::kObject2FieldName.toString());
     deps->fields.insert(repl::OplogEntry::kPrevWriteOpTimeInTransactionFieldName.toString());
+    deps->fields.insert(repl::OplogEntry::kPostImageOpTimeFieldName.toString());
     deps->fields.insert(repl::OplogEntry::kSessionIdFieldName.toString());
     deps->fields.insert(repl::OplogEntry::kTermFieldName.toString());
     deps->fields.insert(repl::OplogEntry::kTxnNumberFieldName.toString());
@@ -418,6 +476,18 @@ DocumentSource::GetNextResult DocumentSourceChangeStreamTransform::doGetNext() {
         auto op = doc[repl::OplogEntry::kOpTypeFieldName];
         auto opType =
             repl::OpType_parse(IDLParserErrorContext("ChangeStreamEntry.op"), op.getStringData());
+        // Hold on to a recorded post-image until we reach the update it belongs to.
+        if (opType == repl::OpTypeEnum::kNoop &&
+            ValueComparator::kInstance.evaluate(doc.getNestedField("o2.type") ==
+                                                Value("changeStreamPostImage"_sd))) {
+            checkValueType(doc[repl::OplogEntry::kObjectFieldName],
+                           repl::OplogEntry::kObjectFieldName,
+                           BSONType::Object);
+            _postImage.emplace(doc[repl::OplogEntry::kTimestampFieldName].getTimestamp(),
+                               doc[repl::OplogEntry::kObjectFieldName]);
+            continue;
+        }
+
         auto commandVal = doc["o"];
         if (opType != repl::OpTypeEnum::kCommand ||
             (commandVal["applyOps"].missing() && commandVal["commitTransaction"].missing())) {
@@ -55,6 +55,14 @@ public:
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain) const;
     StageConstraints constraints(Pipeline::SplitState pipeState) const final;
 
+    /**
+     * Narrows the oplog filter preceding this stage with whatever part of a user $match following
+     * the change stream stages can be expressed on the raw oplog entries, so that fewer entries
+     * are transformed only to be discarded. The user $match itself is left in place.
+     */
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
     boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
         return boost::none;
     }
@@ -213,6 +221,11 @@ private:
     // Represents the current transaction we're unwinding, if any.
     boost::optional<TransactionOpIterator> _txnIterator;
 
+    // The last post-image recorded in the oplog by a collection with 'recordPostImages' set, keyed
+    // by the timestamp of the no-op entry holding it. Such entries are only scanned by streams
+    // using 'fullDocument: updateLookup', and precede the update that links to them.
+    boost::optional<std::pair<Timestamp, Value>> _postImage;
+
     // Set to true if this transformation stage can be run on the collectionless namespace.
     bool _isIndependentOfAnyCollection;
 
@@ -220,6 +233,9 @@ private:
     // This is a snapshot of what the feature compatibility version was at the time the stream was
     // opened or resumed.
     ServerGlobalParams::FeatureCompatibility::Version _fcv;
+
+    // Set once a user $match has been pushed into the oplog filter.
+    bool _pushedDownEventFilter = false;
 };
 
 }  // namespace mongo
@@ -89,6 +89,15 @@ intrusive_ptr<DocumentSource> DocumentSourceCollStats::createFromBson(
                     str::stream() << "queryExecStats argument must be an empty object, but got "
                                   << elem,
                     elem.embeddedObject().isEmpty());
+        } else if ("cacheStats" == fieldName) {
+            uassert(4031728,
+                    str::stream() << "cacheStats argument must be an empty object, but got " << elem
+                                  << " of type " << typeName(elem.type()),
+                    elem.type() == BSONType::Object);
+            uassert(4031729,
+                    str::stream() << "cacheStats argument must be an empty object, but got "
+                                  << elem,
+                    elem.embeddedObject().isEmpty());
         } else {
             uasserted(40168, str::stream() << "unrecognized option to $collStats: " << fieldName);
         }
@@ -161,6 +170,18 @@ DocumentSource::GetNextResult DocumentSourceCollStats::doGetNext() {
         }
     }
 
+    if (_collStatsSpec.hasField("cacheStats")) {
+        BSONObjBuilder cacheBuilder(builder.subobjStart("cacheStats"));
+        Status status = pExpCtx->mongoProcessInterface->appendCacheStats(
+            pExpCtx->opCtx, pExpCtx->ns, &cacheBuilder);
+        cacheBuilder.doneFast();
+        if (!status.isOK()) {
+            uasserted(4031730,
+                      str::stream() << "Unable to retrieve cacheStats in $collStats stage: "
+                                    << status.reason());
+        }
+    }
+
     return {Document(builder.obj())};
 }
 
@@ -33,6 +33,9 @@
 
 #include "mongo/db/pipeline/document_source_cursor.h"
 
+#include <algorithm>
+#include <boost/container/small_vector.hpp>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/working_set_common.h"
@@ -73,6 +76,50 @@ DocumentSource::GetNextResult DocumentSourceCursor::doGetNext() {
     return std::move(out);
 }
 
+Document DocumentSourceCursor::extractFieldsToProduce(const Document& doc) const {
+    // Walk the BSON backing the result rather than looking each field up in the document, which
+    // would cache every field preceding it. The extracted fields are owned, so the result's BSON
+    // need not be copied.
+    BSONObjBuilder extracted;
+    // The names found so far. A name may appear more than once in the BSON, so only the first
+    // occurrence counts towards having found every field.
+    boost::container::small_vector<StringData, 8> fieldsFound;
+    for (auto&& elem : doc.toBson()) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (!_fieldsToProduce->count(fieldName)) {
+            continue;
+        }
+        extracted.append(elem);
+        if (std::find(fieldsFound.begin(), fieldsFound.end(), fieldName) != fieldsFound.end()) {
+            continue;
+        }
+        fieldsFound.push_back(fieldName);
+        if (fieldsFound.size() == _fieldsToProduce->size()) {
+            break;
+        }
+    }
+
+    if (!doc.metadata()) {
+        return Document(extracted.obj());
+    }
+
+    MutableDocument out(Document(extracted.obj()));
+    out.copyMetaDataFrom(doc);
+    return out.freeze();
+}
+
+long long DocumentSourceCursor::nextBatchSizeBytes() {
+    // Re-read the maximum for each batch so that it may be changed while the pipeline runs.
+    const long long maxBatchSizeBytes = internalDocumentSourceCursorBatchSizeBytes.load();
+    if (!_batchSizeBytes) {
+        _batchSizeBytes = internalDocumentSourceCursorInitialBatchSizeBytes.load();
+    }
+
+    const long long batchSizeBytes = std::min(*_batchSizeBytes, maxBatchSizeBytes);
+    _batchSizeBytes = std::min(std::max(batchSizeBytes * 2, 1LL), maxBatchSizeBytes);
+    return batchSizeBytes;
+}
+
 void DocumentSourceCursor::loadBatch() {
     if (!_exec || _exec->isDisposed()) {
         // No more documents.
@@ -93,13 +140,16 @@ void DocumentSourceCursor::loadBatch() {
 
         _exec->restoreState();
 
-        int memUsageBytes = 0;
+        const long long batchSizeBytes = nextBatchSizeBytes();
+        long long memUsageBytes = 0;
         {
             ON_BLOCK_EXIT([this] { recordPlanSummaryStats(); });
 
             while ((state = _exec->getNext(&resultObj, nullptr)) == PlanExecutor::ADVANCED) {
                 if (_shouldProduceEmptyDocs) {
                     _currentBatch.push_back(Document());
+                } else if (_fieldsToProduce) {
+                    _currentBatch.push_back(transformDoc(extractFieldsToProduce(resultObj)));
                 } else {
                     _currentBatch.push_back(transformDoc(resultObj.getOwned()));
                 }
@@ -109,7 +159,7 @@ void DocumentSourceCursor::loadBatch() {
                 // As long as we're waiting for inserts, we shouldn't do any batching at this level
                 // we need the whole pipeline to see each document to see if we should stop waiting.
                 if (awaitDataState(pExpCtx->opCtx).shouldWaitForInserts ||
-                    memUsageBytes > internalDocumentSourceCursorBatchSizeBytes.load()) {
+                    memUsageBytes > batchSizeBytes) {
                     // End this batch and prepare PlanExecutor for yielding.
                     _exec->saveState();
                     return;
@@ -37,6 +37,7 @@
 #include "mongo/db/query/explain_options.h"
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -91,6 +92,16 @@ public:
         _shouldProduceEmptyDocs = true;
     }
 
+    /**
+     * If subsequent sources only need some of the top-level fields of the documents returned by the
+     * PlanExecutor, the cursor can output documents holding just those fields. They are copied out
+     * of each result's BSON in a single pass, keeping batches small and sparing later stages from
+     * looking fields up in the full documents.
+     */
+    void shouldProduceOnlyFields(StringSet topLevelFieldNames) {
+        _fieldsToProduce = std::move(topLevelFieldNames);
+    }
+
     Timestamp getLatestOplogTimestamp() const {
         return _latestOplogTimestamp;
     }
@@ -146,8 +157,20 @@ private:
      */
     void loadBatch();
 
+    /**
+     * Returns the number of bytes to cache in the batch about to be loaded, growing the batch size
+     * for the next one.
+     */
+    long long nextBatchSizeBytes();
+
     void recordPlanSummaryStats();
 
+    /**
+     * Returns a document holding only the fields of 'doc' named in '_fieldsToProduce', along with
+     * its metadata.
+     */
+    Document extractFieldsToProduce(const Document& doc) const;
+
     /**
      * If we are tailing the oplog, this method updates the cached timestamp to that of the latest
      * document returned, or the latest timestamp observed in the oplog if we have no more results.
@@ -157,8 +180,19 @@ private:
     // Batches results returned from the underlying PlanExecutor.
     std::deque<Document> _currentBatch;
 
+    // The amount of data, in bytes, to cache in the next batch. Starts at
+    // 'internalDocumentSourceCursorInitialBatchSizeBytes' and doubles each time the pipeline asks
+    // for another batch, up to 'internalDocumentSourceCursorBatchSizeBytes'. Pipelines which stop
+    // early, such as those ending in a $limit, thereby avoid fetching results they will never
+    // consume, while pipelines which drain the cursor amortize the cost of reacquiring locks and
+    // restoring '_exec' over increasingly large batches.
+    boost::optional<long long> _batchSizeBytes;
+
     bool _shouldProduceEmptyDocs = false;
 
+    // If set, the only top-level fields to keep in the documents returned by '_exec'.
+    boost::optional<StringSet> _fieldsToProduce;
+
     // The underlying query plan which feeds this pipeline. Must be destroyed while holding the
     // collection lock.
     std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> _exec;
@@ -45,6 +45,7 @@
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/tee_buffer.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/str.h"
 
@@ -184,6 +185,9 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
         return GetNextResult::makeEOF();
     }
 
+    const size_t maxBytes = internalQueryFacetMaxOutputDocSizeBytes.load();
+    size_t totalBytes = 0;
+
     vector<vector<Value>> results(_facets.size());
     bool allPipelinesEOF = false;
     while (!allPipelinesEOF) {
@@ -192,6 +196,14 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
             const auto& pipeline = _facets[facetId].pipeline;
             auto next = pipeline->getSources().back()->getNext();
             for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+                // Fail as soon as the output can no longer fit, rather than after the whole input
+                // has been consumed and every sub-pipeline's results are held in memory.
+                totalBytes += next.getDocument().getApproximateSize();
+                uassert(4031700,
+                        str::stream() << "document constructed by $facet is " << totalBytes
+                                      << " bytes, which exceeds the limit of " << maxBytes
+                                      << " bytes",
+                        totalBytes <= maxBytes);
                 results[facetId].emplace_back(next.releaseDocument());
             }
             allPipelinesEOF = allPipelinesEOF && next.isEOF();
@@ -44,8 +44,10 @@
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_skip.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 using std::deque;
@@ -334,6 +336,31 @@ TEST_F(DocumentSourceFacetTest, SingleFacetShouldReceiveAllDocuments) {
     ASSERT(facetStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceFacetTest, ShouldFailOnceAccumulatedOutputExceedsLimit) {
+    auto ctx = getExpCtx();
+
+    const auto originalLimit = internalQueryFacetMaxOutputDocSizeBytes.load();
+    ON_BLOCK_EXIT([&] { internalQueryFacetMaxOutputDocSizeBytes.store(originalLimit); });
+
+    const std::string bigStr(1024, 'x');
+    deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 10; ++i) {
+        inputs.emplace_back(Document{{"_id", i}, {"str", bigStr}});
+    }
+    internalQueryFacetMaxOutputDocSizeBytes.store(
+        5 * inputs.front().getDocument().getApproximateSize());
+    auto mock = DocumentSourceMock::createForTest(inputs);
+
+    std::vector<DocumentSourceFacet::FacetPipeline> facets;
+    facets.emplace_back("results",
+                        uassertStatusOK(Pipeline::createFacetPipeline(
+                            {DocumentSourcePassthrough::create()}, ctx)));
+    auto facetStage = DocumentSourceFacet::create(std::move(facets), ctx);
+    facetStage->setSource(mock.get());
+
+    ASSERT_THROWS_CODE(facetStage->getNext(), AssertionException, 4031700);
+}
+
 TEST_F(DocumentSourceFacetTest, MultipleFacetsShouldSeeTheSameDocuments) {
     auto ctx = getExpCtx();
 
@@ -42,6 +42,7 @@
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
 
 namespace mongo {
@@ -183,7 +184,7 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
         // Check whether each key in the frontier exists in the cache or needs to be queried.
         auto cached = pExpCtx->getDocumentComparator().makeUnorderedDocumentSet();
-        auto matchStage = makeMatchStageFromFrontier(&cached);
+        auto matchStages = makeMatchStagesFromFrontier(&cached);
 
         ValueUnorderedSet queried = pExpCtx->getValueComparator().makeUnorderedValueSet();
         _frontier.swap(queried);
@@ -198,12 +199,12 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
             checkMemoryUsage();
         }
 
-        if (matchStage) {
+        for (auto&& matchStage : matchStages) {
             // Query for all keys that were in the frontier and not in the cache, populating
             // '_frontier' for the next iteration of search.
 
             // We've already allocated space for the trailing $match stage in '_fromPipeline'.
-            _fromPipeline.back() = *matchStage;
+            _fromPipeline.back() = std::move(matchStage);
             auto pipeline =
                 pExpCtx->mongoProcessInterface->makePipeline(_fromPipeline, _fromExpCtx);
             while (auto next = pipeline->getNext()) {
@@ -278,7 +279,7 @@ void DocumentSourceGraphLookUp::addToCache(const Document& result,
         });
 }
 
-boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
+std::vector<BSONObj> DocumentSourceGraphLookUp::makeMatchStagesFromFrontier(
     DocumentUnorderedSet* cached) {
     // Add any cached values to 'cached' and remove them from '_frontier'.
     for (auto it = _frontier.begin(); it != _frontier.end();) {
@@ -296,35 +297,45 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
         }
     }
 
-    // Create a query of the form {$and: [_additionalFilter, {_connectToField: {$in: [...]}}]}.
-    //
-    // We wrap the query in a $match so that it can be parsed into a DocumentSourceMatch when
-    // constructing a pipeline to execute.
-    BSONObjBuilder match;
-    {
-        BSONObjBuilder query(match.subobjStart("$match"));
+    const size_t batchSize = internalGraphLookupFrontierBatchSize.load();
+
+    std::vector<BSONObj> matchStages;
+    auto frontierIt = _frontier.begin();
+    while (frontierIt != _frontier.end()) {
+        // Create a query of the form
+        // {$and: [_additionalFilter, {_connectToField: {$in: [...]}}]}.
+        //
+        // We wrap the query in a $match so that it can be parsed into a DocumentSourceMatch when
+        // constructing a pipeline to execute.
+        BSONObjBuilder match;
         {
-            BSONArrayBuilder andObj(query.subarrayStart("$and"));
-            if (_additionalFilter) {
-                andObj << *_additionalFilter;
-            }
-
+            BSONObjBuilder query(match.subobjStart("$match"));
             {
-                BSONObjBuilder connectToObj(andObj.subobjStart());
+                BSONArrayBuilder andObj(query.subarrayStart("$and"));
+                if (_additionalFilter) {
+                    andObj << *_additionalFilter;
+                }
+
                 {
-                    BSONObjBuilder subObj(connectToObj.subobjStart(_connectToField.fullPath()));
+                    BSONObjBuilder connectToObj(andObj.subobjStart());
                     {
-                        BSONArrayBuilder in(subObj.subarrayStart("$in"));
-                        for (auto&& value : _frontier) {
-                            in << value;
+                        BSONObjBuilder subObj(
+                            connectToObj.subobjStart(_connectToField.fullPath()));
+                        {
+                            BSONArrayBuilder in(subObj.subarrayStart("$in"));
+                            for (size_t n = 0; n < batchSize && frontierIt != _frontier.end();
+                                 ++n, ++frontierIt) {
+                                in << *frontierIt;
+                            }
                         }
                     }
                 }
             }
         }
+        matchStages.push_back(match.obj());
     }
 
-    return _frontier.empty() ? boost::none : boost::optional<BSONObj>(match.obj());
+    return matchStages;
 }
 
 void DocumentSourceGraphLookUp::performSearch() {
@@ -62,6 +62,9 @@ std::string nextFileName() {
     return "extsort-doc-group." + std::to_string(documentSourceGroupFileCounter.fetchAndAdd(1));
 }
 
+// The maximum number of arguments buffered per accumulator before they are processed as a batch.
+constexpr size_t kMaxPendingArguments = 64;
+
 }  // namespace
 
 using boost::intrusive_ptr;
@@ -133,6 +136,10 @@ const char* DocumentSourceGroup::getSourceName() const {
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::doGetNext() {
+    if (_streaming) {
+        return getNextStreaming();
+    }
+
     if (!_initialized) {
         const auto initializationResult = initialize();
         if (initializationResult.isPaused()) {
@@ -141,10 +148,6 @@ DocumentSource::GetNextResult DocumentSourceGroup::doGetNext() {
         invariant(initializationResult.isEOF());
     }
 
-    for (auto&& accum : _currentAccumulators) {
-        accum->reset();  // Prep accumulators for a new group.
-    }
-
     if (_spilled) {
         return getNextSpilled();
     } else {
@@ -153,37 +156,26 @@ DocumentSource::GetNextResult DocumentSourceGroup::doGetNext() {
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
-    // We aren't streaming, and we have spilled to disk.
-    if (!_sorterIterator)
-        return GetNextResult::makeEOF();
-
-    _currentId = _firstPartOfNextGroup.first;
-    const size_t numAccumulators = _accumulatedFields.size();
-    while (pExpCtx->getValueComparator().evaluate(_currentId == _firstPartOfNextGroup.first)) {
-        // Inside of this loop, _firstPartOfNextGroup is the current data being processed.
-        // At loop exit, it is the first value to be processed in the next group.
-        switch (numAccumulators) {  // mirrors switch in spill()
-            case 1:                 // Single accumulators serialize as a single Value.
-                _currentAccumulators[0]->process(_firstPartOfNextGroup.second, true);
-            case 0:  // No accumulators so no Values.
-                break;
-            default: {  // Multiple accumulators serialize as an array of Values.
-                const vector<Value>& accumulatorStates = _firstPartOfNextGroup.second.getArray();
-                for (size_t i = 0; i < numAccumulators; i++) {
-                    _currentAccumulators[i]->process(accumulatorStates[i], true);
-                }
-            }
-        }
-
-        if (!_sorterIterator->more()) {
+    // We have spilled to disk. The groups are returned one spilled partition at a time, loading the
+    // next partition once all the groups of the current one have been returned.
+    while (groupsIterator == _groups->end()) {
+        if (_spilledPartitions.empty()) {
             dispose();
-            break;
+            return GetNextResult::makeEOF();
         }
 
-        _firstPartOfNextGroup = _sorterIterator->next();
+        // Every group of the previous partition has been returned.
+        _groups->clear();
+        _memoryUsageBytes = 0;
+
+        auto partition = std::move(_spilledPartitions.back());
+        _spilledPartitions.pop_back();
+        loadSpilledPartition(std::move(partition));
     }
 
-    return makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
+    Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->needsMerge);
+    ++groupsIterator;
+    return std::move(out);
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
@@ -199,10 +191,78 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     return std::move(out);
 }
 
+DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
+    while (_streamingOutput.empty()) {
+        if (_streamingInputExhausted) {
+            dispose();
+            return GetNextResult::makeEOF();
+        }
+
+        if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+            // The groups of a single run don't fit in memory. Every group returned so far was
+            // complete, so the rest of the input is grouped as if it wasn't sorted.
+            _streaming = false;
+            return doGetNext();
+        }
+
+        auto input = pSource->getNext();
+        if (input.isPaused()) {
+            return input;
+        }
+
+        if (input.isEOF()) {
+            _streamingInputExhausted = true;
+            flushStreamingRun();
+            continue;
+        }
+
+        auto rootDocument = input.releaseDocument();
+        Value id = computeId(rootDocument);
+        Value runKey = makeStreamingRunKey(id);
+        if (_streamingRunKey &&
+            pExpCtx->getValueComparator().evaluate(*_streamingRunKey != runKey)) {
+            flushStreamingRun();
+        }
+        _streamingRunKey = std::move(runKey);
+        accumulate(rootDocument, id);
+    }
+
+    Document out = std::move(_streamingOutput.front());
+    _streamingOutput.pop_front();
+    return std::move(out);
+}
+
+void DocumentSourceGroup::flushStreamingRun() {
+    flushPendingArguments();
+    for (auto&& group : *_groups) {
+        _streamingOutput.push_back(makeDocument(group.first, group.second, pExpCtx->needsMerge));
+    }
+    _groups->clear();
+    _memoryUsageBytes = 0;
+    _streamingRunKey = boost::none;
+}
+
+Value DocumentSourceGroup::makeStreamingRunKey(const Value& id) const {
+    if (_idExpressions.size() == 1) {
+        // A missing key has already been replaced by null.
+        return id;
+    }
+
+    std::vector<Value> runKey;
+    runKey.reserve(id.getArrayLength());
+    for (auto&& value : id.getArray()) {
+        runKey.push_back(value.missing() ? Value(BSONNULL) : value);
+    }
+    return Value(std::move(runKey));
+}
+
 void DocumentSourceGroup::doDispose() {
     // Free our resources.
+    _pendingGroup = nullptr;
+    _pendingArguments.clear();
     _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
-    _sorterIterator.reset();
+    _spilledPartitions.clear();
+    _streamingOutput.clear();
 
     // Make us look done.
     groupsIterator = _groups->end();
@@ -220,9 +280,40 @@ intrusive_ptr<DocumentSource> DocumentSourceGroup::optimize() {
         accumulatedField.expression = accumulatedField.expression->optimize();
     }
 
+    // Accumulators such as {$min: X} and {$max: X} often share their argument. Find the ones whose
+    // argument is identical to an earlier accumulator's, so that 'accumulate()' evaluates it once.
+    _accumulatorArgumentSources.clear();
+    std::vector<Value> serializedArguments;
+    bool anyShared = false;
+    for (size_t i = 0; i < _accumulatedFields.size(); ++i) {
+        serializedArguments.push_back(_accumulatedFields[i].expression->serialize(false));
+        size_t source = i;
+        for (size_t j = 0; j < i; ++j) {
+            if (ValueComparator().evaluate(serializedArguments[j] == serializedArguments[i])) {
+                source = j;
+                anyShared = true;
+                break;
+            }
+        }
+        _accumulatorArgumentSources.push_back(source);
+    }
+    if (!anyShared) {
+        _accumulatorArgumentSources.clear();
+    }
+
     return this;
 }
 
+size_t DocumentSourceGroup::getNumSharedAccumulatorArguments() const {
+    size_t numShared = 0;
+    for (size_t i = 0; i < _accumulatorArgumentSources.size(); ++i) {
+        if (_accumulatorArgumentSources[i] != i) {
+            ++numShared;
+        }
+    }
+    return numShared;
+}
+
 Value DocumentSourceGroup::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     MutableDocument insides;
 
@@ -254,7 +345,22 @@ Value DocumentSourceGroup::serialize(boost::optional<ExplainOptions::Verbosity>
         insides["$doingMerge"] = Value(true);
     }
 
-    return Value(DOC(getSourceName() << insides.freeze()));
+    MutableDocument out;
+    out[getSourceName()] = insides.freezeToValue();
+
+    if (explain && _streaming) {
+        out["streaming"] = Value(true);
+    }
+
+    if (explain && *explain >= ExplainOptions::Verbosity::kExecStats) {
+        out["usedDisk"] = Value(_usedDisk);
+        out["spills"] = Value(static_cast<long long>(_spillStats.spills));
+        out["spilledPartitions"] = Value(static_cast<long long>(_spillStats.spilledPartitions));
+        out["spilledBytes"] = Value(static_cast<long long>(_spillStats.spilledBytes));
+        out["maxSpillPartitionDepth"] = Value(_spillStats.maxSpillPartitionDepth);
+    }
+
+    return out.freezeToValue();
 }
 
 DepsTracker::State DocumentSourceGroup::getDependencies(DepsTracker* deps) const {
@@ -334,6 +440,7 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
       _initialized(false),
       _groups(pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>()),
       _spilled(false),
+      _numSpillPartitions(internalDocumentSourceGroupSpillPartitions.load()),
       _allowDiskUse(pExpCtx->allowDiskUse && !pExpCtx->inMongos) {
     if (!pExpCtx->inMongos && (pExpCtx->allowDiskUse || kDebugBuild)) {
         // We spill to disk in debug mode, regardless of allowDiskUse, to stress the system.
@@ -435,38 +542,143 @@ intrusive_ptr<DocumentSource> DocumentSourceGroup::createFromBson(
 
 namespace {
 
-using GroupsMap = DocumentSourceGroup::GroupsMap;
+/**
+ * Serializes the states of the accumulators of a group as written to a spilled partition. A single
+ * accumulator serializes as a single Value, and multiple accumulators as an array of Values.
+ */
+Value serializeAccumulatorStates(const DocumentSourceGroup::Accumulators& accumulators) {
+    switch (accumulators.size()) {
+        case 0:  // No values, essentially a distinct.
+            return Value();
+        case 1:  // Just one value, use optimized serialization as a single Value.
+            return accumulators[0]->getValue(/*toBeMerged=*/true);
+        default: {
+            vector<Value> states;
+            states.reserve(accumulators.size());
+            for (auto&& accumulator : accumulators) {
+                states.push_back(accumulator->getValue(/*toBeMerged=*/true));
+            }
+            return Value(std::move(states));
+        }
+    }
+}
 
-class SorterComparator {
-public:
-    typedef pair<Value, Value> Data;
+/**
+ * Merges the accumulator states serialized by serializeAccumulatorStates() into 'accumulators'.
+ */
+void mergeAccumulatorStates(const Value& states, DocumentSourceGroup::Accumulators* accumulators) {
+    switch (accumulators->size()) {  // Mirrors the switch in serializeAccumulatorStates().
+        case 0:
+            break;
+        case 1:
+            (*accumulators)[0]->process(states, true);
+            break;
+        default: {
+            const vector<Value>& accumulatorStates = states.getArray();
+            for (size_t i = 0; i < accumulators->size(); i++) {
+                (*accumulators)[i]->process(accumulatorStates[i], true);
+            }
+        }
+    }
+}
 
-    SorterComparator(ValueComparator valueComparator) : _valueComparator(valueComparator) {}
+}  // namespace
 
-    int operator()(const Data& lhs, const Data& rhs) const {
-        return _valueComparator.compare(lhs.first, rhs.first);
+DocumentSourceGroup::Accumulators& DocumentSourceGroup::getGroupForUpdate(const Value& id,
+                                                                          bool* inserted) {
+    // Look for the _id value in the map. If it's not there, add a new entry with a blank
+    // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
+    // looking it up in '_groups' multiple times.
+    const size_t oldSize = _groups->size();
+    Accumulators& group = (*_groups)[id];
+    *inserted = _groups->size() != oldSize;
+
+    if (*inserted) {
+        _memoryUsageBytes += id.getApproximateSize();
+
+        // Add the accumulators
+        group.reserve(_accumulatedFields.size());
+        for (auto&& accumulatedField : _accumulatedFields) {
+            group.push_back(accumulatedField.makeAccumulator());
+        }
+    } else {
+        for (auto&& groupObj : group) {
+            // subtract old mem usage. New usage added back after processing.
+            _memoryUsageBytes -= groupObj->memUsageForSorter();
+        }
     }
 
-private:
-    ValueComparator _valueComparator;
-};
+    return group;
+}
+
+bool DocumentSourceGroup::accumulate(const Document& rootDocument, const Value& id) {
+    const size_t numAccumulators = _accumulatedFields.size();
 
-class SpillSTLComparator {
-public:
-    SpillSTLComparator(ValueComparator valueComparator) : _valueComparator(valueComparator) {}
+    bool inserted;
+    Accumulators& group = getGroupForUpdate(id, &inserted);
 
-    bool operator()(const GroupsMap::value_type* lhs, const GroupsMap::value_type* rhs) const {
-        return _valueComparator.evaluate(lhs->first < rhs->first);
+    /* tickle all the accumulators for the group we found */
+    dassert(numAccumulators == group.size());
+
+    const bool shareArguments = _accumulatorArgumentSources.size() == numAccumulators;
+    if (shareArguments) {
+        _accumulatorArguments.resize(numAccumulators);
     }
 
-private:
-    ValueComparator _valueComparator;
-};
-}  // namespace
+    // Merged inputs are partial results which gain nothing from batching, so they are processed
+    // right away.
+    const bool buffer = !_doingMerge && numAccumulators > 0;
+    if (buffer && &group != _pendingGroup) {
+        flushPendingArguments();
+        _pendingGroup = &group;
+        _pendingArguments.resize(numAccumulators);
+    }
 
-DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
-    const size_t numAccumulators = _accumulatedFields.size();
+    for (size_t i = 0; i < numAccumulators; i++) {
+        Value argument;
+        if (!shareArguments) {
+            argument =
+                _accumulatedFields[i].expression->evaluate(rootDocument, &pExpCtx->variables);
+        } else {
+            const size_t source = _accumulatorArgumentSources[i];
+            _accumulatorArguments[i] = source == i
+                ? _accumulatedFields[i].expression->evaluate(rootDocument, &pExpCtx->variables)
+                : _accumulatorArguments[source];
+            argument = _accumulatorArguments[i];
+        }
 
+        if (buffer) {
+            _pendingArguments[i].push_back(std::move(argument));
+        } else {
+            group[i]->process(argument, _doingMerge);
+        }
+
+        _memoryUsageBytes += group[i]->memUsageForSorter();
+    }
+
+    if (buffer && _pendingArguments[0].size() >= kMaxPendingArguments) {
+        flushPendingArguments();
+    }
+
+    return inserted;
+}
+
+void DocumentSourceGroup::flushPendingArguments() {
+    if (!_pendingGroup) {
+        return;
+    }
+
+    Accumulators& group = *_pendingGroup;
+    for (size_t i = 0; i < group.size(); i++) {
+        _memoryUsageBytes -= group[i]->memUsageForSorter();
+        group[i]->processBatch(_pendingArguments[i], false);
+        _memoryUsageBytes += group[i]->memUsageForSorter();
+        _pendingArguments[i].clear();
+    }
+    _pendingGroup = nullptr;
+}
+
+DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
     GetNextResult input = pSource->getNext();
     for (; input.isAdvanced(); input = pSource->getNext()) {
@@ -475,56 +687,23 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
                     "Exceeded memory limit for $group, but didn't allow external sort."
                     " Pass allowDiskUse:true to opt in.",
                     _allowDiskUse);
-            _sortedFiles.push_back(spill());
-            _memoryUsageBytes = 0;
+            spill();
         }
 
         // We release the result document here so that it does not outlive the end of this loop
         // iteration. Not releasing could lead to an array copy when this group follows an unwind.
         auto rootDocument = input.releaseDocument();
         Value id = computeId(rootDocument);
-
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<Accumulator>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
-
-        if (inserted) {
-            _memoryUsageBytes += id.getApproximateSize();
-
-            // Add the accumulators
-            group.reserve(numAccumulators);
-            for (auto&& accumulatedField : _accumulatedFields) {
-                group.push_back(accumulatedField.makeAccumulator());
-            }
-        } else {
-            for (auto&& groupObj : group) {
-                // subtract old mem usage. New usage added back after processing.
-                _memoryUsageBytes -= groupObj->memUsageForSorter();
-            }
-        }
-
-        /* tickle all the accumulators for the group we found */
-        dassert(numAccumulators == group.size());
-
-        for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(
-                _accumulatedFields[i].expression->evaluate(rootDocument, &pExpCtx->variables),
-                _doingMerge);
-
-            _memoryUsageBytes += group[i]->memUsageForSorter();
-        }
+        const bool inserted = accumulate(rootDocument, id);
 
         if (kDebugBuild && !storageGlobalParams.readOnly) {
             // In debug mode, spill every time we have a duplicate id to stress merge logic.
-            if (!inserted &&                 // is a dup
-                !pExpCtx->inMongos &&        // can't spill to disk in mongos
-                !_allowDiskUse &&            // don't change behavior when testing external sort
-                _sortedFiles.size() < 20) {  // don't open too many FDs
+            if (!inserted &&                // is a dup
+                !pExpCtx->inMongos &&       // can't spill to disk in mongos
+                !_allowDiskUse &&           // don't change behavior when testing external sort
+                _spillStats.spills < 20) {  // don't write too many runs
 
-                _sortedFiles.push_back(spill());
+                spill();
             }
         }
     }
@@ -538,35 +717,25 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
         }
         case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
             // Do any final steps necessary to prepare to output results.
-            if (!_sortedFiles.empty()) {
+            flushPendingArguments();
+            if (!_spilledPartitions.empty()) {
                 _spilled = true;
                 if (!_groups->empty()) {
-                    _sortedFiles.push_back(spill());
+                    spill();
                 }
 
-                // We won't be using groups again so free its memory.
-                _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
-
-                _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
-                    _sortedFiles,
-                    _fileName,
-                    SortOptions(),
-                    SorterComparator(pExpCtx->getValueComparator())));
-                _ownsFileDeletion = false;
-
-                // prepare current to accumulate data
-                _currentAccumulators.reserve(numAccumulators);
-                for (auto&& accumulatedField : _accumulatedFields) {
-                    _currentAccumulators.push_back(accumulatedField.makeAccumulator());
-                }
-
-                verify(_sorterIterator->more());  // we put data in, we should get something out.
-                _firstPartOfNextGroup = _sorterIterator->next();
-            } else {
-                // start the group iterator
-                groupsIterator = _groups->begin();
+                // Drop the partitions that never received any groups. The remaining ones are
+                // loaded and returned one at a time by getNextSpilled().
+                _spilledPartitions.erase(
+                    std::remove_if(_spilledPartitions.begin(),
+                                   _spilledPartitions.end(),
+                                   [](const SpilledPartition& p) { return p.runs.empty(); }),
+                    _spilledPartitions.end());
             }
 
+            // start the group iterator
+            groupsIterator = _groups->begin();
+
             // This must happen last so that, unless control gets here, we will re-enter
             // initialization after getting a GetNextResult::ResultState::kPauseExecution.
             _initialized = true;
@@ -580,48 +749,104 @@ bool DocumentSourceGroup::usedDisk() {
     return _usedDisk;
 }
 
-shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
+void DocumentSourceGroup::spill() {
+    flushPendingArguments();
+    spillToPartitions(&_spilledPartitions, 0);
+}
+
+void DocumentSourceGroup::spillToPartitions(std::vector<SpilledPartition>* partitions, int depth) {
     _usedDisk = true;
-    vector<const GroupsMap::value_type*> ptrs;  // using pointers to speed sorting
-    ptrs.reserve(_groups->size());
-    for (GroupsMap::const_iterator it = _groups->begin(), end = _groups->end(); it != end; ++it) {
-        ptrs.push_back(&*it);
+    ++_spillStats.spills;
+    _spillStats.maxSpillPartitionDepth = std::max(_spillStats.maxSpillPartitionDepth, depth);
+
+    if (partitions->empty()) {
+        partitions->resize(_numSpillPartitions);
+        for (auto&& partition : *partitions) {
+            partition.depth = depth;
+        }
     }
 
-    stable_sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(pExpCtx->getValueComparator()));
+    vector<vector<const GroupsMap::value_type*>> groupsByPartition(_numSpillPartitions);
+    for (auto&& group : *_groups) {
+        groupsByPartition[partitionFor(group.first, depth)].push_back(&group);
+    }
 
-    SortedFileWriter<Value, Value> writer(
-        SortOptions().TempDir(pExpCtx->tempDir), _fileName, _nextSortedFileWriterOffset);
-    switch (_accumulatedFields.size()) {  // same as ptrs[i]->second.size() for all i.
-        case 0:                           // no values, essentially a distinct
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first, Value());
-            }
-            break;
+    for (size_t i = 0; i < _numSpillPartitions; ++i) {
+        if (groupsByPartition[i].empty()) {
+            continue;
+        }
+
+        // All the runs are appended to a single file to stay below the open file limits. The runs
+        // aren't sorted, which is fine since they are only ever read back sequentially.
+        SortedFileWriter<Value, Value> writer(
+            SortOptions().TempDir(pExpCtx->tempDir), _fileName, _nextSortedFileWriterOffset);
+        for (auto&& group : groupsByPartition[i]) {
+            writer.addAlreadySorted(group->first, serializeAccumulatorStates(group->second));
+        }
+
+        (*partitions)[i].runs.emplace_back(writer.done());
+        _spillStats.spilledBytes += writer.getFileEndOffset() - _nextSortedFileWriterOffset;
+        _nextSortedFileWriterOffset = writer.getFileEndOffset();
+    }
+
+    _groups->clear();
+    _memoryUsageBytes = 0;
+}
+
+size_t DocumentSourceGroup::partitionFor(const Value& id, int depth) const {
+    // Salt the hash with the depth and mix its bits, so that the keys which share a partition at
+    // one depth are spread over all the partitions at the next.
+    uint64_t hash = pExpCtx->getValueComparator().hash(id) + depth * 0x9e3779b97f4a7c15ULL;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash % _numSpillPartitions;
+}
 
-        case 1:  // just one value, use optimized serialization as single Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first,
-                                        ptrs[i]->second[0]->getValue(/*toBeMerged=*/true));
+void DocumentSourceGroup::loadSpilledPartition(SpilledPartition partition) {
+    invariant(_groups->empty());
+    _memoryUsageBytes = 0;
+    ++_spillStats.spilledPartitions;
+
+    std::vector<SpilledPartition> subPartitions;
+    for (auto&& run : partition.runs) {
+        run->openSource();
+        while (run->more()) {
+            if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+                uassert(4031731,
+                        str::stream() << "Exceeded memory limit for $group: the groups of a spilled"
+                                         " partition still don't fit in memory after it was"
+                                         " re-partitioned "
+                                      << kMaxSpillPartitionDepth << " times",
+                        partition.depth < kMaxSpillPartitionDepth);
+                spillToPartitions(&subPartitions, partition.depth + 1);
             }
-            break;
 
-        default:  // multiple values, serialize as array-typed Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                vector<Value> accums;
-                for (size_t j = 0; j < ptrs[i]->second.size(); j++) {
-                    accums.push_back(ptrs[i]->second[j]->getValue(/*toBeMerged=*/true));
-                }
-                writer.addAlreadySorted(ptrs[i]->first, Value(std::move(accums)));
+            auto data = run->next();
+            bool inserted;
+            Accumulators& group = getGroupForUpdate(data.first, &inserted);
+            mergeAccumulatorStates(data.second, &group);
+            for (auto&& accumulator : group) {
+                _memoryUsageBytes += accumulator->memUsageForSorter();
             }
-            break;
+        }
+        run->closeSource();
     }
 
-    _groups->clear();
+    if (!subPartitions.empty()) {
+        // Some of the groups of this partition have been re-partitioned, so the remaining ones must
+        // follow them to be merged with their earlier partial results.
+        spillToPartitions(&subPartitions, partition.depth + 1);
+        for (auto&& subPartition : subPartitions) {
+            if (!subPartition.runs.empty()) {
+                _spilledPartitions.push_back(std::move(subPartition));
+            }
+        }
+    }
 
-    Sorter<Value, Value>::Iterator* iteratorPtr = writer.done();
-    _nextSortedFileWriterOffset = writer.getFileEndOffset();
-    return shared_ptr<Sorter<Value, Value>::Iterator>(iteratorPtr);
+    groupsIterator = _groups->begin();
 }
 
 Value DocumentSourceGroup::computeId(const Document& root) {
@@ -705,6 +930,31 @@ boost::optional<DocumentSource::DistributedPlanLogic> DocumentSourceGroup::distr
     return DistributedPlanLogic{this, mergingGroup, boost::none};
 }
 
+bool DocumentSourceGroup::canStreamOnInputSortedBy(const SortPattern& sortPattern) const {
+    std::set<std::string> idPaths;
+    for (auto&& idExpression : _idExpressions) {
+        auto fieldExp = dynamic_cast<ExpressionFieldPath*>(idExpression.get());
+        if (!fieldExp || !fieldExp->isRootFieldPath() ||
+            fieldExp->getFieldPath().getPathLength() == 1) {
+            return false;
+        }
+        idPaths.insert(fieldExp->getFieldPathWithoutCurrentPrefix().fullPath());
+    }
+
+    if (idPaths.size() > sortPattern.size()) {
+        return false;
+    }
+
+    // The order of the group keys doesn't matter, nor does the sort direction of each field.
+    for (size_t i = 0; i < idPaths.size(); ++i) {
+        const auto& sortPatternPart = sortPattern[i];
+        if (!sortPatternPart.fieldPath || !idPaths.count(sortPatternPart.fieldPath->fullPath())) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool DocumentSourceGroup::pathIncludedInGroupKeys(const std::string& dottedPath) const {
     return std::any_of(
         _idExpressions.begin(), _idExpressions.end(), [&dottedPath](const auto& exp) {
@@ -784,6 +1034,33 @@ DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
     return GroupFromFirstDocumentTransformation::create(pExpCtx, groupId, std::move(fields));
 }
 
+boost::optional<DocumentSourceGroup::CountOnlyGrouping> DocumentSourceGroup::getCountOnlyGrouping()
+    const {
+    if (!_idFieldNames.empty() || _doingMerge) {
+        return boost::none;
+    }
+
+    invariant(_idExpressions.size() == 1);
+    auto fieldPathExpr = dynamic_cast<ExpressionFieldPath*>(_idExpressions.front().get());
+    if (!fieldPathExpr || !fieldPathExpr->isRootFieldPath() ||
+        fieldPathExpr->getFieldPath().getPathLength() == 1) {
+        return boost::none;
+    }
+
+    CountOnlyGrouping grouping;
+    grouping.groupId = fieldPathExpr->getFieldPath().tail().fullPath();
+    for (auto&& accumulator : _accumulatedFields) {
+        auto constantExpr = dynamic_cast<ExpressionConstant*>(accumulator.expression.get());
+        if (!constantExpr || constantExpr->getValue().getType() != BSONType::NumberInt ||
+            "$sum"_sd != accumulator.makeAccumulator()->getOpName()) {
+            return boost::none;
+        }
+        grouping.countFields.emplace_back(accumulator.fieldName,
+                                          constantExpr->getValue().getInt());
+    }
+    return grouping;
+}
+
 }  // namespace mongo
 
 #include "mongo/db/sorter/sorter.cpp"
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <utility>
 
@@ -36,6 +37,7 @@
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/transformer_interface.h"
+#include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
@@ -93,6 +95,26 @@ public:
 
     static constexpr StringData kStageName = "$group"_sd;
 
+    // The number of times the groups of a spilled partition can be re-partitioned when they still
+    // don't fit in memory. A partition which still doesn't fit at this depth fails the query with
+    // a memory limit error, which can only happen when a few groups are individually very large.
+    static constexpr int kMaxSpillPartitionDepth = 4;
+
+    struct SpillStats {
+        // The number of times groups were written out to disk.
+        size_t spills = 0;
+
+        // The number of spilled partitions read back and re-aggregated, including the partitions
+        // produced by re-partitioning.
+        size_t spilledPartitions = 0;
+
+        // The total number of bytes written to disk.
+        size_t spilledBytes = 0;
+
+        // The deepest level of re-partitioning reached.
+        int maxSpillPartitionDepth = 0;
+    };
+
     boost::intrusive_ptr<DocumentSource> optimize() final;
     DepsTracker::State getDependencies(DepsTracker* deps) const final;
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
@@ -155,6 +177,30 @@ public:
         _doingMerge = doingMerge;
     }
 
+    /**
+     * Returns true if every group key of this $group is a field path, and together they are the
+     * leading fields of 'sortPattern'. The documents of each group are then adjacent in input
+     * sorted by 'sortPattern', as long as none of the sorted fields hold arrays.
+     */
+    bool canStreamOnInputSortedBy(const SortPattern& sortPattern) const;
+
+    /**
+     * Tell this source that its input keeps the documents of each group adjacent, such that each
+     * group can be returned as soon as a document from another group is read instead of after
+     * consuming the whole input. Defaults to false.
+     */
+    void setStreaming(bool streaming) {
+        _streaming = streaming;
+    }
+
+    bool isStreaming() const {
+        return _streaming;
+    }
+
+    const SpillStats& getSpillStats() const {
+        return _spillStats;
+    }
+
     /**
      * Returns true if this $group stage used disk during execution and false otherwise.
      */
@@ -176,6 +222,32 @@ public:
     std::unique_ptr<GroupFromFirstDocumentTransformation> rewriteGroupAsTransformOnFirstDocument()
         const;
 
+    /**
+     * Describes a $group on a single field whose accumulators each count the documents of a group,
+     * such as {$group: {_id: "$a", n: {$sum: 1}}}.
+     */
+    struct CountOnlyGrouping {
+        // The path of the field that we are grouping on.
+        std::string groupId;
+
+        // The name of each accumulated field, paired with the integer summed for each document.
+        std::vector<std::pair<std::string, long long>> countFields;
+    };
+
+    /**
+     * Returns the CountOnlyGrouping this $group performs when it groups on a single field path and
+     * every accumulator is a $sum of a constant 32-bit integer, and boost::none otherwise. Such a
+     * $group can be answered by counting the equal keys of an index on the grouped field.
+     */
+    boost::optional<CountOnlyGrouping> getCountOnlyGrouping() const;
+
+    /**
+     * Returns the number of accumulators whose argument expression is identical to that of an
+     * earlier accumulator, and so is not evaluated separately. Only known once optimize() has
+     * been called.
+     */
+    size_t getNumSharedAccumulatorArguments() const;
+
 protected:
     GetNextResult doGetNext() final;
     void doDispose() final;
@@ -187,13 +259,30 @@ private:
     ~DocumentSourceGroup();
 
     /**
-     * getNext() dispatches to one of these three depending on what type of $group it is. These
-     * methods expect '_currentAccumulators' to have been reset before being called, and also expect
-     * initialize() to have been called already.
+     * getNext() dispatches to one of these two depending on whether the $group spilled to disk.
+     * These methods expect initialize() to have been called already.
      */
     GetNextResult getNextSpilled();
     GetNextResult getNextStandard();
 
+    /**
+     * Returns the next group when streaming. The groups map only holds the groups of the current
+     * run of input documents, which are returned once a document from a later run is read.
+     */
+    GetNextResult getNextStreaming();
+
+    /**
+     * Moves the groups of the current run to '_streamingOutput' and clears the groups map.
+     */
+    void flushStreamingRun();
+
+    /**
+     * Returns the key identifying the run of sorted input that a document with group key 'id'
+     * belongs to. Sorting doesn't tell missing values apart from null, so the groups of a run may
+     * differ in which of their key fields are missing.
+     */
+    Value makeStreamingRunKey(const Value& id) const;
+
     /**
      * Before returning anything, this source must prepare itself. In a streaming $group,
      * initialize() requests the first document from the previous source, and uses it to prepare the
@@ -207,11 +296,61 @@ private:
     GetNextResult initialize();
 
     /**
-     * Spill groups map to disk and returns an iterator to the file. Note: Since a sorted $group
-     * does not exhaust the previous stage before returning, and thus does not maintain as large a
-     * store of documents at any one time, only an unsorted group can spill to disk.
+     * The spilled groups whose keys hash to the same partition. Each run holds the partial results
+     * written to the partition by one spill, and the runs are kept in the order they were written
+     * so that order-sensitive accumulators such as $first and $push see their inputs in order.
+     */
+    struct SpilledPartition {
+        // The number of times these groups have been re-partitioned.
+        int depth = 0;
+        std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> runs;
+    };
+
+    /**
+     * Feeds 'rootDocument' to the accumulators of the group with key 'id', creating the group if
+     * it doesn't exist yet. Returns true if the group was created.
+     */
+    bool accumulate(const Document& rootDocument, const Value& id);
+
+    /**
+     * Passes the accumulator arguments buffered for '_pendingGroup' to its accumulators, one
+     * processBatch() call per accumulator. Must be called before the groups map is read, spilled
+     * or cleared.
+     */
+    void flushPendingArguments();
+
+    /**
+     * Returns the accumulators of the group with key 'id', creating the group if it doesn't exist
+     * yet. The memory used by the accumulators is subtracted from '_memoryUsageBytes', and must be
+     * added back once they have processed their input.
      */
-    std::shared_ptr<Sorter<Value, Value>::Iterator> spill();
+    Accumulators& getGroupForUpdate(const Value& id, bool* inserted);
+
+    /**
+     * Spills the groups map to the partitions in '_spilledPartitions'.
+     */
+    void spill();
+
+    /**
+     * Writes every group in the groups map to the partition of 'partitions' its key hashes to at
+     * the given re-partitioning 'depth', appending a run to each partition that receives any
+     * groups, and clears the groups map.
+     */
+    void spillToPartitions(std::vector<SpilledPartition>* partitions, int depth);
+
+    /**
+     * Returns the index of the partition that 'id' belongs to at the given re-partitioning
+     * 'depth'. Keys sharing a partition at one depth are spread over all partitions at the next.
+     */
+    size_t partitionFor(const Value& id, int depth) const;
+
+    /**
+     * Re-aggregates the groups of 'partition' into the groups map, which must be empty. If the
+     * partition doesn't fit in memory, its groups are instead re-partitioned one level deeper and
+     * the resulting partitions are added to '_spilledPartitions', leaving the groups map empty.
+     * Throws if the partition doesn't fit in memory at kMaxSpillPartitionDepth.
+     */
+    void loadSpilledPartition(SpilledPartition partition);
 
     Document makeDocument(const Value& id, const Accumulators& accums, bool mergeableOutput);
 
@@ -233,6 +372,20 @@ private:
 
     std::vector<AccumulationStatement> _accumulatedFields;
 
+    // For each entry of '_accumulatedFields', the index of the first accumulator with an identical
+    // argument expression, so that each distinct argument is evaluated once per document. Set by
+    // optimize(), and left empty when no arguments are shared.
+    std::vector<size_t> _accumulatorArgumentSources;
+    // The arguments evaluated for the document being accumulated.
+    std::vector<Value> _accumulatorArguments;
+
+    // Unless merging, the arguments of consecutive documents that belong to the same group are
+    // buffered, one vector per accumulator, and processed as a batch once a document for another
+    // group arrives or the batch is full. This lets accumulators such as $sum use their batch
+    // kernels for single-group and sorted inputs.
+    Accumulators* _pendingGroup = nullptr;
+    std::vector<std::vector<Value>> _pendingArguments;
+
     bool _usedDisk;  // Keeps track of whether this $group spilled to disk.
     bool _doingMerge;
     size_t _memoryUsageBytes = 0;
@@ -246,25 +399,31 @@ private:
 
     bool _initialized;
 
-    Value _currentId;
-    Accumulators _currentAccumulators;
-
     // We use boost::optional to defer initialization until the ExpressionContext containing the
     // correct comparator is injected, since the groups must be built using the comparator's
     // definition of equality.
     boost::optional<GroupsMap> _groups;
 
-    std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> _sortedFiles;
+    // The spilled partitions that have yet to be returned. When '_spilled' is true, the groups
+    // map holds the groups of a single partition while they are being returned.
+    std::vector<SpilledPartition> _spilledPartitions;
     bool _spilled;
 
-    // Only used when '_spilled' is false.
+    // The number of partitions that groups are spilled to.
+    const size_t _numSpillPartitions;
+
+    SpillStats _spillStats;
+
+    // When streaming, holds the run key of the groups in the groups map, and the completed groups
+    // of the previous run which have yet to be returned.
+    bool _streaming = false;
+    bool _streamingInputExhausted = false;
+    boost::optional<Value> _streamingRunKey;
+    std::deque<Document> _streamingOutput;
+
     GroupsMap::iterator groupsIterator;
 
-    // Only used when '_spilled' is true.
-    std::unique_ptr<Sorter<Value, Value>::Iterator> _sorterIterator;
     const bool _allowDiskUse;
-
-    std::pair<Value, Value> _firstPartOfNextGroup;
 };
 
 }  // namespace mongo
@@ -204,6 +204,146 @@ TEST_F(DocumentSourceGroupTest, ShouldCorrectlyTrackMemoryUsageBetweenPauses) {
     ASSERT_THROWS_CODE(group->getNext(), AssertionException, 16945);
 }
 
+namespace {
+
+/**
+ * Runs {$group: {_id: '$k', sum: {$sum: '$v'}, first: {$first: '$v'}, all: {$push: '$v'}, pad:
+ * {$push: '$pad'}}} over 'numGroups' groups of four documents each, with the documents of each
+ * group spread over the input, while limiting memory to 'maxMemoryUsageBytes'. Checks the results
+ * and returns the spill statistics.
+ */
+DocumentSourceGroup::SpillStats runSpillingGroup(const intrusive_ptr<ExpressionContext>& expCtx,
+                                                 int numGroups,
+                                                 size_t padSize,
+                                                 size_t maxMemoryUsageBytes) {
+    auto makeStatement = [&](StringData accumulator, StringData field, StringData path) {
+        auto&& parser = AccumulationStatement::getParser(accumulator);
+        auto accumulatorArg = BSON("" << path);
+        auto [expression, factory] =
+            parser(expCtx, accumulatorArg.firstElement(), expCtx->variablesParseState);
+        return AccumulationStatement{field.toString(), expression, factory};
+    };
+    auto groupByExpression = ExpressionFieldPath::parse(expCtx, "$k", expCtx->variablesParseState);
+    auto group = DocumentSourceGroup::create(expCtx,
+                                             groupByExpression,
+                                             {makeStatement("$sum", "sum", "$v"),
+                                              makeStatement("$first", "first", "$v"),
+                                              makeStatement("$push", "all", "$v"),
+                                              makeStatement("$push", "pad", "$pad")},
+                                             maxMemoryUsageBytes);
+
+    const string pad(padSize, 'x');
+    deque<DocumentSource::GetNextResult> input;
+    for (int i = 0; i < 4 * numGroups; ++i) {
+        input.push_back(Document{{"k", i % numGroups}, {"v", i}, {"pad", pad}});
+    }
+    auto mock = DocumentSourceMock::createForTest(std::move(input));
+    group->setSource(mock.get());
+
+    stdx::unordered_set<int> keys;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        const int k = doc["_id"].coerceToInt();
+        ASSERT_TRUE(keys.insert(k).second);
+        ASSERT_VALUE_EQ(doc["sum"], Value(4 * k + 6 * numGroups));
+        ASSERT_VALUE_EQ(doc["first"], Value(k));
+        ASSERT_VALUE_EQ(doc["all"],
+                        Value(vector<Value>{Value(k),
+                                            Value(k + numGroups),
+                                            Value(k + 2 * numGroups),
+                                            Value(k + 3 * numGroups)}));
+        ASSERT_EQ(doc["pad"].getArrayLength(), 4UL);
+    }
+    ASSERT_TRUE(group->getNext().isEOF());
+    ASSERT_EQ(keys.size(), static_cast<size_t>(numGroups));
+    ASSERT_TRUE(group->usedDisk());
+
+    return group->getSpillStats();
+}
+
+}  // namespace
+
+TEST_F(DocumentSourceGroupTest, ShouldSpillToHashPartitions) {
+    auto expCtx = getExpCtx();
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+
+    // Every partition fits in memory once the groups are spread over the partitions.
+    auto stats = runSpillingGroup(expCtx, 100, 10, 10 * 1024);
+    ASSERT_GT(stats.spills, 0UL);
+    ASSERT_GT(stats.spilledPartitions, 1UL);
+    ASSERT_GT(stats.spilledBytes, 0UL);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldRepartitionSpilledPartitionsThatDontFitInMemory) {
+    auto expCtx = getExpCtx();
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+
+    // A single group fits in memory, but the partitions hold several groups that don't.
+    auto stats = runSpillingGroup(expCtx, 200, 500, 8 * 1024);
+    ASSERT_GT(stats.maxSpillPartitionDepth, 0);
+    ASSERT_GT(stats.spilledPartitions, 16UL);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldReturnTheGroupsOfEverySpilledPartition) {
+    auto expCtx = getExpCtx();
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+
+    // Enough groups to reach most partitions. runSpillingGroup() checks that every group is
+    // returned once, so the groups of each partition must be dropped before the next is loaded.
+    auto stats = runSpillingGroup(expCtx, 1000, 10, 16 * 1024);
+    ASSERT_GTE(stats.spilledPartitions, 8UL);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldFailWhenASpilledGroupNeverFitsInMemory) {
+    auto expCtx = getExpCtx();
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+
+    // Re-partitioning can't split a single group which is larger than the memory limit.
+    auto&& parser = AccumulationStatement::getParser("$push");
+    auto accumulatorArg = BSON(""
+                               << "$pad");
+    auto [expression, factory] =
+        parser(expCtx, accumulatorArg.firstElement(), expCtx->variablesParseState);
+    auto group = DocumentSourceGroup::create(
+        expCtx,
+        ExpressionFieldPath::parse(expCtx, "$k", expCtx->variablesParseState),
+        {AccumulationStatement{"pad", expression, factory}},
+        1024);
+
+    const string pad(2000, 'x');
+    deque<DocumentSource::GetNextResult> input;
+    for (int i = 0; i < 4; ++i) {
+        input.push_back(Document{{"k", 0}, {"pad", pad}});
+    }
+    auto mock = DocumentSourceMock::createForTest(std::move(input));
+    group->setSource(mock.get());
+
+    ASSERT_THROWS_CODE(group->getNext(), AssertionException, 4031731);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldReportSpillStatsInExplain) {
+    auto expCtx = getExpCtx();
+    auto groupByExpression = ExpressionFieldPath::parse(expCtx, "$k", expCtx->variablesParseState);
+    auto group = DocumentSourceGroup::create(expCtx, groupByExpression, {});
+
+    auto queryPlanner = group->serialize(ExplainOptions::Verbosity::kQueryPlanner).getDocument();
+    ASSERT_TRUE(queryPlanner["spills"].missing());
+
+    auto execStats = group->serialize(ExplainOptions::Verbosity::kExecStats).getDocument();
+    ASSERT_VALUE_EQ(execStats["usedDisk"], Value(false));
+    ASSERT_VALUE_EQ(execStats["spills"], Value(0LL));
+    ASSERT_VALUE_EQ(execStats["spilledPartitions"], Value(0LL));
+    ASSERT_VALUE_EQ(execStats["spilledBytes"], Value(0LL));
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldReportSingleFieldGroupKeyAsARename) {
     auto expCtx = getExpCtx();
     VariablesParseState vps = expCtx->variablesParseState;
@@ -242,6 +382,161 @@ TEST_F(DocumentSourceGroupTest, ShouldNotReportDottedGroupKeyAsARename) {
     ASSERT_EQ(modifiedPathsRet.renames.size(), 0UL);
 }
 
+AccumulationStatement makeCountStatement(const intrusive_ptr<ExpressionContext>& expCtx) {
+    auto&& parser = AccumulationStatement::getParser("$sum");
+    auto accumulatorArg = BSON("" << 1);
+    auto [expression, factory] =
+        parser(expCtx, accumulatorArg.firstElement(), expCtx->variablesParseState);
+    return AccumulationStatement{"count", expression, factory};
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldReturnEachGroupOnceItsRunOfSortedInputEnds) {
+    auto expCtx = getExpCtx();
+    auto groupByExpression = ExpressionFieldPath::parse(expCtx, "$k", expCtx->variablesParseState);
+    auto group =
+        DocumentSourceGroup::create(expCtx, groupByExpression, {makeCountStatement(expCtx)});
+    group->setStreaming(true);
+
+    auto mock =
+        DocumentSourceMock::createForTest({Document{{"k", 1}},
+                                           Document{{"k", 1}},
+                                           Document{{"k", 2}},
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document{{"k", 3}}});
+    group->setSource(mock.get());
+
+    // The first group is returned as soon as a document of the second group is read.
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 1}, {"count", 2}}));
+
+    ASSERT_TRUE(group->getNext().isPaused());
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 2}, {"count", 1}}));
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 3}, {"count", 1}}));
+
+    ASSERT_TRUE(group->getNext().isEOF());
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldStreamGroupsWhoseKeysDifferInMissingAndNullFields) {
+    auto expCtx = getExpCtx();
+    VariablesParseState vps = expCtx->variablesParseState;
+    auto x = ExpressionFieldPath::parse(expCtx, "$a", vps);
+    auto y = ExpressionFieldPath::parse(expCtx, "$b", vps);
+    auto groupByExpression = ExpressionObject::create(expCtx, {{"x", x}, {"y", y}});
+    auto group =
+        DocumentSourceGroup::create(expCtx, groupByExpression, {makeCountStatement(expCtx)});
+    group->setStreaming(true);
+
+    // Sorting on {a: 1, b: 1} mixes the documents missing 'b' with those where 'b' is null.
+    auto mock = DocumentSourceMock::createForTest(
+        {"{a: 1, b: null}", "{a: 1}", "{a: 1, b: null}", "{a: 2, b: 1}"});
+    group->setSource(mock.get());
+
+    // Both groups of the first run are returned once the second run starts, in any order.
+    vector<Document> firstRun;
+    for (int i = 0; i < 2; ++i) {
+        auto result = group->getNext();
+        ASSERT_TRUE(result.isAdvanced());
+        firstRun.push_back(result.releaseDocument());
+    }
+    if (firstRun[0]["count"].getInt() == 1) {
+        std::swap(firstRun[0], firstRun[1]);
+    }
+    ASSERT_DOCUMENT_EQ(firstRun[0], Document(fromjson("{_id: {x: 1, y: null}, count: 2}")));
+    ASSERT_DOCUMENT_EQ(firstRun[1], Document(fromjson("{_id: {x: 1}, count: 1}")));
+
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(),
+                       Document(fromjson("{_id: {x: 2, y: 1}, count: 1}")));
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldOnlyStreamOnSortsLeadingWithTheGroupKeys) {
+    auto expCtx = getExpCtx();
+    VariablesParseState vps = expCtx->variablesParseState;
+    auto a = ExpressionFieldPath::parse(expCtx, "$a", vps);
+    auto b = ExpressionFieldPath::parse(expCtx, "$b", vps);
+
+    auto sortedBy = [&](const char* sortSpec) { return SortPattern(fromjson(sortSpec), expCtx); };
+
+    auto singleKey = DocumentSourceGroup::create(expCtx, a, {});
+    ASSERT_TRUE(singleKey->canStreamOnInputSortedBy(sortedBy("{a: 1}")));
+    ASSERT_TRUE(singleKey->canStreamOnInputSortedBy(sortedBy("{a: -1, b: 1}")));
+    ASSERT_FALSE(singleKey->canStreamOnInputSortedBy(sortedBy("{b: 1, a: 1}")));
+    ASSERT_FALSE(singleKey->canStreamOnInputSortedBy(sortedBy("{'a.c': 1}")));
+
+    auto twoKeys = DocumentSourceGroup::create(
+        expCtx, ExpressionObject::create(expCtx, {{"x", a}, {"y", b}}), {});
+    ASSERT_TRUE(twoKeys->canStreamOnInputSortedBy(sortedBy("{b: 1, a: -1}")));
+    ASSERT_FALSE(twoKeys->canStreamOnInputSortedBy(sortedBy("{a: 1}")));
+    ASSERT_FALSE(twoKeys->canStreamOnInputSortedBy(sortedBy("{a: 1, c: 1}")));
+
+    auto computedKey = DocumentSourceGroup::create(
+        expCtx, Expression::parseExpression(expCtx, fromjson("{$toLower: '$a'}"), vps), {});
+    ASSERT_FALSE(computedKey->canStreamOnInputSortedBy(sortedBy("{a: 1}")));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldOnlyReportCountOnlyGroupingForSumsOfIntegerConstants) {
+    auto expCtx = getExpCtx();
+    auto groupingOf = [&](const char* groupSpec) {
+        auto spec = BSON("$group" << fromjson(groupSpec));
+        auto group = DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+        return static_cast<DocumentSourceGroup*>(group.get())->getCountOnlyGrouping();
+    };
+
+    auto grouping = groupingOf("{_id: '$a.b', n: {$sum: 1}, twice: {$sum: 2}}");
+    ASSERT(grouping);
+    ASSERT_EQ(grouping->groupId, "a.b");
+    ASSERT_EQ(grouping->countFields.size(), 2UL);
+    ASSERT_EQ(grouping->countFields[0].first, "n");
+    ASSERT_EQ(grouping->countFields[0].second, 1LL);
+    ASSERT_EQ(grouping->countFields[1].first, "twice");
+    ASSERT_EQ(grouping->countFields[1].second, 2LL);
+
+    grouping = groupingOf("{_id: '$a'}");
+    ASSERT(grouping);
+    ASSERT_TRUE(grouping->countFields.empty());
+
+    ASSERT_FALSE(groupingOf("{_id: '$a', n: {$sum: '$b'}}"));
+    ASSERT_FALSE(groupingOf("{_id: '$a', n: {$sum: 1.5}}"));
+    ASSERT_FALSE(groupingOf("{_id: '$a', n: {$max: 1}}"));
+    ASSERT_FALSE(groupingOf("{_id: {x: '$a'}, n: {$sum: 1}}"));
+    ASSERT_FALSE(groupingOf("{_id: '$$ROOT', n: {$sum: 1}}"));
+    ASSERT_FALSE(groupingOf("{_id: {$toLower: '$a'}, n: {$sum: 1}}"));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldEvaluateIdenticalAccumulatorArgumentsOnce) {
+    auto expCtx = getExpCtx();
+    auto spec = BSON("$group" << fromjson(
+                         "{_id: null, lo: {$min: {$add: ['$a', 1]}}, hi: {$max: {$add: ['$a', 1]}},"
+                         " total: {$sum: '$a'}, count: {$sum: 1}, last: {$last: '$a'}}"));
+    auto group = DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+    auto groupStage = static_cast<DocumentSourceGroup*>(group.get());
+    ASSERT_EQ(0UL, groupStage->getNumSharedAccumulatorArguments());
+
+    group = group->optimize();
+    ASSERT_EQ(2UL, groupStage->getNumSharedAccumulatorArguments());
+
+    auto mock = DocumentSourceMock::createForTest({"{a: 1}", "{a: 5}", "{a: 3}"});
+    group->setSource(mock.get());
+
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        result.releaseDocument(),
+        (Document{
+            {"_id", BSONNULL}, {"lo", 2}, {"hi", 6}, {"total", 9}, {"count", 3}, {"last", 3}}));
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
@@ -809,6 +1104,53 @@ private:
     }
 };
 
+/**
+ * Partial groups computed independently over disjoint partitions of the input, and merged by the
+ * merging half of the distributed plan, produce the same results as a single group.
+ */
+class PartitionedPartialGroups : public CheckResultsBase {
+public:
+    void _doTest() final {
+        const std::vector<deque<DocumentSource::GetNextResult>> partitions{
+            {DOC("x" << 0 << "y" << 1), DOC("x" << 1 << "y" << 2)},
+            {DOC("x" << 0 << "y" << 3), DOC("x" << 0 << "y" << 1)},
+            {DOC("x" << 1 << "y" << 6)}};
+
+        deque<DocumentSource::GetNextResult> partialResults;
+        for (auto&& partition : partitions) {
+            createGroup(groupSpec(), true);
+            auto source = DocumentSourceMock::createForTest(partition);
+            group()->setSource(source.get());
+            for (auto output = group()->getNext(); output.isAdvanced();
+                 output = group()->getNext()) {
+                partialResults.push_back(output.releaseDocument());
+            }
+        }
+
+        intrusive_ptr<DocumentSource> merger = createMerger();
+        auto partialSource = DocumentSourceMock::createForTest(partialResults);
+        merger->setSource(partialSource.get());
+        checkResultSet(merger);
+    }
+
+private:
+    BSONObj groupSpec() final {
+        return BSON("_id"
+                    << "$x"
+                    << "sum" << BSON("$sum"
+                                     << "$y")
+                    << "avg" << BSON("$avg"
+                                     << "$y")
+                    << "max" << BSON("$max"
+                                     << "$y")
+                    << "count" << BSON("$sum" << 1));
+    }
+    string expectedResultSetString() final {
+        return "[{_id:0,sum:5,avg:1.6666666666666667,max:3,count:3},"
+               "{_id:1,sum:8,avg:4,max:6,count:2}]";
+    }
+};
+
 /** Dependant field paths. */
 class Dependencies : public Base {
 public:
@@ -902,6 +1244,7 @@ public:
         add<ComplexId>();
         add<UndefinedAccumulatorValue>();
         add<RouterMerger>();
+        add<PartitionedPartialGroups>();
         add<Dependencies>();
         add<StringConstantIdAndAccumulatorExpressions>();
         add<ArrayConstantAccumulatorExpression>();
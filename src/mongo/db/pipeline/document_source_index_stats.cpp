@@ -51,6 +51,15 @@ DocumentSource::GetNextResult DocumentSourceIndexStats::doGetNext() {
     if (_indexStatsMap.empty()) {
         _indexStatsMap = pExpCtx->mongoProcessInterface->getIndexStats(pExpCtx->opCtx, pExpCtx->ns);
         _indexStatsIter = _indexStatsMap.begin();
+
+        // The cache residency of each index is reported on a best-effort basis, as the collection
+        // may have been dropped since its index usage statistics were read.
+        BSONObjBuilder cacheStats;
+        if (pExpCtx->mongoProcessInterface
+                ->appendCacheStats(pExpCtx->opCtx, pExpCtx->ns, &cacheStats)
+                .isOK()) {
+            _indexCacheStats = cacheStats.obj().getObjectField("indexes").getOwned();
+        }
     }
 
     if (_indexStatsIter != _indexStatsMap.end()) {
@@ -61,6 +70,11 @@ DocumentSource::GetNextResult DocumentSourceIndexStats::doGetNext() {
         doc["host"] = Value(_processName);
         doc["accesses"]["ops"] = Value(stats.accesses.loadRelaxed());
         doc["accesses"]["since"] = Value(stats.trackerStartTime);
+        doc["maintenance"]["skippedUpdates"] = Value(stats.skippedUpdates.loadRelaxed());
+        BSONObj cacheStats = _indexCacheStats.getObjectField(_indexStatsIter->first);
+        if (!cacheStats.isEmpty()) {
+            doc["cache"] = Value(cacheStats);
+        }
         ++_indexStatsIter;
         return doc.freeze();
     }
@@ -97,6 +97,9 @@ private:
 
     CollectionIndexUsageMap _indexStatsMap;
     CollectionIndexUsageMap::const_iterator _indexStatsIter;
+    // Maps the name of each index to a summary of how much of it is resident in the storage
+    // engine's cache, if the storage engine tracks it.
+    BSONObj _indexCacheStats;
     std::string _processName;
 };
 
@@ -0,0 +1,302 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/pipeline/document_source_match.h"
+
+namespace mongo {
+
+REGISTER_DOCUMENT_SOURCE(_internalUnpackBucket,
+                         LiteParsedDocumentSourceDefault::parse,
+                         DocumentSourceInternalUnpackBucket::createFromBson);
+
+constexpr StringData DocumentSourceInternalUnpackBucket::kStageName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kTimeFieldName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kMetaFieldName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kBucketControlFieldName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kBucketControlMinFieldName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kBucketControlMaxFieldName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kBucketMetaFieldName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kBucketDataFieldName;
+
+namespace {
+
+std::string parseFieldName(const BSONElement& elem) {
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << DocumentSourceInternalUnpackBucket::kStageName << " '"
+                          << elem.fieldNameStringData() << "' must be a string but found: "
+                          << elem,
+            elem.type() == BSONType::String);
+
+    auto fieldName = elem.valueStringData();
+    uassert(ErrorCodes::BadValue,
+            str::stream() << DocumentSourceInternalUnpackBucket::kStageName << " '"
+                          << elem.fieldNameStringData()
+                          << "' must be a non-empty top-level field name but found: " << elem,
+            !fieldName.empty() && fieldName[0] != '$' &&
+                fieldName.find('.') == std::string::npos);
+    return fieldName.toString();
+}
+
+std::string controlFieldPath(StringData bound, StringData fieldName) {
+    return str::stream() << DocumentSourceInternalUnpackBucket::kBucketControlFieldName << "."
+                         << bound << "." << fieldName;
+}
+
+/**
+ * Appends to 'predicates' the bucket-level predicates implied by the comparison 'comparison', if
+ * it is a comparison of 'timeField' with a date. A bucket whose control field is missing or is not
+ * a date cannot be ruled out by its summary, so each predicate also lets such buckets through.
+ */
+void addBucketLevelPredicates(const ComparisonMatchExpression* comparison,
+                              StringData timeField,
+                              std::vector<BSONObj>* predicates) {
+    const auto& value = comparison->getData();
+    if (comparison->path() != timeField || value.type() != BSONType::Date) {
+        return;
+    }
+
+    const auto minPath =
+        controlFieldPath(DocumentSourceInternalUnpackBucket::kBucketControlMinFieldName, timeField);
+    const auto maxPath =
+        controlFieldPath(DocumentSourceInternalUnpackBucket::kBucketControlMaxFieldName, timeField);
+    auto makePredicate = [&](const std::string& path, StringData op) {
+        return BSON("$or" << BSON_ARRAY(BSON(path << BSON(op << value))
+                                        << BSON(path << BSON("$not" << BSON("$type"
+                                                                            << "date")))));
+    };
+
+    switch (comparison->matchType()) {
+        case MatchExpression::EQ:
+            predicates->push_back(makePredicate(minPath, "$lte"));
+            predicates->push_back(makePredicate(maxPath, "$gte"));
+            break;
+        case MatchExpression::GT:
+            predicates->push_back(makePredicate(maxPath, "$gt"));
+            break;
+        case MatchExpression::GTE:
+            predicates->push_back(makePredicate(maxPath, "$gte"));
+            break;
+        case MatchExpression::LT:
+            predicates->push_back(makePredicate(minPath, "$lt"));
+            break;
+        case MatchExpression::LTE:
+            predicates->push_back(makePredicate(minPath, "$lte"));
+            break;
+        default:
+            break;
+    }
+}
+
+}  // namespace
+
+boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createFromBson(
+    BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << kStageName << " must take a nested object but found: " << elem,
+            elem.type() == BSONType::Object);
+
+    boost::optional<std::string> timeField;
+    boost::optional<std::string> metaField;
+    for (auto&& specElem : elem.embeddedObject()) {
+        auto fieldName = specElem.fieldNameStringData();
+        if (fieldName == kTimeFieldName) {
+            timeField = parseFieldName(specElem);
+        } else if (fieldName == kMetaFieldName) {
+            metaField = parseFieldName(specElem);
+        } else {
+            uasserted(ErrorCodes::FailedToParse,
+                      str::stream() << "unrecognized option to " << kStageName << ": "
+                                    << fieldName);
+        }
+    }
+
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << kStageName << " requires a '" << kTimeFieldName << "'",
+            timeField);
+    uassert(ErrorCodes::BadValue,
+            str::stream() << kStageName << " '" << kTimeFieldName << "' and '" << kMetaFieldName
+                          << "' must differ",
+            !metaField || *metaField != *timeField);
+
+    return new DocumentSourceInternalUnpackBucket(
+        expCtx, std::move(*timeField), std::move(metaField));
+}
+
+DocumentSourceInternalUnpackBucket::DocumentSourceInternalUnpackBucket(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    std::string timeField,
+    boost::optional<std::string> metaField)
+    : DocumentSource(kStageName, expCtx),
+      _timeField(std::move(timeField)),
+      _metaField(std::move(metaField)) {}
+
+BSONObj DocumentSourceInternalUnpackBucket::createPredicatesOnBucketLevelField(
+    const MatchExpression* matchExpr, StringData timeField) {
+    std::vector<BSONObj> predicates;
+    if (matchExpr->matchType() == MatchExpression::AND) {
+        // Each conjunct which constrains the time field independently rules out buckets.
+        for (size_t i = 0; i < matchExpr->numChildren(); ++i) {
+            const auto child = matchExpr->getChild(i);
+            if (ComparisonMatchExpression::isComparisonMatchExpression(child)) {
+                addBucketLevelPredicates(
+                    static_cast<const ComparisonMatchExpression*>(child), timeField, &predicates);
+            }
+        }
+    } else if (ComparisonMatchExpression::isComparisonMatchExpression(matchExpr)) {
+        addBucketLevelPredicates(
+            static_cast<const ComparisonMatchExpression*>(matchExpr), timeField, &predicates);
+    }
+
+    if (predicates.empty()) {
+        return BSONObj();
+    }
+    if (predicates.size() == 1) {
+        return predicates.front();
+    }
+    BSONObjBuilder bob;
+    BSONArrayBuilder andBuilder(bob.subarrayStart("$and"));
+    for (auto&& predicate : predicates) {
+        andBuilder.append(predicate);
+    }
+    andBuilder.doneFast();
+    return bob.obj();
+}
+
+Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    if (std::next(itr) == container->end() || _triedBucketLevelPredicatePushdown) {
+        return std::next(itr);
+    }
+
+    auto nextMatch = dynamic_cast<DocumentSourceMatch*>(std::next(itr)->get());
+    if (!nextMatch) {
+        return std::next(itr);
+    }
+
+    _triedBucketLevelPredicatePushdown = true;
+    auto bucketPredicate =
+        createPredicatesOnBucketLevelField(nextMatch->getMatchExpression(), _timeField);
+    if (bucketPredicate.isEmpty()) {
+        return std::next(itr);
+    }
+
+    // The new $match may be able to combine with whatever precedes it, or be pushed down into the
+    // query layer, so resume optimizing from the stage before it.
+    auto newMatch = container->insert(itr, DocumentSourceMatch::create(bucketPredicate, pExpCtx));
+    return newMatch == container->begin() ? newMatch : std::prev(newMatch);
+}
+
+void DocumentSourceInternalUnpackBucket::resetBucket(const Document& bucket) {
+    _bucket = bucket.toBson();
+    _columns.clear();
+
+    auto data = _bucket[kBucketDataFieldName];
+    uassert(ErrorCodes::BadValue,
+            str::stream() << kStageName << " requires the bucket '" << kBucketDataFieldName
+                          << "' field to be an object but found: " << data,
+            data.type() == BSONType::Object);
+
+    bool foundTimeColumn = false;
+    for (auto&& columnElem : data.embeddedObject()) {
+        uassert(ErrorCodes::BadValue,
+                str::stream() << kStageName << " requires each bucket column to be an object but "
+                              << "found: " << columnElem,
+                columnElem.type() == BSONType::Object);
+
+        Column column{columnElem.fieldName(), BSONObjIterator(columnElem.embeddedObject())};
+        if (column.it.more()) {
+            column.current = column.it.next();
+        }
+        if (column.fieldName == _timeField) {
+            _timeColumnIndex = _columns.size();
+            foundTimeColumn = true;
+        }
+        _columns.push_back(std::move(column));
+    }
+
+    uassert(ErrorCodes::BadValue,
+            str::stream() << kStageName << " requires each bucket to have a '" << _timeField
+                          << "' column",
+            foundTimeColumn);
+
+    auto metaElem = _bucket[kBucketMetaFieldName];
+    _metaValue = _metaField && metaElem ? Value(metaElem) : Value();
+}
+
+Document DocumentSourceInternalUnpackBucket::extractNextMeasurement() {
+    // The field names of a column are the positions of the measurements holding a value for it,
+    // and every measurement has a time, so the time column names the measurement to build.
+    const auto position = _columns[_timeColumnIndex].current.fieldNameStringData().toString();
+
+    MutableDocument measurement;
+    for (auto&& column : _columns) {
+        if (!column.current.eoo() && column.current.fieldNameStringData() == position) {
+            measurement.addField(column.fieldName, Value(column.current));
+            column.current = column.it.more() ? column.it.next() : BSONElement();
+        }
+    }
+
+    if (!_metaValue.missing()) {
+        measurement.addField(*_metaField, _metaValue);
+    }
+    return measurement.freeze();
+}
+
+DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
+    while (_columns.empty() || _columns[_timeColumnIndex].current.eoo()) {
+        auto nextResult = pSource->getNext();
+        if (!nextResult.isAdvanced()) {
+            return nextResult;
+        }
+        resetBucket(nextResult.getDocument());
+    }
+
+    return extractNextMeasurement();
+}
+
+Value DocumentSourceInternalUnpackBucket::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    MutableDocument spec;
+    spec.addField(kTimeFieldName, Value(_timeField));
+    if (_metaField) {
+        spec.addField(kMetaFieldName, Value(*_metaField));
+    }
+    return Value(Document{{getSourceName(), spec.freeze()}});
+}
+
+}  // namespace mongo
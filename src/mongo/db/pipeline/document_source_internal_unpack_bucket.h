@@ -0,0 +1,156 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/pipeline/document_source.h"
+
+namespace mongo {
+
+class MatchExpression;
+
+/**
+ * Unpacks time-series bucket documents into the individual measurements they contain. A bucket
+ * has the shape
+ *
+ *   {_id: ...,
+ *    control: {min: {<field>: <value>, ...}, max: {<field>: <value>, ...}},
+ *    meta: <value>,
+ *    data: {<field>: {"0": <value>, "1": <value>, ...}, ...}}
+ *
+ * where each field of 'data' is a column keyed by the position of the measurement in the bucket.
+ * A measurement which lacks a field simply has no entry for its position in that column. Every
+ * measurement must have a value for the time field, which therefore determines how many
+ * measurements the bucket holds. The 'meta' value, if any, is copied into each measurement under
+ * the configured meta field name.
+ *
+ * The 'control' min and max values are used to filter whole buckets on predicates over the time
+ * field before they are unpacked. This requires the time field to hold dates.
+ */
+class DocumentSourceInternalUnpackBucket final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalUnpackBucket"_sd;
+    static constexpr StringData kTimeFieldName = "timeField"_sd;
+    static constexpr StringData kMetaFieldName = "metaField"_sd;
+
+    static constexpr StringData kBucketControlFieldName = "control"_sd;
+    static constexpr StringData kBucketControlMinFieldName = "min"_sd;
+    static constexpr StringData kBucketControlMaxFieldName = "max"_sd;
+    static constexpr StringData kBucketMetaFieldName = "meta"_sd;
+    static constexpr StringData kBucketDataFieldName = "data"_sd;
+
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    DocumentSourceInternalUnpackBucket(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                       std::string timeField,
+                                       boost::optional<std::string> metaField);
+
+    /**
+     * Returns a predicate over the 'control' fields of a bucket which every bucket holding a
+     * measurement that matches 'matchExpr' satisfies, or an empty object if no such predicate can
+     * be derived. Only comparisons of the time field with dates contribute to the predicate, and
+     * buckets whose control field for the time field is missing or not a date always satisfy it.
+     */
+    static BSONObj createPredicatesOnBucketLevelField(const MatchExpression* matchExpr,
+                                                      StringData timeField);
+
+    const char* getSourceName() const final {
+        return kStageName.rawData();
+    }
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        return {StreamType::kStreaming,
+                PositionRequirement::kNone,
+                HostTypeRequirement::kNone,
+                DiskUseRequirement::kNoDiskUse,
+                FacetRequirement::kAllowed,
+                TransactionRequirement::kAllowed,
+                LookupRequirement::kAllowed};
+    }
+
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        return boost::none;
+    }
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+protected:
+    /**
+     * Converts predicates on the time field in a following $match into a $match on the bucket
+     * 'control' fields, placed in front of this stage. The original $match is kept, since the
+     * bucket-level predicate only filters out buckets which cannot contain a match.
+     */
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
+private:
+    /**
+     * A column of the bucket being unpacked, along with its next unconsumed entry.
+     */
+    struct Column {
+        std::string fieldName;
+        BSONObjIterator it;
+        BSONElement current;
+    };
+
+    GetNextResult doGetNext() final;
+
+    /**
+     * Sets up '_columns' to unpack the measurements of 'bucket'.
+     */
+    void resetBucket(const Document& bucket);
+
+    /**
+     * Builds the next measurement of the current bucket, whose position in the bucket is given by
+     * the field name of the next entry in the time column.
+     */
+    Document extractNextMeasurement();
+
+    const std::string _timeField;
+    const boost::optional<std::string> _metaField;
+
+    // The bucket currently being unpacked, which owns the memory the column iterators refer to.
+    BSONObj _bucket;
+    std::vector<Column> _columns;
+    size_t _timeColumnIndex = 0;
+    Value _metaValue;
+
+    // Set once the bucket-level predicate pushdown has been attempted, so that the $match it
+    // generates is not added repeatedly.
+    bool _triedBucketLevelPredicatePushdown = false;
+};
+
+}  // namespace mongo
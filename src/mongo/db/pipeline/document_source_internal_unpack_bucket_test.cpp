@@ -0,0 +1,192 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using InternalUnpackBucketTest = AggregationContextFixture;
+
+boost::intrusive_ptr<DocumentSource> createUnpackStage(
+    const char* spec, const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    auto specObj = fromjson(spec);
+    return DocumentSourceInternalUnpackBucket::createFromBson(specObj.firstElement(), expCtx);
+}
+
+BSONObj controlPredicate(StringData path, StringData op, Date_t date) {
+    return BSON("$or" << BSON_ARRAY(BSON(path << BSON(op << date))
+                                    << BSON(path << BSON("$not" << BSON("$type"
+                                                                        << "date")))));
+}
+
+TEST_F(InternalUnpackBucketTest, UnpacksMeasurementsWithMetadata) {
+    auto unpack = createUnpackStage(
+        "{$_internalUnpackBucket: {timeField: 'time', metaField: 'tags'}}", getExpCtx());
+    auto mock = DocumentSourceMock::createForTest(
+        {"{meta: {host: 'a'}, data: {_id: {'0': 1, '1': 2}, time: {'0': 10, '1': 20}, "
+         "x: {'0': 'x0', '1': 'x1'}}}",
+         "{meta: {host: 'b'}, data: {_id: {'0': 3}, time: {'0': 30}, x: {'0': 'x3'}}}"});
+    unpack->setSource(mock.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{_id: 1, time: 10, x: 'x0', tags: {host: 'a'}}")));
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{_id: 2, time: 20, x: 'x1', tags: {host: 'a'}}")));
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{_id: 3, time: 30, x: 'x3', tags: {host: 'b'}}")));
+    ASSERT_TRUE(unpack->getNext().isEOF());
+}
+
+TEST_F(InternalUnpackBucketTest, OmitsFieldsMissingFromAMeasurement) {
+    auto unpack = createUnpackStage("{$_internalUnpackBucket: {timeField: 'time'}}", getExpCtx());
+    auto mock = DocumentSourceMock::createForTest(
+        {"{data: {}}",
+         "{meta: 'ignored', data: {time: {'0': 10, '1': 20, '2': 30}, x: {'1': 'x1'}, "
+         "y: {'0': 'y0', '2': 'y2'}}}"});
+    unpack->setSource(mock.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document(fromjson("{time: 10, y: 'y0'}")));
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document(fromjson("{time: 20, x: 'x1'}")));
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document(fromjson("{time: 30, y: 'y2'}")));
+    ASSERT_TRUE(unpack->getNext().isEOF());
+}
+
+TEST_F(InternalUnpackBucketTest, RejectsInvalidSpecsAndBuckets) {
+    ASSERT_THROWS_CODE(createUnpackStage("{$_internalUnpackBucket: {}}", getExpCtx()),
+                       AssertionException,
+                       ErrorCodes::FailedToParse);
+    ASSERT_THROWS_CODE(createUnpackStage("{$_internalUnpackBucket: {timeField: 1}}", getExpCtx()),
+                       AssertionException,
+                       ErrorCodes::TypeMismatch);
+    ASSERT_THROWS_CODE(
+        createUnpackStage("{$_internalUnpackBucket: {timeField: 'a.b'}}", getExpCtx()),
+        AssertionException,
+        ErrorCodes::BadValue);
+    ASSERT_THROWS_CODE(
+        createUnpackStage("{$_internalUnpackBucket: {timeField: 't', metaField: 't'}}",
+                          getExpCtx()),
+        AssertionException,
+        ErrorCodes::BadValue);
+
+    auto unpack = createUnpackStage("{$_internalUnpackBucket: {timeField: 'time'}}", getExpCtx());
+    auto mock = DocumentSourceMock::createForTest("{data: {x: {'0': 1}}}");
+    unpack->setSource(mock.get());
+    ASSERT_THROWS_CODE(unpack->getNext(), AssertionException, ErrorCodes::BadValue);
+}
+
+TEST_F(InternalUnpackBucketTest, PushesTimePredicatesOntoBucketControlFields) {
+    const auto date = Date_t::fromMillisSinceEpoch(1000);
+    auto pipeline = uassertStatusOK(Pipeline::parse(
+        {fromjson("{$_internalUnpackBucket: {timeField: 'time'}}"),
+         BSON("$match" << BSON("time" << BSON("$gte" << date) << "x" << 1))},
+        getExpCtx()));
+    pipeline->optimizePipeline();
+
+    auto serialized = pipeline->serialize();
+    ASSERT_EQ(3u, serialized.size());
+    ASSERT_VALUE_EQ(serialized[0],
+                    Value(BSON("$match" << controlPredicate("control.max.time", "$gte", date))));
+
+    // Optimizing again does not add another bucket-level $match.
+    pipeline->optimizePipeline();
+    ASSERT_EQ(3u, pipeline->serialize().size());
+}
+
+TEST_F(InternalUnpackBucketTest, BucketLevelPredicatesOnlyUseDateComparisonsOnTheTimeField) {
+    const auto date = Date_t::fromMillisSinceEpoch(1000);
+    auto expCtx = getExpCtx();
+    auto predicatesFor = [&](const BSONObj& query) {
+        auto expr = uassertStatusOK(MatchExpressionParser::parse(query, expCtx));
+        return DocumentSourceInternalUnpackBucket::createPredicatesOnBucketLevelField(expr.get(),
+                                                                                      "time");
+    };
+
+    ASSERT_BSONOBJ_EQ(predicatesFor(BSON("time" << date)),
+                      BSON("$and" << BSON_ARRAY(controlPredicate("control.min.time", "$lte", date)
+                                                << controlPredicate(
+                                                       "control.max.time", "$gte", date))));
+    ASSERT_BSONOBJ_EQ(predicatesFor(BSON("time" << BSON("$lt" << date))),
+                      controlPredicate("control.min.time", "$lt", date));
+    ASSERT_BSONOBJ_EQ(predicatesFor(BSON("time" << BSON("$gt" << date << "$lte" << date))),
+                      BSON("$and" << BSON_ARRAY(controlPredicate("control.max.time", "$gt", date)
+                                                << controlPredicate(
+                                                       "control.min.time", "$lte", date))));
+    ASSERT_BSONOBJ_EQ(predicatesFor(BSON("time" << BSON("$gt" << 5))), BSONObj());
+    ASSERT_BSONOBJ_EQ(predicatesFor(BSON("x" << BSON("$gt" << date))), BSONObj());
+    ASSERT_BSONOBJ_EQ(
+        predicatesFor(BSON("$or" << BSON_ARRAY(BSON("time" << date) << BSON("x" << 1)))),
+        BSONObj());
+}
+
+TEST_F(InternalUnpackBucketTest, BucketLevelPredicatesKeepBucketsWithoutDateControlFields) {
+    const auto date = Date_t::fromMillisSinceEpoch(1000);
+    auto expCtx = getExpCtx();
+    auto query = uassertStatusOK(
+        MatchExpressionParser::parse(BSON("time" << BSON("$gte" << date)), expCtx));
+    auto bucketPredicate = uassertStatusOK(MatchExpressionParser::parse(
+        DocumentSourceInternalUnpackBucket::createPredicatesOnBucketLevelField(query.get(), "time"),
+        expCtx));
+
+    ASSERT_TRUE(bucketPredicate->matchesBSON(fromjson("{data: {}}")));
+    ASSERT_TRUE(bucketPredicate->matchesBSON(fromjson("{control: {max: {}}, data: {}}")));
+    ASSERT_TRUE(bucketPredicate->matchesBSON(fromjson("{control: {max: {time: 5}}, data: {}}")));
+    ASSERT_TRUE(bucketPredicate->matchesBSON(
+        BSON("control" << BSON("max" << BSON("time" << date)) << "data" << BSONObj())));
+    ASSERT_FALSE(bucketPredicate->matchesBSON(
+        BSON("control" << BSON("max" << BSON("time" << Date_t::fromMillisSinceEpoch(999)))
+                       << "data" << BSONObj())));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -38,6 +38,7 @@
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
@@ -232,6 +233,11 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         return unwindResult();
     }
 
+    // Joining in batches may have been abandoned with joined documents still to be returned.
+    if (_hashJoinState == HashJoinState::kBatched || !_batchOutput.empty() || _batchInputResult) {
+        return getNextFromBatch();
+    }
+
     auto nextInput = pSource->getNext();
     if (!nextInput.isAdvanced()) {
         return nextInput;
@@ -243,6 +249,31 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
     // '_unwindSrc' would be non-null, and we would not have made it here.
     invariant(!_matchSrc);
 
+    if (_hashJoinState == HashJoinState::kUndecided) {
+        initializeHashJoin();
+    }
+
+    if (_hashJoinState == HashJoinState::kBatched) {
+        _batchInput.push_back(std::move(inputDoc));
+        return getNextFromBatch();
+    }
+
+    if (_hashJoinState == HashJoinState::kBuilt) {
+        if (auto results = probeHashJoinTable(inputDoc)) {
+            MutableDocument output(std::move(inputDoc));
+            output.setNestedField(_as, Value(std::move(*results)));
+            return output.freeze();
+        }
+    }
+
+    auto results = queryForeignCollection(inputDoc);
+
+    MutableDocument output(std::move(inputDoc));
+    output.setNestedField(_as, Value(std::move(results)));
+    return output.freeze();
+}
+
+std::vector<Value> DocumentSourceLookUp::queryForeignCollection(const Document& inputDoc) {
     if (!wasConstructedWithPipelineSyntax()) {
         auto matchStage =
             makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
@@ -266,10 +297,7 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         results.emplace_back(std::move(*result));
     }
     _usedDisk = _usedDisk || pipeline->usedDisk();
-
-    MutableDocument output(std::move(inputDoc));
-    output.setNestedField(_as, Value(std::move(results)));
-    return output.freeze();
+    return results;
 }
 
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
@@ -318,6 +346,240 @@ std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
     return pipeline;
 }
 
+namespace {
+
+/**
+ * Returns true if the documents matching {<path>: {$eq: 'value'}} are exactly the documents having
+ * a value equal to 'value' among those visited along <path> by visitAllValuesAtPath(). This doesn't
+ * hold for null, which also matches missing values, for arrays, which also match an array value as
+ * a whole, and is not relied upon for regular expressions.
+ */
+bool canHashJoinOnValue(const Value& value) {
+    switch (value.getType()) {
+        case BSONType::jstNULL:
+        case BSONType::Undefined:
+        case BSONType::EOO:
+        case BSONType::Array:
+        case BSONType::RegEx:
+            return false;
+        default:
+            return true;
+    }
+}
+
+}  // namespace
+
+void DocumentSourceLookUp::initializeHashJoin() {
+    invariant(_hashJoinState == HashJoinState::kUndecided);
+    _hashJoinState = HashJoinState::kNotUsed;
+
+    const auto maxBytes = internalLookupStageHashJoinMaxMemoryBytes.load();
+    if (wasConstructedWithPipelineSyntax() || maxBytes == 0 || pExpCtx->inMongos) {
+        return;
+    }
+
+    // Positional path components have different semantics in a query than along the paths visited
+    // when building the hash table.
+    for (size_t i = 0; i < _foreignField->getPathLength(); ++i) {
+        if (str::parseUnsignedBase10Integer(_foreignField->getFieldName(i))) {
+            return;
+        }
+    }
+
+    if (foreignFieldHasSupportingIndex()) {
+        if (internalLookupStageIndexedJoinBatchSize.load() > 1) {
+            _hashJoinState = HashJoinState::kBatched;
+        }
+        return;
+    }
+
+    // Read the foreign collection, through any view definition, without a join predicate.
+    _resolvedPipeline.back() = BSON("$match" << BSONObj());
+    copyVariablesToExpCtx(_variables, _variablesParseState, _fromExpCtx.get());
+    auto pipeline = pExpCtx->mongoProcessInterface->makePipeline(_resolvedPipeline, _fromExpCtx);
+
+    _hashJoinTable = _fromExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>();
+    long long memoryUsageBytes = 0;
+    while (auto foreignDoc = pipeline->getNext()) {
+        memoryUsageBytes += foreignDoc->getApproximateSize();
+        if (memoryUsageBytes > maxBytes) {
+            // The foreign collection is too large, query it for each input document instead.
+            _hashJoinTable.reset();
+            _hashJoinForeignDocs.clear();
+            return;
+        }
+
+        addToHashJoinTable(std::move(*foreignDoc));
+    }
+    _usedDisk = _usedDisk || pipeline->usedDisk();
+
+    _hashJoinState = HashJoinState::kBuilt;
+}
+
+void DocumentSourceLookUp::addToHashJoinTable(Document foreignDoc) {
+    const size_t position = _hashJoinForeignDocs.size();
+    document_path_support::visitAllValuesAtPath(
+        foreignDoc, *_foreignField, [&](const Value& value) {
+            auto& positions = (*_hashJoinTable)[value];
+            // A document may hold the same value several times along the path.
+            if (positions.empty() || positions.back() != position) {
+                positions.push_back(position);
+            }
+        });
+    _hashJoinForeignDocs.push_back(std::move(foreignDoc));
+}
+
+DocumentSource::GetNextResult DocumentSourceLookUp::getNextFromBatch() {
+    if (_batchOutput.empty() && !_batchInputResult) {
+        const size_t batchSize = internalLookupStageIndexedJoinBatchSize.load();
+        while (_batchInput.empty() || _batchInput.size() < batchSize) {
+            auto nextInput = pSource->getNext();
+            if (!nextInput.isAdvanced()) {
+                _batchInputResult = std::move(nextInput);
+                break;
+            }
+            _batchInput.push_back(nextInput.releaseDocument());
+        }
+        joinBatch();
+    }
+
+    if (!_batchOutput.empty()) {
+        auto output = std::move(_batchOutput.front());
+        _batchOutput.pop_front();
+        return output;
+    }
+
+    // The batch was ended by a pause or EOF, which is returned once its documents have been.
+    invariant(_batchInputResult);
+    auto result = std::move(*_batchInputResult);
+    _batchInputResult.reset();
+    return result;
+}
+
+void DocumentSourceLookUp::joinBatch() {
+    // Gather the distinct join values of the batch which can be looked up by hash. The remaining
+    // input documents are joined with a query of their own.
+    auto joinValues = _fromExpCtx->getValueComparator().makeUnorderedValueSet();
+    BSONArrayBuilder inBuilder;
+    for (auto&& inputDoc : _batchInput) {
+        document_path_support::visitAllValuesAtPath(
+            inputDoc, *_localField, [&](const Value& value) {
+                if (canHashJoinOnValue(value) && joinValues.insert(value).second) {
+                    value.addToBsonArray(&inBuilder);
+                }
+            });
+    }
+
+    _hashJoinTable = _fromExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>();
+    _hashJoinForeignDocs.clear();
+    if (!joinValues.empty()) {
+        _resolvedPipeline.back() =
+            BSON("$match" << BSON(_foreignField->fullPath() << BSON("$in" << inBuilder.arr())));
+        copyVariablesToExpCtx(_variables, _variablesParseState, _fromExpCtx.get());
+        auto pipeline =
+            pExpCtx->mongoProcessInterface->makePipeline(_resolvedPipeline, _fromExpCtx);
+
+        long long memoryUsageBytes = 0;
+        const auto maxBytes = internalLookupStageHashJoinMaxMemoryBytes.load();
+        while (auto foreignDoc = pipeline->getNext()) {
+            memoryUsageBytes += foreignDoc->getApproximateSize();
+            if (memoryUsageBytes > maxBytes) {
+                // The batch joins with too many foreign documents to hold them at once. Query the
+                // foreign collection for every input document from now on.
+                _hashJoinTable.reset();
+                _hashJoinForeignDocs.clear();
+                _hashJoinState = HashJoinState::kNotUsed;
+                break;
+            }
+            addToHashJoinTable(std::move(*foreignDoc));
+        }
+        _usedDisk = _usedDisk || pipeline->usedDisk();
+    }
+
+    for (auto&& inputDoc : _batchInput) {
+        auto results = _hashJoinTable ? probeHashJoinTable(inputDoc) : boost::none;
+        if (!results) {
+            results = queryForeignCollection(inputDoc);
+        }
+
+        MutableDocument output(std::move(inputDoc));
+        output.setNestedField(_as, Value(std::move(*results)));
+        _batchOutput.push_back(output.freeze());
+    }
+    _batchInput.clear();
+
+    _hashJoinTable.reset();
+    _hashJoinForeignDocs.clear();
+}
+
+bool DocumentSourceLookUp::foreignFieldHasSupportingIndex() const {
+    const auto indexStats =
+        pExpCtx->mongoProcessInterface->getIndexStats(pExpCtx->opCtx, _resolvedNs);
+    const auto foreignFieldPath = _foreignField->fullPath();
+    for (auto&& index : indexStats) {
+        auto firstField = index.second.indexKey.firstElement();
+        if (firstField && firstField.fieldNameStringData() == foreignFieldPath) {
+            return true;
+        }
+    }
+    return false;
+}
+
+boost::optional<std::vector<Value>> DocumentSourceLookUp::probeHashJoinTable(
+    const Document& input) {
+    bool canProbe = true;
+    bool hasValues = false;
+    std::vector<size_t> candidates;
+    document_path_support::visitAllValuesAtPath(input, *_localField, [&](const Value& value) {
+        hasValues = true;
+        if (!canProbe || !canHashJoinOnValue(value)) {
+            canProbe = false;
+            return;
+        }
+
+        auto it = _hashJoinTable->find(value);
+        if (it != _hashJoinTable->end()) {
+            candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+        }
+    });
+
+    if (!canProbe || !hasValues) {
+        // Missing values are treated as null.
+        return boost::none;
+    }
+
+    // Return the joined documents in the order they were read from the foreign collection.
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    // The hash table can only narrow down the candidates; whether a document actually joins is
+    // still decided by the same query that would have been run against the foreign collection.
+    const auto matchStage =
+        makeMatchStageFromInput(input, *_localField, _foreignField->fullPath(), BSONObj());
+    auto matcher = uassertStatusOK(
+        MatchExpressionParser::parse(matchStage.firstElement().embeddedObject(), _fromExpCtx));
+
+    std::vector<Value> results;
+    int objsize = 0;
+    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+    for (auto position : candidates) {
+        const auto& foreignDoc = _hashJoinForeignDocs[position];
+        if (!matcher->matchesBSON(foreignDoc.toBson())) {
+            continue;
+        }
+
+        objsize += foreignDoc.getApproximateSize();
+        uassert(4568,
+                str::stream() << "Total size of documents in " << _fromNs.coll()
+                              << " matching pipeline's $lookup stage exceeds " << maxBytes
+                              << " bytes",
+
+                objsize <= maxBytes);
+        results.emplace_back(foreignDoc);
+    }
+    return results;
+}
+
 DocumentSource::GetModPathsReturn DocumentSourceLookUp::getModifiedPaths() const {
     std::set<std::string> modifiedPaths{_as.fullPath()};
     if (_unwindSrc) {
@@ -454,6 +716,15 @@ bool DocumentSourceLookUp::usedDisk() {
 }
 
 void DocumentSourceLookUp::doDispose() {
+    if (_hashJoinState == HashJoinState::kBuilt || _hashJoinState == HashJoinState::kBatched) {
+        _hashJoinState = HashJoinState::kNotUsed;
+        _hashJoinTable.reset();
+        _hashJoinForeignDocs.clear();
+        _batchInput.clear();
+        _batchOutput.clear();
+        _batchInputResult.reset();
+    }
+
     if (_pipeline) {
         _usedDisk = _usedDisk || _pipeline->usedDisk();
         _pipeline->dispose(pExpCtx->opCtx);
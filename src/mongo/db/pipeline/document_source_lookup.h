@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/pipeline/document_source.h"
@@ -207,6 +208,22 @@ public:
         return *_resolvedIntrospectionPipeline;
     }
 
+    /**
+     * Returns true if this $lookup joined its input by probing a hash table built over the foreign
+     * collection.
+     */
+    bool usedHashJoin_forTest() const {
+        return _hashJoinState == HashJoinState::kBuilt;
+    }
+
+    /**
+     * Returns true if this $lookup joined batches of its input through a single query against an
+     * index on the foreign field.
+     */
+    bool usedBatchedIndexJoin_forTest() const {
+        return _hashJoinState == HashJoinState::kBatched;
+    }
+
     const Variables& getVariables_forTest() {
         return _variables;
     }
@@ -292,6 +309,51 @@ private:
      */
     std::unique_ptr<Pipeline, PipelineDeleter> buildPipeline(const Document& inputDoc);
 
+    /**
+     * Decides whether to join with the foreign collection through a hash table, and builds the
+     * table if so. A hash join is used for localField/foreignField syntax when no index on the
+     * foreign collection can answer the per-document queries, as long as the foreign collection
+     * fits within internalLookupStageHashJoinMaxMemoryBytes. When such an index exists, the input
+     * is instead joined in batches of internalLookupStageIndexedJoinBatchSize documents.
+     */
+    void initializeHashJoin();
+
+    /**
+     * Adds 'foreignDoc' to the hash table under each of the values along '_foreignField'.
+     */
+    void addToHashJoinTable(Document foreignDoc);
+
+    /**
+     * Returns the next joined document when joining in batches, reading and joining a new batch of
+     * input documents once the previous one has been returned.
+     */
+    GetNextResult getNextFromBatch();
+
+    /**
+     * Joins the documents in '_batchInput' and moves them to '_batchOutput'. The distinct join
+     * values of the batch are looked up in the foreign collection with a single $in query, which
+     * the foreign index answers with one scan over all of their intervals, and the results are
+     * distributed to the input documents through the hash table.
+     */
+    void joinBatch();
+
+    /**
+     * Runs the foreign pipeline for 'inputDoc' and returns the documents it joins with.
+     */
+    std::vector<Value> queryForeignCollection(const Document& inputDoc);
+
+    /**
+     * Returns true if an index on '_resolvedNs' has '_foreignField' as its leading field.
+     */
+    bool foreignFieldHasSupportingIndex() const;
+
+    /**
+     * Looks up the foreign documents which join with 'input' in the hash table. Returns boost::none
+     * if the join values of 'input' can't be looked up by hash, e.g. because they are null or
+     * arrays, in which case the foreign collection must be queried instead.
+     */
+    boost::optional<std::vector<Value>> probeHashJoinTable(const Document& input);
+
     /**
      * Reinitialize the cache with a new max size. May only be called if this DSLookup was created
      * with pipeline syntax, the cache has not been frozen or abandoned, and no data has been added
@@ -303,6 +365,8 @@ private:
         _cache.emplace(maxCacheSizeBytes);
     }
 
+    enum class HashJoinState { kUndecided, kBuilt, kBatched, kNotUsed };
+
     bool _usedDisk = false;
     NamespaceString _fromNs;
     NamespaceString _resolvedNs;
@@ -325,6 +389,20 @@ private:
     // from a cursor source.
     boost::optional<SequentialDocumentCache> _cache;
 
+    // For use when $lookup is specified with localField/foreignField syntax and joins through a
+    // hash table. '_hashJoinTable' maps each value at the foreign field path to the positions in
+    // '_hashJoinForeignDocs' of the documents holding that value, in the order they were read.
+    HashJoinState _hashJoinState = HashJoinState::kUndecided;
+    std::vector<Document> _hashJoinForeignDocs;
+    boost::optional<ValueUnorderedMap<std::vector<size_t>>> _hashJoinTable;
+
+    // For use when joining in batches, in which case the hash table holds the foreign documents
+    // matching the current batch. '_batchInputResult' holds the pause or EOF which ended the
+    // current batch, to be returned after its joined documents.
+    std::deque<Document> _batchInput;
+    std::deque<Document> _batchOutput;
+    boost::optional<GetNextResult> _batchInputResult;
+
     // The ExpressionContext used when performing aggregation pipelines against the '_resolvedNs'
     // namespace.
     boost::intrusive_ptr<ExpressionContext> _fromExpCtx;
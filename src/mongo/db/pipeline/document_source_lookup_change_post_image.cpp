@@ -97,6 +97,11 @@ Value DocumentSourceLookupChangePostImage::lookupPostImage(const Document& updat
                                           BSONType::Object)
                            .getDocument();
 
+    // The post-image was recorded in the oplog and already attached to the event.
+    if (!updateOp[kFullDocumentFieldName].missing()) {
+        return updateOp[kFullDocumentFieldName];
+    }
+
     // Extract the UUID from resume token and do change stream lookups by UUID.
     auto resumeToken =
         ResumeToken::parse(updateOp[DocumentSourceChangeStream::kIdField].getDocument());
@@ -268,6 +268,32 @@ TEST_F(DocumentSourceLookupChangePostImageTest, ShouldErrorIfDocumentKeyIsNotUni
         lookupChangeStage->getNext(), AssertionException, ErrorCodes::TooManyMatchingDocuments);
 }
 
+TEST_F(DocumentSourceLookupChangePostImageTest, ShouldNotLookUpPostImageAlreadyInEvent) {
+    auto expCtx = getExpCtx();
+
+    // Set up the lookup change post image stage.
+    auto lookupChangeStage = DocumentSourceLookupChangePostImage::create(expCtx);
+
+    // Mock its input with an update event carrying the post-image recorded in the oplog.
+    Document updateEvent{{"_id", makeResumeToken(0)},
+                         {"documentKey", Document{{"_id", 0}}},
+                         {"operationType", "update"_sd},
+                         {"fullDocument", Document{{"_id", 0}, {"x", 1}}},
+                         {"ns", Document{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}}}};
+    auto mockLocalSource = DocumentSourceMock::createForTest(updateEvent);
+
+    lookupChangeStage->setSource(mockLocalSource.get());
+
+    // Mock out the foreign collection with a different version of the document.
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document{{"_id", 0}, {"x", 2}}};
+    getExpCtx()->mongoProcessInterface =
+        std::make_unique<MockMongoInterface>(std::move(mockForeignContents));
+
+    auto next = lookupChangeStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), updateEvent);
+}
+
 TEST_F(DocumentSourceLookupChangePostImageTest, ShouldPropagatePauses) {
     auto expCtx = getExpCtx();
 
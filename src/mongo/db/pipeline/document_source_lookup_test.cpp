@@ -48,6 +48,7 @@
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/server_options.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -496,6 +497,15 @@ public:
         return false;
     }
 
+    CollectionIndexUsageMap getIndexStats(OperationContext* opCtx,
+                                          const NamespaceString& ns) final {
+        // The foreign collection only has the _id index.
+        CollectionIndexUsageMap indexStats;
+        indexStats["_id_"] =
+            CollectionIndexUsageTracker::IndexUsageStats(Date_t::now(), BSON("_id" << 1));
+        return indexStats;
+    }
+
     std::unique_ptr<Pipeline, PipelineDeleter> makePipeline(
         const std::vector<BSONObj>& rawPipeline,
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
@@ -641,6 +651,245 @@ TEST_F(DocumentSourceLookUpTest, ShouldPropagatePausesWhileUnwinding) {
     lookup->dispose();
 }
 
+TEST_F(DocumentSourceLookUpTest, ShouldHashJoinWhenForeignFieldIsNotIndexed) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    auto lookupSpec = fromjson("{$lookup: {from: 'foreign', localField: 'x', foreignField: 'y', "
+                               "as: 'foreignDocs'}}");
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource = DocumentSourceMock::createForTest(
+        {"{x: 1}", "{x: [1, 2]}", "{x: 'a'}", "{x: null}", "{x: 5}"});
+    lookup->setSource(mockLocalSource.get());
+
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(
+        deque<DocumentSource::GetNextResult>{Document(fromjson("{_id: 0, y: 1}")),
+                                             Document(fromjson("{_id: 1, y: [2, 3]}")),
+                                             Document(fromjson("{_id: 2, y: 'a'}")),
+                                             Document(fromjson("{_id: 3}")),
+                                             Document(fromjson("{_id: 4, y: 1.0}"))});
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_TRUE(lookup->usedHashJoin_forTest());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        Document(fromjson("{x: 1, foreignDocs: [{_id: 0, y: 1}, {_id: 4, y: 1.0}]}")));
+
+    // Array values join with any of their elements, in the order of the foreign collection.
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{x: [1, 2], foreignDocs: [{_id: 0, y: 1}, "
+                                         "{_id: 1, y: [2, 3]}, {_id: 4, y: 1.0}]}")));
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{x: 'a', foreignDocs: [{_id: 2, y: 'a'}]}")));
+
+    // Null values also join with missing values, which is answered by querying instead.
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{x: null, foreignDocs: [{_id: 3}]}")));
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document(fromjson("{x: 5, foreignDocs: []}")));
+
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    lookup->dispose();
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldNotHashJoinOnPositionalForeignPaths) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    // In a query 'y.0' names the first element of the array 'y', which the paths visited to build
+    // the hash table would not.
+    auto lookupSpec = fromjson("{$lookup: {from: 'foreign', localField: 'x', foreignField: 'y.0', "
+                               "as: 'foreignDocs'}}");
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource = DocumentSourceMock::createForTest({"{x: 1}"});
+    lookup->setSource(mockLocalSource.get());
+
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(
+        deque<DocumentSource::GetNextResult>{Document(fromjson("{_id: 0, y: [1, 2]}")),
+                                             Document(fromjson("{_id: 1, y: [2, 1]}"))});
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_FALSE(lookup->usedHashJoin_forTest());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{x: 1, foreignDocs: [{_id: 0, y: [1, 2]}]}")));
+    lookup->dispose();
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldNotHashJoinWhenForeignFieldIsIndexed) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    auto lookupSpec = fromjson("{$lookup: {from: 'foreign', localField: 'x', foreignField: '_id', "
+                               "as: 'foreignDocs'}}");
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource = DocumentSourceMock::createForTest({"{x: 1}"});
+    lookup->setSource(mockLocalSource.get());
+
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(
+        deque<DocumentSource::GetNextResult>{Document(fromjson("{_id: 0}")),
+                                             Document(fromjson("{_id: 1}"))});
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_FALSE(lookup->usedHashJoin_forTest());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{x: 1, foreignDocs: [{_id: 1}]}")));
+    lookup->dispose();
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldJoinInBatchesWhenForeignFieldIsIndexed) {
+    const auto originalBatchSize = internalLookupStageIndexedJoinBatchSize.load();
+    ON_BLOCK_EXIT([&] { internalLookupStageIndexedJoinBatchSize.store(originalBatchSize); });
+    internalLookupStageIndexedJoinBatchSize.store(2);
+
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    auto lookupSpec = fromjson("{$lookup: {from: 'foreign', localField: 'x', foreignField: '_id', "
+                               "as: 'foreignDocs'}}");
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource =
+        DocumentSourceMock::createForTest({Document(fromjson("{x: 0}")),
+                                           Document(fromjson("{x: [1, 2]}")),
+                                           Document(fromjson("{x: null}")),
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document(fromjson("{x: 3}"))});
+    lookup->setSource(mockLocalSource.get());
+
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(
+        deque<DocumentSource::GetNextResult>{Document(fromjson("{_id: 0}")),
+                                             Document(fromjson("{_id: 1}")),
+                                             Document(fromjson("{_id: 2}")),
+                                             Document(fromjson("{_id: null}"))});
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_TRUE(lookup->usedBatchedIndexJoin_forTest());
+    ASSERT_FALSE(lookup->usedHashJoin_forTest());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{x: 0, foreignDocs: [{_id: 0}]}")));
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{x: [1, 2], foreignDocs: [{_id: 1}, {_id: 2}]}")));
+
+    // Null values can't be looked up in the batch and are queried for on their own. The pause
+    // ending this batch is returned once its documents have been.
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{x: null, foreignDocs: [{_id: null}]}")));
+
+    ASSERT_TRUE(lookup->getNext().isPaused());
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document(fromjson("{x: 3, foreignDocs: []}")));
+
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    lookup->dispose();
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldStopJoiningInBatchesWhenBatchExceedsMemoryLimit) {
+    const auto originalMaxBytes = internalLookupStageHashJoinMaxMemoryBytes.load();
+    ON_BLOCK_EXIT([&] { internalLookupStageHashJoinMaxMemoryBytes.store(originalMaxBytes); });
+    internalLookupStageHashJoinMaxMemoryBytes.store(1);
+
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    auto lookupSpec = fromjson("{$lookup: {from: 'foreign', localField: 'x', foreignField: '_id', "
+                               "as: 'foreignDocs'}}");
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource = DocumentSourceMock::createForTest({"{x: 0}", "{x: 1}", "{x: 2}"});
+    lookup->setSource(mockLocalSource.get());
+
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(
+        deque<DocumentSource::GetNextResult>{Document(fromjson("{_id: 0}")),
+                                             Document(fromjson("{_id: 1}"))});
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_FALSE(lookup->usedBatchedIndexJoin_forTest());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{x: 0, foreignDocs: [{_id: 0}]}")));
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{x: 1, foreignDocs: [{_id: 1}]}")));
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document(fromjson("{x: 2, foreignDocs: []}")));
+
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    lookup->dispose();
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldNotHashJoinWhenForeignCollectionExceedsMemoryLimit) {
+    const auto originalMaxBytes = internalLookupStageHashJoinMaxMemoryBytes.load();
+    ON_BLOCK_EXIT([&] { internalLookupStageHashJoinMaxMemoryBytes.store(originalMaxBytes); });
+    internalLookupStageHashJoinMaxMemoryBytes.store(1);
+
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    auto lookupSpec = fromjson("{$lookup: {from: 'foreign', localField: 'x', foreignField: 'y', "
+                               "as: 'foreignDocs'}}");
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource = DocumentSourceMock::createForTest({"{x: 1}"});
+    lookup->setSource(mockLocalSource.get());
+
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(
+        deque<DocumentSource::GetNextResult>{Document(fromjson("{_id: 0, y: 1}")),
+                                             Document(fromjson("{_id: 1, y: 2}"))});
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_FALSE(lookup->usedHashJoin_forTest());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{x: 1, foreignDocs: [{_id: 0, y: 1}]}")));
+    lookup->dispose();
+}
+
 TEST_F(DocumentSourceLookUpTest, LookupReportsAsFieldIsModified) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "foreign");
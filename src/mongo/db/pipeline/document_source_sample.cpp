@@ -81,6 +81,13 @@ DocumentSource::GetNextResult DocumentSourceSample::doGetNext() {
 }
 
 Value DocumentSourceSample::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
+    if (explain) {
+        // This stage is only left in the pipeline when it could not be replaced by a random
+        // cursor, in which case it assigns random values to its whole input and keeps the top
+        // '_size' of them.
+        return Value(DOC(kStageName << DOC("size" << _size << "method"
+                                                  << "randomSort"_sd)));
+    }
     return Value(DOC(kStageName << DOC("size" << _size)));
 }
 
@@ -49,12 +49,14 @@ DocumentSourceSampleFromRandomCursor::DocumentSourceSampleFromRandomCursor(
     const intrusive_ptr<ExpressionContext>& pExpCtx,
     long long size,
     std::string idField,
-    long long nDocsInCollection)
+    long long nDocsInCollection,
+    bool blockSampling)
     : DocumentSource(kStageName, pExpCtx),
       _size(size),
       _idField(std::move(idField)),
       _seenDocs(pExpCtx->getValueComparator().makeUnorderedValueSet()),
-      _nDocsInColl(nDocsInCollection) {}
+      _nDocsInColl(nDocsInCollection),
+      _blockSampling(blockSampling) {}
 
 const char* DocumentSourceSampleFromRandomCursor::getSourceName() const {
     return kStageName.rawData();
@@ -143,6 +145,11 @@ DocumentSource::GetNextResult DocumentSourceSampleFromRandomCursor::getNextNonDu
 
 Value DocumentSourceSampleFromRandomCursor::serialize(
     boost::optional<ExplainOptions::Verbosity> explain) const {
+    if (explain) {
+        return Value(DOC(getSourceName() << DOC(
+                             "size" << _size << "method"
+                                    << (_blockSampling ? "blockSampling"_sd : "randomCursor"_sd))));
+    }
     return Value(DOC(getSourceName() << DOC("size" << _size)));
 }
 
@@ -155,9 +162,11 @@ intrusive_ptr<DocumentSourceSampleFromRandomCursor> DocumentSourceSampleFromRand
     const intrusive_ptr<ExpressionContext>& expCtx,
     long long size,
     std::string idField,
-    long long nDocsInCollection) {
+    long long nDocsInCollection,
+    bool blockSampling) {
     intrusive_ptr<DocumentSourceSampleFromRandomCursor> source(
-        new DocumentSourceSampleFromRandomCursor(expCtx, size, idField, nDocsInCollection));
+        new DocumentSourceSampleFromRandomCursor(
+            expCtx, size, idField, nDocsInCollection, blockSampling));
     return source;
 }
 }  // namespace mongo
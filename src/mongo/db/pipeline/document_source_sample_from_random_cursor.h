@@ -59,17 +59,23 @@ public:
         return boost::none;
     }
 
+    /**
+     * 'blockSampling' records whether the input comes from a storage engine block sampling cursor
+     * rather than a random cursor. It is only used for explain output.
+     */
     static boost::intrusive_ptr<DocumentSourceSampleFromRandomCursor> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         long long size,
         std::string idField,
-        long long collectionSize);
+        long long collectionSize,
+        bool blockSampling = false);
 
 private:
     DocumentSourceSampleFromRandomCursor(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                          long long size,
                                          std::string idField,
-                                         long long collectionSize);
+                                         long long collectionSize,
+                                         bool blockSampling);
 
     GetNextResult doGetNext() final;
 
@@ -96,6 +102,8 @@ private:
     // will decrement this value by an amount scaled by _nDocsInColl as an attempt to appear as if
     // the documents were produced by a top-k random sort.
     double _randMetaFieldVal = 1.0;
+
+    const bool _blockSampling;
 };
 
 }  // namespace mongo
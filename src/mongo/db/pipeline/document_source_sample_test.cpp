@@ -390,6 +390,30 @@ TEST_F(SampleFromRandomCursorBasics, MimicNonOptimized) {
     ASSERT_LTE(secondTotal / nTrials, 0.52);
 }
 
+TEST_F(SampleFromRandomCursorBasics, ExplainShouldReportSamplingMethod) {
+    const auto verbosity = ExplainOptions::Verbosity::kQueryPlanner;
+
+    auto randomCursorSample =
+        DocumentSourceSampleFromRandomCursor::create(getExpCtx(), 2, "_id", 100);
+    ASSERT_VALUE_EQ(randomCursorSample->serialize(verbosity),
+                    Value(DOC("$sampleFromRandomCursor"
+                              << DOC("size" << 2 << "method"
+                                            << "randomCursor"_sd))));
+
+    auto blockSample =
+        DocumentSourceSampleFromRandomCursor::create(getExpCtx(), 2, "_id", 100, true);
+    ASSERT_VALUE_EQ(blockSample->serialize(verbosity),
+                    Value(DOC("$sampleFromRandomCursor"
+                              << DOC("size" << 2 << "method"
+                                            << "blockSampling"_sd))));
+
+    auto sortSample = DocumentSourceSample::createFromBson(
+        BSON("$sample" << BSON("size" << 2)).firstElement(), getExpCtx());
+    ASSERT_VALUE_EQ(sortSample->serialize(verbosity),
+                    Value(DOC("$sample" << DOC("size" << 2 << "method"
+                                                     << "randomSort"_sd))));
+}
+
 DEATH_TEST_F(SampleFromRandomCursorBasics,
              ShouldFailIfGivenPausedInput,
              "Invariant failure Hit a MONGO_UNREACHABLE!") {
@@ -0,0 +1,801 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_set_window_fields.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/summation.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+using std::list;
+using std::vector;
+
+using WindowFunction = DocumentSourceInternalSetWindowFields::WindowFunction;
+using WindowAccumulator = DocumentSourceInternalSetWindowFields::WindowAccumulator;
+
+REGISTER_MULTI_STAGE_ALIAS(setWindowFields,
+                           LiteParsedDocumentSourceDefault::parse,
+                           DocumentSourceSetWindowFields::createFromBson);
+
+REGISTER_DOCUMENT_SOURCE(_internalSetWindowFields,
+                         LiteParsedDocumentSourceDefault::parse,
+                         DocumentSourceInternalSetWindowFields::createFromBson);
+
+namespace {
+
+constexpr StringData kPartitionByName = "partitionBy"_sd;
+constexpr StringData kSortByName = "sortBy"_sd;
+constexpr StringData kOutputName = "output"_sd;
+constexpr StringData kWindowName = "window"_sd;
+constexpr StringData kDocumentsName = "documents"_sd;
+constexpr StringData kUnboundedName = "unbounded"_sd;
+constexpr StringData kCurrentName = "current"_sd;
+
+StringData windowFunctionName(WindowFunction function) {
+    switch (function) {
+        case WindowFunction::kSum:
+            return "$sum"_sd;
+        case WindowFunction::kAvg:
+            return "$avg"_sd;
+        case WindowFunction::kMin:
+            return "$min"_sd;
+        case WindowFunction::kMax:
+            return "$max"_sd;
+    }
+    MONGO_UNREACHABLE;
+}
+
+boost::optional<WindowFunction> parseWindowFunctionName(StringData name) {
+    for (auto function :
+         {WindowFunction::kSum, WindowFunction::kAvg, WindowFunction::kMin, WindowFunction::kMax}) {
+        if (windowFunctionName(function) == name) {
+            return function;
+        }
+    }
+    return boost::none;
+}
+
+boost::optional<long long> parseWindowBound(BSONElement elem) {
+    if (elem.type() == BSONType::String) {
+        if (elem.valueStringData() == kUnboundedName) {
+            return boost::none;
+        }
+        if (elem.valueStringData() == kCurrentName) {
+            return 0;
+        }
+    }
+    uassert(4031710,
+            str::stream() << "window bounds must be an integer, '" << kUnboundedName << "' or '"
+                          << kCurrentName << "', but found: " << elem.toString(false, false),
+            elem.isNumber() && elem.numberDouble() == static_cast<double>(elem.safeNumberLong()));
+    return elem.safeNumberLong();
+}
+
+Value serializeWindowBound(const boost::optional<long long>& bound) {
+    return bound ? Value(*bound) : Value(kUnboundedName);
+}
+
+/**
+ * Maintains the sum of the numeric values in a window. Like the $sum accumulator, non-numeric
+ * values are ignored and the result has the widest numeric type in the window. Infinities and NaNs
+ * are counted rather than added to the sum, so that they stop affecting it once they leave the
+ * window.
+ */
+class WindowSum : public WindowAccumulator {
+public:
+    explicit WindowSum(bool removable) : _removable(removable) {}
+
+    void add(const Value& value) override {
+        if (_removable) {
+            pushValue(value);
+        }
+        if (value.numeric()) {
+            update(value, 1);
+        }
+    }
+
+    void addBatch(std::deque<Value>::const_iterator first,
+                  std::deque<Value>::const_iterator last) override {
+        // Batches of finite doubles or of integers go through the batch kernels of the summation.
+        // Anything else, including infinities and NaNs which are counted separately, is added one
+        // value at a time.
+        if (!_batch.gather(first, last) ||
+            !std::all_of(_batch.doubles.begin(), _batch.doubles.end(), [](double x) {
+                return std::isfinite(x);
+            })) {
+            WindowAccumulator::addBatch(first, last);
+            return;
+        }
+
+        if (_removable) {
+            for (auto it = first; it != last; ++it) {
+                pushValue(*it);
+            }
+        }
+        _nNumeric += _batch.size();
+        _nDoubles += _batch.doubles.size();
+        _nLongs += _batch.numLongs;
+        _nonDecimalTotal.addDoubles(_batch.doubles.data(), _batch.doubles.size());
+        _nonDecimalTotal.addLongs(_batch.integers.data(), _batch.integers.size());
+    }
+
+    void removeOldest() override {
+        invariant(_removable && !_values.empty());
+        auto& [value, bytes] = _values.front();
+        if (value.numeric()) {
+            update(value, -1);
+        }
+        _memUsageBytes -= bytes;
+        _values.pop_front();
+    }
+
+    Value getValue() const override {
+        if (_nDecimals > 0) {
+            if (auto special = getSpecialDouble()) {
+                return Value(Decimal128(*special));
+            }
+            return Value(_decimalTotal.add(_nonDecimalTotal.getDecimal()));
+        }
+        if (_nDoubles > 0) {
+            if (auto special = getSpecialDouble()) {
+                return Value(*special);
+            }
+            return Value(_nonDecimalTotal.getDouble());
+        }
+        if (!_nonDecimalTotal.fitsLong()) {
+            return Value(_nonDecimalTotal.getDouble());
+        }
+        return _nLongs > 0 ? Value(_nonDecimalTotal.getLong())
+                           : Value::createIntOrLong(_nonDecimalTotal.getLong());
+    }
+
+protected:
+    long long numericCount() const {
+        return _nNumeric;
+    }
+
+private:
+    void pushValue(const Value& value) {
+        const auto bytes = value.getApproximateSize();
+        _values.push_back({value, bytes});
+        _memUsageBytes += bytes;
+    }
+
+    void update(const Value& value, int sign) {
+        _nNumeric += sign;
+        switch (value.getType()) {
+            case NumberInt:
+                _nonDecimalTotal.addLong(sign * value.coerceToLong());
+                break;
+            case NumberLong: {
+                _nLongs += sign;
+                const long long x = value.getLong();
+                if (sign < 0 && x == std::numeric_limits<long long>::min()) {
+                    // -x is not representable as a long long, but is exactly representable as a
+                    // double.
+                    _nonDecimalTotal.addDouble(-static_cast<double>(x));
+                } else {
+                    _nonDecimalTotal.addLong(sign * x);
+                }
+                break;
+            }
+            case NumberDouble: {
+                _nDoubles += sign;
+                const double x = value.getDouble();
+                if (std::isnan(x)) {
+                    _nNaNs += sign;
+                } else if (std::isinf(x)) {
+                    (x > 0 ? _nPositiveInfinities : _nNegativeInfinities) += sign;
+                } else {
+                    _nonDecimalTotal.addDouble(sign * x);
+                }
+                break;
+            }
+            case NumberDecimal:
+                _nDecimals += sign;
+                _decimalTotal = sign > 0 ? _decimalTotal.add(value.getDecimal())
+                                         : _decimalTotal.subtract(value.getDecimal());
+                break;
+            default:
+                MONGO_UNREACHABLE;
+        }
+    }
+
+    /**
+     * Returns the sum if it is determined by the infinities and NaNs in the window.
+     */
+    boost::optional<double> getSpecialDouble() const {
+        if (_nNaNs > 0 || (_nPositiveInfinities > 0 && _nNegativeInfinities > 0)) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        if (_nPositiveInfinities > 0) {
+            return std::numeric_limits<double>::infinity();
+        }
+        if (_nNegativeInfinities > 0) {
+            return -std::numeric_limits<double>::infinity();
+        }
+        return boost::none;
+    }
+
+    const bool _removable;
+    // The values in the window and their sizes when they were added, if values are removed.
+    std::deque<std::pair<Value, size_t>> _values;
+    // Reused by addBatch() to avoid allocating for every batch.
+    NumericBatch _batch;
+
+    long long _nNumeric = 0;
+    long long _nLongs = 0;
+    long long _nDoubles = 0;
+    long long _nDecimals = 0;
+    long long _nNaNs = 0;
+    long long _nPositiveInfinities = 0;
+    long long _nNegativeInfinities = 0;
+
+    DoubleDoubleSummation _nonDecimalTotal;
+    Decimal128 _decimalTotal;
+};
+
+/**
+ * Maintains the average of the numeric values in a window, or null if there are none.
+ */
+class WindowAvg final : public WindowSum {
+public:
+    using WindowSum::WindowSum;
+
+    Value getValue() const final {
+        const auto count = numericCount();
+        if (count == 0) {
+            return Value(BSONNULL);
+        }
+        auto sum = WindowSum::getValue();
+        if (sum.getType() == NumberDecimal) {
+            return Value(sum.getDecimal().divide(Decimal128(static_cast<int64_t>(count))));
+        }
+        return Value(sum.coerceToDouble() / count);
+    }
+};
+
+/**
+ * Maintains the minimum or maximum of the non-nullish values in a window, or null if there are
+ * none. A window with a lower bound keeps a monotonic queue of the values which could still become
+ * the result once the values before them leave the window, so each value is pushed and popped at
+ * most once.
+ */
+class WindowMinMax final : public WindowAccumulator {
+public:
+    WindowMinMax(const ValueComparator& comparator, bool isMin, bool removable)
+        : _comparator(comparator), _sign(isMin ? 1 : -1), _removable(removable) {}
+
+    void add(const Value& value) override {
+        const long long position = _nAdded++;
+        if (value.nullish()) {
+            return;
+        }
+
+        if (!_removable) {
+            if (_candidates.empty()) {
+                pushCandidate(position, value);
+            } else if (isBetter(value, _candidates.front().value)) {
+                _memUsageBytes -= _candidates.front().bytes;
+                _candidates.pop_front();
+                pushCandidate(position, value);
+            }
+            return;
+        }
+
+        // Values which are not better than the new one can never be the result again, since the
+        // new one will stay in the window for longer.
+        while (!_candidates.empty() && !isBetter(_candidates.back().value, value)) {
+            _memUsageBytes -= _candidates.back().bytes;
+            _candidates.pop_back();
+        }
+        pushCandidate(position, value);
+    }
+
+    void removeOldest() override {
+        invariant(_removable && _nRemoved < _nAdded);
+        if (!_candidates.empty() && _candidates.front().position == _nRemoved) {
+            _memUsageBytes -= _candidates.front().bytes;
+            _candidates.pop_front();
+        }
+        ++_nRemoved;
+    }
+
+    Value getValue() const override {
+        return _candidates.empty() ? Value(BSONNULL) : _candidates.front().value;
+    }
+
+private:
+    struct Candidate {
+        long long position;
+        Value value;
+        // The size of 'value' when it was added.
+        size_t bytes;
+    };
+
+    bool isBetter(const Value& lhs, const Value& rhs) const {
+        return _sign * _comparator.compare(lhs, rhs) < 0;
+    }
+
+    void pushCandidate(long long position, const Value& value) {
+        const auto bytes = value.getApproximateSize();
+        _candidates.push_back({position, value, bytes});
+        _memUsageBytes += bytes;
+    }
+
+    const ValueComparator _comparator;
+    const int _sign;
+    const bool _removable;
+
+    // Ordered by partition position, with the best value first.
+    std::deque<Candidate> _candidates;
+    long long _nAdded = 0;
+    long long _nRemoved = 0;
+};
+
+}  // namespace
+
+list<intrusive_ptr<DocumentSource>> DocumentSourceSetWindowFields::createFromBson(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& pExpCtx) {
+    uassert(4031711,
+            str::stream() << "the " << kStageName
+                          << " stage specification must be an object, but found type: "
+                          << typeName(elem.type()),
+            elem.type() == BSONType::Object);
+
+    boost::optional<std::string> partitionPath;
+    BSONObj sortBy;
+    boost::optional<vector<DocumentSourceInternalSetWindowFields::OutputField>> outputFields;
+    for (auto&& argument : elem.embeddedObject()) {
+        const auto argName = argument.fieldNameStringData();
+        if (kPartitionByName == argName) {
+            uassert(4031712,
+                    str::stream() << "the " << kStageName << " '" << kPartitionByName
+                                  << "' argument must be a $-prefixed field path, but found: "
+                                  << argument.toString(false, false),
+                    argument.type() == BSONType::String &&
+                        argument.valueStringData().startsWith("$") &&
+                        !argument.valueStringData().startsWith("$$"));
+            partitionPath = argument.valueStringData().substr(1).toString();
+        } else if (kSortByName == argName) {
+            uassert(4031713,
+                    str::stream() << "the " << kStageName << " '" << kSortByName
+                                  << "' argument must be an object, but found type: "
+                                  << typeName(argument.type()),
+                    argument.type() == BSONType::Object);
+            sortBy = argument.embeddedObject();
+        } else if (kOutputName == argName) {
+            outputFields =
+                DocumentSourceInternalSetWindowFields::parseOutputFields(argument, pExpCtx);
+        } else {
+            uasserted(4031714,
+                      str::stream() << "unrecognized option to " << kStageName << ": " << argName);
+        }
+    }
+    uassert(4031715,
+            str::stream() << kStageName << " requires an '" << kOutputName << "' argument",
+            outputFields);
+
+    // Sort by the partition key first, so that each partition is contiguous in the input of
+    // $_internalSetWindowFields.
+    BSONObjBuilder sortSpec;
+    if (partitionPath) {
+        sortSpec.append(*partitionPath, 1);
+    }
+    for (auto&& sortElem : sortBy) {
+        if (!partitionPath || sortElem.fieldNameStringData() != *partitionPath) {
+            sortSpec.append(sortElem);
+        }
+    }
+
+    intrusive_ptr<Expression> partitionBy;
+    if (partitionPath) {
+        partitionBy =
+            ExpressionFieldPath::parse(pExpCtx, "$" + *partitionPath, pExpCtx->variablesParseState);
+    }
+
+    list<intrusive_ptr<DocumentSource>> stages;
+    auto sortObj = sortSpec.obj();
+    if (!sortObj.isEmpty()) {
+        stages.push_back(DocumentSourceSort::create(pExpCtx, sortObj));
+    }
+    stages.push_back(DocumentSourceInternalSetWindowFields::create(
+        pExpCtx, std::move(partitionBy), std::move(*outputFields)));
+    return stages;
+}
+
+vector<DocumentSourceInternalSetWindowFields::OutputField>
+DocumentSourceInternalSetWindowFields::parseOutputFields(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& expCtx) {
+    uassert(4031716,
+            str::stream() << "the '" << kOutputName
+                          << "' argument of a window stage must be an object, but found type: "
+                          << typeName(elem.type()),
+            elem.type() == BSONType::Object);
+
+    vector<OutputField> outputFields;
+    for (auto&& outputElem : elem.embeddedObject()) {
+        const auto fieldName = outputElem.fieldNameStringData();
+        uassert(4031717,
+                str::stream() << "the window output field '" << fieldName
+                              << "' must be specified as an object",
+                outputElem.type() == BSONType::Object);
+
+        boost::optional<WindowFunction> function;
+        intrusive_ptr<Expression> input;
+        WindowBounds bounds;
+        for (auto&& arg : outputElem.embeddedObject()) {
+            const auto argName = arg.fieldNameStringData();
+            if (kWindowName == argName) {
+                uassert(4031718,
+                        str::stream() << "'" << kWindowName << "' must be an object of the form {"
+                                      << kDocumentsName << ": [<lower>, <upper>]}",
+                        arg.type() == BSONType::Object && arg.embeddedObject().nFields() == 1 &&
+                            arg.embeddedObject().hasField(kDocumentsName) &&
+                            arg.embeddedObject()[kDocumentsName].type() == BSONType::Array &&
+                            arg.embeddedObject()[kDocumentsName].embeddedObject().nFields() == 2);
+                auto documents = arg.embeddedObject()[kDocumentsName].embeddedObject();
+                bounds.lower = parseWindowBound(documents["0"]);
+                bounds.upper = parseWindowBound(documents["1"]);
+                uassert(4031719,
+                        "the lower bound of a window must not be greater than its upper bound",
+                        !bounds.lower || !bounds.upper || *bounds.lower <= *bounds.upper);
+            } else {
+                auto parsedFunction = parseWindowFunctionName(argName);
+                uassert(4031720,
+                        str::stream() << "unrecognized window function: " << argName
+                                      << ". Supported functions are $sum, $avg, $min and $max",
+                        parsedFunction);
+                uassert(4031721,
+                        str::stream() << "the window output field '" << fieldName
+                                      << "' must specify exactly one window function",
+                        !function);
+                function = parsedFunction;
+                input = Expression::parseOperand(expCtx, arg, expCtx->variablesParseState);
+            }
+        }
+        uassert(4031722,
+                str::stream() << "the window output field '" << fieldName
+                              << "' must specify a window function",
+                function);
+
+        outputFields.push_back({FieldPath(fieldName), *function, std::move(input), bounds});
+    }
+    uassert(4031723,
+            str::stream() << "the '" << kOutputName << "' argument must not be empty",
+            !outputFields.empty());
+    return outputFields;
+}
+
+intrusive_ptr<DocumentSource> DocumentSourceInternalSetWindowFields::createFromBson(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& pExpCtx) {
+    uassert(4031724,
+            str::stream() << "the " << kStageName
+                          << " stage specification must be an object, but found type: "
+                          << typeName(elem.type()),
+            elem.type() == BSONType::Object);
+
+    intrusive_ptr<Expression> partitionBy;
+    boost::optional<vector<OutputField>> outputFields;
+    for (auto&& argument : elem.embeddedObject()) {
+        const auto argName = argument.fieldNameStringData();
+        if (kPartitionByName == argName) {
+            partitionBy =
+                Expression::parseOperand(pExpCtx, argument, pExpCtx->variablesParseState);
+        } else if (kOutputName == argName) {
+            outputFields = parseOutputFields(argument, pExpCtx);
+        } else {
+            uasserted(4031725,
+                      str::stream() << "unrecognized option to " << kStageName << ": " << argName);
+        }
+    }
+    uassert(4031726,
+            str::stream() << kStageName << " requires an '" << kOutputName << "' argument",
+            outputFields);
+
+    return create(pExpCtx, std::move(partitionBy), std::move(*outputFields));
+}
+
+intrusive_ptr<DocumentSourceInternalSetWindowFields> DocumentSourceInternalSetWindowFields::create(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    intrusive_ptr<Expression> partitionBy,
+    vector<OutputField> outputFields) {
+    return new DocumentSourceInternalSetWindowFields(
+        expCtx, std::move(partitionBy), std::move(outputFields));
+}
+
+std::unique_ptr<WindowAccumulator> DocumentSourceInternalSetWindowFields::makeAccumulator(
+    WindowFunction function, const ValueComparator& comparator, bool removable) {
+    switch (function) {
+        case WindowFunction::kSum:
+            return std::make_unique<WindowSum>(removable);
+        case WindowFunction::kAvg:
+            return std::make_unique<WindowAvg>(removable);
+        case WindowFunction::kMin:
+            return std::make_unique<WindowMinMax>(comparator, true, removable);
+        case WindowFunction::kMax:
+            return std::make_unique<WindowMinMax>(comparator, false, removable);
+    }
+    MONGO_UNREACHABLE;
+}
+
+DocumentSourceInternalSetWindowFields::DocumentSourceInternalSetWindowFields(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    intrusive_ptr<Expression> partitionBy,
+    vector<OutputField> outputFields)
+    : DocumentSource(kStageName, expCtx),
+      _partitionBy(std::move(partitionBy)),
+      _outputFields(std::move(outputFields)),
+      _outputStates(_outputFields.size()) {
+    _maxUpper = 0;
+    for (auto&& outputField : _outputFields) {
+        if (!outputField.bounds.upper) {
+            _maxUpper = boost::none;
+            break;
+        }
+        _maxUpper = std::max(*_maxUpper, *outputField.bounds.upper);
+    }
+    resetPartition();
+}
+
+Value DocumentSourceInternalSetWindowFields::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    MutableDocument spec;
+    if (_partitionBy) {
+        spec[kPartitionByName] = _partitionBy->serialize(static_cast<bool>(explain));
+    }
+
+    MutableDocument output;
+    for (auto&& outputField : _outputFields) {
+        MutableDocument fieldSpec;
+        fieldSpec[windowFunctionName(outputField.function)] =
+            outputField.input->serialize(static_cast<bool>(explain));
+        fieldSpec[kWindowName] = Value(
+            DOC(kDocumentsName << vector<Value>{serializeWindowBound(outputField.bounds.lower),
+                                                serializeWindowBound(outputField.bounds.upper)}));
+        output[outputField.path.fullPath()] = fieldSpec.freezeToValue();
+    }
+    spec[kOutputName] = output.freezeToValue();
+
+    return Value(DOC(getSourceName() << spec.freeze()));
+}
+
+DepsTracker::State DocumentSourceInternalSetWindowFields::getDependencies(
+    DepsTracker* deps) const {
+    if (_partitionBy) {
+        _partitionBy->addDependencies(deps);
+    }
+    for (auto&& outputField : _outputFields) {
+        outputField.input->addDependencies(deps);
+    }
+    return DepsTracker::State::SEE_NEXT;
+}
+
+DocumentSource::GetModPathsReturn DocumentSourceInternalSetWindowFields::getModifiedPaths() const {
+    std::set<std::string> modifiedPaths;
+    for (auto&& outputField : _outputFields) {
+        modifiedPaths.insert(outputField.path.fullPath());
+    }
+    return {GetModPathsReturn::Type::kFiniteSet, std::move(modifiedPaths), {}};
+}
+
+intrusive_ptr<DocumentSource> DocumentSourceInternalSetWindowFields::optimize() {
+    if (_partitionBy) {
+        _partitionBy = _partitionBy->optimize();
+    }
+    for (auto&& outputField : _outputFields) {
+        outputField.input = outputField.input->optimize();
+    }
+    return this;
+}
+
+void DocumentSourceInternalSetWindowFields::resetPartition() {
+    invariant(_buffer.empty());
+    _bufferBytes = 0;
+    _nextOut = 0;
+    _nextRead = 0;
+    _partitionDone = false;
+
+    for (size_t i = 0; i < _outputFields.size(); ++i) {
+        auto& state = _outputStates[i];
+        state.pending.clear();
+        state.pendingValueBytes.clear();
+        state.pendingBytes = 0;
+        state.added = 0;
+        state.windowStart = 0;
+        state.accumulator = makeAccumulator(_outputFields[i].function,
+                                            pExpCtx->getValueComparator(),
+                                            static_cast<bool>(_outputFields[i].bounds.lower));
+    }
+}
+
+void DocumentSourceInternalSetWindowFields::readDocument(Document doc) {
+    for (size_t i = 0; i < _outputFields.size(); ++i) {
+        auto& state = _outputStates[i];
+        state.pending.push_back(_outputFields[i].input->evaluate(doc, &pExpCtx->variables));
+        state.pendingValueBytes.push_back(state.pending.back().getApproximateSize());
+        state.pendingBytes += state.pendingValueBytes.back();
+    }
+
+    const auto bytes = doc.getApproximateSize();
+    _bufferBytes += bytes;
+    _buffer.push_back({std::move(doc), bytes});
+    ++_nextRead;
+
+    // Emitting a document only moves input values from 'pending' into the accumulators, or drops
+    // them, so the memory in use can only grow here.
+    assertWithinMemoryLimit();
+}
+
+void DocumentSourceInternalSetWindowFields::assertWithinMemoryLimit() const {
+    size_t bytes = _bufferBytes;
+    for (auto&& state : _outputStates) {
+        bytes += state.pendingBytes + state.accumulator->getMemUsage();
+    }
+
+    const auto maxBytes = internalDocumentSourceSetWindowFieldsMaxMemoryBytes.load();
+    uassert(4031727,
+            str::stream() << kStageName << " exceeded its memory limit of " << maxBytes
+                          << " bytes while buffering a partition. Use windows with a bounded upper "
+                             "bound, or partition the input further",
+            bytes <= static_cast<size_t>(maxBytes));
+}
+
+bool DocumentSourceInternalSetWindowFields::canEmit() const {
+    if (_buffer.empty()) {
+        return false;
+    }
+    if (_partitionDone) {
+        return true;
+    }
+    // Every window of the oldest buffered document ends at or before position
+    // '_nextOut + _maxUpper', so it is complete once that position has been read.
+    return _maxUpper && _nextRead > _nextOut + std::max(*_maxUpper, 0LL);
+}
+
+Document DocumentSourceInternalSetWindowFields::emitNext() {
+    const long long position = _nextOut++;
+    const long long lastRead = _nextRead - 1;
+
+    MutableDocument output(std::move(_buffer.front().doc));
+    _bufferBytes -= _buffer.front().bytes;
+    _buffer.pop_front();
+
+    for (size_t i = 0; i < _outputFields.size(); ++i) {
+        const auto& bounds = _outputFields[i].bounds;
+        auto& state = _outputStates[i];
+
+        const long long windowEnd =
+            bounds.upper ? std::min(position + *bounds.upper, lastRead) : lastRead;
+        if (state.added <= windowEnd) {
+            const auto numToAdd = windowEnd - state.added + 1;
+            const auto last = state.pending.begin() + numToAdd;
+            state.accumulator->addBatch(state.pending.begin(), last);
+            state.pending.erase(state.pending.begin(), last);
+            const auto lastBytes = state.pendingValueBytes.begin() + numToAdd;
+            state.pendingBytes -=
+                std::accumulate(state.pendingValueBytes.begin(), lastBytes, size_t{0});
+            state.pendingValueBytes.erase(state.pendingValueBytes.begin(), lastBytes);
+            state.added += numToAdd;
+        }
+
+        if (bounds.lower) {
+            const long long windowStart = position + *bounds.lower;
+            while (state.windowStart < windowStart && state.windowStart < state.added) {
+                state.accumulator->removeOldest();
+                ++state.windowStart;
+            }
+        }
+
+        output.setNestedField(_outputFields[i].path, state.accumulator->getValue());
+    }
+
+    return output.freeze();
+}
+
+DocumentSource::GetNextResult DocumentSourceInternalSetWindowFields::doGetNext() {
+    while (true) {
+        if (canEmit()) {
+            return emitNext();
+        }
+
+        if (_partitionDone) {
+            if (_eof) {
+                return GetNextResult::makeEOF();
+            }
+            resetPartition();
+            readDocument(std::move(*_nextPartitionFirstDoc));
+            _nextPartitionFirstDoc = boost::none;
+            continue;
+        }
+
+        auto next = pSource->getNext();
+        if (next.isPaused()) {
+            return next;
+        }
+        if (next.isEOF()) {
+            _partitionDone = true;
+            _eof = true;
+            continue;
+        }
+
+        auto doc = next.releaseDocument();
+        Value partitionKey;
+        if (_partitionBy) {
+            partitionKey = _partitionBy->evaluate(doc, &pExpCtx->variables);
+            // $sort orders missing partition keys together with null ones.
+            if (partitionKey.missing()) {
+                partitionKey = Value(BSONNULL);
+            }
+            // $sort orders arrays by their smallest or largest element, so the documents of a
+            // partition whose key is an array would not be contiguous.
+            uassert(4031732,
+                    str::stream() << kStageName << " partitionBy must not evaluate to an array, "
+                                  << "but found: " << partitionKey.toString(),
+                    !partitionKey.isArray());
+        }
+
+        if (_nextRead > 0 &&
+            pExpCtx->getValueComparator().evaluate(partitionKey != _partitionKey)) {
+            // 'doc' starts the next partition, so the current one is complete.
+            _partitionDone = true;
+            _partitionKey = std::move(partitionKey);
+            _nextPartitionFirstDoc = std::move(doc);
+            continue;
+        }
+
+        _partitionKey = std::move(partitionKey);
+        readDocument(std::move(doc));
+    }
+}
+
+void DocumentSourceInternalSetWindowFields::doDispose() {
+    _buffer.clear();
+    _nextPartitionFirstDoc = boost::none;
+    _partitionDone = true;
+    _eof = true;
+}
+
+}  // namespace mongo
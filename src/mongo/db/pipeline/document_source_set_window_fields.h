@@ -0,0 +1,263 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <deque>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/field_path.h"
+
+namespace mongo {
+
+/**
+ * The $setWindowFields stage is an alias for a $sort stage on the partition and sort keys, followed
+ * by a $_internalSetWindowFields stage which computes the window functions over the sorted stream.
+ */
+class DocumentSourceSetWindowFields final {
+public:
+    static constexpr StringData kStageName = "$setWindowFields"_sd;
+
+    /**
+     * Returns a $sort stage followed by a $_internalSetWindowFields stage. The $sort stage is
+     * omitted if neither 'partitionBy' nor 'sortBy' are specified.
+     */
+    static std::list<boost::intrusive_ptr<DocumentSource>> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
+
+private:
+    // It is illegal to construct a DocumentSourceSetWindowFields directly, use createFromBson()
+    // instead.
+    DocumentSourceSetWindowFields() = default;
+};
+
+/**
+ * Computes window functions over input which is sorted by partition. Each output field is a $sum,
+ * $avg, $min or $max over a window of documents given as offsets from the current document within
+ * its partition. The window functions are maintained incrementally as the window slides, so each
+ * document costs amortized O(1) per output field, and only the documents and values inside the
+ * largest window are buffered.
+ */
+class DocumentSourceInternalSetWindowFields final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalSetWindowFields"_sd;
+
+    enum class WindowFunction { kSum, kAvg, kMin, kMax };
+
+    /**
+     * The bounds of a window, as offsets from the current document within its partition. Both
+     * bounds are inclusive, and boost::none means the window is unbounded in that direction.
+     */
+    struct WindowBounds {
+        boost::optional<long long> lower;
+        boost::optional<long long> upper;
+    };
+
+    struct OutputField {
+        FieldPath path;
+        WindowFunction function;
+        boost::intrusive_ptr<Expression> input;
+        WindowBounds bounds;
+    };
+
+    /**
+     * Interface of the incrementally maintained window functions. Values are added in partition
+     * order, and removed oldest first.
+     */
+    class WindowAccumulator {
+    public:
+        virtual ~WindowAccumulator() = default;
+
+        virtual void add(const Value& value) = 0;
+
+        /**
+         * Adds the values in [first, last) in order, one at a time unless overridden.
+         */
+        virtual void addBatch(std::deque<Value>::const_iterator first,
+                              std::deque<Value>::const_iterator last) {
+            for (; first != last; ++first) {
+                add(*first);
+            }
+        }
+
+        /**
+         * Removes the oldest value which has been added and not yet removed.
+         */
+        virtual void removeOldest() = 0;
+
+        virtual Value getValue() const = 0;
+
+        /**
+         * Returns the approximate size of the values the accumulator holds on to, as measured when
+         * each of them was added.
+         */
+        size_t getMemUsage() const {
+            return _memUsageBytes;
+        }
+
+    protected:
+        size_t _memUsageBytes = 0;
+    };
+
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
+
+    static boost::intrusive_ptr<DocumentSourceInternalSetWindowFields> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        boost::intrusive_ptr<Expression> partitionBy,
+        std::vector<OutputField> outputFields);
+
+    /**
+     * Parses the 'output' argument shared by $setWindowFields and $_internalSetWindowFields.
+     */
+    static std::vector<OutputField> parseOutputFields(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    /**
+     * Creates the accumulator for 'function'. If 'removable' is false, the window has no lower
+     * bound and removeOldest() will never be called, which lets the accumulator use O(1) memory.
+     */
+    static std::unique_ptr<WindowAccumulator> makeAccumulator(
+        WindowFunction function, const ValueComparator& comparator, bool removable);
+
+    const char* getSourceName() const final {
+        return kStageName.rawData();
+    }
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        return {StreamType::kBlocking,
+                PositionRequirement::kNone,
+                HostTypeRequirement::kNone,
+                DiskUseRequirement::kNoDiskUse,
+                FacetRequirement::kAllowed,
+                TransactionRequirement::kAllowed,
+                LookupRequirement::kAllowed};
+    }
+
+    /**
+     * Partitions may span shards, so this stage must run after the sorted streams are merged.
+     */
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        // {shardsStage, mergingStage, sortPattern}
+        return DistributedPlanLogic{nullptr, this, boost::none};
+    }
+
+    DepsTracker::State getDependencies(DepsTracker* deps) const final;
+
+    GetModPathsReturn getModifiedPaths() const final;
+
+    boost::intrusive_ptr<DocumentSource> optimize() final;
+
+private:
+    struct OutputState {
+        // Input values of the documents at partition positions ['added', '_nextRead'), and the
+        // size each of them had when it was evaluated.
+        std::deque<Value> pending;
+        std::deque<size_t> pendingValueBytes;
+        size_t pendingBytes = 0;
+        // Positions before 'added' have been added to the accumulator, and positions before
+        // 'windowStart' have been removed from it again.
+        long long added = 0;
+        long long windowStart = 0;
+        std::unique_ptr<WindowAccumulator> accumulator;
+    };
+
+    struct BufferedDocument {
+        Document doc;
+        // The size of 'doc' when it was buffered, which is what must be given back when it is
+        // returned.
+        size_t bytes;
+    };
+
+    DocumentSourceInternalSetWindowFields(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                          boost::intrusive_ptr<Expression> partitionBy,
+                                          std::vector<OutputField> outputFields);
+
+    GetNextResult doGetNext() final;
+
+    void doDispose() final;
+
+    /**
+     * Resets the per-partition state, before reading the first document of a partition.
+     */
+    void resetPartition();
+
+    /**
+     * Buffers 'doc' as the next document of the current partition.
+     */
+    void readDocument(Document doc);
+
+    /**
+     * Throws if the buffered documents, together with the input values held by the output fields,
+     * exceed the memory limit for a partition.
+     */
+    void assertWithinMemoryLimit() const;
+
+    /**
+     * Returns true if the window of every output field is complete for the oldest buffered
+     * document.
+     */
+    bool canEmit() const;
+
+    /**
+     * Computes the output fields for the oldest buffered document and returns it.
+     */
+    Document emitNext();
+
+    boost::intrusive_ptr<Expression> _partitionBy;
+    std::vector<OutputField> _outputFields;
+
+    // The largest upper bound over all output fields, or boost::none if any window is unbounded
+    // above, in which case the whole partition must be buffered.
+    boost::optional<long long> _maxUpper;
+
+    // Iteration state.
+    Value _partitionKey;
+    boost::optional<Document> _nextPartitionFirstDoc;
+    bool _partitionDone = false;
+    bool _eof = false;
+
+    // Documents of the current partition which have been read but not yet returned. They are at
+    // partition positions ['_nextOut', '_nextRead').
+    std::deque<BufferedDocument> _buffer;
+    size_t _bufferBytes = 0;
+    long long _nextOut = 0;
+    long long _nextRead = 0;
+
+    std::vector<OutputState> _outputStates;
+};
+
+}  // namespace mongo
@@ -0,0 +1,308 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <boost/intrusive_ptr.hpp>
+#include <deque>
+#include <limits>
+#include <list>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/json.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_source_set_window_fields.h"
+#include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+using boost::intrusive_ptr;
+using std::deque;
+using std::list;
+using std::vector;
+
+class SetWindowFieldsTest : public AggregationContextFixture {
+public:
+    /**
+     * Runs a $_internalSetWindowFields stage with the given spec over 'inputs', which must already
+     * be sorted by partition, and returns all of its results.
+     */
+    vector<Document> runWindowStage(const BSONObj& spec,
+                                    deque<DocumentSource::GetNextResult> inputs) {
+        auto mock = DocumentSourceMock::createForTest(std::move(inputs));
+        auto stage = DocumentSourceInternalSetWindowFields::createFromBson(
+            BSON("$_internalSetWindowFields" << spec).firstElement(), getExpCtx());
+        stage->setSource(mock.get());
+
+        vector<Document> results;
+        for (auto next = stage->getNext(); !next.isEOF(); next = stage->getNext()) {
+            if (next.isAdvanced()) {
+                results.push_back(next.releaseDocument());
+            }
+        }
+        ASSERT_TRUE(stage->getNext().isEOF());
+        return results;
+    }
+
+    /**
+     * Returns documents {_id: i, part: <partition>, x: <value>} for the given partition values.
+     */
+    deque<DocumentSource::GetNextResult> makeInputs(const vector<std::pair<int, int>>& values) {
+        deque<DocumentSource::GetNextResult> inputs;
+        int id = 0;
+        for (auto&& [partition, x] : values) {
+            inputs.emplace_back(Document{{"_id", id++}, {"part", partition}, {"x", x}});
+        }
+        return inputs;
+    }
+
+    vector<Value> fieldValues(const vector<Document>& docs, StringData field) {
+        vector<Value> values;
+        for (auto&& doc : docs) {
+            values.push_back(doc[field]);
+        }
+        return values;
+    }
+};
+
+TEST_F(SetWindowFieldsTest, ShouldComputeRunningTotalPerPartition) {
+    auto results = runWindowStage(
+        fromjson("{partitionBy: '$part', output: {total: {$sum: '$x', window: {documents: "
+                 "['unbounded', 'current']}}}}"),
+        makeInputs({{1, 1}, {1, 2}, {1, 3}, {2, 10}, {2, 20}}));
+
+    ASSERT_EQ(results.size(), 5UL);
+    ASSERT_VALUE_EQ(Value(fieldValues(results, "total")),
+                    Value(vector<Value>{Value(1), Value(3), Value(6), Value(10), Value(30)}));
+    // The other fields are passed through unmodified.
+    ASSERT_VALUE_EQ(results[3]["_id"], Value(3));
+}
+
+TEST_F(SetWindowFieldsTest, ShouldComputeSlidingWindowFunctions) {
+    auto results = runWindowStage(
+        fromjson("{output: {"
+                 "avg: {$avg: '$x', window: {documents: [-1, 1]}},"
+                 "min: {$min: '$x', window: {documents: [-1, 1]}},"
+                 "max: {$max: '$x', window: {documents: [-1, 1]}}}}"),
+        makeInputs({{1, 4}, {1, 2}, {1, 6}, {1, 8}}));
+
+    ASSERT_EQ(results.size(), 4UL);
+    ASSERT_VALUE_EQ(Value(fieldValues(results, "avg")),
+                    Value(vector<Value>{Value(3.0), Value(4.0), Value(16.0 / 3), Value(7.0)}));
+    ASSERT_VALUE_EQ(Value(fieldValues(results, "min")),
+                    Value(vector<Value>{Value(2), Value(2), Value(2), Value(6)}));
+    ASSERT_VALUE_EQ(Value(fieldValues(results, "max")),
+                    Value(vector<Value>{Value(4), Value(6), Value(8), Value(8)}));
+}
+
+TEST_F(SetWindowFieldsTest, ShouldComputeWindowsWhichExcludeTheCurrentDocument) {
+    auto results = runWindowStage(
+        fromjson("{output: {"
+                 "prev: {$sum: '$x', window: {documents: [-2, -1]}},"
+                 "next: {$max: '$x', window: {documents: [1, 1]}}}}"),
+        makeInputs({{1, 1}, {1, 2}, {1, 3}, {1, 4}}));
+
+    ASSERT_EQ(results.size(), 4UL);
+    ASSERT_VALUE_EQ(Value(fieldValues(results, "prev")),
+                    Value(vector<Value>{Value(0), Value(1), Value(3), Value(5)}));
+    ASSERT_VALUE_EQ(Value(fieldValues(results, "next")),
+                    Value(vector<Value>{Value(2), Value(3), Value(4), Value(BSONNULL)}));
+}
+
+TEST_F(SetWindowFieldsTest, ShouldComputeUnboundedWindowOverWholePartition) {
+    auto results = runWindowStage(
+        fromjson("{partitionBy: '$part', output: {total: {$sum: '$x'}}}"),
+        makeInputs({{1, 1}, {1, 2}, {2, 5}}));
+
+    ASSERT_EQ(results.size(), 3UL);
+    ASSERT_VALUE_EQ(Value(fieldValues(results, "total")),
+                    Value(vector<Value>{Value(3), Value(3), Value(5)}));
+}
+
+TEST_F(SetWindowFieldsTest, ShouldPropagatePauses) {
+    deque<DocumentSource::GetNextResult> inputs{
+        Document{{"x", 1}},
+        DocumentSource::GetNextResult::makePauseExecution(),
+        Document{{"x", 2}},
+    };
+    auto mock = DocumentSourceMock::createForTest(std::move(inputs));
+    auto stage = DocumentSourceInternalSetWindowFields::createFromBson(
+        fromjson("{$_internalSetWindowFields: {output: {total: {$sum: '$x', window: {documents: "
+                 "['unbounded', 'current']}}}}}")
+            .firstElement(),
+        getExpCtx());
+    stage->setSource(mock.get());
+
+    auto next = stage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_VALUE_EQ(next.getDocument()["total"], Value(1));
+    ASSERT_TRUE(stage->getNext().isPaused());
+    next = stage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_VALUE_EQ(next.getDocument()["total"], Value(3));
+    ASSERT_TRUE(stage->getNext().isEOF());
+}
+
+TEST_F(SetWindowFieldsTest, SumShouldRecoverFromNonFiniteValuesLeavingTheWindow) {
+    deque<DocumentSource::GetNextResult> inputs{
+        Document{{"x", std::numeric_limits<double>::infinity()}},
+        Document{{"x", 1.5}},
+        Document{{"x", 2.5}},
+    };
+    auto results = runWindowStage(
+        fromjson("{output: {total: {$sum: '$x', window: {documents: [-1, 0]}}}}"),
+        std::move(inputs));
+
+    ASSERT_EQ(results.size(), 3UL);
+    const auto infinity = std::numeric_limits<double>::infinity();
+    ASSERT_VALUE_EQ(Value(fieldValues(results, "total")),
+                    Value(vector<Value>{Value(infinity), Value(infinity), Value(4.0)}));
+}
+
+TEST_F(SetWindowFieldsTest, ShouldRejectArrayPartitionKeys) {
+    deque<DocumentSource::GetNextResult> inputs{
+        Document{{"part", 1}, {"x", 1}},
+        Document{{"part", vector<Value>{Value(1), Value(2)}}, {"x", 2}},
+    };
+    ASSERT_THROWS_CODE(
+        runWindowStage(fromjson("{partitionBy: '$part', output: {total: {$sum: '$x'}}}"),
+                       std::move(inputs)),
+        AssertionException,
+        4031732);
+}
+
+/**
+ * Returns documents {x: <string of 'bytes' bytes>}.
+ */
+deque<DocumentSource::GetNextResult> makeLargeInputs(size_t numDocs, size_t bytes) {
+    deque<DocumentSource::GetNextResult> inputs;
+    for (size_t i = 0; i < numDocs; ++i) {
+        inputs.emplace_back(Document{{"x", std::string(bytes, 'a' + i % 26)}});
+    }
+    return inputs;
+}
+
+TEST_F(SetWindowFieldsTest, MemoryLimitShouldCountValuesHeldByWindowFunctions) {
+    const auto maxMemoryBytes = internalDocumentSourceSetWindowFieldsMaxMemoryBytes.load();
+    ON_BLOCK_EXIT(
+        [&] { internalDocumentSourceSetWindowFieldsMaxMemoryBytes.store(maxMemoryBytes); });
+    internalDocumentSourceSetWindowFieldsMaxMemoryBytes.store(20 * 1024);
+
+    // Every document is returned as soon as it is read, but $sum keeps the last 100 values.
+    ASSERT_THROWS_CODE(
+        runWindowStage(fromjson("{output: {total: {$sum: '$x', window: {documents: [-100, 0]}}}}"),
+                       makeLargeInputs(50, 1024)),
+        AssertionException,
+        4031727);
+
+    // $min keeps every value of an increasing run, since each of them becomes the minimum once the
+    // values before it leave the window.
+    ASSERT_THROWS_CODE(
+        runWindowStage(fromjson("{output: {low: {$min: '$x', window: {documents: [-100, 0]}}}}"),
+                       makeLargeInputs(50, 1024)),
+        AssertionException,
+        4031727);
+}
+
+TEST_F(SetWindowFieldsTest, MemoryShouldBeReleasedAsTheWindowSlides) {
+    const auto maxMemoryBytes = internalDocumentSourceSetWindowFieldsMaxMemoryBytes.load();
+    ON_BLOCK_EXIT(
+        [&] { internalDocumentSourceSetWindowFieldsMaxMemoryBytes.store(maxMemoryBytes); });
+    internalDocumentSourceSetWindowFieldsMaxMemoryBytes.store(32 * 1024);
+
+    auto results = runWindowStage(fromjson("{output: {"
+                                           "total: {$sum: '$x', window: {documents: [-2, 1]}},"
+                                           "top: {$max: '$x', window: {documents: [-2, 1]}}}}"),
+                                  makeLargeInputs(1000, 1024));
+    ASSERT_EQ(results.size(), 1000UL);
+}
+
+TEST_F(SetWindowFieldsTest, ShouldDesugarIntoSortAndInternalStage) {
+    auto spec = fromjson(
+        "{$setWindowFields: {partitionBy: '$part', sortBy: {x: -1}, output: {total: {$sum: '$x', "
+        "window: {documents: ['unbounded', 'current']}}}}}");
+    list<intrusive_ptr<DocumentSource>> result =
+        DocumentSourceSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
+
+    ASSERT_EQUALS(result.size(), 2UL);
+    auto* sortStage = dynamic_cast<DocumentSourceSort*>(result.front().get());
+    ASSERT(sortStage);
+    ASSERT_BSONOBJ_EQ(sortStage->getSortKeyPattern().serialize(
+                          SortPattern::SortKeySerialization::kForPipelineSerialization)
+                          .toBson(),
+                      fromjson("{part: 1, x: -1}"));
+
+    auto* windowStage = dynamic_cast<DocumentSourceInternalSetWindowFields*>(result.back().get());
+    ASSERT(windowStage);
+    ASSERT_VALUE_EQ(
+        windowStage->serialize(),
+        Value(fromjson("{$_internalSetWindowFields: {partitionBy: '$part', output: {total: "
+                       "{$sum: '$x', window: {documents: ['unbounded', 0]}}}}}")));
+}
+
+TEST_F(SetWindowFieldsTest, ShouldRejectInvalidSpecifications) {
+    auto parse = [&](const char* json) {
+        return DocumentSourceSetWindowFields::createFromBson(fromjson(json).firstElement(),
+                                                             getExpCtx());
+    };
+
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: 1}"), AssertionException, 4031711);
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: {partitionBy: {$add: ['$a', 1]}, output: "
+                             "{total: {$sum: '$x'}}}}"),
+                       AssertionException,
+                       4031712);
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: {sortBy: {x: 1}}}"), AssertionException, 4031715);
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: {output: {total: {$push: '$x'}}}}"),
+                       AssertionException,
+                       4031720);
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: {output: {total: {$sum: '$x', $max: '$x'}}}}"),
+                       AssertionException,
+                       4031721);
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: {output: {total: {$sum: '$x', window: "
+                             "{documents: [1, -1]}}}}}"),
+                       AssertionException,
+                       4031719);
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: {output: {total: {$sum: '$x', window: "
+                             "{documents: [0.5, 1]}}}}}"),
+                       AssertionException,
+                       4031710);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -36,6 +36,7 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/storage/recovery_unit.h"
 
@@ -183,6 +184,12 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
         _initialized = true;
     }
 
+    // Batches are handed to the process interface as in-memory write ops, which split them into
+    // commands within the BSON and write batch size limits wherever they are sent over the wire.
+    // Larger batches reduce the number of synchronous round trips to the targeted shards.
+    const int maxBatchBytes = internalQueryDocumentSourceWriterBatchMaxBytes.load();
+    const size_t maxBatchCount = internalQueryDocumentSourceWriterBatchMaxCount.load();
+
     BatchedObjects batch;
     int bufferedBytes = 0;
 
@@ -195,7 +202,7 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
 
         bufferedBytes += objSize;
         if (!batch.empty() &&
-            (bufferedBytes > BSONObjMaxUserSize || batch.size() >= write_ops::kMaxWriteBatchSize)) {
+            (bufferedBytes > maxBatchBytes || batch.size() >= maxBatchCount)) {
             spill(std::move(batch));
             batch.clear();
             bufferedBytes = objSize;
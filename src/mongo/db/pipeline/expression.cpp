@@ -47,6 +47,7 @@
 #include "mongo/db/query/datetime/date_time_support.h"
 #include "mongo/platform/bits.h"
 #include "mongo/platform/decimal128.h"
+#include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/util/regex_util.h"
 #include "mongo/util/str.h"
 #include "mongo/util/string_map.h"
@@ -276,10 +277,29 @@ Value ExpressionAdd::evaluate(const Document& root, Variables* variables) const
     BSONType totalType = NumberInt;
     bool haveDate = false;
 
+    // Sums of 32- and 64-bit integers are by far the most common, so add them with plain integer
+    // arithmetic until a value of another type or an overflow requires the compensated sum.
+    long long integralTotal = 0;
+    bool integralOnly = true;
+
     const size_t n = _children.size();
     for (size_t i = 0; i < n; ++i) {
         Value val = _children[i]->evaluate(root, variables);
 
+        if (integralOnly) {
+            const BSONType type = val.getType();
+            long long newTotal;
+            if ((type == NumberInt || type == NumberLong) &&
+                !overflow::add(integralTotal, val.getLong(), &newTotal)) {
+                integralTotal = newTotal;
+                if (type == NumberLong)
+                    totalType = NumberLong;
+                continue;
+            }
+            integralOnly = false;
+            nonDecimalTotal.addLong(integralTotal);
+        }
+
         switch (val.getType()) {
             case NumberDecimal:
                 decimalTotal = decimalTotal.add(val.getDecimal());
@@ -322,6 +342,10 @@ Value ExpressionAdd::evaluate(const Document& root, Variables* variables) const
         }
         return Value(Date_t::fromMillisSinceEpoch(longTotal));
     }
+    if (integralOnly) {
+        return totalType == NumberLong ? Value(integralTotal)
+                                       : Value::createIntOrLong(integralTotal);
+    }
     switch (totalType) {
         case NumberDecimal:
             return Value(decimalTotal.add(nonDecimalTotal.getDecimal()));
@@ -1750,6 +1774,17 @@ intrusive_ptr<Expression> ExpressionDateToString::optimize() {
 
     if (_format) {
         _format = _format->optimize();
+        if (auto constFormat = dynamic_cast<ExpressionConstant*>(_format.get())) {
+            // An invalid format is left to fail when a document is evaluated, as it would if it
+            // wasn't constant.
+            const auto& formatValue = constFormat->getValue();
+            if (formatValue.getType() == BSONType::String) {
+                auto parsed = DateToStringFormat::parse(formatValue.getStringData());
+                if (parsed.isOK()) {
+                    _parsedFormat = std::move(parsed.getValue());
+                }
+            }
+        }
     }
 
     if (ExpressionConstant::allNullOrConstant({_date, _format, _timeZone, _onNull})) {
@@ -1775,8 +1810,8 @@ Value ExpressionDateToString::evaluate(const Document& root, Variables* variable
     Value formatValue;
 
     // Eagerly validate the format parameter, ignoring if nullish since the input date nullish
-    // behavior takes precedence.
-    if (_format) {
+    // behavior takes precedence. A constant format was validated by optimize().
+    if (_format && !_parsedFormat) {
         formatValue = _format->evaluate(root, variables);
         if (!formatValue.nullish()) {
             uassert(18533,
@@ -1802,6 +1837,10 @@ Value ExpressionDateToString::evaluate(const Document& root, Variables* variable
         return Value(BSONNULL);
     }
 
+    if (_parsedFormat) {
+        return Value(timeZone->formatDate(*_parsedFormat, date.coerceToDate()));
+    }
+
     if (_format) {
         if (formatValue.nullish()) {
             return Value(BSONNULL);
@@ -1810,7 +1849,9 @@ Value ExpressionDateToString::evaluate(const Document& root, Variables* variable
         return Value(timeZone->formatDate(formatValue.getStringData(), date.coerceToDate()));
     }
 
-    return Value(timeZone->formatDate(Value::kISOFormatString, date.coerceToDate()));
+    static const auto isoFormat =
+        uassertStatusOK(DateToStringFormat::parse(Value::kISOFormatString));
+    return Value(timeZone->formatDate(isoFormat, date.coerceToDate()));
 }
 
 void ExpressionDateToString::_doAddDependencies(DepsTracker* deps) const {
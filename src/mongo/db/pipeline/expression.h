@@ -409,14 +409,12 @@ public:
     Value evaluate(const Document& root, Variables* variables) const final {
         Accumulator accum(this->getExpressionContext());
         const auto n = this->_children.size();
-        // If a single array arg is given, loop through it passing each member to the accumulator.
+        // If a single array arg is given, pass its members to the accumulator as one batch.
         // If a single, non-array arg is given, pass it directly to the accumulator.
         if (n == 1) {
             Value singleVal = this->_children[0]->evaluate(root, variables);
             if (singleVal.getType() == Array) {
-                for (const Value& val : singleVal.getArray()) {
-                    accum.process(val, false);
-                }
+                accum.processBatch(singleVal.getArray(), false);
             } else {
                 accum.process(singleVal, false);
             }
@@ -1210,6 +1208,10 @@ private:
     boost::intrusive_ptr<Expression>& _date;
     boost::intrusive_ptr<Expression>& _timeZone;
     boost::intrusive_ptr<Expression>& _onNull;
+
+    // Set by optimize() when '_format' is a constant, valid format string, so that it isn't
+    // validated and parsed again for every document.
+    boost::optional<DateToStringFormat> _parsedFormat;
 };
 
 class ExpressionDayOfMonth final : public DateExpressionAcceptingTimeZone<ExpressionDayOfMonth> {
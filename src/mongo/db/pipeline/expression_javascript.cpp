@@ -64,6 +64,7 @@ ExpressionInternalJsEmit::ExpressionInternalJsEmit(
     : Expression(expCtx, {std::move(thisRef)}),
       _thisRef(_children[0]),
       _funcSource(std::move(funcSource)),
+      _funcKey(Scope::makeFunctionCacheKey(_funcSource)),
       _byteLimit(internalQueryMaxJsEmitBytes.load()) {}
 
 void ExpressionInternalJsEmit::_doAddDependencies(mongo::DepsTracker* deps) const {
@@ -119,10 +120,10 @@ Value ExpressionInternalJsEmit::evaluate(const Document& root, Variables* variab
     auto expCtx = getExpressionContext();
     auto jsExec = expCtx->getJsExecWithScope();
 
-    // Although inefficient to "create" a new function every time we evaluate, this will usually end
-    // up being a simple cache lookup. This is needed because the JS Scope may have been recreated
-    // on a new thread if the expression is evaluated across getMores.
-    auto func = jsExec->getScope()->createFunction(_funcSource.c_str());
+    // The function is "created" every time we evaluate because the JS Scope may have been
+    // recreated on a new thread if the expression is evaluated across getMores. Since '_funcKey' is
+    // hashed up front, this is usually a single probe of the scope's function cache.
+    auto func = jsExec->getScope()->createFunction(_funcKey);
     uassert(31226, "The map function failed to parse in the javascript engine", func);
 
     // For a given invocation of the user-defined function, this vector holds the results of each
@@ -154,7 +155,8 @@ ExpressionInternalJs::ExpressionInternalJs(const boost::intrusive_ptr<Expression
                                            std::string funcSource)
     : Expression(expCtx, {std::move(passedArgs)}),
       _passedArgs(_children[0]),
-      _funcSource(std::move(funcSource)) {}
+      _funcSource(std::move(funcSource)),
+      _funcKey(Scope::makeFunctionCacheKey(_funcSource)) {}
 
 Value ExpressionInternalJs::serialize(bool explain) const {
     return Value(
@@ -203,7 +205,7 @@ Value ExpressionInternalJs::evaluate(const Document& root, Variables* variables)
 
     auto jsExec = expCtx->getJsExecWithScope();
 
-    ScriptingFunction func = jsExec->getScope()->createFunction(_funcSource.c_str());
+    ScriptingFunction func = jsExec->getScope()->createFunction(_funcKey);
     uassert(31265, "The eval function did not evaluate", func);
 
     auto argExpressions = _passedArgs->evaluate(root, variables);
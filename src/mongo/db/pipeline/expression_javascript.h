@@ -74,6 +74,9 @@ private:
     const boost::intrusive_ptr<Expression>& _thisRef;
     std::string _funcSource;
 
+    // Looks up the function compiled from '_funcSource' in the JS scope.
+    StringMapHashedKey _funcKey;
+
     static constexpr auto kExpressionName = "$_internalJsEmit"_sd;
 
     size_t _byteLimit;
@@ -115,5 +118,8 @@ private:
 
     const boost::intrusive_ptr<Expression>& _passedArgs;
     std::string _funcSource;
+
+    // Looks up the function compiled from '_funcSource' in the JS scope.
+    StringMapHashedKey _funcKey;
 };
 }  // namespace mongo
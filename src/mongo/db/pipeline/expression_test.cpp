@@ -1649,6 +1649,20 @@ class LongUndefined : public TwoOperandBase {
     }
 };
 
+/** An intermediate overflow of the integer sum does not lose precision in the result. */
+class LongOverflowThenBackInRange : public ExpectedResultBase {
+    void populateOperands(intrusive_ptr<ExpressionNary>& expression) {
+        intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+        expression->addOperand(
+            ExpressionConstant::create(expCtx, Value(numeric_limits<long long>::max())));
+        expression->addOperand(ExpressionConstant::create(expCtx, Value(1)));
+        expression->addOperand(ExpressionConstant::create(expCtx, Value(-1)));
+    }
+    BSONObj expectedResult() {
+        return BSON("" << numeric_limits<long long>::max());
+    }
+};
+
 }  // namespace Add
 
 namespace And {
@@ -6379,6 +6393,7 @@ public:
         add<Add::LongDoubleNoOverflow>();
         add<Add::IntNull>();
         add<Add::LongUndefined>();
+        add<Add::LongOverflowThenBackInRange>();
 
         add<And::NoOperands>();
         add<And::True>();
@@ -204,6 +204,14 @@ public:
                                         const NamespaceString& nss,
                                         BSONObjBuilder* builder) const = 0;
 
+    /**
+     * Appends a summary of how much of the collection 'nss' and of its indexes is resident in the
+     * storage engine's cache to 'builder'.
+     */
+    virtual Status appendCacheStats(OperationContext* opCtx,
+                                    const NamespaceString& nss,
+                                    BSONObjBuilder* builder) const = 0;
+
     /**
      * Gets the collection options for the collection given by 'nss'. Throws
      * ErrorCodes::CommandNotSupportedOnView if 'nss' describes a view. Future callers may want to
@@ -358,6 +366,12 @@ public:
                                                                 const NamespaceString&,
                                                                 const MatchExpression*) const = 0;
 
+    /**
+     * Returns a vector of BSON objects, where each entry describes the execution statistics that
+     * this node has accumulated for one query shape.
+     */
+    virtual std::vector<BSONObj> getQueryStats(OperationContext*) const = 0;
+
     /**
      * Returns true if there is an index on 'nss' with properties that will guarantee that a
      * document with non-array values for each of 'fieldPaths' will have at most one matching
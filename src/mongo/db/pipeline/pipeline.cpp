@@ -39,6 +39,7 @@
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/operation_trace.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_geo_near.h"
@@ -52,6 +53,7 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/str.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -336,6 +338,10 @@ void Pipeline::reattachToOperationContext(OperationContext* opCtx) {
 }
 
 void Pipeline::dispose(OperationContext* opCtx) {
+    if (opCtx && OperationTrace::get(opCtx).isActive()) {
+        _addStageSpans(&OperationTrace::get(opCtx));
+    }
+
     try {
         pCtx->opCtx = opCtx;
 
@@ -352,6 +358,26 @@ void Pipeline::dispose(OperationContext* opCtx) {
     }
 }
 
+void Pipeline::_addStageSpans(OperationTrace* trace) const {
+    // Each stage pulls from the stage before it, so a stage's execution time includes that of
+    // every stage ahead of it in the pipeline. The spans are nested accordingly, with the last
+    // stage outermost. A stage only accumulates its execution time, in milliseconds, so each span
+    // is recorded at the time of disposal and carries that time as an attribute.
+    const auto disposeMicros = static_cast<long long>(curTimeMicros64());
+    boost::optional<uint64_t> parentSpanId;
+    for (auto it = _sources.rbegin(); it != _sources.rend(); ++it) {
+        const auto& stats = (*it)->getCommonStats();
+        parentSpanId = trace->addCompletedSpan(
+            str::stream() << "stage:" << (*it)->getSourceName(),
+            disposeMicros,
+            disposeMicros,
+            BSON("executionTimeMillis" << stats.executionTimeMillis << "works"
+                                       << static_cast<long long>(stats.works) << "advanced"
+                                       << static_cast<long long>(stats.advanced)),
+            parentSpanId);
+    }
+}
+
 bool Pipeline::usedDisk() {
     return std::any_of(
         _sources.begin(), _sources.end(), [](const auto& stage) { return stage->usedDisk(); });
@@ -54,6 +54,7 @@ class CollatorInterface;
 class DocumentSource;
 class ExpressionContext;
 class OperationContext;
+class OperationTrace;
 class PipelineDeleter;
 
 /**
@@ -344,6 +345,11 @@ private:
      */
     void unstitch();
 
+    /**
+     * Records a span for each stage of the pipeline in the trace of the operation disposing it.
+     */
+    void _addStageSpans(OperationTrace* trace) const;
+
     /**
      * Throws if the pipeline fails any of a set of semantic checks. For example, if an $out stage
      * is present then it must come last in the pipeline, while initial stages such as $indexStats
@@ -45,12 +45,17 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/collection_scan.h"
 #include "mongo/db/exec/fetch.h"
+#include "mongo/db/exec/group_count_scan.h"
 #include "mongo/db/exec/multi_iterator.h"
+#include "mongo/db/exec/multi_plan.h"
+#include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/exec/queued_data_stage.h"
 #include "mongo/db/exec/shard_filter.h"
 #include "mongo/db/exec/trial_stage.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index_names.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/ops/write_ops_exec.h"
@@ -71,6 +76,7 @@
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -126,7 +132,11 @@ bool canSortBePushedDown(const SortPattern& sortPattern) {
  * percentage of the collection.
  */
 StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> createRandomCursorExecutor(
-    Collection* coll, OperationContext* opCtx, long long sampleSize, long long numRecords) {
+    Collection* coll,
+    OperationContext* opCtx,
+    long long sampleSize,
+    long long numRecords,
+    bool blockSampling) {
     // Verify that we are already under a collection lock. We avoid taking locks ourselves in this
     // function because double-locking forces any PlanExecutor we create to adopt a NO_YIELD policy.
     invariant(opCtx->lockState()->isCollectionLockedForMode(coll->ns(), MODE_IS));
@@ -137,7 +147,9 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> createRandomCursorEx
     }
 
     // Attempt to get a random cursor from the RecordStore.
-    auto rsRandCursor = coll->getRecordStore()->getRandomCursor(opCtx);
+    auto rsRandCursor = blockSampling
+        ? coll->getRecordStore()->getBlockSamplingCursor(opCtx, sampleSize)
+        : coll->getRecordStore()->getRandomCursor(opCtx);
     if (!rsRandCursor) {
         // The storage engine has no random cursor support.
         return {nullptr};
@@ -268,6 +280,74 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
         expCtx->opCtx, collection, std::move(cq.getValue()), permitYield, plannerOpts);
 }
 
+/**
+ * Returns a PlanExecutor which answers the $group beginning 'pipeline' with a GROUP_COUNT_SCAN over
+ * an index whose leading field is the grouped field, or nullptr if this isn't possible. The $group
+ * must read every document of the collection, count the documents of each group and compare group
+ * keys without a collation. The index must hold exactly one key per document with the value the
+ * $group would see. Documents missing the field have a null key, and $group also puts them in the
+ * null group.
+ */
+std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> attemptToGetGroupCountScanExecutor(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    Collection* collection,
+    Pipeline* pipeline,
+    const BSONObj& queryObj,
+    const AggregationRequest* aggRequest) {
+    auto groupStage = dynamic_cast<DocumentSourceGroup*>(pipeline->peekFront());
+    if (!collection || !groupStage || !queryObj.isEmpty() || expCtx->getCollator() ||
+        expCtx->tailableMode != TailableModeEnum::kNormal ||
+        (aggRequest && !aggRequest->getHint().isEmpty()) ||
+        !internalDocumentSourceGroupAllowCountScan.load()) {
+        return nullptr;
+    }
+
+    auto grouping = groupStage->getCountOnlyGrouping();
+    if (!grouping) {
+        return nullptr;
+    }
+
+    // Index keys are not filtered by shard ownership, so orphaned documents would be counted.
+    auto opCtx = expCtx->opCtx;
+    if (CollectionShardingState::get(opCtx, collection->ns())
+            ->getOrphansFilter(opCtx, collection)
+            ->isSharded()) {
+        return nullptr;
+    }
+
+    // Among the suitable indexes, prefer the one with the fewest fields, whose keys are cheapest
+    // to read.
+    const IndexDescriptor* bestIndex = nullptr;
+    auto ii = collection->getIndexCatalog()->getIndexIterator(opCtx, false);
+    while (ii->more()) {
+        const IndexDescriptor* desc = ii->next()->descriptor();
+        if (desc->getAccessMethodName() != IndexNames::BTREE ||
+            desc->keyPattern().firstElementFieldNameStringData() != grouping->groupId ||
+            desc->isMultikey() || desc->isSparse() || desc->isPartial() ||
+            !desc->infoObj().getObjectField(IndexDescriptor::kCollationFieldName).isEmpty()) {
+            continue;
+        }
+        if (!bestIndex || desc->getNumFields() < bestIndex->getNumFields()) {
+            bestIndex = desc;
+        }
+    }
+    if (!bestIndex) {
+        return nullptr;
+    }
+
+    auto ws = std::make_unique<WorkingSet>();
+    auto root = std::make_unique<GroupCountScan>(
+        opCtx,
+        GroupCountScanParams(bestIndex, "_id", std::move(grouping->countFields)),
+        ws.get());
+    auto exec = uassertStatusOK(PlanExecutor::make(
+        opCtx, std::move(ws), std::move(root), collection, PlanExecutor::YIELD_AUTO));
+
+    // The executor produces the output of the $group.
+    pipeline->popFrontWithName(DocumentSourceGroup::kStageName);
+    return exec;
+}
+
 /**
  * Examines the indexes in 'collection' and returns the field name of a geo-indexed field suitable
  * for use in $geoNear. 2d indexes are given priority over 2dsphere indexes.
@@ -336,8 +416,9 @@ PipelineD::buildInnerQueryExecutor(Collection* collection,
         if (collection && sampleStage) {
             const long long sampleSize = sampleStage->getSampleSize();
             const long long numRecords = collection->getRecordStore()->numRecords(expCtx->opCtx);
-            auto exec = uassertStatusOK(
-                createRandomCursorExecutor(collection, expCtx->opCtx, sampleSize, numRecords));
+            const bool blockSampling = internalQueryUseBlockSamplingForSample.load();
+            auto exec = uassertStatusOK(createRandomCursorExecutor(
+                collection, expCtx->opCtx, sampleSize, numRecords, blockSampling));
             if (exec) {
                 // For sharded collections, the root of the plan tree is a TrialStage that may have
                 // chosen either a random-sampling cursor trial plan or a COLLSCAN backup plan. We
@@ -350,7 +431,7 @@ PipelineD::buildInnerQueryExecutor(Collection* collection,
                     pipeline->popFront();
                     std::string idString = collection->ns().isOplog() ? "ts" : "_id";
                     pipeline->addInitialSource(DocumentSourceSampleFromRandomCursor::create(
-                        expCtx, sampleSize, idString, numRecords));
+                        expCtx, sampleSize, idString, numRecords, blockSampling));
                 }
 
                 // The order in which we evaluate these arguments is significant. We'd like to be
@@ -448,6 +529,35 @@ getSortAndGroupStagesFromPipeline(const Pipeline::SourceContainer& sources) {
     return std::make_pair(sortStage, groupStage);
 }
 
+/**
+ * Returns true if the plan rooted at 'root' returns documents in the order requested from the query
+ * layer without a blocking sort, through scans of indexes which are not multikey. The documents are
+ * then ordered by the values of the sorted fields themselves, which can't be arrays whose elements
+ * would interleave the documents holding them with those holding the elements as scalars.
+ */
+bool sortIsProvidedByNonMultikeyIndexes(const PlanStage* root) {
+    switch (root->stageType()) {
+        case STAGE_MULTI_PLAN: {
+            // Only the winning plan of a MultiPlanStage produces results.
+            auto mps = static_cast<const MultiPlanStage*>(root);
+            return sortIsProvidedByNonMultikeyIndexes(
+                mps->getChildren()[mps->bestPlanIdx()].get());
+        }
+        case STAGE_COLLSCAN:
+        case STAGE_SORT:
+            return false;
+        case STAGE_IXSCAN:
+            return !static_cast<const IndexScanStats*>(root->getSpecificStats())->isMultiKey;
+        default:
+            break;
+    }
+
+    const auto& children = root->getChildren();
+    return std::all_of(children.begin(), children.end(), [](const auto& child) {
+        return sortIsProvidedByNonMultikeyIndexes(child.get());
+    });
+}
+
 boost::optional<long long> extractLimitForPushdown(Pipeline* pipeline) {
     auto&& sources = pipeline->getSources();
     auto limit = DocumentSourceSort::extractLimitForPushdown(sources.begin(), &sources);
@@ -536,6 +646,15 @@ PipelineD::buildInnerQueryExecutorGeneric(Collection* collection,
                                                 &shouldProduceEmptyDocs));
 
 
+    // If the $sort before the $group was pushed down and the query layer produces its order from
+    // indexes, the documents of each group are adjacent and the $group can return every group as
+    // soon as it has read the group's last document.
+    if (sortStage && groupStage && !sources.empty() && sources.front() == groupStage &&
+        groupStage->canStreamOnInputSortedBy(sortStage->getSortKeyPattern()) &&
+        sortIsProvidedByNonMultikeyIndexes(exec->getRootStage())) {
+        groupStage->setStreaming(true);
+    }
+
     if (!projForQuery.isEmpty() && !sources.empty()) {
         // Check for redundant $project in query with the same specification as the inclusion
         // projection generated by the dependency optimization.
@@ -552,16 +671,33 @@ PipelineD::buildInnerQueryExecutorGeneric(Collection* collection,
         }
     }
 
+    // If the query layer returns whole documents but the remaining stages only depend on some of
+    // their fields, have the cursor stage keep just the top-level fields which are needed.
+    boost::optional<StringSet> fieldsToProduce;
+    if (projForQuery.isEmpty() && !shouldProduceEmptyDocs) {
+        auto deps = pipeline->getDependencies(metadataAvailable);
+        if (!deps.needWholeDocument && !deps.fields.empty()) {
+            fieldsToProduce.emplace();
+            for (auto&& field : deps.fields) {
+                auto topLevelField = FieldPath::extractFirstFieldFromDottedPath(field);
+                fieldsToProduce->insert(topLevelField.toString());
+            }
+        }
+    }
+
     // If this is a change stream pipeline, make sure that we tell DSCursor to track the oplog time.
     const bool trackOplogTS =
         (pipeline->peekFront() && pipeline->peekFront()->constraints().isChangeStreamStage());
 
-    auto attachExecutorCallback = [shouldProduceEmptyDocs, trackOplogTS](
+    auto attachExecutorCallback = [shouldProduceEmptyDocs, fieldsToProduce, trackOplogTS](
                                       Collection* collection,
                                       std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec,
                                       Pipeline* pipeline) {
         auto cursor = DocumentSourceCursor::create(
             collection, std::move(exec), pipeline->getContext(), trackOplogTS);
+        if (fieldsToProduce) {
+            cursor->shouldProduceOnlyFields(*fieldsToProduce);
+        }
         addCursorSource(pipeline, std::move(cursor), shouldProduceEmptyDocs);
     };
     return std::make_pair(std::move(attachExecutorCallback), std::move(exec));
@@ -744,6 +880,18 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
         }
     }
 
+    // See if the query system can answer a $group which only counts the documents of each group
+    // from the keys of an index, without reading the documents. This is only considered when no
+    // $sort or $limit was pushed down, since the $group must then be at the front of the pipeline.
+    if (sortObj.isEmpty() && !limit) {
+        if (auto groupCountScanExec = attemptToGetGroupCountScanExecutor(
+                expCtx, collection, pipeline, queryObj, aggRequest)) {
+            *projectionObj = BSONObj();
+            *hasNoRequirements = false;
+            return std::move(groupCountScanExec);
+        }
+    }
+
     // Unlike stages such as $match and limit which always get pushed down into the inner
     // PlanExecutor when present at the front of the pipeline, 'projectionObj' may not always be
     // pushed down. (Note that 'projectionObj' is generated based on the dependency set, and
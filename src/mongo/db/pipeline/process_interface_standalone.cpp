@@ -56,6 +56,7 @@
 #include "mongo/db/session_catalog.h"
 #include "mongo/db/session_catalog_mongod.h"
 #include "mongo/db/stats/fill_locker_info.h"
+#include "mongo/db/stats/query_stats_store.h"
 #include "mongo/db/stats/storage_stats.h"
 #include "mongo/db/storage/backup_cursor_hooks.h"
 #include "mongo/db/transaction_history_iterator.h"
@@ -323,6 +324,12 @@ Status MongoInterfaceStandalone::appendQueryExecStats(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status MongoInterfaceStandalone::appendCacheStats(OperationContext* opCtx,
+                                                  const NamespaceString& nss,
+                                                  BSONObjBuilder* builder) const {
+    return appendCollectionCacheStats(opCtx, nss, builder);
+}
+
 BSONObj MongoInterfaceStandalone::getCollectionOptions(const NamespaceString& nss) {
     std::list<BSONObj> infos;
 
@@ -549,6 +556,10 @@ std::vector<BSONObj> MongoInterfaceStandalone::getMatchingPlanCacheEntryStats(
     return planCache->getMatchingStats(serializer, predicate);
 }
 
+std::vector<BSONObj> MongoInterfaceStandalone::getQueryStats(OperationContext* opCtx) const {
+    return QueryStatsStore::get(opCtx->getServiceContext()).getStats();
+}
+
 bool MongoInterfaceStandalone::fieldsHaveSupportingUniqueIndex(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     const NamespaceString& nss,
@@ -314,6 +314,9 @@ Status appendExplainResults(sharded_agg_helpers::DispatchShardPipelineResults&&
             BSONObjBuilder bob;
             dispatchResults.exchangeSpec->exchangeSpec.serialize(&bob);
             bob.append("consumerShards", dispatchResults.exchangeSpec->consumerShards);
+            if (auto numConsumerStages = dispatchResults.exchangeSpec->numConsumerStages) {
+                bob.append("numConsumerStages", static_cast<long long>(*numConsumerStages));
+            }
             pipelinesDoc.addField("exchange", Value(bob.obj()));
         }
         pipelinesDoc.addField("mergerPart",
@@ -413,6 +416,15 @@ sharded_agg_helpers::DispatchShardPipelineResults dispatchExchangeConsumerPipeli
     std::vector<std::pair<ShardId, BSONObj>> requests;
     auto numConsumers = shardDispatchResults->exchangeSpec->consumerShards.size();
     std::vector<SplitPipeline> consumerPipelines;
+
+    // The consumers run the leading stages of the merging pipeline, and the rest of it merges their
+    // results.
+    const auto& mergeStages = shardDispatchResults->splitPipeline->mergePipeline->getSources();
+    const auto numConsumerStages = shardDispatchResults->exchangeSpec->numConsumerStages;
+    const auto consumerStagesEnd = numConsumerStages
+        ? std::next(mergeStages.begin(), *numConsumerStages)
+        : mergeStages.end();
+
     for (size_t idx = 0; idx < numConsumers; ++idx) {
         // Pick this consumer's cursors from producers.
         std::vector<OwnedRemoteCursor> producers;
@@ -422,8 +434,8 @@ sharded_agg_helpers::DispatchShardPipelineResults dispatchExchangeConsumerPipeli
         }
 
         // Create a pipeline for a consumer and add the merging stage.
-        auto consumerPipeline = uassertStatusOK(Pipeline::create(
-            shardDispatchResults->splitPipeline->mergePipeline->getSources(), expCtx));
+        auto consumerPipeline = uassertStatusOK(
+            Pipeline::create({mergeStages.begin(), consumerStagesEnd}, expCtx));
 
         cluster_aggregation_planner::addMergeCursorsSource(
             consumerPipeline.get(),
@@ -455,9 +467,10 @@ sharded_agg_helpers::DispatchShardPipelineResults dispatchExchangeConsumerPipeli
         ownedCursors.emplace_back(OwnedRemoteCursor(opCtx, std::move(cursor), executionNss));
     }
 
-    // The merging pipeline is just a union of the results from each of the shards involved on the
-    // consumer side of the exchange.
-    auto mergePipeline = uassertStatusOK(Pipeline::create({}, expCtx));
+    // The merging pipeline is the union of the results from each of the shards involved on the
+    // consumer side of the exchange, followed by the stages the consumers didn't run.
+    auto mergePipeline =
+        uassertStatusOK(Pipeline::create({consumerStagesEnd, mergeStages.end()}, expCtx));
     mergePipeline->setSplitState(Pipeline::SplitState::kSplitForMerge);
 
     SplitPipeline splitPipeline{nullptr, std::move(mergePipeline), boost::none};
@@ -478,6 +491,77 @@ sharded_agg_helpers::DispatchShardPipelineResults dispatchExchangeConsumerPipeli
                                                              numConsumers};
 }
 
+/**
+ * Hands the shards' cursors in 'shardDispatchResults' over to intermediate shards in groups of at
+ * most 'policy.fanIn', each running the partial merge stages of 'policy' over its group, and
+ * replaces them with the cursors of the intermediate shards. This repeats until at most
+ * 'policy.fanIn' cursors are left for the merging pipeline.
+ */
+void dispatchPartialMergePipelines(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& executionNss,
+    Document serializedCommand,
+    const cluster_aggregation_planner::PartialMergePolicy& policy,
+    sharded_agg_helpers::DispatchShardPipelineResults* shardDispatchResults) {
+    auto opCtx = expCtx->opCtx;
+    auto& remoteCursors = shardDispatchResults->remoteCursors;
+
+    while (remoteCursors.size() > policy.fanIn) {
+        // Each group of cursors is merged on the shard of its first cursor, which then only has to
+        // fetch the results of the others.
+        std::vector<std::pair<ShardId, BSONObj>> requests;
+        std::vector<SplitPipeline> partialMergePipelines;
+        for (size_t begin = 0; begin < remoteCursors.size(); begin += policy.fanIn) {
+            const size_t end = std::min(begin + policy.fanIn, remoteCursors.size());
+            std::vector<OwnedRemoteCursor> cursors(
+                std::make_move_iterator(remoteCursors.begin() + begin),
+                std::make_move_iterator(remoteCursors.begin() + end));
+            const ShardId shardId = cursors.front()->getShardId().toString();
+
+            auto partialMergePipeline = uassertStatusOK(Pipeline::parse(policy.stages, expCtx));
+            cluster_aggregation_planner::addMergeCursorsSource(
+                partialMergePipeline.get(),
+                BSONObj(),
+                std::move(cursors),
+                {},
+                boost::none,
+                Grid::get(opCtx)->getExecutorPool()->getArbitraryExecutor(),
+                false);
+
+            partialMergePipelines.emplace_back(
+                std::move(partialMergePipeline), nullptr, boost::none);
+            requests.emplace_back(shardId,
+                                  createCommandForTargetedShards(expCtx,
+                                                                 serializedCommand,
+                                                                 partialMergePipelines.back(),
+                                                                 boost::none,
+                                                                 true));
+        }
+
+        LOG(1) << "Dispatching partial merges of " << remoteCursors.size() << " cursors to "
+               << requests.size() << " shards";
+
+        auto cursors = establishCursors(opCtx,
+                                        Grid::get(opCtx)->getExecutorPool()->getArbitraryExecutor(),
+                                        executionNss,
+                                        ReadPreferenceSetting::get(opCtx),
+                                        requests,
+                                        false /* do not allow partial results */);
+
+        // The intermediate shards are now responsible for the cursors they merge.
+        for (const auto& pipeline : partialMergePipelines) {
+            const auto& mergeCursors =
+                static_cast<DocumentSourceMergeCursors*>(pipeline.shardsPipeline->peekFront());
+            mergeCursors->dismissCursorOwnership();
+        }
+
+        remoteCursors.clear();
+        for (auto&& cursor : cursors) {
+            remoteCursors.emplace_back(opCtx, std::move(cursor), executionNss);
+        }
+    }
+}
+
 BSONObj createCommandForMergingShard(Document serializedCommand,
                                      const boost::intrusive_ptr<ExpressionContext>& mergeCtx,
                                      const ShardId& shardId,
@@ -594,6 +678,10 @@ DispatchShardPipelineResults dispatchShardPipeline(
 
         exchangeSpec = cluster_aggregation_planner::checkIfEligibleForExchange(
             opCtx, splitPipeline->mergePipeline.get());
+        if (!exchangeSpec) {
+            exchangeSpec = cluster_aggregation_planner::checkIfEligibleForGroupExchange(
+                opCtx, *splitPipeline, shardIds);
+        }
     }
 
     // Generate the command object for the targeted shards.
@@ -1218,10 +1306,21 @@ Status dispatchPipelineAndMerge(OperationContext* opCtx,
         return appendCursorResponseToCommandResult(shardId, reply, result);
     }
 
-    // If we have the exchange spec then dispatch all consumers.
+    // If we have the exchange spec then dispatch all consumers. Otherwise, if there are too many
+    // cursors to merge in one place, combine them on the shards first.
     if (shardDispatchResults.exchangeSpec) {
         shardDispatchResults = dispatchExchangeConsumerPipeline(
             expCtx, namespaces.executionNss, serializedCommand, &shardDispatchResults);
+    } else if (auto partialMergePolicy =
+                   cluster_aggregation_planner::checkIfEligibleForPartialMerge(
+                       opCtx,
+                       *shardDispatchResults.splitPipeline,
+                       shardDispatchResults.remoteCursors.size())) {
+        dispatchPartialMergePipelines(expCtx,
+                                      namespaces.executionNss,
+                                      serializedCommand,
+                                      *partialMergePolicy,
+                                      &shardDispatchResults);
     }
 
     // If we reach here, we have a merge pipeline to dispatch.
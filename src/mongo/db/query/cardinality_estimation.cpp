@@ -0,0 +1,181 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/cardinality_estimation.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/query/query_knobs_gen.h"
+
+namespace mongo {
+namespace cardinality_estimation {
+namespace {
+
+const long long kMaxEstimate = std::numeric_limits<long long>::max();
+
+long long saturatingAdd(long long lhs, long long rhs) {
+    return lhs > kMaxEstimate - rhs ? kMaxEstimate : lhs + rhs;
+}
+
+long long saturatingMultiply(long long lhs, long long rhs) {
+    if (lhs == 0 || rhs == 0) {
+        return 0;
+    }
+    return lhs > kMaxEstimate / rhs ? kMaxEstimate : lhs * rhs;
+}
+
+boost::optional<long long> estimatePointScan(const IndexScanNode* node) {
+    const auto& bounds = node->bounds;
+    if (!node->index.unique ||
+        bounds.fields.size() != static_cast<size_t>(node->index.keyPattern.nFields())) {
+        return boost::none;
+    }
+
+    long long numPoints = 1;
+    for (auto&& oil : bounds.fields) {
+        for (auto&& interval : oil.intervals) {
+            if (!interval.isPoint()) {
+                return boost::none;
+            }
+        }
+        numPoints = saturatingMultiply(numPoints, oil.intervals.size());
+    }
+    return numPoints;
+}
+
+boost::optional<long long> estimateIndexScan(const IndexScanNode* node,
+                                             long long numRecords,
+                                             const IndexStatisticsMap* indexStats) {
+    const auto& bounds = node->bounds;
+    if (bounds.isSimpleRange || bounds.fields.empty()) {
+        return boost::none;
+    }
+
+    if (auto numPoints = estimatePointScan(node)) {
+        return numPoints;
+    }
+
+    if (!indexStats) {
+        return boost::none;
+    }
+
+    // Statistics are only gathered for simple-collation indexes, and the index may have been
+    // rebuilt under the same name since they were.
+    auto it = indexStats->find(node->index.identifier.catalogName);
+    if (it == indexStats->end() || node->index.collator ||
+        SimpleBSONObjComparator::kInstance.evaluate(it->second.keyPattern !=
+                                                    node->index.keyPattern)) {
+        return boost::none;
+    }
+
+    // A sampled estimate only stands in for multi-planning when the sample is large enough, and
+    // then only as an upper confidence bound on the number of matching documents.
+    const auto& stats = it->second;
+    if (stats.numSampledDocs < internalQueryStatisticsMinSampledDocs.load()) {
+        return boost::none;
+    }
+    return stats.estimateDocsUpperBound(
+        bounds.fields[0], numRecords, internalQueryStatisticsConfidenceStdDevs.load());
+}
+
+}  // namespace
+
+boost::optional<long long> estimateDocsExamined(const QuerySolutionNode* node,
+                                                long long numRecords,
+                                                const IndexStatisticsMap* indexStats) {
+    switch (node->getType()) {
+        case STAGE_COLLSCAN:
+            return numRecords;
+        case STAGE_IXSCAN:
+            return estimateIndexScan(
+                static_cast<const IndexScanNode*>(node), numRecords, indexStats);
+        case STAGE_EOF:
+            return 0LL;
+        case STAGE_LIMIT: {
+            auto childEstimate = estimateDocsExamined(node->children[0], numRecords, indexStats);
+            if (!childEstimate) {
+                return boost::none;
+            }
+            return std::min(*childEstimate, static_cast<const LimitNode*>(node)->limit);
+        }
+        case STAGE_FETCH:
+        case STAGE_SKIP:
+        case STAGE_SORT:
+        case STAGE_SORT_KEY_GENERATOR:
+        case STAGE_ENSURE_SORTED:
+        case STAGE_SHARDING_FILTER:
+        case STAGE_RETURN_KEY:
+        case STAGE_PROJECTION_DEFAULT:
+        case STAGE_PROJECTION_COVERED:
+        case STAGE_PROJECTION_SIMPLE:
+            // Stages which examine nothing beyond what their child produces.
+            return estimateDocsExamined(node->children[0], numRecords, indexStats);
+        case STAGE_OR:
+        case STAGE_SORT_MERGE:
+        case STAGE_AND_HASH:
+        case STAGE_AND_SORTED: {
+            // In the worst case every child of a union or an intersection runs to completion.
+            long long total = 0;
+            for (auto&& child : node->children) {
+                auto childEstimate = estimateDocsExamined(child, numRecords, indexStats);
+                if (!childEstimate) {
+                    return boost::none;
+                }
+                total = saturatingAdd(total, *childEstimate);
+            }
+            return total;
+        }
+        default:
+            return boost::none;
+    }
+}
+
+boost::optional<size_t> chooseSolution(const std::vector<std::unique_ptr<QuerySolution>>& solutions,
+                                       long long numRecords,
+                                       long long maxDocsExamined,
+                                       const IndexStatisticsMap* indexStats) {
+    boost::optional<size_t> best;
+    long long bestEstimate = kMaxEstimate;
+    for (size_t ix = 0; ix < solutions.size(); ++ix) {
+        auto estimate = estimateDocsExamined(solutions[ix]->root.get(), numRecords, indexStats);
+        if (estimate && *estimate <= maxDocsExamined && (!best || *estimate < bestEstimate)) {
+            best = ix;
+            bestEstimate = *estimate;
+        }
+    }
+    return best;
+}
+
+}  // namespace cardinality_estimation
+}  // namespace mongo
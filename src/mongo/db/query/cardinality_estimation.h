@@ -0,0 +1,78 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/query/index_statistics.h"
+#include "mongo/db/query/query_solution.h"
+
+namespace mongo {
+
+/**
+ * Estimates how many documents candidate query solutions will examine using only statistics that
+ * are available without executing a plan: the collection's record count, the shape of each index
+ * scan's bounds and, when the analyze command has collected them, sampled index statistics.
+ * Estimates are upper bounds, and are only produced when the bound is certain or is an upper
+ * confidence bound derived from a large enough sample. Anything the estimator cannot bound is left
+ * to multi-planning.
+ */
+namespace cardinality_estimation {
+
+/**
+ * Returns an upper bound on the number of documents the subtree rooted at 'node' examines, or
+ * boost::none if no bound can be derived. 'numRecords' is the number of records in the
+ * collection being queried.
+ *
+ * Index scans are bounded when every field of a unique index is constrained to point intervals, in
+ * which case each distinct point matches at most one document. Otherwise, if 'indexStats' has
+ * statistics for the scanned index sampled from at least internalQueryStatisticsMinSampledDocs
+ * documents, the bounds on its leading field are estimated from them, widened by
+ * internalQueryStatisticsConfidenceStdDevs standard errors.
+ */
+boost::optional<long long> estimateDocsExamined(const QuerySolutionNode* node,
+                                                long long numRecords,
+                                                const IndexStatisticsMap* indexStats = nullptr);
+
+/**
+ * Returns the position of the solution with the smallest estimate, provided that estimate is no
+ * larger than 'maxDocsExamined'. Returns boost::none if no solution qualifies, in which case the
+ * candidates must be ranked by running them.
+ */
+boost::optional<size_t> chooseSolution(const std::vector<std::unique_ptr<QuerySolution>>& solutions,
+                                       long long numRecords,
+                                       long long maxDocsExamined,
+                                       const IndexStatisticsMap* indexStats = nullptr);
+
+}  // namespace cardinality_estimation
+}  // namespace mongo
@@ -0,0 +1,196 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/cardinality_estimation.h"
+
+#include "mongo/db/query/index_entry.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+IndexEntry buildIndexEntry(const BSONObj& kp, bool unique) {
+    return {kp,
+            IndexNames::nameToType(IndexNames::findPluginName(kp)),
+            false,
+            {},
+            {},
+            false,
+            unique,
+            CoreIndexInfo::Identifier("test_foo"),
+            nullptr,
+            {},
+            nullptr,
+            nullptr};
+}
+
+Interval makePoint(int value) {
+    return Interval(BSON("" << value << "" << value), true, true);
+}
+
+Interval makeRange(int start, int end) {
+    return Interval(BSON("" << start << "" << end), true, true);
+}
+
+std::unique_ptr<IndexScanNode> makeIndexScan(const BSONObj& kp,
+                                             bool unique,
+                                             std::vector<std::vector<Interval>> fields) {
+    auto node = std::make_unique<IndexScanNode>(buildIndexEntry(kp, unique));
+    BSONObjIterator it(kp);
+    for (auto&& intervals : fields) {
+        OrderedIntervalList oil(it.next().fieldName());
+        oil.intervals = std::move(intervals);
+        node->bounds.fields.push_back(std::move(oil));
+    }
+    return node;
+}
+
+std::unique_ptr<QuerySolution> makeSolution(std::unique_ptr<QuerySolutionNode> root) {
+    auto soln = std::make_unique<QuerySolution>();
+    soln->root = std::move(root);
+    return soln;
+}
+
+std::unique_ptr<QuerySolutionNode> fetch(std::unique_ptr<QuerySolutionNode> child) {
+    auto node = std::make_unique<FetchNode>();
+    node->children.push_back(child.release());
+    return std::move(node);
+}
+
+TEST(CardinalityEstimationTest, CollectionScanIsBoundedByRecordCount) {
+    CollectionScanNode node;
+    ASSERT_EQ(500, *cardinality_estimation::estimateDocsExamined(&node, 500));
+}
+
+TEST(CardinalityEstimationTest, UniqueIndexPointsAreBounded) {
+    auto node = makeIndexScan(
+        BSON("a" << 1 << "b" << 1), true, {{makePoint(1), makePoint(2)}, {makePoint(3)}});
+    ASSERT_EQ(2, *cardinality_estimation::estimateDocsExamined(node.get(), 1000));
+
+    node = makeIndexScan(BSON("a" << 1 << "b" << 1),
+                         true,
+                         {{makePoint(1), makePoint(2)}, {makePoint(3), makePoint(4)}});
+    ASSERT_EQ(4, *cardinality_estimation::estimateDocsExamined(node.get(), 1000));
+}
+
+TEST(CardinalityEstimationTest, IndexScansWithoutCertainBoundsAreNotEstimated) {
+    // Not unique.
+    auto node = makeIndexScan(BSON("a" << 1), false, {{makePoint(1)}});
+    ASSERT_FALSE(cardinality_estimation::estimateDocsExamined(node.get(), 1000));
+
+    // A range on a unique index.
+    node = makeIndexScan(BSON("a" << 1), true, {{makeRange(1, 5)}});
+    ASSERT_FALSE(cardinality_estimation::estimateDocsExamined(node.get(), 1000));
+
+    // A point on a prefix of a unique index.
+    node = makeIndexScan(BSON("a" << 1 << "b" << 1), true, {{makePoint(1)}});
+    ASSERT_FALSE(cardinality_estimation::estimateDocsExamined(node.get(), 1000));
+}
+
+TEST(CardinalityEstimationTest, EstimatesPropagateThroughTheTree) {
+    std::unique_ptr<QuerySolutionNode> node =
+        fetch(makeIndexScan(BSON("a" << 1), true, {{makePoint(1), makePoint(2), makePoint(3)}}));
+    ASSERT_EQ(3, *cardinality_estimation::estimateDocsExamined(node.get(), 1000));
+
+    auto limit = std::make_unique<LimitNode>();
+    limit->limit = 1;
+    limit->children.push_back(node.release());
+    ASSERT_EQ(1, *cardinality_estimation::estimateDocsExamined(limit.get(), 1000));
+
+    auto orNode = std::make_unique<OrNode>();
+    orNode->children.push_back(makeIndexScan(BSON("a" << 1), true, {{makePoint(1)}}).release());
+    orNode->children.push_back(makeIndexScan(BSON("b" << 1), true, {{makePoint(1)}}).release());
+    ASSERT_EQ(2, *cardinality_estimation::estimateDocsExamined(orNode.get(), 1000));
+
+    orNode->children.push_back(makeIndexScan(BSON("c" << 1), false, {{makePoint(1)}}).release());
+    ASSERT_FALSE(cardinality_estimation::estimateDocsExamined(orNode.get(), 1000));
+}
+
+TEST(CardinalityEstimationTest, IndexStatisticsBoundRangeScans) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 100; ++i) {
+        docs.push_back(BSON("a" << i));
+    }
+    IndexStatisticsMap indexStats;
+    indexStats.emplace("test_foo",
+                       IndexStatistics::build("test_foo", BSON("a" << 1), docs, 100, 10));
+
+    // Values 10 through 19 make up one bucket. The estimate is an upper confidence bound, so it
+    // exceeds the 10 sampled documents in the range.
+    auto node = makeIndexScan(BSON("a" << 1), false, {{makeRange(10, 19)}});
+    ASSERT_FALSE(cardinality_estimation::estimateDocsExamined(node.get(), 100));
+    auto estimate = cardinality_estimation::estimateDocsExamined(node.get(), 100, &indexStats);
+    ASSERT(estimate);
+    ASSERT_GT(*estimate, 10);
+    ASSERT_LT(*estimate, 25);
+
+    // Statistics gathered for a different key pattern under the same index name are ignored.
+    node = makeIndexScan(BSON("b" << 1), false, {{makeRange(10, 19)}});
+    ASSERT_FALSE(cardinality_estimation::estimateDocsExamined(node.get(), 100, &indexStats));
+}
+
+TEST(CardinalityEstimationTest, SmallSamplesDoNotBoundRangeScans) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 50; ++i) {
+        docs.push_back(BSON("a" << i));
+    }
+    IndexStatisticsMap indexStats;
+    indexStats.emplace("test_foo",
+                       IndexStatistics::build("test_foo", BSON("a" << 1), docs, 50, 10));
+
+    // Fifty sampled documents are fewer than internalQueryStatisticsMinSampledDocs.
+    auto node = makeIndexScan(BSON("a" << 1), false, {{makeRange(10, 14)}});
+    ASSERT_FALSE(cardinality_estimation::estimateDocsExamined(node.get(), 50, &indexStats));
+}
+
+TEST(CardinalityEstimationTest, ChoosesSmallestEstimateUnderThreshold) {
+    std::vector<std::unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(
+        makeSolution(fetch(makeIndexScan(BSON("a" << 1), false, {{makePoint(1)}}))));
+    solutions.push_back(makeSolution(
+        fetch(makeIndexScan(BSON("b" << 1), true, {{makePoint(1), makePoint(2)}}))));
+    solutions.push_back(
+        makeSolution(fetch(makeIndexScan(BSON("c" << 1), true, {{makePoint(1)}}))));
+
+    ASSERT_EQ(2u, *cardinality_estimation::chooseSolution(solutions, 1000, 100));
+
+    // All estimates exceed the threshold, multi-planning must decide.
+    ASSERT_FALSE(cardinality_estimation::chooseSolution(solutions, 1000, 0));
+
+    // With no certain estimates, nothing is chosen.
+    solutions.pop_back();
+    solutions.pop_back();
+    ASSERT_FALSE(cardinality_estimation::chooseSolution(solutions, 1000, 100));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -33,9 +33,12 @@
 
 #include "mongo/db/query/collection_query_info.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <memory>
 
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/curop_metrics.h"
@@ -43,16 +46,25 @@
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/wildcard_access_method.h"
 #include "mongo/db/index_legacy.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_context.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/planner_ixselect.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context.h"
 #include "mongo/util/clock_source.h"
 #include "mongo/util/log.h"
+#include "mongo/util/uuid.h"
 
 namespace mongo {
 
 namespace {
+// Write generations are drawn from a process-wide counter rather than counted per collection. When
+// the catalog is reopened, such as after rollback to stable, the re-created Collection keeps its
+// UUID, so counting from zero again would repeat generations that results were cached under.
+AtomicWord<long long> nextWriteGeneration{0};
+
 CoreIndexInfo indexInfoFromIndexCatalogEntry(const IndexCatalogEntry& ice) {
     auto desc = ice.descriptor();
     invariant(desc);
@@ -72,13 +84,63 @@ CoreIndexInfo indexInfoFromIndexCatalogEntry(const IndexCatalogEntry& ice) {
             ice.getCollator(),
             projExec};
 }
+
+/**
+ * Reads the statistics which the analyze command persisted for 'coll' in the system.statistics
+ * collection of its database. Statistics for indexes that have since been dropped, or rebuilt with
+ * a different key pattern, are skipped, as are documents which fail to parse. Sets 'numRecords' to
+ * the size of the collection when it was analyzed.
+ */
+IndexStatisticsMap loadIndexStatistics(OperationContext* opCtx,
+                                       const Collection* coll,
+                                       long long* numRecords) {
+    IndexStatisticsMap indexStats;
+    const NamespaceString statsNss(coll->ns().db(),
+                                   NamespaceString::kSystemDotStatisticsCollectionName);
+    Lock::CollectionLock statsLock(opCtx, statsNss, MODE_IS);
+    const Collection* statsColl =
+        CollectionCatalog::get(opCtx).lookupCollectionByNamespace(statsNss);
+    if (!statsColl) {
+        return indexStats;
+    }
+
+    auto cursor = statsColl->getCursor(opCtx);
+    while (auto record = cursor->next()) {
+        const BSONObj doc = record->data.toBson();
+        const auto id = doc["_id"];
+        if (id.type() != Object) {
+            continue;
+        }
+        auto swUUID = UUID::parse(id.Obj()["collectionUUID"]);
+        if (!swUUID.isOK() || swUUID.getValue() != coll->uuid()) {
+            continue;
+        }
+
+        try {
+            auto stats = IndexStatistics::parse(doc);
+            const IndexDescriptor* desc =
+                coll->getIndexCatalog()->findIndexByName(opCtx, stats.indexName);
+            if (!desc || desc->keyPattern().woCompare(stats.keyPattern) != 0) {
+                continue;
+            }
+            *numRecords = std::max(*numRecords, stats.numRecords);
+            const std::string indexName = stats.indexName;
+            indexStats.emplace(indexName, std::move(stats));
+        } catch (const DBException& ex) {
+            LOG(1) << "Ignoring index statistics for " << coll->ns() << " which failed to parse: "
+                   << redact(ex.toStatus());
+        }
+    }
+    return indexStats;
+}
 }  // namespace
 
 CollectionQueryInfo::CollectionQueryInfo()
     : _keysComputed(false),
       _planCache(std::make_unique<PlanCache>()),
       _querySettings(std::make_unique<QuerySettings>()),
-      _indexUsageTracker(getGlobalServiceContext()->getPreciseClockSource()) {}
+      _indexUsageTracker(getGlobalServiceContext()->getPreciseClockSource()),
+      _writeGeneration(nextWriteGeneration.addAndFetch(1)) {}
 
 const UpdateIndexData& CollectionQueryInfo::getIndexKeys(OperationContext* opCtx) const {
     const Collection* coll = get.owner(this);
@@ -175,6 +237,10 @@ void CollectionQueryInfo::notifyOfQuery(OperationContext* opCtx,
     }
 }
 
+void CollectionQueryInfo::notifyOfSkippedIndexUpdate(StringData indexName) {
+    _indexUsageTracker.recordSkippedIndexUpdate(indexName);
+}
+
 void CollectionQueryInfo::clearQueryCache() {
     const Collection* coll = get.owner(this);
     LOG(1) << coll->ns() << ": clearing plan cache - collection info cache reset";
@@ -242,6 +308,13 @@ void CollectionQueryInfo::droppedIndex(OperationContext* opCtx, StringData index
 
     rebuildIndexData(opCtx);
     _indexUsageTracker.unregisterIndex(indexName);
+
+    stdx::lock_guard<Latch> lk(_indexStatisticsMutex);
+    if (_indexStatistics && _indexStatistics->count(indexName)) {
+        auto indexStats = std::make_shared<IndexStatisticsMap>(*_indexStatistics);
+        indexStats->erase(indexName);
+        _indexStatistics = std::move(indexStats);
+    }
 }
 
 void CollectionQueryInfo::rebuildIndexData(OperationContext* opCtx) {
@@ -261,4 +334,75 @@ CollectionIndexUsageTracker::CollectionScanStats CollectionQueryInfo::getCollect
     return _indexUsageTracker.getCollectionScanStats();
 }
 
+void CollectionQueryInfo::setIndexStatistics(IndexStatisticsMap indexStats, long long numRecords) {
+    stdx::lock_guard<Latch> lk(_indexStatisticsMutex);
+    _indexStatistics = std::make_shared<const IndexStatisticsMap>(std::move(indexStats));
+    _indexStatisticsNumRecords = numRecords;
+    _indexStatisticsLoaded = true;
+    _writesSinceIndexStatistics.store(0);
+}
+
+std::shared_ptr<const IndexStatisticsMap> CollectionQueryInfo::getIndexStatistics(
+    OperationContext* opCtx) {
+    {
+        stdx::lock_guard<Latch> lk(_indexStatisticsMutex);
+        if (_indexStatisticsLoaded) {
+            return _getIndexStatistics(lk);
+        }
+    }
+
+    // The statistics collection is read without holding the mutex. If the analyze command
+    // installs statistics in the meantime, those are newer and are kept.
+    const Collection* coll = get.owner(this);
+    long long numRecords = 0;
+    auto indexStats = loadIndexStatistics(opCtx, coll, &numRecords);
+    const long long currentNumRecords = static_cast<long long>(coll->numRecords(opCtx));
+
+    stdx::lock_guard<Latch> lk(_indexStatisticsMutex);
+    if (!_indexStatisticsLoaded) {
+        _indexStatisticsLoaded = true;
+        if (!indexStats.empty()) {
+            _indexStatistics = std::make_shared<const IndexStatisticsMap>(std::move(indexStats));
+            _indexStatisticsNumRecords = numRecords;
+
+            // Writes made before this collection was loaded were not counted, but there were at
+            // least as many as the collection has grown or shrunk by since it was analyzed.
+            _writesSinceIndexStatistics.store(
+                std::max(_writesSinceIndexStatistics.load(),
+                         std::llabs(currentNumRecords - numRecords)));
+        }
+    }
+    return _getIndexStatistics(lk);
+}
+
+std::shared_ptr<const IndexStatisticsMap> CollectionQueryInfo::_getIndexStatistics(
+    WithLock) const {
+    const double maxWrites = internalQueryStatisticsStaleWriteFraction.load() *
+        static_cast<double>(_indexStatisticsNumRecords);
+    if (static_cast<double>(_writesSinceIndexStatistics.load()) > maxWrites) {
+        return nullptr;
+    }
+    return _indexStatistics;
+}
+
+void CollectionQueryInfo::notifyOfWritesOnCommit(OperationContext* opCtx, long long numDocs) {
+    if (!opCtx->lockState()->inAWriteUnitOfWork()) {
+        _writesSinceIndexStatistics.fetchAndAddRelaxed(numDocs);
+        return;
+    }
+    opCtx->recoveryUnit()->onCommit([this, numDocs](boost::optional<Timestamp>) {
+        _writesSinceIndexStatistics.fetchAndAddRelaxed(numDocs);
+    });
+}
+
+void CollectionQueryInfo::advanceWriteGenerationOnCommit(OperationContext* opCtx) {
+    if (!opCtx->lockState()->inAWriteUnitOfWork()) {
+        _writeGeneration.store(nextWriteGeneration.addAndFetch(1));
+        return;
+    }
+    opCtx->recoveryUnit()->onCommit([this](boost::optional<Timestamp>) {
+        _writeGeneration.store(nextWriteGeneration.addAndFetch(1));
+    });
+}
+
 }  // namespace mongo
@@ -33,10 +33,14 @@
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/collection_index_usage_tracker.h"
+#include "mongo/db/query/index_statistics.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/query/query_settings.h"
 #include "mongo/db/update_index_data.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
 
 namespace mongo {
 
@@ -107,6 +111,50 @@ public:
 
     void notifyOfQuery(OperationContext* opCtx, const PlanSummaryStats& summaryStats);
 
+    /**
+     * Records that an update left the keys of index 'indexName' unchanged without generating them.
+     * Does nothing for indexes which are still being built.
+     */
+    void notifyOfSkippedIndexUpdate(StringData indexName);
+
+    /**
+     * Installs index statistics gathered by the analyze command, replacing any previous ones.
+     * 'numRecords' is the size of the collection when the statistics were gathered.
+     */
+    void setIndexStatistics(IndexStatisticsMap indexStats, long long numRecords);
+
+    /**
+     * Returns the statistics last installed by setIndexStatistics, or nullptr if there are none or
+     * the collection has since seen more writes than internalQueryStatisticsStaleWriteFraction
+     * of its size at the time. If none have been installed yet, reads back those that the analyze
+     * command persisted in the database's system.statistics collection, which requires a database
+     * lock.
+     */
+    std::shared_ptr<const IndexStatisticsMap> getIndexStatistics(OperationContext* opCtx);
+
+    /**
+     * Records that 'numDocs' documents were inserted, updated or deleted once the current unit of
+     * work commits, or immediately outside of a unit of work.
+     */
+    void notifyOfWritesOnCommit(OperationContext* opCtx, long long numDocs);
+
+    /**
+     * Advances the write generation of the collection once the current unit of work commits, or
+     * immediately outside of a unit of work. Must be called for every write to the collection's
+     * documents.
+     */
+    void advanceWriteGenerationOnCommit(OperationContext* opCtx);
+
+    /**
+     * Returns a value which changes whenever a write to the collection commits. It is advanced
+     * after the write becomes visible, so results computed from a snapshot opened after reading
+     * the generation are out of date if it has changed since. Generations are unique within the
+     * process, and never repeat even if the collection is re-created when the catalog reopens.
+     */
+    long long getWriteGeneration() const {
+        return _writeGeneration.load();
+    }
+
 private:
     void computeIndexKeys(OperationContext* opCtx);
     void updatePlanCacheIndexEntries(OperationContext* opCtx);
@@ -117,6 +165,8 @@ private:
      */
     void rebuildIndexData(OperationContext* opCtx);
 
+    std::shared_ptr<const IndexStatisticsMap> _getIndexStatistics(WithLock) const;
+
     // ---  index keys cache
     bool _keysComputed;
     UpdateIndexData _indexedPaths;
@@ -130,6 +180,16 @@ private:
 
     // Tracks index usage statistics for this collection.
     CollectionIndexUsageTracker _indexUsageTracker;
+
+    mutable Mutex _indexStatisticsMutex =
+        MONGO_MAKE_LATCH("CollectionQueryInfo::_indexStatisticsMutex");
+    std::shared_ptr<const IndexStatisticsMap> _indexStatistics;
+    // Whether statistics have been installed or read back from system.statistics.
+    bool _indexStatisticsLoaded = false;
+    long long _indexStatisticsNumRecords = 0;
+    AtomicWord<long long> _writesSinceIndexStatistics{0};
+
+    AtomicWord<long long> _writeGeneration;
 };
 
 }  // namespace mongo
@@ -87,6 +87,16 @@ public:
         _numDocs++;
     }
 
+    /**
+     * Makes room in the reply for at least another 'bytes' bytes of batch. This lets a caller that
+     * can tell a batch will be large grow the reply buffer once, rather than letting it double,
+     * copying the batch so far each time, on the way there.
+     */
+    void reserveBytes(std::size_t bytes) {
+        invariant(_active);
+        _replyBuilder->reserveBytes(bytes);
+    }
+
     void setPostBatchResumeToken(BSONObj token) {
         _postBatchResumeToken = token.getOwned();
     }
@@ -297,6 +297,38 @@ TEST(CursorResponseTest, cursorReturnDocumentSequences) {
     ASSERT_BSONOBJ_EQ(opMsg.body, expectedBody);
 }
 
+TEST(CursorResponseTest, reserveBytesPartwayThroughBatchKeepsResponseIntact) {
+    for (bool useDocumentSequences : {false, true}) {
+        CursorResponseBuilder::Options options;
+        options.isInitialResponse = true;
+        options.useDocumentSequences = useDocumentSequences;
+        rpc::OpMsgReplyBuilder builder;
+        BSONObj doc0 = BSON("_id" << 0);
+        BSONObj doc1 = BSON("_id" << 1);
+
+        CursorResponseBuilder crb(&builder, options);
+        crb.append(doc0);
+        crb.reserveBytes(1024 * 1024);
+        crb.append(doc1);
+        crb.done(CursorId(123), "db.coll");
+
+        auto msg = builder.done();
+        auto opMsg = OpMsg::parse(msg);
+        std::vector<BSONObj> batch;
+        if (useDocumentSequences) {
+            ASSERT_EQ(opMsg.sequences.size(), 1U);
+            batch = opMsg.sequences[0].objs;
+        } else {
+            for (auto&& elem : opMsg.body["cursor"]["firstBatch"].Obj()) {
+                batch.push_back(elem.Obj());
+            }
+        }
+        ASSERT_EQ(batch.size(), 2U);
+        ASSERT_BSONOBJ_EQ(batch[0], doc0);
+        ASSERT_BSONOBJ_EQ(batch[1], doc1);
+    }
+}
+
 }  // namespace
 
 }  // namespace mongo
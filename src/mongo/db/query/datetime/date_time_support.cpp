@@ -31,6 +31,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <memory>
 #include <timelib.h>
 
@@ -111,28 +112,136 @@ const std::vector<timelib_format_specifier> kDateToStringFormatMap = {
 
 // Verifies that any '%' is followed by a valid format character as indicated by 'allowedFormats',
 // and that the 'format' string ends with an even number of '%' symbols.
-void validateFormat(StringData format,
-                    const std::vector<timelib_format_specifier>& allowedFormats) {
+Status checkFormat(StringData format, const std::vector<timelib_format_specifier>& allowedFormats) {
     for (auto it = format.begin(); it != format.end(); ++it) {
         if (*it != '%') {
             continue;
         }
 
         ++it;  // next character must be format modifier
-        uassert(18535, "Unmatched '%' at end of format string", it != format.end());
+        if (it == format.end()) {
+            return {ErrorCodes::Error(18535), "Unmatched '%' at end of format string"};
+        }
 
         const bool validSpecifier = (*it == '%') ||
             std::find_if(allowedFormats.begin(), allowedFormats.end(), [=](const auto& format) {
                 return format.specifier == *it;
             }) != allowedFormats.end();
-        uassert(18536,
-                str::stream() << "Invalid format character '%" << *it << "' in format string",
-                validSpecifier);
+        if (!validSpecifier) {
+            return {ErrorCodes::Error(18536),
+                    str::stream() << "Invalid format character '%" << *it << "' in format string"};
+        }
     }
+    return Status::OK();
+}
+
+void validateFormat(StringData format,
+                    const std::vector<timelib_format_specifier>& allowedFormats) {
+    uassertStatusOK(checkFormat(format, allowedFormats));
+}
+
+constexpr long long kSecondsPerDay = 24 * 60 * 60;
+
+// Returns the number of days from 1970-01-01 to the given date of the proleptic Gregorian calendar,
+// for 1 <= month <= 12 and any day. See Howard Hinnant, "chrono-Compatible Low-Level Date
+// Algorithms", http://howardhinnant.github.io/date_algorithms.html.
+long long daysFromCivil(long long year, long long month, long long day) {
+    year -= month <= 2;
+    const long long era = (year >= 0 ? year : year - 399) / 400;
+    const long long yearOfEra = year - era * 400;                                 // [0, 399]
+    const long long dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5;  // [0, 365]
+    const long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468 + day - 1;
+}
+
+// The inverse of daysFromCivil(), filling in the date fields of 'out'.
+void civilFromDays(long long days, TimeZone::LocalTime* out) {
+    days += 719468;
+    const long long era = (days >= 0 ? days : days - 146096) / 146097;
+    const long long dayOfEra = days - era * 146097;  // [0, 146096]
+    const long long yearOfEra =
+        (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;  // [0, 399]
+    const long long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const long long shiftedMonth = (5 * dayOfYear + 2) / 153;  // [0, 11], starting in March
+    out->dayOfMonth = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    out->month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    out->year = yearOfEra + era * 400 + (out->month <= 2);
+}
+
+// Returns 'dividend' divided by 'divisor', rounded toward negative infinity.
+long long floorDiv(long long dividend, long long divisor) {
+    const long long quotient = dividend / divisor;
+    return quotient * divisor > dividend ? quotient - 1 : quotient;
 }
 
 }  // namespace
 
+/**
+ * The UTC offset of an Olson time zone is a step function of time. timelib finds the step for an
+ * instant with a linear scan over the transitions, several times for each conversion, so the steps
+ * are copied into sorted arrays which are binary searched instead.
+ */
+struct TimeZone::UtcOffsetTable {
+    explicit UtcOffsetTable(const timelib_tzinfo& tzInfo) {
+        // Mirrors timelib's fetch_timezone_offset(): before the first transition, or when there are
+        // no transitions, the first type is in effect if it can be determined.
+        const bool hasTransitions = tzInfo.bit64.timecnt > 0 && tzInfo.trans;
+        if (hasTransitions || tzInfo.bit64.typecnt == 1) {
+            initialOffset = Seconds(tzInfo.type[0].offset);
+        }
+        if (!hasTransitions) {
+            return;
+        }
+
+        transitions.assign(tzInfo.trans, tzInfo.trans + tzInfo.bit64.timecnt);
+        offsets.reserve(transitions.size());
+        for (size_t i = 0; i < transitions.size(); ++i) {
+            offsets.push_back(Seconds(tzInfo.type[tzInfo.trans_idx[i]].offset));
+        }
+    }
+
+    Seconds offsetAt(long long secondsSinceEpoch) const {
+        auto next =
+            std::upper_bound(transitions.begin(), transitions.end(), secondsSinceEpoch);
+        return next == transitions.begin() ? initialOffset
+                                           : offsets[next - transitions.begin() - 1];
+    }
+
+    // The times at which the offset changes, in seconds since the epoch and in ascending order.
+    std::vector<long long> transitions;
+
+    // offsets[i] is in effect from transitions[i] until transitions[i + 1].
+    std::vector<Seconds> offsets;
+
+    // The offset in effect before the first transition.
+    Seconds initialOffset{0};
+};
+
+StatusWith<DateToStringFormat> DateToStringFormat::parse(StringData format) {
+    auto status = checkFormat(format, kDateToStringFormatMap);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    DateToStringFormat parsed;
+    for (auto it = format.begin(); it != format.end(); ++it) {
+        if (*it == '%') {
+            ++it;  // next character is format modifier, checked above
+            if (*it != '%') {
+                parsed._pieces.push_back({*it, {}});
+                continue;
+            }
+        }
+
+        // Literal text, including escaped '%' characters, is merged into a single piece.
+        if (parsed._pieces.empty() || parsed._pieces.back().specifier) {
+            parsed._pieces.push_back({'\0', {}});
+        }
+        parsed._pieces.back().literal.push_back(*it);
+    }
+    return {std::move(parsed)};
+}
+
 const TimeZoneDatabase* TimeZoneDatabase::get(ServiceContext* serviceContext) {
     return getTimeZoneDatabase(serviceContext).get();
 }
@@ -391,6 +500,18 @@ Date_t TimeZone::createFromDateParts(long long year,
                                      long long minute,
                                      long long second,
                                      long long millisecond) const {
+    if (!isTimeZoneIDZone()) {
+        // In UTC and UTC-offset zones local time is a fixed distance from UTC, so the result can
+        // be computed directly. Out of range parts carry into the next larger part, as they do in
+        // timelib.
+        const long long yearsFromMonths = floorDiv(month - 1, 12);
+        const long long days =
+            daysFromCivil(year + yearsFromMonths, month - 12 * yearsFromMonths, day);
+        const long long seconds = ((days * 24 + hour) * 60 + minute) * 60 + second -
+            durationCount<Seconds>(_utcOffset);
+        return Date_t::fromMillisSinceEpoch(seconds * 1000 + millisecond);
+    }
+
     auto newTime = createTimelibTime();
 
     newTime->y = year;
@@ -433,26 +554,26 @@ Date_t TimeZone::createFromIso8601DateParts(long long isoYear,
     return returnValue;
 }
 
-TimeZone::DateParts::DateParts(const timelib_time& timelib_time, Date_t date)
-    : year(timelib_time.y),
-      month(timelib_time.m),
-      dayOfMonth(timelib_time.d),
-      hour(timelib_time.h),
-      minute(timelib_time.i),
-      second(timelib_time.s) {
+TimeZone::DateParts::DateParts(const LocalTime& localTime, Date_t date)
+    : year(localTime.year),
+      month(localTime.month),
+      dayOfMonth(localTime.dayOfMonth),
+      hour(localTime.hour),
+      minute(localTime.minute),
+      second(localTime.second) {
     const int ms = date.toMillisSinceEpoch() % 1000LL;
     // Add 1000 since dates before 1970 would have negative milliseconds.
     millisecond = ms >= 0 ? ms : 1000 + ms;
 }
 
-TimeZone::Iso8601DateParts::Iso8601DateParts(const timelib_time& timelib_time, Date_t date)
-    : hour(timelib_time.h), minute(timelib_time.i), second(timelib_time.s) {
+TimeZone::Iso8601DateParts::Iso8601DateParts(const LocalTime& localTime, Date_t date)
+    : hour(localTime.hour), minute(localTime.minute), second(localTime.second) {
 
     timelib_sll tmpIsoYear, tmpIsoWeekOfYear, tmpIsoDayOfWeek;
 
-    timelib_isodate_from_date(timelib_time.y,
-                              timelib_time.m,
-                              timelib_time.d,
+    timelib_isodate_from_date(localTime.year,
+                              localTime.month,
+                              localTime.dayOfMonth,
                               &tmpIsoYear,
                               &tmpIsoWeekOfYear,
                               &tmpIsoDayOfWeek);
@@ -474,7 +595,9 @@ void TimeZone::TimelibTZInfoDeleter::operator()(timelib_tzinfo* tzInfo) {
 }
 
 TimeZone::TimeZone(timelib_tzinfo* tzInfo)
-    : _tzInfo(tzInfo, TimelibTZInfoDeleter()), _utcOffset(0) {}
+    : _tzInfo(tzInfo, TimelibTZInfoDeleter()),
+      _utcOffsetTable(tzInfo ? std::make_shared<const UtcOffsetTable>(*tzInfo) : nullptr),
+      _utcOffset(0) {}
 
 TimeZone::TimeZone(Seconds utcOffsetSeconds) : _tzInfo(nullptr), _utcOffset(utcOffsetSeconds) {}
 
@@ -482,31 +605,33 @@ void TimeZone::TimelibTimeDeleter::operator()(timelib_time* time) {
     timelib_time_dtor(time);
 }
 
-std::unique_ptr<timelib_time, TimeZone::TimelibTimeDeleter> TimeZone::getTimelibTime(
-    Date_t date) const {
-    auto time = createTimelibTime();
-
-    timelib_unixtime2gmt(time.get(), seconds(date));
-    adjustTimeZone(time.get());
-    timelib_unixtime2local(time.get(), seconds(date));
+TimeZone::LocalTime TimeZone::localTime(Date_t date) const {
+    // Like timelib_unixtime2local(), the local time is the UTC time of the instant shifted by the
+    // offset in effect at that instant.
+    const long long local = seconds(date) + durationCount<Seconds>(utcOffset(date));
+    const long long days = floorDiv(local, kSecondsPerDay);
+    const long long secondOfDay = local - days * kSecondsPerDay;
 
-    return time;
+    LocalTime result;
+    civilFromDays(days, &result);
+    result.hour = secondOfDay / 3600;
+    result.minute = secondOfDay / 60 % 60;
+    result.second = secondOfDay % 60;
+    return result;
 }
 
 TimeZone::Iso8601DateParts TimeZone::dateIso8601Parts(Date_t date) const {
-    auto time = getTimelibTime(date);
-    return Iso8601DateParts(*time, date);
+    return Iso8601DateParts(localTime(date), date);
 }
 
 TimeZone::DateParts TimeZone::dateParts(Date_t date) const {
-    auto time = getTimelibTime(date);
-    return DateParts(*time, date);
+    return DateParts(localTime(date), date);
 }
 
 int TimeZone::dayOfWeek(Date_t date) const {
-    auto time = getTimelibTime(date);
+    auto time = localTime(date);
     // timelib_day_of_week() returns a number in the range [0,6], we want [1,7], so add one.
-    return timelib_day_of_week(time->y, time->m, time->d) + 1;
+    return timelib_day_of_week(time.year, time.month, time.dayOfMonth) + 1;
 }
 
 int TimeZone::week(Date_t date) const {
@@ -523,36 +648,37 @@ int TimeZone::week(Date_t date) const {
 }
 
 int TimeZone::dayOfYear(Date_t date) const {
-    auto time = getTimelibTime(date);
+    auto time = localTime(date);
     // timelib_day_of_year() returns a number in the range [0,365], we want [1,366], so add one.
-    return timelib_day_of_year(time->y, time->m, time->d) + 1;
+    return timelib_day_of_year(time.year, time.month, time.dayOfMonth) + 1;
 }
 
 int TimeZone::isoDayOfWeek(Date_t date) const {
-    auto time = getTimelibTime(date);
-    return timelib_iso_day_of_week(time->y, time->m, time->d);
+    auto time = localTime(date);
+    return timelib_iso_day_of_week(time.year, time.month, time.dayOfMonth);
 }
 
 int TimeZone::isoWeek(Date_t date) const {
-    auto time = getTimelibTime(date);
+    auto time = localTime(date);
     long long isoWeek;
     long long isoYear;
-    timelib_isoweek_from_date(time->y, time->m, time->d, &isoWeek, &isoYear);
+    timelib_isoweek_from_date(time.year, time.month, time.dayOfMonth, &isoWeek, &isoYear);
     return isoWeek;
 }
 
 long long TimeZone::isoYear(Date_t date) const {
-    auto time = getTimelibTime(date);
+    auto time = localTime(date);
     long long isoWeek;
     long long isoYear;
-    timelib_isoweek_from_date(time->y, time->m, time->d, &isoWeek, &isoYear);
+    timelib_isoweek_from_date(time.year, time.month, time.dayOfMonth, &isoWeek, &isoYear);
     return isoYear;
 }
 
 Seconds TimeZone::utcOffset(Date_t date) const {
-    auto time = getTimelibTime(date);
-
-    return Seconds(time->z);
+    if (_utcOffsetTable) {
+        return _utcOffsetTable->offsetAt(seconds(date));
+    }
+    return _utcOffset;
 }
 
 void TimeZone::validateToStringFormat(StringData format) {
@@ -568,4 +694,10 @@ std::string TimeZone::formatDate(StringData format, Date_t date) const {
     outputDateWithFormat(formatted, format, date);
     return formatted.str();
 }
+
+std::string TimeZone::formatDate(const DateToStringFormat& format, Date_t date) const {
+    StringBuilder formatted;
+    outputDateWithFormat(formatted, format, date);
+    return formatted.str();
+}
 }  // namespace mongo
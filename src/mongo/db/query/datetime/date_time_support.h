@@ -31,7 +31,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "mongo/base/status_with.h"
 #include "mongo/db/service_context.h"
 #include "mongo/util/string_map.h"
 #include "mongo/util/time_support.h"
@@ -43,6 +45,36 @@ struct _timelib_tzinfo;
 
 namespace mongo {
 
+/**
+ * A $dateToString format string which has been validated and split into literal text and format
+ * specifiers, so that a format shared by many documents is only scanned once.
+ */
+class DateToStringFormat {
+public:
+    /**
+     * A run of literal text, or a single format specifier such as 'Y' with no literal text.
+     */
+    struct Piece {
+        char specifier;
+        std::string literal;
+    };
+
+    /**
+     * Returns the parsed form of 'format', or the error TimeZone::validateToStringFormat() would
+     * have thrown for it.
+     */
+    static StatusWith<DateToStringFormat> parse(StringData format);
+
+    const std::vector<Piece>& pieces() const {
+        return _pieces;
+    }
+
+private:
+    DateToStringFormat() = default;
+
+    std::vector<Piece> _pieces;
+};
+
 /**
  * A TimeZone object represents one way of formatting/reading dates to compute things like the day
  * of the week or the hour of a given date. Different TimeZone objects may report different answers
@@ -51,11 +83,23 @@ namespace mongo {
 class TimeZone {
 
 public:
+    /**
+     * The local date and time of some instant in a time zone, in the proleptic Gregorian calendar.
+     */
+    struct LocalTime {
+        long long year;
+        int month;
+        int dayOfMonth;
+        int hour;
+        int minute;
+        int second;
+    };
+
     /**
      * A struct with member variables describing the different parts of the date.
      */
     struct DateParts {
-        DateParts(const _timelib_time&, Date_t);
+        DateParts(const LocalTime&, Date_t);
 
         int year;
         int month;
@@ -70,7 +114,7 @@ public:
      * A struct with member variables describing the different parts of the ISO8601 date.
      */
     struct Iso8601DateParts {
-        Iso8601DateParts(const _timelib_time&, Date_t);
+        Iso8601DateParts(const LocalTime&, Date_t);
 
         int year;
         int weekOfYear;
@@ -196,6 +240,11 @@ public:
      */
     std::string formatDate(StringData format, Date_t) const;
 
+    /**
+     * Like formatDate, except that 'format' has already been validated and parsed.
+     */
+    std::string formatDate(const DateToStringFormat& format, Date_t) const;
+
     /**
      * Like formatDate, except outputs to an output stream like a std::ostream or a StringBuilder.
      */
@@ -211,65 +260,23 @@ public:
             ++it;                           // next character is format modifier
             invariant(it != format.end());  // checked in validateFormat
 
-            switch (*it) {
-                case '%':  // Escaped literal %
-                    os << '%';
-                    break;
-                case 'Y':  // Year
-                {
-                    insertPadded(os, parts.year, 4);
-                    break;
-                }
-                case 'm':  // Month
-                    insertPadded(os, parts.month, 2);
-                    break;
-                case 'd':  // Day of month
-                    insertPadded(os, parts.dayOfMonth, 2);
-                    break;
-                case 'H':  // Hour
-                    insertPadded(os, parts.hour, 2);
-                    break;
-                case 'M':  // Minute
-                    insertPadded(os, parts.minute, 2);
-                    break;
-                case 'S':  // Second
-                    insertPadded(os, parts.second, 2);
-                    break;
-                case 'L':  // Millisecond
-                    insertPadded(os, parts.millisecond, 3);
-                    break;
-                case 'j':  // Day of year
-                    insertPadded(os, dayOfYear(date), 3);
-                    break;
-                case 'w':  // Day of week
-                    insertPadded(os, dayOfWeek(date), 1);
-                    break;
-                case 'U':  // Week
-                    insertPadded(os, week(date), 2);
-                    break;
-                case 'G':  // Iso year of week
-                    insertPadded(os, isoYear(date), 4);
-                    break;
-                case 'V':  // Iso week
-                    insertPadded(os, isoWeek(date), 2);
-                    break;
-                case 'u':  // Iso day of week
-                    insertPadded(os, isoDayOfWeek(date), 1);
-                    break;
-                case 'z':  // UTC offset as ±hhmm.
-                {
-                    auto offset = utcOffset(date);
-                    os << ((offset.count() < 0) ? "-" : "+");                            // sign
-                    insertPadded(os, std::abs(durationCount<Hours>(offset)), 2);         // hh
-                    insertPadded(os, std::abs(durationCount<Minutes>(offset)) % 60, 2);  // mm
-                    break;
-                }
-                case 'Z':  // UTC offset in minutes.
-                    os << durationCount<Minutes>(utcOffset(date));
-                    break;
-                default:
-                    // Should never happen as format is pre-validated
-                    MONGO_UNREACHABLE;
+            outputFormatSpecifier(os, *it, parts, date);
+        }
+    }
+
+    /**
+     * Like outputDateWithFormat, except that 'format' has already been validated and parsed.
+     */
+    template <typename OutputStream>
+    void outputDateWithFormat(OutputStream& os,
+                              const DateToStringFormat& format,
+                              Date_t date) const {
+        auto parts = dateParts(date);
+        for (auto&& piece : format.pieces()) {
+            if (piece.specifier) {
+                outputFormatSpecifier(os, piece.specifier, parts, date);
+            } else {
+                os << piece.literal;
             }
         }
     }
@@ -282,7 +289,82 @@ public:
     static void validateFromStringFormat(StringData format);
 
 private:
-    std::unique_ptr<_timelib_time, TimelibTimeDeleter> getTimelibTime(Date_t) const;
+    /**
+     * Returns the local date and time of 'date' in this time zone. Olson time zones look up their
+     * UTC offset in '_utcOffsetTable' rather than going through timelib.
+     */
+    LocalTime localTime(Date_t) const;
+
+    /**
+     * Outputs the part of 'date' described by the format specifier 'specifier', which must have
+     * been validated by validateToStringFormat(). 'parts' must be the result of dateParts(date).
+     */
+    template <typename OutputStream>
+    void outputFormatSpecifier(OutputStream& os,
+                               char specifier,
+                               const DateParts& parts,
+                               Date_t date) const {
+        switch (specifier) {
+            case '%':  // Escaped literal %
+                os << '%';
+                break;
+            case 'Y':  // Year
+            {
+                insertPadded(os, parts.year, 4);
+                break;
+            }
+            case 'm':  // Month
+                insertPadded(os, parts.month, 2);
+                break;
+            case 'd':  // Day of month
+                insertPadded(os, parts.dayOfMonth, 2);
+                break;
+            case 'H':  // Hour
+                insertPadded(os, parts.hour, 2);
+                break;
+            case 'M':  // Minute
+                insertPadded(os, parts.minute, 2);
+                break;
+            case 'S':  // Second
+                insertPadded(os, parts.second, 2);
+                break;
+            case 'L':  // Millisecond
+                insertPadded(os, parts.millisecond, 3);
+                break;
+            case 'j':  // Day of year
+                insertPadded(os, dayOfYear(date), 3);
+                break;
+            case 'w':  // Day of week
+                insertPadded(os, dayOfWeek(date), 1);
+                break;
+            case 'U':  // Week
+                insertPadded(os, week(date), 2);
+                break;
+            case 'G':  // Iso year of week
+                insertPadded(os, isoYear(date), 4);
+                break;
+            case 'V':  // Iso week
+                insertPadded(os, isoWeek(date), 2);
+                break;
+            case 'u':  // Iso day of week
+                insertPadded(os, isoDayOfWeek(date), 1);
+                break;
+            case 'z':  // UTC offset as ±hhmm.
+            {
+                auto offset = utcOffset(date);
+                os << ((offset.count() < 0) ? "-" : "+");                            // sign
+                insertPadded(os, std::abs(durationCount<Hours>(offset)), 2);         // hh
+                insertPadded(os, std::abs(durationCount<Minutes>(offset)) % 60, 2);  // mm
+                break;
+            }
+            case 'Z':  // UTC offset in minutes.
+                os << durationCount<Minutes>(utcOffset(date));
+                break;
+            default:
+                // Should never happen as format is pre-validated
+                MONGO_UNREACHABLE;
+        }
+    }
 
     /**
      * Only works with 1 <= spaces <= 4 and 0 <= number <= 9999. If spaces is less than the digit
@@ -318,9 +400,15 @@ private:
         void operator()(_timelib_tzinfo* tzInfo);
     };
 
+    // The UTC offsets of an Olson time zone, built from '_tzInfo' when the zone is loaded.
+    struct UtcOffsetTable;
+
     // null if this TimeZone represents the default UTC time zone, or a UTC-offset time zone
     std::shared_ptr<_timelib_tzinfo> _tzInfo;
 
+    // null unless '_tzInfo' is set
+    std::shared_ptr<const UtcOffsetTable> _utcOffsetTable;
+
     // represents the UTC offset in seconds if _tzInfo is null and it is not 0
     Seconds _utcOffset{0};
 };
@@ -408,6 +408,52 @@ TEST(NewYorkTimeBeforeEpoch, DoesFormatDate) {
               "isoWeek: 01, isoDayOfWeek: 2, percent: %");
 }
 
+TEST(DateToStringFormat, ParsedFormatMatchesFormatString) {
+    constexpr auto format =
+        "%Y/%m/%d %H:%M:%S:%L, dayOfYear: %j, dayOfWeek: %w, week: %U, isoYear: %G, "
+        "isoWeek: %V, isoDayOfWeek: %u, offset: %z %Z, percent: %%"_sd;
+    auto parsed = DateToStringFormat::parse(format);
+    ASSERT_OK(parsed.getStatus());
+
+    // Step across several years in both directions from the epoch, crossing daylight savings
+    // transitions in the zones that have them.
+    for (auto&& zoneName : {"UTC", "America/New_York", "Australia/Sydney", "+05:30"}) {
+        auto zone = kDefaultTimeZoneDatabase.getTimeZone(zoneName);
+        for (long long millis = -200000000000LL; millis < 2000000000000LL;
+             millis += 3600LL * 1000 * 97 + 123) {
+            auto date = Date_t::fromMillisSinceEpoch(millis);
+            ASSERT_EQ(zone.formatDate(parsed.getValue(), date), zone.formatDate(format, date))
+                << zoneName << " " << millis;
+        }
+    }
+}
+
+TEST(DateToStringFormat, ParseRejectsInvalidFormats) {
+    ASSERT_EQ(DateToStringFormat::parse("%Y-%m-%").getStatus().code(), 18535);
+    ASSERT_EQ(DateToStringFormat::parse("%Y-%q").getStatus().code(), 18536);
+}
+
+TEST(CreateFromDateParts, FixedOffsetZoneNormalizesOverflowingParts) {
+    auto zone = kDefaultTimeZoneDatabase.getTimeZone("-03:30");
+    const auto& utc = TimeZoneDatabase::utcZone();
+    const auto offset = durationCount<Milliseconds>(Hours(3) + Minutes(30));
+
+    // Months, days and times out of their usual ranges roll over into the neighbouring units.
+    // 2018-03-05T02:02:02.001Z
+    ASSERT_EQ(utc.createFromDateParts(2017, 14, 32, 25, 61, 61, 1001).toMillisSinceEpoch(),
+              1520215322001LL);
+    ASSERT_EQ(zone.createFromDateParts(2017, 14, 32, 25, 61, 61, 1001).toMillisSinceEpoch(),
+              1520215322001LL + offset);
+    // 2015-10-30T22:58:58.999Z
+    ASSERT_EQ(utc.createFromDateParts(2017, -13, 0, -1, -1, -1, -1).toMillisSinceEpoch(),
+              1446245938999LL);
+    ASSERT_EQ(zone.createFromDateParts(2017, -13, 0, -1, -1, -1, -1).toMillisSinceEpoch(),
+              1446245938999LL + offset);
+    ASSERT_EQ(utc.createFromDateParts(2016, 2, 29, 0, 0, 0, 0).toMillisSinceEpoch(),
+              1456704000000LL);
+    ASSERT_EQ(utc.createFromDateParts(1969, 12, 31, 23, 59, 59, 999).toMillisSinceEpoch(), -1LL);
+}
+
 TEST(UTCTimeBeforeEpoch, DoesOutputFormatDate) {
     // Tuesday, Dec 30, 1969 13:42:23:211
     auto date = Date_t::fromMillisSinceEpoch(-123456789LL);
@@ -44,6 +44,7 @@
 #include "mongo/db/exec/sort.h"
 #include "mongo/db/exec/text.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/query/canonical_query_encoder.h"
 #include "mongo/db/query/collection_query_info.h"
@@ -159,6 +160,9 @@ size_t getKeysExamined(StageType type, const SpecificStats* specific) {
     } else if (STAGE_DISTINCT_SCAN == type) {
         const DistinctScanStats* spec = static_cast<const DistinctScanStats*>(specific);
         return spec->keysExamined;
+    } else if (STAGE_GROUP_COUNT_SCAN == type) {
+        const GroupCountScanStats* spec = static_cast<const GroupCountScanStats*>(specific);
+        return spec->keysExamined;
     }
 
     return 0;
@@ -209,6 +213,10 @@ void addStageSummaryStr(const PlanStage* stage, StringBuilder& sb) {
         const DistinctScanStats* spec = static_cast<const DistinctScanStats*>(specific);
         const KeyPattern keyPattern{spec->keyPattern};
         sb << " " << keyPattern;
+    } else if (STAGE_GROUP_COUNT_SCAN == stage->stageType()) {
+        const GroupCountScanStats* spec = static_cast<const GroupCountScanStats*>(specific);
+        const KeyPattern keyPattern{spec->keyPattern};
+        sb << " " << keyPattern;
     } else if (STAGE_GEO_NEAR_2D == stage->stageType()) {
         const NearStats* spec = static_cast<const NearStats*>(specific);
         const KeyPattern keyPattern{spec->keyPattern};
@@ -221,6 +229,13 @@ void addStageSummaryStr(const PlanStage* stage, StringBuilder& sb) {
         const IndexScanStats* spec = static_cast<const IndexScanStats*>(specific);
         const KeyPattern keyPattern{spec->keyPattern};
         sb << " " << keyPattern;
+    } else if (STAGE_IDHACK == stage->stageType()) {
+        // Only lookups through a unique index other than _id name the index they used.
+        const IDHackStats* spec = static_cast<const IDHackStats*>(specific);
+        if (!IndexDescriptor::isIdIndexPattern(spec->keyPattern)) {
+            const KeyPattern keyPattern{spec->keyPattern};
+            sb << " " << keyPattern;
+        }
     } else if (STAGE_TEXT == stage->stageType()) {
         const TextStats* spec = static_cast<const TextStats*>(specific);
         const KeyPattern keyPattern{spec->indexPrefix};
@@ -368,6 +383,12 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (spec->maxTs) {
             bob->append("maxTs", *(spec->maxTs));
         }
+        if (spec->minRecord) {
+            bob->append("minRecord", static_cast<long long>(spec->minRecord.get().repr()));
+        }
+        if (spec->maxRecord) {
+            bob->append("maxRecord", static_cast<long long>(spec->maxRecord.get().repr()));
+        }
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->docsTested);
         }
@@ -471,8 +492,23 @@ void Explain::statsToBSON(const PlanStageStats& stats,
             }
             intervalsBob.doneFast();
         }
+    } else if (STAGE_GROUP_COUNT_SCAN == stats.stageType) {
+        GroupCountScanStats* spec = static_cast<GroupCountScanStats*>(stats.specific.get());
+
+        bob->append("keyPattern", spec->keyPattern);
+        bob->append("indexName", spec->indexName);
+        bob->append("indexVersion", spec->indexVersion);
+
+        if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+            bob->appendNumber("keysExamined", spec->keysExamined);
+            bob->appendNumber("groupsReturned", spec->groupsReturned);
+        }
     } else if (STAGE_IDHACK == stats.stageType) {
         IDHackStats* spec = static_cast<IDHackStats*>(stats.specific.get());
+        if (!IndexDescriptor::isIdIndexPattern(spec->keyPattern)) {
+            bob->append("keyPattern", spec->keyPattern);
+            bob->append("indexName", spec->indexName);
+        }
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("keysExamined", spec->keysExamined);
             bob->appendNumber("docsExamined", spec->docsExamined);
@@ -547,6 +583,10 @@ void Explain::statsToBSON(const PlanStageStats& stats,
             bob->appendIntOrLL("limitAmount", spec->limit);
         }
 
+        if (spec->sortPrefixLength > 0) {
+            bob->appendIntOrLL("sortPrefixLength", spec->sortPrefixLength);
+        }
+
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendIntOrLL("totalDataSizeSorted", spec->totalDataSizeBytes);
             bob->appendBool("usedDisk", spec->wasDiskUsed);
@@ -809,6 +849,13 @@ void Explain::generateExecutionInfo(PlanExecutor* exec,
     const auto winningExecStats = getWinningPlanStatsTree(exec);
     generateSinglePlanExecutionInfo(winningExecStats.get(), verbosity, totalTimeMillis, &execBob);
 
+    // Report how long it took to pick the winning plan, if several plans were ranked.
+    if (const auto mps = getMultiPlanStage(exec->getRootStage())) {
+        const MultiPlanStats* multiPlanStats =
+            static_cast<const MultiPlanStats*>(mps->getSpecificStats());
+        execBob.appendNumber("planningTimeMicros", multiPlanStats->planningTimeMicros);
+    }
+
     // Also generate exec stats for all plans, if the verbosity level is high enough.
     // These stats reflect what happened during the trial period that ranked the plans.
     if (verbosity >= ExplainOptions::Verbosity::kExecAllPlans) {
@@ -1009,6 +1056,10 @@ void Explain::getSummaryStats(const PlanExecutor& exec, PlanSummaryStats* statsO
             const DistinctScanStats* distinctScanStats =
                 static_cast<const DistinctScanStats*>(distinctScan->getSpecificStats());
             statsOut->indexesUsed.insert(distinctScanStats->indexName);
+        } else if (STAGE_GROUP_COUNT_SCAN == stages[i]->stageType()) {
+            const GroupCountScanStats* groupCountScanStats =
+                static_cast<const GroupCountScanStats*>(stages[i]->getSpecificStats());
+            statsOut->indexesUsed.insert(groupCountScanStats->indexName);
         } else if (STAGE_TEXT == stages[i]->stageType()) {
             const TextStage* textStage = static_cast<const TextStage*>(stages[i]);
             const TextStats* textStats =
@@ -1027,6 +1078,9 @@ void Explain::getSummaryStats(const PlanExecutor& exec, PlanSummaryStats* statsO
             statsOut->replanned = cachedStats->replanned;
         } else if (STAGE_MULTI_PLAN == stages[i]->stageType()) {
             statsOut->fromMultiPlanner = true;
+            const MultiPlanStats* multiPlanStats =
+                static_cast<const MultiPlanStats*>(stages[i]->getSpecificStats());
+            statsOut->planningTimeMicros = multiPlanStats->planningTimeMicros;
         } else if (STAGE_COLLSCAN == stages[i]->stageType()) {
             statsOut->collectionScans++;
             const auto collScan = static_cast<const CollectionScan*>(stages[i]);
@@ -1054,6 +1108,16 @@ void Explain::planCacheEntryToBSON(const PlanCacheEntry& entry, BSONObjBuilder*
     out->append("isActive", entry.isActive);
     out->append("works", static_cast<long long>(entry.works));
 
+    BSONObjBuilder usageBob(out->subobjStart("usageStats"));
+    usageBob.append("hits", static_cast<long long>(entry.usageStats.numHits));
+    usageBob.append("inactiveLookups", static_cast<long long>(entry.usageStats.numInactiveLookups));
+    BSONObjBuilder replansBob(usageBob.subobjStart("replans"));
+    replansBob.append("worksExceeded",
+                      static_cast<long long>(entry.usageStats.numReplansWorksExceeded));
+    replansBob.append("planFailed", static_cast<long long>(entry.usageStats.numReplansPlanFailed));
+    replansBob.doneFast();
+    usageBob.doneFast();
+
     BSONObjBuilder cachedPlanBob(out->subobjStart("cachedPlan"));
     Explain::statsToBSON(
         *entry.decision->stats[0], &cachedPlanBob, ExplainOptions::Verbosity::kQueryPlanner);
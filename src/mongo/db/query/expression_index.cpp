@@ -30,13 +30,20 @@
 #include "mongo/db/query/expression_index.h"
 
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <unordered_set>
 
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/r2_region_coverer.h"
 #include "mongo/db/hasher.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/query/expression_index_knobs_gen.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/str.h"
 #include "third_party/s2/s2cellid.h"
 #include "third_party/s2/s2region.h"
 #include "third_party/s2/s2regioncoverer.h"
@@ -108,28 +115,114 @@ void ExpressionMapping::cover2d(const R2Region& region,
     GeoHashsToIntervalsWithParents(unorderedCovering, oilOut);
 }
 
-std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
-    auto minLevel = gInternalQueryS2GeoCoarsestLevel.load();
-    auto maxLevel = gInternalQueryS2GeoFinestLevel.load();
+namespace {
+
+Counter64 s2CoveringCacheHits;
+Counter64 s2CoveringCacheMisses;
+ServerStatusMetricField<Counter64> s2CoveringCacheHitsMetric("query.s2CoveringCache.hits",
+                                                             &s2CoveringCacheHits);
+ServerStatusMetricField<Counter64> s2CoveringCacheMissesMetric("query.s2CoveringCache.misses",
+                                                               &s2CoveringCacheMisses);
+
+using Covering = std::shared_ptr<const std::vector<S2CellId>>;
 
-    uassert(28739, "Geo coarsest level must be in range [0,30]", 0 <= minLevel && minLevel <= 30);
-    uassert(28740, "Geo finest level must be in range [0,30]", 0 <= maxLevel && maxLevel <= 30);
-    uassert(28741, "Geo coarsest level must be less than or equal to finest", minLevel <= maxLevel);
+Mutex s2CoveringCacheMutex = MONGO_MAKE_LATCH("ExpressionMapping::s2CoveringCacheMutex");
 
+// The size limit is a runtime setting, so the cache is created unbounded and trimmed on insert.
+LRUCache<std::string, Covering> s2CoveringCache(std::numeric_limits<std::size_t>::max());
+
+struct S2CoveringParams {
+    int minLevel;
+    int maxLevel;
+    int maxCells;
+};
+
+S2CoveringParams getS2CoveringParams() {
+    S2CoveringParams params{gInternalQueryS2GeoCoarsestLevel.load(),
+                            gInternalQueryS2GeoFinestLevel.load(),
+                            gInternalQueryS2GeoMaxCells.load()};
+
+    uassert(28739,
+            "Geo coarsest level must be in range [0,30]",
+            0 <= params.minLevel && params.minLevel <= 30);
+    uassert(28740,
+            "Geo finest level must be in range [0,30]",
+            0 <= params.maxLevel && params.maxLevel <= 30);
+    uassert(28741,
+            "Geo coarsest level must be less than or equal to finest",
+            params.minLevel <= params.maxLevel);
+    return params;
+}
+
+std::vector<S2CellId> computeS2Covering(const S2Region& region, const S2CoveringParams& params) {
     S2RegionCoverer coverer;
-    coverer.set_min_level(minLevel);
-    coverer.set_max_level(maxLevel);
-    coverer.set_max_cells(gInternalQueryS2GeoMaxCells.load());
+    coverer.set_min_level(params.minLevel);
+    coverer.set_max_level(params.maxLevel);
+    coverer.set_max_cells(params.maxCells);
 
     std::vector<S2CellId> cover;
     coverer.GetCovering(region, &cover);
     return cover;
 }
 
+/**
+ * Builds the cache key from the covering parameters followed by the raw bytes of the geometry. The
+ * parameters are delimited, so no two (parameters, geometry) pairs produce the same key.
+ */
+std::string makeS2CoveringKey(const S2CoveringParams& params, const BSONObj& geometry) {
+    std::string key = str::stream()
+        << params.minLevel << ':' << params.maxLevel << ':' << params.maxCells << ':';
+    key.append(geometry.objdata(), geometry.objsize());
+    return key;
+}
+
+}  // namespace
+
+std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
+    return computeS2Covering(region, getS2CoveringParams());
+}
+
+std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region,
+                                                             const BSONObj& geometry) {
+    const auto params = getS2CoveringParams();
+    const std::size_t maxSize = gInternalQueryS2CoveringCacheSize.load();
+    if (maxSize == 0) {
+        return computeS2Covering(region, params);
+    }
+
+    const std::string key = makeS2CoveringKey(params, geometry);
+    {
+        stdx::lock_guard<Latch> lk(s2CoveringCacheMutex);
+        auto it = s2CoveringCache.find(key);
+        if (it != s2CoveringCache.end()) {
+            s2CoveringCacheHits.increment();
+            return *it->second;
+        }
+    }
+
+    // Compute the covering outside of the mutex. Concurrent misses on the same key may each
+    // compute it, in which case the last one inserted is kept.
+    s2CoveringCacheMisses.increment();
+    auto cover = std::make_shared<const std::vector<S2CellId>>(computeS2Covering(region, params));
+
+    stdx::lock_guard<Latch> lk(s2CoveringCacheMutex);
+    s2CoveringCache.add(key, cover);
+    while (s2CoveringCache.size() > maxSize) {
+        s2CoveringCache.erase(std::prev(s2CoveringCache.end()));
+    }
+    return *cover;
+}
+
+void ExpressionMapping::clear2dsphereCoveringCacheForTest() {
+    stdx::lock_guard<Latch> lk(s2CoveringCacheMutex);
+    s2CoveringCache.clear();
+}
+
 void ExpressionMapping::cover2dsphere(const S2Region& region,
+                                      const BSONObj& geometry,
                                       const S2IndexingParams& indexingParams,
                                       OrderedIntervalList* oilOut) {
-    std::vector<S2CellId> cover = get2dsphereCovering(region);
+    std::vector<S2CellId> cover = get2dsphereCovering(region, geometry);
     S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
 }
 
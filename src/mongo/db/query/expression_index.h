@@ -65,6 +65,21 @@ public:
 
     static std::vector<S2CellId> get2dsphereCovering(const S2Region& region);
 
+    /**
+     * Returns the covering of 'region', which was parsed from the query geometry 'geometry'.
+     *
+     * Coverings are kept in a process-wide cache of up to 'internalQueryS2CoveringCacheSize'
+     * entries keyed by the geometry and the covering parameters, evicted in least recently used
+     * order, so that queries repeating the same geometry compute its covering once.
+     */
+    static std::vector<S2CellId> get2dsphereCovering(const S2Region& region,
+                                                     const BSONObj& geometry);
+
+    /**
+     * Empties the covering cache. For testing.
+     */
+    static void clear2dsphereCoveringCacheForTest();
+
     static void S2CellIdsToIntervals(const std::vector<S2CellId>& intervalSet,
                                      const S2IndexVersion indexVersion,
                                      OrderedIntervalList* oilOut);
@@ -76,6 +91,7 @@ public:
                                                 OrderedIntervalList* out);
 
     static void cover2dsphere(const S2Region& region,
+                              const BSONObj& geometry,
                               const S2IndexingParams& indexParams,
                               OrderedIntervalList* oilOut);
 };
@@ -0,0 +1,102 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/expression_index.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/query/expression_index_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "third_party/s2/s2cellid.h"
+#include "third_party/s2/s2latlng.h"
+#include "third_party/s2/s2latlngrect.h"
+
+namespace mongo {
+namespace {
+
+S2LatLngRect makeRect(double lo, double hi) {
+    return S2LatLngRect(S2LatLng::FromDegrees(lo, lo), S2LatLng::FromDegrees(hi, hi));
+}
+
+TEST(S2CoveringCacheTest, CachedCoveringMatchesComputedCovering) {
+    ExpressionMapping::clear2dsphereCoveringCacheForTest();
+    const auto rect = makeRect(0, 1);
+    const BSONObj geometry = BSON("rect" << BSON_ARRAY(0 << 1));
+
+    const auto expected = ExpressionMapping::get2dsphereCovering(rect);
+    ASSERT_FALSE(expected.empty());
+    ASSERT(ExpressionMapping::get2dsphereCovering(rect, geometry) == expected);
+    ASSERT(ExpressionMapping::get2dsphereCovering(rect, geometry) == expected);
+}
+
+TEST(S2CoveringCacheTest, DifferentGeometriesAreCachedSeparately) {
+    ExpressionMapping::clear2dsphereCoveringCacheForTest();
+    const auto small = makeRect(0, 1);
+    const auto large = makeRect(0, 20);
+
+    const auto smallCover =
+        ExpressionMapping::get2dsphereCovering(small, BSON("rect" << BSON_ARRAY(0 << 1)));
+    const auto largeCover =
+        ExpressionMapping::get2dsphereCovering(large, BSON("rect" << BSON_ARRAY(0 << 20)));
+    ASSERT(smallCover == ExpressionMapping::get2dsphereCovering(small));
+    ASSERT(largeCover == ExpressionMapping::get2dsphereCovering(large));
+    ASSERT(smallCover != largeCover);
+}
+
+TEST(S2CoveringCacheTest, CoveringParametersArePartOfTheKey) {
+    ExpressionMapping::clear2dsphereCoveringCacheForTest();
+    const auto rect = makeRect(0, 1);
+    const BSONObj geometry = BSON("rect" << BSON_ARRAY(0 << 1));
+    ExpressionMapping::get2dsphereCovering(rect, geometry);
+
+    const auto originalFinestLevel = gInternalQueryS2GeoFinestLevel.load();
+    gInternalQueryS2GeoFinestLevel.store(5);
+    const auto coarseCover = ExpressionMapping::get2dsphereCovering(rect, geometry);
+    gInternalQueryS2GeoFinestLevel.store(originalFinestLevel);
+
+    for (auto&& cell : coarseCover) {
+        ASSERT_LTE(cell.level(), 5);
+    }
+    ASSERT(coarseCover != ExpressionMapping::get2dsphereCovering(rect, geometry));
+}
+
+TEST(S2CoveringCacheTest, ZeroSizeDisablesTheCache) {
+    ExpressionMapping::clear2dsphereCoveringCacheForTest();
+    const auto originalSize = gInternalQueryS2CoveringCacheSize.load();
+    gInternalQueryS2CoveringCacheSize.store(0);
+    const auto rect = makeRect(0, 1);
+    ASSERT(ExpressionMapping::get2dsphereCovering(rect, BSON("rect" << 1)) ==
+           ExpressionMapping::get2dsphereCovering(rect));
+    gInternalQueryS2CoveringCacheSize.store(originalSize);
+}
+
+}  // namespace
+}  // namespace mongo
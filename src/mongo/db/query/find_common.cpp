@@ -33,6 +33,8 @@
 
 #include "mongo/db/query/find_common.h"
 
+#include <algorithm>
+
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/curop_failpoint_helpers.h"
@@ -76,6 +78,25 @@ bool FindCommon::haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int
     return (bytesBuffered + nextDoc.objsize()) <= kMaxBytesToReturnToClientAtOnce;
 }
 
+std::size_t FindCommon::estimateRemainingFirstBatchBytes(const QueryRequest& qr,
+                                                         long long numDocs,
+                                                         int bytesBuffered) {
+    invariant(numDocs > 0);
+    const long long batchSize = qr.getEffectiveBatchSize()
+        ? qr.getEffectiveBatchSize().value()
+        : static_cast<long long>(QueryRequest::kDefaultBatchSize);
+    const long long remainingDocs = std::max(batchSize - numDocs, 0LL);
+    const long long remainingBudget =
+        std::max(static_cast<long long>(kMaxBytesToReturnToClientAtOnce) - bytesBuffered, 0LL);
+
+    // Divide before multiplying, since a batchSize can be large enough to overflow otherwise.
+    const long long avgDocSize = bytesBuffered / numDocs + 1;
+    if (remainingDocs > remainingBudget / avgDocSize) {
+        return remainingBudget;
+    }
+    return remainingDocs * avgDocSize;
+}
+
 void FindCommon::waitInFindBeforeMakingBatch(OperationContext* opCtx, const CanonicalQuery& cq) {
     auto whileWaitingFunc = [&, hasLogged = false]() mutable {
         if (!std::exchange(hasLogged, true)) {
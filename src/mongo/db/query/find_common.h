@@ -116,6 +116,16 @@ public:
      */
     static bool haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int bytesBuffered);
 
+    /**
+     * Given the number of docs ('numDocs') and bytes ('bytesBuffered') in an initial find batch
+     * that has outgrown kInitReplyBufferSize, returns how many more bytes the rest of the batch is
+     * likely to need, judging by the average size of the documents so far. The estimate never
+     * exceeds what is left of the kMaxBytesToReturnToClientAtOnce budget.
+     */
+    static std::size_t estimateRemainingFirstBatchBytes(const QueryRequest& qr,
+                                                        long long numDocs,
+                                                        int bytesBuffered);
+
     /**
      * This function wraps waitWhileFailPointEnabled() on waitInFindBeforeMakingBatch.
      *
@@ -59,12 +59,15 @@
 #include "mongo/db/index_names.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
+#include "mongo/db/operation_trace.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/canonical_query_encoder.h"
+#include "mongo/db/query/cardinality_estimation.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/db/query/indexability.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_executor.h"
@@ -276,6 +279,15 @@ void fillOutPlannerParams(OperationContext* opCtx,
         plannerParams->options |= QueryPlannerParams::INDEX_INTERSECTION;
     }
 
+    if (internalQueryPlannerEnableIndexSkipScan.load()) {
+        if (auto indexStats = CollectionQueryInfo::get(collection).getIndexStatistics(opCtx)) {
+            for (auto&& indexNameAndStats : *indexStats) {
+                plannerParams->leadingFieldDistinctValues[indexNameAndStats.first] =
+                    indexNameAndStats.second.distinctValues.estimate();
+            }
+        }
+    }
+
     if (internalQueryPlannerGenerateCoveredWholeIndexScans.load()) {
         plannerParams->options |= QueryPlannerParams::GENERATE_COVERED_IXSCANS;
     }
@@ -318,6 +330,49 @@ bool shouldWaitForOplogVisibility(OperationContext* opCtx,
 
 namespace {
 
+/**
+ * Returns the descriptor of a unique, single-field btree index among the planner's candidate
+ * indexes which answers 'query' with a single key lookup, or nullptr if there is none. This is the
+ * case when the query is a simple equality to a scalar on that top-level field, and the index has
+ * the query's collation and no partial filter.
+ */
+const IndexDescriptor* getUniqueIndexForPointQuery(OperationContext* opCtx,
+                                                   Collection* collection,
+                                                   const CanonicalQuery& query,
+                                                   const QueryPlannerParams& plannerParams) {
+    const QueryRequest& qr = query.getQueryRequest();
+    if (qr.showRecordId() || qr.returnKey() || !qr.getHint().isEmpty() || !qr.getMin().isEmpty() ||
+        !qr.getMax().isEmpty() || qr.getSkip() || qr.isTailable()) {
+        return nullptr;
+    }
+
+    const BSONObj& filter = qr.getFilter();
+    if (filter.nFields() != 1) {
+        return nullptr;
+    }
+
+    // Null equality also matches missing fields and objects may be query operators, so neither
+    // maps to exactly one key.
+    const BSONElement elt = filter.firstElement();
+    const StringData fieldName = elt.fieldNameStringData();
+    if (fieldName.startsWith("$") || fieldName.find('.') != std::string::npos ||
+        elt.type() == BSONType::Object || !Indexability::isExactBoundsGenerating(elt)) {
+        return nullptr;
+    }
+
+    for (auto&& index : plannerParams.indices) {
+        if (!index.unique || index.filterExpr || index.type != IndexType::INDEX_BTREE ||
+            index.keyPattern.nFields() != 1 ||
+            index.keyPattern.firstElementFieldNameStringData() != fieldName ||
+            !CollatorInterface::collatorsMatch(query.getCollator(), index.collator)) {
+            continue;
+        }
+        return collection->getIndexCatalog()->findIndexByName(opCtx,
+                                                              index.identifier.catalogName);
+    }
+    return nullptr;
+}
+
 struct PrepareExecutionResult {
     PrepareExecutionResult(unique_ptr<CanonicalQuery> canonicalQuery,
                            unique_ptr<QuerySolution> querySolution,
@@ -349,6 +404,7 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
                                                     unique_ptr<CanonicalQuery> canonicalQuery,
                                                     size_t plannerOptions) {
     invariant(canonicalQuery);
+    OperationTrace::Span planSpan(opCtx, "plan");
     unique_ptr<PlanStage> root;
 
     // This can happen as we're called by internal clients as well.
@@ -373,10 +429,17 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
     }
 
     const IndexDescriptor* descriptor = collection->getIndexCatalog()->findIdIndex(opCtx);
+    if (!descriptor || !IDHackStage::supportsQuery(collection, *canonicalQuery)) {
+        // An equality lookup on another unique index can take the same path as one on _id.
+        descriptor = internalQueryAllowIdHackOnUniqueIndexes.load()
+            ? getUniqueIndexForPointQuery(opCtx, collection, *canonicalQuery, plannerParams)
+            : nullptr;
+    }
 
-    // If we have an _id index we can use an idhack plan.
-    if (descriptor && IDHackStage::supportsQuery(collection, *canonicalQuery)) {
-        LOG(2) << "Using idhack: " << redact(canonicalQuery->toStringShort());
+    // If we have an _id index or a suitable unique index we can use an idhack plan.
+    if (descriptor) {
+        LOG(2) << "Using idhack: " << redact(canonicalQuery->toStringShort())
+               << ", index: " << descriptor->indexName();
 
         root = std::make_unique<IDHackStage>(opCtx, canonicalQuery.get(), ws, descriptor);
 
@@ -541,6 +604,29 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
         return PrepareExecutionResult(
             std::move(canonicalQuery), std::move(solutions[0]), std::move(root));
     } else {
+        if (internalQueryPlannerEnableCardinalityEstimation.load()) {
+            // A plan that is guaranteed, or by sampled statistics all but certain, to examine very
+            // few documents costs less to run than a trial period would, so there is nothing for
+            // multi-planning to find.
+            const auto indexStats = CollectionQueryInfo::get(collection).getIndexStatistics(opCtx);
+            if (auto chosen = cardinality_estimation::chooseSolution(
+                    solutions,
+                    static_cast<long long>(collection->numRecords(opCtx)),
+                    internalQueryCardinalityEstimationMaxDocs.load(),
+                    indexStats.get())) {
+                auto root = StageBuilder::build(
+                    opCtx, collection, *canonicalQuery, *solutions[*chosen], ws);
+
+                LOG(2) << "Plan chosen by cardinality estimation; it will be run but will not be "
+                          "cached. "
+                       << redact(canonicalQuery->toStringShort())
+                       << ", planSummary: " << Explain::getPlanSummary(root.get());
+
+                return PrepareExecutionResult(
+                    std::move(canonicalQuery), std::move(solutions[*chosen]), std::move(root));
+            }
+        }
+
         // Many solutions. Create a MultiPlanStage to pick the best, update the cache,
         // and so on. The working set will be shared by all candidate plans.
         auto multiPlanStage =
@@ -0,0 +1,373 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/index_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/bson/bsonelement_comparator_interface.h"
+#include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/hasher.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+int compareValues(const BSONElement& lhs, const BSONElement& rhs) {
+    return lhs.woCompare(rhs, false);
+}
+
+std::uint64_t hashValue(const BSONElement& value) {
+    return static_cast<std::uint64_t>(
+        BSONElementHasher::hash64(value, BSONElementHasher::DEFAULT_HASH_SEED));
+}
+
+std::string getStringField(const BSONObj& obj, StringData fieldName) {
+    const auto elem = obj[fieldName];
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << "'" << fieldName << "' must be a string",
+            elem.type() == String);
+    return elem.str();
+}
+
+long long getNumberField(const BSONObj& obj, StringData fieldName) {
+    const auto elem = obj[fieldName];
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << "'" << fieldName << "' must be a number",
+            elem.isNumber());
+    const long long value = elem.safeNumberLong();
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "'" << fieldName << "' must not be negative",
+            value >= 0);
+    return value;
+}
+
+BSONObj getObjectField(const BSONObj& obj, StringData fieldName, BSONType type) {
+    const auto elem = obj[fieldName];
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << "'" << fieldName << "' must be of type " << typeName(type),
+            elem.type() == type);
+    return elem.Obj();
+}
+
+}  // namespace
+
+void HyperLogLog::add(std::uint64_t hash) {
+    const size_t index = hash >> (64 - kPrecision);
+    const std::uint64_t remaining = hash << kPrecision;
+    const int rank = remaining == 0 ? 64 - kPrecision + 1 : countLeadingZeros64(remaining) + 1;
+    _registers[index] = std::max(_registers[index], static_cast<std::uint8_t>(rank));
+}
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+    for (size_t i = 0; i < kNumRegisters; ++i) {
+        _registers[i] = std::max(_registers[i], other._registers[i]);
+    }
+}
+
+double HyperLogLog::estimate() const {
+    const double m = static_cast<double>(kNumRegisters);
+    const double alpha = 0.7213 / (1.0 + 1.079 / m);
+
+    double sum = 0.0;
+    size_t numZeroRegisters = 0;
+    for (auto reg : _registers) {
+        sum += std::ldexp(1.0, -static_cast<int>(reg));
+        if (reg == 0) {
+            ++numZeroRegisters;
+        }
+    }
+
+    const double estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && numZeroRegisters > 0) {
+        // Small cardinalities are more accurately estimated by linear counting.
+        return m * std::log(m / static_cast<double>(numZeroRegisters));
+    }
+    return estimate;
+}
+
+void HyperLogLog::serialize(StringData fieldName, BSONObjBuilder* builder) const {
+    builder->appendBinData(fieldName, kNumRegisters, BinDataGeneral, _registers.data());
+}
+
+HyperLogLog HyperLogLog::parse(const BSONElement& elem) {
+    int length = 0;
+    const char* data = elem.type() == BinData ? elem.binData(length) : nullptr;
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << "'" << elem.fieldNameStringData() << "' must be a " << kNumRegisters
+                          << " byte binary",
+            data && static_cast<size_t>(length) == kNumRegisters);
+
+    HyperLogLog sketch;
+    std::copy(data, data + kNumRegisters, sketch._registers.begin());
+    return sketch;
+}
+
+EquiDepthHistogram EquiDepthHistogram::build(const std::vector<BSONObj>& sortedValues,
+                                             size_t maxBuckets) {
+    EquiDepthHistogram histogram;
+    if (sortedValues.empty()) {
+        return histogram;
+    }
+
+    const size_t numValues = sortedValues.size();
+    maxBuckets = std::max(maxBuckets, size_t{1});
+    const long long depth = static_cast<long long>((numValues + maxBuckets - 1) / maxBuckets);
+
+    histogram._min = sortedValues.front();
+    histogram._totalCount = static_cast<long long>(numValues);
+
+    Bucket current;
+    for (size_t i = 0; i < numValues; ++i) {
+        const auto value = sortedValues[i].firstElement();
+        if (current.count == 0 ||
+            compareValues(value, current.upperBound.firstElement()) != 0) {
+            current.upperBound = sortedValues[i];
+            current.upperBoundCount = 0;
+            ++current.numDistinct;
+        }
+        ++current.count;
+        ++current.upperBoundCount;
+
+        // Only close a bucket after the last occurrence of a value.
+        const bool lastOccurrence = i + 1 == numValues ||
+            compareValues(sortedValues[i + 1].firstElement(), value) != 0;
+        if (lastOccurrence && current.count >= depth) {
+            histogram._buckets.push_back(std::move(current));
+            current = Bucket();
+        }
+    }
+
+    if (current.count > 0) {
+        histogram._buckets.push_back(std::move(current));
+    }
+    return histogram;
+}
+
+long long EquiDepthHistogram::estimateCount(const Interval& interval) const {
+    BSONElement low = interval.start;
+    BSONElement high = interval.end;
+    bool lowInclusive = interval.startInclusive;
+    bool highInclusive = interval.endInclusive;
+    if (compareValues(low, high) > 0) {
+        // Intervals on descending indexes run from high to low.
+        std::swap(low, high);
+        std::swap(lowInclusive, highInclusive);
+    }
+
+    long long count = 0;
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+        const auto& bucket = _buckets[i];
+        const auto upperBound = bucket.upperBound.firstElement();
+
+        // The first bucket covers [min, upperBound], the others (previous upperBound, upperBound].
+        const int highVsLowerBound = i == 0
+            ? compareValues(high, _min.firstElement())
+            : compareValues(high, _buckets[i - 1].upperBound.firstElement());
+        if (highVsLowerBound < 0 || (i > 0 && highVsLowerBound == 0)) {
+            // This bucket and all the following ones are past the interval.
+            break;
+        }
+
+        const int lowVsUpperBound = compareValues(low, upperBound);
+        if (lowVsUpperBound > 0) {
+            continue;
+        }
+
+        if (lowVsUpperBound == 0) {
+            count += lowInclusive ? bucket.upperBoundCount : 0;
+            continue;
+        }
+
+        const int highVsUpperBound = compareValues(high, upperBound);
+        if (highVsUpperBound < 0 || (highVsUpperBound == 0 && !highInclusive)) {
+            count += bucket.count - bucket.upperBoundCount;
+        } else {
+            count += bucket.count;
+        }
+    }
+    return count;
+}
+
+void EquiDepthHistogram::serialize(BSONObjBuilder* builder) const {
+    if (!_min.isEmpty()) {
+        builder->appendAs(_min.firstElement(), "min");
+    }
+
+    BSONArrayBuilder bucketsBuilder(builder->subarrayStart("buckets"));
+    for (auto&& bucket : _buckets) {
+        BSONObjBuilder bucketBuilder(bucketsBuilder.subobjStart());
+        bucketBuilder.appendAs(bucket.upperBound.firstElement(), "upperBound");
+        bucketBuilder.append("count", bucket.count);
+        bucketBuilder.append("upperBoundCount", bucket.upperBoundCount);
+        bucketBuilder.append("numDistinct", bucket.numDistinct);
+    }
+}
+
+EquiDepthHistogram EquiDepthHistogram::parse(const BSONObj& obj) {
+    EquiDepthHistogram histogram;
+    if (auto min = obj["min"]) {
+        histogram._min = min.wrap("");
+    }
+
+    for (auto&& elem : getObjectField(obj, "buckets", Array)) {
+        uassert(ErrorCodes::TypeMismatch, "histogram buckets must be objects", elem.isABSONObj());
+        const BSONObj bucketObj = elem.Obj();
+        const auto upperBound = bucketObj["upperBound"];
+        uassert(ErrorCodes::NoSuchKey, "histogram bucket has no 'upperBound'", upperBound);
+
+        Bucket bucket;
+        bucket.upperBound = upperBound.wrap("");
+        bucket.count = getNumberField(bucketObj, "count");
+        bucket.upperBoundCount = getNumberField(bucketObj, "upperBoundCount");
+        bucket.numDistinct = getNumberField(bucketObj, "numDistinct");
+        uassert(ErrorCodes::BadValue,
+                "histogram bucket holds fewer values than are equal to its upper bound",
+                bucket.upperBoundCount <= bucket.count);
+        histogram._totalCount += bucket.count;
+        histogram._buckets.push_back(std::move(bucket));
+    }
+
+    uassert(ErrorCodes::BadValue,
+            "histogram has buckets but no 'min'",
+            histogram._buckets.empty() || !histogram._min.isEmpty());
+    return histogram;
+}
+
+IndexStatistics IndexStatistics::build(const std::string& indexName,
+                                       const BSONObj& keyPattern,
+                                       const std::vector<BSONObj>& sampledDocs,
+                                       long long numRecords,
+                                       size_t maxBuckets) {
+    IndexStatistics stats;
+    stats.indexName = indexName;
+    stats.keyPattern = keyPattern.getOwned();
+    stats.field = keyPattern.firstElementFieldName();
+    stats.numRecords = numRecords;
+    stats.numSampledDocs = static_cast<long long>(sampledDocs.size());
+
+    const BSONObj nullValue = BSON("" << BSONNULL);
+    std::vector<BSONObj> values;
+    values.reserve(sampledDocs.size());
+    for (auto&& doc : sampledDocs) {
+        // Index keys are generated per array element, with missing fields indexed as null.
+        BSONElementSet elements;
+        dotted_path_support::extractAllElementsAlongPath(doc, stats.field, elements);
+        if (elements.empty()) {
+            values.push_back(nullValue);
+            stats.distinctValues.add(hashValue(nullValue.firstElement()));
+        }
+        for (auto&& element : elements) {
+            values.push_back(element.wrap(""));
+            stats.distinctValues.add(hashValue(element));
+        }
+    }
+
+    std::sort(values.begin(), values.end(), [](const BSONObj& lhs, const BSONObj& rhs) {
+        return compareValues(lhs.firstElement(), rhs.firstElement()) < 0;
+    });
+    stats.numSampledKeys = static_cast<long long>(values.size());
+    stats.histogram = EquiDepthHistogram::build(values, maxBuckets);
+    return stats;
+}
+
+long long IndexStatistics::estimateDocs(const OrderedIntervalList& oil,
+                                        long long numRecords) const {
+    return estimateDocsUpperBound(oil, numRecords, 0.0);
+}
+
+long long IndexStatistics::estimateDocsUpperBound(const OrderedIntervalList& oil,
+                                                  long long numRecords,
+                                                  double numStdDevs) const {
+    if (numSampledKeys == 0) {
+        return numRecords;
+    }
+
+    long long matchingKeys = 0;
+    for (auto&& interval : oil.intervals) {
+        matchingKeys += histogram.estimateCount(interval);
+    }
+
+    // The standard error of a sampled proportion is sqrt(p * (1 - p) / n). It is taken to be at
+    // least that of a single key in the sample, so that a range matching no sampled keys is not
+    // assumed to match no documents at all.
+    const double numKeys = static_cast<double>(numSampledKeys);
+    double fraction = static_cast<double>(matchingKeys) / numKeys;
+    const double variance = std::max(fraction * (1.0 - fraction), 1.0 / numKeys);
+    fraction = std::min(1.0, fraction + numStdDevs * std::sqrt(variance / numKeys));
+
+    // Scale the matching fraction of sampled keys up to the collection. Each matching document
+    // contributes at least one matching key, so this stays an upper bound for array fields.
+    const double keysPerDoc = numKeys / static_cast<double>(numSampledDocs);
+    const double estimate = std::ceil(fraction * keysPerDoc * static_cast<double>(numRecords));
+    return std::min(numRecords, static_cast<long long>(estimate));
+}
+
+BSONObj IndexStatistics::toBSON() const {
+    BSONObjBuilder builder;
+    builder.append("index", indexName);
+    builder.append("keyPattern", keyPattern);
+    builder.append("field", field);
+    builder.append("numRecords", numRecords);
+    builder.append("numSampledDocs", numSampledDocs);
+    builder.append("numSampledKeys", numSampledKeys);
+    builder.append("distinctValues", distinctValues.estimate());
+    distinctValues.serialize("distinctValuesSketch", &builder);
+    {
+        BSONObjBuilder histogramBuilder(builder.subobjStart("histogram"));
+        histogram.serialize(&histogramBuilder);
+    }
+    return builder.obj();
+}
+
+IndexStatistics IndexStatistics::parse(const BSONObj& obj) {
+    IndexStatistics stats;
+    stats.indexName = getStringField(obj, "index");
+    stats.keyPattern = getObjectField(obj, "keyPattern", Object).getOwned();
+    stats.field = getStringField(obj, "field");
+    stats.numRecords = getNumberField(obj, "numRecords");
+    stats.numSampledDocs = getNumberField(obj, "numSampledDocs");
+    stats.numSampledKeys = getNumberField(obj, "numSampledKeys");
+    stats.distinctValues = HyperLogLog::parse(obj["distinctValuesSketch"]);
+    stats.histogram = EquiDepthHistogram::parse(getObjectField(obj, "histogram", Object));
+
+    uassert(ErrorCodes::BadValue,
+            "index statistics must sample at least one key per document",
+            stats.numSampledKeys == 0 ||
+                (stats.numSampledDocs > 0 && stats.numSampledKeys >= stats.numSampledDocs));
+    return stats;
+}
+
+}  // namespace mongo
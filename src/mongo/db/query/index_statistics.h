@@ -0,0 +1,181 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/query/index_bounds.h"
+#include "mongo/db/query/interval.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * A HyperLogLog sketch estimating the number of distinct values it has been fed. Sketches built
+ * from different samples of the same field can be merged.
+ */
+class HyperLogLog {
+public:
+    static constexpr int kPrecision = 10;
+    static constexpr size_t kNumRegisters = size_t{1} << kPrecision;
+
+    void add(std::uint64_t hash);
+
+    void merge(const HyperLogLog& other);
+
+    double estimate() const;
+
+    void serialize(StringData fieldName, BSONObjBuilder* builder) const;
+
+    /**
+     * Parses a sketch written by serialize(). Throws if 'elem' does not hold one.
+     */
+    static HyperLogLog parse(const BSONElement& elem);
+
+private:
+    std::array<std::uint8_t, kNumRegisters> _registers{};
+};
+
+/**
+ * An equi-depth histogram over sampled values of a single field. Each bucket holds roughly the
+ * same number of sampled values and covers the range (previous upper bound, upper bound]. A value
+ * never straddles two buckets, so the number of samples equal to each bucket's upper bound is
+ * tracked exactly.
+ */
+class EquiDepthHistogram {
+public:
+    struct Bucket {
+        // A single-field object holding the largest value in the bucket.
+        BSONObj upperBound;
+
+        // Number of sampled values in the bucket, including those equal to 'upperBound'.
+        long long count = 0;
+
+        // Number of sampled values equal to 'upperBound'.
+        long long upperBoundCount = 0;
+
+        long long numDistinct = 0;
+    };
+
+    /**
+     * Builds a histogram of at most 'maxBuckets' buckets. 'sortedValues' holds single-field
+     * objects in ascending order of their values.
+     */
+    static EquiDepthHistogram build(const std::vector<BSONObj>& sortedValues, size_t maxBuckets);
+
+    /**
+     * Returns an upper bound on the number of sampled values which fall inside 'interval'.
+     */
+    long long estimateCount(const Interval& interval) const;
+
+    long long getTotalCount() const {
+        return _totalCount;
+    }
+
+    const std::vector<Bucket>& getBuckets() const {
+        return _buckets;
+    }
+
+    void serialize(BSONObjBuilder* builder) const;
+
+    /**
+     * Parses a histogram written by serialize(). Throws if 'obj' does not hold one.
+     */
+    static EquiDepthHistogram parse(const BSONObj& obj);
+
+private:
+    // A single-field object holding the smallest sampled value.
+    BSONObj _min;
+    std::vector<Bucket> _buckets;
+    long long _totalCount = 0;
+};
+
+/**
+ * Data distribution statistics for the leading field of an index, computed from a sample of the
+ * collection's documents.
+ */
+struct IndexStatistics {
+    /**
+     * Builds statistics for the leading field of 'keyPattern' from 'sampledDocs'. 'numRecords' is
+     * the size of the collection the documents were sampled from.
+     */
+    static IndexStatistics build(const std::string& indexName,
+                                 const BSONObj& keyPattern,
+                                 const std::vector<BSONObj>& sampledDocs,
+                                 long long numRecords,
+                                 size_t maxBuckets);
+
+    /**
+     * Returns an estimated upper bound on the number of documents, out of 'numRecords', whose
+     * leading index field falls inside any interval of 'oil'.
+     */
+    long long estimateDocs(const OrderedIntervalList& oil, long long numRecords) const;
+
+    /**
+     * Like estimateDocs(), but widens the matching fraction of the sample by 'numStdDevs' standard
+     * errors, so that the true number of matching documents is unlikely to exceed the result even
+     * though only a sample was examined.
+     */
+    long long estimateDocsUpperBound(const OrderedIntervalList& oil,
+                                     long long numRecords,
+                                     double numStdDevs) const;
+
+    BSONObj toBSON() const;
+
+    /**
+     * Parses statistics written by toBSON(). Throws if 'obj' does not hold them.
+     */
+    static IndexStatistics parse(const BSONObj& obj);
+
+    std::string indexName;
+    BSONObj keyPattern;
+    std::string field;
+
+    // The size of the collection when the sample was taken.
+    long long numRecords = 0;
+    long long numSampledDocs = 0;
+
+    // Greater than 'numSampledDocs' when the field holds arrays.
+    long long numSampledKeys = 0;
+
+    EquiDepthHistogram histogram;
+    HyperLogLog distinctValues;
+};
+
+// Index statistics keyed by index name.
+using IndexStatisticsMap = StringMap<IndexStatistics>;
+
+}  // namespace mongo
@@ -0,0 +1,238 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/index_statistics.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/hasher.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+Interval makePoint(int value) {
+    return Interval(BSON("" << value << "" << value), true, true);
+}
+
+Interval makeRange(int start, int end, bool startInclusive = true, bool endInclusive = true) {
+    return Interval(BSON("" << start << "" << end), startInclusive, endInclusive);
+}
+
+std::vector<BSONObj> makeSortedValues(const std::vector<int>& values) {
+    std::vector<BSONObj> ret;
+    for (auto value : values) {
+        ret.push_back(BSON("" << value));
+    }
+    return ret;
+}
+
+TEST(HyperLogLogTest, EstimatesDistinctValues) {
+    HyperLogLog sketch;
+    ASSERT_EQ(0.0, sketch.estimate());
+
+    for (int i = 0; i < 10000; ++i) {
+        const auto value = BSON("" << i);
+        const auto hash = static_cast<std::uint64_t>(BSONElementHasher::hash64(
+            value.firstElement(), BSONElementHasher::DEFAULT_HASH_SEED));
+        // Adding every value twice must not change the estimate.
+        sketch.add(hash);
+        sketch.add(hash);
+    }
+    ASSERT_APPROX_EQUAL(10000.0, sketch.estimate(), 1000.0);
+}
+
+TEST(HyperLogLogTest, MergingSketches) {
+    HyperLogLog lhs;
+    HyperLogLog rhs;
+    for (int i = 0; i < 1000; ++i) {
+        const auto value = BSON("" << i);
+        const auto hash = static_cast<std::uint64_t>(BSONElementHasher::hash64(
+            value.firstElement(), BSONElementHasher::DEFAULT_HASH_SEED));
+        (i % 2 ? lhs : rhs).add(hash);
+    }
+    lhs.merge(rhs);
+    ASSERT_APPROX_EQUAL(1000.0, lhs.estimate(), 100.0);
+}
+
+TEST(EquiDepthHistogramTest, BucketsHoldEqualNumbersOfValues) {
+    std::vector<int> values;
+    for (int i = 1; i <= 100; ++i) {
+        values.push_back(i);
+    }
+    auto histogram = EquiDepthHistogram::build(makeSortedValues(values), 10);
+
+    ASSERT_EQ(100, histogram.getTotalCount());
+    ASSERT_EQ(10u, histogram.getBuckets().size());
+    for (auto&& bucket : histogram.getBuckets()) {
+        ASSERT_EQ(10, bucket.count);
+        ASSERT_EQ(1, bucket.upperBoundCount);
+        ASSERT_EQ(10, bucket.numDistinct);
+    }
+
+    // Points.
+    ASSERT_EQ(1, histogram.estimateCount(makePoint(10)));
+    ASSERT_EQ(9, histogram.estimateCount(makePoint(5)));
+    ASSERT_EQ(0, histogram.estimateCount(makePoint(0)));
+    ASSERT_EQ(0, histogram.estimateCount(makePoint(101)));
+
+    // Ranges.
+    ASSERT_EQ(100, histogram.estimateCount(makeRange(1, 100)));
+    ASSERT_EQ(10, histogram.estimateCount(makeRange(11, 20)));
+    ASSERT_EQ(9, histogram.estimateCount(makeRange(11, 20, true, false)));
+    ASSERT_EQ(19, histogram.estimateCount(makeRange(15, 25)));
+
+    // Descending index bounds.
+    ASSERT_EQ(10, histogram.estimateCount(makeRange(20, 11)));
+}
+
+TEST(EquiDepthHistogramTest, FrequentValuesDoNotStraddleBuckets) {
+    std::vector<int> values;
+    for (int i = 1; i <= 10; ++i) {
+        values.push_back(i);
+    }
+    values.insert(values.begin() + 5, 50, 5);
+
+    auto histogram = EquiDepthHistogram::build(makeSortedValues(values), 6);
+    ASSERT_EQ(60, histogram.getTotalCount());
+
+    // Every occurrence of the frequent value lands in the same bucket, as its upper bound.
+    ASSERT_EQ(51, histogram.estimateCount(makePoint(5)));
+    ASSERT_EQ(1, histogram.estimateCount(makePoint(10)));
+}
+
+TEST(EquiDepthHistogramTest, EmptyHistogram) {
+    auto histogram = EquiDepthHistogram::build({}, 10);
+    ASSERT_EQ(0, histogram.getTotalCount());
+    ASSERT_EQ(0, histogram.estimateCount(makePoint(1)));
+}
+
+TEST(IndexStatisticsTest, EstimatesScaleToTheCollection) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 100; ++i) {
+        docs.push_back(BSON("_id" << i << "a" << i % 10));
+    }
+    auto stats = IndexStatistics::build("a_1", BSON("a" << 1), docs, 1000, 64);
+    ASSERT_EQ(100, stats.numSampledDocs);
+    ASSERT_EQ(100, stats.numSampledKeys);
+    ASSERT_APPROX_EQUAL(10.0, stats.distinctValues.estimate(), 1.0);
+
+    OrderedIntervalList oil("a");
+    oil.intervals.push_back(makePoint(3));
+    ASSERT_EQ(100, stats.estimateDocs(oil, 1000));
+
+    oil.intervals.push_back(makePoint(7));
+    ASSERT_EQ(200, stats.estimateDocs(oil, 1000));
+}
+
+TEST(IndexStatisticsTest, ArrayAndMissingValues) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 10; ++i) {
+        docs.push_back(BSON("a" << BSON_ARRAY(1 << 2)));
+    }
+    for (int i = 0; i < 10; ++i) {
+        docs.push_back(BSON("b" << 1));
+    }
+    auto stats = IndexStatistics::build("a_1", BSON("a" << 1), docs, 20, 64);
+    ASSERT_EQ(20, stats.numSampledDocs);
+    ASSERT_EQ(30, stats.numSampledKeys);
+
+    // Half of the documents hold the value 1.
+    OrderedIntervalList oil("a");
+    oil.intervals.push_back(makePoint(1));
+    ASSERT_EQ(10, stats.estimateDocs(oil, 20));
+
+    // Missing fields are indexed as null.
+    OrderedIntervalList nullOil("a");
+    nullOil.intervals.push_back(Interval(BSON("" << BSONNULL << "" << BSONNULL), true, true));
+    ASSERT_EQ(10, stats.estimateDocs(nullOil, 20));
+}
+
+TEST(IndexStatisticsTest, Serialization) {
+    std::vector<BSONObj> docs{BSON("a" << 1), BSON("a" << 2)};
+    auto obj = IndexStatistics::build("a_1", BSON("a" << 1), docs, 2, 64).toBSON();
+    ASSERT_EQ("a_1", obj["index"].str());
+    ASSERT_EQ("a", obj["field"].str());
+    ASSERT_EQ(2, obj["numSampledDocs"].numberLong());
+    ASSERT_EQ(BinData, obj["distinctValuesSketch"].type());
+    ASSERT_EQ(1, obj["histogram"]["min"].numberInt());
+    ASSERT_EQ(2u, obj["histogram"]["buckets"].Array().size());
+}
+
+TEST(IndexStatisticsTest, ParsesSerializedStatistics) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 100; ++i) {
+        docs.push_back(BSON("a" << i % 10));
+    }
+    auto stats = IndexStatistics::build("a_1", BSON("a" << 1), docs, 1000, 4);
+    auto parsed = IndexStatistics::parse(stats.toBSON());
+    ASSERT_EQ("a_1", parsed.indexName);
+    ASSERT_BSONOBJ_EQ(BSON("a" << 1), parsed.keyPattern);
+    ASSERT_EQ("a", parsed.field);
+    ASSERT_EQ(1000, parsed.numRecords);
+    ASSERT_EQ(100, parsed.numSampledDocs);
+    ASSERT_EQ(100, parsed.numSampledKeys);
+    ASSERT_EQ(stats.histogram.getBuckets().size(), parsed.histogram.getBuckets().size());
+    ASSERT_EQ(stats.histogram.getTotalCount(), parsed.histogram.getTotalCount());
+    ASSERT_EQ(stats.distinctValues.estimate(), parsed.distinctValues.estimate());
+
+    OrderedIntervalList oil("a");
+    oil.intervals.push_back(makePoint(3));
+    ASSERT_EQ(stats.estimateDocs(oil, 1000), parsed.estimateDocs(oil, 1000));
+
+    ASSERT_THROWS_CODE(IndexStatistics::parse(BSON("index"
+                                                   << "a_1")),
+                       AssertionException,
+                       ErrorCodes::TypeMismatch);
+}
+
+TEST(IndexStatisticsTest, UpperBoundWidensSampledEstimates) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 100; ++i) {
+        docs.push_back(BSON("a" << i));
+    }
+    auto stats = IndexStatistics::build("a_1", BSON("a" << 1), docs, 1000, 10);
+
+    OrderedIntervalList oil("a");
+    oil.intervals.push_back(makeRange(10, 19));
+    ASSERT_EQ(100, stats.estimateDocs(oil, 1000));
+    ASSERT_EQ(100, stats.estimateDocsUpperBound(oil, 1000, 0.0));
+    ASSERT_GT(stats.estimateDocsUpperBound(oil, 1000, 3.0), 100);
+
+    // A range holding no sampled values may still match unsampled documents.
+    OrderedIntervalList emptyOil("a");
+    emptyOil.intervals.push_back(makeRange(1000, 2000));
+    ASSERT_EQ(0, stats.estimateDocs(emptyOil, 1000));
+    ASSERT_GT(stats.estimateDocsUpperBound(emptyOil, 1000, 3.0), 0);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -62,6 +62,23 @@ namespace {
 ServerStatusMetricField<Counter64> totalPlanCacheSizeEstimateBytesMetric(
     "query.planCacheTotalSizeEstimateBytes", &PlanCacheEntry::planCacheTotalSizeEstimateBytes);
 
+// Process-wide counters of how queries were served by the plan cache.
+Counter64 planCacheHits;
+Counter64 planCacheMisses;
+Counter64 planCacheInactiveLookups;
+Counter64 planCacheReplansWorksExceeded;
+Counter64 planCacheReplansPlanFailed;
+
+ServerStatusMetricField<Counter64> planCacheHitsMetric("query.planCache.hits", &planCacheHits);
+ServerStatusMetricField<Counter64> planCacheMissesMetric("query.planCache.misses",
+                                                         &planCacheMisses);
+ServerStatusMetricField<Counter64> planCacheInactiveLookupsMetric(
+    "query.planCache.inactiveLookups", &planCacheInactiveLookups);
+ServerStatusMetricField<Counter64> planCacheReplansWorksExceededMetric(
+    "query.planCache.replans.worksExceeded", &planCacheReplansWorksExceeded);
+ServerStatusMetricField<Counter64> planCacheReplansPlanFailedMetric(
+    "query.planCache.replans.planFailed", &planCacheReplansPlanFailed);
+
 // Delimiters for cache key encoding.
 const char kEncodeDiscriminatorsBegin = '<';
 const char kEncodeDiscriminatorsEnd = '>';
@@ -242,7 +259,8 @@ std::unique_ptr<PlanCacheEntry> PlanCacheEntry::create(
         std::move(decision),
         {},
         isActive,
-        works));
+        works,
+        {}));
 }
 
 PlanCacheEntry::PlanCacheEntry(std::vector<std::unique_ptr<const SolutionCacheData>> plannerData,
@@ -256,7 +274,8 @@ PlanCacheEntry::PlanCacheEntry(std::vector<std::unique_ptr<const SolutionCacheDa
                                std::unique_ptr<const PlanRankingDecision> decision,
                                std::vector<double> feedback,
                                const bool isActive,
-                               const size_t works)
+                               const size_t works,
+                               const UsageStats usageStats)
     : plannerData(std::move(plannerData)),
       query(query),
       sort(sort),
@@ -269,6 +288,7 @@ PlanCacheEntry::PlanCacheEntry(std::vector<std::unique_ptr<const SolutionCacheDa
       feedback(std::move(feedback)),
       isActive(isActive),
       works(works),
+      usageStats(usageStats),
       _entireObjectSize(_estimateObjectSizeInBytes()) {
     // Account for the object in the global metric for estimating the server's total plan cache
     // memory consumption.
@@ -298,7 +318,8 @@ std::unique_ptr<PlanCacheEntry> PlanCacheEntry::clone() const {
                                                               std::move(decisionPtr),
                                                               feedback,
                                                               isActive,
-                                                              works));
+                                                              works,
+                                                              usageStats));
 }
 
 uint64_t PlanCacheEntry::_estimateObjectSizeInBytes() const {
@@ -435,15 +456,57 @@ PlanCache::PlanCache(size_t size) : _cache(size) {}
 PlanCache::~PlanCache() {}
 
 std::unique_ptr<CachedSolution> PlanCache::getCacheEntryIfActive(const PlanCacheKey& key) const {
+    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    PlanCacheEntry* entry = nullptr;
+    Status cacheStatus = _cache.get(key, &entry);
+    if (!cacheStatus.isOK()) {
+        invariant(cacheStatus == ErrorCodes::NoSuchKey);
+        planCacheMisses.increment();
+        return nullptr;
+    }
+    invariant(entry);
 
-    PlanCache::GetResult res = get(key);
-    if (res.state == PlanCache::CacheEntryState::kPresentInactive) {
-        LOG(2) << "Not using cached entry for " << redact(res.cachedSolution->toString())
+    if (!entry->isActive) {
+        ++entry->usageStats.numInactiveLookups;
+        planCacheInactiveLookups.increment();
+        LOG(2) << "Not using cached entry for " << redact(entry->toString())
                << " since it is inactive";
         return nullptr;
     }
 
-    return std::move(res.cachedSolution);
+    ++entry->usageStats.numHits;
+    planCacheHits.increment();
+    return std::make_unique<CachedSolution>(key, *entry);
+}
+
+void PlanCache::notifyOfReplan(const CanonicalQuery& query, ReplanReason reason) {
+    switch (reason) {
+        case ReplanReason::kWorksExceeded:
+            planCacheReplansWorksExceeded.increment();
+            break;
+        case ReplanReason::kPlanFailed:
+            planCacheReplansPlanFailed.increment();
+            break;
+    }
+
+    PlanCacheKey key = computeKey(query);
+    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    PlanCacheEntry* entry = nullptr;
+    Status cacheStatus = _cache.get(key, &entry);
+    if (!cacheStatus.isOK()) {
+        invariant(cacheStatus == ErrorCodes::NoSuchKey);
+        return;
+    }
+    invariant(entry);
+
+    switch (reason) {
+        case ReplanReason::kWorksExceeded:
+            ++entry->usageStats.numReplansWorksExceeded;
+            break;
+        case ReplanReason::kPlanFailed:
+            ++entry->usageStats.numReplansPlanFailed;
+            break;
+    }
 }
 
 /**
@@ -557,15 +620,15 @@ Status PlanCache::set(const CanonicalQuery& query,
     bool isNewEntryActive = false;
     uint32_t queryHash;
     uint32_t planCacheKey;
+    PlanCacheEntry* oldEntry = nullptr;
+    Status cacheStatus = _cache.get(key, &oldEntry);
+    invariant(cacheStatus.isOK() || cacheStatus == ErrorCodes::NoSuchKey);
     if (internalQueryCacheDisableInactiveEntries.load()) {
         // All entries are always active.
         isNewEntryActive = true;
         planCacheKey = canonical_query_encoder::computeHash(key.stringData());
         queryHash = canonical_query_encoder::computeHash(key.getStableKeyStringData());
     } else {
-        PlanCacheEntry* oldEntry = nullptr;
-        Status cacheStatus = _cache.get(key, &oldEntry);
-        invariant(cacheStatus.isOK() || cacheStatus == ErrorCodes::NoSuchKey);
         if (oldEntry) {
             queryHash = oldEntry->queryHash;
             planCacheKey = oldEntry->planCacheKey;
@@ -591,6 +654,11 @@ Status PlanCache::set(const CanonicalQuery& query,
     auto newEntry(PlanCacheEntry::create(
         solns, std::move(why), query, queryHash, planCacheKey, now, isNewEntryActive, newWorks));
 
+    // The usage counters describe the query shape, so they survive the replacement of its plan.
+    if (oldEntry) {
+        newEntry->usageStats = oldEntry->usageStats;
+    }
+
     std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(key, newEntry.release());
 
     if (nullptr != evictedEntry.get()) {
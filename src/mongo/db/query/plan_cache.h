@@ -378,6 +378,27 @@ public:
     // cause this value to be increased.
     size_t works = 0;
 
+    /**
+     * Counters describing how queries of this shape have been served by the cache. They are
+     * carried over when the entry is replaced by a newer plan for the same shape, so they describe
+     * the shape rather than one particular plan. Protected by the plan cache mutex.
+     */
+    struct UsageStats {
+        // Number of times the entry was active and its plan was used without multi-planning.
+        uint64_t numHits = 0;
+
+        // Number of times the entry was found inactive, causing the query to be multi-planned.
+        uint64_t numInactiveLookups = 0;
+
+        // Number of times a CachedPlanStage replanned because the cached plan exceeded its trial
+        // period works budget.
+        uint64_t numReplansWorksExceeded = 0;
+
+        // Number of times a CachedPlanStage replanned because the cached plan failed.
+        uint64_t numReplansPlanFailed = 0;
+    };
+    UsageStats usageStats;
+
     /**
      * Tracks the approximate cumulative size of the plan cache entries across all the collections.
      */
@@ -398,7 +419,8 @@ private:
                    std::unique_ptr<const PlanRankingDecision> decision,
                    std::vector<double> feedback,
                    bool isActive,
-                   size_t works);
+                   size_t works,
+                   UsageStats usageStats);
 
     // Ensure that PlanCacheEntry is non-copyable.
     PlanCacheEntry(const PlanCacheEntry&) = delete;
@@ -516,6 +538,21 @@ public:
      */
     std::unique_ptr<CachedSolution> getCacheEntryIfActive(const PlanCacheKey& key) const;
 
+    /**
+     * The reasons for which a CachedPlanStage may abandon a cached plan and replan the query.
+     */
+    enum class ReplanReason {
+        // The cached plan did not finish its trial period within its works budget.
+        kWorksExceeded,
+        // The cached plan failed during its trial period.
+        kPlanFailed,
+    };
+
+    /**
+     * Records that a query of the shape of 'query' was replanned for 'reason'. Does nothing if the
+     * shape has no entry in the cache.
+     */
+    void notifyOfReplan(const CanonicalQuery& query, ReplanReason reason);
 
     /**
      * When the CachedPlanStage runs a plan out of the cache, we want to record data about the
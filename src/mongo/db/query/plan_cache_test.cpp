@@ -631,6 +631,45 @@ TEST(PlanCacheTest, AddActiveCacheEntry) {
     ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kNotPresent);
 }
 
+TEST(PlanCacheTest, UsageStatsTrackLookupsAndReplans) {
+    PlanCache planCache;
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+    const auto key = planCache.computeKey(*cq);
+
+    // Lookups of an uncached shape and replans of it are not attributed to any entry.
+    ASSERT_FALSE(planCache.getCacheEntryIfActive(key));
+    planCache.notifyOfReplan(*cq, PlanCache::ReplanReason::kPlanFailed);
+    ASSERT_EQUALS(planCache.size(), 0U);
+
+    QueryTestServiceContext serviceContext;
+    ASSERT_OK(planCache.set(*cq, solns, createDecision(1U, 20), Date_t{}));
+    ASSERT_FALSE(planCache.getCacheEntryIfActive(key));
+    auto entry = assertGet(planCache.getEntry(*cq));
+    ASSERT_EQ(entry->usageStats.numHits, 0U);
+    ASSERT_EQ(entry->usageStats.numInactiveLookups, 1U);
+
+    // Promoting the entry to active keeps the counters accumulated for the shape.
+    ASSERT_OK(planCache.set(*cq, solns, createDecision(1U, 10), Date_t{}));
+    ASSERT_TRUE(planCache.getCacheEntryIfActive(key));
+    ASSERT_TRUE(planCache.getCacheEntryIfActive(key));
+    planCache.notifyOfReplan(*cq, PlanCache::ReplanReason::kWorksExceeded);
+    planCache.notifyOfReplan(*cq, PlanCache::ReplanReason::kPlanFailed);
+    planCache.notifyOfReplan(*cq, PlanCache::ReplanReason::kPlanFailed);
+
+    entry = assertGet(planCache.getEntry(*cq));
+    ASSERT_EQ(entry->usageStats.numHits, 2U);
+    ASSERT_EQ(entry->usageStats.numInactiveLookups, 1U);
+    ASSERT_EQ(entry->usageStats.numReplansWorksExceeded, 1U);
+    ASSERT_EQ(entry->usageStats.numReplansPlanFailed, 2U);
+
+    // Plain get() calls, as used by the plan cache commands, are not counted as lookups.
+    ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kPresentActive);
+    entry = assertGet(planCache.getEntry(*cq));
+    ASSERT_EQ(entry->usageStats.numHits, 2U);
+}
+
 TEST(PlanCacheTest, WorksValueIncreases) {
     PlanCache planCache;
     unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
@@ -1255,6 +1294,25 @@ TEST_F(CachePlanSelectionTest, EqualityIndexScanWithTrailingFields) {
 // Geo
 //
 
+TEST_F(CachePlanSelectionTest, IndexScansRecoveredAmongUnrelatedIndexes) {
+    addIndex(BSON("a" << 1), "a_1");
+    addIndex(BSON("x" << 1), "x_1");
+    addIndex(BSON("b" << 1 << "c" << 1), "b_1_c_1");
+    addIndex(BSON("y" << 1), "y_1");
+    addIndex(BSON("d" << 1), "d_1");
+
+    runQuery(BSON("x" << 5));
+    assertPlanCacheRecoversSolution(BSON("x" << 5),
+                                    "{fetch: {filter: null, node: {ixscan: {pattern: {x: 1}}}}}");
+
+    BSONObj query = fromjson("{$or: [{x: 1}, {y: 2}]}");
+    runQuery(query);
+    assertPlanCacheRecoversSolution(query,
+                                    "{fetch: {filter: null, node: {or: {nodes: ["
+                                    "{ixscan: {pattern: {x: 1}}}, "
+                                    "{ixscan: {pattern: {y: 1}}}]}}}}");
+}
+
 TEST_F(CachePlanSelectionTest, Basic2DSphereNonNear) {
     addIndex(BSON("a"
                   << "2dsphere"),
@@ -2030,6 +2088,16 @@ TEST(PlanCacheTest, StableKeyDoesNotChangeAcrossIndexCreation) {
     ASSERT_EQ(postIndexKey.getUnstablePart(), "<1>");
 }
 
+TEST(PlanCacheTest, ComputeKeyInListsOfDifferentSizesShareKey) {
+    PlanCache planCache;
+
+    // The cached plan is parameterized over the $in list: the index bounds are rebuilt from the
+    // literals of each query, so the number of elements is not part of the shape.
+    unique_ptr<CanonicalQuery> inTwo(canonicalize("{a: {$in: [1, 2]}}"));
+    unique_ptr<CanonicalQuery> inFive(canonicalize("{a: {$in: [5, 4, 3, 2, 1]}}"));
+    ASSERT_EQ(planCache.computeKey(*inTwo), planCache.computeKey(*inFive));
+}
+
 TEST(PlanCacheTest, ComputeKeyNotEqualsArray) {
     PlanCache planCache;
     unique_ptr<CanonicalQuery> cqNeArray(canonicalize("{a: {$ne: [1]}}"));
@@ -51,15 +51,19 @@
 #include "mongo/db/exec/trial_stage.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/operation_trace.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/mock_yield_policies.h"
 #include "mongo/db/query/plan_yield_policy.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/stacktrace.h"
+#include "mongo/util/str.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -81,6 +85,34 @@ namespace {
 MONGO_FAIL_POINT_DEFINE(planExecutorAlwaysFails);
 MONGO_FAIL_POINT_DEFINE(planExecutorHangBeforeShouldWaitForInserts);
 
+/**
+ * Records a span for the stage described by 'stats' and for each of its descendants, nested like
+ * the plan. A stage only accumulates its execution time, in milliseconds, so each span is recorded
+ * at 'disposeMicros' and carries that time as its executionTimeMillis attribute, rather than
+ * being given start and end times which were never measured.
+ */
+void addStageSpans(OperationTrace* trace,
+                   const PlanStageStats& stats,
+                   long long disposeMicros,
+                   boost::optional<uint64_t> parentSpanId) {
+    const auto& common = stats.common;
+    const auto spanId =
+        trace->addCompletedSpan(str::stream() << "stage:" << common.stageTypeStr,
+                                disposeMicros,
+                                disposeMicros,
+                                BSON("executionTimeMillis"
+                                     << common.executionTimeMillis << "works"
+                                     << static_cast<long long>(common.works) << "advanced"
+                                     << static_cast<long long>(common.advanced) << "needTime"
+                                     << static_cast<long long>(common.needTime) << "needYield"
+                                     << static_cast<long long>(common.needYield) << "isEOF"
+                                     << common.isEOF),
+                                parentSpanId);
+    for (const auto& child : stats.children) {
+        addStageSpans(trace, *child, disposeMicros, spanId);
+    }
+}
+
 /**
  * Constructs a PlanYieldPolicy based on 'policy'.
  */
@@ -334,6 +366,11 @@ void PlanExecutorImpl::saveState() {
     if (!isMarkedAsKilled()) {
         _root->saveState();
     }
+
+    // Buffered results may refer to storage engine memory which does not survive the save.
+    for (size_t i = _resultBatchPos; i < _resultBatch.size(); ++i) {
+        _workingSet->get(_resultBatch[i])->makeObjOwnedIfNeeded();
+    }
     _currentState = kSaved;
 }
 
@@ -554,7 +591,7 @@ PlanExecutor::ExecState PlanExecutorImpl::_getNextImpl(Snapshotted<Document>* ob
         }
 
         WorkingSetID id = WorkingSet::INVALID_ID;
-        PlanStage::StageState code = _root->work(&id);
+        PlanStage::StageState code = _workRoot(&id);
 
         if (code != PlanStage::NEED_YIELD)
             writeConflictsInARow = 0;
@@ -649,9 +686,43 @@ PlanExecutor::ExecState PlanExecutorImpl::_getNextImpl(Snapshotted<Document>* ob
     }
 }
 
+PlanStage::StageState PlanExecutorImpl::_workRoot(WorkingSetID* out) {
+    if (_resultBatchPos < _resultBatch.size()) {
+        *out = _resultBatch[_resultBatchPos++];
+        return PlanStage::ADVANCED;
+    }
+
+    if (_resultBatchState) {
+        const auto state = _resultBatchState->first;
+        *out = _resultBatchState->second;
+        _resultBatchState = boost::none;
+        return state;
+    }
+
+    const size_t batchSize = internalQueryExecWorkBatchSize.load();
+    if (batchSize <= 1) {
+        return _root->work(out);
+    }
+
+    _resultBatch.clear();
+    _resultBatchPos = 0;
+    WorkingSetID stateId = WorkingSet::INVALID_ID;
+    const PlanStage::StageState state = _root->workBatch(batchSize, &_resultBatch, &stateId);
+    if (_resultBatch.empty()) {
+        *out = stateId;
+        return state;
+    }
+
+    if (PlanStage::ADVANCED != state && PlanStage::NEED_TIME != state) {
+        _resultBatchState = std::make_pair(state, stateId);
+    }
+    *out = _resultBatch[_resultBatchPos++];
+    return PlanStage::ADVANCED;
+}
+
 bool PlanExecutorImpl::isEOF() {
     invariant(_currentState == kUsable);
-    return isMarkedAsKilled() || (_stash.empty() && _root->isEOF());
+    return isMarkedAsKilled() || (_stash.empty() && !_hasBufferedBatch() && _root->isEOF());
 }
 
 void PlanExecutorImpl::markAsKilled(Status killStatus) {
@@ -667,6 +738,13 @@ void PlanExecutorImpl::dispose(OperationContext* opCtx) {
         return;
     }
 
+    if (opCtx && OperationTrace::get(opCtx).isActive()) {
+        addStageSpans(&OperationTrace::get(opCtx),
+                      *_root->getStats(),
+                      static_cast<long long>(curTimeMicros64()),
+                      boost::none);
+    }
+
     _root->dispose(opCtx);
     _currentState = kDisposed;
 }
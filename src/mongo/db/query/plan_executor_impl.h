@@ -31,7 +31,11 @@
 
 #include <boost/optional.hpp>
 #include <queue>
+#include <utility>
+#include <vector>
 
+#include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/working_set.h"
 #include "mongo/db/query/plan_executor.h"
 
 namespace mongo {
@@ -155,6 +159,24 @@ private:
      */
     ExecState _getNextImpl(Snapshotted<Document>* objOut, RecordId* dlOut);
 
+    /**
+     * Performs a unit of work on '_root' on behalf of _getNextImpl(), with the same contract as
+     * PlanStage::work().
+     *
+     * When 'internalQueryExecWorkBatchSize' is greater than one, the plan is worked a batch at a
+     * time via PlanStage::workBatch(), and the results of each batch are buffered and handed out
+     * one per call before the plan is worked again.
+     */
+    PlanStage::StageState _workRoot(WorkingSetID* out);
+
+    /**
+     * Returns true if results or a state from the most recent batch are still waiting to be
+     * returned from _workRoot().
+     */
+    bool _hasBufferedBatch() const {
+        return _resultBatchPos < _resultBatch.size() || _resultBatchState;
+    }
+
     // The OperationContext that we're executing within. This can be updated if necessary by using
     // detachFromOperationContext() and reattachToOperationContext().
     OperationContext* _opCtx;
@@ -189,6 +211,13 @@ private:
     // stages.
     std::queue<Document> _stash;
 
+    // The results of the most recent call to PlanStage::workBatch() on '_root', of which those
+    // from '_resultBatchPos' onwards have not been returned yet, and the state which ended that
+    // batch if it was IS_EOF, NEED_YIELD or FAILURE. See _workRoot().
+    std::vector<WorkingSetID> _resultBatch;
+    size_t _resultBatchPos = 0;
+    boost::optional<std::pair<PlanStage::StageState, WorkingSetID>> _resultBatchState;
+
     // The output document that is used by getNext BSON API. This allows us to avoid constantly
     // allocating and freeing DocumentStorage.
     Document _docOutput;
@@ -71,6 +71,10 @@ struct PlanSummaryStats {
     // candidates?
     bool fromMultiPlanner = false;
 
+    // The number of microseconds the MultiPlanStage spent picking the winning plan, if the plan
+    // came from the multi-planner.
+    long long planningTimeMicros = 0;
+
     // Was a replan triggered during the execution of this query?
     bool replanned = false;
 };
@@ -37,6 +37,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/wait_events.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/time_support.h"
@@ -176,6 +177,9 @@ void PlanYieldPolicy::_yieldAllLocks(OperationContext* opCtx,
         return;
     }
 
+    // The yield lasts until the locks are reacquired, once this function returns.
+    ScopedWaitEvent waitEvent(opCtx, WaitEvent::kYield);
+
     // Top-level locks are freed, release any potential low-level (storage engine-specific
     // locks). If we are yielding, we are at a safe place to do so.
     opCtx->recoveryUnit()->abandonSnapshot();
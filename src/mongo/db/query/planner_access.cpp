@@ -67,6 +67,31 @@ bool isTextNode(const QuerySolutionNode* node) {
     return STAGE_TEXT == node->getType();
 }
 
+/**
+ * Returns true if the leaf predicate 'expr' is over a field of the regular btree index 'index' and
+ * can be evaluated correctly against the index keys alone.
+ */
+bool canEvaluateFromIndexKeys(const MatchExpression* expr, const IndexEntry& index) {
+    // Keys of a multikey index hold single array elements, and keys of an index with a collation
+    // hold collation keys rather than the original strings.
+    if (INDEX_BTREE != index.type || index.multikey || index.collator ||
+        expr->getCategory() != MatchExpression::MatchCategory::kLeaf ||
+        MatchExpression::GEO == expr->matchType() ||
+        !Indexability::nodeCanUseIndexOnOwnField(expr)) {
+        return false;
+    }
+
+    for (auto&& elt : index.keyPattern) {
+        if (elt.fieldNameStringData() == expr->path()) {
+            OrderedIntervalList oil;
+            IndexBoundsBuilder::BoundsTightness tightness;
+            IndexBoundsBuilder::translate(expr, elt, index, &oil, &tightness);
+            return tightness >= IndexBoundsBuilder::INEXACT_COVERED;
+        }
+    }
+    return false;
+}
+
 /**
  * Casts 'node' to a FetchNode* if it is a FetchNode, otherwise returns null.
  */
@@ -1336,8 +1361,6 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::scanWholeIndex(
     const CanonicalQuery& query,
     const QueryPlannerParams& params,
     int direction) {
-    std::unique_ptr<QuerySolutionNode> solnRoot;
-
     // Build an ixscan over the id index, use it, and return it.
     unique_ptr<IndexScanNode> isn = std::make_unique<IndexScanNode>(index);
     isn->addKeyMetadata = query.getQueryRequest().returnKey();
@@ -1350,21 +1373,46 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::scanWholeIndex(
         isn->direction = -1;
     }
 
-    unique_ptr<MatchExpression> filter = query.root()->shallowClone();
+    return filterIndexScan(index, std::move(isn), query.root()->shallowClone());
+}
 
-    // If it's find({}) remove the no-op root.
-    if (MatchExpression::AND == filter->matchType() && (0 == filter->numChildren())) {
-        solnRoot = std::move(isn);
-    } else {
-        // TODO: We may not need to do the fetch if the predicates in root are covered.  But
-        // for now it's safe (though *maybe* slower).
-        unique_ptr<FetchNode> fetch = std::make_unique<FetchNode>();
-        fetch->filter = std::move(filter);
-        fetch->children.push_back(isn.release());
-        solnRoot = std::move(fetch);
+std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::filterIndexScan(
+    const IndexEntry& index,
+    std::unique_ptr<IndexScanNode> isn,
+    std::unique_ptr<MatchExpression> filter) {
+    // Evaluating the covered predicates on the keys matters most when the scan provides a sort and
+    // the query has a limit: the scan then stops after fetching little more than the documents
+    // returned, rather than one document per key it reads.
+    if (MatchExpression::AND == filter->matchType()) {
+        auto children = filter->getChildVector();
+        for (auto it = children->begin(); it != children->end();) {
+            if (canEvaluateFromIndexKeys(*it, index)) {
+                // Takes ownership.
+                addFilterToSolutionNode(isn.get(), *it, MatchExpression::AND);
+                it = children->erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        if (children->empty()) {
+            // It was find({}), or every predicate is covered.
+            return std::move(isn);
+        } else if (children->size() == 1) {
+            // An $and of one thing is that thing.
+            MatchExpression* child = children->front();
+            children->clear();
+            filter.reset(child);
+        }
+    } else if (canEvaluateFromIndexKeys(filter.get(), index)) {
+        isn->filter = std::move(filter);
+        return std::move(isn);
     }
 
-    return solnRoot;
+    auto fetch = std::make_unique<FetchNode>();
+    fetch->filter = std::move(filter);
+    fetch->children.push_back(isn.release());
+    return std::move(fetch);
 }
 
 void QueryPlannerAccess::addFilterToSolutionNode(QuerySolutionNode* node,
@@ -1467,8 +1515,6 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeIndexScan(
     const QueryPlannerParams& params,
     const BSONObj& startKey,
     const BSONObj& endKey) {
-    std::unique_ptr<QuerySolutionNode> solnRoot;
-
     // Build an ixscan over the id index, use it, and return it.
     auto isn = std::make_unique<IndexScanNode>(index);
     isn->direction = 1;
@@ -1479,21 +1525,7 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeIndexScan(
     isn->bounds.boundInclusion = BoundInclusion::kIncludeStartKeyOnly;
     isn->queryCollator = query.getCollator();
 
-    unique_ptr<MatchExpression> filter = query.root()->shallowClone();
-
-    // If it's find({}) remove the no-op root.
-    if (MatchExpression::AND == filter->matchType() && (0 == filter->numChildren())) {
-        solnRoot = std::move(isn);
-    } else {
-        // TODO: We may not need to do the fetch if the predicates in root are covered.  But
-        // for now it's safe (though *maybe* slower).
-        unique_ptr<FetchNode> fetch = std::make_unique<FetchNode>();
-        fetch->filter = std::move(filter);
-        fetch->children.push_back(isn.release());
-        solnRoot = std::move(fetch);
-    }
-
-    return solnRoot;
+    return filterIndexScan(index, std::move(isn), query.root()->shallowClone());
 }
 
 }  // namespace mongo
@@ -400,6 +400,18 @@ private:
                                         MatchExpression* match,
                                         MatchExpression::MatchType type);
 
+    /**
+     * Applies 'filter', a clone of the whole query predicate, to the index scan 'isn' which
+     * returns every key within its bounds. The predicates which can be evaluated from the keys of
+     * 'index' become a filter of the index scan, so that only the documents passing them are
+     * fetched. The rest are applied by a FETCH above the scan, which is only added when some are
+     * left. Returns the root of the resulting tree.
+     */
+    static std::unique_ptr<QuerySolutionNode> filterIndexScan(
+        const IndexEntry& index,
+        std::unique_ptr<IndexScanNode> isn,
+        std::unique_ptr<MatchExpression> filter);
+
     /**
      * Once a predicate is merged into the current scan, there are a few things we might
      * want to do with the filter:
@@ -390,6 +390,35 @@ std::unique_ptr<ProjectionNode> analyzeProjection(const CanonicalQuery& query,
         *query.root(),
         *query.getProj());
 }
+
+/**
+ * Returns the length of the longest proper prefix of 'sortObj' by which 'solnRoot' already sorts
+ * its output, or zero if it provides no such prefix. If only the reverse of the prefix is provided,
+ * reverses the scans beneath 'solnRoot' so that the prefix itself is provided.
+ */
+size_t analyzeProvidedSortPrefix(const BSONObj& sortObj, QuerySolutionNode* solnRoot) {
+    const BSONObjSet& sorts = solnRoot->getSort();
+    for (size_t prefixLength = sortObj.nFields() - 1; prefixLength > 0; --prefixLength) {
+        BSONObjBuilder prefixBob;
+        BSONObjIterator it(sortObj);
+        for (size_t i = 0; i < prefixLength; ++i) {
+            prefixBob.append(it.next());
+        }
+        BSONObj prefix = prefixBob.obj();
+
+        if (sorts.end() != sorts.find(prefix)) {
+            return prefixLength;
+        }
+
+        if (sorts.end() != sorts.find(QueryPlannerCommon::reverseSortObj(prefix))) {
+            QueryPlannerCommon::reverseScans(solnRoot);
+            LOG(5) << "Reversing ixscan to provide sort prefix. Result: "
+                   << redact(solnRoot->toString());
+            return prefixLength;
+        }
+    }
+    return 0;
+}
 }  // namespace
 
 // static
@@ -617,7 +646,9 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         return solnRoot;
     }
 
-    // If we're here, we need to add a sort stage.
+    // If we're here, we need to add a sort stage. If solnRoot provides a prefix of the sort, the
+    // sort stage only has to order each run of results with equal values for that prefix.
+    const size_t sortPrefixLength = analyzeProvidedSortPrefix(sortObj, solnRoot);
 
     if (!solnRoot->fetched()) {
         const bool sortIsCovered =
@@ -645,6 +676,7 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
 
     SortNode* sort = new SortNode();
     sort->pattern = sortObj;
+    sort->sortPrefixLength = sortPrefixLength;
     sort->children.push_back(solnRoot);
     solnRoot = sort;
     // When setting the limit on the sort, we need to consider both
@@ -712,6 +744,15 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         sort->limit = 0;
     }
 
+    // A top-k sort on the text score alone directly above a TEXT stage only needs the highest
+    // scoring documents, which the TEXT stage can find from the index keys without fetching the
+    // other candidates.
+    QuerySolutionNode* sortInput = keyGenNode->children[0];
+    if (sort->limit > 0 && STAGE_TEXT == sortInput->getType() && sortObj.nFields() == 1 &&
+        QueryRequest::isTextScoreMeta(sortObj.firstElement())) {
+        static_cast<TextNode*>(sortInput)->limit = sort->limit;
+    }
+
     *blockingSortOut = true;
 
     return solnRoot;
@@ -47,6 +47,7 @@
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_enumerator.h"
 #include "mongo/db/query/planner_access.h"
@@ -291,6 +292,105 @@ bool providesSort(const CanonicalQuery& query, const BSONObj& kp) {
     return query.getQueryRequest().getSort().isPrefixOf(kp, SimpleBSONElementComparator::kInstance);
 }
 
+/**
+ * Builds a solution which answers 'query' with an index scan over 'indexes[indexPos]' whose bounds
+ * come from the predicates over the index's second field, leaving the leading field unbounded. The
+ * index scan seeks to the start of those bounds within each distinct value of the leading field and
+ * past the rest of that value once it leaves them, so the cost of the scan grows with the number of
+ * distinct leading values. Returns nullptr if no top-level predicate can bound the second field.
+ */
+std::unique_ptr<QuerySolution> buildSkipScanSoln(const CanonicalQuery& query,
+                                                 const QueryPlannerParams& params,
+                                                 const std::vector<IndexEntry>& indexes,
+                                                 size_t indexPos) {
+    const IndexEntry& index = indexes[indexPos];
+    BSONObjIterator kpIt(index.keyPattern);
+    kpIt.next();
+    const std::string secondField = kpIt.next().fieldName();
+
+    // Find the predicates that the planner considers compatible with the second field of the
+    // index, using the relevance tags assigned by index selection.
+    std::unique_ptr<MatchExpression> clone = query.root()->shallowClone();
+    QueryPlannerIXSelect::rateIndices(clone.get(), "", indexes, query.getCollator());
+
+    std::vector<MatchExpression*> leaves;
+    if (MatchExpression::AND == clone->matchType()) {
+        for (size_t i = 0; i < clone->numChildren(); ++i) {
+            leaves.push_back(clone->getChild(i));
+        }
+    } else {
+        leaves.push_back(clone.get());
+    }
+
+    std::vector<MatchExpression*> boundedLeaves;
+    for (auto&& leaf : leaves) {
+        const auto* relevantTag = static_cast<const RelevantTag*>(leaf->getTag());
+        if (!relevantTag || relevantTag->path != secondField ||
+            std::find(relevantTag->notFirst.begin(), relevantTag->notFirst.end(), indexPos) ==
+                relevantTag->notFirst.end()) {
+            continue;
+        }
+        boundedLeaves.push_back(leaf);
+
+        // Bounds from several predicates over a multikey field cannot be intersected.
+        if (index.multikey) {
+            break;
+        }
+    }
+    clone->resetTag();
+
+    if (boundedLeaves.empty()) {
+        return nullptr;
+    }
+    for (auto&& leaf : boundedLeaves) {
+        leaf->setTag(new IndexTag(indexPos, 1, !index.multikey));
+    }
+
+    auto statusWithCacheData = QueryPlanner::cacheDataFromTaggedTree(clone.get(), indexes);
+    prepareForAccessPlanning(clone.get());
+
+    std::unique_ptr<QuerySolutionNode> solnRoot(
+        QueryPlannerAccess::buildIndexedDataAccess(query, std::move(clone), indexes, params));
+    if (!solnRoot) {
+        return nullptr;
+    }
+
+    auto soln = QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
+    if (soln && statusWithCacheData.isOK()) {
+        SolutionCacheData* scd = new SolutionCacheData();
+        scd->tree = std::move(statusWithCacheData.getValue());
+        soln->cacheData.reset(scd);
+    }
+    return soln;
+}
+
+/**
+ * Returns whether 'query' can be answered by a skip scan over 'index': a compound btree index
+ * whose leading field 'query' does not constrain and which, according to its sampled statistics,
+ * has few enough distinct leading values that seeking past each of them is cheaper than a
+ * collection scan.
+ */
+bool canUseSkipScan(const CanonicalQuery& query,
+                    const QueryPlannerParams& params,
+                    const stdx::unordered_set<std::string>& fields,
+                    const IndexEntry& index) {
+    if (index.type != INDEX_BTREE || index.keyPattern.nFields() < 2 || index.sparse ||
+        index.filterExpr ||
+        !CollatorInterface::collatorsMatch(index.collator, query.getCollator())) {
+        return false;
+    }
+
+    // A query which constrains the leading field is planned by the enumerator as usual.
+    if (fields.count(index.keyPattern.firstElementFieldName())) {
+        return false;
+    }
+
+    auto distinctValues = params.leadingFieldDistinctValues.find(index.identifier.catalogName);
+    return distinctValues != params.leadingFieldDistinctValues.end() &&
+        distinctValues->second <=
+        static_cast<double>(internalQueryPlannerSkipScanMaxDistinctValues.load());
+}
+
 // static
 const int QueryPlanner::kPlannerVersion = 1;
 
@@ -434,6 +534,23 @@ Status QueryPlanner::tagAccordingToCache(MatchExpression* filter,
     return Status::OK();
 }
 
+/**
+ * Adds the catalog name of every index referenced by 'indexTree', either directly or through an OR
+ * pushdown, to 'indexNames'.
+ */
+static void getIndexNamesReferencedByCache(const PlanCacheIndexTree* indexTree,
+                                           stdx::unordered_set<std::string>* indexNames) {
+    if (indexTree->entry) {
+        indexNames->insert(indexTree->entry->identifier.catalogName);
+    }
+    for (auto&& orPushdown : indexTree->orPushdowns) {
+        indexNames->insert(orPushdown.indexEntryId.catalogName);
+    }
+    for (auto&& child : indexTree->children) {
+        getIndexNamesReferencedByCache(child, indexNames);
+    }
+}
+
 StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
     const CanonicalQuery& query,
     const QueryPlannerParams& params,
@@ -480,10 +597,28 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
            << redact(clone->debugString()) << "Cache data:" << endl
            << redact(winnerCacheData.toString());
 
+    // Rebuilding the solution only needs the indexes which the cached tags refer to. On a cache hit
+    // we avoid copying, and expanding when wildcard, the rest of the collection's indexes, which is
+    // a noticeable part of the cost of planning a point query on a collection with many indexes.
+    stdx::unordered_set<std::string> cachedIndexNames;
+    getIndexNamesReferencedByCache(winnerCacheData.tree.get(), &cachedIndexNames);
+
+    std::vector<IndexEntry> cachedIndexes;
+    bool hasWildcardIndex = false;
+    for (auto&& index : params.indices) {
+        if (cachedIndexNames.count(index.identifier.catalogName)) {
+            hasWildcardIndex = hasWildcardIndex || index.type == IndexType::INDEX_WILDCARD;
+            cachedIndexes.push_back(index);
+        }
+    }
+
+    // The query's fields are only used to expand wildcard indexes.
     stdx::unordered_set<string> fields;
-    QueryPlannerIXSelect::getFields(query.root(), &fields);
+    if (hasWildcardIndex) {
+        QueryPlannerIXSelect::getFields(query.root(), &fields);
+    }
     std::vector<IndexEntry> expandedIndexes =
-        QueryPlannerIXSelect::expandIndexes(fields, params.indices);
+        QueryPlannerIXSelect::expandIndexes(fields, std::move(cachedIndexes));
 
     // Map from index name to index number.
     map<IndexEntry::Identifier, size_t> indexMap;
@@ -992,11 +1127,29 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         !QueryPlannerCommon::hasNode(query.root(), MatchExpression::GEO_NEAR) &&
         !QueryPlannerCommon::hasNode(query.root(), MatchExpression::TEXT) && hintedIndex.isEmpty();
 
+    // If no index can be used the usual way, a compound index whose leading field has few distinct
+    // values may still be scanned within each of them. The collection scan is kept as a candidate
+    // so that the multi-planner decides whether the skip scan pays off.
+    bool skipScanAdded = false;
+    if (0 == out.size() && possibleToCollscan && !params.leadingFieldDistinctValues.empty()) {
+        for (size_t i = 0; i < fullIndexList.size() && out.size() < params.maxIndexedSolutions;
+             ++i) {
+            if (!canUseSkipScan(query, params, fields, fullIndexList[i])) {
+                continue;
+            }
+            if (auto soln = buildSkipScanSoln(query, params, fullIndexList, i)) {
+                LOG(5) << "Planner: outputting skip scan soln:" << endl << redact(soln->toString());
+                out.push_back(std::move(soln));
+                skipScanAdded = true;
+            }
+        }
+    }
+
     // The caller can explicitly ask for a collscan.
     bool collscanRequested = (params.options & QueryPlannerParams::INCLUDE_COLLSCAN);
 
     // No indexed plans?  We must provide a collscan if possible or else we can't run the query.
-    bool collscanNeeded = (0 == out.size() && canTableScan);
+    bool collscanNeeded = ((0 == out.size() || skipScanAdded) && canTableScan);
 
     if (possibleToCollscan && (collscanRequested || collscanNeeded)) {
         auto collscan = buildCollscanSoln(query, isTailable, params);
@@ -1309,6 +1309,96 @@ TEST_F(QueryPlannerTest, MustFetchWhenNotAllSortKeysAreCoveredByIndex) {
         "{pattern: {a: 1, b: 1}}}}}}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, SkipScanOverUnconstrainedLeadingFieldWithFewDistinctValues) {
+    params.options = QueryPlannerParams::DEFAULT;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    params.leadingFieldDistinctValues["hari_king_of_the_stove"] = 5;
+
+    runQuery(fromjson("{b: 5}"));
+
+    // The collection scan stays a candidate so that the multi-planner can reject the skip scan.
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {a: 1, b: 1}, bounds: "
+        "{a: [['MinKey','MaxKey',true,true]], b: [[5,5,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanCombinesBoundsAndFiltersOtherPredicates) {
+    params.options = QueryPlannerParams::DEFAULT;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    params.leadingFieldDistinctValues["hari_king_of_the_stove"] = 5;
+
+    runQuery(fromjson("{b: {$gt: 1, $lt: 4}, c: 3}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: {c: 3}, node: {ixscan: {pattern: {a: 1, b: 1}, bounds: "
+        "{a: [['MinKey','MaxKey',true,true]], b: [[1,4,false,false]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, NoSkipScanWithoutStatisticsOrWithManyDistinctValues) {
+    params.options = QueryPlannerParams::DEFAULT;
+    addIndex(BSON("a" << 1 << "b" << 1));
+
+    runQuery(fromjson("{b: 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+
+    params.leadingFieldDistinctValues["hari_king_of_the_stove"] =
+        static_cast<double>(internalQueryPlannerSkipScanMaxDistinctValues.load() + 1);
+    runQuery(fromjson("{b: 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerTest, NoSkipScanWhenLeadingFieldIsConstrained) {
+    params.options = QueryPlannerParams::DEFAULT;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    params.leadingFieldDistinctValues["hari_king_of_the_stove"] = 5;
+
+    runQuery(fromjson("{a: {$gt: 0}, b: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {a: 1, b: 1}, bounds: "
+        "{a: [[0,Infinity,false,true]], b: [[5,5,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, WholeIndexScanForSortFiltersOnCoveredPredicatesBeforeFetch) {
+    addIndex(BSON("a" << 1 << "b" << 1));
+
+    runQuerySortProj(fromjson("{b: 5, c: 6}"), fromjson("{a: 1}"), BSONObj());
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{sort: {pattern: {a: 1}, limit: 0, node: {sortKeyGen: {node: {cscan: {dir: 1}}}}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {c: 6}, node: {ixscan: {filter: {b: 5}, pattern: {a: 1, b: 1}, bounds: "
+        "{a: [['MinKey','MaxKey',true,true]], b: [['MinKey','MaxKey',true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, WholeIndexScanFetchesOnlyForUncoveredPredicates) {
+    addIndex(BSON("a" << 1 << "b" << 1 << "c" << 1));
+
+    // $exists cannot be answered from the index keys, since missing fields are indexed as null.
+    runQueryHint(fromjson("{b: {$exists: true}, c: {$gt: 1}}"), fromjson("{a: 1, b: 1, c: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: {b: {$exists: true}}, node: {ixscan: {filter: {c: {$gt: 1}}, "
+        "pattern: {a: 1, b: 1, c: 1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, WholeIndexScanOverMultikeyIndexFetchesBeforeFiltering) {
+    addIndex(BSON("a" << 1 << "b" << 1), true);
+
+    runQuerySortProj(fromjson("{b: 5, c: 6}"), fromjson("{a: 1}"), BSONObj());
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{fetch: {filter: {b: 5, c: 6}, node: {ixscan: {filter: null, pattern: {a: 1, b: 1}}}}}");
+}
 
 }  // namespace
 }  // namespace mongo
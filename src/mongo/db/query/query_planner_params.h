@@ -34,6 +34,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/index_entry.h"
 #include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -115,6 +116,11 @@ struct QueryPlannerParams {
     // plans via the MultiPlanStage, and the set of possible plans is very large for certain
     // index+query combinations.
     size_t maxIndexedSolutions;
+
+    // Estimated number of distinct values of the leading field of each index which has sampled
+    // statistics, keyed by index name. The planner only considers a skip scan over an index whose
+    // leading field the query leaves unconstrained if the index has an entry here.
+    StringMap<double> leadingFieldDistinctValues;
 };
 
 }  // namespace mongo
@@ -403,7 +403,8 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
                                          "diacriticSensitive",
                                          "prefix",
                                          "collation",
-                                         "filter"}));
+                                         "filter",
+                                         "limit"}));
 
         BSONElement searchElt = textObj["search"];
         if (!searchElt.eoo()) {
@@ -444,6 +445,14 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
             }
         }
 
+        BSONElement limitElt = textObj["limit"];
+        if (!limitElt.eoo()) {
+            if (!limitElt.isNumber() ||
+                limitElt.numberLong() != static_cast<long long>(node->limit)) {
+                return false;
+            }
+        }
+
         BSONObj collation;
         if (BSONElement collationElt = textObj["collation"]) {
             if (!collationElt.isABSONObj()) {
@@ -634,7 +643,7 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
             return false;
         }
         BSONObj sortObj = el.Obj();
-        invariant(bsonObjFieldsAreInSet(sortObj, {"pattern", "limit", "node"}));
+        invariant(bsonObjFieldsAreInSet(sortObj, {"pattern", "limit", "sortPrefixLength", "node"}));
 
         BSONElement patternEl = sortObj["pattern"];
         if (patternEl.eoo() || !patternEl.isABSONObj()) {
@@ -649,6 +658,13 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
             return false;
         }
 
+        // The sort prefix length is only checked if the test solution specifies one.
+        BSONElement sortPrefixLengthEl = sortObj["sortPrefixLength"];
+        if (!sortPrefixLengthEl.eoo() &&
+            static_cast<size_t>(sortPrefixLengthEl.numberInt()) != sn->sortPrefixLength) {
+            return false;
+        }
+
         size_t expectedLimit = limitEl.numberInt();
         return SimpleBSONObjComparator::kInstance.evaluate(patternEl.Obj() == sn->pattern) &&
             (expectedLimit == sn->limit) &&
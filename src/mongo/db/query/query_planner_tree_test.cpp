@@ -1201,6 +1201,34 @@ TEST_F(QueryPlannerTest, ReverseScanForSort) {
         "{filter: null, pattern: {_id: 1}}}}}");
 }
 
+TEST_F(QueryPlannerTest, PartialSortWhenIndexProvidesSortPrefix) {
+    addIndex(BSON("a" << 1));
+    runQuerySortProj(fromjson("{a: {$gt: 1}}"), fromjson("{a: 1, b: 1}"), BSONObj());
+
+    ASSERT_EQUALS(getNumSolutions(), 2U);
+    assertSolutionExists(
+        "{sort: {pattern: {a: 1, b: 1}, limit: 0, sortPrefixLength: 0, node: {sortKeyGen: "
+        "{node: {cscan: {dir: 1}}}}}}");
+    assertSolutionExists(
+        "{sort: {pattern: {a: 1, b: 1}, limit: 0, sortPrefixLength: 1, node: {sortKeyGen: "
+        "{node: {fetch: {filter: null, node: {ixscan: {filter: null, pattern: {a: 1}, "
+        "dir: 1}}}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, PartialSortReversesScanToProvideSortPrefix) {
+    addIndex(BSON("a" << 1));
+    runQuerySortProj(fromjson("{a: {$gt: 1}}"), fromjson("{a: -1, b: 1}"), BSONObj());
+
+    ASSERT_EQUALS(getNumSolutions(), 2U);
+    assertSolutionExists(
+        "{sort: {pattern: {a: -1, b: 1}, limit: 0, sortPrefixLength: 0, node: {sortKeyGen: "
+        "{node: {cscan: {dir: 1}}}}}}");
+    assertSolutionExists(
+        "{sort: {pattern: {a: -1, b: 1}, limit: 0, sortPrefixLength: 1, node: {sortKeyGen: "
+        "{node: {fetch: {filter: null, node: {ixscan: {filter: null, pattern: {a: 1}, "
+        "dir: -1}}}}}}}}");
+}
+
 TEST_F(QueryPlannerTest, MergeSortReverseScans) {
     addIndex(BSON("a" << 1));
     runQueryAsCommand(
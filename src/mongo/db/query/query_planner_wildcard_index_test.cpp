@@ -1741,8 +1741,8 @@ TEST_F(QueryPlannerWildcardTest, WildcardIndexDoesNotAffectValidMinMax) {
 
     assertNumSolutions(1U);
     assertSolutionExists(
-        "{fetch: {filter: {x: {$eq: 5}}, "
-        "node: {ixscan: {filter: null, pattern: {x: 1}}}}}");
+        "{fetch: {filter: null, "
+        "node: {ixscan: {filter: {x: {$eq: 5}}, pattern: {x: 1}}}}}");
 }
 
 TEST_F(QueryPlannerWildcardTest, CanAnswerEqualityToEmptyObject) {
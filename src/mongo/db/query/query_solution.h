@@ -287,6 +287,10 @@ struct TextNode : public QuerySolutionNode {
     // text node while creating the text leaf node and convert them into a BSONObj index prefix
     // when we finish the text leaf node.
     BSONObj indexPrefix;
+
+    // If non-zero, the TEXT node feeds a sort on the text score alone which keeps only the first
+    // 'limit' results, so lower scoring documents need not be returned.
+    size_t limit = 0u;
 };
 
 struct CollectionScanNode : public QuerySolutionNode {
@@ -725,7 +729,10 @@ struct SortKeyGeneratorNode : public QuerySolutionNode {
 };
 
 struct SortNode : public QuerySolutionNode {
-    SortNode() : _sorts(SimpleBSONObjComparator::kInstance.makeBSONObjSet()), limit(0) {}
+    SortNode()
+        : _sorts(SimpleBSONObjComparator::kInstance.makeBSONObjSet()),
+          limit(0),
+          sortPrefixLength(0) {}
 
     virtual ~SortNode() {}
 
@@ -765,6 +772,11 @@ struct SortNode : public QuerySolutionNode {
 
     // Sum of both limit and skip count in the parsed query.
     size_t limit;
+
+    // The number of leading fields of 'pattern' by which the child already sorts its output. If
+    // non-zero, the sort only needs to order each run of results with equal values for these
+    // fields.
+    size_t sortPrefixLength;
 };
 
 struct LimitNode : public QuerySolutionNode {
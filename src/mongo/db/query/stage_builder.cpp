@@ -59,6 +59,7 @@
 #include "mongo/db/exec/sort_key_generator.h"
 #include "mongo/db/exec/text.h"
 #include "mongo/db/index/fts_access_method.h"
+#include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/storage/oplog_hack.h"
@@ -74,6 +75,12 @@ std::unique_ptr<PlanStage> buildStages(OperationContext* opCtx,
                                        const QuerySolution& qsol,
                                        const QuerySolutionNode* root,
                                        WorkingSet* ws) {
+    if (root->filter) {
+        // Evaluate the cheaper predicates of the filter first, so that the more expensive ones are
+        // skipped whenever the result is already decided.
+        expression::orderForEvaluation(root->filter.get());
+    }
+
     switch (root->getType()) {
         case STAGE_COLLSCAN: {
             const CollectionScanNode* csn = static_cast<const CollectionScanNode*>(root);
@@ -127,7 +134,8 @@ std::unique_ptr<PlanStage> buildStages(OperationContext* opCtx,
                                                SortPattern{sn->pattern, cq.getExpCtx()},
                                                sn->limit,
                                                internalQueryMaxBlockingSortMemoryUsageBytes.load(),
-                                               std::move(childStage));
+                                               std::move(childStage),
+                                               sn->sortPrefixLength);
         }
         case STAGE_SORT_KEY_GENERATOR: {
             const SortKeyGeneratorNode* keyGenNode = static_cast<const SortKeyGeneratorNode*>(root);
@@ -268,6 +276,7 @@ std::unique_ptr<PlanStage> buildStages(OperationContext* opCtx,
             // created by planning a query that contains "no-op" expressions.
             params.query = static_cast<FTSQueryImpl&>(*node->ftsQuery);
             params.wantTextScore = cq.metadataDeps()[DocumentMetadataFields::kTextScore];
+            params.limit = node->limit;
             return std::make_unique<TextStage>(opCtx, params, ws, node->filter.get());
         }
         case STAGE_SHARDING_FILTER: {
@@ -332,6 +341,7 @@ std::unique_ptr<PlanStage> buildStages(OperationContext* opCtx,
         case STAGE_COUNT:
         case STAGE_DELETE:
         case STAGE_EOF:
+        case STAGE_GROUP_COUNT_SCAN:
         case STAGE_IDHACK:
         case STAGE_MULTI_ITERATOR:
         case STAGE_MULTI_PLAN:
@@ -65,6 +65,10 @@ enum StageType {
     STAGE_GEO_NEAR_2D,
     STAGE_GEO_NEAR_2DSPHERE,
 
+    // Counts the adjacent equal keys of an index to answer a $group which only counts the
+    // documents of each group.
+    STAGE_GROUP_COUNT_SCAN,
+
     STAGE_IDHACK,
 
     STAGE_IXSCAN,
@@ -43,6 +43,7 @@
 #include "mongo/db/repl/speculative_majority_read_info.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/snapshot_window_util.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/s/grid.h"
 #include "mongo/util/concurrency/notification.h"
@@ -340,6 +341,7 @@ MONGO_REGISTER_SHIM(waitForReadConcern)
     }
 
     if (atClusterTime) {
+        SnapshotWindowUtil::notePointInTimeRead(opCtx);
         opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kProvided,
                                                       atClusterTime->asTimestamp());
     } else if (readConcernArgs.getLevel() == repl::ReadConcernLevel::kMajorityReadConcern &&
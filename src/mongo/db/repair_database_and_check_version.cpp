@@ -59,6 +59,7 @@
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log.h"
 #include "mongo/util/quick_exit.h"
+#include "mongo/util/timer.h"
 
 #if !defined(_WIN32)
 #include <sys/file.h>
@@ -262,8 +263,11 @@ void checkForCappedOplog(OperationContext* opCtx, Database* db) {
 }
 
 void rebuildIndexes(OperationContext* opCtx, StorageEngine* storageEngine) {
+    Timer reconcileTimer;
     std::vector<StorageEngine::CollectionIndexNamePair> indexesToRebuild =
         fassert(40593, storageEngine->reconcileCatalogAndIdents(opCtx));
+    log() << "Reconciled the catalog with the storage engine in " << reconcileTimer.millis()
+          << "ms";
 
     if (!indexesToRebuild.empty() && serverGlobalParams.indexBuildRetry) {
         log() << "note: restart the server with --noIndexBuildRetry "
@@ -109,6 +109,12 @@ Status CollectionBulkLoaderImpl::init(const std::vector<BSONObj>& secondaryIndex
             _idIndexBlock.reset();
         }
 
+        // Uncapped collections are loaded while empty, so the record store may be able to append
+        // to them more cheaply than through regular inserts.
+        if (!coll->isCapped()) {
+            _bulkInserter = coll->getRecordStore()->makeBulkInserter(_opCtx.get());
+        }
+
         return Status::OK();
     });
 }
@@ -136,7 +142,7 @@ Status CollectionBulkLoaderImpl::_insertDocumentsForUncappedCollection(
                     bytesInBlock += doc.objsize();
                     // This version of insert will not update any indexes.
                     const auto status = _autoColl->getCollection()->insertDocumentForBulkLoader(
-                        _opCtx.get(), doc, onRecordInserted);
+                        _opCtx.get(), doc, onRecordInserted, _bulkInserter.get());
                     if (!status.isOK()) {
                         return status;
                     }
@@ -215,6 +221,10 @@ Status CollectionBulkLoaderImpl::commit() {
         LOG(2) << "Creating indexes for ns: " << _nss.ns();
         UnreplicatedWritesBlock uwb(_opCtx.get());
 
+        // All documents have been inserted, and the record store must be released from bulk
+        // loading before duplicates can be deleted from it.
+        _bulkInserter.reset();
+
         // Commit before deleting dups, so the dups will be removed from secondary indexes when
         // deleted.
         if (_secondaryIndexesBlock) {
@@ -318,6 +328,8 @@ Status CollectionBulkLoaderImpl::commit() {
 
 void CollectionBulkLoaderImpl::_releaseResources() {
     invariant(&cc() == _opCtx->getClient());
+    _bulkInserter.reset();
+
     if (_secondaryIndexesBlock) {
         _secondaryIndexesBlock->cleanUpAfterBuild(
             _opCtx.get(), _collection, MultiIndexBlock::kNoopOnCleanUpFn);
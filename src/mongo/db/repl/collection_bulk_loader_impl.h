@@ -109,6 +109,8 @@ private:
     NamespaceString _nss;
     std::unique_ptr<MultiIndexBlock> _idIndexBlock;
     std::unique_ptr<MultiIndexBlock> _secondaryIndexesBlock;
+    // Set while loading an uncapped collection whose record store supports bulk loading.
+    std::unique_ptr<BulkRecordInserter> _bulkInserter;
     BSONObj _idIndexSpec;
     Stats _stats;
 };
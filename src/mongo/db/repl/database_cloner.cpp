@@ -400,17 +400,35 @@ void DatabaseCloner::_listCollectionsCallback(const StatusWith<Fetcher::QueryRes
         }
     }
 
-    // Start first collection cloner.
     _currentCollectionClonerIter = _collectionCloners.begin();
+    _startCollectionCloners_inlock(lk);
+}
 
-    LOG(1) << "    cloning collection " << _currentCollectionClonerIter->getSourceNamespace();
+void DatabaseCloner::_startCollectionCloners_inlock(UniqueLock& lk) {
+    const int maxActive = initialSyncMaxConcurrentCollectionCloners.load();
+    while (_collectionClonerStatus.isOK() && _activeCollectionCloners < maxActive &&
+           _currentCollectionClonerIter != _collectionCloners.end()) {
+        auto& collectionCloner = *_currentCollectionClonerIter++;
 
-    Status startStatus = _startCollectionCloner(*_currentCollectionClonerIter);
-    if (!startStatus.isOK()) {
-        LOG(1) << "    failed to start collection cloning on "
-               << _currentCollectionClonerIter->getSourceNamespace() << ": " << redact(startStatus);
-        _finishCallback_inlock(lk, startStatus);
-        return;
+        LOG(1) << "    cloning collection " << collectionCloner.getSourceNamespace();
+
+        Status startStatus = _startCollectionCloner(collectionCloner);
+        if (!startStatus.isOK()) {
+            LOG(1) << "    failed to start collection cloning on "
+                   << collectionCloner.getSourceNamespace() << ": " << redact(startStatus);
+            _collectionClonerStatus = startStatus;
+
+            // Don't leave the collections that are already cloning to run to completion.
+            for (auto it = _collectionCloners.begin(); it != _currentCollectionClonerIter; ++it) {
+                it->shutdown();
+            }
+            break;
+        }
+        ++_activeCollectionCloners;
+    }
+
+    if (_activeCollectionCloners == 0) {
+        _finishCallback_inlock(lk, _collectionClonerStatus);
     }
 }
 
@@ -429,30 +447,22 @@ void DatabaseCloner::_collectionClonerCallback(const Status& status, const Names
     _collectionWork(collStatus, nss);
     lk.lock();
 
+    --_activeCollectionCloners;
+
     // Failure to clone a collection will stop the database cloner from
     // cloning the rest of the collections in the listCollections result.
     if (!collStatus.isOK()) {
-        Status failStatus = {ErrorCodes::InitialSyncFailure, collStatus.toString()};
-        _finishCallback_inlock(lk, failStatus);
-        return;
-    }
-
-    ++_stats.clonedCollections;
-    _currentCollectionClonerIter++;
-
-    if (_currentCollectionClonerIter != _collectionCloners.end()) {
-        Status startStatus = _startCollectionCloner(*_currentCollectionClonerIter);
-        if (!startStatus.isOK()) {
-            LOG(1) << "    failed to start collection cloning on "
-                   << _currentCollectionClonerIter->getSourceNamespace() << ": "
-                   << redact(startStatus);
-            _finishCallback_inlock(lk, startStatus);
-            return;
+        if (_collectionClonerStatus.isOK()) {
+            _collectionClonerStatus = {ErrorCodes::InitialSyncFailure, collStatus.toString()};
+            for (auto it = _collectionCloners.begin(); it != _currentCollectionClonerIter; ++it) {
+                it->shutdown();
+            }
         }
-        return;
+    } else {
+        ++_stats.clonedCollections;
     }
 
-    _finishCallback_inlock(lk, Status::OK());
+    _startCollectionCloners_inlock(lk);
 }
 
 void DatabaseCloner::_finishCallback(const Status& status) {
@@ -203,6 +203,13 @@ private:
      */
     void _finishCallback_inlock(stdx::unique_lock<Latch>& lk, const Status& status);
 
+    /**
+     * Starts collection cloners until initialSyncMaxConcurrentCollectionCloners are running, there
+     * are none left to start, or one has failed. Finishes the database cloner once the last running
+     * collection cloner is done.
+     */
+    void _startCollectionCloners_inlock(stdx::unique_lock<Latch>& lk);
+
     //
     // All member variables are labeled with one of the following codes indicating the
     // synchronization rules for accessing them.
@@ -236,6 +243,10 @@ private:
     std::vector<NamespaceString> _collectionNamespaces;                  // (M)
     std::list<CollectionCloner> _collectionCloners;                      // (M)
     std::list<CollectionCloner>::iterator _currentCollectionClonerIter;  // (M)
+    int _activeCollectionCloners = 0;                                    // (M)
+    // The first error from starting or running a collection cloner. Once set, no more collection
+    // cloners are started and the database cloner finishes with it.
+    Status _collectionClonerStatus = Status::OK();  // (M)
     ScheduleDbWorkFn
         _scheduleDbWorkFn;  // (RT) Function for scheduling database work using the executor.
     StartCollectionClonerFn _startCollectionCloner;  // (RT)
@@ -38,10 +38,12 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/repl/base_cloner_test_fixture.h"
 #include "mongo/db/repl/database_cloner.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/dbtests/mock/mock_dbclient_connection.h"
 #include "mongo/unittest/task_executor_proxy.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 #include "mongo/util/uuid.h"
 
@@ -793,7 +795,7 @@ TEST_F(DatabaseClonerTest, FirstCollectionListIndexesFailed) {
     ASSERT_EQUALS(getDetectableErrorStatus(), getStatus());
     ASSERT_TRUE(_databaseCloner->isActive());
 
-    // Collection cloners are run serially for now.
+    // Collection cloners are run serially by default.
     // This affects the order of the network responses.
     {
         executor::NetworkInterfaceMock::InNetworkGuard guard(getNet());
@@ -847,7 +849,7 @@ TEST_F(DatabaseClonerTest, CreateCollections) {
     ASSERT_EQUALS(getDetectableErrorStatus(), getStatus());
     ASSERT_TRUE(_databaseCloner->isActive());
 
-    // Collection cloners are run serially for now.
+    // Collection cloners are run serially by default.
     // This affects the order of the network responses.
     {
         executor::NetworkInterfaceMock::InNetworkGuard guard(getNet());
@@ -882,4 +884,52 @@ TEST_F(DatabaseClonerTest, CreateCollections) {
     stats.commitCalled = true;
 }
 
+
+TEST_F(DatabaseClonerTest, CreateCollectionsConcurrently) {
+    const int originalMaxCloners = initialSyncMaxConcurrentCollectionCloners.load();
+    initialSyncMaxConcurrentCollectionCloners.store(2);
+    ON_BLOCK_EXIT([&] { initialSyncMaxConcurrentCollectionCloners.store(originalMaxCloners); });
+
+    ASSERT_OK(_databaseCloner->startup());
+
+    const std::vector<BSONObj> sourceInfos = {BSON("name"
+                                                   << "a"
+                                                   << "options" << _options1.toBSON()),
+                                              BSON("name"
+                                                   << "b"
+                                                   << "options" << _options2.toBSON())};
+    auto net = getNet();
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+        processNetworkResponse(
+            createListCollectionsResponse(0, BSON_ARRAY(sourceInfos[0] << sourceInfos[1])));
+    }
+    ASSERT_EQUALS(getDetectableErrorStatus(), getStatus());
+    ASSERT_TRUE(_databaseCloner->isActive());
+
+    // Both collection cloners are running, so both count requests are outstanding before either
+    // of them gets a response.
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+        for (size_t i = 0; i < 2; ++i) {
+            auto request = net->getNthUnscheduledRequest(i)->getRequest();
+            ASSERT_EQUALS("count"_sd, request.cmdObj.firstElementFieldNameStringData());
+        }
+
+        processNetworkResponse(createCountResponse(0));
+        processNetworkResponse(createCountResponse(0));
+        processNetworkResponse(createListIndexesResponse(0, BSON_ARRAY(idIndexSpec)));
+        processNetworkResponse(createListIndexesResponse(0, BSON_ARRAY(idIndexSpec)));
+    }
+
+    _databaseCloner->join();
+    ASSERT_OK(getStatus());
+    ASSERT_FALSE(_databaseCloner->isActive());
+    ASSERT_EQUALS(DatabaseCloner::State::kComplete, _databaseCloner->getState_forTest());
+
+    ASSERT_EQUALS(2U, _collections.size());
+    ASSERT_OK(_collections[NamespaceString{"db.a"}].status);
+    ASSERT_OK(_collections[NamespaceString{"db.b"}].status);
+}
+
 }  // namespace
@@ -37,6 +37,7 @@
 #include "mongo/db/commands/txn_cmds_gen.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/util/concurrency/numa_placement.h"
 #include "mongo/util/log.h"
 #include "mongo/util/time_support.h"
 
@@ -206,6 +207,13 @@ StatusWith<OplogApplier::Operations> OplogApplier::getNextApplierBatch(
     Operations ops;
     BSONObj op;
     while (_oplogBuffer->peek(opCtx, &op)) {
+        // The byte limit only needs the raw size. Check it before parsing an entry that would be
+        // left for the next batch anyway, since that batch parses it again.
+        const auto opBytes = op.objsize();
+        if (totalOps > 0 && totalBytes + opBytes > batchLimits.bytes) {
+            return std::move(ops);
+        }
+
         auto entry = OplogEntry(op);
 
         // Check for oplog version change.
@@ -242,11 +250,8 @@ StatusWith<OplogApplier::Operations> OplogApplier::getNextApplierBatch(
 
         // Apply replication batch limits. Avoid returning an empty batch.
         auto opCount = getOpCount(entry);
-        auto opBytes = entry.getRawObjSizeBytes();
-        if (totalOps > 0) {
-            if (totalOps + opCount > batchLimits.ops || totalBytes + opBytes > batchLimits.bytes) {
-                return std::move(ops);
-            }
+        if (totalOps > 0 && totalOps + opCount > batchLimits.ops) {
+            return std::move(ops);
         }
 
         // If we have a forced batch boundary, apply it.
@@ -297,6 +302,7 @@ std::unique_ptr<ThreadPool> makeReplWriterPool(int threadCount) {
     options.poolName = "repl writer worker Pool";
     options.maxThreads = options.minThreads = static_cast<size_t>(threadCount);
     options.onCreateThread = [](const std::string&) {
+        NumaPlacement::get().bindCurrentThread();
         Client::initThread(getThreadName());
         AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
     };
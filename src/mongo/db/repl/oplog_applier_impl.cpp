@@ -31,23 +31,29 @@
 
 #include "mongo/db/repl/oplog_applier_impl.h"
 
+#include <algorithm>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/document_validation.h"
+#include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/dbhelpers.h"
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/repl/apply_ops.h"
 #include "mongo/db/repl/insert_group.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/transaction_oplog_application.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/platform/basic.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log.h"
+#include "mongo/util/timer.h"
 #include "third_party/murmurhash3/MurmurHash3.h"
 
 namespace mongo {
@@ -235,10 +241,36 @@ void addDerivedOps(OperationContext* opCtx,
     }
 }
 
+/**
+ * Returns the end of the run of update and delete operations on the same namespace that starts at
+ * 'first'. Any other operation forms a run of its own.
+ */
+MultiApplier::OperationPtrs::const_iterator findEndOfUpdateAndDeleteGroup(
+    MultiApplier::OperationPtrs::const_iterator first,
+    MultiApplier::OperationPtrs::const_iterator last) {
+    auto isUpdateOrDelete = [](const OplogEntry* entry) {
+        return entry->getOpType() == OpTypeEnum::kUpdate ||
+            entry->getOpType() == OpTypeEnum::kDelete;
+    };
+    if (!isUpdateOrDelete(*first)) {
+        return first + 1;
+    }
+
+    const auto& groupNamespace = (*first)->getNss();
+    return std::find_if(first + 1, last, [&](const OplogEntry* nextEntry) {
+        return !isUpdateOrDelete(nextEntry) || nextEntry->getNss() != groupNamespace;
+    });
+}
+
 void stableSortByNamespace(MultiApplier::OperationPtrs* oplogEntryPointers) {
     auto nssComparator = [](const OplogEntry* l, const OplogEntry* r) {
         return l->getNss() < r->getNss();
     };
+    // A writer's ops are commonly all for one hot collection, in which case they're already in
+    // order and one linear pass is all that is needed.
+    if (std::is_sorted(oplogEntryPointers->begin(), oplogEntryPointers->end(), nssComparator)) {
+        return;
+    }
     std::stable_sort(oplogEntryPointers->begin(), oplogEntryPointers->end(), nssComparator);
 }
 
@@ -448,9 +480,12 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
 
         // Apply the operations in this batch. '_applyOplogBatch' returns the optime of the
         // last op that was applied, which should be the last optime in the batch.
+        const auto numOpsInBatch = ops.getCount();
+        Timer applyTimer;
         auto lastOpTimeAppliedInBatch =
             fassertNoTrace(34437, _applyOplogBatch(&opCtx, ops.releaseBatch()));
         invariant(lastOpTimeAppliedInBatch == lastOpTimeInBatch);
+        batcher.recordBatchApplied(numOpsInBatch, Milliseconds(applyTimer.millis()));
 
         // Update various things that care about our last applied optime. Tests rely on 1 happening
         // before 2 even though it isn't strictly necessary.
@@ -552,6 +587,72 @@ void scheduleWritesToOplog(OperationContext* opCtx,
     }
 }
 
+// Schedules lookups by _id of the documents that the updates and deletes in 'writerVectors' will
+// modify, so that reading them from disk overlaps with the writes to the oplog instead of stalling
+// the writer threads. The lookups are only a hint to the storage engine cache, so any error is
+// ignored. The caller must guarantee that 'writerVectors' stays valid until all scheduled work in
+// the thread pool completes.
+void schedulePrefetchOfDocuments(ThreadPool* writerPool,
+                                 const std::vector<MultiApplier::OperationPtrs>& writerVectors) {
+    auto prefetchOps = std::make_shared<std::vector<const OplogEntry*>>();
+    for (const auto& writer : writerVectors) {
+        for (const auto op : writer) {
+            if (op->getOpType() == OpTypeEnum::kUpdate || op->getOpType() == OpTypeEnum::kDelete) {
+                prefetchOps->push_back(op);
+            }
+        }
+    }
+    if (prefetchOps->empty()) {
+        return;
+    }
+
+    auto makePrefetcherForRange = [prefetchOps](size_t begin, size_t end) {
+        return [prefetchOps, begin, end](auto status) {
+            invariant(status);
+
+            auto opCtx = cc().makeOperationContext();
+            ShouldNotConflictWithSecondaryBatchApplicationBlock shouldNotConflictBlock(
+                opCtx->lockState());
+
+            for (size_t i = begin; i < end; i++) {
+                const auto& op = *(*prefetchOps)[i];
+                try {
+                    const auto idElem = op.getIdElement();
+                    if (idElem.eoo()) {
+                        continue;
+                    }
+
+                    AutoGetCollection autoColl(
+                        opCtx.get(), getNsOrUUID(op.getNss(), op), MODE_IS);
+                    auto collection = autoColl.getCollection();
+                    if (!collection || !collection->getIndexCatalog()->haveIdIndex(opCtx.get())) {
+                        continue;
+                    }
+
+                    auto recordId = Helpers::findById(opCtx.get(), collection, idElem.wrap());
+                    Snapshotted<BSONObj> doc;
+                    if (!recordId.isNull()) {
+                        collection->findDoc(opCtx.get(), recordId, &doc);
+                    }
+                } catch (const DBException& ex) {
+                    LOG(2) << "Failed to prefetch document for " << redact(op.toBSON()) << ": "
+                           << redact(ex);
+                }
+                opCtx->recoveryUnit()->abandonSnapshot();
+            }
+        };
+    };
+
+    const size_t numThreads =
+        std::min(prefetchOps->size(), size_t(writerPool->getStats().numThreads));
+    const size_t numOpsPerThread = prefetchOps->size() / numThreads;
+    for (size_t thread = 0; thread < numThreads; thread++) {
+        size_t begin = thread * numOpsPerThread;
+        size_t end = (thread == numThreads - 1) ? prefetchOps->size() : begin + numOpsPerThread;
+        writerPool->schedule(makePrefetcherForRange(begin, end));
+    }
+}
+
 StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                                                       MultiApplier::Operations ops) {
     invariant(!ops.empty());
@@ -601,7 +702,11 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         std::vector<MultiApplier::OperationPtrs> writerVectors(_writerPool->getStats().numThreads);
         fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
 
-        // Wait for writes to finish before applying ops.
+        if (oplogApplicationPrefetchDocuments.load()) {
+            schedulePrefetchOfDocuments(_writerPool, writerVectors);
+        }
+
+        // Wait for writes and prefetches to finish before applying ops.
         _writerPool->waitForIdle();
 
         // Use this fail point to hold the PBWM lock after we have written the oplog entries but
@@ -975,9 +1080,33 @@ Status OplogApplierImpl::applyOplogBatchPerWorker(OperationContext* opCtx,
         ON_BLOCK_EXIT([opCtx] { MultikeyPathTracker::get(opCtx).stopTrackingMultikeyPathInfo(); });
         MultikeyPathTracker::get(opCtx).startTrackingMultikeyPathInfo();
 
+        // Held across a run of updates and deletes on the same collection, so that applying each
+        // of them only re-acquires locks this thread already holds instead of going through the
+        // lock manager. Every operation still gets its own WriteUnitOfWork and timestamp.
+        boost::optional<AutoGetCollection> groupCollectionLock;
+        auto endOfGroupCollectionLock = ops->cbegin();
+
         for (auto it = ops->cbegin(); it != ops->cend(); ++it) {
             const OplogEntry& entry = **it;
 
+            // Grouped inserts can move 'it' past the end of the previous run.
+            if (it >= endOfGroupCollectionLock) {
+                groupCollectionLock.reset();
+                endOfGroupCollectionLock = findEndOfUpdateAndDeleteGroup(it, ops->cend());
+                if (std::distance(it, endOfGroupCollectionLock) > 1) {
+                    const auto& nss = entry.getNss();
+                    try {
+                        groupCollectionLock.emplace(
+                            opCtx,
+                            getNsOrUUID(nss, entry),
+                            fixLockModeForSystemDotViewsChanges(nss, MODE_IX));
+                    } catch (const DBException&) {
+                        // Leave the errors, such as a missing collection, to the application of
+                        // the individual operations.
+                    }
+                }
+            }
+
             // If we are successful in grouping and applying inserts, advance the current iterator
             // past the end of the inserted group of entries.
             auto groupResult = insertGroup.groupAndApplyInserts(it);
@@ -0,0 +1,338 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/repl/idempotency_test_fixture.h"
+#include "mongo/db/repl/oplog_applier_impl.h"
+#include "mongo/db/repl/oplog_applier_impl_test_fixture.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+/*
+ * Throughput benchmarks of secondary oplog application. Each benchmark starts the WiredTiger
+ * storage engine in a temporary dbpath and applies batches of synthetic oplog entries through
+ * OplogApplierImpl, which writes them to the oplog and applies them on a pool of writer threads
+ * exactly as a secondary does. Besides the rate of operations, each benchmark reports
+ * "writerUtilization", the fraction of the writer threads' time spent applying operations while a
+ * batch was being applied.
+ */
+
+const NamespaceString kNss("oplog_applier_bm.coll");
+
+constexpr int kBatchSize = 1000;
+constexpr int kApplyOpsSize = 10;
+
+enum class UpdateShape {
+    kSetOneField,
+    kSetManyFields,
+    kReplacement,
+};
+
+BSONObj makeDocument(int id, int version) {
+    return BSON("_id" << id << "u" << id << "x" << version << "s" << std::string(64, 'a' + id % 26)
+                      << "n"
+                      << BSON("f0" << version << "f1" << version << "f2" << version << "f3"
+                                   << version << "f4" << version));
+}
+
+BSONObj makeUpdate(UpdateShape shape, int id, int version) {
+    switch (shape) {
+        case UpdateShape::kSetOneField:
+            return BSON("$v" << 1 << "$set" << BSON("x" << version));
+        case UpdateShape::kSetManyFields:
+            return BSON("$v" << 1 << "$set"
+                             << BSON("x" << version << "n.f0" << version << "n.f1" << version
+                                         << "n.f2" << version << "n.f3" << version << "n.f4"
+                                         << version));
+        case UpdateShape::kReplacement:
+            return makeDocument(id, version);
+    }
+    MONGO_UNREACHABLE;
+}
+
+/**
+ * OplogApplierImpl which keeps track of the time its writer threads spend applying operations.
+ */
+class TimedOplogApplier : public OplogApplierImpl {
+public:
+    using OplogApplierImpl::OplogApplierImpl;
+
+    Microseconds getWriterBusyTime() const {
+        return Microseconds(_writerBusyMicros.load());
+    }
+
+protected:
+    Status applyOplogBatchPerWorker(OperationContext* opCtx,
+                                    MultiApplier::OperationPtrs* ops,
+                                    WorkerMultikeyPathInfo* workerMultikeyPathInfo) override {
+        Timer timer;
+        auto status =
+            OplogApplierImpl::applyOplogBatchPerWorker(opCtx, ops, workerMultikeyPathInfo);
+        _writerBusyMicros.fetchAndAdd(timer.micros());
+        return status;
+    }
+
+private:
+    AtomicWord<long long> _writerBusyMicros{0};
+};
+
+/**
+ * Owns a secondary running the WiredTiger storage engine in a temporary dbpath, with an oplog
+ * applier using 'writerThreadCount' writer threads.
+ */
+class OplogApplierBenchmarkHarness : public OplogApplierImplTest {
+public:
+    explicit OplogApplierBenchmarkHarness(int writerThreadCount)
+        : OplogApplierImplTest("wiredTiger") {
+        setUp();
+        invariant(ReplicationCoordinator::get(_opCtx.get())
+                      ->setFollowerMode(MemberState::RS_SECONDARY));
+
+        _writerThreadCount = writerThreadCount;
+        _writerPool = makeReplWriterPool(writerThreadCount);
+        _applier = std::make_unique<TimedOplogApplier>(
+            nullptr,  // executor
+            nullptr,  // oplogBuffer
+            &_observer,
+            ReplicationCoordinator::get(_opCtx.get()),
+            getConsistencyMarkers(),
+            getStorageInterface(),
+            OplogApplier::Options(OplogApplication::Mode::kSecondary),
+            _writerPool.get());
+    }
+
+    using OplogApplierImplTest::nextOpTime;
+
+    ~OplogApplierBenchmarkHarness() {
+        _applier.reset();
+        _writerPool->shutdown();
+        _writerPool->join();
+        _writerPool.reset();
+        tearDown();
+    }
+
+    /**
+     * Creates the benchmark collection, with a unique secondary index on "u" if requested.
+     */
+    void createCollection(bool uniqueIndex) {
+        const auto uuid = UUID::gen();
+        apply({makeCreateCollectionOplogEntry(nextOpTime(), kNss, BSON("uuid" << uuid))});
+        if (uniqueIndex) {
+            apply({makeCommandOplogEntry(nextOpTime(),
+                                         kNss,
+                                         BSON("createIndexes" << kNss.coll() << "v" << 2 << "key"
+                                                              << BSON("u" << 1) << "name"
+                                                              << "u_1"
+                                                              << "unique" << true),
+                                         uuid)});
+        }
+    }
+
+    std::vector<OplogEntry> makeInserts(int begin, int end) {
+        std::vector<OplogEntry> ops;
+        for (int id = begin; id < end; ++id) {
+            ops.push_back(makeInsertDocumentOplogEntry(nextOpTime(), kNss, makeDocument(id, 0)));
+        }
+        return ops;
+    }
+
+    /**
+     * Applies 'ops' as a single batch and advances the stable and oldest timestamps past it, as a
+     * secondary would once the batch is majority committed, so that WiredTiger does not have to
+     * keep the history of every batch.
+     */
+    void apply(std::vector<OplogEntry> ops) {
+        auto lastOpTime = uassertStatusOK(_applier->applyOplogBatch(_opCtx.get(), std::move(ops)));
+        auto storageEngine = getServiceContext()->getStorageEngine();
+        storageEngine->setStableTimestamp(lastOpTime.getTimestamp());
+        storageEngine->setOldestTimestamp(lastOpTime.getTimestamp());
+    }
+
+    int getWriterThreadCount() const {
+        return _writerThreadCount;
+    }
+
+    Microseconds getWriterBusyTime() const {
+        return _applier->getWriterBusyTime();
+    }
+
+private:
+    void _doTest() override {}
+
+    int _writerThreadCount;
+    NoopOplogApplierObserver _observer;
+    std::unique_ptr<ThreadPool> _writerPool;
+    std::unique_ptr<TimedOplogApplier> _applier;
+};
+
+/**
+ * Applies a batch generated by 'makeBatch' on each iteration. Generating the batch is not timed.
+ */
+template <typename MakeBatch>
+void runApplyBenchmark(benchmark::State& state,
+                       OplogApplierBenchmarkHarness& harness,
+                       MakeBatch makeBatch) {
+    Microseconds applyTime{0};
+    Microseconds writerBusyTime{0};
+    int64_t numOps = 0;
+    int batchNumber = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto ops = makeBatch(batchNumber++);
+        numOps += ops.size();
+        const auto writerBusyTimeBefore = harness.getWriterBusyTime();
+        state.ResumeTiming();
+
+        Timer timer;
+        harness.apply(std::move(ops));
+        applyTime += Microseconds(timer.micros());
+        writerBusyTime += harness.getWriterBusyTime() - writerBusyTimeBefore;
+    }
+
+    state.SetItemsProcessed(numOps);
+    if (applyTime > Microseconds(0)) {
+        state.counters["writerUtilization"] = static_cast<double>(writerBusyTime.count()) /
+            (applyTime.count() * harness.getWriterThreadCount());
+    }
+}
+
+void BM_ApplyInserts(benchmark::State& state) {
+    OplogApplierBenchmarkHarness harness(state.range(0));
+    harness.createCollection(false);
+
+    runApplyBenchmark(state, harness, [&](int batchNumber) {
+        return harness.makeInserts(batchNumber * kBatchSize, (batchNumber + 1) * kBatchSize);
+    });
+}
+
+void BM_ApplyInsertsUniqueIndex(benchmark::State& state) {
+    OplogApplierBenchmarkHarness harness(state.range(0));
+    harness.createCollection(true);
+
+    runApplyBenchmark(state, harness, [&](int batchNumber) {
+        return harness.makeInserts(batchNumber * kBatchSize, (batchNumber + 1) * kBatchSize);
+    });
+}
+
+void BM_ApplyUpdates(benchmark::State& state) {
+    OplogApplierBenchmarkHarness harness(state.range(0));
+    const auto shape = static_cast<UpdateShape>(state.range(1));
+    harness.createCollection(false);
+    harness.apply(harness.makeInserts(0, kBatchSize));
+
+    // Every batch updates each document once.
+    runApplyBenchmark(state, harness, [&](int batchNumber) {
+        std::vector<OplogEntry> ops;
+        for (int id = 0; id < kBatchSize; ++id) {
+            ops.push_back(makeUpdateDocumentOplogEntry(harness.nextOpTime(),
+                                                       kNss,
+                                                       BSON("_id" << id),
+                                                       makeUpdate(shape, id, batchNumber + 1)));
+        }
+        return ops;
+    });
+}
+
+void BM_ApplyDeletes(benchmark::State& state) {
+    OplogApplierBenchmarkHarness harness(state.range(0));
+    harness.createCollection(false);
+
+    // The documents each batch deletes are inserted, untimed, right before it.
+    runApplyBenchmark(state, harness, [&](int batchNumber) {
+        const int begin = batchNumber * kBatchSize;
+        harness.apply(harness.makeInserts(begin, begin + kBatchSize));
+
+        std::vector<OplogEntry> ops;
+        for (int id = begin; id < begin + kBatchSize; ++id) {
+            ops.push_back(
+                makeDeleteDocumentOplogEntry(harness.nextOpTime(), kNss, BSON("_id" << id)));
+        }
+        return ops;
+    });
+}
+
+void BM_ApplyApplyOps(benchmark::State& state) {
+    OplogApplierBenchmarkHarness harness(state.range(0));
+    harness.createCollection(false);
+
+    // Each applyOps entry holds kApplyOpsSize inserts, which the applier extracts and distributes
+    // across the writer threads.
+    runApplyBenchmark(state, harness, [&](int batchNumber) {
+        std::vector<OplogEntry> ops;
+        int id = batchNumber * kBatchSize;
+        for (int i = 0; i < kBatchSize / kApplyOpsSize; ++i) {
+            BSONArrayBuilder innerOps;
+            for (int j = 0; j < kApplyOpsSize; ++j, ++id) {
+                innerOps.append(BSON("op"
+                                     << "i"
+                                     << "ns" << kNss.ns() << "o" << makeDocument(id, 0)));
+            }
+            ops.push_back(makeCommandOplogEntry(
+                harness.nextOpTime(), kNss, BSON("applyOps" << innerOps.arr())));
+        }
+        return ops;
+    });
+}
+
+void writerThreadCounts(benchmark::internal::Benchmark* b) {
+    for (int writerThreadCount : {1, 4, 16}) {
+        b->Arg(writerThreadCount);
+    }
+}
+
+void updateShapesAndWriterThreadCounts(benchmark::internal::Benchmark* b) {
+    for (auto shape :
+         {UpdateShape::kSetOneField, UpdateShape::kSetManyFields, UpdateShape::kReplacement}) {
+        for (int writerThreadCount : {1, 4, 16}) {
+            b->Args({writerThreadCount, static_cast<int>(shape)});
+        }
+    }
+}
+
+BENCHMARK(BM_ApplyInserts)->Apply(writerThreadCounts)->UseRealTime();
+BENCHMARK(BM_ApplyInsertsUniqueIndex)->Apply(writerThreadCounts)->UseRealTime();
+BENCHMARK(BM_ApplyUpdates)->Apply(updateShapesAndWriterThreadCounts)->UseRealTime();
+BENCHMARK(BM_ApplyDeletes)->Apply(writerThreadCounts)->UseRealTime();
+BENCHMARK(BM_ApplyApplyOps)->Apply(writerThreadCounts)->UseRealTime();
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
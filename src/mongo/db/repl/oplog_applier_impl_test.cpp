@@ -56,6 +56,8 @@
 #include "mongo/db/repl/idempotency_test_fixture.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_applier.h"
+#include "mongo/db/repl/opqueue_batcher.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_process.h"
 #include "mongo/db/repl/storage_interface.h"
@@ -1856,6 +1858,107 @@ TEST_F(OplogApplierImplTest,
     ASSERT_FALSE(AutoGetCollectionForReadCommand(_opCtx.get(), badNss).getCollection());
 }
 
+TEST_F(OplogApplierImplTest, OplogApplicationThreadFuncAppliesGroupedUpdatesAndDeletes) {
+    TestApplyOplogGroupApplier oplogApplier(
+        nullptr, nullptr, OplogApplier::Options(OplogApplication::Mode::kInitialSync));
+    NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    NamespaceString missingNss("local." + _agent.getSuiteName() + "_" + _agent.getTestName() +
+                               "missing");
+    auto op0 = makeCreateCollectionOplogEntry({Timestamp(Seconds(1), 0), 1LL}, nss);
+    auto op1 = makeInsertDocumentOplogEntry({Timestamp(Seconds(2), 0), 1LL}, nss, BSON("_id" << 1));
+    auto op2 = makeInsertDocumentOplogEntry({Timestamp(Seconds(3), 0), 1LL}, nss, BSON("_id" << 2));
+    auto op3 = makeInsertDocumentOplogEntry({Timestamp(Seconds(4), 0), 1LL}, nss, BSON("_id" << 3));
+    auto op4 = makeUpdateDocumentOplogEntry(
+        {Timestamp(Seconds(5), 0), 1LL}, nss, BSON("_id" << 1), BSON("_id" << 1 << "x" << 1));
+    auto op5 = makeDeleteDocumentOplogEntry({Timestamp(Seconds(6), 0), 1LL}, nss, BSON("_id" << 2));
+    auto op6 = makeUpdateDocumentOplogEntry(
+        {Timestamp(Seconds(7), 0), 1LL}, nss, BSON("_id" << 3), BSON("_id" << 3 << "x" << 3));
+    auto op7 =
+        makeDeleteDocumentOplogEntry({Timestamp(Seconds(8), 0), 1LL}, missingNss, BSON("_id" << 1));
+    auto op8 =
+        makeDeleteDocumentOplogEntry({Timestamp(Seconds(9), 0), 1LL}, missingNss, BSON("_id" << 2));
+    MultiApplier::OperationPtrs ops = {&op0, &op1, &op2, &op3, &op4, &op5, &op6, &op7, &op8};
+    WorkerMultikeyPathInfo pathInfo;
+    ASSERT_OK(oplogApplier.applyOplogBatchPerWorker(_opCtx.get(), &ops, &pathInfo));
+
+    CollectionReader collectionReader(_opCtx.get(), nss);
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 1 << "x" << 1), unittest::assertGet(collectionReader.next()));
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 3 << "x" << 3), unittest::assertGet(collectionReader.next()));
+    ASSERT_EQUALS(ErrorCodes::CollectionIsEmpty, collectionReader.next().getStatus());
+
+    // Deletes on a collection that does not exist are still treated as successful.
+    ASSERT_FALSE(AutoGetCollectionForReadCommand(_opCtx.get(), missingNss).getCollection());
+}
+
+TEST(AdaptiveBatchLimitTest, UsesMaximumUntilABatchHasBeenRecorded) {
+    AdaptiveBatchLimit limit;
+    ASSERT_EQUALS(5000U, limit.getLimitOps(5000U, Milliseconds(100)));
+}
+
+TEST(AdaptiveBatchLimitTest, UsesMaximumWithoutATarget) {
+    AdaptiveBatchLimit limit;
+    limit.recordBatchApplied(100U, Milliseconds(100));
+    ASSERT_EQUALS(5000U, limit.getLimitOps(5000U, Milliseconds(0)));
+}
+
+TEST(AdaptiveBatchLimitTest, SizesBatchesToApplyWithinTheTarget) {
+    AdaptiveBatchLimit limit;
+
+    // 1000 operations per second.
+    limit.recordBatchApplied(100U, Milliseconds(100));
+    ASSERT_EQUALS(200U, limit.getLimitOps(5000U, Milliseconds(200)));
+    ASSERT_EQUALS(5000U, limit.getLimitOps(5000U, Milliseconds(60 * 1000)));
+    ASSERT_EQUALS(AdaptiveBatchLimit::kMinLimitOps, limit.getLimitOps(5000U, Milliseconds(1)));
+
+    // A batch at 9000 operations per second moves the average to 2000.
+    limit.recordBatchApplied(900U, Milliseconds(100));
+    ASSERT_EQUALS(400U, limit.getLimitOps(5000U, Milliseconds(200)));
+
+    // Batches that apply too quickly to be timed are ignored.
+    limit.recordBatchApplied(10U, Milliseconds(0));
+    ASSERT_EQUALS(400U, limit.getLimitOps(5000U, Milliseconds(200)));
+}
+
+TEST_F(OplogApplierImplTest, ApplyBatchWithDocumentPrefetchAppliesUpdatesAndDeletes) {
+    const bool originalPrefetch = oplogApplicationPrefetchDocuments.load();
+    oplogApplicationPrefetchDocuments.store(true);
+    ON_BLOCK_EXIT([&] { oplogApplicationPrefetchDocuments.store(originalPrefetch); });
+
+    NamespaceString nss("test." + _agent.getTestName());
+    createCollectionWithUuid(_opCtx.get(), nss);
+
+    auto writerPool = makeReplWriterPool();
+    NoopOplogApplierObserver observer;
+    OplogApplierImpl oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+
+    ASSERT_OK(oplogApplier.applyOplogBatch(
+        _opCtx.get(),
+        {makeInsertDocumentOplogEntry({Timestamp(Seconds(1), 0), 1LL}, nss, BSON("_id" << 0)),
+         makeInsertDocumentOplogEntry({Timestamp(Seconds(2), 0), 1LL}, nss, BSON("_id" << 1))}));
+
+    // The second batch prefetches both existing documents and the missing one before applying.
+    ASSERT_OK(oplogApplier.applyOplogBatch(
+        _opCtx.get(),
+        {makeUpdateDocumentOplogEntry({Timestamp(Seconds(3), 0), 1LL},
+                                      nss,
+                                      BSON("_id" << 0),
+                                      BSON("_id" << 0 << "x" << 2)),
+         makeDeleteDocumentOplogEntry({Timestamp(Seconds(4), 0), 1LL}, nss, BSON("_id" << 1)),
+         makeDeleteDocumentOplogEntry({Timestamp(Seconds(5), 0), 1LL}, nss, BSON("_id" << 2))}));
+
+    CollectionReader collectionReader(_opCtx.get(), nss);
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 0 << "x" << 2), unittest::assertGet(collectionReader.next()));
+    ASSERT_EQUALS(ErrorCodes::CollectionIsEmpty, collectionReader.next().getStatus());
+}
+
 TEST_F(IdempotencyTest, Geo2dsphereIndexFailedOnUpdate) {
     ASSERT_OK(
         ReplicationCoordinator::get(_opCtx.get())->setFollowerMode(MemberState::RS_RECOVERING));
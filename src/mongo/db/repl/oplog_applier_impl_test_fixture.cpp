@@ -71,7 +71,8 @@ void OplogApplierImplOpObserver::onDelete(OperationContext* opCtx,
                                           OptionalCollectionUUID uuid,
                                           StmtId stmtId,
                                           bool fromMigrate,
-                                          const boost::optional<BSONObj>& deletedDoc) {
+                                          const boost::optional<BSONObj>& deletedDoc,
+                                          const repl::OplogSlot& oplogSlot) {
     if (!onDeleteFn) {
         return;
     }
@@ -88,7 +88,8 @@ public:
                   OptionalCollectionUUID uuid,
                   StmtId stmtId,
                   bool fromMigrate,
-                  const boost::optional<BSONObj>& deletedDoc) override;
+                  const boost::optional<BSONObj>& deletedDoc,
+                  const repl::OplogSlot& oplogSlot) override;
 
     /**
      * Called when OplogApplierImpl creates a collection.
@@ -123,6 +124,14 @@ public:
 
 class OplogApplierImplTest : public ServiceContextMongoDTest {
 protected:
+    OplogApplierImplTest() = default;
+
+    /**
+     * Build an OplogApplierImplTest, using the named storage engine.
+     */
+    explicit OplogApplierImplTest(std::string storageEngine)
+        : ServiceContextMongoDTest(std::move(storageEngine)) {}
+
     void _testApplyOplogEntryOrGroupedInsertsCrudOperation(ErrorCodes::Error expectedError,
                                                            const OplogEntry& op,
                                                            bool expectedApplyOpCalled);
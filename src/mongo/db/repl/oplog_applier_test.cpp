@@ -328,6 +328,32 @@ TEST_F(OplogApplierTest, GetNextApplierBatchChecksBatchLimitsForSizeOfOperations
     ASSERT_EQUALS(srcOps[2], batch[0]);
 }
 
+TEST_F(OplogApplierTest, GetNextApplierBatchChecksSizeLimitBeforeParsingNextOperation) {
+    OplogApplier::Operations srcOps;
+    srcOps.push_back(makeInsertOplogEntry(1, NamespaceString(dbName, "bar")));
+
+    // An entry with an unsupported oplog version fails the batch that parses it.
+    BSONObjBuilder badVersionBuilder;
+    for (auto&& elem : makeInsertOplogEntry(2, NamespaceString(dbName, "bar")).toBSON()) {
+        if (elem.fieldNameStringData() != OplogEntry::kVersionFieldName) {
+            badVersionBuilder.append(elem);
+        }
+    }
+    badVersionBuilder.append(OplogEntry::kVersionFieldName, OplogEntry::kOplogVersion + 1);
+    srcOps.push_back(OplogEntry(badVersionBuilder.obj()));
+    _applier->enqueue(_opCtx.get(), srcOps.cbegin(), srcOps.cend());
+
+    _limits.bytes = std::size_t(srcOps[0].getRawObjSizeBytes());
+
+    // First batch: [insert]. The second entry does not fit, so it is not parsed yet.
+    auto batch = unittest::assertGet(_applier->getNextApplierBatch(_opCtx.get(), _limits));
+    ASSERT_EQUALS(1U, batch.size()) << toString(batch);
+    ASSERT_EQUALS(srcOps[0], batch[0]);
+
+    ASSERT_EQUALS(ErrorCodes::BadValue,
+                  _applier->getNextApplierBatch(_opCtx.get(), _limits).getStatus());
+}
+
 TEST_F(OplogApplierTest,
        GetNextApplierBatchChecksBatchLimitsUsingEmbededCountInUnpreparedCommitTransactionOp1) {
     OplogApplier::Operations srcOps;
@@ -30,10 +30,46 @@
 #define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kReplication
 
 #include "mongo/db/repl/opqueue_batcher.h"
+
+#include <algorithm>
+
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
 namespace repl {
+namespace {
+
+// The operation limit chosen for the most recent batch.
+AtomicWord<long long> batchLimitOps;
+ServerStatusMetricField<AtomicWord<long long>> displayBatchLimitOps("repl.apply.batchLimitOps",
+                                                                    &batchLimitOps);
+
+}  // namespace
+
+void AdaptiveBatchLimit::recordBatchApplied(std::size_t numOps, Milliseconds applyDuration) {
+    // Batches that apply in under a millisecond tell us little about the throughput.
+    if (applyDuration < Milliseconds(1)) {
+        return;
+    }
+
+    const long long sample = numOps * 1000 / durationCount<Milliseconds>(applyDuration);
+    const long long average = _opsPerSecond.load();
+    _opsPerSecond.store(average == 0 ? sample : (average * 7 + sample) / 8);
+}
+
+std::size_t AdaptiveBatchLimit::getLimitOps(std::size_t maxOps,
+                                            Milliseconds targetApplyDuration) const {
+    const long long opsPerSecond = _opsPerSecond.load();
+    if (targetApplyDuration <= Milliseconds(0) || opsPerSecond == 0) {
+        return maxOps;
+    }
+
+    const auto limit =
+        std::size_t(opsPerSecond * durationCount<Milliseconds>(targetApplyDuration) / 1000);
+    return std::min(maxOps, std::max(kMinLimitOps, limit));
+}
 
 
 OpQueueBatcher::OpQueueBatcher(OplogApplier* oplogApplier,
@@ -75,6 +111,10 @@ OpQueue OpQueueBatcher::getNextBatch(Seconds maxWaitTime) {
     return ops;
 }
 
+void OpQueueBatcher::recordBatchApplied(std::size_t numOps, Milliseconds applyDuration) {
+    _adaptiveBatchLimit.recordBatchApplied(numOps, applyDuration);
+}
+
 /**
  * If slaveDelay is enabled, this function calculates the most recent timestamp of any oplog
  * entries that can be be returned in a batch.
@@ -101,7 +141,9 @@ void OpQueueBatcher::run() {
         batchLimits.slaveDelayLatestTimestamp = _calculateSlaveDelayLatestTimestamp();
 
         // Check the limits once per batch since users can change them at runtime.
-        batchLimits.ops = getBatchLimitOplogEntries();
+        batchLimits.ops = _adaptiveBatchLimit.getLimitOps(
+            getBatchLimitOplogEntries(), Milliseconds(replBatchTargetApplyMillis.load()));
+        batchLimitOps.store(batchLimits.ops);
 
         OpQueue ops(batchLimits.ops);
         {
@@ -120,8 +162,10 @@ void OpQueueBatcher::run() {
 
             auto oplogEntries =
                 fassertNoTrace(31004, _getNextApplierBatchFn(opCtx.get(), batchLimits));
-            for (const auto& oplogEntry : oplogEntries) {
-                ops.emplace_back(oplogEntry);
+            // The entries are parsed once, here on the batcher thread, while the applier is still
+            // busy with the previous batch. Move them rather than copy every parsed field again.
+            for (auto& oplogEntry : oplogEntries) {
+                ops.emplace_back(std::move(oplogEntry));
             }
 
             // If we don't have anything in the queue, wait a bit for something to appear.
@@ -31,6 +31,8 @@
 
 #include "mongo/db/repl/initial_syncer.h"
 #include "mongo/db/repl/oplog_applier_impl.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 namespace repl {
@@ -114,6 +116,36 @@ private:
     boost::optional<long long> _termWhenExhausted;
 };
 
+/**
+ * Picks the operation limit of each batch so that applying it takes about
+ * replBatchTargetApplyMillis at the throughput of recent batches. Under heavy load this lets
+ * batches grow to amortize the per-batch overhead, while a slow applier gets smaller batches that
+ * advance lastApplied, and with it the majority commit point, more often.
+ *
+ * The applier records each batch and the batcher reads the limit from another thread.
+ */
+class AdaptiveBatchLimit {
+public:
+    // Keep batches from shrinking to the point where the per-batch overhead dominates.
+    static constexpr std::size_t kMinLimitOps = 16;
+
+    /**
+     * Folds the throughput of a batch of 'numOps' operations that took 'applyDuration' to apply
+     * into the moving average.
+     */
+    void recordBatchApplied(std::size_t numOps, Milliseconds applyDuration);
+
+    /**
+     * Returns the operation limit for the next batch. This is 'maxOps' until the first batch has
+     * been recorded or when 'targetApplyDuration' is not positive, and never more than 'maxOps'.
+     */
+    std::size_t getLimitOps(std::size_t maxOps, Milliseconds targetApplyDuration) const;
+
+private:
+    // Moving average of the apply throughput in operations per second, zero until the first batch.
+    AtomicWord<long long> _opsPerSecond{0};
+};
+
 class OpQueueBatcher {
     OpQueueBatcher(const OpQueueBatcher&) = delete;
     OpQueueBatcher& operator=(const OpQueueBatcher&) = delete;
@@ -134,6 +166,11 @@ public:
      */
     OpQueue getNextBatch(Seconds maxWaitTime);
 
+    /**
+     * Reports how long the applier spent applying a batch, to size the following batches.
+     */
+    void recordBatchApplied(std::size_t numOps, Milliseconds applyDuration);
+
 private:
     /**
      * If slaveDelay is enabled, this function calculates the most recent timestamp of any oplog
@@ -147,6 +184,7 @@ private:
     StorageInterface* const _storageInterface;
     OplogBuffer* const _oplogBuffer;
     OplogApplier::GetNextApplierBatchFn const _getNextApplierBatchFn;
+    AdaptiveBatchLimit _adaptiveBatchLimit;
 
     Mutex _mutex = MONGO_MAKE_LATCH("OpQueueBatcher::_mutex");
     stdx::condition_variable _cv;
@@ -73,6 +73,7 @@
 #include "mongo/db/repl/repl_settings.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_metrics.h"
+#include "mongo/db/repl/replication_network_connection_hook.h"
 #include "mongo/db/repl/replication_process.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/s/balancer/balancer.h"
@@ -101,6 +102,7 @@
 #include "mongo/transport/service_entry_point.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/concurrency/work_stealing_thread_pool.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log.h"
@@ -137,13 +139,23 @@ ServerStatusMetricField<Counter64> displayBufferMaxSize("repl.buffer.maxSizeByte
 /**
  * Returns new thread pool for thread pool task executor.
  */
-auto makeThreadPool(const std::string& poolName) {
-    ThreadPool::Options threadPoolOptions;
-    threadPoolOptions.poolName = poolName;
-    threadPoolOptions.onCreateThread = [](const std::string& threadName) {
+std::unique_ptr<ThreadPoolInterface> makeThreadPool(const std::string& poolName) {
+    auto onCreateThread = [](const std::string& threadName) {
         Client::initThread(threadName.c_str());
         AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
     };
+
+    if (replExecutorWorkStealingThreadCount > 0) {
+        WorkStealingThreadPool::Options threadPoolOptions;
+        threadPoolOptions.poolName = poolName;
+        threadPoolOptions.numThreads = static_cast<size_t>(replExecutorWorkStealingThreadCount);
+        threadPoolOptions.onCreateThread = onCreateThread;
+        return std::make_unique<WorkStealingThreadPool>(std::move(threadPoolOptions));
+    }
+
+    ThreadPool::Options threadPoolOptions;
+    threadPoolOptions.poolName = poolName;
+    threadPoolOptions.onCreateThread = onCreateThread;
     return std::make_unique<ThreadPool>(threadPoolOptions);
 }
 
@@ -155,7 +167,8 @@ auto makeTaskExecutor(ServiceContext* service, const std::string& poolName) {
     hookList->addHook(std::make_unique<rpc::LogicalTimeMetadataHook>(service));
     return std::make_unique<executor::ThreadPoolTaskExecutor>(
         makeThreadPool(poolName),
-        executor::makeNetworkInterface("RS", nullptr, std::move(hookList)));
+        executor::makeNetworkInterface(
+            "RS", std::make_unique<ReplicationNetworkConnectionHook>(), std::move(hookList)));
 }
 
 /**
@@ -78,6 +78,7 @@
 #include "mongo/db/repl/update_position_args.h"
 #include "mongo/db/repl/vote_requester.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/stats/timer_stats.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/db/write_concern_options.h"
 #include "mongo/executor/connection_pool_stats.h"
@@ -120,6 +121,37 @@ Counter64 userOpsRunning;
 ServerStatusMetricField<Counter64> displayUserOpsRunning(
     "repl.stateTransition.userOperationsRunning", &userOpsRunning);
 
+// Tracks how long after the primary wrote an operation this node learned that it was majority
+// committed. On secondaries this includes any clock skew between the members.
+TimerStats commitPointLagStats;
+ServerStatusMetricField<TimerStats> displayCommitPointLag("repl.commitPoint.lag",
+                                                          &commitPointLagStats);
+Counter64 commitPointLagUnder10ms;
+ServerStatusMetricField<Counter64> displayCommitPointLagUnder10ms(
+    "repl.commitPoint.lagHistogram.under10ms", &commitPointLagUnder10ms);
+Counter64 commitPointLagUnder100ms;
+ServerStatusMetricField<Counter64> displayCommitPointLagUnder100ms(
+    "repl.commitPoint.lagHistogram.under100ms", &commitPointLagUnder100ms);
+Counter64 commitPointLagUnder1000ms;
+ServerStatusMetricField<Counter64> displayCommitPointLagUnder1000ms(
+    "repl.commitPoint.lagHistogram.under1000ms", &commitPointLagUnder1000ms);
+Counter64 commitPointLagAtLeast1000ms;
+ServerStatusMetricField<Counter64> displayCommitPointLagAtLeast1000ms(
+    "repl.commitPoint.lagHistogram.atLeast1000ms", &commitPointLagAtLeast1000ms);
+
+void recordCommitPointLag(Milliseconds lag) {
+    commitPointLagStats.recordMillis(durationCount<Milliseconds>(lag));
+    if (lag < Milliseconds(10)) {
+        commitPointLagUnder10ms.increment();
+    } else if (lag < Milliseconds(100)) {
+        commitPointLagUnder100ms.increment();
+    } else if (lag < Milliseconds(1000)) {
+        commitPointLagUnder1000ms.increment();
+    } else {
+        commitPointLagAtLeast1000ms.increment();
+    }
+}
+
 using CallbackArgs = executor::TaskExecutor::CallbackArgs;
 using CallbackFn = executor::TaskExecutor::CallbackFn;
 using CallbackHandle = executor::TaskExecutor::CallbackHandle;
@@ -199,62 +231,6 @@ Status futureGetNoThrowWithDeadline(OperationContext* opCtx,
 
 }  // namespace
 
-void ReplicationCoordinatorImpl::WaiterList::add_inlock(const OpTime& opTime,
-                                                        SharedWaiterHandle waiter) {
-    _waiters.emplace(opTime, std::move(waiter));
-}
-
-SharedSemiFuture<void> ReplicationCoordinatorImpl::WaiterList::add_inlock(
-    const OpTime& opTime, boost::optional<WriteConcernOptions> wc) {
-    auto pf = makePromiseFuture<void>();
-    _waiters.emplace(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
-    return std::move(pf.future);
-}
-
-bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(SharedWaiterHandle waiter) {
-    for (auto iter = _waiters.begin(); iter != _waiters.end(); iter++) {
-        if (iter->second == waiter) {
-            _waiters.erase(iter);
-            return true;
-        }
-    }
-    return false;
-}
-
-template <typename Func>
-void ReplicationCoordinatorImpl::WaiterList::setValueIf_inlock(Func&& func,
-                                                               boost::optional<OpTime> opTime) {
-    for (auto it = _waiters.begin(); it != _waiters.end() && (!opTime || it->first <= *opTime);) {
-        const auto& waiter = it->second;
-        try {
-            if (func(it->first, waiter)) {
-                waiter->promise.emplaceValue();
-                it = _waiters.erase(it);
-            } else {
-                ++it;
-            }
-        } catch (const DBException& e) {
-            waiter->promise.setError(e.toStatus());
-            it = _waiters.erase(it);
-        }
-    }
-}
-
-void ReplicationCoordinatorImpl::WaiterList::setValueAll_inlock() {
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.emplaceValue();
-    }
-    _waiters.clear();
-}
-
-void ReplicationCoordinatorImpl::WaiterList::setErrorAll_inlock(Status status) {
-    invariant(!status.isOK());
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.setError(status);
-    }
-    _waiters.clear();
-}
-
 namespace {
 ReplicationCoordinator::Mode getReplicationModeFromSettings(const ReplSettings& settings) {
     if (settings.usingReplSets()) {
@@ -3291,10 +3267,9 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig(WithLock lk,
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters(WithLock lk, boost::optional<OpTime> opTime) {
-    _replicationWaiterList.setValueIf_inlock(
-        [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
-            invariant(waiter->writeConcern);
-            return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
+    _replicationWaiterList.setValueIfWriteConcernSatisfied_inlock(
+        [this](const OpTime& opTime, const WriteConcernOptions& writeConcern) {
+            return _doneWaitingForReplication_inlock(opTime, writeConcern);
         },
         opTime);
 }
@@ -3746,6 +3721,11 @@ void ReplicationCoordinatorImpl::_advanceCommitPoint(
         _setStableTimestampForStorage(lk);
         // Even if we have no new snapshot, we need to notify waiters that the commit point moved.
         _externalState->notifyOplogMetadataWaiters(committedOpTimeAndWallTime.opTime);
+
+        if (committedOpTimeAndWallTime.wallTime != Date_t()) {
+            recordCommitPointLag(std::max(
+                Milliseconds(0), _replExecutor->now() - committedOpTimeAndWallTime.wallTime));
+        }
     }
 }
 
@@ -44,6 +44,7 @@
 #include "mongo/db/repl/repl_set_config.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_coordinator_external_state.h"
+#include "mongo/db/repl/replication_waiter_list.h"
 #include "mongo/db/repl/sync_source_resolver.h"
 #include "mongo/db/repl/topology_coordinator.h"
 #include "mongo/db/repl/update_position_args.h"
@@ -596,37 +597,9 @@ private:
         ReplicationCoordinator::OpsKillingStateTransitionEnum _stateTransition;
     };
 
-    struct Waiter {
-        Promise<void> promise;
-        boost::optional<WriteConcernOptions> writeConcern;
-        explicit Waiter(Promise<void> p, boost::optional<WriteConcernOptions> w = boost::none)
-            : promise(std::move(p)), writeConcern(w) {}
-    };
-
-    using SharedWaiterHandle = std::shared_ptr<Waiter>;
-
-    class WaiterList {
-    public:
-        // Adds waiter into the list.
-        void add_inlock(const OpTime& opTime, SharedWaiterHandle waiter);
-        // Adds a waiter into the list and returns the future of the waiter's promise.
-        SharedSemiFuture<void> add_inlock(const OpTime& opTime,
-                                          boost::optional<WriteConcernOptions> w = boost::none);
-        // Returns whether waiter is found and removed.
-        bool remove_inlock(SharedWaiterHandle waiter);
-        // Signals all waiters whose opTime is <= the given opTime (if any) that satisfy the
-        // condition in func.
-        template <typename Func>
-        void setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
-        // Signals all waiters from the list and fulfills promises with OK status.
-        void setValueAll_inlock();
-        // Signals all waiters from the list and fulfills promises with Error status.
-        void setErrorAll_inlock(Status status);
-
-    private:
-        // Waiters sorted by OpTime.
-        std::multimap<OpTime, SharedWaiterHandle> _waiters;
-    };
+    using Waiter = ReplicationWaiter;
+    using SharedWaiterHandle = ReplicationWaiterList::SharedWaiterHandle;
+    using WaiterList = ReplicationWaiterList;
 
     typedef std::vector<executor::TaskExecutor::CallbackHandle> HeartbeatHandles;
 
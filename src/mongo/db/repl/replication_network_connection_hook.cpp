@@ -0,0 +1,109 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/replication_network_connection_hook.h"
+
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+constexpr StringData kCompressionFieldName = "compression"_sd;
+
+}  // namespace
+
+BSONObj ReplicationNetworkConnectionHook::augmentIsMasterRequest(BSONObj cmdObj) {
+    if (replicationNetworkPreferredCompressor.empty()) {
+        return cmdObj;
+    }
+    return preferCompressor(std::move(cmdObj), replicationNetworkPreferredCompressor);
+}
+
+Status ReplicationNetworkConnectionHook::validateHost(
+    const HostAndPort& remoteHost,
+    const BSONObj& isMasterRequest,
+    const executor::RemoteCommandResponse& isMasterReply) {
+    return Status::OK();
+}
+
+StatusWith<boost::optional<executor::RemoteCommandRequest>>
+ReplicationNetworkConnectionHook::makeRequest(const HostAndPort& remoteHost) {
+    return {boost::none};
+}
+
+Status ReplicationNetworkConnectionHook::handleReply(const HostAndPort& remoteHost,
+                                                     executor::RemoteCommandResponse&& response) {
+    MONGO_UNREACHABLE;
+}
+
+BSONObj ReplicationNetworkConnectionHook::preferCompressor(BSONObj cmdObj, StringData compressor) {
+    const auto offeredElem = cmdObj[kCompressionFieldName];
+    if (offeredElem.type() != Array) {
+        return cmdObj;
+    }
+
+    bool offered = false;
+    std::vector<BSONElement> others;
+    for (auto&& elem : offeredElem.Obj()) {
+        if (elem.type() == String && elem.valueStringData() == compressor) {
+            offered = true;
+        } else {
+            others.push_back(elem);
+        }
+    }
+    if (!offered) {
+        return cmdObj;
+    }
+
+    BSONObjBuilder bob;
+    for (auto&& elem : cmdObj) {
+        if (elem.fieldNameStringData() != kCompressionFieldName) {
+            bob.append(elem);
+            continue;
+        }
+
+        BSONArrayBuilder compressors(bob.subarrayStart(kCompressionFieldName));
+        compressors.append(compressor);
+        for (auto&& other : others) {
+            compressors.append(other);
+        }
+    }
+    return bob.obj();
+}
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,66 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/executor/network_connection_hook.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * The NetworkConnectionHook for the replication network interface. It moves the compressor named
+ * by the replicationNetworkPreferredCompressor server parameter to the front of the list offered in
+ * the isMaster request. The remote node picks compressors in the order they were offered, so that
+ * is the one this node's requests, and the remote node's replies to them, are compressed with.
+ */
+class ReplicationNetworkConnectionHook final : public executor::NetworkConnectionHook {
+public:
+    BSONObj augmentIsMasterRequest(BSONObj cmdObj) override;
+
+    Status validateHost(const HostAndPort& remoteHost,
+                        const BSONObj& isMasterRequest,
+                        const executor::RemoteCommandResponse& isMasterReply) override;
+
+    StatusWith<boost::optional<executor::RemoteCommandRequest>> makeRequest(
+        const HostAndPort& remoteHost) override;
+
+    Status handleReply(const HostAndPort& remoteHost,
+                       executor::RemoteCommandResponse&& response) override;
+
+    /**
+     * Returns 'cmdObj' with 'compressor' moved to the front of its "compression" array. Returns
+     * 'cmdObj' unchanged if 'compressor' isn't offered in it.
+     */
+    static BSONObj preferCompressor(BSONObj cmdObj, StringData compressor);
+};
+
+}  // namespace repl
+}  // namespace mongo
@@ -60,6 +60,17 @@ namespace {
 const auto kRecoveryBatchLogLevel = logger::LogSeverity::Debug(2);
 const auto kRecoveryOperationLogLevel = logger::LogSeverity::Debug(3);
 
+// How often to report the progress of oplog application during recovery.
+const int kRecoveryProgressLogIntervalSeconds = 10;
+
+/**
+ * Returns the number of operations applied per second, given the time it took to apply them.
+ */
+long long opsPerSecond(std::size_t numOps, long long elapsedMillis) {
+    const auto ops = static_cast<long long>(numOps);
+    return elapsedMillis > 0 ? ops * 1000 / elapsedMillis : ops;
+}
+
 /**
  * Tracks and logs operations applied during recovery.
  */
@@ -86,16 +97,40 @@ public:
         }
     }
 
-    void onBatchEnd(const StatusWith<OpTime>&, const OplogApplier::Operations&) final {}
+    void onBatchEnd(const StatusWith<OpTime>& lastOpTimeApplied,
+                    const OplogApplier::Operations&) final {
+        if (!lastOpTimeApplied.isOK() ||
+            _progressTimer.seconds() < kRecoveryProgressLogIntervalSeconds) {
+            return;
+        }
+
+        log() << "Replication recovery has applied " << _numOpsApplied << " operations in "
+              << _numBatches << " batches through optime " << lastOpTimeApplied.getValue()
+              << " ("
+              << opsPerSecond(_numOpsApplied - _numOpsAppliedAtLastProgress,
+                              _progressTimer.millis())
+              << " operations per second)";
+        _numOpsAppliedAtLastProgress = _numOpsApplied;
+        _progressTimer.reset();
+    }
 
     void complete(const OpTime& applyThroughOpTime) const {
+        const auto elapsedMillis = _totalTimer.millis();
         log() << "Applied " << _numOpsApplied << " operations in " << _numBatches
-              << " batches. Last operation applied with optime: " << applyThroughOpTime;
+              << " batches. Last operation applied with optime: " << applyThroughOpTime
+              << ". Took " << elapsedMillis << "ms ("
+              << opsPerSecond(_numOpsApplied, elapsedMillis) << " operations per second)";
     }
 
 private:
     std::size_t _numBatches = 0;
     std::size_t _numOpsApplied = 0;
+
+    // Times the whole of recovery oplog application, and the interval since progress was last
+    // reported.
+    Timer _totalTimer;
+    Timer _progressTimer;
+    std::size_t _numOpsAppliedAtLastProgress = 0;
 };
 
 /**
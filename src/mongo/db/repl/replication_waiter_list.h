@@ -0,0 +1,151 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/status.h"
+#include "mongo/db/repl/optime.h"
+#include "mongo/db/write_concern_options.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/future.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * A thread waiting for an opTime to be reached, either locally or with a write concern.
+ */
+struct ReplicationWaiter {
+    Promise<void> promise;
+    boost::optional<WriteConcernOptions> writeConcern;
+    explicit ReplicationWaiter(Promise<void> p,
+                               boost::optional<WriteConcernOptions> w = boost::none)
+        : promise(std::move(p)), writeConcern(w) {}
+};
+
+/**
+ * Waiters sorted by the opTime they wait for. Not thread safe; every method must be called while
+ * holding the mutex of the owning ReplicationCoordinator.
+ */
+class ReplicationWaiterList {
+public:
+    using SharedWaiterHandle = std::shared_ptr<ReplicationWaiter>;
+
+    // Adds waiter into the list.
+    void add_inlock(const OpTime& opTime, SharedWaiterHandle waiter);
+    // Adds a waiter into the list and returns the future of the waiter's promise.
+    SharedSemiFuture<void> add_inlock(const OpTime& opTime,
+                                      boost::optional<WriteConcernOptions> w = boost::none);
+    // Returns whether waiter is found and removed.
+    bool remove_inlock(SharedWaiterHandle waiter);
+    // Signals all waiters whose opTime is <= the given opTime (if any) that satisfy the
+    // condition in func.
+    template <typename Func>
+    void setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
+    // Signals all waiters whose opTime is <= the given opTime (if any) and whose write concern
+    // 'isSatisfied(opTime, writeConcern)' returns true for. This relies on a write concern that is
+    // not satisfied at some opTime not being satisfied at any later one either, so 'isSatisfied' is
+    // not called again for the same write concern once it returns false. Every waiter must have a
+    // write concern.
+    template <typename Func>
+    void setValueIfWriteConcernSatisfied_inlock(Func&& isSatisfied,
+                                                boost::optional<OpTime> opTime = boost::none);
+    // Signals all waiters from the list and fulfills promises with OK status.
+    void setValueAll_inlock();
+    // Signals all waiters from the list and fulfills promises with Error status.
+    void setErrorAll_inlock(Status status);
+
+    size_t size_inlock() const {
+        return _waiters.size();
+    }
+
+private:
+    // Waiters sorted by OpTime.
+    std::multimap<OpTime, SharedWaiterHandle> _waiters;
+};
+
+template <typename Func>
+void ReplicationWaiterList::setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime) {
+    for (auto it = _waiters.begin(); it != _waiters.end() && (!opTime || it->first <= *opTime);) {
+        const auto& waiter = it->second;
+        try {
+            if (func(it->first, waiter)) {
+                waiter->promise.emplaceValue();
+                it = _waiters.erase(it);
+            } else {
+                ++it;
+            }
+        } catch (const DBException& e) {
+            waiter->promise.setError(e.toStatus());
+            it = _waiters.erase(it);
+        }
+    }
+}
+
+template <typename Func>
+void ReplicationWaiterList::setValueIfWriteConcernSatisfied_inlock(Func&& isSatisfied,
+                                                                 boost::optional<OpTime> opTime) {
+    // The write concerns seen not to be satisfied during this pass. There are usually only a few
+    // distinct ones however many waiters there are.
+    std::vector<const WriteConcernOptions*> unsatisfied;
+    auto isKnownUnsatisfied = [&](const WriteConcernOptions& writeConcern) {
+        for (auto other : unsatisfied) {
+            if (other->wNumNodes == writeConcern.wNumNodes &&
+                other->syncMode == writeConcern.syncMode && other->wMode == writeConcern.wMode) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    setValueIf_inlock(
+        [&](const OpTime& waitOpTime, const SharedWaiterHandle& waiter) {
+            invariant(waiter->writeConcern);
+            const auto& writeConcern = *waiter->writeConcern;
+            if (isKnownUnsatisfied(writeConcern)) {
+                return false;
+            }
+            if (isSatisfied(waitOpTime, writeConcern)) {
+                return true;
+            }
+            unsatisfied.push_back(&writeConcern);
+            return false;
+        },
+        opTime);
+}
+
+}  // namespace repl
+}  // namespace mongo
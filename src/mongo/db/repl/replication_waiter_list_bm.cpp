@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <array>
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/repl/replication_waiter_list.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+// How far each member of a five-member set has replicated, as the topology coordinator would
+// check for a write concern.
+const std::array<OpTime, 5> kMemberOpTimes = {OpTime(Timestamp(1000, 0), 1),
+                                              OpTime(Timestamp(1000, 0), 1),
+                                              OpTime(Timestamp(10, 0), 1),
+                                              OpTime(Timestamp(10, 0), 1),
+                                              OpTime(Timestamp(10, 0), 1)};
+
+bool haveMajorityReached(const OpTime& opTime, const WriteConcernOptions&, size_t* numChecks) {
+    ++*numChecks;
+    size_t numReached = 0;
+    for (const auto& memberOpTime : kMemberOpTimes) {
+        if (memberOpTime >= opTime) {
+            ++numReached;
+        }
+    }
+    return numReached > kMemberOpTimes.size() / 2;
+}
+
+/**
+ * Fills the list with 'state.range(0)' w:majority waiters that wait for opTimes newer than a
+ * majority of the set has reached, like concurrent writers waiting for their writes to commit.
+ */
+void addMajorityWaiters(benchmark::State& state, ReplicationWaiterList* waiters) {
+    WriteConcernOptions majority(
+        WriteConcernOptions::kMajority, WriteConcernOptions::SyncMode::JOURNAL, Milliseconds(0));
+    for (int i = 0; i < state.range(0); ++i) {
+        waiters->add_inlock(OpTime(Timestamp(100 + i, 0), 1), majority);
+    }
+}
+
+/**
+ * The pass the replication coordinator makes over the waiters whenever a member reports progress
+ * that does not yet commit any of them.
+ */
+void BM_WakeReplicationWaiters(benchmark::State& state) {
+    ReplicationWaiterList waiters;
+    addMajorityWaiters(state, &waiters);
+
+    size_t numChecks = 0;
+    for (auto _ : state) {
+        waiters.setValueIfWriteConcernSatisfied_inlock(
+            [&](const OpTime& opTime, const WriteConcernOptions& writeConcern) {
+                return haveMajorityReached(opTime, writeConcern, &numChecks);
+            },
+            kMemberOpTimes.front());
+    }
+    invariant(waiters.size_inlock() == size_t(state.range(0)));
+    state.counters["checksPerPass"] = double(numChecks) / state.iterations();
+}
+
+/**
+ * The same pass checking the write concern of every waiter, as it was done before the checks were
+ * shared between waiters with the same write concern.
+ */
+void BM_WakeReplicationWaitersCheckingEach(benchmark::State& state) {
+    ReplicationWaiterList waiters;
+    addMajorityWaiters(state, &waiters);
+
+    size_t numChecks = 0;
+    for (auto _ : state) {
+        waiters.setValueIf_inlock(
+            [&](const OpTime& opTime, const ReplicationWaiterList::SharedWaiterHandle& waiter) {
+                return haveMajorityReached(opTime, *waiter->writeConcern, &numChecks);
+            },
+            kMemberOpTimes.front());
+    }
+    invariant(waiters.size_inlock() == size_t(state.range(0)));
+    state.counters["checksPerPass"] = double(numChecks) / state.iterations();
+}
+
+BENCHMARK(BM_WakeReplicationWaiters)->RangeMultiplier(10)->Range(10, 100 * 1000);
+BENCHMARK(BM_WakeReplicationWaitersCheckingEach)->RangeMultiplier(10)->Range(10, 100 * 1000);
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
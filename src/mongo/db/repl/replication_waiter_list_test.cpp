@@ -0,0 +1,149 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/replication_waiter_list.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+const WriteConcernOptions kMajority(WriteConcernOptions::kMajority,
+                                    WriteConcernOptions::SyncMode::JOURNAL,
+                                    Milliseconds(0));
+const WriteConcernOptions kTwoNodes(2, WriteConcernOptions::SyncMode::NONE, Milliseconds(0));
+
+OpTime opTimeAt(unsigned int secs) {
+    return OpTime(Timestamp(secs, 0), 1);
+}
+
+TEST(ReplicationWaiterListTest, SetValueIfSignalsWaitersUpToOpTime) {
+    ReplicationWaiterList waiters;
+    auto first = waiters.add_inlock(opTimeAt(1));
+    auto second = waiters.add_inlock(opTimeAt(2));
+    auto third = waiters.add_inlock(opTimeAt(3));
+
+    std::vector<OpTime> visited;
+    waiters.setValueIf_inlock(
+        [&](const OpTime& opTime, const ReplicationWaiterList::SharedWaiterHandle&) {
+            visited.push_back(opTime);
+            return opTime != opTimeAt(1);
+        },
+        opTimeAt(2));
+
+    ASSERT_EQUALS(2U, visited.size());
+    ASSERT_FALSE(first.isReady());
+    ASSERT_TRUE(second.isReady());
+    ASSERT_FALSE(third.isReady());
+    ASSERT_EQUALS(2U, waiters.size_inlock());
+}
+
+TEST(ReplicationWaiterListTest, SetValueIfSetsErrorWhenConditionThrows) {
+    ReplicationWaiterList waiters;
+    auto future = waiters.add_inlock(opTimeAt(1));
+
+    waiters.setValueIf_inlock(
+        [](const OpTime&, const ReplicationWaiterList::SharedWaiterHandle&) -> bool {
+            uasserted(ErrorCodes::InternalError, "failed to check waiter");
+        });
+
+    ASSERT_EQUALS(ErrorCodes::InternalError, future.getNoThrow());
+    ASSERT_EQUALS(0U, waiters.size_inlock());
+}
+
+TEST(ReplicationWaiterListTest, WriteConcernSatisfiedChecksEachUnsatisfiedWriteConcernOnce) {
+    ReplicationWaiterList waiters;
+    std::vector<SharedSemiFuture<void>> majorityFutures;
+    std::vector<SharedSemiFuture<void>> twoNodesFutures;
+    for (unsigned int i = 1; i <= 10; ++i) {
+        majorityFutures.push_back(waiters.add_inlock(opTimeAt(i), kMajority));
+        twoNodesFutures.push_back(waiters.add_inlock(opTimeAt(i), kTwoNodes));
+    }
+
+    // A majority has reached opTime 3 and two nodes have reached opTime 5.
+    int numChecks = 0;
+    waiters.setValueIfWriteConcernSatisfied_inlock(
+        [&](const OpTime& opTime, const WriteConcernOptions& writeConcern) {
+            ++numChecks;
+            return opTime <= (writeConcern.wMode.empty() ? opTimeAt(5) : opTimeAt(3));
+        });
+
+    // Each satisfied waiter is checked, plus one check for each write concern that stopped
+    // being satisfied.
+    ASSERT_EQUALS(3 + 5 + 2, numChecks);
+    for (unsigned int i = 0; i < 10; ++i) {
+        ASSERT_EQUALS(i < 3, majorityFutures[i].isReady());
+        ASSERT_EQUALS(i < 5, twoNodesFutures[i].isReady());
+    }
+    ASSERT_EQUALS(7U + 5U, waiters.size_inlock());
+}
+
+TEST(ReplicationWaiterListTest, WriteConcernSatisfiedChecksAgainOnTheNextPass) {
+    ReplicationWaiterList waiters;
+    auto first = waiters.add_inlock(opTimeAt(1), kMajority);
+    auto second = waiters.add_inlock(opTimeAt(2), kMajority);
+
+    OpTime majorityOpTime;
+    auto isSatisfied = [&](const OpTime& opTime, const WriteConcernOptions&) {
+        return opTime <= majorityOpTime;
+    };
+
+    waiters.setValueIfWriteConcernSatisfied_inlock(isSatisfied);
+    ASSERT_FALSE(first.isReady());
+    ASSERT_EQUALS(2U, waiters.size_inlock());
+
+    majorityOpTime = opTimeAt(2);
+    waiters.setValueIfWriteConcernSatisfied_inlock(isSatisfied, opTimeAt(1));
+    ASSERT_TRUE(first.isReady());
+    ASSERT_FALSE(second.isReady());
+
+    waiters.setValueIfWriteConcernSatisfied_inlock(isSatisfied, opTimeAt(2));
+    ASSERT_TRUE(second.isReady());
+    ASSERT_EQUALS(0U, waiters.size_inlock());
+}
+
+TEST(ReplicationWaiterListTest, SetErrorAllSignalsEveryWaiter) {
+    ReplicationWaiterList waiters;
+    auto first = waiters.add_inlock(opTimeAt(1), kMajority);
+    auto second = waiters.add_inlock(opTimeAt(2));
+
+    waiters.setErrorAll_inlock(Status(ErrorCodes::PrimarySteppedDown, "stepped down"));
+
+    ASSERT_EQUALS(ErrorCodes::PrimarySteppedDown, first.getNoThrow());
+    ASSERT_EQUALS(ErrorCodes::PrimarySteppedDown, second.getNoThrow());
+    ASSERT_EQUALS(0U, waiters.size_inlock());
+}
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -93,6 +93,16 @@ StatusWith<DistributionStatus> createCollectionDistributionStatus(
 
     DistributionStatus distribution(chunkMgr->getns(), std::move(shardToChunksMap));
 
+    // Attach the measured write load of the collection's chunks, if it was collected
+    for (const auto& stat : allShards) {
+        for (const auto& chunkLoad : stat.chunkLoad) {
+            if (chunkLoad.nss == chunkMgr->getns()) {
+                distribution.addChunkLoad(
+                    chunkLoad.min, chunkLoad.writeOpsPerSec, chunkLoad.bytesWrittenPerSec);
+            }
+        }
+    }
+
     // Cache the collection tags
     const auto& keyPattern = chunkMgr->getShardKeyPattern().getKeyPattern();
 
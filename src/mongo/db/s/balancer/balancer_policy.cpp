@@ -33,6 +33,7 @@
 
 #include "mongo/db/s/balancer/balancer_policy.h"
 
+#include <cmath>
 #include <random>
 
 #include "mongo/db/s/balancer/type_migration.h"
@@ -58,12 +59,17 @@ namespace {
 // optimal average across all shards for a zone for a rebalancing migration to be initiated.
 const size_t kDefaultImbalanceThreshold = 1;
 
+// This value indicates the minimum fraction by which a shard's load needs to exceed the optimal
+// average load across all shards for a zone for a load balancing migration to be initiated.
+const double kLoadImbalanceThreshold = 0.1;
+
 }  // namespace
 
 DistributionStatus::DistributionStatus(NamespaceString nss, ShardToChunksMap shardToChunksMap)
     : _nss(std::move(nss)),
       _shardChunks(std::move(shardToChunksMap)),
-      _zoneRanges(SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<ZoneRange>()) {}
+      _zoneRanges(SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<ZoneRange>()),
+      _chunkLoads(SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<ChunkLoad>()) {}
 
 size_t DistributionStatus::totalChunks() const {
     size_t total = 0;
@@ -177,6 +183,46 @@ string DistributionStatus::getTagForChunk(const ChunkType& chunk) const {
     return "";
 }
 
+void DistributionStatus::addChunkLoad(const BSONObj& chunkMin,
+                                      double writeOpsPerSec,
+                                      double bytesWrittenPerSec) {
+    auto& chunkLoad = _chunkLoads[chunkMin.getOwned()];
+    chunkLoad.writeOpsPerSec += writeOpsPerSec;
+    chunkLoad.bytesWrittenPerSec += bytesWrittenPerSec;
+
+    _totalWriteOpsPerSec += writeOpsPerSec;
+    _totalBytesWrittenPerSec += bytesWrittenPerSec;
+}
+
+double DistributionStatus::getChunkLoad(const ChunkType& chunk) const {
+    const auto it = _chunkLoads.find(chunk.getMin());
+    if (it == _chunkLoads.end()) {
+        return 0;
+    }
+
+    double load = 0;
+    if (_totalWriteOpsPerSec > 0) {
+        load += it->second.writeOpsPerSec / _totalWriteOpsPerSec;
+    }
+    if (_totalBytesWrittenPerSec > 0) {
+        load += it->second.bytesWrittenPerSec / _totalBytesWrittenPerSec;
+    }
+
+    return load;
+}
+
+double DistributionStatus::loadOfShardWithTag(const ShardId& shardId, const string& tag) const {
+    double total = 0;
+
+    for (const auto& chunk : getChunks(shardId)) {
+        if (tag == getTagForChunk(chunk)) {
+            total += getChunkLoad(chunk);
+        }
+    }
+
+    return total;
+}
+
 void DistributionStatus::report(BSONObjBuilder* builder) const {
     builder->append("ns", _nss.ns());
 
@@ -489,6 +535,29 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
             continue;
         }
 
+        // If the write load of the zone's chunks is known, even out the load instead of the
+        // number of chunks
+        if (distribution.hasChunkLoad()) {
+            double totalLoadWithTag = 0;
+            for (const auto& stat : shardStats) {
+                totalLoadWithTag += distribution.loadOfShardWithTag(stat.shardId, tag);
+            }
+
+            if (totalLoadWithTag > 0) {
+                const double idealLoadPerShardForTag =
+                    totalLoadWithTag / totalNumberOfShardsWithTag;
+
+                while (_singleZoneLoadBalance(shardStats,
+                                              distribution,
+                                              tag,
+                                              idealLoadPerShardForTag,
+                                              &migrations,
+                                              usedShards))
+                    ;
+                continue;
+            }
+        }
+
         // Calculate the rounded optimal number of chunks per shard
         const size_t idealNumberOfChunksPerShardForTag =
             (size_t)std::roundf(totalNumberOfChunksWithTag / (float)totalNumberOfShardsWithTag);
@@ -591,6 +660,103 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
     return false;
 }
 
+bool BalancerPolicy::_singleZoneLoadBalance(const ShardStatisticsVector& shardStats,
+                                            const DistributionStatus& distribution,
+                                            const string& tag,
+                                            double idealLoadPerShardForTag,
+                                            vector<MigrateInfo>* migrations,
+                                            set<ShardId>* usedShards) {
+    ShardId from;
+    double max = 0;
+
+    ShardId to;
+    double min = numeric_limits<double>::max();
+
+    for (const auto& stat : shardStats) {
+        if (usedShards->count(stat.shardId))
+            continue;
+
+        const double shardLoad = distribution.loadOfShardWithTag(stat.shardId, tag);
+
+        if (shardLoad > max) {
+            from = stat.shardId;
+            max = shardLoad;
+        }
+
+        if (shardLoad < min && isShardSuitableReceiver(stat, tag).isOK()) {
+            to = stat.shardId;
+            min = shardLoad;
+        }
+    }
+
+    if (!from.isValid())
+        return false;
+
+    // Do not use a shard if its load is not sufficiently above the optimal per-shard load
+    if (max <= idealLoadPerShardForTag * (1 + kLoadImbalanceThreshold))
+        return false;
+
+    if (!to.isValid() || to == from) {
+        if (migrations->empty()) {
+            log() << "No available shards to take load for zone [" << tag << "]";
+        }
+        return false;
+    }
+
+    // Do not use a shard if it is already at or above the optimal per-shard load
+    if (min >= idealLoadPerShardForTag)
+        return false;
+
+    LOG(1) << "collection : " << distribution.nss().ns();
+    LOG(1) << "zone       : " << tag;
+    LOG(1) << "donor      : " << from << " load " << max;
+    LOG(1) << "receiver   : " << to << " load " << min;
+    LOG(1) << "ideal      : " << idealLoadPerShardForTag;
+
+    // Moving a chunk with load 'chunkLoad' leaves the two shards with loads 'max - chunkLoad' and
+    // 'min + chunkLoad', so the best chunk to move is the one closest to half of the difference
+    // between them. Chunks at least as loaded as the difference would only swap the roles of the
+    // two shards and are not considered.
+    const double gap = max - min;
+
+    const ChunkType* bestChunk = nullptr;
+    double bestDistance = numeric_limits<double>::max();
+    unsigned numJumboChunks = 0;
+
+    for (const auto& chunk : distribution.getChunks(from)) {
+        if (distribution.getTagForChunk(chunk) != tag)
+            continue;
+
+        const double chunkLoad = distribution.getChunkLoad(chunk);
+        if (chunkLoad <= 0 || chunkLoad >= gap)
+            continue;
+
+        if (chunk.getJumbo()) {
+            numJumboChunks++;
+            continue;
+        }
+
+        const double distance = std::abs(chunkLoad - gap / 2);
+        if (distance < bestDistance) {
+            bestChunk = &chunk;
+            bestDistance = distance;
+        }
+    }
+
+    if (!bestChunk) {
+        LOG(1) << "Shard: " << from << ", collection: " << distribution.nss().ns()
+               << " has no chunk for zone \'" << tag
+               << "\', which can be moved to even out its load. Jumbo chunks count: "
+               << numJumboChunks;
+        return false;
+    }
+
+    migrations->emplace_back(to, *bestChunk);
+    invariant(usedShards->insert(from).second);
+    invariant(usedShards->insert(to).second);
+    return true;
+}
+
 ZoneRange::ZoneRange(const BSONObj& a_min, const BSONObj& a_max, const std::string& _zone)
     : min(a_min.getOwned()), max(a_max.getOwned()), zone(_zone) {}
 
@@ -143,6 +143,31 @@ public:
      */
     std::string getTagForChunk(const ChunkType& chunk) const;
 
+    /**
+     * Records the measured write load of the chunk, which starts at the specified key. Load
+     * reported more than once for the same chunk is added up.
+     */
+    void addChunkLoad(const BSONObj& chunkMin, double writeOpsPerSec, double bytesWrittenPerSec);
+
+    /**
+     * Returns whether any write load has been recorded for the chunks of the collection.
+     */
+    bool hasChunkLoad() const {
+        return _totalWriteOpsPerSec > 0 || _totalBytesWrittenPerSec > 0;
+    }
+
+    /**
+     * Returns the load of the specified chunk, as the sum of its share of the collection's write
+     * operations and its share of the collection's bytes written, so that both are weighed
+     * equally. Chunks without recorded load have a load of zero.
+     */
+    double getChunkLoad(const ChunkType& chunk) const;
+
+    /**
+     * Returns the total load of the chunks in the specified shard, which have the given tag.
+     */
+    double loadOfShardWithTag(const ShardId& shardId, const std::string& tag) const;
+
     /**
      * Returns a BSON/string representation of this distribution status.
      */
@@ -161,6 +186,21 @@ private:
 
     // Set of all zones defined for this collection
     std::set<std::string> _allTags;
+
+    /**
+     * Measured write load of a single chunk.
+     */
+    struct ChunkLoad {
+        double writeOpsPerSec{0};
+        double bytesWrittenPerSec{0};
+    };
+
+    // Map of chunk min key to the chunk's measured load
+    BSONObjIndexedMap<ChunkLoad> _chunkLoads;
+
+    // Total measured load across all chunks of the collection
+    double _totalWriteOpsPerSec{0};
+    double _totalBytesWrittenPerSec{0};
 };
 
 class BalancerPolicy {
@@ -182,7 +222,8 @@ public:
      *
      * The balancing logic calculates the optimum number of chunks per shard for each zone and if
      * any of the shards have chunks, which are sufficiently higher than this number, suggests
-     * moving chunks to shards, which are under this number.
+     * moving chunks to shards, which are under this number. If the distribution carries measured
+     * chunk load, zones with load are instead balanced so as to even out the load of their shards.
      *
      * The usedShards parameter is in/out and it contains the set of shards, which have already been
      * used for migrations. Used so we don't return multiple conflicting migrations for the same
@@ -237,6 +278,26 @@ private:
                                    size_t idealNumberOfChunksPerShardForTag,
                                    std::vector<MigrateInfo>* migrations,
                                    std::set<ShardId>* usedShards);
+
+    /**
+     * Selects one chunk for the specified zone (if appropriate) to be moved from the most loaded
+     * shard to the least loaded one, in order to bring the load of the shards in the zone closer
+     * to even. Picks the chunk whose move best evens out the load of the two shards and never one,
+     * which would leave the receiver more loaded than the donor was. Takes into account and
+     * updates the shards, which have already been used for migrations.
+     *
+     * The 'idealLoadPerShardForTag' indicates the load which each shard should have and is used to
+     * determine the imbalance and also to prevent chunks from moving when not necessary.
+     *
+     * Returns true if a migration was suggested, false otherwise. This method is intented to be
+     * called multiple times until all posible migrations for a zone have been selected.
+     */
+    static bool _singleZoneLoadBalance(const ShardStatisticsVector& shardStats,
+                                       const DistributionStatus& distribution,
+                                       const std::string& tag,
+                                       double idealLoadPerShardForTag,
+                                       std::vector<MigrateInfo>* migrations,
+                                       std::set<ShardId>* usedShards);
 };
 
 }  // namespace mongo
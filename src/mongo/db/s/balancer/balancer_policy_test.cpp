@@ -609,6 +609,86 @@ TEST(BalancerPolicy, BalancerHandlesNoShardsWithTag) {
     ASSERT(balanceChunks(cluster.first, distribution, false).empty());
 }
 
+TEST(BalancerPolicy, LoadAwareMovesHotChunkOffOverloadedShard) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 3, false, emptyTagSet, emptyShardVersion), 3},
+         {ShardStatistics(kShardId1, kNoMaxSize, 3, false, emptyTagSet, emptyShardVersion), 3}});
+
+    // The chunk counts are balanced, but most of the writes go to the first shard
+    DistributionStatus distribution(kNamespace, cluster.second);
+    const std::vector<double> shard0WriteOps{100, 100, 10};
+    for (size_t i = 0; i < 3; i++) {
+        distribution.addChunkLoad(cluster.second[kShardId0][i].getMin(),
+                                  shard0WriteOps[i],
+                                  shard0WriteOps[i] * 1024);
+        distribution.addChunkLoad(cluster.second[kShardId1][i].getMin(), 10, 10 * 1024);
+    }
+
+    const auto migrations(balanceChunks(cluster.first, distribution, false));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMin(), migrations[0].minKey);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMax(), migrations[0].maxKey);
+}
+
+TEST(BalancerPolicy, LoadAwareDoesNotBalanceChunkCountsWhenLoadIsEven) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 4, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId1, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+
+    // The first shard has twice as many chunks, but each of them takes half as many writes
+    DistributionStatus distribution(kNamespace, cluster.second);
+    for (const auto& chunk : cluster.second[kShardId0]) {
+        distribution.addChunkLoad(chunk.getMin(), 10, 10 * 1024);
+    }
+    for (const auto& chunk : cluster.second[kShardId1]) {
+        distribution.addChunkLoad(chunk.getMin(), 20, 20 * 1024);
+    }
+
+    ASSERT(balanceChunks(cluster.first, distribution, false).empty());
+}
+
+TEST(BalancerPolicy, LoadAwareDoesNotMoveChunkHotterThanTheImbalance) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId1, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+
+    // Moving the only written chunk would just move the whole load to the other shard
+    DistributionStatus distribution(kNamespace, cluster.second);
+    distribution.addChunkLoad(cluster.second[kShardId0][0].getMin(), 100, 100 * 1024);
+
+    ASSERT(balanceChunks(cluster.first, distribution, false).empty());
+}
+
+TEST(BalancerPolicy, LoadAwareRespectsTags) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 3, false, {"a"}, emptyShardVersion), 3},
+         {ShardStatistics(kShardId1, kNoMaxSize, 3, false, {"b"}, emptyShardVersion), 3},
+         {ShardStatistics(kShardId2, kNoMaxSize, 3, false, {"a"}, emptyShardVersion), 3}});
+
+    DistributionStatus distribution(kNamespace, cluster.second);
+    ASSERT_OK(distribution.addRangeToZone(ZoneRange(kMinBSONKey, BSON("x" << 3), "a")));
+    ASSERT_OK(distribution.addRangeToZone(ZoneRange(BSON("x" << 3), BSON("x" << 6), "b")));
+    ASSERT_OK(distribution.addRangeToZone(ZoneRange(BSON("x" << 6), kMaxBSONKey, "a")));
+
+    // Zone 'a' is hot on the first shard, while the second shard, which is the least loaded one
+    // overall, is not in the zone
+    const std::vector<double> shard0WriteOps{100, 100, 10};
+    for (size_t i = 0; i < 3; i++) {
+        distribution.addChunkLoad(cluster.second[kShardId0][i].getMin(),
+                                  shard0WriteOps[i],
+                                  shard0WriteOps[i] * 1024);
+        distribution.addChunkLoad(cluster.second[kShardId2][i].getMin(), 10, 10 * 1024);
+    }
+
+    const auto migrations(balanceChunks(cluster.first, distribution, false));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId2, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMin(), migrations[0].minKey);
+}
+
 TEST(DistributionStatus, AddTagRangeOverlap) {
     DistributionStatus d(kNamespace, ShardToChunksMap{});
 
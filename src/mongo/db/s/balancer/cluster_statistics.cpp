@@ -40,6 +40,15 @@ ClusterStatistics::ClusterStatistics() = default;
 
 ClusterStatistics::~ClusterStatistics() = default;
 
+ClusterStatistics::ChunkLoadStatistics::ChunkLoadStatistics(NamespaceString inNss,
+                                                            BSONObj inMin,
+                                                            double inWriteOpsPerSec,
+                                                            double inBytesWrittenPerSec)
+    : nss(std::move(inNss)),
+      min(inMin.getOwned()),
+      writeOpsPerSec(inWriteOpsPerSec),
+      bytesWrittenPerSec(inBytesWrittenPerSec) {}
+
 ClusterStatistics::ShardStatistics::ShardStatistics(ShardId inShardId,
                                                     uint64_t inMaxSizeMB,
                                                     uint64_t inCurrSizeMB,
@@ -73,6 +82,9 @@ BSONObj ClusterStatistics::ShardStatistics::toBSON() const {
     }
 
     builder.append("version", mongoVersion);
+    if (!chunkLoad.empty()) {
+        builder.append("numChunksWithLoad", static_cast<long long>(chunkLoad.size()));
+    }
     return builder.obj();
 }
 
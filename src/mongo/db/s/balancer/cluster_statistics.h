@@ -34,11 +34,12 @@
 #include <string>
 #include <vector>
 
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/s/client/shard.h"
 
 namespace mongo {
 
-class BSONObj;
 class OperationContext;
 template <typename T>
 class StatusWith;
@@ -53,6 +54,26 @@ class ClusterStatistics {
     ClusterStatistics& operator=(const ClusterStatistics&) = delete;
 
 public:
+    /**
+     * Structure, which describes the measured write load of a single chunk.
+     */
+    struct ChunkLoadStatistics {
+        ChunkLoadStatistics(NamespaceString nss,
+                            BSONObj min,
+                            double writeOpsPerSec,
+                            double bytesWrittenPerSec);
+
+        // The collection and the lower bound of the chunk for which this statistic applies
+        NamespaceString nss;
+        BSONObj min;
+
+        // Rate of writes to the chunk, in operations per second
+        double writeOpsPerSec{0};
+
+        // Rate of data written to the chunk, in bytes per second
+        double bytesWrittenPerSec{0};
+    };
+
     /**
      * Structure, which describes the statistics of a single shard host.
      */
@@ -93,6 +114,10 @@ public:
 
         // Version of mongod, which runs on this shard's primary
         std::string mongoVersion;
+
+        // Measured load of the chunks on this shard, which have been written to recently. Only
+        // populated when load-aware balancing is enabled.
+        std::vector<ChunkLoadStatistics> chunkLoad;
     };
 
     virtual ~ClusterStatistics();
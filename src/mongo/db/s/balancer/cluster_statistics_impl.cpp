@@ -38,10 +38,13 @@
 #include "mongo/base/status_with.h"
 #include "mongo/bson/util/bson_extract.h"
 #include "mongo/client/read_preference.h"
+#include "mongo/db/s/balancer/balancer_server_parameters_gen.h"
+#include "mongo/db/service_context.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/shard_util.h"
+#include "mongo/util/clock_source.h"
 #include "mongo/util/log.h"
 #include "mongo/util/str.h"
 
@@ -49,16 +52,19 @@ namespace mongo {
 namespace {
 
 const char kVersionField[] = "version";
+const char kChunkLoadField[] = "chunkLoad";
 
 /**
- * Executes the serverStatus command against the specified shard and obtains the version of the
- * running MongoD service.
+ * Executes the serverStatus command against the specified shard and returns its response. The
+ * 'chunkLoad' section, which is not included by default, is requested if 'includeChunkLoad' is
+ * true.
  *
- * Returns the MongoD version in strig format or an error. Known error codes are:
+ * Known error codes are:
  *  ShardNotFound if shard by that id is not available on the registry
- *  NoSuchKey if the version could not be retrieved
  */
-StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, ShardId shardId) {
+StatusWith<BSONObj> retrieveShardServerStatus(OperationContext* opCtx,
+                                              ShardId shardId,
+                                              bool includeChunkLoad) {
     auto shardRegistry = Grid::get(opCtx)->shardRegistry();
     auto shardStatus = shardRegistry->getShard(opCtx, shardId);
     if (!shardStatus.isOK()) {
@@ -66,11 +72,17 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
     }
     auto shard = shardStatus.getValue();
 
+    BSONObjBuilder cmdBuilder;
+    cmdBuilder.append("serverStatus", 1);
+    if (includeChunkLoad) {
+        cmdBuilder.append(kChunkLoadField, 1);
+    }
+
     auto commandResponse =
         shard->runCommandWithFixedRetryAttempts(opCtx,
                                                 ReadPreferenceSetting{ReadPreference::PrimaryOnly},
                                                 "admin",
-                                                BSON("serverStatus" << 1),
+                                                cmdBuilder.obj(),
                                                 Shard::RetryPolicy::kIdempotent);
     if (!commandResponse.isOK()) {
         return commandResponse.getStatus();
@@ -79,8 +91,16 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
         return commandResponse.getValue().commandStatus;
     }
 
-    BSONObj serverStatus = std::move(commandResponse.getValue().response);
+    return std::move(commandResponse.getValue().response);
+}
 
+/**
+ * Obtains the version of the running MongoD service from its serverStatus response.
+ *
+ * Returns the MongoD version in strig format or an error. Known error codes are:
+ *  NoSuchKey if the version could not be retrieved
+ */
+StatusWith<std::string> extractShardMongoDVersion(const BSONObj& serverStatus) {
     std::string version;
     Status status = bsonExtractStringField(serverStatus, kVersionField, &version);
     if (!status.isOK()) {
@@ -90,6 +110,13 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
     return version;
 }
 
+/**
+ * Returns the rate at which 'current' has grown since 'previous' over 'elapsed'.
+ */
+double ratePerSecond(long long previous, long long current, Milliseconds elapsed) {
+    return static_cast<double>(current - previous) * 1000 / durationCount<Milliseconds>(elapsed);
+}
+
 }  // namespace
 
 using ShardStatistics = ClusterStatistics::ShardStatistics;
@@ -116,6 +143,9 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
 
     std::vector<ShardStatistics> stats;
 
+    const bool loadAwarePolicy = gBalancerLoadAwarePolicy.load();
+    const auto now = opCtx->getServiceContext()->getPreciseClockSource()->now();
+
     for (const auto& shard : shards) {
         const auto shardSizeStatus = [&]() -> StatusWith<long long> {
             if (!shard.getMaxSizeMB()) {
@@ -134,13 +164,31 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
         }
 
         std::string mongoDVersion;
+        std::vector<ChunkLoadStatistics> chunkLoad;
 
-        auto mongoDVersionStatus = retrieveShardMongoDVersion(opCtx, shard.getName());
+        auto mongoDVersionStatus = [&]() -> StatusWith<std::string> {
+            auto serverStatus = retrieveShardServerStatus(opCtx, shard.getName(), loadAwarePolicy);
+            if (!serverStatus.isOK()) {
+                return serverStatus.getStatus();
+            }
+
+            if (loadAwarePolicy) {
+                // Shards, which do not own any chunks that were written to, omit the section
+                const auto chunkLoadElem = serverStatus.getValue()[kChunkLoadField];
+                chunkLoad = _computeChunkLoad(
+                    shard.getName(),
+                    chunkLoadElem.type() == Object ? chunkLoadElem.Obj() : BSONObj(),
+                    now);
+            }
+
+            return extractShardMongoDVersion(serverStatus.getValue());
+        }();
         if (mongoDVersionStatus.isOK()) {
             mongoDVersion = std::move(mongoDVersionStatus.getValue());
         } else {
-            // Since the mongod version is only used for reporting, there is no need to fail the
-            // entire round if it cannot be retrieved, so just leave it empty
+            // Since the mongod version and the chunk load are only used for reporting and for
+            // guiding the balancer, there is no need to fail the entire round if they cannot be
+            // retrieved, so just leave them empty
             log() << "Unable to obtain shard version for " << shard.getName()
                   << causedBy(mongoDVersionStatus.getStatus());
         }
@@ -157,9 +205,94 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
                            shard.getDraining(),
                            std::move(shardTags),
                            std::move(mongoDVersion));
+        stats.back().chunkLoad = std::move(chunkLoad);
+    }
+
+    {
+        // Drop the samples of shards, which are no longer part of the cluster, or all of them if
+        // load-aware balancing has been disabled
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (auto it = _chunkLoadSamples.begin(); it != _chunkLoadSamples.end();) {
+            const bool isShardPresent =
+                std::any_of(shards.begin(), shards.end(), [&](const ShardType& shard) {
+                    return shard.getName() == it->first.toString();
+                });
+            if (loadAwarePolicy && isShardPresent) {
+                ++it;
+            } else {
+                _chunkLoadSamples.erase(it++);
+            }
+        }
     }
 
     return stats;
 }
 
+std::vector<ClusterStatistics::ChunkLoadStatistics> ClusterStatisticsImpl::_computeChunkLoad(
+    const ShardId& shardId, const BSONObj& chunkLoadSection, Date_t now) {
+    const Milliseconds minSampleInterval = Seconds(gBalancerChunkLoadSampleIntervalSecs.load());
+
+    std::vector<ChunkLoadStatistics> chunkLoad;
+
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    auto& previousSamples = _chunkLoadSamples[shardId];
+    stdx::unordered_map<std::string, ChunkLoadSample> samples;
+
+    for (const auto& nsElem : chunkLoadSection) {
+        if (nsElem.type() != Array) {
+            continue;
+        }
+
+        const NamespaceString nss(nsElem.fieldNameStringData());
+
+        for (const auto& chunkElem : nsElem.Obj()) {
+            if (chunkElem.type() != Object || chunkElem.Obj()["min"].type() != Object) {
+                continue;
+            }
+
+            const BSONObj chunkObj = chunkElem.Obj();
+            const BSONObj min = chunkObj["min"].Obj();
+            const long long writeOps = chunkObj["writeOps"].safeNumberLong();
+            const long long bytesWritten = chunkObj["bytesWritten"].safeNumberLong();
+
+            // The chunk bounds are compared in their binary form, since they are reported by the
+            // same shard key pattern in every round.
+            std::string key = nss.ns();
+            key.push_back('\0');
+            key.append(min.objdata(), min.objsize());
+
+            ChunkLoadSample sample{now, writeOps, bytesWritten};
+
+            auto it = previousSamples.find(key);
+            if (it != previousSamples.end() && it->second.writeOps <= writeOps &&
+                it->second.bytesWritten <= bytesWritten) {
+                const auto& previous = it->second;
+                const auto elapsed = now - previous.sampledAt;
+                if (elapsed < minSampleInterval) {
+                    // Too little time has passed for a meaningful rate, so keep reporting the
+                    // rate computed over the previous interval.
+                    sample = previous;
+                } else {
+                    sample.writeOpsPerSec = ratePerSecond(previous.writeOps, writeOps, elapsed);
+                    sample.bytesWrittenPerSec =
+                        ratePerSecond(previous.bytesWritten, bytesWritten, elapsed);
+                }
+            }
+
+            // A chunk which is seen for the first time, or whose totals were reset because it was
+            // split or moved, has no measured rate until its next sample.
+            if (sample.writeOpsPerSec > 0 || sample.bytesWrittenPerSec > 0) {
+                chunkLoad.emplace_back(nss, min, sample.writeOpsPerSec, sample.bytesWrittenPerSec);
+            }
+
+            samples.emplace(std::move(key), sample);
+        }
+    }
+
+    previousSamples = std::move(samples);
+
+    return chunkLoad;
+}
+
 }  // namespace mongo
@@ -31,6 +31,9 @@
 
 #include "mongo/db/s/balancer/balancer_random.h"
 #include "mongo/db/s/balancer/cluster_statistics.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -38,6 +41,10 @@ namespace mongo {
  * Default implementation for the cluster statistics gathering utility. Uses a blocking method to
  * fetch the statistics and does not perform any caching. If any of the shards fails to report
  * statistics fails the entire refresh.
+ *
+ * When load-aware balancing is enabled, shards report the total number of writes to each of their
+ * chunks and the write rates are derived from the difference between consecutive reports, which
+ * is the only state retained between calls.
  */
 class ClusterStatisticsImpl final : public ClusterStatistics {
 public:
@@ -47,8 +54,37 @@ public:
     StatusWith<std::vector<ShardStatistics>> getStats(OperationContext* opCtx) override;
 
 private:
+    /**
+     * Write totals last reported for a chunk along with the rates derived from them.
+     */
+    struct ChunkLoadSample {
+        Date_t sampledAt;
+        long long writeOps{0};
+        long long bytesWritten{0};
+        double writeOpsPerSec{0};
+        double bytesWrittenPerSec{0};
+    };
+
+    /**
+     * Converts the write totals reported by the 'chunkLoad' serverStatus section of the given
+     * shard into per-chunk rates, using and updating the samples retained from earlier reports.
+     */
+    std::vector<ChunkLoadStatistics> _computeChunkLoad(const ShardId& shardId,
+                                                       const BSONObj& chunkLoadSection,
+                                                       Date_t now);
+
     // Source of randomness when metadata needs to be randomized.
     BalancerRandomSource& _random;
+
+    // Protects the chunk load samples below, since statistics may be requested concurrently by
+    // the balancer and by commands, which validate chunk moves
+    Mutex _mutex = MONGO_MAKE_LATCH("ClusterStatisticsImpl::_mutex");
+
+    // Last load sample for each chunk that has been reported as written to, keyed by shard and
+    // then by the chunk's namespace and lower bound. Chunks, which are no longer reported by their
+    // shard are dropped.
+    stdx::unordered_map<ShardId, stdx::unordered_map<std::string, ChunkLoadSample>, ShardId::Hasher>
+        _chunkLoadSamples;
 };
 
 }  // namespace mongo
@@ -40,7 +40,9 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/s/chunk_split_state_driver.h"
 #include "mongo/db/s/shard_filtering_metadata_refresh.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_state.h"
+#include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/split_chunk.h"
 #include "mongo/db/s/split_vector.h"
 #include "mongo/db/service_context.h"
@@ -317,18 +319,59 @@ void ChunkSplitter::_runAutosplit(std::shared_ptr<ChunkSplitStateDriver> chunkSp
                << " maxChunkSizeBytes: " << maxChunkSizeBytes;
 
         chunkSplitStateDriver->prepareSplit();
-        auto splitPoints = uassertStatusOK(splitVector(opCtx.get(),
-                                                       nss,
-                                                       shardKeyPattern.toBSON(),
-                                                       chunk.getMin(),
-                                                       chunk.getMax(),
-                                                       false,
-                                                       boost::none,
-                                                       boost::none,
-                                                       boost::none,
-                                                       maxChunkSizeBytes));
-
-        if (splitPoints.size() <= 1) {
+
+        // Like splitVector, aim for pieces of half the maximum chunk size, so that the chunks
+        // resulting from the split have room to grow.
+        auto& shardingStatistics = ShardingStatistics::get(opCtx.get());
+        auto splitPoints = autoSplitUseShardKeySketch.load()
+            ? chunk.getWritesTracker()->getShardKeySketch().getSplitPoints(chunk.getMin(),
+                                                                           maxChunkSizeBytes / 2)
+            : std::vector<BSONObj>();
+        bool splitPointsFromSketch = !splitPoints.empty();
+        if (splitPointsFromSketch) {
+            // The sketch only observes inserts and never forgets the bytes of documents which were
+            // deleted or moved since, so it can overestimate the chunk. Confirm that the chunk has
+            // reached the maximum size, which splitVector does by scanning the shard key index
+            // only until it has found two split points, before using the sketch's points.
+            shardingStatistics.countAutoSplitVectorScans.addAndFetch(1);
+            auto confirmingSplitPoints = uassertStatusOK(splitVector(opCtx.get(),
+                                                                     nss,
+                                                                     shardKeyPattern.toBSON(),
+                                                                     chunk.getMin(),
+                                                                     chunk.getMax(),
+                                                                     false,
+                                                                     2LL,
+                                                                     boost::none,
+                                                                     boost::none,
+                                                                     maxChunkSizeBytes));
+            if (confirmingSplitPoints.size() < 2) {
+                LOG(1) << "shard key sketch of chunk " << redact(chunk.toString())
+                       << " overestimates its size, not splitting it";
+                splitPoints = std::move(confirmingSplitPoints);
+                splitPointsFromSketch = false;
+            } else {
+                LOG(1) << "picked " << splitPoints.size() << " split points for chunk "
+                       << redact(chunk.toString()) << " from its shard key sketch";
+                shardingStatistics.countAutoSplitsFromShardKeySketch.addAndFetch(1);
+            }
+        } else {
+            shardingStatistics.countAutoSplitVectorScans.addAndFetch(1);
+            splitPoints = uassertStatusOK(splitVector(opCtx.get(),
+                                                      nss,
+                                                      shardKeyPattern.toBSON(),
+                                                      chunk.getMin(),
+                                                      chunk.getMax(),
+                                                      false,
+                                                      boost::none,
+                                                      boost::none,
+                                                      boost::none,
+                                                      maxChunkSizeBytes));
+        }
+
+        // The sketch only returns split points once it has observed at least a full chunk's
+        // worth of data, which was confirmed above, so a single split point from it still
+        // warrants a split.
+        if (splitPoints.empty() || (splitPoints.size() == 1 && !splitPointsFromSketch)) {
             LOG(1)
                 << "ChunkSplitter attempted split but not enough split points were found for chunk "
                 << redact(chunk.toString());
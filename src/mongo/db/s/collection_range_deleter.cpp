@@ -41,7 +41,6 @@
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/dbhelpers.h"
-#include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/keypattern.h"
@@ -50,7 +49,9 @@
 #include "mongo/db/query/plan_yield_policy.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_runtime.h"
 #include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_state.h"
@@ -75,6 +76,7 @@ const WriteConcernOptions kMajorityWriteConcern(WriteConcernOptions::kMajority,
                                                 WriteConcernOptions::kWriteConcernTimeoutSharding);
 
 MONGO_FAIL_POINT_DEFINE(hangBeforeDoingDeletion);
+MONGO_FAIL_POINT_DEFINE(throwWriteConflictBeforeCommittingRangeDeletions);
 
 boost::optional<DeleteNotification> checkOverlap(std::list<Deletion> const& deletions,
                                                  ChunkRange const& range) {
@@ -375,58 +377,112 @@ StatusWith<int> CollectionRangeDeleter::_doDeletion(OperationContext* opCtx,
         return {ErrorCodes::InternalError, msg};
     }
 
-    auto deleteStageParams = std::make_unique<DeleteStageParams>();
-    deleteStageParams->fromMigrate = true;
-    deleteStageParams->isMulti = true;
-    deleteStageParams->returnDeleted = true;
-
+    std::unique_ptr<RemoveSaver> removeSaver;
     if (serverGlobalParams.moveParanoia) {
-        deleteStageParams->removeSaver =
-            std::make_unique<RemoveSaver>("moveChunk", nss.ns(), "cleaning");
+        removeSaver = std::make_unique<RemoveSaver>("moveChunk", nss.ns(), "cleaning");
     }
 
-    auto exec = InternalPlanner::deleteWithIndexScan(opCtx,
-                                                     collection,
-                                                     std::move(deleteStageParams),
-                                                     descriptor,
-                                                     min,
-                                                     max,
-                                                     BoundInclusion::kIncludeStartKeyOnly,
-                                                     PlanExecutor::YIELD_MANUAL,
-                                                     InternalPlanner::FORWARD);
+    auto exec = InternalPlanner::indexScan(opCtx,
+                                           collection,
+                                           descriptor,
+                                           min,
+                                           max,
+                                           BoundInclusion::kIncludeStartKeyOnly,
+                                           PlanExecutor::YIELD_MANUAL,
+                                           InternalPlanner::FORWARD,
+                                           InternalPlanner::IXSCAN_FETCH);
 
     if (MONGO_unlikely(hangBeforeDoingDeletion.shouldFail())) {
         LOG(0) << "Hit hangBeforeDoingDeletion failpoint";
         hangBeforeDoingDeletion.pauseWhileSet(opCtx);
     }
 
-    PlanYieldPolicy planYieldPolicy(exec.get(), PlanExecutor::YIELD_MANUAL);
+    // Deletes are committed in groups, each bounded by a number of documents and by their total
+    // size. As for batched inserts, the oplog slots of a group are reserved up front, and each
+    // delete is timestamped with the slot of its own oplog entry. Engines without document-level
+    // locking must write the oplog in timestamp order, so they assign the optimes as they log.
+    const int maxDeletesPerWriteUnitOfWork = rangeDeleterDeletesPerWriteUnitOfWork.load();
+    const int maxBytesPerWriteUnitOfWork = rangeDeleterBytesPerWriteUnitOfWork.load();
+    const bool reserveOplogSlots = supportsDocLocking() &&
+        !repl::ReplicationCoordinator::get(opCtx)->isOplogDisabledFor(opCtx, nss);
 
     int numDeleted = 0;
-    do {
-        BSONObj deletedObj;
+    bool rangeExhausted = false;
+    std::vector<RecordId> recordIds;
+    while (numDeleted < maxToDelete && !rangeExhausted) {
+        recordIds.clear();
+        int groupBytes = 0;
+        while (numDeleted + static_cast<int>(recordIds.size()) < maxToDelete &&
+               static_cast<int>(recordIds.size()) < maxDeletesPerWriteUnitOfWork &&
+               groupBytes < maxBytesPerWriteUnitOfWork) {
+            BSONObj obj;
+            RecordId recordId;
+
+            // TODO SERVER-41606: Remove this function when we refactor CollectionRangeDeleter.
+            if (_throwWriteConflictForTest)
+                throw WriteConflictException();
+
+            PlanExecutor::ExecState state = exec->getNext(&obj, &recordId);
+
+            if (state == PlanExecutor::IS_EOF) {
+                rangeExhausted = true;
+                break;
+            }
+
+            if (state == PlanExecutor::FAILURE) {
+                warning() << PlanExecutor::statestr(state)
+                          << " - cursor error while trying to delete " << redact(min) << " to "
+                          << redact(max) << " in " << nss << ": FAILURE, stats: "
+                          << Explain::getWinningPlanStats(exec.get());
+                rangeExhausted = true;
+                break;
+            }
 
-        // TODO SERVER-41606: Remove this function when we refactor CollectionRangeDeleter.
-        if (_throwWriteConflictForTest)
-            throw WriteConflictException();
+            invariant(PlanExecutor::ADVANCED == state);
 
-        PlanExecutor::ExecState state = exec->getNext(&deletedObj, nullptr);
+            if (removeSaver) {
+                uassertStatusOK(removeSaver->goingToDelete(obj));
+            }
 
-        if (state == PlanExecutor::IS_EOF) {
-            break;
+            recordIds.push_back(recordId);
+            groupBytes += obj.objsize();
         }
 
-        if (state == PlanExecutor::FAILURE) {
-            warning() << PlanExecutor::statestr(state) << " - cursor error while trying to delete "
-                      << redact(min) << " to " << redact(max) << " in " << nss
-                      << ": FAILURE, stats: " << Explain::getWinningPlanStats(exec.get());
+        if (recordIds.empty()) {
             break;
         }
 
-        invariant(PlanExecutor::ADVANCED == state);
-        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(1);
+        // Deleting the documents invalidates the cursor positions of the plan, so they have to be
+        // saved and restored around it. The documents are deleted in the snapshot they were found
+        // in, so a concurrent write to any of them throws a WriteConflictException, which rolls
+        // back the whole group.
+        exec->saveState();
+        {
+            WriteUnitOfWork wuow(opCtx);
+            std::vector<repl::OplogSlot> oplogSlots(recordIds.size());
+            if (reserveOplogSlots) {
+                oplogSlots = repl::getNextOpTimes(opCtx, recordIds.size());
+            }
+            for (size_t i = 0; i < recordIds.size(); ++i) {
+                collection->deleteDocument(opCtx,
+                                           kUninitializedStmtId,
+                                           recordIds[i],
+                                           nullptr,
+                                           true /* fromMigrate */,
+                                           false /* noWarn */,
+                                           Collection::StoreDeletedDoc::Off,
+                                           oplogSlots[i]);
+            }
+            if (MONGO_unlikely(throwWriteConflictBeforeCommittingRangeDeletions.shouldFail())) {
+                throw WriteConflictException();
+            }
+            wuow.commit();
+        }
+        exec->restoreState();
 
-    } while (++numDeleted < maxToDelete);
+        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(recordIds.size());
+        numDeleted += recordIds.size();
+    }
 
     return numDeleted;
 }
@@ -201,8 +201,9 @@ private:
         std::shared_ptr<MetadataManager> metadataManager);
 
     /**
-     * Performs the deletion of up to maxToDelete entries within the range in progress. Must be
-     * called under the collection lock.
+     * Performs the deletion of up to maxToDelete entries within the range in progress, in write
+     * units of work bounded by rangeDeleterDeletesPerWriteUnitOfWork documents and
+     * rangeDeleterBytesPerWriteUnitOfWork bytes. Must be called under the collection lock.
      *
      * Returns the number of documents deleted, 0 if done with the range, or bad status if deleting
      * the range failed.
@@ -40,12 +40,15 @@
 #include "mongo/db/keypattern.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/s/collection_sharding_runtime.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/s/balancer_configuration.h"
 #include "mongo/s/chunk_version.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/shard_server_test_fixture.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -414,5 +417,75 @@ TEST_F(CollectionRangeDeleterTest, RetryOnWriteConflictException) {
     ASSERT_EQUALS(2ULL, dbclient.count(kNss, BSON(kShardKey << LT << 5)));
 }
 
+// Tests that the deletes of a batch are committed in groups of at most
+// rangeDeleterDeletesPerWriteUnitOfWork documents, each of which commits or rolls back as a whole.
+TEST_F(CollectionRangeDeleterTest, DeletesAreCommittedInGroupsBoundedByCount) {
+    CollectionRangeDeleter rangeDeleter;
+    DBDirectClient dbclient(operationContext());
+    for (int i = 1; i <= 5; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+    ASSERT_EQUALS(5ULL, dbclient.count(kNss, BSON(kShardKey << LT << 10)));
+
+    std::list<Deletion> ranges;
+    ranges.emplace_back(
+        Deletion{ChunkRange(BSON(kShardKey << 0), BSON(kShardKey << 10)), Date_t{}});
+    auto when = rangeDeleter.add(std::move(ranges));
+    ASSERT(when && *when == Date_t{});
+
+    const int originalDeletesPerWriteUnitOfWork = rangeDeleterDeletesPerWriteUnitOfWork.load();
+    ON_BLOCK_EXIT([&] {
+        rangeDeleterDeletesPerWriteUnitOfWork.store(originalDeletesPerWriteUnitOfWork);
+    });
+    rangeDeleterDeletesPerWriteUnitOfWork.store(2);
+
+    // The first group commits, and the second one rolls back all of its deletes.
+    auto failPoint =
+        globalFailPointRegistry().find("throwWriteConflictBeforeCommittingRangeDeletions");
+    failPoint->setMode(FailPoint::skip, 1);
+    ASSERT_TRUE(next(rangeDeleter, 100));
+    failPoint->setMode(FailPoint::off);
+    ASSERT_EQUALS(3ULL, dbclient.count(kNss, BSON(kShardKey << LT << 10)));
+
+    ASSERT_TRUE(next(rangeDeleter, 100));
+    ASSERT_EQUALS(0ULL, dbclient.count(kNss, BSON(kShardKey << LT << 10)));
+    ASSERT_FALSE(next(rangeDeleter, 100));
+}
+
+// Tests that a group of deletes is also closed once its documents reach
+// rangeDeleterBytesPerWriteUnitOfWork bytes.
+TEST_F(CollectionRangeDeleterTest, DeletesAreCommittedInGroupsBoundedBySize) {
+    CollectionRangeDeleter rangeDeleter;
+    DBDirectClient dbclient(operationContext());
+    const std::string padding(100, 'x');
+    for (int i = 1; i <= 5; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i << "padding" << padding));
+    }
+    ASSERT_EQUALS(5ULL, dbclient.count(kNss, BSON(kShardKey << LT << 10)));
+
+    std::list<Deletion> ranges;
+    ranges.emplace_back(
+        Deletion{ChunkRange(BSON(kShardKey << 0), BSON(kShardKey << 10)), Date_t{}});
+    auto when = rangeDeleter.add(std::move(ranges));
+    ASSERT(when && *when == Date_t{});
+
+    const int originalBytesPerWriteUnitOfWork = rangeDeleterBytesPerWriteUnitOfWork.load();
+    ON_BLOCK_EXIT(
+        [&] { rangeDeleterBytesPerWriteUnitOfWork.store(originalBytesPerWriteUnitOfWork); });
+    rangeDeleterBytesPerWriteUnitOfWork.store(1);
+
+    // Every document exceeds the size bound on its own, so each group holds one document.
+    auto failPoint =
+        globalFailPointRegistry().find("throwWriteConflictBeforeCommittingRangeDeletions");
+    failPoint->setMode(FailPoint::skip, 1);
+    ASSERT_TRUE(next(rangeDeleter, 100));
+    failPoint->setMode(FailPoint::off);
+    ASSERT_EQUALS(4ULL, dbclient.count(kNss, BSON(kShardKey << LT << 10)));
+
+    ASSERT_TRUE(next(rangeDeleter, 100));
+    ASSERT_EQUALS(0ULL, dbclient.count(kNss, BSON(kShardKey << LT << 10)));
+    ASSERT_FALSE(next(rangeDeleter, 100));
+}
+
 }  // namespace
 }  // namespace mongo
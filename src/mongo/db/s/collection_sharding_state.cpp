@@ -88,6 +88,42 @@ public:
         versionB.done();
     }
 
+    void reportChunkLoad(OperationContext* opCtx, BSONObjBuilder* builder) {
+        stdx::lock_guard<Latch> lg(_mutex);
+
+        for (auto& coll : _collections) {
+            const auto optMetadata = coll.second->getCurrentMetadataIfKnown();
+            if (!optMetadata || !(*optMetadata)->isSharded()) {
+                continue;
+            }
+
+            const auto& metadata = *optMetadata;
+            boost::optional<BSONArrayBuilder> chunksB;
+            for (const auto& chunk : metadata->getChunkManager()->chunks()) {
+                if (chunk.getShardId() != metadata->shardId()) {
+                    continue;
+                }
+
+                const auto writesTracker = chunk.getWritesTracker();
+                const auto totalWriteOps = writesTracker->getTotalWriteOps();
+                if (!totalWriteOps) {
+                    continue;
+                }
+
+                if (!chunksB) {
+                    chunksB.emplace(builder->subarrayStart(coll.first));
+                }
+
+                BSONObjBuilder chunkB(chunksB->subobjStart());
+                chunkB.append("min", chunk.getMin());
+                chunkB.append("max", chunk.getMax());
+                chunkB.append("writeOps", static_cast<long long>(totalWriteOps));
+                chunkB.append("bytesWritten",
+                              static_cast<long long>(writesTracker->getTotalBytesWritten()));
+            }
+        }
+    }
+
 private:
     using CollectionsMap = StringMap<std::shared_ptr<CollectionShardingState>>;
 
@@ -163,6 +199,11 @@ void CollectionShardingState::report(OperationContext* opCtx, BSONObjBuilder* bu
     collectionsMap->report(opCtx, builder);
 }
 
+void CollectionShardingState::reportChunkLoad(OperationContext* opCtx, BSONObjBuilder* builder) {
+    auto& collectionsMap = CollectionShardingStateMap::get(opCtx->getServiceContext());
+    collectionsMap->reportChunkLoad(opCtx, builder);
+}
+
 ScopedCollectionMetadata CollectionShardingState::getOrphansFilter(OperationContext* opCtx,
                                                                    bool isCollection) {
     const auto atClusterTime = repl::ReadConcernArgs::get(opCtx).getArgsAtClusterTime();
@@ -80,6 +80,13 @@ public:
      */
     static void report(OperationContext* opCtx, BSONObjBuilder* builder);
 
+    /**
+     * Reports, for every sharded collection with known filtering information, the total number of
+     * writes and bytes written to each of the chunks owned by this shard which have been written
+     * to. Used by the balancer to derive the write load of each chunk.
+     */
+    static void reportChunkLoad(OperationContext* opCtx, BSONObjBuilder* builder);
+
     /**
      * Returns the orphan chunk filtering metadata that the current operation should be using for
      * the collection.
@@ -621,17 +621,18 @@ Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
                            internalQueryExecYieldIterations.load(),
                            Milliseconds(internalQueryExecYieldPeriodMS.load()));
 
+    // Every document is removed from '_cloneLocs' before the mutex is released to fetch it, so that
+    // concurrent requests from the recipient never return the same document.
     stdx::unique_lock<Latch> lk(_mutex);
-    auto iter = _cloneLocs.begin();
-
-    for (; iter != _cloneLocs.end(); ++iter) {
+    while (!_cloneLocs.empty()) {
         // We must always make progress in this method by at least one document because empty return
         // indicates there is no more initial clone data.
         if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
             break;
         }
 
-        auto nextRecordId = *iter;
+        auto nextRecordId = *_cloneLocs.begin();
+        _cloneLocs.erase(_cloneLocs.begin());
 
         lk.unlock();
 
@@ -641,6 +642,9 @@ Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
             // that we take into consideration the overhead of BSONArray indices.
             if (arrBuilder->arrSize() &&
                 (arrBuilder->len() + doc.value().objsize() + 1024) > BSONObjMaxUserSize) {
+                // Leave the document for the next batch.
+                lk.lock();
+                _cloneLocs.insert(nextRecordId);
                 break;
             }
 
@@ -651,8 +655,6 @@ Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
         lk.lock();
     }
 
-    _cloneLocs.erase(_cloneLocs.begin(), iter);
-
     return Status::OK();
 }
 
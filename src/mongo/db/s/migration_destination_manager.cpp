@@ -381,57 +381,108 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
     OperationContext* opCtx,
     std::function<void(OperationContext*, BSONObj)> insertBatchFn,
     std::function<BSONObj(OperationContext*)> fetchBatchFn) {
+    const int concurrency = migrateCloneConcurrency.load();
 
-    SingleProducerSingleConsumerQueue<BSONObj>::Options options;
-    options.maxQueueDepth = 1;
+    MultiProducerMultiConsumerQueue<BSONObj>::Options options;
+    options.maxQueueDepth = concurrency;
 
-    SingleProducerSingleConsumerQueue<BSONObj> batches(options);
-    repl::OpTime lastOpApplied;
-
-    stdx::thread inserterThread{[&] {
-        Client::initKillableThread("chunkInserter", opCtx->getServiceContext());
+    MultiProducerMultiConsumerQueue<BSONObj> batches(options);
 
-        auto inserterOpCtx = Client::getCurrent()->makeOperationContext();
-        auto consumerGuard = makeGuard([&] {
-            batches.closeConsumerEnd();
-            lastOpApplied = repl::ReplClientInfo::forClient(inserterOpCtx->getClient()).getLastOp();
+    auto mutex = MONGO_MAKE_LATCH("MigrationDestinationManager::cloneDocumentsFromDonor");
+    repl::OpTime lastOpApplied;
+    int numActiveFetchers = concurrency;
+
+    // Errors on the helper threads interrupt 'opCtx', so that the clone fails on the calling
+    // thread.
+    auto interruptClone = [&](StringData what) {
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(51008));
+        log() << what << " failed " << causedBy(redact(exceptionToStatus()));
+    };
+
+    // Each fetcher requests batches until the donor has no documents left for it. The donor hands
+    // out every document to only one of the concurrent requests.
+    auto fetchBatches = [&](OperationContext* fetcherOpCtx) {
+        ON_BLOCK_EXIT([&] {
+            stdx::lock_guard<Latch> lk(mutex);
+            if (--numActiveFetchers == 0) {
+                batches.closeProducerEnd();
+            }
         });
 
-        try {
-            while (true) {
-                auto nextBatch = batches.pop(inserterOpCtx.get());
-                auto arr = nextBatch["objects"].Obj();
-                if (arr.isEmpty()) {
-                    return;
-                }
-                insertBatchFn(inserterOpCtx.get(), arr);
+        while (true) {
+            fetcherOpCtx->checkForInterrupt();
+
+            auto res = fetchBatchFn(fetcherOpCtx);
+            if (res["objects"].Obj().isEmpty()) {
+                return;
             }
-        } catch (...) {
-            stdx::lock_guard<Client> lk(*opCtx->getClient());
-            opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(51008));
-            log() << "Batch insertion failed " << causedBy(redact(exceptionToStatus()));
+
+            fetcherOpCtx->checkForInterrupt();
+            batches.push(res.getOwned(), fetcherOpCtx);
+        }
+    };
+
+    std::vector<stdx::thread> workers;
+    auto joinWorkersGuard = makeGuard([&] {
+        batches.closeConsumerEnd();
+        for (auto& worker : workers) {
+            worker.join();
         }
-    }};
-    auto inserterThreadJoinGuard = makeGuard([&] {
-        batches.closeProducerEnd();
-        inserterThread.join();
     });
 
-    while (true) {
-        opCtx->checkForInterrupt();
+    for (int i = 0; i < concurrency; ++i) {
+        workers.emplace_back([&] {
+            Client::initKillableThread("chunkInserter", opCtx->getServiceContext());
 
-        auto res = fetchBatchFn(opCtx);
+            auto inserterOpCtx = Client::getCurrent()->makeOperationContext();
+            auto consumerGuard = makeGuard([&] {
+                batches.closeConsumerEnd();
 
-        opCtx->checkForInterrupt();
-        batches.push(res.getOwned(), opCtx);
-        auto arr = res["objects"].Obj();
-        if (arr.isEmpty()) {
-            inserterThreadJoinGuard.dismiss();
-            inserterThread.join();
-            opCtx->checkForInterrupt();
-            break;
-        }
+                stdx::lock_guard<Latch> lk(mutex);
+                lastOpApplied = std::max(
+                    lastOpApplied,
+                    repl::ReplClientInfo::forClient(inserterOpCtx->getClient()).getLastOp());
+            });
+
+            try {
+                while (true) {
+                    auto nextBatch = batches.pop(inserterOpCtx.get());
+                    insertBatchFn(inserterOpCtx.get(), nextBatch["objects"].Obj());
+                }
+            } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueConsumed>&) {
+                // Every batch has been inserted.
+            } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+                // Another thread failed and is stopping the clone.
+            } catch (...) {
+                interruptClone("Batch insertion");
+            }
+        });
+    }
+
+    for (int i = 1; i < concurrency; ++i) {
+        workers.emplace_back([&] {
+            Client::initKillableThread("chunkFetcher", opCtx->getServiceContext());
+
+            auto fetcherOpCtx = Client::getCurrent()->makeOperationContext();
+            try {
+                fetchBatches(fetcherOpCtx.get());
+            } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+                // Another thread failed and is stopping the clone.
+            } catch (...) {
+                interruptClone("Batch fetching");
+            }
+        });
+    }
+
+    fetchBatches(opCtx);
+
+    // Wait for the other fetchers, and for the inserters to drain the queue.
+    joinWorkersGuard.dismiss();
+    for (auto& worker : workers) {
+        worker.join();
     }
+    opCtx->checkForInterrupt();
 
     return lastOpApplied;
 }
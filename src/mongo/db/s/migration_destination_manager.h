@@ -109,7 +109,8 @@ public:
                  const WriteConcernOptions& writeConcern);
 
     /**
-     * Clones documents from a donor shard.
+     * Clones documents from a donor shard. Runs 'migrateCloneConcurrency' threads each of
+     * 'fetchBatchFn' and 'insertBatchFn', where the calling thread is one of the fetchers.
      */
     static repl::OpTime cloneDocumentsFromDonor(
         OperationContext* opCtx,
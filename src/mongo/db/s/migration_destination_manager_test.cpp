@@ -30,8 +30,11 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/s/migration_destination_manager.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/s/shard_server_test_fixture.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -105,6 +108,47 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWorksCorrectly) {
     }
 }
 
+// Tests that concurrent fetchers and inserters clone every document exactly once.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorConcurrently) {
+    migrateCloneConcurrency.store(4);
+    ON_BLOCK_EXIT([] { migrateCloneConcurrency.store(1); });
+
+    const int numBatches = 20;
+    AtomicWord<int> nextBatch{0};
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        BSONObjBuilder fetchBatchResultBuilder;
+
+        const auto batch = nextBatch.fetchAndAdd(1);
+        if (batch >= numBatches) {
+            fetchBatchResultBuilder.append("objects", BSONObj());
+        } else {
+            fetchBatchResultBuilder.append("objects", BSON_ARRAY(createDocument(batch)));
+        }
+
+        return fetchBatchResultBuilder.obj();
+    };
+
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<int> resultIds;
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        stdx::lock_guard<Latch> lk(mutex);
+        for (auto&& docToClone : docs) {
+            resultIds.push_back(docToClone.Obj()["_id"].numberInt());
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn);
+
+    std::sort(resultIds.begin(), resultIds.end());
+    ASSERT_EQ(static_cast<size_t>(numBatches), resultIds.size());
+    for (int i = 0; i < numBatches; ++i) {
+        ASSERT_EQ(i, resultIds[i]);
+    }
+}
+
 // Tests that an exception in the fetch logic will successfully throw an exception on the main
 // thread.
 TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrors) {
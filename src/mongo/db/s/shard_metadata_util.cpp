@@ -165,6 +165,30 @@ StatusWith<ShardCollectionType> readShardCollectionsEntry(OperationContext* opCt
     }
 }
 
+StatusWith<std::vector<NamespaceString>> readShardCollectionsNamespaces(OperationContext* opCtx) {
+    try {
+        DBDirectClient client(opCtx);
+        std::unique_ptr<DBClientCursor> cursor =
+            client.query(NamespaceString::kShardConfigCollectionsNamespace, Query());
+        if (!cursor) {
+            return Status(ErrorCodes::OperationFailed,
+                          str::stream() << "Failed to establish a cursor for reading "
+                                        << NamespaceString::kShardConfigCollectionsNamespace.ns()
+                                        << " from local storage");
+        }
+
+        std::vector<NamespaceString> namespaces;
+        while (cursor->more()) {
+            BSONObj document = cursor->nextSafe();
+            namespaces.emplace_back(document.getStringField(ShardCollectionType::kNssFieldName));
+        }
+
+        return namespaces;
+    } catch (const DBException& ex) {
+        return ex.toStatus("Failed to read the entries locally from config.collections");
+    }
+}
+
 StatusWith<ShardDatabaseType> readShardDatabasesEntry(OperationContext* opCtx, StringData dbName) {
     Query fullQuery(BSON(ShardDatabaseType::name() << dbName.toString()));
 
@@ -126,6 +126,11 @@ StatusWith<RefreshState> getPersistedRefreshFlags(OperationContext* opCtx,
 StatusWith<ShardCollectionType> readShardCollectionsEntry(OperationContext* opCtx,
                                                           const NamespaceString& nss);
 
+/**
+ * Reads the namespaces of all the shard server's collections collection entries.
+ */
+StatusWith<std::vector<NamespaceString>> readShardCollectionsNamespaces(OperationContext* opCtx);
+
 /**
  * Reads the shard server's databases collection entry identified by 'dbName'.
  */
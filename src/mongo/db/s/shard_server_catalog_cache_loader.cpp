@@ -42,6 +42,7 @@
 #include "mongo/db/read_concern.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/shard_metadata_util.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/s/catalog/type_shard_collection.h"
 #include "mongo/s/catalog/type_shard_database.h"
@@ -394,10 +395,22 @@ void ShardServerCatalogCacheLoader::onStepDown() {
 }
 
 void ShardServerCatalogCacheLoader::onStepUp() {
-    stdx::lock_guard<Latch> lg(_mutex);
-    invariant(_role != ReplicaSetRole::None);
-    ++_term;
-    _role = ReplicaSetRole::Primary;
+    long long term;
+    {
+        stdx::lock_guard<Latch> lg(_mutex);
+        invariant(_role != ReplicaSetRole::None);
+        ++_term;
+        _role = ReplicaSetRole::Primary;
+
+        if (_inShutdown) {
+            return;
+        }
+        term = _term;
+    }
+
+    if (refreshRoutingMetadataOnStepUp.load()) {
+        _scheduleStepUpRefresh(term);
+    }
 }
 
 void ShardServerCatalogCacheLoader::shutDown() {
@@ -611,6 +624,42 @@ void ShardServerCatalogCacheLoader::waitForDatabaseFlush(OperationContext* opCtx
     }
 }
 
+void ShardServerCatalogCacheLoader::_scheduleStepUpRefresh(long long termScheduled) {
+    _threadPool.schedule([this, termScheduled](auto status) noexcept {
+        if (!status.isOK()) {
+            // The loader is shutting down.
+            return;
+        }
+
+        auto context = _contexts.makeOperationContext(*Client::getCurrent());
+        auto const opCtx = context.opCtx();
+
+        try {
+            const auto namespaces = uassertStatusOK(readShardCollectionsNamespaces(opCtx));
+
+            for (const auto& nss : namespaces) {
+                {
+                    stdx::lock_guard<Latch> lock(_mutex);
+                    if (_term != termScheduled) {
+                        return;
+                    }
+                }
+
+                // Each refresh only fetches from the config server the chunks which changed
+                // since the version this node has already persisted, and runs independently of
+                // the others, so the collections are refreshed in parallel.
+                getChunksSince(nss, getPersistedMaxChunkVersion(opCtx, nss), [](auto, auto) {});
+            }
+
+            LOG_CATALOG_REFRESH(1) << "Scheduled a refresh of the routing metadata for "
+                                   << namespaces.size() << " collections after step-up";
+        } catch (const DBException& ex) {
+            LOG_CATALOG_REFRESH(0) << "Failed to schedule the refresh of the routing metadata "
+                                   << "after step-up" << causedBy(redact(ex.toStatus()));
+        }
+    });
+}
+
 void ShardServerCatalogCacheLoader::_runSecondaryGetChunksSince(
     OperationContext* opCtx,
     const NamespaceString& nss,
@@ -334,6 +334,14 @@ private:
 
     typedef std::map<NamespaceString, CollAndChunkTaskList> CollAndChunkTaskLists;
 
+    /**
+     * Schedules an incremental refresh of every collection with persisted metadata, so that a node
+     * which has just become primary catches up with the config server in parallel rather than one
+     * collection at a time as stale-version errors arrive. Stops scheduling refreshes if the term
+     * changes from 'termScheduled'.
+     */
+    void _scheduleStepUpRefresh(long long termScheduled);
+
     /**
      * Forces the primary to refresh its metadata for 'nss' and waits until this node's metadata
      * has caught up to the primary's.
@@ -42,6 +42,7 @@
 #include "mongo/db/s/migration_source_manager.h"
 #include "mongo/db/s/shard_identity_rollback_notifier.h"
 #include "mongo/db/s/sharding_initialization_mongod.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/type_shard_identity.h"
 #include "mongo/s/balancer_configuration.h"
 #include "mongo/s/catalog/type_shard_collection.h"
@@ -147,14 +148,16 @@ void onConfigDeleteInvalidateCachedCollectionMetadataAndNotify(OperationContext*
 /**
  * If the collection is sharded, finds the chunk that contains the specified document and increments
  * the size tracked for that chunk by the specified amount of data written, in bytes. Returns the
- * number of total bytes on that chunk after the data is written.
+ * number of total bytes on that chunk after the data is written. Inserted documents are also added
+ * to the chunk's shard key sketch, from which split points are picked.
  */
 void incrementChunkOnInsertOrUpdate(OperationContext* opCtx,
                                     const NamespaceString& nss,
                                     const ChunkManager& chunkManager,
                                     const BSONObj& document,
                                     long dataWritten,
-                                    bool fromMigrate) {
+                                    bool fromMigrate,
+                                    bool isInsert) {
     const auto& shardKeyPattern = chunkManager.getShardKeyPattern();
     BSONObj shardKey = shardKeyPattern.extractShardKeyFromDoc(document);
 
@@ -166,6 +169,10 @@ void incrementChunkOnInsertOrUpdate(OperationContext* opCtx,
     auto chunk = chunkManager.findIntersectingChunkWithSimpleCollation(shardKey);
     auto chunkWritesTracker = chunk.getWritesTracker();
     chunkWritesTracker->addBytesWritten(dataWritten);
+    chunkWritesTracker->recordWriteOp(dataWritten);
+    if (isInsert && autoSplitUseShardKeySketch.load()) {
+        chunkWritesTracker->getShardKeySketch().add(shardKey, dataWritten);
+    }
     // Don't trigger chunk splits from inserts happening due to migration since
     // we don't necessarily own that chunk yet
     if (!fromMigrate) {
@@ -223,7 +230,8 @@ void ShardServerOpObserver::onInserts(OperationContext* opCtx,
                                            *metadata->getChunkManager(),
                                            insertedDoc,
                                            insertedDoc.objsize(),
-                                           fromMigrate);
+                                           fromMigrate,
+                                           true /* isInsert */);
         }
     }
 }
@@ -327,7 +335,8 @@ void ShardServerOpObserver::onUpdate(OperationContext* opCtx, const OplogUpdateE
                                        *metadata->getChunkManager(),
                                        args.updateArgs.updatedDoc,
                                        args.updateArgs.updatedDoc.objsize(),
-                                       args.updateArgs.fromMigrate);
+                                       args.updateArgs.fromMigrate,
+                                       false /* isInsert */);
     }
 }
 
@@ -342,7 +351,8 @@ void ShardServerOpObserver::onDelete(OperationContext* opCtx,
                                      OptionalCollectionUUID uuid,
                                      StmtId stmtId,
                                      bool fromMigrate,
-                                     const boost::optional<BSONObj>& deletedDoc) {
+                                     const boost::optional<BSONObj>& deletedDoc,
+                                     const repl::OplogSlot& oplogSlot) {
     auto& documentKey = getDocumentKey(opCtx);
 
     if (nss == NamespaceString::kShardConfigCollectionsNamespace) {
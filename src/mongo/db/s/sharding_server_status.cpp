@@ -32,6 +32,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/s/active_migrations_registry.h"
+#include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/s/balancer_configuration.h"
@@ -116,5 +117,34 @@ public:
 
 } shardingStatisticsServerStatus;
 
+/**
+ * Reports the total writes to each of the chunks owned by this shard. Not included by default,
+ * because its size grows with the number of chunks written to; the balancer requests it explicitly
+ * when load-aware balancing is enabled.
+ */
+class ChunkLoadServerStatus final : public ServerStatusSection {
+public:
+    ChunkLoadServerStatus() : ServerStatusSection("chunkLoad") {}
+
+    bool includeByDefault() const override {
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        if (!isClusterNode())
+            return {};
+
+        auto const shardingState = ShardingState::get(opCtx);
+        if (!shardingState->enabled())
+            return {};
+
+        BSONObjBuilder result;
+        CollectionShardingState::reportChunkLoad(opCtx, &result);
+        return result.obj();
+    }
+
+} chunkLoadServerStatus;
+
 }  // namespace
 }  // namespace mongo
@@ -63,6 +63,8 @@ void ShardingStatistics::report(BSONObjBuilder* builder) const {
     builder->append("countRecipientMoveChunkStarted", countRecipientMoveChunkStarted.load());
     builder->append("countDocsDeletedOnDonor", countDocsDeletedOnDonor.load());
     builder->append("countDonorMoveChunkLockTimeout", countDonorMoveChunkLockTimeout.load());
+    builder->append("countAutoSplitsFromShardKeySketch", countAutoSplitsFromShardKeySketch.load());
+    builder->append("countAutoSplitVectorScans", countAutoSplitVectorScans.load());
 }
 
 }  // namespace mongo
@@ -91,6 +91,15 @@ struct ShardingStatistics {
     // after timing out waiting to acquire a lock.
     AtomicWord<long long> countDonorMoveChunkLockTimeout{0};
 
+    // Cumulative, always-increasing counter of the number of auto-splits whose split points were
+    // taken from the chunk's shard key sketch, after only confirming the chunk's size with a scan
+    // of part of the shard key index.
+    AtomicWord<long long> countAutoSplitsFromShardKeySketch{0};
+
+    // Cumulative, always-increasing counter of the number of times auto-split scanned the shard key
+    // index of a chunk to look for split points.
+    AtomicWord<long long> countAutoSplitVectorScans{0};
+
     /**
      * Obtains the per-process instance of the sharding statistics object.
      */
@@ -232,6 +232,14 @@ TransactionCoordinator::TransactionCoordinator(OperationContext* operationContex
                     return Future<repl::OpTime>::makeReady(repl::OpTime());
             }
 
+            // Overlap sending an abort decision with making it durable, so that the participants
+            // release their resources without waiting for the decision to be majority committed.
+            // The response to the client is still only sent after the decision is durable.
+            if (_decision->getDecision() == CommitDecision::kAbort) {
+                _abortSentBeforeDecisionDurable.emplace(txn::sendAbort(
+                    _serviceContext, *_scheduler, _lsid, _txnNumber, *_participants));
+            }
+
             return txn::persistDecision(*_scheduler, _lsid, _txnNumber, *_participants, *_decision);
         })
         .then([this](repl::OpTime opTime) {
@@ -280,6 +288,12 @@ TransactionCoordinator::TransactionCoordinator(OperationContext* operationContex
                     else
                         _decisionPromise.emplaceValue(CommitDecision::kAbort);
 
+                    if (_abortSentBeforeDecisionDurable) {
+                        auto abortSent = std::move(*_abortSentBeforeDecisionDurable);
+                        _abortSentBeforeDecisionDurable.reset();
+                        return abortSent;
+                    }
+
                     return txn::sendAbort(
                         _serviceContext, *_scheduler, _lsid, _txnNumber, *_participants);
                 }
@@ -309,13 +323,27 @@ TransactionCoordinator::TransactionCoordinator(OperationContext* operationContex
             _scheduler->shutdown(
                 {ErrorCodes::TransactionCoordinatorDeadlineTaskCanceled, "Coordinator completed"});
 
-            return std::move(deadlineFuture).onCompletion([this, s = std::move(s)](Status) {
-                // Notify all the listeners which are interested in the coordinator's lifecycle.
-                // After this call, the coordinator object could potentially get destroyed by its
-                // lifetime controller, so there shouldn't be any accesses to `this` after this
-                // call.
-                _done(s);
-            });
+            // If the chain failed while an abort decision was being made durable, the
+            // abortTransaction requests sent in the meantime must be joined as well.
+            auto abortSent = [&] {
+                if (!_abortSentBeforeDecisionDurable)
+                    return Future<void>::makeReady();
+                auto abortSent = std::move(*_abortSentBeforeDecisionDurable);
+                _abortSentBeforeDecisionDurable.reset();
+                return abortSent;
+            }();
+
+            return std::move(abortSent).onCompletion(
+                [this, s = std::move(s), deadlineFuture = std::move(deadlineFuture)](
+                    Status) mutable {
+                    return std::move(deadlineFuture).onCompletion([this, s = std::move(s)](Status) {
+                        // Notify all the listeners which are interested in the coordinator's
+                        // lifecycle. After this call, the coordinator object could potentially get
+                        // destroyed by its lifetime controller, so there shouldn't be any accesses
+                        // to `this` after this call.
+                        _done(s);
+                    });
+                });
         });
 }
 
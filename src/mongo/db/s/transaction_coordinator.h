@@ -194,6 +194,13 @@ private:
     bool _decisionDurable{false};
     SharedPromise<txn::CommitDecision> _decisionPromise;
 
+    // Set when the decision is to abort and it is not yet durable, to the abortTransaction requests
+    // which are sent to the participants while the decision is being persisted. Unlike a commit
+    // decision, an abort decision may reach the participants before it is majority committed: a
+    // coordinator which recovers the transaction without a decision sends prepare again, which is
+    // answered with an abort vote by every participant which has already aborted.
+    boost::optional<Future<void>> _abortSentBeforeDecisionDurable;
+
     // A list of all promises corresponding to futures that were returned to callers of
     // onCompletion.
     SharedPromise<txn::CommitDecision> _completionPromise;
@@ -895,6 +895,35 @@ TEST_F(TransactionCoordinatorTest, RunCommitProducesAbortDecisionOnSingleAbortRe
     coordinator.onCompletion().get();
 }
 
+TEST_F(TransactionCoordinatorTest, RunCommitSendsAbortBeforeAbortDecisionIsMajorityCommitted) {
+    TransactionCoordinator coordinator(
+        operationContext(),
+        _lsid,
+        _txnNumber,
+        std::make_unique<txn::AsyncWorkScheduler>(getServiceContext()),
+        Date_t::max());
+    auto commitDecisionFuture = coordinator.getDecision();
+
+    {
+        FailPointEnableBlock fp("hangBeforeWaitingForDecisionWriteConcern");
+
+        coordinator.runCommit(operationContext(), kTwoShardIdList);
+        assertPrepareSentAndRespondWithNoSuchTransaction();
+        advanceClockAndExecuteScheduledTasks();  // Make sure the cancellation callback is delivered
+
+        // The participants learn about the abort while the decision is not yet durable, but the
+        // decision is only returned once it is.
+        assertAbortSentAndRespondWithSuccess();
+        assertAbortSentAndRespondWithSuccess();
+        ASSERT(!commitDecisionFuture.isReady());
+    }
+
+    auto commitDecision = commitDecisionFuture.get();
+    ASSERT_EQ(static_cast<int>(commitDecision), static_cast<int>(txn::CommitDecision::kAbort));
+
+    coordinator.onCompletion().get();
+}
+
 TEST_F(TransactionCoordinatorTest,
        RunCommitProducesAbortDecisionOnOneCommitResponseAndOneAbortResponseAfterRetry) {
     TransactionCoordinator coordinator(
@@ -84,7 +84,7 @@ struct ServerGlobalParams {
     std::string socket = "/tmp";  // UNIX domain socket directory
     std::string transportLayer;   // --transportLayer (must be either "asio" or "legacy")
 
-    // --serviceExecutor ("adaptive", "synchronous")
+    // --serviceExecutor ("adaptive", "perCore", "synchronous")
     std::string serviceExecutor;
 
     size_t maxConns = DEFAULT_MAX_CONN;  // Maximum number of simultaneous open connections.
@@ -104,6 +104,8 @@ struct ServerGlobalParams {
     bool logWithSyslog = false;     // True if logging to syslog; must not be set if logpath is set.
     bool logV2 = false;  // True if logV1 logging statements should get plumbed through to logV2
     int syslogFacility;  // Facility used when appending messages to the syslog.
+    // True if logV2 writes to the log file from a background thread.
+    bool logAsyncWrites = false;
 
 #ifndef _WIN32
     ProcessId parentProc;  // --fork pid of initial process
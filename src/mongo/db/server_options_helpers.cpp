@@ -396,6 +396,14 @@ Status storeBaseOptions(const moe::Environment& params) {
         }
     }
 
+    if (params.count("systemLog.asyncWrites") &&
+        params["systemLog.asyncWrites"].as<bool>() == true) {
+        if (!serverGlobalParams.logV2)
+            return Status(ErrorCodes::BadValue,
+                          "Can only use systemLog.asyncWrites if logv2 is enabled.");
+        serverGlobalParams.logAsyncWrites = true;
+    }
+
     if (params.count("systemLog.logAppend") && params["systemLog.logAppend"].as<bool>() == true) {
         serverGlobalParams.logAppend = true;
     }
@@ -149,6 +149,38 @@ void ServerTransactionsMetrics::decrementCurrentPrepared() {
     _currentPrepared.fetchAndSubtract(1);
 }
 
+Microseconds ServerTransactionsMetrics::getTotalStashTime() const {
+    return Microseconds{_totalStashMicros.load()};
+}
+
+void ServerTransactionsMetrics::incrementTotalStashTime(Microseconds duration) {
+    _totalStashMicros.fetchAndAdd(durationCount<Microseconds>(duration));
+}
+
+Microseconds ServerTransactionsMetrics::getTotalUnstashTime() const {
+    return Microseconds{_totalUnstashMicros.load()};
+}
+
+void ServerTransactionsMetrics::incrementTotalUnstashTime(Microseconds duration) {
+    _totalUnstashMicros.fetchAndAdd(durationCount<Microseconds>(duration));
+}
+
+Microseconds ServerTransactionsMetrics::getTotalCommitOplogWriteTime() const {
+    return Microseconds{_totalCommitOplogWriteMicros.load()};
+}
+
+void ServerTransactionsMetrics::incrementTotalCommitOplogWriteTime(Microseconds duration) {
+    _totalCommitOplogWriteMicros.fetchAndAdd(durationCount<Microseconds>(duration));
+}
+
+Microseconds ServerTransactionsMetrics::getTotalCommitStorageTime() const {
+    return Microseconds{_totalCommitStorageMicros.load()};
+}
+
+void ServerTransactionsMetrics::incrementTotalCommitStorageTime(Microseconds duration) {
+    _totalCommitStorageMicros.fetchAndAdd(durationCount<Microseconds>(duration));
+}
+
 void ServerTransactionsMetrics::updateStats(TransactionsStats* stats) {
     stats->setCurrentActive(_currentActive.load());
     stats->setCurrentInactive(_currentInactive.load());
@@ -160,6 +192,10 @@ void ServerTransactionsMetrics::updateStats(TransactionsStats* stats) {
     stats->setTotalPreparedThenCommitted(_totalPreparedThenCommitted.load());
     stats->setTotalPreparedThenAborted(_totalPreparedThenAborted.load());
     stats->setCurrentPrepared(_currentPrepared.load());
+    stats->setTimeStashingMicros(_totalStashMicros.load());
+    stats->setTimeUnstashingMicros(_totalUnstashMicros.load());
+    stats->setTimeWritingCommitOplogEntriesMicros(_totalCommitOplogWriteMicros.load());
+    stats->setTimeCommittingStorageTransactionMicros(_totalCommitStorageMicros.load());
 }
 
 namespace {
@@ -37,6 +37,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/transactions_stats_gen.h"
 #include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
@@ -87,6 +88,24 @@ public:
     void incrementCurrentPrepared();
     void decrementCurrentPrepared();
 
+    /**
+     * Cumulative time spent in the fixed per-transaction phases that a small transaction pays for
+     * regardless of how much work its statements do: moving the transaction's resources off of and
+     * back onto the operation context between statements, writing the commit oplog entries, and
+     * committing the storage transaction.
+     */
+    Microseconds getTotalStashTime() const;
+    void incrementTotalStashTime(Microseconds duration);
+
+    Microseconds getTotalUnstashTime() const;
+    void incrementTotalUnstashTime(Microseconds duration);
+
+    Microseconds getTotalCommitOplogWriteTime() const;
+    void incrementTotalCommitOplogWriteTime(Microseconds duration);
+
+    Microseconds getTotalCommitStorageTime() const;
+    void incrementTotalCommitStorageTime(Microseconds duration);
+
     /**
      * Appends the accumulated stats to a transactions stats object.
      */
@@ -122,6 +141,15 @@ private:
 
     // The current number of transactions in the prepared state.
     AtomicWord<unsigned long long> _currentPrepared{0};
+
+    // The total time, in microseconds, spent stashing and unstashing transaction resources.
+    AtomicWord<long long> _totalStashMicros{0};
+    AtomicWord<long long> _totalUnstashMicros{0};
+
+    // The total time, in microseconds, spent writing the oplog entries of unprepared transaction
+    // commits and committing the storage transactions of all transaction commits.
+    AtomicWord<long long> _totalCommitOplogWriteMicros{0};
+    AtomicWord<long long> _totalCommitStorageMicros{0};
 };
 
 }  // namespace mongo
@@ -58,6 +58,7 @@
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/logical_session_id_helpers.h"
 #include "mongo/db/logical_time_validator.h"
+#include "mongo/db/operation_trace.h"
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/ops/write_ops_exec.h"
 #include "mongo/db/query/find.h"
@@ -77,6 +78,7 @@
 #include "mongo/db/session_catalog_mongod.h"
 #include "mongo/db/snapshot_window_util.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats/query_stats_store.h"
 #include "mongo/db/stats/server_read_concern_metrics.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/db/transaction_participant.h"
@@ -742,7 +744,14 @@ void execCommandDatabase(OperationContext* opCtx,
     BSONObjBuilder extraFieldsBuilder;
     auto startOperationTime = getClientOperationTime(opCtx);
 
-    auto invocation = command->parse(opCtx, request);
+    OperationTrace::get(opCtx).start(
+        opCtx, command->getName(), request.body[OperationTrace::kMetadataFieldName]);
+
+    std::unique_ptr<CommandInvocation> invocation;
+    {
+        OperationTrace::Span parseSpan(opCtx, "parse");
+        invocation = command->parse(opCtx, request);
+    }
 
     OperationSessionInfoFromClient sessionOptions;
 
@@ -1355,6 +1364,47 @@ DbResponse receivedGetMore(OperationContext* opCtx,
     return dbresponse;
 }
 
+/**
+ * Closes the trace of the operation if it is being traced, attaching the operation's totals to its
+ * root span.
+ */
+void finishOperationTrace(OperationContext* opCtx, CurOp& currentOp) {
+    auto& trace = OperationTrace::get(opCtx);
+    if (!trace.isActive()) {
+        return;
+    }
+
+    const auto& debug = currentOp.debug();
+    BSONObjBuilder attributes;
+    attributes.append("ns", currentOp.getNS());
+    if (!currentOp.getPlanSummary().empty()) {
+        attributes.append("planSummary", currentOp.getPlanSummary());
+    }
+    if (debug.additiveMetrics.keysExamined) {
+        attributes.append("keysExamined", *debug.additiveMetrics.keysExamined);
+    }
+    if (debug.additiveMetrics.docsExamined) {
+        attributes.append("docsExamined", *debug.additiveMetrics.docsExamined);
+    }
+    if (debug.nreturned >= 0) {
+        attributes.append("nreturned", debug.nreturned);
+    }
+    if (debug.responseLength >= 0) {
+        attributes.append("responseLength", debug.responseLength);
+    }
+    if (!debug.errInfo.isOK()) {
+        attributes.append("errCode", debug.errInfo.code());
+    }
+    if (auto lockerInfo = opCtx->lockState()->getLockerInfo(boost::none)) {
+        BSONObjBuilder locks(attributes.subobjStart("locks"));
+        lockerInfo->stats.report(&locks);
+    }
+    if (debug.storageStats) {
+        attributes.append("storage", debug.storageStats->toBSON());
+    }
+    trace.finish(attributes.obj());
+}
+
 }  // namespace
 
 BSONObj ServiceEntryPointCommon::getRedactedCopyForLogging(const Command* command,
@@ -1487,6 +1537,22 @@ DbResponse ServiceEntryPointCommon::handleRequest(OperationContext* opCtx,
             durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses()),
             currentOp.getReadWriteType());
 
+    finishOperationTrace(opCtx, currentOp);
+
+    // Accumulate the statistics of operations which ran a query with a plan cache shape.
+    if (debug.queryHash && c.isFromUserConnection() && !c.isInDirectClient()) {
+        QueryStatsStore::Execution execution;
+        execution.latencyMicros = debug.executionTimeMicros;
+        execution.readWriteType = currentOp.getReadWriteType();
+        execution.keysExamined = debug.additiveMetrics.keysExamined.value_or(0);
+        execution.docsExamined = debug.additiveMetrics.docsExamined.value_or(0);
+        execution.nreturned = std::max(debug.nreturned, 0LL);
+        execution.bytesReturned = std::max(debug.responseLength, 0);
+        execution.usedDisk = debug.usedDisk;
+        QueryStatsStore::get(opCtx->getServiceContext())
+            .record(NamespaceString(currentOp.getNS()), *debug.queryHash, execution);
+    }
+
     if (currentOp.shouldDBProfile(shouldSample)) {
         // Performance profiling is on
         if (opCtx->lockState()->isReadLocked()) {
@@ -59,8 +59,25 @@ Date_t MockServiceLiaisonImpl::now() const {
 }
 
 void MockServiceLiaisonImpl::scheduleJob(PeriodicRunner::PeriodicJob job) {
-    // The cache should be refreshed from tests by calling refreshNow().
-    return;
+    // The cache should be refreshed from tests by calling refreshNow() or runScheduledJob().
+    stdx::unique_lock<Latch> lk(_mutex);
+    _scheduledJobs.push_back(std::move(job));
+}
+
+Milliseconds MockServiceLiaisonImpl::runScheduledJob(StringData name, Client* client) {
+    auto job = [&] {
+        stdx::unique_lock<Latch> lk(_mutex);
+        auto it = std::find_if(
+            _scheduledJobs.begin(), _scheduledJobs.end(), [&](const auto& scheduledJob) {
+                return scheduledJob.name == name;
+            });
+        invariant(it != _scheduledJobs.end());
+        return &*it;
+    }();
+
+    // Jobs call back into this object, so they must run without holding the mutex.
+    job->job(client);
+    return job->interval;
 }
 
 
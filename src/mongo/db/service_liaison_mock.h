@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "mongo/db/service_context.h"
 #include "mongo/db/service_liaison.h"
 #include "mongo/executor/async_timer_mock.h"
@@ -77,6 +79,9 @@ public:
     void fastForward(Milliseconds time);
     int jobs();
 
+    // Runs the job with the given name which was handed to scheduleJob(), and returns its interval.
+    Milliseconds runScheduledJob(StringData name, Client* client);
+
     const KillAllSessionsByPattern* matchKilled(const LogicalSessionId& lsid);
     std::pair<Status, int> killCursorsWithMatchingSessions(OperationContext* opCtx,
                                                            const SessionKiller::Matcher& matcher);
@@ -90,6 +95,8 @@ private:
     mutable Mutex _mutex = MONGO_MAKE_LATCH("MockServiceLiaisonImpl::_mutex");
     LogicalSessionIdSet _activeSessions;
     LogicalSessionIdSet _cursorSessions;
+
+    std::vector<PeriodicRunner::PeriodicJob> _scheduledJobs;
 };
 
 /**
@@ -110,6 +110,20 @@ struct SnapshotWindowParams {
     static inline MutableObserverRegistry<decltype(checkCachePressurePeriodSeconds)::WordType>
         observeCheckCachePressurePeriodSeconds;
 
+    // snapshotHistoryIdleSeconds (startup & runtime server parameter, range 0+).
+    //
+    // Releases the snapshot history while nobody reads from it. When no read at a provided
+    // atClusterTime has started for this many seconds, the periodic cache pressure task drops
+    // targetSnapshotHistoryWindowInSeconds to 0, and the storage engine then only keeps the history
+    // that open transactions are still reading. The next such read restores the previous target.
+    // 0, the default, keeps the target window whether or not there are readers.
+    AtomicWord<int> snapshotHistoryIdleSeconds{0};
+
+    // When the last read at a provided atClusterTime started, in milliseconds since the epoch, and
+    // whether the snapshot history has been released for idleness since.
+    AtomicWord<long long> lastPointInTimeReadMillis{0};
+    AtomicWord<bool> snapshotHistoryReleased{false};
+
     AtomicWord<std::int64_t> snapshotTooOldErrorCount{0};
 };
 
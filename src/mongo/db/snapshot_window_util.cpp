@@ -50,15 +50,23 @@ MONGO_FAIL_POINT_DEFINE(preventDynamicSnapshotHistoryWindowTargetAdjustments);
 
 namespace SnapshotWindowUtil {
 
-// Adds concurrency control to increaseTargetSnapshotWindowSize() and
-// decreaseTargetSnapshotWindowSize(). They should not run concurrently with themselves or one
-// another, since they act on and modify the same storage parameters. Further guards the static
-// variables "_snapshotWindowLastDecreasedAt" and "_snapshotWindowLastIncreasedAt" used in
-// increaseTargetSnapshotWindowSize() and decreaseSnapshowWindow().
+// Adds concurrency control to increaseTargetSnapshotWindowSize(),
+// decreaseTargetSnapshotWindowSize(), notePointInTimeRead() and releaseIdleSnapshotHistory(). They
+// should not run concurrently with themselves or one another, since they act on and modify the same
+// storage parameters. Further guards the static variables "_snapshotWindowLastDecreasedAt" and
+// "_snapshotWindowLastIncreasedAt" used in increaseTargetSnapshotWindowSize() and
+// decreaseSnapshowWindow(), and "_targetSnapshotWindowBeforeRelease".
 Mutex snapshotWindowMutex;
 
 namespace {
 
+// The target window size to restore when a point-in-time read follows a release of the history.
+int _targetSnapshotWindowBeforeRelease = 0;
+
+// Readers only refresh the time of the last point-in-time read this often, so that every read
+// doesn't write the same word.
+const long long kPointInTimeReadRefreshMillis = 1000;
+
 void _decreaseTargetSnapshotWindowSize(WithLock lock, OperationContext* opCtx) {
     // Tracks the last time that the snapshot window was decreased so that it does not go down so
     // fast that the system does not have time to react and reduce snapshot availability.
@@ -159,6 +167,60 @@ void decreaseTargetSnapshotWindowSize(OperationContext* opCtx) {
     }
 }
 
+void notePointInTimeRead(OperationContext* opCtx) {
+    const long long now = Date_t::now().toMillisSinceEpoch();
+    if (now - snapshotWindowParams.lastPointInTimeReadMillis.load() >=
+        kPointInTimeReadRefreshMillis) {
+        snapshotWindowParams.lastPointInTimeReadMillis.store(now);
+    }
+
+    if (MONGO_likely(!snapshotWindowParams.snapshotHistoryReleased.load())) {
+        return;
+    }
+
+    stdx::unique_lock<Latch> lock(snapshotWindowMutex);
+    if (!snapshotWindowParams.snapshotHistoryReleased.load()) {
+        return;
+    }
+
+    snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.store(
+        std::min(_targetSnapshotWindowBeforeRelease,
+                 snapshotWindowParams.maxTargetSnapshotHistoryWindowInSeconds.load()));
+    snapshotWindowParams.snapshotHistoryReleased.store(false);
+    log() << "Restoring the window of available snapshots for point-in-time operations to "
+          << snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.load() << " seconds";
+}
+
+void releaseIdleSnapshotHistory(OperationContext* opCtx) {
+    const int idleSeconds = snapshotWindowParams.snapshotHistoryIdleSeconds.load();
+    if (idleSeconds == 0 || snapshotWindowParams.snapshotHistoryReleased.load()) {
+        return;
+    }
+
+    const auto lastPointInTimeRead =
+        Date_t::fromMillisSinceEpoch(snapshotWindowParams.lastPointInTimeReadMillis.load());
+    if (Date_t::now() - lastPointInTimeRead < Seconds(idleSeconds)) {
+        return;
+    }
+
+    stdx::unique_lock<Latch> lock(snapshotWindowMutex);
+    if (snapshotWindowParams.snapshotHistoryReleased.load()) {
+        return;
+    }
+
+    _targetSnapshotWindowBeforeRelease =
+        snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.load();
+    snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.store(0);
+    snapshotWindowParams.snapshotHistoryReleased.store(true);
+    LOG(1) << "No point-in-time reads for " << idleSeconds
+           << " seconds, releasing the window of available snapshots";
+
+    StorageEngine* engine = opCtx->getServiceContext()->getStorageEngine();
+    if (engine) {
+        engine->setOldestTimestampFromStable();
+    }
+}
+
 void incrementSnapshotTooOldErrorCount() {
     snapshotWindowParams.snapshotTooOldErrorCount.addAndFetch(1);
 }
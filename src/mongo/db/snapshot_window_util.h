@@ -74,6 +74,22 @@ void increaseTargetSnapshotWindowSize(OperationContext* opCtx);
  */
 void decreaseTargetSnapshotWindowSize(OperationContext* opCtx);
 
+/**
+ * Records that a read at a provided atClusterTime is starting, which needs the snapshot history
+ * window. If the history was released by releaseIdleSnapshotHistory(), restores the target window
+ * size it had before. As with an increase, the window only grows back as the stable timestamp
+ * advances.
+ */
+void notePointInTimeRead(OperationContext* opCtx);
+
+/**
+ * Drops the target snapshot history window size to 0 if snapshotHistoryIdleSeconds is set and no
+ * read has been noted by notePointInTimeRead() for that long. The storage engine then keeps only
+ * the history pinned by the read timestamps of open transactions, instead of a window that nobody
+ * reads. The oldest_timestamp is moved up to the stable timestamp right away.
+ */
+void releaseIdleSnapshotHistory(OperationContext* opCtx);
+
 /**
  * Increments a counter of SnapshotTooOld errors encountered in the command layer. Used for
  * statistics purposes. Continuing SnapshotTooOld errors can indicate cache pressure.
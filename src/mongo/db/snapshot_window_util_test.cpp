@@ -162,6 +162,41 @@ TEST_F(SnapshotWindowTest, DecreaseAndIncreaseSnapshotWindow) {
     ASSERT_EQ(snapshotWindowSecondsFive, maxTargetSnapshotWindowSeconds);
 }
 
+TEST_F(SnapshotWindowTest, ReleaseIdleSnapshotHistoryAndRestoreOnRead) {
+    snapshotWindowParams.maxTargetSnapshotHistoryWindowInSeconds.store(100);
+    snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.store(60);
+
+    // Nothing is released while the release is disabled.
+    snapshotWindowParams.snapshotHistoryIdleSeconds.store(0);
+    snapshotWindowParams.lastPointInTimeReadMillis.store(0);
+    releaseIdleSnapshotHistory(_opCtx.get());
+    ASSERT_FALSE(snapshotWindowParams.snapshotHistoryReleased.load());
+    ASSERT_EQ(snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.load(), 60);
+
+    // Nor while point-in-time reads are recent.
+    snapshotWindowParams.snapshotHistoryIdleSeconds.store(3600);
+    notePointInTimeRead(_opCtx.get());
+    releaseIdleSnapshotHistory(_opCtx.get());
+    ASSERT_FALSE(snapshotWindowParams.snapshotHistoryReleased.load());
+    ASSERT_EQ(snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.load(), 60);
+
+    // Once reads have been idle for long enough, the window is released.
+    snapshotWindowParams.lastPointInTimeReadMillis.store(
+        (Date_t::now() - Hours(2)).toMillisSinceEpoch());
+    releaseIdleSnapshotHistory(_opCtx.get());
+    ASSERT_TRUE(snapshotWindowParams.snapshotHistoryReleased.load());
+    ASSERT_EQ(snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.load(), 0);
+
+    // The next point-in-time read restores it.
+    notePointInTimeRead(_opCtx.get());
+    ASSERT_FALSE(snapshotWindowParams.snapshotHistoryReleased.load());
+    ASSERT_EQ(snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.load(), 60);
+    ASSERT_GT(snapshotWindowParams.lastPointInTimeReadMillis.load(),
+              (Date_t::now() - Hours(1)).toMillisSinceEpoch());
+
+    snapshotWindowParams.snapshotHistoryIdleSeconds.store(0);
+}
+
 TEST_F(SnapshotWindowTest, IncrementSnapshotTooOldErrorCount) {
     auto beforeCount = snapshotWindowParams.snapshotTooOldErrorCount.load();
     incrementSnapshotTooOldErrorCount();
@@ -56,6 +56,7 @@
 #include "mongo/config.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/sorter/sorter_stats.h"
 #include "mongo/db/storage/encryption_hooks.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
@@ -367,6 +368,10 @@ private:
  * Merge-sorts results from 0 or more FileIterators, all of which should be iterating over sorted
  * ranges within the same file. This class is given the data source file name upon construction and
  * is responsible for deleting the data source file upon destruction.
+ *
+ * The streams are merged with a loser tree: each internal node holds the stream that lost the
+ * comparison at that node, so replacing the winner takes a single leaf-to-root pass of log2(k)
+ * comparisons, rather than the up to 2*log2(k) a binary heap needs to sift the replacement down.
  */
 template <typename Key, typename Value, typename Comparator>
 class MergeIterator : public SortIteratorInterface<Key, Value> {
@@ -386,28 +391,26 @@ public:
         for (size_t i = 0; i < iters.size(); i++) {
             iters[i]->openSource();
             if (iters[i]->more()) {
-                _heap.push_back(std::make_shared<Stream>(i, iters[i]->next(), iters[i]));
+                _streams.push_back(std::make_unique<Stream>(i, iters[i]->next(), iters[i]));
             } else {
                 iters[i]->closeSource();
             }
         }
 
-        if (_heap.empty()) {
+        if (_streams.empty()) {
             _remaining = 0;
             return;
         }
 
-        std::make_heap(_heap.begin(), _heap.end(), _greater);
-        std::pop_heap(_heap.begin(), _heap.end(), _greater);
-        _current = _heap.back();
-        _heap.pop_back();
+        _numActiveStreams = _streams.size();
+        _tree.resize(_streams.size());
+        _tree[0] = buildTree(1);
     }
 
     ~MergeIterator() {
         // Clear the remaining Stream objects first, to close the file handles before deleting the
         // file. Some systems will error closing the file if any file handles are still open.
-        _current.reset();
-        _heap.clear();
+        _streams.clear();
         DESTRUCTOR_GUARD(boost::filesystem::remove(_itersSourceFileName));
     }
 
@@ -415,7 +418,7 @@ public:
     void closeSource() {}
 
     bool more() {
-        if (_remaining > 0 && (_first || !_heap.empty() || _current->more()))
+        if (_remaining > 0 && (_first || _numActiveStreams > 1 || winner()->more()))
             return true;
 
         _remaining = 0;
@@ -429,21 +432,26 @@ public:
 
         if (_first) {
             _first = false;
-            return _current->current();
+            return winner()->current();
+        }
+
+        size_t index = _tree[0];
+        if (!_streams[index]->advance()) {
+            verify(_numActiveStreams > 1);
+            // Closes the input source. An exhausted stream loses every comparison from now on.
+            _streams[index].reset();
+            _numActiveStreams--;
         }
 
-        if (!_current->advance()) {
-            verify(!_heap.empty());
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            _current = _heap.back();
-            _heap.pop_back();
-        } else if (!_heap.empty() && _greater(_current, _heap.front())) {
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            std::swap(_current, _heap.back());
-            std::push_heap(_heap.begin(), _heap.end(), _greater);
+        // Replay the matches on the path from the advanced stream's leaf to the root.
+        for (size_t node = (index + _streams.size()) / 2; node > 0; node /= 2) {
+            if (beats(_tree[node], index)) {
+                std::swap(_tree[node], index);
+            }
         }
+        _tree[0] = index;
 
-        return _current->current();
+        return winner()->current();
     }
 
 
@@ -485,7 +493,7 @@ private:
         std::shared_ptr<Input> _rest;
     };
 
-    class STLComparator {  // uses greater rather than less-than to maintain a MinHeap
+    class STLComparator {  // uses greater rather than less-than
     public:
         explicit STLComparator(const Comparator& comp) : _comp(comp) {}
         bool operator()(unowned_ptr<const Stream> lhs, unowned_ptr<const Stream> rhs) const {
@@ -503,12 +511,48 @@ private:
         const Comparator _comp;
     };
 
+    Stream* winner() const {
+        return _streams[_tree[0]].get();
+    }
+
+    /**
+     * Returns true if the stream at index 'lhs' comes before the stream at index 'rhs'. Exhausted
+     * streams come after all others.
+     */
+    bool beats(size_t lhs, size_t rhs) const {
+        if (!_streams[lhs] || !_streams[rhs])
+            return !_streams[rhs];
+        return _greater(_streams[rhs].get(), _streams[lhs].get());
+    }
+
+    /**
+     * Plays the matches in the subtree rooted at 'node', records the loser of each match in that
+     * subtree, and returns the index of the winning stream. Node n has children 2n and 2n + 1, and
+     * node _streams.size() + i is the leaf for stream i.
+     */
+    size_t buildTree(size_t node) {
+        if (node >= _streams.size())
+            return node - _streams.size();
+
+        size_t lhs = buildTree(2 * node);
+        size_t rhs = buildTree(2 * node + 1);
+        if (beats(lhs, rhs)) {
+            _tree[node] = rhs;
+            return lhs;
+        }
+        _tree[node] = lhs;
+        return rhs;
+    }
+
     SortOptions _opts;
     unsigned long long _remaining;
     bool _first;
-    std::shared_ptr<Stream> _current;
-    std::vector<std::shared_ptr<Stream>> _heap;  // MinHeap
-    STLComparator _greater;                      // named so calls make sense
+    std::vector<std::unique_ptr<Stream>> _streams;  // Exhausted streams are reset to null.
+    size_t _numActiveStreams = 0;
+    // _tree[0] is the index of the stream holding the smallest element, and _tree[n] for n > 0 is
+    // the index of the stream that lost the match at internal node n.
+    std::vector<size_t> _tree;
+    STLComparator _greater;  // named so calls make sense
     std::string _itersSourceFileName;
 };
 
@@ -997,7 +1041,8 @@ void SortedFileWriter<Key, Value>::addAlreadySorted(const Key& key, const Value&
 
 template <typename Key, typename Value>
 void SortedFileWriter<Key, Value>::spill() {
-    int32_t size = _buffer.len();
+    const int32_t uncompressedSize = _buffer.len();
+    int32_t size = uncompressedSize;
     char* outBuffer = _buffer.buf();
 
     if (size == 0)
@@ -1041,6 +1086,7 @@ void SortedFileWriter<Key, Value>::spill() {
                     str::stream() << "error writing to file \"" << _fileName
                                   << "\": " << sorter::myErrnoWithDescription());
     }
+    sorter::recordSpilledBlock(uncompressedSize, sizeof(size) + std::abs(size));
 
     _buffer.reset();
 }
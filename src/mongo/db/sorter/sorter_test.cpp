@@ -288,9 +288,17 @@ public:
             sorter.addAlreadySorted(2, -2);
             sorter.addAlreadySorted(3, -3);
             sorter.addAlreadySorted(4, -4);
+            const auto statsBefore = getSpillStats();
             ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter.done()),
                                         make_shared<IntIterator>(0, 5));
 
+            const auto statsAfter = getSpillStats();
+            ASSERT_EQ(statsBefore.blocks + 1, statsAfter.blocks);
+            ASSERT_EQ(statsBefore.bytesBeforeCompression + 5 * 2 * int(sizeof(int)),
+                      statsAfter.bytesBeforeCompression);
+            ASSERT_EQ(static_cast<long long>(boost::filesystem::file_size(fileName)),
+                      statsAfter.bytesWritten - statsBefore.bytesWritten);
+
             ASSERT_TRUE(boost::filesystem::remove(fileName));
         }
         {  // big
@@ -352,6 +360,29 @@ public:
             ASSERT_ITERATORS_EQUIVALENT(mergeIterators(iterators, DESC),
                                         make_shared<IntIterator>(30, 0, -1));
         }
+        {  // test sources that run out at different times in a tree that is not a full power of 2
+            std::shared_ptr<IWIterator> iterators[] = {
+                make_shared<IntIterator>(0, 50, 5)  // 0, 5, ... 45
+                ,
+                make_shared<EmptyIterator>(),
+                make_shared<IntIterator>(1, 30, 5)  // 1, 6, ... 26
+                ,
+                make_shared<IntIterator>(2, 50, 5)  // 2, 7, ... 47
+                ,
+                make_shared<IntIterator>(3, 10, 5)  // 3, 8
+                ,
+                make_shared<IntIterator>(4, 50, 5)  // 4, 9, ... 49
+                ,
+                make_shared<IntIterator>(31, 50, 5)  // 31, 36, ... 46
+                ,
+                make_shared<IntIterator>(13, 30, 5)  // 13, 18, ... 28
+                ,
+                make_shared<IntIterator>(33, 50, 5)  // 33, 38, ... 48
+            };
+
+            ASSERT_ITERATORS_EQUIVALENT(mergeIterators(iterators, ASC),
+                                        make_shared<IntIterator>(0, 50, 1));
+        }
         {  // test Limit
             std::shared_ptr<IWIterator> iterators[] = {
                 make_shared<IntIterator>(1, 20, 2)  // 1, 3, ... 19
@@ -66,9 +66,9 @@ void OpCounters::gotOp(int op, bool isCommand) {
     }
 }
 
-void OpCounters::_checkWrap(CacheAligned<AtomicWord<long long>> OpCounters::*counter, int n) {
+void OpCounters::_checkWrap(ShardedCounter OpCounters::*counter, int n) {
     static constexpr auto maxCount = 1LL << 60;
-    auto oldValue = (this->*counter).fetchAndAddRelaxed(n);
+    auto oldValue = (this->*counter).fetchAndAdd(n);
     if (oldValue > maxCount) {
         _insert.store(0);
         _query.store(0);
@@ -81,78 +81,50 @@ void OpCounters::_checkWrap(CacheAligned<AtomicWord<long long>> OpCounters::*cou
 
 BSONObj OpCounters::getObj() const {
     BSONObjBuilder b;
-    b.append("insert", _insert.loadRelaxed());
-    b.append("query", _query.loadRelaxed());
-    b.append("update", _update.loadRelaxed());
-    b.append("delete", _delete.loadRelaxed());
-    b.append("getmore", _getmore.loadRelaxed());
-    b.append("command", _command.loadRelaxed());
+    b.append("insert", _insert.load());
+    b.append("query", _query.load());
+    b.append("update", _update.load());
+    b.append("delete", _delete.load());
+    b.append("getmore", _getmore.load());
+    b.append("command", _command.load());
     return b.obj();
 }
 
-void NetworkCounter::hitPhysicalIn(long long bytes) {
+void NetworkCounter::_hit(ShardedCounter* counter, long long bytes) {
     static const int64_t MAX = 1ULL << 60;
 
     // don't care about the race as its just a counter
-    const bool overflow = _physicalBytesIn.loadRelaxed() > MAX;
-
-    if (overflow) {
-        _physicalBytesIn.store(bytes);
-    } else {
-        _physicalBytesIn.fetchAndAdd(bytes);
+    if (counter->fetchAndAdd(bytes) > MAX) {
+        counter->store(bytes);
     }
 }
 
-void NetworkCounter::hitPhysicalOut(long long bytes) {
-    static const int64_t MAX = 1ULL << 60;
-
-    // don't care about the race as its just a counter
-    const bool overflow = _physicalBytesOut.loadRelaxed() > MAX;
+void NetworkCounter::hitPhysicalIn(long long bytes) {
+    _hit(&_physicalBytesIn, bytes);
+}
 
-    if (overflow) {
-        _physicalBytesOut.store(bytes);
-    } else {
-        _physicalBytesOut.fetchAndAdd(bytes);
-    }
+void NetworkCounter::hitPhysicalOut(long long bytes) {
+    _hit(&_physicalBytesOut, bytes);
 }
 
 void NetworkCounter::hitLogicalIn(long long bytes) {
-    static const int64_t MAX = 1ULL << 60;
-
-    // don't care about the race as its just a counter
-    const bool overflow = _together.logicalBytesIn.loadRelaxed() > MAX;
-
-    if (overflow) {
-        _together.logicalBytesIn.store(bytes);
-        // The requests field only gets incremented here (and not in hitPhysical) because the
-        // hitLogical and hitPhysical are each called for each operation. Incrementing it in both
-        // functions would double-count the number of operations.
-        _together.requests.store(1);
-    } else {
-        _together.logicalBytesIn.fetchAndAdd(bytes);
-        _together.requests.fetchAndAdd(1);
-    }
+    _hit(&_logicalBytesIn, bytes);
+    // The requests field only gets incremented here (and not in hitPhysical) because the
+    // hitLogical and hitPhysical are each called for each operation. Incrementing it in both
+    // functions would double-count the number of operations.
+    _hit(&_requests, 1);
 }
 
 void NetworkCounter::hitLogicalOut(long long bytes) {
-    static const int64_t MAX = 1ULL << 60;
-
-    // don't care about the race as its just a counter
-    const bool overflow = _logicalBytesOut.loadRelaxed() > MAX;
-
-    if (overflow) {
-        _logicalBytesOut.store(bytes);
-    } else {
-        _logicalBytesOut.fetchAndAdd(bytes);
-    }
+    _hit(&_logicalBytesOut, bytes);
 }
 
 void NetworkCounter::append(BSONObjBuilder& b) {
-    b.append("bytesIn", static_cast<long long>(_together.logicalBytesIn.loadRelaxed()));
-    b.append("bytesOut", static_cast<long long>(_logicalBytesOut.loadRelaxed()));
-    b.append("physicalBytesIn", static_cast<long long>(_physicalBytesIn.loadRelaxed()));
-    b.append("physicalBytesOut", static_cast<long long>(_physicalBytesOut.loadRelaxed()));
-    b.append("numRequests", static_cast<long long>(_together.requests.loadRelaxed()));
+    b.append("bytesIn", _logicalBytesIn.load());
+    b.append("bytesOut", _logicalBytesOut.load());
+    b.append("physicalBytesIn", _physicalBytesIn.load());
+    b.append("physicalBytesOut", _physicalBytesOut.load());
+    b.append("numRequests", _requests.load());
 }
 
 
@@ -33,6 +33,7 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/basic.h"
 #include "mongo/rpc/message.h"
+#include "mongo/util/concurrency/sharded_counter.h"
 #include "mongo/util/concurrency/spin_lock.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/with_alignment.h"
@@ -41,7 +42,9 @@ namespace mongo {
 
 /**
  * for storing operation counters
- * note: not thread safe.  ok with that for speed
+ *
+ * Each counter is a ShardedCounter, so concurrent operations on different cores do not contend
+ * on the same cache line. Values are only summed up when they are read.
  */
 class OpCounters {
 public:
@@ -74,35 +77,35 @@ public:
     BSONObj getObj() const;
 
     // thse are used by snmp, and other things, do not remove
-    const AtomicWord<long long>* getInsert() const {
+    const ShardedCounter* getInsert() const {
         return &_insert;
     }
-    const AtomicWord<long long>* getQuery() const {
+    const ShardedCounter* getQuery() const {
         return &_query;
     }
-    const AtomicWord<long long>* getUpdate() const {
+    const ShardedCounter* getUpdate() const {
         return &_update;
     }
-    const AtomicWord<long long>* getDelete() const {
+    const ShardedCounter* getDelete() const {
         return &_delete;
     }
-    const AtomicWord<long long>* getGetMore() const {
+    const ShardedCounter* getGetMore() const {
         return &_getmore;
     }
-    const AtomicWord<long long>* getCommand() const {
+    const ShardedCounter* getCommand() const {
         return &_command;
     }
 
 private:
     // Increment member `counter` by `n`, resetting all counters if it was > 2^60.
-    void _checkWrap(CacheAligned<AtomicWord<long long>> OpCounters::*counter, int n);
-
-    CacheAligned<AtomicWord<long long>> _insert;
-    CacheAligned<AtomicWord<long long>> _query;
-    CacheAligned<AtomicWord<long long>> _update;
-    CacheAligned<AtomicWord<long long>> _delete;
-    CacheAligned<AtomicWord<long long>> _getmore;
-    CacheAligned<AtomicWord<long long>> _command;
+    void _checkWrap(ShardedCounter OpCounters::*counter, int n);
+
+    ShardedCounter _insert;
+    ShardedCounter _query;
+    ShardedCounter _update;
+    ShardedCounter _delete;
+    ShardedCounter _getmore;
+    ShardedCounter _command;
 };
 
 extern OpCounters globalOpCounters;
@@ -122,20 +125,15 @@ public:
     void append(BSONObjBuilder& b);
 
 private:
-    CacheAligned<AtomicWord<long long>> _physicalBytesIn{0};
-    CacheAligned<AtomicWord<long long>> _physicalBytesOut{0};
-
-    // These two counters are always incremented at the same time, so
-    // we place them on the same cache line.
-    struct Together {
-        AtomicWord<long long> logicalBytesIn{0};
-        AtomicWord<long long> requests{0};
-    };
-    CacheAligned<Together> _together{};
-    static_assert(sizeof(decltype(_together)) <= stdx::hardware_constructive_interference_size,
-                  "cache line spill");
-
-    CacheAligned<AtomicWord<long long>> _logicalBytesOut{0};
+    // Adds 'bytes' to 'counter', restarting it from 'bytes' if the calling thread's shard has
+    // grown past 2^60.
+    static void _hit(ShardedCounter* counter, long long bytes);
+
+    ShardedCounter _physicalBytesIn;
+    ShardedCounter _physicalBytesOut;
+    ShardedCounter _logicalBytesIn;
+    ShardedCounter _requests;
+    ShardedCounter _logicalBytesOut;
 };
 
 extern NetworkCounter networkCounter;
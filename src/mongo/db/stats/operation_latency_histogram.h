@@ -40,7 +40,8 @@ class BSONObjBuilder;
  * Stores statistics for latencies of read, write, command, and multi-document transaction
  * operations.
  *
- * Note: This class is not thread-safe.
+ * Note: This class is not thread-safe. Callers that record from many threads keep one histogram
+ * per ShardedCounter shard and combine them with merge() when reporting.
  */
 class OperationLatencyHistogram {
 public:
@@ -54,6 +55,11 @@ public:
      */
     void increment(uint64_t latency, Command::ReadWriteType type);
 
+    /**
+     * Adds the bucket counts, latency totals and operation counts of 'other' to this histogram.
+     */
+    void merge(const OperationLatencyHistogram& other);
+
     /**
      * Appends the four histograms with latency totals and operation counts.
      */
@@ -77,6 +83,8 @@ private:
 
     void _incrementData(uint64_t latency, int bucket, HistogramData* data);
 
+    static void _mergeData(const HistogramData& other, HistogramData* data);
+
     HistogramData _reads, _writes, _commands, _transactions;
 };
 }  // namespace mongo
@@ -92,4 +92,22 @@ TEST(OperationLatencyHistogram, CheckBucketCountsAndTotalLatency) {
         ASSERT_EQUALS(bucket["count"].Long(), (i < kMaxBuckets - 1) ? 3 : 2);
     }
 }
+TEST(OperationLatencyHistogram, MergeAddsUpBothHistograms) {
+    OperationLatencyHistogram first, second;
+    first.increment(10, Command::ReadWriteType::kRead);
+    second.increment(20, Command::ReadWriteType::kRead);
+    second.increment(30, Command::ReadWriteType::kWrite);
+
+    first.merge(second);
+    BSONObjBuilder outBuilder;
+    first.append(true, &outBuilder);
+    BSONObj out = outBuilder.done();
+    ASSERT_EQUALS(out["reads"]["ops"].Long(), 2);
+    ASSERT_EQUALS(out["reads"]["latency"].Long(), 30);
+    ASSERT_EQUALS(out["reads"]["histogram"].Array().size(), 2U);
+    ASSERT_EQUALS(out["writes"]["ops"].Long(), 1);
+    ASSERT_EQUALS(out["writes"]["latency"].Long(), 30);
+    ASSERT_EQUALS(out["commands"]["ops"].Long(), 0);
+}
+
 }  // namespace mongo
@@ -0,0 +1,136 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_stats_store.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getQueryStatsStore = ServiceContext::declareDecoration<QueryStatsStore>();
+
+}  // namespace
+
+QueryStatsStore& QueryStatsStore::get(ServiceContext* service) {
+    return getQueryStatsStore(service);
+}
+
+void QueryStatsStore::record(const NamespaceString& nss,
+                             uint32_t queryHash,
+                             const Execution& execution) {
+    const size_t maxSize = internalQueryStatsStoreSize.load();
+    if (maxSize == 0) {
+        return;
+    }
+
+    const auto now = Date_t::now();
+    Key key{nss.ns(), queryHash};
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _index.find(key);
+    if (it == _index.end()) {
+        while (_entries.size() >= maxSize) {
+            const auto& oldest = _entries.back();
+            _index.erase(Key{oldest.nss.ns(), oldest.queryHash});
+            _entries.pop_back();
+        }
+
+        _entries.emplace_front();
+        _entries.front().nss = nss;
+        _entries.front().queryHash = queryHash;
+        _entries.front().firstSeen = now;
+        it = _index.emplace(std::move(key), _entries.begin()).first;
+    } else {
+        _entries.splice(_entries.begin(), _entries, it->second);
+    }
+
+    auto& entry = *it->second;
+    entry.lastSeen = now;
+    entry.execCount++;
+    entry.totalExecMicros += execution.latencyMicros;
+    entry.keysExamined += execution.keysExamined;
+    entry.docsExamined += execution.docsExamined;
+    entry.nreturned += execution.nreturned;
+    entry.bytesReturned += execution.bytesReturned;
+    if (execution.usedDisk) {
+        entry.spills++;
+    }
+    entry.latencyHistogram.increment(execution.latencyMicros, execution.readWriteType);
+}
+
+std::vector<BSONObj> QueryStatsStore::getStats() const {
+    std::vector<BSONObj> stats;
+    stdx::lock_guard<Latch> lk(_mutex);
+    stats.reserve(_entries.size());
+    for (const auto& entry : _entries) {
+        BSONObjBuilder builder;
+        entry.toBSON(&builder);
+        stats.push_back(builder.obj());
+    }
+    return stats;
+}
+
+size_t QueryStatsStore::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+void QueryStatsStore::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _index.clear();
+    _entries.clear();
+}
+
+void QueryStatsStore::Entry::toBSON(BSONObjBuilder* builder) const {
+    builder->append("ns", nss.ns());
+    builder->append("queryHash", unsignedIntToFixedLengthHex(queryHash));
+    builder->append("firstSeen", firstSeen);
+    builder->append("lastSeen", lastSeen);
+    builder->append("execCount", execCount);
+    builder->append("totalExecMicros", totalExecMicros);
+    builder->append("keysExamined", keysExamined);
+    builder->append("docsExamined", docsExamined);
+    builder->append("nreturned", nreturned);
+    builder->append("bytesReturned", bytesReturned);
+    builder->append("spills", spills);
+
+    BSONObjBuilder latencyBuilder(builder->subobjStart("latencyStats"));
+    latencyHistogram.append(true, &latencyBuilder);
+    latencyBuilder.doneFast();
+}
+
+}  // namespace mongo
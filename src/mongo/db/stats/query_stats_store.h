@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/db/commands.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/stats/operation_latency_histogram.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * Accumulates execution statistics per query shape, identified by the namespace and the queryHash
+ * of the query's plan cache key. Unlike the profiler and the slow query log, every operation with
+ * a query shape is counted, so the shapes that are expensive in aggregate can be found even when
+ * no single execution is slow.
+ *
+ * Holds up to 'internalQueryStatsStoreSize' shapes, evicting the least recently executed shape
+ * when full. A size of 0 disables the store.
+ */
+class QueryStatsStore {
+    QueryStatsStore(const QueryStatsStore&) = delete;
+    QueryStatsStore& operator=(const QueryStatsStore&) = delete;
+
+public:
+    QueryStatsStore() = default;
+
+    static QueryStatsStore& get(ServiceContext* service);
+
+    /**
+     * The metrics of a single completed operation.
+     */
+    struct Execution {
+        long long latencyMicros = 0;
+        Command::ReadWriteType readWriteType = Command::ReadWriteType::kRead;
+        long long keysExamined = 0;
+        long long docsExamined = 0;
+        long long nreturned = 0;
+        long long bytesReturned = 0;
+        bool usedDisk = false;
+    };
+
+    /**
+     * Adds 'execution' to the statistics of the query shape 'queryHash' on 'nss', creating the
+     * entry if this is the first execution seen for the shape.
+     */
+    void record(const NamespaceString& nss, uint32_t queryHash, const Execution& execution);
+
+    /**
+     * Returns one document per query shape, most recently executed first.
+     */
+    std::vector<BSONObj> getStats() const;
+
+    size_t size() const;
+
+    void clear();
+
+private:
+    struct Entry {
+        void toBSON(BSONObjBuilder* builder) const;
+
+        NamespaceString nss;
+        uint32_t queryHash;
+
+        Date_t firstSeen;
+        Date_t lastSeen;
+
+        long long execCount = 0;
+        long long totalExecMicros = 0;
+        long long keysExamined = 0;
+        long long docsExamined = 0;
+        long long nreturned = 0;
+        long long bytesReturned = 0;
+
+        // Number of executions that spilled to disk.
+        long long spills = 0;
+
+        OperationLatencyHistogram latencyHistogram;
+    };
+
+    using Key = std::pair<std::string, uint32_t>;
+
+    struct KeyHasher {
+        std::size_t operator()(const Key& key) const {
+            return std::hash<std::string>{}(key.first) ^ key.second;
+        }
+    };
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("QueryStatsStore::_mutex");
+
+    // Ordered from the most to the least recently executed shape.
+    std::list<Entry> _entries;
+    stdx::unordered_map<Key, std::list<Entry>::iterator, KeyHasher> _index;
+};
+
+}  // namespace mongo
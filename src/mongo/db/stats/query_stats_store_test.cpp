@@ -0,0 +1,114 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_stats_store.h"
+
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/hex.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+
+QueryStatsStore::Execution makeExecution(long long latencyMicros, bool usedDisk = false) {
+    QueryStatsStore::Execution execution;
+    execution.latencyMicros = latencyMicros;
+    execution.keysExamined = 10;
+    execution.docsExamined = 5;
+    execution.nreturned = 2;
+    execution.bytesReturned = 100;
+    execution.usedDisk = usedDisk;
+    return execution;
+}
+
+TEST(QueryStatsStoreTest, AccumulatesExecutionsOfTheSameShape) {
+    QueryStatsStore store;
+    store.record(kNss, 1, makeExecution(30));
+    store.record(kNss, 1, makeExecution(50, true));
+
+    auto stats = store.getStats();
+    ASSERT_EQ(1U, stats.size());
+    ASSERT_EQ("test.coll", stats[0]["ns"].String());
+    ASSERT_EQ(2, stats[0]["execCount"].numberLong());
+    ASSERT_EQ(80, stats[0]["totalExecMicros"].numberLong());
+    ASSERT_EQ(20, stats[0]["keysExamined"].numberLong());
+    ASSERT_EQ(10, stats[0]["docsExamined"].numberLong());
+    ASSERT_EQ(4, stats[0]["nreturned"].numberLong());
+    ASSERT_EQ(200, stats[0]["bytesReturned"].numberLong());
+    ASSERT_EQ(1, stats[0]["spills"].numberLong());
+    ASSERT_EQ(2, stats[0]["latencyStats"]["reads"]["ops"].numberLong());
+}
+
+TEST(QueryStatsStoreTest, SeparatesShapesAndNamespaces) {
+    QueryStatsStore store;
+    store.record(kNss, 1, makeExecution(10));
+    store.record(kNss, 2, makeExecution(10));
+    store.record(NamespaceString("test.other"), 1, makeExecution(10));
+    ASSERT_EQ(3U, store.size());
+
+    store.clear();
+    ASSERT_EQ(0U, store.size());
+}
+
+TEST(QueryStatsStoreTest, EvictsLeastRecentlyExecutedShape) {
+    const auto originalSize = internalQueryStatsStoreSize.load();
+    ON_BLOCK_EXIT([&] { internalQueryStatsStoreSize.store(originalSize); });
+    internalQueryStatsStoreSize.store(2);
+
+    QueryStatsStore store;
+    store.record(kNss, 1, makeExecution(10));
+    store.record(kNss, 2, makeExecution(10));
+    // Executing shape 1 again makes shape 2 the least recently executed.
+    store.record(kNss, 1, makeExecution(10));
+    store.record(kNss, 3, makeExecution(10));
+
+    auto stats = store.getStats();
+    ASSERT_EQ(2U, stats.size());
+    ASSERT_EQ(unsignedIntToFixedLengthHex(3), stats[0]["queryHash"].String());
+    ASSERT_EQ(unsignedIntToFixedLengthHex(1), stats[1]["queryHash"].String());
+}
+
+TEST(QueryStatsStoreTest, SizeZeroDisablesTheStore) {
+    const auto originalSize = internalQueryStatsStoreSize.load();
+    ON_BLOCK_EXIT([&] { internalQueryStatsStoreSize.store(originalSize); });
+    internalQueryStatsStoreSize.store(0);
+
+    QueryStatsStore store;
+    store.record(kNss, 1, makeExecution(10));
+    ASSERT_EQ(0U, store.size());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -144,4 +144,36 @@ Status appendCollectionRecordCount(OperationContext* opCtx,
 
     return Status::OK();
 }
+
+Status appendCollectionCacheStats(OperationContext* opCtx,
+                                  const NamespaceString& nss,
+                                  BSONObjBuilder* result) {
+    AutoGetCollectionForReadCommand ctx(opCtx, nss);
+    if (!ctx.getDb()) {
+        return {ErrorCodes::NamespaceNotFound,
+                str::stream() << "Database [" << nss.db().toString() << "] not found."};
+    }
+
+    Collection* collection = ctx.getCollection();
+    if (!collection) {
+        return {ErrorCodes::NamespaceNotFound,
+                str::stream() << "Collection [" << nss.toString() << "] not found."};
+    }
+
+    collection->getRecordStore()->appendCacheStats(opCtx, result, 1);
+
+    BSONObjBuilder indexes(result->subobjStart("indexes"));
+    std::unique_ptr<IndexCatalog::IndexIterator> it =
+        collection->getIndexCatalog()->getIndexIterator(opCtx, /*includeUnfinishedIndexes=*/true);
+    while (it->more()) {
+        const IndexCatalogEntry* entry = it->next();
+        BSONObjBuilder bob;
+        if (entry->accessMethod()->appendCacheStats(opCtx, &bob, 1)) {
+            indexes.append(entry->descriptor()->indexName(), bob.obj());
+        }
+    }
+    indexes.doneFast();
+
+    return Status::OK();
+}
 }  // namespace mongo
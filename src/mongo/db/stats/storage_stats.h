@@ -60,4 +60,13 @@ Status appendCollectionRecordCount(OperationContext* opCtx,
                                    const NamespaceString& nss,
                                    BSONObjBuilder* builder);
 
+/**
+ * Appends to 'builder' a summary of how much of the collection represented by 'nss' and of each of
+ * its indexes is resident in the storage engine's cache. Storage engines which do not track this
+ * append nothing.
+ */
+Status appendCollectionCacheStats(OperationContext* opCtx,
+                                  const NamespaceString& nss,
+                                  BSONObjBuilder* builder);
+
 };  // namespace mongo
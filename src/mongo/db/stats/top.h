@@ -33,12 +33,15 @@
  * DB usage monitor.
  */
 
+#include <array>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 #include "mongo/db/commands.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/stats/operation_latency_histogram.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/concurrency/sharded_counter.h"
 #include "mongo/util/string_map.h"
 
 namespace mongo {
@@ -47,6 +50,10 @@ class ServiceContext;
 
 /**
  * tracks usage by collection
+ *
+ * Usage is recorded into one of ShardedCounter::kNumShards independently locked shards, chosen by
+ * the recording thread, so that operations running on different cores do not serialize on a
+ * single mutex. The shards are combined when the statistics are read.
  */
 class Top {
 public:
@@ -64,6 +71,11 @@ public:
             count++;
             time += micros;
         }
+
+        void merge(const UsageData& other) {
+            count += other.count;
+            time += other.time;
+        }
     };
 
     struct CollectionData {
@@ -73,6 +85,11 @@ public:
         CollectionData() {}
         CollectionData(const CollectionData& older, const CollectionData& newer);
 
+        /**
+         * Adds the usage recorded in 'other' to this entry.
+         */
+        void merge(const CollectionData& other);
+
         UsageData total;
 
         UsageData readLock;
@@ -135,6 +152,16 @@ public:
     void appendGlobalLatencyStats(bool includeHistograms, BSONObjBuilder* builder);
 
 private:
+    struct Shard {
+        SimpleMutex lock;
+        OperationLatencyHistogram globalHistogramStats;
+        UsageMap usage;
+    };
+
+    Shard& _shardForCurrentThread() {
+        return _shards[ShardedCounter::shardForCurrentThread()];
+    }
+
     void _appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const;
 
     void _appendStatsEntry(BSONObjBuilder& b, const char* statsName, const UsageData& map) const;
@@ -151,10 +178,12 @@ private:
                              OperationLatencyHistogram* histogram,
                              Command::ReadWriteType readWriteType);
 
-    mutable SimpleMutex _lock;
-    OperationLatencyHistogram _globalHistogramStats;
-    UsageMap _usage;
+    mutable std::array<CacheAligned<Shard>, ShardedCounter::kNumShards> _shards;
+
+    // Guards _collDropNs. _numCollDropNs lets record() skip taking it while no drop is pending.
+    SimpleMutex _collDropLock;
     std::set<std::string> _collDropNs;
+    AtomicWord<size_t> _numCollDropNs{0};
 };
 
 }  // namespace mongo
@@ -40,4 +40,26 @@ TEST(TopTest, CollectionDropped) {
     Top().collectionDropped(NamespaceString("test.coll"));
 }
 
+TEST(TopTest, MergeCollectionData) {
+    Top::CollectionData first, second;
+    first.total.inc(10);
+    first.queries.inc(10);
+    second.total.inc(5);
+    second.insert.inc(5);
+
+    first.merge(second);
+    ASSERT_EQ(2, first.total.count);
+    ASSERT_EQ(15, first.total.time);
+    ASSERT_EQ(1, first.queries.count);
+    ASSERT_EQ(1, first.insert.count);
+    ASSERT_EQ(5, first.insert.time);
+}
+
+TEST(TopTest, CloneMapOfEmptyTop) {
+    Top top;
+    Top::UsageMap usage;
+    top.cloneMap(usage);
+    ASSERT(usage.empty());
+}
+
 }  // namespace
@@ -35,9 +35,11 @@
 
 #include <memory>
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/snapshot_window_options.h"
 #include "mongo/db/storage/biggie/biggie_recovery_unit.h"
+#include "mongo/db/storage/biggie/biggie_server_parameters_gen.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/sorted_data_interface.h"
@@ -100,9 +102,38 @@ bool KVEngine::trySwapMaster(StringStore& newMaster, uint64_t version) {
         return false;
     _master = newMaster;
     _masterVersion++;
+    _masterDataSize.store(_master.dataSize());
     return true;
 }
 
+bool KVEngine::isDataSizeLimitReached() const {
+    const long long maxDataSize = gBiggieMaxDataSizeBytes.load();
+    return maxDataSize > 0 && _masterDataSize.load() >= maxDataSize;
+}
+
+void KVEngine::recordCommit(int retries) {
+    _commits.fetchAndAdd(1);
+    _commitRetries.fetchAndAdd(retries);
+}
+
+void KVEngine::recordWriteConflict() {
+    _commitWriteConflicts.fetchAndAdd(1);
+}
+
+void KVEngine::appendStats(BSONObjBuilder* builder) const {
+    {
+        stdx::lock_guard<Latch> lock(_masterLock);
+        builder->appendNumber("entries", static_cast<long long>(_master.size()));
+        builder->appendNumber("dataSize", static_cast<long long>(_master.dataSize()));
+    }
+    builder->append("maxDataSize", gBiggieMaxDataSizeBytes.load());
+
+    BSONObjBuilder commitsBuilder(builder->subobjStart("commits"));
+    commitsBuilder.append("total", _commits.load());
+    commitsBuilder.append("mergeRetries", _commitRetries.load());
+    commitsBuilder.append("writeConflicts", _commitWriteConflicts.load());
+}
+
 
 Status KVEngine::createSortedDataInterface(OperationContext* opCtx,
                                            const CollectionOptions& collOptions,
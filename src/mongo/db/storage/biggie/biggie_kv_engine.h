@@ -37,6 +37,7 @@
 #include "mongo/db/storage/biggie/biggie_sorted_impl.h"
 #include "mongo/db/storage/biggie/store.h"
 #include "mongo/db/storage/kv/kv_engine.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 namespace biggie {
@@ -164,6 +165,24 @@ public:
      */
     bool trySwapMaster(StringStore& newMaster, uint64_t version);
 
+    /**
+     * Returns true if 'biggieMaxDataSizeBytes' is set and the data in the master tree has reached
+     * it.
+     */
+    bool isDataSizeLimitReached() const;
+
+    /**
+     * Records the outcome of merging a unit of work into the master tree. 'retries' is the number
+     * of times the merge was redone because another commit swapped the master first.
+     */
+    void recordCommit(int retries);
+    void recordWriteConflict();
+
+    /**
+     * Appends the engine's size and commit statistics for serverStatus.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
     std::shared_ptr<void> _catalogInfo;
     int _cachePressureForTest = 0;
@@ -173,6 +192,12 @@ private:
     mutable Mutex _masterLock = MONGO_MAKE_LATCH("KVEngine::_masterLock");
     StringStore _master;
     uint64_t _masterVersion = 0;
+    // Size of the data in _master, readable without taking _masterLock.
+    AtomicWord<long long> _masterDataSize{0};
+
+    AtomicWord<long long> _commits{0};
+    AtomicWord<long long> _commitRetries{0};
+    AtomicWord<long long> _commitWriteConflicts{0};
 };
 }  // namespace biggie
 }  // namespace mongo
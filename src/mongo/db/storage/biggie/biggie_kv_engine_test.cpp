@@ -34,10 +34,15 @@
 #include <memory>
 
 #include "mongo/base/init.h"
+#include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/operation_context_noop.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/db/storage/biggie/biggie_kv_engine.h"
+#include "mongo/db/storage/biggie/biggie_server_parameters_gen.h"
+#include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace biggie {
@@ -70,5 +75,41 @@ MONGO_INITIALIZER(RegisterKVHarnessFactory)(InitializerContext*) {
     return Status::OK();
 }
 
+TEST(BiggieKVEngineTest, InsertsFailOnceDataSizeLimitIsReached) {
+    BiggieKVHarnessHelper helper;
+    KVEngine* engine = helper.getEngine();
+
+    const long long originalMaxDataSize = gBiggieMaxDataSizeBytes.load();
+    ON_BLOCK_EXIT([&] { gBiggieMaxDataSizeBytes.store(originalMaxDataSize); });
+    gBiggieMaxDataSizeBytes.store(10);
+
+    OperationContextNoop opCtx(engine->newRecoveryUnit());
+    ASSERT_OK(engine->createRecordStore(&opCtx, "a.b", "ident", CollectionOptions()));
+    auto rs = engine->getRecordStore(&opCtx, "a.b", "ident", CollectionOptions());
+
+    const std::string data(10, 'x');
+    {
+        WriteUnitOfWork wuow(&opCtx);
+        ASSERT_OK(rs->insertRecord(&opCtx, data.c_str(), data.size(), Timestamp()).getStatus());
+        wuow.commit();
+    }
+    ASSERT(engine->isDataSizeLimitReached());
+
+    {
+        WriteUnitOfWork wuow(&opCtx);
+        ASSERT_EQ(ErrorCodes::ExceededMemoryLimit,
+                  rs->insertRecord(&opCtx, data.c_str(), data.size(), Timestamp()).getStatus());
+    }
+
+    // Lifting the limit allows inserts again.
+    gBiggieMaxDataSizeBytes.store(0);
+    ASSERT_FALSE(engine->isDataSizeLimitReached());
+    {
+        WriteUnitOfWork wuow(&opCtx);
+        ASSERT_OK(rs->insertRecord(&opCtx, data.c_str(), data.size(), Timestamp()).getStatus());
+        wuow.commit();
+    }
+}
+
 }  // namespace biggie
 }  // namespace mongo
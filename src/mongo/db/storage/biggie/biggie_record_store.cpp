@@ -160,6 +160,11 @@ Status RecordStore::insertRecords(OperationContext* opCtx,
         return Status(ErrorCodes::BadValue, "object to insert exceeds cappedMaxSize");
 
     auto ru = RecoveryUnit::get(opCtx);
+    // Capped collections and the oplog delete as they insert, so they cannot grow without bound.
+    if (!_isCapped && ru->getEngine()->isDataSizeLimitReached())
+        return Status(ErrorCodes::ExceededMemoryLimit,
+                      "biggie storage engine has reached biggieMaxDataSizeBytes");
+
     StringStore* workingCopy(ru->getHead());
     {
         SizeAdjuster adjuster(opCtx, this);
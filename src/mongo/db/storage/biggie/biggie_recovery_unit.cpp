@@ -58,20 +58,24 @@ void RecoveryUnit::doCommitUnitOfWork() {
 
     if (_dirty) {
         invariant(_forked);
+        int retries = 0;
         while (true) {
             std::pair<uint64_t, StringStore> masterInfo = _KVEngine->getMasterInfo();
             try {
                 _workingCopy.merge3(_mergeBase, masterInfo.second);
             } catch (const merge_conflict_exception&) {
+                _KVEngine->recordWriteConflict();
                 throw WriteConflictException();
             }
 
             if (_KVEngine->trySwapMaster(_workingCopy, masterInfo.first)) {
                 // Merged successfully
+                _KVEngine->recordCommit(retries);
                 break;
             } else {
                 // Retry the merge, but update the mergeBase since some progress was made merging.
                 _mergeBase = masterInfo.second;
+                ++retries;
             }
         }
         _forked = false;
@@ -71,6 +71,10 @@ public:
      */
     bool forkIfNeeded();
 
+    KVEngine* getEngine() {
+        return _KVEngine;
+    }
+
     static RecoveryUnit* get(OperationContext* opCtx);
 
 private:
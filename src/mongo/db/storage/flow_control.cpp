@@ -124,11 +124,13 @@ bool sustainerAdvanced(const std::vector<repl::MemberData>& prevMemberData,
 FlowControl::FlowControl(repl::ReplicationCoordinator* replCoord)
     : ServerStatusSection("flowControl"),
       _replCoord(replCoord),
+      _lastPollTime(Date_t::now()),
       _lastTimeSustainerAdvanced(Date_t::now()) {}
 
 FlowControl::FlowControl(ServiceContext* service, repl::ReplicationCoordinator* replCoord)
     : ServerStatusSection("flowControl"),
       _replCoord(replCoord),
+      _lastPollTime(Date_t::now()),
       _lastTimeSustainerAdvanced(Date_t::now()) {
     // Initialize _lastTargetTicketsPermitted to maximum tickets to make sure flow control doesn't
     // cause a slow start on start up.
@@ -199,6 +201,9 @@ BSONObj FlowControl::generateSection(OperationContext* opCtx,
                FlowControlTicketholder::get(opCtx)->totalTimeAcquiringMicros());
     bob.append("locksPerOp", _lastLocksPerOp.load());
     bob.append("sustainerRate", _lastSustainerAppliedCount.load());
+    if (gFlowControlPredictiveMode.load()) {
+        bob.append("predictedSustainerRate", _lastPredictedSustainerRate.load());
+    }
     bob.append("isLagged", _isLagged.load());
     bob.append("isLaggedCount", _isLaggedCount.load());
     bob.append("isLaggedTimeMicros", _isLaggedTimeMicros.load());
@@ -290,6 +295,92 @@ int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>&
     return multiplyWithOverflowCheck(locksPerOp, sustainerAppliedPenalty, _kMaxTickets);
 }
 
+double FlowControl::_updateApplyRates(const std::vector<repl::MemberData>& prevMemberData,
+                                      const std::vector<repl::MemberData>& currMemberData,
+                                      Milliseconds period) {
+    std::map<int, Timestamp> prevApplied;
+    for (auto&& member : prevMemberData) {
+        prevApplied[member.getMemberId().getData()] = member.getLastAppliedOpTime().getTimestamp();
+    }
+
+    // Members that left the replica set are dropped along the way.
+    std::map<int, double> newRates;
+    const double alpha = gFlowControlApplyRateSmoothingFactor.load();
+    for (auto&& member : currMemberData) {
+        const int memberId = member.getMemberId().getData();
+        auto oldRate = _memberApplyRates.find(memberId);
+        const bool hasOldRate = oldRate != _memberApplyRates.end();
+        if (hasOldRate) {
+            newRates[memberId] = oldRate->second;
+        }
+
+        auto prevTs = prevApplied.find(memberId);
+        if (prevTs == prevApplied.end() || period <= Milliseconds(0)) {
+            continue;
+        }
+
+        const auto currTs = member.getLastAppliedOpTime().getTimestamp();
+        if (currTs < prevTs->second) {
+            continue;
+        }
+
+        std::int64_t opsApplied = 0;
+        if (currTs != prevTs->second) {
+            opsApplied = _approximateOpsBetween(prevTs->second, currTs);
+            if (opsApplied == -1) {
+                // Too few operations between the two timestamps to say anything useful.
+                continue;
+            }
+        }
+
+        const double observedRate =
+            1000.0 * static_cast<double>(opsApplied) / durationCount<Milliseconds>(period);
+        newRates[memberId] =
+            hasOldRate ? alpha * observedRate + (1.0 - alpha) * oldRate->second : observedRate;
+    }
+    _memberApplyRates = std::move(newRates);
+
+    if (_memberApplyRates.size() != currMemberData.size() || currMemberData.empty()) {
+        return -1.0;
+    }
+
+    // The majority commit point moves at the pace of the same member `getMedianAppliedTimestamp`
+    // picks, only ordered by apply rate instead of applied optime.
+    std::vector<double> rates;
+    rates.reserve(_memberApplyRates.size());
+    for (auto&& entry : _memberApplyRates) {
+        rates.push_back(entry.second);
+    }
+    std::sort(rates.begin(), rates.end());
+    return rates[rates.size() / 2];
+}
+
+int FlowControl::_calculatePredictiveTickets(double locksPerOp,
+                                             double primaryRate,
+                                             double sustainerRate,
+                                             std::uint64_t lagMillis,
+                                             std::uint64_t thresholdLagMillis,
+                                             Milliseconds period) {
+    if (sustainerRate < 0.0 || primaryRate <= sustainerRate) {
+        // The majority is keeping up with the primary, no reason to expect the lag to grow.
+        return -1;
+    }
+
+    // While the primary outpaces the sustainer, the commit point falls behind by
+    // (1 - sustainerRate / primaryRate) milliseconds for every millisecond that passes.
+    const double projectedLagMillis = static_cast<double>(lagMillis) +
+        durationCount<Milliseconds>(period) * (1.0 - sustainerRate / primaryRate);
+    LOG(DEBUG_LOG_LEVEL) << "Predictive. PrimaryRate: " << primaryRate
+                         << " SustainerRate: " << sustainerRate << " LagMillis: " << lagMillis
+                         << " ProjectedLagMillis: " << projectedLagMillis;
+    if (projectedLagMillis < static_cast<double>(thresholdLagMillis)) {
+        return -1;
+    }
+
+    return multiplyWithOverflowCheck(
+        locksPerOp, sustainerRate * gFlowControlFudgeFactor.load(), _kMaxTickets);
+}
+
 int FlowControl::getNumTickets() {
     // Flow Control is only enabled on nodes that can accept writes.
     const bool canAcceptWrites = _replCoord->canAcceptNonLocalWrites();
@@ -308,6 +399,24 @@ int FlowControl::getNumTickets() {
     const double locksPerOp = _getLocksPerOp();
     const std::int64_t locksUsedLastPeriod = _getLocksUsedLastPeriod();
 
+    const auto now = Date_t::now();
+    const Milliseconds pollPeriod = now - _lastPollTime;
+    _lastPollTime = now;
+    std::uint64_t opsLastPeriod;
+    {
+        stdx::lock_guard<Latch> lk(_sampledOpsMutex);
+        opsLastPeriod = _numOpsSinceStartup - _lastPollOpsSinceStartup;
+        _lastPollOpsSinceStartup = _numOpsSinceStartup;
+    }
+
+    double sustainerRate = -1.0;
+    if (gFlowControlPredictiveMode.load()) {
+        sustainerRate = _updateApplyRates(_prevMemberData, _currMemberData, pollPeriod);
+    } else {
+        _memberApplyRates.clear();
+    }
+    _lastPredictedSustainerRate.store(sustainerRate);
+
     if (serverGlobalParams.enableMajorityReadConcern == false ||
         gFlowControlEnabled.load() == false || canAcceptWrites == false || locksPerOp < 0.0) {
         _trimSamples(std::min(lastCommitted.opTime.getTimestamp(),
@@ -341,6 +450,22 @@ int FlowControl::getNumTickets() {
                                         gFlowControlTicketMultiplierConstant.load(),
                                         _kMaxTickets);
         _lastTimeSustainerAdvanced = Date_t::now();
+
+        if (sustainerRate >= 0.0 && pollPeriod > Milliseconds(0)) {
+            const double primaryRate = 1000.0 * static_cast<double>(opsLastPeriod) /
+                durationCount<Milliseconds>(pollPeriod);
+            const int predictedTickets = _calculatePredictiveTickets(
+                locksPerOp,
+                primaryRate,
+                sustainerRate,
+                getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime),
+                thresholdLagMillis,
+                pollPeriod);
+            if (predictedTickets >= 0) {
+                ret = std::min(ret, predictedTickets);
+            }
+        }
+
         if (_isLagged.load()) {
             _isLagged.store(false);
             auto waitTime = curTimeMicros64() - _startWaitTime;
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <deque>
+#include <map>
 
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/operation_context.h"
@@ -104,6 +105,28 @@ public:
                                    std::uint64_t thresholdLagMillis);
     void _trimSamples(const Timestamp trimSamplesTo);
 
+    /**
+     * Folds the progress each member made between two topology observations taken `period` apart
+     * into a smoothed apply rate, in operations per second, for that member. Returns the smoothed
+     * rate of the member sustaining the majority commit point, or -1.0 if it is not yet known.
+     */
+    double _updateApplyRates(const std::vector<repl::MemberData>& prevMemberData,
+                             const std::vector<repl::MemberData>& currMemberData,
+                             Milliseconds period);
+
+    /**
+     * Used by predictive mode while the commit point lag is still under the threshold. If the
+     * primary accepting writes at `primaryRate` would push the lag past `thresholdLagMillis` within
+     * the next `period`, returns the number of tickets that keeps the primary at the sustainer's
+     * apply rate. Otherwise returns -1.
+     */
+    int _calculatePredictiveTickets(double locksPerOp,
+                                    double primaryRate,
+                                    double sustainerRate,
+                                    std::uint64_t lagMillis,
+                                    std::uint64_t thresholdLagMillis,
+                                    Milliseconds period);
+
     // Sample of (timestamp, ops, lock acquisitions) where ops and lock acquisitions are
     // observations of the corresponding counter at (roughly) <timestamp>.
     typedef std::tuple<std::uint64_t, std::uint64_t, std::int64_t> Sample;
@@ -120,6 +143,7 @@ private:
     AtomicWord<int> _lastTargetTicketsPermitted{_kMaxTickets};
     AtomicWord<double> _lastLocksPerOp{0.0};
     AtomicWord<int> _lastSustainerAppliedCount{0};
+    AtomicWord<double> _lastPredictedSustainerRate{-1.0};
     AtomicWord<bool> _isLagged{false};
     AtomicWord<int> _isLaggedCount{0};
     // Use an int64_t as this is serialized to bson which does not support unsigned 64-bit numbers.
@@ -134,6 +158,11 @@ private:
 
     std::int64_t _lastPollLockAcquisitions = 0;
 
+    // These values are used by predictive mode. Apply rates are keyed by member id.
+    std::map<int, double> _memberApplyRates;
+    std::uint64_t _lastPollOpsSinceStartup = 0;
+    Date_t _lastPollTime;
+
     std::vector<repl::MemberData> _currMemberData;
     std::vector<repl::MemberData> _prevMemberData;
 
@@ -245,4 +245,65 @@ TEST_F(FlowControlTest, CalculatingTickets) {
                                                       currLag,
                                                       thresholdLag));
 }
+TEST_F(FlowControlTest, PredictingSustainerApplyRate) {
+    gFlowControlApplyRateSmoothingFactor.store(0.5);
+
+    auto constructMemberData = [](int memberId, Timestamp ts) -> repl::MemberData {
+        repl::MemberData ret;
+        ret.setMemberId(repl::MemberId(memberId));
+        ret.setLastAppliedOpTimeAndWallTime({{ts, 1}, Date_t()}, Date_t());
+        return ret;
+    };
+
+    // Construct samples where Timestamp X maps to operation number X.
+    for (int ts = 1; ts <= 5000; ++ts) {
+        flowControl->sample(Timestamp(ts), 1);
+    }
+
+    std::vector<repl::MemberData> prevMemberData;
+    prevMemberData.emplace_back(constructMemberData(0, Timestamp(1000)));
+    prevMemberData.emplace_back(constructMemberData(1, Timestamp(1000)));
+    prevMemberData.emplace_back(constructMemberData(2, Timestamp(1000)));
+
+    // The first observation only establishes where each member is.
+    ASSERT_EQ(-1.0, flowControl->_updateApplyRates({}, prevMemberData, Seconds(1)));
+
+    // Over one second, members apply 200, 1000 and 2000 operations. The median member sustains
+    // the majority commit point.
+    std::vector<repl::MemberData> currMemberData;
+    currMemberData.emplace_back(constructMemberData(0, Timestamp(1200)));
+    currMemberData.emplace_back(constructMemberData(1, Timestamp(2000)));
+    currMemberData.emplace_back(constructMemberData(2, Timestamp(3000)));
+    ASSERT_EQ(1000.0, flowControl->_updateApplyRates(prevMemberData, currMemberData, Seconds(1)));
+
+    // A burst where member 1 applies 2000 operations is smoothed against the earlier rate.
+    prevMemberData = currMemberData;
+    currMemberData.clear();
+    currMemberData.emplace_back(constructMemberData(0, Timestamp(1400)));
+    currMemberData.emplace_back(constructMemberData(1, Timestamp(4000)));
+    currMemberData.emplace_back(constructMemberData(2, Timestamp(5000)));
+    ASSERT_EQ(1500.0, flowControl->_updateApplyRates(prevMemberData, currMemberData, Seconds(1)));
+}
+
+TEST_F(FlowControlTest, CalculatingPredictiveTickets) {
+    gFlowControlFudgeFactor.store(0.95);
+    const double locksPerOp = 2.0;
+    const std::uint64_t thresholdLag = 5000;
+
+    // The majority keeps up with the primary.
+    ASSERT_EQ(-1,
+              flowControl->_calculatePredictiveTickets(
+                  locksPerOp, 1000.0, 1000.0, 4900, thresholdLag, Seconds(1)));
+
+    // The primary outpaces the sustainer, but the lag stays under the threshold: 1000ms + 500ms.
+    ASSERT_EQ(-1,
+              flowControl->_calculatePredictiveTickets(
+                  locksPerOp, 2000.0, 1000.0, 1000, thresholdLag, Seconds(1)));
+
+    // The lag is projected to cross the threshold, 4600ms + 500ms. The primary is held to 95% of
+    // the sustainer rate.
+    ASSERT_EQ(1900,
+              flowControl->_calculatePredictiveTickets(
+                  locksPerOp, 2000.0, 1000.0, 4600, thresholdLag, Seconds(1)));
+}
 }  // namespace mongo
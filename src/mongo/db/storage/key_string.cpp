@@ -243,6 +243,16 @@ void memcpy_flipBits(void* dst, const void* src, size_t bytes) {
     const char* input = static_cast<const char*>(src);
     char* output = static_cast<char*>(dst);
     const char* const end = input + bytes;
+
+    // Flip a word at a time and finish the tail a byte at a time.
+    while (static_cast<size_t>(end - input) >= sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, input, sizeof(word));
+        word = ~word;
+        memcpy(output, &word, sizeof(word));
+        input += sizeof(word);
+        output += sizeof(word);
+    }
     while (input != end) {
         *output++ = ~(*input++);
     }
@@ -289,45 +299,61 @@ StringData readCStringWithNuls(BufReader* reader, std::string* scratch) {
     return *scratch;
 }
 
+/**
+ * Advances 'reader' past a string read by readCStringWithNuls() without copying it.
+ */
+void skipCStringWithNuls(BufReader* reader) {
+    (void)readCString(reader);
+    while (reader->peek<unsigned char>() == 0xFF) {
+        reader->skip(1);
+        (void)readCString(reader);
+    }
+}
+
 string readInvertedCString(BufReader* reader) {
     const char* start = static_cast<const char*>(reader->pos());
     const char* end = static_cast<const char*>(memchr(start, 0xFF, reader->remaining()));
     keyStringAssert(50817, "Failed to find '0xFF' in inverted string.", end);
     size_t actualBytes = end - start;
-    string s(start, actualBytes);
-    for (size_t i = 0; i < s.size(); i++) {
-        s[i] = ~s[i];
-    }
+    string s(actualBytes, '\0');
+    memcpy_flipBits(&s[0], start, actualBytes);
     reader->skip(1 + actualBytes);
     return s;
 }
 
-string readInvertedCStringWithNuls(BufReader* reader) {
-    std::string out;
-    bool firstPass = true;
-    do {
-        if (firstPass) {
-            firstPass = false;
-        } else {
-            // If this isn't our first pass through the loop it means we hit an NUL byte
-            // encoded as "\xFF\00" in our inverted string.
-            reader->skip(1);
-            out += '\xFF';  // will be flipped to '\0' with rest of out before returning.
-        }
-
+/**
+ * Appends the string encoded with inverted bits at the position of 'reader' to 'out', flipping the
+ * bits back as it is copied. If 'out' is null, only advances 'reader' past the string.
+ */
+void readInvertedCStringWithNuls(BufReader* reader, std::string* out) {
+    while (true) {
         const char* start = static_cast<const char*>(reader->pos());
         const char* end = static_cast<const char*>(memchr(start, 0xFF, reader->remaining()));
         keyStringAssert(50820, "Failed to find '0xFF' in inverted string.", end);
         size_t actualBytes = end - start;
 
-        out.append(start, actualBytes);
+        if (out) {
+            const size_t outSize = out->size();
+            out->resize(outSize + actualBytes);
+            memcpy_flipBits(&(*out)[outSize], start, actualBytes);
+        }
         reader->skip(1 + actualBytes);
-    } while (reader->peek<unsigned char>() == 0x00);
 
-    for (size_t i = 0; i < out.size(); i++) {
-        out[i] = ~out[i];
+        if (reader->peek<unsigned char>() != 0x00) {
+            return;
+        }
+
+        // A NUL byte in the original string is encoded as "\xFF\x00" in an inverted string.
+        reader->skip(1);
+        if (out) {
+            *out += '\0';
+        }
     }
+}
 
+string readInvertedCStringWithNuls(BufReader* reader) {
+    std::string out;
+    readInvertedCStringWithNuls(reader, &out);
     return out;
 }
 }  // namespace
@@ -1868,10 +1894,9 @@ void filterKeyFromKeyString(uint8_t ctype, BufReader* reader, bool inverted, Ver
         case CType::kStringLike:
         case CType::kCode: {
             if (inverted) {
-                (void)readInvertedCStringWithNuls(reader);
+                readInvertedCStringWithNuls(reader, nullptr);
             } else {
-                std::string scratch;
-                (void)readCStringWithNuls(reader, &scratch);
+                skipCStringWithNuls(reader);
             }
             break;
         }
@@ -366,11 +366,12 @@ public:
     static Value deserialize(BufReader& buf, KeyString::Version version) {
         const int32_t sizeOfKeystring = buf.read<LittleEndian<int32_t>>();
         const void* keystringPtr = buf.skip(sizeOfKeystring);
+        auto typeBits = TypeBits::fromBuffer(version, &buf);  // advances the buf
 
-        BufBuilder newBuf;
+        // Size the buffer exactly, since the Sorter reads back every spilled key through here and
+        // charges the buffer's capacity against its memory limit.
+        BufBuilder newBuf(sizeOfKeystring + (typeBits.isAllZeros() ? 1 : typeBits.getSize()));
         newBuf.appendBuf(keystringPtr, sizeOfKeystring);
-
-        auto typeBits = TypeBits::fromBuffer(version, &buf);  // advances the buf
         if (typeBits.isAllZeros()) {
             newBuf.appendChar(0);
         } else {
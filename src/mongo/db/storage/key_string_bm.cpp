@@ -49,6 +49,7 @@ const int kStrLenMultiplier = 100;
 const int kArrLenMultiplier = 40;
 
 const Ordering ALL_ASCENDING = Ordering::make(BSONObj());
+const Ordering ALL_DESCENDING = Ordering::make(BSON("a" << -1 << "b" << -1 << "c" << -1));
 
 struct BsonsAndKeyStrings {
     int bsonSize = 0;
@@ -66,6 +67,9 @@ enum BsonValueType {
     STRING,
     ARRAY,
     DECIMAL,
+    STRING_WITH_NULS,
+    COMPOUND,
+    TYPEBITS,
 };
 
 BSONObj generateBson(BsonValueType bsonValueType) {
@@ -93,18 +97,54 @@ BSONObj generateBson(BsonValueType bsonValueType) {
                                          Decimal128::kRoundTo34Digits,
                                          Decimal128::kRoundTiesToAway)
                                   .quantize(Decimal128("0.01", Decimal128::kRoundTiesToAway)));
+        case STRING_WITH_NULS: {
+            // Every NUL byte is escaped in the KeyString encoding.
+            std::string str(expDist(gen) * kStrLenMultiplier, 'x');
+            for (size_t i = 0; i < str.size(); i += 10) {
+                str[i] = '\0';
+            }
+            return BSON("" << str);
+        }
+        case COMPOUND:
+            return BSON("" << static_cast<int>(expReal(gen)) << ""
+                           << std::string(expDist(gen) * kStrLenMultiplier, 'x') << ""
+                           << expReal(gen));
+        case TYPEBITS: {
+            // Numbers of every type that have the same KeyString encoding, so that the TypeBits
+            // must record the original type of each one.
+            const int arrLen = expDist(gen) * kArrLenMultiplier;
+            BSONArrayBuilder bab;
+            for (int i = 0; i < arrLen; i++) {
+                switch (i % 4) {
+                    case 0:
+                        bab.append(i);
+                        break;
+                    case 1:
+                        bab.append(static_cast<long long>(i));
+                        break;
+                    case 2:
+                        bab.append(static_cast<double>(i));
+                        break;
+                    case 3:
+                        bab.append(Decimal128(i));
+                        break;
+                }
+            }
+            return BSON("" << bab.arr());
+        }
     }
     MONGO_UNREACHABLE;
 }
 
 static BsonsAndKeyStrings generateBsonsAndKeyStrings(BsonValueType bsonValueType,
-                                                     KeyString::Version version) {
+                                                     KeyString::Version version,
+                                                     Ordering ordering = ALL_ASCENDING) {
     BsonsAndKeyStrings result;
     result.bsonSize = 0;
     result.keystringSize = 0;
     for (int i = 0; i < kSampleSize; i++) {
         BSONObj bson = generateBson(bsonValueType);
-        KeyString::Builder ks(version, bson, ALL_ASCENDING);
+        KeyString::Builder ks(version, bson, ordering);
         result.bsonSize += bson.objsize();
         result.keystringSize += ks.getSize();
         result.bsons[i] = bson;
@@ -115,7 +155,7 @@ static BsonsAndKeyStrings generateBsonsAndKeyStrings(BsonValueType bsonValueType
 
         result.typebits[i] = SharedBuffer::allocate(ks.getTypeBits().getSize());
         memcpy(result.typebits[i].get(), ks.getTypeBits().getBuffer(), ks.getTypeBits().getSize());
-        result.typebitsLens[i] = ks.getSize();
+        result.typebitsLens[i] = ks.getTypeBits().getSize();
     }
     return result;
 }
@@ -134,10 +174,12 @@ void BM_BSONToKeyString(benchmark::State& state,
     state.SetItemsProcessed(state.iterations() * kSampleSize);
 }
 
-void BM_KeyStringToBSON(benchmark::State& state,
-                        const KeyString::Version version,
-                        BsonValueType bsonType) {
-    const BsonsAndKeyStrings bsonsAndKeyStrings = generateBsonsAndKeyStrings(bsonType, version);
+void keyStringToBSON(benchmark::State& state,
+                     const KeyString::Version version,
+                     BsonValueType bsonType,
+                     Ordering ordering) {
+    const BsonsAndKeyStrings bsonsAndKeyStrings =
+        generateBsonsAndKeyStrings(bsonType, version, ordering);
     for (auto _ : state) {
         benchmark::ClobberMemory();
         for (size_t i = 0; i < kSampleSize; i++) {
@@ -145,7 +187,7 @@ void BM_KeyStringToBSON(benchmark::State& state,
             benchmark::DoNotOptimize(
                 KeyString::toBson(bsonsAndKeyStrings.keystrings[i].get(),
                                   bsonsAndKeyStrings.keystringLens[i],
-                                  ALL_ASCENDING,
+                                  ordering,
                                   KeyString::TypeBits::fromBuffer(version, &buf)));
         }
     }
@@ -153,6 +195,19 @@ void BM_KeyStringToBSON(benchmark::State& state,
     state.SetItemsProcessed(state.iterations() * kSampleSize);
 }
 
+void BM_KeyStringToBSON(benchmark::State& state,
+                        const KeyString::Version version,
+                        BsonValueType bsonType) {
+    keyStringToBSON(state, version, bsonType, ALL_ASCENDING);
+}
+
+// Descending keys are stored with their bits inverted, which decoding must undo.
+void BM_KeyStringToBSONDescending(benchmark::State& state,
+                                  const KeyString::Version version,
+                                  BsonValueType bsonType) {
+    keyStringToBSON(state, version, bsonType, ALL_DESCENDING);
+}
+
 void BM_KeyStringValueAssign(benchmark::State& state, BsonValueType bsonType) {
     // The KeyString version does not matter for this test.
     const auto version = KeyString::Version::V1;
@@ -235,6 +290,9 @@ BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_String, KeyString::Version::V0, STRING)
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_String, KeyString::Version::V1, STRING);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_Array, KeyString::Version::V0, ARRAY);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Array, KeyString::Version::V1, ARRAY);
+BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_StringWithNuls, KeyString::Version::V1, STRING_WITH_NULS);
+BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Compound, KeyString::Version::V1, COMPOUND);
+BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_TypeBits, KeyString::Version::V1, TYPEBITS);
 
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Int, KeyString::Version::V0, INT);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Int, KeyString::Version::V1, INT);
@@ -245,6 +303,16 @@ BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_String, KeyString::Version::V0, STRING)
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_String, KeyString::Version::V1, STRING);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Array, KeyString::Version::V0, ARRAY);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Array, KeyString::Version::V1, ARRAY);
+BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_StringWithNuls, KeyString::Version::V1, STRING_WITH_NULS);
+BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Compound, KeyString::Version::V1, COMPOUND);
+BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_TypeBits, KeyString::Version::V1, TYPEBITS);
+
+BENCHMARK_CAPTURE(BM_KeyStringToBSONDescending, V1_String, KeyString::Version::V1, STRING);
+BENCHMARK_CAPTURE(BM_KeyStringToBSONDescending,
+                  V1_StringWithNuls,
+                  KeyString::Version::V1,
+                  STRING_WITH_NULS);
+BENCHMARK_CAPTURE(BM_KeyStringToBSONDescending, V1_Compound, KeyString::Version::V1, COMPOUND);
 
 }  // namespace
 }  // namespace mongo
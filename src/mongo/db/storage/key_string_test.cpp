@@ -518,6 +518,26 @@ TEST_F(KeyStringBuilderTest, DecimalNumbers) {
     ROUNDTRIP(V1, BSON("" << BSONNULL << "" << BSON("a" << Decimal128::kPositiveInfinity)));
 }
 
+TEST_F(KeyStringBuilderTest, StringsWithNulsOfManyLengthsRoundTrip) {
+    // Inverted strings are decoded a word at a time, so cover lengths around word boundaries with
+    // NUL bytes at the start, middle and end, followed by another field that must still be found.
+    for (size_t length = 0; length < 34; length++) {
+        std::string str(length, 'x');
+        for (size_t i = 0; i < length; i += 7) {
+            str[i] = '\0';
+        }
+        if (length) {
+            str[length - 1] = '\0';
+        }
+
+        ROUNDTRIP(version, BSON("" << str << "" << 1));
+
+        const Ordering allDescending = Ordering::make(BSON("a" << -1 << "b" << -1));
+        ROUNDTRIP_ORDER(version, BSON("" << str << "" << BSONSymbol(str)), allDescending);
+        ROUNDTRIP_ORDER(version, BSON("" << BSON("a" << str) << "" << 1), allDescending);
+    }
+}
+
 TEST_F(KeyStringBuilderTest, KeyStringValue) {
     // Test that KeyStringBuilder is releasable into a Value type that is comparable. Once
     // released, it is reusable once reset.
@@ -581,6 +601,26 @@ TEST_F(KeyStringBuilderTest, KeyStringGetValueCopyTest) {
     COMPARE_KS_BSON(data2, BSON("" << 1), ALL_ASCENDING);
 }
 
+TEST_F(KeyStringBuilderTest, KeyStringValueDeserializesIntoExactlySizedBuffer) {
+    for (auto&& key : {BSON("" << 1), BSON("" << 1.0 << ""
+                                           << "abc")}) {
+        KeyString::HeapBuilder ks(KeyString::Version::V1, key, ALL_ASCENDING);
+        KeyString::Value value = ks.release();
+
+        BufBuilder serialized;
+        value.serialize(serialized);
+        BufReader reader(serialized.buf(), serialized.len());
+        auto deserialized = KeyString::Value::deserialize(reader, KeyString::Version::V1);
+
+        ASSERT(reader.atEof());
+        ASSERT_EQ(0, deserialized.compare(value));
+        ASSERT_EQ(value.getTypeBits().isAllZeros(), deserialized.getTypeBits().isAllZeros());
+        ASSERT_EQ(sizeof(KeyString::Value) + serialized.len() - sizeof(int32_t),
+                  static_cast<size_t>(deserialized.memUsageForSorter()));
+        COMPARE_KS_BSON(deserialized, key, ALL_ASCENDING);
+    }
+}
+
 TEST_F(KeyStringBuilderTest, KeyStringBuilderAppendBsonElement) {
     // Test that appendBsonElement works.
     {
@@ -186,7 +186,15 @@ MobileRecordStore::MobileRecordStore(OperationContext* opCtx,
                                      const std::string& path,
                                      const std::string& ident,
                                      const CollectionOptions& options)
-    : RecordStore(ns), _path(path), _ident(ident) {
+    : RecordStore(ns),
+      _path(path),
+      _ident(ident),
+      _dataSizeQuery(str::stream() << "SELECT IFNULL(LENGTH(data), 0) FROM \"" << _ident
+                                   << "\" WHERE rec_id = ?;"),
+      _insertQuery(str::stream() << "INSERT OR REPLACE INTO \"" << _ident
+                                 << "\"(rec_id, data) VALUES(?, ?);"),
+      _updateQuery(str::stream() << "UPDATE \"" << _ident << "\" SET data = ? WHERE rec_id = ?;"),
+      _deleteQuery(str::stream() << "DELETE FROM \"" << _ident << "\" WHERE rec_id = ?;") {
 
     // Mobile SE doesn't support creating an oplog, assert now
     massert(ErrorCodes::IllegalOperation,
@@ -283,18 +291,19 @@ bool MobileRecordStore::findRecord(OperationContext* opCtx,
 void MobileRecordStore::deleteRecord(OperationContext* opCtx, const RecordId& recId) {
     MobileSession* session = MobileRecoveryUnit::get(opCtx)->getSession(opCtx, false);
 
-    SqliteStatement dataSizeStmt(
-        *session, "SELECT IFNULL(LENGTH(data), 0) FROM \"", _ident, "\" WHERE rec_id = ?;");
-    dataSizeStmt.bindInt(0, recId.repr());
-    dataSizeStmt.step(SQLITE_ROW);
-
-    int64_t dataSizeBefore = dataSizeStmt.getColInt(0);
+    int64_t dataSizeBefore;
+    {
+        auto dataSizeStmt = SqliteStatementCache::get(*session, _dataSizeQuery);
+        dataSizeStmt->bindInt(0, recId.repr());
+        dataSizeStmt->step(SQLITE_ROW);
+        dataSizeBefore = dataSizeStmt->getColInt(0);
+    }
     _changeNumRecs(opCtx, -1);
     _changeDataSize(opCtx, -dataSizeBefore);
 
-    SqliteStatement deleteStmt(*session, "DELETE FROM \"", _ident, "\" WHERE rec_id = ?;");
-    deleteStmt.bindInt(0, recId.repr());
-    deleteStmt.step(SQLITE_DONE);
+    auto deleteStmt = SqliteStatementCache::get(*session, _deleteQuery);
+    deleteStmt->bindInt(0, recId.repr());
+    deleteStmt->step(SQLITE_DONE);
 }
 
 Status MobileRecordStore::insertRecords(OperationContext* opCtx,
@@ -303,8 +312,7 @@ Status MobileRecordStore::insertRecords(OperationContext* opCtx,
     // Inserts record into SQLite table (or replaces if duplicate record id).
     MobileSession* session = MobileRecoveryUnit::get(opCtx)->getSession(opCtx, false);
 
-    SqliteStatement insertStmt(
-        *session, "INSERT OR REPLACE INTO \"", _ident, "\"(rec_id, data) VALUES(?, ?);");
+    auto insertStmt = SqliteStatementCache::get(*session, _insertQuery);
 
     for (auto& record : *inOutRecords) {
         const auto data = record.data.data();
@@ -314,12 +322,12 @@ Status MobileRecordStore::insertRecords(OperationContext* opCtx,
         _changeDataSize(opCtx, len);
 
         RecordId recId = _nextId();
-        insertStmt.bindInt(0, recId.repr());
-        insertStmt.bindBlob(1, data, len);
-        insertStmt.step(SQLITE_DONE);
+        insertStmt->bindInt(0, recId.repr());
+        insertStmt->bindBlob(1, data, len);
+        insertStmt->step(SQLITE_DONE);
 
         record.id = recId;
-        insertStmt.reset();
+        insertStmt->reset();
     }
 
     return Status::OK();
@@ -331,19 +339,19 @@ Status MobileRecordStore::updateRecord(OperationContext* opCtx,
                                        int len) {
     MobileSession* session = MobileRecoveryUnit::get(opCtx)->getSession(opCtx, false);
 
-    SqliteStatement dataSizeStmt(
-        *session, "SELECT IFNULL(LENGTH(data), 0) FROM \"", _ident, "\" WHERE rec_id = ?;");
-    dataSizeStmt.bindInt(0, recId.repr());
-    dataSizeStmt.step(SQLITE_ROW);
-
-    int64_t dataSizeBefore = dataSizeStmt.getColInt(0);
+    int64_t dataSizeBefore;
+    {
+        auto dataSizeStmt = SqliteStatementCache::get(*session, _dataSizeQuery);
+        dataSizeStmt->bindInt(0, recId.repr());
+        dataSizeStmt->step(SQLITE_ROW);
+        dataSizeBefore = dataSizeStmt->getColInt(0);
+    }
     _changeDataSize(opCtx, -dataSizeBefore + len);
 
-    SqliteStatement updateStmt(
-        *session, "UPDATE \"", _ident, "\" SET data = ? ", "WHERE rec_id = ?;");
-    updateStmt.bindBlob(0, data, len);
-    updateStmt.bindInt(1, recId.repr());
-    updateStmt.step(SQLITE_DONE);
+    auto updateStmt = SqliteStatementCache::get(*session, _updateQuery);
+    updateStmt->bindBlob(0, data, len);
+    updateStmt->bindInt(1, recId.repr());
+    updateStmt->step(SQLITE_DONE);
 
     return Status::OK();
 }
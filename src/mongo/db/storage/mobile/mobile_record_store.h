@@ -145,6 +145,13 @@ private:
     const std::string _path;
     const std::string _ident;
 
+    // The SQL of the statements run by writes, which are run from the statement caches of the
+    // sessions.
+    const std::string _dataSizeQuery;
+    const std::string _insertQuery;
+    const std::string _updateQuery;
+    const std::string _deleteQuery;
+
     AtomicWord<long long> _nextIdNum;
 
     /**
@@ -0,0 +1,120 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/operation_context_noop.h"
+#include "mongo/db/storage/mobile/mobile_options.h"
+#include "mongo/db/storage/mobile/mobile_record_store.h"
+#include "mongo/db/storage/mobile/mobile_recovery_unit.h"
+#include "mongo/db/storage/mobile/mobile_session_pool.h"
+#include "mongo/db/storage/write_unit_of_work.h"
+#include "mongo/unittest/temp_dir.h"
+
+namespace mongo {
+namespace {
+
+const std::string kIdent = "collection-sensor-data";
+
+class MobileBenchmarkHelper {
+public:
+    explicit MobileBenchmarkHelper(int durabilityLevel) : _dbPath("mobile_record_store_bm") {
+        // The defaults of the storage.mobile options.
+        _options.durabilityLevel = durabilityLevel;
+        _options.cacheSizeKB = 10240;
+        _options.mmapSizeKB = 51200;
+        _options.journalSizeLimitKB = 5120;
+        _options.walAutoCheckpointPages = 1000;
+        _options.disableVacuumJob = true;
+
+        _sessionPool = std::make_unique<MobileSessionPool>(_dbPath.path() + "/mobile.sqlite",
+                                                           _options);
+        _opCtx = std::make_unique<OperationContextNoop>(
+            new MobileRecoveryUnit(_sessionPool.get()));
+
+        MobileRecordStore::create(_opCtx.get(), kIdent);
+        _recordStore = std::make_unique<MobileRecordStore>(
+            _opCtx.get(), "test.sensors", _dbPath.path(), kIdent, CollectionOptions());
+    }
+
+    OperationContext* opCtx() const {
+        return _opCtx.get();
+    }
+
+    RecordStore* recordStore() const {
+        return _recordStore.get();
+    }
+
+private:
+    unittest::TempDir _dbPath;
+    embedded::MobileOptions _options;
+    std::unique_ptr<MobileSessionPool> _sessionPool;
+    std::unique_ptr<OperationContext> _opCtx;
+    std::unique_ptr<RecordStore> _recordStore;
+};
+
+/**
+ * Inserts small sensor readings in units of work of state.range(0) documents, with the SQLite
+ * synchronous level given by state.range(1).
+ */
+void BM_MobileInsert(benchmark::State& state) {
+    const auto docsPerUnitOfWork = state.range(0);
+    MobileBenchmarkHelper helper(state.range(1));
+    auto opCtx = helper.opCtx();
+
+    long long reading = 0;
+    for (auto _ : state) {
+        WriteUnitOfWork wuow(opCtx);
+        for (int64_t i = 0; i < docsPerUnitOfWork; ++i) {
+            const auto doc = BSON("sensor" << 7 << "reading" << ++reading << "value" << 21.5);
+            invariant(helper.recordStore()
+                          ->insertRecord(opCtx, doc.objdata(), doc.objsize(), Timestamp())
+                          .getStatus());
+        }
+        wuow.commit();
+    }
+
+    state.SetItemsProcessed(state.iterations() * docsPerUnitOfWork);
+}
+
+BENCHMARK(BM_MobileInsert)
+    ->Args({1, 1})
+    ->Args({16, 1})
+    ->Args({256, 1})
+    ->Args({1, 2})
+    ->Args({16, 2})
+    ->Args({256, 2});
+
+}  // namespace
+}  // namespace mongo
@@ -125,23 +125,29 @@ bool MobileRecoveryUnit::waitUntilDurable(OperationContext* opCtx) {
     if (_sessionPool->getOptions().durabilityLevel < 2) {
         _ensureSession(opCtx);
         RECOVERY_UNIT_TRACE() << "waitUntilDurable called, attempting to perform a checkpoint";
-        int framesInWAL = 0;
-        int checkpointedFrames = 0;
-        int ret;
-        {
-            Lock::GlobalLock lk(opCtx, MODE_X);
-            // Use FULL mode to guarantee durability
-            ret = sqlite3_wal_checkpoint_v2(_session.get()->getSession(),
-                                            nullptr,
-                                            SQLITE_CHECKPOINT_FULL,
-                                            &framesInWAL,
-                                            &checkpointedFrames);
-        }
-        embedded::checkStatus(ret, SQLITE_OK, "sqlite3_wal_checkpoint_v2");
-        fassert(51164,
-                framesInWAL != -1 && checkpointedFrames != -1 && framesInWAL == checkpointedFrames);
-        RECOVERY_UNIT_TRACE() << "Checkpointed " << checkpointedFrames << " of the " << framesInWAL
-                              << " total frames in the WAL";
+
+        // Concurrent callers share checkpoints, so that a burst of durable writes costs a few
+        // checkpoints rather than one global X lock and checkpoint each.
+        _sessionPool->runGroupCheckpoint(opCtx, [&] {
+            int framesInWAL = 0;
+            int checkpointedFrames = 0;
+            int ret;
+            {
+                Lock::GlobalLock lk(opCtx, MODE_X);
+                // Use FULL mode to guarantee durability
+                ret = sqlite3_wal_checkpoint_v2(_session.get()->getSession(),
+                                                nullptr,
+                                                SQLITE_CHECKPOINT_FULL,
+                                                &framesInWAL,
+                                                &checkpointedFrames);
+            }
+            embedded::checkStatus(ret, SQLITE_OK, "sqlite3_wal_checkpoint_v2");
+            fassert(51164,
+                    framesInWAL != -1 && checkpointedFrames != -1 &&
+                        framesInWAL == checkpointedFrames);
+            RECOVERY_UNIT_TRACE() << "Checkpointed " << checkpointedFrames << " of the "
+                                  << framesInWAL << " total frames in the WAL";
+        });
     } else {
         RECOVERY_UNIT_TRACE() << "No checkpoint attempted -- in full synchronous mode";
     }
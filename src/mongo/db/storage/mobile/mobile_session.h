@@ -36,6 +36,7 @@
 
 namespace mongo {
 class MobileSessionPool;
+class SqliteStatementCache;
 
 /**
  * This class manages a SQLite database connection object.
@@ -45,7 +46,9 @@ class MobileSession final {
     MobileSession& operator=(const MobileSession&) = delete;
 
 public:
-    MobileSession(sqlite3* session, MobileSessionPool* sessionPool);
+    MobileSession(sqlite3* session,
+                  MobileSessionPool* sessionPool,
+                  SqliteStatementCache* statementCache = nullptr);
 
     ~MobileSession();
 
@@ -54,8 +57,16 @@ public:
      */
     sqlite3* getSession() const;
 
+    /**
+     * Returns the cache of the statements prepared on the connection, if it has one.
+     */
+    SqliteStatementCache* getStatementCache() const {
+        return _statementCache;
+    }
+
 private:
     sqlite3* _session;
     MobileSessionPool* _sessionPool;
+    SqliteStatementCache* _statementCache;
 };
 }  // namespace mongo
@@ -45,6 +45,7 @@
 #include "mongo/db/storage/mobile/mobile_util.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -114,7 +115,7 @@ std::unique_ptr<MobileSession> MobileSessionPool::getSession(OperationContext* o
     // Checks if there is an open session available.
     if (!_sessions.empty()) {
         sqlite3* session = _popSession_inlock();
-        return std::make_unique<MobileSession>(session, this);
+        return std::make_unique<MobileSession>(session, this, _statementCaches[session].get());
     }
 
     // Checks if a new session can be opened.
@@ -124,7 +125,9 @@ std::unique_ptr<MobileSession> MobileSessionPool::getSession(OperationContext* o
         embedded::checkStatus(status, SQLITE_OK, "sqlite3_open");
         embedded::configureSession(session, _options);
         _curPoolSize++;
-        return std::make_unique<MobileSession>(session, this);
+        auto& statementCache = _statementCaches[session];
+        statementCache = std::make_unique<SqliteStatementCache>();
+        return std::make_unique<MobileSession>(session, this, statementCache.get());
     }
 
     // There are no open sessions available and the maxPoolSize has been reached.
@@ -133,7 +136,7 @@ std::unique_ptr<MobileSession> MobileSessionPool::getSession(OperationContext* o
         _releasedSessionNotifier, lk, [&] { return !_sessions.empty(); });
 
     sqlite3* session = _popSession_inlock();
-    return std::make_unique<MobileSession>(session, this);
+    return std::make_unique<MobileSession>(session, this, _statementCaches[session].get());
 }
 
 void MobileSessionPool::releaseSession(MobileSession* session) {
@@ -177,10 +180,48 @@ void MobileSessionPool::shutDown() {
     }
 
     for (auto&& session : _sessions) {
+        // The prepared statements of a session must be finalized before it can be closed.
+        _statementCaches.erase(session);
         sqlite3_close(session);
     }
 }
 
+void MobileSessionPool::runGroupCheckpoint(OperationContext* opCtx,
+                                           const std::function<void()>& checkpoint) {
+    stdx::unique_lock<Latch> lk(_checkpointMutex);
+    const auto ticket = ++_lastCheckpointTicket;
+
+    while (_lastCoveredCheckpointTicket < ticket) {
+        if (_checkpointRunning) {
+            // The running checkpoint may have started before this caller's writes committed, so
+            // wait for it to finish, then run or wait for another.
+            opCtx->waitForConditionOrInterrupt(
+                _checkpointFinished, lk, [&] { return !_checkpointRunning; });
+            continue;
+        }
+
+        _checkpointRunning = true;
+        const auto coveredTicket = _lastCheckpointTicket;
+        lk.unlock();
+
+        ON_BLOCK_EXIT([&] {
+            if (!lk.owns_lock()) {
+                lk.lock();
+            }
+            _checkpointRunning = false;
+            _checkpointFinished.notify_all();
+        });
+        checkpoint();
+
+        lk.lock();
+        LOG(MOBILE_LOG_LEVEL_LOW) << "MobileSE: Checkpoint covered "
+                                  << coveredTicket - _lastCoveredCheckpointTicket
+                                  << " waiters for durability";
+        _lastCoveredCheckpointTicket = coveredTicket;
+        return;
+    }
+}
+
 // This method should only be called when _sessions is locked.
 sqlite3* MobileSessionPool::_popSession_inlock() {
     sqlite3* session = _sessions.back();
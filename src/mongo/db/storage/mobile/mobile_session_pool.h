@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <queue>
 #include <sqlite3.h>
 #include <string>
@@ -38,9 +40,12 @@
 #include "mongo/db/storage/mobile/mobile_options.h"
 #include "mongo/db/storage/mobile/mobile_session.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 class MobileSession;
+class SqliteStatementCache;
 
 /**
  * This class manages a queue of operations delayed for some reason
@@ -92,6 +97,13 @@ public:
      */
     void shutDown();
 
+    /**
+     * Runs 'checkpoint', which makes the writes committed so far durable, on behalf of all the
+     * callers waiting for durability. A caller arriving while a checkpoint runs waits for the next
+     * one, which a single one of the callers waiting by then runs for all of them.
+     */
+    void runGroupCheckpoint(OperationContext* opCtx, const std::function<void()>& checkpoint);
+
     // Failed drops get queued here and get re-tried periodically
     MobileDelayedOpQueue failedDropsQueue;
 
@@ -122,5 +134,16 @@ private:
 
     using SessionPool = std::vector<sqlite3*>;
     SessionPool _sessions;
+
+    // The statements prepared on each open session.
+    stdx::unordered_map<sqlite3*, std::unique_ptr<SqliteStatementCache>> _statementCaches;
+
+    // Lets concurrent callers of runGroupCheckpoint() share checkpoints. Callers take increasing
+    // tickets, and a checkpoint covers all the tickets taken before it started.
+    Mutex _checkpointMutex = MONGO_MAKE_LATCH("MobileSessionPool::_checkpointMutex");
+    stdx::condition_variable _checkpointFinished;
+    bool _checkpointRunning = false;
+    std::uint64_t _lastCheckpointTicket = 0;
+    std::uint64_t _lastCoveredCheckpointTicket = 0;
 };
 }  // namespace mongo
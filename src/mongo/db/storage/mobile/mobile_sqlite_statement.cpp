@@ -172,4 +172,36 @@ void SqliteStatement::reset() {
     embedded::checkStatus(status, SQLITE_OK, "sqlite3_reset");
 }
 
+void SqliteStatement::resetForReuse() {
+    // sqlite3_reset() repeats the status of the last step, which its caller has already handled.
+    sqlite3_reset(_stmt);
+    sqlite3_clear_bindings(_stmt);
+    _exceptionStatus = SQLITE_OK;
+}
+
+SqliteStatementCache::Handle SqliteStatementCache::get(const MobileSession& session,
+                                                       const std::string& query) {
+    auto cache = session.getStatementCache();
+    if (!cache) {
+        return Handle(std::make_shared<SqliteStatement>(session, query));
+    }
+
+    auto it = cache->_statements.find(query);
+    if (it == cache->_statements.end()) {
+        if (cache->_statements.size() >= kMaxStatements) {
+            cache->_statements.clear();
+        }
+        it = cache->_statements.emplace(query, std::make_shared<SqliteStatement>(session, query))
+                 .first;
+    } else if (it->second.use_count() > 1) {
+        // The cached statement is checked out already, so this use gets its own.
+        return Handle(std::make_shared<SqliteStatement>(session, query));
+    }
+    return Handle(it->second);
+}
+
+void SqliteStatementCache::clear() {
+    _statements.clear();
+}
+
 }  // namespace mongo
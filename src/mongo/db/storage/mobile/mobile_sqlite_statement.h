@@ -29,11 +29,13 @@
 
 #pragma once
 
+#include <memory>
 #include <sqlite3.h>
 #include <string>
 
 #include "mongo/db/storage/mobile/mobile_session.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/unordered_map.h"
 
 #include <boost/container/small_vector.hpp>
 
@@ -105,6 +107,12 @@ public:
      */
     void reset();
 
+    /**
+     * Resets the statement and clears its bindings, so that it can be run again later, whatever
+     * the outcome of its last step.
+     */
+    void resetForReuse();
+
     /**
      * Sets the last status on the prepared statement.
      */
@@ -181,6 +189,63 @@ private:
     }
 };
 
+/**
+ * A cache of the statements prepared on a SQLite connection, keyed by their SQL text. Statements
+ * which run often, such as those of inserts, are then prepared once per connection rather than
+ * every time they run.
+ */
+class SqliteStatementCache final {
+    SqliteStatementCache(const SqliteStatementCache&) = delete;
+    SqliteStatementCache& operator=(const SqliteStatementCache&) = delete;
+
+public:
+    // The statements are per table, so the cache is emptied when it reaches this size rather than
+    // growing with the number of tables ever written to.
+    static constexpr size_t kMaxStatements = 64;
+
+    /**
+     * A statement checked out of a cache. The statement is reset for reuse when the handle goes
+     * away, so that it does not keep its transaction or its bound data.
+     */
+    class Handle {
+    public:
+        explicit Handle(std::shared_ptr<SqliteStatement> stmt) : _stmt(std::move(stmt)) {}
+        Handle(Handle&&) = default;
+        ~Handle() {
+            if (_stmt) {
+                _stmt->resetForReuse();
+            }
+        }
+
+        SqliteStatement* operator->() const {
+            return _stmt.get();
+        }
+
+        SqliteStatement& operator*() const {
+            return *_stmt;
+        }
+
+    private:
+        std::shared_ptr<SqliteStatement> _stmt;
+    };
+
+    SqliteStatementCache() = default;
+
+    /**
+     * Returns the statement for 'query' from the cache of 'session', preparing it if it is not
+     * cached yet. Sessions without a cache get a newly prepared statement.
+     */
+    static Handle get(const MobileSession& session, const std::string& query);
+
+    /**
+     * Finalizes the cached statements. This must be done before the connection is closed.
+     */
+    void clear();
+
+private:
+    stdx::unordered_map<std::string, std::shared_ptr<SqliteStatement>> _statements;
+};
+
 namespace detail {
 // Most of the strings we build statements with are static strings so we can calculate their length
 // during compile time.
@@ -186,6 +186,27 @@ public:
     }
 };
 
+/**
+ * Appends records to an empty RecordStore more cheaply than RecordStore::insertRecords(), for
+ * loading a collection before it is in use, such as during initial sync. Obtained from
+ * RecordStore::makeBulkInserter().
+ *
+ * Records are only written when the WriteUnitOfWork they were inserted in commits, and are
+ * discarded if it rolls back, so inserts may be retried after a WriteConflictException.
+ */
+class BulkRecordInserter {
+public:
+    virtual ~BulkRecordInserter() {}
+
+    /**
+     * Copies the record described by 'data' and 'len' and returns the RecordId it will be written
+     * with when the current WriteUnitOfWork commits. Must be called in a WriteUnitOfWork.
+     */
+    virtual StatusWith<RecordId> insertRecord(OperationContext* opCtx,
+                                              const char* data,
+                                              int len) = 0;
+};
+
 /**
  * An abstraction used for storing documents in a collection or entries in an index.
  *
@@ -254,6 +275,14 @@ public:
                                 BSONObjBuilder* extraInfo = nullptr,
                                 int infoLevel = 0) const = 0;
 
+    /**
+     * Returns the number of bytes of stable storage allocated to this record store which it is not
+     * using, and which compact() could at best return to the file system.
+     */
+    virtual int64_t freeStorageSize(OperationContext* opCtx) const {
+        return 0;
+    }
+
     // CRUD related
 
     /**
@@ -319,6 +348,16 @@ public:
         return inOutRecords.front().id;
     }
 
+    /**
+     * Returns an inserter that bulk loads records into this RecordStore, or nullptr if the
+     * RecordStore is not empty or does not support bulk loading. Callers must fall back to
+     * insertRecords() when nullptr is returned. The RecordStore may not be otherwise written to or
+     * read from while the inserter is alive.
+     */
+    virtual std::unique_ptr<BulkRecordInserter> makeBulkInserter(OperationContext* opCtx) {
+        return nullptr;
+    }
+
     /**
      * Updates the record with id 'recordId', replacing its contents with those described by
      * 'data' and 'len'.
@@ -377,6 +416,18 @@ public:
         return {};
     }
 
+    /**
+     * Like getRandomCursor(), but tells the storage engine that roughly 'numSamples' records will
+     * be read. Rather than picking each record independently, the storage engine may divide the
+     * record store into 'numSamples' contiguous blocks and return one record from each, which
+     * spreads the samples evenly across the record store and avoids most duplicates. Records are
+     * then not returned in a randomized order.
+     */
+    virtual std::unique_ptr<RecordCursor> getBlockSamplingCursor(OperationContext* opCtx,
+                                                                 long long numSamples) const {
+        return getRandomCursor(opCtx);
+    }
+
     // higher level
 
 
@@ -449,6 +500,16 @@ public:
                                    BSONObjBuilder* result,
                                    double scale) const = 0;
 
+    /**
+     * Appends a summary of how much of this RecordStore is resident in the storage engine's cache,
+     * with byte counts divided by 'scale'. Returns false if the storage engine does not track it.
+     */
+    virtual bool appendCacheStats(OperationContext* opCtx,
+                                  BSONObjBuilder* result,
+                                  double scale) const {
+        return false;
+    }
+
     /**
      * Return the RecordId of an oplog entry as close to startingPosition as possible without
      * being higher. If there are no entries <= startingPosition, return RecordId().
@@ -138,6 +138,16 @@ public:
                                    BSONObjBuilder* output,
                                    double scale) const = 0;
 
+    /**
+     * Appends a summary of how much of this index is resident in the storage engine's cache, with
+     * byte counts divided by 'scale'. Returns false if the storage engine does not track it.
+     */
+    virtual bool appendCacheStats(OperationContext* opCtx,
+                                  BSONObjBuilder* output,
+                                  double scale) const {
+        return false;
+    }
+
 
     /**
      * Return the number of bytes consumed by 'this' index.
@@ -148,6 +158,14 @@ public:
      */
     virtual long long getSpaceUsedBytes(OperationContext* opCtx) const = 0;
 
+    /**
+     * Return the number of bytes allocated to 'this' index which it is not using, and which
+     * compact() could at best return to the file system.
+     */
+    virtual long long getFreeStorageBytes(OperationContext* opCtx) const {
+        return 0;
+    }
+
     /**
      * Return true if 'this' index is empty, and false otherwise.
      */
@@ -53,6 +53,7 @@
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -83,6 +84,7 @@ StorageEngineImpl::StorageEngineImpl(KVEngine* engine, StorageEngineOptions opti
 }
 
 void StorageEngineImpl::loadCatalog(OperationContext* opCtx) {
+    Timer timer;
     bool catalogExists = _engine->hasIdent(opCtx, catalogInfo);
     if (_options.forRepair && catalogExists) {
         auto repairObserver = StorageRepairObserver::get(getGlobalServiceContext());
@@ -125,6 +127,7 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx) {
     _catalog.reset(new DurableCatalogImpl(
         _catalogRecordStore.get(), _options.directoryPerDB, _options.directoryForIndexes, this));
     _catalog->init(opCtx);
+    const auto catalogInitMillis = timer.millis();
 
     // We populate 'identsKnownToStorageEngine' only if we are loading after an unclean shutdown or
     // doing repair.
@@ -232,6 +235,10 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx) {
     KVPrefix::setLargestPrefix(maxSeenPrefix);
     opCtx->recoveryUnit()->abandonSnapshot();
 
+    log() << "Loaded " << collectionsKnownToCatalog.size() << " collections from the catalog in "
+          << timer.millis() << "ms, of which reading the catalog took " << catalogInitMillis
+          << "ms";
+
     // Unset the unclean shutdown flag to avoid executing special behavior if this method is called
     // after startup.
     startingAfterUncleanShutdown(getGlobalServiceContext()) = false;
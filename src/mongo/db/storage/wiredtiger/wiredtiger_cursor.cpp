@@ -42,11 +42,12 @@ namespace mongo {
 WiredTigerCursor::WiredTigerCursor(const std::string& uri,
                                    uint64_t tableID,
                                    bool allowOverwrite,
-                                   OperationContext* opCtx) {
+                                   OperationContext* opCtx,
+                                   bool readOnce) {
     _tableID = tableID;
     _ru = WiredTigerRecoveryUnit::get(opCtx);
     _session = _ru->getSession();
-    _readOnce = _ru->getReadOnce();
+    _readOnce = readOnce || _ru->getReadOnce();
     _isCheckpoint =
         (_ru->getTimestampReadSource() == WiredTigerRecoveryUnit::ReadSource::kCheckpoint);
 
@@ -89,7 +90,9 @@ WiredTigerCursor::WiredTigerCursor(const std::string& uri,
 }
 
 WiredTigerCursor::~WiredTigerCursor() {
-    dassert(_ru->getReadOnce() == _readOnce);
+    // A cursor may be read-once without its recovery unit being in read-once mode, but not the
+    // other way around.
+    dassert(!_ru->getReadOnce() || _readOnce);
     dassert(_isCheckpoint ==
             (_ru->getTimestampReadSource() == WiredTigerRecoveryUnit::ReadSource::kCheckpoint));
 
@@ -47,11 +47,15 @@ public:
      * If 'allowOverwrite' is true, insert operations will not return an error if the record
      * already exists, and update/remove operations will not return error if the record does not
      * exist.
+     *
+     * If 'readOnce' is true, pages this cursor reads into the cache are given less priority there,
+     * as they are for every cursor of a recovery unit in read-once mode.
      */
     WiredTigerCursor(const std::string& uri,
                      uint64_t tableID,
                      bool allowOverwrite,
-                     OperationContext* opCtx);
+                     OperationContext* opCtx,
+                     bool readOnce = false);
 
     ~WiredTigerCursor();
 
@@ -33,6 +33,7 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
 
+#include <algorithm>
 #include <memory>
 #include <set>
 
@@ -55,6 +56,7 @@
 #include "mongo/util/fail_point.h"
 #include "mongo/util/hex.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 #define TRACING_ENABLED 0
@@ -80,6 +82,83 @@ using std::string;
 using std::vector;
 
 static const WiredTigerItem emptyItem(nullptr, 0);
+
+// Number of entries a random cursor samples when reporting key size statistics for collStats.
+const int kKeyStatsSampleSize = 1000;
+
+int64_t getFastStatistic(WT_SESSION* s, const std::string& uri, int statisticsKey) {
+    auto result = WiredTigerUtil::getStatisticsValue(
+        s, "statistics:" + uri, "statistics=(fast)", statisticsKey);
+    return result.isOK() ? result.getValue() : 0;
+}
+
+/**
+ * Appends a "keyStats" subobject describing the on-disk shape of the index's entries. Key and
+ * value sizes come from a bounded random sample of the table so that the cost does not grow with
+ * the size of the index. The value of an entry holds its TypeBits, preceded by the RecordId for
+ * unique indexes. Prefix compression savings and average page size come from WiredTiger's
+ * cumulative reconciliation and cache statistics for the table since it was opened.
+ */
+void appendKeyStats(OperationContext* opCtx,
+                    WT_SESSION* s,
+                    const std::string& uri,
+                    BSONObjBuilder* output) {
+    BSONObjBuilder keyStats(output->subobjStart("keyStats"));
+
+    WT_CURSOR* c = nullptr;
+    const std::string config = str::stream() << "next_random,next_random_sample_size="
+                                             << kKeyStatsSampleSize;
+    int ret = s->open_cursor(s, uri.c_str(), nullptr, config.c_str(), &c);
+    if (ret != 0) {
+        keyStats.append("error", "unable to open random cursor");
+        keyStats.append("reason", wiredtiger_strerror(ret));
+        return;
+    }
+    ON_BLOCK_EXIT([&] { c->close(c); });
+
+    long long sampled = 0;
+    long long totalKeySize = 0;
+    long long maxKeySize = 0;
+    long long totalValueSize = 0;
+    long long entriesWithValue = 0;
+    for (; sampled < kKeyStatsSampleSize; ++sampled) {
+        ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return c->next(c); });
+        if (ret == WT_NOTFOUND)
+            break;
+        invariantWTOK(ret);
+
+        WT_ITEM key;
+        WT_ITEM value;
+        invariantWTOK(c->get_key(c, &key));
+        invariantWTOK(c->get_value(c, &value));
+        totalKeySize += key.size;
+        maxKeySize = std::max(maxKeySize, static_cast<long long>(key.size));
+        totalValueSize += value.size;
+        if (value.size > 0)
+            ++entriesWithValue;
+    }
+
+    keyStats.append("sampledEntries", sampled);
+    if (sampled > 0) {
+        keyStats.append("avgKeySize", static_cast<double>(totalKeySize) / sampled);
+        keyStats.append("maxKeySize", maxKeySize);
+        keyStats.append("avgValueSize", static_cast<double>(totalValueSize) / sampled);
+        keyStats.append("entriesWithValueFraction",
+                        static_cast<double>(entriesWithValue) / sampled);
+    }
+
+    const int64_t prefixSaved = getFastStatistic(s, uri, WT_STAT_DSRC_REC_PREFIX_COMPRESSION);
+    const int64_t bytesWritten = getFastStatistic(s, uri, WT_STAT_DSRC_CACHE_BYTES_WRITE);
+    const int64_t pagesWritten = getFastStatistic(s, uri, WT_STAT_DSRC_CACHE_WRITE);
+    keyStats.append("prefixCompressionBytesSaved", static_cast<long long>(prefixSaved));
+    if (prefixSaved + bytesWritten > 0) {
+        keyStats.append("prefixCompressionSavingsRatio",
+                        static_cast<double>(prefixSaved) / (prefixSaved + bytesWritten));
+    }
+    if (pagesWritten > 0) {
+        keyStats.append("avgWrittenPageSize", static_cast<double>(bytesWritten) / pagesWritten);
+    }
+}
 }  // namespace
 
 
@@ -360,6 +439,12 @@ bool WiredTigerIndex::appendCustomStats(OperationContext* opCtx,
         output->append("code", static_cast<int>(status.code()));
         output->append("reason", status.reason());
     }
+
+    // Tables shared between prefixed collections hold entries that do not belong to this index, so
+    // a random sample of them would be meaningless.
+    if (_prefix == KVPrefix::kNotPrefixed) {
+        appendKeyStats(opCtx, s, _uri, output);
+    }
     return true;
 }
 
@@ -401,6 +486,19 @@ bool WiredTigerIndex::isEmpty(OperationContext* opCtx) {
     return false;
 }
 
+bool WiredTigerIndex::appendCacheStats(OperationContext* opCtx,
+                                       BSONObjBuilder* output,
+                                       double scale) const {
+    WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSessionNoTxn();
+    Status status = WiredTigerUtil::appendCacheStats(session->getSession(), uri(), scale, output);
+    if (!status.isOK()) {
+        output->append("error", "unable to retrieve cache statistics");
+        output->append("code", static_cast<int>(status.code()));
+        output->append("reason", status.reason());
+    }
+    return true;
+}
+
 long long WiredTigerIndex::getSpaceUsedBytes(OperationContext* opCtx) const {
     dassert(opCtx->lockState()->isReadLocked());
     auto ru = WiredTigerRecoveryUnit::get(opCtx);
@@ -441,6 +539,18 @@ long long WiredTigerIndex::getSpaceUsedBytes(OperationContext* opCtx) const {
     return static_cast<long long>(WiredTigerUtil::getIdentSize(session->getSession(), _uri));
 }
 
+long long WiredTigerIndex::getFreeStorageBytes(OperationContext* opCtx) const {
+    dassert(opCtx->lockState()->isReadLocked());
+    auto ru = WiredTigerRecoveryUnit::get(opCtx);
+
+    // Ephemeral indexes keep no file whose space could be reused.
+    if (ru->getSessionCache()->isEphemeral()) {
+        return 0;
+    }
+    return static_cast<long long>(
+        WiredTigerUtil::getIdentReuseSize(ru->getSession()->getSession(), _uri));
+}
+
 bool WiredTigerIndex::isDup(OperationContext* opCtx, WT_CURSOR* c, const KeyString::Value& key) {
     dassert(opCtx->lockState()->isReadLocked());
     invariant(unique());
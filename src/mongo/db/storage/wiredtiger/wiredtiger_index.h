@@ -105,12 +105,17 @@ public:
     virtual bool appendCustomStats(OperationContext* opCtx,
                                    BSONObjBuilder* output,
                                    double scale) const;
+    bool appendCacheStats(OperationContext* opCtx,
+                          BSONObjBuilder* output,
+                          double scale) const override;
     virtual Status dupKeyCheck(OperationContext* opCtx, const KeyString::Value& keyString);
 
     virtual bool isEmpty(OperationContext* opCtx);
 
     virtual long long getSpaceUsedBytes(OperationContext* opCtx) const;
 
+    virtual long long getFreeStorageBytes(OperationContext* opCtx) const;
+
     virtual Status initAsEmpty(OperationContext* opCtx);
 
     virtual Status compact(OperationContext* opCtx);
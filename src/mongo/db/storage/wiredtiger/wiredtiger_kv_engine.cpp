@@ -81,6 +81,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_tuner.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
@@ -332,13 +333,7 @@ public:
         while (!_shuttingDown.load()) {
             auto opCtx = tc->makeOperationContext();
 
-            {
-                stdx::unique_lock<Latch> lock(_mutex);
-                MONGO_IDLE_THREAD_BLOCK;
-                _condvar.wait_for(lock,
-                                  stdx::chrono::seconds(static_cast<std::int64_t>(
-                                      wiredTigerGlobalOptions.checkpointDelaySecs)));
-            }
+            _waitForNextCheckpoint();
 
             pauseCheckpointThread.pauseWhileSet();
 
@@ -348,6 +343,9 @@ public:
             }
 
             const Date_t startTime = Date_t::now();
+            CacheStats statsAtStart;
+            const bool sampledStatsAtStart = _sampleCacheStats(&statsAtStart);
+            bool tookCheckpoint = false;
 
             const Timestamp stableTimestamp = _wiredTigerKVEngine->getStableTimestamp();
             const Timestamp initialDataTimestamp = _wiredTigerKVEngine->getInitialDataTimestamp();
@@ -383,11 +381,15 @@ public:
                 // Third, stableTimestamp >= initialDataTimestamp: Take stable checkpoint. Steady
                 // state case.
                 if (initialDataTimestamp.asULL() <= 1) {
+                    // Write out the latest collection sizes so that the checkpoint includes
+                    // counts which match its data, rather than ones up to a minute old.
+                    _wiredTigerKVEngine->syncSizeInfo(false);
                     UniqueWiredTigerSession session = _sessionCache->getSession();
                     WT_SESSION* s = session->getSession();
                     auto checkpointLock = _wiredTigerKVEngine->getCheckpointLock(opCtx.get());
                     _wiredTigerKVEngine->clearIndividuallyCheckpointedIndexesList();
                     invariantWTOK(s->checkpoint(s, "use_timestamp=false"));
+                    tookCheckpoint = true;
                 } else if (stableTimestamp < initialDataTimestamp) {
                     LOG_FOR_RECOVERY(2)
                         << "Stable timestamp is behind the initial data timestamp, skipping "
@@ -401,6 +403,7 @@ public:
                         << "Performing stable checkpoint. StableTimestamp: " << stableTimestamp
                         << ", OplogNeededForRollback: " << toString(oplogNeededForRollback);
 
+                    _wiredTigerKVEngine->syncSizeInfo(false);
                     UniqueWiredTigerSession session = _sessionCache->getSession();
                     WT_SESSION* s = session->getSession();
                     {
@@ -408,6 +411,7 @@ public:
                         _wiredTigerKVEngine->clearIndividuallyCheckpointedIndexesList();
                         invariantWTOK(s->checkpoint(s, "use_timestamp=true"));
                     }
+                    tookCheckpoint = true;
 
                     if (oplogNeededForRollback.isOK()) {
                         // Now that the checkpoint is durable, publish the oplog needed to recover
@@ -422,6 +426,9 @@ public:
                 if (secondsElapsed >= 30) {
                     LOG(1) << "Checkpoint took " << secondsElapsed << " seconds to complete.";
                 }
+                if (tookCheckpoint) {
+                    _recordCheckpoint(startTime, sampledStatsAtStart ? &statsAtStart : nullptr);
+                }
             } catch (const WriteConflictException&) {
                 // Temporary: remove this after WT-3483
                 warning() << "Checkpoint encountered a write conflict exception.";
@@ -458,6 +465,7 @@ public:
             log() << "Triggering the first stable checkpoint. Initial Data: " << initialData
                   << " PrevStable: " << prevStable << " CurrStable: " << currStable;
             stdx::unique_lock<Latch> lock(_mutex);
+            _triggerCheckpoint = true;
             _condvar.notify_one();
         }
     }
@@ -486,15 +494,142 @@ public:
         wait();
     }
 
+    void appendStats(BSONObjBuilder* builder) const {
+        builder->append("checkpoints", _numCheckpoints.load());
+        builder->append("checkpointsTriggeredByDirtyCache", _numDirtyTriggeredCheckpoints.load());
+        builder->append("lastDurationMillis", _lastCheckpointMillis.load());
+        builder->append("totalDurationMillis", _totalCheckpointMillis.load());
+        builder->append("lastDirtyBytesAtStart", _lastCheckpointDirtyBytesAtStart.load());
+        builder->append("lastBytesWritten", _lastCheckpointBytesWritten.load());
+        builder->append("totalBytesWritten", _totalCheckpointBytesWritten.load());
+        builder->append("lastWriteStallMicros", _lastCheckpointStallMicros.load());
+        builder->append("totalWriteStallMicros", _totalCheckpointStallMicros.load());
+    }
+
 private:
+    /**
+     * The cache statistics sampled around each checkpoint.
+     */
+    struct CacheStats {
+        long long bytesDirty = 0;
+        long long bytesMax = 0;
+        long long bytesWritten = 0;
+        // Time application threads spent evicting pages or waiting for room in the cache.
+        long long stallMicros = 0;
+    };
+
+    bool _sampleCacheStats(CacheStats* cacheStats) {
+        auto session = _sessionCache->getSession();
+        const auto getStat = [&](int statisticsKey, long long* value) {
+            auto swValue = WiredTigerUtil::getStatisticsValue(
+                session->getSession(), "statistics:", "", statisticsKey);
+            if (!swValue.isOK()) {
+                LOG(1) << "Failed to read the WiredTiger cache statistics: "
+                       << swValue.getStatus();
+                return false;
+            }
+            *value = swValue.getValue();
+            return true;
+        };
+        long long evictMicros = 0;
+        long long cacheWaitMicros = 0;
+        if (!getStat(WT_STAT_CONN_CACHE_BYTES_DIRTY, &cacheStats->bytesDirty) ||
+            !getStat(WT_STAT_CONN_CACHE_BYTES_MAX, &cacheStats->bytesMax) ||
+            !getStat(WT_STAT_CONN_CACHE_BYTES_WRITE, &cacheStats->bytesWritten) ||
+            !getStat(WT_STAT_CONN_APPLICATION_EVICT_TIME, &evictMicros) ||
+            !getStat(WT_STAT_CONN_APPLICATION_CACHE_TIME, &cacheWaitMicros)) {
+            return false;
+        }
+        cacheStats->stallMicros = evictMicros + cacheWaitMicros;
+        return true;
+    }
+
+    /**
+     * Waits out the checkpoint interval. Returns early if a checkpoint is triggered, the thread is
+     * shutting down, or dirty data in the cache exceeds wiredTigerCheckpointDirtyTriggerPercent.
+     */
+    void _waitForNextCheckpoint() {
+        const Date_t deadline = Date_t::now() +
+            Seconds(static_cast<std::int64_t>(wiredTigerGlobalOptions.checkpointDelaySecs));
+        while (true) {
+            const int dirtyTriggerPercent = gWiredTigerCheckpointDirtyTriggerPercent.load();
+            const Date_t wakeAt = dirtyTriggerPercent > 0
+                ? std::min(deadline, Date_t::now() + kDirtyCachePollInterval)
+                : deadline;
+            {
+                stdx::unique_lock<Latch> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                const bool woken = _condvar.wait_for(
+                    lock, (wakeAt - Date_t::now()).toSystemDuration(), [&] {
+                        return _triggerCheckpoint || _shuttingDown.load();
+                    });
+                if (woken) {
+                    _triggerCheckpoint = false;
+                    return;
+                }
+            }
+
+            if (Date_t::now() >= deadline) {
+                return;
+            }
+
+            CacheStats cacheStats;
+            if (dirtyTriggerPercent > 0 && _sampleCacheStats(&cacheStats) &&
+                cacheStats.bytesDirty * 100 > cacheStats.bytesMax * dirtyTriggerPercent) {
+                LOG(1) << "Starting a checkpoint early, " << cacheStats.bytesDirty
+                       << " bytes of the cache are dirty";
+                _numDirtyTriggeredCheckpoints.fetchAndAdd(1);
+                return;
+            }
+        }
+    }
+
+    /**
+     * Records the statistics of a checkpoint which started at 'startTime'. 'statsAtStart' is null
+     * if the cache statistics could not be read when the checkpoint started.
+     */
+    void _recordCheckpoint(Date_t startTime, const CacheStats* statsAtStart) {
+        const auto millis = durationCount<Milliseconds>(Date_t::now() - startTime);
+        _numCheckpoints.fetchAndAdd(1);
+        _lastCheckpointMillis.store(millis);
+        _totalCheckpointMillis.fetchAndAdd(millis);
+
+        CacheStats statsAtEnd;
+        if (!statsAtStart || !_sampleCacheStats(&statsAtEnd)) {
+            return;
+        }
+        const auto bytesWritten = statsAtEnd.bytesWritten - statsAtStart->bytesWritten;
+        const auto stallMicros = statsAtEnd.stallMicros - statsAtStart->stallMicros;
+        _lastCheckpointDirtyBytesAtStart.store(statsAtStart->bytesDirty);
+        _lastCheckpointBytesWritten.store(bytesWritten);
+        _totalCheckpointBytesWritten.fetchAndAdd(bytesWritten);
+        _lastCheckpointStallMicros.store(stallMicros);
+        _totalCheckpointStallMicros.fetchAndAdd(stallMicros);
+    }
+
+    // How often the dirty data in the cache is checked while waiting for the next checkpoint.
+    static constexpr Milliseconds kDirtyCachePollInterval{1000};
+
     WiredTigerKVEngine* _wiredTigerKVEngine;
     WiredTigerSessionCache* _sessionCache;
 
     Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerCheckpointThread::_mutex");
-    ;  // protects _condvar
+    ;  // protects _condvar and _triggerCheckpoint
     // The checkpoint thread idles on this condition variable for a particular time duration between
     // taking checkpoints. It can be triggered early to expediate immediate checkpointing.
     stdx::condition_variable _condvar;
+    bool _triggerCheckpoint = false;
+
+    // Statistics about the checkpoints taken by this thread, reported in serverStatus.
+    AtomicWord<long long> _numCheckpoints{0};
+    AtomicWord<long long> _numDirtyTriggeredCheckpoints{0};
+    AtomicWord<long long> _lastCheckpointMillis{0};
+    AtomicWord<long long> _totalCheckpointMillis{0};
+    AtomicWord<long long> _lastCheckpointDirtyBytesAtStart{0};
+    AtomicWord<long long> _lastCheckpointBytesWritten{0};
+    AtomicWord<long long> _totalCheckpointBytesWritten{0};
+    AtomicWord<long long> _lastCheckpointStallMicros{0};
+    AtomicWord<long long> _totalCheckpointStallMicros{0};
 
     AtomicWord<bool> _shuttingDown{false};
 
@@ -505,9 +640,97 @@ private:
     AtomicWord<std::uint64_t> _oplogNeededForCrashRecovery;
 };
 
+class WiredTigerKVEngine::WiredTigerTicketTunerThread : public BackgroundJob {
+public:
+    WiredTigerTicketTunerThread(WiredTigerSessionCache* sessionCache,
+                                WiredTigerTicketTuner* ticketTuner)
+        : BackgroundJob(false /* deleteSelf */),
+          _sessionCache(sessionCache),
+          _ticketTuner(ticketTuner) {}
+
+    virtual string name() const {
+        return "WTTicketTuner";
+    }
+
+    virtual void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        LOG(1) << "starting " << name() << " thread";
+
+        while (!_shuttingDown.load()) {
+            {
+                stdx::unique_lock<Latch> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                _condvar.wait_for(lock,
+                                  stdx::chrono::milliseconds(
+                                      gWiredTigerConcurrencyAdjustmentIntervalMillis.load()));
+            }
+
+            if (_shuttingDown.load()) {
+                break;
+            }
+            if (!gWiredTigerConcurrencyAdjustment.load()) {
+                _ticketTuner->reset();
+                continue;
+            }
+
+            WiredTigerTicketTuner::CacheStats cacheStats;
+            if (!_sampleCacheStats(&cacheStats)) {
+                _ticketTuner->reset();
+                continue;
+            }
+
+            const int minTickets = gWiredTigerConcurrentTransactionsMin.load();
+            const int maxTickets =
+                std::max(minTickets, gWiredTigerConcurrentTransactionsMax.load());
+            _ticketTuner->adjust(Date_t::now(), cacheStats, minTickets, maxTickets);
+        }
+        LOG(1) << "stopping " << name() << " thread";
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        {
+            stdx::unique_lock<Latch> lock(_mutex);
+            // Wake up the ticket tuner thread early, we do not want the shutdown to wait for us
+            // too long.
+            _condvar.notify_one();
+        }
+        wait();
+    }
+
+private:
+    bool _sampleCacheStats(WiredTigerTicketTuner::CacheStats* cacheStats) {
+        auto session = _sessionCache->getSession();
+        const auto getStat = [&](int statisticsKey, long long* value) {
+            auto swValue = WiredTigerUtil::getStatisticsValue(
+                session->getSession(), "statistics:", "", statisticsKey);
+            if (!swValue.isOK()) {
+                LOG(1) << "Failed to read the WiredTiger cache statistics: "
+                       << swValue.getStatus();
+                return false;
+            }
+            *value = swValue.getValue();
+            return true;
+        };
+        return getStat(WT_STAT_CONN_CACHE_BYTES_INUSE, &cacheStats->bytesInUse) &&
+            getStat(WT_STAT_CONN_CACHE_BYTES_MAX, &cacheStats->bytesMax) &&
+            getStat(WT_STAT_CONN_CACHE_EVICTION_APP, &cacheStats->appEvictions);
+    }
+
+    WiredTigerSessionCache* _sessionCache;
+    WiredTigerTicketTuner* _ticketTuner;
+    AtomicWord<bool> _shuttingDown{false};
+
+    Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerTicketTunerThread::_mutex");  // protects _condvar
+    // The ticket tuner thread idles on this condition variable between rounds. It can be
+    // triggered early to expediate shutdown.
+    stdx::condition_variable _condvar;
+};
+
 namespace {
 TicketHolder openWriteTransaction(128);
 TicketHolder openReadTransaction(128);
+WiredTigerTicketTuner ticketTuner(&openReadTransaction, &openWriteTransaction);
 }  // namespace
 
 OpenWriteTransactionParam::OpenWriteTransactionParam(StringData name, ServerParameterType spt)
@@ -531,6 +754,12 @@ Status OpenWriteTransactionParam::setFromString(const std::string& str) {
     return _data->resize(num);
 }
 
+Status onUpdateWiredTigerTicketPrioritization(const bool& prioritized) {
+    openWriteTransaction.setPrioritized(prioritized);
+    openReadTransaction.setPrioritized(prioritized);
+    return Status::OK();
+}
+
 OpenReadTransactionParam::OpenReadTransactionParam(StringData name, ServerParameterType spt)
     : ServerParameter(name, spt), _data(&openReadTransaction) {}
 
@@ -728,6 +957,13 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sessionSweeper = std::make_unique<WiredTigerSessionSweeper>(_sessionCache.get());
     _sessionSweeper->go();
 
+    // The ticket pools outlive the engine, but the rounds of a previous engine say nothing about
+    // this one.
+    ticketTuner.reset();
+    _ticketTunerThread =
+        std::make_unique<WiredTigerTicketTunerThread>(_sessionCache.get(), &ticketTuner);
+    _ticketTunerThread->go();
+
     // Until the Replication layer installs a real callback, prevent truncating the oplog.
     setOldestActiveTransactionTimestampCallback(
         [](Timestamp) { return StatusWith(boost::make_optional(Timestamp::min())); });
@@ -784,6 +1020,14 @@ void WiredTigerKVEngine::startAsyncThreads() {
     }
 }
 
+void WiredTigerKVEngine::appendCheckpointStats(BSONObjBuilder* builder) const {
+    if (!_checkpointThread) {
+        return;
+    }
+    BSONObjBuilder checkpointBuilder(builder->subobjStart("checkpointThread"));
+    _checkpointThread->appendStats(&checkpointBuilder);
+}
+
 void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
     BSONObjBuilder bb(b.subobjStart("concurrentTransactions"));
     {
@@ -791,6 +1035,7 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openWriteTransaction.used());
         bbb.append("available", openWriteTransaction.available());
         bbb.append("totalTickets", openWriteTransaction.outof());
+        openWriteTransaction.appendQueueStats(&bbb);
         bbb.done();
     }
     {
@@ -798,6 +1043,13 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openReadTransaction.used());
         bbb.append("available", openReadTransaction.available());
         bbb.append("totalTickets", openReadTransaction.outof());
+        openReadTransaction.appendQueueStats(&bbb);
+        bbb.done();
+    }
+    {
+        BSONObjBuilder bbb(bb.subobjStart("adjustment"));
+        bbb.append("enabled", gWiredTigerConcurrencyAdjustment.load());
+        ticketTuner.appendStats(&bbb);
         bbb.done();
     }
     bb.done();
@@ -879,6 +1131,11 @@ void WiredTigerKVEngine::cleanShutdown() {
         _sessionSweeper->shutdown();
         log() << "Finished shutting down session sweeper thread";
     }
+    if (_ticketTunerThread) {
+        log() << "Shutting down ticket tuner thread";
+        _ticketTunerThread->shutdown();
+        log() << "Finished shutting down ticket tuner thread";
+    }
     if (_journalFlusher) {
         log() << "Shutting down journal flusher thread";
         _journalFlusher->shutdown();
@@ -1309,6 +1566,8 @@ std::unique_ptr<RecordStore> WiredTigerKVEngine::getGroupedRecordStore(
     params.sizeStorer = _sizeStorer.get();
     params.isReadOnly = _readOnly;
     params.tracksSizeAdjustments = true;
+    params.cachePriority = uassertStatusOK(WiredTigerRecordStore::parseCachePriority(
+        options.storageEngine.getObjectField(_canonicalName)));
 
     params.cappedMaxSize = -1;
     if (options.capped) {
@@ -304,6 +304,11 @@ public:
 
     static void appendGlobalStats(BSONObjBuilder& b);
 
+    /**
+     * Appends statistics about the checkpoints taken by the checkpoint thread, if it is running.
+     */
+    void appendCheckpointStats(BSONObjBuilder* builder) const;
+
     Timestamp getStableTimestamp() const override;
     Timestamp getOldestTimestamp() const override;
     Timestamp getCheckpointTimestamp() const override;
@@ -369,6 +374,7 @@ private:
     class WiredTigerSessionSweeper;
     class WiredTigerJournalFlusher;
     class WiredTigerCheckpointThread;
+    class WiredTigerTicketTunerThread;
 
     /**
      * Opens a connection on the WiredTiger database 'path' with the configuration 'wtOpenConfig'.
@@ -459,6 +465,7 @@ private:
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
     std::unique_ptr<WiredTigerJournalFlusher> _journalFlusher;  // Depends on _sizeStorer
     std::unique_ptr<WiredTigerCheckpointThread> _checkpointThread;
+    std::unique_ptr<WiredTigerTicketTunerThread> _ticketTunerThread;
 
     std::string _rsOptions;
     std::string _indexOptions;
@@ -495,4 +502,10 @@ private:
     // Access must be protected by the CheckpointLock.
     std::list<std::string> _checkpointedIndexes;
 };
+
+/**
+ * Makes operations waiting for WiredTiger read and write tickets queue by priority, or not.
+ */
+Status onUpdateWiredTigerTicketPrioritization(const bool& prioritized);
+
 }  // namespace mongo
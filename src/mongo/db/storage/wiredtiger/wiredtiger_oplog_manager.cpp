@@ -31,6 +31,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "mongo/db/concurrency/lock_state.h"
@@ -75,11 +76,13 @@ void WiredTigerOplogManager::start(OperationContext* opCtx,
     // Need to obtain the mutex before starting the thread, as otherwise it may race ahead
     // see _shuttingDown as true and quit prematurely.
     stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
-    _oplogJournalThread = stdx::thread(&WiredTigerOplogManager::_oplogJournalThreadLoop,
-                                       this,
-                                       WiredTigerRecoveryUnit::get(opCtx)->getSessionCache(),
-                                       oplogRecordStore);
+    auto sessionCache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
+    _oplogJournalThread = stdx::thread(
+        &WiredTigerOplogManager::_oplogJournalThreadLoop, this, sessionCache, oplogRecordStore);
 
+    _sessionCache = sessionCache;
+    _oplogRecordStore = oplogRecordStore;
+    _publishVisibilityOnCommit = sessionCache->isEphemeral();
     _isRunning = true;
     _shuttingDown = false;
 }
@@ -90,6 +93,8 @@ void WiredTigerOplogManager::halt() {
         invariant(_isRunning);
         _shuttingDown = true;
         _isRunning = false;
+        _sessionCache = nullptr;
+        _oplogRecordStore = nullptr;
     }
 
     if (_oplogJournalThread.joinable()) {
@@ -127,6 +132,10 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     invariant(_opsWaitingForVisibility > 0);
     auto exitGuard = makeGuard([&] { _opsWaitingForVisibility--; });
 
+    // Wake the oplogJournal thread if it is delaying a journal flush, rather than leaving it to
+    // notice this waiter on its next poll.
+    _opsWaitingForJournalCV.notify_one();
+
     opCtx->waitForConditionOrInterrupt(_opsBecameVisibleCV, lk, [&] {
         auto newLatestVisibleTimestamp = getOplogReadTimestamp();
         if (newLatestVisibleTimestamp < currentLatestVisibleTimestamp) {
@@ -149,12 +158,56 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
 
 void WiredTigerOplogManager::triggerJournalFlush() {
     stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+    _triggerJournalFlush(lk);
+}
+
+void WiredTigerOplogManager::_triggerJournalFlush(WithLock) {
     if (!_opsWaitingForJournal) {
         _opsWaitingForJournal = true;
         _opsWaitingForJournalCV.notify_one();
     }
 }
 
+void WiredTigerOplogManager::registerPendingOplogWrite(Timestamp ts) {
+    _visibilityTracker.registerWrite(ts);
+}
+
+void WiredTigerOplogManager::completePendingOplogWrite(Timestamp ts) {
+    _visibilityTracker.completeWrite(ts);
+
+    // Refresh visibility whether the write committed or aborted. A reservation may stand in for
+    // oplog entries written by another, untracked unit of work: prepared transactions reserve the
+    // slots of their prepare, commit and abort entries in a side transaction which always aborts.
+    WiredTigerSessionCache* sessionCache;
+    {
+        stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+        if (!_isRunning || !_publishVisibilityOnCommit) {
+            // Oplog entries must be durable before they become visible.
+            _triggerJournalFlush(lk);
+            return;
+        }
+        sessionCache = _sessionCache;
+    }
+
+    // WiredTiger's all_durable timestamp accounts for every write it knows of, but a write may
+    // reserve its timestamp before telling WiredTiger about it, so stay behind any tracked write
+    // still in flight.
+    uint64_t newTimestamp = fetchAllDurableValue(sessionCache->conn());
+    if (auto earliestPendingWrite = _visibilityTracker.getEarliestPendingWrite()) {
+        newTimestamp = std::min(newTimestamp, earliestPendingWrite->asULL() - 1);
+    }
+
+    stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+    if (!_isRunning || newTimestamp <= getOplogReadTimestamp()) {
+        return;
+    }
+    _setOplogReadTimestamp(lk, newTimestamp);
+
+    // Wake up any await_data cursors and tell them more data might be visible now. This is done
+    // under the mutex, as the oplog record store may go away once the manager is halted.
+    _oplogRecordStore->notifyCappedWaitersIfNeeded();
+}
+
 void WiredTigerOplogManager::_oplogJournalThreadLoop(WiredTigerSessionCache* sessionCache,
                                                      WiredTigerRecordStore* oplogRecordStore) {
     Client::initThread("WTOplogJournalThread");
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/storage/wiredtiger/wiredtiger_oplog_visibility_tracker.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
@@ -41,8 +42,11 @@ class WiredTigerRecordStore;
 class WiredTigerSessionCache;
 
 
-// Manages oplog visibility, by periodically querying WiredTiger's all_durable timestamp value and
-// then using that timestamp for all transactions that read the oplog collection.
+// Manages oplog visibility, by querying WiredTiger's all_durable timestamp value and then using
+// that timestamp for all transactions that read the oplog collection. Visibility is refreshed when
+// an oplog write in flight on a primary completes: directly by the completing thread if the
+// storage engine is ephemeral, and otherwise by a background thread which first makes the writes
+// durable.
 class WiredTigerOplogManager {
     WiredTigerOplogManager(const WiredTigerOplogManager&) = delete;
     WiredTigerOplogManager& operator=(const WiredTigerOplogManager&) = delete;
@@ -73,6 +77,14 @@ public:
     // Triggers the oplogJournal thread to update its oplog read timestamp, by flushing the journal.
     void triggerJournalFlush();
 
+    // Records that the current transaction will write oplog entries starting at 'ts', which may
+    // commit out of order with respect to other oplog writes.
+    void registerPendingOplogWrite(Timestamp ts);
+
+    // Records that the transaction which registered 'ts' has committed or aborted, and refreshes
+    // the oplog read timestamp.
+    void completePendingOplogWrite(Timestamp ts);
+
     // Waits until all committed writes at this point to become visible (that is, no holes exist in
     // the oplog.)
     void waitForAllEarlierOplogWritesToBeVisible(const WiredTigerRecordStore* oplogRecordStore,
@@ -88,6 +100,8 @@ private:
 
     void _setOplogReadTimestamp(WithLock, uint64_t newTimestamp);
 
+    void _triggerJournalFlush(WithLock);
+
     stdx::thread _oplogJournalThread;
     mutable Mutex _oplogVisibilityStateMutex =
         MONGO_MAKE_LATCH("WiredTigerOplogManager::_oplogVisibilityStateMutex");
@@ -104,6 +118,16 @@ private:
     // journal flushing should not be delayed.
     std::int64_t _opsWaitingForVisibility = 0;  // Guarded by oplogVisibilityStateMutex.
 
+    // Set while running. Guarded by oplogVisibilityStateMutex.
+    WiredTigerSessionCache* _sessionCache = nullptr;
+    WiredTigerRecordStore* _oplogRecordStore = nullptr;
+
+    // True if oplog entries may become visible as soon as they commit, because the storage engine
+    // is ephemeral and there is no journal to wait for. Guarded by oplogVisibilityStateMutex.
+    bool _publishVisibilityOnCommit = false;
+
+    WiredTigerOplogVisibilityTracker _visibilityTracker;
+
     AtomicWord<unsigned long long> _oplogReadTimestamp;
 };
 }  // namespace mongo
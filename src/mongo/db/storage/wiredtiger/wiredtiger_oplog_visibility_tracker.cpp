@@ -0,0 +1,62 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_oplog_visibility_tracker.h"
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+void WiredTigerOplogVisibilityTracker::registerWrite(Timestamp ts) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    invariant(_pendingWrites.insert(ts).second);
+}
+
+void WiredTigerOplogVisibilityTracker::completeWrite(Timestamp ts) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    invariant(_pendingWrites.erase(ts) == 1);
+}
+
+boost::optional<Timestamp> WiredTigerOplogVisibilityTracker::getEarliestPendingWrite() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_pendingWrites.empty()) {
+        return boost::none;
+    }
+    return *_pendingWrites.begin();
+}
+
+size_t WiredTigerOplogVisibilityTracker::numPendingWrites() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _pendingWrites.size();
+}
+
+}  // namespace mongo
@@ -0,0 +1,80 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <set>
+
+#include "mongo/bson/timestamp.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+
+/**
+ * Tracks the oplog writes of primaries which are in flight, that is, whose timestamps have been
+ * reserved but whose transactions have not yet committed or aborted. Timestamps are reserved in
+ * increasing order, but the writes may complete in any order, so the oplog may have "holes" at and
+ * after the earliest pending write. Oplog visibility must not advance past such a hole, even when
+ * WiredTiger's all_durable timestamp does, since a transaction may reserve its timestamp before it
+ * tells WiredTiger about it.
+ */
+class WiredTigerOplogVisibilityTracker {
+    WiredTigerOplogVisibilityTracker(const WiredTigerOplogVisibilityTracker&) = delete;
+    WiredTigerOplogVisibilityTracker& operator=(const WiredTigerOplogVisibilityTracker&) = delete;
+
+public:
+    WiredTigerOplogVisibilityTracker() = default;
+
+    /**
+     * Records that a transaction will write oplog entries starting at 'ts'.
+     */
+    void registerWrite(Timestamp ts);
+
+    /**
+     * Records that the transaction which registered 'ts' has committed or aborted.
+     */
+    void completeWrite(Timestamp ts);
+
+    /**
+     * Returns the first timestamp of the earliest write in flight, if any.
+     */
+    boost::optional<Timestamp> getEarliestPendingWrite() const;
+
+    size_t numPendingWrites() const;
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerOplogVisibilityTracker::_mutex");
+
+    // The first timestamps of the writes in flight.
+    std::set<Timestamp> _pendingWrites;
+};
+
+}  // namespace mongo
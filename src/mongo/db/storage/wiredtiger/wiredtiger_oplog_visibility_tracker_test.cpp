@@ -0,0 +1,83 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_oplog_visibility_tracker.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(WiredTigerOplogVisibilityTrackerTest, NoPendingWritesUntilAWriteRegisters) {
+    WiredTigerOplogVisibilityTracker tracker;
+    ASSERT_FALSE(tracker.getEarliestPendingWrite());
+
+    tracker.registerWrite(Timestamp(1, 1));
+    ASSERT_EQ(tracker.getEarliestPendingWrite(), Timestamp(1, 1));
+    ASSERT_EQ(tracker.numPendingWrites(), 1U);
+
+    tracker.completeWrite(Timestamp(1, 1));
+    ASSERT_FALSE(tracker.getEarliestPendingWrite());
+    ASSERT_EQ(tracker.numPendingWrites(), 0U);
+}
+
+TEST(WiredTigerOplogVisibilityTrackerTest, EarliestPendingWriteHoldsBackLaterCompletions) {
+    WiredTigerOplogVisibilityTracker tracker;
+    tracker.registerWrite(Timestamp(1, 1));
+    tracker.registerWrite(Timestamp(1, 2));
+    tracker.registerWrite(Timestamp(1, 3));
+
+    // Completing a write behind a pending one leaves the hole in place.
+    tracker.completeWrite(Timestamp(1, 2));
+    ASSERT_EQ(tracker.getEarliestPendingWrite(), Timestamp(1, 1));
+
+    tracker.completeWrite(Timestamp(1, 1));
+    ASSERT_EQ(tracker.getEarliestPendingWrite(), Timestamp(1, 3));
+
+    tracker.completeWrite(Timestamp(1, 3));
+    ASSERT_FALSE(tracker.getEarliestPendingWrite());
+}
+
+TEST(WiredTigerOplogVisibilityTrackerTest, LaterRegistrationDoesNotMoveEarliestPendingWrite) {
+    WiredTigerOplogVisibilityTracker tracker;
+    tracker.registerWrite(Timestamp(1, 5));
+    tracker.registerWrite(Timestamp(1, 10));
+    ASSERT_EQ(tracker.getEarliestPendingWrite(), Timestamp(1, 5));
+
+    tracker.completeWrite(Timestamp(1, 5));
+    tracker.registerWrite(Timestamp(1, 11));
+    ASSERT_EQ(tracker.getEarliestPendingWrite(), Timestamp(1, 10));
+    ASSERT_EQ(tracker.numPendingWrites(), 2U);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -33,6 +33,7 @@
 #include "mongo/db/prepare_conflict_tracker.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
+#include "mongo/db/wait_events.h"
 #include "mongo/util/fail_point.h"
 
 namespace mongo {
@@ -120,9 +121,13 @@ int wiredTigerPrepareConflictRetry(OperationContext* opCtx, F&& f) {
         return WT_ROLLBACK;
     }
 
+    // Only prepared units of work at or before the read timestamp can conflict with the read, so
+    // the retries only wait for those to end.
+    const auto readTimestamp = recoveryUnit->getPointInTimeReadTimestamp();
     while (true) {
         attempts++;
-        auto lastCount = recoveryUnit->getSessionCache()->getPrepareCommitOrAbortCount();
+        WiredTigerSessionCache::PrepareConflictWaiter waiter(recoveryUnit->getSessionCache(),
+                                                             readTimestamp);
         // If the failpoint is enabled, don't call the function, just simulate a conflict.
         ret = MONGO_unlikely(WTPrepareConflictForReads.shouldFail()) ? WT_PREPARE_CONFLICT
                                                                      : WT_READ_CHECK(f());
@@ -134,8 +139,8 @@ int wiredTigerPrepareConflictRetry(OperationContext* opCtx, F&& f) {
         wiredTigerPrepareConflictLog(attempts);
 
         // Wait on the session cache to signal that a unit of work has been committed or aborted.
-        recoveryUnit->getSessionCache()->waitUntilPreparedUnitOfWorkCommitsOrAborts(opCtx,
-                                                                                    lastCount);
+        ScopedWaitEvent waitEvent(opCtx, WaitEvent::kPrepareConflict);
+        waiter.wait(opCtx);
     }
 }
 }  // namespace mongo
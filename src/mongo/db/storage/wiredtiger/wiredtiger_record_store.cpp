@@ -225,19 +225,40 @@ void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
 }
 
 boost::optional<WiredTigerRecordStore::OplogStones::Stone>
-WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
+WiredTigerRecordStore::OplogStones::peekOldestStonesIfNeeded(Timestamp mayTruncateUpTo,
+                                                             size_t* numStones) const {
     stdx::lock_guard<Latch> lk(_mutex);
 
-    if (!hasExcessStones_inlock()) {
-        return {};
+    int64_t totalBytes = 0;
+    for (const auto& stone : _stones) {
+        totalBytes += stone.bytes;
     }
 
-    return _stones.front();
+    boost::optional<Stone> range;
+    *numStones = 0;
+    for (const auto& stone : _stones) {
+        invariant(stone.lastRecord.isValid());
+        if (totalBytes <= _rs->cappedMaxSize() ||
+            static_cast<std::uint64_t>(stone.lastRecord.repr()) >= mayTruncateUpTo.asULL()) {
+            break;
+        }
+
+        if (!range) {
+            range = Stone{0, 0, RecordId()};
+        }
+        range->records += stone.records;
+        range->bytes += stone.bytes;
+        range->lastRecord = stone.lastRecord;
+        totalBytes -= stone.bytes;
+        ++*numStones;
+    }
+    return range;
 }
 
-void WiredTigerRecordStore::OplogStones::popOldestStone() {
+void WiredTigerRecordStore::OplogStones::popOldestStones(size_t numStones) {
     stdx::lock_guard<Latch> lk(_mutex);
-    _stones.pop_front();
+    invariant(numStones <= _stones.size());
+    _stones.erase(_stones.begin(), _stones.begin() + numStones);
 }
 
 void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(RecordId lastRecord) {
@@ -490,6 +511,31 @@ void WiredTigerRecordStore::OplogStones::adjust(int64_t maxSize) {
     _pokeReclaimThreadIfNeeded();
 }
 
+StatusWith<WiredTigerRecordStore::CachePriority> WiredTigerRecordStore::parseCachePriority(
+    const BSONObj& options) {
+    BSONElement elem = options[kCachePriorityFieldName];
+    if (elem.eoo()) {
+        return CachePriority::kNormal;
+    }
+    if (elem.type() != String) {
+        return {ErrorCodes::TypeMismatch,
+                str::stream() << '\'' << kCachePriorityFieldName << "' must be a string."};
+    }
+
+    StringData priority = elem.valueStringData();
+    if (priority == "low"_sd) {
+        return CachePriority::kLow;
+    } else if (priority == "normal"_sd) {
+        return CachePriority::kNormal;
+    } else if (priority == "high"_sd) {
+        return CachePriority::kHigh;
+    }
+    return {ErrorCodes::InvalidOptions,
+            str::stream() << '\'' << kCachePriorityFieldName
+                          << "' must be one of \"low\", \"normal\" or \"high\", but got \""
+                          << priority << '"'};
+}
+
 StatusWith<std::string> WiredTigerRecordStore::parseOptionsField(const BSONObj options) {
     StringBuilder ss;
     BSONForEach(elem, options) {
@@ -499,6 +545,14 @@ StatusWith<std::string> WiredTigerRecordStore::parseOptionsField(const BSONObj o
                 return status;
             }
             ss << elem.valueStringData() << ',';
+        } else if (elem.fieldNameStringData() == kCachePriorityFieldName) {
+            auto cachePriority = parseCachePriority(options);
+            if (!cachePriority.isOK()) {
+                return cachePriority.getStatus();
+            }
+            if (cachePriority.getValue() == CachePriority::kHigh) {
+                ss << "cache_resident=true,";
+            }
         } else {
             // Return error on first unrecognized field.
             return StatusWith<std::string>(ErrorCodes::InvalidOptions,
@@ -682,7 +736,8 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
       _cappedDeleteCheckCount(0),
       _sizeStorer(params.sizeStorer),
       _tracksSizeAdjustments(params.tracksSizeAdjustments),
-      _kvEngine(kvEngine) {
+      _kvEngine(kvEngine),
+      _cachePriority(params.cachePriority) {
     invariant(_ident.size() > 0);
 
     Status versionStatus = WiredTigerUtil::checkApplicationMetadataFormatVersion(
@@ -850,6 +905,16 @@ int64_t WiredTigerRecordStore::storageSize(OperationContext* opCtx,
     return size;
 }
 
+int64_t WiredTigerRecordStore::freeStorageSize(OperationContext* opCtx) const {
+    dassert(opCtx->lockState()->isReadLocked());
+
+    if (_isEphemeral) {
+        return 0;
+    }
+    WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSessionNoTxn();
+    return WiredTigerUtil::getIdentReuseSize(session->getSession(), getURI());
+}
+
 // Retrieve the value from a positioned cursor.
 RecordData WiredTigerRecordStore::_getData(const WiredTigerCursor& cursor) const {
     WT_ITEM value;
@@ -1201,17 +1266,14 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx) {
 
 void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayTruncateUpTo) {
     Timer timer;
-    while (auto stone = _oplogStones->peekOldestStoneIfNeeded()) {
-        invariant(stone->lastRecord.isValid());
-
-        if (static_cast<std::uint64_t>(stone->lastRecord.repr()) >= mayTruncateUpTo.asULL()) {
-            // Do not truncate oplogs needed for replication recovery.
-            return;
-        }
-
+    // Every stone that can be removed is removed by one truncate of the range of records from the
+    // start of the oplog to the last record of the newest of them, rather than one per stone.
+    size_t numStones = 0;
+    while (auto stones = _oplogStones->peekOldestStonesIfNeeded(mayTruncateUpTo, &numStones)) {
         LOG(1) << "Truncating the oplog between " << _oplogStones->firstRecord << " and "
-               << stone->lastRecord << " to remove approximately " << stone->records
-               << " records totaling to " << stone->bytes << " bytes";
+               << stones->lastRecord << " to remove approximately " << stones->records
+               << " records totaling to " << stones->bytes << " bytes in " << numStones
+               << " stones";
 
         WiredTigerRecoveryUnit* ru = WiredTigerRecoveryUnit::get(opCtx);
         WT_SESSION* session = ru->getSession()->getSession();
@@ -1226,23 +1288,23 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
             int ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return cursor->next(cursor); });
             invariantWTOK(ret);
             RecordId firstRecord = getKey(cursor);
-            if (firstRecord < _oplogStones->firstRecord || firstRecord > stone->lastRecord) {
+            if (firstRecord < _oplogStones->firstRecord || firstRecord > stones->lastRecord) {
                 warning() << "First oplog record " << firstRecord << " is not in truncation range ("
-                          << _oplogStones->firstRecord << ", " << stone->lastRecord << ")";
+                          << _oplogStones->firstRecord << ", " << stones->lastRecord << ")";
             }
 
-            setKey(cursor, stone->lastRecord);
+            setKey(cursor, stones->lastRecord);
             invariantWTOK(session->truncate(session, nullptr, nullptr, cursor, nullptr));
-            _changeNumRecords(opCtx, -stone->records);
-            _increaseDataSize(opCtx, -stone->bytes);
+            _changeNumRecords(opCtx, -stones->records);
+            _increaseDataSize(opCtx, -stones->bytes);
 
             wuow.commit();
 
-            // Remove the stone after a successful truncation.
-            _oplogStones->popOldestStone();
+            // Remove the stones after a successful truncation.
+            _oplogStones->popOldestStones(numStones);
 
             // Stash the truncate point for next time to cleanly skip over tombstones, etc.
-            _oplogStones->firstRecord = stone->lastRecord;
+            _oplogStones->firstRecord = stones->lastRecord;
         } catch (const WriteConflictException&) {
             LOG(1) << "Caught WriteConflictException while truncating oplog entries, retrying";
         }
@@ -1342,6 +1404,105 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
     return Status::OK();
 }
 
+/**
+ * Loads records into an empty table through a WiredTiger bulk cursor, which skips the transaction
+ * and update machinery of a regular cursor. Writes through a bulk cursor cannot be rolled back, so
+ * records are buffered until the WriteUnitOfWork that inserted them commits.
+ */
+class WiredTigerRecordStore::BulkInserter final : public BulkRecordInserter {
+public:
+    BulkInserter(WiredTigerRecordStore* rs, UniqueWiredTigerSession session, WT_CURSOR* cursor)
+        : _rs(rs), _session(std::move(session)), _cursor(cursor) {}
+
+    ~BulkInserter() {
+        invariant(_pending.empty());
+        _cursor->close(_cursor);
+    }
+
+    StatusWith<RecordId> insertRecord(OperationContext* opCtx, const char* data, int len) final {
+        invariant(opCtx->lockState()->inAWriteUnitOfWork());
+        if (_pending.empty()) {
+            opCtx->recoveryUnit()->registerChange(std::make_unique<PendingRecordsChange>(this));
+        }
+
+        // RecordIds are assigned in increasing order, which the bulk cursor requires.
+        RecordId id = _rs->_nextId(opCtx);
+        _pending.emplace_back(id, std::string(data, len));
+        return id;
+    }
+
+private:
+    class PendingRecordsChange : public RecoveryUnit::Change {
+    public:
+        PendingRecordsChange(BulkInserter* inserter) : _inserter(inserter) {}
+
+        void commit(boost::optional<Timestamp>) final {
+            _inserter->_writePending();
+        }
+
+        void rollback() final {
+            _inserter->_pending.clear();
+        }
+
+    private:
+        BulkInserter* _inserter;
+    };
+
+    void _writePending() {
+        int64_t totalLength = 0;
+        for (auto&& record : _pending) {
+            _rs->setKey(_cursor, record.first);
+            WiredTigerItem value(record.second.data(), record.second.size());
+            _cursor->set_value(_cursor, value.Get());
+            invariantWTOK(_cursor->insert(_cursor));
+            totalLength += record.second.size();
+        }
+
+        // The writes are already durable in the table, so the size changes must not be rolled
+        // back with any later unit of work.
+        _rs->_changeNumRecords(nullptr, _pending.size());
+        _rs->_increaseDataSize(nullptr, totalLength);
+        _pending.clear();
+    }
+
+    WiredTigerRecordStore* const _rs;
+    UniqueWiredTigerSession _session;
+    WT_CURSOR* const _cursor;
+
+    // Records inserted in the current WriteUnitOfWork, in RecordId order.
+    std::vector<std::pair<RecordId, std::string>> _pending;
+};
+
+std::unique_ptr<BulkRecordInserter> WiredTigerRecordStore::makeBulkInserter(
+    OperationContext* opCtx) {
+    if (_isCapped || _isOplog || numRecords(opCtx) != 0) {
+        return nullptr;
+    }
+
+    // Initialize the next RecordId before opening the bulk cursor, since doing so reads the table
+    // through a regular cursor.
+    _initNextIdIfNeeded(opCtx);
+
+    // Open cursors can cause bulk open_cursor to fail with EBUSY.
+    WiredTigerRecoveryUnit::get(opCtx)->getSession()->closeAllCursors(_uri);
+
+    // Use a different session to ensure we don't hijack an existing transaction, and fail quickly
+    // rather than wait on a checkpoint to complete.
+    UniqueWiredTigerSession session =
+        WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->getSession();
+    WT_SESSION* wtSession = session->getSession();
+    WT_CURSOR* cursor;
+    int ret = wtSession->open_cursor(
+        wtSession, _uri.c_str(), nullptr, "bulk,checkpoint_wait=false", &cursor);
+    if (ret) {
+        LOG(1) << "Unable to open a WiredTiger bulk cursor on " << _uri << ", falling back to "
+               << "regular inserts: " << wiredtiger_strerror(ret);
+        return nullptr;
+    }
+
+    return std::make_unique<BulkInserter>(this, std::move(session), cursor);
+}
+
 bool WiredTigerRecordStore::isOpHidden_forTest(const RecordId& id) const {
     invariant(id.repr() > 0);
     invariant(_kvEngine->getOplogManager()->isRunning());
@@ -1495,6 +1656,14 @@ std::unique_ptr<RecordCursor> WiredTigerRecordStore::getRandomCursor(
     return getRandomCursorWithOptions(opCtx, extraConfig);
 }
 
+std::unique_ptr<RecordCursor> WiredTigerRecordStore::getBlockSamplingCursor(
+    OperationContext* opCtx, long long numSamples) const {
+    // With next_random_sample_size, WiredTiger splits the table into that many equally sized
+    // pieces and returns a record from each of them in turn.
+    const std::string extraConfig = str::stream() << "next_random_sample_size=" << numSamples;
+    return getRandomCursorWithOptions(opCtx, extraConfig);
+}
+
 Status WiredTigerRecordStore::truncate(OperationContext* opCtx) {
     WiredTigerCursor startWrap(_uri, _tableId, true, opCtx);
     WT_CURSOR* start = startWrap.get();
@@ -1611,6 +1780,20 @@ void WiredTigerRecordStore::appendCustomStats(OperationContext* opCtx,
         bob.append("code", static_cast<int>(status.code()));
         bob.append("reason", status.reason());
     }
+
+    // Report how well the data compresses, counting only the file blocks that are in use.
+    if (!_isEphemeral) {
+        auto fileSize = WiredTigerUtil::getStatisticsValue(
+            s, "statistics:" + getURI(), "statistics=(size)", WT_STAT_DSRC_BLOCK_SIZE);
+        auto reusableSize = WiredTigerUtil::getStatisticsValue(
+            s, "statistics:" + getURI(), "statistics=(fast)", WT_STAT_DSRC_BLOCK_REUSE_BYTES);
+        if (fileSize.isOK() && reusableSize.isOK() &&
+            fileSize.getValue() > reusableSize.getValue()) {
+            bob.append("compressionRatio",
+                       static_cast<double>(dataSize(opCtx)) /
+                           (fileSize.getValue() - reusableSize.getValue()));
+        }
+    }
 }
 
 void WiredTigerRecordStore::waitForAllEarlierOplogWritesToBeVisible(OperationContext* opCtx) const {
@@ -1732,7 +1915,8 @@ void WiredTigerRecordStore::_changeNumRecords(OperationContext* opCtx, int64_t d
         return;
     }
 
-    opCtx->recoveryUnit()->registerChange(std::make_unique<NumRecordsChange>(this, diff));
+    if (opCtx)
+        opCtx->recoveryUnit()->registerChange(std::make_unique<NumRecordsChange>(this, diff));
     if (_sizeInfo->numRecords.fetchAndAdd(diff) < 0)
         _sizeInfo->numRecords.store(std::max(diff, int64_t(0)));
 }
@@ -1769,6 +1953,32 @@ void WiredTigerRecordStore::_increaseDataSize(OperationContext* opCtx, int64_t a
         _sizeStorer->store(_uri, _sizeInfo);
 }
 
+bool WiredTigerRecordStore::appendCacheStats(OperationContext* opCtx,
+                                             BSONObjBuilder* result,
+                                             double scale) const {
+    WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSessionNoTxn();
+    Status status =
+        WiredTigerUtil::appendCacheStats(session->getSession(), getURI(), scale, result);
+    if (!status.isOK()) {
+        result->append("error", "unable to retrieve cache statistics");
+        result->append("code", static_cast<int>(status.code()));
+        result->append("reason", status.reason());
+    }
+
+    switch (_cachePriority) {
+        case CachePriority::kLow:
+            result->append(kCachePriorityFieldName, "low");
+            break;
+        case CachePriority::kNormal:
+            result->append(kCachePriorityFieldName, "normal");
+            break;
+        case CachePriority::kHigh:
+            result->append(kCachePriorityFieldName, "high");
+            break;
+    }
+    return true;
+}
+
 void WiredTigerRecordStore::cappedTruncateAfter(OperationContext* opCtx,
                                                 RecordId end,
                                                 bool inclusive) {
@@ -1862,6 +2072,10 @@ Status WiredTigerRecordStore::oplogDiskLocRegister(OperationContext* opCtx,
                                                    bool orderedCommit) {
     opCtx->recoveryUnit()->setOrderedCommit(orderedCommit);
     if (!orderedCommit) {
+        // Callers reserve oplog timestamps in increasing order and register them before releasing
+        // the reservation, so the oplog manager knows of every hole in the oplog.
+        WiredTigerRecoveryUnit::get(opCtx)->trackPendingOplogWrite(ts);
+
         // This labels the current transaction with a timestamp.
         // This is required for oplog visibility to work correctly, as WiredTiger uses the
         // transaction list to determine where there are holes in the oplog.
@@ -1882,7 +2096,11 @@ WiredTigerRecordStoreCursorBase::WiredTigerRecordStoreCursorBase(OperationContex
     if (_rs._isOplog) {
         _oplogVisibleTs = WiredTigerRecoveryUnit::get(opCtx)->getOplogVisibilityTs();
     }
-    _cursor.emplace(rs.getURI(), rs.tableId(), true, opCtx);
+    _cursor.emplace(rs.getURI(),
+                    rs.tableId(),
+                    true,
+                    opCtx,
+                    _rs._cachePriority == WiredTigerRecordStore::CachePriority::kLow);
 }
 
 boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
@@ -1993,7 +2211,11 @@ bool WiredTigerRecordStoreCursorBase::restore() {
     }
 
     if (!_cursor)
-        _cursor.emplace(_rs.getURI(), _rs.tableId(), true, _opCtx);
+        _cursor.emplace(_rs.getURI(),
+                        _rs.tableId(),
+                        true,
+                        _opCtx,
+                        _rs._cachePriority == WiredTigerRecordStore::CachePriority::kLow);
 
     // This will ensure an active session exists, so any restored cursors will bind to it
     invariant(WiredTigerRecoveryUnit::get(_opCtx)->getSession() == _cursor->getSession());
@@ -77,6 +77,23 @@ class WiredTigerRecordStore : public RecordStore {
     friend class PrefixedWiredTigerRecordStore;
 
 public:
+    /**
+     * How the pages of a collection should be treated by the cache, set by the 'cachePriority'
+     * field of its WiredTiger storage engine options. The pages of a "high" priority collection are
+     * never evicted, and pages read from disk by the cursors of a "low" priority collection are
+     * evicted before those of other collections.
+     */
+    enum class CachePriority { kLow, kNormal, kHigh };
+
+    static constexpr StringData kCachePriorityFieldName = "cachePriority"_sd;
+
+    /**
+     * Returns the cache priority requested by 'options', or kNormal if there is none. The document
+     * 'options' is typically obtained from the 'wiredTiger' field of
+     * CollectionOptions::storageEngine.
+     */
+    static StatusWith<CachePriority> parseCachePriority(const BSONObj& options);
+
     /**
      * Parses collections options for wired tiger configuration string for table creation.
      * The document 'options' is typically obtained from the 'wiredTiger' field of
@@ -114,6 +131,7 @@ public:
         WiredTigerSizeStorer* sizeStorer;
         bool isReadOnly;
         bool tracksSizeAdjustments;
+        CachePriority cachePriority = CachePriority::kNormal;
     };
 
     WiredTigerRecordStore(WiredTigerKVEngine* kvEngine, OperationContext* opCtx, Params params);
@@ -137,6 +155,8 @@ public:
                                 BSONObjBuilder* extraInfo = nullptr,
                                 int infoLevel = 0) const;
 
+    virtual int64_t freeStorageSize(OperationContext* opCtx) const;
+
     // CRUD related
 
     virtual bool findRecord(OperationContext* opCtx, const RecordId& id, RecordData* out) const;
@@ -147,6 +167,8 @@ public:
                                  std::vector<Record>* records,
                                  const std::vector<Timestamp>& timestamps);
 
+    std::unique_ptr<BulkRecordInserter> makeBulkInserter(OperationContext* opCtx) override;
+
     virtual Status updateRecord(OperationContext* opCtx,
                                 const RecordId& recordId,
                                 const char* data,
@@ -165,6 +187,9 @@ public:
 
     std::unique_ptr<RecordCursor> getRandomCursor(OperationContext* opCtx) const final;
 
+    std::unique_ptr<RecordCursor> getBlockSamplingCursor(OperationContext* opCtx,
+                                                         long long numSamples) const final;
+
     virtual std::unique_ptr<RecordCursor> getRandomCursorWithOptions(
         OperationContext* opCtx, StringData extraConfig) const = 0;
 
@@ -193,6 +218,10 @@ public:
                                    BSONObjBuilder* result,
                                    double scale) const;
 
+    bool appendCacheStats(OperationContext* opCtx,
+                          BSONObjBuilder* result,
+                          double scale) const override;
+
     virtual void cappedTruncateAfter(OperationContext* opCtx, RecordId end, bool inclusive);
 
     virtual boost::optional<RecordId> oplogStartHack(OperationContext* opCtx,
@@ -277,6 +306,7 @@ protected:
 
 private:
     class RandomCursor;
+    class BulkInserter;
 
     class NumRecordsChange;
     class DataSizeChange;
@@ -379,6 +409,8 @@ private:
     bool _tracksSizeAdjustments;
     WiredTigerKVEngine* _kvEngine;  // not owned.
 
+    const CachePriority _cachePriority;
+
     // Non-null if this record store is underlying the active oplog.
     std::shared_ptr<OplogStones> _oplogStones;
 
@@ -74,9 +74,13 @@ public:
         builder.append("processingMethod", _processBySampling.load() ? "sampling" : "scanning");
     }
 
-    boost::optional<OplogStones::Stone> peekOldestStoneIfNeeded() const;
+    // Returns a stone spanning the oldest stones that must be removed to bring the oplog back
+    // under its maximum size and whose last record is before 'mayTruncateUpTo', so that they can
+    // all be removed by a single truncate. Sets 'numStones' to the number of stones it spans.
+    boost::optional<OplogStones::Stone> peekOldestStonesIfNeeded(Timestamp mayTruncateUpTo,
+                                                                 size_t* numStones) const;
 
-    void popOldestStone();
+    void popOldestStones(size_t numStones);
 
     void createNewStoneIfNeeded(RecordId lastRecord);
 
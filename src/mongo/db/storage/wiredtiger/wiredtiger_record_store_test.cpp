@@ -101,6 +101,26 @@ TEST(WiredTigerRecordStoreTest, GenerateCreateStringValidConfigStringOption) {
               std::string("prefix_compression=true,"));
 }
 
+TEST(WiredTigerRecordStoreTest, GenerateCreateStringCachePriority) {
+    ASSERT_EQ(WiredTigerRecordStore::parseOptionsField(fromjson("{cachePriority: 'high'}")),
+              std::string("cache_resident=true,"));
+    ASSERT_EQ(WiredTigerRecordStore::parseOptionsField(fromjson("{cachePriority: 'normal'}")),
+              std::string(""));
+    ASSERT_EQ(WiredTigerRecordStore::parseOptionsField(fromjson("{cachePriority: 'low'}")),
+              std::string(""));
+    ASSERT_EQ(WiredTigerRecordStore::parseOptionsField(fromjson("{cachePriority: 'urgent'}")),
+              ErrorCodes::InvalidOptions);
+    ASSERT_EQ(WiredTigerRecordStore::parseOptionsField(fromjson("{cachePriority: 1}")),
+              ErrorCodes::TypeMismatch);
+
+    auto priority = WiredTigerRecordStore::parseCachePriority(fromjson("{cachePriority: 'low'}"));
+    ASSERT_OK(priority.getStatus());
+    ASSERT(priority.getValue() == WiredTigerRecordStore::CachePriority::kLow);
+    priority = WiredTigerRecordStore::parseCachePriority(fromjson("{configString: ''}"));
+    ASSERT_OK(priority.getStatus());
+    ASSERT(priority.getValue() == WiredTigerRecordStore::CachePriority::kNormal);
+}
+
 TEST(WiredTigerRecordStoreTest, Isolation1) {
     const auto harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
@@ -374,6 +394,33 @@ TEST(WiredTigerRecordStoreTest, AppendCustomStatsMetadata) {
     ASSERT_EQUALS(creationStringElement.type(), String);
 }
 
+TEST(WiredTigerRecordStoreTest, AppendCacheStats) {
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore("a.b"));
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(rs->insertRecord(opCtx.get(), "abc", 4, Timestamp()).getStatus());
+        uow.commit();
+    }
+
+    BSONObjBuilder builder;
+    ASSERT_TRUE(rs->appendCacheStats(opCtx.get(), &builder, 1.0));
+    BSONObj cacheStats = builder.obj();
+
+    for (auto&& fieldName : {"bytesInCache",
+                             "dirtyBytesInCache",
+                             "bytesReadIntoCache",
+                             "pagesReadIntoCache",
+                             "unmodifiedPagesEvicted",
+                             "modifiedPagesEvicted"}) {
+        ASSERT_TRUE(cacheStats[fieldName].isNumber()) << cacheStats;
+    }
+    ASSERT_GT(cacheStats["bytesInCache"].numberLong(), 0) << cacheStats;
+    ASSERT_EQ(cacheStats["cachePriority"].str(), "normal");
+}
+
 TEST(WiredTigerRecordStoreTest, CappedCursorYieldFirst) {
     unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newCappedRecordStore("a.b", 10000, 50));
@@ -819,6 +866,67 @@ TEST(WiredTigerRecordStoreTest, OplogStones_ReclaimStones) {
     }
 }
 
+// Verify that all the stones that can be reclaimed are removed together, up to the first stone the
+// persisted timestamp still needs.
+TEST(WiredTigerRecordStoreTest, OplogStones_ReclaimStonesUpToPinnedStone) {
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+
+    const int64_t cappedMaxSize = 10 * 1024;  // 10KB
+    unique_ptr<RecordStore> rs(
+        harnessHelper->newCappedRecordStore("local.oplog.stones", cappedMaxSize, -1));
+
+    WiredTigerRecordStore* wtrs = static_cast<WiredTigerRecordStore*>(rs.get());
+    WiredTigerRecordStore::OplogStones* oplogStones = wtrs->oplogStones();
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        ASSERT_OK(wtrs->updateCappedSize(opCtx.get(), 100U));
+    }
+
+    oplogStones->setMinBytesPerStone(100);
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        for (unsigned int i = 1; i <= 4; ++i) {
+            ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, i), 100),
+                      RecordId(1, i));
+        }
+
+        ASSERT_EQ(4, rs->numRecords(opCtx.get()));
+        ASSERT_EQ(400, rs->dataSize(opCtx.get()));
+        ASSERT_EQ(4U, oplogStones->numStones());
+    }
+
+    // The stones ending at (1, 1) and (1, 2) are truncated together. The stone ending at (1, 3)
+    // is still needed.
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        wtrs->reclaimOplog(opCtx.get(), Timestamp(1, 3));
+
+        ASSERT_EQ(2, rs->numRecords(opCtx.get()));
+        ASSERT_EQ(200, rs->dataSize(opCtx.get()));
+        ASSERT_EQ(2U, oplogStones->numStones());
+    }
+
+    // Once it is no longer needed, only the stones beyond the maximum size are truncated.
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        wtrs->reclaimOplog(opCtx.get(), Timestamp(1, 5));
+
+        ASSERT_EQ(1, rs->numRecords(opCtx.get()));
+        ASSERT_EQ(100, rs->dataSize(opCtx.get()));
+        ASSERT_EQ(1U, oplogStones->numStones());
+
+        auto cursor = rs->getCursor(opCtx.get());
+        auto record = cursor->next();
+        ASSERT(record);
+        ASSERT_EQ(RecordId(1, 4), record->id);
+    }
+}
+
 // Verify that an oplog stone isn't created if it would cause the logical representation of the
 // records to not be in increasing order.
 TEST(WiredTigerRecordStoreTest, OplogStones_AscendingOrder) {
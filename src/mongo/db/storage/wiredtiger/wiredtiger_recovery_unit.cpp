@@ -33,6 +33,8 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 
+#include <algorithm>
+
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_begin_transaction_block.h"
@@ -172,7 +174,8 @@ void WiredTigerRecoveryUnit::_commit() {
     // be boost::none and we'll set the commit time to that.
     auto commitTime = _commitTimestamp.isNull() ? _lastTimestampSet : _commitTimestamp;
 
-    bool notifyDone = !_prepareTimestamp.isNull();
+    const Timestamp prepareTimestamp = _prepareTimestamp;
+    bool notifyDone = !prepareTimestamp.isNull();
     if (_session && _isActive()) {
         _txnClose(true);
     }
@@ -183,7 +186,7 @@ void WiredTigerRecoveryUnit::_commit() {
     }
 
     if (notifyDone) {
-        _sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted();
+        _sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted(prepareTimestamp);
     }
 
     commitRegisteredChanges(commitTime);
@@ -191,14 +194,15 @@ void WiredTigerRecoveryUnit::_commit() {
 }
 
 void WiredTigerRecoveryUnit::_abort() {
-    bool notifyDone = !_prepareTimestamp.isNull();
+    const Timestamp prepareTimestamp = _prepareTimestamp;
+    bool notifyDone = !prepareTimestamp.isNull();
     if (_session && _isActive()) {
         _txnClose(false);
     }
     _setState(State::kAborting);
 
     if (notifyDone || MONGO_unlikely(WTAlwaysNotifyPrepareConflictWaiters.shouldFail())) {
-        _sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted();
+        _sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted(prepareTimestamp);
     }
 
     abortRegisteredChanges();
@@ -354,7 +358,13 @@ void WiredTigerRecoveryUnit::_txnClose(bool commit) {
         LOG(3) << "WT rollback_transaction for snapshot id " << getSnapshotId().toNumber();
     }
 
-    if (_isTimestamped) {
+    if (_pendingOplogWriteTs) {
+        // The oplog manager refreshes oplog visibility even if this transaction aborted, as its
+        // oplog entries may have been written by another one.
+        _oplogManager->completePendingOplogWrite(*_pendingOplogWriteTs);
+        _pendingOplogWriteTs = boost::none;
+        _isTimestamped = false;
+    } else if (_isTimestamped) {
         if (!_orderedCommit) {
             // We only need to update oplog visibility where commits can be out-of-order with
             // respect to their assigned optime and such commits might otherwise be visible.
@@ -600,6 +610,14 @@ Timestamp WiredTigerRecoveryUnit::_getTransactionReadTimestamp(WT_SESSION* sessi
     return Timestamp(read_timestamp);
 }
 
+void WiredTigerRecoveryUnit::trackPendingOplogWrite(Timestamp ts) {
+    if (_pendingOplogWriteTs) {
+        return;
+    }
+    _oplogManager->registerPendingOplogWrite(ts);
+    _pendingOplogWriteTs = ts;
+}
+
 Status WiredTigerRecoveryUnit::setTimestamp(Timestamp timestamp) {
     _ensureSession();
     LOG(3) << "WT set timestamp of future write operations to " << timestamp;
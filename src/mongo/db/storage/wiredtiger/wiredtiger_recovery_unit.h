@@ -147,6 +147,13 @@ public:
         _orderedCommit = orderedCommit;
     }
 
+    /**
+     * Registers the oplog entries this transaction will write, starting at 'ts', with the oplog
+     * manager, which is told when the transaction commits or aborts. Only the first call in a
+     * transaction registers, as later oplog entries are always hidden behind the first.
+     */
+    void trackPendingOplogWrite(Timestamp ts);
+
     void setReadOnce(bool readOnce) override {
         // Do not allow a session to use readOnce and regular cursors at the same time.
         invariant(!_isActive() || readOnce == _readOnce || getSession()->cursorsOut() == 0);
@@ -241,6 +248,10 @@ private:
     // new optime, and thus always call oplogDiskLocRegister() on the record store.
     bool _orderedCommit = true;
 
+    // The first timestamp of the oplog entries of this transaction, if it registered them with the
+    // oplog manager.
+    boost::optional<Timestamp> _pendingOplogWriteTs;
+
     // When 'true', data read from disk should not be kept in the storage engine cache.
     bool _readOnce = false;
 
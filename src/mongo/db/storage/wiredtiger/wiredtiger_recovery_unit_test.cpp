@@ -180,6 +180,28 @@ TEST_F(WiredTigerRecoveryUnitTestFixture, SetReadSource) {
     ASSERT_EQ(Timestamp(1, 1), ru1->getPointInTimeReadTimestamp());
 }
 
+TEST_F(WiredTigerRecoveryUnitTestFixture, PrepareConflictWaitersWokenOnlyByConflictingUnitsOfWork) {
+    auto sessionCache = ru1->getSessionCache();
+    auto opCtx = clientAndCtx1.second.get();
+
+    WiredTigerSessionCache::PrepareConflictWaiter earlyReader(sessionCache, Timestamp(10, 1));
+    WiredTigerSessionCache::PrepareConflictWaiter lateReader(sessionCache, Timestamp(30, 1));
+    WiredTigerSessionCache::PrepareConflictWaiter untimestampedReader(sessionCache, boost::none);
+
+    // A unit of work prepared after a read's timestamp cannot have conflicted with the read.
+    sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted(Timestamp(20, 1));
+    lateReader.wait(opCtx);
+    untimestampedReader.wait(opCtx);
+
+    auto timedOpCtx = clientAndCtx2.second.get();
+    timedOpCtx->setDeadlineAfterNowBy(Milliseconds(10), ErrorCodes::ExceededTimeLimit);
+    ASSERT_THROWS_CODE(
+        earlyReader.wait(timedOpCtx), AssertionException, ErrorCodes::ExceededTimeLimit);
+
+    sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted(Timestamp(5, 1));
+    earlyReader.wait(opCtx);
+}
+
 TEST_F(WiredTigerRecoveryUnitTestFixture, CreateAndCheckForCachePressure) {
     int time = 1;
 
@@ -79,6 +79,11 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
     }
 
     WiredTigerKVEngine::appendGlobalStats(bob);
+    _engine->appendCheckpointStats(&bob);
+
+    WiredTigerSessionCache* sessionCache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
+    sessionCache->appendStats(&bob);
+    sessionCache->snapshotManager().appendStats(&bob);
 
     WiredTigerUtil::appendSnapshotWindowSettings(_engine, session, &bob);
 
@@ -33,9 +33,11 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/base/error_codes.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/global_settings.h"
 #include "mongo/db/repl/repl_settings.h"
@@ -46,6 +48,8 @@
 #include "mongo/stdx/thread.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -121,6 +125,7 @@ WT_CURSOR* WiredTigerSession::getCachedCursor(const std::string& uri,
             WT_CURSOR* c = i->_cursor;
             _cursors.erase(i);
             _cursorsOut++;
+            _cursorCacheHits++;
             return c;
         }
     }
@@ -128,6 +133,7 @@ WT_CURSOR* WiredTigerSession::getCachedCursor(const std::string& uri,
     WT_CURSOR* cursor = nullptr;
     _openCursor(_session, uri, config, &cursor);
     _cursorsOut++;
+    _cursorCacheMisses++;
     return cursor;
 }
 
@@ -208,15 +214,10 @@ WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
     : _engine(engine),
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
-      _shuttingDown(0),
-      _prepareCommitOrAbortCounter(0) {}
+      _shuttingDown(0) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
-    : _engine(nullptr),
-      _conn(conn),
-      _clockSource(cs),
-      _shuttingDown(0),
-      _prepareCommitOrAbortCounter(0) {}
+    : _engine(nullptr), _conn(conn), _clockSource(cs), _shuttingDown(0) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
     shuttingDown();
@@ -284,6 +285,9 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
         return;
     }
 
+    _durabilityWaits.fetchAndAddRelaxed(1);
+    _durabilityWaitersSinceLastFlush.fetchAndAdd(1);
+
     uint32_t start = _lastSyncTime.load();
     // Do the remainder in a critical section that ensures only a single thread at a time
     // will attempt to synchronize.
@@ -293,7 +297,23 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
         // Someone else synced already since we read lastSyncTime, so we're done!
         return;
     }
+
+    // When the previous flush was shared by several writers, more are likely to arrive while this
+    // one is pending. Give them a window, bounded by the cost of the flush itself, to queue up
+    // behind _lastSyncMutex so that the flush below also covers them. This must happen before
+    // bumping _lastSyncTime, as that is what tells later arrivals that they are covered.
+    const long long maxWindowMicros = gWiredTigerJournalCommitMaxBatchWindowMicros.load();
+    if (maxWindowMicros > 0 && _lastFlushBatchSize > 1 && _engine && _engine->isDurable()) {
+        const long long windowMicros = std::min(maxWindowMicros, _lastFlushMicros / 2);
+        if (windowMicros > 0) {
+            sleepmicros(windowMicros);
+            _journalBatchWindowMicros.fetchAndAddRelaxed(windowMicros);
+        }
+    }
+
     _lastSyncTime.store(current + 1);
+    _lastFlushBatchSize = _durabilityWaitersSinceLastFlush.swap(0);
+    Timer flushTimer;
 
     // Nobody has synched yet, so we have to sync ourselves.
 
@@ -318,24 +338,52 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
         invariantWTOK(_waitUntilDurableSession->checkpoint(_waitUntilDurableSession, nullptr));
         LOG(4) << "created checkpoint";
     }
+    _lastFlushMicros = flushTimer.micros();
+    _journalFlushes.fetchAndAddRelaxed(1);
+    _journalFlushMicros.fetchAndAddRelaxed(_lastFlushMicros);
     _journalListener->onDurable(token);
 }
 
-void WiredTigerSessionCache::waitUntilPreparedUnitOfWorkCommitsOrAborts(OperationContext* opCtx,
-                                                                        std::uint64_t lastCount) {
+WiredTigerSessionCache::PrepareConflictWaiter::PrepareConflictWaiter(
+    WiredTigerSessionCache* sessionCache, boost::optional<Timestamp> readTimestamp)
+    : _sessionCache(sessionCache) {
+    stdx::lock_guard<Latch> lk(_sessionCache->_prepareCommittedOrAbortedMutex);
+    _registration = _sessionCache->_prepareConflictWaiters.emplace(
+        readTimestamp.value_or(Timestamp::max()), this);
+}
+
+WiredTigerSessionCache::PrepareConflictWaiter::~PrepareConflictWaiter() {
+    stdx::lock_guard<Latch> lk(_sessionCache->_prepareCommittedOrAbortedMutex);
+    _sessionCache->_prepareConflictWaiters.erase(_registration);
+}
+
+void WiredTigerSessionCache::PrepareConflictWaiter::wait(OperationContext* opCtx) {
     invariant(opCtx);
-    stdx::unique_lock<Latch> lk(_prepareCommittedOrAbortedMutex);
-    if (lastCount == _prepareCommitOrAbortCounter.loadRelaxed()) {
-        opCtx->waitForConditionOrInterrupt(_prepareCommittedOrAbortedCond, lk, [&] {
-            return _prepareCommitOrAbortCounter.loadRelaxed() > lastCount;
-        });
-    }
+    Timer timer;
+    ON_BLOCK_EXIT([&] {
+        _sessionCache->_prepareConflictWaits.fetchAndAddRelaxed(1);
+        _sessionCache->_prepareConflictWaitMicros.fetchAndAddRelaxed(timer.micros());
+    });
+
+    stdx::unique_lock<Latch> lk(_sessionCache->_prepareCommittedOrAbortedMutex);
+    opCtx->waitForConditionOrInterrupt(_endedCond, lk, [&] { return _ended; });
 }
 
-void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
-    stdx::unique_lock<Latch> lk(_prepareCommittedOrAbortedMutex);
-    _prepareCommitOrAbortCounter.fetchAndAdd(1);
-    _prepareCommittedOrAbortedCond.notify_all();
+void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted(
+    Timestamp prepareTimestamp) {
+    stdx::lock_guard<Latch> lk(_prepareCommittedOrAbortedMutex);
+    // Readers at timestamps before the prepare timestamp cannot have conflicted with the unit of
+    // work, as its writes are not visible to them.
+    for (auto it = _prepareConflictWaiters.lower_bound(prepareTimestamp);
+         it != _prepareConflictWaiters.end();
+         ++it) {
+        auto waiter = it->second;
+        if (!waiter->_ended) {
+            waiter->_ended = true;
+            waiter->_endedCond.notify_one();
+            _prepareConflictWakeups.fetchAndAddRelaxed(1);
+        }
+    }
 }
 
 
@@ -361,6 +409,37 @@ size_t WiredTigerSessionCache::getIdleSessionsCount() {
     return _sessions.size();
 }
 
+void WiredTigerSessionCache::appendStats(BSONObjBuilder* builder) const {
+    const long long hits = _cursorCacheHits.loadRelaxed();
+    const long long misses = _cursorCacheMisses.loadRelaxed();
+
+    BSONObjBuilder bob(builder->subobjStart("sessionCache"));
+    bob.append("sessionsReused", _sessionsReused.loadRelaxed());
+    bob.append("sessionsOpened", _sessionsOpened.loadRelaxed());
+    bob.append("cursorCacheHits", hits);
+    bob.append("cursorCacheMisses", misses);
+    bob.append("cursorCacheHitRatio",
+               hits + misses > 0 ? static_cast<double>(hits) / (hits + misses) : 0.0);
+    bob.done();
+
+    const long long waits = _durabilityWaits.loadRelaxed();
+    const long long flushes = _journalFlushes.loadRelaxed();
+
+    BSONObjBuilder groupCommit(builder->subobjStart("journalGroupCommit"));
+    groupCommit.append("durabilityWaits", waits);
+    groupCommit.append("flushes", flushes);
+    groupCommit.append("averageBatchSize",
+                       flushes > 0 ? static_cast<double>(waits) / flushes : 0.0);
+    groupCommit.append("totalFlushMicros", _journalFlushMicros.loadRelaxed());
+    groupCommit.append("totalBatchWindowMicros", _journalBatchWindowMicros.loadRelaxed());
+    groupCommit.done();
+
+    BSONObjBuilder prepareConflicts(builder->subobjStart("prepareConflictWaits"));
+    prepareConflicts.append("waits", _prepareConflictWaits.loadRelaxed());
+    prepareConflicts.append("totalWaitMicros", _prepareConflictWaitMicros.loadRelaxed());
+    prepareConflicts.append("wakeups", _prepareConflictWakeups.loadRelaxed());
+}
+
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     // Do nothing if session close idle time is set to 0 or less
     if (idleTimeMillis <= 0) {
@@ -417,10 +496,13 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
             _sessions.pop_back();
             // Reset the idle time
             cachedSession->setIdleExpireTime(Date_t::min());
+            _sessionsReused.fetchAndAddRelaxed(1);
             return UniqueWiredTigerSession(cachedSession);
         }
     }
 
+    _sessionsOpened.fetchAndAddRelaxed(1);
+
     // Outside of the cache partition lock, but on release will be put back on the cache
     return UniqueWiredTigerSession(
         new WiredTigerSession(_conn, this, _epoch.load(), _cursorEpoch.load()));
@@ -430,6 +512,11 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     invariant(session);
     invariant(session->cursorsOut() == 0);
 
+    _cursorCacheHits.fetchAndAddRelaxed(session->_cursorCacheHits);
+    _cursorCacheMisses.fetchAndAddRelaxed(session->_cursorCacheMisses);
+    session->_cursorCacheHits = 0;
+    session->_cursorCacheMisses = 0;
+
     const int shuttingDown = _shuttingDown.fetchAndAdd(1);
     ON_BLOCK_EXIT([this] { _shuttingDown.fetchAndSubtract(1); });
 
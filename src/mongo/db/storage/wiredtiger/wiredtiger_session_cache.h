@@ -29,19 +29,24 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <list>
+#include <map>
 #include <string>
 
 #include <wiredtiger.h>
 
+#include "mongo/bson/timestamp.h"
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/util/concurrency/spin_lock.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerKVEngine;
 class WiredTigerSessionCache;
 
@@ -143,6 +148,18 @@ public:
         return _cursors.size();
     }
 
+    /**
+     * Number of getCachedCursor() calls satisfied from and missing this session's cursor cache
+     * since the session was last returned to the session cache.
+     */
+    uint64_t cursorCacheHits() const {
+        return _cursorCacheHits;
+    }
+
+    uint64_t cursorCacheMisses() const {
+        return _cursorCacheMisses;
+    }
+
     bool isDropQueuedIdentsAtSessionEndAllowed() const {
         return _dropQueuedIdentsAtSessionEnd;
     }
@@ -198,6 +215,11 @@ private:
     uint64_t _cursorGen;
     int _cursorsOut;
     bool _dropQueuedIdentsAtSessionEnd = true;
+
+    // Kept per session rather than in the session cache so that cursor lookups never touch shared
+    // cache lines. Folded into the session cache totals when the session is released.
+    uint64_t _cursorCacheHits = 0;
+    uint64_t _cursorCacheMisses = 0;
     Date_t _idleExpireTime;
 };
 
@@ -258,6 +280,13 @@ public:
      */
     void closeAllCursors(const std::string& uri);
 
+    /**
+     * Appends session reuse, cursor cache hit and journal group commit statistics, for
+     * serverStatus. Cursor cache activity is only accounted for once the session performing it is
+     * released.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
     /**
      * Transitions the cache to shutting down mode. Any already released sessions are freed and
      * any sessions released subsequently are leaked. Must be called while holding the global
@@ -280,24 +309,53 @@ public:
     void waitUntilDurable(OperationContext* opCtx, bool forceCheckpoint, bool stableCheckpoint);
 
     /**
-     * Waits until a prepared unit of work has ended (either been commited or aborted). This
-     * should be used when encountering WT_PREPARE_CONFLICT errors. The caller is required to retry
-     * the conflicting WiredTiger API operation. A return from this function does not guarantee that
-     * the conflicting transaction has ended, only that one prepared unit of work in the process has
-     * signaled that it has ended.
-     * Accepts an OperationContext that will throw an AssertionException when interrupted.
+     * A reader waiting for a prepared unit of work to end (either be committed or aborted) after
+     * encountering WT_PREPARE_CONFLICT. It must be constructed before the conflicting WiredTiger
+     * API operation is tried, so that no unit of work ending between that attempt and wait() is
+     * missed, and the operation must be retried after wait() returns.
      *
-     * This method is provided in WiredTigerSessionCache and not RecoveryUnit because all recovery
-     * units share the same session cache, and we want a recovery unit on one thread to signal all
-     * recovery units waiting for prepare conflicts across all other threads.
+     * WiredTiger does not say which transaction a read conflicted with, so the waiter is woken by
+     * any prepared unit of work the read could have conflicted with: one prepared at or before the
+     * read timestamp, or any if the read has no timestamp. A return from wait() does not guarantee
+     * that the conflicting transaction has ended.
+     *
+     * Waiters are registered with WiredTigerSessionCache and not RecoveryUnit because all recovery
+     * units share the same session cache, and a recovery unit on one thread must signal the
+     * recovery units waiting for prepare conflicts on all other threads.
      */
-    void waitUntilPreparedUnitOfWorkCommitsOrAborts(OperationContext* opCtx, uint64_t lastCount);
+    class PrepareConflictWaiter {
+        PrepareConflictWaiter(const PrepareConflictWaiter&) = delete;
+        PrepareConflictWaiter& operator=(const PrepareConflictWaiter&) = delete;
+
+    public:
+        PrepareConflictWaiter(WiredTigerSessionCache* sessionCache,
+                              boost::optional<Timestamp> readTimestamp);
+        ~PrepareConflictWaiter();
+
+        /**
+         * Waits until a prepared unit of work that the read could have conflicted with ends, unless
+         * one already has since construction. Throws an AssertionException if 'opCtx' is
+         * interrupted.
+         */
+        void wait(OperationContext* opCtx);
+
+    private:
+        friend class WiredTigerSessionCache;
+
+        WiredTigerSessionCache* const _sessionCache;
+
+        // Guarded by the session cache's _prepareCommittedOrAbortedMutex.
+        stdx::condition_variable _endedCond;
+        bool _ended = false;
+        std::multimap<Timestamp, PrepareConflictWaiter*>::iterator _registration;
+    };
 
     /**
-     * Notifies waiters that the caller's perpared unit of work has ended (either committed or
-     * aborted).
+     * Notifies the waiters that could have conflicted with the caller's prepared unit of work,
+     * prepared at 'prepareTimestamp', that it has ended (either committed or aborted). A null
+     * 'prepareTimestamp' notifies every waiter.
      */
-    void notifyPreparedUnitOfWorkHasCommittedOrAborted();
+    void notifyPreparedUnitOfWorkHasCommittedOrAborted(Timestamp prepareTimestamp);
 
     WT_CONNECTION* conn() const {
         return _conn;
@@ -320,10 +378,6 @@ public:
         return _engine;
     }
 
-    std::uint64_t getPrepareCommitOrAbortCount() const {
-        return _prepareCommitOrAbortCounter.loadRelaxed();
-    }
-
 private:
     WiredTigerKVEngine* _engine;      // not owned, might be NULL
     WT_CONNECTION* _conn;             // not owned
@@ -350,11 +404,35 @@ private:
     AtomicWord<unsigned> _lastSyncTime;
     Mutex _lastSyncMutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::_lastSyncMutex");
 
-    // Mutex and cond var for waiting on prepare commit or abort.
+    // Group commit state for waitUntilDurable. Callers since the last flush started are counted in
+    // _durabilityWaitersSinceLastFlush; the remaining members are guarded by _lastSyncMutex.
+    AtomicWord<long long> _durabilityWaitersSinceLastFlush{0};
+    long long _lastFlushBatchSize = 0;
+    long long _lastFlushMicros = 0;
+
+    // Statistics reported by appendStats().
+    AtomicWord<long long> _durabilityWaits{0};
+    AtomicWord<long long> _journalFlushes{0};
+    AtomicWord<long long> _journalFlushMicros{0};
+    AtomicWord<long long> _journalBatchWindowMicros{0};
+
+    // The readers waiting on prepare commit or abort, keyed by read timestamp. Readers without a
+    // read timestamp are keyed by Timestamp::max(), as every prepared unit of work can conflict
+    // with them.
     Mutex _prepareCommittedOrAbortedMutex =
         MONGO_MAKE_LATCH("WiredTigerSessionCache::_prepareCommittedOrAbortedMutex");
-    stdx::condition_variable _prepareCommittedOrAbortedCond;
-    AtomicWord<std::uint64_t> _prepareCommitOrAbortCounter{0};
+    std::multimap<Timestamp, PrepareConflictWaiter*> _prepareConflictWaiters;
+
+    // Statistics reported by appendStats().
+    AtomicWord<long long> _prepareConflictWaits{0};
+    AtomicWord<long long> _prepareConflictWaitMicros{0};
+    AtomicWord<long long> _prepareConflictWakeups{0};
+
+    // Statistics reported by appendStats().
+    AtomicWord<long long> _sessionsReused{0};
+    AtomicWord<long long> _sessionsOpened{0};
+    AtomicWord<long long> _cursorCacheHits{0};
+    AtomicWord<long long> _cursorCacheMisses{0};
 
     // Protects _journalListener.
     Mutex _journalListenerMutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::_journalListenerMutex");
@@ -33,6 +33,7 @@
 #include <string>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/unittest/temp_dir.h"
@@ -113,4 +114,36 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, AppendStatsReportsSessionReuseAndCursorCacheHits) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+    const std::string uri = "table:cursorCacheStats";
+    const uint64_t tableId = WiredTigerSession::genTableId();
+
+    for (int i = 0; i < 2; i++) {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        WT_SESSION* wtSession = session->getSession();
+        ASSERT_OK(wtRCToStatus(
+            wtSession->create(wtSession, uri.c_str(), "key_format=S,value_format=S")));
+
+        // The first lookup opens a fresh cursor and the second finds it in the cursor cache.
+        for (int j = 0; j < 2; j++) {
+            WT_CURSOR* cursor = session->getCachedCursor(uri, tableId, nullptr);
+            ASSERT(cursor);
+            session->releaseCursor(tableId, cursor);
+        }
+        ASSERT_EQUALS(session->cursorCacheMisses(), 1U);
+        ASSERT_EQUALS(session->cursorCacheHits(), 1U);
+    }
+
+    BSONObjBuilder builder;
+    sessionCache->appendStats(&builder);
+    BSONObj stats = builder.obj().getObjectField("sessionCache");
+    ASSERT_EQUALS(stats["sessionsOpened"].numberLong(), 1);
+    ASSERT_EQUALS(stats["sessionsReused"].numberLong(), 1);
+    ASSERT_EQUALS(stats["cursorCacheMisses"].numberLong(), 2);
+    ASSERT_EQUALS(stats["cursorCacheHits"].numberLong(), 2);
+    ASSERT_EQUALS(stats["cursorCacheHitRatio"].numberDouble(), 0.5);
+}
+
 }  // namespace mongo
@@ -33,6 +33,7 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_begin_transaction_block.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
@@ -86,13 +87,32 @@ Timestamp WiredTigerSnapshotManager::beginTransactionOnCommittedSnapshot(
             "Committed view disappeared while running operation",
             _committedSnapshot);
 
+    // Set the read timestamp while holding the mutex, so that the committed snapshot cannot be
+    // dropped before WiredTiger has been told to read at it.
     auto status = txnOpen.setReadSnapshot(_committedSnapshot.get());
     fassert(30635, status);
 
+    ++_committedSnapshotReads;
+    if (*_committedSnapshot == _lastCommittedSnapshotRead)
+        ++_committedSnapshotReadsAtRepeatedTimestamp;
+    _lastCommittedSnapshotRead = *_committedSnapshot;
+
     txnOpen.done();
     return *_committedSnapshot;
 }
 
+void WiredTigerSnapshotManager::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lock(_committedSnapshotMutex);
+    BSONObjBuilder bob(builder->subobjStart("committedSnapshot"));
+    bob.append("reads", _committedSnapshotReads);
+    bob.append("readsAtRepeatedTimestamp", _committedSnapshotReadsAtRepeatedTimestamp);
+    bob.append("repeatedTimestampRatio",
+               _committedSnapshotReads > 0
+                   ? static_cast<double>(_committedSnapshotReadsAtRepeatedTimestamp) /
+                       _committedSnapshotReads
+                   : 0.0);
+}
+
 Timestamp WiredTigerSnapshotManager::beginTransactionOnLocalSnapshot(
     WT_SESSION* session,
     PrepareConflictBehavior prepareConflictBehavior,
@@ -39,6 +39,8 @@
 
 namespace mongo {
 
+class BSONObjBuilder;
+
 using RoundUpPreparedTimestamps = WiredTigerBeginTxnBlock::RoundUpPreparedTimestamps;
 
 class WiredTigerOplogManager;
@@ -89,12 +91,23 @@ public:
      */
     boost::optional<Timestamp> getMinSnapshotForNextCommittedRead() const;
 
+    /**
+     * Appends how many transactions began on the committed snapshot and how many of those read
+     * at the same timestamp as the transaction before them, for serverStatus.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
     // Snapshot to use for reads at a commit timestamp.
     mutable Mutex _committedSnapshotMutex =  // Guards _committedSnapshot.
         MONGO_MAKE_LATCH("WiredTigerSnapshotManager::_committedSnapshotMutex");
     boost::optional<Timestamp> _committedSnapshot;
 
+    // Also guarded by _committedSnapshotMutex, which every committed snapshot reader takes anyway.
+    mutable Timestamp _lastCommittedSnapshotRead;
+    mutable long long _committedSnapshotReads = 0;
+    mutable long long _committedSnapshotReadsAtRepeatedTimestamp = 0;
+
     // Snapshot to use for reads at a local stable timestamp.
     mutable Mutex _localSnapshotMutex =  // Guards _localSnapshot.
         MONGO_MAKE_LATCH("WiredTigerSnapshotManager::_localSnapshotMutex");
@@ -146,5 +146,36 @@ MONGO_INITIALIZER(RegisterSortedDataInterfaceHarnessFactory)(InitializerContext*
     mongo::registerSortedDataInterfaceHarnessHelperFactory(makeWTIndexHarnessHelper);
     return Status::OK();
 }
+
+TEST(WiredTigerStandardIndexTest, AppendCustomStatsReportsSampledKeyStats) {
+    WiredTigerIndexHarnessHelper harnessHelper;
+    auto sorted = harnessHelper.newSortedDataInterface(/*unique=*/false, /*partial=*/false);
+
+    const int nToInsert = 10;
+    for (int i = 0; i < nToInsert; i++) {
+        auto opCtx = harnessHelper.newOperationContext();
+        WriteUnitOfWork uow(opCtx.get());
+        // Longs, unlike ints, carry non-zero TypeBits, so every entry has a value.
+        BSONObj key = BSON("" << static_cast<long long>(i));
+        ASSERT_OK(sorted->insert(opCtx.get(), makeKeyString(sorted.get(), key, RecordId(i)), true));
+        uow.commit();
+    }
+
+    auto opCtx = harnessHelper.newOperationContext();
+    BSONObjBuilder builder;
+    ASSERT_TRUE(sorted->appendCustomStats(opCtx.get(), &builder, 1.0));
+    BSONObj stats = builder.obj();
+
+    BSONElement keyStatsElement = stats.getField("keyStats");
+    ASSERT_TRUE(keyStatsElement.isABSONObj());
+    BSONObj keyStats = keyStatsElement.Obj();
+
+    ASSERT_GT(keyStats["sampledEntries"].numberLong(), 0);
+    ASSERT_GT(keyStats["avgKeySize"].numberDouble(), 0);
+    ASSERT_GTE(keyStats["maxKeySize"].numberLong(), keyStats["avgKeySize"].numberDouble());
+    ASSERT_GT(keyStats["avgValueSize"].numberDouble(), 0);
+    ASSERT_EQ(keyStats["entriesWithValueFraction"].numberDouble(), 1.0);
+    ASSERT_TRUE(keyStats["prefixCompressionBytesSaved"].isNumber());
+}
 }  // namespace
 }  // namespace mongo
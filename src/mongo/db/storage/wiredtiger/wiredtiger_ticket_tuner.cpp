@@ -0,0 +1,192 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_tuner.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+namespace {
+
+// A pool grows only when it delayed more than this fraction of the operations it admitted, so that
+// the odd operation which arrives at a full pool does not make it grow.
+constexpr double kMinDelayedRatio = 0.01;
+
+// A pool shrinks back from an increase when its throughput falls below this fraction of what it
+// was before.
+constexpr double kThroughputDropRatio = 0.95;
+
+}  // namespace
+
+WiredTigerTicketTuner::WiredTigerTicketTuner(TicketHolder* readTickets,
+                                             TicketHolder* writeTickets)
+    : _pools{{{"read"_sd, readTickets}, {"write"_sd, writeTickets}}} {}
+
+void WiredTigerTicketTuner::adjust(Date_t now,
+                                   const CacheStats& cacheStats,
+                                   int minTickets,
+                                   int maxTickets) {
+    invariant(minTickets <= maxTickets);
+
+    const auto lastRoundTime = _lastRoundTime;
+    const long long appEvictions = cacheStats.appEvictions - _lastAppEvictions;
+    _lastRoundTime = now;
+    _lastAppEvictions = cacheStats.appEvictions;
+
+    const double elapsedSecs =
+        lastRoundTime ? durationCount<Milliseconds>(now - *lastRoundTime) / 1000.0 : 0;
+    if (elapsedSecs <= 0) {
+        for (auto& pool : _pools) {
+            pool.lastAdmitted = pool.holder->numAdmitted();
+            pool.lastDelayed = pool.holder->numDelayed();
+        }
+        return;
+    }
+
+    const double cacheFillRatio =
+        cacheStats.bytesMax > 0 ? double(cacheStats.bytesInUse) / cacheStats.bytesMax : 0;
+    for (auto& pool : _pools) {
+        _adjustPool(pool, now, elapsedSecs, appEvictions, cacheFillRatio, minTickets, maxTickets);
+    }
+}
+
+void WiredTigerTicketTuner::reset() {
+    _lastRoundTime = boost::none;
+    for (auto& pool : _pools) {
+        pool.throughputBeforeIncrease = boost::none;
+        pool.roundsToHold = 0;
+    }
+}
+
+void WiredTigerTicketTuner::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    builder->append("numIncreases", _numIncreases);
+    builder->append("numDecreases", _numDecreases);
+
+    BSONArrayBuilder recent(builder->subarrayStart("recentAdjustments"));
+    for (const auto& adjustment : _recentAdjustments) {
+        BSONObjBuilder entry(recent.subobjStart());
+        entry.append("time", adjustment.time);
+        entry.append("pool", adjustment.pool);
+        entry.append("from", adjustment.from);
+        entry.append("to", adjustment.to);
+        entry.append("reason", adjustment.reason);
+        entry.append("admittedPerSec", adjustment.admittedPerSec);
+        entry.append("delayedPerSec", adjustment.delayedPerSec);
+        entry.append("appEvictions", adjustment.appEvictions);
+        entry.append("cacheFillRatio", adjustment.cacheFillRatio);
+    }
+}
+
+void WiredTigerTicketTuner::_adjustPool(Pool& pool,
+                                        Date_t now,
+                                        double elapsedSecs,
+                                        long long appEvictions,
+                                        double cacheFillRatio,
+                                        int minTickets,
+                                        int maxTickets) {
+    const long long admitted = pool.holder->numAdmitted() - pool.lastAdmitted;
+    const long long delayed = pool.holder->numDelayed() - pool.lastDelayed;
+    pool.lastAdmitted += admitted;
+    pool.lastDelayed += delayed;
+    const double admittedPerSec = admitted / elapsedSecs;
+
+    const auto throughputBeforeIncrease = pool.throughputBeforeIncrease;
+    pool.throughputBeforeIncrease = boost::none;
+    if (pool.roundsToHold > 0) {
+        --pool.roundsToHold;
+    }
+
+    const int size = pool.holder->outof();
+    const int step = std::max(1, size / 10);
+    int newSize = size;
+    StringData reason;
+    if (size < minTickets) {
+        newSize = minTickets;
+        reason = "belowMinimum"_sd;
+    } else if (size > maxTickets) {
+        newSize = maxTickets;
+        reason = "aboveMaximum"_sd;
+    } else if (appEvictions > 0) {
+        newSize = std::max(minTickets, size - step);
+        reason = "cacheEvictionPressure"_sd;
+    } else if (throughputBeforeIncrease &&
+               admittedPerSec < *throughputBeforeIncrease * kThroughputDropRatio) {
+        newSize = std::max(minTickets, size - step);
+        reason = "throughputDroppedAfterIncrease"_sd;
+        pool.roundsToHold = kRoundsToHoldAfterRevert;
+    } else if (delayed > admitted * kMinDelayedRatio && pool.roundsToHold == 0) {
+        newSize = std::min(maxTickets, size + step);
+        reason = "operationsDelayed"_sd;
+        pool.throughputBeforeIncrease = admittedPerSec;
+    }
+
+    if (newSize == size) {
+        pool.throughputBeforeIncrease = boost::none;
+        return;
+    }
+
+    // Shrinking waits for the tickets it removes to be released.
+    const Status status = pool.holder->resize(newSize);
+    if (!status.isOK()) {
+        warning() << "Failed to resize the WiredTiger " << pool.name << " ticket pool from "
+                  << size << " to " << newSize << ": " << status;
+        pool.throughputBeforeIncrease = boost::none;
+        return;
+    }
+
+    LOG(1) << "Resized the WiredTiger " << pool.name << " ticket pool from " << size << " to "
+           << newSize << ", reason: " << reason;
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    ++(newSize > size ? _numIncreases : _numDecreases);
+    _recentAdjustments.push_back({now,
+                                  pool.name,
+                                  size,
+                                  newSize,
+                                  reason,
+                                  admittedPerSec,
+                                  delayed / elapsedSecs,
+                                  appEvictions,
+                                  cacheFillRatio});
+    if (_recentAdjustments.size() > kMaxRecentAdjustments) {
+        _recentAdjustments.pop_front();
+    }
+}
+
+}  // namespace mongo
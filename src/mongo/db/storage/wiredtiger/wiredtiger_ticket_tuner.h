@@ -0,0 +1,150 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <string>
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/string_data.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class TicketHolder;
+
+/**
+ * Resizes the WiredTiger read and write ticket pools from what they achieve, instead of leaving
+ * them at a fixed size. Each round looks at the operations each pool admitted and delayed since the
+ * last one, together with the eviction activity of the WiredTiger cache:
+ *
+ *  - While application threads have to evict pages from the cache, every pool shrinks by a tenth,
+ *    since more concurrent operations would only dirty the cache faster.
+ *  - A pool which delayed operations grows by a tenth, unless it grew the round before and then
+ *    admitted fewer operations per second, in which case it shrinks back and stays put for a while.
+ *
+ * Pools always stay within the configured limits. The most recent adjustments are kept, with the
+ * observations behind them, to explain the current pool sizes in serverStatus.
+ *
+ * Rounds are driven by a single thread; appending the statistics may happen concurrently.
+ */
+class WiredTigerTicketTuner {
+    WiredTigerTicketTuner(const WiredTigerTicketTuner&) = delete;
+    WiredTigerTicketTuner& operator=(const WiredTigerTicketTuner&) = delete;
+
+public:
+    // Connection-wide WiredTiger cache statistics, as of the start of a round.
+    struct CacheStats {
+        long long bytesInUse = 0;
+        long long bytesMax = 0;
+
+        // Pages evicted by application threads since the connection was opened.
+        long long appEvictions = 0;
+    };
+
+    // The number of rounds a pool keeps its size after shrinking back from an increase which
+    // reduced its throughput.
+    static constexpr int kRoundsToHoldAfterRevert = 10;
+
+    // The number of adjustments kept for serverStatus.
+    static constexpr size_t kMaxRecentAdjustments = 16;
+
+    WiredTigerTicketTuner(TicketHolder* readTickets, TicketHolder* writeTickets);
+
+    /**
+     * Resizes the pools, if needed, to between 'minTickets' and 'maxTickets' tickets from what
+     * happened since the previous round. The first round after construction or reset() only
+     * records where the counters are.
+     */
+    void adjust(Date_t now, const CacheStats& cacheStats, int minTickets, int maxTickets);
+
+    /**
+     * Forgets the previous round, for when rounds stop for a while.
+     */
+    void reset();
+
+    /**
+     * Appends the number of adjustments made and the most recent ones.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    struct Pool {
+        StringData name;
+        TicketHolder* holder;
+
+        long long lastAdmitted = 0;
+        long long lastDelayed = 0;
+
+        // The throughput of the round before the last increase, while it has not been confirmed.
+        boost::optional<double> throughputBeforeIncrease;
+
+        int roundsToHold = 0;
+    };
+
+    struct Adjustment {
+        Date_t time;
+        StringData pool;
+        int from;
+        int to;
+        StringData reason;
+        double admittedPerSec;
+        double delayedPerSec;
+        long long appEvictions;
+        double cacheFillRatio;
+    };
+
+    void _adjustPool(Pool& pool,
+                     Date_t now,
+                     double elapsedSecs,
+                     long long appEvictions,
+                     double cacheFillRatio,
+                     int minTickets,
+                     int maxTickets);
+
+    std::array<Pool, 2> _pools;
+
+    boost::optional<Date_t> _lastRoundTime;
+    long long _lastAppEvictions = 0;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerTicketTuner::_mutex");
+
+    // Protected by '_mutex'.
+    long long _numIncreases = 0;
+    long long _numDecreases = 0;
+    std::deque<Adjustment> _recentAdjustments;
+};
+
+}  // namespace mongo
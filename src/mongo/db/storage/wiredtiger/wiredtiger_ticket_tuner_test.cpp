@@ -0,0 +1,191 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_tuner.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/ticketholder.h"
+
+namespace mongo {
+namespace {
+
+constexpr int kMinTickets = 10;
+constexpr int kMaxTickets = 100;
+
+class WiredTigerTicketTunerTest : public unittest::Test {
+protected:
+    /**
+     * Admits 'admitted' operations to 'holder', of which 'delayed' more find it full.
+     */
+    void runOperations(TicketHolder* holder, int admitted, int delayed) {
+        for (int i = 0; i < admitted; ++i) {
+            holder->waitForTicket();
+            holder->release();
+        }
+
+        int held = 0;
+        while (holder->tryAcquire()) {
+            ++held;
+        }
+        for (int i = 0; i < delayed; ++i) {
+            ASSERT_FALSE(holder->waitForTicketUntil(Date_t::now()));
+        }
+        while (held-- > 0) {
+            holder->release();
+        }
+    }
+
+    void nextRound(WiredTigerTicketTuner::CacheStats cacheStats = {}) {
+        _now += Seconds(1);
+        tuner.adjust(_now, cacheStats, kMinTickets, kMaxTickets);
+    }
+
+    TicketHolder readTickets{50};
+    TicketHolder writeTickets{50};
+    WiredTigerTicketTuner tuner{&readTickets, &writeTickets};
+
+private:
+    Date_t _now = Date_t::fromMillisSinceEpoch(1000 * 1000);
+};
+
+TEST_F(WiredTigerTicketTunerTest, FirstRoundOnlyRecordsCounters) {
+    runOperations(&writeTickets, 100, 100);
+    nextRound();
+    ASSERT_EQ(50, writeTickets.outof());
+
+    nextRound();
+    ASSERT_EQ(50, writeTickets.outof());
+}
+
+TEST_F(WiredTigerTicketTunerTest, DelayedOperationsGrowThePool) {
+    nextRound();
+    runOperations(&writeTickets, 100, 10);
+    nextRound();
+    ASSERT_EQ(55, writeTickets.outof());
+    ASSERT_EQ(50, readTickets.outof());
+
+    // An operation delayed here and there is not worth growing for.
+    runOperations(&writeTickets, 1000, 1);
+    nextRound();
+    ASSERT_EQ(55, writeTickets.outof());
+}
+
+TEST_F(WiredTigerTicketTunerTest, GrowthStopsAtTheMaximum) {
+    nextRound();
+    for (int i = 0; i < 20; ++i) {
+        runOperations(&readTickets, 100 * (i + 1), 100);
+        nextRound();
+    }
+    ASSERT_EQ(kMaxTickets, readTickets.outof());
+}
+
+TEST_F(WiredTigerTicketTunerTest, IncreaseWhichReducesThroughputIsRevertedAndHeld) {
+    nextRound();
+    runOperations(&writeTickets, 1000, 100);
+    nextRound();
+    ASSERT_EQ(55, writeTickets.outof());
+
+    runOperations(&writeTickets, 500, 100);
+    nextRound();
+    ASSERT_EQ(50, writeTickets.outof());
+
+    for (int i = 0; i < WiredTigerTicketTuner::kRoundsToHoldAfterRevert - 1; ++i) {
+        runOperations(&writeTickets, 500, 100);
+        nextRound();
+        ASSERT_EQ(50, writeTickets.outof());
+    }
+
+    runOperations(&writeTickets, 500, 100);
+    nextRound();
+    ASSERT_EQ(55, writeTickets.outof());
+}
+
+TEST_F(WiredTigerTicketTunerTest, EvictionPressureShrinksBothPools) {
+    WiredTigerTicketTuner::CacheStats cacheStats{950, 1000, 0};
+    nextRound(cacheStats);
+
+    // Operations which are delayed do not make the pools grow while application threads evict.
+    runOperations(&writeTickets, 100, 100);
+    cacheStats.appEvictions += 3;
+    nextRound(cacheStats);
+    ASSERT_EQ(45, readTickets.outof());
+    ASSERT_EQ(45, writeTickets.outof());
+
+    for (int i = 0; i < 20; ++i) {
+        cacheStats.appEvictions += 3;
+        nextRound(cacheStats);
+    }
+    ASSERT_EQ(kMinTickets, readTickets.outof());
+    ASSERT_EQ(kMinTickets, writeTickets.outof());
+
+    // Without more evictions the pools stay where they are.
+    nextRound(cacheStats);
+    ASSERT_EQ(kMinTickets, readTickets.outof());
+}
+
+TEST_F(WiredTigerTicketTunerTest, PoolsOutsideTheLimitsAreBroughtWithinThem) {
+    nextRound();
+    ASSERT_OK(readTickets.resize(kMaxTickets + 10));
+    ASSERT_OK(writeTickets.resize(kMinTickets - 1));
+    nextRound();
+    ASSERT_EQ(kMaxTickets, readTickets.outof());
+    ASSERT_EQ(kMinTickets, writeTickets.outof());
+}
+
+TEST_F(WiredTigerTicketTunerTest, StatsExplainRecentAdjustments) {
+    nextRound();
+    runOperations(&writeTickets, 100, 10);
+    nextRound();
+    nextRound({900, 1000, 2});
+
+    BSONObjBuilder builder;
+    tuner.appendStats(&builder);
+    const BSONObj stats = builder.obj();
+    ASSERT_EQ(1, stats["numIncreases"].numberLong());
+    ASSERT_EQ(2, stats["numDecreases"].numberLong());
+
+    const auto recent = stats["recentAdjustments"].Array();
+    ASSERT_EQ(3U, recent.size());
+    ASSERT_EQ("write", recent[0]["pool"].str());
+    ASSERT_EQ(50, recent[0]["from"].numberInt());
+    ASSERT_EQ(55, recent[0]["to"].numberInt());
+    ASSERT_EQ("operationsDelayed", recent[0]["reason"].str());
+    ASSERT_EQ(100, recent[0]["admittedPerSec"].numberDouble());
+    ASSERT_EQ(10, recent[0]["delayedPerSec"].numberDouble());
+    ASSERT_EQ("cacheEvictionPressure", recent[2]["reason"].str());
+    ASSERT_EQ(2, recent[2]["appEvictions"].numberLong());
+    ASSERT_EQ(0.9, recent[2]["cacheFillRatio"].numberDouble());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -367,6 +367,60 @@ StatusWith<int64_t> WiredTigerUtil::getStatisticsValue(WT_SESSION* session,
     return StatusWith<int64_t>(value);
 }
 
+Status WiredTigerUtil::appendCacheStats(WT_SESSION* session,
+                                        const std::string& uri,
+                                        double scale,
+                                        BSONObjBuilder* builder) {
+    invariant(session);
+    const std::string statsURI = "statistics:" + uri;
+    WT_CURSOR* cursor = nullptr;
+    int ret =
+        session->open_cursor(session, statsURI.c_str(), nullptr, "statistics=(fast)", &cursor);
+    if (ret != 0) {
+        return {ErrorCodes::CursorNotFound,
+                str::stream() << "unable to open cursor at URI " << statsURI
+                              << ". reason: " << wiredtiger_strerror(ret)};
+    }
+    invariant(cursor);
+    ON_BLOCK_EXIT([&] { cursor->close(cursor); });
+
+    struct CacheStat {
+        StringData fieldName;
+        int statisticsKey;
+        bool isBytes;
+    };
+    static const CacheStat kCacheStats[] = {
+        {"bytesInCache"_sd, WT_STAT_DSRC_CACHE_BYTES_INUSE, true},
+        {"dirtyBytesInCache"_sd, WT_STAT_DSRC_CACHE_BYTES_DIRTY, true},
+        {"bytesReadIntoCache"_sd, WT_STAT_DSRC_CACHE_BYTES_READ, true},
+        {"pagesReadIntoCache"_sd, WT_STAT_DSRC_CACHE_READ, false},
+        {"unmodifiedPagesEvicted"_sd, WT_STAT_DSRC_CACHE_EVICTION_CLEAN, false},
+        {"modifiedPagesEvicted"_sd, WT_STAT_DSRC_CACHE_EVICTION_DIRTY, false},
+    };
+
+    for (const auto& stat : kCacheStats) {
+        cursor->set_key(cursor, stat.statisticsKey);
+        ret = cursor->search(cursor);
+        if (ret != 0) {
+            return {ErrorCodes::NoSuchKey,
+                    str::stream() << "unable to find key " << stat.statisticsKey << " at URI "
+                                  << statsURI << ". reason: " << wiredtiger_strerror(ret)};
+        }
+
+        int64_t value;
+        ret = cursor->get_value(cursor, nullptr, nullptr, &value);
+        if (ret != 0) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "unable to get value for key " << stat.statisticsKey
+                                  << " at URI " << statsURI
+                                  << ". reason: " << wiredtiger_strerror(ret)};
+        }
+        builder->appendNumber(stat.fieldName,
+                              static_cast<long long>(stat.isBytes ? value / scale : value));
+    }
+    return Status::OK();
+}
+
 int64_t WiredTigerUtil::getIdentSize(WT_SESSION* s, const std::string& uri) {
     StatusWith<int64_t> result = WiredTigerUtil::getStatisticsValue(
         s, "statistics:" + uri, "statistics=(size)", WT_STAT_DSRC_BLOCK_SIZE);
@@ -381,6 +435,20 @@ int64_t WiredTigerUtil::getIdentSize(WT_SESSION* s, const std::string& uri) {
     return result.getValue();
 }
 
+int64_t WiredTigerUtil::getIdentReuseSize(WT_SESSION* s, const std::string& uri) {
+    StatusWith<int64_t> result = WiredTigerUtil::getStatisticsValue(
+        s, "statistics:" + uri, "statistics=(fast)", WT_STAT_DSRC_BLOCK_REUSE_BYTES);
+    const Status& status = result.getStatus();
+    if (!status.isOK()) {
+        if (status.code() == ErrorCodes::CursorNotFound) {
+            // ident gone, so its 0
+            return 0;
+        }
+        uassertStatusOK(status);
+    }
+    return result.getValue();
+}
+
 size_t WiredTigerUtil::getCacheSizeMB(double requestedCacheSizeGB) {
     double cacheSizeMB;
     const double kMaxSizeCacheMB = 10 * 1000 * 1000;
@@ -705,8 +773,22 @@ void WiredTigerUtil::appendSnapshotWindowSettings(WiredTigerKVEngine* engine,
     const unsigned currentAvailableSnapshotWindow =
         stableTimestamp.getSecs() - oldestTimestamp.getSecs();
 
-    int64_t score = uassertStatusOK(WiredTigerUtil::getStatisticsValue(
-        session->getSession(), "statistics:", "", WT_STAT_CONN_CACHE_LOOKASIDE_SCORE));
+    auto getConnectionStatistic = [&](int key) {
+        return uassertStatusOK(
+            WiredTigerUtil::getStatisticsValue(session->getSession(), "statistics:", "", key));
+    };
+    int64_t score = getConnectionStatistic(WT_STAT_CONN_CACHE_LOOKASIDE_SCORE);
+
+    // The pinned ranges are differences between timestamps, whose high 32 bits are seconds.
+    const auto pinnedSeconds = [](int64_t range) {
+        return static_cast<long long>(Timestamp(static_cast<unsigned long long>(range)).getSecs());
+    };
+    const int64_t pinnedByOldest = getConnectionStatistic(WT_STAT_CONN_TXN_PINNED_TIMESTAMP_OLDEST);
+    const int64_t pinnedByReaders =
+        getConnectionStatistic(WT_STAT_CONN_TXN_PINNED_TIMESTAMP_READER);
+    const int64_t oldestActiveRead =
+        getConnectionStatistic(WT_STAT_CONN_TXN_TIMESTAMP_OLDEST_ACTIVE_READ);
+    const int64_t historyCacheBytes = getConnectionStatistic(WT_STAT_CONN_CACHE_BYTES_LOOKASIDE);
 
     auto totalNumberOfSnapshotTooOldErrors = snapshotWindowParams.snapshotTooOldErrorCount.load();
 
@@ -725,6 +807,21 @@ void WiredTigerUtil::appendSnapshotWindowSettings(WiredTigerKVEngine* engine,
                     stableTimestamp.toStringPretty());
     settings.append("oldest majority snapshot timestamp available",
                     oldestTimestamp.toStringPretty());
+    settings.append("seconds without point-in-time reads before releasing the window",
+                    snapshotWindowParams.snapshotHistoryIdleSeconds.load());
+    settings.append("window released for lack of point-in-time reads",
+                    snapshotWindowParams.snapshotHistoryReleased.load());
+    settings.append("seconds of history pinned by the oldest timestamp",
+                    pinnedSeconds(pinnedByOldest));
+    settings.append("seconds of history pinned by the oldest active reader",
+                    pinnedSeconds(pinnedByReaders));
+    if (oldestActiveRead != 0) {
+        settings.append("oldest active read timestamp",
+                        Timestamp(static_cast<unsigned long long>(oldestActiveRead))
+                            .toStringPretty());
+    }
+    settings.appendNumber("bytes of history in the cache overflow table",
+                          static_cast<long long>(historyCacheBytes));
 }
 
 }  // namespace mongo
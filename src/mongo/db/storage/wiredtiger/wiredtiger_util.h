@@ -217,8 +217,25 @@ public:
                                                   const std::string& config,
                                                   int statisticsKey);
 
+    /**
+     * Appends a summary of how much of the table at 'uri' is resident in the cache: the bytes and
+     * dirty bytes it holds there, and the number of its pages read into and evicted from it. Byte
+     * counts are divided by 'scale'. Only these statistics are read, from a single statistics
+     * cursor, which is far cheaper than exporting all of the table's statistics.
+     */
+    static Status appendCacheStats(WT_SESSION* session,
+                                   const std::string& uri,
+                                   double scale,
+                                   BSONObjBuilder* builder);
+
     static int64_t getIdentSize(WT_SESSION* s, const std::string& uri);
 
+    /**
+     * Returns the number of bytes of the file backing 'uri' which are free for reuse, or 0 if the
+     * ident is gone.
+     */
+    static int64_t getIdentReuseSize(WT_SESSION* s, const std::string& uri);
+
 
     /**
      * Return amount of memory to use for the WiredTiger cache based on either the startup
@@ -825,17 +825,20 @@ void TransactionParticipant::Participant::_stashActiveTransaction(OperationConte
     invariant(o().activeTxnNumber == opCtx->getTxnNumber());
 
     stdx::lock_guard<Client> lk(*opCtx->getClient());
+    auto tickSource = opCtx->getServiceContext()->getTickSource();
     {
-        auto tickSource = opCtx->getServiceContext()->getTickSource();
         o(lk).transactionMetricsObserver.onStash(ServerTransactionsMetrics::get(opCtx), tickSource);
         o(lk).transactionMetricsObserver.onTransactionOperation(
             opCtx, CurOp::get(opCtx)->debug().additiveMetrics, o().txnState.isPrepared());
     }
 
     invariant(!o().txnResourceStash);
+    auto stashStart = tickSource->getTicks();
     auto stashStyle = opCtx->writesAreReplicated() ? TxnResources::StashStyle::kPrimary
                                                    : TxnResources::StashStyle::kSecondary;
     o(lk).txnResourceStash = TxnResources(lk, opCtx, stashStyle);
+    ServerTransactionsMetrics::get(opCtx)->incrementTotalStashTime(
+        tickSource->ticksTo<Microseconds>(tickSource->getTicks() - stashStart));
 }
 
 
@@ -923,6 +926,14 @@ void TransactionParticipant::Participant::unstashTransactionResources(OperationC
     }
 
     _checkIsCommandValidWithTxnState(*opCtx->getTxnNumber(), cmdName);
+
+    auto tickSource = opCtx->getServiceContext()->getTickSource();
+    auto unstashStart = tickSource->getTicks();
+    ON_BLOCK_EXIT([&] {
+        ServerTransactionsMetrics::get(opCtx)->incrementTotalUnstashTime(
+            tickSource->ticksTo<Microseconds>(tickSource->getTicks() - unstashStart));
+    });
+
     if (o().txnResourceStash) {
         MaxLockTimeout maxLockTimeout;
         // Default is we should acquire ticket.
@@ -951,7 +962,7 @@ void TransactionParticipant::Participant::unstashTransactionResources(OperationC
         _releaseTransactionResourcesToOpCtx(opCtx, maxLockTimeout, acquireTicket);
         stdx::lock_guard<Client> lg(*opCtx->getClient());
         o(lg).transactionMetricsObserver.onUnstash(ServerTransactionsMetrics::get(opCtx),
-                                                   opCtx->getServiceContext()->getTickSource());
+                                                   tickSource);
         return;
     }
 
@@ -1227,7 +1238,11 @@ void TransactionParticipant::Participant::commitUnpreparedTransaction(OperationC
     auto opObserver = opCtx->getServiceContext()->getOpObserver();
     invariant(opObserver);
 
+    auto tickSource = opCtx->getServiceContext()->getTickSource();
+    auto oplogWriteStart = tickSource->getTicks();
     opObserver->onUnpreparedTransactionCommit(opCtx, txnOps);
+    ServerTransactionsMetrics::get(opCtx)->incrementTotalCommitOplogWriteTime(
+        tickSource->ticksTo<Microseconds>(tickSource->getTicks() - oplogWriteStart));
 
     // Read-only transactions with all read concerns must wait for any data they read to be majority
     // committed. For local read concern this is to match majority read concern. For both local and
@@ -1383,8 +1398,12 @@ void TransactionParticipant::Participant::commitPreparedTransaction(
 void TransactionParticipant::Participant::_commitStorageTransaction(OperationContext* opCtx) try {
     invariant(opCtx->getWriteUnitOfWork());
     invariant(opCtx->lockState()->isRSTLLocked());
+    auto tickSource = opCtx->getServiceContext()->getTickSource();
+    auto commitStart = tickSource->getTicks();
     opCtx->getWriteUnitOfWork()->commit();
     opCtx->setWriteUnitOfWork(nullptr);
+    ServerTransactionsMetrics::get(opCtx)->incrementTotalCommitStorageTime(
+        tickSource->ticksTo<Microseconds>(tickSource->getTicks() - commitStart));
 
     // We must clear the recovery unit and locker for the 'config.transactions' and oplog entry
     // writes.
@@ -2029,6 +2029,52 @@ TEST_F(TransactionsMetricsTest, SingleTransactionStatsDurationShouldBeSetUponCom
               Microseconds(100));
 }
 
+TEST_F(TransactionsMetricsTest, CommitOplogWriteTimeShouldBeAccumulatedUponCommit) {
+    auto tickSource = initMockTickSource();
+    auto metrics = ServerTransactionsMetrics::get(opCtx());
+    auto beforeOplogWriteTime = metrics->getTotalCommitOplogWriteTime();
+    auto beforeStorageCommitTime = metrics->getTotalCommitStorageTime();
+
+    // Only the time spent in the op observer counts as writing the commit oplog entries.
+    auto originalFn = _opObserver->onUnpreparedTransactionCommitFn;
+    _opObserver->onUnpreparedTransactionCommitFn =
+        [&](const std::vector<repl::ReplOperation>& statements) {
+            originalFn(statements);
+            tickSource->advance(Microseconds(100));
+        };
+
+    auto sessionCheckout = checkOutSession();
+    auto txnParticipant = TransactionParticipant::get(opCtx());
+    txnParticipant.unstashTransactionResources(opCtx(), "commitTransaction");
+    // The transaction machinery cannot store an empty locker.
+    { Lock::GlobalLock lk(opCtx(), MODE_IX, Date_t::now(), Lock::InterruptBehavior::kThrow); }
+
+    txnParticipant.commitUnpreparedTransaction(opCtx());
+    ASSERT_EQ(metrics->getTotalCommitOplogWriteTime(), beforeOplogWriteTime + Microseconds(100));
+    ASSERT_EQ(metrics->getTotalCommitStorageTime(), beforeStorageCommitTime);
+}
+
+TEST_F(TransactionsMetricsTest, StashAndUnstashTimeShouldNotIncludeTimeBetweenStatements) {
+    auto tickSource = initMockTickSource();
+    auto metrics = ServerTransactionsMetrics::get(opCtx());
+    auto beforeStashTime = metrics->getTotalStashTime();
+    auto beforeUnstashTime = metrics->getTotalUnstashTime();
+
+    auto sessionCheckout = checkOutSession();
+    auto txnParticipant = TransactionParticipant::get(opCtx());
+    txnParticipant.unstashTransactionResources(opCtx(), "insert");
+    // The transaction machinery cannot store an empty locker.
+    { Lock::GlobalLock lk(opCtx(), MODE_IX, Date_t::now(), Lock::InterruptBehavior::kThrow); }
+    txnParticipant.stashTransactionResources(opCtx());
+
+    // Time spent while the transaction is inactive is not overhead of the stash or the unstash.
+    tickSource->advance(Microseconds(100));
+
+    txnParticipant.unstashTransactionResources(opCtx(), "insert");
+    ASSERT_EQ(metrics->getTotalStashTime(), beforeStashTime);
+    ASSERT_EQ(metrics->getTotalUnstashTime(), beforeUnstashTime);
+}
+
 TEST_F(TransactionsMetricsTest, SingleTransactionStatsPreparedDurationShouldBeSetUponCommit) {
     auto tickSource = initMockTickSource();
 
@@ -33,6 +33,9 @@
 
 #include "mongo/db/ttl.h"
 
+#include <algorithm>
+#include <map>
+
 #include "mongo/base/counter.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/user_name.h"
@@ -58,6 +61,7 @@
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -65,10 +69,13 @@ MONGO_FAIL_POINT_DEFINE(hangTTLMonitorWithLock);
 
 Counter64 ttlPasses;
 Counter64 ttlDeletedDocuments;
+AtomicWord<long long> ttlIndexesWithBacklog;
 
 ServerStatusMetricField<Counter64> ttlPassesDisplay("ttl.passes", &ttlPasses);
 ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocuments",
                                                               &ttlDeletedDocuments);
+ServerStatusMetricField<AtomicWord<long long>> ttlIndexesWithBacklogDisplay(
+    "ttl.indexesWithBacklog", &ttlIndexesWithBacklog);
 
 class TTLMonitor : public BackgroundJob {
 public:
@@ -93,7 +100,11 @@ public:
         while (!globalInShutdownDeprecated()) {
             {
                 MONGO_IDLE_THREAD_BLOCK;
-                sleepsecs(ttlMonitorSleepSecs.load());
+                if (_backlog.empty()) {
+                    sleepsecs(ttlMonitorSleepSecs.load());
+                } else {
+                    sleepmillis(ttlMonitorBacklogSleepMillis.load());
+                }
             }
 
             LOG(3) << "thread awake";
@@ -110,8 +121,12 @@ public:
                 continue;
             }
 
+            // Passes in between the regular ones only visit the indexes with a backlog.
+            const bool fullPass = _backlog.empty() ||
+                Date_t::now() - _lastFullPass >= Seconds(ttlMonitorSleepSecs.load());
+
             try {
-                doTTLPass();
+                doTTLPass(fullPass);
             } catch (const WriteConflictException&) {
                 LOG(1) << "got WriteConflictException";
             } catch (const ExceptionForCat<ErrorCategory::Interruption>& interruption) {
@@ -121,7 +136,15 @@ public:
     }
 
 private:
-    void doTTLPass() {
+    using TTLInfo = std::pair<UUID, std::string>;
+
+    struct TTLIndex {
+        TTLInfo info;
+        NamespaceString nss;
+        BSONObj spec;
+    };
+
+    void doTTLPass(bool fullPass) {
         const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
         OperationContext& opCtx = *opCtxPtr;
 
@@ -134,13 +157,19 @@ private:
         TTLCollectionCache& ttlCollectionCache = TTLCollectionCache::get(getGlobalServiceContext());
         std::vector<std::pair<UUID, std::string>> ttlInfos = ttlCollectionCache.getTTLInfos();
 
-        // Pair of collection namespace and index spec.
-        std::vector<std::pair<NamespaceString, BSONObj>> ttlIndexes;
+        std::vector<TTLIndex> ttlIndexes;
 
-        ttlPasses.increment();
+        if (fullPass) {
+            ttlPasses.increment();
+            _lastFullPass = Date_t::now();
+        }
 
         // Get all TTL indexes from every collection.
         for (const std::pair<UUID, std::string>& ttlInfo : ttlInfos) {
+            if (!fullPass && !_backlog.count(ttlInfo)) {
+                continue;
+            }
+
             auto uuid = ttlInfo.first;
             auto indexName = ttlInfo.second;
 
@@ -172,43 +201,78 @@ private:
             if (!DurableCatalog::get(opCtxPtr.get())->isIndexReady(&opCtx, *nss, indexName))
                 continue;
 
-            ttlIndexes.push_back(std::make_pair(*nss, spec.getOwned()));
+            ttlIndexes.push_back({ttlInfo, *nss, spec.getOwned()});
+        }
+
+        // Visit the indexes which have had expired documents left over for the most passes first,
+        // so that they are not starved by the indexes which are caught up.
+        auto backlogPasses = [&](const TTLIndex& index) {
+            auto it = _backlog.find(index.info);
+            return it == _backlog.end() ? 0 : it->second;
+        };
+        std::stable_sort(ttlIndexes.begin(),
+                         ttlIndexes.end(),
+                         [&](const TTLIndex& lhs, const TTLIndex& rhs) {
+                             return backlogPasses(lhs) > backlogPasses(rhs);
+                         });
+
+        // Indexes which are no longer TTL indexes are dropped from the backlog by full passes.
+        if (fullPass) {
+            std::map<TTLInfo, int> backlog;
+            for (const auto& index : ttlIndexes) {
+                auto it = _backlog.find(index.info);
+                if (it != _backlog.end()) {
+                    backlog.insert(*it);
+                }
+            }
+            _backlog = std::move(backlog);
         }
+        ON_BLOCK_EXIT([&] { _updateBacklogMetric(); });
 
         for (const auto& it : ttlIndexes) {
             try {
-                doTTLForIndex(&opCtx, it.first, it.second);
+                if (doTTLForIndex(&opCtx, it.nss, it.spec)) {
+                    ++_backlog[it.info];
+                } else {
+                    _backlog.erase(it.info);
+                }
             } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
                 warning() << "TTLMonitor was interrupted, waiting " << ttlMonitorSleepSecs.load()
                           << " seconds before doing another pass";
                 return;
             } catch (const DBException& dbex) {
-                error() << "Error processing ttl index: " << it.second << " -- " << dbex.toString();
+                error() << "Error processing ttl index: " << it.spec << " -- " << dbex.toString();
+                _backlog.erase(it.info);
                 // Continue on to the next index.
                 continue;
             }
         }
     }
 
+    void _updateBacklogMetric() {
+        ttlIndexesWithBacklog.store(_backlog.size());
+    }
+
     /**
      * Remove documents from the collection using the specified TTL index after a sufficient amount
-     * of time has passed according to its expiry specification.
+     * of time has passed according to its expiry specification. Returns true if the deletes
+     * stopped at ttlIndexDeleteBatchSize, in which case expired documents may be left over.
      */
-    void doTTLForIndex(OperationContext* opCtx, NamespaceString collectionNSS, BSONObj idx) {
+    bool doTTLForIndex(OperationContext* opCtx, NamespaceString collectionNSS, BSONObj idx) {
         if (collectionNSS.isDropPendingNamespace()) {
-            return;
+            return false;
         }
         if (!userAllowedWriteNS(collectionNSS).isOK()) {
             error() << "namespace '" << collectionNSS
                     << "' doesn't allow deletes, skipping ttl job for: " << idx;
-            return;
+            return false;
         }
 
         const BSONObj key = idx["key"].Obj();
         const StringData name = idx["name"].valueStringData();
         if (key.nFields() != 1) {
             error() << "key for ttl index can only have 1 field, skipping ttl job for: " << idx;
-            return;
+            return false;
         }
 
         LOG(1) << "ns: " << collectionNSS << " key: " << key << " name: " << name;
@@ -223,18 +287,18 @@ private:
         Collection* collection = autoGetCollection.getCollection();
         if (!collection) {
             // Collection was dropped.
-            return;
+            return false;
         }
 
         if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, collectionNSS)) {
-            return;
+            return false;
         }
 
         const IndexDescriptor* desc = collection->getIndexCatalog()->findIndexByName(opCtx, name);
         if (!desc) {
             LOG(1) << "index not found (index build in progress? index dropped?), skipping "
                    << "ttl job for: " << idx;
-            return;
+            return false;
         }
 
         // Re-read 'idx' from the descriptor, in case the collection or index definition changed
@@ -243,7 +307,7 @@ private:
 
         if (IndexType::INDEX_BTREE != IndexNames::nameToType(desc->getAccessMethodName())) {
             error() << "special index can't be used as a ttl index, skipping ttl job for: " << idx;
-            return;
+            return false;
         }
 
         BSONElement secondsExpireElt = idx[secondsExpireField];
@@ -251,7 +315,7 @@ private:
             error() << "ttl indexes require the " << secondsExpireField << " field to be "
                     << "numeric but received a type of " << typeName(secondsExpireElt.type())
                     << ", skipping ttl job for: " << idx;
-            return;
+            return false;
         }
 
         const Date_t kDawnOfTime =
@@ -280,6 +344,11 @@ private:
         params->isMulti = true;
         params->canonicalQuery = canonicalQuery.getValue().get();
 
+        const long long batchSize = ttlIndexDeleteBatchSize.load();
+        if (batchSize > 0) {
+            params->limit = batchSize;
+        }
+
         auto exec =
             InternalPlanner::deleteWithIndexScan(opCtx,
                                                  collection,
@@ -295,15 +364,23 @@ private:
         if (!result.isOK()) {
             error() << "ttl query execution for index " << idx
                     << " failed with status: " << redact(result);
-            return;
+            return false;
         }
 
         const long long numDeleted = DeleteStage::getNumDeleted(*exec);
         ttlDeletedDocuments.increment(numDeleted);
         LOG(1) << "deleted: " << numDeleted;
+
+        return batchSize > 0 && numDeleted >= batchSize;
     }
 
     ServiceContext* _serviceContext;
+
+    // The TTL indexes whose last visit stopped at ttlIndexDeleteBatchSize, mapped to the number of
+    // consecutive passes that did so.
+    std::map<TTLInfo, int> _backlog;
+
+    Date_t _lastFullPass;
 };
 
 namespace {
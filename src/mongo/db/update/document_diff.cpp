@@ -0,0 +1,192 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/document_diff.h"
+
+#include <string>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/update/log_builder.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace doc_diff {
+namespace {
+
+class DiffBuilder {
+public:
+    /**
+     * Records the differences between the fields of 'pre' and 'post', the objects at 'prefix',
+     * which is empty or ends with a dot. Returns false without recording anything if 'post' must
+     * be set as a whole.
+     */
+    bool diffObjects(const BSONObj& pre, const BSONObj& post, const std::string& prefix) {
+        StringMap<BSONElement> preFields;
+        for (auto&& elem : pre) {
+            if (!isPathComponent(elem.fieldNameStringData()) ||
+                !preFields.emplace(elem.fieldNameStringData(), elem).second) {
+                return false;
+            }
+        }
+
+        StringMap<BSONElement> postFields;
+        for (auto&& elem : post) {
+            if (!isPathComponent(elem.fieldNameStringData()) ||
+                !postFields.emplace(elem.fieldNameStringData(), elem).second) {
+                return false;
+            }
+        }
+
+        // The fields of 'post' must be those of 'pre' which were kept, in the same order,
+        // followed by the new fields in field name order, as the update system appends the new
+        // fields of an object in lexicographic order when applying the diff.
+        BSONObjIterator preIt(pre);
+        boost::optional<StringData> lastAddedField;
+        for (auto&& elem : post) {
+            auto fieldName = elem.fieldNameStringData();
+            if (preFields.find(fieldName) == preFields.end()) {
+                if (lastAddedField && fieldName <= *lastAddedField) {
+                    return false;
+                }
+                lastAddedField = fieldName;
+                continue;
+            }
+
+            if (lastAddedField) {
+                return false;
+            }
+            while (true) {
+                auto preFieldName = preIt.next().fieldNameStringData();
+                if (preFieldName == fieldName) {
+                    break;
+                }
+                if (postFields.find(preFieldName) != postFields.end()) {
+                    return false;
+                }
+            }
+        }
+
+        for (auto&& preElem : pre) {
+            auto postElem = postFields.find(preElem.fieldNameStringData());
+            if (postElem == postFields.end()) {
+                _unsets.append(prefix + preElem.fieldName(), true);
+            } else {
+                diffValues(preElem, postElem->second, prefix + preElem.fieldName());
+            }
+        }
+        for (auto&& postElem : post) {
+            if (preFields.find(postElem.fieldNameStringData()) == preFields.end()) {
+                _sets.appendAs(postElem, prefix + postElem.fieldName());
+            }
+        }
+        return true;
+    }
+
+    BSONObj obj() {
+        BSONObjBuilder builder;
+        builder.append(LogBuilder::kUpdateSemanticsFieldName,
+                       static_cast<int>(UpdateSemantics::kUpdateNode));
+        auto sets = _sets.done();
+        if (!sets.isEmpty()) {
+            builder.append("$set"_sd, sets);
+        }
+        auto unsets = _unsets.done();
+        if (!unsets.isEmpty()) {
+            builder.append("$unset"_sd, unsets);
+        }
+        return builder.obj();
+    }
+
+private:
+    static bool isPathComponent(StringData fieldName) {
+        return !fieldName.empty() && fieldName[0] != '$' &&
+            fieldName.find('.') == std::string::npos;
+    }
+
+    /**
+     * Records the change of the value at 'path' from 'pre' to 'post'.
+     */
+    void diffValues(const BSONElement& pre, const BSONElement& post, const std::string& path) {
+        if (pre.type() == post.type() && pre.binaryEqualValues(post)) {
+            return;
+        }
+
+        if (pre.type() == Object && post.type() == Object) {
+            if (diffObjects(pre.embeddedObject(), post.embeddedObject(), path + '.')) {
+                return;
+            }
+        } else if (pre.type() == Array && post.type() == Array) {
+            if (diffArrays(pre.embeddedObject(), post.embeddedObject(), path + '.')) {
+                return;
+            }
+        }
+        _sets.appendAs(post, path);
+    }
+
+    /**
+     * Records the changes between the arrays 'pre' and 'post' element by element, which is only
+     * possible if they have the same length. Returns false without recording anything otherwise.
+     */
+    bool diffArrays(const BSONObj& pre, const BSONObj& post, const std::string& prefix) {
+        if (pre.nFields() != post.nFields()) {
+            return false;
+        }
+
+        BSONObjIterator postIt(post);
+        for (auto&& preElem : pre) {
+            auto postElem = postIt.next();
+            diffValues(preElem, postElem, prefix + preElem.fieldName());
+        }
+        return true;
+    }
+
+    BSONObjBuilder _sets;
+    BSONObjBuilder _unsets;
+};
+
+}  // namespace
+
+boost::optional<BSONObj> computeOplogDiff(const BSONObj& pre, const BSONObj& post) {
+    auto preId = pre["_id"];
+    auto postId = post["_id"];
+    if (!preId.binaryEqual(postId)) {
+        return boost::none;
+    }
+
+    DiffBuilder builder;
+    if (!builder.diffObjects(pre, post, "")) {
+        return boost::none;
+    }
+    return builder.obj();
+}
+
+}  // namespace doc_diff
+}  // namespace mongo
@@ -0,0 +1,55 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+namespace doc_diff {
+
+/**
+ * Computes an oplog entry for an operator-style update, of the form
+ * {$v: 1, $set: {<path>: <value>, ...}, $unset: {<path>: true, ...}}, which turns 'pre' into
+ * 'post' when applied to it. Only the fields whose values differ are recorded, at any depth:
+ * changed fields of embedded objects are set by their dotted path, as are changed elements of
+ * arrays whose length is unchanged.
+ *
+ * Objects whose changes cannot be expressed this way are set as a whole. This is the case for
+ * objects whose common fields were reordered, whose new fields do not all come after the existing
+ * ones in field name order, or which contain field names that are not valid path components.
+ * Returns boost::none if this applies to 'pre' itself, or if the _id differs, in which case the
+ * caller must log the whole of 'post' instead.
+ */
+boost::optional<BSONObj> computeOplogDiff(const BSONObj& pre, const BSONObj& post);
+
+}  // namespace doc_diff
+}  // namespace mongo
@@ -0,0 +1,140 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/document_diff.h"
+
+#include "mongo/bson/mutable/document.h"
+#include "mongo/db/json.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/update/update_driver.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Computes the diff from 'pre' to 'post', checks that applying it to 'pre' the way a secondary
+ * would produces exactly 'post', and returns it.
+ */
+BSONObj diffAndApply(const BSONObj& pre, const BSONObj& post) {
+    auto diff = doc_diff::computeOplogDiff(pre, post);
+    ASSERT_TRUE(diff);
+
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    UpdateDriver driver(expCtx);
+    driver.setFromOplogApplication(true);
+    std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+    driver.parse(*diff, arrayFilters);
+
+    mutablebson::Document doc(pre);
+    FieldRefSet immutablePaths;
+    ASSERT_OK(driver.update(StringData(), &doc, false, immutablePaths, false));
+    ASSERT_BSONOBJ_EQ(post, doc.getObject());
+    ASSERT_TRUE(post.binaryEqual(doc.getObject()));
+    return *diff;
+}
+
+TEST(DocumentDiffTest, RecordsChangedTopLevelFields) {
+    ASSERT_BSONOBJ_EQ(fromjson("{$v: 1, $set: {b: 3, d: 'x'}, $unset: {c: true}}"),
+                      diffAndApply(fromjson("{_id: 0, a: 1, b: 2, c: 'big'}"),
+                                   fromjson("{_id: 0, a: 1, b: 3, d: 'x'}")));
+}
+
+TEST(DocumentDiffTest, RecordsChangesInsideEmbeddedObjects) {
+    ASSERT_BSONOBJ_EQ(
+        fromjson("{$v: 1, $set: {'a.b.c': 2, 'a.e': 1}, $unset: {'a.d': true}}"),
+        diffAndApply(fromjson("{_id: 0, a: {b: {c: 1, x: 1}, d: 1}}"),
+                     fromjson("{_id: 0, a: {b: {c: 2, x: 1}, e: 1}}")));
+}
+
+TEST(DocumentDiffTest, RecordsChangedArrayElements) {
+    ASSERT_BSONOBJ_EQ(
+        fromjson("{$v: 1, $set: {'a.1': 5, 'a.2.b': 2}}"),
+        diffAndApply(fromjson("{_id: 0, a: [1, 2, {b: 1}, 4]}"),
+                     fromjson("{_id: 0, a: [1, 5, {b: 2}, 4]}")));
+}
+
+TEST(DocumentDiffTest, SetsArraysWhoseLengthChanged) {
+    ASSERT_BSONOBJ_EQ(fromjson("{$v: 1, $set: {'a.b': [1, 2, 3]}}"),
+                      diffAndApply(fromjson("{_id: 0, a: {b: [1, 2], c: 1}}"),
+                                   fromjson("{_id: 0, a: {b: [1, 2, 3], c: 1}}")));
+}
+
+TEST(DocumentDiffTest, SetsValuesWhoseTypeChanged) {
+    ASSERT_BSONOBJ_EQ(fromjson("{$v: 1, $set: {a: [1], b: {'0': 1}, c: 1.0}}"),
+                      diffAndApply(fromjson("{_id: 0, a: {'0': 1}, b: [1], c: 1}"),
+                                   fromjson("{_id: 0, a: [1], b: {'0': 1}, c: 1.0}")));
+}
+
+TEST(DocumentDiffTest, SetsObjectsWhoseFieldsCannotBeAppendedInOrder) {
+    // Reordered fields.
+    ASSERT_BSONOBJ_EQ(fromjson("{$v: 1, $set: {a: {c: 1, b: 1}}}"),
+                      diffAndApply(fromjson("{_id: 0, a: {b: 1, c: 1}}"),
+                                   fromjson("{_id: 0, a: {c: 1, b: 1}}")));
+
+    // New fields which are not in field name order.
+    ASSERT_BSONOBJ_EQ(fromjson("{$v: 1, $set: {a: {x: 1, c: 1, b: 1}}}"),
+                      diffAndApply(fromjson("{_id: 0, a: {x: 1}}"),
+                                   fromjson("{_id: 0, a: {x: 1, c: 1, b: 1}}")));
+
+    // A new field before an existing one.
+    ASSERT_BSONOBJ_EQ(fromjson("{$v: 1, $set: {a: {b: 1, x: 1}}}"),
+                      diffAndApply(fromjson("{_id: 0, a: {x: 1}}"),
+                                   fromjson("{_id: 0, a: {b: 1, x: 1}}")));
+}
+
+TEST(DocumentDiffTest, SetsObjectsWithFieldNamesThatAreNotPathComponents) {
+    ASSERT_BSONOBJ_EQ(fromjson("{$v: 1, $set: {a: {'b.c': 2}}}"),
+                      diffAndApply(fromjson("{_id: 0, a: {'b.c': 1}}"),
+                                   fromjson("{_id: 0, a: {'b.c': 2}}")));
+}
+
+TEST(DocumentDiffTest, IdenticalDocumentsHaveAnEmptyDiff) {
+    ASSERT_BSONOBJ_EQ(fromjson("{$v: 1}"),
+                      *doc_diff::computeOplogDiff(fromjson("{_id: 0, a: [1, {b: 1}]}"),
+                                                  fromjson("{_id: 0, a: [1, {b: 1}]}")));
+}
+
+TEST(DocumentDiffTest, FailsWhenTopLevelFieldsCannotBeAppendedInOrder) {
+    ASSERT_FALSE(doc_diff::computeOplogDiff(fromjson("{_id: 0, a: 1, b: 1}"),
+                                            fromjson("{_id: 0, b: 1, a: 1}")));
+    ASSERT_FALSE(doc_diff::computeOplogDiff(fromjson("{_id: 0, a: 1}"),
+                                            fromjson("{_id: 0, a: 1, c: 1, b: 1}")));
+}
+
+TEST(DocumentDiffTest, FailsWhenIdChanges) {
+    ASSERT_FALSE(
+        doc_diff::computeOplogDiff(fromjson("{_id: 0, a: 1}"), fromjson("{_id: 1, a: 1}")));
+    ASSERT_FALSE(doc_diff::computeOplogDiff(fromjson("{_id: 0, a: 1}"), fromjson("{a: 1}")));
+}
+
+}  // namespace
+}  // namespace mongo
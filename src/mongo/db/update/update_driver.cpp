@@ -29,6 +29,7 @@
 
 #include "mongo/db/update/update_driver.h"
 
+#include <algorithm>
 
 #include "mongo/base/error_codes.h"
 #include "mongo/base/string_data.h"
@@ -39,12 +40,14 @@
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/update/document_diff.h"
 #include "mongo/db/update/log_builder.h"
 #include "mongo/db/update/modifier_table.h"
 #include "mongo/db/update/object_replace_executor.h"
 #include "mongo/db/update/path_support.h"
 #include "mongo/db/update/storage_validation.h"
 #include "mongo/util/embedded_builder.h"
+#include "mongo/util/safe_num.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -192,6 +195,56 @@ void UpdateDriver::parse(
     auto root = std::make_unique<UpdateObjectNode>();
     _positional = parseUpdateExpression(updateExpr, root.get(), _expCtx, arrayFilters);
     _updateExecutor = std::make_unique<UpdateTreeExecutor>(std::move(root));
+
+    if (!_positional && arrayFilters.empty()) {
+        initInPlaceMods(updateExpr);
+    }
+}
+
+void UpdateDriver::initInPlaceMods(const BSONObj& updateExpr) {
+    std::vector<InPlaceMod> mods;
+    for (auto&& mod : updateExpr) {
+        auto modName = mod.fieldNameStringData();
+        if (modName == LogBuilder::kUpdateSemanticsFieldName) {
+            continue;
+        }
+
+        const bool isIncrement = modName == "$inc"_sd;
+        if (!isIncrement && modName != "$set"_sd) {
+            return;
+        }
+
+        for (auto&& field : mod.Obj()) {
+            auto fieldName = field.fieldNameStringData();
+            if (fieldName.find('.') != std::string::npos || fieldName.startsWith("$") ||
+                fieldName == "_id"_sd) {
+                return;
+            }
+
+            // Only values whose size is fixed by their type can be overwritten in place.
+            switch (field.type()) {
+                case NumberInt:
+                case NumberLong:
+                case NumberDouble:
+                case NumberDecimal:
+                    break;
+                case Bool:
+                case Date:
+                    if (isIncrement) {
+                        return;
+                    }
+                    break;
+                default:
+                    return;
+            }
+            mods.push_back({FieldRef(fieldName), isIncrement, field});
+        }
+    }
+
+    std::sort(mods.begin(), mods.end(), [](const InPlaceMod& lhs, const InPlaceMod& rhs) {
+        return lhs.path.dottedField() < rhs.path.dottedField();
+    });
+    _inPlaceMods = std::move(mods);
 }
 
 Status UpdateDriver::populateDocumentWithQueryFields(OperationContext* opCtx,
@@ -274,6 +327,12 @@ Status UpdateDriver::update(StringData matchedField,
         applyParams.logBuilder = &logBuilder;
     }
 
+    // Pipeline-style updates are logged as a diff from the original document where possible.
+    boost::optional<BSONObj> preImage;
+    if (_updateType == UpdateType::kPipeline && _logOp && logOpRec) {
+        preImage = doc->getObject();
+    }
+
     invariant(_updateExecutor);
     auto applyResult = _updateExecutor->applyUpdate(applyParams);
     if (applyResult.indexesAffected) {
@@ -297,12 +356,105 @@ Status UpdateDriver::update(StringData matchedField,
         invariant(logBuilder.setUpdateSemantics(UpdateSemantics::kUpdateNode));
     }
 
-    if (_logOp && logOpRec)
+    if (_logOp && logOpRec) {
         *logOpRec = _logDoc.getObject();
 
+        // Only use the diff if it is smaller than the replacement document it stands in for.
+        if (preImage && !applyResult.noop) {
+            auto diff = doc_diff::computeOplogDiff(*preImage, doc->getObject());
+            if (diff && diff->objsize() < logOpRec->objsize()) {
+                *logOpRec = std::move(*diff);
+            }
+        }
+    }
+
     return Status::OK();
 }
 
+bool UpdateDriver::applyInPlace(const BSONObj& original,
+                                const FieldRefSet& immutablePaths,
+                                mutablebson::DamageVector* damages,
+                                BSONObj* damageSource,
+                                BSONObj* logOpRec,
+                                bool* docWasModified) {
+    if (_inPlaceMods.empty()) {
+        return false;
+    }
+
+    // Find the existing values and compute the new ones before touching anything, so that any
+    // reason to fall back to update() is discovered while there is still nothing to undo.
+    std::vector<BSONElement> updatedElements;
+    BSONObjBuilder setBuilder;
+    for (auto&& mod : _inPlaceMods) {
+        if ((_indexedFields && _indexedFields->mightBeIndexed(mod.path)) ||
+            immutablePaths.findConflicts(&mod.path, nullptr)) {
+            return false;
+        }
+
+        BSONElement existing = original[mod.path.dottedField()];
+        if (!existing) {
+            return false;
+        }
+
+        if (mod.isIncrement) {
+            if (!existing.isNumber()) {
+                return false;
+            }
+            SafeNum originalValue(existing);
+            SafeNum newValue = SafeNum(mod.value) + originalValue;
+            if (!newValue.isValid() || newValue.type() != existing.type()) {
+                return false;
+            }
+            if (newValue.isIdentical(originalValue)) {
+                continue;
+            }
+            newValue.toBSON(existing.fieldNameStringData(), &setBuilder);
+        } else {
+            if (mod.value.type() != existing.type()) {
+                return false;
+            }
+            if (existing.binaryEqualValues(mod.value)) {
+                continue;
+            }
+            setBuilder.appendAs(mod.value, existing.fieldNameStringData());
+        }
+        updatedElements.push_back(existing);
+    }
+
+    // The modified fields are logged as a $set of their new values, as the update tree would log
+    // them, and the values within the log entry double as the source of the damages.
+    BSONObjBuilder logBuilder;
+    logBuilder.append(LogBuilder::kUpdateSemanticsFieldName,
+                      static_cast<int>(UpdateSemantics::kUpdateNode));
+    if (!updatedElements.empty()) {
+        logBuilder.append("$set"_sd, setBuilder.done());
+    }
+    *damageSource = logBuilder.obj();
+
+    damages->clear();
+    if (!updatedElements.empty()) {
+        BSONObjIterator newValues(damageSource->getObjectField("$set"_sd));
+        for (auto&& existing : updatedElements) {
+            BSONElement newValue = newValues.next();
+            invariant(newValue.valuesize() == existing.valuesize());
+            damages->push_back({static_cast<mutablebson::DamageEvent::OffsetSizeType>(
+                                    newValue.value() - damageSource->objdata()),
+                                static_cast<mutablebson::DamageEvent::OffsetSizeType>(
+                                    existing.value() - original.objdata()),
+                                static_cast<size_t>(existing.valuesize())});
+        }
+    }
+
+    _affectIndices = false;
+    if (docWasModified) {
+        *docWasModified = !updatedElements.empty();
+    }
+    if (_logOp && logOpRec) {
+        *logOpRec = *damageSource;
+    }
+    return true;
+}
+
 void UpdateDriver::setCollator(const CollatorInterface* collator) {
     _expCtx->setCollator(collator);
 
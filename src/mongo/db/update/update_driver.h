@@ -34,6 +34,7 @@
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/base/status.h"
+#include "mongo/bson/mutable/damage_vector.h"
 #include "mongo/bson/mutable/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/field_ref_set.h"
@@ -124,6 +125,32 @@ public:
                   bool* docWasModified = nullptr,
                   FieldRefSetWithStorage* modifiedPaths = nullptr);
 
+    /**
+     * Attempts to apply the update directly to the bytes of 'original', without building a
+     * mutable document. This is only possible for updates made of $set and $inc on existing
+     * top-level fields, where every new value has the same BSON type, and therefore the same size,
+     * as the value it replaces, and none of the fields is indexed or in 'immutablePaths'.
+     *
+     * Returns false if the update cannot be applied this way, in which case nothing has been done
+     * and the caller must use update(). Otherwise fills 'damages' with the byte ranges to write
+     * into 'original', whose source offsets are relative to 'damageSource->objdata()', and sets
+     * 'docWasModified'. If the driver's '_logOp' mode is turned on, and if 'logOpRec' is not
+     * null, also fills in the latter with the oplog entry corresponding to the update.
+     */
+    bool applyInPlace(const BSONObj& original,
+                      const FieldRefSet& immutablePaths,
+                      mutablebson::DamageVector* damages,
+                      BSONObj* damageSource,
+                      BSONObj* logOpRec,
+                      bool* docWasModified);
+
+    /**
+     * Returns true if applyInPlace() may succeed for this update, depending on the document.
+     */
+    bool canApplyInPlace() const {
+        return !_inPlaceMods.empty();
+    }
+
     /**
      * Passes the visitor through to the root of the update tree. The visitor is responsible for
      * implementing methods that operate on the nodes of the tree.
@@ -204,6 +231,22 @@ private:
     /** Create the modifier and add it to the back of the modifiers vector */
     inline Status addAndParse(const modifiertable::ModifierType type, const BSONElement& elem);
 
+    /**
+     * A $set or $inc of a top-level field which applyInPlace() may be able to write over the
+     * existing value.
+     */
+    struct InPlaceMod {
+        FieldRef path;
+        bool isIncrement;
+        BSONElement value;
+    };
+
+    /**
+     * Fills '_inPlaceMods' if every modifier in the operator-style 'updateExpr' is eligible for
+     * applyInPlace(), and leaves it empty otherwise.
+     */
+    void initInPlaceMods(const BSONObj& updateExpr);
+
     //
     // immutable properties after parsing
     //
@@ -237,6 +280,11 @@ private:
     // Do any of the mods require positional match details when calling 'prepare'?
     bool _positional = false;
 
+    // The modifiers of the update in field name order, which is the order in which the update
+    // tree applies and logs them, if the update is eligible for applyInPlace(). The values
+    // point into the update expression, which must outlive the driver.
+    std::vector<InPlaceMod> _inPlaceMods;
+
     // The document used to represent or store the object being updated.
     mutablebson::Document _objDoc;
 
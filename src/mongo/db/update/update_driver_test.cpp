@@ -30,6 +30,7 @@
 #include "mongo/db/update/update_driver.h"
 
 
+#include <cstring>
 #include <map>
 
 #include "mongo/base/owned_pointer_vector.h"
@@ -170,6 +171,115 @@ TEST(Parse, SetOnInsert) {
     ASSERT_FALSE(driver.type() == UpdateDriver::UpdateType::kReplacement);
 }
 
+/**
+ * Applies 'updateSpec' to 'doc' with UpdateDriver::applyInPlace(), and checks that the document
+ * and oplog entry produced by writing the resulting damages over 'doc' match those produced by
+ * UpdateDriver::update(). Returns false if the update could not be applied in place.
+ */
+bool applyInPlaceMatchesUpdate(const BSONObj& doc,
+                               const BSONObj& updateSpec,
+                               bool expectModified = true,
+                               const UpdateIndexData* indexData = nullptr) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    UpdateDriver driver(expCtx);
+    std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+    driver.parse(updateSpec, arrayFilters);
+    driver.setLogOp(true);
+    driver.refreshIndexKeys(indexData);
+
+    FieldRefSet immutablePaths;
+    mutablebson::DamageVector damages;
+    BSONObj damageSource;
+    BSONObj logObj;
+    bool docWasModified = false;
+    if (!driver.applyInPlace(
+            doc, immutablePaths, &damages, &damageSource, &logObj, &docWasModified)) {
+        return false;
+    }
+    ASSERT_EQ(expectModified, docWasModified);
+    ASSERT_EQ(expectModified, !damages.empty());
+
+    std::string buffer(doc.objdata(), doc.objsize());
+    for (auto&& damage : damages) {
+        std::memcpy(&buffer[damage.targetOffset],
+                    damageSource.objdata() + damage.sourceOffset,
+                    damage.size);
+    }
+    BSONObj inPlaceResult(buffer.data());
+
+    mutablebson::Document mutableDoc(doc);
+    BSONObj expectedLogObj;
+    bool expectedDocWasModified = false;
+    ASSERT_OK(driver.update(StringData(),
+                            &mutableDoc,
+                            false,
+                            immutablePaths,
+                            false,
+                            &expectedLogObj,
+                            &expectedDocWasModified));
+    ASSERT_EQ(expectedDocWasModified, docWasModified);
+    ASSERT_BSONOBJ_EQ(mutableDoc.getObject(), inPlaceResult);
+    ASSERT_TRUE(mutableDoc.getObject().binaryEqual(inPlaceResult));
+    if (docWasModified) {
+        ASSERT_BSONOBJ_EQ(expectedLogObj, logObj);
+        ASSERT_TRUE(expectedLogObj.binaryEqual(logObj));
+    }
+    return true;
+}
+
+TEST(ApplyInPlace, SetsFixedSizeValues) {
+    ASSERT_TRUE(applyInPlaceMatchesUpdate(
+        fromjson("{_id: 1, a: 1, b: 2.5, c: true, d: {$date: 0}, e: NumberLong(3)}"),
+        fromjson("{$set: {e: NumberLong(4), c: false, a: 5, d: {$date: 1000}, b: -1.5}}")));
+}
+
+TEST(ApplyInPlace, IncrementsNumbers) {
+    ASSERT_TRUE(applyInPlaceMatchesUpdate(fromjson("{_id: 1, a: 1, b: NumberLong(2), c: 2.5}"),
+                                          fromjson("{$inc: {a: 1, b: 2, c: 0.5}}")));
+}
+
+TEST(ApplyInPlace, CombinesSetAndIncrement) {
+    ASSERT_TRUE(applyInPlaceMatchesUpdate(fromjson("{_id: 1, a: 1, b: 'x', c: false}"),
+                                          fromjson("{$inc: {a: -3}, $set: {c: true}}")));
+}
+
+TEST(ApplyInPlace, SkipsUnchangedValues) {
+    ASSERT_TRUE(applyInPlaceMatchesUpdate(fromjson("{_id: 1, a: 1, b: 2}"),
+                                          fromjson("{$inc: {a: 0}, $set: {b: 3}}")));
+    ASSERT_TRUE(applyInPlaceMatchesUpdate(
+        fromjson("{_id: 1, a: 1, b: 2}"), fromjson("{$inc: {a: 0}, $set: {b: 2}}"), false));
+}
+
+TEST(ApplyInPlace, FallsBackWhenTypeChanges) {
+    ASSERT_FALSE(
+        applyInPlaceMatchesUpdate(fromjson("{_id: 1, a: 1}"), fromjson("{$set: {a: 1.5}}")));
+    ASSERT_FALSE(
+        applyInPlaceMatchesUpdate(fromjson("{_id: 1, a: 1}"), fromjson("{$inc: {a: 0.5}}")));
+    ASSERT_FALSE(applyInPlaceMatchesUpdate(BSON("_id" << 1 << "a" << 2147483647),
+                                           fromjson("{$inc: {a: 1}}")));
+}
+
+TEST(ApplyInPlace, FallsBackForMissingVariableSizeOrNestedFields) {
+    ASSERT_FALSE(applyInPlaceMatchesUpdate(fromjson("{_id: 1}"), fromjson("{$set: {a: 1}}")));
+    ASSERT_FALSE(
+        applyInPlaceMatchesUpdate(fromjson("{_id: 1, a: 'x'}"), fromjson("{$set: {a: 'y'}}")));
+    ASSERT_FALSE(applyInPlaceMatchesUpdate(fromjson("{_id: 1, a: {b: 1}}"),
+                                           fromjson("{$set: {'a.b': 2}}")));
+    ASSERT_FALSE(
+        applyInPlaceMatchesUpdate(fromjson("{_id: 1, a: 'x'}"), fromjson("{$inc: {a: 1}}")));
+    ASSERT_FALSE(applyInPlaceMatchesUpdate(fromjson("{_id: 1, a: 1, b: 1}"),
+                                           fromjson("{$set: {a: 2}, $unset: {b: 1}}")));
+}
+
+TEST(ApplyInPlace, FallsBackForIndexedFields) {
+    UpdateIndexData indexData;
+    indexData.addPath(FieldRef("a"));
+    ASSERT_FALSE(applyInPlaceMatchesUpdate(
+        fromjson("{_id: 1, a: 1}"), fromjson("{$inc: {a: 1}}"), true, &indexData));
+    ASSERT_TRUE(applyInPlaceMatchesUpdate(
+        fromjson("{_id: 1, a: 1, b: 1}"), fromjson("{$inc: {b: 1}}"), true, &indexData));
+}
+
 TEST(Collator, SetCollationUpdatesModifierInterfaces) {
     boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
     CollatorInterfaceMock reverseStringCollator(CollatorInterfaceMock::MockType::kReverseString);
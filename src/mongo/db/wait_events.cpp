@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/wait_events.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/concurrency/sharded_counter.h"
+#include "mongo/util/system_tick_source.h"
+
+namespace mongo {
+namespace {
+
+struct GlobalEntry {
+    ShardedCounter count;
+    ShardedCounter micros;
+};
+
+std::array<GlobalEntry, kNumWaitEvents> globalWaitEvents;
+
+}  // namespace
+
+const OperationContext::Decoration<WaitEventStats> WaitEventStats::get =
+    OperationContext::declareDecoration<WaitEventStats>();
+
+StringData toString(WaitEvent event) {
+    switch (event) {
+        case WaitEvent::kLock:
+            return "lock"_sd;
+        case WaitEvent::kTicket:
+            return "ticket"_sd;
+        case WaitEvent::kFlowControl:
+            return "flowControl"_sd;
+        case WaitEvent::kPrepareConflict:
+            return "prepareConflict"_sd;
+        case WaitEvent::kCacheEviction:
+            return "cacheEviction"_sd;
+        case WaitEvent::kJournalFlush:
+            return "journalFlush"_sd;
+        case WaitEvent::kWriteConcern:
+            return "writeConcern"_sd;
+        case WaitEvent::kNetwork:
+            return "network"_sd;
+        case WaitEvent::kYield:
+            return "yield"_sd;
+    }
+    MONGO_UNREACHABLE;
+}
+
+bool WaitEventStats::empty() const {
+    for (const auto& entry : _entries) {
+        if (entry.count > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void WaitEventStats::append(BSONObjBuilder* builder) const {
+    for (size_t i = 0; i < kNumWaitEvents; ++i) {
+        const auto& entry = _entries[i];
+        if (entry.count == 0) {
+            continue;
+        }
+
+        BSONObjBuilder entryBuilder(builder->subobjStart(toString(static_cast<WaitEvent>(i))));
+        entryBuilder.append("count", entry.count);
+        entryBuilder.append("micros", entry.micros);
+    }
+}
+
+void WaitEvents::record(OperationContext* opCtx, WaitEvent event, Microseconds elapsed) {
+    if (opCtx) {
+        WaitEventStats::get(opCtx).record(event, elapsed);
+    }
+
+    auto& globalEntry = globalWaitEvents[static_cast<size_t>(event)];
+    globalEntry.count.add(1);
+    globalEntry.micros.add(durationCount<Microseconds>(elapsed));
+}
+
+void WaitEvents::appendGlobalStats(BSONObjBuilder* builder) {
+    for (size_t i = 0; i < kNumWaitEvents; ++i) {
+        const auto& globalEntry = globalWaitEvents[i];
+        BSONObjBuilder entryBuilder(builder->subobjStart(toString(static_cast<WaitEvent>(i))));
+        entryBuilder.append("count", globalEntry.count.load());
+        entryBuilder.append("micros", globalEntry.micros.load());
+    }
+}
+
+namespace {
+
+TickSource* tickSourceFor(OperationContext* opCtx) {
+    auto serviceContext = opCtx ? opCtx->getServiceContext() : nullptr;
+    return serviceContext ? serviceContext->getTickSource() : SystemTickSource::get();
+}
+
+}  // namespace
+
+ScopedWaitEvent::ScopedWaitEvent(OperationContext* opCtx, WaitEvent event)
+    : _opCtx(opCtx),
+      _event(event),
+      _tickSource(tickSourceFor(opCtx)),
+      _start(_tickSource->getTicks()) {}
+
+ScopedWaitEvent::~ScopedWaitEvent() {
+    const auto elapsed = _tickSource->ticksTo<Microseconds>(_tickSource->getTicks() - _start);
+    if (elapsed > Microseconds(0)) {
+        WaitEvents::record(_opCtx, _event, elapsed);
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,137 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/util/tick_source.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * The classes of waits an operation can block on. Each blocking point in the server records the
+ * time it spends waiting under one of these classes, so that the time an operation was not
+ * running can be broken down by cause, per operation and server-wide.
+ *
+ * The classes can overlap: a yield includes the lock waits made to reacquire the locks.
+ */
+enum class WaitEvent {
+    kLock,
+    kTicket,
+    kFlowControl,
+    kPrepareConflict,
+    kCacheEviction,
+    kJournalFlush,
+    kWriteConcern,
+    kNetwork,
+    kYield,
+};
+
+constexpr size_t kNumWaitEvents = static_cast<size_t>(WaitEvent::kYield) + 1;
+
+StringData toString(WaitEvent event);
+
+/**
+ * The number of waits and the time spent in them, per wait class, of a single operation. Only the
+ * thread running the operation updates it.
+ */
+class WaitEventStats {
+public:
+    struct Entry {
+        long long count = 0;
+        long long micros = 0;
+    };
+
+    static const OperationContext::Decoration<WaitEventStats> get;
+
+    void record(WaitEvent event, Microseconds elapsed) {
+        auto& entry = _entries[static_cast<size_t>(event)];
+        ++entry.count;
+        entry.micros += durationCount<Microseconds>(elapsed);
+    }
+
+    const Entry& getEntry(WaitEvent event) const {
+        return _entries[static_cast<size_t>(event)];
+    }
+
+    bool empty() const;
+
+    /**
+     * Appends a {count, micros} subobject for each wait class the operation waited on.
+     */
+    void append(BSONObjBuilder* builder) const;
+
+private:
+    std::array<Entry, kNumWaitEvents> _entries;
+};
+
+/**
+ * Records waits into the operation that waited, if there is one, and into the server-wide totals.
+ */
+class WaitEvents {
+public:
+    /**
+     * Records a wait of 'elapsed' of class 'event'. The 'opCtx' may be null for waits which do not
+     * belong to an operation, in which case only the server-wide totals are updated.
+     */
+    static void record(OperationContext* opCtx, WaitEvent event, Microseconds elapsed);
+
+    /**
+     * Appends a {count, micros} subobject for each wait class, as reported by serverStatus.
+     */
+    static void appendGlobalStats(BSONObjBuilder* builder);
+};
+
+/**
+ * Times the scope it lives in and records it as a wait of the given class when it ends, whether
+ * the wait succeeded or threw. Waits which took less than a microsecond are not recorded, so that
+ * a blocking point whose fast path did not actually block does not count as a wait.
+ */
+class ScopedWaitEvent {
+    ScopedWaitEvent(const ScopedWaitEvent&) = delete;
+    ScopedWaitEvent& operator=(const ScopedWaitEvent&) = delete;
+
+public:
+    ScopedWaitEvent(OperationContext* opCtx, WaitEvent event);
+    ~ScopedWaitEvent();
+
+private:
+    OperationContext* const _opCtx;
+    const WaitEvent _event;
+    TickSource* const _tickSource;
+    const TickSource::Tick _start;
+};
+
+}  // namespace mongo
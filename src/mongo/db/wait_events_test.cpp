@@ -0,0 +1,151 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/wait_events.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/tick_source_mock.h"
+
+namespace mongo {
+namespace {
+
+class WaitEventsTest : public ServiceContextTest {
+public:
+    void setUp() override {
+        ServiceContextTest::setUp();
+        auto tickSource = std::make_unique<TickSourceMock<Microseconds>>();
+        _tickSource = tickSource.get();
+        getServiceContext()->setTickSource(std::move(tickSource));
+    }
+
+    TickSourceMock<Microseconds>* tickSource() {
+        return _tickSource;
+    }
+
+    /**
+     * Returns the server-wide {count, micros} of the given wait class.
+     */
+    BSONObj globalStats(WaitEvent event) {
+        BSONObjBuilder builder;
+        WaitEvents::appendGlobalStats(&builder);
+        return builder.obj()[toString(event)].Obj().getOwned();
+    }
+
+private:
+    TickSourceMock<Microseconds>* _tickSource = nullptr;
+};
+
+TEST_F(WaitEventsTest, NewOperationHasNoWaits) {
+    auto opCtx = makeOperationContext();
+    const auto& stats = WaitEventStats::get(opCtx.get());
+    ASSERT_TRUE(stats.empty());
+
+    BSONObjBuilder builder;
+    stats.append(&builder);
+    ASSERT_BSONOBJ_EQ(builder.obj(), BSONObj());
+}
+
+TEST_F(WaitEventsTest, RecordUpdatesOperationAndGlobalStats) {
+    auto opCtx = makeOperationContext();
+    const auto before = globalStats(WaitEvent::kWriteConcern);
+
+    WaitEvents::record(opCtx.get(), WaitEvent::kWriteConcern, Microseconds(30));
+    WaitEvents::record(opCtx.get(), WaitEvent::kWriteConcern, Microseconds(12));
+
+    const auto& entry = WaitEventStats::get(opCtx.get()).getEntry(WaitEvent::kWriteConcern);
+    ASSERT_EQ(entry.count, 2);
+    ASSERT_EQ(entry.micros, 42);
+
+    const auto after = globalStats(WaitEvent::kWriteConcern);
+    ASSERT_EQ(after["count"].numberLong() - before["count"].numberLong(), 2);
+    ASSERT_EQ(after["micros"].numberLong() - before["micros"].numberLong(), 42);
+}
+
+TEST_F(WaitEventsTest, RecordWithoutOperationOnlyUpdatesGlobalStats) {
+    const auto before = globalStats(WaitEvent::kLock);
+    WaitEvents::record(nullptr, WaitEvent::kLock, Microseconds(5));
+
+    const auto after = globalStats(WaitEvent::kLock);
+    ASSERT_EQ(after["count"].numberLong() - before["count"].numberLong(), 1);
+    ASSERT_EQ(after["micros"].numberLong() - before["micros"].numberLong(), 5);
+}
+
+TEST_F(WaitEventsTest, AppendOnlyReportsClassesWaitedOn) {
+    auto opCtx = makeOperationContext();
+    WaitEvents::record(opCtx.get(), WaitEvent::kTicket, Microseconds(7));
+    WaitEvents::record(opCtx.get(), WaitEvent::kYield, Microseconds(3));
+
+    BSONObjBuilder builder;
+    WaitEventStats::get(opCtx.get()).append(&builder);
+    ASSERT_BSONOBJ_EQ(builder.obj(),
+                      BSON("ticket" << BSON("count" << 1LL << "micros" << 7LL) << "yield"
+                                    << BSON("count" << 1LL << "micros" << 3LL)));
+}
+
+TEST_F(WaitEventsTest, ScopedWaitEventRecordsElapsedTime) {
+    auto opCtx = makeOperationContext();
+    {
+        ScopedWaitEvent wait(opCtx.get(), WaitEvent::kNetwork);
+        tickSource()->advance(Microseconds(250));
+    }
+
+    const auto& entry = WaitEventStats::get(opCtx.get()).getEntry(WaitEvent::kNetwork);
+    ASSERT_EQ(entry.count, 1);
+    ASSERT_EQ(entry.micros, 250);
+}
+
+TEST_F(WaitEventsTest, ScopedWaitEventRecordsWhenScopeThrows) {
+    auto opCtx = makeOperationContext();
+    ASSERT_THROWS_CODE(
+        [&] {
+            ScopedWaitEvent wait(opCtx.get(), WaitEvent::kJournalFlush);
+            tickSource()->advance(Microseconds(80));
+            uasserted(ErrorCodes::Interrupted, "interrupted while waiting");
+        }(),
+        DBException,
+        ErrorCodes::Interrupted);
+
+    const auto& entry = WaitEventStats::get(opCtx.get()).getEntry(WaitEvent::kJournalFlush);
+    ASSERT_EQ(entry.count, 1);
+    ASSERT_EQ(entry.micros, 80);
+}
+
+TEST_F(WaitEventsTest, ScopedWaitEventIgnoresWaitsThatDidNotBlock) {
+    auto opCtx = makeOperationContext();
+    { ScopedWaitEvent wait(opCtx.get(), WaitEvent::kFlowControl); }
+    ASSERT_TRUE(WaitEventStats::get(opCtx.get()).empty());
+}
+
+}  // namespace
+}  // namespace mongo
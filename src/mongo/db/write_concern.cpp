@@ -45,6 +45,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/db/storage/storage_engine.h"
+#include "mongo/db/wait_events.h"
 #include "mongo/db/write_concern_options.h"
 #include "mongo/rpc/protocol.h"
 #include "mongo/util/fail_point.h"
@@ -210,6 +211,7 @@ Status waitForWriteConcern(OperationContext* opCtx,
         case WriteConcernOptions::SyncMode::NONE:
             break;
         case WriteConcernOptions::SyncMode::FSYNC: {
+            ScopedWaitEvent waitEvent(opCtx, WaitEvent::kJournalFlush);
             StorageEngine* storageEngine = getGlobalServiceContext()->getStorageEngine();
             if (!storageEngine->isDurable()) {
                 result->fsyncFiles = storageEngine->flushAllFiles(opCtx, true);
@@ -219,7 +221,8 @@ Status waitForWriteConcern(OperationContext* opCtx,
             }
             break;
         }
-        case WriteConcernOptions::SyncMode::JOURNAL:
+        case WriteConcernOptions::SyncMode::JOURNAL: {
+            ScopedWaitEvent waitEvent(opCtx, WaitEvent::kJournalFlush);
             if (replCoord->getReplicationMode() != repl::ReplicationCoordinator::Mode::modeNone) {
                 // Wait for ops to become durable then update replication system's
                 // knowledge of this.
@@ -230,6 +233,7 @@ Status waitForWriteConcern(OperationContext* opCtx,
                 opCtx->recoveryUnit()->waitUntilDurable(opCtx);
             }
             break;
+        }
     }
 
     result->syncMillis = syncTimer.millis();
@@ -248,8 +252,10 @@ Status waitForWriteConcern(OperationContext* opCtx,
     }
 
     // Replica set stepdowns and gle mode changes are thrown as errors
-    repl::ReplicationCoordinator::StatusAndDuration replStatus =
-        replCoord->awaitReplication(opCtx, replOpTime, writeConcernWithPopulatedSyncMode);
+    repl::ReplicationCoordinator::StatusAndDuration replStatus = [&] {
+        ScopedWaitEvent waitEvent(opCtx, WaitEvent::kWriteConcern);
+        return replCoord->awaitReplication(opCtx, replOpTime, writeConcernWithPopulatedSyncMode);
+    }();
     if (replStatus.status == ErrorCodes::WriteConcernFailed) {
         gleWtimeouts.increment();
         result->err = "timeout";
@@ -49,6 +49,7 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/mock_yield_policies.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/stage_builder.h"
 #include "mongo/dbtests/dbtests.h"
@@ -159,6 +160,32 @@ TEST_F(DocumentSourceCursorTest, Iterate) {
     ASSERT(!opCtx()->lockState()->isReadLocked());
 }
 
+/** Iterate a DocumentSourceCursor which only produces the fields needed by later stages. */
+TEST_F(DocumentSourceCursorTest, IterateProducingOnlyFields) {
+    client.insert(nss.ns(), BSON("_id" << 0 << "a" << 1 << "b" << BSON("c" << 2) << "d" << 3));
+    createSource();
+    source()->shouldProduceOnlyFields({"b", "a"});
+    // The fields are produced in the order of the collection's documents.
+    auto next = source()->getNext();
+    ASSERT(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"a", 1}, {"b", Document{{"c", 2}}}}));
+    ASSERT(source()->getNext().isEOF());
+}
+
+/** Produce only some fields from documents in which one of those fields appears twice. */
+TEST_F(DocumentSourceCursorTest, IterateProducingOnlyFieldsWithDuplicateNames) {
+    client.insert(nss.ns(), BSON("_id" << 0 << "a" << 1 << "a" << 2 << "b" << 3 << "d" << 4));
+    createSource();
+    source()->shouldProduceOnlyFields({"a", "b"});
+    auto next = source()->getNext();
+    ASSERT(next.isAdvanced());
+    auto doc = next.releaseDocument();
+    ASSERT_VALUE_EQ(doc["a"], Value(1));
+    ASSERT_VALUE_EQ(doc["b"], Value(3));
+    ASSERT(doc["d"].missing());
+    ASSERT(source()->getNext().isEOF());
+}
+
 /** Dispose of a DocumentSourceCursor. */
 TEST_F(DocumentSourceCursorTest, Dispose) {
     createSource();
@@ -194,6 +221,48 @@ TEST_F(DocumentSourceCursorTest, IterateDispose) {
     ASSERT(source()->getNext().isEOF());
 }
 
+/** The batches cached by a DocumentSourceCursor start small and double up to a maximum size. */
+TEST_F(DocumentSourceCursorTest, BatchSizeGrowsUpToTheMaximum) {
+    const int initialBatchSizeBytes = internalDocumentSourceCursorInitialBatchSizeBytes.load();
+    const int maxBatchSizeBytes = internalDocumentSourceCursorBatchSizeBytes.load();
+    ON_BLOCK_EXIT([&] {
+        internalDocumentSourceCursorInitialBatchSizeBytes.store(initialBatchSizeBytes);
+        internalDocumentSourceCursorBatchSizeBytes.store(maxBatchSizeBytes);
+    });
+    internalDocumentSourceCursorInitialBatchSizeBytes.store(10 * 1024);
+    internalDocumentSourceCursorBatchSizeBytes.store(40 * 1024);
+
+    // Documents of equal size, so that batch sizes in documents follow batch sizes in bytes.
+    for (int i = 0; i < 200; ++i) {
+        client.insert(nss.ns(), BSON("_id" << i << "s" << std::string(1000, 'x')));
+    }
+    createSource();
+
+    // The executor's count of returned documents grows by a whole batch each time one is loaded.
+    std::vector<long long> batchSizes;
+    long long numLoaded = 0;
+    while (source()->getNext().isAdvanced()) {
+        const auto nReturned = static_cast<long long>(source()->getPlanSummaryStats().nReturned);
+        if (nReturned > numLoaded) {
+            batchSizes.push_back(nReturned - numLoaded);
+            numLoaded = nReturned;
+        }
+    }
+    ASSERT_EQ(200, numLoaded);
+    ASSERT_GTE(batchSizes.size(), 5U);
+
+    // A batch ends with the document which takes it past its size, so a batch of twice as many
+    // bytes holds either twice as many documents or one fewer.
+    ASSERT_GT(batchSizes[0], 1);
+    for (size_t i = 1; i < 3; ++i) {
+        ASSERT_GTE(batchSizes[i], 2 * batchSizes[i - 1] - 1);
+        ASSERT_LTE(batchSizes[i], 2 * batchSizes[i - 1]);
+    }
+
+    // The third batch reached the maximum size, so the next one is no larger.
+    ASSERT_EQ(batchSizes[2], batchSizes[3]);
+}
+
 /** Set a value or await an expected value. */
 class PendingValue {
 public:
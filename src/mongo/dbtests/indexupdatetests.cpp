@@ -34,6 +34,7 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/multi_index_block.h"
+#include "mongo/db/catalog/multi_index_block_gen.h"
 #include "mongo/db/client.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
@@ -206,6 +207,78 @@ public:
     }
 };
 
+/** Building several indexes at once generates their keys on multiple threads when enabled. */
+class InsertBuildGeneratesKeysInParallel : public IndexBuildBase {
+public:
+    void run() {
+        const int originalThreads = maxIndexBuildKeyGenerationThreads.load();
+        maxIndexBuildKeyGenerationThreads.store(3);
+        ON_BLOCK_EXIT([&] { maxIndexBuildKeyGenerationThreads.store(originalThreads); });
+
+        // Create a new collection with enough documents to fill more than one batch.
+        Database* db = _ctx.db();
+        Collection* coll;
+        const int32_t nDocs = 2500;
+        {
+            WriteUnitOfWork wunit(&_opCtx);
+            ASSERT_OK(db->dropCollection(&_opCtx, _nss));
+            coll = db->createCollection(&_opCtx, _nss);
+
+            OpDebug* const nullOpDebug = nullptr;
+            for (int32_t i = 0; i < nDocs; ++i) {
+                BSONObjBuilder doc;
+                doc.append("_id", i);
+                doc.append("a", i);
+                doc.append("b", BSON_ARRAY(i << i + nDocs));
+                if (i % 2) {
+                    doc.append("c", i);
+                }
+                ASSERT_OK(coll->insertDocument(&_opCtx, InsertStatement(doc.obj()), nullOpDebug));
+            }
+            wunit.commit();
+        }
+
+        const std::vector<BSONObj> specs = {
+            BSON("name"
+                 << "a_1"
+                 << "key" << BSON("a" << 1) << "v" << static_cast<int>(kIndexVersion)),
+            BSON("name"
+                 << "b_1"
+                 << "key" << BSON("b" << 1) << "v" << static_cast<int>(kIndexVersion)),
+            BSON("name"
+                 << "c_1"
+                 << "key" << BSON("c" << 1) << "v" << static_cast<int>(kIndexVersion)
+                 << "partialFilterExpression" << BSON("c" << BSON("$exists" << true)))};
+
+        MultiIndexBlock indexer;
+        ON_BLOCK_EXIT(
+            [&] { indexer.cleanUpAfterBuild(&_opCtx, coll, MultiIndexBlock::kNoopOnCleanUpFn); });
+
+        ASSERT_OK(indexer.init(&_opCtx, coll, specs, MultiIndexBlock::kNoopOnInitFn).getStatus());
+        ASSERT_OK(indexer.insertAllDocumentsInCollection(&_opCtx, coll));
+        ASSERT_OK(indexer.checkConstraints(&_opCtx));
+        {
+            WriteUnitOfWork wunit(&_opCtx);
+            ASSERT_OK(indexer.commit(&_opCtx,
+                                     coll,
+                                     MultiIndexBlock::kNoopOnCreateEachFn,
+                                     MultiIndexBlock::kNoopOnCommitFn));
+            wunit.commit();
+        }
+
+        auto numEntries = [&](StringData indexName) {
+            auto indexCatalog = coll->getIndexCatalog();
+            auto desc = indexCatalog->findIndexByName(&_opCtx, indexName);
+            ASSERT(desc);
+            auto accessMethod = indexCatalog->getEntry(desc)->accessMethod();
+            return accessMethod->getSortedDataInterface()->numEntries(&_opCtx);
+        };
+        ASSERT_EQ(nDocs, numEntries("a_1"));
+        ASSERT_EQ(2 * nDocs, numEntries("b_1"));
+        ASSERT_EQ(nDocs / 2, numEntries("c_1"));
+    }
+};
+
 /** Index creation is killed if mayInterrupt is true. */
 class InsertBuildIndexInterrupt : public IndexBuildBase {
 public:
@@ -657,6 +730,7 @@ public:
         addIf<InsertBuildEnforceUnique<true>>();
         addIf<InsertBuildEnforceUnique<false>>();
 
+        add<InsertBuildGeneratesKeysInParallel>();
         add<InsertBuildIndexInterrupt>();
         add<InsertBuildIdIndexInterrupt>();
         add<SameSpecDifferentOption>();
@@ -47,10 +47,12 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace query_stage_collection_scan {
 
@@ -179,6 +181,35 @@ TEST_F(QueryStageCollectionScanTest, QueryStageCollscanBasicBackwardWithMatch) {
     ASSERT_EQUALS(25, countResults(CollectionScanParams::BACKWARD, obj));
 }
 
+// Only records which pass the filter are copied into the working set.
+TEST_F(QueryStageCollectionScanTest, QueryStageCollscanFilteredOutRecordsTakeNoMembers) {
+    AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+    auto collection = ctx.getCollection();
+
+    CollectionScanParams params;
+    params.direction = CollectionScanParams::FORWARD;
+    params.tailable = false;
+
+    const boost::intrusive_ptr<ExpressionContext> expCtx(new ExpressionContext(&_opCtx, nullptr));
+    StatusWithMatchExpression statusWithMatcher =
+        MatchExpressionParser::parse(BSON("foo" << BSON("$gte" << numObj())), expCtx);
+    ASSERT_OK(statusWithMatcher.getStatus());
+    unique_ptr<MatchExpression> filterExpr = std::move(statusWithMatcher.getValue());
+
+    WorkingSet ws;
+    auto scan =
+        std::make_unique<CollectionScan>(&_opCtx, collection, params, &ws, filterExpr.get());
+    while (!scan->isEOF()) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        ASSERT_NOT_EQUALS(PlanStage::ADVANCED, scan->work(&id));
+    }
+
+    // Every record was tested, but none of them ever took a working set member.
+    auto stats = static_cast<const CollectionScanStats*>(scan->getSpecificStats());
+    ASSERT_EQUALS(static_cast<size_t>(numObj()), stats->docsTested);
+    ASSERT_EQUALS(0U, ws.capacity());
+}
+
 // Get objects in the order we inserted them.
 TEST_F(QueryStageCollectionScanTest, QueryStageCollscanObjectsInOrderForward) {
     AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
@@ -238,6 +269,45 @@ TEST_F(QueryStageCollectionScanTest, QueryStageCollscanObjectsInOrderBackward) {
     ASSERT_EQUALS(numObj(), count);
 }
 
+// Get objects in the order we inserted them when the executor works the scan in batches.
+TEST_F(QueryStageCollectionScanTest, QueryStageCollscanBatchedObjectsInOrderForward) {
+    const auto originalBatchSize = internalQueryExecWorkBatchSize.load();
+    internalQueryExecWorkBatchSize.store(7);
+    ON_BLOCK_EXIT([&] { internalQueryExecWorkBatchSize.store(originalBatchSize); });
+
+    AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+    auto collection = ctx.getCollection();
+
+    CollectionScanParams params;
+    params.direction = CollectionScanParams::FORWARD;
+    params.tailable = false;
+
+    // Only match every other document, so that batches are cut short by the filter.
+    const boost::intrusive_ptr<ExpressionContext> expCtx(new ExpressionContext(&_opCtx, nullptr));
+    StatusWithMatchExpression statusWithMatcher =
+        MatchExpressionParser::parse(fromjson("{foo: {$mod: [2, 0]}}"), expCtx);
+    ASSERT_OK(statusWithMatcher.getStatus());
+    unique_ptr<MatchExpression> filterExpr = std::move(statusWithMatcher.getValue());
+
+    unique_ptr<WorkingSet> ws = std::make_unique<WorkingSet>();
+    unique_ptr<PlanStage> ps = std::make_unique<CollectionScan>(
+        &_opCtx, collection, params, ws.get(), filterExpr.get());
+
+    auto statusWithPlanExecutor = PlanExecutor::make(
+        &_opCtx, std::move(ws), std::move(ps), collection, PlanExecutor::NO_YIELD);
+    ASSERT_OK(statusWithPlanExecutor.getStatus());
+    auto exec = std::move(statusWithPlanExecutor.getValue());
+
+    int count = 0;
+    PlanExecutor::ExecState state;
+    for (BSONObj obj; PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr));) {
+        ASSERT_EQUALS(2 * count, obj["foo"].numberInt());
+        ++count;
+    }
+    ASSERT_EQUALS(PlanExecutor::IS_EOF, state);
+    ASSERT_EQUALS(numObj() / 2, count);
+}
+
 // Scan through half the objects, delete the one we're about to fetch, then expect to get the "next"
 // object we would have gotten after that.
 TEST_F(QueryStageCollectionScanTest, QueryStageCollscanDeleteUpcomingObject) {
@@ -345,4 +415,67 @@ TEST_F(QueryStageCollectionScanTest, QueryStageCollscanDeleteUpcomingObjectBackw
     ASSERT_EQUALS(numObj(), count);
 }
 
+// Scan only the records within a range of RecordIds, seeking directly to the start of the range.
+TEST_F(QueryStageCollectionScanTest, QueryStageCollscanRecordIdRangeForward) {
+    AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+    auto collection = ctx.getCollection();
+
+    vector<RecordId> recordIds;
+    getRecordIds(collection, CollectionScanParams::FORWARD, &recordIds);
+
+    CollectionScanParams params;
+    params.direction = CollectionScanParams::FORWARD;
+    params.minRecord = recordIds[10];
+    params.maxRecord = recordIds[19];
+
+    WorkingSet ws;
+    auto scan = std::make_unique<CollectionScan>(&_opCtx, collection, params, &ws, nullptr);
+
+    int count = 10;
+    while (!scan->isEOF()) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        PlanStage::StageState state = scan->work(&id);
+        if (PlanStage::ADVANCED == state) {
+            WorkingSetMember* member = ws.get(id);
+            ASSERT_EQUALS(recordIds[count], member->recordId);
+            ++count;
+        }
+    }
+    ASSERT_EQUALS(20, count);
+
+    // The scan must not have visited the records preceding the range.
+    auto stats = static_cast<const CollectionScanStats*>(scan->getSpecificStats());
+    ASSERT_EQUALS(10U, stats->docsTested);
+}
+
+// Scan a range of RecordIds backwards, when the record at the start of the range doesn't exist.
+TEST_F(QueryStageCollectionScanTest, QueryStageCollscanRecordIdRangeBackwardMissingStart) {
+    dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+    Collection* coll = ctx.getCollection();
+
+    vector<RecordId> recordIds;
+    getRecordIds(coll, CollectionScanParams::FORWARD, &recordIds);
+    remove(coll->docFor(&_opCtx, recordIds[29]).value());
+
+    CollectionScanParams params;
+    params.direction = CollectionScanParams::BACKWARD;
+    params.minRecord = recordIds[20];
+    params.maxRecord = recordIds[29];
+
+    WorkingSet ws;
+    auto scan = std::make_unique<CollectionScan>(&_opCtx, coll, params, &ws, nullptr);
+
+    int count = 28;
+    while (!scan->isEOF()) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        PlanStage::StageState state = scan->work(&id);
+        if (PlanStage::ADVANCED == state) {
+            WorkingSetMember* member = ws.get(id);
+            ASSERT_EQUALS(recordIds[count], member->recordId);
+            --count;
+        }
+    }
+    ASSERT_EQUALS(19, count);
+}
+
 }  // namespace query_stage_collection_scan
@@ -181,6 +181,46 @@ public:
     }
 };
 
+/**
+ * Test that a multi delete with a limit stops once it has deleted that many documents.
+ */
+class QueryStageDeleteStopsAtLimit : public QueryStageDeleteBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+
+        Collection* coll = ctx.getCollection();
+        ASSERT(coll);
+
+        CollectionScanParams collScanParams;
+        collScanParams.direction = CollectionScanParams::FORWARD;
+        collScanParams.tailable = false;
+
+        const long long limit = 10;
+        auto deleteStageParams = std::make_unique<DeleteStageParams>();
+        deleteStageParams->isMulti = true;
+        deleteStageParams->limit = limit;
+
+        WorkingSet ws;
+        DeleteStage deleteStage(&_opCtx,
+                                std::move(deleteStageParams),
+                                &ws,
+                                coll,
+                                new CollectionScan(&_opCtx, coll, collScanParams, &ws, nullptr));
+
+        const DeleteStats* stats = static_cast<const DeleteStats*>(deleteStage.getSpecificStats());
+
+        while (!deleteStage.isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            PlanStage::StageState state = deleteStage.work(&id);
+            invariant(PlanStage::NEED_TIME == state || PlanStage::IS_EOF == state);
+        }
+
+        ASSERT_EQUALS(static_cast<size_t>(limit), stats->docsDeleted);
+        ASSERT_EQUALS(static_cast<long long>(numObj()) - limit, coll->numRecords(&_opCtx));
+    }
+};
+
 /**
  * Test that the delete stage returns an owned copy of the original document if returnDeleted is
  * specified.
@@ -256,6 +296,7 @@ public:
     void setupTests() {
         // Stage-specific tests below.
         add<QueryStageDeleteUpcomingObjectWasDeleted>();
+        add<QueryStageDeleteStopsAtLimit>();
         add<QueryStageDeleteReturnOldDoc>();
     }
 };
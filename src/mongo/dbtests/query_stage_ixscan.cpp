@@ -29,9 +29,13 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/client.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/exec/fetch.h"
 #include "mongo/db/exec/index_scan.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/index/index_descriptor.h"
@@ -314,6 +318,48 @@ public:
     }
 };
 
+// A FETCH over an IXSCAN worked in batches returns the same documents, in order, as when worked
+// one unit at a time, with no batch exceeding the requested size.
+class QueryStageIxscanFetchWorkBatch : public IndexScanTest {
+public:
+    void run() {
+        setup();
+
+        for (int i = 0; i < 10; ++i) {
+            insert(BSON("_id" << i << "x" << i));
+        }
+
+        std::unique_ptr<PlanStage> ixscan(
+            createIndexScan(BSON("x" << 2), BSON("x" << 8), true, false));
+        FetchStage fetch(&_opCtx, &_ws, std::move(ixscan), nullptr, _coll);
+
+        const size_t maxWorks = 4;
+        std::vector<int> results;
+        size_t largestBatch = 0;
+        PlanStage::StageState state = PlanStage::NEED_TIME;
+        while (PlanStage::IS_EOF != state) {
+            std::vector<WorkingSetID> batch;
+            WorkingSetID stateId = WorkingSet::INVALID_ID;
+            state = fetch.workBatch(maxWorks, &batch, &stateId);
+            ASSERT_NE(PlanStage::FAILURE, state);
+            ASSERT_NE(PlanStage::NEED_YIELD, state);
+            ASSERT_LTE(batch.size(), maxWorks);
+            largestBatch = std::max(largestBatch, batch.size());
+
+            for (auto id : batch) {
+                WorkingSetMember* member = _ws.get(id);
+                ASSERT_EQ(WorkingSetMember::RID_AND_OBJ, member->getState());
+                results.push_back(member->doc.value()["x"].getInt());
+                _ws.free(id);
+            }
+        }
+
+        ASSERT(std::vector<int>({2, 3, 4, 5, 6, 7}) == results);
+        ASSERT_GT(largestBatch, 1U);
+        ASSERT(fetch.isEOF());
+    }
+};
+
 class All : public OldStyleSuiteSpecification {
 public:
     All() : OldStyleSuiteSpecification("query_stage_ixscan") {}
@@ -324,6 +370,7 @@ public:
         add<QueryStageIxscanInsertDuringSaveExclusive>();
         add<QueryStageIxscanInsertDuringSaveExclusive2>();
         add<QueryStageIxscanInsertDuringSaveReverse>();
+        add<QueryStageIxscanFetchWorkBatch>();
     }
 };
 
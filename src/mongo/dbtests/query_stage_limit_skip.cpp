@@ -88,6 +88,19 @@ int countResults(PlanStage* stage) {
     return count;
 }
 
+int countResultsBatched(PlanStage* stage, size_t batchSize) {
+    int count = 0;
+    while (!stage->isEOF()) {
+        std::vector<WorkingSetID> batch;
+        WorkingSetID stateId = WorkingSet::INVALID_ID;
+        PlanStage::StageState status = stage->workBatch(batchSize, &batch, &stateId);
+        ASSERT_LTE(batch.size(), batchSize);
+        ASSERT_EQUALS(PlanStage::ADVANCED == status, !batch.empty());
+        count += batch.size();
+    }
+    return count;
+}
+
 //
 // Insert 50 objects.  Filter/skip 0, 1, 2, ..., 100 objects and expect the right # of results.
 //
@@ -112,12 +125,39 @@ protected:
     OperationContext* const _opCtx = _uniqOpCtx.get();
 };
 
+//
+// Same as above, but working a skip over a limit a batch at a time.
+//
+class QueryStageLimitSkipBatchedTest {
+public:
+    void run() {
+        for (size_t batchSize : {1, 3, 64}) {
+            for (int i = 0; i < 2 * N; ++i) {
+                WorkingSet ws;
+
+                unique_ptr<PlanStage> skip = std::make_unique<SkipStage>(
+                    _opCtx,
+                    i / 2,
+                    &ws,
+                    std::make_unique<LimitStage>(_opCtx, i, &ws, getMS(_opCtx, &ws)));
+                ASSERT_EQUALS(min(N, i) - min(N, i / 2),
+                              countResultsBatched(skip.get(), batchSize));
+            }
+        }
+    }
+
+protected:
+    const ServiceContext::UniqueOperationContext _uniqOpCtx = cc().makeOperationContext();
+    OperationContext* const _opCtx = _uniqOpCtx.get();
+};
+
 class All : public OldStyleSuiteSpecification {
 public:
     All() : OldStyleSuiteSpecification("query_stage_limit_skip") {}
 
     void setupTests() {
         add<QueryStageLimitSkipBasicTest>();
+        add<QueryStageLimitSkipBatchedTest>();
     }
 };
 
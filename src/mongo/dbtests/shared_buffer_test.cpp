@@ -32,8 +32,10 @@
 #include "mongo/util/shared_buffer.h"
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
 
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/shared_buffer_pool.h"
 
 namespace mongo {
 namespace {
@@ -131,5 +133,56 @@ TEST_F(SharedBufferTest, ReallocOrCopyShrinkShared) {
     ASSERT_NE(buf.get(), sharer.get());
 }
 
+long long poolHits() {
+    BSONObjBuilder bob;
+    SharedBufferPool::appendStats(&bob);
+    return bob.obj()["hits"].numberLong();
+}
+
+TEST_F(SharedBufferTest, AllocateFromPoolReusesReleasedBlocks) {
+    void* block;
+    {
+        SharedBuffer buf = SharedBuffer::allocateFromPool(100);
+        ASSERT(buf);
+        ASSERT_EQ(buf.capacity(), 100u);
+        block = buf.get();
+    }
+    const auto hitsBefore = poolHits();
+    SharedBuffer buf = SharedBuffer::allocateFromPool(100);
+    ASSERT_EQ(poolHits(), hitsBefore + 1);
+    ASSERT_EQ(buf.get(), block);
+}
+
+TEST_F(SharedBufferTest, ReallocPooledBuffer) {
+    SharedBuffer buf = SharedBuffer::allocateFromPool(4);
+    memcpy(buf.get(), "foo", 4);
+    buf.realloc(10000);
+    ASSERT_EQ(buf.capacity(), 10000u);
+    ASSERT_EQ("foo"_sd, buf.get());
+    buf.realloc(2);
+    ASSERT_EQ(buf.capacity(), 2u);
+    ASSERT_EQ('f', buf.get()[0]);
+}
+
+TEST_F(SharedBufferTest, PooledBufBuilderAllocatesFromThePoolFromTheStart) {
+    void* block;
+    {
+        SharedBuffer buf = SharedBuffer::allocateFromPool(512);
+        block = buf.get();
+    }
+    const auto hitsBefore = poolHits();
+    BufBuilder builder(UseSharedBufferPool{}, 512);
+    ASSERT_EQ(poolHits(), hitsBefore + 1);
+    ASSERT_EQ(static_cast<void*>(builder.buf()), block);
+}
+
+TEST_F(SharedBufferTest, AllocateFromPoolTooLargeIsNotPooled) {
+    const size_t bytes = SharedBufferPool::sizeClassBytes(SharedBufferPool::kNumSizeClasses - 1);
+    ASSERT_EQ(SharedBufferPool::sizeClassFor(bytes + 1), -1);
+    SharedBuffer buf = SharedBuffer::allocateFromPool(bytes);
+    ASSERT(buf);
+    ASSERT_EQ(buf.capacity(), bytes);
+}
+
 }  // namespace
 }  // namespace mongo
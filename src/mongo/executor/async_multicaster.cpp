@@ -33,6 +33,7 @@
 
 #include "mongo/executor/async_multicaster.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/base/status.h"
@@ -70,30 +71,45 @@ std::vector<AsyncMulticaster::Reply> AsyncMulticaster::multicast(
     };
 
     auto state = std::make_shared<State>(servers.size());
-    for (const auto& server : servers) {
-        stdx::unique_lock<Latch> lk(state->mutex);
-        // spin up no more than maxConcurrency tasks at once
-        opCtx->waitForConditionOrInterrupt(
-            state->cv, lk, [&] { return state->running < _options.maxConcurrency; });
-        ++state->running;
-
-        uassertStatusOK(_executor->scheduleRemoteCommand(
-            RemoteCommandRequest{server, theDbName, theCmdObj, opCtx, timeoutMillis},
-            [state](const TaskExecutor::RemoteCommandCallbackArgs& cbData) {
-                stdx::lock_guard<Latch> lk(state->mutex);
-
-                state->out.emplace_back(
-                    std::forward_as_tuple(cbData.request.target, cbData.response));
-
-                // If we were the last job, flush the done flag and release via notify.
-                if (!--(state->leftToDo)) {
-                    state->cv.notify_one();
-                }
-
-                if (--(state->running) < kMaxConcurrency) {
-                    state->cv.notify_one();
-                }
-            }));
+    auto callback = [state](const TaskExecutor::RemoteCommandCallbackArgs& cbData) {
+        stdx::lock_guard<Latch> lk(state->mutex);
+
+        state->out.emplace_back(std::forward_as_tuple(cbData.request.target, cbData.response));
+
+        // If we were the last job, flush the done flag and release via notify.
+        if (!--(state->leftToDo)) {
+            state->cv.notify_one();
+        }
+
+        if (--(state->running) < kMaxConcurrency) {
+            state->cv.notify_one();
+        }
+    };
+
+    for (auto next = servers.begin(); next != servers.end();) {
+        size_t batchSize;
+        {
+            stdx::unique_lock<Latch> lk(state->mutex);
+            // spin up no more than maxConcurrency tasks at once
+            opCtx->waitForConditionOrInterrupt(
+                state->cv, lk, [&] { return state->running < _options.maxConcurrency; });
+
+            // Send as many requests as the concurrency limit allows as one batch, so that the
+            // executor can share the work of sending them.
+            batchSize = std::min(_options.maxConcurrency - state->running,
+                                 static_cast<size_t>(servers.end() - next));
+            state->running += batchSize;
+        }
+
+        std::vector<RemoteCommandRequest> requests;
+        requests.reserve(batchSize);
+        for (size_t i = 0; i < batchSize; ++i, ++next) {
+            requests.emplace_back(*next, theDbName, theCmdObj, opCtx, timeoutMillis);
+        }
+
+        for (auto& swCbHandle : _executor->scheduleRemoteCommands(requests, callback)) {
+            uassertStatusOK(swCbHandle);
+        }
     }
 
     stdx::unique_lock<Latch> lk(state->mutex);
@@ -115,6 +115,11 @@ void ConnectionPool::ControllerInterface::init(ConnectionPool* pool) {
     _pool = pool;
 }
 
+Date_t ConnectionPool::ControllerInterface::now() const {
+    invariant(_pool);
+    return _pool->_factory->now();
+}
+
 std::string ConnectionPool::ConnectionControls::toString() const {
     return "{{ maxPending: {}, target: {}, }}"_format(maxPendingConnections, targetConnections);
 }
@@ -288,6 +293,13 @@ public:
      */
     size_t createdConnections() const;
 
+    /**
+     * Returns how long the connections created by this pool took to set up.
+     */
+    const ConnectionSetupTimeHistogram& setupTimes() const {
+        return _setupTimes;
+    }
+
     /**
      * Returns the total number of connections currently open that belong to
      * this pool. This is the sum of refreshingConnections, availableConnections,
@@ -407,6 +419,8 @@ private:
 
     size_t _created = 0;
 
+    ConnectionSetupTimeHistogram _setupTimes;
+
     transport::Session::TagMask _tags = transport::Session::kPending;
 
     HostHealth _health;
@@ -559,6 +573,7 @@ void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
                                      pool->availableConnections(),
                                      pool->createdConnections(),
                                      pool->refreshingConnections()};
+        hostStats.setupTimes = pool->setupTimes();
         stats->updateStatsForHost(_name, host, hostStats);
     }
 }
@@ -956,7 +971,11 @@ void ConnectionPool::SpecificPool::spawnConnections() {
 
         // Run the setup callback
         handle->setup(_parent->_controller->pendingTimeout(),
-                      guardCallback([this](auto conn, auto status) {
+                      guardCallback([this, start = _parent->_factory->now()](auto conn,
+                                                                             auto status) {
+                          if (status.isOK()) {
+                              _setupTimes.record(_parent->_factory->now() - start);
+                          }
                           finishRefresh(std::move(conn), std::move(status));
                       }));
     }
@@ -465,6 +465,11 @@ public:
     }
 
 protected:
+    /**
+     * Returns the current time, from the clock of the ConnectionPool's factory
+     */
+    Date_t now() const;
+
     ConnectionPool* _pool = nullptr;
 };
 
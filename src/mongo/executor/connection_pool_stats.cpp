@@ -33,10 +33,45 @@
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/util/map_util.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 namespace executor {
 
+void ConnectionSetupTimeHistogram::record(Milliseconds setupTime) {
+    size_t bucket = 0;
+    for (auto bound = 1LL; bucket < kNumBuckets - 1 && setupTime.count() >= bound; bound *= 2) {
+        ++bucket;
+    }
+    ++buckets[bucket];
+    ++count;
+    total += setupTime;
+}
+
+ConnectionSetupTimeHistogram& ConnectionSetupTimeHistogram::operator+=(
+    const ConnectionSetupTimeHistogram& other) {
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    count += other.count;
+    total += other.total;
+
+    return *this;
+}
+
+void ConnectionSetupTimeHistogram::appendToBSON(mongo::BSONObjBuilder* builder) const {
+    BSONObjBuilder histogramBuilder(builder->subobjStart("setupTimes"));
+    histogramBuilder.appendNumber("count", count);
+    histogramBuilder.appendNumber("totalMillis", durationCount<Milliseconds>(total));
+    for (size_t i = 0; i < kNumBuckets - 1; ++i) {
+        histogramBuilder.appendNumber(str::stream() << "lessThan" << (1LL << i) << "ms",
+                                      buckets[i]);
+    }
+    histogramBuilder.appendNumber(str::stream()
+                                      << "atLeast" << (1LL << (kNumBuckets - 2)) << "ms",
+                                  buckets[kNumBuckets - 1]);
+}
+
 ConnectionStatsPer::ConnectionStatsPer(size_t nInUse,
                                        size_t nAvailable,
                                        size_t nCreated,
@@ -50,6 +85,7 @@ ConnectionStatsPer& ConnectionStatsPer::operator+=(const ConnectionStatsPer& oth
     available += other.available;
     created += other.created;
     refreshing += other.refreshing;
+    setupTimes += other.setupTimes;
 
     return *this;
 }
@@ -99,6 +135,7 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFT
             poolInfo.appendNumber("poolAvailable", poolStats.available);
             poolInfo.appendNumber("poolCreated", poolStats.created);
             poolInfo.appendNumber("poolRefreshing", poolStats.refreshing);
+            poolStats.setupTimes.appendToBSON(&poolInfo);
             for (const auto& host : statsByPoolHost[pool.first]) {
                 BSONObjBuilder hostInfo(poolInfo.subobjStart(host.first.toString()));
                 auto& hostStats = host.second;
@@ -106,6 +143,7 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFT
                 hostInfo.appendNumber("available", hostStats.available);
                 hostInfo.appendNumber("created", hostStats.created);
                 hostInfo.appendNumber("refreshing", hostStats.refreshing);
+                hostStats.setupTimes.appendToBSON(&hostInfo);
             }
         }
     }
@@ -118,6 +156,7 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFT
             hostInfo.appendNumber("available", hostStats.available);
             hostInfo.appendNumber("created", hostStats.created);
             hostInfo.appendNumber("refreshing", hostStats.refreshing);
+            hostStats.setupTimes.appendToBSON(&hostInfo);
         }
     }
 }
@@ -29,12 +29,34 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/duration.h"
 #include "mongo/util/net/hostandport.h"
 
 namespace mongo {
 namespace executor {
 
+/**
+ * Histogram of how long new connections took to set up, which includes connecting, the TLS
+ * handshake and authentication. Bucket i counts setups which took less than 2^i milliseconds and
+ * at least 2^(i-1), and the last bucket counts all the slower ones.
+ */
+struct ConnectionSetupTimeHistogram {
+    static constexpr size_t kNumBuckets = 16;
+
+    void record(Milliseconds setupTime);
+
+    ConnectionSetupTimeHistogram& operator+=(const ConnectionSetupTimeHistogram& other);
+
+    void appendToBSON(mongo::BSONObjBuilder* builder) const;
+
+    std::array<size_t, kNumBuckets> buckets{};
+    size_t count = 0u;
+    Milliseconds total{0};
+};
+
 /**
  * Holds connection information for a specific pool or remote host. These objects are maintained by
  * a parent ConnectionPoolStats object and should not need to be created directly.
@@ -50,6 +72,7 @@ struct ConnectionStatsPer {
     size_t available = 0u;
     size_t created = 0u;
     size_t refreshing = 0u;
+    ConnectionSetupTimeHistogram setupTimes;
 };
 
 /**
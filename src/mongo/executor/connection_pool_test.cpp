@@ -41,6 +41,7 @@
 #include <fmt/ostream.h>
 
 #include "mongo/executor/connection_pool.h"
+#include "mongo/executor/connection_pool_stats.h"
 #include "mongo/stdx/future.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/scopeguard.h"
@@ -1532,6 +1533,45 @@ TEST_F(ConnectionPoolTest, ReturnAfterShutdown) {
     pool->shutdown();
 }
 
+/**
+ * Verify that the time taken to set up connections is recorded, and that failed setups are not.
+ */
+TEST_F(ConnectionPoolTest, SetupTimesAreRecorded) {
+    auto pool = makePool();
+
+    auto now = Date_t::now();
+    PoolImpl::setNow(now);
+
+    // The first setup succeeds after 3ms
+    boost::optional<StatusWithConn> conn1;
+    pool->get_forTest(HostAndPort(), Seconds(1), [&](StatusWithConn swConn) {
+        conn1 = std::move(swConn);
+    });
+    PoolImpl::setNow(now + Milliseconds(3));
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT(conn1);
+    verifyAndGetId(*conn1);
+
+    // The second setup fails
+    boost::optional<StatusWithConn> conn2;
+    pool->get_forTest(HostAndPort(), Seconds(1), [&](StatusWithConn swConn) {
+        conn2 = std::move(swConn);
+    });
+    ConnectionImpl::pushSetup(Status(ErrorCodes::HostUnreachable, "unreachable"));
+    ASSERT(conn2);
+    ASSERT_NOT_OK(conn2->getStatus());
+
+    doneWith(conn1->getValue());
+
+    ConnectionPoolStats stats;
+    pool->appendConnectionStats(&stats);
+    const auto& setupTimes = stats.statsByHost[HostAndPort()].setupTimes;
+    ASSERT_EQ(setupTimes.count, 1u);
+    ASSERT_EQ(setupTimes.total, Milliseconds(3));
+    // 3ms falls in [2ms, 4ms)
+    ASSERT_EQ(setupTimes.buckets[2], 1u);
+}
+
 }  // namespace connection_pool_test_details
 }  // namespace executor
 }  // namespace mongo
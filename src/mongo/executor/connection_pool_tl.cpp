@@ -152,6 +152,10 @@ public:
         : _wrappedHook(hookToWrap) {}
 
     BSONObj augmentIsMasterRequest(BSONObj cmdObj) override {
+        if (_wrappedHook) {
+            cmdObj = _wrappedHook->augmentIsMasterRequest(std::move(cmdObj));
+        }
+
         BSONObjBuilder bob(std::move(cmdObj));
         bob.append("hangUpOnStepDown", false);
         if (internalSecurity.user) {
@@ -38,6 +38,17 @@ namespace executor {
 NetworkInterface::NetworkInterface() {}
 NetworkInterface::~NetworkInterface() {}
 
+std::vector<Status> NetworkInterface::startCommands(std::vector<CommandToStart>& commands,
+                                                    const BatonHandle& baton) {
+    std::vector<Status> statuses;
+    statuses.reserve(commands.size());
+    for (auto& command : commands) {
+        statuses.push_back(
+            startCommand(command.cbHandle, command.request, std::move(command.onFinish), baton));
+    }
+    return statuses;
+}
+
 MONGO_FAIL_POINT_DEFINE(networkInterfaceDiscardCommandsBeforeAcquireConn);
 MONGO_FAIL_POINT_DEFINE(networkInterfaceDiscardCommandsAfterAcquireConn);
 
@@ -32,6 +32,7 @@
 #include <boost/optional.hpp>
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "mongo/executor/task_executor.h"
 #include "mongo/transport/baton.h"
@@ -169,6 +170,27 @@ public:
         return std::move(pf.future);
     }
 
+    /**
+     * A command to start with startCommands().
+     */
+    struct CommandToStart {
+        TaskExecutor::CallbackHandle cbHandle;
+        RemoteCommandRequestOnAny request;
+        RemoteCommandCompletionFn onFinish;
+    };
+
+    /**
+     * Starts asynchronous execution of a batch of commands, such as the requests of a fan-out to
+     * several hosts. Each command behaves as if it had been started with startCommand(), and the
+     * returned vector holds the status of starting each of them, in order. Implementations may
+     * share the work of starting the commands, for example using a single timer for the commands
+     * which share a deadline.
+     *
+     * The default implementation starts the commands one at a time.
+     */
+    virtual std::vector<Status> startCommands(std::vector<CommandToStart>& commands,
+                                              const BatonHandle& baton = nullptr);
+
     /**
      * Requests cancelation of the network activity associated with "cbHandle" if it has not yet
      * completed.
@@ -217,25 +217,112 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
 
     LOG(3) << "startCommand: " << redact(request.toString());
 
-    if (_metadataHook) {
-        BSONObjBuilder newMetadata(std::move(request.metadata));
+    if (auto status = _writeRequestMetadata(request); !status.isOK()) {
+        return status;
+    }
 
-        auto status = _metadataHook->writeRequestMetadata(request.opCtx, &newMetadata);
-        if (!status.isOK()) {
-            return status;
+    _startCommand(cbHandle, request, std::move(onFinish), baton, now(), nullptr);
+    return Status::OK();
+}
+
+std::vector<Status> NetworkInterfaceTL::startCommands(std::vector<CommandToStart>& commands,
+                                                      const BatonHandle& baton) {
+    if (inShutdown()) {
+        return std::vector<Status>(
+            commands.size(),
+            Status(ErrorCodes::ShutdownInProgress, "NetworkInterface shutdown in progress"));
+    }
+
+    const auto start = now();
+
+    // Fan-outs usually give all of their requests the same timeout, so the batch's deadline is
+    // that of the first request with a timeout.
+    auto batch = [&] {
+        for (const auto& command : commands) {
+            if (command.request.timeout != RemoteCommandRequest::kNoTimeout) {
+                return std::make_shared<BatchState>(start + command.request.timeout);
+            }
         }
+        return std::make_shared<BatchState>(RemoteCommandRequest::kNoExpirationDate);
+    }();
+
+    std::vector<Status> statuses;
+    statuses.reserve(commands.size());
+    for (auto& command : commands) {
+        LOG(3) << "startCommand: " << redact(command.request.toString());
+
+        auto status = _writeRequestMetadata(command.request);
+        if (status.isOK()) {
+            _startCommand(command.cbHandle,
+                          command.request,
+                          std::move(command.onFinish),
+                          baton,
+                          start,
+                          batch);
+        }
+        statuses.push_back(std::move(status));
+    }
+
+    if (!batch->commands.empty()) {
+        batch->timer = _reactor->makeTimer();
+        batch->timer->waitUntil(batch->deadline, baton)
+            .getAsync([this, batch, baton](Status status) {
+                if (status == ErrorCodes::CallbackCanceled) {
+                    return;
+                }
 
-        request.metadata = newMetadata.obj();
+                for (const auto& weakState : batch->commands) {
+                    if (auto state = weakState.lock()) {
+                        _timeOutCommand(state, baton);
+                    }
+                }
+            });
     }
 
+    if (batch->outstanding.subtractAndFetch(1) == 0 && batch->timer) {
+        batch->timer->cancel(baton);
+    }
+
+    return statuses;
+}
+
+Status NetworkInterfaceTL::_writeRequestMetadata(RemoteCommandRequestOnAny& request) {
+    if (!_metadataHook) {
+        return Status::OK();
+    }
+
+    BSONObjBuilder newMetadata(std::move(request.metadata));
+
+    auto status = _metadataHook->writeRequestMetadata(request.opCtx, &newMetadata);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    request.metadata = newMetadata.obj();
+    return Status::OK();
+}
+
+void NetworkInterfaceTL::_startCommand(const TaskExecutor::CallbackHandle& cbHandle,
+                                       const RemoteCommandRequestOnAny& request,
+                                       RemoteCommandCompletionFn&& onFinish,
+                                       const BatonHandle& baton,
+                                       Date_t start,
+                                       const std::shared_ptr<BatchState>& batch) {
     auto pf = makePromiseFuture<RemoteCommandOnAnyResponse>();
 
     auto cmdState = CommandState::make(this, request, cbHandle, std::move(pf.promise));
-    cmdState->start = now();
+    cmdState->start = start;
     if (cmdState->requestOnAny.timeout != cmdState->requestOnAny.kNoTimeout) {
         cmdState->deadline = cmdState->start + cmdState->requestOnAny.timeout;
     }
 
+    if (batch && cmdState->deadline != RemoteCommandRequest::kNoExpirationDate &&
+        cmdState->deadline == batch->deadline) {
+        cmdState->batch = batch;
+        batch->commands.push_back(cmdState);
+        batch->outstanding.addAndFetch(1);
+    }
+
     /**
      * It is important that onFinish() runs out of line. That said, we can't thenRunOn() arbitrarily
      * without doing extra context switches and delaying execution. The cmdState promise can be
@@ -258,26 +345,30 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
      * - Connection failure and command failure are related but distinct
      */
 
-    // When our command finishes, run onFinish
+    // When our command finishes, run onFinish. This is a single continuation, rather than one to
+    // translate errors and one to run onFinish, to save an allocation per command.
     std::move(pf.future)
-        .onError([requestId = cmdState->requestOnAny.id](
-                     auto error) -> StatusWith<RemoteCommandOnAnyResponse> {
-            LOG(2) << "Failed to get connection from pool for request " << requestId << ": "
-                   << redact(error);
-
-            // The TransportLayer has, for historical reasons returned SocketException
-            // for network errors, but sharding assumes HostUnreachable on network
-            // errors.
-            if (error == ErrorCodes::SocketException) {
-                error = Status(ErrorCodes::HostUnreachable, error.reason());
-            }
-            return error;
-        })
-        .getAsync([this, cmdState, onFinish = std::move(onFinish)](
+        .getAsync([this, cmdState, baton, onFinish = std::move(onFinish)](
                       StatusWith<RemoteCommandOnAnyResponse> response) {
             auto duration = now() - cmdState->start;
+
+            if (const auto& batch = cmdState->batch;
+                batch && batch->outstanding.subtractAndFetch(1) == 0) {
+                batch->timer->cancel(baton);
+            }
+
             if (!response.isOK()) {
-                onFinish(RemoteCommandOnAnyResponse(boost::none, response.getStatus(), duration));
+                auto error = response.getStatus();
+                LOG(2) << "Failed to get connection from pool for request "
+                       << cmdState->requestOnAny.id << ": " << redact(error);
+
+                // The TransportLayer has, for historical reasons returned SocketException
+                // for network errors, but sharding assumes HostUnreachable on network
+                // errors.
+                if (error == ErrorCodes::SocketException) {
+                    error = Status(ErrorCodes::HostUnreachable, error.reason());
+                }
+                onFinish(RemoteCommandOnAnyResponse(boost::none, std::move(error), duration));
             } else {
                 const auto& rs = response.getValue();
                 LOG(2) << "Request " << cmdState->requestOnAny.id << " finished with response: "
@@ -288,7 +379,7 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
 
     if (MONGO_unlikely(networkInterfaceDiscardCommandsBeforeAcquireConn.shouldFail())) {
         log() << "Discarding command due to failpoint before acquireConn";
-        return Status::OK();
+        return;
     }
 
     // Attempt to use a connection and update our accounting
@@ -357,8 +448,32 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
                     }
                 });
     }
+}
 
-    return Status::OK();
+void NetworkInterfaceTL::_timeOutCommand(const std::shared_ptr<CommandState>& state,
+                                         const BatonHandle& baton) {
+    if (state->done.swap(true)) {
+        return;
+    }
+
+    if (getTestCommandsEnabled()) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _counters.timedOut++;
+    }
+
+    const std::string message = str::stream()
+        << "Request " << state->requestOnAny.id << " timed out"
+        << ", deadline was " << state->deadline.toString() << ", op was "
+        << redact(state->requestOnAny.toString());
+
+    LOG(2) << message;
+    state->promise.setError(Status(ErrorCodes::NetworkInterfaceExceededTimeLimit, message));
+
+    // A command in a batch may time out before it has a connection.
+    if (state->conn) {
+        auto tlconn = checked_cast<connection_pool_tl::TLConnection*>(state->conn.get());
+        tlconn->client()->cancel(baton);
+    }
 }
 
 // This is only called from within a then() callback on a future, so throwing is equivalent to
@@ -386,35 +501,20 @@ void NetworkInterfaceTL::_onAcquireConn(std::shared_ptr<CommandState> state,
                                     << connDuration << ", timeout was set to "
                                     << state->requestOnAny.timeout);
         }
+    }
 
+    // Commands started in a batch are timed out by the timer of their batch.
+    if (state->deadline != RemoteCommandRequest::kNoExpirationDate && !state->batch) {
         // TODO reform with SERVER-41459
         state->timer = _reactor->makeTimer();
         state->timer->waitUntil(state->deadline, baton)
-            .getAsync([this, client, state, baton](Status status) {
+            .getAsync([this, state, baton](Status status) {
                 if (status == ErrorCodes::CallbackCanceled) {
                     invariant(state->done.load());
                     return;
                 }
 
-                if (state->done.swap(true)) {
-                    return;
-                }
-
-                if (getTestCommandsEnabled()) {
-                    stdx::lock_guard<Latch> lk(_mutex);
-                    _counters.timedOut++;
-                }
-
-                const std::string message = str::stream()
-                    << "Request " << state->requestOnAny.id << " timed out"
-                    << ", deadline was " << state->deadline.toString() << ", op was "
-                    << redact(state->requestOnAny.toString());
-
-                LOG(2) << message;
-                state->promise.setError(
-                    Status(ErrorCodes::NetworkInterfaceExceededTimeLimit, message));
-
-                client->cancel(baton);
+                _timeOutCommand(state, baton);
             });
     }
 
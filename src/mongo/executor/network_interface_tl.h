@@ -69,6 +69,8 @@ public:
                         RemoteCommandRequestOnAny& request,
                         RemoteCommandCompletionFn&& onFinish,
                         const BatonHandle& baton) override;
+    std::vector<Status> startCommands(std::vector<CommandToStart>& commands,
+                                      const BatonHandle& baton) override;
 
     void cancelCommand(const TaskExecutor::CallbackHandle& cbHandle,
                        const BatonHandle& baton) override;
@@ -85,6 +87,24 @@ public:
     void dropConnections(const HostAndPort& hostAndPort) override;
 
 private:
+    struct CommandState;
+
+    /**
+     * The commands started together by startCommands() which share a deadline. They are timed out
+     * by a single timer rather than by one timer per command.
+     */
+    struct BatchState {
+        explicit BatchState(Date_t deadline_) : deadline(deadline_) {}
+
+        Date_t deadline;
+        std::unique_ptr<transport::ReactorTimer> timer;
+        std::vector<std::weak_ptr<CommandState>> commands;
+
+        // The commands which have not finished yet, plus one held by startCommands() until the
+        // timer is armed.
+        AtomicWord<size_t> outstanding{1};
+    };
+
     struct CommandState {
         CommandState(NetworkInterfaceTL* interface_,
                      RemoteCommandRequestOnAny request_,
@@ -111,6 +131,9 @@ private:
         ConnectionPool::ConnectionHandle conn;
         std::unique_ptr<transport::ReactorTimer> timer;
 
+        // Set if the command's deadline is enforced by the timer of its batch instead of 'timer'.
+        std::shared_ptr<BatchState> batch;
+
         AtomicWord<bool> done;
         Promise<RemoteCommandOnAnyResponse> promise;
     };
@@ -136,6 +159,14 @@ private:
     void _answerAlarm(Status status, std::shared_ptr<AlarmState> state);
 
     void _run();
+    Status _writeRequestMetadata(RemoteCommandRequestOnAny& request);
+    void _startCommand(const TaskExecutor::CallbackHandle& cbHandle,
+                       const RemoteCommandRequestOnAny& request,
+                       RemoteCommandCompletionFn&& onFinish,
+                       const BatonHandle& baton,
+                       Date_t start,
+                       const std::shared_ptr<BatchState>& batch);
+    void _timeOutCommand(const std::shared_ptr<CommandState>& state, const BatonHandle& baton);
     void _onAcquireConn(std::shared_ptr<CommandState> state,
                         ConnectionPool::ConnectionHandle conn,
                         const BatonHandle& baton);
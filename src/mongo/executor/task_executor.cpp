@@ -120,5 +120,27 @@ StatusWith<TaskExecutor::CallbackHandle> TaskExecutor::scheduleRemoteCommand(
     });
 }
 
+std::vector<StatusWith<TaskExecutor::CallbackHandle>> TaskExecutor::scheduleRemoteCommands(
+    const std::vector<RemoteCommandRequest>& requests,
+    const RemoteCommandCallbackFn& cb,
+    const BatonHandle& baton) {
+    return scheduleRemoteCommandsOnAny(
+        std::vector<RemoteCommandRequestOnAny>(requests.begin(), requests.end()),
+        [cb](const RemoteCommandOnAnyCallbackArgs& args) { cb({args, 0}); },
+        baton);
+}
+
+std::vector<StatusWith<TaskExecutor::CallbackHandle>> TaskExecutor::scheduleRemoteCommandsOnAny(
+    const std::vector<RemoteCommandRequestOnAny>& requests,
+    const RemoteCommandOnAnyCallbackFn& cb,
+    const BatonHandle& baton) {
+    std::vector<StatusWith<CallbackHandle>> cbHandles;
+    cbHandles.reserve(requests.size());
+    for (const auto& request : requests) {
+        cbHandles.push_back(scheduleRemoteCommandOnAny(request, cb, baton));
+    }
+    return cbHandles;
+}
+
 }  // namespace executor
 }  // namespace mongo
@@ -32,6 +32,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
@@ -266,6 +267,29 @@ public:
         const RemoteCommandOnAnyCallbackFn& cb,
         const BatonHandle& baton = nullptr) = 0;
 
+    /**
+     * Schedules "cb" to be run by the executor with the result of executing each of the remote
+     * commands described by "requests", such as the requests of a fan-out to several hosts, as if
+     * by calling scheduleRemoteCommand() once per request. Implementations may share the work of
+     * sending the commands of the batch.
+     *
+     * Returns the result of scheduling each request, in order.
+     */
+    std::vector<StatusWith<CallbackHandle>> scheduleRemoteCommands(
+        const std::vector<RemoteCommandRequest>& requests,
+        const RemoteCommandCallbackFn& cb,
+        const BatonHandle& baton = nullptr);
+
+    /**
+     * Like scheduleRemoteCommands(), for requests which can be sent to any of several hosts.
+     *
+     * The default implementation schedules the requests one at a time.
+     */
+    virtual std::vector<StatusWith<CallbackHandle>> scheduleRemoteCommandsOnAny(
+        const std::vector<RemoteCommandRequestOnAny>& requests,
+        const RemoteCommandOnAnyCallbackFn& cb,
+        const BatonHandle& baton = nullptr);
+
     /**
      * If the callback referenced by "cbHandle" hasn't already executed, marks it as
      * canceled and runnable.
@@ -434,6 +434,40 @@ COMMON_EXECUTOR_TEST(ScheduleRemoteCommand) {
     ASSERT_EQUALS(ErrorCodes::NoSuchKey, status1);
 }
 
+COMMON_EXECUTOR_TEST(ScheduleRemoteCommands) {
+    NetworkInterfaceMock* net = getNet();
+    TaskExecutor& executor = getExecutor();
+    launchExecutorThread();
+    const std::vector<RemoteCommandRequest> requests{
+        {HostAndPort("host1", 27017), "mydb", BSON("ping" << 1), nullptr},
+        {HostAndPort("host2", 27017), "mydb", BSON("ping" << 1), nullptr}};
+    std::vector<Status> statuses(requests.size(), getDetectableErrorStatus());
+    auto cbHandles = executor.scheduleRemoteCommands(
+        requests, [&](const TaskExecutor::RemoteCommandCallbackArgs& cbData) {
+            const bool first = cbData.request.target == requests[0].target;
+            statuses[first ? 0 : 1] = cbData.response.status;
+        });
+    ASSERT_EQUALS(requests.size(), cbHandles.size());
+    net->enterNetwork();
+    for (size_t i = 0; i < requests.size(); ++i) {
+        ASSERT(net->hasReadyRequests());
+        NetworkInterfaceMock::NetworkOperationIterator noi = net->getNextReadyRequest();
+        const bool first = noi->getRequest().target == requests[0].target;
+        net->scheduleResponse(
+            noi, net->now(), {first ? ErrorCodes::NoSuchKey : ErrorCodes::BadValue, "error"});
+    }
+    net->runReadyNetworkOperations();
+    ASSERT(!net->hasReadyRequests());
+    net->exitNetwork();
+    for (const auto& swCbHandle : cbHandles) {
+        executor.wait(unittest::assertGet(swCbHandle));
+    }
+    executor.shutdown();
+    joinExecutorThread();
+    ASSERT_EQUALS(ErrorCodes::NoSuchKey, statuses[0]);
+    ASSERT_EQUALS(ErrorCodes::BadValue, statuses[1]);
+}
+
 COMMON_EXECUTOR_TEST(ScheduleAndCancelRemoteCommand) {
     TaskExecutor& executor = getExecutor();
     Status status1 = getDetectableErrorStatus();
@@ -413,13 +413,7 @@ void remoteCommandFailedEarly(const TaskExecutor::CallbackArgs& cbData,
 const auto initialSyncPauseCmds =
     std::vector<std::string>{"listCollections", "listIndexes", "listDatabases"};
 
-}  // namespace
-
-StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleRemoteCommandOnAny(
-    const RemoteCommandRequestOnAny& request,
-    const RemoteCommandOnAnyCallbackFn& cb,
-    const BatonHandle& baton) {
-
+void pauseForInitialSyncFuzzer(const RemoteCommandRequestOnAny& request) {
     if (MONGO_unlikely(initialSyncFuzzerSynchronizationPoint1.shouldFail())) {
         // We are only going to pause on these failpoints if the command issued is for the
         // collection cloning part of initial sync.
@@ -439,13 +433,28 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleRemoteC
             }
         }
     }
+}
 
+RemoteCommandRequestOnAny makeScheduledRequest(const RemoteCommandRequestOnAny& request,
+                                               Date_t now) {
     RemoteCommandRequestOnAny scheduledRequest = request;
     if (request.timeout == RemoteCommandRequest::kNoTimeout) {
         scheduledRequest.expirationDate = RemoteCommandRequest::kNoExpirationDate;
     } else {
-        scheduledRequest.expirationDate = _net->now() + scheduledRequest.timeout;
+        scheduledRequest.expirationDate = now + scheduledRequest.timeout;
     }
+    return scheduledRequest;
+}
+
+}  // namespace
+
+StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleRemoteCommandOnAny(
+    const RemoteCommandRequestOnAny& request,
+    const RemoteCommandOnAnyCallbackFn& cb,
+    const BatonHandle& baton) {
+    pauseForInitialSyncFuzzer(request);
+
+    RemoteCommandRequestOnAny scheduledRequest = makeScheduledRequest(request, _net->now());
 
     // In case the request fails to even get a connection from the pool,
     // we wrap the callback in a method that prepares its input parameters.
@@ -463,24 +472,11 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleRemoteC
     LOG(3) << "Scheduling remote command request: " << redact(scheduledRequest.toString());
     lk.unlock();
 
-    auto commandStatus = _net->startCommand(
-        swCbHandle.getValue(),
-        scheduledRequest,
-        [this, scheduledRequest, cbState, cb](const ResponseOnAnyStatus& response) {
-            using std::swap;
-            CallbackFn newCb = [cb, scheduledRequest, response](const CallbackArgs& cbData) {
-                remoteCommandFinished(cbData, cb, scheduledRequest, response);
-            };
-            stdx::unique_lock<Latch> lk(_mutex);
-            if (_inShutdown_inlock()) {
-                return;
-            }
-            LOG(3) << "Received remote response: "
-                   << redact(response.isOK() ? response.toString() : response.status.toString());
-            swap(cbState->callback, newCb);
-            scheduleIntoPool_inlock(&_networkInProgressQueue, cbState->iter, std::move(lk));
-        },
-        baton);
+    auto commandStatus =
+        _net->startCommand(swCbHandle.getValue(),
+                           scheduledRequest,
+                           makeRemoteCommandCompletionFn(scheduledRequest, cbState, cb),
+                           baton);
 
     if (!commandStatus.isOK())
         return commandStatus;
@@ -488,6 +484,93 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleRemoteC
     return swCbHandle;
 }
 
+std::vector<StatusWith<TaskExecutor::CallbackHandle>>
+ThreadPoolTaskExecutor::scheduleRemoteCommandsOnAny(
+    const std::vector<RemoteCommandRequestOnAny>& requests,
+    const RemoteCommandOnAnyCallbackFn& cb,
+    const BatonHandle& baton) {
+    for (const auto& request : requests) {
+        pauseForInitialSyncFuzzer(request);
+    }
+
+    const auto now = _net->now();
+    std::vector<RemoteCommandRequestOnAny> scheduledRequests;
+    std::vector<WorkQueue> wqs;
+    scheduledRequests.reserve(requests.size());
+    wqs.reserve(requests.size());
+    for (const auto& request : requests) {
+        const auto& scheduledRequest =
+            scheduledRequests.emplace_back(makeScheduledRequest(request, now));
+        auto& wq = wqs.emplace_back(makeSingletonWorkQueue(
+            [scheduledRequest, cb](const CallbackArgs& cbData) {
+                remoteCommandFailedEarly(cbData, cb, scheduledRequest);
+            },
+            baton));
+        wq.front()->isNetworkOperation = true;
+    }
+
+    // Enqueue the callback states of the whole batch under a single acquisition of the mutex.
+    std::vector<StatusWith<CallbackHandle>> cbHandles;
+    std::vector<std::shared_ptr<CallbackState>> cbStates;
+    cbHandles.reserve(requests.size());
+    cbStates.reserve(requests.size());
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (auto& wq : wqs) {
+            auto& swCbHandle =
+                cbHandles.emplace_back(enqueueCallbackState_inlock(&_networkInProgressQueue, &wq));
+            cbStates.push_back(swCbHandle.isOK() ? _networkInProgressQueue.back() : nullptr);
+        }
+    }
+
+    std::vector<NetworkInterface::CommandToStart> commands;
+    std::vector<size_t> commandIndexes;
+    commands.reserve(requests.size());
+    commandIndexes.reserve(requests.size());
+    for (size_t i = 0; i < scheduledRequests.size(); ++i) {
+        if (!cbHandles[i].isOK()) {
+            continue;
+        }
+
+        LOG(3) << "Scheduling remote command request: " << redact(scheduledRequests[i].toString());
+        commands.push_back({cbHandles[i].getValue(),
+                            scheduledRequests[i],
+                            makeRemoteCommandCompletionFn(scheduledRequests[i], cbStates[i], cb)});
+        commandIndexes.push_back(i);
+    }
+
+    auto statuses = _net->startCommands(commands, baton);
+    for (size_t i = 0; i < statuses.size(); ++i) {
+        if (!statuses[i].isOK()) {
+            cbHandles[commandIndexes[i]] = std::move(statuses[i]);
+        }
+    }
+
+    return cbHandles;
+}
+
+unique_function<void(const TaskExecutor::ResponseOnAnyStatus&)>
+ThreadPoolTaskExecutor::makeRemoteCommandCompletionFn(
+    const RemoteCommandRequestOnAny& scheduledRequest,
+    std::shared_ptr<CallbackState> cbState,
+    const RemoteCommandOnAnyCallbackFn& cb) {
+    return [this, scheduledRequest, cbState = std::move(cbState), cb](
+               const ResponseOnAnyStatus& response) {
+        using std::swap;
+        CallbackFn newCb = [cb, scheduledRequest, response](const CallbackArgs& cbData) {
+            remoteCommandFinished(cbData, cb, scheduledRequest, response);
+        };
+        stdx::unique_lock<Latch> lk(_mutex);
+        if (_inShutdown_inlock()) {
+            return;
+        }
+        LOG(3) << "Received remote response: "
+               << redact(response.isOK() ? response.toString() : response.status.toString());
+        swap(cbState->callback, newCb);
+        scheduleIntoPool_inlock(&_networkInProgressQueue, cbState->iter, std::move(lk));
+    };
+}
+
 void ThreadPoolTaskExecutor::cancel(const CallbackHandle& cbHandle) {
     invariant(cbHandle.isValid());
     auto cbState = checked_cast<CallbackState*>(getCallbackFromHandle(cbHandle));
@@ -88,6 +88,10 @@ public:
         const RemoteCommandRequestOnAny& request,
         const RemoteCommandOnAnyCallbackFn& cb,
         const BatonHandle& baton = nullptr) override;
+    std::vector<StatusWith<CallbackHandle>> scheduleRemoteCommandsOnAny(
+        const std::vector<RemoteCommandRequestOnAny>& requests,
+        const RemoteCommandOnAnyCallbackFn& cb,
+        const BatonHandle& baton = nullptr) override;
     void cancel(const CallbackHandle& cbHandle) override;
     void wait(const CallbackHandle& cbHandle,
               Interruptible* interruptible = Interruptible::notInterruptible()) override;
@@ -146,6 +150,15 @@ private:
      */
     StatusWith<CallbackHandle> enqueueCallbackState_inlock(WorkQueue* queue, WorkQueue* wq);
 
+    /**
+     * Returns the function for the network interface to run when the remote command
+     * "scheduledRequest", enqueued as "cbState", finishes. It schedules "cb" into the thread pool.
+     */
+    unique_function<void(const ResponseOnAnyStatus&)> makeRemoteCommandCompletionFn(
+        const RemoteCommandRequestOnAny& scheduledRequest,
+        std::shared_ptr<CallbackState> cbState,
+        const RemoteCommandOnAnyCallbackFn& cb);
+
     /**
      * Signals the given event.
      */
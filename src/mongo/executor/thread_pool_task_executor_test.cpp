@@ -41,8 +41,10 @@
 #include "mongo/executor/thread_pool_mock.h"
 #include "mongo/executor/thread_pool_task_executor.h"
 #include "mongo/executor/thread_pool_task_executor_test_fixture.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/unittest/barrier.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/work_stealing_thread_pool.h"
 #include "mongo/util/fail_point.h"
 
 namespace mongo {
@@ -258,6 +260,51 @@ TEST_F(ThreadPoolExecutorTest, ShutdownAndScheduleRaceDoesNotCrash) {
     ASSERT_EQUALS(ErrorCodes::CallbackCanceled, status2);
 }
 
+class WorkStealingThreadPoolExecutorTest : public TaskExecutorTest {
+private:
+    std::unique_ptr<TaskExecutor> makeTaskExecutor(
+        std::unique_ptr<NetworkInterfaceMock> net) override {
+        WorkStealingThreadPool::Options options;
+        options.poolName = "WorkStealingThreadPoolExecutorTest";
+        options.numThreads = 4;
+        return std::make_unique<ThreadPoolTaskExecutor>(
+            std::make_unique<WorkStealingThreadPool>(std::move(options)), std::move(net));
+    }
+};
+
+TEST_F(WorkStealingThreadPoolExecutorTest, RunsCallbacksScheduledFromCallbacks) {
+    const int kNumOuterCallbacks = 100;
+    const int kNumInnerCallbacks = 10;
+
+    auto& executor = getExecutor();
+    launchExecutorThread();
+    auto allDone = unittest::assertGet(executor.makeEvent());
+    AtomicWord<int> numRun{0};
+    auto countCallback = [&] {
+        if (numRun.addAndFetch(1) == kNumOuterCallbacks * (kNumInnerCallbacks + 1)) {
+            executor.signalEvent(allDone);
+        }
+    };
+
+    for (int i = 0; i < kNumOuterCallbacks; ++i) {
+        executor.schedule([&](Status status) {
+            ASSERT_OK(status);
+            for (int j = 0; j < kNumInnerCallbacks; ++j) {
+                executor.schedule([&](Status status) {
+                    ASSERT_OK(status);
+                    countCallback();
+                });
+            }
+            countCallback();
+        });
+    }
+
+    executor.waitForEvent(allDone);
+    ASSERT_EQ(kNumOuterCallbacks * (kNumInnerCallbacks + 1), numRun.load());
+    shutdownExecutorThread();
+    joinExecutorThread();
+}
+
 }  // namespace
 }  // namespace executor
 }  // namespace mongo
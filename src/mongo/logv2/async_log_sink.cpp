@@ -0,0 +1,231 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/logv2/async_log_sink.h"
+
+#include <algorithm>
+#include <boost/log/attributes/value_extraction.hpp>
+
+#include "mongo/logv2/attributes.h"
+#include "mongo/logv2/log_severity.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace logv2 {
+namespace {
+
+// Slots which held an unusually long line give the memory back once it is written out.
+constexpr size_t kMaxRetainedLineCapacity = 64 * 1024;
+
+// How long the writer thread sleeps when there is nothing to write before looking again. Logging
+// threads wake it up earlier, this only bounds the delay if a wakeup is missed.
+constexpr auto kWriterIdleWait = Milliseconds(100);
+
+// How long a logging thread which found the ring full sleeps before trying again.
+constexpr auto kProducerBackoff = Microseconds(50);
+
+// How long a Severe record may wait for the lines queued before it to be written out.
+constexpr auto kSevereFlushTimeout = Seconds(5);
+
+size_t roundUpToPowerOfTwo(size_t n) {
+    size_t result = 1;
+    while (result < n) {
+        result <<= 1;
+    }
+    return result;
+}
+
+}  // namespace
+
+AsyncLogSink::AsyncLogSink(Writer writer, size_t capacity)
+    : _writer(std::move(writer)),
+      _capacity(roundUpToPowerOfTwo(std::max<size_t>(capacity, 2))),
+      _slots(std::make_unique<Slot[]>(_capacity)) {
+    for (size_t i = 0; i < _capacity; ++i) {
+        _slots[i].sequence.store(i);
+    }
+    _thread = stdx::thread([this] { _writerLoop(); });
+}
+
+AsyncLogSink::~AsyncLogSink() {
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _shutdown = true;
+    }
+    _writerCV.notify_one();
+    _thread.join();
+}
+
+void AsyncLogSink::consume(boost::log::record_view const& rec,
+                           string_type const& formattedString) {
+    if (!_tryPush(formattedString)) {
+        _producerWaits.fetchAndAddRelaxed(1);
+        Timer waitTimer;
+        do {
+            _writerCV.notify_one();
+            sleepFor(kProducerBackoff);
+        } while (!_tryPush(formattedString));
+        _producerWaitMicros.fetchAndAddRelaxed(waitTimer.micros());
+    }
+
+    if (_writerSleeping.load()) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _writerCV.notify_one();
+    }
+
+    auto severity = boost::log::extract<LogSeverity>(attributes::severity(), rec);
+    if (severity && severity.get() >= LogSeverity::Severe()) {
+        flush(Date_t::now() + kSevereFlushTimeout);
+    }
+}
+
+bool AsyncLogSink::flush(Date_t deadline) {
+    const auto target = _tail.load();
+    if (_head.load() >= target) {
+        return true;
+    }
+
+    _flushWaiters.fetchAndAdd(1);
+    ON_BLOCK_EXIT([&] { _flushWaiters.fetchAndAdd(-1); });
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    _writerCV.notify_one();
+    auto flushed = [&] { return _head.load() >= target; };
+    if (deadline == Date_t::max()) {
+        _flushCV.wait(lk, flushed);
+        return true;
+    }
+    return _flushCV.wait_until(lk, deadline.toSystemTimePoint(), flushed);
+}
+
+AsyncLogSink::Stats AsyncLogSink::getStats() const {
+    Stats stats;
+    stats.queued = static_cast<long long>(_tail.load());
+    stats.written = static_cast<long long>(_head.load());
+    stats.bytesWritten = _bytesWritten.load();
+    stats.writeErrors = _writeErrors.load();
+    stats.producerWaits = _producerWaits.load();
+    stats.producerWaitMicros = _producerWaitMicros.load();
+    stats.capacity = static_cast<long long>(_capacity);
+    return stats;
+}
+
+bool AsyncLogSink::_tryPush(const string_type& line) {
+    auto pos = _tail.load();
+    Slot* slot;
+    while (true) {
+        slot = &_slots[pos & (_capacity - 1)];
+        const auto sequence = slot->sequence.load();
+        if (sequence == pos) {
+            // The slot is free, claim its position. On failure 'pos' is updated to the current
+            // tail and the claim is retried.
+            if (_tail.compareAndSwap(&pos, pos + 1)) {
+                break;
+            }
+        } else if (sequence < pos) {
+            // The slot still holds the line queued one lap ago, the ring is full.
+            return false;
+        } else {
+            pos = _tail.load();
+        }
+    }
+
+    slot->line.assign(line.data(), line.size());
+    slot->sequence.store(pos + 1);
+    return true;
+}
+
+bool AsyncLogSink::_writeReady() {
+    bool wroteAny = false;
+    auto pos = _head.load();
+    while (true) {
+        auto& slot = _slots[pos & (_capacity - 1)];
+        if (slot.sequence.load() != pos + 1) {
+            break;
+        }
+
+        try {
+            _writer(slot.line);
+            _bytesWritten.fetchAndAddRelaxed(slot.line.size());
+        } catch (...) {
+            _writeErrors.fetchAndAddRelaxed(1);
+        }
+
+        if (slot.line.capacity() > kMaxRetainedLineCapacity) {
+            string_type().swap(slot.line);
+        }
+
+        // Hand the slot back to the logging threads for the next lap of the ring.
+        slot.sequence.store(pos + _capacity);
+        _head.store(++pos);
+        wroteAny = true;
+    }
+    return wroteAny;
+}
+
+void AsyncLogSink::_writerLoop() {
+    setThreadName("AsyncLogWriter");
+
+    while (true) {
+        const bool wroteAny = _writeReady();
+
+        if (wroteAny && _flushWaiters.load() > 0) {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _flushCV.notify_all();
+        }
+        if (wroteAny) {
+            continue;
+        }
+
+        stdx::unique_lock<Latch> lk(_mutex);
+        if (_shutdown) {
+            // Lines queued after the check above are written out before stopping.
+            lk.unlock();
+            _writeReady();
+            return;
+        }
+
+        // Logging threads only wake the writer up while it is marked as sleeping, so check for a
+        // ready line again after marking it.
+        _writerSleeping.store(true);
+        _writerCV.wait_for(lk, kWriterIdleWait.toSystemDuration(), [&] {
+            return _shutdown ||
+                _slots[_head.load() & (_capacity - 1)].sequence.load() == _head.load() + 1;
+        });
+        _writerSleeping.store(false);
+    }
+}
+
+}  // namespace logv2
+}  // namespace mongo
@@ -0,0 +1,161 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/sinks/unlocked_frontend.hpp>
+#include <boost/make_shared.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace logv2 {
+
+/**
+ * Sink backend which hands formatted log lines to a background writer thread, so that threads
+ * which log do not wait for the write to the destination, nor for each other while it happens.
+ *
+ * Records are formatted on the logging thread, since their attributes refer to the caller's
+ * stack, by the per-thread formatter of the unlocked frontend. The formatted line is then copied
+ * into a slot of a bounded lock-free ring buffer. Slots keep their capacity, so once the ring is
+ * warm queueing a line of a usual size does not allocate.
+ *
+ * When the ring is full, the logging thread waits for the writer to free a slot rather than drop
+ * the line, and the wait is counted in the statistics. Severe records are written out before the
+ * logging thread returns, since the process may be about to terminate.
+ */
+class AsyncLogSink
+    : public boost::log::sinks::basic_formatted_sink_backend<char,
+                                                             boost::log::sinks::concurrent_feeding> {
+private:
+    typedef boost::log::sinks::basic_formatted_sink_backend<char,
+                                                            boost::log::sinks::concurrent_feeding>
+        base_type;
+
+public:
+    typedef typename base_type::string_type string_type;
+
+    /**
+     * Writes a formatted line to the destination. Only called from the writer thread.
+     */
+    using Writer = std::function<void(const string_type&)>;
+
+    struct Stats {
+        // Number of lines accepted into the ring.
+        long long queued = 0;
+        // Number of lines handed to the writer.
+        long long written = 0;
+        long long bytesWritten = 0;
+        // Number of lines whose writer threw.
+        long long writeErrors = 0;
+        // Number of times a logging thread found the ring full, and how long it waited in total.
+        long long producerWaits = 0;
+        long long producerWaitMicros = 0;
+        long long capacity = 0;
+    };
+
+    static constexpr size_t kDefaultCapacity = 4096;
+
+    static boost::shared_ptr<boost::log::sinks::unlocked_sink<AsyncLogSink>> create(
+        Writer writer, size_t capacity = kDefaultCapacity) {
+        auto backend = boost::make_shared<AsyncLogSink>(std::move(writer), capacity);
+        return boost::make_shared<boost::log::sinks::unlocked_sink<AsyncLogSink>>(
+            boost::move(backend));
+    }
+
+    /**
+     * Starts the writer thread. The 'capacity' is rounded up to a power of two.
+     */
+    AsyncLogSink(Writer writer, size_t capacity);
+
+    /**
+     * Writes out the queued lines and stops the writer thread.
+     */
+    ~AsyncLogSink();
+
+    void consume(boost::log::record_view const& rec, string_type const& formattedString);
+
+    /**
+     * Waits until the lines queued before the call have been written, or until 'deadline'.
+     * Returns false if the deadline was reached first.
+     */
+    bool flush(Date_t deadline = Date_t::max());
+
+    Stats getStats() const;
+
+private:
+    struct Slot {
+        // Equal to the position of the slot when it is free to be written, and to the position
+        // plus one once the line in it is ready to be written out.
+        AtomicWord<unsigned long long> sequence;
+        string_type line;
+    };
+
+    bool _tryPush(const string_type& line);
+    bool _writeReady();
+    void _writerLoop();
+
+    const Writer _writer;
+    const size_t _capacity;
+    const std::unique_ptr<Slot[]> _slots;
+
+    // Next position to queue into, shared by the logging threads.
+    AtomicWord<unsigned long long> _tail{0};
+    // Next position to write out, only advanced by the writer thread.
+    AtomicWord<unsigned long long> _head{0};
+
+    AtomicWord<long long> _bytesWritten{0};
+    AtomicWord<long long> _writeErrors{0};
+    AtomicWord<long long> _producerWaits{0};
+    AtomicWord<long long> _producerWaitMicros{0};
+
+    // Set while the writer thread sleeps, and while threads wait for a flush, so that logging
+    // threads and the writer only take the mutex to wake someone up.
+    AtomicWord<bool> _writerSleeping{false};
+    AtomicWord<int> _flushWaiters{0};
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("AsyncLogSink::_mutex");
+    stdx::condition_variable _writerCV;
+    stdx::condition_variable _flushCV;
+    bool _shutdown = false;
+
+    stdx::thread _thread;
+};
+
+}  // namespace logv2
+}  // namespace mongo
@@ -87,6 +87,7 @@ struct LogDomainGlobal::Impl {
 #endif
     typedef boost::log::sinks::synchronous_sink<boost::log::sinks::text_file_backend>
         RotatableFileBackend;
+    typedef boost::log::sinks::unlocked_sink<AsyncLogSink> AsyncFileBackend;
 
     Impl(LogDomainGlobal& parent);
     Status configure(LogDomainGlobal::ConfigurationOptions const& options);
@@ -96,6 +97,9 @@ struct LogDomainGlobal::Impl {
     LogComponentSettings _settings;
     boost::shared_ptr<ConsoleBackend> _consoleBackend;
     boost::shared_ptr<RotatableFileBackend> _rotatableFileBackend;
+    // When the file is written asynchronously, records are formatted and queued by this sink and
+    // its writer thread writes them to '_rotatableFileBackend', which is not added to the core.
+    boost::shared_ptr<AsyncFileBackend> _asyncFileBackend;
     boost::shared_ptr<RamLogBackend> _globalLogCacheBackend;
     boost::shared_ptr<RamLogBackend> _startupWarningsBackend;
 #ifndef _WIN32
@@ -165,7 +169,18 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
         boost::log::core::get()->remove_sink(_consoleBackend);
     }
 
+    if (_asyncFileBackend) {
+        // Removing the sink from the core stops new records from being queued, the writer thread
+        // writes out the queued ones when the last reference to the sink goes away.
+        boost::log::core::get()->remove_sink(_asyncFileBackend);
+        _asyncFileBackend.reset();
+    }
+
     if (options._fileEnabled) {
+        if (_rotatableFileBackend) {
+            boost::log::core::get()->remove_sink(_rotatableFileBackend);
+        }
+
         auto backend = boost::make_shared<boost::log::sinks::text_file_backend>(
             boost::log::keywords::file_name = options._filePath);
         backend->auto_flush(true);
@@ -175,7 +190,17 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
         _rotatableFileBackend = boost::make_shared<RotatableFileBackend>(backend);
         _rotatableFileBackend->set_filter(ComponentSettingsFilter(_parent, _settings));
 
-        boost::log::core::get()->add_sink(_rotatableFileBackend);
+        if (options._fileAsync) {
+            _asyncFileBackend = AsyncLogSink::create(
+                [fileBackend = _rotatableFileBackend](const std::string& line) {
+                    // The file backend does not look at the record, only at the formatted line.
+                    fileBackend->locked_backend()->consume(boost::log::record_view(), line);
+                });
+            _asyncFileBackend->set_filter(ComponentSettingsFilter(_parent, _settings));
+            boost::log::core::get()->add_sink(_asyncFileBackend);
+        } else {
+            boost::log::core::get()->add_sink(_rotatableFileBackend);
+        }
     } else if (_rotatableFileBackend) {
         boost::log::core::get()->remove_sink(_rotatableFileBackend);
         _rotatableFileBackend.reset();
@@ -185,7 +210,9 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
         _consoleBackend->set_formatter(mkFmt());
         _globalLogCacheBackend->set_formatter(mkFmt());
         _startupWarningsBackend->set_formatter(mkFmt());
-        if (_rotatableFileBackend)
+        if (_asyncFileBackend)
+            _asyncFileBackend->set_formatter(mkFmt());
+        else if (_rotatableFileBackend)
             _rotatableFileBackend->set_formatter(mkFmt());
 #ifndef _WIN32
         if (_syslogBackend)
@@ -207,6 +234,10 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
 }
 
 Status LogDomainGlobal::Impl::rotate() {
+    if (_asyncFileBackend) {
+        // Lines logged before the rotation belong in the file being rotated out.
+        _asyncFileBackend->locked_backend()->flush();
+    }
     if (_rotatableFileBackend) {
         auto backend = _rotatableFileBackend->locked_backend();
         backend->rotate_file();
@@ -235,6 +266,19 @@ Status LogDomainGlobal::rotate() {
     return _impl->rotate();
 }
 
+void LogDomainGlobal::flush(Date_t deadline) {
+    if (auto asyncFileBackend = _impl->_asyncFileBackend) {
+        asyncFileBackend->locked_backend()->flush(deadline);
+    }
+}
+
+boost::optional<AsyncLogSink::Stats> LogDomainGlobal::asyncFileStats() const {
+    if (auto asyncFileBackend = _impl->_asyncFileBackend) {
+        return asyncFileBackend->locked_backend()->getStats();
+    }
+    return boost::none;
+}
+
 LogComponentSettings& LogDomainGlobal::settings() {
     return _impl->_settings;
 }
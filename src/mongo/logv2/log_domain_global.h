@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
+#include "mongo/logv2/async_log_sink.h"
 #include "mongo/logv2/log_domain_internal.h"
 #include "mongo/logv2/log_format.h"
 
@@ -43,6 +46,8 @@ public:
         bool _consoleEnabled{true};
         bool _fileEnabled{false};
         std::string _filePath;
+        // Write to the file from a background thread instead of from the logging threads.
+        bool _fileAsync{false};
         RotationMode _fileRotationMode{RotationMode::kRename};
         OpenMode _fileOpenMode{OpenMode::kTruncate};
         bool _syslogEnabled{false};
@@ -60,6 +65,18 @@ public:
     Status configure(ConfigurationOptions const& options);
     Status rotate();
 
+    /**
+     * Waits until the lines queued for asynchronous writing have been written, or until
+     * 'deadline'. Returns immediately if the file is not written asynchronously.
+     */
+    void flush(Date_t deadline = Date_t::max());
+
+    /**
+     * Returns the statistics of the asynchronous file writer, if the file is written
+     * asynchronously.
+     */
+    boost::optional<AsyncLogSink::Stats> asyncFileStats() const;
+
     LogComponentSettings& settings();
 
 private:
@@ -33,11 +33,13 @@
 
 #include "mongo/logv2/log_test_v2.h"
 
+#include <cstdio>
 #include <fstream>
 #include <string>
 #include <vector>
 
 #include "mongo/bson/json.h"
+#include "mongo/logv2/async_log_sink.h"
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/formatter_base.h"
 #include "mongo/logv2/json_formatter.h"
@@ -47,6 +49,7 @@
 #include "mongo/logv2/text_formatter.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
+#include "mongo/util/time_support.h"
 
 #include <boost/log/attributes/constant.hpp>
 
@@ -438,6 +441,90 @@ TEST_F(LogTestV2, FileLogging) {
     ASSERT(before_rotation == after_rotation);
 }
 
+TEST_F(LogTestV2, AsyncSink) {
+    std::vector<std::string> lines;
+    auto sink = AsyncLogSink::create([&](const std::string& line) { lines.push_back(line); });
+    sink->set_filter(ComponentSettingsFilter(LogManager::global().getGlobalDomain(),
+                                             LogManager::global().getGlobalSettings()));
+    sink->set_formatter(PlainFormatter());
+    attach(sink);
+
+    LOGV2("test");
+    LOGV2("test {}", "name"_attr = 2);
+    ASSERT(sink->locked_backend()->flush());
+
+    ASSERT_EQ(lines.size(), 2u);
+    ASSERT_EQ(lines[0], "test");
+    ASSERT_EQ(lines[1], "test 2");
+
+    auto stats = sink->locked_backend()->getStats();
+    ASSERT_EQ(stats.queued, 2);
+    ASSERT_EQ(stats.written, 2);
+    ASSERT_EQ(stats.bytesWritten, 10);
+    ASSERT_EQ(stats.capacity, static_cast<long long>(AsyncLogSink::kDefaultCapacity));
+}
+
+TEST_F(LogTestV2, AsyncSinkThreads) {
+    std::vector<std::string> lines;
+    auto sink = AsyncLogSink::create([&](const std::string& line) { lines.push_back(line); }, 64);
+    sink->set_filter(ComponentSettingsFilter(LogManager::global().getGlobalDomain(),
+                                             LogManager::global().getGlobalSettings()));
+    sink->set_formatter(PlainFormatter());
+    attach(sink);
+
+    constexpr int kNumThreads = 4;
+    constexpr int kNumPerThread = 1000;
+    std::vector<stdx::thread> threads;
+    for (int t = 0; t < kNumThreads; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < kNumPerThread; ++i)
+                LOGV2("{} {}", "thread"_attr = t, "i"_attr = i);
+        });
+    }
+
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    ASSERT(sink->locked_backend()->flush());
+
+    // Every line is written once, and the lines of each thread are written in order.
+    ASSERT_EQ(lines.size(), static_cast<size_t>(kNumThreads * kNumPerThread));
+    std::vector<int> next(kNumThreads, 0);
+    for (auto&& line : lines) {
+        int t, i;
+        ASSERT_EQ(sscanf(line.c_str(), "%d %d", &t, &i), 2);
+        ASSERT_EQ(i, next[t]++);
+    }
+}
+
+TEST_F(LogTestV2, AsyncSinkWaitsWhenFull) {
+    std::vector<std::string> lines;
+    auto sink = AsyncLogSink::create(
+        [&](const std::string& line) {
+            sleepmillis(1);
+            lines.push_back(line);
+        },
+        2);
+    sink->set_filter(ComponentSettingsFilter(LogManager::global().getGlobalDomain(),
+                                             LogManager::global().getGlobalSettings()));
+    sink->set_formatter(PlainFormatter());
+    attach(sink);
+
+    constexpr int kNumLines = 20;
+    for (int i = 0; i < kNumLines; ++i)
+        LOGV2("{}", "i"_attr = i);
+    ASSERT(sink->locked_backend()->flush());
+
+    // No line is dropped when the writer falls behind, the logging thread waits instead.
+    ASSERT_EQ(lines.size(), static_cast<size_t>(kNumLines));
+    for (int i = 0; i < kNumLines; ++i)
+        ASSERT_EQ(lines[i], std::to_string(i));
+
+    auto stats = sink->locked_backend()->getStats();
+    ASSERT_GT(stats.producerWaits, 0);
+    ASSERT_EQ(stats.capacity, 2);
+}
+
 }  // namespace
 }  // namespace logv2
 }  // namespace mongo
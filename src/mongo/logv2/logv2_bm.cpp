@@ -33,6 +33,7 @@
 #include "mongo/logger/console_appender.h"
 #include "mongo/logger/logger.h"
 #include "mongo/logger/message_event_utf8_encoder.h"
+#include "mongo/logv2/async_log_sink.h"
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/log.h"
 #include "mongo/logv2/log_domain_global.h"
@@ -160,6 +161,60 @@ private:
     bool _shouldInit;
 };
 
+// RAII style helper class for init/deinit new log system writing from a background thread
+class ScopedLogV2AsyncBench {
+public:
+    ScopedLogV2AsyncBench(benchmark::State& state) {
+        _shouldInit = state.thread_index == 0;
+        if (_shouldInit) {
+            setupAppender();
+        }
+    }
+
+    ~ScopedLogV2AsyncBench() {
+        if (_shouldInit) {
+            tearDownAppender();
+        }
+    }
+
+private:
+    void setupAppender() {
+        logv2::LogDomainGlobal::ConfigurationOptions config;
+        config.makeDisabled();
+        invariant(logv2::LogManager::global().getGlobalDomainInternal().configure(config).isOK());
+
+        _sink = logv2::AsyncLogSink::create(
+            [stream = makeNullStream()](const std::string& line) { *stream << line << '\n'; });
+        _sink->set_filter(
+            logv2::ComponentSettingsFilter(logv2::LogManager::global().getGlobalDomain(),
+                                           logv2::LogManager::global().getGlobalSettings()));
+        _sink->set_formatter(logv2::TextFormatter());
+        boost::log::core::get()->add_sink(_sink);
+    }
+
+    void tearDownAppender() {
+        boost::log::core::get()->remove_sink(_sink);
+        _sink->locked_backend()->flush();
+        invariant(logv2::LogManager::global().getGlobalDomainInternal().configure({}).isOK());
+    }
+
+    boost::shared_ptr<boost::log::sinks::unlocked_sink<logv2::AsyncLogSink>> _sink;
+    bool _shouldInit;
+};
+
+// A line of the size and shape of a typical slow query log line.
+std::string createSlowQueryLine() {
+    return "command test.coll appName: \"MongoDB Shell\" command: find { find: \"coll\", "
+           "filter: { a: { $gte: 10 }, b: \"abc\" }, sort: { c: -1 }, limit: 20, lsid: { id: "
+           "UUID(\"f3b0a3a6-2c8e-4b7a-9c55-3d3a0f2e1c11\") }, $db: \"test\" } planSummary: "
+           "IXSCAN { a: 1 } keysExamined:12031 docsExamined:12031 hasSortStage:1 "
+           "cursorExhausted:1 numYields:94 nreturned:20 queryHash:7E2A3B4C "
+           "planCacheKey:1F2E3D4C reslen:4211 locks:{ ReplicationStateTransition: { "
+           "acquireCount: { w: 95 } }, Global: { acquireCount: { r: 95 } }, Database: { "
+           "acquireCount: { r: 95 } }, Collection: { acquireCount: { r: 95 } } } "
+           "storage:{} protocol:op_msg 187ms";
+}
+
 // "Expensive" way to create a string.
 std::string createLongString() {
     return std::string(1000, 'a') + std::string(1000, 'b') + std::string(1000, 'c') +
@@ -266,6 +321,32 @@ static void BM_EnabledLogV2ManySmallArg(benchmark::State& state) {
     }
 }
 
+static void BM_EnabledLogV2SlowQuery(benchmark::State& state) {
+    ScopedLogV2Bench init(state);
+    const auto line = createSlowQueryLine();
+
+    for (auto _ : state)
+        LOGV2("{}", "message"_attr = line);
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_EnabledLogV2Async(benchmark::State& state) {
+    ScopedLogV2AsyncBench init(state);
+
+    for (auto _ : state)
+        LOGV2("enabled log");
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_EnabledLogV2AsyncSlowQuery(benchmark::State& state) {
+    ScopedLogV2AsyncBench init(state);
+    const auto line = createSlowQueryLine();
+
+    for (auto _ : state)
+        LOGV2("{}", "message"_attr = line);
+    state.SetItemsProcessed(state.iterations());
+}
+
 BENCHMARK(BM_NoopLog)->Threads(1);
 BENCHMARK(BM_NoopLogV2Inline)->Threads(1);
 BENCHMARK(BM_NoopLogV2PimplRecord)->Threads(1);
@@ -334,6 +415,12 @@ BENCHMARK(BM_EnabledLogV2ManySmallArg)->Threads(4);
 BENCHMARK(BM_EnabledLogManySmallArg)->Threads(8);
 BENCHMARK(BM_EnabledLogV2ManySmallArg)->Threads(8);
 
+BENCHMARK(BM_EnabledLogV2)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_EnabledLogV2Async)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK(BM_EnabledLogV2SlowQuery)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_EnabledLogV2AsyncSlowQuery)->ThreadRange(1, 16)->UseRealTime();
+
 
 }  // namespace
 }  // namespace mongo
@@ -47,7 +47,8 @@ namespace rpc {
 
 LegacyReplyBuilder::LegacyReplyBuilder() : LegacyReplyBuilder(Message()) {}
 
-LegacyReplyBuilder::LegacyReplyBuilder(Message&& message) : _message{std::move(message)} {
+LegacyReplyBuilder::LegacyReplyBuilder(Message&& message)
+    : _builder(UseSharedBufferPool{}), _message{std::move(message)} {
     _builder.skip(sizeof(QueryResult::Value));
 }
 
@@ -33,6 +33,7 @@
 
 #include "mongo/rpc/op_msg.h"
 
+#include <array>
 #include <bitset>
 #include <set>
 
@@ -76,6 +77,86 @@ uint32_t calculateChecksum(const Message& message) {
     invariant(OpMsg::isFlagSet(message, OpMsg::kChecksumPresent));
     return wiredtiger_crc32c_func()(message.singleData().view2ptr(), message.size() - kCrc32Size);
 }
+
+// Reflected CRC-32C (Castagnoli) polynomial.
+constexpr uint32_t kCrc32cPolynomial = 0x82f63b78;
+
+// Returns a * b modulo the CRC polynomial, where the bits of a and b are polynomial coefficients
+// with x^0 in the most significant bit.
+uint32_t crc32cMultiplyModP(uint32_t a, uint32_t b) {
+    uint32_t m = uint32_t(1) << 31;
+    uint32_t product = 0;
+    for (;;) {
+        if (a & m) {
+            product ^= b;
+            if ((a & (m - 1)) == 0) {
+                break;
+            }
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ kCrc32cPolynomial : b >> 1;
+    }
+    return product;
+}
+
+/**
+ * Returns the crc32c of the concatenation of two byte ranges from the crc32c of each and the length
+ * of the second, in time logarithmic in that length.
+ */
+uint32_t crc32cCombine(uint32_t crc1, uint32_t crc2, uint32_t length2) {
+    // powers[k] is x^(2^k) modulo the polynomial.
+    static const auto powers = [] {
+        std::array<uint32_t, 35> powers;
+        powers[0] = uint32_t(1) << 30;
+        for (size_t k = 1; k < powers.size(); ++k) {
+            powers[k] = crc32cMultiplyModP(powers[k - 1], powers[k - 1]);
+        }
+        return powers;
+    }();
+
+    // Appending 'length2' bytes multiplies the first crc by x^(8 * length2).
+    uint32_t shift = uint32_t(1) << 31;
+    for (size_t k = 3; length2; length2 >>= 1, ++k) {
+        if (length2 & 1) {
+            shift = crc32cMultiplyModP(powers[k], shift);
+        }
+    }
+    return crc32cMultiplyModP(shift, crc1) ^ crc2;
+}
+
+/**
+ * Checksums a message from its start, a range at a time, as it is parsed. The parser reports how
+ * far it has read after each document, and every range of at least kChunkBytes is checksummed then,
+ * while it is still in cache, instead of in a second pass over the whole message.
+ */
+class IncrementalChecksum {
+public:
+    explicit IncrementalChecksum(const char* begin) : _pending(begin) {}
+
+    void advance(const void* pos) {
+        if (static_cast<const char*>(pos) - _pending >= kChunkBytes) {
+            _checksumTo(static_cast<const char*>(pos));
+        }
+    }
+
+    uint32_t finish(const void* end) {
+        _checksumTo(static_cast<const char*>(end));
+        return _crc;
+    }
+
+private:
+    static constexpr ptrdiff_t kChunkBytes = 128 * 1024;
+
+    void _checksumTo(const char* pos) {
+        const uint32_t length = pos - _pending;
+        _crc = crc32cCombine(_crc, wiredtiger_crc32c_func()(_pending, length), length);
+        _pending = pos;
+    }
+
+    // The crc32c of everything before '_pending'. The crc32c of no bytes is 0.
+    uint32_t _crc = 0;
+    const char* _pending;
+};
 #endif  // MONGO_CONFIG_WIREDTIGER_ENABLED
 }  // namespace
 
@@ -151,6 +232,13 @@ OpMsg OpMsg::parse(const Message& message) try {
     // The sections begin after the flags and before the checksum (if present).
     BufReader sectionsBuf(message.singleData().data() + sizeof(flags), dataSize);
 
+#ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
+    boost::optional<IncrementalChecksum> incrementalChecksum;
+    if (checksum) {
+        incrementalChecksum.emplace(message.singleData().view2ptr());
+    }
+#endif
+
     // TODO some validation may make more sense in the IDL parser. I've tagged them with comments.
     bool haveBody = false;
     OpMsg msg;
@@ -161,6 +249,11 @@ OpMsg OpMsg::parse(const Message& message) try {
                 uassert(40430, "Multiple body sections in message", !haveBody);
                 haveBody = true;
                 msg.body = sectionsBuf.read<Validated<BSONObj>>();
+#ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
+                if (incrementalChecksum) {
+                    incrementalChecksum->advance(sectionsBuf.pos());
+                }
+#endif
                 break;
             }
 
@@ -184,6 +277,11 @@ OpMsg OpMsg::parse(const Message& message) try {
                 msg.sequences.push_back({name.toString()});
                 while (!seqBuf.atEof()) {
                     msg.sequences.back().objs.push_back(seqBuf.read<Validated<BSONObj>>());
+#ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
+                    if (incrementalChecksum) {
+                        incrementalChecksum->advance(seqBuf.pos());
+                    }
+#endif
                 }
                 break;
             }
@@ -212,7 +310,7 @@ OpMsg OpMsg::parse(const Message& message) try {
     if (checksum) {
         uassert(ErrorCodes::ChecksumMismatch,
                 "OP_MSG checksum does not match contents",
-                *checksum == calculateChecksum(message));
+                *checksum == incrementalChecksum->finish(sectionsBuf.pos()));
     }
 #endif
 
@@ -199,7 +199,7 @@ class OpMsgBuilder {
     OpMsgBuilder& operator=(const OpMsgBuilder&) = delete;
 
 public:
-    OpMsgBuilder() {
+    OpMsgBuilder() : _buf(UseSharedBufferPool{}) {
         skipHeaderAndFlags();
     }
 
@@ -382,6 +382,68 @@ TEST(OpMsg, ServerHandlesExhaustCorrectlyWithChecksum) {
     exhaustTest(true);
 }
 
+TEST(OpMsg, ServerStreamsAggregateCursorThroughExhaust) {
+    std::string errMsg;
+    auto conn = std::unique_ptr<DBClientBase>(
+        unittest::getFixtureConnectionString().connect("integration_test", errMsg));
+    uassert(ErrorCodes::SocketException, errMsg, conn);
+
+    // Receiving the stream requires a connection to a single server or to a mongos.
+    if (conn->isReplicaSetMember()) {
+        return;
+    }
+
+    NamespaceString nss("test", "coll");
+    conn->dropCollection(nss.toString());
+
+    for (int i = 0; i < 5; i++) {
+        conn->insert(nss.toString(), BSON("_id" << i), 0);
+    }
+
+    // The aggregate starts the exhaust stream, and every later batch is pushed by the server
+    // without the client sending a getMore. This holds for mongos cluster cursors as well.
+    auto aggCmd = BSON("aggregate" << nss.coll() << "pipeline"
+                                   << BSON_ARRAY(BSON("$sort" << BSON("_id" << 1))) << "cursor"
+                                   << BSON("batchSize" << 2));
+    auto request = OpMsgRequest::fromDBAndBody(nss.db(), aggCmd).serialize();
+    OpMsg::setFlag(&request, OpMsg::kExhaustSupported);
+
+    Message reply;
+    ASSERT(conn->call(request, reply));
+    auto lastRequestId = reply.header().getId();
+    ASSERT(OpMsg::isFlagSet(reply, OpMsg::kMoreToCome));
+    auto res = OpMsg::parse(reply).body;
+    ASSERT_OK(getStatusFromCommandResult(res));
+    const long long cursorId = res["cursor"]["id"].numberLong();
+    ASSERT_NE(cursorId, 0);
+    std::vector<BSONElement> batch = res["cursor"]["firstBatch"].Array();
+    ASSERT_EQ(batch.size(), 2U);
+    ASSERT_BSONOBJ_EQ(batch[0].embeddedObject(), BSON("_id" << 0));
+    ASSERT_BSONOBJ_EQ(batch[1].embeddedObject(), BSON("_id" << 1));
+
+    // Receive next exhaust batch, which keeps the batch size of the aggregate.
+    ASSERT(conn->recv(reply, lastRequestId));
+    lastRequestId = reply.header().getId();
+    ASSERT(OpMsg::isFlagSet(reply, OpMsg::kMoreToCome));
+    res = OpMsg::parse(reply).body;
+    ASSERT_OK(getStatusFromCommandResult(res));
+    ASSERT_EQ(res["cursor"]["id"].numberLong(), cursorId);
+    batch = res["cursor"]["nextBatch"].Array();
+    ASSERT_EQ(batch.size(), 2U);
+    ASSERT_BSONOBJ_EQ(batch[0].embeddedObject(), BSON("_id" << 2));
+    ASSERT_BSONOBJ_EQ(batch[1].embeddedObject(), BSON("_id" << 3));
+
+    // Receive terminal batch.
+    ASSERT(conn->recv(reply, lastRequestId));
+    ASSERT(!OpMsg::isFlagSet(reply, OpMsg::kMoreToCome));
+    res = OpMsg::parse(reply).body;
+    ASSERT_OK(getStatusFromCommandResult(res));
+    ASSERT_EQ(res["cursor"]["id"].numberLong(), 0);
+    batch = res["cursor"]["nextBatch"].Array();
+    ASSERT_EQ(batch.size(), 1U);
+    ASSERT_BSONOBJ_EQ(batch[0].embeddedObject(), BSON("_id" << 4));
+}
+
 TEST(OpMsg, ExhaustWithDBClientCursorBehavesCorrectly) {
     // This test simply tries to verify that using the exhaust option with DBClientCursor works
     // correctly. The externally visible behavior should technically be the same as a non-exhaust
@@ -31,6 +31,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <type_traits>
 
 #include "mongo/base/static_assert.h"
@@ -931,6 +932,27 @@ TEST(OpMsgTest, ChecksumResizesMessage) {
     OpMsg::parse(msg);
 }
 
+TEST(OpMsgTest, ChecksumOfLargeMessage) {
+    // The checksum of a message spanning many chunks is verified a chunk at a time as it is parsed.
+    OpMsg request;
+    request.body = fromjson("{insert: 'coll', $db: 'db'}");
+    request.sequences.push_back({"documents"});
+    const std::string value(1000, 'a');
+    for (int i = 0; i < 1000; ++i) {
+        request.sequences.back().objs.push_back(BSON("_id" << i << "value" << value));
+    }
+    auto msg = request.serialize();
+    OpMsg::appendChecksum(&msg);
+    ASSERT_EQ(OpMsg::parse(msg).sequences[0].objs.size(), 1000U);
+
+    // Changing a byte that leaves the documents valid is caught by the checksum.
+    char* data = msg.singleData().view2ptr();
+    char* changed = std::find(data + msg.size() / 2, data + msg.size(), 'a');
+    ASSERT(changed != data + msg.size());
+    *changed = 'b';
+    ASSERT_THROWS_CODE(OpMsg::parse(msg), AssertionException, ErrorCodes::ChecksumMismatch);
+}
+
 TEST(OpMsgTest, EmptyMessageWithChecksumFlag) {
     // Checks that an empty message that would normally be invalid because it's
     // missing a body, is invalid because a checksum was specified in the flag
@@ -37,15 +37,21 @@
 #include <memory>
 
 #include "mongo/client/remote_command_targeter.h"
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/db/query/killcursors_request.h"
+#include "mongo/db/wait_events.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
+#include "mongo/s/hedging_metrics.h"
+#include "mongo/s/hedging_server_parameters_gen.h"
 #include "mongo/transport/baton.h"
 #include "mongo/transport/transport_layer.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 using namespace fmt::literals;
 
@@ -56,6 +62,156 @@ namespace {
 // Maximum number of retries for network and replication notMaster errors (per host).
 const int kMaxNumFailedHostRetryAttempts = 3;
 
+using RemoteCommandOnAnyCallbackArgs = executor::TaskExecutor::RemoteCommandOnAnyCallbackArgs;
+
+/**
+ * Returns whether 'cmdObj' only reads and may run on a secondary, so that also sending it to a
+ * second host of the shard is harmless.
+ */
+bool isHedgeable(const ReadPreferenceSetting& readPref, const BSONObj& cmdObj) {
+    if (readPref.pref == ReadPreference::PrimaryOnly || cmdObj.hasField("txnNumber")) {
+        return false;
+    }
+
+    const auto cmdName = cmdObj.firstElementFieldNameStringData();
+    if (cmdName == "find"_sd || cmdName == "count"_sd || cmdName == "distinct"_sd) {
+        return true;
+    }
+    if (cmdName != "aggregate"_sd) {
+        return false;
+    }
+    const auto pipeline = cmdObj["pipeline"];
+    if (pipeline.type() != BSONType::Array) {
+        return false;
+    }
+    for (const auto& stage : pipeline.Obj()) {
+        if (stage.type() != BSONType::Object) {
+            return false;
+        }
+        const auto stageName = stage.Obj().firstElementFieldNameStringData();
+        if (stageName == "$out"_sd || stageName == "$merge"_sd) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * The state shared by the attempts of a hedged read. It outlives the AsyncRequestsSender when
+ * the slower attempt is still running after the response of the faster one was taken.
+ */
+struct HedgedRead {
+    HedgedRead(Promise<RemoteCommandOnAnyCallbackArgs> promise, bool opensCursor)
+        : promise(std::move(promise)), opensCursor(opensCursor) {}
+
+    Mutex mutex = MONGO_MAKE_LATCH("HedgedRead::mutex");
+
+    Promise<RemoteCommandOnAnyCallbackArgs> promise;
+
+    // Whether the command leaves a cursor open on the host which ran it. The attempts of such
+    // commands are not canceled once the other one has answered, since the cursor each of them
+    // opens has to be killed.
+    const bool opensCursor;
+
+    // Set once the promise was fulfilled.
+    bool done = false;
+
+    // The number of attempts still waiting for their response.
+    int outstanding = 0;
+
+    std::vector<executor::TaskExecutor::CallbackHandle> attempts;
+};
+
+/**
+ * Kills the cursor, if any, which the slower attempt of a hedged read opened.
+ */
+void killCursorOpenedBy(executor::TaskExecutor* executor,
+                        const RemoteCommandOnAnyCallbackArgs& cbData) {
+    if (!cbData.response.isOK() || !cbData.response.target) {
+        return;
+    }
+
+    auto swCursorResponse = CursorResponse::parseFromBSON(cbData.response.data);
+    if (!swCursorResponse.isOK() || swCursorResponse.getValue().getCursorId() == 0) {
+        return;
+    }
+
+    const auto& nss = swCursorResponse.getValue().getNSS();
+    executor::RemoteCommandRequest request(
+        *cbData.response.target,
+        nss.db().toString(),
+        KillCursorsRequest(nss, {swCursorResponse.getValue().getCursorId()}).toBSON(),
+        nullptr);
+
+    // Send kill request; discard callback handle, if any, or failure report, if not.
+    executor->scheduleRemoteCommand(request, [](auto const&) {}).getStatus().ignore();
+}
+
+/**
+ * Sends one attempt of a hedged read through 'executor', and fulfills the promise of 'read' with
+ * its response unless the other attempt answered first. A cursor opened by the slower attempt is
+ * killed through 'executor' as well, so for reads which open cursors 'executor' must be one which
+ * outlives the sender.
+ */
+Status sendHedgedAttempt(std::shared_ptr<executor::TaskExecutor> executor,
+                         const BatonHandle& baton,
+                         const executor::RemoteCommandRequestOnAny& request,
+                         std::shared_ptr<HedgedRead> read,
+                         HedgingMetrics* metrics,
+                         const ShardId& shardId,
+                         bool isHedge) {
+    {
+        stdx::lock_guard<Latch> lk(read->mutex);
+        ++read->outstanding;
+    }
+
+    Timer timer;
+    auto swCallbackHandle = executor->scheduleRemoteCommandOnAny(
+        request,
+        [executor, read, metrics, shardId, isHedge, timer](
+            const RemoteCommandOnAnyCallbackArgs& cbData) {
+            if (cbData.response.isOK()) {
+                metrics->recordResponseTime(shardId, Microseconds(timer.micros()));
+            }
+
+            stdx::unique_lock<Latch> lk(read->mutex);
+            --read->outstanding;
+            if (read->done) {
+                lk.unlock();
+                killCursorOpenedBy(executor.get(), cbData);
+                return;
+            }
+
+            // If this host could not be reached, the other one may still answer.
+            if (!cbData.response.isOK() && read->outstanding > 0) {
+                return;
+            }
+
+            read->done = true;
+            const auto attempts = read->attempts;
+            lk.unlock();
+
+            if (isHedge && cbData.response.isOK()) {
+                metrics->incrementNumAdvantageouslyHedgedOperations();
+            }
+            if (!read->opensCursor) {
+                for (const auto& attempt : attempts) {
+                    executor->cancel(attempt);
+                }
+            }
+            read->promise.emplaceValue(cbData);
+        },
+        baton);
+
+    stdx::lock_guard<Latch> lk(read->mutex);
+    if (!swCallbackHandle.isOK()) {
+        --read->outstanding;
+        return swCallbackHandle.getStatus();
+    }
+    read->attempts.push_back(swCallbackHandle.getValue());
+    return Status::OK();
+}
+
 }  // namespace
 
 AsyncRequestsSender::AsyncRequestsSender(OperationContext* opCtx,
@@ -68,6 +224,7 @@ AsyncRequestsSender::AsyncRequestsSender(OperationContext* opCtx,
       _db(dbName.toString()),
       _readPreference(readPreference),
       _retryPolicy(retryPolicy),
+      _executor(executor),
       _subExecutor(std::move(executor)),
       _subBaton(opCtx->getBaton()->makeSubBaton()) {
 
@@ -88,6 +245,8 @@ AsyncRequestsSender::Response AsyncRequestsSender::next() noexcept {
 
     _remotesLeft--;
 
+    ScopedWaitEvent waitEvent(_opCtx, WaitEvent::kNetwork);
+
     // If we've been interrupted, the response queue should be filled with interrupted answers, go
     // ahead and return one of those
     if (!_interruptStatus.isOK()) {
@@ -134,7 +293,10 @@ AsyncRequestsSender::Request::Request(ShardId shardId, BSONObj cmdObj)
 AsyncRequestsSender::RemoteData::RemoteData(AsyncRequestsSender* ars,
                                             ShardId shardId,
                                             BSONObj cmdObj)
-    : _ars(ars), _shardId(std::move(shardId)), _cmdObj(std::move(cmdObj)) {}
+    : _ars(ars),
+      _shardId(std::move(shardId)),
+      _cmdObj(std::move(cmdObj)),
+      _hedgeable(isHedgeable(ars->_readPreference, _cmdObj)) {}
 
 std::shared_ptr<Shard> AsyncRequestsSender::RemoteData::getShard() {
     // TODO: Pass down an OperationContext* to use here.
@@ -181,6 +343,10 @@ SemiFuture<std::vector<HostAndPort>> AsyncRequestsSender::RemoteData::resolveSha
 
 auto AsyncRequestsSender::RemoteData::scheduleRemoteCommand(std::vector<HostAndPort>&& hostAndPorts)
     -> SemiFuture<RemoteCommandOnAnyCallbackArgs> {
+    if (_hedgeable && hostAndPorts.size() > 1 && gEnableHedgedReads.load()) {
+        return scheduleHedgedRemoteCommand(std::move(hostAndPorts));
+    }
+
     executor::RemoteCommandRequestOnAny request(
         std::move(hostAndPorts), _ars->_db, _cmdObj, _ars->_metadataObj, _ars->_opCtx);
 
@@ -188,18 +354,105 @@ auto AsyncRequestsSender::RemoteData::scheduleRemoteCommand(std::vector<HostAndP
     // future returning variant of scheduleRemoteCommand
     auto [p, f] = makePromiseFuture<RemoteCommandOnAnyCallbackArgs>();
 
+    // The response times of reads are recorded even while hedging is off, so that the hedging
+    // delay is known up front once it is turned on.
+    auto metrics = _hedgeable ? HedgingMetrics::get(_ars->_opCtx) : nullptr;
+
     // Failures to schedule skip the retry loop
     uassertStatusOK(_ars->_subExecutor->scheduleRemoteCommandOnAny(
         request,
         // We have to make a shared_ptr<Promise> here because scheduleRemoteCommand requires
         // copyable callbacks
-        [p = std::make_shared<Promise<RemoteCommandOnAnyCallbackArgs>>(std::move(p))](
-            const RemoteCommandOnAnyCallbackArgs& cbData) { p->emplaceValue(cbData); },
+        [p = std::make_shared<Promise<RemoteCommandOnAnyCallbackArgs>>(std::move(p)),
+         metrics,
+         shardId = _shardId,
+         timer = Timer()](const RemoteCommandOnAnyCallbackArgs& cbData) {
+            if (metrics && cbData.response.isOK()) {
+                metrics->recordResponseTime(shardId, Microseconds(timer.micros()));
+            }
+            p->emplaceValue(cbData);
+        },
         *_ars->_subBaton));
 
     return std::move(f).semi();
 }
 
+auto AsyncRequestsSender::RemoteData::scheduleHedgedRemoteCommand(
+    std::vector<HostAndPort>&& hostAndPorts) -> SemiFuture<RemoteCommandOnAnyCallbackArgs> {
+    auto metrics = HedgingMetrics::get(_ars->_opCtx);
+    metrics->incrementNumTotalOperations();
+
+    auto [p, f] = makePromiseFuture<RemoteCommandOnAnyCallbackArgs>();
+    const auto cmdName = _cmdObj.firstElementFieldNameStringData();
+    auto read = std::make_shared<HedgedRead>(std::move(p),
+                                             cmdName == "find"_sd || cmdName == "aggregate"_sd);
+
+    // The attempts of a read which opens a cursor go through the unscoped executor and without the
+    // baton: either of them may turn out to be the slower one, whose callback still has to run to
+    // kill its cursor after the sender has shut down its scoped executor. The attempts of other
+    // reads stay scoped to the sender, as the slower one is canceled once the other has answered.
+    const auto attemptExecutor = read->opensCursor ? _ars->_executor : *_ars->_subExecutor;
+    const auto attemptBaton = read->opensCursor ? BatonHandle() : *_ars->_subBaton;
+
+    // Failures to schedule skip the retry loop
+    uassertStatusOK(sendHedgedAttempt(
+        attemptExecutor,
+        attemptBaton,
+        {{hostAndPorts[0]}, _ars->_db, _cmdObj, _ars->_metadataObj, _ars->_opCtx},
+        read,
+        metrics,
+        _shardId,
+        false));
+
+    // The hedge is sent from the baton, which neither runs it once the ARS has been shut down nor
+    // while the operation context is gone.
+    auto [timerPromise, timerFuture] = makePromiseFuture<void>();
+    _ars->_subExecutor
+        ->scheduleWorkAt(
+            _ars->_subExecutor->now() + metrics->getHedgingDelay(_shardId),
+            [timerPromise = std::make_shared<Promise<void>>(std::move(timerPromise))](
+                const executor::TaskExecutor::CallbackArgs& args) {
+                if (args.status.isOK()) {
+                    timerPromise->emplaceValue();
+                } else {
+                    timerPromise->setError(args.status);
+                }
+            })
+        .getStatus()
+        .ignore();
+
+    std::move(timerFuture)
+        .thenRunOn(*_ars->_subBaton)
+        .getAsync([this,
+                   read,
+                   metrics,
+                   attemptExecutor,
+                   attemptBaton,
+                   hedgeHost = hostAndPorts[1]](Status status) {
+            if (!status.isOK()) {
+                return;
+            }
+            {
+                stdx::lock_guard<Latch> lk(read->mutex);
+                if (read->done) {
+                    return;
+                }
+            }
+
+            metrics->incrementNumTotalHedgedOperations();
+            sendHedgedAttempt(attemptExecutor,
+                              attemptBaton,
+                              {{hedgeHost}, _ars->_db, _cmdObj, _ars->_metadataObj, _ars->_opCtx},
+                              read,
+                              metrics,
+                              _shardId,
+                              true)
+                .ignore();
+        });
+
+    return std::move(f).semi();
+}
+
 
 auto AsyncRequestsSender::RemoteData::handleResponse(RemoteCommandOnAnyCallbackArgs&& rcr)
     -> SemiFuture<RemoteCommandOnAnyCallbackArgs> {
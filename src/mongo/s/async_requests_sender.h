@@ -52,6 +52,10 @@ namespace mongo {
  * The AsyncRequestsSender allows for sending requests to a set of remote shards in parallel.
  * Work on remote nodes is accomplished by scheduling remote work in a TaskExecutor's event loop.
  *
+ * If hedged reads are enabled, a read which does not have to run on the primary is also sent to a
+ * second eligible host of its shard once the first one has been slow to answer, and whichever
+ * host answers first provides the response.
+ *
  * Typical usage is:
  *
  * // Add some requests
@@ -227,6 +231,13 @@ private:
         SemiFuture<RemoteCommandOnAnyCallbackArgs> scheduleRemoteCommand(
             std::vector<HostAndPort>&& hostAndPort);
 
+        /**
+         * Sends the remote command to the first of 'hostAndPorts', and also to the second one if
+         * the first has not answered within the hedging delay of the shard.
+         */
+        SemiFuture<RemoteCommandOnAnyCallbackArgs> scheduleHedgedRemoteCommand(
+            std::vector<HostAndPort>&& hostAndPorts);
+
         /**
          * Handles the remote response
          */
@@ -244,6 +255,9 @@ private:
         // The command object to send to the remote host.
         BSONObj _cmdObj;
 
+        // Whether the command only reads, so that it may be sent to more than one host at a time.
+        bool _hedgeable;
+
         // The exact host on which the remote command was run. Is unset until a request has been
         // sent.
         boost::optional<HostAndPort> _shardHostAndPort;
@@ -270,6 +284,10 @@ private:
     // Data tracking the state of our communication with each of the remote nodes.
     std::vector<RemoteData> _remotes;
 
+    // The executor which kills the cursor opened by the slower attempt of a hedged read, since
+    // that attempt may only answer once the scoped executor below has been shut down.
+    std::shared_ptr<executor::TaskExecutor> _executor;
+
     // Number of remotes we haven't returned final results from.
     size_t _remotesLeft;
 
@@ -0,0 +1,265 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/async_requests_sender.h"
+
+#include "mongo/client/remote_command_targeter_factory_mock.h"
+#include "mongo/client/remote_command_targeter_mock.h"
+#include "mongo/db/cursor_id.h"
+#include "mongo/executor/network_interface_mock.h"
+#include "mongo/s/catalog/type_shard.h"
+#include "mongo/s/hedging_metrics.h"
+#include "mongo/s/hedging_server_parameters_gen.h"
+#include "mongo/s/sharding_router_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using executor::NetworkInterfaceMock;
+using executor::RemoteCommandResponse;
+using InNetworkGuard = NetworkInterfaceMock::InNetworkGuard;
+
+const HostAndPort kTestConfigShardHost = HostAndPort("FakeConfigHost", 12345);
+const ShardId kTestShardId("FakeShard");
+const std::vector<HostAndPort> kTestShardHosts = {HostAndPort("FakeShardHost1", 12345),
+                                                  HostAndPort("FakeShardHost2", 12345)};
+const NamespaceString kTestNss("testdb.testcoll");
+const Milliseconds kHedgingDelay(10);
+
+class AsyncRequestsSenderHedgingTest : public ShardingTestFixture {
+public:
+    void setUp() override {
+        ShardingTestFixture::setUp();
+
+        _enableHedgedReads = gEnableHedgedReads.load();
+        _hedgedReadsDelayMillis = gHedgedReadsDelayMillis.load();
+        _hedgedReadsDelayPercentile = gHedgedReadsDelayPercentile.load();
+        gEnableHedgedReads.store(true);
+        gHedgedReadsDelayMillis.store(durationCount<Milliseconds>(kHedgingDelay));
+        gHedgedReadsDelayPercentile.store(0);
+
+        configTargeter()->setFindHostReturnValue(kTestConfigShardHost);
+
+        const ConnectionString connStr(kTestShardHosts[0]);
+        auto targeter = std::make_unique<RemoteCommandTargeterMock>();
+        targeter->setConnectionStringReturnValue(connStr);
+        targeter->setFindHostsReturnValue(kTestShardHosts);
+        targeterFactory()->addTargeterToReturn(connStr, std::move(targeter));
+
+        ShardType shardType;
+        shardType.setName(kTestShardId.toString());
+        shardType.setHost(connStr.toString());
+        setupShards({shardType});
+    }
+
+    void tearDown() override {
+        gEnableHedgedReads.store(_enableHedgedReads);
+        gHedgedReadsDelayMillis.store(_hedgedReadsDelayMillis);
+        gHedgedReadsDelayPercentile.store(_hedgedReadsDelayPercentile);
+
+        ShardingTestFixture::tearDown();
+    }
+
+protected:
+    /**
+     * Sends a count to the test shard, which may run on either of its hosts, and returns the
+     * response.
+     */
+    AsyncRequestsSender::Response runCount() {
+        AsyncRequestsSender ars(operationContext(),
+                                executor(),
+                                kTestNss.db(),
+                                {AsyncRequestsSender::Request(kTestShardId,
+                                                              BSON("count" << kTestNss.coll()))},
+                                ReadPreferenceSetting(ReadPreference::Nearest),
+                                Shard::RetryPolicy::kNoRetry);
+        return ars.next();
+    }
+
+    /**
+     * Sends a find to the test shard, which may run on either of its hosts, and returns the
+     * response. The sender is gone by the time this returns.
+     */
+    AsyncRequestsSender::Response runFind() {
+        AsyncRequestsSender ars(operationContext(),
+                                executor(),
+                                kTestNss.db(),
+                                {AsyncRequestsSender::Request(kTestShardId,
+                                                              BSON("find" << kTestNss.coll()))},
+                                ReadPreferenceSetting(ReadPreference::Nearest),
+                                Shard::RetryPolicy::kNoRetry);
+        return ars.next();
+    }
+
+    static BSONObj makeCursorResponse(CursorId cursorId) {
+        return BSON("cursor" << BSON("id" << cursorId << "ns" << kTestNss.ns() << "firstBatch"
+                                          << BSONArray())
+                             << "ok" << 1);
+    }
+
+    BSONObj getHedgingStats() {
+        BSONObjBuilder builder;
+        HedgingMetrics::get(getServiceContext())->appendStats(&builder);
+        return builder.obj();
+    }
+
+private:
+    bool _enableHedgedReads;
+    int _hedgedReadsDelayMillis;
+    double _hedgedReadsDelayPercentile;
+};
+
+TEST_F(AsyncRequestsSenderHedgingTest, NoHedgeIsSentWhenTheFirstHostAnswersWithinTheDelay) {
+    auto future = launchAsync([&] {
+        InNetworkGuard guard(network());
+        auto first = network()->getNextReadyRequest();
+        ASSERT_EQ(kTestShardHosts[0], first->getRequest().target);
+        network()->scheduleSuccessfulResponse(
+            first, RemoteCommandResponse(BSON("ok" << 1 << "n" << 5), Milliseconds(1)));
+        network()->runReadyNetworkOperations();
+    });
+
+    const auto response = runCount();
+    future.default_timed_get();
+
+    ASSERT_OK(response.swResponse.getStatus());
+    ASSERT_EQ(kTestShardHosts[0], *response.shardHostAndPort);
+    ASSERT_EQ(5, response.swResponse.getValue().data["n"].numberInt());
+
+    const auto stats = getHedgingStats();
+    ASSERT_EQ(1, stats["numTotalOperations"].numberLong());
+    ASSERT_EQ(0, stats["numTotalHedgedOperations"].numberLong());
+}
+
+TEST_F(AsyncRequestsSenderHedgingTest, FirstResponseWinsAndTheOtherAttemptIsCanceled) {
+    auto future = launchAsync([&] {
+        InNetworkGuard guard(network());
+        auto first = network()->getNextReadyRequest();
+        ASSERT_EQ(kTestShardHosts[0], first->getRequest().target);
+        network()->blackHole(first);
+
+        network()->advanceTime(network()->now() + kHedgingDelay);
+        auto hedge = network()->getNextReadyRequest();
+        ASSERT_EQ(kTestShardHosts[1], hedge->getRequest().target);
+        ASSERT_EQ("count"_sd, hedge->getRequest().cmdObj.firstElementFieldNameStringData());
+        network()->scheduleSuccessfulResponse(
+            hedge, RemoteCommandResponse(BSON("ok" << 1 << "n" << 7), Milliseconds(1)));
+        network()->runReadyNetworkOperations();
+    });
+
+    const auto response = runCount();
+    future.default_timed_get();
+
+    ASSERT_OK(response.swResponse.getStatus());
+    ASSERT_EQ(kTestShardHosts[1], *response.shardHostAndPort);
+    ASSERT_EQ(7, response.swResponse.getValue().data["n"].numberInt());
+
+    // The count which the first host never answered was canceled once the hedge answered, which
+    // takes it off the black hole of the mock network.
+    ASSERT_STRING_CONTAINS(network()->getDiagnosticString(), "blackHoled: 0");
+
+    const auto stats = getHedgingStats();
+    ASSERT_EQ(1, stats["numTotalHedgedOperations"].numberLong());
+    ASSERT_EQ(1, stats["numAdvantageouslyHedgedOperations"].numberLong());
+}
+
+TEST_F(AsyncRequestsSenderHedgingTest, AnErrorFromOneHostFallsBackToTheOther) {
+    auto future = launchAsync([&] {
+        InNetworkGuard guard(network());
+        auto first = network()->getNextReadyRequest();
+        ASSERT_EQ(kTestShardHosts[0], first->getRequest().target);
+
+        network()->advanceTime(network()->now() + kHedgingDelay);
+        auto hedge = network()->getNextReadyRequest();
+        ASSERT_EQ(kTestShardHosts[1], hedge->getRequest().target);
+
+        network()->scheduleErrorResponse(first,
+                                         Status(ErrorCodes::HostUnreachable, "host unreachable"));
+        network()->runReadyNetworkOperations();
+        network()->scheduleSuccessfulResponse(
+            hedge, RemoteCommandResponse(BSON("ok" << 1 << "n" << 3), Milliseconds(1)));
+        network()->runReadyNetworkOperations();
+    });
+
+    const auto response = runCount();
+    future.default_timed_get();
+
+    ASSERT_OK(response.swResponse.getStatus());
+    ASSERT_EQ(kTestShardHosts[1], *response.shardHostAndPort);
+    ASSERT_EQ(3, response.swResponse.getValue().data["n"].numberInt());
+}
+
+TEST_F(AsyncRequestsSenderHedgingTest, CursorOfTheSlowerAttemptIsKilledAfterTheSenderIsGone) {
+    const CursorId kSlowerCursorId = 123;
+    NetworkInterfaceMock::NetworkOperationIterator first;
+    auto future = launchAsync([&] {
+        InNetworkGuard guard(network());
+        first = network()->getNextReadyRequest();
+        ASSERT_EQ(kTestShardHosts[0], first->getRequest().target);
+
+        network()->advanceTime(network()->now() + kHedgingDelay);
+        auto hedge = network()->getNextReadyRequest();
+        ASSERT_EQ(kTestShardHosts[1], hedge->getRequest().target);
+        network()->scheduleSuccessfulResponse(
+            hedge, RemoteCommandResponse(makeCursorResponse(0), Milliseconds(1)));
+        network()->runReadyNetworkOperations();
+    });
+
+    const auto response = runFind();
+    future.default_timed_get();
+
+    ASSERT_OK(response.swResponse.getStatus());
+    ASSERT_EQ(kTestShardHosts[1], *response.shardHostAndPort);
+
+    // The first host answers only after the sender has shut down its scoped executor, and the
+    // cursor it opened is still killed.
+    InNetworkGuard guard(network());
+    network()->scheduleSuccessfulResponse(
+        first, RemoteCommandResponse(makeCursorResponse(kSlowerCursorId), Milliseconds(1)));
+    network()->runReadyNetworkOperations();
+
+    ASSERT_TRUE(network()->hasReadyRequests());
+    auto killCursors = network()->getNextReadyRequest();
+    const auto& request = killCursors->getRequest();
+    ASSERT_EQ(kTestShardHosts[0], request.target);
+    ASSERT_EQ(kTestNss.db().toString(), request.dbname);
+    ASSERT_BSONOBJ_EQ(BSON("killCursors" << kTestNss.coll() << "cursors"
+                                         << BSON_ARRAY(kSlowerCursorId)),
+                      request.cmdObj);
+    network()->scheduleSuccessfulResponse(
+        killCursors, RemoteCommandResponse(BSON("ok" << 1), Milliseconds(1)));
+    network()->runReadyNetworkOperations();
+}
+
+}  // namespace
+}  // namespace mongo
@@ -73,7 +73,9 @@ std::shared_ptr<RoutingTableHistory> refreshCollectionRoutingInfo(
     OperationContext* opCtx,
     const NamespaceString& nss,
     std::shared_ptr<RoutingTableHistory> existingRoutingInfo,
-    StatusWith<CatalogCacheLoader::CollectionAndChangedChunks> swCollectionAndChangedChunks) {
+    StatusWith<CatalogCacheLoader::CollectionAndChangedChunks> swCollectionAndChangedChunks,
+    AtomicWord<long long>* incrementalUpdateTimeMicros,
+    AtomicWord<long long>* fullBuildTimeMicros) {
     if (swCollectionAndChangedChunks == ErrorCodes::NamespaceNotFound) {
         return nullptr;
     }
@@ -81,13 +83,16 @@ std::shared_ptr<RoutingTableHistory> refreshCollectionRoutingInfo(
     const auto collectionAndChunks = uassertStatusOK(std::move(swCollectionAndChangedChunks));
 
     auto chunkManager = [&] {
+        Timer t;
+
         // If we have routing info already and it's for the same collection epoch, we're updating.
         // Otherwise, we're making a whole new routing table.
         if (existingRoutingInfo &&
             existingRoutingInfo->getVersion().epoch() == collectionAndChunks.epoch) {
-
+            ON_BLOCK_EXIT([&] { incrementalUpdateTimeMicros->addAndFetch(t.micros()); });
             return existingRoutingInfo->makeUpdated(collectionAndChunks.changedChunks);
         }
+        ON_BLOCK_EXIT([&] { fullBuildTimeMicros->addAndFetch(t.micros()); });
         auto defaultCollator = [&]() -> std::unique_ptr<CollatorInterface> {
             if (!collectionAndChunks.defaultCollation.isEmpty()) {
                 // The collation should have been validated upon collection creation
@@ -653,7 +658,12 @@ void CatalogCache::_scheduleCollectionRefresh(WithLock lk,
         std::shared_ptr<RoutingTableHistory> newRoutingInfo;
         try {
             newRoutingInfo = refreshCollectionRoutingInfo(
-                opCtx, nss, std::move(existingRoutingInfo), std::move(swCollAndChunks));
+                opCtx,
+                nss,
+                std::move(existingRoutingInfo),
+                std::move(swCollAndChunks),
+                &_stats.totalIncrementalRoutingTableUpdateTimeMicros,
+                &_stats.totalFullRoutingTableBuildTimeMicros);
 
             onRefreshCompleted(Status::OK(), newRoutingInfo.get());
         } catch (const DBException& ex) {
@@ -717,6 +727,11 @@ void CatalogCache::Stats::report(BSONObjBuilder* builder) const {
     builder->append("countFullRefreshesStarted", countFullRefreshesStarted.load());
 
     builder->append("countFailedRefreshes", countFailedRefreshes.load());
+
+    builder->append("totalIncrementalRoutingTableUpdateTimeMicros",
+                    totalIncrementalRoutingTableUpdateTimeMicros.load());
+    builder->append("totalFullRoutingTableBuildTimeMicros",
+                    totalFullRoutingTableBuildTimeMicros.load());
 }
 
 CachedDatabaseInfo::CachedDatabaseInfo(DatabaseType dbt, std::shared_ptr<Shard> primaryShard)
@@ -382,6 +382,11 @@ private:
         // for whatever reason
         AtomicWord<long long> countFailedRefreshes{0};
 
+        // Cumulative, always-increasing counter of how much time refreshes spent applying the
+        // changed chunks to the existing routing tables, and building new routing tables
+        AtomicWord<long long> totalIncrementalRoutingTableUpdateTimeMicros{0};
+        AtomicWord<long long> totalFullRoutingTableBuildTimeMicros{0};
+
         /**
          * Reports the accumulated statistics for serverStatus.
          */
@@ -0,0 +1,227 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/chunk_info_map.h"
+
+#include <algorithm>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Returns the first eight bytes of 'key' as a big-endian integer, padded with zeros. Prefixes
+ * compare in the same order as the keys they come from, except that different keys may have the
+ * same prefix.
+ */
+uint64_t extractKeyPrefix(const std::string& key) {
+    uint64_t prefix = 0;
+    const size_t prefixSize = std::min(key.size(), sizeof(prefix));
+    for (size_t i = 0; i < prefixSize; ++i) {
+        prefix |= uint64_t(static_cast<unsigned char>(key[i])) << (8 * (7 - i));
+    }
+    return prefix;
+}
+
+}  // namespace
+
+struct ChunkInfoMap::Block {
+    /**
+     * Returns the position of the first entry whose key is greater than 'key' (or not less than it
+     * if 'orEqual' is set), or the number of entries if there is none.
+     */
+    size_t find(const std::string& key, uint64_t keyPrefix, bool orEqual) const {
+        // Every entry before 'samePrefix' has a key less than 'key' and every entry after it has a
+        // key greater than it.
+        const auto samePrefix =
+            std::equal_range(maxKeyPrefixes.begin(), maxKeyPrefixes.end(), keyPrefix);
+        const auto first = entries.begin() + (samePrefix.first - maxKeyPrefixes.begin());
+        const auto last = entries.begin() + (samePrefix.second - maxKeyPrefixes.begin());
+
+        if (orEqual) {
+            return std::lower_bound(first,
+                                    last,
+                                    key,
+                                    [](const value_type& entry, const std::string& key) {
+                                        return entry.first < key;
+                                    }) -
+                entries.begin();
+        }
+        return std::upper_bound(first,
+                                last,
+                                key,
+                                [](const std::string& key, const value_type& entry) {
+                                    return key < entry.first;
+                                }) -
+            entries.begin();
+    }
+
+    std::vector<uint64_t> maxKeyPrefixes;
+    std::vector<value_type> entries;
+};
+
+ChunkInfoMap::const_iterator::reference ChunkInfoMap::const_iterator::operator*() const {
+    return _map->_blocks[_block]->entries[_pos];
+}
+
+ChunkInfoMap::const_iterator& ChunkInfoMap::const_iterator::operator++() {
+    if (++_pos == _map->_blocks[_block]->entries.size()) {
+        ++_block;
+        _pos = 0;
+    }
+    return *this;
+}
+
+ChunkInfoMap::const_iterator& ChunkInfoMap::const_iterator::operator--() {
+    if (_pos == 0) {
+        --_block;
+        _pos = _map->_blocks[_block]->entries.size();
+    }
+    --_pos;
+    return *this;
+}
+
+ChunkInfoMap::const_iterator ChunkInfoMap::upper_bound(const std::string& key) const {
+    const auto blockIndex = _findBlock(key, false);
+    if (blockIndex == _blocks.size()) {
+        return end();
+    }
+    return const_iterator(
+        this, blockIndex, _blocks[blockIndex]->find(key, extractKeyPrefix(key), false));
+}
+
+ChunkInfoMap::const_iterator ChunkInfoMap::lower_bound(const std::string& key) const {
+    const auto blockIndex = _findBlock(key, true);
+    if (blockIndex == _blocks.size()) {
+        return end();
+    }
+    return const_iterator(
+        this, blockIndex, _blocks[blockIndex]->find(key, extractKeyPrefix(key), true));
+}
+
+const std::shared_ptr<ChunkInfo>& ChunkInfoMap::at(const std::string& key) const {
+    const auto it = lower_bound(key);
+    invariant(it != end() && it->first == key);
+    return it->second;
+}
+
+void ChunkInfoMap::erase(const_iterator first, const_iterator last) {
+    invariant(first._map == this && last._map == this);
+    if (first == last) {
+        return;
+    }
+
+    // Erase from the last block of the range backwards, so that removing blocks does not move the
+    // ones still to be visited.
+    const size_t endBlock = last._pos == 0 ? last._block : last._block + 1;
+    for (size_t blockIndex = endBlock; blockIndex-- > first._block;) {
+        const auto& entries = _blocks[blockIndex]->entries;
+        const size_t begin = blockIndex == first._block ? first._pos : 0;
+        const size_t end = blockIndex == last._block ? last._pos : entries.size();
+        const size_t numErased = end - begin;
+
+        if (numErased == entries.size()) {
+            _blocks.erase(_blocks.begin() + blockIndex);
+        } else {
+            auto& block = _ownedBlock(blockIndex);
+            block.entries.erase(block.entries.begin() + begin, block.entries.begin() + end);
+            block.maxKeyPrefixes.erase(block.maxKeyPrefixes.begin() + begin,
+                                       block.maxKeyPrefixes.begin() + end);
+        }
+        _size -= numErased;
+    }
+}
+
+void ChunkInfoMap::insert(value_type entry) {
+    const auto keyPrefix = extractKeyPrefix(entry.first);
+
+    // Keys greater than every key in the map go at the end of the last block.
+    size_t blockIndex = 0;
+    if (_blocks.empty()) {
+        _blocks.push_back(std::make_shared<Block>());
+    } else {
+        blockIndex = std::min(_findBlock(entry.first, false), _blocks.size() - 1);
+    }
+    auto& block = _ownedBlock(blockIndex);
+
+    const auto pos = block.find(entry.first, keyPrefix, false);
+    invariant(pos == 0 || block.entries[pos - 1].first != entry.first);
+    block.entries.insert(block.entries.begin() + pos, std::move(entry));
+    block.maxKeyPrefixes.insert(block.maxKeyPrefixes.begin() + pos, keyPrefix);
+    ++_size;
+
+    if (block.entries.size() > kMaxBlockSize) {
+        // Split the block in two halves.
+        auto newBlock = std::make_shared<Block>();
+        const size_t half = block.entries.size() / 2;
+        newBlock->entries.assign(std::make_move_iterator(block.entries.begin() + half),
+                                 std::make_move_iterator(block.entries.end()));
+        newBlock->maxKeyPrefixes.assign(block.maxKeyPrefixes.begin() + half,
+                                        block.maxKeyPrefixes.end());
+        block.entries.resize(half);
+        block.maxKeyPrefixes.resize(half);
+        _blocks.insert(_blocks.begin() + blockIndex + 1, std::move(newBlock));
+    }
+}
+
+size_t ChunkInfoMap::_findBlock(const std::string& key, bool orEqual) const {
+    const auto keyPrefix = extractKeyPrefix(key);
+    const auto isInBlock = [&](const std::shared_ptr<Block>& block) {
+        const auto lastPrefix = block->maxKeyPrefixes.back();
+        if (keyPrefix != lastPrefix) {
+            return keyPrefix < lastPrefix;
+        }
+        const auto& lastKey = block->entries.back().first;
+        return orEqual ? key <= lastKey : key < lastKey;
+    };
+
+    // The blocks are sorted, so the ones the key is not in all come first.
+    return std::partition_point(_blocks.begin(),
+                                _blocks.end(),
+                                [&](const std::shared_ptr<Block>& block) {
+                                    return !isInBlock(block);
+                                }) -
+        _blocks.begin();
+}
+
+ChunkInfoMap::Block& ChunkInfoMap::_ownedBlock(size_t blockIndex) {
+    auto& block = _blocks[blockIndex];
+    // No other map can be sharing the block if this map holds the only reference to it. Nobody
+    // else can take a new reference concurrently either, since those would come from this map.
+    if (block.use_count() > 1) {
+        block = std::make_shared<Block>(*block);
+    }
+    return *block;
+}
+
+}  // namespace mongo
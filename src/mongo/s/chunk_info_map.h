@@ -0,0 +1,171 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/s/chunk.h"
+
+namespace mongo {
+
+/**
+ * Ordered map from the KeyString of the max of each chunk to an entry describing the chunk, with
+ * the interface of the subset of std::map used by the routing table.
+ *
+ * The entries are stored in sorted blocks of at most kMaxBlockSize entries. Copies of a map share
+ * its blocks, and a map only copies a shared block when it is about to modify it, so a routing
+ * table updated with a few changed chunks only copies the blocks those chunks fall in rather than
+ * every entry of the previous table.
+ *
+ * Next to its entries, each block keeps the first bytes of each key as a big-endian integer, so
+ * that looking up a key binary searches contiguous integers and only compares the full keys of the
+ * entries whose prefix ties with that of the key.
+ *
+ * Not thread safe, but maps that share blocks may be used concurrently, since shared blocks are
+ * never modified.
+ */
+class ChunkInfoMap {
+    struct Block;
+
+public:
+    using value_type = std::pair<std::string, std::shared_ptr<ChunkInfo>>;
+
+    static constexpr size_t kMaxBlockSize = 256;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = ChunkInfoMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() = default;
+
+        reference operator*() const;
+        pointer operator->() const {
+            return &**this;
+        }
+
+        const_iterator& operator++();
+        const_iterator operator++(int) {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+        const_iterator& operator--();
+        const_iterator operator--(int) {
+            auto result = *this;
+            --*this;
+            return result;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return _map == other._map && _block == other._block && _pos == other._pos;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        friend class ChunkInfoMap;
+
+        const_iterator(const ChunkInfoMap* map, size_t block, size_t pos)
+            : _map(map), _block(block), _pos(pos) {}
+
+        const ChunkInfoMap* _map{nullptr};
+        size_t _block{0};
+        size_t _pos{0};
+    };
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this, 0, 0);
+    }
+    const_iterator end() const {
+        return const_iterator(this, _blocks.size(), 0);
+    }
+    const_iterator cbegin() const {
+        return begin();
+    }
+    const_iterator cend() const {
+        return end();
+    }
+
+    /**
+     * Same as the std::map methods of the same name.
+     */
+    const_iterator upper_bound(const std::string& key) const;
+    const_iterator lower_bound(const std::string& key) const;
+
+    /**
+     * Returns the chunk whose max is 'key', which must be in the map.
+     */
+    const std::shared_ptr<ChunkInfo>& at(const std::string& key) const;
+
+    /**
+     * Removes the entries in [first, last). Invalidates all iterators.
+     */
+    void erase(const_iterator first, const_iterator last);
+
+    /**
+     * Adds 'entry', whose key must not already be in the map. Invalidates all iterators.
+     */
+    void insert(value_type entry);
+
+private:
+    /**
+     * Returns the index of the first block whose last key is greater than 'key' (or not less than
+     * it if 'orEqual' is set), or the number of blocks if there is none.
+     */
+    size_t _findBlock(const std::string& key, bool orEqual) const;
+
+    /**
+     * Returns the block at 'blockIndex', copying it first if another map shares it.
+     */
+    Block& _ownedBlock(size_t blockIndex);
+
+    std::vector<std::shared_ptr<Block>> _blocks;
+    size_t _size{0};
+};
+
+}  // namespace mongo
@@ -0,0 +1,210 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/chunk_info_map.h"
+
+#include <map>
+
+#include "mongo/platform/random.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+std::string makeKey(int i) {
+    // A common prefix longer than the eight bytes kept for each key, so that lookups must also
+    // compare the full keys.
+    return str::stream() << "common-prefix-" << (100 * 1000 * 1000 + i);
+}
+
+void assertSameKeys(const std::map<std::string, int>& expected, const ChunkInfoMap& map) {
+    ASSERT_EQ(expected.size(), map.size());
+    ASSERT_EQ(expected.empty(), map.empty());
+
+    auto it = map.begin();
+    for (const auto& entry : expected) {
+        ASSERT(it != map.end());
+        ASSERT_EQ(entry.first, it->first);
+        ++it;
+    }
+    ASSERT(it == map.end());
+}
+
+void assertSameBounds(const std::map<std::string, int>& expected,
+                      const ChunkInfoMap& map,
+                      const std::string& key) {
+    const auto expectedUpper = expected.upper_bound(key);
+    const auto upper = map.upper_bound(key);
+    ASSERT_EQ(std::distance(expected.begin(), expectedUpper), std::distance(map.begin(), upper));
+
+    const auto expectedLower = expected.lower_bound(key);
+    const auto lower = map.lower_bound(key);
+    ASSERT_EQ(std::distance(expected.begin(), expectedLower), std::distance(map.begin(), lower));
+}
+
+TEST(ChunkInfoMapTest, EmptyMap) {
+    ChunkInfoMap map;
+    ASSERT(map.empty());
+    ASSERT_EQ(0U, map.size());
+    ASSERT(map.begin() == map.end());
+    ASSERT(map.upper_bound(makeKey(0)) == map.end());
+    ASSERT(map.lower_bound(makeKey(0)) == map.end());
+}
+
+TEST(ChunkInfoMapTest, InsertKeepsKeysSortedAcrossBlocks) {
+    std::map<std::string, int> expected;
+    ChunkInfoMap map;
+
+    // Insert in an order that is neither ascending nor descending, into enough blocks.
+    const int numKeys = 4 * ChunkInfoMap::kMaxBlockSize;
+    for (int i = 0; i < numKeys; ++i) {
+        const auto key = makeKey((i * 7919) % numKeys);
+        expected.emplace(key, i);
+        map.insert({key, nullptr});
+    }
+
+    assertSameKeys(expected, map);
+    for (int i = -1; i <= numKeys; ++i) {
+        assertSameBounds(expected, map, makeKey(i));
+    }
+    assertSameBounds(expected, map, "");
+    assertSameBounds(expected, map, "common-prefix-");
+    assertSameBounds(expected, map, "z");
+}
+
+TEST(ChunkInfoMapTest, IteratorsMoveBothWays) {
+    ChunkInfoMap map;
+    const int numKeys = 2 * ChunkInfoMap::kMaxBlockSize + 1;
+    for (int i = 0; i < numKeys; ++i) {
+        map.insert({makeKey(i), nullptr});
+    }
+
+    auto it = map.end();
+    for (int i = numKeys - 1; i >= 0; --i) {
+        --it;
+        ASSERT_EQ(makeKey(i), it->first);
+    }
+    ASSERT(it == map.begin());
+}
+
+TEST(ChunkInfoMapTest, EraseRangesWithinAndAcrossBlocks) {
+    std::map<std::string, int> expected;
+    ChunkInfoMap map;
+    const int numKeys = 5 * ChunkInfoMap::kMaxBlockSize;
+    for (int i = 0; i < numKeys; ++i) {
+        expected.emplace(makeKey(i), i);
+        map.insert({makeKey(i), nullptr});
+    }
+
+    auto eraseRange = [&](int first, int last) {
+        expected.erase(expected.lower_bound(makeKey(first)), expected.lower_bound(makeKey(last)));
+        map.erase(map.lower_bound(makeKey(first)), map.lower_bound(makeKey(last)));
+        assertSameKeys(expected, map);
+    };
+
+    eraseRange(10, 12);
+    eraseRange(100, 100);
+    eraseRange(200, 3 * ChunkInfoMap::kMaxBlockSize);
+    eraseRange(0, 5);
+    eraseRange(numKeys - 5, numKeys);
+    eraseRange(0, numKeys);
+    ASSERT(map.empty());
+}
+
+TEST(ChunkInfoMapTest, CopiesDoNotSeeEachOthersChanges) {
+    ChunkInfoMap original;
+    const int numKeys = 3 * ChunkInfoMap::kMaxBlockSize;
+    for (int i = 0; i < numKeys; i += 2) {
+        original.insert({makeKey(i), nullptr});
+    }
+
+    std::map<std::string, int> expectedOriginal;
+    for (const auto& entry : original) {
+        expectedOriginal.emplace(entry.first, 0);
+    }
+
+    std::map<std::string, int> expectedCopy = expectedOriginal;
+    ChunkInfoMap copy = original;
+
+    copy.insert({makeKey(1), nullptr});
+    expectedCopy.emplace(makeKey(1), 0);
+    copy.erase(copy.lower_bound(makeKey(100)), copy.lower_bound(makeKey(110)));
+    expectedCopy.erase(expectedCopy.lower_bound(makeKey(100)),
+                       expectedCopy.lower_bound(makeKey(110)));
+
+    assertSameKeys(expectedOriginal, original);
+    assertSameKeys(expectedCopy, copy);
+
+    original.insert({makeKey(numKeys + 1), nullptr});
+    expectedOriginal.emplace(makeKey(numKeys + 1), 0);
+
+    assertSameKeys(expectedOriginal, original);
+    assertSameKeys(expectedCopy, copy);
+}
+
+TEST(ChunkInfoMapTest, RandomSplitsAndMergesMatchStdMap) {
+    PseudoRandom random(12345);
+    std::map<std::string, int> expected;
+    ChunkInfoMap map;
+    std::vector<std::pair<std::map<std::string, int>, ChunkInfoMap>> snapshots;
+
+    const int keySpace = 10 * ChunkInfoMap::kMaxBlockSize;
+    for (int round = 0; round < 5000; ++round) {
+        const int first = random.nextInt32(keySpace);
+        const int last = first + random.nextInt32(round % 50 == 0 ? 500 : 3);
+
+        // Replace the entries in [first, last] by a single one, as applying a changed chunk
+        // covering several existing ones does.
+        expected.erase(expected.lower_bound(makeKey(first)), expected.upper_bound(makeKey(last)));
+        map.erase(map.lower_bound(makeKey(first)), map.upper_bound(makeKey(last)));
+        expected.emplace(makeKey(last), round);
+        map.insert({makeKey(last), nullptr});
+
+        if (round % 500 == 0) {
+            snapshots.emplace_back(expected, map);
+        }
+    }
+
+    assertSameKeys(expected, map);
+    for (int i = 0; i < keySpace; i += 7) {
+        assertSameBounds(expected, map, makeKey(i));
+    }
+
+    // Copies taken along the way were not affected by the later changes.
+    for (const auto& snapshot : snapshots) {
+        assertSameKeys(snapshot.first, snapshot.second);
+    }
+}
+
+}  // namespace
+}  // namespace mongo
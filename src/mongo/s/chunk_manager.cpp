@@ -109,6 +109,43 @@ Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey, const BSONObj
     return Chunk(*(it->second), _clusterTime);
 }
 
+std::vector<ShardId> ChunkManager::getShardIdsForShardKeys(
+    const std::vector<BSONObj>& shardKeys) const {
+    std::vector<std::pair<std::string, size_t>> sortedKeys;
+    sortedKeys.reserve(shardKeys.size());
+    for (size_t i = 0; i < shardKeys.size(); ++i) {
+        sortedKeys.emplace_back(_rt->_extractKeyString(shardKeys[i]), i);
+    }
+    std::sort(sortedKeys.begin(), sortedKeys.end());
+
+    const auto& chunkMap = _rt->getChunkMap();
+    std::vector<ShardId> shardIds(shardKeys.size());
+    auto it = chunkMap.end();
+    for (const auto& [keyString, index] : sortedKeys) {
+        // Every key is at least the previous one, so it is past the min of the previous key's
+        // chunk, and it belongs to that chunk unless it reached its max. Otherwise try the next
+        // chunk before searching the whole map.
+        const bool inPreviousChunk = it != chunkMap.end() && keyString < it->first;
+        if (!inPreviousChunk) {
+            const bool inNextChunk =
+                it != chunkMap.end() && ++it != chunkMap.end() && keyString < it->first;
+            if (!inNextChunk) {
+                it = chunkMap.upper_bound(keyString);
+            }
+        }
+
+        const auto& shardKey = shardKeys[index];
+        uassert(ErrorCodes::ShardKeyNotFound,
+                str::stream() << "Cannot target single shard using key " << shardKey
+                              << " for namespace " << getns(),
+                it != chunkMap.end() && it->second->containsKey(shardKey));
+
+        shardIds[index] = it->second->getShardIdAt(_clusterTime);
+    }
+
+    return shardIds;
+}
+
 bool ChunkManager::keyBelongsToShard(const BSONObj& shardKey, const ShardId& shardId) const {
     if (shardKey.isEmpty())
         return false;
@@ -512,6 +549,9 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
     const std::vector<ChunkType>& changedChunks) {
 
     const auto startingCollectionVersion = getVersion();
+
+    // The copy shares the blocks of entries of the current map, and only the blocks the changed
+    // chunks fall in get copied below.
     auto chunkMap = _chunkMap;
 
     ChunkVersion collectionVersion = startingCollectionVersion;
@@ -560,6 +600,10 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
             auto bytesInReplacedChunk =
                 chunkBeingReplacedBySplit->getWritesTracker()->getBytesWritten();
             newChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
+            newChunk->getWritesTracker()->getShardKeySketch().inheritFrom(
+                chunkBeingReplacedBySplit->getWritesTracker()->getShardKeySketch(),
+                chunk.getMin(),
+                chunk.getMax());
         }
 
         // Erase all chunks from the map, which overlap the chunk we got from the persistent store
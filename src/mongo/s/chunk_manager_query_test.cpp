@@ -488,5 +488,91 @@ TEST_F(ChunkManagerQueryTest, SimpleCollationNumbersMultiShard) {
         {ShardId("0")});
 }
 
+TEST_F(ChunkManagerQueryTest, FindIntersectingChunkWithSharedKeyPrefixes) {
+    // The split points only differ after their first eight bytes, so finding the chunk for a key
+    // must compare the full keys.
+    const ShardKeyPattern shardKeyPattern(BSON("a" << 1));
+    auto chunkManager = makeChunkManager(kNss,
+                                         shardKeyPattern,
+                                         nullptr,
+                                         false,
+                                         {BSON("a"
+                                               << "prefix-b"),
+                                          BSON("a"
+                                               << "prefix-d"),
+                                          BSON("a"
+                                               << "prefix-f")});
+
+    auto shardFor = [&](StringData value) {
+        return chunkManager->findIntersectingChunkWithSimpleCollation(BSON("a" << value))
+            .getShardId();
+    };
+
+    ASSERT_EQ(ShardId("0"), shardFor("prefix-a"));
+    ASSERT_EQ(ShardId("1"), shardFor("prefix-b"));
+    ASSERT_EQ(ShardId("1"), shardFor("prefix-c"));
+    ASSERT_EQ(ShardId("2"), shardFor("prefix-d"));
+    ASSERT_EQ(ShardId("2"), shardFor("prefix-e"));
+    ASSERT_EQ(ShardId("3"), shardFor("prefix-f"));
+    ASSERT_EQ(ShardId("3"), shardFor("prefix-g"));
+    ASSERT_EQ(ShardId("0"), shardFor("p"));
+    ASSERT_EQ(ShardId("3"), shardFor("q"));
+
+    ASSERT(chunkManager->keyBelongsToShard(BSON("a"
+                                                << "prefix-c"),
+                                           ShardId("1")));
+    ASSERT_FALSE(chunkManager->keyBelongsToShard(BSON("a"
+                                                      << "prefix-d"),
+                                                 ShardId("1")));
+}
+
+TEST_F(ChunkManagerQueryTest, GetShardIdsForRangeWithSharedKeyPrefixes) {
+    runGetShardIdsForRangeTest(BSON("a" << 1),
+                               false,
+                               {BSON("a"
+                                     << "prefix-b"),
+                                BSON("a"
+                                     << "prefix-d"),
+                                BSON("a"
+                                     << "prefix-f")},
+                               BSON("a"
+                                    << "prefix-c"),
+                               BSON("a"
+                                    << "prefix-d"),
+                               {ShardId("1"), ShardId("2")});
+}
+
+TEST_F(ChunkManagerQueryTest, GetShardIdsForShardKeys) {
+    const ShardKeyPattern shardKeyPattern(BSON("a" << 1));
+    auto chunkManager = makeChunkManager(
+        kNss, shardKeyPattern, nullptr, false, {BSON("a" << 10), BSON("a" << 20), BSON("a" << 30)});
+
+    // The keys are neither sorted nor unique, and some of them skip over whole chunks.
+    const std::vector<BSONObj> shardKeys{BSON("a" << 25),
+                                         BSON("a" << MINKEY),
+                                         BSON("a" << 10),
+                                         BSON("a" << 35),
+                                         BSON("a" << 5),
+                                         BSON("a" << 25),
+                                         BSON("a" << MAXKEY),
+                                         BSON("a" << 9)};
+    const std::vector<ShardId> expectedShardIds{ShardId("2"),
+                                                ShardId("0"),
+                                                ShardId("1"),
+                                                ShardId("3"),
+                                                ShardId("0"),
+                                                ShardId("2"),
+                                                ShardId("3"),
+                                                ShardId("0")};
+
+    const auto shardIds = chunkManager->getShardIdsForShardKeys(shardKeys);
+    ASSERT_EQ(expectedShardIds.size(), shardIds.size());
+    for (size_t i = 0; i < shardKeys.size(); ++i) {
+        ASSERT_EQ(expectedShardIds[i], shardIds[i]) << shardKeys[i];
+        ASSERT_EQ(chunkManager->findIntersectingChunkWithSimpleCollation(shardKeys[i]).getShardId(),
+                  shardIds[i]);
+    }
+}
+
 }  // namespace
 }  // namespace mongo
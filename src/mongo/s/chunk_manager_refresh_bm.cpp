@@ -351,6 +351,24 @@ MONGO_INITIALIZER(RegisterBenchmarks)(InitializerContext* context) {
             ->Args({2, 2});
     }
 
+    // Targeting a write on mongos looks up the chunk for each document, so also measure the point
+    // lookups against collections with many more chunks.
+    std::initializer_list<benchmark::internal::Benchmark*> targetingBmCases{
+        REGISTER_BENCHMARK_CAPTURE(BM_FindIntersectingChunk,
+                                   PessimalLargeCollection,
+                                   makeChunkManagerWithPessimalBalancedDistribution),
+        REGISTER_BENCHMARK_CAPTURE(BM_FindIntersectingChunk,
+                                   OptimalLargeCollection,
+                                   makeChunkManagerWithOptimalBalancedDistribution),
+        REGISTER_BENCHMARK_CAPTURE(BM_KeyBelongsToMe,
+                                   OptimalLargeCollection,
+                                   makeChunkManagerWithOptimalBalancedDistribution),
+    };
+
+    for (auto bmCase : targetingBmCases) {
+        bmCase->Args({10, 500000})->Args({100, 1000000});
+    }
+
     return Status::OK();
 }
 
@@ -31,6 +31,7 @@
 
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/s/shard_key_sketch.h"
 
 namespace mongo {
 
@@ -56,6 +57,38 @@ public:
         return _bytesWritten.loadRelaxed();
     }
 
+    /**
+     * Records a single write of 'bytesWritten' bytes to the chunk. Unlike the bytes written
+     * counter above, which is reset whenever a split is attempted, these totals only ever grow and
+     * are reported to the balancer so that it can derive the rate of writes to the chunk.
+     */
+    void recordWriteOp(uint64_t bytesWritten) {
+        _totalWriteOps.fetchAndAdd(1);
+        _totalBytesWritten.fetchAndAdd(bytesWritten);
+    }
+
+    /**
+     * Returns the total number of writes recorded for the chunk.
+     */
+    uint64_t getTotalWriteOps() const {
+        return _totalWriteOps.loadRelaxed();
+    }
+
+    /**
+     * Returns the total number of bytes recorded as written to the chunk.
+     */
+    uint64_t getTotalBytesWritten() const {
+        return _totalBytesWritten.loadRelaxed();
+    }
+
+    /**
+     * Returns the sketch of the shard keys inserted into the chunk, which is used to pick split
+     * points without scanning the chunk's data.
+     */
+    ShardKeySketch& getShardKeySketch() {
+        return _shardKeySketch;
+    }
+
     /**
      * Sets the number of bytes in the tracker to zero and returns the number
      * of bytes in the tracker prior to clearing it.
@@ -86,6 +119,19 @@ private:
      */
     AtomicWord<unsigned long long> _bytesWritten{0};
 
+    /**
+     * The number of writes and the number of bytes written to this chunk since it was created.
+     * Never reset. May be modified concurrently by several threads.
+     */
+    AtomicWord<unsigned long long> _totalWriteOps{0};
+    AtomicWord<unsigned long long> _totalBytesWritten{0};
+
+    /**
+     * Sketch of the shard keys inserted into this chunk. Carried over to the chunks it is split
+     * into and never reset otherwise.
+     */
+    ShardKeySketch _shardKeySketch;
+
     /**
      * Protects _splitState when starting a split.
      */
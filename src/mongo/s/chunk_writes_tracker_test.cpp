@@ -64,6 +64,24 @@ TEST(ChunkWritesTrackerTest, ClearBytesWrittenReturnsBytesWrittenBeforeClearing)
     ASSERT_EQ(previousBytesWritten, bytesToAdd);
 }
 
+TEST(ChunkWritesTrackerTest, RecordWriteOpAccumulatesTotals) {
+    ChunkWritesTracker wt;
+    wt.recordWriteOp(4ull);
+    wt.recordWriteOp(6ull);
+    ASSERT_EQ(wt.getTotalWriteOps(), 2ull);
+    ASSERT_EQ(wt.getTotalBytesWritten(), 10ull);
+}
+
+TEST(ChunkWritesTrackerTest, ClearBytesWrittenDoesNotResetTotals) {
+    ChunkWritesTracker wt;
+    wt.addBytesWritten(4ull);
+    wt.recordWriteOp(4ull);
+    wt.clearBytesWritten();
+    ASSERT_EQ(wt.getBytesWritten(), 0ull);
+    ASSERT_EQ(wt.getTotalWriteOps(), 1ull);
+    ASSERT_EQ(wt.getTotalBytesWritten(), 4ull);
+}
+
 TEST(ChunkWritesTrackerTest, ShouldSplitReturnsTrueWithBytesWrittenAndMaxChunkSizeZero) {
     ChunkWritesTracker wt;
     wt.addBytesWritten(4ull);
@@ -0,0 +1,285 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <set>
+
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/platform/random.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/rpc/op_msg.h"
+#include "mongo/s/catalog/type_chunk.h"
+#include "mongo/s/catalog/type_collection.h"
+#include "mongo/s/catalog/type_database.h"
+#include "mongo/s/commands/cluster_command_test_fixture.h"
+#include "mongo/s/database_version_helpers.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+/*
+ * Benchmarks of the CPU mongos spends routing and merging operations on a sharded collection. The
+ * shards are simulated in memory through the mocked network of the sharding test fixtures, and
+ * each operation runs through Strategy::clientCommand, so that the timings cover command parsing,
+ * targeting against the routing table, the dispatch of requests to the shards and the merging of
+ * their responses: ClusterFind and the AsyncResultsMerger for finds, the merging half of the
+ * pipeline for aggregations and BatchWriteExec for inserts.
+ *
+ * The timings also include the mocked network answering the shards' requests on the benchmark
+ * thread, which does not depend on the code being measured.
+ */
+
+// Shard key values are spread over [0, kKeySpace), which the chunks split evenly.
+constexpr long long kKeySpace = 1 << 20;
+
+constexpr int kDocsPerShard = 100;
+constexpr int kNumGroups = 100;
+constexpr int kInsertBatchSize = 1000;
+constexpr int64_t kSeed = 1;
+
+/**
+ * Owns a mongos whose routing table splits 'kNss', sharded on _id, into 'numChunks' chunks
+ * distributed round-robin over 'numShards' shards.
+ */
+class ClusterBenchmarkHarness : public ClusterCommandTestFixture {
+public:
+    ClusterBenchmarkHarness(int numShards, int numChunks) : _numShards(numShards) {
+        invariant(numChunks >= numShards);
+        setUp();
+        setupNShards(numShards);
+        _loadRoutingTable(numChunks);
+    }
+
+    ~ClusterBenchmarkHarness() {
+        tearDown();
+    }
+
+    using ClusterCommandTestFixture::kNss;
+
+    /**
+     * Runs 'cmd' through mongos, answering the requests it sends to the shards with 'respond',
+     * which is passed the index of the shard a request is for. Throws if the command fails.
+     */
+    template <typename Respond>
+    void runClusterCommand(const BSONObj& cmd, int numRequests, Respond respond) {
+        auto future = launchAsync([&] { return runCommand(cmd); });
+
+        for (int i = 0; i < numRequests; ++i) {
+            onCommandForPoolExecutor([&](const executor::RemoteCommandRequest& request) {
+                return respond(request, _shardIndex(request.target));
+            });
+        }
+
+        auto response = future.default_timed_get();
+        uassertStatusOK(getStatusFromWriteCommandReply(OpMsg::parse(response.response).body));
+    }
+
+    /**
+     * Returns the index of the shard which owns 'key'.
+     */
+    int shardForKey(long long key) const {
+        auto chunk = std::upper_bound(_chunkBounds.begin(), _chunkBounds.end(), key) -
+            _chunkBounds.begin() - 1;
+        return chunk % _numShards;
+    }
+
+    int getNumShards() const {
+        return _numShards;
+    }
+
+private:
+    void _doTest() override {}
+
+    void expectInspectRequest(int shardIndex, InspectionCallback cb) override {
+        MONGO_UNREACHABLE;
+    }
+
+    void expectReturnsSuccess(int shardIndex) override {
+        MONGO_UNREACHABLE;
+    }
+
+    void _loadRoutingTable(int numChunks) {
+        ChunkVersion version(1, 0, OID::gen());
+
+        DatabaseType db(kNss.db().toString(), {"0"}, true, databaseVersion::makeNew());
+
+        CollectionType coll;
+        coll.setNs(kNss);
+        coll.setEpoch(version.epoch());
+        coll.setKeyPattern(BSON("_id" << 1));
+        coll.setUnique(false);
+
+        std::vector<BSONObj> chunks;
+        for (int i = 0; i < numChunks; ++i) {
+            _chunkBounds.push_back(i * kKeySpace / numChunks);
+            auto min = i == 0 ? BSON("_id" << MINKEY) : BSON("_id" << _chunkBounds.back());
+            auto max = i + 1 == numChunks ? BSON("_id" << MAXKEY)
+                                          : BSON("_id" << (i + 1) * kKeySpace / numChunks);
+            ChunkType chunk(kNss, {min, max}, version, ShardId(std::to_string(i % _numShards)));
+            chunk.setName(OID::gen());
+            chunks.push_back(chunk.toConfigBSON());
+            version.incMajor();
+        }
+
+        auto future = scheduleRoutingInfoRefresh(kNss);
+        expectFindSendBSONObjVector(kConfigHostAndPort, {db.toBSON()});
+        expectFindSendBSONObjVector(kConfigHostAndPort, {coll.toBSON()});
+        expectFindSendBSONObjVector(kConfigHostAndPort, {coll.toBSON()});
+        expectFindSendBSONObjVector(kConfigHostAndPort, chunks);
+        future.default_timed_get();
+    }
+
+    // Shards are named "0", "1", ... and live on "Host0:12345", "Host1:12345", ...
+    int _shardIndex(const HostAndPort& host) const {
+        return std::stoi(host.host().substr(std::strlen("Host")));
+    }
+
+    const int _numShards;
+
+    // The lower bound of each chunk, in key order.
+    std::vector<long long> _chunkBounds;
+};
+
+BSONObj makeCursorResponse(const NamespaceString& nss, std::vector<BSONObj> batch) {
+    return CursorResponse(nss, CursorId(0), std::move(batch))
+        .toBSON(CursorResponse::ResponseType::InitialResponse);
+}
+
+void BM_ClusterFindTargeted(benchmark::State& state) {
+    ClusterBenchmarkHarness harness(state.range(0), state.range(1));
+    const auto nss = harness.kNss;
+
+    PseudoRandom random(kSeed);
+    for (auto _ : state) {
+        const long long key = random.nextInt64(kKeySpace);
+        harness.runClusterCommand(
+            BSON("find" << nss.coll() << "filter" << BSON("_id" << key)),
+            1,
+            [&](const executor::RemoteCommandRequest&, int) {
+                return makeCursorResponse(nss, {BSON("_id" << key)});
+            });
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ClusterFindSortedMerge(benchmark::State& state) {
+    ClusterBenchmarkHarness harness(state.range(0), state.range(1));
+    const auto nss = harness.kNss;
+    const int numShards = harness.getNumShards();
+
+    // Shard i returns i, i + numShards, i + 2 * numShards, ..., so that the AsyncResultsMerger has
+    // to interleave the batches of all shards.
+    for (auto _ : state) {
+        harness.runClusterCommand(
+            BSON("find" << nss.coll() << "sort" << BSON("_id" << 1) << "batchSize"
+                        << numShards * kDocsPerShard << "singleBatch" << true),
+            numShards,
+            [&](const executor::RemoteCommandRequest&, int shardIndex) {
+                std::vector<BSONObj> batch;
+                for (int i = 0; i < kDocsPerShard; ++i) {
+                    const int id = shardIndex + i * numShards;
+                    batch.push_back(BSON("_id" << id << "$sortKey" << BSON("" << id)));
+                }
+                return makeCursorResponse(nss, std::move(batch));
+            });
+    }
+    state.SetItemsProcessed(state.iterations() * numShards * kDocsPerShard);
+}
+
+void BM_ClusterAggregateGroupMerge(benchmark::State& state) {
+    ClusterBenchmarkHarness harness(state.range(0), state.range(1));
+    const auto nss = harness.kNss;
+    const int numShards = harness.getNumShards();
+
+    // Each shard returns a partial group for every group, which mongos merges.
+    for (auto _ : state) {
+        harness.runClusterCommand(
+            BSON("aggregate" << nss.coll() << "pipeline"
+                             << BSON_ARRAY(BSON("$group" << BSON("_id"
+                                                                 << "$g"
+                                                                 << "total"
+                                                                 << BSON("$sum"
+                                                                         << "$x"))))
+                             << "cursor" << BSON("batchSize" << kNumGroups)),
+            numShards,
+            [&](const executor::RemoteCommandRequest&, int shardIndex) {
+                std::vector<BSONObj> batch;
+                for (int group = 0; group < kNumGroups; ++group) {
+                    batch.push_back(BSON("_id" << group << "total" << shardIndex));
+                }
+                return makeCursorResponse(nss, std::move(batch));
+            });
+    }
+    state.SetItemsProcessed(state.iterations() * numShards * kNumGroups);
+}
+
+void BM_ClusterInsertBatch(benchmark::State& state) {
+    ClusterBenchmarkHarness harness(state.range(0), state.range(1));
+    const auto nss = harness.kNss;
+
+    // The documents are spread evenly over the key space, and so over the chunks.
+    BSONArrayBuilder documentsBuilder;
+    std::set<int> targetedShards;
+    for (int i = 0; i < kInsertBatchSize; ++i) {
+        const long long key = i * kKeySpace / kInsertBatchSize;
+        documentsBuilder.append(BSON("_id" << key << "x" << i));
+        targetedShards.insert(harness.shardForKey(key));
+    }
+    const auto cmd = BSON("insert" << nss.coll() << "documents" << documentsBuilder.arr());
+
+    for (auto _ : state) {
+        harness.runClusterCommand(
+            cmd, targetedShards.size(), [&](const executor::RemoteCommandRequest& request, int) {
+                return BSON("ok" << 1 << "n" << request.cmdObj["documents"].Obj().nFields());
+            });
+    }
+    state.SetItemsProcessed(state.iterations() * kInsertBatchSize);
+}
+
+void shardAndChunkCounts(benchmark::internal::Benchmark* b) {
+    for (int numShards : {1, 4, 16, 64}) {
+        for (int numChunks : {64, 10000}) {
+            b->Args({numShards, numChunks});
+        }
+    }
+}
+
+BENCHMARK(BM_ClusterFindTargeted)->Apply(shardAndChunkCounts)->UseRealTime();
+BENCHMARK(BM_ClusterFindSortedMerge)->Apply(shardAndChunkCounts)->UseRealTime();
+BENCHMARK(BM_ClusterAggregateGroupMerge)->Apply(shardAndChunkCounts)->UseRealTime();
+BENCHMARK(BM_ClusterInsertBatch)->Apply(shardAndChunkCounts)->UseRealTime();
+
+}  // namespace
+}  // namespace mongo
@@ -53,6 +53,7 @@
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_time_tracker.h"
+#include "mongo/db/operation_trace.h"
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/getmore_request.h"
@@ -370,7 +371,14 @@ void runCommand(OperationContext* opCtx,
         opCtx->setComment(commentField.wrap());
     }
 
-    auto invocation = command->parse(opCtx, request);
+    OperationTrace::get(opCtx).start(
+        opCtx, command->getName(), request.body[OperationTrace::kMetadataFieldName]);
+
+    std::unique_ptr<CommandInvocation> invocation;
+    {
+        OperationTrace::Span parseSpan(opCtx, "parse");
+        invocation = command->parse(opCtx, request);
+    }
 
     // Set the logical optype, command object and namespace as soon as we identify the command. If
     // the command does not define a fully-qualified namespace, set CurOp to the generic command
@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/hedging_metrics.h"
+
+#include <cmath>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/bits.h"
+#include "mongo/s/hedging_server_parameters_gen.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+const auto hedgingMetricsDecoration = ServiceContext::declareDecoration<HedgingMetrics>();
+
+// Every power of two microseconds from 4 on is split into this many buckets.
+constexpr int kSubBucketBits = 2;
+constexpr uint64_t kSubBuckets = 1 << kSubBucketBits;
+
+size_t bucketFor(uint64_t micros) {
+    if (micros < kSubBuckets) {
+        return micros;
+    }
+    const int exponent = 63 - countLeadingZeros64(micros);
+    const auto subBucket = (micros >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+    return kSubBuckets * (exponent - kSubBucketBits + 1) + subBucket;
+}
+
+uint64_t bucketStart(size_t bucket) {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+    const int exponent = bucket / kSubBuckets + kSubBucketBits - 1;
+    return (kSubBuckets + bucket % kSubBuckets) << (exponent - kSubBucketBits);
+}
+
+}  // namespace
+
+void ResponseTimeHistogram::record(Microseconds responseTime) {
+    const auto micros = uint64_t(std::max<long long>(responseTime.count(), 0));
+    ++_buckets[std::min(bucketFor(micros), kNumBuckets - 1)];
+
+    if (++_count == kMaxSamples) {
+        _count = 0;
+        for (auto& bucket : _buckets) {
+            bucket /= 2;
+            _count += bucket;
+        }
+    }
+}
+
+boost::optional<Microseconds> ResponseTimeHistogram::percentile(double percentile) const {
+    if (_count < kMinSamples) {
+        return boost::none;
+    }
+
+    const auto rank = std::max<long long>(std::ceil(_count * percentile / 100), 1);
+    long long seen = 0;
+    for (size_t bucket = 0; bucket < kNumBuckets; ++bucket) {
+        seen += _buckets[bucket];
+        if (seen >= rank) {
+            return Microseconds(static_cast<long long>(bucketStart(bucket + 1)));
+        }
+    }
+    MONGO_UNREACHABLE;
+}
+
+HedgingMetrics* HedgingMetrics::get(ServiceContext* service) {
+    return &hedgingMetricsDecoration(service);
+}
+
+HedgingMetrics* HedgingMetrics::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+void HedgingMetrics::recordResponseTime(const ShardId& shardId, Microseconds responseTime) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _responseTimes[shardId].record(responseTime);
+}
+
+Milliseconds HedgingMetrics::getHedgingDelay(const ShardId& shardId) {
+    const Milliseconds minDelay(gHedgedReadsDelayMillis.load());
+    const auto percentile = gHedgedReadsDelayPercentile.load();
+    if (percentile == 0) {
+        return minDelay;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    const auto it = _responseTimes.find(shardId);
+    if (it == _responseTimes.end()) {
+        return minDelay;
+    }
+    const auto responseTime = it->second.percentile(percentile);
+    if (!responseTime) {
+        return minDelay;
+    }
+    return std::max(minDelay, duration_cast<Milliseconds>(*responseTime + Microseconds(999)));
+}
+
+void HedgingMetrics::appendStats(BSONObjBuilder* builder) {
+    builder->append("numTotalOperations", _numTotalOperations.load());
+    builder->append("numTotalHedgedOperations", _numTotalHedgedOperations.load());
+    builder->append("numAdvantageouslyHedgedOperations",
+                    _numAdvantageouslyHedgedOperations.load());
+
+    BSONObjBuilder responseTimesBuilder(builder->subobjStart("shardResponseTimes"));
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (const auto& [shardId, histogram] : _responseTimes) {
+        BSONObjBuilder shardBuilder(responseTimesBuilder.subobjStart(shardId.toString()));
+        shardBuilder.append("count", histogram.count());
+        for (auto percentile : {50, 95, 99}) {
+            if (auto responseTime = histogram.percentile(percentile)) {
+                shardBuilder.append(str::stream() << "p" << percentile << "Micros",
+                                    durationCount<Microseconds>(*responseTime));
+            }
+        }
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,138 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <boost/optional.hpp>
+#include <map>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/s/shard_id.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Histogram of the recent response times of a single shard. The buckets are spaced
+ * logarithmically, with four buckets per power of two microseconds, so that percentiles are
+ * accurate to within a quarter of their value. Once the histogram holds kMaxSamples samples all
+ * counts are halved, so that older samples fade out as new ones come in.
+ *
+ * Not thread safe.
+ */
+class ResponseTimeHistogram {
+public:
+    // The number of samples needed before percentile() returns a value.
+    static constexpr long long kMinSamples = 20;
+
+    static constexpr long long kMaxSamples = 4096;
+
+    void record(Microseconds responseTime);
+
+    /**
+     * Returns the response time which 'percentile' percent of the recent samples did not exceed,
+     * rounded up to the end of its bucket. Returns boost::none if there are too few samples.
+     */
+    boost::optional<Microseconds> percentile(double percentile) const;
+
+    long long count() const {
+        return _count;
+    }
+
+private:
+    static constexpr size_t kNumBuckets = 4 * 40;
+
+    std::array<long long, kNumBuckets> _buckets{};
+
+    long long _count = 0;
+};
+
+/**
+ * Router-wide statistics about hedged reads, and the response times of each shard which the delay
+ * before hedging a read is derived from.
+ */
+class HedgingMetrics {
+    HedgingMetrics(const HedgingMetrics&) = delete;
+    HedgingMetrics& operator=(const HedgingMetrics&) = delete;
+
+public:
+    HedgingMetrics() = default;
+
+    static HedgingMetrics* get(ServiceContext* service);
+    static HedgingMetrics* get(OperationContext* opCtx);
+
+    /**
+     * Records how long a read which could have been hedged took on 'shardId'.
+     */
+    void recordResponseTime(const ShardId& shardId, Microseconds responseTime);
+
+    /**
+     * Returns how long to wait for a response from 'shardId' before hedging a read: the configured
+     * percentile of its recent response times, but no less than the configured delay.
+     */
+    Milliseconds getHedgingDelay(const ShardId& shardId);
+
+    void incrementNumTotalOperations() {
+        _numTotalOperations.fetchAndAdd(1);
+    }
+
+    void incrementNumTotalHedgedOperations() {
+        _numTotalHedgedOperations.fetchAndAdd(1);
+    }
+
+    void incrementNumAdvantageouslyHedgedOperations() {
+        _numAdvantageouslyHedgedOperations.fetchAndAdd(1);
+    }
+
+    void appendStats(BSONObjBuilder* builder);
+
+private:
+    // The number of reads which were sent to a shard with more than one eligible host while hedged
+    // reads were enabled.
+    AtomicWord<long long> _numTotalOperations{0};
+
+    // The number of those reads which were also sent to a second host.
+    AtomicWord<long long> _numTotalHedgedOperations{0};
+
+    // The number of hedged reads which the second host answered first.
+    AtomicWord<long long> _numAdvantageouslyHedgedOperations{0};
+
+    Mutex _mutex = MONGO_MAKE_LATCH("HedgingMetrics::_mutex");
+
+    std::map<ShardId, ResponseTimeHistogram> _responseTimes;
+};
+
+}  // namespace mongo
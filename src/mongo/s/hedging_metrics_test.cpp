@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/hedging_metrics.h"
+
+#include "mongo/s/hedging_server_parameters_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+TEST(ResponseTimeHistogramTest, NoPercentileWithTooFewSamples) {
+    ResponseTimeHistogram histogram;
+    for (long long i = 1; i < ResponseTimeHistogram::kMinSamples; ++i) {
+        histogram.record(Microseconds(100));
+    }
+    ASSERT_FALSE(histogram.percentile(50));
+
+    histogram.record(Microseconds(100));
+    ASSERT(histogram.percentile(50));
+}
+
+TEST(ResponseTimeHistogramTest, PercentilesAreWithinAQuarterOfTheResponseTime) {
+    ResponseTimeHistogram histogram;
+    for (long long micros = 1; micros <= 1000; ++micros) {
+        histogram.record(Microseconds(micros * 1000));
+    }
+
+    for (auto percentile : {1.0, 50.0, 95.0, 99.0, 100.0}) {
+        const auto expected = 10 * percentile * 1000;
+        const auto responseTime = durationCount<Microseconds>(*histogram.percentile(percentile));
+        ASSERT_GTE(responseTime, expected) << percentile;
+        ASSERT_LTE(responseTime, expected * 1.25) << percentile;
+    }
+}
+
+TEST(ResponseTimeHistogramTest, SmallAndLargeResponseTimes) {
+    ResponseTimeHistogram histogram;
+    for (long long i = 0; i < ResponseTimeHistogram::kMinSamples; ++i) {
+        histogram.record(Microseconds(0));
+    }
+    ASSERT_EQ(Microseconds(1), *histogram.percentile(100));
+
+    for (long long i = 0; i < ResponseTimeHistogram::kMinSamples; ++i) {
+        histogram.record(Hours(24 * 365));
+    }
+    ASSERT_GTE(*histogram.percentile(100), Hours(24 * 7));
+}
+
+TEST(ResponseTimeHistogramTest, OldSamplesFadeOut) {
+    ResponseTimeHistogram histogram;
+    for (long long i = 0; i < ResponseTimeHistogram::kMaxSamples - 1; ++i) {
+        histogram.record(Milliseconds(100));
+    }
+    ASSERT_EQ(ResponseTimeHistogram::kMaxSamples - 1, histogram.count());
+
+    // Recording the last sample halves all counts.
+    histogram.record(Milliseconds(100));
+    ASSERT_EQ(ResponseTimeHistogram::kMaxSamples / 2, histogram.count());
+
+    // The new response times take over once they are the majority of the samples.
+    for (long long i = 0; i < ResponseTimeHistogram::kMaxSamples / 2 + 1; ++i) {
+        histogram.record(Milliseconds(1));
+    }
+    ASSERT_LT(*histogram.percentile(50), Milliseconds(2));
+}
+
+TEST(HedgingMetricsTest, HedgingDelayFollowsResponseTimes) {
+    const auto delayMillis = gHedgedReadsDelayMillis.load();
+    const auto delayPercentile = gHedgedReadsDelayPercentile.load();
+    ON_BLOCK_EXIT([&] {
+        gHedgedReadsDelayMillis.store(delayMillis);
+        gHedgedReadsDelayPercentile.store(delayPercentile);
+    });
+    gHedgedReadsDelayMillis.store(5);
+    gHedgedReadsDelayPercentile.store(90);
+
+    HedgingMetrics metrics;
+    const ShardId shardId("shard0");
+
+    // Without enough response times for the shard, the configured delay is used.
+    ASSERT_EQ(Milliseconds(5), metrics.getHedgingDelay(shardId));
+
+    for (int i = 0; i < 100; ++i) {
+        metrics.recordResponseTime(shardId, Milliseconds(i < 90 ? 40 : 400));
+    }
+    const auto delay = metrics.getHedgingDelay(shardId);
+    ASSERT_GTE(delay, Milliseconds(40));
+    ASSERT_LTE(delay, Milliseconds(50));
+    ASSERT_EQ(Milliseconds(5), metrics.getHedgingDelay(ShardId("shard1")));
+
+    // The configured delay is the lower bound.
+    gHedgedReadsDelayMillis.store(100);
+    ASSERT_EQ(Milliseconds(100), metrics.getHedgingDelay(shardId));
+
+    // Without a percentile, the configured delay is always used.
+    gHedgedReadsDelayMillis.store(5);
+    gHedgedReadsDelayPercentile.store(0);
+    ASSERT_EQ(Milliseconds(5), metrics.getHedgingDelay(shardId));
+}
+
+}  // namespace
+}  // namespace mongo
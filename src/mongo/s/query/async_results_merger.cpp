@@ -41,6 +41,7 @@
 #include "mongo/db/query/killcursors_request.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
+#include "mongo/s/query/async_results_merger_params_gen.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 
@@ -91,13 +92,17 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(params.getTailableMode().value_or(TailableModeEnum::kNormal)),
       _params(std::move(params)),
-      _mergeQueue(MergingComparator(
+      _mergeTree(MergingComparator(
           _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
       _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
     if (params.getTxnNumber()) {
         invariant(params.getSessionId());
     }
 
+    if (_params.getSort() && _params.getSort()->nFields() <= int(Ordering::kMaxCompoundIndexKeys)) {
+        _sortKeyOrdering = Ordering::make(*_params.getSort());
+    }
+
     size_t remoteIndex = 0;
     for (const auto& remote : _params.getRemotes()) {
         _remotes.emplace_back(remote.getHostAndPort(),
@@ -109,6 +114,9 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
         _addBatchToBuffer(WithLock::withoutLock(), remoteIndex, remote.getCursorResponse());
         ++remoteIndex;
     }
+    if (_params.getSort()) {
+        _mergeTree.rebuild(_remotes.size());
+    }
     // If this is a change stream, then we expect to have already received PBRTs from every shard.
     invariant(_promisedMinSortKeys.empty() || _promisedMinSortKeys.size() == _remotes.size());
     _highWaterMark = _promisedMinSortKeys.empty() ? BSONObj() : _promisedMinSortKeys.begin()->first;
@@ -186,6 +194,9 @@ void AsyncResultsMerger::addNewShardCursors(std::vector<RemoteCursor>&& newCurso
                               remote.getCursorResponse().getCursorId());
         _addBatchToBuffer(lk, newIndex, remote.getCursorResponse());
     }
+    if (_params.getSort()) {
+        _mergeTree.rebuild(_remotes.size());
+    }
 }
 
 BSONObj AsyncResultsMerger::getHighWaterMark() {
@@ -242,11 +253,11 @@ bool AsyncResultsMerger::_readySorted(WithLock lk) {
 }
 
 bool AsyncResultsMerger::_readySortedTailable(WithLock lk) {
-    if (_mergeQueue.empty()) {
+    if (_mergeTree.size() == 0 || !_remotes[_mergeTree.top()].hasNext()) {
         return false;
     }
 
-    auto smallestRemote = _mergeQueue.top();
+    auto smallestRemote = _mergeTree.top();
     auto smallestResult = _remotes[smallestRemote].docBuffer.front();
     auto keyWeWantToReturn =
         extractSortKey(*smallestResult.getResult(), _params.getCompareWholeSortKey());
@@ -290,27 +301,31 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
     return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock lk) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode != TailableModeEnum::kTailable);
 
-    if (_mergeQueue.empty()) {
+    if (_mergeTree.size() == 0 || !_remotes[_mergeTree.top()].hasNext()) {
         return {};
     }
 
-    size_t smallestRemote = _mergeQueue.top();
-    _mergeQueue.pop();
+    size_t smallestRemote = _mergeTree.top();
+    auto& remote = _remotes[smallestRemote];
+    invariant(remote.status.isOK());
 
-    invariant(!_remotes[smallestRemote].docBuffer.empty());
-    invariant(_remotes[smallestRemote].status.isOK());
+    ClusterQueryResult front = remote.docBuffer.front();
+    remote.docBuffer.pop();
+    if (!remote.sortKeyBuffer.empty()) {
+        remote.sortKeyBuffer.pop();
+    }
 
-    ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
-    _remotes[smallestRemote].docBuffer.pop();
+    // Move the next result from 'smallestRemote', if any, to its place in the merge.
+    _mergeTree.replayTop();
 
-    // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
-    // next result.
-    if (!_remotes[smallestRemote].docBuffer.empty()) {
-        _mergeQueue.push(smallestRemote);
+    // Ask for the next batch while the remaining results are being merged, so that the merge does
+    // not have to wait for the response once they run out.
+    if (_shouldReadAhead(lk, smallestRemote)) {
+        remote.status = _askForNextBatch(lk, smallestRemote);
     }
 
     // For sorted tailable awaitData cursors, update the high water mark to the document's sort key.
@@ -353,6 +368,18 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
     return {};
 }
 
+bool AsyncResultsMerger::_shouldReadAhead(WithLock, size_t remoteIndex) const {
+    const auto& remote = _remotes[remoteIndex];
+    if (_tailableMode != TailableModeEnum::kNormal || !_opCtx || _lifecycleState != kAlive ||
+        remote.exhausted() || remote.cbHandle.isValid()) {
+        return false;
+    }
+
+    // With the default ratio, the next batch is requested once half of the last one was merged.
+    return remote.docBuffer.size() <
+        internalQueryARMReadAheadRatio.load() * double(remote.lastBatchSize);
+}
+
 Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
     invariant(_opCtx, "Cannot schedule a getMore without an OperationContext");
     auto& remote = _remotes[remoteIndex];
@@ -580,9 +607,16 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
         remote.status = Status::OK();
 
         // Clear the results buffer and cursor id.
+        const bool hadNext = remote.hasNext();
         std::queue<ClusterQueryResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
+        std::queue<KeyString::Value> emptySortKeyBuffer;
+        std::swap(remote.sortKeyBuffer, emptySortKeyBuffer);
         remote.cursorId = 0;
+
+        if (_params.getSort() && hadNext) {
+            _updateMergeTree(lk, remoteIndex);
+        }
     }
 }
 
@@ -635,6 +669,7 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                            size_t remoteIndex,
                                            const CursorResponse& response) {
     auto& remote = _remotes[remoteIndex];
+    const bool hadNext = remote.hasNext();
     _updateRemoteMetadata(lk, remoteIndex, response);
     for (const auto& obj : response.getBatch()) {
         // If there's a sort, we're expecting the remote node to have given us back a sort key.
@@ -655,19 +690,45 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
             }
         }
 
+        if (_sortKeyOrdering) {
+            remote.sortKeyBuffer.push(
+                KeyString::HeapBuilder(KeyString::Version::V1,
+                                       extractSortKey(obj, _params.getCompareWholeSortKey()),
+                                       *_sortKeyOrdering)
+                    .release());
+        }
+
         ClusterQueryResult result(obj);
         remote.docBuffer.push(result);
         ++remote.fetchedCount;
     }
 
-    // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
-    // queue.
-    if (_params.getSort() && !response.getBatch().empty()) {
-        _mergeQueue.push(remoteIndex);
+    if (!response.getBatch().empty()) {
+        remote.lastBatchSize = response.getBatch().size();
+    }
+
+    // If we're doing a sorted merge and the remote had no results buffered, its first new result
+    // has to be moved to its place in the merge.
+    if (_params.getSort() && !hadNext && remote.hasNext()) {
+        _updateMergeTree(lk, remoteIndex);
     }
     return true;
 }
 
+void AsyncResultsMerger::_updateMergeTree(WithLock, size_t remoteIndex) {
+    // Remotes which are still being added get their place when the tree is rebuilt over all of
+    // them.
+    if (_mergeTree.size() != _remotes.size()) {
+        return;
+    }
+
+    if (_mergeTree.top() == remoteIndex) {
+        _mergeTree.replayTop();
+    } else {
+        _mergeTree.rebuild(_remotes.size());
+    }
+}
+
 void AsyncResultsMerger::_signalCurrentEventIfReady(WithLock lk) {
     if (_ready(lk) && _currentEvent.isValid()) {
         // To prevent ourselves from signalling the event twice, we set '_currentEvent' as
@@ -774,13 +835,23 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
 // AsyncResultsMerger::MergingComparator
 //
 
-bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
+bool AsyncResultsMerger::MergingComparator::operator()(size_t lhs, size_t rhs) const {
+    const auto& leftRemote = _remotes[lhs];
+    const auto& rightRemote = _remotes[rhs];
+    if (!leftRemote.hasNext() || !rightRemote.hasNext()) {
+        return leftRemote.hasNext();
+    }
+
+    if (!leftRemote.sortKeyBuffer.empty()) {
+        return leftRemote.sortKeyBuffer.front() < rightRemote.sortKeyBuffer.front();
+    }
+
+    const ClusterQueryResult& leftDoc = leftRemote.docBuffer.front();
+    const ClusterQueryResult& rightDoc = rightRemote.docBuffer.front();
 
     return compareSortKeys(extractSortKey(*leftDoc.getResult(), _compareWholeSortKey),
                            extractSortKey(*rightDoc.getResult(), _compareWholeSortKey),
-                           _sort) > 0;
+                           _sort) < 0;
 }
 
 bool AsyncResultsMerger::PromisedMinSortKeyComparator::operator()(
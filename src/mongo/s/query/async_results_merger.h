@@ -35,11 +35,14 @@
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
 #include "mongo/db/cursor_id.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/s/query/async_results_merger_params_gen.h"
 #include "mongo/s/query/cluster_query_result.h"
+#include "mongo/s/query/loser_tree.h"
 #include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/net/hostandport.h"
 #include "mongo/util/time_support.h"
@@ -64,8 +67,9 @@ class CursorResponse;
  *
  * Task-scheduling behavior differs depending on whether there is a sort. If the result documents
  * must be sorted, we pass the sort through to the remote nodes and then merge the sorted streams.
- * This requires waiting until we have a response from every remote before returning results.
- * Without a sort, we are ready to return results as soon as we have *any* response from a remote.
+ * This requires waiting until we have a response from every remote before returning results, so
+ * the next batch is requested from a remote while it still has some results buffered. Without a
+ * sort, we are ready to return results as soon as we have *any* response from a remote.
  *
  * On any error, the caller is responsible for shutting down the ARM using the kill() method.
  *
@@ -88,8 +92,8 @@ public:
      * the hosts on which they exist in _remotes.
      *
      * Additionally copies each remote's first batch of results, if one exists, into that remote's
-     * docBuffer. If a sort is specified in the ClusterClientCursorParams, places the remotes with
-     * buffered results onto _mergeQueue.
+     * docBuffer. If a sort is specified in the ClusterClientCursorParams, builds _mergeTree over
+     * the remotes.
      *
      * The TaskExecutor* must remain valid for the lifetime of the ARM.
      *
@@ -292,6 +296,13 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // The sort keys of the results in 'docBuffer', encoded as KeyStrings so that the merge
+        // compares them as bytes. Empty if there is no sort or the sort keys are compared as BSON.
+        std::queue<KeyString::Value> sortKeyBuffer;
+
+        // The number of results in the last non-empty batch received from this remote.
+        size_t lastBatchSize = 0;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -311,7 +322,11 @@ private:
                           bool compareWholeSortKey)
             : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
 
-        bool operator()(const size_t& lhs, const size_t& rhs);
+        /**
+         * Returns true if the next buffered result of remote 'lhs' sorts before the next buffered
+         * result of remote 'rhs'. Remotes without buffered results sort after all other remotes.
+         */
+        bool operator()(size_t lhs, size_t rhs) const;
 
     private:
         const std::vector<RemoteCursorData>& _remotes;
@@ -435,6 +450,17 @@ private:
      */
     Status _scheduleGetMores(WithLock);
 
+    /**
+     * Returns true if the next batch should already be requested from the remote at 'remoteIndex',
+     * because a sorted merge is about to run out of its buffered results.
+     */
+    bool _shouldReadAhead(WithLock, size_t remoteIndex) const;
+
+    /**
+     * Replays '_mergeTree' after the next buffered result of the remote at 'remoteIndex' changed.
+     */
+    void _updateMergeTree(WithLock, size_t remoteIndex);
+
     /**
      * Schedules a killCursors command to be run on all remote hosts that have open cursors.
      */
@@ -456,9 +482,13 @@ private:
     // Data tracking the state of our communication with each of the remote nodes.
     std::vector<RemoteCursorData> _remotes;
 
-    // The top of this priority queue is the index into '_remotes' for the remote host that has the
-    // next document to return, according to the sort order. Used only if there is a sort.
-    std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
+    // Used only if there is a sort. Encodes the sort keys of the results as KeyStrings, unless the
+    // sort pattern has more fields than an Ordering can describe.
+    boost::optional<Ordering> _sortKeyOrdering;
+
+    // The top of this tree is the index into '_remotes' for the remote host that has the next
+    // document to return, according to the sort order. Used only if there is a sort.
+    LoserTree<MergingComparator> _mergeTree;
 
     // The index into '_remotes' for the remote from which we are currently retrieving results.
     // Used only if there is *not* a sort.
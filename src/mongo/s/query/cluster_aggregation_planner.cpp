@@ -31,6 +31,7 @@
 
 #include "mongo/s/query/cluster_aggregation_planner.h"
 
+#include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_match.h"
@@ -577,5 +578,102 @@ boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationConte
     return walkPipelineBackwardsTrackingShardKey(opCtx, mergePipeline, *routingInfo.cm());
 }
 
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    OperationContext* opCtx,
+    const SplitPipeline& splitPipeline,
+    const std::set<ShardId>& targetedShards) {
+    if (internalQueryDisableExchange.load() || !internalQueryEnableGroupExchange.load() ||
+        targetedShards.size() < 2) {
+        return boost::none;
+    }
+
+    // Hashing the group keys doesn't respect the collation, and the consumers would have to become
+    // participants of the transaction.
+    const auto* mergePipeline = splitPipeline.mergePipeline.get();
+    const auto& expCtx = mergePipeline->getContext();
+    if (TransactionRouter::get(opCtx) || splitPipeline.shardCursorsSortSpec ||
+        expCtx->getCollator() || expCtx->tailableMode != TailableModeEnum::kNormal ||
+        mergePipeline->getSources().empty()) {
+        return boost::none;
+    }
+
+    const auto& stages = mergePipeline->getSources();
+    const auto group = dynamic_cast<DocumentSourceGroup*>(stages.front().get());
+    if (!group || !group->doingMerge()) {
+        return boost::none;
+    }
+
+    // The partial groups of each key all go to the same consumer, which can then run the merging
+    // $group and the stages after it which process each document on its own.
+    size_t numConsumerStages = 1;
+    for (auto it = std::next(stages.begin()); it != stages.end(); ++it, ++numConsumerStages) {
+        const auto constraints = (*it)->constraints(Pipeline::SplitState::kSplitForMerge);
+        if ((*it)->distributedPlanLogic() || constraints.writesPersistentData() ||
+            (constraints.hostRequirement != StageConstraints::HostTypeRequirement::kNone &&
+             constraints.hostRequirement != StageConstraints::HostTypeRequirement::kAnyShard)) {
+            break;
+        }
+    }
+
+    std::vector<ShardId> consumerShards(targetedShards.begin(), targetedShards.end());
+    if (consumerShards.size() > Exchange::kMaxNumberConsumers) {
+        consumerShards.resize(Exchange::kMaxNumberConsumers);
+    }
+
+    // Split the range of hashes evenly between the consumers.
+    const uint64_t hashesPerConsumer = std::numeric_limits<uint64_t>::max() / consumerShards.size();
+    std::vector<BSONObj> boundaries{BSON("_id" << MINKEY)};
+    for (size_t i = 1; i < consumerShards.size(); ++i) {
+        boundaries.push_back(BSON(
+            "_id" << static_cast<long long>(
+                uint64_t(std::numeric_limits<long long>::min()) + i * hashesPerConsumer)));
+    }
+    boundaries.push_back(BSON("_id" << MAXKEY));
+
+    ExchangeSpec exchangeSpec;
+    exchangeSpec.setPolicy(ExchangePolicyEnum::kKeyRange);
+    exchangeSpec.setKey(BSON("_id"
+                             << "hashed"));
+    exchangeSpec.setBoundaries(std::move(boundaries));
+    exchangeSpec.setConsumers(consumerShards.size());
+
+    return ShardedExchangePolicy{
+        std::move(exchangeSpec), std::move(consumerShards), numConsumerStages};
+}
+
+boost::optional<PartialMergePolicy> checkIfEligibleForPartialMerge(
+    OperationContext* opCtx, const SplitPipeline& splitPipeline, size_t numCursors) {
+    const auto fanIn = internalQueryMergeFanIn.load();
+    if (fanIn < 2 || numCursors <= static_cast<size_t>(fanIn)) {
+        return boost::none;
+    }
+
+    // The intermediate shards would have to become participants of the transaction, and would have
+    // to keep their results sorted for the final merger.
+    const auto* mergePipeline = splitPipeline.mergePipeline.get();
+    if (TransactionRouter::get(opCtx) || splitPipeline.shardCursorsSortSpec ||
+        mergePipeline->getContext()->tailableMode != TailableModeEnum::kNormal ||
+        mergePipeline->getSources().empty()) {
+        return boost::none;
+    }
+
+    // A merging $group outputs partial groups when its results need merging, which the final
+    // merging $group then combines in the same way as the partial groups from the shards. Limiting
+    // any subset of the results does not change which results the final $limit can return either.
+    const auto& firstStage = mergePipeline->getSources().front();
+    const auto group = dynamic_cast<DocumentSourceGroup*>(firstStage.get());
+    if (!(group && group->doingMerge()) && !dynamic_cast<DocumentSourceLimit*>(firstStage.get())) {
+        return boost::none;
+    }
+
+    std::vector<Value> serializedStages;
+    firstStage->serializeToArray(serializedStages);
+    std::vector<BSONObj> stages;
+    for (auto&& stage : serializedStages) {
+        stages.push_back(stage.getDocument().toBson());
+    }
+    return PartialMergePolicy{std::move(stages), static_cast<size_t>(fanIn)};
+}
+
 }  // namespace cluster_aggregation_planner
 }  // namespace mongo
@@ -105,6 +105,11 @@ struct ShardedExchangePolicy {
 
     // Shards that will run the consumer part of the exchange.
     std::vector<ShardId> consumerShards;
+
+    // The number of leading stages of the merging pipeline which each consumer runs over its part
+    // of the documents. The remaining stages run on the merger of the consumers' results. If not
+    // set, the consumers run the whole merging pipeline.
+    boost::optional<size_t> numConsumerStages;
 };
 
 /**
@@ -113,5 +118,32 @@ struct ShardedExchangePolicy {
  */
 boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationContext* opCtx,
                                                                   const Pipeline* mergePipeline);
+
+/**
+ * If the merging pipeline of 'splitPipeline' begins with a merging $group, returns the information
+ * required to hash-partition the partial groups from the shards by their group key, such that each
+ * of up to all the 'targetedShards' merges the groups of one partition.
+ */
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    OperationContext* opCtx,
+    const SplitPipeline& splitPipeline,
+    const std::set<ShardId>& targetedShards);
+
+struct PartialMergePolicy {
+    // The stages which combine the results of some of the cursors on an intermediate shard, such
+    // that their output can be merged in the same way as the results of the shards.
+    std::vector<BSONObj> stages;
+
+    // The largest number of cursors merged by each intermediate shard and by the final merger.
+    size_t fanIn;
+};
+
+/**
+ * If the 'numCursors' cursors opened by the shards part of 'splitPipeline' are too many to merge in
+ * one place, and the merging pipeline begins with a merging $group or a $limit, returns the
+ * information required to combine them in a tree of partial merges on the shards first.
+ */
+boost::optional<PartialMergePolicy> checkIfEligibleForPartialMerge(
+    OperationContext* opCtx, const SplitPipeline& splitPipeline, size_t numCursors);
 }  // namespace cluster_aggregation_planner
 }  // namespace mongo
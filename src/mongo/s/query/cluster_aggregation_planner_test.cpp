@@ -33,16 +33,19 @@
 #include "mongo/client/remote_command_targeter_factory_mock.h"
 #include "mongo/client/remote_command_targeter_mock.h"
 #include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_merge.h"
 #include "mongo/db/pipeline/document_source_out.h"
 #include "mongo/db/pipeline/document_source_project.h"
+#include "mongo/db/pipeline/document_source_skip.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/stub_mongo_process_interface.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/catalog_cache_test_fixture.h"
 #include "mongo/s/query/cluster_aggregation_planner.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/scopeguard.h"
 
@@ -691,5 +694,126 @@ TEST_F(ClusterExchangeTest, CompoundShardKeyThreeShards) {
 
     future.default_timed_get();
 }
+
+TEST_F(ClusterExchangeTest, GroupIsEligibleForGroupExchange) {
+    internalQueryEnableGroupExchange.store(true);
+    ON_BLOCK_EXIT([] { internalQueryEnableGroupExchange.store(false); });
+
+    auto splitPipeline = cluster_aggregation_planner::splitPipeline(
+        unittest::assertGet(Pipeline::create({parse("{$group: {_id: '$x', n: {$sum: 1}}}"),
+                                              parse("{$match: {n: {$gt: 1}}}"),
+                                              parse("{$sort: {n: -1}}")},
+                                             expCtx())));
+    auto exchangeSpec = cluster_aggregation_planner::checkIfEligibleForGroupExchange(
+        operationContext(), splitPipeline, {ShardId("0"), ShardId("1"), ShardId("2")});
+    ASSERT_TRUE(exchangeSpec);
+    ASSERT(exchangeSpec->exchangeSpec.getPolicy() == ExchangePolicyEnum::kKeyRange);
+    ASSERT_BSONOBJ_EQ(exchangeSpec->exchangeSpec.getKey(),
+                      BSON("_id"
+                           << "hashed"));
+    ASSERT_EQ(exchangeSpec->consumerShards.size(), 3UL);
+
+    // The consumers run the $group and the $match, and the $sort runs on the merger.
+    ASSERT_EQ(*exchangeSpec->numConsumerStages, 2UL);
+
+    const auto& boundaries = exchangeSpec->exchangeSpec.getBoundaries().get();
+    ASSERT_EQ(boundaries.size(), 4UL);
+    ASSERT_BSONOBJ_EQ(boundaries.front(), BSON("_id" << MINKEY));
+    ASSERT_LT(boundaries[1]["_id"].numberLong(), boundaries[2]["_id"].numberLong());
+    ASSERT_BSONOBJ_EQ(boundaries.back(), BSON("_id" << MAXKEY));
+}
+
+TEST_F(ClusterExchangeTest, ShouldNotGroupExchangeUnlessEnabledWithManyShards) {
+    auto splitPipeline = cluster_aggregation_planner::splitPipeline(unittest::assertGet(
+        Pipeline::create({parse("{$group: {_id: '$x', n: {$sum: 1}}}")}, expCtx())));
+    ASSERT_FALSE(cluster_aggregation_planner::checkIfEligibleForGroupExchange(
+        operationContext(), splitPipeline, {ShardId("0"), ShardId("1")}));
+
+    internalQueryEnableGroupExchange.store(true);
+    ON_BLOCK_EXIT([] { internalQueryEnableGroupExchange.store(false); });
+    ASSERT_FALSE(cluster_aggregation_planner::checkIfEligibleForGroupExchange(
+        operationContext(), splitPipeline, {ShardId("0")}));
+    ASSERT_TRUE(cluster_aggregation_planner::checkIfEligibleForGroupExchange(
+        operationContext(), splitPipeline, {ShardId("0"), ShardId("1")}));
+}
+
+TEST_F(ClusterExchangeTest, ShouldNotGroupExchangeWithoutLeadingGroup) {
+    internalQueryEnableGroupExchange.store(true);
+    ON_BLOCK_EXIT([] { internalQueryEnableGroupExchange.store(false); });
+
+    auto splitPipeline = cluster_aggregation_planner::splitPipeline(
+        unittest::assertGet(Pipeline::create({parse("{$limit: 5}")}, expCtx())));
+    ASSERT_FALSE(cluster_aggregation_planner::checkIfEligibleForGroupExchange(
+        operationContext(), splitPipeline, {ShardId("0"), ShardId("1")}));
+}
+
+class ClusterPartialMergeTest : public ClusterExchangeTest {
+public:
+    void setUp() {
+        ClusterExchangeTest::setUp();
+        _originalFanIn = internalQueryMergeFanIn.load();
+        internalQueryMergeFanIn.store(4);
+    }
+
+    void tearDown() {
+        internalQueryMergeFanIn.store(_originalFanIn);
+        ClusterExchangeTest::tearDown();
+    }
+
+    cluster_aggregation_planner::SplitPipeline split(std::vector<std::string> stages) {
+        Pipeline::SourceContainer sources;
+        for (auto&& stage : stages) {
+            sources.push_back(parse(stage));
+        }
+        return cluster_aggregation_planner::splitPipeline(
+            unittest::assertGet(Pipeline::create(std::move(sources), expCtx())));
+    }
+
+private:
+    int _originalFanIn;
+};
+
+TEST_F(ClusterPartialMergeTest, GroupIsEligibleForPartialMerge) {
+    auto splitPipeline = split({"{$group: {_id: '$x', count: {$sum: 1}}}"});
+    auto policy = cluster_aggregation_planner::checkIfEligibleForPartialMerge(
+        operationContext(), splitPipeline, 10);
+    ASSERT_TRUE(policy);
+    ASSERT_EQ(policy->fanIn, 4UL);
+    ASSERT_EQ(policy->stages.size(), 1UL);
+    ASSERT_TRUE(policy->stages[0]["$group"]["$doingMerge"].trueValue());
+}
+
+TEST_F(ClusterPartialMergeTest, LimitIsEligibleForPartialMerge) {
+    auto splitPipeline = split({"{$limit: 5}"});
+    auto policy = cluster_aggregation_planner::checkIfEligibleForPartialMerge(
+        operationContext(), splitPipeline, 10);
+    ASSERT_TRUE(policy);
+    ASSERT_EQ(policy->stages.size(), 1UL);
+    ASSERT_BSONOBJ_EQ(policy->stages[0], BSON("$limit" << 5));
+}
+
+TEST_F(ClusterPartialMergeTest, ShouldNotPartiallyMergeUpToFanInCursors) {
+    auto splitPipeline = split({"{$group: {_id: '$x'}}"});
+    ASSERT_FALSE(cluster_aggregation_planner::checkIfEligibleForPartialMerge(
+        operationContext(), splitPipeline, 4));
+
+    internalQueryMergeFanIn.store(0);
+    ASSERT_FALSE(cluster_aggregation_planner::checkIfEligibleForPartialMerge(
+        operationContext(), splitPipeline, 10));
+}
+
+TEST_F(ClusterPartialMergeTest, ShouldNotPartiallyMergeSortedCursors) {
+    auto splitPipeline = split({"{$sort: {x: 1}}", "{$limit: 5}"});
+    ASSERT_TRUE(splitPipeline.shardCursorsSortSpec);
+    ASSERT_FALSE(cluster_aggregation_planner::checkIfEligibleForPartialMerge(
+        operationContext(), splitPipeline, 10));
+}
+
+TEST_F(ClusterPartialMergeTest, ShouldNotPartiallyMergeSkip) {
+    auto splitPipeline = split({"{$skip: 5}"});
+    ASSERT_FALSE(cluster_aggregation_planner::checkIfEligibleForPartialMerge(
+        operationContext(), splitPipeline, 10));
+}
+
 }  // namespace
 }  // namespace mongo
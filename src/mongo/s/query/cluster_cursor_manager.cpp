@@ -154,13 +154,16 @@ ClusterCursorManager::ClusterCursorManager(ClockSource* clockSource)
 
 ClusterCursorManager::~ClusterCursorManager() {
     invariant(_cursorIdPrefixToNamespaceMap.empty());
-    invariant(_namespaceToContainerMap.empty());
+    invariant(_namespaceToRegistrationMap.empty());
+    for (const auto& partition : _partitions) {
+        invariant(partition.namespaceToEntryMap.empty());
+    }
 }
 
 void ClusterCursorManager::shutdown(OperationContext* opCtx) {
     {
         stdx::lock_guard<Latch> lk(_mutex);
-        _inShutdown = true;
+        _inShutdown.store(true);
     }
     killAllCursors(opCtx);
 }
@@ -177,7 +180,7 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
 
     stdx::unique_lock<Latch> lk(_mutex);
 
-    if (_inShutdown) {
+    if (_inShutdown.load()) {
         lk.unlock();
         cursor->kill(opCtx);
         return Status(ErrorCodes::ShutdownInProgress,
@@ -187,9 +190,9 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
     invariant(cursor);
     cursor->setLeftoverMaxTimeMicros(opCtx->getRemainingMaxTimeMicros());
 
-    // Find the CursorEntryContainer for this namespace.  If none exists, create one.
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    if (nsToContainerIt == _namespaceToContainerMap.end()) {
+    // Find the registration for this namespace.  If none exists, reserve a new prefix for it.
+    auto nsToRegistrationIt = _namespaceToRegistrationMap.find(nss);
+    if (nsToRegistrationIt == _namespaceToRegistrationMap.end()) {
         uint32_t containerPrefix = 0;
         do {
             // The server has always generated positive values for CursorId (which is a signed
@@ -205,31 +208,41 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
         _cursorIdPrefixToNamespaceMap[containerPrefix] = nss;
 
         auto emplaceResult =
-            _namespaceToContainerMap.emplace(nss, CursorEntryContainer(containerPrefix));
+            _namespaceToRegistrationMap.emplace(nss, NamespaceRegistration{containerPrefix});
         invariant(emplaceResult.second);
-        invariant(_namespaceToContainerMap.size() == _cursorIdPrefixToNamespaceMap.size());
+        invariant(_namespaceToRegistrationMap.size() == _cursorIdPrefixToNamespaceMap.size());
 
-        nsToContainerIt = emplaceResult.first;
+        nsToRegistrationIt = emplaceResult.first;
     } else {
-        invariant(!nsToContainerIt->second.entryMap.empty());  // If exists, shouldn't be empty.
+        invariant(nsToRegistrationIt->second.numCursors > 0);  // If exists, shouldn't be empty.
     }
-    CursorEntryContainer& container = nsToContainerIt->second;
+    NamespaceRegistration& registration = nsToRegistrationIt->second;
 
-    // Generate a CursorId (which can't be the invalid value zero).
-    CursorEntryMap& entryMap = container.entryMap;
-    CursorId cursorId = 0;
-    do {
+    // Generate a CursorId (which can't be the invalid value zero), and register a new CursorEntry
+    // for it in the partition which owns it. The namespace registration is updated while '_mutex'
+    // is still held, so that the namespace's prefix cannot be released concurrently.
+    while (true) {
         const uint32_t cursorSuffix = static_cast<uint32_t>(_pseudoRandom.nextInt32());
-        cursorId = createCursorId(container.containerPrefix, cursorSuffix);
-    } while (cursorId == 0 || entryMap.count(cursorId) > 0);
+        const CursorId cursorId = createCursorId(registration.containerPrefix, cursorSuffix);
+        if (cursorId == 0) {
+            continue;
+        }
 
-    // Create a new CursorEntry and register it in the CursorEntryContainer's map.
-    auto emplaceResult = entryMap.emplace(
-        cursorId,
-        CursorEntry(std::move(cursor), cursorType, cursorLifetime, now, authenticatedUsers));
-    invariant(emplaceResult.second);
+        Partition& partition = _getPartition(cursorId);
+        stdx::lock_guard<Latch> partitionLk(partition.mutex);
+        CursorEntryMap& entryMap = partition.namespaceToEntryMap[nss];
+        if (entryMap.count(cursorId) > 0) {
+            continue;
+        }
+
+        auto emplaceResult = entryMap.emplace(
+            cursorId,
+            CursorEntry(std::move(cursor), cursorType, cursorLifetime, now, authenticatedUsers));
+        invariant(emplaceResult.second);
+        ++registration.numCursors;
 
-    return cursorId;
+        return cursorId;
+    }
 }
 
 StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCursor(
@@ -238,13 +251,13 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     OperationContext* opCtx,
     AuthzCheckFn authChecker,
     AuthCheck checkSessionAuth) {
-    stdx::lock_guard<Latch> lk(_mutex);
-
-    if (_inShutdown) {
+    if (_inShutdown.load()) {
         return Status(ErrorCodes::ShutdownInProgress,
                       "Cannot check out cursor as we are in the process of shutting down");
     }
 
+    stdx::lock_guard<Latch> lk(_getPartition(cursorId).mutex);
+
     CursorEntry* entry = _getEntry(lk, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
@@ -298,7 +311,7 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
     cursor->detachFromOperationContext();
     cursor->setLastUseDate(now);
 
-    stdx::unique_lock<Latch> lk(_mutex);
+    stdx::unique_lock<Latch> lk(_getPartition(cursorId).mutex);
 
     CursorEntry* entry = _getEntry(lk, nss, cursorId);
     invariant(entry);
@@ -323,7 +336,7 @@ Status ClusterCursorManager::checkAuthForKillCursors(OperationContext* opCtx,
                                                      const NamespaceString& nss,
                                                      CursorId cursorId,
                                                      AuthzCheckFn authChecker) {
-    stdx::lock_guard<Latch> lk(_mutex);
+    stdx::lock_guard<Latch> lk(_getPartition(cursorId).mutex);
     auto entry = _getEntry(lk, nss, cursorId);
 
     if (!entry) {
@@ -351,7 +364,7 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
                                         CursorId cursorId) {
     invariant(opCtx);
 
-    stdx::unique_lock<Latch> lk(_mutex);
+    stdx::unique_lock<Latch> lk(_getPartition(cursorId).mutex);
 
     CursorEntry* entry = _getEntry(lk, nss, cursorId);
     if (!entry) {
@@ -384,13 +397,12 @@ void ClusterCursorManager::detachAndKillCursor(stdx::unique_lock<Latch> lk,
 
     // Deletion of the cursor can happen out of the lock.
     lk.unlock();
+    _deregisterCursors(nss, 1);
     detachedCursorGuard.getValue()->kill(opCtx);
 }
 
 std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContext* opCtx,
                                                                  Date_t cutoff) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
     auto pred = [cutoff](CursorId cursorId, const CursorEntry& entry) -> bool {
         bool res = entry.getLifetimeType() == CursorLifetime::Mortal &&
             !entry.getOperationUsingCursor() && entry.getLastActive() <= cutoff;
@@ -403,123 +415,135 @@ std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContex
         return res;
     };
 
-    return killCursorsSatisfying(std::move(lk), opCtx, std::move(pred));
+    return killCursorsSatisfying(opCtx, std::move(pred));
 }
 
 void ClusterCursorManager::killAllCursors(OperationContext* opCtx) {
-    stdx::unique_lock<Latch> lk(_mutex);
     auto pred = [](CursorId, const CursorEntry&) -> bool { return true; };
 
-    killCursorsSatisfying(std::move(lk), opCtx, std::move(pred));
+    killCursorsSatisfying(opCtx, std::move(pred));
 }
 
 std::size_t ClusterCursorManager::killCursorsSatisfying(
-    stdx::unique_lock<Latch> lk,
-    OperationContext* opCtx,
-    std::function<bool(CursorId, const CursorEntry&)> pred) {
+    OperationContext* opCtx, std::function<bool(CursorId, const CursorEntry&)> pred) {
     invariant(opCtx);
-    invariant(lk.owns_lock());
     std::size_t nKilled = 0;
 
-    std::vector<ClusterClientCursorGuard> cursorsToDestroy;
-    auto nsContainerIt = _namespaceToContainerMap.begin();
-    while (nsContainerIt != _namespaceToContainerMap.end()) {
-        auto&& entryMap = nsContainerIt->second.entryMap;
-        auto cursorIdEntryIt = entryMap.begin();
-        while (cursorIdEntryIt != entryMap.end()) {
-            auto cursorId = cursorIdEntryIt->first;
-            auto& entry = cursorIdEntryIt->second;
-
-            if (!pred(cursorId, entry)) {
-                ++cursorIdEntryIt;
-                continue;
+    for (auto& partition : _partitions) {
+        std::vector<ClusterClientCursorGuard> cursorsToDestroy;
+        std::vector<std::pair<NamespaceString, std::size_t>> numDestroyedByNss;
+
+        stdx::unique_lock<Latch> lk(partition.mutex);
+        auto nsEntryMapIt = partition.namespaceToEntryMap.begin();
+        while (nsEntryMapIt != partition.namespaceToEntryMap.end()) {
+            auto&& entryMap = nsEntryMapIt->second;
+            std::size_t numDestroyed = 0;
+            auto cursorIdEntryIt = entryMap.begin();
+            while (cursorIdEntryIt != entryMap.end()) {
+                auto cursorId = cursorIdEntryIt->first;
+                auto& entry = cursorIdEntryIt->second;
+
+                if (!pred(cursorId, entry)) {
+                    ++cursorIdEntryIt;
+                    continue;
+                }
+
+                ++nKilled;
+
+                if (entry.getOperationUsingCursor()) {
+                    // Mark the OperationContext using the cursor as killed, and move on.
+                    killOperationUsingCursor(lk, &entry);
+                    ++cursorIdEntryIt;
+                    continue;
+                }
+
+                cursorsToDestroy.push_back(entry.releaseCursor(opCtx));
+                ++numDestroyed;
+
+                // Destroy the entry and set the iterator to the next element.
+                entryMap.erase(cursorIdEntryIt++);
             }
 
-            ++nKilled;
+            if (numDestroyed > 0) {
+                numDestroyedByNss.emplace_back(nsEntryMapIt->first, numDestroyed);
+            }
 
-            if (entry.getOperationUsingCursor()) {
-                // Mark the OperationContext using the cursor as killed, and move on.
-                killOperationUsingCursor(lk, &entry);
-                ++cursorIdEntryIt;
-                continue;
+            if (entryMap.empty()) {
+                partition.namespaceToEntryMap.erase(nsEntryMapIt++);
+            } else {
+                ++nsEntryMapIt;
             }
+        }
 
-            cursorsToDestroy.push_back(entry.releaseCursor(opCtx));
+        // Ensure cursors are killed outside the lock, as killing may require waiting for callbacks
+        // to finish. Each partition's cursors are killed before moving on to the next one, so that
+        // no lock is held for the duration of the whole pass.
+        lk.unlock();
 
-            // Destroy the entry and set the iterator to the next element.
-            entryMap.erase(cursorIdEntryIt++);
+        for (auto&& nssAndCount : numDestroyedByNss) {
+            _deregisterCursors(nssAndCount.first, nssAndCount.second);
         }
 
-        if (entryMap.empty()) {
-            nsContainerIt = eraseContainer(nsContainerIt);
-        } else {
-            ++nsContainerIt;
+        for (auto&& cursorGuard : cursorsToDestroy) {
+            invariant(cursorGuard);
+            cursorGuard->kill(opCtx);
         }
     }
 
-    // Ensure cursors are killed outside the lock, as killing may require waiting for callbacks to
-    // finish.
-    lk.unlock();
+    return nKilled;
+}
 
-    for (auto&& cursorGuard : cursorsToDestroy) {
-        invariant(cursorGuard);
-        cursorGuard->kill(opCtx);
+void ClusterCursorManager::_forEachEntry(
+    std::function<void(CursorId, const NamespaceString&, const CursorEntry&)> fn) const {
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (const auto& nsEntryMapPair : partition.namespaceToEntryMap) {
+            for (const auto& cursorIdEntryPair : nsEntryMapPair.second) {
+                fn(cursorIdEntryPair.first, nsEntryMapPair.first, cursorIdEntryPair.second);
+            }
+        }
     }
-
-    return nKilled;
 }
 
 ClusterCursorManager::Stats ClusterCursorManager::stats() const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     Stats stats;
 
-    for (auto& nsContainerPair : _namespaceToContainerMap) {
-        for (auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
-            const CursorEntry& entry = cursorIdEntryPair.second;
-
-            if (entry.isKillPending()) {
-                // Killed cursors do not count towards the number of pinned cursors or the number of
-                // open cursors.
-                continue;
-            }
+    _forEachEntry([&](CursorId, const NamespaceString&, const CursorEntry& entry) {
+        if (entry.isKillPending()) {
+            // Killed cursors do not count towards the number of pinned cursors or the number of
+            // open cursors.
+            return;
+        }
 
-            if (entry.getOperationUsingCursor()) {
-                ++stats.cursorsPinned;
-            }
+        if (entry.getOperationUsingCursor()) {
+            ++stats.cursorsPinned;
+        }
 
-            switch (entry.getCursorType()) {
-                case CursorType::SingleTarget:
-                    ++stats.cursorsSingleTarget;
-                    break;
-                case CursorType::MultiTarget:
-                    ++stats.cursorsMultiTarget;
-                    break;
-            }
+        switch (entry.getCursorType()) {
+            case CursorType::SingleTarget:
+                ++stats.cursorsSingleTarget;
+                break;
+            case CursorType::MultiTarget:
+                ++stats.cursorsMultiTarget;
+                break;
         }
-    }
+    });
 
     return stats;
 }
 
 void ClusterCursorManager::appendActiveSessions(LogicalSessionIdSet* lsids) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
-            const CursorEntry& entry = cursorIdEntryPair.second;
-
-            if (entry.isKillPending()) {
-                // Don't include sessions for killed cursors.
-                continue;
-            }
+    _forEachEntry([&](CursorId, const NamespaceString&, const CursorEntry& entry) {
+        if (entry.isKillPending()) {
+            // Don't include sessions for killed cursors.
+            return;
+        }
 
-            auto lsid = entry.getLsid();
-            if (lsid) {
-                lsids->insert(*lsid);
-            }
+        auto lsid = entry.getLsid();
+        if (lsid) {
+            lsids->insert(*lsid);
         }
-    }
+    });
 }
 
 GenericCursor ClusterCursorManager::CursorEntry::cursorToGenericCursor(
@@ -544,30 +568,23 @@ std::vector<GenericCursor> ClusterCursorManager::getIdleCursors(
     const OperationContext* opCtx, MongoProcessInterface::CurrentOpUserMode userMode) const {
     std::vector<GenericCursor> cursors;
 
-    stdx::lock_guard<Latch> lk(_mutex);
-
     AuthorizationSession* ctxAuth = AuthorizationSession::get(opCtx->getClient());
 
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
-
-            const CursorEntry& entry = cursorIdEntryPair.second;
-            // If auth is enabled, and userMode is allUsers, check if the current user has
-            // permission to see this cursor.
-            if (ctxAuth->getAuthorizationManager().isAuthEnabled() &&
-                userMode == MongoProcessInterface::CurrentOpUserMode::kExcludeOthers &&
-                !ctxAuth->isCoauthorizedWith(entry.getAuthenticatedUsers())) {
-                continue;
-            }
-            if (entry.isKillPending() || entry.getOperationUsingCursor()) {
-                // Don't include sessions for killed or pinned cursors.
-                continue;
-            }
-
-            cursors.emplace_back(
-                entry.cursorToGenericCursor(cursorIdEntryPair.first, nsContainerPair.first));
+    _forEachEntry([&](CursorId cursorId, const NamespaceString& nss, const CursorEntry& entry) {
+        // If auth is enabled, and userMode is allUsers, check if the current user has
+        // permission to see this cursor.
+        if (ctxAuth->getAuthorizationManager().isAuthEnabled() &&
+            userMode == MongoProcessInterface::CurrentOpUserMode::kExcludeOthers &&
+            !ctxAuth->isCoauthorizedWith(entry.getAuthenticatedUsers())) {
+            return;
         }
-    }
+        if (entry.isKillPending() || entry.getOperationUsingCursor()) {
+            // Don't include sessions for killed or pinned cursors.
+            return;
+        }
+
+        cursors.emplace_back(entry.cursorToGenericCursor(cursorId, nss));
+    });
 
     return cursors;
 }
@@ -592,25 +609,19 @@ std::pair<Status, int> ClusterCursorManager::killCursorsWithMatchingSessions(
 
 stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
     LogicalSessionId lsid) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     stdx::unordered_set<CursorId> cursorIds;
 
-    for (auto&& nsContainerPair : _namespaceToContainerMap) {
-        for (auto&& cursorIdEntryPair : nsContainerPair.second.entryMap) {
-            const CursorEntry& entry = cursorIdEntryPair.second;
-
-            if (entry.isKillPending()) {
-                // Don't include sessions for killed cursors.
-                continue;
-            }
+    _forEachEntry([&](CursorId cursorId, const NamespaceString&, const CursorEntry& entry) {
+        if (entry.isKillPending()) {
+            // Don't include sessions for killed cursors.
+            return;
+        }
 
-            auto cursorLsid = entry.getLsid();
-            if (lsid == cursorLsid) {
-                cursorIds.insert(cursorIdEntryPair.first);
-            }
+        auto cursorLsid = entry.getLsid();
+        if (lsid == cursorLsid) {
+            cursorIds.insert(cursorId);
         }
-    }
+    });
 
     return cursorIds;
 }
@@ -626,14 +637,21 @@ boost::optional<NamespaceString> ClusterCursorManager::getNamespaceForCursorId(
     return it->second;
 }
 
+auto ClusterCursorManager::_getPartition(CursorId cursorId) const -> Partition& {
+    // The suffix of a cursor id is random, so its low bits spread cursors evenly across the
+    // partitions, including cursors which share a namespace prefix.
+    return _partitions[static_cast<uint64_t>(cursorId) % kNumPartitions];
+}
+
 auto ClusterCursorManager::_getEntry(WithLock, NamespaceString const& nss, CursorId cursorId)
     -> CursorEntry* {
 
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    if (nsToContainerIt == _namespaceToContainerMap.end()) {
+    auto& partition = _getPartition(cursorId);
+    auto nsToEntryMapIt = partition.namespaceToEntryMap.find(nss);
+    if (nsToEntryMapIt == partition.namespaceToEntryMap.end()) {
         return nullptr;
     }
-    CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
+    CursorEntryMap& entryMap = nsToEntryMapIt->second;
     auto entryMapIt = entryMap.find(cursorId);
     if (entryMapIt == entryMap.end()) {
         return nullptr;
@@ -642,19 +660,25 @@ auto ClusterCursorManager::_getEntry(WithLock, NamespaceString const& nss, Curso
     return &entryMapIt->second;
 }
 
-auto ClusterCursorManager::eraseContainer(NssToCursorContainerMap::iterator it)
-    -> NssToCursorContainerMap::iterator {
-    auto&& container = it->second;
-    auto&& entryMap = container.entryMap;
-    invariant(entryMap.empty());
+void ClusterCursorManager::_deregisterCursors(const NamespaceString& nss,
+                                              std::size_t numCursors) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    auto nsToRegistrationIt = _namespaceToRegistrationMap.find(nss);
+    invariant(nsToRegistrationIt != _namespaceToRegistrationMap.end());
+    auto&& registration = nsToRegistrationIt->second;
+    invariant(registration.numCursors >= numCursors);
+    registration.numCursors -= numCursors;
+    if (registration.numCursors > 0) {
+        return;
+    }
 
     // This was the last cursor remaining in the given namespace.  Erase all state associated
     // with this namespace.
-    size_t numDeleted = _cursorIdPrefixToNamespaceMap.erase(container.containerPrefix);
+    size_t numDeleted = _cursorIdPrefixToNamespaceMap.erase(registration.containerPrefix);
     invariant(numDeleted == 1);
-    _namespaceToContainerMap.erase(it++);
-    invariant(_namespaceToContainerMap.size() == _cursorIdPrefixToNamespaceMap.size());
-    return it;
+    _namespaceToRegistrationMap.erase(nsToRegistrationIt);
+    invariant(_namespaceToRegistrationMap.size() == _cursorIdPrefixToNamespaceMap.size());
 }
 
 StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLock lk,
@@ -675,13 +699,14 @@ StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLoc
     ClusterClientCursorGuard cursor = entry->releaseCursor(opCtx);
 
     // Destroy the entry.
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    invariant(nsToContainerIt != _namespaceToContainerMap.end());
-    CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
+    auto& partition = _getPartition(cursorId);
+    auto nsToEntryMapIt = partition.namespaceToEntryMap.find(nss);
+    invariant(nsToEntryMapIt != partition.namespaceToEntryMap.end());
+    CursorEntryMap& entryMap = nsToEntryMapIt->second;
     size_t eraseResult = entryMap.erase(cursorId);
     invariant(1 == eraseResult);
     if (entryMap.empty()) {
-        eraseContainer(nsToContainerIt);
+        partition.namespaceToEntryMap.erase(nsToEntryMapIt);
     }
 
     return std::move(cursor);
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -38,6 +39,7 @@
 #include "mongo/db/kill_sessions.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/session_killer.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/query/cluster_client_cursor.h"
@@ -68,6 +70,11 @@ class StatusWith;
  * The manager supports killing of registered cursors, either through the PinnedCursor object or
  * with the kill*() suite of methods.
  *
+ * Registered cursors are spread across a fixed number of partitions by cursor id, each with its own
+ * lock, so that concurrent getMore, killCursors and cleanup work on different cursors do not
+ * serialize on a single mutex. Only cursor registration and destruction touch the shared namespace
+ * registry.
+ *
  * No public methods throw exceptions, and all public methods are thread-safe.
  */
 class ClusterCursorManager {
@@ -335,7 +342,8 @@ public:
 
 
     /**
-     * Returns the number of open cursors on a ClusterCursorManager, broken down by type.
+     * Returns the number of open cursors on a ClusterCursorManager, broken down by type. Partitions
+     * are counted one at a time, so the result is not a point-in-time snapshot.
      *
      * Does not block.
      */
@@ -383,9 +391,13 @@ public:
 
 private:
     class CursorEntry;
-    struct CursorEntryContainer;
+    struct Partition;
     using CursorEntryMap = stdx::unordered_map<CursorId, CursorEntry>;
-    using NssToCursorContainerMap = stdx::unordered_map<NamespaceString, CursorEntryContainer>;
+    using NssToCursorEntryMap = stdx::unordered_map<NamespaceString, CursorEntryMap>;
+
+    // Number of independently locked partitions the registered cursors are spread across. A cursor
+    // is assigned to a partition by the low bits of its (randomly generated) cursor id suffix.
+    static constexpr std::size_t kNumPartitions = 16;
 
     /**
      * Transfers ownership of the given pinned cursor back to the manager, and moves the cursor to
@@ -404,21 +416,33 @@ private:
                        CursorState cursorState);
 
     /**
-     * Will detach a cursor, release the lock and then call kill() on it.
+     * Will detach a cursor, release the partition lock 'lk' and then call kill() on it.
      */
     void detachAndKillCursor(stdx::unique_lock<Latch> lk,
                              OperationContext* opCtx,
                              const NamespaceString& nss,
                              CursorId cursorId);
 
+    /**
+     * Returns the partition which owns the cursor with the given id.
+     */
+    Partition& _getPartition(CursorId cursorId) const;
+
     /**
      * Returns a pointer to the CursorEntry for the given cursor.  If the given cursor is not
      * registered, returns null.
      *
-     * Not thread-safe.
+     * The caller must hold the mutex of the partition owning 'cursorId'.
      */
     CursorEntry* _getEntry(WithLock, NamespaceString const& nss, CursorId cursorId);
 
+    /**
+     * Drops 'numCursors' destroyed cursors on 'nss' from the namespace registry, releasing the
+     * namespace's cursor id prefix once no cursors on it remain. Must be called without holding
+     * any partition mutex.
+     */
+    void _deregisterCursors(const NamespaceString& nss, std::size_t numCursors);
+
     /**
      * De-registers the given cursor, and returns an owned pointer to the underlying
      * ClusterClientCursor object.
@@ -426,7 +450,8 @@ private:
      * If the given cursor is pinned, returns an error Status with code CursorInUse.  If the given
      * cursor is not registered, returns an error Status with code CursorNotFound.
      *
-     * Not thread-safe.
+     * The caller must hold the mutex of the partition owning 'cursorId', and must call
+     * _deregisterCursors() for a successfully detached cursor once that mutex is released.
      */
     StatusWith<ClusterClientCursorGuard> _detachCursor(WithLock,
                                                        OperationContext* opCtx,
@@ -439,14 +464,21 @@ private:
     void killOperationUsingCursor(WithLock, CursorEntry* entry);
 
     /**
-     * Kill the cursors satisfying the given predicate. Assumes that 'lk' is held upon entry.
+     * Kill the cursors satisfying the given predicate. Partitions are visited one at a time, and
+     * the cursors removed from each partition are killed after its lock has been released, so
+     * that a pass over a large number of cursors never blocks the whole manager.
      *
      * Returns the number of cursors killed.
      */
-    std::size_t killCursorsSatisfying(stdx::unique_lock<Latch> lk,
-                                      OperationContext* opCtx,
+    std::size_t killCursorsSatisfying(OperationContext* opCtx,
                                       std::function<bool(CursorId, const CursorEntry&)> pred);
 
+    /**
+     * Calls 'fn' on every registered cursor, visiting one partition at a time with its lock held.
+     */
+    void _forEachEntry(
+        std::function<void(CursorId, const NamespaceString&, const CursorEntry&)> fn) const;
+
     /**
      * CursorEntry is a moveable, non-copyable container for a single cursor.
      */
@@ -567,39 +599,41 @@ private:
     };
 
     /**
-     * CursorEntryContainer is a moveable, non-copyable container for a set of cursors, where all
-     * contained cursors share the same 32-bit prefix of their cursor id.
+     * Namespace registry entry. All cursors on a namespace share a cursor id prefix, which stays
+     * reserved for the namespace as long as any of its cursors are registered.
      */
-    struct CursorEntryContainer {
-        CursorEntryContainer(const CursorEntryContainer&) = delete;
-        CursorEntryContainer& operator=(const CursorEntryContainer&) = delete;
-
-        CursorEntryContainer(uint32_t containerPrefix) : containerPrefix(containerPrefix) {}
-
-        CursorEntryContainer(CursorEntryContainer&& other) = default;
-        CursorEntryContainer& operator=(CursorEntryContainer&& other) = default;
-
-        // Common cursor id prefix for all cursors in this container.
+    struct NamespaceRegistration {
+        // Common cursor id prefix for all cursors on this namespace.
         uint32_t containerPrefix;
 
-        // Map from cursor id to cursor entry.
-        CursorEntryMap entryMap;
+        // Number of registered cursors on this namespace, across all partitions.
+        std::size_t numCursors = 0;
     };
 
     /**
-     * Erase the container that 'it' points to and return an iterator to the next one. Assumes 'it'
-     * is an iterator in '_namespaceToContainerMap'.
+     * A subset of the registered cursors, chosen by cursor id, with its own lock. Operations which
+     * address a single cursor (check out, check in, kill) only lock the partition owning it, so
+     * that operations on different cursors rarely contend with each other.
      */
-    NssToCursorContainerMap::iterator eraseContainer(NssToCursorContainerMap::iterator it);
+    struct Partition {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("ClusterCursorManager::Partition::mutex");
+
+        // Map from namespace to the cursors on that namespace owned by this partition. Entries are
+        // removed when the partition's last cursor on the namespace is destroyed.
+        NssToCursorEntryMap namespaceToEntryMap;
+    };
 
     // Clock source.  Used when the 'last active' time for a cursor needs to be set/updated.  May be
     // concurrently accessed by multiple threads.
     ClockSource* _clockSource;
 
-    // Synchronizes access to all private state variables below.
-    mutable Mutex _mutex = MONGO_MAKE_LATCH("ClusterCursorManager::_mutex");
+    // Set once shutdown() has been called. Written under '_mutex' so that no cursor can be
+    // registered after shutdown() has started killing cursors, but readable without it.
+    AtomicWord<bool> _inShutdown{false};
 
-    bool _inShutdown{false};
+    // Synchronizes access to the namespace registry state below. Lock ordering: '_mutex' may be
+    // held while acquiring a partition mutex, but never the other way around.
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ClusterCursorManager::_mutex");
 
     // Randomness source.  Used for cursor id generation.
     PseudoRandom _pseudoRandom;
@@ -616,11 +650,12 @@ private:
     // when the last cursor on the given namespace is destroyed.
     stdx::unordered_map<uint32_t, NamespaceString> _cursorIdPrefixToNamespaceMap;
 
-    // Map from namespace to the CursorEntryContainer for that namespace.
-    //
-    // Entries are added when the first cursor on the given namespace is registered, and removed
-    // when the last cursor on the given namespace is destroyed.
-    NssToCursorContainerMap _namespaceToContainerMap;
+    // Map from namespace to its registration. Added and removed together with the corresponding
+    // '_cursorIdPrefixToNamespaceMap' entry.
+    stdx::unordered_map<NamespaceString, NamespaceRegistration> _namespaceToRegistrationMap;
+
+    // The registered cursors, partitioned by cursor id. Each partition is guarded by its own mutex.
+    mutable std::array<Partition, kNumPartitions> _partitions;
 
     size_t _cursorsTimedOut = 0;
 };
@@ -526,6 +526,51 @@ TEST_F(ClusterCursorManagerTest, KillMortalCursorsInactiveSinceMultipleCursors)
     }
 }
 
+// Test that a cleanup pass over many cursors on many namespaces kills every expired cursor, except
+// for those which are pinned, and leaves the pinned cursors usable.
+TEST_F(ClusterCursorManagerTest, KillMortalCursorsInactiveSinceManyNamespaces) {
+    const size_t numNamespaces = 5;
+    const size_t numCursorsPerNamespace = 40;
+    std::vector<std::pair<NamespaceString, CursorId>> cursors;
+    for (size_t i = 0; i < numNamespaces; ++i) {
+        NamespaceString cursorNamespace(std::string(str::stream() << "test.collection" << i));
+        for (size_t j = 0; j < numCursorsPerNamespace; ++j) {
+            auto cursorId = getManager()->registerCursor(
+                _opCtx.get(),
+                allocateMockCursor(),
+                cursorNamespace,
+                ClusterCursorManager::CursorType::SingleTarget,
+                ClusterCursorManager::CursorLifetime::Mortal,
+                UserNameIterator());
+            cursors.emplace_back(cursorNamespace, assertGet(cursorId));
+        }
+    }
+
+    // Pin the first cursor so that the pass must skip it.
+    auto pinnedCursor = getManager()->checkOutCursor(
+        cursors[0].first, cursors[0].second, _opCtx.get(), successAuthChecker);
+    ASSERT_OK(pinnedCursor.getStatus());
+
+    getClockSource()->advance(Milliseconds(1));
+    ASSERT_EQ(cursors.size() - 1,
+              getManager()->killMortalCursorsInactiveSince(_opCtx.get(), getClockSource()->now()));
+    ASSERT(!isMockCursorKilled(0));
+    for (size_t i = 1; i < cursors.size(); ++i) {
+        ASSERT(isMockCursorKilled(i));
+        ASSERT_EQ(ErrorCodes::CursorNotFound,
+                  getManager()->checkOutCursor(cursors[i].first,
+                                               cursors[i].second,
+                                               _opCtx.get(),
+                                               successAuthChecker)
+                      .getStatus());
+    }
+    ASSERT(getManager()->getNamespaceForCursorId(cursors[0].second));
+    ASSERT_FALSE(getManager()->getNamespaceForCursorId(cursors.back().second));
+
+    pinnedCursor.getValue().returnCursor(ClusterCursorManager::CursorState::NotExhausted);
+    ASSERT_EQ(1U, getManager()->stats().cursorsSingleTarget);
+}
+
 // Test that killing all cursors successfully kills all cursors.
 TEST_F(ClusterCursorManagerTest, KillAllCursors) {
     const size_t numCursors = 10;
@@ -799,6 +844,35 @@ TEST_F(ClusterCursorManagerTest, GetNamespaceForCursorIdMultipleCursorsDifferent
     }
 }
 
+// Test that a namespace keeps its cursor id prefix while any of its cursors, which are spread
+// across the manager's partitions, remain registered, and releases it once the last one is gone.
+TEST_F(ClusterCursorManagerTest, GetNamespaceForCursorIdAfterPartialKill) {
+    const size_t numCursors = 100;
+    std::vector<CursorId> cursorIds(numCursors);
+    for (size_t i = 0; i < numCursors; ++i) {
+        cursorIds[i] =
+            assertGet(getManager()->registerCursor(_opCtx.get(),
+                                                   allocateMockCursor(),
+                                                   nss,
+                                                   ClusterCursorManager::CursorType::SingleTarget,
+                                                   ClusterCursorManager::CursorLifetime::Mortal,
+                                                   UserNameIterator()));
+    }
+    for (size_t i = 0; i + 1 < numCursors; ++i) {
+        ASSERT_OK(getManager()->killCursor(_opCtx.get(), nss, cursorIds[i]));
+        ASSERT(isMockCursorKilled(i));
+        boost::optional<NamespaceString> cursorNamespace =
+            getManager()->getNamespaceForCursorId(cursorIds.back());
+        ASSERT(cursorNamespace);
+        ASSERT_EQ(nss.ns(), cursorNamespace->ns());
+    }
+    ASSERT_EQ(1U, getManager()->stats().cursorsSingleTarget);
+
+    ASSERT_OK(getManager()->killCursor(_opCtx.get(), nss, cursorIds.back()));
+    ASSERT_FALSE(getManager()->getNamespaceForCursorId(cursorIds.back()));
+    ASSERT_EQ(0U, getManager()->stats().cursorsSingleTarget);
+}
+
 // Test that getting the namespace for an unknown cursor returns boost::none.
 TEST_F(ClusterCursorManagerTest, GetNamespaceForCursorIdUnknown) {
     boost::optional<NamespaceString> cursorNamespace = getManager()->getNamespaceForCursorId(5);
@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+/**
+ * A tournament tree over a number of sorted streams, which finds the stream with the smallest head
+ * among them. Every inner node remembers the stream which lost the match played there, so after the
+ * head of the winning stream changes, only the matches on the path from its leaf to the root have
+ * to be played again, with one comparison per level.
+ *
+ * The streams are identified by their indexes in [0, size()). 'Less' is called with two stream
+ * indexes and must order the streams by their current heads. Streams with nothing left to return
+ * must be ordered after all other streams.
+ */
+template <typename Less>
+class LoserTree {
+public:
+    explicit LoserTree(Less less) : _less(std::move(less)) {}
+
+    size_t size() const {
+        return _size;
+    }
+
+    /**
+     * Returns the stream with the smallest head. Requires at least one stream.
+     */
+    size_t top() const {
+        invariant(_size > 0);
+        return _nodes[0];
+    }
+
+    /**
+     * Plays every match again over 'size' streams. Used when streams were added, or when the head
+     * of any stream other than the winning one changed.
+     */
+    void rebuild(size_t size) {
+        _size = size;
+        _nodes.assign(size, 0);
+        if (size == 0) {
+            return;
+        }
+
+        // Positions [size, 2 * size) are the leaves and node i has the children 2i and 2i + 1.
+        std::vector<size_t> winners(size);
+        const auto winnerAt = [&](size_t node) {
+            return node >= size ? node - size : winners[node];
+        };
+        for (size_t node = size - 1; node > 0; --node) {
+            auto winner = winnerAt(2 * node);
+            auto loser = winnerAt(2 * node + 1);
+            if (_less(loser, winner)) {
+                std::swap(winner, loser);
+            }
+            winners[node] = winner;
+            _nodes[node] = loser;
+        }
+        _nodes[0] = winnerAt(1);
+    }
+
+    /**
+     * Plays the matches of the winning stream again after its head changed.
+     */
+    void replayTop() {
+        auto winner = top();
+        for (size_t node = (_size + winner) / 2; node > 0; node /= 2) {
+            if (_less(_nodes[node], winner)) {
+                std::swap(_nodes[node], winner);
+            }
+        }
+        _nodes[0] = winner;
+    }
+
+private:
+    Less _less;
+
+    size_t _size = 0;
+
+    // The winner of the whole tree, followed by the loser of the match at each inner node.
+    std::vector<size_t> _nodes;
+};
+
+}  // namespace mongo
@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/loser_tree.h"
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include "mongo/platform/random.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Streams = std::vector<std::deque<int>>;
+
+struct StreamLess {
+    bool operator()(size_t lhs, size_t rhs) const {
+        if ((*streams)[lhs].empty() || (*streams)[rhs].empty()) {
+            return !(*streams)[lhs].empty();
+        }
+        return (*streams)[lhs].front() < (*streams)[rhs].front();
+    }
+
+    const Streams* streams;
+};
+
+/**
+ * Merges 'streams' through a LoserTree and checks that the result is sorted and contains all of
+ * their values.
+ */
+void assertMergesInOrder(Streams streams) {
+    std::vector<int> expected;
+    for (const auto& stream : streams) {
+        expected.insert(expected.end(), stream.begin(), stream.end());
+    }
+    std::sort(expected.begin(), expected.end());
+
+    LoserTree<StreamLess> tree(StreamLess{&streams});
+    tree.rebuild(streams.size());
+
+    std::vector<int> merged;
+    while (!streams.empty() && !streams[tree.top()].empty()) {
+        merged.push_back(streams[tree.top()].front());
+        streams[tree.top()].pop_front();
+        tree.replayTop();
+    }
+
+    ASSERT(merged == expected);
+}
+
+TEST(LoserTreeTest, NoStreams) {
+    assertMergesInOrder({});
+}
+
+TEST(LoserTreeTest, SingleStream) {
+    assertMergesInOrder({{1, 2, 2, 5}});
+}
+
+TEST(LoserTreeTest, EmptyStreams) {
+    assertMergesInOrder({{}, {3}, {}, {}, {1, 4}});
+}
+
+TEST(LoserTreeTest, RandomStreams) {
+    PseudoRandom random(1);
+    for (size_t numStreams = 1; numStreams <= 17; ++numStreams) {
+        Streams streams(numStreams);
+        for (auto& stream : streams) {
+            const auto size = random.nextInt32(20);
+            for (int i = 0; i < size; ++i) {
+                stream.push_back(random.nextInt32(50));
+            }
+            std::sort(stream.begin(), stream.end());
+        }
+        assertMergesInOrder(std::move(streams));
+    }
+}
+
+TEST(LoserTreeTest, RebuildAfterEmptyStreamIsRefilled) {
+    Streams streams{{2, 6}, {}, {4}};
+    LoserTree<StreamLess> tree(StreamLess{&streams});
+    tree.rebuild(streams.size());
+
+    ASSERT_EQ(0U, tree.top());
+    streams[0].pop_front();
+    tree.replayTop();
+    ASSERT_EQ(2U, tree.top());
+
+    // The head of a stream other than the winner changed, so every match has to be played again.
+    streams[1].push_back(3);
+    tree.rebuild(streams.size());
+    ASSERT_EQ(1U, tree.top());
+    streams[1].pop_front();
+    tree.replayTop();
+    ASSERT_EQ(2U, tree.top());
+    streams[2].pop_front();
+    tree.replayTop();
+    ASSERT_EQ(0U, tree.top());
+    streams[0].pop_front();
+    tree.replayTop();
+    ASSERT(streams[tree.top()].empty());
+}
+
+}  // namespace
+}  // namespace mongo
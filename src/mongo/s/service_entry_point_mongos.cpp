@@ -39,6 +39,7 @@
 #include "mongo/db/dbmessage.h"
 #include "mongo/db/lasterror.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/operation_trace.h"
 #include "mongo/db/service_context.h"
 #include "mongo/rpc/message.h"
 #include "mongo/s/client/shard_connection.h"
@@ -58,6 +59,35 @@ BSONObj buildErrReply(const DBException& ex) {
     return errB.obj();
 }
 
+/**
+ * Closes the trace of the operation if it is being traced, attaching the operation's totals to its
+ * root span.
+ */
+void finishOperationTrace(OperationContext* opCtx) {
+    auto& trace = OperationTrace::get(opCtx);
+    if (!trace.isActive()) {
+        return;
+    }
+
+    auto curOp = CurOp::get(opCtx);
+    const auto& debug = curOp->debug();
+    BSONObjBuilder attributes;
+    attributes.append("ns", curOp->getNS());
+    if (debug.nShards >= 0) {
+        attributes.append("nShards", debug.nShards);
+    }
+    if (debug.nreturned >= 0) {
+        attributes.append("nreturned", debug.nreturned);
+    }
+    if (debug.responseLength >= 0) {
+        attributes.append("responseLength", debug.responseLength);
+    }
+    if (!debug.errInfo.isOK()) {
+        attributes.append("errCode", debug.errInfo.code());
+    }
+    trace.finish(attributes.obj());
+}
+
 }  // namespace
 
 
@@ -98,6 +128,8 @@ DbResponse ServiceEntryPointMongos::handleRequest(OperationContext* opCtx, const
         CurOp::get(opCtx)->completeAndLogOperation(
             opCtx, logger::LogComponent::kCommand, dbResponse.response.size());
 
+        finishOperationTrace(opCtx);
+
         return dbResponse;
     }
 
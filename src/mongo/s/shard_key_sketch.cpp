@@ -0,0 +1,195 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/shard_key_sketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/platform/random.h"
+
+namespace mongo {
+
+struct ShardKeySketch::State {
+    struct Sample {
+        // Weighted reservoir sampling priority (Efraimidis-Spirakis): the kCapacity samples with
+        // the highest priority are retained. Kept as log(u) / weight to avoid underflow.
+        double priority;
+        BSONObj shardKey;
+    };
+
+    struct LowerPriority {
+        bool operator()(const Sample& lhs, const Sample& rhs) const {
+            return lhs.priority > rhs.priority;
+        }
+    };
+
+    State() : random(SecureRandom().nextInt64()) {}
+
+    PseudoRandom random;
+
+    // Min-heap on priority, so that the top is the sample to evict next
+    std::vector<Sample> samples;
+
+    uint64_t bytesObserved{0};
+};
+
+ShardKeySketch::ShardKeySketch() = default;
+
+ShardKeySketch::~ShardKeySketch() = default;
+
+void ShardKeySketch::add(const BSONObj& shardKey, uint64_t bytes) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    if (!_state) {
+        _state = std::make_unique<State>();
+    }
+
+    _state->bytesObserved += bytes;
+
+    // The random number must be in (0, 1] for its logarithm to be defined
+    const double u = 1.0 - _state->random.nextCanonicalDouble();
+    const double priority = std::log(u) / std::max<uint64_t>(bytes, 1);
+
+    auto& samples = _state->samples;
+    if (samples.size() == kCapacity) {
+        if (priority <= samples.front().priority) {
+            return;
+        }
+
+        std::pop_heap(samples.begin(), samples.end(), State::LowerPriority());
+        samples.pop_back();
+    }
+
+    samples.push_back({priority, shardKey.getOwned()});
+    std::push_heap(samples.begin(), samples.end(), State::LowerPriority());
+}
+
+void ShardKeySketch::inheritFrom(const ShardKeySketch& other,
+                                 const BSONObj& min,
+                                 const BSONObj& max) {
+    std::vector<State::Sample> inheritedSamples;
+    uint64_t inheritedBytes = 0;
+
+    {
+        stdx::lock_guard<Latch> lk(other._mutex);
+        if (!other._state || other._state->samples.empty()) {
+            return;
+        }
+
+        const auto& otherSamples = other._state->samples;
+        for (const auto& sample : otherSamples) {
+            if (SimpleBSONObjComparator::kInstance.evaluate(sample.shardKey >= min) &&
+                SimpleBSONObjComparator::kInstance.evaluate(sample.shardKey < max)) {
+                inheritedSamples.push_back(sample);
+            }
+        }
+
+        inheritedBytes = static_cast<uint64_t>(static_cast<double>(other._state->bytesObserved) *
+                                               inheritedSamples.size() / otherSamples.size());
+    }
+
+    if (inheritedSamples.empty()) {
+        return;
+    }
+
+    std::make_heap(inheritedSamples.begin(), inheritedSamples.end(), State::LowerPriority());
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    invariant(!_state);
+    _state = std::make_unique<State>();
+    _state->samples = std::move(inheritedSamples);
+    _state->bytesObserved = inheritedBytes;
+}
+
+uint64_t ShardKeySketch::getBytesObserved() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _state ? _state->bytesObserved : 0;
+}
+
+size_t ShardKeySketch::numSamples() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _state ? _state->samples.size() : 0;
+}
+
+std::vector<BSONObj> ShardKeySketch::getSplitPoints(const BSONObj& chunkMin,
+                                                    uint64_t pieceBytes) const {
+    invariant(pieceBytes > 0);
+
+    std::vector<BSONObj> sortedKeys;
+    uint64_t bytesObserved;
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!_state || _state->samples.size() < kMinSamplesForSplitPoints) {
+            return {};
+        }
+
+        bytesObserved = _state->bytesObserved;
+        for (const auto& sample : _state->samples) {
+            sortedKeys.push_back(sample.shardKey);
+        }
+    }
+
+    const uint64_t numPieces = bytesObserved / pieceBytes;
+    if (numPieces < 2) {
+        return {};
+    }
+
+    // Every split point must be backed by several samples, otherwise the pieces it produces could
+    // be far from the requested size
+    if (numPieces * 2 > sortedKeys.size()) {
+        return {};
+    }
+
+    std::sort(
+        sortedKeys.begin(), sortedKeys.end(), SimpleBSONObjComparator::kInstance.makeLessThan());
+
+    std::vector<BSONObj> splitPoints;
+    for (uint64_t piece = 1; piece < numPieces; piece++) {
+        const auto& splitPoint = sortedKeys[piece * sortedKeys.size() / numPieces];
+
+        const auto& lowerBound = splitPoints.empty() ? chunkMin : splitPoints.back();
+        if (!SimpleBSONObjComparator::kInstance.evaluate(lowerBound < splitPoint)) {
+            // Repeated keys, such as from a low-cardinality shard key, leave some pieces empty
+            return {};
+        }
+
+        splitPoints.push_back(splitPoint);
+    }
+
+    return splitPoints;
+}
+
+}  // namespace mongo
@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+
+/**
+ * A small streaming sketch of the shard key values written to a chunk, from which the keys that
+ * divide the chunk's data into pieces of a given size can be estimated without scanning the shard
+ * key index.
+ *
+ * The sketch keeps a fixed-size weighted reservoir sample of the inserted shard keys, where every
+ * key is weighted by the size of its document, so that each sampled key stands for roughly the
+ * same number of bytes and the quantiles of the sample approximate the quantiles of the data.
+ *
+ * All methods are thread-safe.
+ */
+class ShardKeySketch {
+    ShardKeySketch(const ShardKeySketch&) = delete;
+    ShardKeySketch& operator=(const ShardKeySketch&) = delete;
+
+public:
+    /**
+     * The number of shard keys retained by the sketch.
+     */
+    static constexpr size_t kCapacity = 128;
+
+    /**
+     * The minimum number of shard keys the sketch must hold before it is used to pick split
+     * points.
+     */
+    static constexpr size_t kMinSamplesForSplitPoints = 32;
+
+    ShardKeySketch();
+    ~ShardKeySketch();
+
+    /**
+     * Records a document of 'bytes' bytes with the given shard key as written to the chunk.
+     */
+    void add(const BSONObj& shardKey, uint64_t bytes);
+
+    /**
+     * Seeds this sketch, which must be empty, with the samples of 'other' falling within the range
+     * [min, max), and with the share of the bytes observed by 'other' that they represent. Used to
+     * carry the sketch of a chunk over to the chunks it gets split into.
+     */
+    void inheritFrom(const ShardKeySketch& other, const BSONObj& min, const BSONObj& max);
+
+    /**
+     * Returns the total number of bytes the sketch has observed.
+     */
+    uint64_t getBytesObserved() const;
+
+    /**
+     * Returns the number of shard keys currently retained by the sketch.
+     */
+    size_t numSamples() const;
+
+    /**
+     * Returns the keys, which split the data observed by the sketch into pieces of about
+     * 'pieceBytes' bytes each, in ascending order and all greater than 'chunkMin'. Returns an
+     * empty vector if the sketch has not observed enough data for more than one piece, or if it
+     * cannot tell the split points apart reliably (for example, because there are too few distinct
+     * keys), in which case the split points must be found by scanning the data instead.
+     */
+    std::vector<BSONObj> getSplitPoints(const BSONObj& chunkMin, uint64_t pieceBytes) const;
+
+private:
+    struct State;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ShardKeySketch::_mutex");
+
+    // Allocated on the first write, so that chunks which are never written to stay cheap
+    std::unique_ptr<State> _state;
+};
+
+}  // namespace mongo
@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/shard_key_sketch.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const BSONObj kChunkMin = BSON("x" << MINKEY);
+const BSONObj kChunkMax = BSON("x" << MAXKEY);
+
+TEST(ShardKeySketchTest, EmptySketchHasNoSplitPoints) {
+    ShardKeySketch sketch;
+    ASSERT_EQ(sketch.getBytesObserved(), 0ull);
+    ASSERT_EQ(sketch.numSamples(), 0u);
+    ASSERT(sketch.getSplitPoints(kChunkMin, 1024).empty());
+}
+
+TEST(ShardKeySketchTest, RetainsAtMostCapacitySamples) {
+    ShardKeySketch sketch;
+    for (int i = 0; i < 1000; i++) {
+        sketch.add(BSON("x" << i), 10);
+    }
+    ASSERT_EQ(sketch.getBytesObserved(), 10000ull);
+    ASSERT_EQ(sketch.numSamples(), ShardKeySketch::kCapacity);
+}
+
+TEST(ShardKeySketchTest, NoSplitPointsBeforeTwoPiecesWorthOfData) {
+    ShardKeySketch sketch;
+    for (int i = 0; i < 1000; i++) {
+        sketch.add(BSON("x" << i), 10);
+    }
+    ASSERT(sketch.getSplitPoints(kChunkMin, 6000).empty());
+}
+
+TEST(ShardKeySketchTest, SplitPointsFollowUniformDistribution) {
+    ShardKeySketch sketch;
+    for (int i = 0; i < 10000; i++) {
+        sketch.add(BSON("x" << i), 10);
+    }
+
+    // 100000 bytes observed in pieces of 25000 bytes gives 4 pieces, split around the quartiles
+    const auto splitPoints = sketch.getSplitPoints(kChunkMin, 25000);
+    ASSERT_EQ(splitPoints.size(), 3u);
+    for (size_t i = 0; i < splitPoints.size(); i++) {
+        const int expected = 2500 * (i + 1);
+        const int actual = splitPoints[i]["x"].numberInt();
+        ASSERT_GT(actual, expected - 1500);
+        ASSERT_LT(actual, expected + 1500);
+    }
+}
+
+TEST(ShardKeySketchTest, SplitPointsAreWeightedByDocumentSize) {
+    ShardKeySketch sketch;
+
+    // Keys below 1000 have documents 9 times as large as those above, so they hold 90% of the data
+    for (int i = 0; i < 2000; i++) {
+        sketch.add(BSON("x" << i), i < 1000 ? 90 : 10);
+    }
+
+    const auto splitPoints = sketch.getSplitPoints(kChunkMin, 50000);
+    ASSERT_EQ(splitPoints.size(), 1u);
+    ASSERT_LT(splitPoints[0]["x"].numberInt(), 1000);
+}
+
+TEST(ShardKeySketchTest, NoSplitPointsForLowCardinalityKeys) {
+    ShardKeySketch sketch;
+    for (int i = 0; i < 1000; i++) {
+        sketch.add(BSON("x" << i % 2), 100);
+    }
+    ASSERT(sketch.getSplitPoints(kChunkMin, 10000).empty());
+}
+
+TEST(ShardKeySketchTest, InheritFromKeepsSamplesInRange) {
+    ShardKeySketch parent;
+    for (int i = 0; i < 1000; i++) {
+        parent.add(BSON("x" << i), 10);
+    }
+
+    ShardKeySketch lower;
+    lower.inheritFrom(parent, kChunkMin, BSON("x" << 500));
+    ShardKeySketch upper;
+    upper.inheritFrom(parent, BSON("x" << 500), kChunkMax);
+
+    ASSERT_EQ(lower.numSamples() + upper.numSamples(), parent.numSamples());
+    ASSERT_GT(lower.numSamples(), 0u);
+    ASSERT_GT(upper.numSamples(), 0u);
+
+    // The observed bytes are divided in proportion to the inherited samples, up to rounding
+    ASSERT_LTE(lower.getBytesObserved() + upper.getBytesObserved(), parent.getBytesObserved());
+    ASSERT_GTE(lower.getBytesObserved() + upper.getBytesObserved(),
+               parent.getBytesObserved() - 2);
+
+    for (const auto& splitPoint : upper.getSplitPoints(BSON("x" << 500), 1000)) {
+        ASSERT_GTE(splitPoint["x"].numberInt(), 500);
+    }
+}
+
+TEST(ShardKeySketchTest, InheritFromEmptySketch) {
+    ShardKeySketch parent;
+    ShardKeySketch child;
+    child.inheritFrom(parent, kChunkMin, kChunkMax);
+    ASSERT_EQ(child.numSamples(), 0u);
+
+    child.add(BSON("x" << 1), 10);
+    ASSERT_EQ(child.numSamples(), 1u);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -33,6 +33,8 @@
 
 #include "mongo/s/sharding_task_executor.h"
 
+#include <algorithm>
+
 #include "mongo/base/status_with.h"
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/logical_time.h"
@@ -52,120 +54,61 @@ namespace mongo {
 namespace executor {
 
 namespace {
-const std::string kOperationTimeField = "operationTime";
-}
-
-ShardingTaskExecutor::ShardingTaskExecutor(std::unique_ptr<ThreadPoolTaskExecutor> executor)
-    : _executor(std::move(executor)) {}
 
-void ShardingTaskExecutor::startup() {
-    _executor->startup();
-}
-
-void ShardingTaskExecutor::shutdown() {
-    _executor->shutdown();
-}
-
-void ShardingTaskExecutor::join() {
-    _executor->join();
-}
-
-void ShardingTaskExecutor::appendDiagnosticBSON(mongo::BSONObjBuilder* builder) const {
-    _executor->appendDiagnosticBSON(builder);
-}
-
-Date_t ShardingTaskExecutor::now() {
-    return _executor->now();
-}
-
-StatusWith<TaskExecutor::EventHandle> ShardingTaskExecutor::makeEvent() {
-    return _executor->makeEvent();
-}
-
-void ShardingTaskExecutor::signalEvent(const EventHandle& event) {
-    return _executor->signalEvent(event);
-}
-
-StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::onEvent(const EventHandle& event,
-                                                                       CallbackFn&& work) {
-    return _executor->onEvent(event, std::move(work));
-}
-
-void ShardingTaskExecutor::waitForEvent(const EventHandle& event) {
-    _executor->waitForEvent(event);
-}
-
-StatusWith<stdx::cv_status> ShardingTaskExecutor::waitForEvent(OperationContext* opCtx,
-                                                               const EventHandle& event,
-                                                               Date_t deadline) {
-    return _executor->waitForEvent(opCtx, event, deadline);
-}
-
-StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleWork(CallbackFn&& work) {
-    return _executor->scheduleWork(std::move(work));
-}
-
-StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleWorkAt(Date_t when,
-                                                                              CallbackFn&& work) {
-    return _executor->scheduleWorkAt(when, std::move(work));
-}
+const std::string kOperationTimeField = "operationTime";
 
-StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleRemoteCommandOnAny(
-    const RemoteCommandRequestOnAny& request,
-    const RemoteCommandOnAnyCallbackFn& cb,
-    const BatonHandle& baton) {
+/**
+ * Returns a copy of "request" with the logical session id of its operation attached, or boost::none
+ * if "request" can be sent as is.
+ */
+boost::optional<RemoteCommandRequestOnAny> makeRequestWithFixedLsid(
+    const RemoteCommandRequestOnAny& request) {
+    boost::optional<RemoteCommandRequestOnAny> newRequest;
 
-    // schedule the user's callback if there is not opCtx
-    if (!request.opCtx) {
-        return _executor->scheduleRemoteCommandOnAny(request, cb, baton);
+    if (!request.opCtx->getLogicalSessionId()) {
+        return newRequest;
     }
 
-    boost::optional<RemoteCommandRequestOnAny> requestWithFixedLsid = [&] {
-        boost::optional<RemoteCommandRequestOnAny> newRequest;
+    if (request.cmdObj.hasField("lsid")) {
+        auto cmdObjLsid = LogicalSessionFromClient::parse("lsid"_sd, request.cmdObj["lsid"].Obj());
 
-        if (!request.opCtx->getLogicalSessionId()) {
+        if (cmdObjLsid.getUid()) {
+            invariant(*cmdObjLsid.getUid() == request.opCtx->getLogicalSessionId()->getUid());
             return newRequest;
         }
 
-        if (request.cmdObj.hasField("lsid")) {
-            auto cmdObjLsid =
-                LogicalSessionFromClient::parse("lsid"_sd, request.cmdObj["lsid"].Obj());
-
-            if (cmdObjLsid.getUid()) {
-                invariant(*cmdObjLsid.getUid() == request.opCtx->getLogicalSessionId()->getUid());
-                return newRequest;
-            }
-
-            newRequest.emplace(request);
-            newRequest->cmdObj = newRequest->cmdObj.removeField("lsid");
-        }
+        newRequest.emplace(request);
+        newRequest->cmdObj = newRequest->cmdObj.removeField("lsid");
+    }
 
-        if (!newRequest) {
-            newRequest.emplace(request);
-        }
+    if (!newRequest) {
+        newRequest.emplace(request);
+    }
 
-        BSONObjBuilder bob(std::move(newRequest->cmdObj));
-        {
-            BSONObjBuilder subbob(bob.subobjStart("lsid"));
-            request.opCtx->getLogicalSessionId()->serialize(&subbob);
-            subbob.done();
-        }
+    BSONObjBuilder bob(std::move(newRequest->cmdObj));
+    {
+        BSONObjBuilder subbob(bob.subobjStart("lsid"));
+        request.opCtx->getLogicalSessionId()->serialize(&subbob);
+        subbob.done();
+    }
 
-        newRequest->cmdObj = bob.obj();
+    newRequest->cmdObj = bob.obj();
 
-        return newRequest;
-    }();
+    return newRequest;
+}
 
-    std::shared_ptr<OperationTimeTracker> timeTracker = OperationTimeTracker::get(request.opCtx);
+/**
+ * Wraps "cb" to update the replica set monitors, the operation time and the getLastError info of
+ * the client of "opCtx" from the responses to the remote commands it is called for.
+ */
+TaskExecutor::RemoteCommandOnAnyCallbackFn makeShardingCallback(
+    OperationContext* opCtx, const TaskExecutor::RemoteCommandOnAnyCallbackFn& cb) {
+    std::shared_ptr<OperationTimeTracker> timeTracker = OperationTimeTracker::get(opCtx);
 
-    auto clusterGLE = ClusterLastErrorInfo::get(request.opCtx->getClient());
+    auto clusterGLE = ClusterLastErrorInfo::get(opCtx->getClient());
 
-    auto shardingCb = [timeTracker,
-                       clusterGLE,
-                       cb,
-                       grid = Grid::get(request.opCtx),
-                       hosts = request.target](
-                          const TaskExecutor::RemoteCommandOnAnyCallbackArgs& args) {
+    return [timeTracker, clusterGLE, cb, grid = Grid::get(opCtx)](
+               const TaskExecutor::RemoteCommandOnAnyCallbackArgs& args) {
         ON_BLOCK_EXIT([&cb, &args]() { cb(args); });
 
         if (!args.response.isOK()) {
@@ -174,7 +117,7 @@ StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleRemoteCom
             if (args.response.target) {
                 target = *args.response.target;
             } else {
-                target = hosts.front();
+                target = args.request.target.front();
             }
 
             auto shard = grid->shardRegistry()->getShardForHostNoReload(target);
@@ -241,9 +184,115 @@ StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleRemoteCom
             }
         }
     };
+}
+
+}  // namespace
+
+ShardingTaskExecutor::ShardingTaskExecutor(std::unique_ptr<ThreadPoolTaskExecutor> executor)
+    : _executor(std::move(executor)) {}
+
+void ShardingTaskExecutor::startup() {
+    _executor->startup();
+}
+
+void ShardingTaskExecutor::shutdown() {
+    _executor->shutdown();
+}
+
+void ShardingTaskExecutor::join() {
+    _executor->join();
+}
+
+void ShardingTaskExecutor::appendDiagnosticBSON(mongo::BSONObjBuilder* builder) const {
+    _executor->appendDiagnosticBSON(builder);
+}
+
+Date_t ShardingTaskExecutor::now() {
+    return _executor->now();
+}
+
+StatusWith<TaskExecutor::EventHandle> ShardingTaskExecutor::makeEvent() {
+    return _executor->makeEvent();
+}
+
+void ShardingTaskExecutor::signalEvent(const EventHandle& event) {
+    return _executor->signalEvent(event);
+}
+
+StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::onEvent(const EventHandle& event,
+                                                                       CallbackFn&& work) {
+    return _executor->onEvent(event, std::move(work));
+}
+
+void ShardingTaskExecutor::waitForEvent(const EventHandle& event) {
+    _executor->waitForEvent(event);
+}
+
+StatusWith<stdx::cv_status> ShardingTaskExecutor::waitForEvent(OperationContext* opCtx,
+                                                               const EventHandle& event,
+                                                               Date_t deadline) {
+    return _executor->waitForEvent(opCtx, event, deadline);
+}
+
+StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleWork(CallbackFn&& work) {
+    return _executor->scheduleWork(std::move(work));
+}
+
+StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleWorkAt(Date_t when,
+                                                                              CallbackFn&& work) {
+    return _executor->scheduleWorkAt(when, std::move(work));
+}
+
+StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleRemoteCommandOnAny(
+    const RemoteCommandRequestOnAny& request,
+    const RemoteCommandOnAnyCallbackFn& cb,
+    const BatonHandle& baton) {
+
+    // schedule the user's callback if there is not opCtx
+    if (!request.opCtx) {
+        return _executor->scheduleRemoteCommandOnAny(request, cb, baton);
+    }
+
+    auto requestWithFixedLsid = makeRequestWithFixedLsid(request);
 
     return _executor->scheduleRemoteCommandOnAny(
-        requestWithFixedLsid ? *requestWithFixedLsid : request, shardingCb, baton);
+        requestWithFixedLsid ? *requestWithFixedLsid : request,
+        makeShardingCallback(request.opCtx, cb),
+        baton);
+}
+
+std::vector<StatusWith<TaskExecutor::CallbackHandle>>
+ShardingTaskExecutor::scheduleRemoteCommandsOnAny(
+    const std::vector<RemoteCommandRequestOnAny>& requests,
+    const RemoteCommandOnAnyCallbackFn& cb,
+    const BatonHandle& baton) {
+    if (requests.empty()) {
+        return {};
+    }
+
+    // The whole batch shares a callback, which is bound to the operation context of the requests.
+    auto opCtx = requests.front().opCtx;
+    if (std::any_of(requests.begin(), requests.end(), [&](const auto& request) {
+            return request.opCtx != opCtx;
+        })) {
+        return TaskExecutor::scheduleRemoteCommandsOnAny(requests, cb, baton);
+    }
+
+    // schedule the user's callback if there is not opCtx
+    if (!opCtx) {
+        return _executor->scheduleRemoteCommandsOnAny(requests, cb, baton);
+    }
+
+    std::vector<RemoteCommandRequestOnAny> requestsWithFixedLsids;
+    requestsWithFixedLsids.reserve(requests.size());
+    for (const auto& request : requests) {
+        auto requestWithFixedLsid = makeRequestWithFixedLsid(request);
+        requestsWithFixedLsids.push_back(requestWithFixedLsid ? std::move(*requestWithFixedLsid)
+                                                              : request);
+    }
+
+    return _executor->scheduleRemoteCommandsOnAny(
+        requestsWithFixedLsids, makeShardingCallback(opCtx, cb), baton);
 }
 
 void ShardingTaskExecutor::cancel(const CallbackHandle& cbHandle) {
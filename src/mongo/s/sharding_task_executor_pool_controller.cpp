@@ -97,6 +97,29 @@ Status ShardingTaskExecutorPoolController::onUpdateMatchingStrategy(const std::s
     return Status::OK();
 }
 
+size_t ShardingTaskExecutorPoolController::DemandHistory::update(Date_t now,
+                                                                Milliseconds window,
+                                                                size_t demand) {
+    const long long periodMS =
+        std::max(durationCount<Milliseconds>(window) / static_cast<long long>(kNumBuckets), 1LL);
+    const long long elapsed =
+        std::max(durationCount<Milliseconds>(now - _currentStart), 0LL) / periodMS;
+    if (elapsed >= static_cast<long long>(kNumBuckets)) {
+        // The whole window has passed since the last update
+        _peaks.fill(0);
+        _currentStart = now;
+    } else {
+        for (long long i = 0; i < elapsed; ++i) {
+            _current = (_current + 1) % kNumBuckets;
+            _peaks[_current] = 0;
+        }
+        _currentStart += Milliseconds(periodMS * elapsed);
+    }
+
+    _peaks[_current] = std::max(_peaks[_current], demand);
+    return *std::max_element(_peaks.begin(), _peaks.end());
+}
+
 void ShardingTaskExecutorPoolController::_addGroup(WithLock,
                                                    const ReplicaSetChangeNotifier::State& state) {
     auto groupData = std::make_shared<GroupData>(state);
@@ -211,6 +234,11 @@ auto ShardingTaskExecutorPoolController::updateHost(PoolId id, const HostState&
     // Update the target for just the pool first
     poolData.target = stats.requests + stats.active;
 
+    if (auto demandHistoryMS = gParameters.demandHistoryMS.load(); demandHistoryMS > 0) {
+        poolData.target = poolData.demandHistory.update(
+            now(), Milliseconds{demandHistoryMS}, poolData.target);
+    }
+
     if (poolData.target < minConns) {
         poolData.target = minConns;
     } else if (poolData.target > maxConns) {
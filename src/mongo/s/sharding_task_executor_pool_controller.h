@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <boost/optional.hpp>
 
 #include "mongo/base/status.h"
@@ -59,6 +60,12 @@ namespace mongo {
  * When the MatchingStrategy is kMatchBusiestNode, it operates like kMatchPrimaryNode, but any pool
  * can be responsible for increasing the targetConnections of each member of its set.
  *
+ * Independently of the MatchingStrategy, when demandHistoryMS in its Parameters is positive, the
+ * target for each pool is no lower than the peak demand (requests plus active connections) the
+ * pool saw over that period. After a burst, the pool thus keeps enough connections warm for the
+ * next one, rather than letting them lapse and paying for connection setup and authentication
+ * again when the burst returns.
+ *
  * Note that, in essence, there are three outside elements that can mutate the state of this class:
  * * The ReplicaSetChangeNotifier can notify the listener which updates the host groups
  * * The ServerParameters can update the Parameters which will used in the next update
@@ -87,6 +94,8 @@ public:
         AtomicWord<int> pendingTimeoutMS;
         AtomicWord<int> toRefreshTimeoutMS;
 
+        AtomicWord<int> demandHistoryMS;
+
         synchronized_value<std::string> matchingStrategyString;
         AtomicWord<MatchingStrategy> matchingStrategy;
     };
@@ -133,6 +142,27 @@ private:
     void _addGroup(WithLock, const ReplicaSetChangeNotifier::State& state);
     void _removeGroup(WithLock, const std::string& key);
 
+    /**
+     * DemandHistory remembers the peak demand of a pool over a sliding window.
+     *
+     * The window is split into kNumBuckets periods, and each bucket holds the peak demand seen
+     * during its period. The oldest bucket is recycled as each period starts.
+     */
+    class DemandHistory {
+    public:
+        static constexpr size_t kNumBuckets = 8;
+
+        /**
+         * Records 'demand' at time 'now', and returns the peak demand over the last 'window'.
+         */
+        size_t update(Date_t now, Milliseconds window, size_t demand);
+
+    private:
+        std::array<size_t, kNumBuckets> _peaks{};
+        size_t _current = 0;
+        Date_t _currentStart;
+    };
+
     /**
      * GroupData is a shared state for a set of hosts (a replica set).
      *
@@ -176,6 +206,9 @@ private:
         // The number of connections the host should maintain
         size_t target = 0;
 
+        // Recent peak demand on this host, for pre-warming
+        DemandHistory demandHistory;
+
         // This host is able to shutdown
         bool isAbleToShutdown = false;
     };
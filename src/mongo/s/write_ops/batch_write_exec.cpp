@@ -33,27 +33,39 @@
 
 #include "mongo/s/write_ops/batch_write_exec.h"
 
+#include <algorithm>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/base/owned_pointer_map.h"
 #include "mongo/base/status.h"
+#include "mongo/base/counter.h"
 #include "mongo/base/transaction_error.h"
 #include "mongo/bson/util/builder.h"
 #include "mongo/client/connection_string.h"
 #include "mongo/client/remote_command_targeter.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/executor/task_executor_pool.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/multi_statement_transaction_requests_sender.h"
 #include "mongo/s/transaction_router.h"
 #include "mongo/s/write_ops/batch_write_op.h"
+#include "mongo/s/write_ops/insert_batch_coalescer.h"
+#include "mongo/s/write_ops/insert_batch_coalescer_gen.h"
 #include "mongo/s/write_ops/write_error_detail.h"
 #include "mongo/util/log.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
 
 const ReadPreferenceSetting kPrimaryOnlyReadPreference(ReadPreference::PrimaryOnly);
 
+// Cumulative time mongos spent targeting the writes of batches to shards.
+Counter64 writeTargetingMicros;
+ServerStatusMetricField<Counter64> displayWriteTargetingMicros("query.writeTargetingMicros",
+                                                               &writeTargetingMicros);
+
 //
 // Map which allows associating ConnectionString hosts with TargetedWriteBatches
 // This is needed since the dispatcher only returns hosts with responses.
@@ -158,7 +170,11 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
         // If we've already had a targeting error, we've refreshed the metadata once and can
         // record target errors definitively.
         bool recordTargetErrors = refreshedTargeter;
+        Timer targetingTimer;
         Status targetStatus = batchOp.targetBatch(targeter, recordTargetErrors, &childBatches);
+        const auto targetingMicros = targetingTimer.micros();
+        stats->targetingMicros += targetingMicros;
+        writeTargetingMicros.increment(targetingMicros);
         if (!targetStatus.isOK()) {
             // Don't do anything until a targeter refresh
             targeter.noteCouldNotTarget();
@@ -197,6 +213,10 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
 
             std::vector<AsyncRequestsSender::Request> requests;
 
+            // Batches sent together with the batches of other operations
+            std::vector<InsertBatchCoalescer::Ticket> coalescedBatches;
+            const Microseconds coalescingWindow(gInsertBatchCoalescingWindowMicros.load());
+
             // Get as many batches as we can at once
             for (auto& childBatch : childBatches) {
                 TargetedWriteBatch* const nextBatch = childBatch.second;
@@ -213,29 +233,39 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
 
                 stats->noteTargetedShard(targetShardId);
 
-                const auto request = [&] {
-                    const auto shardBatchRequest(batchOp.buildBatchRequest(*nextBatch));
+                const auto shardBatchRequest(batchOp.buildBatchRequest(*nextBatch));
 
-                    BSONObjBuilder requestBuilder;
-                    shardBatchRequest.serialize(&requestBuilder);
+                if (coalescingWindow > Microseconds(0) &&
+                    InsertBatchCoalescer::canCoalesce(opCtx, shardBatchRequest)) {
+                    LOG(4) << "Coalescing write batch to " << targetShardId << ": "
+                           << redact(shardBatchRequest.toBSON());
 
-                    {
-                        OperationSessionInfo sessionInfo;
+                    coalescedBatches.push_back(InsertBatchCoalescer::get(opCtx)->join(
+                        targetShardId, shardBatchRequest, coalescingWindow));
+                } else {
+                    const auto request = [&] {
+                        BSONObjBuilder requestBuilder;
+                        shardBatchRequest.serialize(&requestBuilder);
 
-                        if (opCtx->getLogicalSessionId()) {
-                            sessionInfo.setSessionId(*opCtx->getLogicalSessionId());
-                        }
+                        {
+                            OperationSessionInfo sessionInfo;
 
-                        sessionInfo.setTxnNumber(opCtx->getTxnNumber());
-                        sessionInfo.serialize(&requestBuilder);
-                    }
+                            if (opCtx->getLogicalSessionId()) {
+                                sessionInfo.setSessionId(*opCtx->getLogicalSessionId());
+                            }
 
-                    return requestBuilder.obj();
-                }();
+                            sessionInfo.setTxnNumber(opCtx->getTxnNumber());
+                            sessionInfo.serialize(&requestBuilder);
+                        }
 
-                LOG(4) << "Sending write batch to " << targetShardId << ": " << redact(request);
+                        return requestBuilder.obj();
+                    }();
 
-                requests.emplace_back(targetShardId, request);
+                    LOG(4) << "Sending write batch to " << targetShardId << ": "
+                           << redact(request);
+
+                    requests.emplace_back(targetShardId, request);
+                }
 
                 // Indicate we're done by setting the batch to nullptr. We'll only get duplicate
                 // hostEndpoints if we have broadcast and non-broadcast endpoints for the same host,
@@ -257,13 +287,26 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                 isRetryableWrite ? Shard::RetryPolicy::kIdempotent : Shard::RetryPolicy::kNoRetry);
             numSent += pendingBatches.size();
 
+            // The groups led by this operation are sent while waiting on their tickets, so they
+            // must be waited on before the groups led by others.
+            std::stable_partition(coalescedBatches.begin(),
+                                  coalescedBatches.end(),
+                                  [](const auto& ticket) { return ticket.isLeader(); });
+            auto nextCoalescedBatch = coalescedBatches.begin();
+
             //
             // Receive the responses.
             //
 
-            while (!ars.done()) {
+            while (nextCoalescedBatch != coalescedBatches.end() || !ars.done()) {
                 // Block until a response is available.
-                auto response = ars.next();
+                auto response = [&] {
+                    if (nextCoalescedBatch != coalescedBatches.end()) {
+                        return InsertBatchCoalescer::get(opCtx)->wait(
+                            opCtx, std::move(*nextCoalescedBatch++));
+                    }
+                    return ars.next();
+                }();
 
                 // Get the TargetedWriteBatch to find where to put the response
                 dassert(pendingBatches.find(response.shardId) != pendingBatches.end());
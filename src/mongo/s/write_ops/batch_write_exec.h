@@ -90,7 +90,8 @@ public:
           numTargetErrors(0),
           numResolveErrors(0),
           numStaleShardBatches(0),
-          numStaleDbBatches(0) {}
+          numStaleDbBatches(0),
+          targetingMicros(0) {}
 
     void noteWriteAt(const HostAndPort& host, repl::OpTime opTime, const OID& electionId);
     void noteTargetedShard(const ShardId& shardId);
@@ -110,6 +111,8 @@ public:
     int numStaleShardBatches;
     // Number of stale batches due to StaleDbVersion
     int numStaleDbBatches;
+    // Time spent targeting the writes of the batch
+    long long targetingMicros;
 
 private:
     std::set<ShardId> _targetedShards;
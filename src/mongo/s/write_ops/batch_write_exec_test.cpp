@@ -42,8 +42,10 @@
 #include "mongo/s/write_ops/batch_write_exec.h"
 #include "mongo/s/write_ops/batched_command_request.h"
 #include "mongo/s/write_ops/batched_command_response.h"
+#include "mongo/s/write_ops/insert_batch_coalescer_gen.h"
 #include "mongo/s/write_ops/mock_ns_targeter.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -294,6 +296,37 @@ TEST_F(BatchWriteExecTest, SingleOp) {
     future.default_timed_get();
 }
 
+TEST_F(BatchWriteExecTest, SingleOpCoalesced) {
+    gInsertBatchCoalescingWindowMicros.store(1000);
+    ON_BLOCK_EXIT([] { gInsertBatchCoalescingWindowMicros.store(0); });
+
+    BatchedCommandRequest request([&] {
+        write_ops::Insert insertOp(nss);
+        insertOp.setWriteCommandBase([] {
+            write_ops::WriteCommandBase writeCommandBase;
+            writeCommandBase.setOrdered(false);
+            return writeCommandBase;
+        }());
+        insertOp.setDocuments({BSON("x" << 1), BSON("x" << 2)});
+        return insertOp;
+    }());
+    request.setWriteConcern(BSONObj());
+
+    // The batch is sent on its own once the coalescing window is over
+    auto future = launchAsync([&] {
+        BatchedCommandResponse response;
+        BatchWriteExecStats stats;
+        BatchWriteExec::executeBatch(operationContext(), nsTargeter, request, &response, &stats);
+        ASSERT(response.getOk());
+        ASSERT_EQ(2LL, response.getN());
+        ASSERT_EQ(1, stats.numRounds);
+    });
+
+    expectInsertsReturnSuccess(std::vector<BSONObj>{BSON("x" << 1), BSON("x" << 2)});
+
+    future.default_timed_get();
+}
+
 TEST_F(BatchWriteExecTest, MultiOpLarge) {
     const int kNumDocsToInsert = 100'000;
     const std::string kDocValue(200, 'x');
@@ -304,6 +304,23 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
+    // The remaining documents of unordered insert batches are all targeted at once, which is much
+    // cheaper than one at a time for large batches. Ordered batches stop at the first document
+    // that goes to another shard, so the following ones would be targeted again in the next round.
+    const bool targetInsertsTogether = !ordered && numWriteOps > 1 &&
+        _clientRequest.getBatchType() == BatchedCommandRequest::BatchType_Insert;
+    std::vector<StatusWith<ShardEndpoint>> insertEndpoints;
+    if (targetInsertsTogether) {
+        std::vector<BSONObj> docs;
+        for (const auto& writeOp : _writeOps) {
+            if (writeOp.getWriteState() == WriteOpState_Ready) {
+                docs.push_back(writeOp.getWriteItem().getDocument());
+            }
+        }
+        insertEndpoints = targeter.targetInserts(_opCtx, docs);
+    }
+    auto nextInsertEndpoint = insertEndpoints.begin();
+
     for (size_t i = 0; i < numWriteOps; ++i) {
         WriteOp& writeOp = _writeOps[i];
 
@@ -319,7 +336,9 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         OwnedPointerVector<TargetedWrite> writesOwned;
         vector<TargetedWrite*>& writes = writesOwned.mutableVector();
 
-        Status targetStatus = writeOp.targetWrites(_opCtx, targeter, &writes);
+        Status targetStatus = targetInsertsTogether
+            ? writeOp.targetWrites(_opCtx, targeter, std::move(*nextInsertEndpoint++), &writes)
+            : writeOp.targetWrites(_opCtx, targeter, &writes);
 
         if (!targetStatus.isOK()) {
             WriteErrorDetail targetError;
@@ -405,6 +405,48 @@ StatusWith<ShardEndpoint> ChunkManagerTargeter::targetInsert(OperationContext* o
     return Status::OK();
 }
 
+std::vector<StatusWith<ShardEndpoint>> ChunkManagerTargeter::targetInserts(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+    if (!_routingInfo->cm()) {
+        return NSTargeter::targetInserts(opCtx, docs);
+    }
+
+    const auto& cm = _routingInfo->cm();
+
+    // The documents without a shard key are targeted on their own, like targetInsert does.
+    std::vector<StatusWith<ShardEndpoint>> endpoints;
+    endpoints.reserve(docs.size());
+    std::vector<size_t> docsWithShardKey;
+    std::vector<BSONObj> shardKeys;
+    for (size_t i = 0; i < docs.size(); ++i) {
+        auto shardKey = cm->getShardKeyPattern().extractShardKeyFromDoc(docs[i]);
+        if (shardKey.isEmpty()) {
+            endpoints.push_back(targetInsert(opCtx, docs[i]));
+            continue;
+        }
+
+        endpoints.push_back(Status(ErrorCodes::InternalError, "insert was not targeted"));
+        docsWithShardKey.push_back(i);
+        shardKeys.push_back(std::move(shardKey));
+    }
+
+    try {
+        const auto shardIds = cm->getShardIdsForShardKeys(shardKeys);
+        for (size_t i = 0; i < docsWithShardKey.size(); ++i) {
+            endpoints[docsWithShardKey[i]] =
+                ShardEndpoint(shardIds[i], cm->getVersion(shardIds[i]));
+        }
+    } catch (const DBException&) {
+        // Find which documents could not be targeted and why.
+        for (size_t i = 0; i < docsWithShardKey.size(); ++i) {
+            endpoints[docsWithShardKey[i]] =
+                _targetShardKey(shardKeys[i], CollationSpec::kSimpleSpec, 0);
+        }
+    }
+
+    return endpoints;
+}
+
 StatusWith<std::vector<ShardEndpoint>> ChunkManagerTargeter::targetUpdate(
     OperationContext* opCtx, const write_ops::UpdateOpEntry& updateDoc) const {
     // If the update is replacement-style:
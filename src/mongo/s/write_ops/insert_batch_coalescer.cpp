@@ -0,0 +1,301 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kSharding
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/write_ops/insert_batch_coalescer.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/write_concern_options.h"
+#include "mongo/executor/task_executor_pool.h"
+#include "mongo/s/grid.h"
+#include "mongo/s/transaction_router.h"
+#include "mongo/s/write_ops/batched_command_request.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+namespace {
+
+const auto getInsertBatchCoalescer = ServiceContext::declareDecoration<InsertBatchCoalescer>();
+
+// Combined requests sent for more than one insert batch, and the batches they were sent for.
+Counter64 coalescedInsertRequests;
+Counter64 coalescedInsertBatches;
+ServerStatusMetricField<Counter64> displayCoalescedInsertRequests("query.coalescedInsertRequests",
+                                                                  &coalescedInsertRequests);
+ServerStatusMetricField<Counter64> displayCoalescedInsertBatches("query.coalescedInsertBatches",
+                                                                 &coalescedInsertBatches);
+
+}  // namespace
+
+struct InsertBatchCoalescer::Group {
+    struct Member {
+        // The position of the member's first document in the combined request
+        size_t offset;
+
+        // The number of documents of the member
+        size_t count;
+
+        Promise<AsyncRequestsSender::Response> response;
+    };
+
+    ShardId shardId;
+    NamespaceString nss;
+
+    // The combined request, except for its documents
+    BSONObj commandWithoutDocuments;
+
+    // The key of the group in '_openGroups'
+    std::string key;
+
+    stdx::chrono::steady_clock::time_point deadline;
+
+    // Everything below is protected by the coalescer's mutex until the group is closed, and only
+    // accessed by the leader afterwards.
+    std::vector<BSONObj> documents;
+    int estimatedSizeBytes = 0;
+    std::vector<Member> members;
+
+    bool isClosed = false;
+    stdx::condition_variable closedCV;
+};
+
+InsertBatchCoalescer* InsertBatchCoalescer::get(ServiceContext* serviceContext) {
+    return &getInsertBatchCoalescer(serviceContext);
+}
+
+InsertBatchCoalescer* InsertBatchCoalescer::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+bool InsertBatchCoalescer::canCoalesce(OperationContext* opCtx,
+                                       const BatchedCommandRequest& shardRequest) {
+    if (shardRequest.getBatchType() != BatchedCommandRequest::BatchType_Insert ||
+        shardRequest.getWriteCommandBase().getOrdered()) {
+        return false;
+    }
+
+    if (opCtx->getTxnNumber() || TransactionRouter::get(opCtx)) {
+        return false;
+    }
+
+    if (!shardRequest.hasWriteConcern()) {
+        return true;
+    }
+
+    const auto w = shardRequest.getWriteConcern()["w"];
+    return w.eoo() || (w.isNumber() && w.numberLong() == 1) ||
+        (w.type() == String && w.valueStringData() == WriteConcernOptions::kMajority);
+}
+
+BSONObj InsertBatchCoalescer::splitResponse(const BSONObj& response, size_t offset, size_t count) {
+    if (!response["ok"].trueValue()) {
+        return response;
+    }
+
+    BSONObjBuilder builder;
+    std::vector<BSONObj> writeErrors;
+    for (const auto& elem : response) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName == "n") {
+            continue;
+        }
+
+        if (fieldName != "writeErrors") {
+            builder.append(elem);
+            continue;
+        }
+
+        for (const auto& writeError : elem.Obj()) {
+            const auto index = writeError.Obj()["index"].numberLong();
+            if (index < static_cast<long long>(offset) ||
+                index >= static_cast<long long>(offset + count)) {
+                continue;
+            }
+
+            BSONObjBuilder errorBuilder;
+            for (const auto& errorElem : writeError.Obj()) {
+                if (errorElem.fieldNameStringData() == "index") {
+                    errorBuilder.append("index", static_cast<int>(index - offset));
+                } else {
+                    errorBuilder.append(errorElem);
+                }
+            }
+            writeErrors.push_back(errorBuilder.obj());
+        }
+    }
+
+    // Unordered inserts either insert a document or report a write error for it.
+    builder.append("n", static_cast<int>(count - writeErrors.size()));
+    if (!writeErrors.empty()) {
+        builder.append("writeErrors", writeErrors);
+    }
+
+    return builder.obj();
+}
+
+InsertBatchCoalescer::Ticket InsertBatchCoalescer::join(const ShardId& shardId,
+                                                        const BatchedCommandRequest& shardRequest,
+                                                        Microseconds window) {
+    const auto& nss = shardRequest.getNS();
+    const auto& documents = shardRequest.getInsertRequest().getDocuments();
+
+    int estimatedSizeBytes = 0;
+    for (const auto& document : documents) {
+        estimatedSizeBytes +=
+            document.objsize() + write_ops::kWriteCommandBSONArrayPerElementOverheadBytes;
+    }
+
+    const auto commandWithoutDocuments =
+        shardRequest.toBSON().removeField(write_ops::Insert::kDocumentsFieldName);
+
+    // Only requests which are the same apart from their documents can be combined.
+    std::string key = shardId.toString();
+    key.push_back('\0');
+    key.append(nss.ns());
+    key.push_back('\0');
+    key.append(commandWithoutDocuments.objdata(), commandWithoutDocuments.objsize());
+
+    auto pf = makePromiseFuture<AsyncRequestsSender::Response>();
+
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    std::shared_ptr<Group> group;
+    auto it = _openGroups.find(key);
+    if (it != _openGroups.end()) {
+        group = it->second;
+
+        // A full group is sent right away and the batch starts the next one.
+        if (group->documents.size() + documents.size() > write_ops::kMaxWriteBatchSize ||
+            group->estimatedSizeBytes + estimatedSizeBytes > BSONObjMaxUserSize) {
+            _close(lk, group.get());
+            group.reset();
+        }
+    }
+
+    const bool isLeader = !group;
+    if (isLeader) {
+        group = std::make_shared<Group>();
+        group->shardId = shardId;
+        group->nss = nss;
+        group->commandWithoutDocuments = commandWithoutDocuments;
+        group->key = key;
+        group->deadline = stdx::chrono::steady_clock::now() + window.toSystemDuration();
+        _openGroups.emplace(std::move(key), group);
+    }
+
+    group->members.push_back({group->documents.size(), documents.size(), std::move(pf.promise)});
+    group->documents.insert(group->documents.end(), documents.begin(), documents.end());
+    group->estimatedSizeBytes += estimatedSizeBytes;
+
+    return Ticket(std::move(group), isLeader, std::move(pf.future));
+}
+
+AsyncRequestsSender::Response InsertBatchCoalescer::wait(OperationContext* opCtx, Ticket ticket) {
+    if (!ticket._isLeader) {
+        return std::move(ticket._response).get(opCtx);
+    }
+
+    auto& group = *ticket._group;
+    {
+        stdx::unique_lock<Latch> lk(_mutex);
+        group.closedCV.wait_until(lk, group.deadline, [&] { return group.isClosed; });
+        _close(lk, &group);
+    }
+
+    const auto command = [&] {
+        BSONObjBuilder builder;
+        builder.appendElements(group.commandWithoutDocuments);
+
+        BSONArrayBuilder documents(builder.subarrayStart(write_ops::Insert::kDocumentsFieldName));
+        for (const auto& document : group.documents) {
+            documents.append(document);
+        }
+        documents.done();
+
+        return builder.obj();
+    }();
+
+    if (group.members.size() > 1) {
+        coalescedInsertRequests.increment();
+        coalescedInsertBatches.increment(group.members.size());
+    }
+
+    LOG(4) << "Sending " << group.members.size() << " coalesced insert batches with "
+           << group.documents.size() << " documents to " << group.shardId;
+
+    // The group is sent on a client of its own, so that killOp or maxTimeMS interrupting the
+    // leader does not fail the batches of the other members.
+    const auto response = [&] {
+        auto client = opCtx->getServiceContext()->makeClient("InsertBatchCoalescer");
+        AlternativeClientRegion acr(client);
+        auto sendOpCtx = cc().makeOperationContext();
+
+        AsyncRequestsSender ars(
+            sendOpCtx.get(),
+            Grid::get(sendOpCtx.get())->getExecutorPool()->getArbitraryExecutor(),
+            group.nss.db(),
+            {AsyncRequestsSender::Request(group.shardId, command)},
+            ReadPreferenceSetting(ReadPreference::PrimaryOnly),
+            Shard::RetryPolicy::kNoRetry);
+        return ars.next();
+    }();
+
+    for (auto& member : group.members) {
+        auto memberResponse = response;
+        if (response.swResponse.isOK()) {
+            const auto& remoteResponse = response.swResponse.getValue();
+            memberResponse.swResponse = executor::RemoteCommandResponse(
+                splitResponse(remoteResponse.data, member.offset, member.count),
+                remoteResponse.elapsedMillis.value_or(Milliseconds(0)));
+        }
+        member.response.emplaceValue(std::move(memberResponse));
+    }
+
+    return std::move(ticket._response).get();
+}
+
+void InsertBatchCoalescer::_close(WithLock, Group* group) {
+    if (group->isClosed) {
+        return;
+    }
+
+    group->isClosed = true;
+    _openGroups.erase(group->key);
+    group->closedCV.notify_all();
+}
+
+}  // namespace mongo
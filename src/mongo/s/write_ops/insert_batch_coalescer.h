@@ -0,0 +1,141 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/s/async_requests_sender.h"
+#include "mongo/s/shard_id.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/future.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class BatchedCommandRequest;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Decoration on ServiceContext used by mongos to send the shard requests of concurrent unordered
+ * insert batches as one request, when they go to the same shard and namespace with the same
+ * options.
+ *
+ * The first batch to join a group becomes its leader. The leader waits out the coalescing window,
+ * or until the group is full, sends the combined request and hands every member of the group the
+ * part of the response which covers its own documents, with the indexes of its write errors
+ * relative to its own batch. A member which is interrupted while waiting stops waiting, but its
+ * documents are still sent with the group. The leader sends the group on an operation of its own,
+ * so its interruption does not fail the group either.
+ */
+class InsertBatchCoalescer {
+    InsertBatchCoalescer(const InsertBatchCoalescer&) = delete;
+    InsertBatchCoalescer& operator=(const InsertBatchCoalescer&) = delete;
+
+    struct Group;
+
+public:
+    /**
+     * A batch's place in a group, returned by join() and redeemed by wait().
+     */
+    class Ticket {
+    public:
+        bool isLeader() const {
+            return _isLeader;
+        }
+
+    private:
+        friend class InsertBatchCoalescer;
+
+        Ticket(std::shared_ptr<Group> group,
+               bool isLeader,
+               Future<AsyncRequestsSender::Response> response)
+            : _group(std::move(group)), _isLeader(isLeader), _response(std::move(response)) {}
+
+        std::shared_ptr<Group> _group;
+        bool _isLeader;
+        Future<AsyncRequestsSender::Response> _response;
+    };
+
+    InsertBatchCoalescer() = default;
+    ~InsertBatchCoalescer() = default;
+
+    static InsertBatchCoalescer* get(ServiceContext* serviceContext);
+    static InsertBatchCoalescer* get(OperationContext* opCtx);
+
+    /**
+     * Returns whether 'shardRequest' may be sent together with the requests of other operations:
+     * it must be an unordered insert which is neither retryable nor part of a transaction, since
+     * the combined request carries no session, and its write concern must be w:1 or w:majority.
+     */
+    static bool canCoalesce(OperationContext* opCtx, const BatchedCommandRequest& shardRequest);
+
+    /**
+     * Returns the part of 'response', the response to a combined insert request, which covers
+     * the 'count' documents starting at 'offset'. Command errors are returned as they are.
+     */
+    static BSONObj splitResponse(const BSONObj& response, size_t offset, size_t count);
+
+    /**
+     * Adds the documents of 'shardRequest' for 'shardId' to the open group with the same shard,
+     * namespace and options, or opens a new group which is sent after 'window'. Does not block.
+     */
+    Ticket join(const ShardId& shardId,
+                const BatchedCommandRequest& shardRequest,
+                Microseconds window);
+
+    /**
+     * Returns the response to the batch behind 'ticket', as the response of the shard to its own
+     * request would have been. Leaders send their group from this call, so an operation holding
+     * several tickets must wait on the tickets it leads before the others.
+     */
+    AsyncRequestsSender::Response wait(OperationContext* opCtx, Ticket ticket);
+
+private:
+    /**
+     * Stops 'group' from taking more documents. Must be called with '_mutex' held.
+     */
+    void _close(WithLock, Group* group);
+
+    Mutex _mutex = MONGO_MAKE_LATCH("InsertBatchCoalescer::_mutex");
+
+    // The groups which may still take documents, by shard, namespace and options
+    stdx::unordered_map<std::string, std::shared_ptr<Group>> _openGroups;
+};
+
+}  // namespace mongo
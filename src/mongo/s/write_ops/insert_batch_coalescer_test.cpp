@@ -0,0 +1,248 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/client/remote_command_targeter_factory_mock.h"
+#include "mongo/client/remote_command_targeter_mock.h"
+#include "mongo/db/client.h"
+#include "mongo/db/logical_session_id.h"
+#include "mongo/s/catalog/type_shard.h"
+#include "mongo/s/sharding_router_test_fixture.h"
+#include "mongo/s/write_ops/batched_command_request.h"
+#include "mongo/s/write_ops/batched_command_response.h"
+#include "mongo/s/write_ops/insert_batch_coalescer.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const HostAndPort kTestShardHost = HostAndPort("FakeHost", 12345);
+const HostAndPort kTestConfigShardHost = HostAndPort("FakeConfigHost", 12345);
+const ShardId kShardId("FakeShard");
+const NamespaceString kNss("foo.bar");
+
+BatchedCommandRequest makeInsertRequest(const NamespaceString& nss,
+                                        std::vector<BSONObj> documents,
+                                        bool ordered = false) {
+    BatchedCommandRequest request([&] {
+        write_ops::Insert insertOp(nss);
+        insertOp.setWriteCommandBase([&] {
+            write_ops::WriteCommandBase writeCommandBase;
+            writeCommandBase.setOrdered(ordered);
+            return writeCommandBase;
+        }());
+        insertOp.setDocuments(std::move(documents));
+        return insertOp;
+    }());
+    request.setWriteConcern(BSON("w" << 1));
+    return request;
+}
+
+TEST(InsertBatchCoalescerSplitTest, SplitsWriteErrorsByOffset) {
+    const auto response = BSON("n" << 3 << "writeErrors"
+                                   << BSON_ARRAY(BSON("index" << 1 << "code" << 11000 << "errmsg"
+                                                              << "dup")
+                                                 << BSON("index" << 3 << "code" << 11000 << "errmsg"
+                                                                 << "dup"))
+                                   << "ok" << 1);
+
+    ASSERT_BSONOBJ_EQ(BSON("ok" << 1 << "n" << 1
+                                << "writeErrors"
+                                << BSON_ARRAY(BSON("index" << 1 << "code" << 11000 << "errmsg"
+                                                           << "dup"))),
+                      InsertBatchCoalescer::splitResponse(response, 0, 2));
+    ASSERT_BSONOBJ_EQ(BSON("ok" << 1 << "n" << 2
+                                << "writeErrors"
+                                << BSON_ARRAY(BSON("index" << 1 << "code" << 11000 << "errmsg"
+                                                           << "dup"))),
+                      InsertBatchCoalescer::splitResponse(response, 2, 3));
+}
+
+TEST(InsertBatchCoalescerSplitTest, KeepsWriteConcernErrorsAndCommandErrors) {
+    const auto wcError = BSON("code" << 64 << "errmsg"
+                                     << "waiting for replication timed out");
+    ASSERT_BSONOBJ_EQ(BSON("writeConcernError" << wcError << "ok" << 1 << "n" << 2),
+                      InsertBatchCoalescer::splitResponse(
+                          BSON("n" << 5 << "writeConcernError" << wcError << "ok" << 1), 3, 2));
+
+    const auto commandError = BSON("ok" << 0 << "code" << 13 << "errmsg"
+                                        << "unauthorized");
+    ASSERT_BSONOBJ_EQ(commandError, InsertBatchCoalescer::splitResponse(commandError, 1, 1));
+}
+
+class InsertBatchCoalescerTest : public ShardingTestFixture {
+public:
+    void setUp() override {
+        ShardingTestFixture::setUp();
+        setRemote(HostAndPort("ClientHost", 12345));
+
+        configTargeter()->setFindHostReturnValue(kTestConfigShardHost);
+
+        auto targeter = std::make_unique<RemoteCommandTargeterMock>();
+        targeter->setConnectionStringReturnValue(ConnectionString(kTestShardHost));
+        targeter->setFindHostReturnValue(kTestShardHost);
+        targeterFactory()->addTargeterToReturn(ConnectionString(kTestShardHost),
+                                               std::move(targeter));
+
+        ShardType shardType;
+        shardType.setName(kShardId.toString());
+        shardType.setHost(kTestShardHost.toString());
+        setupShards({shardType});
+    }
+
+    InsertBatchCoalescer coalescer;
+};
+
+TEST_F(InsertBatchCoalescerTest, OnlyUnorderedInsertsOutsideOfSessionsAreCoalesced) {
+    ASSERT(InsertBatchCoalescer::canCoalesce(operationContext(),
+                                             makeInsertRequest(kNss, {BSON("x" << 1)})));
+    ASSERT_FALSE(InsertBatchCoalescer::canCoalesce(
+        operationContext(), makeInsertRequest(kNss, {BSON("x" << 1)}, true /* ordered */)));
+
+    auto majorityRequest = makeInsertRequest(kNss, {BSON("x" << 1)});
+    majorityRequest.setWriteConcern(BSON("w"
+                                         << "majority"));
+    ASSERT(InsertBatchCoalescer::canCoalesce(operationContext(), majorityRequest));
+
+    auto w2Request = makeInsertRequest(kNss, {BSON("x" << 1)});
+    w2Request.setWriteConcern(BSON("w" << 2));
+    ASSERT_FALSE(InsertBatchCoalescer::canCoalesce(operationContext(), w2Request));
+
+    operationContext()->setLogicalSessionId(makeLogicalSessionIdForTest());
+    operationContext()->setTxnNumber(5);
+    ASSERT_FALSE(InsertBatchCoalescer::canCoalesce(operationContext(),
+                                                   makeInsertRequest(kNss, {BSON("x" << 1)})));
+}
+
+TEST_F(InsertBatchCoalescerTest, OnlyBatchesForTheSameShardAndNamespaceShareAGroup) {
+    auto first = coalescer.join(kShardId, makeInsertRequest(kNss, {BSON("x" << 1)}), Seconds(1));
+    auto second = coalescer.join(kShardId, makeInsertRequest(kNss, {BSON("x" << 2)}), Seconds(1));
+    auto otherShard = coalescer.join(
+        ShardId("OtherShard"), makeInsertRequest(kNss, {BSON("x" << 3)}), Seconds(1));
+    auto otherNss = coalescer.join(
+        kShardId, makeInsertRequest(NamespaceString("foo.baz"), {BSON("x" << 4)}), Seconds(1));
+
+    ASSERT(first.isLeader());
+    ASSERT_FALSE(second.isLeader());
+    ASSERT(otherShard.isLeader());
+    ASSERT(otherNss.isLeader());
+}
+
+TEST_F(InsertBatchCoalescerTest, FullGroupStartsANewOne) {
+    std::vector<BSONObj> documents(write_ops::kMaxWriteBatchSize - 1, BSON("x" << 1));
+    auto first = coalescer.join(kShardId, makeInsertRequest(kNss, documents), Seconds(1));
+    auto second = coalescer.join(kShardId, makeInsertRequest(kNss, {BSON("x" << 2)}), Seconds(1));
+    auto third = coalescer.join(kShardId, makeInsertRequest(kNss, {BSON("x" << 3)}), Seconds(1));
+
+    ASSERT(first.isLeader());
+    ASSERT_FALSE(second.isLeader());
+    ASSERT(third.isLeader());
+}
+
+TEST_F(InsertBatchCoalescerTest, SendsOneRequestAndSplitsTheResponse) {
+    auto leader = coalescer.join(
+        kShardId, makeInsertRequest(kNss, {BSON("_id" << 1), BSON("_id" << 2)}), Milliseconds(0));
+    auto follower =
+        coalescer.join(kShardId, makeInsertRequest(kNss, {BSON("_id" << 3)}), Milliseconds(0));
+
+    auto leaderFuture = launchAsync([&] {
+        auto response = coalescer.wait(operationContext(), std::move(leader));
+        ASSERT_EQ(kShardId, response.shardId);
+        ASSERT_BSONOBJ_EQ(BSON("ok" << 1 << "n" << 2), response.swResponse.getValue().data);
+    });
+
+    auto followerFuture = launchAsync([&] {
+        auto client = getServiceContext()->makeClient("Follower");
+        auto opCtx = client->makeOperationContext();
+
+        auto response = coalescer.wait(opCtx.get(), std::move(follower));
+        ASSERT_EQ(kTestShardHost, *response.shardHostAndPort);
+        ASSERT_BSONOBJ_EQ(BSON("ok" << 1 << "n" << 0 << "writeErrors"
+                                    << BSON_ARRAY(BSON("index" << 0 << "code" << 11000 << "errmsg"
+                                                               << "dup"))),
+                          response.swResponse.getValue().data);
+    });
+
+    onCommandForPoolExecutor([&](const executor::RemoteCommandRequest& request) {
+        ASSERT_EQ(kNss.db(), request.dbname);
+        ASSERT_FALSE(request.cmdObj.hasField("lsid"));
+
+        const auto insertRequest = BatchedCommandRequest::parseInsert(
+            OpMsgRequest::fromDBAndBody(request.dbname, request.cmdObj));
+        const auto& documents = insertRequest.getInsertRequest().getDocuments();
+        ASSERT_EQ(3UL, documents.size());
+        ASSERT_BSONOBJ_EQ(BSON("_id" << 3), documents[2]);
+
+        return BSON("n" << 2 << "writeErrors"
+                        << BSON_ARRAY(BSON("index" << 2 << "code" << 11000 << "errmsg"
+                                                   << "dup"))
+                        << "ok" << 1);
+    });
+
+    leaderFuture.default_timed_get();
+    followerFuture.default_timed_get();
+}
+
+TEST_F(InsertBatchCoalescerTest, KillingTheLeaderDoesNotFailTheGroup) {
+    auto leader =
+        coalescer.join(kShardId, makeInsertRequest(kNss, {BSON("_id" << 1)}), Milliseconds(0));
+    auto follower =
+        coalescer.join(kShardId, makeInsertRequest(kNss, {BSON("_id" << 2)}), Milliseconds(0));
+
+    operationContext()->markKilled(ErrorCodes::Interrupted);
+
+    auto leaderFuture = launchAsync([&] {
+        auto response = coalescer.wait(operationContext(), std::move(leader));
+        ASSERT_BSONOBJ_EQ(BSON("ok" << 1 << "n" << 1), response.swResponse.getValue().data);
+    });
+
+    auto followerFuture = launchAsync([&] {
+        auto client = getServiceContext()->makeClient("Follower");
+        auto opCtx = client->makeOperationContext();
+
+        auto response = coalescer.wait(opCtx.get(), std::move(follower));
+        ASSERT_BSONOBJ_EQ(BSON("ok" << 1 << "n" << 1), response.swResponse.getValue().data);
+    });
+
+    onCommandForPoolExecutor([&](const executor::RemoteCommandRequest& request) {
+        const auto insertRequest = BatchedCommandRequest::parseInsert(
+            OpMsgRequest::fromDBAndBody(request.dbname, request.cmdObj));
+        ASSERT_EQ(2UL, insertRequest.getInsertRequest().getDocuments().size());
+
+        return BSON("n" << 2 << "ok" << 1);
+    });
+
+    leaderFuture.default_timed_get();
+    followerFuture.default_timed_get();
+}
+
+}  // namespace
+}  // namespace mongo
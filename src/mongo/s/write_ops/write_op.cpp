@@ -55,14 +55,13 @@ const WriteErrorDetail& WriteOp::getOpError() const {
 Status WriteOp::targetWrites(OperationContext* opCtx,
                              const NSTargeter& targeter,
                              std::vector<TargetedWrite*>* targetedWrites) {
-    auto swEndpoints = [&]() -> StatusWith<std::vector<ShardEndpoint>> {
-        if (_itemRef.getOpType() == BatchedCommandRequest::BatchType_Insert) {
-            auto swEndpoint = targeter.targetInsert(opCtx, _itemRef.getDocument());
-            if (!swEndpoint.isOK())
-                return swEndpoint.getStatus();
+    if (_itemRef.getOpType() == BatchedCommandRequest::BatchType_Insert) {
+        return targetWrites(
+            opCtx, targeter, targeter.targetInsert(opCtx, _itemRef.getDocument()), targetedWrites);
+    }
 
-            return std::vector<ShardEndpoint>{std::move(swEndpoint.getValue())};
-        } else if (_itemRef.getOpType() == BatchedCommandRequest::BatchType_Update) {
+    auto swEndpoints = [&]() -> StatusWith<std::vector<ShardEndpoint>> {
+        if (_itemRef.getOpType() == BatchedCommandRequest::BatchType_Update) {
             return targeter.targetUpdate(opCtx, _itemRef.getUpdate());
         } else if (_itemRef.getOpType() == BatchedCommandRequest::BatchType_Delete) {
             return targeter.targetDelete(opCtx, _itemRef.getDelete());
@@ -71,6 +70,27 @@ Status WriteOp::targetWrites(OperationContext* opCtx,
         }
     }();
 
+    return _targetWrites(opCtx, targeter, std::move(swEndpoints), targetedWrites);
+}
+
+Status WriteOp::targetWrites(OperationContext* opCtx,
+                             const NSTargeter& targeter,
+                             StatusWith<ShardEndpoint> insertEndpoint,
+                             std::vector<TargetedWrite*>* targetedWrites) {
+    invariant(_itemRef.getOpType() == BatchedCommandRequest::BatchType_Insert);
+    if (!insertEndpoint.isOK())
+        return insertEndpoint.getStatus();
+
+    return _targetWrites(opCtx,
+                         targeter,
+                         std::vector<ShardEndpoint>{std::move(insertEndpoint.getValue())},
+                         targetedWrites);
+}
+
+Status WriteOp::_targetWrites(OperationContext* opCtx,
+                              const NSTargeter& targeter,
+                              StatusWith<std::vector<ShardEndpoint>> swEndpoints,
+                              std::vector<TargetedWrite*>* targetedWrites) {
     // Unless executing as part of a transaction, if we're targeting more than one endpoint with an
     // update/delete, we have to target everywhere since we cannot currently retry partial results.
     //
@@ -122,6 +122,15 @@ public:
                         const NSTargeter& targeter,
                         std::vector<TargetedWrite*>* targetedWrites);
 
+    /**
+     * Same as above for an insert which was already targeted, together with other inserts of the
+     * same batch, at 'insertEndpoint'.
+     */
+    Status targetWrites(OperationContext* opCtx,
+                        const NSTargeter& targeter,
+                        StatusWith<ShardEndpoint> insertEndpoint,
+                        std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Returns the number of child writes that were last targeted.
      */
@@ -160,6 +169,14 @@ public:
     void setOpError(const WriteErrorDetail& error);
 
 private:
+    /**
+     * Creates the TargetedWrite operations for the endpoints the targeter returned.
+     */
+    Status _targetWrites(OperationContext* opCtx,
+                         const NSTargeter& targeter,
+                         StatusWith<std::vector<ShardEndpoint>> swEndpoints,
+                         std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Updates the op state after new information is received.
      */
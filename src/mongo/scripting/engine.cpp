@@ -272,7 +272,9 @@ void Scope::loadStored(OperationContext* opCtx, bool ignoreNotConnected) {
     }
 }
 
-ScriptingFunction Scope::createFunction(const char* code) {
+namespace {
+
+const char* skipLeadingComment(const char* code) {
     if (code[0] == '/' && code[1] == '*') {
         code += 2;
         while (code[0] && code[1]) {
@@ -283,13 +285,27 @@ ScriptingFunction Scope::createFunction(const char* code) {
             code++;
         }
     }
+    return code;
+}
 
+}  // namespace
+
+StringMapHashedKey Scope::makeFunctionCacheKey(const std::string& code) {
+    return StringMapHasher().hashed_key(skipLeadingComment(code.c_str()));
+}
+
+ScriptingFunction Scope::createFunction(const char* code) {
+    return createFunction(StringMapHasher().hashed_key(skipLeadingComment(code)));
+}
+
+ScriptingFunction Scope::createFunction(const StringMapHashedKey& code) {
     FunctionCacheMap::iterator i = _cachedFunctions.find(code);
     if (i != _cachedFunctions.end())
         return i->second;
 
-    // Get a function number, so the cache can be utilized to lookup the source on an exception
-    ScriptingFunction functionNumber = _createFunction(code);
+    // Get a function number, so the cache can be utilized to lookup the source on an exception.
+    // The key always ends where the source it was made from does, so it is null-terminated.
+    ScriptingFunction functionNumber = _createFunction(code.key().rawData());
     _cachedFunctions[code] = functionNumber;
     return functionNumber;
 }
@@ -503,6 +519,9 @@ public:
     ScriptingFunction createFunction(const char* code) {
         return _real->createFunction(code);
     }
+    ScriptingFunction createFunction(const StringMapHashedKey& code) {
+        return _real->createFunction(code);
+    }
     int invoke(ScriptingFunction func,
                const BSONObj* args,
                const BSONObj* recv,
@@ -32,11 +32,12 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 typedef unsigned long long ScriptingFunction;
 typedef BSONObj (*NativeFunction)(const BSONObj& args, void* data);
-typedef std::map<std::string, ScriptingFunction> FunctionCacheMap;
+typedef StringMap<ScriptingFunction> FunctionCacheMap;
 
 class DBClientBase;
 class OperationContext;
@@ -108,6 +109,19 @@ public:
 
     virtual ScriptingFunction createFunction(const char* code);
 
+    /**
+     * Same as createFunction(const char*), for a key made by makeFunctionCacheKey(). Callers which
+     * invoke the same function for every document keep the key, so that finding the compiled
+     * function does not copy or rehash its source.
+     */
+    virtual ScriptingFunction createFunction(const StringMapHashedKey& code);
+
+    /**
+     * Returns the key under which the function compiled from 'code' is cached: 'code' without any
+     * leading comment, along with its hash. The key refers into 'code', which must outlive it.
+     */
+    static StringMapHashedKey makeFunctionCacheKey(const std::string& code);
+
     /**
      * @return 0 on success
      */
@@ -253,6 +253,29 @@ TEST(ZstdMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<ZstdMessageCompressor>());
 }
 
+TEST(ZstdMessageCompressor, ContextReuseAcrossMessages) {
+    // The zstd compressor keeps its contexts across calls on a thread, including after a failed
+    // call, so make sure nothing from one message leaks into the next.
+    auto compressor = std::make_unique<ZstdMessageCompressor>();
+    checkOverflow(std::make_unique<ZstdMessageCompressor>());
+
+    for (int i = 0; i < 10; ++i) {
+        const std::string data = str::stream()
+            << "message " << i << ": " << std::string(i * 100, 'x');
+        std::vector<char> compressed(compressor->getMaxCompressedSize(data.size()));
+        auto sws = compressor->compressData(ConstDataRange(data.data(), data.size()),
+                                            DataRange(compressed.data(), compressed.size()));
+        ASSERT_OK(sws);
+
+        std::vector<char> decompressed(data.size());
+        sws = compressor->decompressData(ConstDataRange(compressed.data(), sws.getValue()),
+                                         DataRange(decompressed.data(), decompressed.size()));
+        ASSERT_OK(sws);
+        ASSERT_EQ(sws.getValue(), data.size());
+        ASSERT_EQ(memcmp(decompressed.data(), data.data(), data.size()), 0);
+    }
+}
+
 TEST(MessageCompressorManager, SERVER_28008) {
 
     // Create a client and server that will negotiate the same compressors,
@@ -40,6 +40,42 @@
 #include "mongo/transport/message_compressor_zstd.h"
 
 namespace mongo {
+namespace {
+
+struct ZstdCCtxDeleter {
+    void operator()(ZSTD_CCtx* cctx) const {
+        ZSTD_freeCCtx(cctx);
+    }
+};
+
+struct ZstdDCtxDeleter {
+    void operator()(ZSTD_DCtx* dctx) const {
+        ZSTD_freeDCtx(dctx);
+    }
+};
+
+// ZSTD_compress() and ZSTD_decompress() set up and tear down a context, with its tables and
+// window buffers, on every call, which dominates the cost of compressing a small message. Each
+// thread keeps one of each instead. Every call still resets the context, so the output is exactly
+// what the one-shot functions produce.
+thread_local std::unique_ptr<ZSTD_CCtx, ZstdCCtxDeleter> compressionContext;
+thread_local std::unique_ptr<ZSTD_DCtx, ZstdDCtxDeleter> decompressionContext;
+
+ZSTD_CCtx* getCompressionContext() {
+    if (!compressionContext) {
+        compressionContext.reset(ZSTD_createCCtx());
+    }
+    return compressionContext.get();
+}
+
+ZSTD_DCtx* getDecompressionContext() {
+    if (!decompressionContext) {
+        decompressionContext.reset(ZSTD_createDCtx());
+    }
+    return decompressionContext.get();
+}
+
+}  // namespace
 
 ZstdMessageCompressor::ZstdMessageCompressor() : MessageCompressorBase(MessageCompressor::kZstd) {}
 
@@ -49,11 +85,17 @@ std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
 
 StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
                                                             DataRange output) {
-    size_t ret = ZSTD_compress(const_cast<char*>(output.data()),
-                               output.length(),
-                               input.data(),
-                               input.length(),
-                               ZSTD_CLEVEL_DEFAULT);
+    auto cctx = getCompressionContext();
+    if (!cctx) {
+        return Status{ErrorCodes::ExceededMemoryLimit, "Could not allocate zstd context"};
+    }
+
+    size_t ret = ZSTD_compressCCtx(cctx,
+                                   const_cast<char*>(output.data()),
+                                   output.length(),
+                                   input.data(),
+                                   input.length(),
+                                   ZSTD_CLEVEL_DEFAULT);
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -65,8 +107,13 @@ StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input
 
 StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
                                                               DataRange output) {
-    size_t ret = ZSTD_decompress(
-        const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    auto dctx = getDecompressionContext();
+    if (!dctx) {
+        return Status{ErrorCodes::ExceededMemoryLimit, "Could not allocate zstd context"};
+    }
+
+    size_t ret = ZSTD_decompressDCtx(
+        dctx, const_cast<char*>(output.data()), output.length(), input.data(), input.length());
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
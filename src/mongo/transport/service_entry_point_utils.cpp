@@ -38,6 +38,7 @@
 
 #include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/numa_placement.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/log.h"
 
@@ -62,6 +63,12 @@ void* runFunc(void* ctx) {
 
 Status launchServiceWorkerThread(std::function<void()> task) {
 
+    // Spread the service worker threads over the NUMA nodes of the machine, if enabled.
+    task = [f = std::move(task)] {
+        NumaPlacement::get().bindCurrentThread();
+        f();
+    };
+
     try {
 #if defined(_WIN32)
         stdx::thread(std::move(task)).detach();
@@ -0,0 +1,306 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kExecutor;
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/service_executor_per_core.h"
+
+#include <algorithm>
+
+#include "mongo/transport/service_entry_point_utils.h"
+#include "mongo/transport/service_executor_gen.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/log.h"
+#include "mongo/util/processinfo.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+constexpr auto kExecutorLabel = "executor"_sd;
+constexpr auto kExecutorName = "perCore"_sd;
+constexpr auto kLoops = "loops"_sd;
+constexpr auto kLoopTasksExecuted = "loopTasksExecuted"_sd;
+constexpr auto kBlockingThreadsRunning = "blockingThreadsRunning"_sd;
+constexpr auto kBlockingThreadsIdle = "blockingThreadsIdle"_sd;
+constexpr auto kBlockingThreadsStarted = "blockingThreadsStarted"_sd;
+constexpr auto kBlockingTasksQueued = "blockingTasksQueued"_sd;
+constexpr auto kBlockingTasksExecuted = "blockingTasksExecuted"_sd;
+
+// How long each loop runs its reactor before checking whether the executor is shutting down.
+// Shutdown also stops the reactors, so this only bounds how late a loop can notice it.
+constexpr Milliseconds kLoopRunTime{1000};
+
+size_t numCores() {
+    return static_cast<size_t>(std::max(ProcessInfo::getNumAvailableCores(), 1UL));
+}
+
+size_t reservedBlockingThreads() {
+    const auto value = perCoreServiceExecutorReservedBlockingThreads.load();
+    return value < 0 ? numCores() : static_cast<size_t>(value);
+}
+
+/**
+ * Tasks which process a message run the database operation for it, which may block. Whether it
+ * will block is not known until the command has been parsed and run, so every message is treated
+ * as one that may block.
+ */
+bool isBlockingTask(ServiceExecutorTaskName taskName) {
+    return taskName == ServiceExecutorTaskName::kSSMProcessMessage ||
+        taskName == ServiceExecutorTaskName::kSSMExhaustMessage;
+}
+}  // namespace
+
+thread_local ServiceExecutorPerCore::Loop* ServiceExecutorPerCore::_localLoop = nullptr;
+thread_local bool ServiceExecutorPerCore::_localIsBlockingThread = false;
+thread_local int ServiceExecutorPerCore::_localRecursionDepth = 0;
+
+ServiceExecutorPerCore::ServiceExecutorPerCore(ServiceContext* ctx,
+                                               std::vector<ReactorHandle> reactors) {
+    invariant(!reactors.empty());
+    for (auto& reactor : reactors) {
+        _loops.emplace_back(std::make_unique<Loop>(std::move(reactor)));
+    }
+}
+
+ServiceExecutorPerCore::~ServiceExecutorPerCore() {
+    invariant(!_isRunning.load());
+}
+
+size_t ServiceExecutorPerCore::numLoops() {
+    const auto value = perCoreServiceExecutorLoops.load();
+    return value <= 0 ? numCores() : static_cast<size_t>(value);
+}
+
+Status ServiceExecutorPerCore::start() {
+    invariant(!_isRunning.load());
+    _isRunning.store(true);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (size_t i = 0; i < _loops.size(); ++i) {
+        ++_numLoopThreads;
+        auto status = launchServiceWorkerThread(
+            [this, loop = _loops[i].get(), i] { _loopThreadRoutine(loop, i); });
+        if (!status.isOK()) {
+            --_numLoopThreads;
+            return status;
+        }
+    }
+
+    for (size_t i = 0; i < reservedBlockingThreads(); ++i) {
+        auto status = _startBlockingThread(lk);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
+    return Status::OK();
+}
+
+Status ServiceExecutorPerCore::shutdown(Milliseconds timeout) {
+    if (!_isRunning.load()) {
+        return Status::OK();
+    }
+
+    LOG(3) << "Shutting down per-core executor";
+
+    _isRunning.store(false);
+    for (const auto& loop : _loops) {
+        loop->reactor->stop();
+    }
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    _blockingTaskCondition.notify_all();
+    bool result = _threadExitCondition.wait_for(lk, timeout.toSystemDuration(), [&] {
+        return _numLoopThreads == 0 && _numBlockingThreads == 0;
+    });
+
+    return result
+        ? Status::OK()
+        : Status(ErrorCodes::Error::ExceededTimeLimit,
+                 "per-core executor couldn't shutdown all worker threads within time limit.");
+}
+
+Status ServiceExecutorPerCore::schedule(Task task,
+                                        ScheduleFlags flags,
+                                        ServiceExecutorTaskName taskName) {
+    if (!_isRunning.load()) {
+        return Status{ErrorCodes::ShutdownInProgress, "Executor is not running"};
+    }
+
+    if (isBlockingTask(taskName)) {
+        return _scheduleBlocking(std::move(task), flags);
+    }
+
+    return _scheduleOnLoop(std::move(task));
+}
+
+Status ServiceExecutorPerCore::_scheduleOnLoop(Task task) {
+    // A task scheduled from a loop stays on that loop: it was scheduled by a session whose
+    // networking completes on this loop. Tasks from anywhere else, such as the listener or a
+    // blocking thread, go to the next loop, and the session moves back to its own loop as soon as
+    // its networking next completes.
+    auto loop = _localLoop;
+    if (!loop) {
+        loop = _loops[_nextLoop.fetchAndAdd(1) % _loops.size()].get();
+    }
+
+    // Always post the task, so that the stack of the loop unwinds before it runs.
+    loop->reactor->schedule([loop, task = std::move(task)](Status) {
+        task();
+        loop->tasksExecuted.addAndFetch(1);
+    });
+
+    return Status::OK();
+}
+
+Status ServiceExecutorPerCore::_scheduleBlocking(Task task, ScheduleFlags flags) {
+    // A blocking thread may run the next message of its session itself, as the synchronous
+    // executor does, rather than handing it to another blocking thread.
+    if (_localIsBlockingThread && (flags & ScheduleFlags::kMayRecurse) &&
+        _localRecursionDepth < perCoreServiceExecutorRecursionLimit.loadRelaxed()) {
+        ++_localRecursionDepth;
+        task();
+        --_localRecursionDepth;
+        _blockingTasksExecuted.addAndFetch(1);
+        return Status::OK();
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _blockingTasks.emplace_back(std::move(task));
+    if (_blockingTasks.size() <= _numIdleBlockingThreads) {
+        _blockingTaskCondition.notify_one();
+        return Status::OK();
+    }
+
+    // All the blocking threads are busy, so start another one for the task.
+    auto status = _startBlockingThread(lk);
+    if (!status.isOK() && _numBlockingThreads == 0) {
+        // There is no thread left which would ever run the task.
+        _blockingTasks.pop_back();
+        return status;
+    }
+
+    return Status::OK();
+}
+
+Status ServiceExecutorPerCore::_startBlockingThread(WithLock) {
+    const auto threadId = _nextBlockingThreadId++;
+    ++_numBlockingThreads;
+    auto status =
+        launchServiceWorkerThread([this, threadId] { _blockingThreadRoutine(threadId); });
+    if (!status.isOK()) {
+        --_numBlockingThreads;
+        return status;
+    }
+
+    _blockingThreadsStarted.addAndFetch(1);
+    return Status::OK();
+}
+
+void ServiceExecutorPerCore::_loopThreadRoutine(Loop* loop, size_t loopId) {
+    _localLoop = loop;
+    setThreadName(str::stream() << "loop-" << loopId);
+
+    LOG(3) << "Started per-core executor loop " << loopId;
+
+    while (_isRunning.load()) {
+        loop->reactor->runFor(kLoopRunTime);
+    }
+
+    _localLoop = nullptr;
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    --_numLoopThreads;
+    _threadExitCondition.notify_all();
+}
+
+void ServiceExecutorPerCore::_blockingThreadRoutine(size_t threadId) {
+    _localIsBlockingThread = true;
+    setThreadName(str::stream() << "blocking-" << threadId);
+
+    LOG(3) << "Started per-core executor blocking thread " << threadId;
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    while (_isRunning.load()) {
+        if (_blockingTasks.empty()) {
+            const Milliseconds idleTimeout{
+                perCoreServiceExecutorBlockingThreadIdleTimeoutMillis.load()};
+
+            ++_numIdleBlockingThreads;
+            const bool hasWork =
+                _blockingTaskCondition.wait_for(lk, idleTimeout.toSystemDuration(), [&] {
+                    return !_isRunning.load() || !_blockingTasks.empty();
+                });
+            --_numIdleBlockingThreads;
+
+            if (!hasWork && _numBlockingThreads > reservedBlockingThreads()) {
+                break;
+            }
+            continue;
+        }
+
+        auto task = std::move(_blockingTasks.front());
+        _blockingTasks.pop_front();
+        lk.unlock();
+
+        _localRecursionDepth = 1;
+        task();
+        _blockingTasksExecuted.addAndFetch(1);
+
+        lk.lock();
+    }
+
+    _localIsBlockingThread = false;
+
+    --_numBlockingThreads;
+    _threadExitCondition.notify_all();
+}
+
+void ServiceExecutorPerCore::appendStats(BSONObjBuilder* bob) const {
+    long long loopTasksExecuted = 0;
+    for (const auto& loop : _loops) {
+        loopTasksExecuted += loop->tasksExecuted.load();
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    *bob << kExecutorLabel << kExecutorName << kLoops << static_cast<long long>(_loops.size())
+         << kLoopTasksExecuted << loopTasksExecuted << kBlockingThreadsRunning
+         << static_cast<long long>(_numBlockingThreads) << kBlockingThreadsIdle
+         << static_cast<long long>(_numIdleBlockingThreads) << kBlockingThreadsStarted
+         << _blockingThreadsStarted.load() << kBlockingTasksQueued
+         << static_cast<long long>(_blockingTasks.size()) << kBlockingTasksExecuted
+         << _blockingTasksExecuted.load();
+}
+
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,129 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/transport/service_executor.h"
+#include "mongo/transport/service_executor_task_names.h"
+#include "mongo/transport/transport_layer.h"
+#include "mongo/util/concurrency/with_lock.h"
+
+namespace mongo {
+namespace transport {
+
+/**
+ * A thread-per-core ServiceExecutor. Each loop thread runs the event loop of its own reactor, and
+ * the transport layer spreads the sessions it accepts over those reactors, so all the networking
+ * of a session completes on the same thread, as do the tasks that thread schedules in turn.
+ *
+ * Tasks which process a message run database operations, which may block, so they are handed off
+ * to a separate pool of blocking threads rather than stalling the other sessions of a loop. The
+ * pool starts threads whenever all of its threads are busy, and threads above the reserved
+ * number exit after they have been idle for a while.
+ *
+ * Only the networking of a session has affinity to a core. Every message is processed on a
+ * blocking thread, whichever one is free, even when the operation it runs would not block.
+ */
+class ServiceExecutorPerCore final : public ServiceExecutor {
+public:
+    ServiceExecutorPerCore(ServiceContext* ctx, std::vector<ReactorHandle> reactors);
+    ~ServiceExecutorPerCore();
+
+    /**
+     * Returns the number of loops the executor should run, which is also the number of ingress
+     * reactors the transport layer should spread sessions over.
+     */
+    static size_t numLoops();
+
+    Status start() override;
+    Status shutdown(Milliseconds timeout) override;
+    Status schedule(Task task, ScheduleFlags flags, ServiceExecutorTaskName taskName) override;
+
+    Mode transportMode() const override {
+        return Mode::kAsynchronous;
+    }
+
+    void appendStats(BSONObjBuilder* bob) const override;
+
+private:
+    struct Loop {
+        explicit Loop(ReactorHandle reactor) : reactor(std::move(reactor)) {}
+
+        ReactorHandle reactor;
+        AtomicWord<long long> tasksExecuted{0};
+    };
+
+    void _loopThreadRoutine(Loop* loop, size_t loopId);
+    void _blockingThreadRoutine(size_t threadId);
+
+    Status _scheduleOnLoop(Task task);
+    Status _scheduleBlocking(Task task, ScheduleFlags flags);
+    Status _startBlockingThread(WithLock);
+
+    // The loop whose thread is the current thread, if any.
+    static thread_local Loop* _localLoop;
+    static thread_local bool _localIsBlockingThread;
+    static thread_local int _localRecursionDepth;
+
+    std::vector<std::unique_ptr<Loop>> _loops;
+
+    // Picks the loop for tasks scheduled from outside of the loops, in round-robin order.
+    AtomicWord<unsigned> _nextLoop{0};
+
+    AtomicWord<bool> _isRunning{false};
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ServiceExecutorPerCore::_mutex");
+
+    // Signalled when a blocking task is queued or the executor shuts down.
+    stdx::condition_variable _blockingTaskCondition;
+
+    // Signalled when a loop or blocking thread exits.
+    stdx::condition_variable _threadExitCondition;
+
+    // Everything below is protected by _mutex.
+    std::deque<Task> _blockingTasks;
+    size_t _numLoopThreads = 0;
+    size_t _numBlockingThreads = 0;
+    size_t _numIdleBlockingThreads = 0;
+    size_t _nextBlockingThreadId = 0;
+
+    AtomicWord<long long> _blockingTasksExecuted{0};
+    AtomicWord<long long> _blockingThreadsStarted{0};
+};
+
+}  // namespace transport
+}  // namespace mongo
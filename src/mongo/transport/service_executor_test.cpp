@@ -35,9 +35,11 @@
 
 #include "mongo/db/service_context.h"
 #include "mongo/transport/service_executor_adaptive.h"
+#include "mongo/transport/service_executor_per_core.h"
 #include "mongo/transport/service_executor_synchronous.h"
 #include "mongo/transport/service_executor_task_names.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/notification.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
 
@@ -176,6 +178,21 @@ protected:
     std::unique_ptr<ServiceExecutorSynchronous> executor;
 };
 
+class ServiceExecutorPerCoreFixture : public unittest::Test {
+protected:
+    void setUp() override {
+        auto scOwned = ServiceContext::make();
+        setGlobalServiceContext(std::move(scOwned));
+
+        executor = std::make_unique<ServiceExecutorPerCore>(
+            getGlobalServiceContext(),
+            std::vector<ReactorHandle>{std::make_shared<ASIOReactor>(),
+                                       std::make_shared<ASIOReactor>()});
+    }
+
+    std::unique_ptr<ServiceExecutorPerCore> executor;
+};
+
 void scheduleBasicTask(ServiceExecutor* exec, bool expectSuccess) {
     stdx::condition_variable cond;
     auto mutex = MONGO_MAKE_LATCH();
@@ -217,6 +234,54 @@ TEST_F(ServiceExecutorSynchronousFixture, ScheduleFailsBeforeStartup) {
     scheduleBasicTask(executor.get(), false);
 }
 
+TEST_F(ServiceExecutorPerCoreFixture, BasicTaskRuns) {
+    ASSERT_OK(executor->start());
+    auto guard = makeGuard([this] { ASSERT_OK(executor->shutdown(kShutdownTime)); });
+
+    scheduleBasicTask(executor.get(), true);
+}
+
+TEST_F(ServiceExecutorPerCoreFixture, ScheduleFailsBeforeStartup) {
+    scheduleBasicTask(executor.get(), false);
+}
+
+TEST_F(ServiceExecutorPerCoreFixture, TasksScheduledFromALoopStayOnIt) {
+    ASSERT_OK(executor->start());
+    auto guard = makeGuard([this] { ASSERT_OK(executor->shutdown(kShutdownTime)); });
+
+    Notification<stdx::thread::id> firstThread;
+    Notification<stdx::thread::id> secondThread;
+    ASSERT_OK(executor->schedule(
+        [&] {
+            firstThread.set(stdx::this_thread::get_id());
+            ASSERT_OK(executor->schedule([&] { secondThread.set(stdx::this_thread::get_id()); },
+                                         ServiceExecutor::kDeferredTask,
+                                         ServiceExecutorTaskName::kSSMSourceMessage));
+        },
+        ServiceExecutor::kEmptyFlags,
+        ServiceExecutorTaskName::kSSMStartSession));
+
+    ASSERT_EQ(firstThread.get(), secondThread.get());
+}
+
+TEST_F(ServiceExecutorPerCoreFixture, MessagesAreProcessedOffTheLoops) {
+    ASSERT_OK(executor->start());
+    auto guard = makeGuard([this] { ASSERT_OK(executor->shutdown(kShutdownTime)); });
+
+    Notification<stdx::thread::id> loopThread;
+    Notification<stdx::thread::id> blockingThread;
+    ASSERT_OK(executor->schedule(
+        [&] {
+            loopThread.set(stdx::this_thread::get_id());
+            ASSERT_OK(executor->schedule([&] { blockingThread.set(stdx::this_thread::get_id()); },
+                                         ServiceExecutor::kMayRecurse,
+                                         ServiceExecutorTaskName::kSSMProcessMessage));
+        },
+        ServiceExecutor::kEmptyFlags,
+        ServiceExecutorTaskName::kSSMStartSession));
+
+    ASSERT_NE(loopThread.get(), blockingThread.get());
+}
 
 }  // namespace
 }  // namespace mongo
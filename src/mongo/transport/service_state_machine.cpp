@@ -38,6 +38,7 @@
 #include "mongo/config.h"
 #include "mongo/db/client.h"
 #include "mongo/db/dbmessage.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/traffic_recorder.h"
 #include "mongo/rpc/message.h"
@@ -95,6 +96,56 @@ Message makeLegacyExhaustMessage(Message* m, const DbResponse& dbresponse) {
     return Message(b.release());
 }
 
+/**
+ * Returns whether the given 'find' or 'aggregate' request opens a tailable, awaitData cursor.
+ * Aggregations only open such cursors for change streams.
+ */
+bool opensAwaitDataCursor(const OpMsgRequest& request) {
+    if (request.getCommandName() == "find"_sd) {
+        return request.body["tailable"].trueValue() && request.body["awaitData"].trueValue();
+    }
+    BSONElement firstStage = request.body.getObjectField("pipeline").firstElement();
+    return firstStage.type() == Object && firstStage.Obj().hasField("$changeStream");
+}
+
+/**
+ * Builds the 'getMore' request which continues, as an exhaust stream, the cursor opened by the
+ * given 'find' or 'aggregate' request. The batch size of the initial request, if any, is carried
+ * over to every subsequent batch, and so is its maxTimeMS for awaitData cursors. Returns an empty
+ * message if the cursor cannot be continued through exhaust.
+ */
+Message makeInitialExhaustGetMore(const OpMsgRequest& request, const DbResponse& dbresponse) {
+    // Multi-statement transactions require each statement to be sent by the client.
+    if (request.body.hasField("txnNumber")) {
+        return Message();
+    }
+
+    BSONElement batchSize = request.getCommandName() == "find"_sd
+        ? request.body["batchSize"]
+        : request.body.getObjectField("cursor")["batchSize"];
+    BSONElement maxTimeMS = request.body["maxTimeMS"];
+
+    const NamespaceString nss(dbresponse.exhaustNS);
+    BSONObjBuilder bob;
+    bob.append("getMore", dbresponse.exhaustCursorId);
+    bob.append("collection", nss.coll());
+    if (batchSize.isNumber() && batchSize.safeNumberLong() > 0) {
+        bob.append("batchSize", batchSize.safeNumberLong());
+    }
+    // Other cursors keep the time left from the maxTimeMS of the initial request themselves, and
+    // 'getMore' rejects a maxTimeMS for them.
+    if (maxTimeMS.isNumber() && opensAwaitDataCursor(request)) {
+        bob.append(maxTimeMS);
+    }
+    if (auto lsid = request.body["lsid"]) {
+        bob.append(lsid);
+    }
+
+    auto getMoreMsg = OpMsgRequest::fromDBAndBody(nss.db(), bob.obj()).serialize();
+    OpMsg::setFlag(&getMoreMsg, OpMsg::kExhaustSupported);
+    return getMoreMsg;
+}
+
 /**
  * Given a request and its already generated response, checks for exhaust flags. If exhaust is
  * allowed, modifies the given request message to produce the subsequent exhaust message, and
@@ -102,7 +153,10 @@ Message makeLegacyExhaustMessage(Message* m, const DbResponse& dbresponse) {
  * request message for it to be used as the subsequent, 'synthetic' exhaust request. Returns an
  * empty message if exhaust is not allowed.
  *
- * Currently only supports exhaust for 'getMore' commands.
+ * Supports exhaust for 'getMore' commands, and for the 'find' and 'aggregate' commands that open a
+ * cursor, in which case the stream continues with 'getMore' requests built from the initial one.
+ * This lets the server start producing the next batch as soon as the previous one is handed to the
+ * network, rather than waiting a round trip for the client to ask for it.
  */
 Message makeExhaustMessage(Message requestMsg, DbResponse* dbresponse) {
     if (requestMsg.operation() == dbQuery) {
@@ -113,9 +167,10 @@ Message makeExhaustMessage(Message requestMsg, DbResponse* dbresponse) {
         return Message();
     }
 
-    // Only support exhaust for 'getMore' commands.
     auto request = OpMsgRequest::parse(requestMsg);
-    if (request.getCommandName() != "getMore"_sd) {
+    const auto commandName = request.getCommandName();
+    const bool isInitialRequest = commandName == "find"_sd || commandName == "aggregate"_sd;
+    if (commandName != "getMore"_sd && !isInitialRequest) {
         return Message();
     }
 
@@ -126,6 +181,15 @@ Message makeExhaustMessage(Message requestMsg, DbResponse* dbresponse) {
     }
 
     const bool checksumPresent = OpMsg::isFlagSet(requestMsg, OpMsg::kChecksumPresent);
+    if (isInitialRequest) {
+        // Continue the stream with 'getMore' requests. The cursor stays usable through regular
+        // 'getMore' requests when it cannot be continued through exhaust.
+        requestMsg = makeInitialExhaustGetMore(request, *dbresponse);
+        if (requestMsg.empty()) {
+            return Message();
+        }
+    }
+
     OpMsg::removeChecksum(&dbresponse->response);
     // Indicate that the response is part of an exhaust stream. Re-checksum if needed.
     OpMsg::setFlag(&dbresponse->response, OpMsg::kMoreToCome);
@@ -76,6 +76,7 @@ public:
         log() << "In handleRequest";
         _ranHandler = true;
         ASSERT_TRUE(haveClient());
+        _lastRequest = request;
 
         // Build out a dummy OK response, if no custom response message was set. Otherwise, use the
         // custom response message.
@@ -133,9 +134,14 @@ public:
         return ret;
     }
 
+    const Message& getLastRequest() const {
+        return _lastRequest;
+    }
+
 private:
     bool _uassertInHandler = false;
     bool _ranHandler = false;
+    Message _lastRequest;
 
     // A custom response message to return from 'handleRequest'.
     Message _responseMessage;
@@ -591,21 +597,147 @@ TEST_F(ServiceStateMachineFixture, TestGetMoreWithExhaustAndNonOKResponse) {
 }
 
 
-TEST_F(ServiceStateMachineFixture, TestExhaustOnlySupportedForGetMoreCommand) {
-    // Construct a 'find' OP_MSG request with the exhaust flag set. We should ignore exhaust flags
-    // for non 'getMore' commands.
+TEST_F(ServiceStateMachineFixture, TestFindWithExhaustContinuesWithGetMore) {
+    // Construct a 'find' OP_MSG request with the exhaust flag set.
+    const int32_t initRequestId = 1;
+    const long long cursorId = 42;
     const std::string nss = "test.coll";
-    Message findWithExhaust = buildOpMsg(BSON("find" << nss));
+    Message findWithExhaust =
+        buildOpMsg(BSON("find"
+                        << "coll"
+                        << "batchSize" << 2 << "$db"
+                        << "test"));
+    findWithExhaust.header().setId(initRequestId);
+    OpMsg::setFlag(&findWithExhaust, OpMsg::kExhaustSupported);
+
+    // Construct a 'find' response, with a non-zero cursor id and an empty batch.
+    BSONObj findResBody =
+        BSON("ok" << 1 << "cursor"
+                  << BSON("id" << cursorId << "ns" << nss << "firstBatch" << BSONArray()));
+    Message findRes = buildOpMsg(findResBody);
+
+    // The response to the 'find' starts the exhaust stream.
+    runSourceAndSinkTest(_tl, _sep, findWithExhaust, findRes, State::Process, State::Process);
+
+    auto msg = _tl->getLastSunk();
+    auto firstResponseId = msg.header().getId();
+    ASSERT_EQ(initRequestId, msg.header().getResponseToMsgId());
+    ASSERT(OpMsg::isFlagSet(msg, OpMsg::kMoreToCome));
+    ASSERT_BSONOBJ_EQ(findResBody, OpMsg::parse(msg).body);
+
+    // The next request processed is a 'getMore' on the cursor, with the batch size of the 'find'.
+    BSONObj getMoreTerminalResBody =
+        BSON("ok" << 1 << "cursor" << BSON("id" << 0 << "ns" << nss << "nextBatch" << BSONArray()));
+    _sep->setResponseMessage(buildOpMsg(getMoreTerminalResBody));
+    _ssm->runNext();
+    ASSERT_EQ(_ssm->state(), State::Source);
+
+    const auto& getMore = _sep->getLastRequest();
+    ASSERT(OpMsg::isFlagSet(getMore, OpMsg::kExhaustSupported));
+    ASSERT_EQ(firstResponseId, getMore.header().getId());
+    ASSERT_BSONOBJ_EQ(BSON("getMore" << cursorId << "collection"
+                                     << "coll"
+                                     << "batchSize" << 2LL << "$db"
+                                     << "test"),
+                      OpMsgRequest::parse(getMore).body);
+
+    msg = _tl->getLastSunk();
+    ASSERT_FALSE(OpMsg::isFlagSet(msg, OpMsg::kMoreToCome));
+    ASSERT_BSONOBJ_EQ(getMoreTerminalResBody, OpMsg::parse(msg).body);
+    ASSERT_EQ(firstResponseId, msg.header().getResponseToMsgId());
+}
+
+TEST_F(ServiceStateMachineFixture, TestAwaitDataFindWithExhaustCarriesMaxTimeMSToGetMore) {
+    const long long cursorId = 42;
+    const std::string nss = "test.coll";
+    Message findWithExhaust = buildOpMsg(BSON("find"
+                                              << "coll"
+                                              << "tailable" << true << "awaitData" << true
+                                              << "maxTimeMS" << 100 << "$db"
+                                              << "test"));
+    OpMsg::setFlag(&findWithExhaust, OpMsg::kExhaustSupported);
+
+    Message findRes = buildOpMsg(BSON(
+        "ok" << 1 << "cursor"
+             << BSON("id" << cursorId << "ns" << nss << "firstBatch" << BSONArray())));
+    runSourceAndSinkTest(_tl, _sep, findWithExhaust, findRes, State::Process, State::Process);
+
+    // The awaitData timeout of every 'getMore' in the stream is the maxTimeMS of the 'find'.
+    _sep->setResponseMessage(buildOpMsg(BSON(
+        "ok" << 1 << "cursor" << BSON("id" << 0 << "ns" << nss << "nextBatch" << BSONArray()))));
+    _ssm->runNext();
+    ASSERT_EQ(_ssm->state(), State::Source);
+    ASSERT_BSONOBJ_EQ(BSON("getMore" << cursorId << "collection"
+                                     << "coll"
+                                     << "maxTimeMS" << 100 << "$db"
+                                     << "test"),
+                      OpMsgRequest::parse(_sep->getLastRequest()).body);
+}
+
+TEST_F(ServiceStateMachineFixture, TestFindWithExhaustLeavesMaxTimeMSToTheCursor) {
+    const long long cursorId = 42;
+    const std::string nss = "test.coll";
+    Message findWithExhaust = buildOpMsg(BSON("find"
+                                              << "coll"
+                                              << "maxTimeMS" << 100 << "$db"
+                                              << "test"));
+    OpMsg::setFlag(&findWithExhaust, OpMsg::kExhaustSupported);
+
+    Message findRes = buildOpMsg(BSON(
+        "ok" << 1 << "cursor"
+             << BSON("id" << cursorId << "ns" << nss << "firstBatch" << BSONArray())));
+    runSourceAndSinkTest(_tl, _sep, findWithExhaust, findRes, State::Process, State::Process);
+
+    // The cursor keeps the time left from the maxTimeMS of the 'find', which 'getMore' applies.
+    _sep->setResponseMessage(buildOpMsg(BSON(
+        "ok" << 1 << "cursor" << BSON("id" << 0 << "ns" << nss << "nextBatch" << BSONArray()))));
+    _ssm->runNext();
+    ASSERT_EQ(_ssm->state(), State::Source);
+    ASSERT_BSONOBJ_EQ(BSON("getMore" << cursorId << "collection"
+                                     << "coll"
+                                     << "$db"
+                                     << "test"),
+                      OpMsgRequest::parse(_sep->getLastRequest()).body);
+}
+
+TEST_F(ServiceStateMachineFixture, TestFindWithExhaustInTransactionIsNotStreamed) {
+    // Statements of a multi-document transaction are always sent by the client.
+    const std::string nss = "test.coll";
+    Message findWithExhaust = buildOpMsg(BSON("find"
+                                              << "coll"
+                                              << "txnNumber" << 1LL << "$db"
+                                              << "test"));
     OpMsg::setFlag(&findWithExhaust, OpMsg::kExhaustSupported);
 
-    // Construct an OK response.
     Message findRes = buildOpMsg(BSON(
         "ok" << 1 << "cursor" << BSON("id" << 42 << "ns" << nss << "firstBatch" << BSONArray())));
 
-    // Let the 'find' request be sourced from the network, processed in the database, and
-    // and the response sunk to the TransportLayer.
     runSourceAndSinkTest(_tl, _sep, findWithExhaust, findRes, State::Process, State::Source);
 
+    auto msg = _tl->getLastSunk();
+    ASSERT(!msg.empty());
+    ASSERT_FALSE(OpMsg::isFlagSet(msg, OpMsg::kMoreToCome));
+}
+
+TEST_F(ServiceStateMachineFixture, TestExhaustNotSupportedForOtherCommands) {
+    // Construct a 'listIndexes' OP_MSG request with the exhaust flag set. We should ignore exhaust
+    // flags for commands other than 'find', 'aggregate' and 'getMore'.
+    const std::string nss = "test.coll";
+    Message listIndexesWithExhaust = buildOpMsg(BSON("listIndexes"
+                                                     << "coll"
+                                                     << "$db"
+                                                     << "test"));
+    OpMsg::setFlag(&listIndexesWithExhaust, OpMsg::kExhaustSupported);
+
+    // Construct an OK response.
+    Message listIndexesRes = buildOpMsg(BSON(
+        "ok" << 1 << "cursor" << BSON("id" << 42 << "ns" << nss << "firstBatch" << BSONArray())));
+
+    // Let the 'listIndexes' request be sourced from the network, processed in the database, and
+    // and the response sunk to the TransportLayer.
+    runSourceAndSinkTest(
+        _tl, _sep, listIndexesWithExhaust, listIndexesRes, State::Process, State::Source);
+
     // Check the last sunk message.
     auto msg = _tl->getLastSunk();
     ASSERT(!msg.empty());
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include <utility>
 
 #include "mongo/base/system_error.h"
@@ -37,6 +39,7 @@
 #include "mongo/transport/asio_utils.h"
 #include "mongo/transport/baton.h"
 #include "mongo/transport/transport_layer_asio.h"
+#include "mongo/transport/transport_layer_asio_gen.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/net/socket_utils.h"
 #ifdef MONGO_CONFIG_SSL
@@ -350,7 +353,11 @@ private:
     Future<Message> sourceMessageImpl(const BatonHandle& baton = nullptr) {
         static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
 
-        auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
+        if (canReadAhead()) {
+            return sourceMessageWithReadAhead(baton);
+        }
+
+        auto headerBuffer = SharedBuffer::allocateFromPool(kHeaderSize);
         auto ptr = headerBuffer.get();
         return read(asio::buffer(ptr, kHeaderSize), baton)
             .then([headerBuffer = std::move(headerBuffer), this, baton]() mutable {
@@ -377,7 +384,7 @@ private:
                     return Future<Message>::makeReady(Message(std::move(headerBuffer)));
                 }
 
-                auto buffer = SharedBuffer::allocate(msgLen);
+                auto buffer = SharedBuffer::allocateFromPool(msgLen);
                 memcpy(buffer.get(), headerBuffer.get(), kHeaderSize);
 
                 MsgData::View msgView(buffer.get());
@@ -391,6 +398,124 @@ private:
             });
     }
 
+    /**
+     * Read-ahead is only used on plaintext sockets, once the first message has shown that the
+     * session isn't going to be upgraded to TLS. A TLS stream already reads through its own
+     * buffer.
+     */
+    bool canReadAhead() const {
+        if (gTransportLayerASIOReadAheadBytes <= static_cast<int>(sizeof(MSGHEADER::Value))) {
+            return false;
+        }
+#ifdef MONGO_CONFIG_SSL
+        return !_sslSocket && _ranHandshake;
+#else
+        return true;
+#endif
+    }
+
+    /**
+     * Like the regular path of sourceMessageImpl(), but reads through _readAheadBuffer so that a
+     * small message, or the start of a large one, arrives with its header in a single read.
+     */
+    Future<Message> sourceMessageWithReadAhead(const BatonHandle& baton) {
+        static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+
+        return fillReadAheadBuffer(kHeaderSize, baton).then([this, baton]() mutable {
+            const char* header = _readAheadBuffer.get() + _readAheadBegin;
+            if (checkForHTTPRequest(asio::buffer(header, kHeaderSize))) {
+                return sendHTTPResponse(baton);
+            }
+
+            const auto msgLen = size_t(MSGHEADER::ConstView(header).getMessageLength());
+            if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
+                StringBuilder sb;
+                sb << "recv(): message msgLen " << msgLen << " is invalid. "
+                   << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
+                const auto str = sb.str();
+                LOG(0) << str;
+
+                return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
+            }
+
+            auto buffer = SharedBuffer::allocateFromPool(msgLen);
+            const size_t buffered = std::min(msgLen, _readAheadEnd - _readAheadBegin);
+            memcpy(buffer.get(), header, buffered);
+            _readAheadBegin += buffered;
+
+            auto onComplete = [this, msgLen](SharedBuffer buffer) {
+                if (_isIngressSession) {
+                    networkCounter.hitPhysicalIn(msgLen);
+                }
+                return Message(std::move(buffer));
+            };
+
+            if (buffered == msgLen) {
+                return Future<Message>::makeReady(onComplete(std::move(buffer)));
+            }
+
+            // The rest of a message that didn't fit is read straight into its own buffer.
+            auto ptr = buffer.get() + buffered;
+            return read(asio::buffer(ptr, msgLen - buffered), baton)
+                .then([buffer = std::move(buffer), onComplete]() mutable {
+                    return onComplete(std::move(buffer));
+                });
+        });
+    }
+
+    /**
+     * Reads from the socket into _readAheadBuffer until it holds at least 'minBytes' unconsumed
+     * bytes, taking whatever else is already available on the socket in the same reads.
+     */
+    Future<void> fillReadAheadBuffer(size_t minBytes, const BatonHandle& baton) {
+        const size_t capacity = gTransportLayerASIOReadAheadBytes;
+        invariant(minBytes <= capacity);
+
+        if (!_readAheadBuffer) {
+            _readAheadBuffer = SharedBuffer::allocate(capacity);
+        }
+
+        // Move what is left of the previous read to the front, so that the whole buffer past it is
+        // available to the next read. This is normally nothing, or a few bytes.
+        if (_readAheadBegin > 0) {
+            memmove(_readAheadBuffer.get(),
+                    _readAheadBuffer.get() + _readAheadBegin,
+                    _readAheadEnd - _readAheadBegin);
+            _readAheadEnd -= _readAheadBegin;
+            _readAheadBegin = 0;
+        }
+
+        while (_readAheadEnd < minBytes) {
+            std::error_code ec;
+            auto ptr = _readAheadBuffer.get() + _readAheadEnd;
+            _readAheadEnd += _socket.read_some(asio::buffer(ptr, capacity - _readAheadEnd), ec);
+
+            if (((ec == asio::error::would_block) || (ec == asio::error::try_again)) &&
+                (_blockingMode == Async)) {
+                if (baton && baton->networking()) {
+                    return baton->networking()
+                        ->addSession(*this, NetworkingBaton::Type::In)
+                        .then([this, minBytes, baton] {
+                            return fillReadAheadBuffer(minBytes, baton);
+                        });
+                }
+
+                // Wait for the next byte without holding the thread, then pick up anything that
+                // arrived along with it.
+                ptr = _readAheadBuffer.get() + _readAheadEnd;
+                return asio::async_read(_socket, asio::buffer(ptr, 1), UseFuture{})
+                    .then([this, minBytes, baton](size_t size) {
+                        _readAheadEnd += size;
+                        return fillReadAheadBuffer(minBytes, baton);
+                    });
+            } else if (ec) {
+                return futurize(ec);
+            }
+        }
+
+        return Future<void>::makeReady();
+    }
+
     template <typename MutableBufferSequence>
     Future<void> read(const MutableBufferSequence& buffers, const BatonHandle& baton = nullptr) {
 #ifdef MONGO_CONFIG_SSL
@@ -707,6 +832,12 @@ private:
 
     TransportLayerASIO* const _tl;
     bool _isIngressSession;
+
+    // Bytes read from the socket but not yet handed out as part of a message, when read-ahead is
+    // enabled. See sourceMessageWithReadAhead().
+    SharedBuffer _readAheadBuffer;
+    size_t _readAheadBegin = 0;
+    size_t _readAheadEnd = 0;
 };
 
 }  // namespace transport
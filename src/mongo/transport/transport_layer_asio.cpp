@@ -230,8 +230,7 @@ TransportLayerASIO::Options::Options(const ServerGlobalParams* params)
 
 TransportLayerASIO::TransportLayerASIO(const TransportLayerASIO::Options& opts,
                                        ServiceEntryPoint* sep)
-    : _ingressReactor(std::make_shared<ASIOReactor>()),
-      _egressReactor(std::make_shared<ASIOReactor>()),
+    : _egressReactor(std::make_shared<ASIOReactor>()),
       _acceptorReactor(std::make_shared<ASIOReactor>()),
 #ifdef MONGO_CONFIG_SSL
       _ingressSSLContext(nullptr),
@@ -239,6 +238,10 @@ TransportLayerASIO::TransportLayerASIO(const TransportLayerASIO::Options& opts,
 #endif
       _sep(sep),
       _listenerOptions(opts) {
+    invariant(opts.ingressReactors > 0);
+    for (size_t i = 0; i < opts.ingressReactors; ++i) {
+        _ingressReactors.emplace_back(std::make_shared<ASIOReactor>());
+    }
 }
 
 TransportLayerASIO::~TransportLayerASIO() = default;
@@ -845,7 +848,7 @@ void TransportLayerASIO::shutdown() {
 ReactorHandle TransportLayerASIO::getReactor(WhichReactor which) {
     switch (which) {
         case TransportLayer::kIngress:
-            return _ingressReactor;
+            return _ingressReactors.front();
         case TransportLayer::kEgress:
             return _egressReactor;
         case TransportLayer::kNewReactor:
@@ -855,6 +858,10 @@ ReactorHandle TransportLayerASIO::getReactor(WhichReactor which) {
     MONGO_UNREACHABLE;
 }
 
+std::vector<ReactorHandle> TransportLayerASIO::getIngressReactors() const {
+    return {_ingressReactors.begin(), _ingressReactors.end()};
+}
+
 void TransportLayerASIO::_acceptConnection(GenericAcceptor& acceptor) {
     auto acceptCb = [this, &acceptor](const std::error_code& ec, GenericSocket peerSocket) mutable {
         if (!_running.load())
@@ -878,7 +885,10 @@ void TransportLayerASIO::_acceptConnection(GenericAcceptor& acceptor) {
         _acceptConnection(acceptor);
     };
 
-    acceptor.async_accept(*_ingressReactor, std::move(acceptCb));
+    // The accepted socket is created on the next ingress reactor, so that all of its networking
+    // activity happens there.
+    auto& reactor = _ingressReactors[_nextIngressReactor.fetchAndAdd(1) % _ingressReactors.size()];
+    acceptor.async_accept(*reactor, std::move(acceptCb));
 }
 
 #ifdef MONGO_CONFIG_SSL
@@ -109,6 +109,8 @@ public:
         Mode transportMode = Mode::kSynchronous;  // whether accepted sockets should be put into
                                                   // non-blocking mode after they're accepted
         size_t maxConns = DEFAULT_MAX_CONN;       // maximum number of active connections
+        size_t ingressReactors = 1;               // number of reactors accepted sockets are
+                                                  // spread over
     };
 
     TransportLayerASIO(const Options& opts, ServiceEntryPoint* sep);
@@ -128,6 +130,12 @@ public:
 
     ReactorHandle getReactor(WhichReactor which) final;
 
+    /**
+     * Returns all the reactors accepted sockets are spread over. getReactor(kIngress) returns the
+     * first of them.
+     */
+    std::vector<ReactorHandle> getIngressReactors() const;
+
     Status start() final;
 
     void shutdown() final;
@@ -162,11 +170,13 @@ private:
 
     Mutex _mutex = MONGO_MAKE_LATCH("TransportLayerASIO::_mutex");
 
-    // There are three reactors that are used by TransportLayerASIO. The _ingressReactor contains
-    // all the accepted sockets and all ingress networking activity. The _acceptorReactor contains
-    // all the sockets in _acceptors.  The _egressReactor contains egress connections.
+    // There are three kinds of reactors that are used by TransportLayerASIO. The _ingressReactors
+    // contain all the accepted sockets and all ingress networking activity; accepted sockets are
+    // spread over them in round-robin order, and there is only one unless the ServiceExecutor runs
+    // a loop per reactor. The _acceptorReactor contains all the sockets in _acceptors. The
+    // _egressReactor contains egress connections.
     //
-    // TransportLayerASIO should never call run() on the _ingressReactor.
+    // TransportLayerASIO should never call run() on the _ingressReactors.
     // In synchronous mode, this will cause a massive performance degradation due to
     // unnecessary wakeups on the asio thread for sockets we don't intend to interact
     // with asynchronously. The additional IO context avoids registering those sockets
@@ -184,7 +194,7 @@ private:
     // state that is associated with the reactors), so that we destroy any existing acceptors or
     // other reactor associated state before we drop the refcount on the reactor, which may destroy
     // it.
-    std::shared_ptr<ASIOReactor> _ingressReactor;
+    std::vector<std::shared_ptr<ASIOReactor>> _ingressReactors;
     std::shared_ptr<ASIOReactor> _egressReactor;
     std::shared_ptr<ASIOReactor> _acceptorReactor;
 
@@ -200,6 +210,7 @@ private:
 
     ServiceEntryPoint* const _sep = nullptr;
     AtomicWord<bool> _running{false};
+    AtomicWord<unsigned> _nextIngressReactor{0};
     Options _listenerOptions;
     // The real incoming port in case of _listenerOptions.port==0 (ephemeral).
     int _listenerPort = 0;
@@ -35,10 +35,12 @@
 #include "mongo/db/server_options.h"
 #include "mongo/rpc/op_msg.h"
 #include "mongo/transport/service_entry_point.h"
+#include "mongo/transport/transport_layer_asio_gen.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/sock.h"
+#include "mongo/util/scopeguard.h"
 
 #include "asio.hpp"
 
@@ -271,15 +273,26 @@ public:
     }
 
     void sendMessage() {
-        OpMsgBuilder builder;
-        builder.setBody(BSON("ping" << 1));
-        Message msg = builder.finish();
-        msg.header().setResponseToMsgId(0);
-        msg.header().setId(0);
-        OpMsg::appendChecksum(&msg);
+        sendMessages({BSON("ping" << 1)});
+    }
+
+    /**
+     * Sends a message for each of 'bodies' in a single write, so that they arrive pipelined.
+     */
+    void sendMessages(const std::vector<BSONObj>& bodies) {
+        std::string buffer;
+        for (const auto& body : bodies) {
+            OpMsgBuilder builder;
+            builder.setBody(body);
+            Message msg = builder.finish();
+            msg.header().setResponseToMsgId(0);
+            msg.header().setId(0);
+            OpMsg::appendChecksum(&msg);
+            buffer.append(msg.buf(), msg.size());
+        }
 
         std::error_code ec;
-        asio::write(_sock, asio::buffer(msg.buf(), msg.size()), ec);
+        asio::write(_sock, asio::buffer(buffer.data(), buffer.size()), ec);
         ASSERT_FALSE(ec);
     }
 
@@ -380,5 +393,62 @@ TEST(TransportLayerASIO, SwitchTimeoutModes) {
     tla->shutdown();
 }
 
+/* check that reading ahead sources pipelined messages, and those larger than the buffer, intact */
+class ReadAheadSEP : public TimeoutSEP {
+public:
+    explicit ReadAheadSEP(size_t numMessages) : _numMessages(numMessages) {}
+
+    void startSession(transport::SessionHandle session) override {
+        log() << "Accepted connection from " << session->remote();
+        startWorkerThread([this, session = std::move(session)]() mutable {
+            for (size_t i = 0; i < _numMessages; ++i) {
+                auto swMessage = session->sourceMessage();
+                ASSERT_OK(swMessage.getStatus());
+                _bodies.push_back(OpMsg::parse(swMessage.getValue()).body.getOwned());
+            }
+
+            session.reset();
+            notifyComplete();
+        });
+    }
+
+    // Only to be called once waitForTimeout() has returned.
+    const std::vector<BSONObj>& bodies() const {
+        return _bodies;
+    }
+
+private:
+    const size_t _numMessages;
+    std::vector<BSONObj> _bodies;
+};
+
+TEST(TransportLayerASIO, ReadAheadSourcesPipelinedAndLargeMessages) {
+    const auto readAheadBytes = gTransportLayerASIOReadAheadBytes;
+    ON_BLOCK_EXIT([&] { gTransportLayerASIOReadAheadBytes = readAheadBytes; });
+    gTransportLayerASIOReadAheadBytes = 1024;
+
+    const std::vector<BSONObj> bodies{BSON("ping" << 1),
+                                      BSON("ping" << 2),
+                                      BSON("ping" << 3 << "padding" << std::string(4096, 'x')),
+                                      BSON("ping" << 4),
+                                      BSON("ping" << 5)};
+    ReadAheadSEP sep(bodies.size());
+    auto tla = makeAndStartTL(&sep);
+
+    // The first message of a session may be read without read-ahead, in case it starts a TLS
+    // handshake. The others arrive together, and the third does not fit in the buffer.
+    TimeoutConnector connector(tla->listenerPort(), false);
+    connector.sendMessages({bodies[0]});
+    connector.sendMessages({bodies.begin() + 1, bodies.end()});
+
+    ASSERT_TRUE(sep.waitForTimeout());
+    ASSERT_EQ(bodies.size(), sep.bodies().size());
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(bodies[i], sep.bodies()[i]);
+    }
+
+    tla->shutdown();
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,102 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Decoration on OperationContext which tells a TicketHolder which prioritizes its waiters how
+ * urgently the operation should be admitted.
+ *
+ * Only the thread running the operation may use it.
+ */
+class AdmissionContext {
+public:
+    enum class Priority {
+        // Waits behind operations of normal priority, but still gets a share of the tickets.
+        kLow,
+
+        // The priority of operations which do not ask for one.
+        kNormal,
+    };
+
+    static AdmissionContext& get(OperationContext* opCtx);
+
+    Priority getPriority() const {
+        return _priority;
+    }
+
+    void setPriority(Priority priority) {
+        _priority = priority;
+    }
+
+    /**
+     * The number of times the operation has been given a ticket. Operations which yield often
+     * are admitted again after every yield.
+     */
+    int getAdmissions() const {
+        return _admissions;
+    }
+
+    void recordAdmission() {
+        ++_admissions;
+    }
+
+private:
+    Priority _priority = Priority::kNormal;
+    int _admissions = 0;
+};
+
+/**
+ * Sets the admission priority of an operation for the lifetime of this object.
+ */
+class ScopedAdmissionPriority {
+    ScopedAdmissionPriority(const ScopedAdmissionPriority&) = delete;
+    ScopedAdmissionPriority& operator=(const ScopedAdmissionPriority&) = delete;
+
+public:
+    ScopedAdmissionPriority(OperationContext* opCtx, AdmissionContext::Priority priority)
+        : _admCtx(&AdmissionContext::get(opCtx)), _originalPriority(_admCtx->getPriority()) {
+        _admCtx->setPriority(priority);
+    }
+
+    ~ScopedAdmissionPriority() {
+        _admCtx->setPriority(_originalPriority);
+    }
+
+private:
+    AdmissionContext* const _admCtx;
+    const AdmissionContext::Priority _originalPriority;
+};
+
+}  // namespace mongo
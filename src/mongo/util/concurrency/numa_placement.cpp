@@ -0,0 +1,262 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kExecutor
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/concurrency/numa_placement.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#include "mongo/base/parse_number.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/concurrency/numa_placement_gen.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/log.h"
+#include "mongo/util/str.h"
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace mongo {
+namespace {
+
+#if defined(__linux__)
+constexpr auto kSysNodePath = "/sys/devices/system/node";
+
+/**
+ * Reads the CPUs of each node from /sys, leaving out the CPUs this process may not run on, such as
+ * those excluded by a cpuset.
+ */
+std::vector<std::vector<int>> discoverNodeCpus() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        auto ec = errno;
+        warning() << "Cannot read the CPU affinity of the process, NUMA-aware thread placement is "
+                     "disabled: "
+                  << errnoWithDescription(ec);
+        return {};
+    }
+
+    std::vector<std::pair<int, std::vector<int>>> nodes;
+    boost::system::error_code ec;
+    boost::filesystem::directory_iterator di(kSysNodePath, ec);
+    if (ec) {
+        LOG(1) << "Cannot list NUMA nodes in '" << kSysNodePath << "': " << ec.message();
+        return {};
+    }
+
+    for (; di != boost::filesystem::directory_iterator(); di++) {
+        auto name = di->path().filename().generic_string();
+        int nodeId;
+        if (!StringData(name).startsWith("node") ||
+            !NumberParser{}.base(10)(StringData(name).substr(4), &nodeId).isOK()) {
+            continue;
+        }
+
+        std::ifstream f((di->path() / "cpulist").generic_string());
+        std::string cpuList;
+        if (!f.is_open() || !std::getline(f, cpuList)) {
+            continue;
+        }
+
+        auto swCpus = NumaPlacement::parseCpuList(cpuList);
+        if (!swCpus.isOK()) {
+            warning() << "Cannot parse the CPUs of NUMA node " << nodeId << ": "
+                      << swCpus.getStatus();
+            continue;
+        }
+
+        std::vector<int> cpus;
+        for (auto cpu : swCpus.getValue()) {
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+                cpus.push_back(cpu);
+            }
+        }
+        nodes.emplace_back(nodeId, std::move(cpus));
+    }
+
+    std::sort(nodes.begin(), nodes.end());
+
+    std::vector<std::vector<int>> nodeCpus;
+    for (auto& node : nodes) {
+        nodeCpus.push_back(std::move(node.second));
+    }
+    return nodeCpus;
+}
+#else
+std::vector<std::vector<int>> discoverNodeCpus() {
+    return {};
+}
+#endif
+
+}  // namespace
+
+NumaPlacement::NumaPlacement(std::vector<std::vector<int>> nodeCpus)
+    : _nodeCpus([&] {
+          nodeCpus.erase(
+              std::remove_if(nodeCpus.begin(),
+                             nodeCpus.end(),
+                             [](const std::vector<int>& cpus) { return cpus.empty(); }),
+              nodeCpus.end());
+          return std::move(nodeCpus);
+      }()),
+      _threadsBound(std::make_unique<AtomicWord<long long>[]>(_nodeCpus.size())) {}
+
+NumaPlacement& NumaPlacement::get() {
+    static NumaPlacement* placement = new NumaPlacement(discoverNodeCpus());
+    return *placement;
+}
+
+StatusWith<std::vector<int>> NumaPlacement::parseCpuList(StringData cpuList) {
+    std::vector<int> cpus;
+
+    auto parseCpu = [&](StringData str, int* cpu) -> Status {
+        auto status = NumberParser{}.base(10)(str, cpu);
+        if (!status.isOK() || *cpu < 0) {
+            return {ErrorCodes::FailedToParse,
+                    str::stream() << "Invalid CPU '" << str << "' in CPU list '" << cpuList
+                                  << "'"};
+        }
+        return Status::OK();
+    };
+
+    auto rest = cpuList;
+    while (!rest.empty() && (rest[rest.size() - 1] == '\n' || rest[rest.size() - 1] == ' ')) {
+        rest = rest.substr(0, rest.size() - 1);
+    }
+
+    while (!rest.empty()) {
+        auto comma = rest.find(',');
+        auto range = rest.substr(0, comma);
+        rest = comma == std::string::npos ? StringData() : rest.substr(comma + 1);
+
+        auto dash = range.find('-');
+        int first, last;
+        auto status = parseCpu(range.substr(0, dash), &first);
+        if (!status.isOK()) {
+            return status;
+        }
+        last = first;
+        if (dash != std::string::npos) {
+            status = parseCpu(range.substr(dash + 1), &last);
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+
+        if (last < first) {
+            return {ErrorCodes::FailedToParse,
+                    str::stream() << "Invalid CPU range '" << range << "' in CPU list '" << cpuList
+                                  << "'"};
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+bool NumaPlacement::isEnabled() const {
+    return gNumaAwareThreadPlacement && numNodes() > 1;
+}
+
+size_t NumaPlacement::nextNode() {
+    invariant(numNodes() > 0);
+    return _nextNode.fetchAndAdd(1) % numNodes();
+}
+
+int NumaPlacement::bindCurrentThread() {
+    if (!isEnabled()) {
+        return -1;
+    }
+
+    auto node = nextNode();
+    if (!_bindCurrentThreadToNode(node)) {
+        _bindFailures.fetchAndAdd(1);
+        return -1;
+    }
+
+    _threadsBound[node].fetchAndAdd(1);
+    return static_cast<int>(node);
+}
+
+bool NumaPlacement::_bindCurrentThreadToNode(size_t node) {
+#if defined(__linux__)
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (auto cpu : _nodeCpus[node]) {
+        CPU_SET(cpu, &cpus);
+    }
+
+    if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+        auto ec = errno;
+        LOG(1) << "Failed to bind thread to the CPUs of NUMA node " << node << ": "
+               << errnoWithDescription(ec);
+        return false;
+    }
+
+    // A preferred policy with an empty node mask allocates on the node the thread runs on. This
+    // overrides an interleaved policy inherited from numactl, for this thread only.
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, nullptr, 0) != 0) {
+        auto ec = errno;
+        LOG(1) << "Failed to switch thread to allocating from NUMA node " << node << ": "
+               << errnoWithDescription(ec);
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+void NumaPlacement::appendStats(BSONObjBuilder* builder) const {
+    builder->append("enabled", isEnabled());
+    builder->append("numNodes", static_cast<int>(numNodes()));
+
+    BSONArrayBuilder threadsBound(builder->subarrayStart("threadsBound"));
+    for (size_t node = 0; node < numNodes(); ++node) {
+        threadsBound.append(_threadsBound[node].load());
+    }
+    threadsBound.doneFast();
+
+    builder->append("bindFailures", _bindFailures.load());
+}
+
+}  // namespace mongo
@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * Places worker threads on the NUMA nodes of the machine.
+ *
+ * When the numaAwareThreadPlacement server parameter is enabled and there is more than one node
+ * with CPUs, the thread pools which opt in bind each of their threads to the CPUs of one node,
+ * handing out nodes in round-robin order. The thread's memory policy is also switched to local
+ * allocation, so that the pages it touches first are backed by memory of its own node, even when
+ * the rest of the process runs with interleaved allocation.
+ *
+ * Binding is only implemented on Linux; elsewhere the machine is treated as a single node.
+ */
+class NumaPlacement {
+    NumaPlacement(const NumaPlacement&) = delete;
+    NumaPlacement& operator=(const NumaPlacement&) = delete;
+
+public:
+    /**
+     * Creates a placement over nodes with the given CPUs. Nodes without CPUs are ignored.
+     */
+    explicit NumaPlacement(std::vector<std::vector<int>> nodeCpus);
+
+    /**
+     * Returns the placement for the topology of this machine, discovered on first use.
+     */
+    static NumaPlacement& get();
+
+    /**
+     * Parses a list of CPUs in the format of /sys/devices/system/node/node<N>/cpulist, such as
+     * "0-3,8,10-11".
+     */
+    static StatusWith<std::vector<int>> parseCpuList(StringData cpuList);
+
+    size_t numNodes() const {
+        return _nodeCpus.size();
+    }
+
+    /**
+     * Whether threads get bound to nodes: placement is enabled and there is more than one node.
+     */
+    bool isEnabled() const;
+
+    /**
+     * Returns the node the next bound thread should go to.
+     */
+    size_t nextNode();
+
+    /**
+     * Binds the calling thread to the next node, if placement is enabled. Returns the node the
+     * thread was bound to, or -1 if it was not bound.
+     */
+    int bindCurrentThread();
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    bool _bindCurrentThreadToNode(size_t node);
+
+    // The CPUs of each node, in node order.
+    const std::vector<std::vector<int>> _nodeCpus;
+
+    AtomicWord<unsigned> _nextNode{0};
+
+    // The number of threads bound to each node so far.
+    std::unique_ptr<AtomicWord<long long>[]> _threadsBound;
+    AtomicWord<long long> _bindFailures{0};
+};
+
+}  // namespace mongo
@@ -0,0 +1,83 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/numa_placement.h"
+#include "mongo/util/concurrency/numa_placement_gen.h"
+
+namespace {
+using namespace mongo;
+
+TEST(NumaPlacementTest, ParseCpuList) {
+    ASSERT(NumaPlacement::parseCpuList("0").getValue() == std::vector<int>({0}));
+    ASSERT(NumaPlacement::parseCpuList("0-3,8,10-11\n").getValue() ==
+           std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+    ASSERT(NumaPlacement::parseCpuList("").getValue().empty());
+}
+
+TEST(NumaPlacementTest, ParseInvalidCpuList) {
+    ASSERT_EQ(NumaPlacement::parseCpuList("a").getStatus(), ErrorCodes::FailedToParse);
+    ASSERT_EQ(NumaPlacement::parseCpuList("3-1").getStatus(), ErrorCodes::FailedToParse);
+    ASSERT_EQ(NumaPlacement::parseCpuList("0-").getStatus(), ErrorCodes::FailedToParse);
+    ASSERT_EQ(NumaPlacement::parseCpuList("0,,1").getStatus(), ErrorCodes::FailedToParse);
+}
+
+TEST(NumaPlacementTest, IgnoresNodesWithoutCpus) {
+    NumaPlacement placement({{0, 1}, {}, {2, 3}});
+    ASSERT_EQ(placement.numNodes(), 2U);
+}
+
+TEST(NumaPlacementTest, HandsOutNodesRoundRobin) {
+    NumaPlacement placement({{0, 1}, {2, 3}, {4, 5}});
+    std::vector<size_t> nodes;
+    for (int i = 0; i < 6; ++i) {
+        nodes.push_back(placement.nextNode());
+    }
+    ASSERT(nodes == std::vector<size_t>({0, 1, 2, 0, 1, 2}));
+}
+
+TEST(NumaPlacementTest, DoesNotBindWhenDisabled) {
+    NumaPlacement placement({{0}, {1}});
+    gNumaAwareThreadPlacement = false;
+    ASSERT_FALSE(placement.isEnabled());
+    ASSERT_EQ(placement.bindCurrentThread(), -1);
+
+    gNumaAwareThreadPlacement = true;
+    NumaPlacement singleNode({{0, 1}});
+    ASSERT_FALSE(singleNode.isEnabled());
+    ASSERT_EQ(singleNode.bindCurrentThread(), -1);
+    gNumaAwareThreadPlacement = false;
+}
+
+}  // namespace
@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/with_alignment.h"
+
+namespace mongo {
+
+/**
+ * A counter which spreads its updates over several cache-line sized shards, so that threads
+ * running on different cores do not keep pulling the same cache line away from each other. Each
+ * thread is assigned a shard the first time it updates any sharded counter, and reads add up all
+ * of the shards.
+ *
+ * Reads are not a point-in-time snapshot across shards, which is acceptable for statistics.
+ */
+class ShardedCounter {
+public:
+    static constexpr size_t kNumShards = 16;
+
+    ShardedCounter() = default;
+
+    /**
+     * Returns the shard assigned to the calling thread. Statistics which cannot be expressed as
+     * plain counters may use it to pick among their own per-shard copies.
+     */
+    static size_t shardForCurrentThread() {
+        static AtomicWord<unsigned> nextShard{0};
+        thread_local const size_t shard = nextShard.fetchAndAddRelaxed(1) % kNumShards;
+        return shard;
+    }
+
+    /**
+     * Adds 'n' to the shard of the calling thread and returns the value the shard held before.
+     */
+    long long fetchAndAdd(long long n) {
+        return _shards[shardForCurrentThread()].fetchAndAddRelaxed(n);
+    }
+
+    void add(long long n) {
+        fetchAndAdd(n);
+    }
+
+    long long load() const {
+        long long total = 0;
+        for (const auto& shard : _shards) {
+            total += shard.loadRelaxed();
+        }
+        return total;
+    }
+
+    /**
+     * Sets the counter to 'value'. Updates made concurrently by other threads may be lost.
+     */
+    void store(long long value) {
+        for (auto& shard : _shards) {
+            shard.store(0);
+        }
+        _shards[0].store(value);
+    }
+
+private:
+    std::array<CacheAligned<AtomicWord<long long>>, kNumShards> _shards;
+};
+
+}  // namespace mongo
@@ -0,0 +1,84 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/concurrency/sharded_counter.h"
+
+#include <vector>
+
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(ShardedCounterTest, AddAndStore) {
+    ShardedCounter counter;
+    ASSERT_EQ(0, counter.load());
+
+    counter.add(5);
+    ASSERT_EQ(5, counter.fetchAndAdd(-2));
+    ASSERT_EQ(3, counter.load());
+
+    counter.store(42);
+    ASSERT_EQ(42, counter.load());
+    counter.add(1);
+    ASSERT_EQ(43, counter.load());
+}
+
+TEST(ShardedCounterTest, ThreadsKeepTheirShard) {
+    auto shard = ShardedCounter::shardForCurrentThread();
+    ASSERT_LT(shard, ShardedCounter::kNumShards);
+    ASSERT_EQ(shard, ShardedCounter::shardForCurrentThread());
+}
+
+TEST(ShardedCounterTest, ConcurrentIncrementsAreAllCounted) {
+    const int kThreads = static_cast<int>(ShardedCounter::kNumShards) * 2;
+    const int kIncrements = 10000;
+    ShardedCounter counter;
+
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kIncrements; ++j) {
+                counter.add(1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(static_cast<long long>(kThreads) * kIncrements, counter.load());
+}
+
+}  // namespace
+}  // namespace mongo
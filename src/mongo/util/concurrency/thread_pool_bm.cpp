@@ -0,0 +1,153 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/concurrency/work_stealing_thread_pool.h"
+#include "mongo/util/processinfo.h"
+
+namespace mongo {
+namespace {
+
+constexpr size_t kPoolThreads = 8;
+constexpr int kTasksPerIteration = 1000;
+
+std::unique_ptr<ThreadPoolInterface> makeThreadPool() {
+    ThreadPool::Options options;
+    options.minThreads = kPoolThreads;
+    options.maxThreads = kPoolThreads;
+    return std::make_unique<ThreadPool>(std::move(options));
+}
+
+std::unique_ptr<ThreadPoolInterface> makeWorkStealingThreadPool() {
+    WorkStealingThreadPool::Options options;
+    options.numThreads = kPoolThreads;
+    return std::make_unique<WorkStealingThreadPool>(std::move(options));
+}
+
+/**
+ * Counts down completed tasks, and lets a benchmark thread wait for all of its tasks.
+ */
+class CountDownLatch {
+public:
+    explicit CountDownLatch(int count) : _count(count) {}
+
+    void countDown() {
+        if (_count.subtractAndFetch(1) == 0) {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _cv.notify_all();
+        }
+    }
+
+    void wait() {
+        stdx::unique_lock<Latch> lk(_mutex);
+        _cv.wait(lk, [&] { return _count.load() == 0; });
+    }
+
+private:
+    AtomicWord<int> _count;
+    Mutex _mutex = MONGO_MAKE_LATCH("CountDownLatch::_mutex");
+    stdx::condition_variable _cv;
+};
+
+/**
+ * Each benchmark thread schedules tasks from outside the pool, so this measures the cost of
+ * handing off tasks to the pool's workers.
+ */
+template <std::unique_ptr<ThreadPoolInterface> (*makePool)()>
+void BM_ExternalSubmit(benchmark::State& state) {
+    static std::unique_ptr<ThreadPoolInterface> pool;
+    if (state.thread_index == 0) {
+        pool = makePool();
+        pool->startup();
+    }
+
+    for (auto keepRunning : state) {
+        CountDownLatch done(kTasksPerIteration);
+        for (int i = 0; i < kTasksPerIteration; ++i) {
+            pool->schedule([&](auto status) { done.countDown(); });
+        }
+        done.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * kTasksPerIteration);
+
+    if (state.thread_index == 0) {
+        pool->shutdown();
+        pool->join();
+        pool.reset();
+    }
+}
+
+/**
+ * Each benchmark thread schedules one task, which schedules the rest from inside the pool. For the
+ * work-stealing pool, they all land on one worker's deque and the others must steal them.
+ */
+template <std::unique_ptr<ThreadPoolInterface> (*makePool)()>
+void BM_FanOut(benchmark::State& state) {
+    static std::unique_ptr<ThreadPoolInterface> pool;
+    if (state.thread_index == 0) {
+        pool = makePool();
+        pool->startup();
+    }
+
+    for (auto keepRunning : state) {
+        CountDownLatch done(kTasksPerIteration);
+        pool->schedule([&](auto status) {
+            for (int i = 0; i < kTasksPerIteration; ++i) {
+                pool->schedule([&](auto status) { done.countDown(); });
+            }
+        });
+        done.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * kTasksPerIteration);
+
+    if (state.thread_index == 0) {
+        pool->shutdown();
+        pool->join();
+        pool.reset();
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_ExternalSubmit, makeThreadPool)
+    ->ThreadRange(1, ProcessInfo::getNumAvailableCores());
+BENCHMARK_TEMPLATE(BM_ExternalSubmit, makeWorkStealingThreadPool)
+    ->ThreadRange(1, ProcessInfo::getNumAvailableCores());
+BENCHMARK_TEMPLATE(BM_FanOut, makeThreadPool)->ThreadRange(1, ProcessInfo::getNumAvailableCores());
+BENCHMARK_TEMPLATE(BM_FanOut, makeWorkStealingThreadPool)
+    ->ThreadRange(1, ProcessInfo::getNumAvailableCores());
+
+}  // namespace
+}  // namespace mongo
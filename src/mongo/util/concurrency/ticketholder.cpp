@@ -33,10 +33,15 @@
 
 #include "mongo/util/concurrency/ticketholder.h"
 
+#include <algorithm>
 #include <iostream>
 
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/concurrency/admission_context.h"
+#include "mongo/util/concurrency/ticketholder_gen.h"
 #include "mongo/util/log.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -88,11 +93,7 @@ bool TicketHolder::tryAcquire() {
     return true;
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    waitForTicketUntil(opCtx, Date_t::max());
-}
-
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+bool TicketHolder::_waitForTicketUntil(OperationContext* opCtx, Date_t until) {
     const Milliseconds intervalMs(500);
     struct timespec ts;
 
@@ -123,7 +124,7 @@ bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
     return true;
 }
 
-void TicketHolder::release() {
+void TicketHolder::_releaseToPool() {
     check(sem_post(&_sem));
 }
 
@@ -178,29 +179,22 @@ bool TicketHolder::tryAcquire() {
     return _tryAcquire();
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
-    } else {
-        _newTicket.wait(lk, [this] { return _tryAcquire(); });
-    }
-}
-
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+bool TicketHolder::_waitForTicketUntil(OperationContext* opCtx, Date_t until) {
     stdx::unique_lock<Latch> lk(_mutex);
 
     if (opCtx) {
         return opCtx->waitForConditionOrInterruptUntil(
             _newTicket, lk, until, [this] { return _tryAcquire(); });
+    } else if (until == Date_t::max()) {
+        _newTicket.wait(lk, [this] { return _tryAcquire(); });
+        return true;
     } else {
         return _newTicket.wait_until(
             lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
     }
 }
 
-void TicketHolder::release() {
+void TicketHolder::_releaseToPool() {
     {
         stdx::lock_guard<Latch> lk(_mutex);
         _num++;
@@ -253,4 +247,215 @@ bool TicketHolder::_tryAcquire() {
     return true;
 }
 #endif
+
+void TicketHolder::waitForTicket(OperationContext* opCtx, AdmissionContext* admCtx) {
+    waitForTicketUntil(opCtx, admCtx, Date_t::max());
+}
+
+bool TicketHolder::tryAdmit(AdmissionContext* admCtx) {
+    // Taking a ticket straight from the pool would jump ahead of any queued waiters.
+    if (_numQueued.load() != 0 || !tryAcquire()) {
+        return false;
+    }
+
+    _numAdmitted.fetchAndAddRelaxed(1);
+    if (admCtx) {
+        admCtx->recordAdmission();
+    }
+    return true;
+}
+
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx,
+                                      AdmissionContext* admCtx,
+                                      Date_t until) {
+    if (tryAdmit(admCtx)) {
+        return true;
+    }
+
+    _numDelayed.fetchAndAddRelaxed(1);
+    const bool admitted = _prioritized.load() ? _waitInQueueUntil(opCtx, admCtx, until)
+                                              : _waitForTicketUntil(opCtx, until);
+    if (!admitted) {
+        return false;
+    }
+
+    _numAdmitted.fetchAndAddRelaxed(1);
+    if (admCtx) {
+        admCtx->recordAdmission();
+    }
+    return true;
+}
+
+void TicketHolder::release() {
+    _releaseToPool();
+
+    // A waiter which queued while the ticket was being released may have missed it in the pool,
+    // so whoever releases a ticket while there are queued waiters hands one over.
+    if (_numQueued.load() > 0) {
+        stdx::lock_guard<Latch> lk(_queueMutex);
+        _grantQueuedWaiters(lk);
+    }
+}
+
+void TicketHolder::setPrioritized(bool prioritized) {
+    _prioritized.store(prioritized);
+}
+
+void TicketHolder::appendQueueStats(BSONObjBuilder* builder) const {
+    if (!_prioritized.load()) {
+        return;
+    }
+
+    std::array<size_t, kNumQueueTypes> queueLengths;
+    {
+        stdx::lock_guard<Latch> lk(_queueMutex);
+        for (size_t i = 0; i < kNumQueueTypes; ++i) {
+            queueLengths[i] = _queues[i].size();
+        }
+    }
+
+    BSONObjBuilder queuesBuilder(builder->subobjStart("queues"));
+    for (size_t i = 0; i < kNumQueueTypes; ++i) {
+        const auto& stats = _queueStats[i];
+        BSONObjBuilder queueBuilder(queuesBuilder.subobjStart(
+            static_cast<QueueType>(i) == QueueType::kNormalPriority ? "normalPriority"
+                                                                    : "lowPriority"));
+        queueBuilder.append("addedToQueue", stats.addedToQueue.load());
+        queueBuilder.append("admitted", stats.admitted.load());
+        queueBuilder.append("canceled", stats.canceled.load());
+        queueBuilder.append("queueLength", static_cast<long long>(queueLengths[i]));
+        queueBuilder.append("totalTimeQueuedMicros", stats.totalTimeQueuedMicros.load());
+
+        BSONArrayBuilder histogramBuilder(queueBuilder.subarrayStart("waitTimeHistogram"));
+        for (size_t bucket = 0; bucket < stats.waitTimeBuckets.size(); ++bucket) {
+            const auto count = stats.waitTimeBuckets[bucket].load();
+            if (count == 0) {
+                continue;
+            }
+
+            BSONObjBuilder entryBuilder(histogramBuilder.subobjStart());
+            entryBuilder.append("micros", bucket == 0 ? 0LL : kWaitBucketBounds[bucket - 1]);
+            entryBuilder.append("count", count);
+            entryBuilder.doneFast();
+        }
+        histogramBuilder.doneFast();
+        queueBuilder.doneFast();
+    }
+    queuesBuilder.doneFast();
+}
+
+bool TicketHolder::_waitInQueueUntil(OperationContext* opCtx,
+                                     AdmissionContext* admCtx,
+                                     Date_t until) {
+    const auto queueType = _queueTypeFor(admCtx);
+    auto& queue = _queues[static_cast<size_t>(queueType)];
+    auto& stats = _queueStats[static_cast<size_t>(queueType)];
+    Timer queuedTimer;
+
+    stdx::unique_lock<Latch> lk(_queueMutex);
+
+    // Waiters which are already queued go first, so the pool is only tried when there are none.
+    // They are counted before trying it, so that any release which returns a ticket to the pool
+    // afterwards hands it over.
+    if (_numQueued.fetchAndAdd(1) == 0 && tryAcquire()) {
+        _numQueued.subtractAndFetch(1);
+        return true;
+    }
+
+    Waiter waiter;
+    const auto it = queue.insert(queue.end(), &waiter);
+    stats.addedToQueue.fetchAndAdd(1);
+
+    const auto leaveQueue = [&] {
+        queue.erase(it);
+        _numQueued.subtractAndFetch(1);
+        stats.canceled.fetchAndAdd(1);
+        _recordQueueWait(queueType, queuedTimer.micros());
+    };
+
+    bool admitted;
+    try {
+        const auto isGranted = [&] { return waiter.isGranted; };
+        if (opCtx) {
+            admitted =
+                opCtx->waitForConditionOrInterruptUntil(waiter.granted, lk, until, isGranted);
+        } else if (until == Date_t::max()) {
+            waiter.granted.wait(lk, isGranted);
+            admitted = true;
+        } else {
+            admitted = waiter.granted.wait_until(lk, until.toSystemTimePoint(), isGranted);
+        }
+    } catch (const DBException&) {
+        if (waiter.isGranted) {
+            // The wait was interrupted just as the ticket was handed over, so pass it on.
+            lk.unlock();
+            _recordQueueWait(queueType, queuedTimer.micros());
+            release();
+        } else {
+            leaveQueue();
+        }
+        throw;
+    }
+
+    if (!admitted) {
+        leaveQueue();
+        return false;
+    }
+
+    _recordQueueWait(queueType, queuedTimer.micros());
+    return true;
+}
+
+void TicketHolder::_grantQueuedWaiters(WithLock) {
+    auto& normalQueue = _queues[static_cast<size_t>(QueueType::kNormalPriority)];
+    auto& lowQueue = _queues[static_cast<size_t>(QueueType::kLowPriority)];
+
+    while ((!normalQueue.empty() || !lowQueue.empty()) && tryAcquire()) {
+        const bool admitLow = !lowQueue.empty() &&
+            (normalQueue.empty() ||
+             _lowPriorityBypassed >= gLowPriorityAdmissionBypassThreshold.load());
+        if (admitLow) {
+            _lowPriorityBypassed = 0;
+        } else if (!lowQueue.empty()) {
+            ++_lowPriorityBypassed;
+        }
+
+        const auto queueType = admitLow ? QueueType::kLowPriority : QueueType::kNormalPriority;
+        auto& queue = admitLow ? lowQueue : normalQueue;
+        Waiter* const waiter = queue.front();
+        queue.pop_front();
+        _numQueued.subtractAndFetch(1);
+
+        waiter->isGranted = true;
+        waiter->granted.notify_one();
+        _queueStats[static_cast<size_t>(queueType)].admitted.fetchAndAdd(1);
+    }
+}
+
+TicketHolder::QueueType TicketHolder::_queueTypeFor(const AdmissionContext* admCtx) {
+    if (!admCtx) {
+        return QueueType::kNormalPriority;
+    }
+
+    if (admCtx->getPriority() == AdmissionContext::Priority::kLow) {
+        return QueueType::kLowPriority;
+    }
+
+    const auto admissionsBeforeLowPriority = gAdmissionsBeforeLowPriority.load();
+    return admissionsBeforeLowPriority > 0 &&
+            admCtx->getAdmissions() >= admissionsBeforeLowPriority
+        ? QueueType::kLowPriority
+        : QueueType::kNormalPriority;
+}
+
+void TicketHolder::_recordQueueWait(QueueType queueType, long long waitMicros) {
+    auto& stats = _queueStats[static_cast<size_t>(queueType)];
+    stats.totalTimeQueuedMicros.fetchAndAdd(waitMicros);
+
+    const auto bucket =
+        std::upper_bound(kWaitBucketBounds.begin(), kWaitBucketBounds.end(), waitMicros) -
+        kWaitBucketBounds.begin();
+    stats.waitTimeBuckets[bucket].fetchAndAdd(1);
+}
+
 }  // namespace mongo
@@ -32,30 +32,60 @@
 #include <semaphore.h>
 #endif
 
+#include <array>
+#include <list>
+
 #include "mongo/db/operation_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
 
+class AdmissionContext;
+class BSONObjBuilder;
+
+/**
+ * Limits the number of operations which may run at once to the number of tickets it holds.
+ *
+ * By default waiters get tickets in no particular order. A holder which prioritizes its waiters
+ * queues them by their AdmissionContext instead: operations which asked for low priority, and
+ * operations which have been admitted many times such as long-running reads which yield often,
+ * wait behind the others but are still admitted after a bounded number of them.
+ */
 class TicketHolder {
     TicketHolder(const TicketHolder&) = delete;
     TicketHolder& operator=(const TicketHolder&) = delete;
 
 public:
+    enum class QueueType { kNormalPriority, kLowPriority };
+
     explicit TicketHolder(int num);
     ~TicketHolder();
 
     bool tryAcquire();
 
+    /**
+     * Takes a ticket without blocking if one is available and no waiter is queued ahead of the
+     * caller. Returns 'false' otherwise. On success the admission is counted as by
+     * waitForTicket(), and recorded in 'admCtx' if it is provided.
+     */
+    bool tryAdmit(AdmissionContext* admCtx);
+
     /**
      * Attempts to acquire a ticket. Blocks until a ticket is acquired or the OperationContext
      * 'opCtx' is killed, throwing an AssertionException.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
+     * If 'admCtx' is provided, it decides the queue of the waiter when the holder prioritizes its
+     * waiters, and the admission is recorded in it.
      */
-    void waitForTicket(OperationContext* opCtx);
+    void waitForTicket(OperationContext* opCtx, AdmissionContext* admCtx);
+    void waitForTicket(OperationContext* opCtx) {
+        waitForTicket(opCtx, nullptr);
+    }
     void waitForTicket() {
         waitForTicket(nullptr);
     }
@@ -67,7 +97,10 @@ public:
      * proceed.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    bool waitForTicketUntil(OperationContext* opCtx, Date_t until);
+    bool waitForTicketUntil(OperationContext* opCtx, AdmissionContext* admCtx, Date_t until);
+    bool waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+        return waitForTicketUntil(opCtx, nullptr, until);
+    }
     bool waitForTicketUntil(Date_t until) {
         return waitForTicketUntil(nullptr, until);
     }
@@ -81,7 +114,98 @@ public:
 
     int outof() const;
 
+    /**
+     * Returns the number of operations which got a ticket by waiting for one, and the number of
+     * those which could not get one straight away, since the holder was created.
+     */
+    long long numAdmitted() const {
+        return _numAdmitted.loadRelaxed();
+    }
+    long long numDelayed() const {
+        return _numDelayed.loadRelaxed();
+    }
+
+    /**
+     * Makes waiters queue by priority, or get tickets in no particular order again. Operations
+     * which are already waiting keep waiting the way they started to.
+     */
+    void setPrioritized(bool prioritized);
+
+    /**
+     * Appends the statistics of the priority queues, if the holder prioritizes its waiters.
+     */
+    void appendQueueStats(BSONObjBuilder* builder) const;
+
 private:
+    static constexpr size_t kNumQueueTypes = 2;
+
+    // Upper bounds in microseconds of the buckets of the queue wait time histograms, except for
+    // the last bucket which has no bound.
+    static constexpr std::array<long long, 6> kWaitBucketBounds{
+        10, 100, 1000, 10 * 1000, 100 * 1000, 1000 * 1000};
+
+    struct QueueStats {
+        AtomicWord<long long> addedToQueue{0};
+        AtomicWord<long long> admitted{0};
+        AtomicWord<long long> canceled{0};
+        AtomicWord<long long> totalTimeQueuedMicros{0};
+        std::array<AtomicWord<long long>, kWaitBucketBounds.size() + 1> waitTimeBuckets;
+    };
+
+    // An operation waiting in a priority queue.
+    struct Waiter {
+        stdx::condition_variable granted;
+        bool isGranted = false;
+    };
+
+    /**
+     * Waits for a ticket from the pool, the way a holder which does not prioritize its waiters
+     * does.
+     */
+    bool _waitForTicketUntil(OperationContext* opCtx, Date_t until);
+
+    /**
+     * Waits for a ticket in the priority queue for 'admCtx'.
+     */
+    bool _waitInQueueUntil(OperationContext* opCtx, AdmissionContext* admCtx, Date_t until);
+
+    /**
+     * Returns a ticket to the pool, without handing it to a queued waiter.
+     */
+    void _releaseToPool();
+
+    /**
+     * Hands tickets from the pool to queued waiters while there are both.
+     */
+    void _grantQueuedWaiters(WithLock);
+
+    /**
+     * Returns the queue an operation with 'admCtx' waits in.
+     */
+    static QueueType _queueTypeFor(const AdmissionContext* admCtx);
+
+    void _recordQueueWait(QueueType queueType, long long waitMicros);
+
+    AtomicWord<bool> _prioritized{false};
+
+    AtomicWord<long long> _numAdmitted{0};
+    AtomicWord<long long> _numDelayed{0};
+
+    // Waiters which are queued or about to be. A release hands its ticket from the pool to a
+    // queued waiter while there are any.
+    AtomicWord<int> _numQueued{0};
+
+    mutable Mutex _queueMutex = MONGO_MAKE_LATCH("TicketHolder::_queueMutex");
+
+    // The waiters in each priority queue, in arrival order. Protected by '_queueMutex'.
+    std::array<std::list<Waiter*>, kNumQueueTypes> _queues;
+
+    // Operations of normal priority admitted since the last operation of low priority, while one
+    // was waiting. Protected by '_queueMutex'.
+    int _lowPriorityBypassed = 0;
+
+    std::array<QueueStats, kNumQueueTypes> _queueStats;
+
 #if defined(__linux__)
     mutable sem_t _sem;
 
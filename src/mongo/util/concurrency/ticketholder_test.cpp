@@ -32,8 +32,15 @@
 
 #include "mongo/platform/basic.h"
 
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/admission_context.h"
 #include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/concurrency/ticketholder_gen.h"
+#include "mongo/util/scopeguard.h"
 
 namespace {
 using namespace mongo;
@@ -72,4 +79,91 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+long long queueStat(const TicketHolder& holder, StringData queue, StringData stat) {
+    BSONObjBuilder builder;
+    holder.appendQueueStats(&builder);
+    return builder.obj()["queues"].Obj()[queue].Obj()[stat].numberLong();
+}
+
+void waitForQueueLength(const TicketHolder& holder, StringData queue, long long length) {
+    while (queueStat(holder, queue, "queueLength") != length) {
+        sleepmillis(1);
+    }
+}
+
+/**
+ * Queues an operation of low and one of normal priority for the only ticket of a prioritized
+ * holder and returns the order in which they were admitted.
+ */
+std::vector<AdmissionContext::Priority> admitLowAndNormalPriority(TicketHolder* holder) {
+    holder->setPrioritized(true);
+    ASSERT(holder->tryAcquire());
+
+    std::vector<AdmissionContext::Priority> admitted;
+    const auto waitForTicket = [&](AdmissionContext::Priority priority) {
+        return stdx::thread([&admitted, holder, priority] {
+            AdmissionContext admCtx;
+            admCtx.setPriority(priority);
+            holder->waitForTicket(nullptr, &admCtx);
+            ASSERT_EQ(1, admCtx.getAdmissions());
+
+            admitted.push_back(priority);
+            holder->release();
+        });
+    };
+
+    auto lowPriority = waitForTicket(AdmissionContext::Priority::kLow);
+    waitForQueueLength(*holder, "lowPriority", 1);
+    auto normalPriority = waitForTicket(AdmissionContext::Priority::kNormal);
+    waitForQueueLength(*holder, "normalPriority", 1);
+
+    holder->release();
+    lowPriority.join();
+    normalPriority.join();
+
+    ASSERT_EQ(1, queueStat(*holder, "lowPriority", "admitted"));
+    ASSERT_EQ(1, queueStat(*holder, "normalPriority", "admitted"));
+    return admitted;
+}
+
+TEST(TicketholderTest, PrioritizedAdmitsNormalPriorityFirst) {
+    TicketHolder holder(1);
+    ASSERT(admitLowAndNormalPriority(&holder) ==
+           std::vector<AdmissionContext::Priority>({AdmissionContext::Priority::kNormal,
+                                                    AdmissionContext::Priority::kLow}));
+}
+
+TEST(TicketholderTest, PrioritizedAdmitsLowPriorityAfterBypassThreshold) {
+    const auto originalThreshold = gLowPriorityAdmissionBypassThreshold.load();
+    gLowPriorityAdmissionBypassThreshold.store(0);
+    ON_BLOCK_EXIT([&] { gLowPriorityAdmissionBypassThreshold.store(originalThreshold); });
+
+    TicketHolder holder(1);
+    ASSERT(admitLowAndNormalPriority(&holder) ==
+           std::vector<AdmissionContext::Priority>({AdmissionContext::Priority::kLow,
+                                                    AdmissionContext::Priority::kNormal}));
+}
+
+TEST(TicketholderTest, PrioritizedQueuesOftenAdmittedOperationsAsLowPriority) {
+    TicketHolder holder(1);
+    holder.setPrioritized(true);
+
+    AdmissionContext admCtx;
+    for (int i = 0; i < gAdmissionsBeforeLowPriority.load(); ++i) {
+        ASSERT(holder.waitForTicketUntil(nullptr, &admCtx, Date_t::now()));
+        holder.release();
+    }
+    ASSERT_EQ(gAdmissionsBeforeLowPriority.load(), admCtx.getAdmissions());
+
+    ASSERT(holder.tryAcquire());
+    ASSERT_FALSE(holder.waitForTicketUntil(nullptr, &admCtx, Date_t::now() + Milliseconds(2)));
+    ASSERT_EQ(1, queueStat(holder, "lowPriority", "addedToQueue"));
+    ASSERT_EQ(1, queueStat(holder, "lowPriority", "canceled"));
+    ASSERT_EQ(0, queueStat(holder, "lowPriority", "queueLength"));
+    ASSERT_EQ(0, queueStat(holder, "normalPriority", "addedToQueue"));
+
+    holder.release();
+    ASSERT_EQ(holder.used(), 0);
+}
 }  // namespace
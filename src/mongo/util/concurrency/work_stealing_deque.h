@@ -0,0 +1,183 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <atomic>  // NOLINT
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "mongo/stdx/new.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+/**
+ * A lock-free double-ended queue of pointers, after Chase and Lev, "Dynamic Circular Work-Stealing
+ * Deque" (SPAA 2005), with the memory orders of Le et al., "Correct and Efficient Work-Stealing
+ * for Weak Memory Models" (PPoPP 2013).
+ *
+ * One thread, the owner, pushes and pops at the bottom, like a stack. Any other thread may steal
+ * from the top. The deque does not own the pointed-to objects.
+ *
+ * The buffer grows as needed. Buffers that have been outgrown are kept until the deque is
+ * destroyed, because a thief may still be reading from one.
+ */
+template <typename T>
+class WorkStealingDeque {
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+public:
+    explicit WorkStealingDeque(int64_t initialCapacity = 256) {
+        invariant(initialCapacity > 0 && (initialCapacity & (initialCapacity - 1)) == 0);
+        _buffers.push_back(std::make_unique<Buffer>(initialCapacity));
+        _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    /**
+     * Adds 'item' at the bottom. Only the owner may call this.
+     */
+    void push(T* item) {
+        auto bottom = _bottom.load(std::memory_order_relaxed);
+        auto top = _top.load(std::memory_order_acquire);
+        auto buffer = _buffer.load(std::memory_order_relaxed);
+        if (bottom - top > buffer->capacity - 1) {
+            buffer = _grow(buffer, top, bottom);
+        }
+        buffer->put(bottom, item);
+        // A release store rather than the paper's release fence, which ThreadSanitizer does not
+        // understand. They are the same on x86.
+        _bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    /**
+     * Removes and returns the item at the bottom, or nullptr if the deque is empty. Only the owner
+     * may call this.
+     */
+    T* pop() {
+        auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        auto buffer = _buffer.load(std::memory_order_relaxed);
+        _bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);  // NOLINT
+        auto top = _top.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            // Empty.
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T* item = buffer->get(bottom);
+        if (top == bottom) {
+            // This is the last item, so race the thieves for it.
+            if (!_top.compare_exchange_strong(
+                    top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    /**
+     * Removes and returns the item at the top, or nullptr if the deque is empty or another thread
+     * won the race for the item. Any thread may call this.
+     */
+    T* steal() {
+        auto top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);  // NOLINT
+        auto bottom = _bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom) {
+            return nullptr;
+        }
+
+        auto buffer = _buffer.load(std::memory_order_acquire);
+        T* item = buffer->get(top);
+        if (!_top.compare_exchange_strong(
+                top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    /**
+     * Returns whether the deque looked empty at some point during the call. Any thread may call
+     * this.
+     */
+    bool empty() const {
+        auto top = _top.load(std::memory_order_acquire);
+        auto bottom = _bottom.load(std::memory_order_acquire);
+        return top >= bottom;
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(int64_t capacity)
+            : capacity(capacity), slots(new std::atomic<T*>[capacity]) {}  // NOLINT
+
+        T* get(int64_t index) const {
+            return slots[index & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, T* item) {
+            slots[index & (capacity - 1)].store(item, std::memory_order_relaxed);
+        }
+
+        const int64_t capacity;
+        std::unique_ptr<std::atomic<T*>[]> slots;  // NOLINT
+    };
+
+    Buffer* _grow(Buffer* buffer, int64_t top, int64_t bottom) {
+        _buffers.push_back(std::make_unique<Buffer>(buffer->capacity * 2));
+        auto grown = _buffers.back().get();
+        for (auto i = top; i < bottom; ++i) {
+            grown->put(i, buffer->get(i));
+        }
+        _buffer.store(grown, std::memory_order_release);
+        return grown;
+    }
+
+    // Indexes of the top and bottom of the deque. They only ever grow, apart from the owner
+    // briefly decrementing '_bottom' in pop(). Thieves write '_top' and the owner writes
+    // '_bottom', so they are kept on separate cache lines.
+    alignas(stdx::hardware_destructive_interference_size) std::atomic<int64_t> _top{0};  // NOLINT
+    alignas(stdx::hardware_destructive_interference_size)
+        std::atomic<int64_t> _bottom{0};  // NOLINT
+
+    std::atomic<Buffer*> _buffer{nullptr};  // NOLINT
+
+    // Every buffer the deque has used. Only the owner touches this.
+    std::vector<std::unique_ptr<Buffer>> _buffers;
+};
+
+}  // namespace mongo
@@ -0,0 +1,298 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kExecutor
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/concurrency/work_stealing_thread_pool.h"
+
+#include "mongo/base/status.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/log.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+struct WorkStealingThreadPool::Worker {
+    explicit Worker(size_t index) : index(index) {}
+
+    const size_t index;
+
+    // Only the worker's own thread pushes and pops. Other workers steal.
+    WorkStealingDeque<Task> tasks;
+};
+
+namespace {
+
+// Counter used to assign unique names to otherwise-unnamed thread pools.
+AtomicWord<int> nextUnnamedWorkStealingThreadPoolId{1};
+
+// The pool and deque of the current thread, if it is a worker thread of a WorkStealingThreadPool.
+thread_local const WorkStealingThreadPool* currentPool = nullptr;
+thread_local void* currentDeque = nullptr;
+
+WorkStealingThreadPool::Options cleanUpOptions(WorkStealingThreadPool::Options&& options) {
+    if (options.poolName.empty()) {
+        options.poolName = str::stream() << "WorkStealingThreadPool"
+                                         << nextUnnamedWorkStealingThreadPoolId.fetchAndAdd(1);
+    }
+    if (options.threadNamePrefix.empty()) {
+        options.threadNamePrefix = str::stream() << options.poolName << '-';
+    }
+    if (options.numThreads < 1) {
+        severe() << "Tried to create pool " << options.poolName << " with "
+                 << options.numThreads << " threads but it must have at least 1";
+        fassertFailed(51265);
+    }
+    return {std::move(options)};
+}
+
+}  // namespace
+
+WorkStealingThreadPool::WorkStealingThreadPool(Options options)
+    : _options(cleanUpOptions(std::move(options))) {
+    for (size_t i = 0; i < _options.numThreads; ++i) {
+        _workers.push_back(std::make_unique<Worker>(i));
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    stdx::unique_lock<Latch> lk(_mutex);
+    _shutdown_inlock();
+    if (shutdownComplete != _state) {
+        _join_inlock(&lk);
+    }
+
+    if (shutdownComplete != _state) {
+        severe() << "Failed to shutdown pool during destruction";
+        fassertFailed(51266);
+    }
+    invariant(_threads.empty());
+    invariant(_numPendingTasks.load() == 0);
+}
+
+void WorkStealingThreadPool::startup() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_state != preStart) {
+        severe() << "Attempting to start pool " << _options.poolName
+                 << ", but it has already started";
+        fassertFailed(51267);
+    }
+    _setState_inlock(running);
+    invariant(_threads.empty());
+    for (size_t i = 0; i < _options.numThreads; ++i) {
+        const std::string threadName = str::stream() << _options.threadNamePrefix << i;
+        _threads.emplace_back([this, i, threadName] { _workerThreadBody(i, threadName); });
+    }
+}
+
+void WorkStealingThreadPool::shutdown() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _shutdown_inlock();
+}
+
+void WorkStealingThreadPool::_shutdown_inlock() {
+    switch (_state) {
+        case preStart:
+        case running:
+            _shuttingDown.store(true);
+            _setState_inlock(joinRequired);
+            _workAvailable.notify_all();
+            return;
+        case joinRequired:
+        case joining:
+        case shutdownComplete:
+            return;
+    }
+    MONGO_UNREACHABLE;
+}
+
+void WorkStealingThreadPool::join() {
+    stdx::unique_lock<Latch> lk(_mutex);
+    _join_inlock(&lk);
+}
+
+void WorkStealingThreadPool::_join_inlock(stdx::unique_lock<Latch>* lk) {
+    _stateChange.wait(*lk, [this] {
+        switch (_state) {
+            case preStart:
+                return false;
+            case running:
+                return false;
+            case joinRequired:
+                return true;
+            case joining:
+            case shutdownComplete:
+                severe() << "Attempted to join pool " << _options.poolName << " more than once";
+                fassertFailed(51268);
+        }
+        MONGO_UNREACHABLE;
+    });
+    _setState_inlock(joining);
+    std::vector<stdx::thread> threadsToJoin;
+    swap(threadsToJoin, _threads);
+    lk->unlock();
+    if (threadsToJoin.empty()) {
+        // The pool was never started, so nothing ran the tasks scheduled before shutdown.
+        _drainPendingTasks();
+    }
+    for (auto& t : threadsToJoin) {
+        t.join();
+    }
+    lk->lock();
+    invariant(_state == joining);
+    _setState_inlock(shutdownComplete);
+}
+
+void WorkStealingThreadPool::_drainPendingTasks() {
+    // Tasks cannot be run inline because they can create OperationContexts and the join() caller
+    // may already have one associated with the thread.
+    stdx::thread cleanThread = stdx::thread([&] {
+        const std::string threadName = str::stream() << _options.threadNamePrefix << "drain";
+        setThreadName(threadName);
+        _options.onCreateThread(threadName);
+        while (auto task = _popInjectedTask()) {
+            _numPendingTasks.subtractAndFetch(1);
+            _runTask(task);
+        }
+    });
+    cleanThread.join();
+}
+
+void WorkStealingThreadPool::schedule(Task task) {
+    // Count the task before checking for shutdown, so that a worker which sees no pending tasks
+    // after shutdown started can exit knowing no task will be queued behind it.
+    _numPendingTasks.addAndFetch(1);
+    if (_shuttingDown.load()) {
+        _numPendingTasks.subtractAndFetch(1);
+        auto status = Status(ErrorCodes::ShutdownInProgress,
+                             str::stream() << "Shutdown of thread pool " << _options.poolName
+                                           << " in progress");
+        task(status);
+        return;
+    }
+
+    auto owned = new Task(std::move(task));
+    if (currentPool == this) {
+        static_cast<WorkStealingDeque<Task>*>(currentDeque)->push(owned);
+    } else {
+        stdx::lock_guard<Latch> lk(_injectionMutex);
+        _injectionQueue.push_back(owned);
+    }
+
+    // Pairs with the increment of '_numSleepingWorkers' in _workerThreadBody(): either this sees a
+    // worker going to sleep and wakes it, or that worker sees this task as pending and stays up.
+    if (_numSleepingWorkers.load() > 0) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _workAvailable.notify_one();
+    }
+}
+
+void WorkStealingThreadPool::_workerThreadBody(size_t workerIndex, const std::string& threadName) {
+    setThreadName(threadName);
+    _options.onCreateThread(threadName);
+    LOG(1) << "starting thread in pool " << _options.poolName;
+
+    auto worker = _workers[workerIndex].get();
+    currentPool = this;
+    currentDeque = &worker->tasks;
+    while (true) {
+        if (auto task = _findTask(worker)) {
+            _runTask(task);
+            continue;
+        }
+
+        if (_numPendingTasks.load() > 0) {
+            // A task is on its way into a queue, or being taken by another worker.
+            stdx::this_thread::yield();
+            continue;
+        }
+
+        if (_shuttingDown.load()) {
+            break;
+        }
+
+        stdx::unique_lock<Latch> lk(_mutex);
+        _numSleepingWorkers.addAndFetch(1);
+        {
+            MONGO_IDLE_THREAD_BLOCK;
+            _workAvailable.wait(
+                lk, [&] { return _numPendingTasks.load() > 0 || _shuttingDown.load(); });
+        }
+        _numSleepingWorkers.subtractAndFetch(1);
+    }
+    currentPool = nullptr;
+    currentDeque = nullptr;
+
+    LOG(1) << "shutting down thread in pool " << _options.poolName;
+}
+
+WorkStealingThreadPool::Task* WorkStealingThreadPool::_findTask(Worker* worker) {
+    auto task = worker->tasks.pop();
+    if (!task) {
+        task = _popInjectedTask();
+    }
+    for (size_t i = 1; !task && i < _workers.size(); ++i) {
+        task = _workers[(worker->index + i) % _workers.size()]->tasks.steal();
+    }
+    if (task) {
+        _numPendingTasks.subtractAndFetch(1);
+    }
+    return task;
+}
+
+WorkStealingThreadPool::Task* WorkStealingThreadPool::_popInjectedTask() {
+    stdx::lock_guard<Latch> lk(_injectionMutex);
+    if (_injectionQueue.empty()) {
+        return nullptr;
+    }
+    auto task = _injectionQueue.front();
+    _injectionQueue.pop_front();
+    return task;
+}
+
+void WorkStealingThreadPool::_runTask(Task* task) noexcept {
+    LOG(3) << "Executing a task on behalf of pool " << _options.poolName;
+    std::unique_ptr<Task> owned(task);
+    (*owned)(Status::OK());
+}
+
+void WorkStealingThreadPool::_setState_inlock(const LifecycleState newState) {
+    if (newState == _state) {
+        return;
+    }
+    _state = newState;
+    _stateChange.notify_all();
+}
+
+}  // namespace mongo
@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/thread_pool_interface.h"
+#include "mongo/util/concurrency/work_stealing_deque.h"
+
+namespace mongo {
+
+/**
+ * A thread pool with a fixed number of threads, for many small tasks.
+ *
+ * Each worker thread has its own lock-free deque. Tasks scheduled by a task running in the pool go
+ * onto the deque of the worker running it, while tasks scheduled from outside the pool go onto a
+ * shared injection queue. An idle worker takes work from its own deque first, then from the
+ * injection queue, and then steals from the deques of the other workers. Workers only take the
+ * pool's mutex to sleep, when there is nothing to run anywhere.
+ *
+ * Unlike ThreadPool, the number of threads does not change while the pool is running, and there
+ * is no waitForIdle().
+ */
+class WorkStealingThreadPool final : public ThreadPoolInterface {
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+public:
+    struct Options {
+        // Name of the thread pool. If this string is empty, the pool will be assigned a
+        // name unique to the current process.
+        std::string poolName;
+
+        // Prefix used to name threads for logging purposes. An integer will be appended to this
+        // string to create the thread name for each thread in the pool. If you leave this empty,
+        // the prefix will be the pool name followed by a hyphen.
+        std::string threadNamePrefix;
+
+        // Number of worker threads, all started by startup().
+        size_t numThreads = 8;
+
+        // This function is run before each worker thread begins consuming tasks.
+        using OnCreateThreadFn = std::function<void(const std::string& threadName)>;
+        OnCreateThreadFn onCreateThread = [](const std::string&) {};
+    };
+
+    explicit WorkStealingThreadPool(Options options);
+
+    ~WorkStealingThreadPool() override;
+
+    void startup() override;
+    void shutdown() override;
+    void join() override;
+    void schedule(Task task) override;
+
+private:
+    struct Worker;
+
+    /**
+     * See ThreadPool::LifecycleState.
+     */
+    enum LifecycleState { preStart, running, joinRequired, joining, shutdownComplete };
+
+    void _workerThreadBody(size_t workerIndex, const std::string& threadName);
+
+    /**
+     * Takes a task for 'worker' to run, looking in its own deque, then the injection queue, and
+     * then the deques of the other workers. Returns nullptr if none was found.
+     */
+    Task* _findTask(Worker* worker);
+
+    /**
+     * Takes a task from the front of the injection queue, or returns nullptr if it is empty.
+     */
+    Task* _popInjectedTask();
+
+    void _runTask(Task* task) noexcept;
+
+    /**
+     * Runs the tasks scheduled before startup on a new thread, when the pool was never started.
+     */
+    void _drainPendingTasks();
+
+    void _shutdown_inlock();
+    void _join_inlock(stdx::unique_lock<Latch>* lk);
+    void _setState_inlock(LifecycleState newState);
+
+    const Options _options;
+
+    // One per worker thread, created by the constructor.
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    // Tasks scheduled from outside the pool, protected by '_injectionMutex'.
+    Mutex _injectionMutex = MONGO_MAKE_LATCH("WorkStealingThreadPool::_injectionMutex");
+    std::deque<Task*> _injectionQueue;
+
+    // Number of tasks scheduled and not yet taken by a worker. A worker only sleeps when this is
+    // zero, and only exits during shutdown when this is zero.
+    AtomicWord<long long> _numPendingTasks{0};
+
+    // Set by shutdown(). After this, schedule() rejects tasks.
+    AtomicWord<bool> _shuttingDown{false};
+
+    // Number of workers asleep on '_workAvailable', or about to be. schedule() only takes '_mutex'
+    // to wake a worker when this is not zero.
+    AtomicWord<int> _numSleepingWorkers{0};
+
+    // Mutex guarding the lifecycle state and '_threads', and which idle workers sleep on.
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("WorkStealingThreadPool::_mutex");
+    LifecycleState _state = preStart;
+    stdx::condition_variable _workAvailable;
+    stdx::condition_variable _stateChange;
+    std::vector<stdx::thread> _threads;
+};
+
+}  // namespace mongo
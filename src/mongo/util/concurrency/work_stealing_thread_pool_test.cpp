@@ -0,0 +1,184 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/base/init.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/thread_pool_test_common.h"
+#include "mongo/util/concurrency/work_stealing_deque.h"
+#include "mongo/util/concurrency/work_stealing_thread_pool.h"
+
+namespace {
+using namespace mongo;
+
+MONGO_INITIALIZER(WorkStealingThreadPoolCommonTests)(InitializerContext*) {
+    addTestsForThreadPool("WorkStealingThreadPoolCommon", []() {
+        return std::make_unique<WorkStealingThreadPool>(WorkStealingThreadPool::Options());
+    });
+    return Status::OK();
+}
+
+TEST(WorkStealingDequeTest, OwnerPopsNewestAndThievesStealOldest) {
+    WorkStealingDeque<int> deque;
+    int items[3] = {0, 1, 2};
+    ASSERT(deque.empty());
+    ASSERT(!deque.pop());
+    ASSERT(!deque.steal());
+
+    for (auto& item : items) {
+        deque.push(&item);
+    }
+    ASSERT_FALSE(deque.empty());
+    ASSERT_EQ(deque.pop(), &items[2]);
+    ASSERT_EQ(deque.steal(), &items[0]);
+    ASSERT_EQ(deque.pop(), &items[1]);
+    ASSERT(deque.empty());
+    ASSERT(!deque.pop());
+    ASSERT(!deque.steal());
+}
+
+TEST(WorkStealingDequeTest, GrowsPastInitialCapacity) {
+    WorkStealingDeque<int> deque(2);
+    std::vector<int> items(100);
+    for (auto& item : items) {
+        deque.push(&item);
+    }
+    for (size_t i = 0; i < items.size() / 2; ++i) {
+        ASSERT_EQ(deque.steal(), &items[i]);
+    }
+    for (size_t i = items.size(); i > items.size() / 2; --i) {
+        ASSERT_EQ(deque.pop(), &items[i - 1]);
+    }
+    ASSERT(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, ConcurrentThievesTakeEachItemOnce) {
+    constexpr int kItems = 100000;
+    constexpr int kThieves = 4;
+    WorkStealingDeque<int> deque(16);
+    std::vector<int> items(kItems, 0);
+    std::vector<AtomicWord<int>> taken(kItems);
+    AtomicWord<bool> done{false};
+
+    auto take = [&](int* item) { taken[item - items.data()].fetchAndAdd(1); };
+
+    std::vector<stdx::thread> thieves;
+    for (int i = 0; i < kThieves; ++i) {
+        thieves.emplace_back([&] {
+            while (!done.load() || !deque.empty()) {
+                if (auto item = deque.steal()) {
+                    take(item);
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < kItems; ++i) {
+        deque.push(&items[i]);
+        if (i % 3 == 0) {
+            if (auto item = deque.pop()) {
+                take(item);
+            }
+        }
+    }
+    while (auto item = deque.pop()) {
+        take(item);
+    }
+    done.store(true);
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    for (int i = 0; i < kItems; ++i) {
+        ASSERT_EQ(taken[i].load(), 1);
+    }
+}
+
+TEST(WorkStealingThreadPoolTest, TasksScheduledByTasksAllRun) {
+    constexpr int kFanOut = 100;
+    WorkStealingThreadPool::Options options;
+    options.numThreads = 4;
+    WorkStealingThreadPool pool(std::move(options));
+    pool.startup();
+
+    auto mutex = MONGO_MAKE_LATCH();
+    stdx::condition_variable cv;
+    int finished = 0;
+    for (int i = 0; i < kFanOut; ++i) {
+        pool.schedule([&](auto status) {
+            ASSERT_OK(status);
+            for (int j = 0; j < kFanOut; ++j) {
+                pool.schedule([&](auto status) {
+                    ASSERT_OK(status);
+                    stdx::lock_guard<Latch> lk(mutex);
+                    if (++finished == kFanOut * kFanOut) {
+                        cv.notify_all();
+                    }
+                });
+            }
+        });
+    }
+
+    stdx::unique_lock<Latch> lk(mutex);
+    cv.wait(lk, [&] { return finished == kFanOut * kFanOut; });
+    lk.unlock();
+    pool.shutdown();
+    pool.join();
+}
+
+TEST(WorkStealingThreadPoolTest, ShutdownRunsTasksQueuedOnWorkers) {
+    WorkStealingThreadPool::Options options;
+    options.numThreads = 2;
+    WorkStealingThreadPool pool(std::move(options));
+    pool.startup();
+
+    AtomicWord<int> ran{0};
+    pool.schedule([&](auto status) {
+        ASSERT_OK(status);
+        for (int i = 0; i < 10; ++i) {
+            pool.schedule([&](auto status) {
+                ASSERT_OK(status);
+                ran.fetchAndAdd(1);
+            });
+        }
+        pool.shutdown();
+    });
+    pool.join();
+    ASSERT_EQ(ran.load(), 10);
+}
+
+}  // namespace
@@ -37,6 +37,8 @@
 #include <functional>
 #include <stack>
 
+#include "mongo/logv2/log_domain_global.h"
+#include "mongo/logv2/log_manager.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/thread.h"
@@ -69,6 +71,8 @@ void runTasks(decltype(shutdownTasks) tasks, const ShutdownTaskArgs& shutdownArg
 MONGO_COMPILER_NORETURN void logAndQuickExit_inlock() {
     ExitCode code = shutdownExitCode.get();
     log() << "shutting down with code:" << code;
+    // Give the lines queued for asynchronous writing a chance to reach the log file.
+    logv2::LogManager::global().getGlobalDomainInternal().flush(Date_t::now() + Seconds(5));
     quickExit(code);
 }
 
@@ -38,6 +38,7 @@
 #include <boost/algorithm/string/finder.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/filesystem.hpp>
+#include <cctype>
 #include <fcntl.h>
 #include <string>
 #include <sys/stat.h>
@@ -712,5 +713,31 @@ std::vector<std::string> findPhysicalDisks(StringData sysBlockPath) {
     return files;
 }
 
+std::vector<std::string> findNumaNodes(StringData sysNodePath) {
+    boost::system::error_code ec;
+    auto sysNodePathStr = sysNodePath.toString();
+
+    boost::filesystem::directory_iterator di(sysNodePathStr, ec);
+    if (ec) {
+        LOG(1) << "Error getting directory iterator '" << sysNodePathStr << "': " << ec.message();
+        return {};
+    }
+
+    std::vector<std::string> nodes;
+    for (; di != boost::filesystem::directory_iterator(); di++) {
+        auto name = (*di).path().filename().generic_string();
+        StringData nameSd(name);
+
+        auto isDigit = [](char c) { return std::isdigit(static_cast<unsigned char>(c)); };
+        if (nameSd.size() > 4 && nameSd.startsWith("node") &&
+            std::all_of(nameSd.begin() + 4, nameSd.end(), isDigit)) {
+            nodes.push_back(name);
+        }
+    }
+
+    std::sort(nodes.begin(), nodes.end());
+    return nodes;
+}
+
 }  // namespace procparser
 }  // namespace mongo
@@ -135,5 +135,14 @@ Status parseProcDiskStatsFile(StringData filename,
  */
 std::vector<std::string> findPhysicalDisks(StringData directory);
 
+/**
+ * Get a vector of NUMA nodes, such as "node0", by enumerating the specified directory, normally
+ * /sys/devices/system/node. Each node directory holds a numastat file, which is in
+ * /proc/meminfo format without units and can be read with parseProcMemInfoFile.
+ *
+ * If the directory does not exist, or otherwise permission is denied, returns an empty vector.
+ */
+std::vector<std::string> findNumaNodes(StringData directory);
+
 }  // namespace procparser
 }  // namespace mongo
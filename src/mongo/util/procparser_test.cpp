@@ -649,5 +649,30 @@ TEST(FTDCProcDiskStats, TestLocalDiskStats) {
     }
 }
 
+TEST(FTDCProcNumaStat, TestFindBadNumaNodePaths) {
+    auto nodes = procparser::findNumaNodes("/proc/does_not_exist");
+    ASSERT_EQUALS(0UL, nodes.size());
+}
+
+// Test we can parse the numastat files of the NUMA nodes on this machine, if it has any.
+TEST(FTDCProcNumaStat, TestLocalNumaStat) {
+    auto nodes = procparser::findNumaNodes("/sys/devices/system/node");
+
+    std::vector<StringData> keys{"local_node"_sd, "other_node"_sd};
+    for (const auto& node : nodes) {
+        log() << "NODE:" << node;
+        ASSERT(StringData(node).startsWith("node"));
+
+        BSONObjBuilder builder;
+        ASSERT_OK(procparser::parseProcMemInfoFile(
+            std::string("/sys/devices/system/node/") + node + "/numastat", keys, &builder));
+
+        BSONObj obj = builder.obj();
+        log() << "OBJ:" << obj;
+        ASSERT(obj.hasField("local_node"));
+        ASSERT(obj.hasField("other_node"));
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,199 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/sampling_profiler.h"
+
+#include <algorithm>
+
+#include "mongo/config.h"
+
+#if defined(__linux__) && \
+    (defined(MONGO_USE_LIBUNWIND) || defined(MONGO_CONFIG_HAVE_EXECINFO_BACKTRACE))
+#define MONGO_SAMPLING_PROFILER_SUPPORTED 1
+#endif
+
+#if defined(MONGO_SAMPLING_PROFILER_SUPPORTED)
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sys/time.h>
+
+#if defined(MONGO_USE_LIBUNWIND)
+#include <libunwind.h>
+#else
+#include <execinfo.h>
+#endif
+#endif
+
+#include "mongo/base/error_codes.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+namespace {
+
+#if defined(MONGO_SAMPLING_PROFILER_SUPPORTED)
+// The signal handler and the signal trampoline are the innermost frames of every sample.
+constexpr size_t kSkippedFrames = 2;
+
+int captureFrames(void** frames, int maxFrames) {
+#if defined(MONGO_USE_LIBUNWIND)
+    return unw_backtrace(frames, maxFrames);
+#else
+    return ::backtrace(frames, maxFrames);
+#endif
+}
+#endif
+
+}  // namespace
+
+SamplingProfiler& SamplingProfiler::get() {
+    static SamplingProfiler* profiler = new SamplingProfiler();
+    return *profiler;
+}
+
+#if defined(MONGO_SAMPLING_PROFILER_SUPPORTED)
+
+Status SamplingProfiler::setSampleRate(int samplesPerSecond) {
+    if (samplesPerSecond < 0 || samplesPerSecond > 1000) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "CPU sample rate must be between 0 and 1000, not "
+                              << samplesPerSecond};
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    if (samplesPerSecond > 0 && !_handlerInstalled) {
+        // The first backtrace() call loads libgcc, which is not async-signal-safe, so make it here
+        // rather than in the handler.
+        std::array<void*, kMaxFrames> frames;
+        captureFrames(frames.data(), frames.size());
+
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = &SamplingProfiler::_handleSignal;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, nullptr) != 0) {
+            auto err = errno;
+            return {ErrorCodes::InternalError,
+                    str::stream() << "Failed to install the SIGPROF handler: " << strerror(err)};
+        }
+
+        // The handler stays installed once the profiler stops, because a SIGPROF may still be in
+        // flight and the default action would terminate the process.
+        _handlerInstalled = true;
+    }
+
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    if (samplesPerSecond > 0) {
+        const long intervalMicros = 1000 * 1000 / samplesPerSecond;
+        timer.it_interval.tv_sec = intervalMicros / (1000 * 1000);
+        timer.it_interval.tv_usec = intervalMicros % (1000 * 1000);
+        timer.it_value = timer.it_interval;
+    }
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        auto err = errno;
+        return {ErrorCodes::InternalError,
+                str::stream() << "Failed to arm the profiling timer: " << strerror(err)};
+    }
+
+    _samplesPerSecond.store(samplesPerSecond);
+    return Status::OK();
+}
+
+void SamplingProfiler::_handleSignal(int signalNum) {
+    const auto savedErrno = errno;
+    auto& profiler = get();
+    if (profiler._samplesPerSecond.loadRelaxed() > 0) {
+        profiler._recordSample();
+    }
+    errno = savedErrno;
+}
+
+void SamplingProfiler::_recordSample() {
+    _sampleCount.fetchAndAddRelaxed(1);
+
+    auto& slot = _ring[_nextSlot.fetchAndAddRelaxed(1) % kRingSize];
+    std::uint32_t expected = kEmpty;
+    if (!slot.state.compareAndSwap(&expected, kWriting)) {
+        // The slot from the previous lap has not been drained yet.
+        _droppedSampleCount.fetchAndAddRelaxed(1);
+        return;
+    }
+
+    std::array<void*, kMaxFrames + kSkippedFrames> frames;
+    const int depth = captureFrames(frames.data(), frames.size());
+    const size_t kept = depth > static_cast<int>(kSkippedFrames) ? depth - kSkippedFrames : 0;
+    std::copy(frames.begin() + kSkippedFrames,
+              frames.begin() + kSkippedFrames + kept,
+              slot.frames.begin());
+    slot.depth = kept;
+    slot.state.store(kReady);
+}
+
+#else
+
+Status SamplingProfiler::setSampleRate(int samplesPerSecond) {
+    if (samplesPerSecond == 0) {
+        return Status::OK();
+    }
+    return {ErrorCodes::IllegalOperation, "CPU sampling is not supported on this platform"};
+}
+
+#endif
+
+std::uint64_t SamplingProfiler::drainSamples(StackCounts* stacks) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    std::uint64_t drained = 0;
+    for (auto& slot : _ring) {
+        if (slot.state.load() != kReady) {
+            continue;
+        }
+        Stack stack(slot.depth);
+        std::transform(slot.frames.begin(),
+                       slot.frames.begin() + slot.depth,
+                       stack.begin(),
+                       [](void* frame) { return reinterpret_cast<std::uintptr_t>(frame); });
+        slot.state.store(kEmpty);
+
+        if (!stack.empty()) {
+            ++(*stacks)[stack];
+            ++drained;
+        }
+    }
+    return drained;
+}
+
+}  // namespace mongo
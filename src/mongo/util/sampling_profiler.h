@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+
+/**
+ * A low-rate, process-wide CPU sampling profiler.
+ *
+ * While running, the profiler arms a CPU-time interval timer (ITIMER_PROF), so the kernel sends
+ * SIGPROF to whichever thread is on-CPU roughly 'samplesPerSecond' times per second of consumed
+ * CPU time. The signal handler captures the interrupted thread's return addresses into a fixed
+ * ring of sample slots without allocating or taking locks, and drainSamples() folds the ring into
+ * a count per distinct stack from a regular thread. The ring holds kRingSize samples; samples
+ * taken while the ring is full are counted as dropped, so it should be drained at least once a
+ * second.
+ *
+ * Only supported on Linux. SIGPROF interrupts blocking system calls which were not installed with
+ * SA_RESTART semantics, so the profiler is off unless explicitly started. It cannot run alongside
+ * the gperftools profiler, which also relies on SIGPROF.
+ */
+class SamplingProfiler {
+    SamplingProfiler(const SamplingProfiler&) = delete;
+    SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+
+public:
+    static constexpr size_t kMaxFrames = 64;
+    static constexpr size_t kRingSize = 4096;
+
+    // A stack is the list of return addresses of a sample, innermost first.
+    using Stack = std::vector<std::uintptr_t>;
+    using StackCounts = std::map<Stack, std::uint64_t>;
+
+    static SamplingProfiler& get();
+
+    /**
+     * Starts sampling at 'samplesPerSecond' samples per second of CPU time, or changes the rate of
+     * a running profiler. A rate of 0 stops the profiler. Fails on platforms without support.
+     */
+    Status setSampleRate(int samplesPerSecond);
+
+    int getSampleRate() const {
+        return _samplesPerSecond.load();
+    }
+
+    /**
+     * Moves the samples taken since the last call into 'stacks', adding to the count of each stack
+     * already present, and returns the number of samples moved.
+     */
+    std::uint64_t drainSamples(StackCounts* stacks);
+
+    /**
+     * Returns the total number of samples taken, including dropped ones.
+     */
+    std::uint64_t getSampleCount() const {
+        return _sampleCount.load();
+    }
+
+    /**
+     * Returns the number of samples dropped because the ring was full.
+     */
+    std::uint64_t getDroppedSampleCount() const {
+        return _droppedSampleCount.load();
+    }
+
+private:
+    SamplingProfiler() = default;
+
+    enum SlotState : std::uint32_t { kEmpty, kWriting, kReady };
+
+    struct Slot {
+        AtomicWord<std::uint32_t> state{kEmpty};
+        std::uint32_t depth = 0;
+        std::array<void*, kMaxFrames> frames;
+    };
+
+    static void _handleSignal(int signalNum);
+
+    // Records the current stack of the calling thread. Async-signal-safe.
+    void _recordSample();
+
+    // Serializes setSampleRate() and drainSamples().
+    Mutex _mutex = MONGO_MAKE_LATCH("SamplingProfiler::_mutex");
+
+    AtomicWord<int> _samplesPerSecond{0};
+    bool _handlerInstalled = false;
+
+    AtomicWord<std::uint64_t> _nextSlot{0};
+    AtomicWord<std::uint64_t> _sampleCount{0};
+    AtomicWord<std::uint64_t> _droppedSampleCount{0};
+    std::array<Slot, kRingSize> _ring;
+};
+
+}  // namespace mongo
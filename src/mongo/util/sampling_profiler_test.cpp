@@ -0,0 +1,87 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/sampling_profiler.h"
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace {
+
+TEST(SamplingProfilerTest, RejectsOutOfRangeSampleRates) {
+    ASSERT_EQ(ErrorCodes::BadValue, SamplingProfiler::get().setSampleRate(-1));
+    ASSERT_EQ(ErrorCodes::BadValue, SamplingProfiler::get().setSampleRate(1001));
+    ASSERT_EQ(0, SamplingProfiler::get().getSampleRate());
+}
+
+TEST(SamplingProfilerTest, SamplesStacksWhileBurningCpu) {
+    auto& profiler = SamplingProfiler::get();
+    ASSERT_OK(profiler.setSampleRate(1000));
+    ON_BLOCK_EXIT([&] { ASSERT_OK(profiler.setSampleRate(0)); });
+
+    SamplingProfiler::StackCounts stacks;
+    std::uint64_t drained = 0;
+    volatile std::uint64_t sink = 0;
+    Timer timer;
+    while (drained == 0 && timer.seconds() < 30) {
+        for (int i = 0; i < 1000 * 1000; ++i) {
+            sink = sink + i;
+        }
+        drained += profiler.drainSamples(&stacks);
+    }
+
+    ASSERT_GT(drained, 0U);
+    ASSERT_FALSE(stacks.empty());
+    std::uint64_t total = 0;
+    for (const auto& [stack, count] : stacks) {
+        ASSERT_FALSE(stack.empty());
+        ASSERT_LTE(stack.size(), SamplingProfiler::kMaxFrames);
+        total += count;
+    }
+    ASSERT_EQ(drained, total);
+    ASSERT_GTE(profiler.getSampleCount(), drained);
+}
+
+TEST(SamplingProfilerTest, DrainIsEmptyWhenStopped) {
+    auto& profiler = SamplingProfiler::get();
+    SamplingProfiler::StackCounts stacks;
+    profiler.drainSamples(&stacks);
+
+    stacks.clear();
+    ASSERT_EQ(0U, profiler.drainSamples(&stacks));
+    ASSERT_TRUE(stacks.empty());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -38,6 +38,7 @@
 
 #include "mongo/util/allocator.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/shared_buffer_pool.h"
 
 namespace mongo {
 
@@ -57,7 +58,22 @@ public:
     }
 
     /**
-     * Resizes the buffer, copying the current contents.
+     * Like allocate(), but takes the memory from the SharedBufferPool, and gives it back to the
+     * pool once the last reference to the buffer is released. Meant for buffers which are
+     * allocated and released at a high rate, such as network messages.
+     */
+    static SharedBuffer allocateFromPool(size_t bytes) {
+        const int sizeClass = SharedBufferPool::sizeClassFor(sizeof(Holder) + bytes);
+        if (sizeClass < 0) {
+            return allocate(bytes);
+        }
+        auto holder = new (SharedBufferPool::allocate(sizeClass)) Holder(1U, bytes, sizeClass);
+        return SharedBuffer(holder);
+    }
+
+    /**
+     * Resizes the buffer, copying the current contents. A buffer from the SharedBufferPool leaves
+     * the pool.
      *
      * Like ::realloc() this can be called on a null SharedBuffer.
      *
@@ -121,8 +137,8 @@ public:
 private:
     class Holder {
     public:
-        explicit Holder(unsigned initial, size_t capacity)
-            : _refCount(initial), _capacity(capacity) {
+        explicit Holder(unsigned initial, size_t capacity, int poolSizeClass = -1)
+            : _refCount(initial), _capacity(capacity), _poolSizeClass(poolSizeClass) {
             invariant(capacity == _capacity);
         }
 
@@ -135,8 +151,13 @@ private:
             if (h->_refCount.subtractAndFetch(1) == 0) {
                 // We placement new'ed a Holder in takeOwnership above,
                 // so we must destroy the object here.
+                const auto poolSizeClass = h->_poolSizeClass;
                 h->~Holder();
-                free(h);
+                if (poolSizeClass >= 0) {
+                    SharedBufferPool::release(h, poolSizeClass);
+                } else {
+                    free(h);
+                }
             }
         }
 
@@ -154,6 +175,13 @@ private:
 
         AtomicWord<unsigned> _refCount;
         uint32_t _capacity;
+
+        // The SharedBufferPool size class the memory came from, or -1 if it was allocated
+        // directly.
+        int32_t _poolSizeClass;
+
+        // Keeps the data following the Holder 8-byte aligned.
+        uint32_t _padding = 0;
     };
 
     explicit SharedBuffer(Holder* holder) : _holder(holder, /*add_ref=*/false) {
@@ -0,0 +1,164 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/shared_buffer_pool.h"
+
+#include <array>
+
+#include "mongo/base/status.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/allocator.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/spin_lock.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * The free list of a size class. Retained blocks are linked through their first bytes.
+ *
+ * The critical sections are a few instructions long, so they are guarded by a SpinLock rather
+ * than a Mutex, which also keeps the release path, which runs whenever a SharedBuffer dies, free
+ * of latch diagnostics.
+ */
+class SizeClass {
+public:
+    void* pop() {
+        scoped_spinlock lk(_lock);
+        auto block = _head;
+        if (block) {
+            _head = block->next;
+        }
+        return block;
+    }
+
+    void push(void* block) {
+        auto freeBlock = static_cast<FreeBlock*>(block);
+        scoped_spinlock lk(_lock);
+        freeBlock->next = _head;
+        _head = freeBlock;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    SpinLock _lock;
+    FreeBlock* _head = nullptr;
+};
+
+struct PoolState {
+    std::array<SizeClass, SharedBufferPool::kNumSizeClasses> sizeClasses;
+
+    AtomicWord<long long> maxRetainedBytes{SharedBufferPool::kDefaultMaxRetainedBytes};
+    AtomicWord<long long> retainedBytes{0};
+    AtomicWord<long long> peakRetainedBytes{0};
+
+    AtomicWord<long long> hits{0};
+    AtomicWord<long long> misses{0};
+    AtomicWord<long long> discards{0};
+};
+
+PoolState& poolState() {
+    // Intentionally leaked, since buffers may be released during static destruction.
+    static auto state = new PoolState();
+    return *state;
+}
+
+}  // namespace
+
+int SharedBufferPool::sizeClassFor(size_t bytes) {
+    size_t classBytes = kMinSizeClassBytes;
+    for (int sizeClass = 0; sizeClass < kNumSizeClasses; ++sizeClass, classBytes <<= 1) {
+        if (bytes <= classBytes) {
+            return sizeClass;
+        }
+    }
+    return -1;
+}
+
+void* SharedBufferPool::allocate(int sizeClass) {
+    dassert(sizeClass >= 0 && sizeClass < kNumSizeClasses);
+    auto& state = poolState();
+
+    if (auto block = state.sizeClasses[sizeClass].pop()) {
+        state.retainedBytes.subtractAndFetch(sizeClassBytes(sizeClass));
+        state.hits.addAndFetch(1);
+        return block;
+    }
+
+    state.misses.addAndFetch(1);
+    return mongoMalloc(sizeClassBytes(sizeClass));
+}
+
+void SharedBufferPool::release(void* block, int sizeClass) noexcept {
+    dassert(sizeClass >= 0 && sizeClass < kNumSizeClasses);
+    auto& state = poolState();
+
+    const long long bytes = sizeClassBytes(sizeClass);
+    const auto retainedBytes = state.retainedBytes.addAndFetch(bytes);
+    if (retainedBytes > state.maxRetainedBytes.loadRelaxed()) {
+        state.retainedBytes.subtractAndFetch(bytes);
+        state.discards.addAndFetch(1);
+        free(block);
+        return;
+    }
+
+    state.sizeClasses[sizeClass].push(block);
+
+    auto peak = state.peakRetainedBytes.load();
+    while (retainedBytes > peak && !state.peakRetainedBytes.compareAndSwap(&peak, retainedBytes)) {
+    }
+}
+
+void SharedBufferPool::setMaxRetainedBytes(long long bytes) {
+    poolState().maxRetainedBytes.store(bytes);
+}
+
+Status SharedBufferPool::onUpdateMaxRetainedBytes(const long long& bytes) {
+    setMaxRetainedBytes(bytes);
+    return Status::OK();
+}
+
+void SharedBufferPool::appendStats(BSONObjBuilder* builder) {
+    const auto& state = poolState();
+    builder->append("hits", state.hits.load());
+    builder->append("misses", state.misses.load());
+    builder->append("discards", state.discards.load());
+    builder->append("retainedBytes", state.retainedBytes.load());
+    builder->append("peakRetainedBytes", state.peakRetainedBytes.load());
+    builder->append("maxRetainedBytes", state.maxRetainedBytes.load());
+}
+
+}  // namespace mongo
@@ -0,0 +1,90 @@
+/**
+ *    Copyright (C) 2019-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+
+namespace mongo {
+
+class BSONObjBuilder;
+class Status;
+
+/**
+ * A process-wide pool of the memory blocks behind SharedBuffers allocated with
+ * SharedBuffer::allocateFromPool(), for buffers which are allocated and released at a high rate,
+ * such as network messages.
+ *
+ * Blocks come in power-of-two size classes, and released blocks are kept on a free list per class
+ * for reuse, as long as the total memory retained stays within the configured maximum.
+ */
+class SharedBufferPool {
+public:
+    static constexpr size_t kMinSizeClassBytes = 64;
+    static constexpr int kNumSizeClasses = 15;  // Up to 1MB.
+    static constexpr long long kDefaultMaxRetainedBytes = 32 * 1024 * 1024;
+
+    /**
+     * Returns the smallest size class whose blocks hold 'bytes', or -1 if they are too large to
+     * be pooled.
+     */
+    static int sizeClassFor(size_t bytes);
+
+    static size_t sizeClassBytes(int sizeClass) {
+        return kMinSizeClassBytes << sizeClass;
+    }
+
+    /**
+     * Returns a block of sizeClassBytes(sizeClass) bytes, reusing a retained block if there is
+     * one.
+     */
+    static void* allocate(int sizeClass);
+
+    /**
+     * Gives back a block returned by allocate() for 'sizeClass'. The block is retained for reuse,
+     * or freed if retaining it would exceed the maximum retained memory.
+     */
+    static void release(void* block, int sizeClass) noexcept;
+
+    /**
+     * Sets the maximum total size of the blocks retained for reuse. 0 disables retaining blocks.
+     * Blocks already retained beyond the new maximum are kept until they are reused.
+     */
+    static void setMaxRetainedBytes(long long bytes);
+
+    /**
+     * Server parameter hook for setMaxRetainedBytes().
+     */
+    static Status onUpdateMaxRetainedBytes(const long long& bytes);
+
+    static void appendStats(BSONObjBuilder* builder);
+};
+
+}  // namespace mongo
@@ -185,7 +185,21 @@ int versionCmp(const StringData rhs, const StringData lhs) {
 std::string escape(StringData sd, bool escape_slash) {
     StringBuilder ret;
     ret.reset(sd.size());
-    for (const auto& c : sd) {
+
+    // Most strings need little or no escaping, so copy each run of characters that can be written
+    // as-is with a single append rather than one character at a time.
+    size_t runStart = 0;
+    for (size_t i = 0; i < sd.size(); ++i) {
+        const char c = sd[i];
+        if (!(c >= 0 && c <= 0x1f) && c != '"' && c != '\\' && c != '/') {
+            continue;
+        }
+
+        if (i > runStart) {
+            ret << sd.substr(runStart, i - runStart);
+        }
+        runStart = i + 1;
+
         switch (c) {
             case '"':
                 ret << "\\\"";
@@ -212,14 +226,13 @@ std::string escape(StringData sd, bool escape_slash) {
                 ret << "\\t";
                 break;
             default:
-                if (c >= 0 && c <= 0x1f) {
-                    // For c < 0x7f, ASCII value == Unicode code point.
-                    ret << "\\u00" << toHexLower(&c, 1);
-                } else {
-                    ret << c;
-                }
+                // For c < 0x7f, ASCII value == Unicode code point.
+                ret << "\\u00" << toHexLower(&c, 1);
         }
     }
+    if (sd.size() > runStart) {
+        ret << sd.substr(runStart);
+    }
     return ret.str();
 }
 
@@ -280,4 +280,17 @@ TEST(StringUtilsTest, ConvertDoubleToStringWithProperPrecision) {
     ASSERT_EQUALS(std::string("0.1000000006"), convertDoubleToString(0.1 + 6E-10, 10));
     ASSERT_EQUALS(std::string("0.1"), convertDoubleToString(0.1 + 6E-8, 6));
 }
+
+TEST(StringUtilsTest, Escape) {
+    ASSERT_EQUALS(std::string(""), escape(""));
+    ASSERT_EQUALS(std::string("plain text"), escape("plain text"));
+    ASSERT_EQUALS(std::string("\\\"quoted\\\""), escape("\"quoted\""));
+    ASSERT_EQUALS(std::string("a\\\\b\\tc\\nd"), escape("a\\b\tc\nd"));
+    ASSERT_EQUALS(std::string("\\u0001x\\u001f"), escape(StringData("\x01x\x1f", 3)));
+    ASSERT_EQUALS(std::string("a/b"), escape("a/b"));
+    ASSERT_EQUALS(std::string("a\\/b"), escape("a/b", true));
+
+    // Characters outside of ASCII are copied through unchanged.
+    ASSERT_EQUALS(std::string("caf\xc3\xa9"), escape("caf\xc3\xa9"));
+}
 }  // namespace mongo::str
@@ -33,9 +33,85 @@
 
 #include <cmath>
 
+#include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/util/assert_util.h"
 
+// TODO replace this with #if BOOST_HW_SIMD_X86 >= BOOST_HW_SIMD_X86_SSE2_VERSION in boost 1.60
+#if defined(_M_AMD64) || defined(__amd64__)
+#include <emmintrin.h>
+#define MONGO_SUMMATION_HAVE_SSE2
+#endif
+
 namespace mongo {
+namespace {
+// Arrays shorter than this are passed to addDouble() one value at a time by addDoubles(), since
+// setting up and folding the lanes would cost more than it saves.
+constexpr size_t kMinLanedDoubles = 16;
+}  // namespace
+
+void DoubleDoubleSummation::addDoubles(const double* values, size_t n) {
+    if (n < kMinLanedDoubles) {
+        for (size_t i = 0; i < n; ++i) {
+            addDouble(values[i]);
+        }
+        return;
+    }
+
+    // Lane 0 sums the values at even positions and lane 1 those at odd positions, each with the
+    // algorithm of addDouble(). The scalar version performs exactly the same operations as the
+    // SSE2 version, so the result doesn't depend on the platform.
+    const size_t nPairs = n / 2;
+    double sum[2] = {0.0, 0.0};
+    double addend[2] = {0.0, 0.0};
+    double special[2] = {0.0, 0.0};
+#ifdef MONGO_SUMMATION_HAVE_SSE2
+    __m128d vSum = _mm_setzero_pd();
+    __m128d vAddend = _mm_setzero_pd();
+    __m128d vSpecial = _mm_setzero_pd();
+    for (size_t i = 0; i < nPairs; ++i) {
+        __m128d x = _mm_loadu_pd(&values[2 * i]);
+        vSpecial = _mm_add_pd(vSpecial, x);
+
+        // Fast2Sum of x and the addend.
+        __m128d s = _mm_add_pd(x, vAddend);
+        vAddend = _mm_sub_pd(vAddend, _mm_sub_pd(s, x));
+        x = s;
+
+        // 2Sum of the sum and x.
+        s = _mm_add_pd(vSum, x);
+        const __m128d aPrime = _mm_sub_pd(s, x);
+        const __m128d bPrime = _mm_sub_pd(s, aPrime);
+        x = _mm_add_pd(_mm_sub_pd(vSum, aPrime), _mm_sub_pd(x, bPrime));
+        vSum = s;
+
+        vAddend = _mm_add_pd(vAddend, x);
+    }
+    _mm_storeu_pd(sum, vSum);
+    _mm_storeu_pd(addend, vAddend);
+    _mm_storeu_pd(special, vSpecial);
+#else
+    for (size_t i = 0; i < nPairs; ++i) {
+        for (size_t lane = 0; lane < 2; ++lane) {
+            double x = values[2 * i + lane];
+            special[lane] += x;
+            std::tie(x, addend[lane]) = _fast2Sum(x, addend[lane]);
+            std::tie(sum[lane], x) = _2Sum(sum[lane], x);
+            addend[lane] += x;
+        }
+    }
+#endif
+
+    _special += special[0] + special[1];
+    _addCompensated(sum[0]);
+    _addCompensated(sum[1]);
+    _addCompensated(addend[0]);
+    _addCompensated(addend[1]);
+
+    if (n % 2) {
+        addDouble(values[n - 1]);
+    }
+}
+
 void DoubleDoubleSummation::addLong(long long x) {
     // Split 64-bit integers into two doubles, so the sum remains exact.
     int64_t high = x / (1ll << 32) * (1ll << 32);
@@ -45,6 +121,25 @@ void DoubleDoubleSummation::addLong(long long x) {
     addDouble(high);
 }
 
+void DoubleDoubleSummation::addLongs(const long long* values, size_t n) {
+    if (n == 0) {
+        return;
+    }
+
+    // Integer addition is exact, so the values only need to go through the compensated sum when
+    // the partial sum is about to overflow.
+    long long partial = values[0];
+    for (size_t i = 1; i < n; ++i) {
+        long long next;
+        if (overflow::add(partial, values[i], &next)) {
+            addLong(partial);
+            next = values[i];
+        }
+        partial = next;
+    }
+    addLong(partial);
+}
+
 /**
  * Returns whether the sum is in range of the 64-bit signed integer long long type.
  */
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include <tuple>
 #include <utility>
 
@@ -52,18 +53,31 @@ public:
      * Adds x to the sum, keeping track of a compensation amount to be subtracted later.
      */
     void addDouble(double x) {
-        _special += x;                                 // Keep a simple sum to use in case of NaN
-        std::tie(x, _addend) = _fast2Sum(x, _addend);  // Compensated add: _addend tinier than _sum
-        std::tie(_sum, x) = _2Sum(_sum, x);            // Compensated add: x maybe larger than _sum
-        _addend += x;                                  // Store away lowest part of sum
+        _special += x;  // Keep a simple sum to use in case of NaN
+        _addCompensated(x);
     }
 
+    /**
+     * Adds the 'n' doubles starting at 'values'. Long arrays are summed in two interleaved lanes,
+     * each using the same compensated addition as addDouble(), which are then added to this sum;
+     * the result has the same precision as adding the values one at a time. Short arrays are added
+     * one at a time.
+     */
+    void addDoubles(const double* values, size_t n);
+
     /**
      * Adds x to internal sum. Extra precision guarantees that sum is exact, unless intermediate
      * sums exceed a magnitude of 2**106.
      */
     void addLong(long long x);
 
+    /**
+     * Adds the 'n' integers starting at 'values'. The values are summed with 64-bit integer
+     * arithmetic until that would overflow, so the result is exact under the same conditions as
+     * for addLong().
+     */
+    void addLongs(const long long* values, size_t n);
+
     /**
      * Adds x to internal sum. Adds as double as that is more efficient.
      */
@@ -114,6 +128,15 @@ public:
     long long getLong() const;
 
 private:
+    /**
+     * Adds x to the compensated sum without updating the simple sum kept for NaNs.
+     */
+    void _addCompensated(double x) {
+        std::tie(x, _addend) = _fast2Sum(x, _addend);  // Compensated add: _addend tinier than _sum
+        std::tie(_sum, x) = _2Sum(_sum, x);            // Compensated add: x maybe larger than _sum
+        _addend += x;                                  // Store away lowest part of sum
+    }
+
     /**
      * Assuming |b| <= |a|, returns exact unevaluated sum of a and b, where the first member is the
      * double nearest the sum (ties to even) and the second member is the remainder.
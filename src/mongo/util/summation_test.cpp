@@ -205,6 +205,63 @@ TEST(Summation, AddDoubles) {
     ASSERT(straightSum != sum.getDouble());
 }
 
+TEST(Summation, AddDoublesBatch) {
+    // Every prefix exercises both the one-at-a-time path for short arrays and the laned path with
+    // an odd or even number of values.
+    for (size_t n = 0; n <= doubleValues.size(); ++n) {
+        DoubleDoubleSummation sequential;
+        for (size_t i = 0; i < n; ++i) {
+            sequential.addDouble(doubleValues[i]);
+        }
+
+        DoubleDoubleSummation batched;
+        batched.addDoubles(doubleValues.data(), n);
+        ASSERT_EQUALS(batched.getDouble(), sequential.getDouble());
+    }
+
+    DoubleDoubleSummation sum;
+    sum.addDoubles(doubleValues.data(), doubleValues.size());
+    ASSERT_EQUALS(sum.getDouble(), doubleValuesSum);
+}
+
+TEST(Summation, AddDoublesBatchSpecial) {
+    for (auto x : specialValues) {
+        std::vector<double> values(31, 1.5);
+        values[7] = x;
+
+        DoubleDoubleSummation sum;
+        sum.addDoubles(values.data(), values.size());
+        ASSERT(!sum.fitsLong());
+        if (std::isnan(x)) {
+            ASSERT(std::isnan(sum.getDouble()));
+        } else {
+            ASSERT_EQUALS(sum.getDouble(), x);
+        }
+    }
+}
+
+TEST(Summation, AddLongsBatch) {
+    // Summing all the values overflows a 64-bit integer many times over.
+    DoubleDoubleSummation sequential;
+    uint64_t checkUint64 = 0;
+    for (auto x : longValues) {
+        sequential.addLong(x);
+        checkUint64 += static_cast<uint64_t>(x);
+    }
+
+    DoubleDoubleSummation batched;
+    batched.addLongs(longValues.data(), longValues.size());
+    ASSERT(batched.isInteger());
+    ASSERT_EQUALS(batched.getDouble(), sequential.getDouble());
+    ASSERT_EQUALS(batched.fitsLong(), sequential.fitsLong());
+
+    // Reduce the sum to fit in a 64-bit integer.
+    while (!batched.fitsLong()) {
+        batched.addDouble(batched.getDouble() < 0 ? std::ldexp(1, 64) : -std::ldexp(1, 64));
+    }
+    ASSERT_EQUALS(static_cast<uint64_t>(batched.getLong()), checkUint64);
+}
+
 TEST(Summation, ConvertInfinityToDecimal) {
     constexpr double infinity = std::numeric_limits<double>::infinity();
     DoubleDoubleSummation sum;